@@ -4,7 +4,9 @@
 #include <Cesium3DTiles/Schema.h>
 #include <CesiumUtility/JsonValue.h>
 
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Cesium3DTiles {
@@ -49,6 +51,78 @@ struct CESIUM3DTILES_API FoundMetadataProperty {
   const CesiumUtility::JsonValue& propertyValue;
 };
 
+/**
+ * @brief An index of the properties of the classes of a {@link Schema} by
+ * their {@link ClassProperty::semantic}.
+ *
+ * {@link MetadataQuery::findFirstPropertyWithSemantic} looks at each property
+ * of the entity in turn to find the one with the semantic. When the same
+ * semantics are queried for many entities, such as for every tile, build one
+ * index for the schema and pass it instead, so that each query only needs two
+ * lookups by identifier.
+ *
+ * Because the index holds _references_ to the original {@link Schema}, it
+ * must be built again if the schema is destroyed or modified.
+ */
+class CESIUM3DTILES_API MetadataSemanticIndex {
+public:
+  /**
+   * @brief A property with a semantic, along with the class that contains it.
+   */
+  struct IndexedProperty {
+    /**
+     * @brief The identifier of the class within the {@link Schema}.
+     */
+    const std::string* pClassIdentifier;
+
+    /**
+     * @brief The class within the {@link Schema}.
+     */
+    const Class* pClassDefinition;
+
+    /**
+     * @brief The identifier of the property within the class.
+     */
+    const std::string* pPropertyIdentifier;
+
+    /**
+     * @brief The property within the class.
+     */
+    const ClassProperty* pPropertyDefinition;
+  };
+
+  /**
+   * @brief Indexes the properties with a semantic of every class of the given
+   * schema.
+   *
+   * The schema is expected to use each semantic at most once in each class.
+   * If it doesn't, the property that is indexed for the semantic is
+   * unspecified.
+   *
+   * @param schema The schema, which must outlive the index.
+   */
+  explicit MetadataSemanticIndex(const Schema& schema);
+
+  /**
+   * @brief Finds the property with the given semantic in the class with the
+   * given identifier.
+   *
+   * @param classIdentifier The identifier of the class.
+   * @param semantic The semantic to find.
+   * @return The property, or nullptr if the class doesn't exist or doesn't
+   * have a property with the semantic.
+   */
+  const IndexedProperty* find(
+      const std::string& classIdentifier,
+      const std::string& semantic) const noexcept;
+
+private:
+  // The keys are views of the identifiers and semantics in the schema.
+  using PropertiesBySemantic =
+      std::unordered_map<std::string_view, IndexedProperty>;
+  std::unordered_map<std::string_view, PropertiesBySemantic> _classes;
+};
+
 /**
  * @brief Convenience functions for querying {@link MetadataEntity} instances.
  */
@@ -69,6 +143,22 @@ public:
       const Schema& schema,
       const MetadataEntity& entity,
       const std::string& semantic);
+
+  /**
+   * @brief Gets the property with a given {@link ClassProperty::semantic},
+   * using an index of the schema's semantics.
+   *
+   * @param index The index of the semantics of the schema of the entity.
+   * @param entity The metadata entity to search for a property with the
+   * semantic.
+   * @param semantic The semantic to find.
+   * @return The details of the found property, or `std::nullopt` if a property
+   * with the given semantic does not exist.
+   */
+  static std::optional<FoundMetadataProperty> findFirstPropertyWithSemantic(
+      const MetadataSemanticIndex& index,
+      const MetadataEntity& entity,
+      const std::string& semantic);
 };
 
 } // namespace Cesium3DTiles
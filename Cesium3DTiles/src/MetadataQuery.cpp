@@ -2,6 +2,46 @@
 
 namespace Cesium3DTiles {
 
+MetadataSemanticIndex::MetadataSemanticIndex(const Schema& schema) {
+  for (const auto& [classIdentifier, classDefinition] : schema.classes) {
+    PropertiesBySemantic* pProperties = nullptr;
+    for (const auto& [propertyIdentifier, propertyDefinition] :
+         classDefinition.properties) {
+      if (!propertyDefinition.semantic) {
+        continue;
+      }
+
+      if (!pProperties) {
+        pProperties = &this->_classes[classIdentifier];
+      }
+
+      pProperties->emplace(
+          *propertyDefinition.semantic,
+          IndexedProperty{
+              &classIdentifier,
+              &classDefinition,
+              &propertyIdentifier,
+              &propertyDefinition});
+    }
+  }
+}
+
+const MetadataSemanticIndex::IndexedProperty* MetadataSemanticIndex::find(
+    const std::string& classIdentifier,
+    const std::string& semantic) const noexcept {
+  auto classIt = this->_classes.find(classIdentifier);
+  if (classIt == this->_classes.end()) {
+    return nullptr;
+  }
+
+  auto propertyIt = classIt->second.find(semantic);
+  if (propertyIt == classIt->second.end()) {
+    return nullptr;
+  }
+
+  return &propertyIt->second;
+}
+
 std::optional<FoundMetadataProperty>
 MetadataQuery::findFirstPropertyWithSemantic(
     const Schema& schema,
@@ -35,4 +75,28 @@ MetadataQuery::findFirstPropertyWithSemantic(
   return std::nullopt;
 }
 
+std::optional<FoundMetadataProperty>
+MetadataQuery::findFirstPropertyWithSemantic(
+    const MetadataSemanticIndex& index,
+    const MetadataEntity& entity,
+    const std::string& semantic) {
+  const MetadataSemanticIndex::IndexedProperty* pProperty =
+      index.find(entity.classProperty, semantic);
+  if (!pProperty) {
+    return std::nullopt;
+  }
+
+  auto valueIt = entity.properties.find(*pProperty->pPropertyIdentifier);
+  if (valueIt == entity.properties.end()) {
+    return std::nullopt;
+  }
+
+  return FoundMetadataProperty{
+      *pProperty->pClassIdentifier,
+      *pProperty->pClassDefinition,
+      valueIt->first,
+      *pProperty->pPropertyDefinition,
+      valueIt->second};
+}
+
 } // namespace Cesium3DTiles
@@ -51,5 +51,38 @@ TEST_CASE("MetadataQuery") {
     CHECK(foundProperty2->propertyIdentifier == "somePropertyWithSemantic");
     CHECK(&foundProperty2->propertyDefinition == &classProperty2);
     CHECK(foundProperty2->propertyValue.getStringOrDefault("") == "the value");
+
+    MetadataSemanticIndex index(schema);
+
+    std::optional<FoundMetadataProperty> foundProperty3 =
+        MetadataQuery::findFirstPropertyWithSemantic(
+            index,
+            withoutSemantic,
+            "SOME_SEMANTIC");
+    CHECK(!foundProperty3);
+
+    std::optional<FoundMetadataProperty> foundProperty4 =
+        MetadataQuery::findFirstPropertyWithSemantic(
+            index,
+            withSemantic,
+            "SOME_SEMANTIC");
+    REQUIRE(foundProperty4);
+    CHECK(foundProperty4->classIdentifier == "someClass");
+    CHECK(&foundProperty4->classDefinition == &classDefinition);
+    CHECK(foundProperty4->propertyIdentifier == "somePropertyWithSemantic");
+    CHECK(&foundProperty4->propertyDefinition == &classProperty2);
+    CHECK(foundProperty4->propertyValue.getStringOrDefault("") == "the value");
+
+    CHECK(!MetadataQuery::findFirstPropertyWithSemantic(
+        index,
+        withSemantic,
+        "OTHER_SEMANTIC"));
+
+    MetadataEntity ofOtherClass = withSemantic;
+    ofOtherClass.classProperty = "otherClass";
+    CHECK(!MetadataQuery::findFirstPropertyWithSemantic(
+        index,
+        ofOtherClass,
+        "SOME_SEMANTIC"));
   }
 }
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GltfConverterResult.h"
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfReader/GltfReader.h>
+
+#include <gsl/span>
+
+namespace Cesium3DTilesContent {
+/**
+ * @brief Converts Instanced 3D Model (i3dm) content to a glTF that draws the
+ * embedded model once per instance with the `EXT_mesh_gpu_instancing`
+ * extension, rather than by copying its geometry.
+ *
+ * The instance positions, orientations and scales of the feature table become
+ * the `TRANSLATION`, `ROTATION` and `SCALE` attributes of each node with a
+ * mesh, and the `BATCH_ID`, if any, becomes its `_FEATURE_ID_0` attribute.
+ * Instances oriented with `EAST_NORTH_UP` are oriented as if the tile's
+ * coordinate system were the Earth-centered, Earth-fixed one, as is usual.
+ *
+ * Only instances of an embedded glTF are supported, not of one referenced by
+ * a URI.
+ */
+struct I3dmToGltfConverter {
+  static GltfConverterResult convert(
+      const gsl::span<const std::byte>& instancesBinary,
+      const CesiumGltfReader::GltfReaderOptions& options);
+};
+} // namespace Cesium3DTilesContent
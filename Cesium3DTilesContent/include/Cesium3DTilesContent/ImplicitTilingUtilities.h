@@ -2,6 +2,8 @@
 
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumUtility/UriResolver.h>
+#include <CesiumUtility/UriTemplate.h>
 
 #include <array>
 #include <iterator>
@@ -149,6 +151,44 @@ public:
       const std::string& urlTemplate,
       const CesiumGeometry::OctreeTileID& octreeID);
 
+  /**
+   * @brief Resolves a templatized implicit tiling URL with a quadtree tile ID,
+   * using a base URL and a template that were each parsed once.
+   *
+   * This gives the same result as the overload that takes strings, but
+   * doesn't parse either of them again for each tile.
+   *
+   * @param baseUrl The base URL that is used to resolve the urlTemplate if it
+   * is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param quadtreeID The quadtree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::UriResolver& baseUrl,
+      const CesiumUtility::UriTemplate& urlTemplate,
+      const CesiumGeometry::QuadtreeTileID& quadtreeID);
+
+  /**
+   * @brief Resolves a templatized implicit tiling URL with an octree tile ID,
+   * using a base URL and a template that were each parsed once.
+   *
+   * This gives the same result as the overload that takes strings, but
+   * doesn't parse either of them again for each tile.
+   *
+   * @param baseUrl The base URL that is used to resolve the urlTemplate if it
+   * is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param octreeID The octree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::UriResolver& baseUrl,
+      const CesiumUtility::UriTemplate& urlTemplate,
+      const CesiumGeometry::OctreeTileID& octreeID);
+
   /**
    * @brief Computes the denominator for a given implicit tile level.
    *
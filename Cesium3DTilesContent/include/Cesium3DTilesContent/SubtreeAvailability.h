@@ -353,6 +353,78 @@ public:
    */
   bool isSubtreeAvailable(uint64_t relativeSubtreeMortonId) const noexcept;
 
+  /**
+   * @brief Gets the availability of the children of a given tile in the
+   * subtree, all at once.
+   *
+   * Bit `i` of the returned mask is set if the child whose relative Morton ID
+   * is `relativeTileMortonId * 4 + i` for a quadtree, or
+   * `relativeTileMortonId * 8 + i` for an octree, is available. This is the
+   * order in which {@link ImplicitTilingUtilities::getChildren} enumerates
+   * the children. The children must be within this subtree, so the tile must
+   * not be one of its leaves.
+   *
+   * @param relativeTileLevel The level of the parent tile, relative to the
+   * root of the subtree.
+   * @param relativeTileMortonId The Morton ID of the parent tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return The availability mask of the children.
+   */
+  uint8_t getChildTileAvailabilityMask(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId) const noexcept;
+
+  /**
+   * @brief Gets the content availability of the children of a given tile in
+   * the subtree, all at once.
+   *
+   * The bits of the returned mask are ordered as in
+   * {@link getChildTileAvailabilityMask}.
+   *
+   * @param relativeTileLevel The level of the parent tile, relative to the
+   * root of the subtree.
+   * @param relativeTileMortonId The Morton ID of the parent tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @param contentId The ID of the content to query.
+   * @return The content availability mask of the children.
+   */
+  uint8_t getChildContentAvailabilityMask(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId,
+      uint64_t contentId) const noexcept;
+
+  /**
+   * @brief Gets the availability of the subtrees rooted at the children of a
+   * given leaf of this subtree, all at once.
+   *
+   * The bits of the returned mask are ordered as in
+   * {@link getChildTileAvailabilityMask}.
+   *
+   * @param relativeTileMortonId The Morton ID of the leaf tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return The subtree availability mask of the children.
+   */
+  uint8_t
+  getChildSubtreeAvailabilityMask(uint64_t relativeTileMortonId) const noexcept;
+
+  /**
+   * @brief Determines if any descendant of a given tile in the subtree is
+   * available, either as a tile of this subtree or as the root of a child
+   * subtree.
+   *
+   * Instead of visiting each descendant, this tests the contiguous range of
+   * the descendants' availability bits on each level a word at a time.
+   *
+   * @param relativeTileLevel The level of the tile, relative to the root of
+   * the subtree.
+   * @param relativeTileMortonId The Morton ID of the tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return True if any descendant is available; otherwise, false.
+   */
+  bool hasAvailableDescendants(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId) const noexcept;
+
   /**
    * @brief Sets the availability state of the child quadtree rooted at the
    * given tile.
@@ -420,6 +492,16 @@ private:
       AvailabilityView& availabilityView,
       bool isAvailable) noexcept;
 
+  uint8_t getChildAvailabilityMask(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId,
+      uint64_t numOfTilesFromRootToChildLevel,
+      const AvailabilityView& availabilityView) const noexcept;
+  bool isAnyAvailable(
+      uint64_t firstAvailabilityBitIndex,
+      uint64_t availabilityBitCount,
+      const AvailabilityView& availabilityView) const noexcept;
+
   bool isAvailableUsingBufferView(
       uint64_t numOfTilesFromRootToParentLevel,
       uint64_t relativeTileMortonId,
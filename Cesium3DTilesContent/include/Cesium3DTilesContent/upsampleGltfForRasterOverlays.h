@@ -3,6 +3,9 @@
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumGltf/Model.h>
 
+#include <optional>
+#include <vector>
+
 namespace Cesium3DTilesContent {
 
 std::optional<CesiumGltf::Model> upsampleGltfForRasterOverlays(
@@ -10,4 +13,40 @@ std::optional<CesiumGltf::Model> upsampleGltfForRasterOverlays(
     CesiumGeometry::UpsampledQuadtreeNode childID,
     int32_t textureCoordinateIndex = 0);
 
-}
+/**
+ * @brief Upsamples a model for several of its children at once, such as all
+ * four children of a quadtree tile.
+ *
+ * This gives the same models as calling {@link upsampleGltfForRasterOverlays}
+ * for each child, but the triangles of the parent are only traversed once,
+ * and the attributes of its vertices are only read and dequantized once.
+ *
+ * @param parentModel The model to upsample.
+ * @param childIDs The IDs of the children to upsample the model for.
+ * @param textureCoordinateIndex The index of the overlay texture coordinates
+ * that divide the model.
+ * @return The model for each of the children, in the same order as
+ * `childIDs`, or std::nullopt for a child that has no part of the model.
+ */
+std::vector<std::optional<CesiumGltf::Model>>
+upsampleGltfForRasterOverlayChildren(
+    const CesiumGltf::Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex = 0);
+
+/**
+ * @brief Creates a compact copy of a model that upsamples to the same models
+ * as the model itself.
+ *
+ * The copy only keeps the data of the accessors of the primitives, tightly
+ * packed, and of the property tables. It doesn't keep the rest of the model's
+ * buffers, such as the encoded images and compressed meshes in a binary glTF,
+ * so that it can be kept to upsample children of the model after the model is
+ * unloaded.
+ *
+ * @param model The model to copy.
+ * @return The compact copy of the model.
+ */
+CesiumGltf::Model createGltfUpsamplingSource(const CesiumGltf::Model& model);
+
+} // namespace Cesium3DTilesContent
@@ -181,6 +181,7 @@ void convertB3dmMetadataToGltfStructuralMetadata(
     const gsl::span<const std::byte>& b3dmBinary,
     const B3dmHeader& header,
     uint32_t headerLength,
+    const CesiumGltfReader::GltfReaderOptions& options,
     GltfConverterResult& result) {
   if (result.model && header.featureTableJsonByteLength > 0) {
     CesiumGltf::Model& gltf = result.model.value();
@@ -225,7 +226,8 @@ void convertB3dmMetadataToGltfStructuralMetadata(
           featureTableJson,
           batchTableJson,
           batchTableBinaryData,
-          gltf));
+          gltf,
+          options.batchTableProperties));
     }
   }
 }
@@ -251,6 +253,7 @@ GltfConverterResult B3dmToGltfConverter::convert(
       b3dmBinary,
       header,
       headerLength,
+      options,
       result);
 
   return result;
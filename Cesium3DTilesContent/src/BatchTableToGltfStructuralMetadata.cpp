@@ -2,7 +2,9 @@
 
 #include "BatchTableHierarchyPropertyValues.h"
 
+#include <CesiumGltf/ExtensionExtInstanceFeatures.h>
 #include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltf/Model.h>
@@ -13,6 +15,7 @@
 #include <rapidjson/writer.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <type_traits>
@@ -660,6 +663,16 @@ CompatibleTypes findCompatibleTypes(const TValueGetter& propertyValue) {
   return compatibleTypes;
 }
 
+bool shouldConvertProperty(
+    const std::vector<std::string>& propertiesToConvert,
+    const std::string& name) {
+  return propertiesToConvert.empty() ||
+         std::find(
+             propertiesToConvert.begin(),
+             propertiesToConvert.end(),
+             name) != propertiesToConvert.end();
+}
+
 int32_t addBufferToGltf(Model& gltf, std::vector<std::byte>&& buffer) {
   const size_t gltfBufferIndex = gltf.buffers.size();
   Buffer& gltfBuffer = gltf.buffers.emplace_back();
@@ -1628,7 +1641,8 @@ void updateExtensionWithBatchTableHierarchy(
     Class& classDefinition,
     PropertyTable& propertyTable,
     ErrorList& result,
-    const rapidjson::Value& batchTableHierarchy) {
+    const rapidjson::Value& batchTableHierarchy,
+    const std::vector<std::string>& propertiesToConvert) {
   // EXT_structural_metadata can't support hierarchy, so we need to flatten
   // it. It also can't support multiple classes with a single set of feature
   // IDs, because IDs can only specify one property table. So essentially
@@ -1671,7 +1685,9 @@ void updateExtensionWithBatchTableHierarchy(
             "3DTILES_batch_table_hierarchy properties are currently "
             "supported.",
             propertyIt->name.GetString()));
-      } else {
+      } else if (shouldConvertProperty(
+                     propertiesToConvert,
+                     propertyIt->name.GetString())) {
         properties.insert(propertyIt->name.GetString());
       }
     }
@@ -1710,6 +1726,7 @@ void convertBatchTableToGltfStructuralMetadataExtension(
     const gsl::span<const std::byte>& batchTableBinaryData,
     CesiumGltf::Model& gltf,
     const int64_t featureCount,
+    const std::vector<std::string>& propertiesToConvert,
     ErrorList& result) {
   // Add the binary part of the batch table - if any - to the glTF as a
   // buffer. We will reallign this buffer later on
@@ -1748,6 +1765,10 @@ void convertBatchTableToGltfStructuralMetadataExtension(
       continue;
     }
 
+    if (!shouldConvertProperty(propertiesToConvert, name)) {
+      continue;
+    }
+
     ClassProperty& classProperty =
         classDefinition.properties.emplace(name, ClassProperty()).first->second;
     classProperty.name = name;
@@ -1796,7 +1817,8 @@ void convertBatchTableToGltfStructuralMetadataExtension(
           classDefinition,
           propertyTable,
           result,
-          bthIt->value);
+          bthIt->value,
+          propertiesToConvert);
     }
   }
 
@@ -1820,7 +1842,8 @@ ErrorList BatchTableToGltfStructuralMetadata::convertFromB3dm(
     const rapidjson::Document& featureTableJson,
     const rapidjson::Document& batchTableJson,
     const gsl::span<const std::byte>& batchTableBinaryData,
-    CesiumGltf::Model& gltf) {
+    CesiumGltf::Model& gltf,
+    const std::vector<std::string>& propertiesToConvert) {
   // Check to make sure a char of rapidjson is 1 byte
   static_assert(
       sizeof(rapidjson::Value::Ch) == 1,
@@ -1850,6 +1873,7 @@ ErrorList BatchTableToGltfStructuralMetadata::convertFromB3dm(
       batchTableBinaryData,
       gltf,
       batchLength,
+      propertiesToConvert,
       result);
 
   // Create an EXT_mesh_features extension for each primitive with a _BATCHID
@@ -1899,7 +1923,8 @@ ErrorList BatchTableToGltfStructuralMetadata::convertFromPnts(
     const rapidjson::Document& featureTableJson,
     const rapidjson::Document& batchTableJson,
     const gsl::span<const std::byte>& batchTableBinaryData,
-    CesiumGltf::Model& gltf) {
+    CesiumGltf::Model& gltf,
+    const std::vector<std::string>& propertiesToConvert) {
   // Check to make sure a char of rapidjson is 1 byte
   static_assert(
       sizeof(rapidjson::Value::Ch) == 1,
@@ -1944,6 +1969,7 @@ ErrorList BatchTableToGltfStructuralMetadata::convertFromPnts(
       batchTableBinaryData,
       gltf,
       featureCount,
+      propertiesToConvert,
       result);
 
   // Create the EXT_mesh_features extension for the single mesh primitive.
@@ -1975,4 +2001,69 @@ ErrorList BatchTableToGltfStructuralMetadata::convertFromPnts(
 
   return result;
 }
+
+ErrorList BatchTableToGltfStructuralMetadata::convertFromI3dm(
+    const rapidjson::Document& featureTableJson,
+    const rapidjson::Document& batchTableJson,
+    const gsl::span<const std::byte>& batchTableBinaryData,
+    CesiumGltf::Model& gltf,
+    const std::vector<std::string>& propertiesToConvert) {
+  // Check to make sure a char of rapidjson is 1 byte
+  static_assert(
+      sizeof(rapidjson::Value::Ch) == 1,
+      "RapidJson::Value::Ch is not 1 byte");
+
+  ErrorList result;
+
+  // Parse the i3dm batch table and convert it to the EXT_structural_metadata
+  // extension.
+
+  const auto instancesLengthIt =
+      featureTableJson.FindMember("INSTANCES_LENGTH");
+  if (instancesLengthIt == featureTableJson.MemberEnd() ||
+      !instancesLengthIt->value.IsInt64()) {
+    result.emplaceError("The I3DM cannot be parsed because there is no valid "
+                        "INSTANCES_LENGTH semantic.");
+    return result;
+  }
+
+  // The batch table has one value per instance, like the feature table.
+  const int64_t featureCount = instancesLengthIt->value.GetInt64();
+
+  convertBatchTableToGltfStructuralMetadataExtension(
+      batchTableJson,
+      batchTableBinaryData,
+      gltf,
+      featureCount,
+      propertiesToConvert,
+      result);
+
+  // Create an EXT_instance_features extension for each instanced node.
+  for (Node& node : gltf.nodes) {
+    ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    if (!pInstancing) {
+      continue;
+    }
+
+    ExtensionExtInstanceFeatures& extension =
+        node.addExtension<ExtensionExtInstanceFeatures>();
+    gltf.addExtensionUsed(ExtensionExtInstanceFeatures::ExtensionName);
+
+    ExtensionExtInstanceFeaturesFeatureId& featureID =
+        extension.featureIds.emplace_back();
+
+    // Without feature IDs, the instance index is the feature ID.
+    featureID.featureCount = featureCount;
+    featureID.propertyTable = 0;
+
+    if (pInstancing->attributes.find("_FEATURE_ID_0") !=
+        pInstancing->attributes.end()) {
+      featureID.attribute = 0;
+      featureID.label = "_FEATURE_ID_0";
+    }
+  }
+
+  return result;
+}
 } // namespace Cesium3DTilesContent
@@ -7,19 +7,38 @@
 #include <rapidjson/document.h>
 
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace Cesium3DTilesContent {
+/**
+ * @brief Converts the batch table of a B3DM, PNTS or I3DM to the
+ * `EXT_structural_metadata` extension of the converted glTF.
+ *
+ * If `propertiesToConvert` isn't empty, only the batch table properties with
+ * these names are converted, and the others are left out of the glTF, so that
+ * they cost nothing to load.
+ */
 struct BatchTableToGltfStructuralMetadata {
   static CesiumUtility::ErrorList convertFromB3dm(
       const rapidjson::Document& featureTableJson,
       const rapidjson::Document& batchTableJson,
       const gsl::span<const std::byte>& batchTableBinaryData,
-      CesiumGltf::Model& gltf);
+      CesiumGltf::Model& gltf,
+      const std::vector<std::string>& propertiesToConvert = {});
 
   static CesiumUtility::ErrorList convertFromPnts(
       const rapidjson::Document& featureTableJson,
       const rapidjson::Document& batchTableJson,
       const gsl::span<const std::byte>& batchTableBinaryData,
-      CesiumGltf::Model& gltf);
+      CesiumGltf::Model& gltf,
+      const std::vector<std::string>& propertiesToConvert = {});
+
+  static CesiumUtility::ErrorList convertFromI3dm(
+      const rapidjson::Document& featureTableJson,
+      const rapidjson::Document& batchTableJson,
+      const gsl::span<const std::byte>& batchTableBinaryData,
+      CesiumGltf::Model& gltf,
+      const std::vector<std::string>& propertiesToConvert = {});
 };
 } // namespace Cesium3DTilesContent
@@ -1,8 +1,16 @@
 #include <Cesium3DTilesContent/CmptToGltfConverter.h>
 #include <Cesium3DTilesContent/GltfConverters.h>
+#include <CesiumGltfReader/decodeInParallel.h>
 
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace Cesium3DTilesContent {
 namespace {
 struct CmptHeader {
@@ -54,7 +62,7 @@ GltfConverterResult CmptToGltfConverter::convert(
     return result;
   }
 
-  std::vector<GltfConverterResult> innerTiles;
+  std::vector<gsl::span<const std::byte>> innerTileData;
   uint32_t pos = sizeof(CmptHeader);
 
   for (uint32_t i = 0; i < pHeader->tilesLength && pos < pHeader->byteLength;
@@ -72,13 +80,39 @@ GltfConverterResult CmptToGltfConverter::convert(
       break;
     }
 
-    const gsl::span<const std::byte> innerData(
-        cmptBinary.data() + pos,
-        pInner->byteLength);
+    innerTileData.emplace_back(cmptBinary.data() + pos, pInner->byteLength);
 
     pos += pInner->byteLength;
+  }
 
-    innerTiles.emplace_back(GltfConverters::convert(innerData, options));
+  // The inner tiles are independent, and each may hold its own Draco payloads
+  // and images, so they are converted in parallel.
+  std::vector<GltfConverterResult> innerTiles(innerTileData.size());
+  std::atomic<bool> canceled{false};
+  CesiumGltfReader::decodeInParallel(
+      innerTileData.size(),
+      options.asyncSystem,
+      std::max(1U, std::thread::hardware_concurrency()),
+      [&innerTileData, &innerTiles, &options, &canceled](size_t i) {
+        if (options.cancellationToken.isCanceled()) {
+          // Don't convert the remaining inner tiles of a tile that is no
+          // longer needed.
+          canceled = true;
+          return;
+        }
+
+        try {
+          innerTiles[i] = GltfConverters::convert(innerTileData[i], options);
+        } catch (const std::exception& e) {
+          innerTiles[i].errors.emplaceWarning(
+              std::string("Composite inner tile conversion failed: ") +
+              e.what());
+        }
+      });
+
+  if (canceled) {
+    result.errors.emplaceError("The composite tile load was canceled.");
+    return result;
   }
 
   uint32_t tilesLength = pHeader->tilesLength;
@@ -96,10 +130,12 @@ GltfConverterResult CmptToGltfConverter::convert(
     return std::move(innerTiles[0]);
   }
 
+  std::vector<CesiumGltf::Model> innerModels;
+  innerModels.reserve(innerTiles.size());
   for (size_t i = 0; i < innerTiles.size(); ++i) {
     if (innerTiles[i].model) {
       if (result.model) {
-        result.model->merge(std::move(*innerTiles[i].model));
+        innerModels.emplace_back(std::move(*innerTiles[i].model));
       } else {
         result.model = std::move(innerTiles[i].model);
       }
@@ -108,6 +144,12 @@ GltfConverterResult CmptToGltfConverter::convert(
     result.errors.merge(innerTiles[i].errors);
   }
 
+  // Merge all of the inner models at once, so that the composite's arrays
+  // are grown only once.
+  if (result.model && !innerModels.empty()) {
+    result.model->merge(std::move(innerModels));
+  }
+
   return result;
 }
 } // namespace Cesium3DTilesContent
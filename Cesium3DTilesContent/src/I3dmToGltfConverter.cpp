@@ -0,0 +1,806 @@
+#include "BatchTableToGltfStructuralMetadata.h"
+
+#include <Cesium3DTilesContent/BinaryToGltfConverter.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
+#include <CesiumGeometry/Transforms.h>
+#include <CesiumGeospatial/GlobeTransforms.h>
+#include <CesiumGltf/ExtensionCesiumRTC.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <rapidjson/document.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesContent {
+namespace {
+struct I3dmHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint32_t byteLength;
+  uint32_t featureTableJsonByteLength;
+  uint32_t featureTableBinaryByteLength;
+  uint32_t batchTableJsonByteLength;
+  uint32_t batchTableBinaryByteLength;
+  uint32_t gltfFormat;
+};
+
+struct I3dmContent {
+  uint32_t instancesLength = 0;
+  std::optional<glm::dvec3> rtcCenter;
+  bool eastNorthUp = false;
+
+  // Relative to the RTC_CENTER, if there is one.
+  std::vector<glm::dvec3> positions;
+
+  // Either empty, or both with one unnormalized vector per instance.
+  std::vector<glm::vec3> normalsUp;
+  std::vector<glm::vec3> normalsRight;
+
+  // Empty if the instances are not scaled.
+  std::vector<glm::vec3> scales;
+
+  gsl::span<const std::byte> batchIds;
+  int32_t batchIdComponentType = Accessor::ComponentType::UNSIGNED_SHORT;
+};
+
+void parseI3dmHeader(
+    const gsl::span<const std::byte>& instancesBinary,
+    I3dmHeader& header,
+    GltfConverterResult& result) {
+  if (instancesBinary.size() < sizeof(I3dmHeader)) {
+    result.errors.emplaceError("The I3DM is invalid because it is too small to "
+                               "include an I3DM header.");
+    return;
+  }
+
+  header = *reinterpret_cast<const I3dmHeader*>(instancesBinary.data());
+
+  if (header.version != 1) {
+    result.errors.emplaceError(fmt::format(
+        "The I3DM is invalid because its version {} is not supported.",
+        header.version));
+    return;
+  }
+
+  if (instancesBinary.size() < header.byteLength) {
+    result.errors.emplaceError(
+        "The I3DM is invalid because the total data available is less than the "
+        "size specified in its header.");
+    return;
+  }
+
+  const uint64_t gltfStart = uint64_t(sizeof(I3dmHeader)) +
+                             header.featureTableJsonByteLength +
+                             header.featureTableBinaryByteLength +
+                             header.batchTableJsonByteLength +
+                             header.batchTableBinaryByteLength;
+  if (gltfStart >= header.byteLength) {
+    result.errors.emplaceError(
+        "The I3DM is invalid because the start of the "
+        "glTF model is after the end of the entire I3DM.");
+    return;
+  }
+
+  if (header.gltfFormat == 0) {
+    result.errors.emplaceError(
+        "The I3DM cannot be loaded because instances of a glTF referenced by "
+        "a URI are not supported.");
+  } else if (header.gltfFormat != 1) {
+    result.errors.emplaceError(fmt::format(
+        "The I3DM is invalid because its glTF format {} is unknown.",
+        header.gltfFormat));
+  }
+}
+
+std::optional<glm::dvec3>
+getGlobalVec3(const rapidjson::Document& featureTableJson, const char* name) {
+  const auto it = featureTableJson.FindMember(name);
+  if (it == featureTableJson.MemberEnd() || !it->value.IsArray() ||
+      it->value.Size() != 3 || !it->value[0].IsNumber() ||
+      !it->value[1].IsNumber() || !it->value[2].IsNumber()) {
+    return std::nullopt;
+  }
+
+  return glm::dvec3(
+      it->value[0].GetDouble(),
+      it->value[1].GetDouble(),
+      it->value[2].GetDouble());
+}
+
+/**
+ * Gets the per-instance values of a semantic from the feature table binary.
+ * Returns std::nullopt if the semantic is not defined, and also adds an error
+ * if it is defined but invalid.
+ */
+std::optional<gsl::span<const std::byte>> getSemanticData(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* semantic,
+    uint32_t instancesLength,
+    size_t elementSize,
+    GltfConverterResult& result) {
+  const auto it = featureTableJson.FindMember(semantic);
+  if (it == featureTableJson.MemberEnd()) {
+    return std::nullopt;
+  }
+
+  const auto byteOffsetIt = it->value.IsObject()
+                                ? it->value.FindMember("byteOffset")
+                                : it->value.MemberEnd();
+  if (!it->value.IsObject() || byteOffsetIt == it->value.MemberEnd() ||
+      !byteOffsetIt->value.IsUint()) {
+    result.errors.emplaceError(fmt::format(
+        "Error parsing I3DM feature table, the {} semantic does not have a "
+        "valid byteOffset.",
+        semantic));
+    return std::nullopt;
+  }
+
+  const uint64_t byteOffset = byteOffsetIt->value.GetUint();
+  const uint64_t byteLength = uint64_t(instancesLength) * elementSize;
+  if (byteOffset > featureTableBinary.size() ||
+      featureTableBinary.size() - byteOffset < byteLength) {
+    result.errors.emplaceError(fmt::format(
+        "Error parsing I3DM feature table, the {} semantic is out of the "
+        "bounds of the feature table binary.",
+        semantic));
+    return std::nullopt;
+  }
+
+  return featureTableBinary.subspan(
+      static_cast<size_t>(byteOffset),
+      static_cast<size_t>(byteLength));
+}
+
+template <typename T>
+gsl::span<const T> asSpanOf(const gsl::span<const std::byte>& data) {
+  return gsl::span<const T>(
+      reinterpret_cast<const T*>(data.data()),
+      data.size() / sizeof(T));
+}
+
+// Decodes like AttributeCompression::octDecodeInRange with a range of 65535,
+// but in single precision and with the fold of the lower hemisphere written
+// without branches, so that the loop can be vectorized.
+void decodeOct32P(
+    const gsl::span<const glm::u16vec2>& encoded,
+    std::vector<glm::vec3>& decoded) {
+  decoded.resize(encoded.size());
+  for (size_t i = 0; i < encoded.size(); i++) {
+    float x = static_cast<float>(encoded[i].x) / 65535.0f * 2.0f - 1.0f;
+    float y = static_cast<float>(encoded[i].y) / 65535.0f * 2.0f - 1.0f;
+    const float z = 1.0f - (std::abs(x) + std::abs(y));
+    const float fold = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -fold : fold;
+    y += y >= 0.0f ? -fold : fold;
+    decoded[i] = glm::vec3(x, y, z);
+  }
+}
+
+void parsePositions(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    I3dmContent& content,
+    GltfConverterResult& result) {
+  const uint32_t instancesLength = content.instancesLength;
+  content.positions.resize(instancesLength);
+
+  std::optional<gsl::span<const std::byte>> maybePositions = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "POSITION",
+      instancesLength,
+      sizeof(glm::vec3),
+      result);
+  if (maybePositions) {
+    const gsl::span<const glm::vec3> positions =
+        asSpanOf<glm::vec3>(*maybePositions);
+    for (size_t i = 0; i < positions.size(); i++) {
+      content.positions[i] = glm::dvec3(positions[i]);
+    }
+    return;
+  }
+
+  if (result.errors) {
+    return;
+  }
+
+  std::optional<gsl::span<const std::byte>> maybeQuantized = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "POSITION_QUANTIZED",
+      instancesLength,
+      sizeof(glm::u16vec3),
+      result);
+  if (!maybeQuantized) {
+    if (!result.errors) {
+      result.errors.emplaceError(
+          "The I3DM is invalid because its feature table has neither a "
+          "POSITION nor a POSITION_QUANTIZED semantic.");
+    }
+    return;
+  }
+
+  const std::optional<glm::dvec3> maybeOffset =
+      getGlobalVec3(featureTableJson, "QUANTIZED_VOLUME_OFFSET");
+  const std::optional<glm::dvec3> maybeScale =
+      getGlobalVec3(featureTableJson, "QUANTIZED_VOLUME_SCALE");
+  if (!maybeOffset || !maybeScale) {
+    result.errors.emplaceError(
+        "The I3DM is invalid because it has quantized positions but no valid "
+        "QUANTIZED_VOLUME_OFFSET and QUANTIZED_VOLUME_SCALE semantics.");
+    return;
+  }
+
+  const gsl::span<const glm::u16vec3> quantized =
+      asSpanOf<glm::u16vec3>(*maybeQuantized);
+  const glm::dvec3 offset = *maybeOffset;
+  const glm::dvec3 step = *maybeScale / 65535.0;
+  for (size_t i = 0; i < quantized.size(); i++) {
+    content.positions[i] = offset + glm::dvec3(quantized[i]) * step;
+  }
+}
+
+void parseNormals(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    I3dmContent& content,
+    GltfConverterResult& result) {
+  const uint32_t instancesLength = content.instancesLength;
+
+  std::optional<gsl::span<const std::byte>> maybeUp = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "NORMAL_UP",
+      instancesLength,
+      sizeof(glm::vec3),
+      result);
+  std::optional<gsl::span<const std::byte>> maybeRight = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "NORMAL_RIGHT",
+      instancesLength,
+      sizeof(glm::vec3),
+      result);
+  if (maybeUp && maybeRight) {
+    const gsl::span<const glm::vec3> up = asSpanOf<glm::vec3>(*maybeUp);
+    const gsl::span<const glm::vec3> right = asSpanOf<glm::vec3>(*maybeRight);
+    content.normalsUp.assign(up.begin(), up.end());
+    content.normalsRight.assign(right.begin(), right.end());
+    return;
+  }
+
+  std::optional<gsl::span<const std::byte>> maybeUpOct = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "NORMAL_UP_OCT32P",
+      instancesLength,
+      sizeof(glm::u16vec2),
+      result);
+  std::optional<gsl::span<const std::byte>> maybeRightOct = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "NORMAL_RIGHT_OCT32P",
+      instancesLength,
+      sizeof(glm::u16vec2),
+      result);
+  if (maybeUpOct && maybeRightOct) {
+    decodeOct32P(asSpanOf<glm::u16vec2>(*maybeUpOct), content.normalsUp);
+    decodeOct32P(asSpanOf<glm::u16vec2>(*maybeRightOct), content.normalsRight);
+    return;
+  }
+
+  if (maybeUp || maybeRight || maybeUpOct || maybeRightOct) {
+    result.errors.emplaceWarning(
+        "The I3DM defines only one of the up and right vectors of its "
+        "instances, so the instances are not rotated.");
+  }
+}
+
+void parseScales(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    I3dmContent& content,
+    GltfConverterResult& result) {
+  const uint32_t instancesLength = content.instancesLength;
+
+  std::optional<gsl::span<const std::byte>> maybeNonUniform = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "SCALE_NON_UNIFORM",
+      instancesLength,
+      sizeof(glm::vec3),
+      result);
+  if (maybeNonUniform) {
+    const gsl::span<const glm::vec3> scales =
+        asSpanOf<glm::vec3>(*maybeNonUniform);
+    content.scales.assign(scales.begin(), scales.end());
+    return;
+  }
+
+  std::optional<gsl::span<const std::byte>> maybeUniform = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "SCALE",
+      instancesLength,
+      sizeof(float),
+      result);
+  if (maybeUniform) {
+    const gsl::span<const float> scales = asSpanOf<float>(*maybeUniform);
+    content.scales.resize(scales.size());
+    for (size_t i = 0; i < scales.size(); i++) {
+      content.scales[i] = glm::vec3(scales[i]);
+    }
+  }
+}
+
+void parseBatchIds(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    I3dmContent& content,
+    GltfConverterResult& result) {
+  const auto batchIdIt = featureTableJson.FindMember("BATCH_ID");
+  if (batchIdIt == featureTableJson.MemberEnd() ||
+      !batchIdIt->value.IsObject()) {
+    return;
+  }
+
+  const auto componentTypeIt = batchIdIt->value.FindMember("componentType");
+  if (componentTypeIt != batchIdIt->value.MemberEnd()) {
+    const std::string componentType = componentTypeIt->value.IsString()
+                                          ? componentTypeIt->value.GetString()
+                                          : "";
+    if (componentType == "UNSIGNED_BYTE") {
+      content.batchIdComponentType = Accessor::ComponentType::UNSIGNED_BYTE;
+    } else if (componentType == "UNSIGNED_INT") {
+      content.batchIdComponentType = Accessor::ComponentType::UNSIGNED_INT;
+    } else if (componentType != "UNSIGNED_SHORT") {
+      result.errors.emplaceWarning(
+          "Error parsing I3DM feature table, BATCH_ID componentType is defined "
+          "but is not UNSIGNED_BYTE, UNSIGNED_SHORT, or UNSIGNED_INT. Skip "
+          "parsing batch IDs.");
+      return;
+    }
+  }
+
+  std::optional<gsl::span<const std::byte>> maybeBatchIds = getSemanticData(
+      featureTableJson,
+      featureTableBinary,
+      "BATCH_ID",
+      content.instancesLength,
+      static_cast<size_t>(
+          Accessor::computeByteSizeOfComponent(content.batchIdComponentType)),
+      result);
+  if (maybeBatchIds) {
+    content.batchIds = *maybeBatchIds;
+  }
+}
+
+void parseFeatureTable(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary,
+    I3dmContent& content,
+    GltfConverterResult& result) {
+  const auto instancesLengthIt =
+      featureTableJson.FindMember("INSTANCES_LENGTH");
+  if (instancesLengthIt == featureTableJson.MemberEnd() ||
+      !instancesLengthIt->value.IsUint()) {
+    result.errors.emplaceError("The I3DM cannot be parsed because there is no "
+                               "valid INSTANCES_LENGTH semantic.");
+    return;
+  }
+
+  content.instancesLength = instancesLengthIt->value.GetUint();
+  content.rtcCenter = getGlobalVec3(featureTableJson, "RTC_CENTER");
+
+  const auto eastNorthUpIt = featureTableJson.FindMember("EAST_NORTH_UP");
+  content.eastNorthUp = eastNorthUpIt != featureTableJson.MemberEnd() &&
+                        eastNorthUpIt->value.IsBool() &&
+                        eastNorthUpIt->value.GetBool();
+
+  parsePositions(featureTableJson, featureTableBinary, content, result);
+  parseNormals(featureTableJson, featureTableBinary, content, result);
+  parseScales(featureTableJson, featureTableBinary, content, result);
+  parseBatchIds(featureTableJson, featureTableBinary, content, result);
+}
+
+/**
+ * Computes the transform of each instance in the coordinate system of the
+ * tile, relative to the given center so that it can be stored in single
+ * precision.
+ */
+std::vector<glm::dmat4> computeInstanceTransforms(
+    const I3dmContent& content,
+    const glm::dvec3& center) {
+  const glm::dvec3 rtcCenter = content.rtcCenter.value_or(glm::dvec3(0.0));
+
+  std::vector<glm::dmat4> transforms(content.instancesLength);
+  for (size_t i = 0; i < transforms.size(); i++) {
+    glm::dmat3 rotation(1.0);
+    if (!content.normalsUp.empty()) {
+      const glm::dvec3 up = glm::normalize(glm::dvec3(content.normalsUp[i]));
+      const glm::dvec3 right =
+          glm::normalize(glm::dvec3(content.normalsRight[i]));
+      rotation = glm::dmat3(right, up, glm::cross(right, up));
+    } else if (content.eastNorthUp) {
+      rotation = glm::dmat3(
+          CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(
+              rtcCenter + content.positions[i]));
+    }
+
+    glm::dmat4& transform = transforms[i];
+    transform = glm::dmat4(rotation);
+    if (!content.scales.empty()) {
+      const glm::dvec3 scale(content.scales[i]);
+      transform[0] *= scale.x;
+      transform[1] *= scale.y;
+      transform[2] *= scale.z;
+    }
+    transform[3] = glm::dvec4(content.positions[i] - center, 1.0);
+  }
+
+  return transforms;
+}
+
+void decomposeTransform(
+    const glm::dmat4& transform,
+    glm::vec3& translation,
+    glm::vec4& rotation,
+    glm::vec3& scale) {
+  glm::dmat3 rotationScale(transform);
+  glm::dvec3 scaleDouble(
+      glm::length(rotationScale[0]),
+      glm::length(rotationScale[1]),
+      glm::length(rotationScale[2]));
+  if (glm::determinant(rotationScale) < 0.0) {
+    scaleDouble.x = -scaleDouble.x;
+  }
+
+  for (glm::length_t i = 0; i < 3; i++) {
+    if (scaleDouble[i] != 0.0) {
+      rotationScale[i] /= scaleDouble[i];
+    }
+  }
+
+  const glm::dquat quaternion = glm::normalize(glm::quat_cast(rotationScale));
+  translation = glm::vec3(transform[3]);
+  rotation = glm::vec4(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
+  scale = glm::vec3(scaleDouble);
+}
+
+int32_t addAccessorToGltf(
+    Model& gltf,
+    int32_t bufferId,
+    size_t byteOffset,
+    size_t byteLength,
+    int32_t componentType,
+    int64_t count,
+    const std::string& type) {
+  const int32_t bufferViewId = static_cast<int32_t>(gltf.bufferViews.size());
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = bufferId;
+  bufferView.byteOffset = static_cast<int64_t>(byteOffset);
+  bufferView.byteLength = static_cast<int64_t>(byteLength);
+
+  const int32_t accessorId = static_cast<int32_t>(gltf.accessors.size());
+  Accessor& accessor = gltf.accessors.emplace_back();
+  accessor.bufferView = bufferViewId;
+  accessor.componentType = componentType;
+  accessor.count = count;
+  accessor.type = type;
+
+  return accessorId;
+}
+
+/**
+ * Adds the `TRANSLATION`, `ROTATION` and `SCALE` attributes of the instances of
+ * a node with the given transform, which are the instance transforms in the
+ * coordinate system of the node, where they are applied.
+ */
+std::unordered_map<std::string, int32_t> addInstanceAttributesToGltf(
+    Model& gltf,
+    const std::vector<glm::dmat4>& instanceTransforms,
+    const glm::dmat4& nodeToTile) {
+  const glm::dmat4 tileToNode = glm::inverse(nodeToTile);
+  const size_t count = instanceTransforms.size();
+  const size_t translationsByteLength = count * sizeof(glm::vec3);
+  const size_t rotationsByteLength = count * sizeof(glm::vec4);
+  const size_t scalesByteLength = count * sizeof(glm::vec3);
+
+  std::vector<std::byte> data(
+      translationsByteLength + rotationsByteLength + scalesByteLength);
+  glm::vec3* pTranslations = reinterpret_cast<glm::vec3*>(data.data());
+  glm::vec4* pRotations =
+      reinterpret_cast<glm::vec4*>(data.data() + translationsByteLength);
+  glm::vec3* pScales = reinterpret_cast<glm::vec3*>(
+      data.data() + translationsByteLength + rotationsByteLength);
+
+  for (size_t i = 0; i < count; i++) {
+    decomposeTransform(
+        tileToNode * instanceTransforms[i] * nodeToTile,
+        pTranslations[i],
+        pRotations[i],
+        pScales[i]);
+  }
+
+  const int32_t bufferId = static_cast<int32_t>(gltf.buffers.size());
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(data.size());
+  buffer.cesium.data = std::move(data);
+
+  const int64_t accessorCount = static_cast<int64_t>(count);
+  std::unordered_map<std::string, int32_t> attributes;
+  attributes["TRANSLATION"] = addAccessorToGltf(
+      gltf,
+      bufferId,
+      0,
+      translationsByteLength,
+      Accessor::ComponentType::FLOAT,
+      accessorCount,
+      Accessor::Type::VEC3);
+  attributes["ROTATION"] = addAccessorToGltf(
+      gltf,
+      bufferId,
+      translationsByteLength,
+      rotationsByteLength,
+      Accessor::ComponentType::FLOAT,
+      accessorCount,
+      Accessor::Type::VEC4);
+  attributes["SCALE"] = addAccessorToGltf(
+      gltf,
+      bufferId,
+      translationsByteLength + rotationsByteLength,
+      scalesByteLength,
+      Accessor::ComponentType::FLOAT,
+      accessorCount,
+      Accessor::Type::VEC3);
+  return attributes;
+}
+
+int32_t addBatchIdsToGltf(Model& gltf, const I3dmContent& content) {
+  const int32_t bufferId = static_cast<int32_t>(gltf.buffers.size());
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(content.batchIds.size());
+  buffer.cesium.data.assign(content.batchIds.begin(), content.batchIds.end());
+
+  return addAccessorToGltf(
+      gltf,
+      bufferId,
+      0,
+      content.batchIds.size(),
+      content.batchIdComponentType,
+      static_cast<int64_t>(content.instancesLength),
+      Accessor::Type::SCALAR);
+}
+
+void findMeshNodes(
+    const Model& gltf,
+    int32_t nodeId,
+    const glm::dmat4& parentTransform,
+    std::vector<bool>& visited,
+    std::vector<std::pair<int32_t, glm::dmat4>>& meshNodes) {
+  if (nodeId < 0 || size_t(nodeId) >= gltf.nodes.size() ||
+      visited[size_t(nodeId)]) {
+    return;
+  }
+  visited[size_t(nodeId)] = true;
+
+  const Node& node = gltf.nodes[size_t(nodeId)];
+  const glm::dmat4 transform =
+      parentTransform * CesiumGltfContent::GltfUtilities::getNodeTransform(node)
+                            .value_or(glm::dmat4(1.0));
+  if (node.mesh >= 0) {
+    meshNodes.emplace_back(nodeId, transform);
+  }
+
+  for (int32_t childId : node.children) {
+    findMeshNodes(gltf, childId, transform, visited, meshNodes);
+  }
+}
+
+void addInstancesToGltf(const I3dmContent& content, Model& gltf) {
+  // Store the instance positions relative to the center of their bounds, so
+  // that they keep their precision in single precision even when the tile
+  // has no RTC_CENTER.
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (const glm::dvec3& position : content.positions) {
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+  const glm::dvec3 center =
+      content.positions.empty() ? glm::dvec3(0.0) : (minimum + maximum) * 0.5;
+
+  const glm::dvec3 rtcCenter =
+      content.rtcCenter.value_or(glm::dvec3(0.0)) + center;
+  if (content.rtcCenter || rtcCenter != glm::dvec3(0.0)) {
+    ExtensionCesiumRTC& cesiumRTC = gltf.addExtension<ExtensionCesiumRTC>();
+    gltf.addExtensionRequired(ExtensionCesiumRTC::ExtensionName);
+    cesiumRTC.center = {rtcCenter.x, rtcCenter.y, rtcCenter.z};
+  }
+
+  const std::vector<glm::dmat4> instanceTransforms =
+      computeInstanceTransforms(content, center);
+
+  // Instancing is a property of nodes, so give each mesh of a glTF without
+  // nodes a node of its own.
+  if (gltf.nodes.empty() && !gltf.meshes.empty()) {
+    gltf.scene = static_cast<int32_t>(gltf.scenes.size());
+    Scene& scene = gltf.scenes.emplace_back();
+    for (size_t i = 0; i < gltf.meshes.size(); i++) {
+      scene.nodes.emplace_back(static_cast<int32_t>(gltf.nodes.size()));
+      gltf.nodes.emplace_back().mesh = static_cast<int32_t>(i);
+    }
+  }
+
+  std::vector<bool> visited(gltf.nodes.size(), false);
+  std::vector<std::pair<int32_t, glm::dmat4>> meshNodes;
+  gltf.forEachRootNodeInScene(-1, [&](Model& model, Node& node) {
+    findMeshNodes(
+        model,
+        static_cast<int32_t>(&node - model.nodes.data()),
+        glm::dmat4(1.0),
+        visited,
+        meshNodes);
+  });
+
+  std::optional<int32_t> batchIdAccessor;
+  if (!content.batchIds.empty()) {
+    batchIdAccessor = addBatchIdsToGltf(gltf, content);
+  }
+
+  // The instances are transformed in the Z-up coordinate system of the tile,
+  // after the glTF's Y-up coordinates are converted to it. Nodes that share a
+  // transform, as most meshes of a model usually do, share the attributes.
+  std::vector<std::pair<glm::dmat4, std::unordered_map<std::string, int32_t>>>
+      attributesByTransform;
+  for (const auto& [nodeId, nodeTransform] : meshNodes) {
+    const glm::dmat4 nodeToTile =
+        CesiumGeometry::Transforms::Y_UP_TO_Z_UP * nodeTransform;
+    auto attributesIt = std::find_if(
+        attributesByTransform.begin(),
+        attributesByTransform.end(),
+        [&nodeToTile](const auto& entry) { return entry.first == nodeToTile; });
+    if (attributesIt == attributesByTransform.end()) {
+      attributesByTransform.emplace_back(
+          nodeToTile,
+          addInstanceAttributesToGltf(gltf, instanceTransforms, nodeToTile));
+      attributesIt = attributesByTransform.end() - 1;
+    }
+
+    Node& node = gltf.nodes[size_t(nodeId)];
+    ExtensionExtMeshGpuInstancing& instancing =
+        node.addExtension<ExtensionExtMeshGpuInstancing>();
+    instancing.attributes = attributesIt->second;
+    if (batchIdAccessor) {
+      instancing.attributes["_FEATURE_ID_0"] = *batchIdAccessor;
+    }
+  }
+
+  if (!meshNodes.empty()) {
+    gltf.addExtensionUsed(ExtensionExtMeshGpuInstancing::ExtensionName);
+    gltf.addExtensionRequired(ExtensionExtMeshGpuInstancing::ExtensionName);
+  }
+}
+
+rapidjson::Document parseFeatureTableJson(
+    const gsl::span<const std::byte>& featureTableJsonData,
+    GltfConverterResult& result) {
+  rapidjson::Document document;
+  document.Parse(
+      reinterpret_cast<const char*>(featureTableJsonData.data()),
+      featureTableJsonData.size());
+  if (document.HasParseError()) {
+    result.errors.emplaceError(fmt::format(
+        "Error when parsing feature table JSON, error code {} at byte offset "
+        "{}",
+        document.GetParseError(),
+        document.GetErrorOffset()));
+  }
+  return document;
+}
+
+void convertI3dmMetadataToGltfStructuralMetadata(
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& batchTableJsonData,
+    const gsl::span<const std::byte>& batchTableBinaryData,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    GltfConverterResult& result) {
+  if (!result.model || batchTableJsonData.empty()) {
+    return;
+  }
+
+  rapidjson::Document batchTableJson;
+  batchTableJson.Parse(
+      reinterpret_cast<const char*>(batchTableJsonData.data()),
+      batchTableJsonData.size());
+  if (batchTableJson.HasParseError()) {
+    result.errors.emplaceWarning(fmt::format(
+        "Error when parsing batch table JSON, error code {} at byte "
+        "offset {}. Skip parsing metadata",
+        batchTableJson.GetParseError(),
+        batchTableJson.GetErrorOffset()));
+    return;
+  }
+
+  // upgrade batch table to glTF structural metadata and append the result
+  result.errors.merge(BatchTableToGltfStructuralMetadata::convertFromI3dm(
+      featureTableJson,
+      batchTableJson,
+      batchTableBinaryData,
+      *result.model,
+      options.batchTableProperties));
+}
+} // namespace
+
+GltfConverterResult I3dmToGltfConverter::convert(
+    const gsl::span<const std::byte>& instancesBinary,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  GltfConverterResult result;
+  I3dmHeader header;
+  parseI3dmHeader(instancesBinary, header, result);
+  if (result.errors) {
+    return result;
+  }
+
+  size_t offset = sizeof(I3dmHeader);
+  const gsl::span<const std::byte> featureTableJsonData =
+      instancesBinary.subspan(offset, header.featureTableJsonByteLength);
+  offset += header.featureTableJsonByteLength;
+  const gsl::span<const std::byte> featureTableBinaryData =
+      instancesBinary.subspan(offset, header.featureTableBinaryByteLength);
+  offset += header.featureTableBinaryByteLength;
+  const gsl::span<const std::byte> batchTableJsonData =
+      instancesBinary.subspan(offset, header.batchTableJsonByteLength);
+  offset += header.batchTableJsonByteLength;
+  const gsl::span<const std::byte> batchTableBinaryData =
+      instancesBinary.subspan(offset, header.batchTableBinaryByteLength);
+  offset += header.batchTableBinaryByteLength;
+  const gsl::span<const std::byte> gltfData =
+      instancesBinary.subspan(offset, header.byteLength - offset);
+
+  rapidjson::Document featureTableJson =
+      parseFeatureTableJson(featureTableJsonData, result);
+  if (result.errors) {
+    return result;
+  }
+
+  I3dmContent content;
+  parseFeatureTable(featureTableJson, featureTableBinaryData, content, result);
+  if (result.errors) {
+    return result;
+  }
+
+  GltfConverterResult gltfResult =
+      BinaryToGltfConverter::convert(gltfData, options);
+  result.model = std::move(gltfResult.model);
+  result.errors.merge(std::move(gltfResult.errors));
+  if (result.errors || !result.model) {
+    return result;
+  }
+
+  addInstancesToGltf(content, *result.model);
+
+  convertI3dmMetadataToGltfStructuralMetadata(
+      featureTableJson,
+      batchTableJsonData,
+      batchTableBinaryData,
+      options,
+      result);
+
+  return result;
+}
+} // namespace Cesium3DTilesContent
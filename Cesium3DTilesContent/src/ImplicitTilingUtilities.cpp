@@ -6,7 +6,6 @@
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/S2CellBoundingVolume.h>
-#include <CesiumUtility/Uri.h>
 
 #include <libmorton/morton.h>
 
@@ -19,9 +18,28 @@ std::string ImplicitTilingUtilities::resolveUrl(
     const std::string& baseUrl,
     const std::string& urlTemplate,
     const QuadtreeTileID& quadtreeID) {
-  std::string url = CesiumUtility::Uri::substituteTemplateParameters(
-      urlTemplate,
-      [&quadtreeID](const std::string& placeholder) {
+  return resolveUrl(
+      CesiumUtility::UriResolver(baseUrl),
+      CesiumUtility::UriTemplate(urlTemplate),
+      quadtreeID);
+}
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const std::string& baseUrl,
+    const std::string& urlTemplate,
+    const OctreeTileID& octreeID) {
+  return resolveUrl(
+      CesiumUtility::UriResolver(baseUrl),
+      CesiumUtility::UriTemplate(urlTemplate),
+      octreeID);
+}
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const CesiumUtility::UriResolver& baseUrl,
+    const CesiumUtility::UriTemplate& urlTemplate,
+    const QuadtreeTileID& quadtreeID) {
+  std::string url =
+      urlTemplate.substitute([&quadtreeID](const std::string& placeholder) {
         if (placeholder == "level") {
           return std::to_string(quadtreeID.level);
         }
@@ -35,16 +53,15 @@ std::string ImplicitTilingUtilities::resolveUrl(
         return placeholder;
       });
 
-  return CesiumUtility::Uri::resolve(baseUrl, url);
+  return baseUrl.resolve(url);
 }
 
 std::string ImplicitTilingUtilities::resolveUrl(
-    const std::string& baseUrl,
-    const std::string& urlTemplate,
+    const CesiumUtility::UriResolver& baseUrl,
+    const CesiumUtility::UriTemplate& urlTemplate,
     const OctreeTileID& octreeID) {
-  std::string url = CesiumUtility::Uri::substituteTemplateParameters(
-      urlTemplate,
-      [&octreeID](const std::string& placeholder) {
+  std::string url =
+      urlTemplate.substitute([&octreeID](const std::string& placeholder) {
         if (placeholder == "level") {
           return std::to_string(octreeID.level);
         }
@@ -61,7 +78,7 @@ std::string ImplicitTilingUtilities::resolveUrl(
         return placeholder;
       });
 
-  return CesiumUtility::Uri::resolve(baseUrl, url);
+  return baseUrl.resolve(url);
 }
 
 uint64_t ImplicitTilingUtilities::computeMortonIndex(
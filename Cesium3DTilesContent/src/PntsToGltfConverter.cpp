@@ -4,8 +4,8 @@
 #include <CesiumGeometry/Transforms.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionKhrMaterialsUnlit.h>
-#include <CesiumUtility/AttributeCompression.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumUtility/ScratchVector.h>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,7 +24,12 @@
 #include <rapidjson/document.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <numeric>
+#include <random>
 
 using namespace CesiumGltf;
 using namespace CesiumUtility;
@@ -198,6 +203,22 @@ template <typename TColor> TColor srgbToLinear(const TColor srgb) {
   }
 }
 
+// The linear values of the sRGB values that a channel with the given number of
+// bits can hold, so that colors are converted with a table lookup per channel
+// rather than a call to std::pow.
+template <size_t Bits>
+const std::array<float, (1 << Bits)>& srgbToLinearTable() {
+  static const std::array<float, (1 << Bits)> table = []() {
+    constexpr float maximum = static_cast<float>((1 << Bits) - 1);
+    std::array<float, (1 << Bits)> result{};
+    for (size_t i = 0; i < result.size(); i++) {
+      result[i] = std::pow(static_cast<float>(i) / maximum, 2.2f);
+    }
+    return result;
+  }();
+  return table;
+}
+
 struct PntsContent {
   uint32_t pointsLength = 0;
   std::optional<glm::dvec3> rtcCenter;
@@ -208,6 +229,9 @@ struct PntsContent {
 
   PntsSemantic position;
   bool positionQuantized = false;
+  // Whether quantized positions are kept as they are, with the
+  // KHR_mesh_quantization extension, instead of being dequantized.
+  bool keepPositionsQuantized = false;
   // required by glTF spec
   glm::vec3 positionMin = glm::vec3(std::numeric_limits<float>::max());
   glm::vec3 positionMax = glm::vec3(std::numeric_limits<float>::lowest());
@@ -1089,27 +1113,53 @@ void parsePositionsFromFeatureTableBinary(
   std::vector<std::byte>& positionData = parsedContent.position.data;
   if (positionData.size() > 0) {
     // If data isn't empty, it must have been decoded from Draco.
+    parsedContent.keepPositionsQuantized = false;
     return;
   }
 
-  const uint32_t pointsLength = parsedContent.pointsLength;
-  const size_t positionsByteStride = sizeof(glm::vec3);
-  const size_t positionsByteLength = pointsLength * positionsByteStride;
-  positionData.resize(positionsByteLength);
+  if (!parsedContent.positionQuantized) {
+    parsedContent.keepPositionsQuantized = false;
+  }
 
-  gsl::span<glm::vec3> outPositions(
-      reinterpret_cast<glm::vec3*>(positionData.data()),
-      pointsLength);
+  const uint32_t pointsLength = parsedContent.pointsLength;
 
   if (parsedContent.positionQuantized) {
-    // PERFORMANCE_IDEA: In the future, it might be more performant to detect
-    // if the recipient engine can handle dequantization itself, and if so, use
-    // the KHR_mesh_quantization extension to avoid dequantizing here.
     const gsl::span<const glm::u16vec3> quantizedPositions(
         reinterpret_cast<const glm::u16vec3*>(
             featureTableBinaryData.data() + parsedContent.position.byteOffset),
         pointsLength);
 
+    // The accessor min / max is found among the quantized values, which is
+    // cheaper than comparing floats and gives the same result, because
+    // dequantizing is monotonic in each component.
+    glm::u16vec3 quantizedMin(std::numeric_limits<uint16_t>::max());
+    glm::u16vec3 quantizedMax(0);
+
+    if (parsedContent.keepPositionsQuantized) {
+      // KHR_mesh_quantization requires each element to start on a four-byte
+      // boundary, so pad each position to four components.
+      positionData.resize(pointsLength * sizeof(glm::u16vec4));
+      gsl::span<glm::u16vec4> outPositions(
+          reinterpret_cast<glm::u16vec4*>(positionData.data()),
+          pointsLength);
+
+      for (size_t i = 0; i < pointsLength; i++) {
+        const glm::u16vec3 quantizedPosition = quantizedPositions[i];
+        outPositions[i] = glm::u16vec4(quantizedPosition, 0);
+        quantizedMin = glm::min(quantizedMin, quantizedPosition);
+        quantizedMax = glm::max(quantizedMax, quantizedPosition);
+      }
+
+      parsedContent.positionMin = glm::vec3(quantizedMin);
+      parsedContent.positionMax = glm::vec3(quantizedMax);
+      return;
+    }
+
+    positionData.resize(pointsLength * sizeof(glm::vec3));
+    gsl::span<glm::vec3> outPositions(
+        reinterpret_cast<glm::vec3*>(positionData.data()),
+        pointsLength);
+
     const glm::vec3 quantizedVolumeScale(
         parsedContent.quantizedVolumeScale.value());
     const glm::vec3 quantizedVolumeOffset(
@@ -1118,32 +1168,43 @@ void parsePositionsFromFeatureTableBinary(
     const glm::vec3 quantizedPositionScalar = quantizedVolumeScale / 65535.0f;
 
     for (size_t i = 0; i < pointsLength; i++) {
-      const glm::vec3 quantizedPosition(
-          quantizedPositions[i].x,
-          quantizedPositions[i].y,
-          quantizedPositions[i].z);
-
-      const glm::vec3 dequantizedPosition =
-          quantizedPosition * quantizedPositionScalar + quantizedVolumeOffset;
-      outPositions[i] = dequantizedPosition;
-      parsedContent.positionMin =
-          glm::min(parsedContent.positionMin, dequantizedPosition);
-      parsedContent.positionMax =
-          glm::max(parsedContent.positionMax, dequantizedPosition);
+      const glm::u16vec3 quantizedPosition = quantizedPositions[i];
+      outPositions[i] = glm::vec3(quantizedPosition) * quantizedPositionScalar +
+                        quantizedVolumeOffset;
+      quantizedMin = glm::min(quantizedMin, quantizedPosition);
+      quantizedMax = glm::max(quantizedMax, quantizedPosition);
+    }
+
+    if (pointsLength > 0) {
+      const glm::vec3 dequantizedMin =
+          glm::vec3(quantizedMin) * quantizedPositionScalar +
+          quantizedVolumeOffset;
+      const glm::vec3 dequantizedMax =
+          glm::vec3(quantizedMax) * quantizedPositionScalar +
+          quantizedVolumeOffset;
+      // A negative scale swaps the extremes.
+      parsedContent.positionMin = glm::min(dequantizedMin, dequantizedMax);
+      parsedContent.positionMax = glm::max(dequantizedMin, dequantizedMax);
     }
   } else {
-    // The position accessor min / max is required by the glTF spec, so
-    // use a for loop instead of std::memcpy.
+    positionData.resize(pointsLength * sizeof(glm::vec3));
+    std::memcpy(
+        positionData.data(),
+        featureTableBinaryData.data() + parsedContent.position.byteOffset,
+        positionData.size());
+
+    // The position accessor min / max is required by the glTF spec.
     const gsl::span<const glm::vec3> positions(
-        reinterpret_cast<const glm::vec3*>(
-            featureTableBinaryData.data() + parsedContent.position.byteOffset),
+        reinterpret_cast<const glm::vec3*>(positionData.data()),
         pointsLength);
+    glm::vec3 positionMin = parsedContent.positionMin;
+    glm::vec3 positionMax = parsedContent.positionMax;
     for (size_t i = 0; i < pointsLength; i++) {
-      const glm::vec3 position = positions[i];
-      outPositions[i] = position;
-      parsedContent.positionMin = glm::min(parsedContent.positionMin, position);
-      parsedContent.positionMax = glm::max(parsedContent.positionMax, position);
+      positionMin = glm::min(positionMin, positions[i]);
+      positionMax = glm::max(positionMax, positions[i]);
     }
+    parsedContent.positionMin = positionMin;
+    parsedContent.positionMax = positionMax;
   }
 }
 
@@ -1173,9 +1234,14 @@ void parseColorsFromFeatureTableBinary(
         reinterpret_cast<glm::vec4*>(colorData.data()),
         pointsLength);
 
+    const std::array<float, 256>& toLinear = srgbToLinearTable<8>();
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec4 normalizedColor = glm::vec4(rgbaColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      const glm::u8vec4 rgbaColor = rgbaColors[i];
+      outColors[i] = glm::vec4(
+          toLinear[rgbaColor.r],
+          toLinear[rgbaColor.g],
+          toLinear[rgbaColor.b],
+          static_cast<float>(rgbaColor.a) / 255.0f);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB) {
     const gsl::span<const glm::u8vec3> rgbColors(
@@ -1186,12 +1252,15 @@ void parseColorsFromFeatureTableBinary(
         reinterpret_cast<glm::vec3*>(colorData.data()),
         pointsLength);
 
+    const std::array<float, 256>& toLinear = srgbToLinearTable<8>();
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec3 normalizedColor = glm::vec3(rgbColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      const glm::u8vec3 rgbColor = rgbColors[i];
+      outColors[i] = glm::vec3(
+          toLinear[rgbColor.r],
+          toLinear[rgbColor.g],
+          toLinear[rgbColor.b]);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB565) {
-
     const gsl::span<const uint16_t> compressedColors(
         reinterpret_cast<const uint16_t*>(
             featureTableBinaryData.data() + color.byteOffset),
@@ -1200,11 +1269,15 @@ void parseColorsFromFeatureTableBinary(
         reinterpret_cast<glm::vec3*>(colorData.data()),
         pointsLength);
 
+    // Unpacks the channels like AttributeCompression::decodeRGB565.
+    const std::array<float, 32>& fiveBitsToLinear = srgbToLinearTable<5>();
+    const std::array<float, 64>& sixBitsToLinear = srgbToLinearTable<6>();
     for (size_t i = 0; i < pointsLength; i++) {
       const uint16_t compressedColor = compressedColors[i];
-      glm::vec3 decompressedColor =
-          glm::vec3(AttributeCompression::decodeRGB565(compressedColor));
-      outColors[i] = srgbToLinear(decompressedColor);
+      outColors[i] = glm::vec3(
+          fiveBitsToLinear[static_cast<size_t>(compressedColor >> 11)],
+          sixBitsToLinear[static_cast<size_t>((compressedColor >> 5) & 0x3f)],
+          fiveBitsToLinear[static_cast<size_t>(compressedColor & 0x1f)]);
     }
   }
 }
@@ -1234,11 +1307,17 @@ void parseNormalsFromFeatureTableBinary(
         reinterpret_cast<glm::vec3*>(normalData.data()),
         pointsLength);
 
+    // Decodes like AttributeCompression::octDecode, but in single precision
+    // and with the fold of the lower hemisphere written without branches.
     for (size_t i = 0; i < pointsLength; i++) {
       const glm::u8vec2 encodedNormal = encodedNormals[i];
-      outNormals[i] = glm::vec3(CesiumUtility::AttributeCompression::octDecode(
-          encodedNormal.x,
-          encodedNormal.y));
+      float x = static_cast<float>(encodedNormal.x) / 255.0f * 2.0f - 1.0f;
+      float y = static_cast<float>(encodedNormal.y) / 255.0f * 2.0f - 1.0f;
+      const float z = 1.0f - (std::abs(x) + std::abs(y));
+      const float fold = std::max(-z, 0.0f);
+      x += x >= 0.0f ? -fold : fold;
+      y += y >= 0.0f ? -fold : fold;
+      outNormals[i] = glm::normalize(glm::vec3(x, y, z));
     }
   } else {
     std::memcpy(
@@ -1300,6 +1379,80 @@ void parseFeatureTableBinary(
   }
 }
 
+void permutePoints(
+    std::vector<std::byte>& data,
+    const std::vector<uint32_t>& permutation) {
+  if (permutation.empty() || data.size() % permutation.size() != 0) {
+    return;
+  }
+
+  const size_t elementSize = data.size() / permutation.size();
+
+  // Swapping gives the original buffer to the scratch pool, where the next
+  // property of the same size will reuse it.
+  ScratchVector<std::byte> permuted;
+  permuted->resize(data.size());
+  for (size_t i = 0; i < permutation.size(); ++i) {
+    std::memcpy(
+        permuted->data() + i * elementSize,
+        data.data() + static_cast<size_t>(permutation[i]) * elementSize,
+        elementSize);
+  }
+
+  data.swap(*permuted);
+}
+
+// Randomly permutes the points, so that any prefix of them is a uniform
+// subsample of the point cloud. The generator is seeded with the number of
+// points, so a tile is shuffled the same way every time it is converted.
+void shufflePoints(PntsContent& parsedContent, bool hasPerPointProperties) {
+  const uint32_t pointsLength = parsedContent.pointsLength;
+  ScratchVector<uint32_t> permutationScratch;
+  std::vector<uint32_t>& permutation = *permutationScratch;
+  permutation.resize(pointsLength);
+  std::iota(permutation.begin(), permutation.end(), uint32_t(0));
+
+  // This is a Fisher-Yates shuffle rather than std::shuffle, whose results
+  // differ between standard libraries.
+  std::mt19937 generator(pointsLength);
+  for (uint32_t i = pointsLength; i > 1; --i) {
+    const uint32_t j = static_cast<uint32_t>(generator() % i);
+    std::swap(permutation[i - 1], permutation[j]);
+  }
+
+  permutePoints(parsedContent.position.data, permutation);
+  if (parsedContent.color) {
+    permutePoints(parsedContent.color->data, permutation);
+  }
+  if (parsedContent.normal) {
+    permutePoints(parsedContent.normal->data, permutation);
+  }
+
+  if (parsedContent.batchId) {
+    permutePoints(parsedContent.batchId->data, permutation);
+  } else if (hasPerPointProperties) {
+    // The properties of each point stay in their original order, so the points
+    // need explicit feature IDs that refer to them.
+    PntsSemantic& batchId = parsedContent.batchId.emplace();
+    if (pointsLength <= 65536) {
+      parsedContent.batchIdComponentType =
+          MetadataProperty::ComponentType::UNSIGNED_SHORT;
+      batchId.data.resize(pointsLength * sizeof(uint16_t));
+      gsl::span<uint16_t> batchIds(
+          reinterpret_cast<uint16_t*>(batchId.data.data()),
+          pointsLength);
+      for (size_t i = 0; i < pointsLength; ++i) {
+        batchIds[i] = static_cast<uint16_t>(permutation[i]);
+      }
+    } else {
+      parsedContent.batchIdComponentType =
+          MetadataProperty::ComponentType::UNSIGNED_INT;
+      batchId.data.resize(pointsLength * sizeof(uint32_t));
+      std::memcpy(batchId.data.data(), permutation.data(), batchId.data.size());
+    }
+  }
+}
+
 int32_t createBufferInGltf(Model& gltf, std::vector<std::byte>&& buffer) {
   size_t bufferId = gltf.buffers.size();
   Buffer& gltfBuffer = gltf.buffers.emplace_back();
@@ -1343,8 +1496,10 @@ int32_t createAccessorInGltf(
 }
 
 void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
+  const bool quantized = parsedContent.keepPositionsQuantized;
   const int64_t count = static_cast<int64_t>(parsedContent.pointsLength);
-  const int64_t byteStride = static_cast<int64_t>(sizeof(glm ::vec3));
+  const int64_t byteStride = static_cast<int64_t>(
+      quantized ? sizeof(glm::u16vec4) : sizeof(glm ::vec3));
   const int64_t byteLength = static_cast<int64_t>(byteStride * count);
   int32_t bufferId =
       createBufferInGltf(gltf, std::move(parsedContent.position.data));
@@ -1353,7 +1508,8 @@ void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
   int32_t accessorId = createAccessorInGltf(
       gltf,
       bufferViewId,
-      Accessor::ComponentType::FLOAT,
+      quantized ? Accessor::ComponentType::UNSIGNED_SHORT
+                : Accessor::ComponentType::FLOAT,
       count,
       Accessor::Type::VEC3);
 
@@ -1477,10 +1633,23 @@ void createGltfFromParsedContent(
 
   // Create a single node with a single mesh, with a single primitive.
   Node& node = gltf.nodes.emplace_back();
-  std::memcpy(
-      node.matrix.data(),
-      &CesiumGeometry::Transforms::Z_UP_TO_Y_UP,
-      sizeof(glm::dmat4));
+  glm::dmat4 nodeTransform = CesiumGeometry::Transforms::Z_UP_TO_Y_UP;
+  if (parsedContent.keepPositionsQuantized) {
+    // The node dequantizes the positions, as KHR_mesh_quantization expects.
+    const glm::dvec3 scale =
+        parsedContent.quantizedVolumeScale.value() / 65535.0;
+    const glm::dvec3& offset = parsedContent.quantizedVolumeOffset.value();
+    const glm::dmat4 dequantization(
+        glm::dvec4(scale.x, 0.0, 0.0, 0.0),
+        glm::dvec4(0.0, scale.y, 0.0, 0.0),
+        glm::dvec4(0.0, 0.0, scale.z, 0.0),
+        glm::dvec4(offset, 1.0));
+    nodeTransform = nodeTransform * dequantization;
+
+    gltf.addExtensionUsed("KHR_mesh_quantization");
+    gltf.addExtensionRequired("KHR_mesh_quantization");
+  }
+  std::memcpy(node.matrix.data(), &nodeTransform, sizeof(glm::dmat4));
 
   // Create a scene containing the node, and make it the default scene.
   Scene& scene = gltf.scenes.emplace_back();
@@ -1550,10 +1719,12 @@ void convertPntsContentToGltf(
     const gsl::span<const std::byte>& pntsBinary,
     const PntsHeader& header,
     uint32_t headerLength,
+    const CesiumGltfReader::GltfReaderOptions& options,
     GltfConverterResult& result) {
   if (header.featureTableJsonByteLength > 0 &&
       header.featureTableBinaryByteLength > 0) {
     PntsContent parsedContent;
+    parsedContent.keepPositionsQuantized = !options.dequantizeMeshData;
 
     const gsl::span<const std::byte> featureTableJsonData =
         pntsBinary.subspan(headerLength, header.featureTableJsonByteLength);
@@ -1604,6 +1775,14 @@ void convertPntsContentToGltf(
       return;
     }
 
+    if (options.shufflePointClouds) {
+      // Without BATCH_LENGTH, the batch table has a value for each point.
+      const bool hasPerPointProperties =
+          batchTableJson.IsObject() && !batchTableJson.HasParseError() &&
+          !parsedContent.dracoMetadataHasErrors && !parsedContent.batchLength;
+      shufflePoints(parsedContent, hasPerPointProperties);
+    }
+
     createGltfFromParsedContent(parsedContent, result);
 
     if (!batchTableJson.IsObject() || batchTableJson.HasParseError() ||
@@ -1624,14 +1803,15 @@ void convertPntsContentToGltf(
         featureTableJson,
         batchTableJson,
         batchTableBinaryData,
-        result.model.value()));
+        result.model.value(),
+        options.batchTableProperties));
   }
 }
 } // namespace
 
 GltfConverterResult PntsToGltfConverter::convert(
     const gsl::span<const std::byte>& pntsBinary,
-    const CesiumGltfReader::GltfReaderOptions& /*options*/) {
+    const CesiumGltfReader::GltfReaderOptions& options) {
   GltfConverterResult result;
   PntsHeader header;
   uint32_t headerLength = 0;
@@ -1640,7 +1820,7 @@ GltfConverterResult PntsToGltfConverter::convert(
     return result;
   }
 
-  convertPntsContentToGltf(pntsBinary, header, headerLength, result);
+  convertPntsContentToGltf(pntsBinary, header, headerLength, options, result);
   return result;
 }
 } // namespace Cesium3DTilesContent
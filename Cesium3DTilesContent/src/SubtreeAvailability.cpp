@@ -12,7 +12,9 @@
 #include <gsl/span>
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <optional>
 #include <string>
 
@@ -371,6 +373,93 @@ bool SubtreeAvailability::isSubtreeAvailable(
       checkSubtreeID));
 }
 
+uint8_t SubtreeAvailability::getChildTileAvailabilityMask(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId) const noexcept {
+  uint32_t relativeChildLevel = relativeTileLevel + 1;
+  if (relativeChildLevel >= this->_levelsInSubtree) {
+    return 0;
+  }
+
+  uint64_t numOfTilesInChildLevel = uint64_t(1)
+                                    << (this->_powerOf2 * relativeChildLevel);
+  return getChildAvailabilityMask(
+      relativeTileLevel,
+      relativeTileMortonId,
+      (numOfTilesInChildLevel - 1U) / (this->_childCount - 1U),
+      this->_tileAvailability);
+}
+
+uint8_t SubtreeAvailability::getChildContentAvailabilityMask(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId,
+    uint64_t contentId) const noexcept {
+  uint32_t relativeChildLevel = relativeTileLevel + 1;
+  if (contentId >= this->_contentAvailability.size() ||
+      relativeChildLevel >= this->_levelsInSubtree) {
+    return 0;
+  }
+
+  uint64_t numOfTilesInChildLevel = uint64_t(1)
+                                    << (this->_powerOf2 * relativeChildLevel);
+  return getChildAvailabilityMask(
+      relativeTileLevel,
+      relativeTileMortonId,
+      (numOfTilesInChildLevel - 1U) / (this->_childCount - 1U),
+      this->_contentAvailability[contentId]);
+}
+
+uint8_t SubtreeAvailability::getChildSubtreeAvailabilityMask(
+    uint64_t relativeTileMortonId) const noexcept {
+  if (this->_levelsInSubtree == 0) {
+    return 0;
+  }
+
+  return getChildAvailabilityMask(
+      this->_levelsInSubtree - 1,
+      relativeTileMortonId,
+      0,
+      this->_subtreeAvailability);
+}
+
+bool SubtreeAvailability::hasAvailableDescendants(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId) const noexcept {
+  if (relativeTileLevel >= this->_levelsInSubtree) {
+    return false;
+  }
+
+  uint64_t numOfTilesInLevel = uint64_t(1)
+                               << (this->_powerOf2 * relativeTileLevel);
+  if (relativeTileMortonId >= numOfTilesInLevel) {
+    return false;
+  }
+
+  // The descendants on each level have consecutive Morton IDs.
+  uint64_t firstDescendantMortonId = relativeTileMortonId;
+  uint64_t descendantCount = 1;
+  for (uint32_t level = relativeTileLevel + 1; level < this->_levelsInSubtree;
+       ++level) {
+    numOfTilesInLevel <<= this->_powerOf2;
+    firstDescendantMortonId <<= this->_powerOf2;
+    descendantCount <<= this->_powerOf2;
+
+    uint64_t numOfTilesFromRootToLevel =
+        (numOfTilesInLevel - 1U) / (this->_childCount - 1U);
+    if (isAnyAvailable(
+            numOfTilesFromRootToLevel + firstDescendantMortonId,
+            descendantCount,
+            this->_tileAvailability)) {
+      return true;
+    }
+  }
+
+  return isAnyAvailable(
+      firstDescendantMortonId << this->_powerOf2,
+      descendantCount << this->_powerOf2,
+      this->_subtreeAvailability);
+}
+
 namespace {
 
 void convertConstantAvailabilityToBitstream(
@@ -539,6 +628,94 @@ void SubtreeAvailability::setAvailable(
       isAvailable);
 }
 
+uint8_t SubtreeAvailability::getChildAvailabilityMask(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId,
+    uint64_t numOfTilesFromRootToChildLevel,
+    const AvailabilityView& availabilityView) const noexcept {
+  uint64_t numOfTilesInLevel = uint64_t(1)
+                               << (this->_powerOf2 * relativeTileLevel);
+  if (relativeTileMortonId >= numOfTilesInLevel) {
+    return 0;
+  }
+
+  const uint32_t allChildren = (1U << this->_childCount) - 1U;
+
+  const SubtreeConstantAvailability* constantAvailability =
+      std::get_if<SubtreeConstantAvailability>(&availabilityView);
+  if (constantAvailability) {
+    return constantAvailability->constant ? uint8_t(allChildren) : uint8_t(0);
+  }
+
+  const SubtreeBufferViewAvailability* bufferViewAvailability =
+      std::get_if<SubtreeBufferViewAvailability>(&availabilityView);
+  const gsl::span<const std::byte> view = bufferViewAvailability->view;
+
+  // The bits of at most eight children span at most two bytes, so they can be
+  // extracted together instead of one at a time.
+  const uint64_t firstBitIndex = numOfTilesFromRootToChildLevel +
+                                 relativeTileMortonId * this->_childCount;
+  const uint64_t byteIndex = firstBitIndex / 8;
+  uint32_t bits = 0;
+  if (byteIndex < view.size()) {
+    bits |= std::to_integer<uint32_t>(view[byteIndex]);
+  }
+  if (byteIndex + 1 < view.size()) {
+    bits |= std::to_integer<uint32_t>(view[byteIndex + 1]) << 8;
+  }
+
+  return uint8_t((bits >> (firstBitIndex % 8)) & allChildren);
+}
+
+bool SubtreeAvailability::isAnyAvailable(
+    uint64_t firstAvailabilityBitIndex,
+    uint64_t availabilityBitCount,
+    const AvailabilityView& availabilityView) const noexcept {
+  const SubtreeConstantAvailability* constantAvailability =
+      std::get_if<SubtreeConstantAvailability>(&availabilityView);
+  if (constantAvailability) {
+    return constantAvailability->constant && availabilityBitCount > 0;
+  }
+
+  const SubtreeBufferViewAvailability* bufferViewAvailability =
+      std::get_if<SubtreeBufferViewAvailability>(&availabilityView);
+  const gsl::span<const std::byte> view = bufferViewAvailability->view;
+
+  uint64_t bitIndex = firstAvailabilityBitIndex;
+  const uint64_t endBitIndex = std::min(
+      firstAvailabilityBitIndex + availabilityBitCount,
+      uint64_t(view.size()) * 8);
+
+  const auto isBitSet = [&view](uint64_t index) {
+    return ((std::to_integer<int>(view[index / 8]) >> (index % 8)) & 1) == 1;
+  };
+
+  // Test bit by bit up to a byte boundary, then 64 bits at a time, then the
+  // rest bit by bit.
+  for (; bitIndex < endBitIndex && bitIndex % 8 != 0; ++bitIndex) {
+    if (isBitSet(bitIndex)) {
+      return true;
+    }
+  }
+
+  for (; bitIndex < endBitIndex && endBitIndex - bitIndex >= 64;
+       bitIndex += 64) {
+    uint64_t word;
+    std::memcpy(&word, view.data() + bitIndex / 8, sizeof(word));
+    if (word != 0) {
+      return true;
+    }
+  }
+
+  for (; bitIndex < endBitIndex; ++bitIndex) {
+    if (isBitSet(bitIndex)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool SubtreeAvailability::isAvailableUsingBufferView(
     uint64_t numOfTilesFromRootToParentLevel,
     uint64_t relativeTileMortonId,
@@ -2,6 +2,7 @@
 #include <Cesium3DTilesContent/BinaryToGltfConverter.h>
 #include <Cesium3DTilesContent/CmptToGltfConverter.h>
 #include <Cesium3DTilesContent/GltfConverters.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
 #include <Cesium3DTilesContent/PntsToGltfConverter.h>
 #include <Cesium3DTilesContent/registerAllTileContentTypes.h>
 
@@ -12,6 +13,7 @@ void registerAllTileContentTypes() {
   GltfConverters::registerMagic("b3dm", B3dmToGltfConverter::convert);
   GltfConverters::registerMagic("cmpt", CmptToGltfConverter::convert);
   GltfConverters::registerMagic("pnts", PntsToGltfConverter::convert);
+  GltfConverters::registerMagic("i3dm", I3dmToGltfConverter::convert);
 
   GltfConverters::registerFileExtension(
       ".gltf",
@@ -6,15 +6,20 @@
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumUtility/ScratchVector.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
+using CesiumUtility::ScratchVector;
 
 namespace Cesium3DTilesContent {
 struct EdgeVertex {
@@ -29,12 +34,19 @@ struct EdgeIndices {
   std::vector<EdgeVertex> north;
 };
 
-static bool upsamplePrimitiveForRasterOverlays(
+// A copy of a primitive of the parent model in the model of one of the
+// children, and whether any part of it is inside the child.
+struct UpsampledPrimitive {
+  Model& model;
+  MeshPrimitive& primitive;
+  CesiumGeometry::UpsampledQuadtreeNode childID;
+  bool keep;
+};
+
+static void upsamplePrimitiveForRasterOverlays(
     const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
     int32_t textureCoordinateIndex);
 
 struct FloatVertexAttribute {
@@ -47,6 +59,149 @@ struct FloatVertexAttribute {
   std::vector<double> maximums;
 };
 
+// The vertices and triangles of a primitive that are inside one of the
+// children, while the triangles of the parent are being clipped.
+struct UpsampledPrimitiveClip {
+  UpsampledPrimitive& upsampled;
+  bool keepAboveU;
+  bool keepAboveV;
+  uint8_t behindSides;
+  size_t vertexBufferIndex;
+  size_t indexBufferIndex;
+  size_t vertexBufferViewIndex;
+  size_t indexBufferViewIndex;
+  std::vector<FloatVertexAttribute> attributes;
+
+  // Maps old (parentModel) vertex indices to new (model) vertex indices.
+  std::vector<uint32_t> vertexMap;
+  std::vector<float> newVertexFloats;
+  std::vector<uint32_t> indices;
+  EdgeIndices edgeIndices;
+};
+
+// Converts the components of a quantized vertex attribute, as allowed by the
+// KHR_mesh_quantization extension, to tightly-packed floats, so that it can be
+// interpolated like any other attribute.
+template <typename T>
+static bool dequantizeVertexAttribute(
+    const std::vector<std::byte>& buffer,
+    int64_t offset,
+    int64_t stride,
+    int64_t count,
+    int64_t numberOfComponents,
+    bool normalized,
+    std::vector<std::byte>& output) {
+  if (offset < 0 || stride < numberOfComponents * int64_t(sizeof(T)) ||
+      count <= 0 ||
+      offset + (count - 1) * stride +
+              numberOfComponents * int64_t(sizeof(T)) >
+          int64_t(buffer.size())) {
+    return false;
+  }
+
+  output.resize(size_t(count * numberOfComponents) * sizeof(float));
+  float* pOutput = reinterpret_cast<float*>(output.data());
+  for (int64_t i = 0; i < count; ++i) {
+    const T* pInput =
+        reinterpret_cast<const T*>(buffer.data() + offset + i * stride);
+    for (int64_t j = 0; j < numberOfComponents; ++j) {
+      float value = static_cast<float>(pInput[j]);
+      if (normalized) {
+        value /= static_cast<float>(std::numeric_limits<T>::max());
+        if constexpr (std::is_signed_v<T>) {
+          value = glm::max(value, -1.0f);
+        }
+      }
+      *pOutput++ = value;
+    }
+  }
+
+  return true;
+}
+
+static bool dequantizeVertexAttribute(
+    const Accessor& accessor,
+    const std::vector<std::byte>& buffer,
+    int64_t offset,
+    int64_t stride,
+    std::vector<std::byte>& output) {
+  const int64_t numberOfComponents = accessor.computeNumberOfComponents();
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    return dequantizeVertexAttribute<int8_t>(
+        buffer,
+        offset,
+        stride,
+        accessor.count,
+        numberOfComponents,
+        accessor.normalized,
+        output);
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return dequantizeVertexAttribute<uint8_t>(
+        buffer,
+        offset,
+        stride,
+        accessor.count,
+        numberOfComponents,
+        accessor.normalized,
+        output);
+  case Accessor::ComponentType::SHORT:
+    return dequantizeVertexAttribute<int16_t>(
+        buffer,
+        offset,
+        stride,
+        accessor.count,
+        numberOfComponents,
+        accessor.normalized,
+        output);
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return dequantizeVertexAttribute<uint16_t>(
+        buffer,
+        offset,
+        stride,
+        accessor.count,
+        numberOfComponents,
+        accessor.normalized,
+        output);
+  default:
+    return false;
+  }
+}
+
+// Gets a view of the texture coordinates in the given accessor as floats,
+// dequantizing them into `dequantized` if they are integers.
+static AccessorView<glm::vec2> getFloatTextureCoordinates(
+    const Model& model,
+    int32_t accessorIndex,
+    std::vector<std::byte>& dequantized) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor ||
+      pAccessor->componentType == Accessor::ComponentType::FLOAT) {
+    return AccessorView<glm::vec2>(model, accessorIndex);
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  const Buffer* pBuffer =
+      pBufferView ? Model::getSafe(&model.buffers, pBufferView->buffer)
+                  : nullptr;
+  if (!pBuffer || pAccessor->type != Accessor::Type::VEC2 ||
+      !dequantizeVertexAttribute(
+          *pAccessor,
+          pBuffer->cesium.data,
+          pBufferView->byteOffset + pAccessor->byteOffset,
+          pAccessor->computeByteStride(model),
+          dequantized)) {
+    return AccessorView<glm::vec2>(AccessorViewStatus::WrongSizeT);
+  }
+
+  return AccessorView<glm::vec2>(
+      dequantized.data(),
+      int64_t(sizeof(glm::vec2)),
+      0,
+      pAccessor->count);
+}
+
 static void addClippedPolygon(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
@@ -86,7 +241,8 @@ static void addSkirts(
     const SkirtMeshMetadata& parentSkirt,
     EdgeIndices& edgeIndices,
     int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex);
+    int32_t positionAttributeIndex,
+    std::vector<uint32_t>* pSkirtEdgeIndices);
 
 static bool
 isWestChild(CesiumGeometry::UpsampledQuadtreeNode childID) noexcept {
@@ -100,15 +256,9 @@ isSouthChild(CesiumGeometry::UpsampledQuadtreeNode childID) noexcept {
 
 static void copyMetadataTables(const Model& parentModel, Model& result);
 
-std::optional<Model> upsampleGltfForRasterOverlays(
-    const Model& parentModel,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
-    int32_t textureCoordinateIndex) {
-  CESIUM_TRACE("upsampleGltfForRasterOverlays");
-  Model result;
-
-  // Copy the entire parent model except for the buffers, bufferViews, and
-  // accessors, which we'll be rewriting.
+// Copies the entire parent model except for the buffers, bufferViews, and
+// accessors, which are rewritten, and the buffers of the property tables.
+static void copyModelWithoutBuffers(const Model& parentModel, Model& result) {
   result.animations = parentModel.animations;
   result.materials = parentModel.materials;
   result.meshes = parentModel.meshes;
@@ -133,6 +283,15 @@ std::optional<Model> upsampleGltfForRasterOverlays(
   // Copy EXT_structural_metadata property table buffer views and unique
   // buffers.
   copyMetadataTables(parentModel, result);
+}
+
+// Copies the entire parent model for a child except for the buffers,
+// bufferViews, and accessors, which are rewritten by the upsampling.
+static void copyUpsampledModel(
+    const Model& parentModel,
+    CesiumGeometry::UpsampledQuadtreeNode childID,
+    Model& result) {
+  copyModelWithoutBuffers(parentModel, result);
 
   // If the glTF has a name, update it with upsample info.
   auto nameIt = result.extras.find("Cesium3DTiles_TileUrl");
@@ -147,33 +306,187 @@ std::optional<Model> upsampleGltfForRasterOverlays(
     name += "-Y" + std::to_string(childID.tileID.y);
     nameIt->second = name;
   }
+}
+
+Model createGltfUpsamplingSource(const Model& model) {
+  CESIUM_TRACE_CATEGORY(Raster, "createGltfUpsamplingSource");
+  Model source;
+  copyModelWithoutBuffers(model, source);
+
+  // Only the accessors of the primitives are read by the upsampling, so only
+  // their data is kept, tightly packed into one buffer.
+  source.accessors = model.accessors;
+  for (Accessor& accessor : source.accessors) {
+    accessor.bufferView = -1;
+    accessor.byteOffset = 0;
+    accessor.sparse.reset();
+  }
+
+  const int32_t bufferIndex = static_cast<int32_t>(source.buffers.size());
+  std::vector<std::byte> data;
+
+  auto copyAccessorData = [&model, &source, bufferIndex, &data](
+                              int32_t accessorIndex) {
+    if (accessorIndex < 0 ||
+        accessorIndex >= static_cast<int32_t>(model.accessors.size())) {
+      return;
+    }
+
+    Accessor& copy = source.accessors[static_cast<size_t>(accessorIndex)];
+    if (copy.bufferView >= 0) {
+      // Shared by several primitives and already copied.
+      return;
+    }
+
+    const Accessor& accessor =
+        model.accessors[static_cast<size_t>(accessorIndex)];
+    const BufferView* pBufferView =
+        Model::getSafe(&model.bufferViews, accessor.bufferView);
+    if (!pBufferView) {
+      return;
+    }
+
+    const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+    if (!pBuffer) {
+      return;
+    }
+
+    const int64_t elementSize = accessor.computeBytesPerVertex();
+    const int64_t stride = accessor.computeByteStride(model);
+    const int64_t offset = pBufferView->byteOffset + accessor.byteOffset;
+    if (accessor.count <= 0 || elementSize <= 0 || stride < elementSize ||
+        offset < 0 ||
+        offset + (accessor.count - 1) * stride + elementSize >
+            int64_t(pBuffer->cesium.data.size())) {
+      // The accessor is left without data, as the upsampling would ignore
+      // it anyway.
+      return;
+    }
+
+    // Keep the data of each accessor aligned for any component type.
+    const size_t byteOffset = (data.size() + 7) & ~size_t(7);
+    const size_t byteLength = size_t(accessor.count * elementSize);
+    data.resize(byteOffset + byteLength);
+    for (int64_t i = 0; i < accessor.count; ++i) {
+      std::memcpy(
+          data.data() + byteOffset + size_t(i * elementSize),
+          pBuffer->cesium.data.data() + offset + i * stride,
+          size_t(elementSize));
+    }
+
+    copy.bufferView = static_cast<int32_t>(source.bufferViews.size());
+    BufferView& bufferView = source.bufferViews.emplace_back();
+    bufferView.buffer = bufferIndex;
+    bufferView.byteOffset = int64_t(byteOffset);
+    bufferView.byteLength = int64_t(byteLength);
+  };
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      copyAccessorData(primitive.indices);
+      for (const std::pair<const std::string, int32_t>& attribute :
+           primitive.attributes) {
+        copyAccessorData(attribute.second);
+      }
+    }
+  }
+
+  Buffer& buffer = source.buffers.emplace_back();
+  buffer.byteLength = int64_t(data.size());
+  buffer.cesium.data = std::move(data);
+
+  return source;
+}
+
+std::optional<Model> upsampleGltfForRasterOverlays(
+    const Model& parentModel,
+    CesiumGeometry::UpsampledQuadtreeNode childID,
+    int32_t textureCoordinateIndex) {
+  CESIUM_TRACE_CATEGORY(Raster, "upsampleGltfForRasterOverlays");
+  return std::move(upsampleGltfForRasterOverlayChildren(
+                       parentModel,
+                       {childID},
+                       textureCoordinateIndex)
+                       .front());
+}
+
+std::vector<std::optional<Model>> upsampleGltfForRasterOverlayChildren(
+    const Model& parentModel,
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode>& childIDs,
+    int32_t textureCoordinateIndex) {
+  CESIUM_TRACE_CATEGORY(Raster, "upsampleGltfForRasterOverlayChildren");
+  std::vector<Model> results(childIDs.size());
+  for (size_t i = 0; i < childIDs.size(); ++i) {
+    copyUpsampledModel(parentModel, childIDs[i], results[i]);
+  }
+
+  std::vector<UpsampledPrimitive> upsampledPrimitives;
+  upsampledPrimitives.reserve(childIDs.size());
 
-  bool containsPrimitives = false;
+  // Whether each primitive of the current mesh is kept, for each child.
+  std::vector<std::vector<bool>> keepPrimitives(childIDs.size());
 
-  for (Mesh& mesh : result.meshes) {
-    for (size_t i = 0; i < mesh.primitives.size(); ++i) {
-      MeshPrimitive& primitive = mesh.primitives[i];
+  for (size_t meshIndex = 0; meshIndex < parentModel.meshes.size();
+       ++meshIndex) {
+    const Mesh& parentMesh = parentModel.meshes[meshIndex];
+    for (std::vector<bool>& keepPrimitive : keepPrimitives) {
+      keepPrimitive.clear();
+    }
+
+    for (size_t i = 0; i < parentMesh.primitives.size(); ++i) {
+      upsampledPrimitives.clear();
+      for (size_t j = 0; j < results.size(); ++j) {
+        upsampledPrimitives.emplace_back(UpsampledPrimitive{
+            results[j],
+            results[j].meshes[meshIndex].primitives[i],
+            childIDs[j],
+            false});
+      }
 
-      bool keep = upsamplePrimitiveForRasterOverlays(
+      upsamplePrimitiveForRasterOverlays(
           parentModel,
-          result,
-          mesh,
-          primitive,
-          childID,
+          parentMesh.primitives[i],
+          upsampledPrimitives,
           textureCoordinateIndex);
 
-      // We're assuming here that nothing references primitives by index, so we
-      // can remove them without any drama.
-      if (!keep) {
-        mesh.primitives.erase(mesh.primitives.begin() + int64_t(i));
-        --i;
+      for (size_t j = 0; j < results.size(); ++j) {
+        keepPrimitives[j].push_back(upsampledPrimitives[j].keep);
       }
-      containsPrimitives |= !mesh.primitives.empty();
     }
+
+    // We're assuming here that nothing references primitives by index, so we
+    // can remove them without any drama.
+    for (size_t j = 0; j < results.size(); ++j) {
+      std::vector<MeshPrimitive>& primitives =
+          results[j].meshes[meshIndex].primitives;
+      size_t keptCount = 0;
+      for (size_t i = 0; i < primitives.size(); ++i) {
+        if (keepPrimitives[j][i]) {
+          if (keptCount != i) {
+            primitives[keptCount] = std::move(primitives[i]);
+          }
+          ++keptCount;
+        }
+      }
+      primitives.erase(
+          primitives.begin() + int64_t(keptCount),
+          primitives.end());
+    }
+  }
+
+  std::vector<std::optional<Model>> upsampledModels;
+  upsampledModels.reserve(results.size());
+  for (Model& result : results) {
+    const bool containsPrimitives = std::any_of(
+        result.meshes.begin(),
+        result.meshes.end(),
+        [](const Mesh& mesh) { return !mesh.primitives.empty(); });
+    upsampledModels.emplace_back(
+        containsPrimitives ? std::make_optional<Model>(std::move(result))
+                           : std::nullopt);
   }
 
-  return containsPrimitives ? std::make_optional<Model>(std::move(result))
-                            : std::nullopt;
+  return upsampledModels;
 }
 
 static void copyVertexAttributes(
@@ -385,281 +698,57 @@ static T getVertexValue(
   return std::visit(Operation{accessor, complements}, vertex);
 }
 
-template <class TIndex>
-static bool upsamplePrimitiveForRasterOverlays(
-    const Model& parentModel,
+// Adds an accessor, with its own buffer, for the indices of the vertices along
+// the edges of a child, and returns its index.
+static int32_t addSkirtEdgeIndicesAccessor(
     Model& model,
-    Mesh& /*mesh*/,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
-    int32_t textureCoordinateIndex) {
-  CESIUM_TRACE("upsamplePrimitiveForRasterOverlays");
-
-  // Add up the per-vertex size of all attributes and create buffers,
-  // bufferViews, and accessors
-  std::vector<FloatVertexAttribute> attributes;
-  attributes.reserve(primitive.attributes.size());
-
-  const size_t vertexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
-
-  const size_t indexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
-
-  const size_t vertexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
-
-  const size_t indexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
-
-  BufferView& vertexBufferView = model.bufferViews[vertexBufferViewIndex];
-  vertexBufferView.buffer = static_cast<int>(vertexBufferIndex);
-  vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
-
-  BufferView& indexBufferView = model.bufferViews[indexBufferViewIndex];
-  indexBufferView.buffer = static_cast<int>(indexBufferIndex);
-  indexBufferView.target = BufferView::Target::ARRAY_BUFFER;
-
-  int64_t vertexSizeFloats = 0;
-  int32_t uvAccessorIndex = -1;
-  int32_t positionAttributeIndex = -1;
-
-  std::vector<std::string> toRemove;
-
-  std::string textureCoordinateName =
-      "_CESIUMOVERLAY_" + std::to_string(textureCoordinateIndex);
-
-  for (std::pair<const std::string, int>& attribute : primitive.attributes) {
-    if (attribute.first.find("_CESIUMOVERLAY_") == 0) {
-      if (uvAccessorIndex == -1) {
-        if (attribute.first == textureCoordinateName) {
-          uvAccessorIndex = attribute.second;
-        }
-      }
-      // Do not include _CESIUMOVERLAY_*, it will be generated later.
-      toRemove.push_back(attribute.first);
-      continue;
-    }
-
-    if (attribute.second < 0 ||
-        attribute.second >= static_cast<int>(parentModel.accessors.size())) {
-      toRemove.push_back(attribute.first);
-      continue;
-    }
-
-    const Accessor& accessor =
-        parentModel.accessors[static_cast<size_t>(attribute.second)];
-    if (accessor.bufferView < 0 ||
-        accessor.bufferView >=
-            static_cast<int>(parentModel.bufferViews.size())) {
-      toRemove.push_back(attribute.first);
-      continue;
-    }
-
-    const BufferView& bufferView =
-        parentModel.bufferViews[static_cast<size_t>(accessor.bufferView)];
-    if (bufferView.buffer < 0 ||
-        bufferView.buffer >= static_cast<int>(parentModel.buffers.size())) {
-      toRemove.push_back(attribute.first);
-      continue;
-    }
-
-    const Buffer& buffer =
-        parentModel.buffers[static_cast<size_t>(bufferView.buffer)];
-
-    const int64_t accessorByteStride = accessor.computeByteStride(parentModel);
-    const int64_t accessorComponentElements =
-        accessor.computeNumberOfComponents();
-    if (accessor.componentType != Accessor::ComponentType::FLOAT) {
-      // Can only interpolate floating point vertex attributes
-      toRemove.push_back(attribute.first);
-      continue;
-    }
-
-    attribute.second = static_cast<int>(model.accessors.size());
-    model.accessors.emplace_back();
-    Accessor& newAccessor = model.accessors.back();
-    newAccessor.bufferView = static_cast<int>(vertexBufferViewIndex);
-    newAccessor.byteOffset = vertexSizeFloats * int64_t(sizeof(float));
-    newAccessor.componentType = Accessor::ComponentType::FLOAT;
-    newAccessor.type = accessor.type;
-
-    vertexSizeFloats += accessorComponentElements;
-
-    attributes.push_back(FloatVertexAttribute{
-        buffer.cesium.data,
-        bufferView.byteOffset + accessor.byteOffset,
-        accessorByteStride,
-        accessorComponentElements,
-        attribute.second,
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::max()),
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::lowest()),
-    });
-
-    // get position to be used to create for skirts later
-    if (attribute.first == "POSITION") {
-      positionAttributeIndex = int32_t(attributes.size() - 1);
-    }
-  }
-
-  if (uvAccessorIndex == -1) {
-    // We don't know how to divide this primitive, so just remove it.
-    return false;
-  }
-
-  for (const std::string& attribute : toRemove) {
-    primitive.attributes.erase(attribute);
-  }
-
-  const bool keepAboveU = !isWestChild(childID);
-  const bool keepAboveV = !isSouthChild(childID);
-
-  const AccessorView<glm::vec2> uvView(parentModel, uvAccessorIndex);
-  const AccessorView<TIndex> indicesView(parentModel, primitive.indices);
-
-  if (uvView.status() != AccessorViewStatus::Valid ||
-      indicesView.status() != AccessorViewStatus::Valid) {
-    return false;
-  }
-
-  // check if the primitive has skirts
-  int64_t indicesBegin = 0;
-  int64_t indicesCount = indicesView.size();
-  std::optional<SkirtMeshMetadata> parentSkirtMeshMetadata =
-      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
-  const bool hasSkirt = (parentSkirtMeshMetadata != std::nullopt) &&
-                        (positionAttributeIndex != -1);
-  if (hasSkirt) {
-    indicesBegin = parentSkirtMeshMetadata->noSkirtIndicesBegin;
-    indicesCount = parentSkirtMeshMetadata->noSkirtIndicesCount;
-  }
-
-  std::vector<uint32_t> clipVertexToIndices;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
-
-  // Maps old (parentModel) vertex indices to new (model) vertex indices.
-  std::vector<uint32_t> vertexMap(
-      size_t(uvView.size()),
-      std::numeric_limits<uint32_t>::max());
-
-  // std::vector<unsigned char> newVertexBuffer(vertexSizeFloats *
-  // sizeof(float)); gsl::span<float>
-  // newVertexFloats(reinterpret_cast<float*>(newVertexBuffer.data()),
-  // newVertexBuffer.size() / sizeof(float));
-  std::vector<float> newVertexFloats;
-  std::vector<uint32_t> indices;
-  EdgeIndices edgeIndices;
-
-  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
-    TIndex i0 = indicesView[i];
-    TIndex i1 = indicesView[i + 1];
-    TIndex i2 = indicesView[i + 2];
-
-    const glm::vec2 uv0 = uvView[i0];
-    const glm::vec2 uv1 = uvView[i1];
-    const glm::vec2 uv2 = uvView[i2];
-
-    // Clip this triangle against the East-West boundary
-    clippedA.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveU,
-        static_cast<int>(i0),
-        static_cast<int>(i1),
-        static_cast<int>(i2),
-        uv0.x,
-        uv1.x,
-        uv2.x,
-        clippedA);
-
-    if (clippedA.size() < 3) {
-      // No part of this triangle is inside the target tile.
-      continue;
-    }
+    const std::vector<uint32_t>& skirtEdgeIndices) {
+  const size_t bufferIndex = model.buffers.size();
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(skirtEdgeIndices.size() * sizeof(uint32_t));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      skirtEdgeIndices.data(),
+      buffer.cesium.data.size());
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
 
-    // Clip the first clipped triange against the North-South boundary
-    clipVertexToIndices.clear();
-    clippedB.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveV,
-        ~0,
-        ~1,
-        ~2,
-        getVertexValue(uvView, clippedA[0]).y,
-        getVertexValue(uvView, clippedA[1]).y,
-        getVertexValue(uvView, clippedA[2]).y,
-        clippedB);
-
-    // Add the clipped triangle or quad, if any
-    addClippedPolygon(
-        newVertexFloats,
-        indices,
-        attributes,
-        vertexMap,
-        clipVertexToIndices,
-        clippedA,
-        clippedB);
-    if (hasSkirt) {
-      addEdge(
-          edgeIndices,
-          0.5,
-          0.5,
-          keepAboveU,
-          keepAboveV,
-          uvView,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-    }
+  const size_t bufferViewIndex = model.bufferViews.size();
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(bufferIndex);
+  bufferView.byteOffset = 0;
+  bufferView.byteLength = buffer.byteLength;
 
-    // If the East-West clip yielded a quad (rather than a triangle), clip the
-    // second triangle of the quad, too.
-    if (clippedA.size() > 3) {
-      clipVertexToIndices.clear();
-      clippedB.clear();
-      clipTriangleAtAxisAlignedThreshold(
-          0.5,
-          keepAboveV,
-          ~0,
-          ~2,
-          ~3,
-          getVertexValue(uvView, clippedA[0]).y,
-          getVertexValue(uvView, clippedA[2]).y,
-          getVertexValue(uvView, clippedA[3]).y,
-          clippedB);
+  const size_t accessorIndex = model.accessors.size();
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(bufferViewIndex);
+  accessor.byteOffset = 0;
+  accessor.count = int64_t(skirtEdgeIndices.size());
+  accessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+  accessor.type = Accessor::Type::SCALAR;
 
-      // Add the clipped triangle or quad, if any
-      addClippedPolygon(
-          newVertexFloats,
-          indices,
-          attributes,
-          vertexMap,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-      if (hasSkirt) {
-        addEdge(
-            edgeIndices,
-            0.5,
-            0.5,
-            keepAboveU,
-            keepAboveV,
-            uvView,
-            clipVertexToIndices,
-            clippedA,
-            clippedB);
-      }
-    }
-  }
+  return static_cast<int32_t>(accessorIndex);
+}
 
-  // create mesh with skirt
+// Creates the buffers and accessors of a primitive for the vertices and
+// triangles that were clipped for a child.
+static bool finishUpsampledPrimitive(
+    UpsampledPrimitiveClip& clip,
+    const std::optional<SkirtMeshMetadata>& parentSkirtMeshMetadata,
+    int64_t vertexSizeFloats,
+    int32_t positionAttributeIndex) {
+  Model& model = clip.upsampled.model;
+  MeshPrimitive& primitive = clip.upsampled.primitive;
+  const CesiumGeometry::UpsampledQuadtreeNode childID = clip.upsampled.childID;
+  std::vector<float>& newVertexFloats = clip.newVertexFloats;
+  std::vector<uint32_t>& indices = clip.indices;
+
+  // create mesh with skirt, or only find the vertices along its edges if the
+  // parent leaves the skirts to the renderer
+  const bool hasSkirt = parentSkirtMeshMetadata != std::nullopt;
+  const bool skirtsAsEdgeIndices =
+      hasSkirt && parentSkirtMeshMetadata->skirtEdgeIndicesAccessor >= 0;
   std::optional<SkirtMeshMetadata> skirtMeshMetadata;
+  std::vector<uint32_t> skirtEdgeIndices;
   if (hasSkirt) {
     skirtMeshMetadata = std::make_optional<SkirtMeshMetadata>();
     skirtMeshMetadata->noSkirtIndicesBegin = 0;
@@ -672,13 +761,14 @@ static bool upsamplePrimitiveForRasterOverlays(
     addSkirts(
         newVertexFloats,
         indices,
-        attributes,
+        clip.attributes,
         childID,
         *skirtMeshMetadata,
         *parentSkirtMeshMetadata,
-        edgeIndices,
+        clip.edgeIndices,
         vertexSizeFloats,
-        positionAttributeIndex);
+        positionAttributeIndex,
+        skirtsAsEdgeIndices ? &skirtEdgeIndices : nullptr);
   }
 
   if (newVertexFloats.empty() || indices.empty()) {
@@ -688,7 +778,7 @@ static bool upsamplePrimitiveForRasterOverlays(
   // Update the accessor vertex counts and min/max values
   const int64_t numberOfVertices =
       int64_t(newVertexFloats.size()) / vertexSizeFloats;
-  for (const FloatVertexAttribute& attribute : attributes) {
+  for (FloatVertexAttribute& attribute : clip.attributes) {
     Accessor& accessor =
         model.accessors[static_cast<size_t>(attribute.accessorIndex)];
     accessor.count = numberOfVertices;
@@ -700,21 +790,23 @@ static bool upsamplePrimitiveForRasterOverlays(
   const size_t indexAccessorIndex = model.accessors.size();
   model.accessors.emplace_back();
   Accessor& newIndicesAccessor = model.accessors.back();
-  newIndicesAccessor.bufferView = static_cast<int>(indexBufferViewIndex);
+  newIndicesAccessor.bufferView = static_cast<int>(clip.indexBufferViewIndex);
   newIndicesAccessor.byteOffset = 0;
   newIndicesAccessor.count = int64_t(indices.size());
   newIndicesAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
   newIndicesAccessor.type = Accessor::Type::SCALAR;
 
   // Populate the buffers
-  Buffer& vertexBuffer = model.buffers[vertexBufferIndex];
+  BufferView& vertexBufferView = model.bufferViews[clip.vertexBufferViewIndex];
+  Buffer& vertexBuffer = model.buffers[clip.vertexBufferIndex];
   vertexBuffer.cesium.data.resize(newVertexFloats.size() * sizeof(float));
   float* pAsFloats = reinterpret_cast<float*>(vertexBuffer.cesium.data.data());
   std::copy(newVertexFloats.begin(), newVertexFloats.end(), pAsFloats);
   vertexBufferView.byteLength = int64_t(vertexBuffer.cesium.data.size());
   vertexBufferView.byteStride = vertexSizeFloats * int64_t(sizeof(float));
 
-  Buffer& indexBuffer = model.buffers[indexBufferIndex];
+  BufferView& indexBufferView = model.bufferViews[clip.indexBufferViewIndex];
+  Buffer& indexBuffer = model.buffers[clip.indexBufferIndex];
   indexBuffer.cesium.data.resize(indices.size() * sizeof(uint32_t));
   uint32_t* pAsUint32s =
       reinterpret_cast<uint32_t*>(indexBuffer.cesium.data.data());
@@ -724,6 +816,7 @@ static bool upsamplePrimitiveForRasterOverlays(
   bool onlyWater = false;
   bool onlyLand = true;
   int64_t waterMaskTextureId = -1;
+  bool waterMaskPackedBits = false;
 
   auto onlyWaterIt = primitive.extras.find("OnlyWater");
   auto onlyLandIt = primitive.extras.find("OnlyLand");
@@ -741,6 +834,12 @@ static bool upsamplePrimitiveForRasterOverlays(
           waterMaskTextureIdIt->second.isInt64()) {
         waterMaskTextureId = waterMaskTextureIdIt->second.getInt64OrDefault(-1);
       }
+
+      auto waterMaskPackedBitsIt = primitive.extras.find("WaterMaskPackedBits");
+      if (waterMaskPackedBitsIt != primitive.extras.end()) {
+        waterMaskPackedBits =
+            waterMaskPackedBitsIt->second.getBoolOrDefault(false);
+      }
     }
   }
 
@@ -767,6 +866,11 @@ static bool upsamplePrimitiveForRasterOverlays(
         waterMaskScale * (childID.tileID.y % 2);
   }
 
+  if (skirtsAsEdgeIndices) {
+    skirtMeshMetadata->skirtEdgeIndicesAccessor =
+        addSkirtEdgeIndicesAccessor(model, skirtEdgeIndices);
+  }
+
   // add skirts to extras to be upsampled later if needed
   if (hasSkirt) {
     primitive.extras = SkirtMeshMetadata::createGltfExtras(*skirtMeshMetadata);
@@ -776,6 +880,9 @@ static bool upsamplePrimitiveForRasterOverlays(
   primitive.extras.emplace("OnlyLand", onlyLand);
 
   primitive.extras.emplace("WaterMaskTex", waterMaskTextureId);
+  if (waterMaskPackedBits) {
+    primitive.extras.emplace("WaterMaskPackedBits", true);
+  }
 
   primitive.extras.emplace("WaterMaskTranslationX", waterMaskTranslationX);
   primitive.extras.emplace("WaterMaskTranslationY", waterMaskTranslationY);
@@ -786,6 +893,393 @@ static bool upsamplePrimitiveForRasterOverlays(
   return true;
 }
 
+template <class TIndex>
+static void upsamplePrimitiveForRasterOverlays(
+    const Model& parentModel,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
+    int32_t textureCoordinateIndex) {
+  CESIUM_TRACE_CATEGORY(Raster, "upsamplePrimitiveForRasterOverlays");
+
+  // Each vertex is classified against the two thresholds once for all the
+  // children, in the same way that clipTriangleAtAxisAlignedThreshold does.
+  // Then only the triangles that straddle a threshold need to be clipped.
+  static constexpr uint8_t belowU = 1;
+  static constexpr uint8_t aboveU = 2;
+  static constexpr uint8_t belowV = 4;
+  static constexpr uint8_t aboveV = 8;
+  static constexpr uint8_t unclassified = 16;
+
+  // Create the buffers and bufferViews of each child.
+  std::vector<UpsampledPrimitiveClip> clips;
+  clips.reserve(children.size());
+  for (UpsampledPrimitive& child : children) {
+    Model& model = child.model;
+    const bool keepAboveU = !isWestChild(child.childID);
+    const bool keepAboveV = !isSouthChild(child.childID);
+
+    UpsampledPrimitiveClip& clip = clips.emplace_back(UpsampledPrimitiveClip{
+        child,
+        keepAboveU,
+        keepAboveV,
+        uint8_t(
+            (keepAboveU ? belowU : aboveU) | (keepAboveV ? belowV : aboveV)),
+        model.buffers.size(),
+        model.buffers.size() + 1,
+        model.bufferViews.size(),
+        model.bufferViews.size() + 1,
+        {},
+        {},
+        {},
+        {},
+        {}});
+    clip.attributes.reserve(parentPrimitive.attributes.size());
+
+    model.buffers.resize(model.buffers.size() + 2);
+    model.bufferViews.resize(model.bufferViews.size() + 2);
+
+    BufferView& vertexBufferView =
+        model.bufferViews[clip.vertexBufferViewIndex];
+    vertexBufferView.buffer = static_cast<int>(clip.vertexBufferIndex);
+    vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+
+    BufferView& indexBufferView = model.bufferViews[clip.indexBufferViewIndex];
+    indexBufferView.buffer = static_cast<int>(clip.indexBufferIndex);
+    indexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+  }
+
+  // Holds the dequantized copies of quantized attributes, which all the
+  // children share. It never grows past its reserved size, so the attributes
+  // can refer to its elements.
+  std::vector<std::vector<std::byte>> dequantizedBuffers;
+  dequantizedBuffers.reserve(parentPrimitive.attributes.size());
+
+  // Add up the per-vertex size of all attributes and create accessors
+  int64_t vertexSizeFloats = 0;
+  int32_t uvAccessorIndex = -1;
+  int32_t positionAttributeIndex = -1;
+  int32_t attributeCount = 0;
+
+  std::vector<std::string> toRemove;
+
+  std::string textureCoordinateName =
+      "_CESIUMOVERLAY_" + std::to_string(textureCoordinateIndex);
+
+  for (const std::pair<const std::string, int>& attribute :
+       parentPrimitive.attributes) {
+    if (attribute.first.find("_CESIUMOVERLAY_") == 0) {
+      if (uvAccessorIndex == -1) {
+        if (attribute.first == textureCoordinateName) {
+          uvAccessorIndex = attribute.second;
+        }
+      }
+      // Do not include _CESIUMOVERLAY_*, it will be generated later.
+      toRemove.push_back(attribute.first);
+      continue;
+    }
+
+    if (attribute.second < 0 ||
+        attribute.second >= static_cast<int>(parentModel.accessors.size())) {
+      toRemove.push_back(attribute.first);
+      continue;
+    }
+
+    const Accessor& accessor =
+        parentModel.accessors[static_cast<size_t>(attribute.second)];
+    if (accessor.bufferView < 0 ||
+        accessor.bufferView >=
+            static_cast<int>(parentModel.bufferViews.size())) {
+      toRemove.push_back(attribute.first);
+      continue;
+    }
+
+    const BufferView& bufferView =
+        parentModel.bufferViews[static_cast<size_t>(accessor.bufferView)];
+    if (bufferView.buffer < 0 ||
+        bufferView.buffer >= static_cast<int>(parentModel.buffers.size())) {
+      toRemove.push_back(attribute.first);
+      continue;
+    }
+
+    const Buffer& buffer =
+        parentModel.buffers[static_cast<size_t>(bufferView.buffer)];
+
+    const std::vector<std::byte>* pData = &buffer.cesium.data;
+    int64_t dataOffset = bufferView.byteOffset + accessor.byteOffset;
+    int64_t accessorByteStride = accessor.computeByteStride(parentModel);
+    const int64_t accessorComponentElements =
+        accessor.computeNumberOfComponents();
+    if (accessor.componentType != Accessor::ComponentType::FLOAT) {
+      // Can only interpolate floating point vertex attributes, so quantized
+      // positions, normals, tangents, and texture coordinates are dequantized
+      // first. Other attributes are removed.
+      const std::string& name = attribute.first;
+      const bool isQuantizable = name == "POSITION" || name == "NORMAL" ||
+                                 name == "TANGENT" ||
+                                 name.find("TEXCOORD") == 0;
+      std::vector<std::byte>& dequantized = dequantizedBuffers.emplace_back();
+      if (!isQuantizable || !dequantizeVertexAttribute(
+                                accessor,
+                                buffer.cesium.data,
+                                dataOffset,
+                                accessorByteStride,
+                                dequantized)) {
+        dequantizedBuffers.pop_back();
+        toRemove.push_back(attribute.first);
+        continue;
+      }
+
+      pData = &dequantized;
+      dataOffset = 0;
+      accessorByteStride = accessorComponentElements * int64_t(sizeof(float));
+    }
+
+    for (UpsampledPrimitiveClip& clip : clips) {
+      Model& model = clip.upsampled.model;
+      const int32_t accessorIndex =
+          static_cast<int32_t>(model.accessors.size());
+      clip.upsampled.primitive.attributes[attribute.first] = accessorIndex;
+
+      Accessor& newAccessor = model.accessors.emplace_back();
+      newAccessor.bufferView = static_cast<int>(clip.vertexBufferViewIndex);
+      newAccessor.byteOffset = vertexSizeFloats * int64_t(sizeof(float));
+      newAccessor.componentType = Accessor::ComponentType::FLOAT;
+      newAccessor.type = accessor.type;
+
+      clip.attributes.push_back(FloatVertexAttribute{
+          *pData,
+          dataOffset,
+          accessorByteStride,
+          accessorComponentElements,
+          accessorIndex,
+          std::vector<double>(
+              static_cast<size_t>(accessorComponentElements),
+              std::numeric_limits<double>::max()),
+          std::vector<double>(
+              static_cast<size_t>(accessorComponentElements),
+              std::numeric_limits<double>::lowest()),
+      });
+    }
+
+    vertexSizeFloats += accessorComponentElements;
+
+    // get position to be used to create for skirts later
+    if (attribute.first == "POSITION") {
+      positionAttributeIndex = attributeCount;
+    }
+    ++attributeCount;
+  }
+
+  if (uvAccessorIndex == -1) {
+    // We don't know how to divide this primitive, so just remove it.
+    return;
+  }
+
+  for (UpsampledPrimitiveClip& clip : clips) {
+    for (const std::string& attribute : toRemove) {
+      clip.upsampled.primitive.attributes.erase(attribute);
+    }
+  }
+
+  // The triangles are clipped with floating-point texture coordinates, so
+  // quantized ones are dequantized first.
+  std::vector<std::byte> dequantizedUvs;
+  const AccessorView<glm::vec2> uvView =
+      getFloatTextureCoordinates(parentModel, uvAccessorIndex, dequantizedUvs);
+  const AccessorView<TIndex> indicesView(parentModel, parentPrimitive.indices);
+
+  if (uvView.status() != AccessorViewStatus::Valid ||
+      indicesView.status() != AccessorViewStatus::Valid) {
+    return;
+  }
+
+  // check if the primitive has skirts
+  int64_t indicesBegin = 0;
+  int64_t indicesCount = indicesView.size();
+  std::optional<SkirtMeshMetadata> parentSkirtMeshMetadata =
+      SkirtMeshMetadata::parseFromGltfExtras(parentPrimitive.extras);
+  if (positionAttributeIndex == -1) {
+    parentSkirtMeshMetadata.reset();
+  }
+  const bool hasSkirt = parentSkirtMeshMetadata != std::nullopt;
+  if (hasSkirt) {
+    indicesBegin = parentSkirtMeshMetadata->noSkirtIndicesBegin;
+    indicesCount = parentSkirtMeshMetadata->noSkirtIndicesCount;
+  }
+
+  // The scratch vectors reuse the memory of earlier primitives clipped in
+  // this thread.
+  ScratchVector<uint32_t> clipVertexToIndicesScratch;
+  ScratchVector<CesiumGeometry::TriangleClipVertex> clippedAScratch;
+  ScratchVector<CesiumGeometry::TriangleClipVertex> clippedBScratch;
+  std::vector<uint32_t>& clipVertexToIndices = *clipVertexToIndicesScratch;
+  std::vector<CesiumGeometry::TriangleClipVertex>& clippedA = *clippedAScratch;
+  std::vector<CesiumGeometry::TriangleClipVertex>& clippedB = *clippedBScratch;
+
+  // Each child gets about a quarter of the parent's triangles and vertices.
+  for (UpsampledPrimitiveClip& clip : clips) {
+    clip.vertexMap.resize(
+        size_t(uvView.size()),
+        std::numeric_limits<uint32_t>::max());
+    clip.newVertexFloats.reserve(
+        size_t(uvView.size() / 4 + 1) * size_t(vertexSizeFloats));
+    clip.indices.reserve(size_t(indicesCount / 4 + 3));
+  }
+
+  ScratchVector<uint8_t> vertexSidesScratch;
+  std::vector<uint8_t>& vertexSides = *vertexSidesScratch;
+  vertexSides.resize(size_t(uvView.size()));
+  for (int64_t i = 0; i < uvView.size(); ++i) {
+    const glm::vec2 uv = uvView[i];
+    vertexSides[size_t(i)] = uint8_t(
+        (uv.x < 0.5f ? belowU : 0) | (uv.x > 0.5f ? aboveU : 0) |
+        (uv.y < 0.5f ? belowV : 0) | (uv.y > 0.5f ? aboveV : 0));
+  }
+
+  // An invalid index is left for the clip below to report.
+  auto getSides = [&vertexSides](TIndex index) {
+    return size_t(index) < vertexSides.size() ? vertexSides[size_t(index)]
+                                              : unclassified;
+  };
+
+  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
+    TIndex i0 = indicesView[i];
+    TIndex i1 = indicesView[i + 1];
+    TIndex i2 = indicesView[i + 2];
+
+    const uint8_t sides0 = getSides(i0);
+    const uint8_t sides1 = getSides(i1);
+    const uint8_t sides2 = getSides(i2);
+    const uint8_t sidesOfAll = uint8_t(sides0 & sides1 & sides2);
+    const uint8_t sidesOfAny = uint8_t(sides0 | sides1 | sides2);
+
+    for (UpsampledPrimitiveClip& clip : clips) {
+      if ((sidesOfAll & clip.behindSides) != 0) {
+        // The whole triangle is behind one of the thresholds, so no part of
+        // it is inside this child.
+        continue;
+      }
+
+      // A triangle with no vertex behind either threshold is kept as it is.
+      const bool isInside =
+          (sidesOfAny & (clip.behindSides | unclassified)) == 0;
+
+      // Clip this triangle against the East-West boundary
+      clippedA.clear();
+      if (isInside) {
+        clippedA.emplace_back(static_cast<int>(i0));
+        clippedA.emplace_back(static_cast<int>(i1));
+        clippedA.emplace_back(static_cast<int>(i2));
+      } else {
+        clipTriangleAtAxisAlignedThreshold(
+            0.5,
+            clip.keepAboveU,
+            static_cast<int>(i0),
+            static_cast<int>(i1),
+            static_cast<int>(i2),
+            uvView[i0].x,
+            uvView[i1].x,
+            uvView[i2].x,
+            clippedA);
+      }
+
+      if (clippedA.size() < 3) {
+        // No part of this triangle is inside the target tile.
+        continue;
+      }
+
+      // Clip the first clipped triange against the North-South boundary
+      clipVertexToIndices.clear();
+      clippedB.clear();
+      if (isInside) {
+        clippedB.emplace_back(~0);
+        clippedB.emplace_back(~1);
+        clippedB.emplace_back(~2);
+      } else {
+        clipTriangleAtAxisAlignedThreshold(
+            0.5,
+            clip.keepAboveV,
+            ~0,
+            ~1,
+            ~2,
+            getVertexValue(uvView, clippedA[0]).y,
+            getVertexValue(uvView, clippedA[1]).y,
+            getVertexValue(uvView, clippedA[2]).y,
+            clippedB);
+      }
+
+      // Add the clipped triangle or quad, if any
+      addClippedPolygon(
+          clip.newVertexFloats,
+          clip.indices,
+          clip.attributes,
+          clip.vertexMap,
+          clipVertexToIndices,
+          clippedA,
+          clippedB);
+      if (hasSkirt) {
+        addEdge(
+            clip.edgeIndices,
+            0.5,
+            0.5,
+            clip.keepAboveU,
+            clip.keepAboveV,
+            uvView,
+            clipVertexToIndices,
+            clippedA,
+            clippedB);
+      }
+
+      // If the East-West clip yielded a quad (rather than a triangle), clip
+      // the second triangle of the quad, too.
+      if (clippedA.size() > 3) {
+        clipVertexToIndices.clear();
+        clippedB.clear();
+        clipTriangleAtAxisAlignedThreshold(
+            0.5,
+            clip.keepAboveV,
+            ~0,
+            ~2,
+            ~3,
+            getVertexValue(uvView, clippedA[0]).y,
+            getVertexValue(uvView, clippedA[2]).y,
+            getVertexValue(uvView, clippedA[3]).y,
+            clippedB);
+
+        // Add the clipped triangle or quad, if any
+        addClippedPolygon(
+            clip.newVertexFloats,
+            clip.indices,
+            clip.attributes,
+            clip.vertexMap,
+            clipVertexToIndices,
+            clippedA,
+            clippedB);
+        if (hasSkirt) {
+          addEdge(
+              clip.edgeIndices,
+              0.5,
+              0.5,
+              clip.keepAboveU,
+              clip.keepAboveV,
+              uvView,
+              clipVertexToIndices,
+              clippedA,
+              clippedB);
+        }
+      }
+    }
+  }
+
+  for (UpsampledPrimitiveClip& clip : clips) {
+    clip.upsampled.keep = finishUpsampledPrimitive(
+        clip,
+        parentSkirtMeshMetadata,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
+}
+
 static uint32_t getOrCreateVertex(
     std::vector<float>& output,
     std::vector<FloatVertexAttribute>& attributes,
@@ -1008,6 +1502,20 @@ static void addSkirt(
   }
 }
 
+// Appends the sorted indices of the vertices along one edge, without the
+// repeats of a vertex shared by several clipped triangles, and returns how
+// many there are.
+static uint32_t appendSkirtEdgeIndices(
+    const std::vector<uint32_t>& sortedEdgeIndices,
+    std::vector<uint32_t>& skirtEdgeIndices) {
+  const size_t begin = skirtEdgeIndices.size();
+  std::unique_copy(
+      sortedEdgeIndices.begin(),
+      sortedEdgeIndices.end(),
+      std::back_inserter(skirtEdgeIndices));
+  return static_cast<uint32_t>(skirtEdgeIndices.size() - begin);
+}
+
 static void addSkirts(
     std::vector<float>& output,
     std::vector<uint32_t>& indices,
@@ -1017,8 +1525,9 @@ static void addSkirts(
     const SkirtMeshMetadata& parentSkirt,
     EdgeIndices& edgeIndices,
     int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex) {
-  CESIUM_TRACE("addSkirts");
+    int32_t positionAttributeIndex,
+    std::vector<uint32_t>* pSkirtEdgeIndices) {
+  CESIUM_TRACE_CATEGORY(Raster, "addSkirts");
 
   const glm::dvec3 center = currentSkirt.meshCenter;
   double shortestSkirtHeight =
@@ -1047,15 +1556,20 @@ static void addSkirts(
       edgeIndices.west.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtWestHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (pSkirtEdgeIndices) {
+    currentSkirt.skirtWestEdgeCount =
+        appendSkirtEdgeIndices(sortEdgeIndices, *pSkirtEdgeIndices);
+  } else {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtWestHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
 
   // south
   if (isSouthChild(childID)) {
@@ -1076,15 +1590,20 @@ static void addSkirts(
       edgeIndices.south.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtSouthHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (pSkirtEdgeIndices) {
+    currentSkirt.skirtSouthEdgeCount =
+        appendSkirtEdgeIndices(sortEdgeIndices, *pSkirtEdgeIndices);
+  } else {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtSouthHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
 
   // east
   if (!isWestChild(childID)) {
@@ -1105,15 +1624,20 @@ static void addSkirts(
       edgeIndices.east.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtEastHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (pSkirtEdgeIndices) {
+    currentSkirt.skirtEastEdgeCount =
+        appendSkirtEdgeIndices(sortEdgeIndices, *pSkirtEdgeIndices);
+  } else {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtEastHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
 
   // north
   if (!isSouthChild(childID)) {
@@ -1134,66 +1658,62 @@ static void addSkirts(
       edgeIndices.north.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtNorthHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (pSkirtEdgeIndices) {
+    currentSkirt.skirtNorthEdgeCount =
+        appendSkirtEdgeIndices(sortEdgeIndices, *pSkirtEdgeIndices);
+  } else {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtNorthHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  }
 }
 
-static bool upsamplePrimitiveForRasterOverlays(
+static void upsamplePrimitiveForRasterOverlays(
     const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID,
+    const MeshPrimitive& parentPrimitive,
+    std::vector<UpsampledPrimitive>& children,
     int32_t textureCoordinateIndex) {
-  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
-      primitive.indices < 0 ||
-      primitive.indices >= static_cast<int>(parentModel.accessors.size())) {
+  if (parentPrimitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      parentPrimitive.indices < 0 ||
+      parentPrimitive.indices >=
+          static_cast<int>(parentModel.accessors.size())) {
     // Not indexed triangles, so we don't know how to divide this primitive
     // (yet). So remove it.
-    return false;
+    return;
   }
 
   const Accessor& indicesAccessorGltf =
-      parentModel.accessors[static_cast<size_t>(primitive.indices)];
+      parentModel.accessors[static_cast<size_t>(parentPrimitive.indices)];
   if (indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_BYTE) {
-    return upsamplePrimitiveForRasterOverlays<uint8_t>(
+    upsamplePrimitiveForRasterOverlays<uint8_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   } else if (
       indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_SHORT) {
-    return upsamplePrimitiveForRasterOverlays<uint16_t>(
+    upsamplePrimitiveForRasterOverlays<uint16_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   } else if (
       indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_INT) {
-    return upsamplePrimitiveForRasterOverlays<uint32_t>(
+    upsamplePrimitiveForRasterOverlays<uint32_t>(
         parentModel,
-        model,
-        mesh,
-        primitive,
-        childID,
+        parentPrimitive,
+        children,
         textureCoordinateIndex);
   }
-
-  return false;
 }
 
 // Copy a buffer view from a parent to a child. Create a new buffer on the
@@ -0,0 +1,97 @@
+#include <Cesium3DTilesContent/B3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CancellationToken.h>
+#include <CesiumNativeTests/ThreadTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGltf;
+
+namespace {
+std::vector<std::byte>
+createComposite(const std::vector<std::vector<std::byte>>& innerTiles) {
+  std::vector<std::byte> cmpt(16);
+  for (const std::vector<std::byte>& innerTile : innerTiles) {
+    cmpt.insert(cmpt.end(), innerTile.begin(), innerTile.end());
+  }
+
+  const uint32_t header[] = {
+      1,
+      static_cast<uint32_t>(cmpt.size()),
+      static_cast<uint32_t>(innerTiles.size())};
+  std::memcpy(cmpt.data(), "cmpt", 4);
+  std::memcpy(cmpt.data() + 4, header, sizeof(header));
+
+  return cmpt;
+}
+} // namespace
+
+TEST_CASE("CmptToGltfConverter") {
+  registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "BatchTables";
+  const std::vector<std::byte> b3dm =
+      readFile(testDataPath / "batchedWithJson.b3dm");
+  const std::vector<std::byte> dracoB3dm =
+      readFile(testDataPath / "batchedWithBatchTable-draco.b3dm");
+  const std::vector<std::byte> cmpt =
+      createComposite({b3dm, dracoB3dm, b3dm, dracoB3dm});
+
+  GltfConverterResult single = B3dmToGltfConverter::convert(b3dm, {});
+  GltfConverterResult singleDraco =
+      B3dmToGltfConverter::convert(dracoB3dm, {});
+  REQUIRE(single.model);
+  REQUIRE(singleDraco.model);
+  const size_t expectedMeshes =
+      2 * (single.model->meshes.size() + singleDraco.model->meshes.size());
+  const size_t expectedBuffers =
+      2 * (single.model->buffers.size() + singleDraco.model->buffers.size());
+
+  SECTION("merges the inner tiles converted in the calling thread") {
+    GltfConverterResult result = CmptToGltfConverter::convert(cmpt, {});
+    REQUIRE(result.model);
+    CHECK(result.model->meshes.size() == expectedMeshes);
+    CHECK(result.model->buffers.size() == expectedBuffers);
+  }
+
+  SECTION("merges the inner tiles converted in parallel in the same order") {
+    CesiumGltfReader::GltfReaderOptions options;
+    options.asyncSystem = CesiumAsync::AsyncSystem(
+        std::make_shared<CesiumNativeTests::ThreadTaskProcessor>());
+
+    GltfConverterResult serial = CmptToGltfConverter::convert(cmpt, {});
+    GltfConverterResult parallel = CmptToGltfConverter::convert(cmpt, options);
+    REQUIRE(serial.model);
+    REQUIRE(parallel.model);
+    CHECK(parallel.model->meshes.size() == expectedMeshes);
+    REQUIRE(parallel.model->buffers.size() == serial.model->buffers.size());
+    for (size_t i = 0; i < serial.model->buffers.size(); ++i) {
+      CHECK(
+          parallel.model->buffers[i].cesium.data ==
+          serial.model->buffers[i].cesium.data);
+    }
+  }
+
+  SECTION("stops converting the inner tiles when canceled") {
+    CesiumAsync::CancellationTokenSource cancellation;
+    cancellation.cancel();
+
+    CesiumGltfReader::GltfReaderOptions options;
+    options.cancellationToken = cancellation.getToken();
+
+    GltfConverterResult result = CmptToGltfConverter::convert(cmpt, options);
+    CHECK(!result.model);
+    CHECK(result.errors.hasErrors());
+  }
+}
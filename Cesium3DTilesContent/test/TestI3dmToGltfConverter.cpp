@@ -0,0 +1,273 @@
+#include <Cesium3DTilesContent/GltfConverters.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumGeometry/Transforms.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionCesiumRTC.h>
+#include <CesiumGltf/ExtensionExtInstanceFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+
+namespace {
+const std::string gltfJson =
+    R"({"asset":{"version":"2.0"},)"
+    R"("meshes":[{"primitives":[{"attributes":{}}]}],)"
+    R"("nodes":[{"mesh":0,"translation":[1,2,3]}],)"
+    R"("scenes":[{"nodes":[0]}],"scene":0})";
+
+template <typename T>
+void appendValues(std::vector<std::byte>& bytes, const std::vector<T>& values) {
+  const size_t offset = bytes.size();
+  bytes.resize(offset + values.size() * sizeof(T));
+  std::memcpy(bytes.data() + offset, values.data(), values.size() * sizeof(T));
+}
+
+std::vector<std::byte> createI3dm(
+    const std::string& featureTableJson,
+    const std::vector<std::byte>& featureTableBinary,
+    const std::string& batchTableJson = "",
+    uint32_t gltfFormat = 1) {
+  std::vector<std::byte> i3dm(32);
+  appendValues(
+      i3dm,
+      std::vector<char>(featureTableJson.begin(), featureTableJson.end()));
+  appendValues(i3dm, featureTableBinary);
+  appendValues(
+      i3dm,
+      std::vector<char>(batchTableJson.begin(), batchTableJson.end()));
+  appendValues(i3dm, std::vector<char>(gltfJson.begin(), gltfJson.end()));
+
+  const uint32_t header[] = {
+      1,
+      static_cast<uint32_t>(i3dm.size()),
+      static_cast<uint32_t>(featureTableJson.size()),
+      static_cast<uint32_t>(featureTableBinary.size()),
+      static_cast<uint32_t>(batchTableJson.size()),
+      0,
+      gltfFormat};
+  std::memcpy(i3dm.data(), "i3dm", 4);
+  std::memcpy(i3dm.data() + 4, header, sizeof(header));
+
+  return i3dm;
+}
+
+glm::dmat4 getInstanceTransform(
+    const Model& gltf,
+    const ExtensionExtMeshGpuInstancing& instancing,
+    int64_t instance) {
+  AccessorView<glm::vec3> translations(
+      gltf,
+      instancing.attributes.at("TRANSLATION"));
+  AccessorView<glm::vec4> rotations(gltf, instancing.attributes.at("ROTATION"));
+  AccessorView<glm::vec3> scales(gltf, instancing.attributes.at("SCALE"));
+  REQUIRE(translations.status() == AccessorViewStatus::Valid);
+  REQUIRE(rotations.status() == AccessorViewStatus::Valid);
+  REQUIRE(scales.status() == AccessorViewStatus::Valid);
+
+  const glm::dvec4 rotation(rotations[instance]);
+  return glm::translate(glm::dmat4(1.0), glm::dvec3(translations[instance])) *
+         glm::mat4_cast(
+             glm::dquat(rotation.w, rotation.x, rotation.y, rotation.z)) *
+         glm::scale(glm::dmat4(1.0), glm::dvec3(scales[instance]));
+}
+
+void checkMatrix(const glm::dmat4& actual, const glm::dmat4& expected) {
+  for (glm::length_t i = 0; i < 4; i++) {
+    for (glm::length_t j = 0; j < 4; j++) {
+      CHECK(actual[i][j] == Approx(expected[i][j]).margin(1e-3));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("I3dmToGltfConverter") {
+  const glm::dmat4 nodeTransform =
+      glm::translate(glm::dmat4(1.0), glm::dvec3(1.0, 2.0, 3.0));
+  const glm::dmat4 nodeToTile = Transforms::Y_UP_TO_Z_UP * nodeTransform;
+
+  SECTION("converts positions to instance translations of the mesh node") {
+    std::vector<std::byte> featureTableBinary;
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::vec3>{{10.0f, 0.0f, 0.0f}, {-10.0f, 0.0f, 5.0f}});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":2,"POSITION":{"byteOffset":0}})",
+        featureTableBinary);
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(i3dm, {});
+    REQUIRE(result.model);
+    CHECK(!result.errors);
+
+    Model& gltf = *result.model;
+    CHECK(gltf.meshes.size() == 1);
+    CHECK(gltf.isExtensionRequired(
+        ExtensionExtMeshGpuInstancing::ExtensionName));
+
+    // The positions are stored relative to the center of their bounds.
+    ExtensionCesiumRTC* pRtc = gltf.getExtension<ExtensionCesiumRTC>();
+    REQUIRE(pRtc);
+    CHECK(pRtc->center == std::vector<double>{0.0, 0.0, 2.5});
+
+    ExtensionExtMeshGpuInstancing* pInstancing =
+        gltf.nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+    REQUIRE(pInstancing);
+    CHECK(pInstancing->attributes.count("_FEATURE_ID_0") == 0);
+
+    const std::vector<glm::dvec3> expected{
+        {10.0, 0.0, -2.5},
+        {-10.0, 0.0, 2.5}};
+    for (size_t i = 0; i < expected.size(); i++) {
+      checkMatrix(
+          nodeToTile * getInstanceTransform(gltf, *pInstancing, int64_t(i)),
+          glm::translate(glm::dmat4(1.0), expected[i]) * nodeToTile);
+    }
+  }
+
+  SECTION("decodes quantized positions, oct-encoded normals and scales") {
+    std::vector<std::byte> featureTableBinary;
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::u16vec3>{{1, 2, 3}, {3, 2, 1}});
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::u16vec2>{{32768, 32768}, {32768, 32768}});
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::u16vec2>{{65535, 32768}, {65535, 32768}});
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::vec3>{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":2,"RTC_CENTER":[1000,0,0],)"
+        R"("QUANTIZED_VOLUME_OFFSET":[100,200,300],)"
+        R"("QUANTIZED_VOLUME_SCALE":[65535,65535,65535],)"
+        R"("POSITION_QUANTIZED":{"byteOffset":0},)"
+        R"("NORMAL_UP_OCT32P":{"byteOffset":12},)"
+        R"("NORMAL_RIGHT_OCT32P":{"byteOffset":20},)"
+        R"("SCALE_NON_UNIFORM":{"byteOffset":28}})",
+        featureTableBinary);
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(i3dm, {});
+    REQUIRE(result.model);
+    CHECK(!result.errors);
+
+    Model& gltf = *result.model;
+    ExtensionCesiumRTC* pRtc = gltf.getExtension<ExtensionCesiumRTC>();
+    REQUIRE(pRtc);
+    CHECK(pRtc->center == std::vector<double>{1102.0, 202.0, 302.0});
+
+    ExtensionExtMeshGpuInstancing* pInstancing =
+        gltf.nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+    REQUIRE(pInstancing);
+
+    // Up is +Z and right is +X, so forward is -Y.
+    const glm::dmat4 rotation(glm::dmat3(
+        glm::dvec3(1.0, 0.0, 0.0),
+        glm::dvec3(0.0, 0.0, 1.0),
+        glm::dvec3(0.0, -1.0, 0.0)));
+    const std::vector<glm::dvec3> translations{
+        {-1.0, 0.0, 1.0},
+        {1.0, 0.0, -1.0}};
+    const std::vector<glm::dvec3> scales{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    for (size_t i = 0; i < translations.size(); i++) {
+      const glm::dmat4 instanceTransform =
+          glm::translate(glm::dmat4(1.0), translations[i]) * rotation *
+          glm::scale(glm::dmat4(1.0), scales[i]);
+      checkMatrix(
+          nodeToTile * getInstanceTransform(gltf, *pInstancing, int64_t(i)),
+          instanceTransform * nodeToTile);
+    }
+  }
+
+  SECTION("converts BATCH_ID and the batch table to instance features") {
+    std::vector<std::byte> featureTableBinary;
+    appendValues(
+        featureTableBinary,
+        std::vector<glm::vec3>{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}});
+    appendValues(featureTableBinary, std::vector<uint8_t>{1, 0});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":2,"POSITION":{"byteOffset":0},)"
+        R"("BATCH_ID":{"byteOffset":24,"componentType":"UNSIGNED_BYTE"}})",
+        featureTableBinary,
+        R"({"height":[10,20]})");
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(i3dm, {});
+    REQUIRE(result.model);
+
+    Model& gltf = *result.model;
+    CHECK(gltf.getExtension<ExtensionModelExtStructuralMetadata>());
+
+    const Node& node = gltf.nodes[0];
+    const ExtensionExtMeshGpuInstancing* pInstancing =
+        node.getExtension<ExtensionExtMeshGpuInstancing>();
+    REQUIRE(pInstancing);
+    auto featureIdIt = pInstancing->attributes.find("_FEATURE_ID_0");
+    REQUIRE(featureIdIt != pInstancing->attributes.end());
+
+    AccessorView<uint8_t> featureIds(gltf, featureIdIt->second);
+    REQUIRE(featureIds.size() == 2);
+    CHECK(featureIds[0] == 1);
+    CHECK(featureIds[1] == 0);
+
+    const ExtensionExtInstanceFeatures* pFeatures =
+        node.getExtension<ExtensionExtInstanceFeatures>();
+    REQUIRE(pFeatures);
+    REQUIRE(pFeatures->featureIds.size() == 1);
+    CHECK(pFeatures->featureIds[0].featureCount == 2);
+    CHECK(pFeatures->featureIds[0].attribute == 0);
+    CHECK(pFeatures->featureIds[0].propertyTable == 0);
+  }
+
+  SECTION("reports instances of a glTF referenced by a URI") {
+    std::vector<std::byte> featureTableBinary;
+    appendValues(featureTableBinary, std::vector<glm::vec3>{{}});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":1,"POSITION":{"byteOffset":0}})",
+        featureTableBinary,
+        "",
+        0);
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(i3dm, {});
+    CHECK(!result.model);
+    CHECK(result.errors.hasErrors());
+  }
+
+  SECTION("reports positions out of the bounds of the feature table") {
+    std::vector<std::byte> featureTableBinary;
+    appendValues(featureTableBinary, std::vector<glm::vec3>{{}});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":2,"POSITION":{"byteOffset":0}})",
+        featureTableBinary);
+
+    GltfConverterResult result = I3dmToGltfConverter::convert(i3dm, {});
+    CHECK(!result.model);
+    CHECK(result.errors.hasErrors());
+  }
+
+  SECTION("is registered for its magic") {
+    registerAllTileContentTypes();
+
+    std::vector<std::byte> featureTableBinary;
+    appendValues(featureTableBinary, std::vector<glm::vec3>{{}});
+    const std::vector<std::byte> i3dm = createI3dm(
+        R"({"INSTANCES_LENGTH":1,"POSITION":{"byteOffset":0}})",
+        featureTableBinary);
+
+    CHECK(
+        GltfConverters::getConverterByMagic(i3dm) ==
+        &I3dmToGltfConverter::convert);
+  }
+}
@@ -2,6 +2,7 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/HttpHeaders.h>
+#include <CesiumGeometry/Transforms.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionExtMeshFeatures.h>
 #include <CesiumGltf/ExtensionKhrMaterialsUnlit.h>
@@ -13,6 +14,7 @@
 #include <spdlog/sinks/ringbuffer_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <cstring>
 #include <filesystem>
 #include <set>
 
@@ -557,6 +559,90 @@ TEST_CASE("Converts point cloud with quantized positions to glTF") {
   checkBufferContents<glm::vec3>(positionBuffer.cesium.data, expectedPositions);
 }
 
+TEST_CASE("Converts point cloud with quantized positions to glTF with "
+          "KHR_mesh_quantization") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath = testFilePath / "PointCloud" / "pointCloudQuantized.pnts";
+  const int32_t pointsLength = 8;
+
+  CesiumGltfReader::GltfReaderOptions options;
+  options.dequantizeMeshData = false;
+  GltfConverterResult result =
+      ConvertTileToGltf::fromPnts(testFilePath, options);
+
+  REQUIRE(result.model);
+  Model& gltf = *result.model;
+
+  CHECK(gltf.isExtensionUsed("KHR_mesh_quantization"));
+  CHECK(gltf.isExtensionRequired("KHR_mesh_quantization"));
+
+  REQUIRE(gltf.nodes.size() == 1);
+  REQUIRE(gltf.meshes.size() == 1);
+  MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+
+  // The colors are unaffected.
+  checkAttribute<glm::vec3>(gltf, primitive, "COLOR_0", pointsLength);
+
+  // The positions keep their quantized values, padded to four components.
+  const uint32_t positionAccessorId =
+      static_cast<uint32_t>(primitive.attributes.at("POSITION"));
+  const Accessor& positionAccessor = gltf.accessors[positionAccessorId];
+  CHECK(positionAccessor.componentType ==
+        Accessor::ComponentType::UNSIGNED_SHORT);
+  CHECK(positionAccessor.type == Accessor::Type::VEC3);
+  CHECK(positionAccessor.count == pointsLength);
+  CHECK(!positionAccessor.normalized);
+
+  const BufferView& positionBufferView =
+      gltf.bufferViews[static_cast<uint32_t>(positionAccessor.bufferView)];
+  CHECK(
+      positionBufferView.byteStride ==
+      static_cast<int64_t>(sizeof(glm::u16vec4)));
+  const Buffer& positionBuffer =
+      gltf.buffers[static_cast<uint32_t>(positionBufferView.buffer)];
+  REQUIRE(
+      positionBuffer.cesium.data.size() ==
+      static_cast<size_t>(pointsLength) * sizeof(glm::u16vec4));
+
+  // The node's transform dequantizes them to the same positions as before.
+  glm::dmat4 nodeTransform;
+  std::memcpy(&nodeTransform, gltf.nodes[0].matrix.data(), sizeof(glm::dmat4));
+  const glm::dmat4 dequantization =
+      CesiumGeometry::Transforms::Y_UP_TO_Z_UP * nodeTransform;
+
+  const std::vector<glm::vec3> expectedPositions = {
+      glm::vec3(1215010.39, -4736313.38, 4081601.7),
+      glm::vec3(1215015.23, -4736312.13, 4081601.7),
+      glm::vec3(1215009.59, -4736310.26, 4081605.53),
+      glm::vec3(1215014.43, -4736309.02, 4081605.53),
+      glm::vec3(1215011.34, -4736317.08, 4081604.92),
+      glm::vec3(1215016.18, -4736315.84, 4081604.92),
+      glm::vec3(1215010.54, -4736313.97, 4081608.74),
+      glm::vec3(1215015.38, -4736312.73, 4081608.74)};
+
+  const glm::u16vec4* pQuantized =
+      reinterpret_cast<const glm::u16vec4*>(positionBuffer.cesium.data.data());
+  for (size_t i = 0; i < expectedPositions.size(); ++i) {
+    CHECK(pQuantized[i].w == 0);
+    const glm::dvec3 position =
+        glm::dvec3(dequantization * glm::dvec4(glm::dvec3(pQuantized[i]), 1.0));
+    CHECK(Math::equalsEpsilon(
+        position,
+        glm::dvec3(expectedPositions[i]),
+        Math::Epsilon6));
+  }
+
+  const glm::dvec3 min =
+      glm::dvec3(dequantization * glm::dvec4(
+                                      positionAccessor.min[0],
+                                      positionAccessor.min[1],
+                                      positionAccessor.min[2],
+                                      1.0));
+  CHECK(min.x == Approx(1215009.59));
+  CHECK(min.y == Approx(-4736317.08));
+  CHECK(min.z == Approx(4081601.7));
+}
+
 TEST_CASE("Converts point cloud with normals to glTF") {
   std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
   testFilePath = testFilePath / "PointCloud" / "pointCloudNormals.pnts";
@@ -839,6 +925,73 @@ TEST_CASE("Converts point cloud with per-point properties to glTF with "
   checkAttribute<glm::vec3>(gltf, primitive, "COLOR_0", pointsLength);
 }
 
+TEST_CASE("Converts point cloud with shuffled points to glTF") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath =
+      testFilePath / "PointCloud" / "pointCloudWithPerPointProperties.pnts";
+  const size_t pointsLength = 8;
+
+  GltfConverterResult original = ConvertTileToGltf::fromPnts(testFilePath);
+  CesiumGltfReader::GltfReaderOptions options;
+  options.shufflePointClouds = true;
+  GltfConverterResult shuffled =
+      ConvertTileToGltf::fromPnts(testFilePath, options);
+
+  REQUIRE(original.model);
+  REQUIRE(shuffled.model);
+  const Model& originalGltf = *original.model;
+  const Model& shuffledGltf = *shuffled.model;
+  const MeshPrimitive& originalPrimitive = originalGltf.meshes[0].primitives[0];
+  const MeshPrimitive& shuffledPrimitive = shuffledGltf.meshes[0].primitives[0];
+
+  // The points refer to their per-point properties with explicit feature IDs.
+  auto pExtension = shuffledPrimitive.getExtension<ExtensionExtMeshFeatures>();
+  REQUIRE(pExtension);
+  REQUIRE(pExtension->featureIds.size() == 1);
+  const FeatureId& featureId = pExtension->featureIds[0];
+  CHECK(featureId.featureCount == int64_t(pointsLength));
+  CHECK(featureId.attribute == 0);
+  CHECK(featureId.propertyTable == 0);
+
+  auto getBufferData = [](const Model& gltf,
+                          const MeshPrimitive& primitive,
+                          const std::string& attribute) {
+    const Accessor& accessor = gltf.accessors[static_cast<size_t>(
+        primitive.attributes.at(attribute))];
+    const BufferView& bufferView =
+        gltf.bufferViews[static_cast<size_t>(accessor.bufferView)];
+    return gltf.buffers[static_cast<size_t>(bufferView.buffer)].cesium.data;
+  };
+
+  const std::vector<std::byte> featureIdData =
+      getBufferData(shuffledGltf, shuffledPrimitive, "_FEATURE_ID_0");
+  REQUIRE(featureIdData.size() == pointsLength * sizeof(uint16_t));
+  std::vector<uint16_t> featureIds(pointsLength);
+  std::memcpy(featureIds.data(), featureIdData.data(), featureIdData.size());
+  CHECK(
+      std::set<uint16_t>(featureIds.begin(), featureIds.end()).size() ==
+      pointsLength);
+
+  // Each point keeps its own position and color.
+  for (const char* attribute : {"POSITION", "COLOR_0"}) {
+    const std::vector<std::byte> originalData =
+        getBufferData(originalGltf, originalPrimitive, attribute);
+    const std::vector<std::byte> shuffledData =
+        getBufferData(shuffledGltf, shuffledPrimitive, attribute);
+    REQUIRE(originalData.size() == pointsLength * sizeof(glm::vec3));
+    REQUIRE(shuffledData.size() == originalData.size());
+
+    for (size_t i = 0; i < pointsLength; ++i) {
+      CHECK(
+          std::memcmp(
+              shuffledData.data() + i * sizeof(glm::vec3),
+              originalData.data() +
+                  static_cast<size_t>(featureIds[i]) * sizeof(glm::vec3),
+              sizeof(glm::vec3)) == 0);
+    }
+  }
+}
+
 TEST_CASE("Converts point cloud with Draco compression to glTF") {
   std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
   testFilePath = testFilePath / "PointCloud" / "pointCloudDraco.pnts";
@@ -71,6 +71,48 @@ TEST_CASE("Test converting skirt mesh metadata to gltf extras") {
       Math::Epsilon7));
 }
 
+TEST_CASE("Test converting skirt mesh metadata with edge indices") {
+  SkirtMeshMetadata skirtMeshMetadata;
+  skirtMeshMetadata.noSkirtIndicesCount = 12;
+  skirtMeshMetadata.noSkirtVerticesCount = 6;
+  skirtMeshMetadata.skirtEdgeIndicesAccessor = 3;
+  skirtMeshMetadata.skirtWestEdgeCount = 2;
+  skirtMeshMetadata.skirtSouthEdgeCount = 3;
+  skirtMeshMetadata.skirtEastEdgeCount = 4;
+  skirtMeshMetadata.skirtNorthEdgeCount = 5;
+
+  JsonValue::Object extras =
+      SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+  std::optional<SkirtMeshMetadata> parsed =
+      SkirtMeshMetadata::parseFromGltfExtras(extras);
+  REQUIRE(parsed);
+  CHECK(parsed->skirtEdgeIndicesAccessor == 3);
+  CHECK(parsed->skirtWestEdgeCount == 2);
+  CHECK(parsed->skirtSouthEdgeCount == 3);
+  CHECK(parsed->skirtEastEdgeCount == 4);
+  CHECK(parsed->skirtNorthEdgeCount == 5);
+
+  SECTION("without edge indices") {
+    skirtMeshMetadata.skirtEdgeIndicesAccessor = -1;
+    extras = SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+    CHECK(
+        extras["skirtMeshMetadata"].getValuePtrForKey("skirtEdgeIndices") ==
+        nullptr);
+    parsed = SkirtMeshMetadata::parseFromGltfExtras(extras);
+    REQUIRE(parsed);
+    CHECK(parsed->skirtEdgeIndicesAccessor == -1);
+  }
+
+  SECTION("with edge indices missing their counts") {
+    JsonValue::Object* pGltfSkirt =
+        extras["skirtMeshMetadata"].getValuePtrForKey<JsonValue::Object>(
+            "skirtEdgeIndices");
+    REQUIRE(pGltfSkirt);
+    pGltfSkirt->erase("counts");
+    CHECK(!SkirtMeshMetadata::parseFromGltfExtras(extras));
+  }
+}
+
 TEST_CASE("Test converting gltf extras to skirt mesh metadata") {
   // mock gltf extras for skirt mesh metadata
   JsonValue::Object gltfSkirtMeshMetadata = {
@@ -332,6 +332,24 @@ TEST_CASE("Test SubtreeAvailability methods") {
       CHECK(!subtreeAvailability.isSubtreeAvailable(
           libmorton::morton2D_64_encode(tileID.x, tileID.y)));
     }
+
+    SECTION("Child availability masks") {
+      CesiumGeometry::QuadtreeTileID tileID{2, 3, 1};
+      uint64_t mortonID = libmorton::morton2D_64_encode(tileID.x, tileID.y);
+      CHECK(
+          subtreeAvailability.getChildTileAvailabilityMask(
+              tileID.level,
+              mortonID) == 0xF);
+      CHECK(
+          subtreeAvailability.getChildContentAvailabilityMask(
+              tileID.level,
+              mortonID,
+              0) == 0);
+      CHECK(subtreeAvailability.getChildSubtreeAvailabilityMask(mortonID) == 0);
+      CHECK(subtreeAvailability.hasAvailableDescendants(
+          tileID.level,
+          mortonID));
+    }
   }
 
   SECTION("Availability stored in buffer view") {
@@ -473,6 +491,77 @@ TEST_CASE("Test SubtreeAvailability methods") {
             libmorton::morton2D_64_encode(subtreeID.x, subtreeID.y)));
       }
     }
+
+    SECTION("Child availability masks match the availability of each child") {
+      for (uint32_t level = 0; level < maxSubtreeLevels; ++level) {
+        for (uint64_t mortonID = 0; mortonID < (uint64_t(1) << (2 * level));
+             ++mortonID) {
+          const bool isLeaf = level + 1 == maxSubtreeLevels;
+          uint8_t tileMask = quadtreeAvailability.getChildTileAvailabilityMask(
+              level,
+              mortonID);
+          uint8_t contentMask =
+              quadtreeAvailability.getChildContentAvailabilityMask(
+                  level,
+                  mortonID,
+                  0);
+          uint8_t subtreeMask =
+              quadtreeAvailability.getChildSubtreeAvailabilityMask(mortonID);
+
+          for (uint64_t i = 0; i < 4; ++i) {
+            uint64_t childMortonID = mortonID * 4 + i;
+            bool isTileAvailable =
+                !isLeaf &&
+                quadtreeAvailability.isTileAvailable(level + 1, childMortonID);
+            bool isContentAvailable =
+                !isLeaf && quadtreeAvailability.isContentAvailable(
+                               level + 1,
+                               childMortonID,
+                               0);
+            bool isSubtreeAvailable =
+                isLeaf &&
+                quadtreeAvailability.isSubtreeAvailable(childMortonID);
+            CHECK((((tileMask >> i) & 1) != 0) == isTileAvailable);
+            CHECK((((contentMask >> i) & 1) != 0) == isContentAvailable);
+            if (isLeaf) {
+              CHECK((((subtreeMask >> i) & 1) != 0) == isSubtreeAvailable);
+            }
+          }
+        }
+      }
+    }
+
+    SECTION("hasAvailableDescendants()") {
+      std::vector<CesiumGeometry::QuadtreeTileID> tilesWithDescendants{
+          CesiumGeometry::QuadtreeTileID{0, 0, 0},
+          CesiumGeometry::QuadtreeTileID{1, 0, 0},
+          CesiumGeometry::QuadtreeTileID{1, 1, 0},
+          CesiumGeometry::QuadtreeTileID{1, 1, 1},
+          CesiumGeometry::QuadtreeTileID{4, 5, 0},
+          CesiumGeometry::QuadtreeTileID{4, 15, 15}};
+
+      std::vector<CesiumGeometry::QuadtreeTileID> tilesWithoutDescendants{
+          CesiumGeometry::QuadtreeTileID{1, 0, 1},
+          CesiumGeometry::QuadtreeTileID{2, 3, 1},
+          CesiumGeometry::QuadtreeTileID{2, 2, 2},
+          CesiumGeometry::QuadtreeTileID{4, 0, 0},
+
+          // illegal ID, so it shouldn't crash
+          CesiumGeometry::QuadtreeTileID{2, 12, 1},
+          CesiumGeometry::QuadtreeTileID{12, 16, 14}};
+
+      for (const auto& tileID : tilesWithDescendants) {
+        CHECK(quadtreeAvailability.hasAvailableDescendants(
+            tileID.level,
+            libmorton::morton2D_64_encode(tileID.x, tileID.y)));
+      }
+
+      for (const auto& tileID : tilesWithoutDescendants) {
+        CHECK(!quadtreeAvailability.hasAvailableDescendants(
+            tileID.level,
+            libmorton::morton2D_64_encode(tileID.x, tileID.y)));
+      }
+    }
   }
 }
 
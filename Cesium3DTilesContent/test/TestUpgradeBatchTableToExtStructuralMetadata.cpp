@@ -1313,6 +1313,50 @@ TEST_CASE("Upgrade nested JSON metadata to string") {
   }
 }
 
+TEST_CASE("Converts only the listed batch table properties") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath =
+      testFilePath / "BatchTables" / "batchedWithStringAndNestedJson.b3dm";
+
+  CesiumGltfReader::GltfReaderOptions options;
+  options.batchTableProperties = {"info", "missing"};
+  GltfConverterResult result =
+      ConvertTileToGltf::fromB3dm(testFilePath, options);
+
+  REQUIRE(!result.errors);
+  REQUIRE(result.model);
+
+  const Model& model = *result.model;
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  REQUIRE(pMetadata);
+  REQUIRE(pMetadata->schema);
+
+  const Class& defaultClass = pMetadata->schema->classes.at("default");
+  REQUIRE(defaultClass.properties.size() == 1);
+  CHECK(defaultClass.properties.count("info") == 1);
+
+  REQUIRE(pMetadata->propertyTables.size() == 1);
+  const PropertyTable& propertyTable = pMetadata->propertyTables[0];
+  REQUIRE(propertyTable.properties.size() == 1);
+
+  std::vector<std::string> expected;
+  for (int64_t i = 0; i < propertyTable.count; ++i) {
+    expected.push_back(
+        std::string("{\"name\":\"building") + std::to_string(i) +
+        "\",\"year\":" + std::to_string(i) + "}");
+  }
+  checkNonArrayProperty<std::string, std::string_view>(
+      model,
+      propertyTable,
+      defaultClass,
+      "info",
+      ClassProperty::Type::STRING,
+      std::nullopt,
+      expected,
+      expected.size());
+}
+
 TEST_CASE("Upgrade JSON booleans to binary") {
   Model model;
 
@@ -9,6 +9,7 @@
 #include <glm/trigonometric.hpp>
 
 #include <cstring>
+#include <optional>
 #include <vector>
 
 using namespace Cesium3DTilesContent;
@@ -472,6 +473,69 @@ TEST_CASE("Test upsample tile") {
             glm::vec3(static_cast<float>(Math::Epsilon7))) == glm::bvec3(true));
   }
 
+  SECTION("Upsample all four children at once") {
+    const std::vector<CesiumGeometry::UpsampledQuadtreeNode> childIDs{
+        lowerLeft,
+        lowerRight,
+        upperLeft,
+        upperRight};
+    std::vector<std::optional<Model>> upsampledModels =
+        upsampleGltfForRasterOverlayChildren(model, childIDs);
+    REQUIRE(upsampledModels.size() == childIDs.size());
+
+    for (size_t i = 0; i < childIDs.size(); ++i) {
+      std::optional<Model> expected =
+          upsampleGltfForRasterOverlays(model, childIDs[i]);
+      REQUIRE(expected);
+      REQUIRE(upsampledModels[i]);
+
+      const Model& upsampledModel = *upsampledModels[i];
+      REQUIRE(upsampledModel.accessors.size() == expected->accessors.size());
+      for (size_t j = 0; j < expected->accessors.size(); ++j) {
+        CHECK(
+            upsampledModel.accessors[j].count == expected->accessors[j].count);
+        CHECK(upsampledModel.accessors[j].min == expected->accessors[j].min);
+        CHECK(upsampledModel.accessors[j].max == expected->accessors[j].max);
+      }
+
+      REQUIRE(upsampledModel.buffers.size() == expected->buffers.size());
+      for (size_t j = 0; j < expected->buffers.size(); ++j) {
+        CHECK(
+            upsampledModel.buffers[j].cesium.data ==
+            expected->buffers[j].cesium.data);
+      }
+    }
+  }
+
+  SECTION("Upsample from a compact upsampling source") {
+    // Add data that the upsampling doesn't read.
+    model.buffers.front().cesium.data.resize(
+        model.buffers.front().cesium.data.size() + 1024);
+
+    const Model source = createGltfUpsamplingSource(model);
+    REQUIRE(source.buffers.size() == 1);
+    CHECK(
+        source.buffers.front().cesium.data.size() <
+        model.buffers.front().cesium.data.size());
+
+    for (const CesiumGeometry::UpsampledQuadtreeNode& childID :
+         {lowerLeft, lowerRight, upperLeft, upperRight}) {
+      std::optional<Model> expected =
+          upsampleGltfForRasterOverlays(model, childID);
+      std::optional<Model> upsampledModel =
+          upsampleGltfForRasterOverlays(source, childID);
+      REQUIRE(expected);
+      REQUIRE(upsampledModel);
+
+      REQUIRE(upsampledModel->buffers.size() == expected->buffers.size());
+      for (size_t i = 0; i < expected->buffers.size(); ++i) {
+        CHECK(
+            upsampledModel->buffers[i].cesium.data ==
+            expected->buffers[i].cesium.data);
+      }
+    }
+  }
+
   SECTION("Check skirt") {
     // add skirts info to primitive extra in case we need to upsample from it
     double skirtHeight = 12.0;
@@ -588,6 +652,44 @@ TEST_CASE("Test upsample tile") {
           skirtHeight * 0.5);
     }
 
+    SECTION("Check bottom left skirt edge indices") {
+      skirtMeshMetadata.skirtEdgeIndicesAccessor = 0;
+      primitive.extras =
+          SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+
+      Model upsampledModel = *upsampleGltfForRasterOverlays(model, lowerLeft);
+
+      REQUIRE(upsampledModel.meshes.size() == 1);
+      const MeshPrimitive& upsampledPrimitive =
+          upsampledModel.meshes.back().primitives.back();
+
+      // the skirts are left out of the mesh
+      AccessorView<glm::vec3> upsampledPosition(
+          upsampledModel,
+          upsampledPrimitive.attributes.at("POSITION"));
+      CHECK(upsampledPosition.size() == 7);
+
+      std::optional<SkirtMeshMetadata> upsampledSkirt =
+          SkirtMeshMetadata::parseFromGltfExtras(upsampledPrimitive.extras);
+      REQUIRE(upsampledSkirt);
+      CHECK(upsampledSkirt->skirtWestEdgeCount == 2);
+      CHECK(upsampledSkirt->skirtSouthEdgeCount == 3);
+      CHECK(upsampledSkirt->skirtEastEdgeCount == 3);
+      CHECK(upsampledSkirt->skirtNorthEdgeCount == 4);
+      CHECK(upsampledSkirt->skirtWestHeight == skirtHeight);
+      CHECK(upsampledSkirt->skirtEastHeight == skirtHeight * 0.5);
+
+      AccessorView<uint32_t> edgeIndices(
+          upsampledModel,
+          upsampledSkirt->skirtEdgeIndicesAccessor);
+      REQUIRE(edgeIndices.status() == AccessorViewStatus::Valid);
+      const std::vector<uint32_t> expected{0, 3, 1, 4, 0, 5, 1, 4, 3, 2, 6, 5};
+      REQUIRE(edgeIndices.size() == int64_t(expected.size()));
+      for (int64_t i = 0; i < edgeIndices.size(); ++i) {
+        CHECK(edgeIndices[i] == expected[size_t(i)]);
+      }
+    }
+
     SECTION("Check upper left skirt") {
       Model upsampledModel = *upsampleGltfForRasterOverlays(model, upperLeft);
 
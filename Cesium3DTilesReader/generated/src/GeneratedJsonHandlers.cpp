@@ -32,6 +32,11 @@ CesiumJsonReader::IJsonHandler*
 Extension3dTilesBoundingVolumeS2JsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          Cesium3DTiles::Extension3dTilesBoundingVolumeS2::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtension3dTilesBoundingVolumeS2(
       Cesium3DTiles::Extension3dTilesBoundingVolumeS2::TypeName,
       str,
@@ -142,6 +147,9 @@ void StatisticsJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 StatisticsJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Statistics::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyStatistics(
       Cesium3DTiles::Statistics::TypeName,
       str,
@@ -225,6 +233,9 @@ void ClassStatisticsJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ClassStatisticsJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::ClassStatistics::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyClassStatistics(
       Cesium3DTiles::ClassStatistics::TypeName,
       str,
@@ -319,6 +330,11 @@ void PropertyStatisticsJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyStatisticsJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          Cesium3DTiles::PropertyStatistics::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyStatistics(
       Cesium3DTiles::PropertyStatistics::TypeName,
       str,
@@ -427,6 +443,9 @@ void SchemaJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SchemaJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Schema::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySchema(
       Cesium3DTiles::Schema::TypeName,
       str,
@@ -518,6 +537,9 @@ void EnumJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 EnumJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Enum::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyEnum(
       Cesium3DTiles::Enum::TypeName,
       str,
@@ -604,6 +626,9 @@ void EnumValueJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 EnumValueJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::EnumValue::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyEnumValue(
       Cesium3DTiles::EnumValue::TypeName,
       str,
@@ -689,6 +714,9 @@ void ClassJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ClassJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Class::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyClass(
       Cesium3DTiles::Class::TypeName,
       str,
@@ -786,6 +814,9 @@ void ClassPropertyJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ClassPropertyJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::ClassProperty::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyClassProperty(
       Cesium3DTiles::ClassProperty::TypeName,
       str,
@@ -908,6 +939,9 @@ void SubtreeJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SubtreeJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Subtree::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySubtree(
       Cesium3DTiles::Subtree::TypeName,
       str,
@@ -1018,6 +1052,9 @@ void MetadataEntityJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 MetadataEntityJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::MetadataEntity::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMetadataEntity(
       Cesium3DTiles::MetadataEntity::TypeName,
       str,
@@ -1106,6 +1143,9 @@ void AvailabilityJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AvailabilityJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Availability::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAvailability(
       Cesium3DTiles::Availability::TypeName,
       str,
@@ -1196,6 +1236,9 @@ void PropertyTableJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTableJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::PropertyTable::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTable(
       Cesium3DTiles::PropertyTable::TypeName,
       str,
@@ -1294,6 +1337,11 @@ void PropertyTablePropertyJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTablePropertyJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          Cesium3DTiles::PropertyTableProperty::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTableProperty(
       Cesium3DTiles::PropertyTableProperty::TypeName,
       str,
@@ -1406,6 +1454,9 @@ void BufferViewJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 BufferViewJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::BufferView::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyBufferView(
       Cesium3DTiles::BufferView::TypeName,
       str,
@@ -1496,6 +1547,9 @@ void BufferJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 BufferJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Buffer::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyBuffer(
       Cesium3DTiles::Buffer::TypeName,
       str,
@@ -1588,6 +1642,9 @@ void TilesetJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 TilesetJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Tileset::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyTileset(
       Cesium3DTiles::Tileset::TypeName,
       str,
@@ -1698,6 +1755,9 @@ void TileJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 TileJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Tile::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyTile(
       Cesium3DTiles::Tile::TypeName,
       str,
@@ -1800,6 +1860,9 @@ void ImplicitTilingJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ImplicitTilingJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::ImplicitTiling::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyImplicitTiling(
       Cesium3DTiles::ImplicitTiling::TypeName,
       str,
@@ -1895,6 +1958,9 @@ void SubtreesJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SubtreesJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Subtrees::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySubtrees(
       Cesium3DTiles::Subtrees::TypeName,
       str,
@@ -1977,6 +2043,9 @@ void ContentJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ContentJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Content::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyContent(
       Cesium3DTiles::Content::TypeName,
       str,
@@ -2063,6 +2132,9 @@ void BoundingVolumeJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 BoundingVolumeJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::BoundingVolume::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyBoundingVolume(
       Cesium3DTiles::BoundingVolume::TypeName,
       str,
@@ -2150,6 +2222,9 @@ void GroupMetadataJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 GroupMetadataJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::GroupMetadata::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyGroupMetadata(
       Cesium3DTiles::GroupMetadata::TypeName,
       str,
@@ -2234,6 +2309,9 @@ void PropertiesJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertiesJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Properties::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyProperties(
       Cesium3DTiles::Properties::TypeName,
       str,
@@ -2319,6 +2397,9 @@ void AssetJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AssetJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(Cesium3DTiles::Asset::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAsset(
       Cesium3DTiles::Asset::TypeName,
       str,
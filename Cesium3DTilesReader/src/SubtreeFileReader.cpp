@@ -274,8 +274,10 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::postprocess(
   }
 
   if (!bufferRequests.empty()) {
+    // The buffers are downloaded in parallel. Storing them doesn't need the
+    // main thread, so don't wait for it.
     return asyncSystem.all(std::move(bufferRequests))
-        .thenInMainThread(
+        .thenImmediately(
             [loaded = std::move(loaded)](std::vector<RequestedSubtreeBuffer>&&
                                              completedBuffers) mutable {
               for (RequestedSubtreeBuffer& completedBuffer : completedBuffers) {
@@ -4,6 +4,7 @@
 
 #include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/PackedBoundingVolumes.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
@@ -87,4 +88,21 @@ getBoundingRegionFromBoundingVolume(const BoundingVolume& boundingVolume);
 CESIUM3DTILESSELECTION_API CesiumGeometry::OrientedBoundingBox
 getOrientedBoundingBoxFromBoundingVolume(const BoundingVolume& boundingVolume);
 
+/**
+ * @brief Adds the given {@link BoundingVolume} to the end of a batch of
+ * {@link CesiumGeometry::PackedBoundingVolumes}, if it can be represented by
+ * one.
+ *
+ * Spheres, oriented bounding boxes, and bounding regions can be packed.
+ * {@link CesiumGeospatial::S2CellBoundingVolume} cannot, and must be culled
+ * individually.
+ *
+ * @param boundingVolume The bounding volume.
+ * @param packed The batch to add the bounding volume to.
+ * @return Whether the bounding volume was added to the batch.
+ */
+CESIUM3DTILESSELECTION_API bool packBoundingVolume(
+    const BoundingVolume& boundingVolume,
+    CesiumGeometry::PackedBoundingVolumes& packed);
+
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ITileEvictionPolicy.h"
+#include "Library.h"
+
+#include <functional>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief When provided to {@link TilesetOptions::evictionPolicy}, unloads the
+ * tiles that are cheapest to load again, per byte freed, first.
+ *
+ * This keeps tiles that are expensive to reload, such as those that must be
+ * decompressed, in the cache in favor of large tiles that are quick to load.
+ * Tiles with the same cost per byte are unloaded in least-recently-used order.
+ */
+class CESIUM3DTILESSELECTION_API CostAwareTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief A function that estimates the cost of loading a tile again, in
+   * arbitrary but consistent units.
+   */
+  using ReloadCostEstimator = std::function<double(const Tile& tile)>;
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param estimateReloadCost Estimates the cost of loading a tile again. If
+   * this is empty, the time the tile's most recent load took is used, see
+   * {@link Tile::getLastLoadDuration}.
+   */
+  CostAwareTileEvictionPolicy(
+      ReloadCostEstimator estimateReloadCost = ReloadCostEstimator()) noexcept;
+
+  /**
+   * @brief Orders the candidates by their reload cost divided by their size,
+   * lowest first.
+   */
+  virtual void orderForEviction(
+      const gsl::span<Tile*>& candidates,
+      const std::vector<ViewState>& frustums) override;
+
+private:
+  ReloadCostEstimator _estimateReloadCost;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -11,6 +11,8 @@
 #include <gsl/span>
 
 #include <any>
+#include <cstddef>
+#include <cstdint>
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -95,6 +97,71 @@ public:
    */
   virtual void* prepareInMainThread(Tile& tile, void* pLoadThreadResult) = 0;
 
+  /**
+   * @brief Returns whether the {@link Tileset} should prepare the tiles that
+   * are ready for the main thread part of loading together, with a single
+   * call to {@link prepareInMainThreadBatch} each frame, rather than calling
+   * {@link prepareInMainThread} for each one.
+   *
+   * The default implementation returns `false`. Override it to return `true`
+   * for a renderer that can create the resources of many tiles at once more
+   * cheaply than one tile at a time.
+   */
+  virtual bool supportsPrepareInMainThreadBatch() const noexcept {
+    return false;
+  }
+
+  /**
+   * @brief Further prepares the renderer resources of several tiles at once.
+   *
+   * This is the batched form of {@link prepareInMainThread}, and is called
+   * instead of it when {@link supportsPrepareInMainThreadBatch} returns
+   * `true`. It is called once each frame, from the same thread that called
+   * {@link Tileset::updateView}, with the tiles that are ready in priority
+   * order. When {@link TilesetOptions::mainThreadLoadingTimeLimit} is greater
+   * than zero, the number of tiles is limited to the number that the previous
+   * batches suggest can be prepared in that time. A tile may also be prepared
+   * in a batch of one when it is needed right away.
+   *
+   * The default implementation calls {@link prepareInMainThread} for each
+   * tile.
+   *
+   * @param tiles The tiles to prepare.
+   * @param loadThreadResults The value returned from
+   * {@link prepareInLoadThread} for each tile.
+   * @param mainThreadResults Receives the result of the load process for each
+   * tile, as would be returned by {@link prepareInMainThread}. It has the same
+   * size as `tiles`.
+   */
+  virtual void prepareInMainThreadBatch(
+      gsl::span<Tile* const> tiles,
+      gsl::span<void* const> loadThreadResults,
+      gsl::span<void*> mainThreadResults) {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+      mainThreadResults[i] =
+          this->prepareInMainThread(*tiles[i], loadThreadResults[i]);
+    }
+  }
+
+  /**
+   * @brief Reports how many bytes of GPU memory the renderer resources for a
+   * tile use.
+   *
+   * This is called right after {@link prepareInMainThread}, from the same
+   * thread. The result is counted against
+   * {@link TilesetOptions::maximumCachedGpuBytes}. The default implementation
+   * returns 0, indicating that GPU memory usage is not reported.
+   *
+   * @param tile The tile that was prepared.
+   * @param pMainThreadResult The value returned from
+   * {@link prepareInMainThread}.
+   */
+  virtual int64_t getGpuByteSize(
+      [[maybe_unused]] const Tile& tile,
+      [[maybe_unused]] void* pMainThreadResult) const noexcept {
+    return 0;
+  }
+
   /**
    * @brief Frees previously-prepared renderer resources.
    *
@@ -157,6 +224,57 @@ public:
       int32_t overlayTextureCoordinateID,
       const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
       void* pMainThreadRendererResources) noexcept = 0;
+
+  /**
+   * @brief Replaces the raster overlay tile attached to a geometry tile with
+   * another one.
+   *
+   * This is called when a geometry tile refines its raster overlay, such as
+   * when the raster tile it's waiting for finishes loading and replaces the
+   * part of an ancestor's raster tile shown in the meantime.
+   *
+   * The default implementation calls {@link detachRasterInMainThread} for the
+   * old raster tile followed by {@link attachRasterInMainThread} for the new
+   * one. A renderer that can swap the texture and texture coordinate transform
+   * of a geometry tile in place should override it to do that instead.
+   *
+   * @param tile The geometry tile.
+   * @param overlayTextureCoordinateID The ID of the overlay texture coordinate
+   * set to which the raster tiles are attached.
+   * @param oldRasterTile The raster overlay tile to remove.
+   * @param pOldMainThreadRendererResources The renderer resources for the old
+   * raster tile, as created and returned by {@link prepareRasterInMainThread}.
+   * @param newRasterTile The raster overlay tile to add. It will have been
+   * prepared like the raster tiles given to {@link attachRasterInMainThread}.
+   * @param pNewMainThreadRendererResources The renderer resources for the new
+   * raster tile, as created and returned by {@link prepareRasterInMainThread}.
+   * @param translation The translation to apply to the texture coordinates to
+   * sample the new raster image, as in {@link attachRasterInMainThread}.
+   * @param scale The scale to apply to the texture coordinates to sample the
+   * new raster image, as in {@link attachRasterInMainThread}.
+   */
+  virtual void replaceRasterInMainThread(
+      const Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& oldRasterTile,
+      void* pOldMainThreadRendererResources,
+      const CesiumRasterOverlays::RasterOverlayTile& newRasterTile,
+      void* pNewMainThreadRendererResources,
+      const glm::dvec2& translation,
+      const glm::dvec2& scale) {
+    this->detachRasterInMainThread(
+        tile,
+        overlayTextureCoordinateID,
+        oldRasterTile,
+        pOldMainThreadRendererResources);
+    this->attachRasterInMainThread(
+        tile,
+        overlayTextureCoordinateID,
+        newRasterTile,
+        pNewMainThreadRendererResources,
+        translation,
+        scale);
+  }
 };
 
 } // namespace Cesium3DTilesSelection
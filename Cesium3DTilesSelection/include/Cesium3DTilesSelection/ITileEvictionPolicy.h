@@ -0,0 +1,37 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+class ViewState;
+
+/**
+ * @brief An interface that decides which cached tiles are unloaded first when
+ * the tile cache is over its limit, when provided in
+ * {@link TilesetOptions::evictionPolicy}.
+ *
+ * Without a policy, tiles are unloaded in least-recently-used order.
+ */
+class ITileEvictionPolicy {
+public:
+  virtual ~ITileEvictionPolicy() = default;
+
+  /**
+   * @brief Orders the tiles that may be unloaded.
+   *
+   * @param candidates The tiles that were not used in the most recent frame
+   * and may be unloaded, least recently used first. This method reorders them
+   * in place so that the tiles that should be unloaded first come first.
+   * @param frustums The views passed to the most recent call to
+   * {@link Tileset::updateView}. This may be empty.
+   */
+  virtual void orderForEviction(
+      const gsl::span<Tile*>& candidates,
+      const std::vector<ViewState>& frustums) = 0;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -4,6 +4,28 @@ namespace Cesium3DTilesSelection {
 
 class Tile;
 
+/**
+ * @brief The result of {@link ITileExcluder::checkExclusion}.
+ */
+enum class TileExclusionResult {
+  /**
+   * @brief The tile and all of its descendants are excluded.
+   */
+  Excluded,
+
+  /**
+   * @brief The tile is included, but its descendants may be excluded, so each
+   * of them must be checked as well.
+   */
+  Included,
+
+  /**
+   * @brief The tile and all of its descendants are included, so none of its
+   * descendants need to be checked.
+   */
+  SubtreeIncluded
+};
+
 /**
  * @brief An interface that allows tiles to be excluded from loading and
  * rendering when provided in {@link TilesetOptions::excluders}.
@@ -26,6 +48,26 @@ public:
    * @return false if this tile should be included.
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept = 0;
+
+  /**
+   * @brief Determines whether a given tile should be excluded, and whether its
+   * descendants need to be checked at all.
+   *
+   * The {@link Tileset} calls this instead of {@link shouldExclude} while
+   * selecting tiles. When it returns
+   * {@link TileExclusionResult::SubtreeIncluded}, this excluder is not called
+   * again for the tile's descendants in the same frame. The default
+   * implementation calls {@link shouldExclude}, and so never returns
+   * {@link TileExclusionResult::SubtreeIncluded}.
+   *
+   * @param tile The tile to test
+   * @return Whether this tile, and possibly all of its descendants, should be
+   * excluded or included.
+   */
+  virtual TileExclusionResult checkExclusion(const Tile& tile) const noexcept {
+    return this->shouldExclude(tile) ? TileExclusionResult::Excluded
+                                     : TileExclusionResult::Included;
+  }
 };
 
 } // namespace Cesium3DTilesSelection
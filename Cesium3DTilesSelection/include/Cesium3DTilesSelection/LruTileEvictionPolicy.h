@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ITileEvictionPolicy.h"
+#include "Library.h"
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief When provided to {@link TilesetOptions::evictionPolicy}, unloads the
+ * least recently used tiles first. This is the same as providing no policy.
+ */
+class CESIUM3DTILESSELECTION_API LruTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief Leaves the candidates in least-recently-used order.
+   */
+  virtual void orderForEviction(
+      const gsl::span<Tile*>& candidates,
+      const std::vector<ViewState>& frustums) override;
+};
+
+} // namespace Cesium3DTilesSelection
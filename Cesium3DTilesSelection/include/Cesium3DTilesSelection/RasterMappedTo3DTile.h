@@ -2,12 +2,14 @@
 
 #include "IPrepareRendererResources.h"
 
+#include <CesiumAsync/TileLoadScheduler.h>
 #include <CesiumGeometry/Rectangle.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
 #include <memory>
+#include <optional>
 
 namespace Cesium3DTilesSelection {
 
@@ -147,6 +149,9 @@ public:
    * {@link IPrepareRendererResources::attachRasterInMainThread} is invoked.
    * When it is detached,
    * {@link IPrepareRendererResources::detachRasterInMainThread} is invoked.
+   * When the part of an ancestor's raster tile that was shown while this tile
+   * was loading is replaced by this tile,
+   * {@link IPrepareRendererResources::replaceRasterInMainThread} is invoked.
    */
   AttachmentState getState() const noexcept { return this->_state; }
 
@@ -157,6 +162,11 @@ public:
    * will return whether there is a more detailed version of the
    * raster data available.
    *
+   * While the raster is waiting for its loading tile, this returns `Unknown`
+   * right away unless the state of a tile of the same
+   * {@link CesiumRasterOverlays::RasterOverlayTileProvider} has changed since
+   * the last update, so it is cheap to call every frame.
+   *
    * @param prepareRendererResources The IPrepareRendererResources used to
    * create render resources for raster overlay
    * @param tile The owner tile.
@@ -180,13 +190,17 @@ public:
   /**
    * @brief Does a throttled load of the mapped {@link RasterOverlayTile}.
    *
+   * @param priority The priority of the load, usually that of the load of the
+   * geometry tile.
    * @return If the mapped tile is already in the process of loading or it has
    * already finished loading, this method does nothing and returns true. If too
    * many loads are already in progress, this method does nothing and returns
    * false. Otherwise, it begins the asynchronous process to load the tile and
    * returns true.
    */
-  bool loadThrottled() noexcept;
+  bool loadThrottled(
+      CesiumAsync::TileLoadScheduler::Priority priority =
+          CesiumAsync::TileLoadScheduler::Priority::Normal) noexcept;
 
   /**
    * @brief Creates a maping between a {@link RasterOverlay} and a {@link Tile}.
@@ -237,6 +251,7 @@ private:
   glm::dvec2 _scale;
   AttachmentState _state;
   bool _originalFailed;
+  std::optional<uint64_t> _lastTileStateVersion;
 };
 
 } // namespace Cesium3DTilesSelection
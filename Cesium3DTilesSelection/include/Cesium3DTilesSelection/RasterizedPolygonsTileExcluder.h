@@ -3,8 +3,12 @@
 #include "ITileExcluder.h"
 #include "Library.h"
 
+#include <CesiumGeospatial/GlobeRectangleTree.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
+#include <cstddef>
+#include <vector>
+
 namespace CesiumRasterOverlays {
 class RasterizedPolygonsOverlay;
 }
@@ -16,6 +20,11 @@ namespace Cesium3DTilesSelection {
  * owned by a {@link RasterizedPolygonsOverlay} to exclude tiles that are
  * entirely inside any of the polygon from loading. This is useful when the
  * polygons will be used for clipping.
+ *
+ * The bounding rectangles of the polygons are indexed in a
+ * {@link CesiumGeospatial::GlobeRectangleTree}, so each tile is only tested
+ * against the polygons near it. A tile that is not near any polygon includes
+ * its whole subtree, so its descendants are not tested at all.
  */
 class CESIUM3DTILESSELECTION_API RasterizedPolygonsTileExcluder
     : public Cesium3DTilesSelection::ITileExcluder {
@@ -27,8 +36,7 @@ public:
    */
   RasterizedPolygonsTileExcluder(
       const CesiumUtility::IntrusivePointer<
-          const CesiumRasterOverlays::RasterizedPolygonsOverlay>&
-          pOverlay) noexcept;
+          const CesiumRasterOverlays::RasterizedPolygonsOverlay>& pOverlay);
 
   /**
    * @brief Determines whether a given tile is entirely inside a polygon and
@@ -40,6 +48,17 @@ public:
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept override;
 
+  /**
+   * @brief Determines whether a given tile is entirely inside a polygon and
+   * therefore should be excluded, or whether it and all of its descendants are
+   * far enough from the polygons to be included.
+   *
+   * @param tile The tile to check.
+   * @return The exclusion of the tile and its descendants.
+   */
+  virtual TileExclusionResult
+  checkExclusion(const Tile& tile) const noexcept override;
+
   /**
    * @brief Gets the overlay defining the polygons.
    */
@@ -49,6 +68,11 @@ private:
   CesiumUtility::IntrusivePointer<
       const CesiumRasterOverlays::RasterizedPolygonsOverlay>
       _pOverlay;
+
+  // The bounding rectangles of the overlay's polygons, and the index in
+  // the overlay's polygons of each one.
+  CesiumGeospatial::GlobeRectangleTree _polygonTree;
+  std::vector<size_t> _polygonIndices;
 };
 
 } // namespace Cesium3DTilesSelection
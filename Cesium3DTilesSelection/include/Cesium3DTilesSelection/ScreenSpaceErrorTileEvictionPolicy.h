@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ITileEvictionPolicy.h"
+#include "Library.h"
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief When provided to {@link TilesetOptions::evictionPolicy}, unloads the
+ * tiles that are least likely to be needed by the current views first.
+ *
+ * Candidates are ordered by the largest screen-space error they have in any of
+ * the views, smallest first, so that tiles that are far away or too detailed
+ * for the views are unloaded before tiles the camera is still close to. Tiles
+ * with equal errors, and all tiles when there are no views, are unloaded in
+ * least-recently-used order.
+ */
+class CESIUM3DTILESSELECTION_API ScreenSpaceErrorTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief Orders the candidates by their screen-space error, smallest first.
+   */
+  virtual void orderForEviction(
+      const gsl::span<Tile*>& candidates,
+      const std::vector<ViewState>& frustums) override;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Library.h"
+#include "TileOcclusionRendererProxy.h"
+#include "ViewState.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A {@link TileOcclusionRendererProxyPool} that determines occlusion on
+ * the CPU, for renderers without occlusion queries and for headless use.
+ *
+ * At the start of each frame, the triangles of the tiles that were rendered in
+ * the previous frame are rasterized from the view of each frustum into a
+ * low-resolution software depth buffer. A hierarchy of maximum depths is built
+ * from it, so that the screen rectangle of any bounding volume is tested
+ * against at most four depths. A tile is occluded when its bounding volume is
+ * behind the depth buffer in every frustum.
+ *
+ * To keep a tile from being hidden by the coarser geometry of its ancestors,
+ * each occluder triangle is pushed back by its farthest vertex and by the
+ * geometric error of its tile.
+ *
+ * To use it, set {@link TilesetExternals::pTileOcclusionProxyPool} to an
+ * instance and enable {@link TilesetOptions::enableOcclusionCulling}. The
+ * occlusion state is known immediately, so it never delays refinement.
+ */
+class CESIUM3DTILESSELECTION_API SoftwareTileOcclusionProxyPool final
+    : public TileOcclusionRendererProxyPool {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param maximumPoolSize The maximum number of occlusion proxies.
+   * @param width The width of the depth buffer, in pixels.
+   * @param height The height of the depth buffer, in pixels.
+   * @param maximumOccluderTriangles The maximum number of triangles that are
+   * rasterized into the depth buffers of a frame. The triangles of the tiles
+   * rendered in the previous frame beyond this number don't occlude anything.
+   */
+  SoftwareTileOcclusionProxyPool(
+      int32_t maximumPoolSize,
+      uint32_t width = 128,
+      uint32_t height = 64,
+      int64_t maximumOccluderTriangles = 200000);
+
+  ~SoftwareTileOcclusionProxyPool() noexcept override;
+
+  /**
+   * @brief Rasterizes the tiles rendered in the previous frame into a depth
+   * buffer for each of the frustums of the new frame.
+   */
+  void startNewFrame(
+      const std::vector<ViewState>& frustums,
+      const std::vector<Tile*>& tilesRenderedLastFrame) override;
+
+  /**
+   * @brief Determines whether the bounding volume of a tile is occluded in
+   * the depth buffers of the current frame.
+   *
+   * @param tile The tile.
+   * @return {@link TileOcclusionState::Occluded} if the bounding volume is
+   * behind the depth buffer of every frustum, otherwise
+   * {@link TileOcclusionState::NotOccluded}.
+   */
+  TileOcclusionState computeOcclusionState(const Tile& tile) const;
+
+  /**
+   * @brief Gets the number of the current frame, which starts at 0 and is
+   * incremented by each call to {@link startNewFrame}.
+   */
+  uint64_t getFrameNumber() const noexcept { return this->_frameNumber; }
+
+protected:
+  TileOcclusionRendererProxy* createProxy() override;
+  void destroyProxy(TileOcclusionRendererProxy* pProxy) override;
+
+private:
+  // A depth buffer for one frustum. Level 0 of the hierarchy has the depth of
+  // each pixel, and each following level has the maximum of each 2x2 block of
+  // the previous one.
+  struct DepthBuffer {
+    glm::dvec3 position;
+    glm::dvec3 direction;
+    glm::dvec3 up;
+    glm::dvec3 right;
+    double xScale;
+    double yScale;
+    std::vector<uint32_t> widths;
+    std::vector<uint32_t> heights;
+    std::vector<std::vector<float>> levels;
+  };
+
+  void rasterizeTile(const Tile& tile, int64_t& remainingTriangles);
+  static bool isOccluded(
+      const DepthBuffer& buffer,
+      const std::vector<glm::dvec3>& corners) noexcept;
+
+  uint32_t _width;
+  uint32_t _height;
+  int64_t _maximumOccluderTriangles;
+  uint64_t _frameNumber;
+  std::vector<DepthBuffer> _depthBuffers;
+  std::vector<glm::dvec3> _cameraSpacePositions;
+};
+
+} // namespace Cesium3DTilesSelection
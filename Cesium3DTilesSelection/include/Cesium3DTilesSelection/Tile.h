@@ -8,6 +8,7 @@
 #include "TileRefine.h"
 #include "TileSelectionState.h"
 
+#include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumUtility/DoublyLinkedList.h>
 
 #include <glm/common.hpp>
@@ -15,6 +16,7 @@
 #include <gsl/span>
 
 #include <atomic>
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -23,6 +25,7 @@
 
 namespace Cesium3DTilesSelection {
 class TilesetContentLoader;
+struct TileUpsamplingSource;
 
 /**
  * The current state of this tile in the loading process.
@@ -221,8 +224,28 @@ public:
    */
   void setBoundingVolume(const BoundingVolume& value) noexcept {
     this->_boundingVolume = value;
+    this->_globeRectangleState.store(
+        GlobeRectangleState::NotEstimated,
+        std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Gets the {@link CesiumGeospatial::GlobeRectangle} that encloses the
+   * bounding volume of this tile, as estimated by
+   * {@link estimateGlobeRectangle}.
+   *
+   * The estimate is computed the first time it is needed after the bounding
+   * volume is set, and kept for later calls, so that checking every frame
+   * whether the camera is above the tile doesn't transform the bounding volume
+   * to cartographic coordinates again. It may be called from several threads
+   * at once, as long as the bounding volume isn't being set at the same time.
+   *
+   * @return The estimated rectangle, or `std::nullopt` if it can't be
+   * estimated.
+   */
+  std::optional<CesiumGeospatial::GlobeRectangle>
+  getEstimatedGlobeRectangle() const;
+
   /**
    * @brief Returns the viewer request volume of this tile.
    *
@@ -428,12 +451,76 @@ public:
     this->_lastSelectionState = newState;
   }
 
+  /**
+   * @brief Determines if this tile is in
+   * {@link ViewUpdateResult::tilesFadingOut}.
+   */
+  bool isFadingOut() const noexcept { return this->_isFadingOut; }
+
+  /**
+   * @brief Sets whether this tile is in
+   * {@link ViewUpdateResult::tilesFadingOut}.
+   *
+   * This function is not supposed to be called by clients.
+   *
+   * @param isFadingOut Whether the tile is in the list.
+   */
+  void setFadingOut(bool isFadingOut) noexcept {
+    this->_isFadingOut = isFadingOut;
+  }
+
   /**
    * @brief Determines the number of bytes in this tile's geometry and texture
-   * data.
+   * data that are resident in CPU memory.
+   *
+   * This walks the buffers and images of the tile's model. Use
+   * {@link getByteSize} for the size recorded when the tile was loaded.
    */
   int64_t computeByteSize() const noexcept;
 
+  /**
+   * @brief Gets the number of bytes in this tile's geometry and texture data
+   * that are resident in CPU memory, as computed by {@link computeByteSize}
+   * when the tile finished loading or its content last changed.
+   *
+   * This is the amount the tile contributes to
+   * {@link Tileset::getTotalDataBytes}, and is zero if the tile is not loaded.
+   */
+  int64_t getByteSize() const noexcept { return this->_cpuByteSize; }
+
+  /**
+   * @brief Gets the number of bytes of GPU memory used by this tile's renderer
+   * resources, as reported by {@link IPrepareRendererResources::getGpuByteSize}
+   * when the tile finished loading.
+   *
+   * This is zero if the tile is not loaded, or if the renderer does not report
+   * its GPU memory usage.
+   */
+  int64_t getGpuByteSize() const noexcept { return this->_gpuByteSize; }
+
+  /**
+   * @brief Gets the time, in seconds, from the start of this tile's most recent
+   * content load until its content was available on the main thread.
+   *
+   * This is zero if the tile's content has never been loaded. It can be used
+   * to estimate the cost of loading the tile again after it is unloaded.
+   */
+  double getLastLoadDuration() const noexcept {
+    return this->_lastLoadDuration;
+  }
+
+  /**
+   * @brief Gets the number of consecutive times that this tile's content load
+   * has failed temporarily.
+   *
+   * This is reset to zero when the content loads. While it is above zero, the
+   * tile is not loaded again until {@link TilesetOptions::retryDelay} has
+   * passed, doubled for each failure after the first.
+   */
+  uint32_t getTemporaryFailureCount() const noexcept {
+    return this->_temporaryFailureCount;
+  }
+
   /**
    * @brief Returns the raster overlay tiles that have been mapped to this tile.
    */
@@ -507,34 +594,66 @@ private:
   void
   setContentShouldContinueUpdating(bool shouldContentContinueUpdating) noexcept;
 
+  void setLastLoadDuration(double lastLoadDuration) noexcept;
+
   // Position in bounding-volume hierarchy.
   Tile* _pParent;
   std::vector<Tile> _children;
 
+  // Properties read on every visit during tile selection. They're kept
+  // together, right after the hierarchy pointers, so that a visit touches as
+  // few cache lines as possible. The (large) bounding volume comes last so
+  // that it doesn't separate the others.
+  double _geometricError;
+  TileSelectionState _lastSelectionState;
+  TileRefine _refine;
+  TileLoadState _loadState;
+  bool _isFadingOut;
+  BoundingVolume _boundingVolume;
+
+  // The estimate of the globe rectangle of the bounding volume, which is valid
+  // once the state is Estimated. The thread that changes the state from
+  // NotEstimated to Estimating is the one that stores it.
+  enum GlobeRectangleState : uint8_t { NotEstimated, Estimating, Estimated };
+  mutable std::atomic<uint8_t> _globeRectangleState;
+  mutable std::optional<CesiumGeospatial::GlobeRectangle> _globeRectangle;
+
   // Properties from tileset.json.
-  // These are immutable after the tile leaves TileState::Unloaded.
+  // These, along with the geometric error, refinement, and bounding volume
+  // above, are immutable after the tile leaves TileState::Unloaded.
   TileID _id;
-  BoundingVolume _boundingVolume;
   std::optional<BoundingVolume> _viewerRequestVolume;
   std::optional<BoundingVolume> _contentBoundingVolume;
-  double _geometricError;
-  TileRefine _refine;
   glm::dmat4x4 _transform;
 
-  // Selection state
-  TileSelectionState _lastSelectionState;
-
   // tile content
   CesiumUtility::DoublyLinkedListPointers<Tile> _loadedTilesLinks;
   TileContent _content;
   TilesetContentLoader* _pLoader;
-  TileLoadState _loadState;
   bool _shouldContentContinueUpdating;
+  double _lastLoadDuration;
+
+  // The number of consecutive temporary failures of this tile's content load,
+  // and the time of the most recent one, for TilesetOptions::retryDelay.
+  uint32_t _temporaryFailureCount;
+  std::chrono::steady_clock::time_point _lastTemporaryFailureTime;
+
+  // The bytes of this tile counted in the totals kept by
+  // TilesetContentManager, so that exactly the same amounts are removed again
+  // when the tile is unloaded.
+  int64_t _cpuByteSize;
+  int64_t _gpuByteSize;
 
   // mapped raster overlay
   std::vector<RasterMappedTo3DTile> _rasterTiles;
 
+  // What's needed to upsample the children of this tile for raster overlays
+  // after its content is unloaded.
+  std::shared_ptr<const TileUpsamplingSource> _pUpsamplingSource;
+
   friend class TilesetContentManager;
+  friend class RasterOverlayUpsampler;
+  friend class TileChildrenPool;
   friend class MockTilesetContentManagerTestFixture;
 
 public:
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Library.h"
+
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief The bounds of one tile in a {@link TileBoundsBuffer}.
+ *
+ * The layout is 64 bytes of 32-bit values in four groups of four, so that an
+ * array of these can be uploaded to the GPU as is, such as into a storage
+ * buffer of `vec4`s with the std430 layout.
+ */
+struct TileBounds {
+  /**
+   * @brief The center of the tile's bounding sphere and oriented bounding box,
+   * relative to {@link TileBoundsBuffer::getCenter}.
+   */
+  glm::vec3 center{0.0f};
+
+  /**
+   * @brief The radius of the tile's bounding sphere.
+   */
+  float radius = 0.0f;
+
+  /**
+   * @brief The first half-axis of the tile's oriented bounding box.
+   */
+  glm::vec3 halfAxisX{0.0f};
+
+  /**
+   * @brief The tile's geometric error.
+   */
+  float geometricError = 0.0f;
+
+  /**
+   * @brief The second half-axis of the tile's oriented bounding box.
+   */
+  glm::vec3 halfAxisY{0.0f};
+
+  /**
+   * @brief The slot of the tile's closest ancestor that is in the buffer, or
+   * -1 if there is none.
+   */
+  int32_t parentIndex = -1;
+
+  /**
+   * @brief The third half-axis of the tile's oriented bounding box.
+   */
+  glm::vec3 halfAxisZ{0.0f};
+
+  /**
+   * @brief 1 if the slot holds a tile, or 0 if it is free.
+   */
+  uint32_t occupied = 0;
+};
+
+static_assert(sizeof(TileBounds) == 64, "TileBounds must be tightly packed");
+
+/**
+ * @brief A compact array of the bounds of a set of tiles, such as the tiles of
+ * a {@link Tileset} with renderable content, for renderers that cull tiles and
+ * choose their level of detail on the GPU.
+ *
+ * Each tile keeps its slot in the array for as long as it is in the set, so
+ * the slot can be used as the tile's handle on the GPU. The slots of removed
+ * tiles are reused for added tiles. After each {@link update},
+ * {@link getChangedSlots} lists the slots that were rewritten, so that only
+ * those need to be uploaded again.
+ *
+ * Positions are single-precision and relative to a center, which should be
+ * near the tiles, such as the center of the tileset or of the camera's
+ * neighborhood.
+ */
+class CESIUM3DTILESSELECTION_API TileBoundsBuffer final {
+public:
+  /**
+   * @brief Creates an empty buffer.
+   *
+   * @param center The center, in ECEF coordinates, that the positions are
+   * relative to.
+   */
+  explicit TileBoundsBuffer(const glm::dvec3& center = glm::dvec3(0.0));
+
+  /**
+   * @brief Gets the center, in ECEF coordinates, that the positions are
+   * relative to.
+   */
+  const glm::dvec3& getCenter() const noexcept { return this->_center; }
+
+  /**
+   * @brief Sets the center that the positions are relative to. Every occupied
+   * slot is rewritten on the next {@link update}.
+   */
+  void setCenter(const glm::dvec3& center) noexcept;
+
+  /**
+   * @brief Gets the bounds of the tiles, indexed by slot.
+   */
+  const std::vector<TileBounds>& getBounds() const noexcept {
+    return this->_bounds;
+  }
+
+  /**
+   * @brief Gets the tile in each slot, or nullptr for a free slot.
+   *
+   * A tile pointer is only valid until the tiles are next unloaded, which
+   * happens when the tileset's view is next updated.
+   */
+  const std::vector<const Tile*>& getTiles() const noexcept {
+    return this->_tiles;
+  }
+
+  /**
+   * @brief Gets the slots, in increasing order, whose bounds changed in the
+   * last {@link update}, including the slots that were freed.
+   */
+  const std::vector<uint32_t>& getChangedSlots() const noexcept {
+    return this->_changedSlots;
+  }
+
+  /**
+   * @brief Gets the number of occupied slots.
+   */
+  size_t getTileCount() const noexcept { return this->_slots.size(); }
+
+  /**
+   * @brief Replaces the set of tiles in the buffer.
+   *
+   * The tiles that are no longer in the set are removed, the new ones are
+   * added, and the bounds, geometric error, and parent slot of every tile are
+   * brought up to date. The tiles must not contain duplicates.
+   *
+   * @param tiles The tiles.
+   */
+  void update(gsl::span<const Tile* const> tiles);
+
+private:
+  glm::dvec3 _center;
+  bool _rewriteAll;
+  std::vector<TileBounds> _bounds;
+  std::vector<const Tile*> _tiles;
+  std::vector<uint32_t> _freeSlots;
+  std::vector<uint32_t> _changedSlots;
+  std::unordered_map<const Tile*, uint32_t> _slots;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -3,12 +3,16 @@
 #include "Library.h"
 #include "TilesetMetadata.h"
 
+#include <CesiumGeometry/TriangleBoundingVolumeHierarchy.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/NodeInstanceGrid.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 #include <CesiumUtility/CreditSystem.h>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <variant>
 #include <vector>
 
@@ -192,12 +196,119 @@ public:
    */
   void setLodTransitionFadePercentage(float percentage) noexcept;
 
+  /**
+   * @brief Gets the fraction of the points of this tile's point primitives
+   * that the renderer should draw to stay within
+   * {@link TilesetOptions::maximumPointsRendered}.
+   *
+   * This is 1.0 when all of the points should be drawn. Otherwise, the
+   * renderer should draw only the first `ceil(fraction * count)` points of each
+   * primitive with the `POINTS` mode, which are a uniform subsample of it if
+   * {@link TilesetContentOptions::shufflePointClouds} is true. A renderer that
+   * attenuates the size of points may enlarge them by the inverse square root
+   * of the fraction, so that the fewer points still cover the tile.
+   *
+   * @return The fraction of the points to draw.
+   */
+  float getPointBudgetFraction() const noexcept;
+
+  /**
+   * @brief Sets the fraction of the points of this tile to draw. Not to be used
+   * by clients.
+   *
+   * @param fraction The new fraction.
+   */
+  void setPointBudgetFraction(float fraction) noexcept;
+
+  /**
+   * @brief Determines if the CPU copies of most of the model's buffer and image
+   * data have been released after the renderer resources were prepared.
+   *
+   * When this is true, the model still contains the positions, indices, and
+   * raster overlay texture coordinates of its primitives, but no other vertex
+   * attributes and no image pixels. See
+   * {@link TilesetContentOptions::releaseCpuDataAfterPreparing}.
+   */
+  bool isCpuDataReleased() const noexcept;
+
+  /**
+   * @brief Records that the CPU copies of the model's data have been released.
+   * Not to be used by clients.
+   *
+   * @param released Whether the data has been released.
+   */
+  void setCpuDataReleased(bool released) noexcept;
+
+  /**
+   * @brief Gets the bounding volume hierarchy over the triangles of the model,
+   * in ECEF coordinates, which is used to intersect rays with the content.
+   *
+   * @return The hierarchy, or nullptr if it hasn't been built yet.
+   */
+  const CesiumGeometry::TriangleBoundingVolumeHierarchy*
+  getTriangleHierarchy() const noexcept;
+
+  /**
+   * @brief Sets the bounding volume hierarchy over the triangles of the
+   * model. It is cleared when the model is replaced.
+   *
+   * @param hierarchy The hierarchy, in ECEF coordinates.
+   */
+  void setTriangleHierarchy(
+      CesiumGeometry::TriangleBoundingVolumeHierarchy&& hierarchy) noexcept;
+
+  /**
+   * @brief Gets the grids over the `EXT_mesh_gpu_instancing` instances of the
+   * model, in ECEF coordinates, which are used to draw only the instances
+   * within a view.
+   *
+   * They are only built if {@link TilesetContentOptions::createInstanceGrids}
+   * is enabled.
+   */
+  const std::vector<CesiumGltfContent::NodeInstanceGrid>&
+  getInstanceGrids() const noexcept;
+
+  /**
+   * @brief Sets the grids over the instances of the model. They are cleared
+   * when the model is replaced.
+   *
+   * @param grids The grids, in ECEF coordinates.
+   */
+  void setInstanceGrids(
+      std::vector<CesiumGltfContent::NodeInstanceGrid>&& grids) noexcept;
+
+  /**
+   * @brief Gets the content hash of each image of the model, by image index,
+   * or 0 for an image that was not decoded.
+   *
+   * A renderer can use the hashes as the keys of a cache of textures, so that
+   * the identical images of different tiles share one texture. They are only
+   * computed if {@link TilesetContentOptions::deduplicateContent} is enabled,
+   * and are otherwise empty. See
+   * {@link CesiumGltfContent::GltfUtilities::computeImageContentHash}.
+   */
+  const std::vector<uint64_t>& getImageContentHashes() const noexcept;
+
+  /**
+   * @brief Sets the content hash of each image of the model. They are cleared
+   * when the model is replaced.
+   *
+   * @param hashes The hashes, by image index.
+   */
+  void setImageContentHashes(std::vector<uint64_t>&& hashes) noexcept;
+
 private:
   CesiumGltf::Model _model;
   void* _pRenderResources;
   CesiumRasterOverlays::RasterOverlayDetails _rasterOverlayDetails;
   std::vector<CesiumUtility::Credit> _credits;
   float _lodTransitionFadePercentage;
+  float _pointBudgetFraction;
+  bool _cpuDataReleased;
+  std::optional<CesiumGeometry::TriangleBoundingVolumeHierarchy>
+      _triangleHierarchy;
+  std::vector<CesiumGltfContent::NodeInstanceGrid> _instanceGrids;
+  std::vector<uint64_t> _imageContentHashes;
 };
 
 /**
@@ -4,6 +4,7 @@
 
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumUtility/InternedString.h>
 
 #include <string>
 #include <variant>
@@ -20,8 +21,11 @@ namespace Cesium3DTilesSelection {
  * Depending on the exact type of the tile and its contents, this
  * identifier may have different forms:
  *
- * * A `std::string`: This is an explicitly-described tile and
- *   the ID is the URL of the tile's content.
+ * * A {@link CesiumUtility::InternedString}: This is an explicitly-described
+ *   tile and the ID is the URL of the tile's content. The URL is interned, so
+ *   that tiles with the same content URL share it and the ID, like the other
+ *   forms, is trivially copyable and cheap to compare and hash. An empty URL
+ *   identifies a tile without content.
  * * A {@link CesiumGeometry::QuadtreeTileID}: This is an implicit
  *   tile in the quadtree. The URL of the tile's content is formed
  *   by instantiating the context's template URL with this ID.
@@ -33,7 +37,7 @@ namespace Cesium3DTilesSelection {
  *   the parent tile's content.
  */
 typedef std::variant<
-    std::string,
+    CesiumUtility::InternedString,
     CesiumGeometry::QuadtreeTileID,
     CesiumGeometry::OctreeTileID,
     CesiumGeometry::UpsampledQuadtreeNode>
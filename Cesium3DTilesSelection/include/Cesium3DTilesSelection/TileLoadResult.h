@@ -6,12 +6,14 @@
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/VertexStreams.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 
 #include <functional>
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 
@@ -62,7 +64,15 @@ enum class TileLoadResultState {
    * background work happenning and
    * __none__ of the fields in {@link TileLoadResult} or {@link TileChildrenResult} are applied to the tile
    */
-  RetryLater
+  RetryLater,
+
+  /**
+   * @brief The operation was abandoned because its
+   * {@link TileLoadInput::cancellationToken} was canceled. __none__ of the
+   * fields in {@link TileLoadResult} are applied to the tile, and the tile
+   * returns to the unloaded state so that it can be loaded again later.
+   */
+  Canceled
 };
 
 /**
@@ -115,12 +125,24 @@ struct CESIUM3DTILESSELECTION_API TileLoadResult {
   std::function<void(Tile&)> tileInitializer;
 
   /**
-   * @brief The result of loading a tile. Note that if the state is Failed or
-   * RetryLater, __none__ of the fields above (including {@link TileLoadResult::tileInitializer}) will be
+   * @brief The result of loading a tile. Note that if the state is Failed,
+   * RetryLater, or Canceled, __none__ of the fields above (including {@link TileLoadResult::tileInitializer}) will be
    * applied to a tile when the loading is finished
    */
   TileLoadResultState state;
 
+  /**
+   * @brief The vertices and indices of the glTF's primitives, written into
+   * memory from {@link TilesetContentOptions::pStagingBufferAllocator} if it
+   * is set.
+   *
+   * These are filled in right before
+   * {@link IPrepareRendererResources::prepareInLoadThread} is called, which
+   * takes ownership of their memory and must free it through the allocator
+   * when it is no longer needed.
+   */
+  std::vector<CesiumGltfContent::PrimitiveVertexStreams> vertexStreams{};
+
   /**
    * @brief Create a result with Failed state
    *
@@ -136,6 +158,15 @@ struct CESIUM3DTILESSELECTION_API TileLoadResult {
    */
   static TileLoadResult createRetryLaterResult(
       std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest);
+
+  /**
+   * @brief Create a result with Canceled state
+   *
+   * @param pCompletedRequest The request, if any, that completed before the
+   * load was canceled
+   */
+  static TileLoadResult createCanceledResult(
+      std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest);
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Library.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A stage of loading a tile, measured by {@link TileLoadStatistics}.
+ */
+enum class TileLoadStage : uint8_t {
+  /**
+   * @brief From the start of the load until the loader has the tile's
+   * content, including requesting it and parsing or converting it.
+   */
+  Load,
+
+  /**
+   * @brief From the content being loaded until its glTF is post-processed in
+   * a worker thread, including waiting for the worker thread and requesting
+   * the glTF's external buffers and images.
+   */
+  PostProcess,
+
+  /**
+   * @brief {@link IPrepareRendererResources::prepareInLoadThread}.
+   */
+  PrepareInLoadThread,
+
+  /**
+   * @brief From the end of the work in worker threads until the result of the
+   * load reaches the main thread.
+   */
+  MainThreadWait,
+
+  /**
+   * @brief {@link IPrepareRendererResources::prepareInMainThread}.
+   */
+  PrepareInMainThread,
+
+  /**
+   * @brief From the start of the load until the tile is ready to render,
+   * including waiting for the main thread's time budget.
+   */
+  Total
+};
+
+/**
+ * @brief A histogram of the durations of one stage of tile loads.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadStageHistogram {
+  /**
+   * @brief The upper bound of each bucket but the last, in milliseconds. The
+   * last bucket holds the durations longer than the last bound.
+   */
+  static constexpr std::array<double, 13> bucketUpperBounds{
+      1.0,
+      2.0,
+      5.0,
+      10.0,
+      20.0,
+      50.0,
+      100.0,
+      200.0,
+      500.0,
+      1000.0,
+      2000.0,
+      5000.0,
+      10000.0};
+
+  /**
+   * @brief The number of durations in each bucket.
+   */
+  std::array<int64_t, bucketUpperBounds.size() + 1> bucketCounts{};
+
+  /**
+   * @brief The number of durations.
+   */
+  int64_t count = 0;
+
+  /**
+   * @brief The sum of the durations, in milliseconds.
+   */
+  double totalMilliseconds = 0.0;
+
+  /**
+   * @brief The longest duration, in milliseconds.
+   */
+  double maximumMilliseconds = 0.0;
+
+  /**
+   * @brief Adds a duration to the histogram.
+   *
+   * @param milliseconds The duration in milliseconds.
+   */
+  void add(double milliseconds) noexcept;
+
+  /**
+   * @brief Estimates a percentile of the durations, by interpolating linearly
+   * within the bucket that contains it.
+   *
+   * @param percentile The percentile, from 0 to 100.
+   * @return The estimated duration in milliseconds, or 0 if the histogram has
+   * no durations.
+   */
+  double estimatePercentile(double percentile) const noexcept;
+};
+
+/**
+ * @brief Histograms of how long each stage of loading a tile takes, for each
+ * type of content.
+ *
+ * A tile's load is only counted if it succeeds. The stages that don't apply
+ * to the tile's content, such as post-processing a tile without a glTF, are
+ * not counted.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadStatistics {
+  /**
+   * @brief The number of stages in {@link TileLoadStage}.
+   */
+  static constexpr size_t stageCount = size_t(TileLoadStage::Total) + 1;
+
+  /**
+   * @brief The histogram of each stage, indexed by {@link TileLoadStage}.
+   */
+  using StageHistograms = std::array<TileLoadStageHistogram, stageCount>;
+
+  /**
+   * @brief The histograms of the loads of each type of content.
+   *
+   * The types are the magic of binary content ("b3dm", "i3dm", "pnts",
+   * "cmpt", or "glb"), "gltf" for glTF JSON, "quantized-mesh", "external" for
+   * external tilesets, "empty" for tiles without content, "upsampled" for
+   * tiles upsampled for raster overlays, and "unknown" for anything else.
+   */
+  std::map<std::string, StageHistograms> contentTypes;
+
+  /**
+   * @brief Gets the histogram of a stage of a type of content.
+   *
+   * @param contentType The type of content, a key of {@link contentTypes}.
+   * @param stage The stage.
+   * @return The histogram, or nullptr if no load of this type of content has
+   * been counted.
+   */
+  const TileLoadStageHistogram*
+  getHistogram(const std::string& contentType, TileLoadStage stage)
+      const noexcept;
+
+  /**
+   * @brief Adds the duration of a stage of a load.
+   *
+   * @param contentType The type of the content that was loaded.
+   * @param stage The stage.
+   * @param milliseconds The duration of the stage in milliseconds.
+   */
+  void
+  add(const std::string& contentType, TileLoadStage stage, double milliseconds);
+};
+
+} // namespace Cesium3DTilesSelection
@@ -2,9 +2,12 @@
 
 #include "Library.h"
 #include "Tile.h"
+#include "ViewState.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 /**
@@ -68,7 +71,7 @@ protected:
   virtual void reset(const Tile* pTile) = 0;
 
 private:
-  bool _usedLastFrame = false;
+  int64_t _lastUsedFrame = -1;
   TileOcclusionRendererProxy* _pNext = nullptr;
 };
 
@@ -76,6 +79,15 @@ private:
  * @brief A pool of {@link TileOcclusionRendererProxy} objects. Allows quick
  * remapping of tiles to occlusion renderer proxies so new proxies do not have
  * to be created for each new tile requesting occlusion results.
+ *
+ * By default a tile loses its proxy as soon as a frame doesn't ask for it, so
+ * a tile that drops out of the traversal for a frame has to wait for a new
+ * occlusion result when it comes back. {@link setRetainUnusedProxyFrames}
+ * lets tiles keep their proxies, and their occlusion results, for a few
+ * frames instead. When the pool is full, a proxy kept this way is taken from
+ * the tile that used it least recently. {@link setMaximumNewProxiesPerFrame}
+ * limits how many proxies are assigned to new tiles in each frame, so that a
+ * sudden change of view doesn't start thousands of occlusion queries at once.
  */
 class CESIUM3DTILESSELECTION_API TileOcclusionRendererProxyPool {
 public:
@@ -112,12 +124,85 @@ public:
 
   /**
    * @brief Prunes the occlusion proxy mappings and removes any mappings that
-   * were unused the last frame. Any mapping corresponding to a tile that was
-   * not visited will have been unused. Occlusion proxies from removed mappings
-   * will be returned to the free list.
+   * were unused for more than {@link getRetainUnusedProxyFrames} frames. Any
+   * mapping corresponding to a tile that was not visited will have been
+   * unused. Occlusion proxies from removed mappings will be returned to the
+   * free list.
+   *
+   * This is called once at the end of each frame, and starts the next one.
    */
   void pruneOcclusionProxyMappings();
 
+  /**
+   * @brief Returns the proxy mapped to a tile, if any, to the free list.
+   *
+   * This must be called before a tile that may still have a proxy is
+   * destroyed, which the tileset does when it releases the children of a
+   * tile.
+   *
+   * @param tile The tile.
+   */
+  void releaseOcclusionProxyForTile(const Tile& tile);
+
+  /**
+   * @brief Gets the number of frames that a tile keeps its proxy while it
+   * isn't used.
+   */
+  int32_t getRetainUnusedProxyFrames() const noexcept {
+    return this->_retainUnusedProxyFrames;
+  }
+
+  /**
+   * @brief Sets the number of frames that a tile keeps its proxy while it
+   * isn't used.
+   *
+   * With the default of 0, the proxy of a tile that wasn't used in a frame is
+   * returned to the free list at the end of that frame.
+   *
+   * @param frames The number of frames.
+   */
+  void setRetainUnusedProxyFrames(int32_t frames) noexcept {
+    this->_retainUnusedProxyFrames = frames < 0 ? 0 : frames;
+  }
+
+  /**
+   * @brief Gets the maximum number of proxies assigned to new tiles in each
+   * frame, or a negative number if there is no limit.
+   */
+  int32_t getMaximumNewProxiesPerFrame() const noexcept {
+    return this->_maximumNewProxiesPerFrame;
+  }
+
+  /**
+   * @brief Sets the maximum number of proxies assigned to new tiles in each
+   * frame.
+   *
+   * Once the limit is reached, {@link fetchOcclusionProxyForTile} returns
+   * nullptr for tiles without a proxy until the next frame, and the traversal
+   * treats them as not occluded rather than waiting for them.
+   *
+   * @param maximum The maximum number, or a negative number for no limit,
+   * which is the default.
+   */
+  void setMaximumNewProxiesPerFrame(int32_t maximum) noexcept {
+    this->_maximumNewProxiesPerFrame = maximum;
+  }
+
+  /**
+   * @brief Called by the tileset at the start of the traversal of each frame,
+   * before any occlusion proxy is fetched for it.
+   *
+   * The default implementation does nothing. A pool that determines occlusion
+   * itself can use it to prepare the occlusion state of the new frame.
+   *
+   * @param frustums The frustums of the new frame.
+   * @param tilesRenderedLastFrame The tiles that were rendered in the previous
+   * frame, which are all still loaded.
+   */
+  virtual void startNewFrame(
+      const std::vector<ViewState>& frustums,
+      const std::vector<Tile*>& tilesRenderedLastFrame);
+
 protected:
   /**
    * @brief Create a {@link TileOcclusionRendererProxy}.
@@ -134,6 +219,8 @@ protected:
   virtual void destroyProxy(TileOcclusionRendererProxy* pProxy) = 0;
 
 private:
+  TileOcclusionRendererProxy* takeRetainedProxy();
+
   // Singly linked list representing the free proxies in the pool
   TileOcclusionRendererProxy* _pFreeProxiesHead;
   int32_t _currentSize;
@@ -141,6 +228,17 @@ private:
   // The currently used proxies in the pool
   std::unordered_map<const Tile*, TileOcclusionRendererProxy*>
       _tileToOcclusionProxyMappings;
+
+  int32_t _retainUnusedProxyFrames;
+  int32_t _maximumNewProxiesPerFrame;
+  int32_t _newProxiesThisFrame;
+  // Counts the calls to pruneOcclusionProxyMappings.
+  int64_t _frame;
+  // The tiles whose proxies were kept without being used, with the frames in
+  // which they were last used, least recently used first, and the next of them
+  // to take a proxy from when the pool is full.
+  std::vector<std::pair<int64_t, const Tile*>> _retainedTiles;
+  size_t _nextRetainedTile;
 };
 
 } // namespace Cesium3DTilesSelection
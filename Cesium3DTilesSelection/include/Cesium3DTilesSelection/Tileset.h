@@ -3,24 +3,36 @@
 #include "Library.h"
 #include "RasterOverlayCollection.h"
 #include "Tile.h"
+#include "TileBoundsBuffer.h"
+#include "TileLoadStatistics.h"
 #include "TilesetContentLoader.h"
 #include "TilesetExternals.h"
 #include "TilesetLoadFailureDetails.h"
+#include "TilesetLoadTimings.h"
 #include "TilesetOptions.h"
 #include "ViewState.h"
 #include "ViewUpdateResult.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ThreadPool.h>
+#include <CesiumGeometry/PackedBoundingVolumes.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
 #include <rapidjson/fwd.h>
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+class CombinedViewState;
 class TilesetContentManager;
 class TilesetMetadata;
 
@@ -80,10 +92,11 @@ public:
    *
    * Destroying the tileset will immediately (before the destructor returns)
    * unload as much tile content as possible. However, tiles that are currently
-   * in the process of being loaded cannot be unloaded immediately. These tiles
-   * will be unloaded asynchronously some time after this destructor returns. To
-   * be notified of completion of the async portion of the tileset destruction,
-   * subscribe to {@link getAsyncDestructionCompleteEvent}.
+   * in the process of being loaded cannot be unloaded immediately. Their loads
+   * are canceled, and each of these tiles is unloaded as soon as its load
+   * stops, some time after this destructor returns. To be notified of
+   * completion of the async portion of the tileset destruction, subscribe to
+   * {@link getAsyncDestructionCompleteEvent}.
    */
   ~Tileset() noexcept;
 
@@ -191,6 +204,20 @@ public:
   const ViewUpdateResult&
   updateView(const std::vector<ViewState>& frustums, float deltaTime = 0.0f);
 
+  /**
+   * @brief Reports how long the application's last frame took and how much
+   * GPU memory it is using, for
+   * {@link TilesetOptions::adaptiveScreenSpaceError}.
+   *
+   * Call this once per frame, before {@link updateView}. It has no effect
+   * unless adaptive screen-space error is enabled.
+   *
+   * @param frameTime The duration of the last frame, in seconds.
+   * @param gpuMemoryUsage The GPU memory in use, in bytes, or a negative value
+   * if it is unknown.
+   */
+  void reportFrameStatistics(double frameTime, int64_t gpuMemoryUsage = -1);
+
   /**
    * @brief Gets the total number of tiles that are currently loaded.
    */
@@ -205,16 +232,165 @@ public:
   /**
    * @brief Invokes a function for each tile that is currently loaded.
    *
+   * The function is called directly rather than through a `std::function`,
+   * so a lambda can be inlined into the loop. It may unload the tile it is
+   * given, but no other tile.
+   *
+   * @param callback The function to invoke, which takes a `Tile&`.
+   */
+  template <typename TCallback> void forEachLoadedTile(TCallback&& callback) {
+    Tile* pCurrent = this->_loadedTiles.head();
+    while (pCurrent) {
+      Tile* pNext = this->_loadedTiles.next(pCurrent);
+      callback(*pCurrent);
+      pCurrent = pNext;
+    }
+  }
+
+  /**
+   * @copybrief forEachLoadedTile
+   *
+   * @param callback The function to invoke, which takes a `const Tile&`.
+   */
+  template <typename TCallback>
+  void forEachLoadedTile(TCallback&& callback) const {
+    for (const Tile* pTile = this->_loadedTiles.head(); pTile;
+         pTile = this->_loadedTiles.next(*pTile)) {
+      callback(*pTile);
+    }
+  }
+
+  /**
+   * @brief Invokes a function for each tile that is currently loaded, from
+   * several threads at once.
+   *
+   * The loaded tiles are split into batches, one for the calling thread and
+   * one for each of the {@link TilesetOptions::parallelTraversalThreadCount}
+   * threads of the pool that the tileset also uses for its traversal. This
+   * returns once the function has been called for every tile. When
+   * `parallelTraversalThreadCount` is 0, every tile is visited in the calling
+   * thread.
+   *
+   * The function must be safe to call from several threads at once, and must
+   * only read the tiles. It should not call into the tileset.
+   *
    * @param callback The function to invoke.
    */
-  void forEachLoadedTile(const std::function<void(Tile& tile)>& callback);
+  void forEachLoadedTileInParallel(
+      const std::function<void(const Tile& tile)>& callback);
+
+  /**
+   * @brief Gets the tiles that are currently loaded, in the order that they
+   * would be unloaded.
+   *
+   * Unlike {@link forEachLoadedTile}, the list stays the same while the tiles
+   * are used, so they can be processed in any order, such as in parallel. The
+   * tile pointers are only valid until the tiles are next unloaded, which
+   * happens when the tileset's view is next updated.
+   *
+   * @param tiles The vector to fill with the tiles. It is cleared first, so
+   * the same vector can be reused without allocating each time.
+   */
+  void getLoadedTiles(std::vector<Tile*>& tiles);
+
+  /**
+   * @brief Updates a {@link TileBoundsBuffer} to hold the bounds of the loaded
+   * tiles with renderable content.
+   *
+   * Call this after {@link updateView} to let the renderer cull the tiles and
+   * choose among them on the GPU. Only the slots in
+   * {@link TileBoundsBuffer::getChangedSlots} need to be uploaded again.
+   *
+   * @param buffer The buffer to update.
+   */
+  void updateTileBoundsBuffer(TileBoundsBuffer& buffer);
+
+  /**
+   * @brief Finds where a ray first hits the loaded content of this tileset.
+   *
+   * The tile hierarchy is descended along the ray by bounding volume, nearest
+   * tile first, and the content of the most detailed loaded tiles along the
+   * ray is intersected with its
+   * {@link CesiumGeometry::TriangleBoundingVolumeHierarchy}. The hierarchy of
+   * a tile is built the first time a ray reaches it, unless
+   * {@link TilesetContentOptions::createTriangleHierarchies} already built it
+   * while loading the tile.
+   *
+   * @param ray The ray, in ECEF coordinates.
+   * @return The distance along the ray to the closest hit, or `std::nullopt`
+   * if the ray doesn't hit any loaded content.
+   */
+  std::optional<double> intersectRay(const CesiumGeometry::Ray& ray);
+
+  /**
+   * @brief Finds where each of a batch of rays first hits the loaded content of
+   * this tileset.
+   *
+   * @param rays The rays, in ECEF coordinates.
+   * @return The result of {@link intersectRay} for each ray.
+   */
+  std::vector<std::optional<double>>
+  intersectRays(const std::vector<CesiumGeometry::Ray>& rays);
+
+  /**
+   * @brief Samples the height of the loaded content of this tileset at a batch
+   * of positions.
+   *
+   * Each height is found by intersecting a ray that points down along the
+   * WGS84 ellipsoid normal, from far above the position, with
+   * {@link intersectRay}. The heights of the given positions are ignored.
+   *
+   * @param positions The positions.
+   * @return The height above the WGS84 ellipsoid of the highest loaded content
+   * at each position, or `std::nullopt` where there isn't any.
+   */
+  std::vector<std::optional<double>>
+  sampleHeights(const std::vector<CesiumGeospatial::Cartographic>& positions);
 
   /**
    * @brief Gets the total number of bytes of tile and raster overlay data that
-   * are currently loaded.
+   * are currently loaded and resident in CPU memory.
    */
   int64_t getTotalDataBytes() const noexcept;
 
+  /**
+   * @brief Gets histograms of how long each stage of this tileset's tile loads
+   * has taken, for each type of content, since the tileset was created or
+   * {@link resetLoadStatistics} was last called.
+   */
+  const TileLoadStatistics& getLoadStatistics() const noexcept;
+
+  /**
+   * @brief Clears the histograms returned by {@link getLoadStatistics}.
+   */
+  void resetLoadStatistics() noexcept;
+
+  /**
+   * @brief Gets how long this tileset took to make its root tile available,
+   * to render its first tiles, and to load every tile needed for the views
+   * after they last changed.
+   */
+  TilesetLoadTimings getLoadTimings() const noexcept;
+
+  /**
+   * @brief Gets the total number of bytes of GPU memory used by the renderer
+   * resources of the tiles and raster overlay tiles that are currently loaded.
+   *
+   * This is only known if the renderer reports it, see
+   * {@link IPrepareRendererResources::getGpuByteSize}.
+   */
+  int64_t getTotalGpuDataBytes() const noexcept;
+
+  /**
+   * @brief Immediately unloads cached tiles until no more than
+   * {@link TilesetOptions::memoryPressureCachedBytes} remain loaded, ignoring
+   * {@link TilesetOptions::tileCacheUnloadTimeLimit}.
+   *
+   * Call this when the operating system reports that memory is running low.
+   * Tiles needed for rendering the most recent frame are not unloaded.
+   */
+  void handleMemoryPressure();
+
   /**
    * @brief Gets the {@link TilesetMetadata} associated with the main or
    * external tileset.json that contains a given tile. If the metadata is not
@@ -309,6 +485,32 @@ private:
     uint32_t notYetRenderableCount = 0;
   };
 
+  /**
+   * @brief Per-frustum distances and visibility of tile bounding volumes that
+   * were computed ahead of the traversal.
+   *
+   * These are only populated when
+   * {@link TilesetOptions::parallelTraversalThreadCount} is non-zero. Each
+   * evaluated tile owns `frustumCount` consecutive entries in `distances` and
+   * `visibility`, starting at the index stored in `tileIndices`.
+   */
+  struct TileViewEvaluations {
+    size_t frustumCount = 0;
+    std::vector<const Tile*> tiles;
+    std::unordered_map<const Tile*, size_t> tileIndices;
+    std::vector<double> distances;
+    std::vector<uint8_t> visibility;
+
+    /**
+     * @brief Gets the offset of the first entry for the given tile in
+     * `distances` and `visibility`, or `std::nullopt` if the tile was not
+     * evaluated ahead of the traversal.
+     */
+    std::optional<size_t> find(const Tile& tile) const noexcept;
+
+    void clear() noexcept;
+  };
+
   /**
    * @brief Input information that is constant throughout the traversal.
    *
@@ -321,6 +523,10 @@ private:
     std::vector<double> fogDensities;
     int32_t lastFrameNumber;
     int32_t currentFrameNumber;
+    const TileViewEvaluations* pTileViewEvaluations;
+    // The frustum that contains all of the frustums, or nullptr if they
+    // aren't combined.
+    const CombinedViewState* pCombinedView;
   };
 
   TraversalDetails _renderLeaf(
@@ -349,6 +555,7 @@ private:
       const FrameState& frameState,
       uint32_t depth,
       bool meetsSse,
+      double screenSpaceError,
       bool ancestorMeetsSse,
       Tile& tile,
       double tilePriority,
@@ -376,6 +583,10 @@ private:
       const Tile& tile,
       const std::vector<double>& distances,
       bool culled) const noexcept;
+  bool _isNearSse(
+      const std::vector<ViewState>& frustums,
+      const Tile& tile,
+      const std::vector<double>& distances) const noexcept;
 
   TraversalDetails _visitTileIfNeeded(
       const FrameState& frameState,
@@ -390,6 +601,62 @@ private:
       Tile& tile,
       ViewUpdateResult& result);
 
+  /**
+   * @brief Computes the visibility of every child of a tile in every frustum,
+   * culling the children in one pass per frustum.
+   *
+   * The visibility is appended to `_childVisibility`, one flag per child per
+   * frustum. The caller is responsible for removing it again.
+   *
+   * @param tile The tile whose children to cull.
+   * @param frustums The frustums to cull against.
+   * @param pCombinedView The frustum that contains all of the frustums, which
+   * is tested first, or nullptr.
+   * @return The offset of the first child's flags within `_childVisibility`.
+   */
+  size_t _computeChildVisibility(
+      const Tile& tile,
+      const std::vector<ViewState>& frustums,
+      const CombinedViewState* pCombinedView);
+
+  /**
+   * @brief Selects the tiles in a subtree that the traversal has no time left
+   * to visit this frame, by repeating the subtree's selection from the
+   * previous frame.
+   *
+   * Tiles that were not visited in the previous frame are skipped. See
+   * {@link TilesetOptions::traversalTimeLimit}.
+   */
+  TraversalDetails _reuseLastSelectionOfSubtree(
+      const FrameState& frameState,
+      Tile& tile,
+      ViewUpdateResult& result);
+
+  /**
+   * @brief Queues loads, with preload priority, for the tiles that the given
+   * views are predicted to need {@link TilesetOptions::predictiveLoadTime}
+   * seconds from now.
+   *
+   * Does not change the selection state of any tile.
+   */
+  void _queuePredictedTileLoads(
+      const std::vector<ViewState>& frustums,
+      float deltaTime);
+
+  /**
+   * @brief Adjusts the number of simultaneous tile loads and the
+   * screen-space error scale of {@link TilesetOptions::networkAdaptiveLoading}
+   * from the latest network measurements.
+   */
+  void _updateNetworkAdaptiveLoading() noexcept;
+
+  /**
+   * @brief Computes the screen-space errors, loading descendant limit, and
+   * number of simultaneous tile loads to use for this frame, and records them
+   * in the given result.
+   */
+  void _updateEffectiveDetailOptions(ViewUpdateResult& result) noexcept;
+
   /**
    * @brief When called on an additive-refined tile, queues it for load and adds
    * it to the render list.
@@ -411,17 +678,97 @@ private:
       double tilePriority,
       bool queuedForLoad);
 
+  /**
+   * @brief The inputs that determined the result of the last selection
+   * traversal, used by {@link TilesetOptions::enableCachedTraversal} to decide
+   * whether that result can be reused.
+   */
+  struct LastTraversalInputs {
+    std::vector<ViewState> frustums;
+    double maximumScreenSpaceError = 0.0;
+    double culledScreenSpaceError = 0.0;
+    uint32_t loadingDescendantLimit = 0;
+    bool enforceCulledScreenSpaceError = false;
+    bool forbidHoles = false;
+    bool enableFrustumCulling = false;
+    bool enableFogCulling = false;
+    bool renderTilesUnderCamera = false;
+    bool preloadAncestors = false;
+    bool preloadSiblings = false;
+    SkipLevelOfDetailOptions skipLevelOfDetail;
+    FoveatedLoadingOptions foveatedLoading;
+
+    /**
+     * @brief Whether every tile visited in the last traversal was in a state
+     * that cannot change without a new load being requested.
+     */
+    bool allVisitedTilesSettled = false;
+  };
+
+  bool _canReuseLastSelection(
+      const std::vector<ViewState>& frustums) const noexcept;
+  void _recordTraversalInputs(const std::vector<ViewState>& frustums);
+
+  void _startLoadTimingsFrame(const std::vector<ViewState>& frustums);
+  void _finishLoadTimingsFrame(ViewUpdateResult& result);
+  bool _isViewFullyLoaded(const ViewUpdateResult& result) const noexcept;
+
+  void _computeVisibilityPerView(
+      const std::vector<ViewState>& frustums,
+      ViewUpdateResult& result) const;
+  void _addCreditsToFrame(const ViewUpdateResult& result);
+
+  CesiumAsync::ThreadPool& _getTraversalThreadPool(uint32_t threadCount);
+  void _evaluateTilesInParallel(
+      const std::vector<ViewState>& frustums,
+      const CombinedViewState* pCombinedView,
+      int32_t lastFrameNumber);
+
   void _processWorkerThreadLoadQueue();
+  void _processSubtreePrefetchQueue();
   void _processMainThreadLoadQueue();
+  void _processMainThreadLoadQueueInBatch(double timeBudget);
+
+  void _unloadCachedTiles(
+      double timeBudget,
+      int64_t maxBytes,
+      int64_t maxGpuBytes);
+
+  /**
+   * @brief Unloads cached tiles, recording the time taken and the bytes freed
+   * in the given result, along with the bytes loaded since the start of the
+   * frame.
+   */
+  void _unloadCachedTilesAndMeasure(
+      int64_t bytesAtStartOfFrame,
+      ViewUpdateResult& result);
 
-  void _unloadCachedTiles(double timeBudget) noexcept;
   void _markTileVisited(Tile& tile) noexcept;
 
+  /**
+   * @brief Releases the children of the tiles that weren't used for
+   * {@link TilesetContentOptions::releaseUnusedTileChildrenAfterFrames}
+   * frames, when they were created on demand.
+   */
+  void _releaseUnusedTileChildren(int32_t currentFrameNumber);
+
+  /**
+   * @brief Cancels the loads of tiles that were not visited this frame.
+   */
+  void _cancelUnneededTileLoads() noexcept;
+
   void _updateLodTransitions(
       const FrameState& frameState,
       float deltaTime,
       ViewUpdateResult& result) const noexcept;
 
+  void _updatePointBudget(ViewUpdateResult& result) const noexcept;
+
+  std::optional<double> _intersectRayWithTile(
+      Tile& tile,
+      const CesiumGeometry::Ray& ray,
+      double maximumDistance);
+
   TilesetExternals _externals;
   CesiumAsync::AsyncSystem _asyncSystem;
 
@@ -484,6 +831,10 @@ private:
   std::vector<TileLoadTask> _mainThreadLoadQueue;
   std::vector<TileLoadTask> _workerThreadLoadQueue;
 
+  // The tiles whose children's subtrees may be prefetched. See
+  // TilesetOptions::prefetchSubtrees.
+  std::vector<TileLoadTask> _subtreePrefetchQueue;
+
   Tile::LoadedLinkedList _loadedTiles;
 
   // Holds computed distances, to avoid allocating them on the heap during tile
@@ -494,6 +845,105 @@ private:
   // scratch variable so that it can allocate only when growing bigger.
   std::vector<const TileOcclusionRendererProxy*> _childOcclusionProxies;
 
+  // The frustum visibility of the children of tiles that are being visited.
+  // Each batch is the offset of one parent's children within
+  // _childVisibility, which holds one flag per child per frustum. The packed
+  // bounds, indices, and visibility are scratch storage used while computing a
+  // batch.
+  struct ChildVisibilityBatch {
+    const Tile* pParent;
+    size_t offset;
+  };
+  std::vector<ChildVisibilityBatch> _childVisibilityBatches;
+  std::vector<uint8_t> _childVisibility;
+  CesiumGeometry::PackedBoundingVolumes _packedChildBounds;
+  std::vector<size_t> _packedChildIndices;
+  std::vector<uint8_t> _packedChildVisibility;
+
+  // For each of the excluders, the depth of the tile being visited whose whole
+  // subtree the excluder includes, so that it is not called for any of the
+  // tile's descendants. Tiles are visited depth-first, so this is cleared as
+  // soon as a tile at the same depth or above it is visited.
+  std::vector<uint32_t> _excluderSubtreeIncludedDepths;
+
+  // The depth and screen-space error of the nearest ancestor of the tile being
+  // visited that is loaded below the base of TilesetOptions::skipLevelOfDetail,
+  // if there is one.
+  struct SkipLevelOfDetailAncestor {
+    uint32_t depth;
+    double screenSpaceError;
+  };
+  std::optional<SkipLevelOfDetailAncestor> _skipLevelOfDetailAncestor;
+
+  LastTraversalInputs _lastTraversalInputs;
+
+  // The factor applied to the screen-space errors (and divided into the
+  // loading descendant limit) by TilesetOptions::adaptiveScreenSpaceError, and
+  // the values it produced for the current frame.
+  double _screenSpaceErrorScale;
+  double _effectiveMaximumScreenSpaceError;
+  double _effectiveCulledScreenSpaceError;
+  uint32_t _effectiveLoadingDescendantLimit;
+
+  // State for TilesetOptions::networkAdaptiveLoading: the number of tiles it
+  // allows to load at once and the factor it applies to the screen-space
+  // errors, the lowest latency measured, and the time and finished request
+  // count of the last adjustment.
+  double _networkSimultaneousTileLoads;
+  double _networkScreenSpaceErrorScale;
+  double _lowestNetworkLatency;
+  std::chrono::steady_clock::time_point _lastNetworkAdjustmentTime;
+  uint64_t _lastNetworkRequestCount;
+  uint32_t _effectiveMaximumSimultaneousTileLoads;
+
+  // State for TilesetOptions::traversalTimeLimit: the time at which the
+  // current traversal must stop descending, the tiles rendered in the previous
+  // frame, and the subtrees (along with their ancestors) that could not be
+  // visited in the previous and current frames.
+  std::optional<std::chrono::system_clock::time_point> _traversalDeadline;
+  std::vector<Tile*> _previousTilesToRender;
+  std::unordered_set<const Tile*> _previousTilesToRenderSet;
+  std::unordered_set<const Tile*> _deferredTraversalTiles;
+  std::unordered_set<const Tile*> _nextDeferredTraversalTiles;
+
+  // The views passed to the previous updateView, for
+  // TilesetOptions::evictionPolicy, and the tiles it may unload.
+  std::vector<ViewState> _evictionFrustums;
+  std::vector<Tile*> _evictionCandidates;
+
+  // The tiles used this frame, and the unused children of those tiles whose
+  // own children may be released, for
+  // TilesetContentOptions::releaseUnusedTileChildrenAfterFrames.
+  std::unordered_set<const Tile*> _tilesUsedThisFrame;
+  std::vector<Tile*> _childrenReleaseCandidates;
+
+  // The positions of the views passed to the previous updateView, used to
+  // estimate their velocities for predictive loading.
+  std::vector<glm::dvec3> _previousViewPositions;
+
+  // Culling inputs computed ahead of the traversal, and the thread pool used
+  // to compute them. The pool is created lazily, and recreated if
+  // TilesetOptions::parallelTraversalThreadCount changes.
+  TileViewEvaluations _tileViewEvaluations;
+  std::optional<CesiumAsync::ThreadPool> _traversalThreadPool;
+  uint32_t _traversalThreadPoolSize;
+
+  // State for getLoadTimings: when this tileset was constructed, the views of
+  // the previous updateView and when they last changed, and whether every tile
+  // they need has loaded since then.
+  std::chrono::steady_clock::time_point _constructionTime;
+  std::chrono::steady_clock::time_point _viewChangeTime;
+  std::vector<ViewState> _loadTimingFrustums;
+  bool _viewFullyLoaded;
+  TilesetLoadTimings _loadTimings;
+
+  // For IPrepareRendererResources::prepareInMainThreadBatch: the tiles that
+  // are finished together in the current frame, and the average time each
+  // tile took in previous batches, used to fit a batch in
+  // TilesetOptions::mainThreadLoadingTimeLimit.
+  std::vector<Tile*> _mainThreadLoadBatch;
+  double _mainThreadBatchMillisecondsPerTile;
+
   CesiumUtility::IntrusivePointer<TilesetContentManager>
       _pTilesetContentManager;
 
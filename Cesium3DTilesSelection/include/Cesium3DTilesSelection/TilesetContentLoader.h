@@ -6,7 +6,9 @@
 #include "TileLoadResult.h"
 #include "TilesetOptions.h"
 
+#include <CesiumAsync/AssetRequestOptions.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CancellationToken.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGeometry/Axis.h>
@@ -15,6 +17,8 @@
 
 #include <spdlog/logger.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -76,6 +80,30 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
    * @brief The request headers that will be attached to the request.
    */
   const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders;
+
+  /**
+   * @brief The token that reports when the tile's content is no longer needed,
+   * such as because the tile has left the view.
+   *
+   * Loaders should pass it, as part of {@link getRequestOptions}, to
+   * {@link CesiumAsync::IAssetAccessor::getWithOptions} and to
+   * {@link CesiumGltfReader::GltfReaderOptions::cancellationToken}, and
+   * resolve with {@link TileLoadResult::createCanceledResult} when they notice
+   * that it has been canceled.
+   */
+  CesiumAsync::CancellationToken cancellationToken;
+
+  /**
+   * @brief The priority of the tile's load, which the tileset updates while
+   * the tile is loading, or nullptr if it has none.
+   */
+  std::shared_ptr<const CesiumAsync::AssetRequestPriority> pRequestPriority;
+
+  /**
+   * @brief Gets the options for the requests of the tile's content, with its
+   * {@link pRequestPriority} and {@link cancellationToken}.
+   */
+  CesiumAsync::AssetRequestOptions getRequestOptions() const;
 };
 
 /**
@@ -135,5 +163,60 @@ public:
    * @return The {@link TileChildrenResult} that stores the tile's children
    */
   virtual TileChildrenResult createTileChildren(const Tile& tile) = 0;
+
+  /**
+   * @brief Prepares for the tile's children to be destroyed so that they can
+   * be created again by a later call to {@link createTileChildren}.
+   *
+   * This is only called once none of the tile's descendants has content
+   * loaded or loading. If this returns true, the children and all of their
+   * descendants are destroyed right after this returns. The default
+   * implementation returns false, which keeps them.
+   *
+   * @param tile The tile whose children are about to be destroyed.
+   * @return Whether the children may be destroyed.
+   */
+  virtual bool releaseTileChildren(const Tile& tile);
+
+  /**
+   * @brief Gets the number of bytes of the data that this loader keeps in
+   * order to load tiles and create their children, such as the availability of
+   * the subtrees of an implicit tileset.
+   *
+   * These bytes are counted against {@link TilesetOptions::maximumCachedBytes}
+   * along with the tiles' content. The default implementation returns 0.
+   */
+  virtual int64_t getLoaderDataBytes() const noexcept;
+
+  /**
+   * @brief Unloads the least recently used data counted by
+   * {@link getLoaderDataBytes} that can be loaded again when it is needed,
+   * until at most `maximumBytes` remain or no more can be unloaded.
+   *
+   * The default implementation does nothing.
+   *
+   * @param maximumBytes The number of bytes to keep at most.
+   */
+  virtual void unloadLoaderData(int64_t maximumBytes);
+
+  /**
+   * @brief Starts loading the data that this loader needs to create the
+   * children of the given tile and load their content before the children are
+   * needed, such as the child subtrees of a tile on the last level of an
+   * implicit subtree, or the external tilesets of the children of an explicit
+   * tile.
+   *
+   * {@link Tileset} calls this for tiles that are close to being refined when
+   * {@link TilesetOptions::prefetchSubtrees} is enabled. The default
+   * implementation loads nothing.
+   *
+   * @param input The {@link TileLoadInput} that has the tile info and loading
+   * systems.
+   * @param maximumLoads The maximum number of loads to start.
+   * @return One future for each load that was started, which resolves in the
+   * main thread once the loaded data is ready to be used.
+   */
+  virtual std::vector<CesiumAsync::Future<void>>
+  prefetchTileChildren(const TileLoadInput& input, size_t maximumLoads);
 };
 } // namespace Cesium3DTilesSelection
@@ -5,18 +5,25 @@
 #include "spdlog-cesium.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/TileLoadScheduler.h>
 
 #include <memory>
 
 namespace CesiumAsync {
 class IAssetAccessor;
+class ICacheDatabase;
 class ITaskProcessor;
+class NetworkThroughputEstimator;
 } // namespace CesiumAsync
 
 namespace CesiumUtility {
 class CreditSystem;
 }
 
+namespace CesiumRasterOverlays {
+class QuadtreeTileImageCache;
+}
+
 namespace Cesium3DTilesSelection {
 class IPrepareRendererResources;
 
@@ -43,6 +50,10 @@ public:
    * The tileset will automatically call
    * {@link CesiumAsync::AsyncSystem::dispatchMainThreadTasks} from
    * {@link Tileset::updateView}.
+   *
+   * To keep blocking I/O, such as reading local files and the request cache,
+   * from competing with CPU-bound decoding for the same threads, construct
+   * the async system with separate CPU and I/O task processors.
    */
   CesiumAsync::AsyncSystem asyncSystem;
 
@@ -56,7 +67,10 @@ public:
   /**
    * @brief A spdlog logger that will receive log messages.
    *
-   * If not specified, defaults to `spdlog::default_logger()`.
+   * If not specified, defaults to `spdlog::default_logger()`. When a server
+   * fails, every tile load can log the same error. To keep those errors from
+   * flooding the log, use a logger created with
+   * {@link CesiumUtility::RateLimitedLogSink::createLogger}.
    */
   std::shared_ptr<spdlog::logger> pLogger = spdlog::default_logger();
 
@@ -69,6 +83,67 @@ public:
    */
   std::shared_ptr<TileOcclusionRendererProxyPool> pTileOcclusionProxyPool =
       nullptr;
+
+  /**
+   * @brief A scheduler that shares a budget of simultaneous tile loads with
+   * other tilesets and their raster overlays.
+   *
+   * If not specified, the tileset and its raster overlays are limited only by
+   * their own `maximumSimultaneousTileLoads` options.
+   */
+  std::shared_ptr<CesiumAsync::TileLoadScheduler> pTileLoadScheduler =
+      nullptr;
+
+  /**
+   * @brief A cache for the tile hierarchies of explicit tilesets.
+   *
+   * When the tileset.json of a tileset is received with an ETag, the tiles
+   * parsed from it are stored here in a compact binary form under its URL and
+   * ETag. The next time the same version of the tileset.json is received, its
+   * tiles are read from that instead of parsing the JSON again, which is much
+   * faster for tilesets with many tiles.
+   *
+   * If not specified, the tileset.json is always parsed.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pTileHierarchyCache = nullptr;
+
+  /**
+   * @brief A cache for the Cesium ion asset endpoints of tilesets.
+   *
+   * When an endpoint is received from Cesium ion, it's stored here until its
+   * access token expires. A tileset created for the same asset in a later
+   * session uses it instead of waiting for Cesium ion, so that its
+   * tileset.json or layer.json can be requested right away. It can be the
+   * same database as the {@link pTileHierarchyCache}.
+   *
+   * Whether or not this is specified, the endpoints are shared by the
+   * tilesets in this session.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pIonEndpointCache = nullptr;
+
+  /**
+   * @brief An estimator of the throughput and latency of the network, used by
+   * {@link TilesetOptions::networkAdaptiveLoading}.
+   *
+   * It is usually the estimator of a
+   * {@link CesiumAsync::ThroughputMeasuringAssetAccessor} that wraps the
+   * {@link pAssetAccessor}, so that it measures the tileset's own requests.
+   */
+  std::shared_ptr<CesiumAsync::NetworkThroughputEstimator>
+      pNetworkThroughputEstimator = nullptr;
+
+  /**
+   * @brief A cache that shares the images of quadtree raster overlay tiles
+   * with other tilesets that drape the same imagery, such as a terrain tileset
+   * and a buildings tileset with the same Bing Maps overlay.
+   *
+   * The tilesets sharing this cache must also share the credit system.
+   *
+   * If not specified, the raster overlays of this tileset only cache their
+   * own images.
+   */
+  std::shared_ptr<CesiumRasterOverlays::QuadtreeTileImageCache>
+      pRasterOverlayTileImageCache = nullptr;
 };
 
 } // namespace Cesium3DTilesSelection
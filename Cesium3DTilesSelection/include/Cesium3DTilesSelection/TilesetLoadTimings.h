@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief How long a {@link Tileset} took to reach milestones of loading, as
+ * returned by {@link Tileset::getLoadTimings}.
+ *
+ * All times are in milliseconds. A milestone that hasn't been reached yet is
+ * `std::nullopt`.
+ */
+struct CESIUM3DTILESSELECTION_API TilesetLoadTimings {
+  /**
+   * @brief The time from the construction of the tileset until
+   * {@link Tileset::getRootTileAvailableEvent} resolved.
+   */
+  std::optional<double> timeToRootTileAvailable;
+
+  /**
+   * @brief The time from the construction of the tileset until the end of the
+   * first {@link Tileset::updateView} that selected at least one tile to
+   * render.
+   */
+  std::optional<double> timeToFirstRenderableFrame;
+
+  /**
+   * @brief The time from the most recent view change until the end of the
+   * first {@link Tileset::updateView} after it in which no more tiles were
+   * needed for the view.
+   *
+   * This is `std::nullopt` while tiles for the current view are still
+   * loading. See {@link ViewUpdateResult::timeToFullDetail}.
+   */
+  std::optional<double> timeToFullDetail;
+
+  /**
+   * @brief The number of times the views passed to
+   * {@link Tileset::updateView} have changed, including the first views.
+   */
+  uint32_t viewChangeCount = 0;
+};
+
+} // namespace Cesium3DTilesSelection
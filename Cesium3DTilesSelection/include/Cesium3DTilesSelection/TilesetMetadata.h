@@ -6,6 +6,7 @@
 #include <Cesium3DTiles/Schema.h>
 #include <CesiumAsync/SharedFuture.h>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -58,6 +59,10 @@ public:
    * time, unless the {@link schemaUri} is changed. In that case, when this
    * method is called, the previous load is canceled and the new one begins.
    *
+   * The schema is parsed in a worker thread. While the metadata of any tileset
+   * holds a schema loaded from the same URI, that schema is copied instead of
+   * being requested and parsed again.
+   *
    * @param asyncSystem The async system used to do work in threads.
    * @param pAssetAccessor The asset accessor used to request the schema from
    * the schemaUri.
@@ -72,6 +77,10 @@ private:
   std::optional<CesiumAsync::SharedFuture<void>> _loadingFuture;
   std::optional<std::string> _loadingSchemaUri;
   std::shared_ptr<bool> _pLoadingCanceled;
+
+  // Keeps the schema loaded from the schemaUri in the cache shared by all
+  // tilesets.
+  std::shared_ptr<const Cesium3DTiles::Schema> _pSharedSchema;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -2,17 +2,36 @@
 
 #include "Library.h"
 
+#include <CesiumAsync/Future.h>
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
+namespace CesiumGltfContent {
+class IStagingBufferAllocator;
+}
+
+namespace CesiumGltfReader {
+class DecodedDataAllocator;
+class ExternalDataCache;
+}
+
 namespace Cesium3DTilesSelection {
 
 class ITileExcluder;
+class Tile;
+class ITileEvictionPolicy;
 class TilesetLoadFailureDetails;
 
 /**
@@ -28,6 +47,31 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    */
   bool enableWaterMask = false;
 
+  /**
+   * @brief Whether to store each water mask that is a mix of land and water
+   * at the lowest resolution that keeps all of its detail, rather than always
+   * at 256x256.
+   *
+   * Coastlines that follow tile edges or large blocks need only a fraction of
+   * the memory this way. The mask's sampler uses nearest filtering, because
+   * that is what makes the smaller mask match the full one. Only applies when
+   * {@link enableWaterMask} is true. See
+   * {@link CesiumQuantizedMeshTerrain::QuantizedMeshLoader::load}.
+   */
+  bool downsampleWaterMask = false;
+
+  /**
+   * @brief Whether to store each water mask that is a mix of land and water
+   * with one bit per texel instead of one byte.
+   *
+   * This makes each mask an eighth of the size, but the renderer must unpack
+   * the bits itself. Primitives with such a mask have a `WaterMaskPackedBits`
+   * extra that is true. Only applies when {@link enableWaterMask} is true. See
+   * {@link CesiumQuantizedMeshTerrain::QuantizedMeshLoader::load} for the
+   * layout of the bits.
+   */
+  bool packWaterMaskBits = false;
+
   /**
    * @brief Whether to generate smooth normals when normals are missing in the
    * original Gltf.
@@ -40,6 +84,64 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    */
   bool generateMissingNormalsSmooth = false;
 
+  /**
+   * @brief Whether the normals generated by
+   * {@link generateMissingNormalsSmooth} are oct-encoded, at four bytes per
+   * vertex instead of twelve.
+   *
+   * The normals are generated into the vertex attribute named
+   * `_OCT_ENCODED_NORMAL` instead of `NORMAL`, as two `UNSIGNED_SHORT`
+   * components, so the renderer has to decode them in its shaders. See
+   * {@link CesiumGltf::Model::generateMissingNormalsSmooth}.
+   */
+  bool octEncodeGeneratedNormals = false;
+
+  /**
+   * @brief Whether the texture coordinates generated for raster overlays are
+   * stored as normalized `UNSIGNED_SHORT` components, at four bytes per vertex
+   * and projection instead of eight.
+   *
+   * The `_CESIUMOVERLAY_n` attributes then have to be read as normalized
+   * integers by the renderer. See
+   * {@link CesiumRasterOverlays::RasterOverlayUtilities::createRasterOverlayTextureCoordinates}.
+   */
+  bool quantizeRasterOverlayTextureCoordinates = false;
+
+  /**
+   * @brief Whether to keep the oct-encoded normals of quantized-mesh terrain
+   * tiles encoded in the Gltf, at four bytes per vertex instead of twelve.
+   *
+   * The normals are kept in the vertex attribute named by
+   * {@link CesiumQuantizedMeshTerrain::QuantizedMeshLoader::OCT_ENCODED_NORMAL_ATTRIBUTE}
+   * instead of `NORMAL`, so the renderer has to decode them in its shaders.
+   * A tile with kept normals has no `NORMAL` attribute, so
+   * {@link generateMissingNormalsSmooth} should be disabled along with this.
+   */
+  bool keepTerrainNormalsOctEncoded = false;
+
+  /**
+   * @brief Whether to generate smooth normals for quantized-mesh terrain tiles
+   * that don't have oct-encoded normals.
+   *
+   * Set this to false if the renderer lights terrain without vertex normals,
+   * such as from a normal map or from derivatives in its shaders, to skip the
+   * cost of generating them.
+   */
+  bool generateMissingTerrainNormals = true;
+
+  /**
+   * @brief Whether to leave the skirts out of the meshes of quantized-mesh
+   * terrain tiles, and of the tiles upsampled from them, and describe them by
+   * the vertices along the edges of each mesh instead.
+   *
+   * The skirt vertices otherwise duplicate every edge vertex with all of its
+   * attributes. With this enabled, the renderer must create the skirts itself,
+   * such as in a vertex shader, from the edge vertex indices and skirt heights
+   * described by {@link CesiumGltfContent::SkirtMeshMetadata} in the extras of
+   * each primitive.
+   */
+  bool terrainSkirtsAsEdgeIndices = false;
+
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
@@ -50,9 +152,282 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    * @brief Whether or not to transform texture coordinates during load when
    * textures have the `KHR_texture_transform` extension. Set this to false if
    * texture coordinates will be transformed another way, such as in a vertex
-   * shader.
+   * shader with the matrix from
+   * {@link CesiumGltf::KhrTextureTransform::toMatrix}.
    */
   bool applyTextureTransform = true;
+
+  /**
+   * @brief Whether to dequantize vertex attributes that are quantized
+   * according to the `KHR_mesh_quantization` extension to floating-point
+   * values during load.
+   *
+   * Set this to false to keep the compact quantized data, in memory and in the
+   * renderer, if the renderer dequantizes vertex attributes in its shaders.
+   * Bounding regions and raster overlay texture coordinates are computed from
+   * quantized positions directly. Tiles upsampled for raster overlays have
+   * floating-point vertex attributes either way. Point clouds with quantized
+   * positions keep them quantized as well.
+   */
+  bool dequantizeMeshData = true;
+
+  /**
+   * @brief Whether to randomly permute the points of PNTS point clouds when
+   * they are loaded, so that a renderer can draw a uniform subsample of each by
+   * drawing only its first points.
+   *
+   * Enable this along with {@link TilesetOptions::maximumPointsRendered}. See
+   * {@link CesiumGltfReader::GltfReaderOptions::shufflePointClouds}.
+   */
+  bool shufflePointClouds = false;
+
+  /**
+   * @brief The names of the batch table properties of B3DM and PNTS tiles to
+   * convert to `EXT_structural_metadata`, or empty to convert all of them.
+   *
+   * Listing only the properties that are used avoids the cost of converting
+   * the others. See
+   * {@link CesiumGltfReader::GltfReaderOptions::batchTableProperties}.
+   */
+  std::vector<std::string> batchTableProperties;
+
+  /**
+   * @brief The maximum width and height of decoded JPEG, PNG, and WebP images,
+   * or 0 for no limit.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::maximumImageDimension}.
+   */
+  int32_t maximumImageDimension = 0;
+
+  /**
+   * @brief The maximum width and height of the mip levels kept from KTX2
+   * images, or 0 for no limit.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::maximumKtx2Dimension}.
+   */
+  int32_t maximumKtx2Dimension = 0;
+
+  /**
+   * @brief Whether JPEG, PNG, and WebP images without an alpha channel are
+   * decoded to three channels rather than four.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::decodeOpaqueImagesToRgb}.
+   */
+  bool decodeOpaqueImagesToRgb = false;
+
+  /**
+   * @brief A cache of the external buffers and images of tile content, which
+   * may be shared with other tilesets, so that those that several tiles refer
+   * to are loaded and decoded once.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::pExternalDataCache}.
+   */
+  std::shared_ptr<CesiumGltfReader::ExternalDataCache> pExternalDataCache;
+
+  /**
+   * @brief Allocates the memory of the buffers and images decoded from tile
+   * content, and counts its bytes for each kind of decoding.
+   *
+   * See {@link CesiumGltfReader::GltfReaderOptions::pDecodedDataAllocator}.
+   */
+  std::shared_ptr<CesiumGltfReader::DecodedDataAllocator>
+      pDecodedDataAllocator;
+
+  /**
+   * @brief A cache for the decoded glTF of tile content.
+   *
+   * When the content of a tile is received with an ETag, the glTF converted
+   * from it, with its Draco, meshopt, and image data already decoded, is
+   * stored here under its URL, its ETag, and the options above that affect
+   * decoding. The next time the same version of the content is received, the
+   * glTF is read from here instead of being decoded again. Content that refers
+   * to external buffers or images is not stored. Because the decoded content
+   * is much larger than the encoded one, this should be a separate database
+   * from the one used by a {@link CesiumAsync::CachingAssetAccessor}, such as
+   * a {@link CesiumAsync::SqliteCache} with its own file, so that they don't
+   * evict each other.
+   *
+   * If not specified, tile content is always decoded.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pDecodedTileCache;
+
+  /**
+   * @brief The number of seconds that decoded tile content is kept in the
+   * {@link pDecodedTileCache}.
+   */
+  int64_t decodedTileCacheSeconds = 7 * 24 * 60 * 60;
+
+  /**
+   * @brief Whether to release the CPU copies of most of a tile's glTF buffer
+   * and image data once {@link IPrepareRendererResources::prepareInMainThread}
+   * has prepared its renderer resources.
+   *
+   * Only the positions, indices, and raster overlay texture coordinates of
+   * each primitive are kept, which is enough for raster overlay upsampling to
+   * create geometry and for picking. Everything else, including all image
+   * pixels, is released. Enable this only if the renderer does not need the
+   * model's data after preparing it. See
+   * {@link TileRenderContent::isCpuDataReleased}.
+   */
+  bool releaseCpuDataAfterPreparing = false;
+
+  /**
+   * @brief Provides the full model of a tile whose CPU data was released by
+   * {@link releaseCpuDataAfterPreparing}, when it is needed again.
+   *
+   * This is called in the main thread when a descendant of the tile is about to
+   * be upsampled for a raster overlay, for example by loading the tile's
+   * content again. The returned future resolves to the full model, or to
+   * `std::nullopt` to upsample from the geometry that was kept, in which case
+   * the upsampled tiles have no other vertex attributes. If this is not set,
+   * the kept geometry is always used.
+   */
+  std::function<CesiumAsync::Future<std::optional<CesiumGltf::Model>>(
+      const Tile& tile)>
+      reloadReleasedModel;
+
+  /**
+   * @brief Whether to decode the images embedded in tile content while the
+   * tile loads.
+   *
+   * If false, the bytes of these images are left in their buffer views and
+   * {@link CesiumGltf::Image::cesium} is left empty. External images are
+   * always decoded.
+   */
+  bool decodeEmbeddedImages = true;
+
+  /**
+   * @brief Whether to wait to decode the embedded images of tiles that are
+   * only being preloaded until they are first needed for rendering.
+   *
+   * Tiles loaded because of {@link TilesetOptions::preloadAncestors},
+   * {@link TilesetOptions::preloadSiblings} or a predicted camera position are
+   * loaded without decoding their embedded images and without calling
+   * {@link IPrepareRendererResources::prepareInLoadThread}. When such a tile is
+   * first needed for rendering, both happen in a worker thread before the
+   * tile continues to {@link IPrepareRendererResources::prepareInMainThread}.
+   * A preloaded tile that is unloaded before it is needed never decodes its
+   * images.
+   */
+  bool deferPreloadedImageDecoding = false;
+
+  /**
+   * @brief Whether to create the tiles of an explicit tileset.json only when
+   * they are first needed.
+   *
+   * By default, every tile of a tileset.json is created when the tileset.json
+   * is loaded. When this is enabled, the parsed JSON is kept instead, and the
+   * children of a tile are only created when the tile is first visited, which
+   * makes very large explicit tilesets faster to load and much smaller in
+   * memory at the cost of the JSON itself.
+   */
+  bool createExplicitTileChildrenOnDemand = false;
+
+  /**
+   * @brief The number of frames after which the children created by
+   * {@link createExplicitTileChildrenOnDemand} are released again if they
+   * have not been used.
+   *
+   * The children of a tile that was not visited in this many frames are
+   * destroyed once none of them has content loaded, and are created again
+   * when the tile is next visited. A value of 0 keeps them until the tileset
+   * is destroyed.
+   */
+  int32_t releaseUnusedTileChildrenAfterFrames = 0;
+
+  /**
+   * @brief Whether to build a
+   * {@link CesiumGeometry::TriangleBoundingVolumeHierarchy} for each tile
+   * while it is loaded in a worker thread, for
+   * {@link Tileset::intersectRay} and {@link Tileset::sampleHeights}.
+   *
+   * When this is disabled, the hierarchy of a tile is built in the main thread
+   * the first time a ray reaches the tile.
+   */
+  bool createTriangleHierarchies = false;
+
+  /**
+   * @brief Whether to build a {@link CesiumGeometry::InstanceGrid} over the
+   * `EXT_mesh_gpu_instancing` instances of each tile while it is loaded in a
+   * worker thread, so that the renderer can draw only the instances within
+   * the view, found with {@link ViewState::computeVisibleInstanceRanges}.
+   *
+   * The instance attributes of the tile's glTF are reordered to match the
+   * grids, which are available from
+   * {@link TileRenderContent::getInstanceGrids}.
+   */
+  bool createInstanceGrids = false;
+
+  /**
+   * @brief Whether to merge the identical images and accessors of each tile's
+   * glTF while it is loaded in a worker thread, and to compute a content hash
+   * of each of its images.
+   *
+   * This saves memory on content that repeats the same textures and geometry,
+   * such as solid colors and copied elements of building models. The hashes
+   * are available from {@link TileRenderContent::getImageContentHashes}, so
+   * that the renderer can also share one texture between the identical images
+   * of different tiles. See
+   * {@link CesiumGltfContent::GltfUtilities::mergeDuplicateImages} and
+   * {@link CesiumGltfContent::GltfUtilities::mergeDuplicateAccessors}.
+   */
+  bool deduplicateContent = false;
+
+  /**
+   * @brief Whether to compute the bounding region of a tile whose bounding
+   * region has loose-fitting heights with
+   * {@link CesiumGltfContent::GltfUtilities::computeApproximateBoundingRegion}
+   * rather than from every vertex position.
+   *
+   * This is much faster for tiles with many vertices, but the heights may not
+   * fit the content as closely, which can make culling and level of detail
+   * selection slightly less precise. It has no effect on tiles with raster
+   * overlays, whose bounding region is computed anyway.
+   */
+  bool approximateLooseBoundingRegions = false;
+
+  /**
+   * @brief Whether to reorder the triangles and vertices of each loaded glTF
+   * so that it renders faster, with
+   * {@link CesiumGltfContent::GltfUtilities::optimizeMeshes}.
+   *
+   * This is worthwhile for content from tilers that don't optimize their
+   * meshes, at the cost of some time in a worker thread for each tile.
+   */
+  bool optimizeMeshes = false;
+
+  /**
+   * @brief Whether to also store 32-bit indices as 16-bit ones when there are
+   * few enough vertices. Only used if {@link optimizeMeshes} is true.
+   */
+  bool compressMeshIndices = false;
+
+  /**
+   * @brief Whether to merge the primitives of each loaded glTF that have the
+   * same material and attributes, with
+   * {@link CesiumGltfContent::GltfUtilities::mergePrimitives}.
+   *
+   * This reduces the number of draw calls for content with many small meshes,
+   * such as some converted b3dm tiles.
+   */
+  bool mergePrimitives = false;
+
+  /**
+   * @brief Allocates renderer memory, such as mapped staging buffers, for the
+   * vertices and indices of each loaded glTF.
+   *
+   * When this is set, the vertices and indices of each primitive are written
+   * into memory from this allocator, interleaved and aligned the way a GPU
+   * reads them, with
+   * {@link CesiumGltfContent::GltfUtilities::writeVertexStreams}. This happens
+   * in a worker thread, after the other post-processing, right before
+   * {@link IPrepareRendererResources::prepareInLoadThread}, which receives the
+   * streams in {@link TileLoadResult::vertexStreams}. A renderer can then copy
+   * the memory to its buffers once, or use it directly, instead of walking
+   * the glTF's accessors itself.
+   */
+  std::shared_ptr<CesiumGltfContent::IStagingBufferAllocator>
+      pStagingBufferAllocator;
 };
 
 /**
@@ -69,6 +444,223 @@ struct CESIUM3DTILESSELECTION_API FogDensityAtHeight {
   double fogDensity;
 };
 
+/**
+ * @brief Options for automatically coarsening a {@link Tileset}'s level of
+ * detail when the application's frame time or GPU memory usage exceeds a
+ * budget.
+ *
+ * The application reports these each frame with
+ * {@link Tileset::reportFrameStatistics}. While either is over its target,
+ * the tileset multiplies {@link TilesetOptions::maximumScreenSpaceError} and
+ * {@link TilesetOptions::culledScreenSpaceError} by a growing scale, and
+ * divides {@link TilesetOptions::loadingDescendantLimit} by it. Once both are
+ * comfortably under their targets, the scale shrinks back toward 1.0. The
+ * values in use are reported in {@link ViewUpdateResult}.
+ *
+ * @see TilesetOptions::adaptiveScreenSpaceError
+ */
+struct CESIUM3DTILESSELECTION_API AdaptiveScreenSpaceErrorOptions {
+  /**
+   * @brief Whether to adjust the level of detail from the reported frame
+   * statistics.
+   */
+  bool enabled = false;
+
+  /**
+   * @brief The frame time to aim for, in seconds. Zero ignores frame time.
+   */
+  double targetFrameTime = 1.0 / 30.0;
+
+  /**
+   * @brief The GPU memory usage to stay under, in bytes. Zero ignores GPU
+   * memory usage.
+   */
+  int64_t gpuMemoryBudget = 0;
+
+  /**
+   * @brief The fraction of each target by which a reported value must exceed
+   * it, or fall below it, before the scale changes.
+   *
+   * This keeps the level of detail from oscillating while the frame time is
+   * close to the target.
+   */
+  double hysteresis = 0.1;
+
+  /**
+   * @brief The factor by which the scale grows or shrinks with each report
+   * that is outside the hysteresis band.
+   */
+  double scaleStep = 1.1;
+
+  /**
+   * @brief The largest scale that may be applied.
+   */
+  double maximumScale = 4.0;
+};
+
+/**
+ * @brief Options for skipping levels of detail while refining a
+ * {@link Tileset}, so that the tiles needed for the view are loaded without
+ * first loading most of the tiles between them and the root.
+ *
+ * Tiles whose screen-space error is at least {@link baseScreenSpaceError} are
+ * refined as usual. The tiles below them form a coarse base, which is loaded
+ * and rendered while the tiles that meet
+ * {@link TilesetOptions::maximumScreenSpaceError} load. Refined tiles between
+ * the base and those tiles are only loaded if they are more than
+ * {@link skipLevels} levels below the last tile loaded on the way, and their
+ * screen-space error is less than that tile's divided by
+ * {@link skipScreenSpaceErrorFactor}. Tiles that are not loaded are neither
+ * preloaded as ancestors nor loaded instead of their descendants when
+ * {@link TilesetOptions::loadingDescendantLimit} is exceeded.
+ *
+ * @see TilesetOptions::skipLevelOfDetail
+ */
+struct CESIUM3DTILESSELECTION_API SkipLevelOfDetailOptions {
+  /**
+   * @brief Whether to skip levels of detail while refining.
+   */
+  bool enabled = false;
+
+  /**
+   * @brief The screen-space error below which tiles may be skipped. The
+   * tileset's {@link TilesetOptions::maximumScreenSpaceError} is used if it is
+   * larger.
+   */
+  double baseScreenSpaceError = 1024.0;
+
+  /**
+   * @brief The factor by which the screen-space error of a tile must be
+   * smaller than that of the last tile loaded above it for it to be loaded
+   * as well.
+   */
+  double skipScreenSpaceErrorFactor = 16.0;
+
+  /**
+   * @brief The number of levels below the last tile loaded above a tile that
+   * are always skipped.
+   */
+  uint32_t skipLevels = 1;
+
+  /**
+   * @brief Whether to load only the tiles that meet the maximum screen-space
+   * error, ignoring the other options.
+   *
+   * No base is loaded, so parts of the tileset are blank until the tiles
+   * needed for them have loaded.
+   */
+  bool immediatelyLoadDesiredLevelOfDetail = false;
+};
+
+/**
+ * @brief Options for loading the tiles that a viewer looks at before the
+ * tiles in the periphery of the view, and with more detail.
+ *
+ * The angle of a tile from the viewer's gaze is measured from
+ * {@link ViewState::getGazeDirection}, which is the center of the view unless
+ * the application supplies a gaze direction, such as from an eye tracker.
+ * Tiles within {@link fovealAngle} of it are loaded in order of distance. The
+ * load priority of tiles further away grows with their angle, so that a tile
+ * one foveal angle outside the fovea is loaded as soon as a tile in the fovea
+ * twice as far away.
+ *
+ * @see TilesetOptions::foveatedLoading
+ */
+struct CESIUM3DTILESSELECTION_API FoveatedLoadingOptions {
+  /**
+   * @brief Whether to prioritize and refine tiles by their angle from the
+   * viewer's gaze.
+   */
+  bool enabled = false;
+
+  /**
+   * @brief The angle from the viewer's gaze, in radians, within which tiles
+   * are treated as being looked at.
+   */
+  double fovealAngle = CesiumUtility::Math::degreesToRadians(10.0);
+
+  /**
+   * @brief The factor by which the maximum screen-space error is relaxed for
+   * tiles at the edge of the view.
+   *
+   * The factor grows linearly from 1.0 at the edge of the fovea to this value
+   * at the corners of the view, so a value of 1.0 refines every visible tile
+   * as usual.
+   */
+  double peripheralScreenSpaceErrorFactor = 1.0;
+};
+
+/**
+ * @brief Options for adapting a {@link Tileset}'s loading to the throughput
+ * and latency of the network, as measured by
+ * {@link TilesetExternals::pNetworkThroughputEstimator}.
+ *
+ * The number of tiles that may load at once starts at
+ * {@link TilesetOptions::maximumSimultaneousTileLoads}. Whenever the measured
+ * latency exceeds the lowest latency seen by {@link congestionLatencyFactor},
+ * the requests are taken to be queuing in the network, and the number is
+ * multiplied by {@link multiplicativeDecrease}. Otherwise, while every load
+ * that is allowed is in use, it grows by {@link additiveIncrease} per round
+ * trip, up to that maximum.
+ *
+ * If {@link targetTimeToFullDetail} is set, the tileset also estimates how
+ * long the tiles it is waiting for will take to download. While that exceeds
+ * the target, {@link TilesetOptions::maximumScreenSpaceError} is scaled up as
+ * it is by {@link TilesetOptions::adaptiveScreenSpaceError}, so that fewer
+ * tiles are needed, and once it is comfortably under the target, the scale
+ * shrinks back toward 1.0. The values in use are reported in
+ * {@link ViewUpdateResult}.
+ *
+ * @see TilesetOptions::networkAdaptiveLoading
+ */
+struct CESIUM3DTILESSELECTION_API NetworkAdaptiveLoadingOptions {
+  /**
+   * @brief Whether to adapt loading to the network. This has no effect unless
+   * {@link TilesetExternals::pNetworkThroughputEstimator} is specified.
+   */
+  bool enabled = false;
+
+  /**
+   * @brief The fewest tiles that may be allowed to load at once.
+   */
+  uint32_t minimumSimultaneousTileLoads = 2;
+
+  /**
+   * @brief The number of simultaneous tile loads added per round trip while
+   * the network is not congested.
+   */
+  double additiveIncrease = 1.0;
+
+  /**
+   * @brief The factor by which the number of simultaneous tile loads is
+   * multiplied when the network is congested.
+   */
+  double multiplicativeDecrease = 0.5;
+
+  /**
+   * @brief The factor by which the latency must exceed the lowest latency
+   * measured for the network to be considered congested.
+   */
+  double congestionLatencyFactor = 2.0;
+
+  /**
+   * @brief The time within which the tiles needed for the view should be
+   * downloaded, in seconds. Zero leaves the screen-space error alone.
+   */
+  double targetTimeToFullDetail = 0.0;
+
+  /**
+   * @brief The factor by which the screen-space error scale grows or shrinks
+   * with each adjustment.
+   */
+  double scaleStep = 1.1;
+
+  /**
+   * @brief The largest screen-space error scale that may be applied.
+   */
+  double maximumScale = 4.0;
+};
+
 /**
  * @brief Additional options for configuring a {@link Tileset}.
  */
@@ -100,12 +692,86 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   uint32_t maximumSimultaneousTileLoads = 20;
 
+  /**
+   * @brief The largest estimated number of bytes of tile content that may
+   * simultaneously be in the process of loading, or 0 for no limit.
+   *
+   * {@link maximumSimultaneousTileLoads} counts every tile the same, but a
+   * tile with tens of megabytes of compressed meshes and textures takes far
+   * more time and memory to decode than a small terrain tile. With this
+   * limit, a tileset whose tiles are large loads fewer at once than one whose
+   * tiles are small.
+   *
+   * The size of a tile that has not loaded yet isn't known, so each load is
+   * estimated to be the size that the content of this tileset's recently
+   * loaded tiles had in memory. Until the first tile has loaded, only
+   * {@link maximumSimultaneousTileLoads} applies. At least one tile may
+   * always load, however large the estimate.
+   */
+  int64_t maximumSimultaneousTileLoadBytes = 0;
+
+  /**
+   * @brief The time, in seconds, to wait before loading a tile again after its
+   * load failed temporarily, such as because the server could not be reached.
+   *
+   * The delay doubles with each consecutive temporary failure of the same
+   * tile, up to {@link maximumRetryDelay}, so that a server that is having
+   * trouble is not flooded with retries. Zero retries right away.
+   */
+  double retryDelay = 1.0;
+
+  /**
+   * @brief The longest time, in seconds, to wait before loading a tile again
+   * after its load failed temporarily.
+   */
+  double maximumRetryDelay = 60.0;
+
   /**
    * @brief The maximum number of subtrees that may simultaneously be in the
    * process of loading.
    */
   uint32_t maximumSimultaneousSubtreeLoads = 20;
 
+  /**
+   * @brief Whether to load the child subtrees of implicit tilesets, and the
+   * external tilesets of the children of explicit tiles, before they are
+   * needed.
+   *
+   * When true, once a tile on the last level of an implicit subtree meets the
+   * screen-space error by less than
+   * {@link subtreePrefetchScreenSpaceErrorFraction}, the subtrees below it are
+   * loaded with the priority of preloads, so that its children only need to
+   * wait for their content when it is refined. Likewise, the JSON of the
+   * external tilesets that are the content of the children of such an
+   * explicit tile is requested and parsed in a worker thread, so that a
+   * tileset made of deeply nested external tilesets doesn't need a round trip
+   * for each level once it gets there. No more than
+   * {@link maximumSimultaneousSubtreeLoads} of these loads are in progress at
+   * once.
+   */
+  bool prefetchSubtrees = false;
+
+  /**
+   * @brief The fraction of {@link maximumScreenSpaceError} that the
+   * screen-space error of a tile must exceed for the subtrees below it to be
+   * prefetched.
+   *
+   * Only used when {@link prefetchSubtrees} is true.
+   */
+  double subtreePrefetchScreenSpaceErrorFraction = 0.5;
+
+  /**
+   * @brief Whether to cancel the loads of tiles that are no longer needed.
+   *
+   * When true, a tile that is still loading but was not visited by
+   * {@link Tileset::updateView}, such as because it has left the view, has its
+   * load canceled. Its network request, decoding, and post-processing stop at
+   * their next check of {@link TileLoadInput::cancellationToken}, and the tile
+   * returns to {@link TileLoadState::Unloaded}, so that it is loaded again if
+   * it is needed later.
+   */
+  bool cancelUnneededTileLoads = false;
+
   /**
    * @brief Indicates whether the ancestors of rendered tiles should be
    * preloaded. Setting this to true optimizes the zoom-out experience and
@@ -168,6 +834,20 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool delayRefinementForOcclusion = true;
 
+  /**
+   * @brief Only check the occlusion of tiles whose refinement would load
+   * children.
+   *
+   * Knowing that a tile is occluded saves the most when it keeps the tile's
+   * children from being loaded. When this is true, a tile whose children are
+   * all renderable already is refined without checking its occlusion, which
+   * leaves the occlusion proxies, and the renderer's occlusion queries, for
+   * the tiles where they can prevent loads. Only applicable when
+   * enableOcclusionCulling is true. See also
+   * {@link TileOcclusionRendererProxyPool::setMaximumNewProxiesPerFrame}.
+   */
+  bool checkOcclusionOnlyBeforeLoading = false;
+
   /**
    * @brief Enable culling of tiles that cannot be seen through atmospheric fog.
    */
@@ -195,7 +875,8 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
   double culledScreenSpaceError = 64.0;
 
   /**
-   * @brief The maximum number of bytes that may be cached.
+   * @brief The maximum number of bytes of CPU memory that may be cached, as
+   * reported by {@link Tileset::getTotalDataBytes}.
    *
    * Note that this value, even if 0, will never
    * cause tiles that are needed for rendering to be unloaded. However, if the
@@ -205,6 +886,35 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   int64_t maximumCachedBytes = 512 * 1024 * 1024;
 
+  /**
+   * @brief The maximum number of bytes of GPU memory that may be cached, as
+   * reported by {@link Tileset::getTotalGpuDataBytes}.
+   *
+   * This is enforced separately from {@link maximumCachedBytes}: tiles are
+   * unloaded while either limit is exceeded. Like that limit, it never causes
+   * tiles that are needed for rendering to be unloaded. It has no effect unless
+   * the renderer reports its GPU memory usage through
+   * {@link IPrepareRendererResources::getGpuByteSize}.
+   */
+  int64_t maximumCachedGpuBytes = 512 * 1024 * 1024;
+
+  /**
+   * @brief The number of bytes to shed the cache down to when
+   * {@link Tileset::handleMemoryPressure} is called.
+   *
+   * Like {@link maximumCachedBytes}, this never causes tiles that are needed
+   * for rendering to be unloaded.
+   */
+  int64_t memoryPressureCachedBytes = 0;
+
+  /**
+   * @brief Decides which cached tiles are unloaded first when the cache is over
+   * {@link maximumCachedBytes}.
+   *
+   * If this is `nullptr`, the least recently used tiles are unloaded first.
+   */
+  std::shared_ptr<ITileEvictionPolicy> evictionPolicy;
+
   /**
    * @brief A table that maps the camera height above the ellipsoid to a fog
    * density. Tiles that are in full fog are culled. The density of the fog
@@ -287,12 +997,35 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool kickDescendantsWhileFadingIn = true;
 
+  /**
+   * @brief The maximum number of points to render in each frame, or 0 for no
+   * limit.
+   *
+   * When the point clouds of the tiles selected for rendering have more points
+   * in total, each of them gets the same
+   * {@link TileRenderContent::getPointBudgetFraction} of less than 1.0, which
+   * keeps the total within the budget if the renderer only draws that fraction
+   * of the points of each point primitive. Enable
+   * {@link TilesetContentOptions::shufflePointClouds} too, so that the points
+   * drawn are a uniform subsample of each tile.
+   */
+  int64_t maximumPointsRendered = 0;
+
   /**
    * @brief A soft limit on how long (in milliseconds) to spend on the
    * main-thread part of tile loading each frame (each call to
    * Tileset::updateView). A value of 0.0 indicates that all pending
    * main-thread loads should be completed each tick.
    *
+   * When this is greater than 0.0, the main-thread continuations that
+   * Tileset::updateView dispatches at the start of a frame are limited to the
+   * same amount of time, with the highest-priority continuations dispatched
+   * first. Continuations that don't fit are dispatched in a later frame.
+   *
+   * When {@link IPrepareRendererResources::supportsPrepareInMainThreadBatch}
+   * is `true`, the tiles are prepared in a single batch, sized from how long
+   * the previous batches took per tile.
+   *
    * Setting this to too low of a value will impede overall tile load progress,
    * creating a discernable load latency.
    */
@@ -305,6 +1038,161 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   double tileCacheUnloadTimeLimit = 0.0;
 
+  /**
+   * @brief A soft limit on how long (in milliseconds) to spend each frame
+   * mapping the raster overlays whose tile providers became ready to the tiles
+   * that were loaded before, and show their placeholders until then. A value
+   * of 0.0 indicates that all of those tiles should be mapped in the frame in
+   * which they are visited.
+   *
+   * Adding an overlay to a tileset with many loaded tiles otherwise maps all
+   * of them in a single frame. With a limit, the tiles visited first, which
+   * are the ones closer to the root, are mapped first, and the rest are
+   * mapped in later frames.
+   */
+  double rasterOverlayMappingTimeLimit = 0.0;
+
+  /**
+   * @brief A soft limit on how long (in milliseconds) to spend traversing the
+   * tileset to select tiles each frame (each call to Tileset::updateView). A
+   * value of 0.0 indicates that the whole tileset should be traversed each
+   * frame.
+   *
+   * When the limit is reached, the subtrees that have not been visited yet keep
+   * the selection they had in the previous frame, and are visited first in the
+   * next frame. Their tiles are not queued for loading until they are visited.
+   * The root tile and its children are always visited.
+   */
+  double traversalTimeLimit = 0.0;
+
+  /**
+   * @brief The number of additional threads used to evaluate tile culling and
+   * screen-space error inputs during each call to Tileset::updateView.
+   *
+   * When this is greater than zero, the tiles that were visited in the
+   * previous frame have their distances and frustum visibility computed in
+   * parallel, on a thread pool owned by the tileset, before the traversal
+   * begins. The traversal itself, which mutates tile selection state and load
+   * queues, still runs in the calling thread and consumes these precomputed
+   * values, so the resulting {@link ViewUpdateResult} is identical to the one
+   * produced without parallel evaluation. A value of 0 disables parallel
+   * evaluation.
+   */
+  uint32_t parallelTraversalThreadCount = 0;
+
+  /**
+   * @brief The minimum number of tiles that must have been visited in the
+   * previous frame before the tileset evaluates them in parallel.
+   *
+   * Below this number, the cost of dispatching work to other threads exceeds
+   * the cost of simply evaluating the tiles during the traversal. Only
+   * applicable when {@link parallelTraversalThreadCount} is greater than zero.
+   */
+  uint32_t parallelTraversalMinimumTiles = 256;
+
+  /**
+   * @brief Whether to cull and measure tiles against a single frustum that
+   * contains all of the views passed to Tileset::updateView, before testing
+   * them against the views one by one.
+   *
+   * This makes each additional view much cheaper when the views are similar,
+   * such as the two eyes of a VR headset or several viewports of the same
+   * scene. A tile outside of the combined frustum is culled without testing
+   * each view. The distance to a tile that is far from the views, compared to
+   * the distances between them, is computed once, from their center, and
+   * reduced by the largest distance from the center to a view. That never
+   * underestimates the screen-space error, but can overestimate it by up to
+   * one percent. Views that face in very different directions are not
+   * combined.
+   */
+  bool enableCombinedViewTraversal = false;
+
+  /**
+   * @brief Whether Tileset::updateView reports which of its views each
+   * selected tile is visible in, in
+   * {@link ViewUpdateResult::tileVisibilityPerView}.
+   *
+   * This lets a single tileset serve several independent viewers, such as the
+   * sessions of a server that renders for remote clients. Each viewer passes
+   * its view to the same updateView call, so the tiles that the viewers have
+   * in common are loaded and cached once. The tiles selected for all of the
+   * views form one level of detail, which is at least as detailed as each view
+   * needs. Each viewer then renders the selected tiles that are visible in its
+   * own view.
+   */
+  bool computeVisibilityPerView = false;
+
+  /**
+   * @brief Whether to reuse the previous frame's selection when the view has
+   * not meaningfully changed.
+   *
+   * When true, Tileset::updateView skips the selection traversal entirely if
+   * each view is within {@link cachedTraversalPositionTolerance} and
+   * {@link cachedTraversalDirectionTolerance} of the corresponding view in the
+   * last traversal, the options that affect selection are unchanged, and none
+   * of the tiles visited in the last traversal are still loading or otherwise
+   * changing. In that case the previous selection is returned again, with
+   * {@link ViewUpdateResult::selectionReused} set.
+   *
+   * Excluders, occlusion culling, and LOD transitions make the selection
+   * depend on more than the view, so the previous selection is never reused
+   * while any of them is active.
+   */
+  bool enableCachedTraversal = false;
+
+  /**
+   * @brief The distance, in meters, that a camera may move and still be
+   * considered unchanged by {@link enableCachedTraversal}, and by
+   * {@link ViewUpdateResult::timeToFullDetail}.
+   */
+  double cachedTraversalPositionTolerance = 0.01;
+
+  /**
+   * @brief The angle, in radians, that a camera's direction or up vector may
+   * rotate and still be considered unchanged by
+   * {@link enableCachedTraversal}, and by
+   * {@link ViewUpdateResult::timeToFullDetail}.
+   */
+  double cachedTraversalDirectionTolerance = 1.0e-5;
+
+  /**
+   * @brief How far ahead, in seconds, to predict the motion of each camera in
+   * order to preload the tiles it is about to need.
+   *
+   * When this is greater than zero, Tileset::updateView estimates the velocity
+   * of each view from its position in the previous call and the `deltaTime`,
+   * extrapolates the view this far ahead, and queues the tiles needed by the
+   * predicted views for loading with preload priority. The predicted views
+   * never affect which tiles are selected for rendering, and their loads are
+   * not counted in the load queue lengths reported by
+   * {@link ViewUpdateResult}. Set to zero to disable prediction.
+   */
+  double predictiveLoadTime = 0.0;
+
+  /**
+   * @brief Options for coarsening the level of detail when frames take too
+   * long or GPU memory runs short.
+   */
+  AdaptiveScreenSpaceErrorOptions adaptiveScreenSpaceError;
+
+  /**
+   * @brief Options for skipping intermediate levels of detail, so that moving
+   * the camera close to a deep tileset loads fewer tiles.
+   */
+  SkipLevelOfDetailOptions skipLevelOfDetail;
+
+  /**
+   * @brief Options for loading the tiles near the viewer's gaze first, and
+   * with more detail than those in the periphery of the view.
+   */
+  FoveatedLoadingOptions foveatedLoading;
+
+  /**
+   * @brief Options for adapting the number of simultaneous tile loads, and
+   * the level of detail, to the measured network throughput.
+   */
+  NetworkAdaptiveLoadingOptions networkAdaptiveLoading;
+
   /**
    * @brief Options for configuring the parsing of a {@link Tileset}'s content
    * and construction of Gltf models.
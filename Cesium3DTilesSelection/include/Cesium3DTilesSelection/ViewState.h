@@ -4,13 +4,17 @@
 #include "Library.h"
 
 #include <CesiumGeometry/CullingVolume.h>
+#include <CesiumGeometry/InstanceGrid.h>
+#include <CesiumGeometry/PackedBoundingVolumes.h>
 #include <CesiumGeometry/Plane.h>
 #include <CesiumGeospatial/Cartographic.h>
 
 #include <glm/mat3x3.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
+#include <cstdint>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -50,6 +54,21 @@ public:
       const CesiumGeospatial::Ellipsoid& ellipsoid =
           CesiumGeospatial::Ellipsoid::WGS84);
 
+  /**
+   * @brief Creates a copy of this view state in which the viewer looks at a
+   * different part of the view than its center, such as the gaze point
+   * reported by an eye tracker.
+   *
+   * The gaze direction only affects the order in which tiles are loaded and
+   * the level of detail of tiles away from it, when enabled with
+   * {@link TilesetOptions::foveatedLoading}. Culling still uses the whole
+   * view.
+   *
+   * @param gazeDirection The direction in which the viewer looks, in
+   * Earth-centered, Earth-fixed coordinates. It must be normalized.
+   */
+  ViewState withGazeDirection(const glm::dvec3& gazeDirection) const;
+
   /**
    * @brief Gets the position of the camera in Earth-centered, Earth-fixed
    * coordinates.
@@ -68,6 +87,17 @@ public:
    */
   const glm::dvec3& getUp() const noexcept { return this->_up; }
 
+  /**
+   * @brief Gets the direction in which the viewer looks, in Earth-centered,
+   * Earth-fixed coordinates.
+   *
+   * This is the look direction of the camera unless another one was given to
+   * {@link withGazeDirection}.
+   */
+  const glm::dvec3& getGazeDirection() const noexcept {
+    return this->_gazeDirection;
+  }
+
   /**
    * @brief Gets the position of the camera as a longitude / latitude / height.
    *
@@ -113,6 +143,40 @@ public:
   bool
   isBoundingVolumeVisible(const BoundingVolume& boundingVolume) const noexcept;
 
+  /**
+   * @brief Determines which of a batch of bounding volumes are visible for
+   * this camera.
+   *
+   * This is equivalent to calling {@link isBoundingVolumeVisible} for each
+   * volume, except that a volume that exactly touches a frustum plane from the
+   * outside is considered visible. The whole batch is tested against each
+   * frustum plane in a single pass.
+   *
+   * @param boundingVolumes The bounding volumes to test.
+   * @param visibility Receives a nonzero value for each bounding volume that is
+   * visible, and zero for each that is not. Must contain at least as many
+   * elements as there are bounding volumes.
+   */
+  void computeBoundingVolumesVisibility(
+      const CesiumGeometry::PackedBoundingVolumes& boundingVolumes,
+      gsl::span<uint8_t> visibility) const;
+
+  /**
+   * @brief Finds the instances of a {@link CesiumGeometry::InstanceGrid} that
+   * may be visible for this camera.
+   *
+   * The instances of each cell whose bounding box is visible are returned as a
+   * range of the grid's order, which can be drawn with a single indirect draw.
+   * The ranges of consecutive visible cells are merged.
+   *
+   * @param grid The grid, in the same coordinates as this camera.
+   * @param ranges Receives the ranges of the instances that may be visible, in
+   * increasing order. It is cleared first.
+   */
+  void computeVisibleInstanceRanges(
+      const CesiumGeometry::InstanceGrid& grid,
+      std::vector<CesiumGeometry::InstanceGrid::Range>& ranges) const;
+
   /**
    * @brief Computes the squared distance to the given {@link BoundingVolume}.
    *
@@ -154,6 +218,9 @@ private:
    * angle of the camera, in radians.
    * @param verticalFieldOfView The vertical field-of-view (opening)
    * angle of the camera, in radians.
+   * @param positionCartographic The position of the camera as a longitude /
+   * latitude / height.
+   * @param gazeDirection The direction in which the viewer looks.
    */
   ViewState(
       const glm::dvec3& position,
@@ -162,12 +229,13 @@ private:
       const glm::dvec2& viewportSize,
       double horizontalFieldOfView,
       double verticalFieldOfView,
-      const std::optional<CesiumGeospatial::Cartographic>&
-          positionCartographic);
+      const std::optional<CesiumGeospatial::Cartographic>& positionCartographic,
+      const glm::dvec3& gazeDirection);
 
   const glm::dvec3 _position;
   const glm::dvec3 _direction;
   const glm::dvec3 _up;
+  const glm::dvec3 _gazeDirection;
   const glm::dvec2 _viewportSize;
   const double _horizontalFieldOfView;
   const double _verticalFieldOfView;
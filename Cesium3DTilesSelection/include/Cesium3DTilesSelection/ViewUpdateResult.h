@@ -2,8 +2,9 @@
 
 #include "Library.h"
 
+#include <cstddef>
 #include <cstdint>
-#include <unordered_set>
+#include <optional>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -36,8 +37,38 @@ public:
    * If {@link TilesetOptions::enableLodTransitionPeriod} is true they may be
    * fading out. If a tile's {TileRenderContent::lodTransitionPercentage} is 0
    * or lod transitions are disabled, the tile should be hidden right away.
+   *
+   * Each tile appears in this list at most once, and the tiles are in no
+   * particular order. {@link Tile::isFadingOut} is true for the tiles in it.
+   */
+  std::vector<Tile*> tilesFadingOut;
+
+  /**
+   * @brief Which of the views passed to {@link Tileset::updateView} each tile
+   * in {@link tilesToRenderThisFrame} is visible in, when
+   * {@link TilesetOptions::computeVisibilityPerView} is true.
+   *
+   * The visibility of tile `i` in view `j` is at index
+   * `i * viewCount + j`, and is 1 if the tile is visible in the view or 0
+   * otherwise. A tile that is under a view's camera counts as visible in it if
+   * {@link TilesetOptions::renderTilesUnderCamera} is true. The vector is
+   * empty if the option is false.
    */
-  std::unordered_set<Tile*> tilesFadingOut;
+  std::vector<uint8_t> tileVisibilityPerView;
+
+  /**
+   * @brief Gets the tiles in {@link tilesToRenderThisFrame} that are visible
+   * in one of the views, using {@link tileVisibilityPerView}.
+   *
+   * @param viewIndex The index of the view in the views passed to
+   * {@link Tileset::updateView}.
+   * @param viewCount The number of views passed to
+   * {@link Tileset::updateView}.
+   * @return The tiles to render in the view, or all of the tiles to render if
+   * the visibility per view wasn't computed.
+   */
+  std::vector<Tile*>
+  getTilesToRenderInView(size_t viewIndex, size_t viewCount) const;
 
   /**
    * @brief The number of tiles in the worker thread load queue.
@@ -49,6 +80,112 @@ public:
    */
   int32_t mainThreadTileLoadQueueLength = 0;
 
+  /**
+   * @brief Whether the previous frame's selection was reused without
+   * traversing the tileset, because the view did not meaningfully change.
+   *
+   * See {@link TilesetOptions::enableCachedTraversal}. When this is true, no
+   * tiles were visited, so the traversal statistics below are all zero.
+   */
+  bool selectionReused = false;
+
+  /**
+   * @brief The maximum screen-space error used to select tiles this frame.
+   *
+   * This is {@link TilesetOptions::maximumScreenSpaceError}, unless it has
+   * been scaled by {@link TilesetOptions::adaptiveScreenSpaceError} or
+   * {@link TilesetOptions::networkAdaptiveLoading}.
+   */
+  double effectiveMaximumScreenSpaceError = 0.0;
+
+  /**
+   * @brief The culled screen-space error used to select tiles this frame.
+   *
+   * This is {@link TilesetOptions::culledScreenSpaceError}, unless it has been
+   * scaled by {@link TilesetOptions::adaptiveScreenSpaceError} or
+   * {@link TilesetOptions::networkAdaptiveLoading}.
+   */
+  double effectiveCulledScreenSpaceError = 0.0;
+
+  /**
+   * @brief The loading descendant limit used to select tiles this frame.
+   *
+   * This is {@link TilesetOptions::loadingDescendantLimit}, unless it has been
+   * scaled by {@link TilesetOptions::adaptiveScreenSpaceError} or
+   * {@link TilesetOptions::networkAdaptiveLoading}.
+   */
+  uint32_t effectiveLoadingDescendantLimit = 0;
+
+  /**
+   * @brief The number of tiles that may be loading at once this frame.
+   *
+   * This is {@link TilesetOptions::maximumSimultaneousTileLoads}, unless it
+   * has been reduced by {@link TilesetOptions::networkAdaptiveLoading}.
+   */
+  uint32_t effectiveMaximumSimultaneousTileLoads = 0;
+
+  /**
+   * @brief The time, in milliseconds, spent traversing the tileset to select
+   * tiles this frame, including evaluating tiles on the traversal threads.
+   */
+  double traversalTime = 0.0;
+
+  /**
+   * @brief The time, in milliseconds, spent dispatching tiles from the worker
+   * thread load queue this frame.
+   */
+  double workerThreadLoadQueueDispatchTime = 0.0;
+
+  /**
+   * @brief The time, in milliseconds, spent on the main-thread part of tile
+   * loading this frame.
+   *
+   * See {@link TilesetOptions::mainThreadLoadingTimeLimit}.
+   */
+  double mainThreadLoadingTime = 0.0;
+
+  /**
+   * @brief The time, in milliseconds, spent unloading cached tiles this frame.
+   *
+   * See {@link TilesetOptions::tileCacheUnloadTimeLimit}.
+   */
+  double tileCacheUnloadTime = 0.0;
+
+  /**
+   * @brief The time, in milliseconds, spent updating level-of-detail
+   * transitions this frame.
+   */
+  double lodTransitionTime = 0.0;
+
+  /**
+   * @brief The number of bytes of tile data that finished loading this frame.
+   *
+   * This is the growth of {@link Tileset::getTotalDataBytes} during the frame,
+   * not counting the bytes freed by unloading cached tiles.
+   */
+  int64_t bytesLoaded = 0;
+
+  /**
+   * @brief The number of bytes of tile data freed by unloading cached tiles
+   * this frame.
+   */
+  int64_t bytesFreed = 0;
+
+  /**
+   * @brief The time, in milliseconds, from the most recent change of the views
+   * until the end of this frame, if this is the first frame since that change
+   * in which no more tiles were needed for the views. In every other frame,
+   * this is `std::nullopt`.
+   *
+   * A frame whose views differ from the ones of the most recent view change
+   * by more than {@link TilesetOptions::cachedTraversalPositionTolerance} or
+   * {@link TilesetOptions::cachedTraversalDirectionTolerance} is a view
+   * change, so while the camera moves, this measures from the frame in which
+   * it stopped. The first views are measured from the construction of the
+   * tileset. See {@link Tileset::getLoadTimings}.
+   */
+  std::optional<double> timeToFullDetail;
+
   //! @cond Doxygen_Suppress
   uint32_t tilesVisited = 0;
   uint32_t culledTilesVisited = 0;
@@ -237,4 +237,37 @@ getOrientedBoundingBoxFromBoundingVolume(const BoundingVolume& boundingVolume) {
   return std::visit(Operation(), boundingVolume);
 }
 
+bool packBoundingVolume(
+    const BoundingVolume& boundingVolume,
+    PackedBoundingVolumes& packed) {
+  struct Operation {
+    PackedBoundingVolumes& packed;
+
+    bool operator()(const BoundingSphere& sphere) {
+      packed.addBoundingSphere(sphere);
+      return true;
+    }
+
+    bool operator()(const OrientedBoundingBox& box) {
+      packed.addOrientedBoundingBox(box);
+      return true;
+    }
+
+    bool operator()(const BoundingRegion& region) {
+      packed.addOrientedBoundingBox(region.getBoundingBox());
+      return true;
+    }
+
+    bool operator()(const BoundingRegionWithLooseFittingHeights& region) {
+      packed.addOrientedBoundingBox(
+          region.getBoundingRegion().getBoundingBox());
+      return true;
+    }
+
+    bool operator()(const S2CellBoundingVolume& /* s2Cell */) { return false; }
+  };
+
+  return std::visit(Operation{packed}, boundingVolume);
+}
+
 } // namespace Cesium3DTilesSelection
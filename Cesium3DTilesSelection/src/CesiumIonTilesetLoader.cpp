@@ -5,11 +5,18 @@
 
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumUtility/ErrorList.h>
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Uri.h>
 
+#include <modp_b64.h>
 #include <rapidjson/document.h>
 
+#include <ctime>
+#include <limits>
+#include <optional>
 #include <unordered_map>
 
 namespace Cesium3DTilesSelection {
@@ -24,9 +31,34 @@ struct AssetEndpoint {
   std::string url;
   std::string accessToken;
   std::vector<AssetEndpointAttribution> attributions;
+
+  // The time at which the access token expires, or the maximum time if it is
+  // not known to expire.
+  std::time_t expiryTime = std::numeric_limits<std::time_t>::max();
+};
+
+// The result of getting an asset endpoint, either from Cesium ion or from a
+// cache.
+struct AssetEndpointResult {
+  std::optional<AssetEndpoint> endpoint;
+  CesiumUtility::ErrorList errors;
+  uint16_t statusCode = 200;
+
+  // Whether the endpoint came from a cache, in which case its access token may
+  // have been revoked since it was received.
+  bool fromCache = false;
 };
 
+// An endpoint is requested again this long before its access token expires,
+// so that tile requests don't fail because of an expired token.
+constexpr std::time_t ENDPOINT_REFRESH_MARGIN_SECONDS = 5 * 60;
+
+// The endpoints that have been received, and the requests for endpoints that
+// are in progress, by the URL of their request. These are only accessed from
+// the main thread, and are shared by all tilesets.
 std::unordered_map<std::string, AssetEndpoint> endpointCache;
+std::unordered_map<std::string, CesiumAsync::SharedFuture<AssetEndpointResult>>
+    endpointRequests;
 
 std::string createEndpointResource(
     int64_t ionAssetID,
@@ -40,37 +72,310 @@ std::string createEndpointResource(
   return ionUrl;
 }
 
+bool isExpiring(std::time_t expiryTime) {
+  return expiryTime != std::numeric_limits<std::time_t>::max() &&
+         std::time(nullptr) >= expiryTime - ENDPOINT_REFRESH_MARGIN_SECONDS;
+}
+
+/**
+ * @brief Gets the time at which an access token expires, from the `exp` claim
+ * of the JSON Web Token.
+ *
+ * @param accessToken The access token.
+ * @return The expiry time, or the maximum time if the token is not a JSON Web
+ * Token with an expiry time.
+ */
+std::time_t getTokenExpiryTime(const std::string& accessToken) {
+  constexpr std::time_t never = std::numeric_limits<std::time_t>::max();
+
+  const size_t payloadStart = accessToken.find('.');
+  if (payloadStart == std::string::npos) {
+    return never;
+  }
+
+  const size_t payloadEnd = accessToken.find('.', payloadStart + 1);
+  if (payloadEnd == std::string::npos || payloadEnd == payloadStart + 1) {
+    return never;
+  }
+
+  // The payload is unpadded Base64url, so convert it to the Base64 that
+  // modp_b64_decode expects.
+  std::string encoded =
+      accessToken.substr(payloadStart + 1, payloadEnd - payloadStart - 1);
+  for (char& c : encoded) {
+    if (c == '-') {
+      c = '+';
+    } else if (c == '_') {
+      c = '/';
+    }
+  }
+  encoded.resize((encoded.size() + 3) / 4 * 4, '=');
+
+  std::string decoded(modp_b64_decode_len(encoded.size()), '\0');
+  const size_t decodedLength =
+      modp_b64_decode(decoded.data(), encoded.data(), encoded.size());
+  if (decodedLength == 0 || decodedLength == std::string::npos) {
+    return never;
+  }
+
+  rapidjson::Document payload;
+  payload.Parse(decoded.data(), decodedLength);
+  if (payload.HasParseError() || !payload.IsObject()) {
+    return never;
+  }
+
+  const int64_t expiryTime =
+      CesiumUtility::JsonHelpers::getInt64OrDefault(payload, "exp", -1);
+  return expiryTime >= 0 ? std::time_t(expiryTime) : never;
+}
+
 /**
- * @brief Tries to obtain the `accessToken` from the JSON of the
- * given response.
+ * @brief Parses the response to an endpoint request.
  *
- * @param pIonResponse The response
- * @return The access token if successful
+ * @param requestUrl The URL of the request.
+ * @param statusCode The status code of the response.
+ * @param data The data of the response.
+ * @return The endpoint, or the errors that prevented it from being parsed.
  */
-std::optional<std::string> getNewAccessToken(
-    const CesiumAsync::IAssetResponse* pIonResponse,
-    const std::shared_ptr<spdlog::logger>& pLogger) {
-  const gsl::span<const std::byte> data = pIonResponse->data();
+AssetEndpointResult parseAssetEndpoint(
+    const std::string& requestUrl,
+    uint16_t statusCode,
+    const gsl::span<const std::byte>& data) {
+  AssetEndpointResult result;
+  result.statusCode = statusCode;
+  if (statusCode < 200 || statusCode >= 300) {
+    result.errors.emplaceError(fmt::format(
+        "Received status code {} for asset response {}",
+        statusCode,
+        requestUrl));
+    return result;
+  }
+
   rapidjson::Document ionResponse;
   ionResponse.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
   if (ionResponse.HasParseError()) {
-    SPDLOG_LOGGER_ERROR(
-        pLogger,
-        "Error when parsing Cesium ion response, error code {} at byte offset "
-        "{}",
+    result.errors.emplaceError(fmt::format(
+        "Error when parsing Cesium ion response JSON, error code {} at byte "
+        "offset {}",
         ionResponse.GetParseError(),
-        ionResponse.GetErrorOffset());
-    return std::nullopt;
+        ionResponse.GetErrorOffset()));
+    return result;
   }
-  return CesiumUtility::JsonHelpers::getStringOrDefault(
+
+  AssetEndpoint& endpoint = result.endpoint.emplace();
+  const auto attributionsIt = ionResponse.FindMember("attributions");
+  if (attributionsIt != ionResponse.MemberEnd() &&
+      attributionsIt->value.IsArray()) {
+
+    for (const rapidjson::Value& attribution :
+         attributionsIt->value.GetArray()) {
+      AssetEndpointAttribution& endpointAttribution =
+          endpoint.attributions.emplace_back();
+      const auto html = attribution.FindMember("html");
+      if (html != attribution.MemberEnd() && html->value.IsString()) {
+        endpointAttribution.html = html->value.GetString();
+      }
+      auto collapsible = attribution.FindMember("collapsible");
+      if (collapsible != attribution.MemberEnd() &&
+          collapsible->value.IsBool()) {
+        endpointAttribution.collapsible = collapsible->value.GetBool();
+      }
+    }
+  }
+
+  endpoint.type =
+      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "type", "");
+  endpoint.url =
+      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "url", "");
+  endpoint.accessToken = CesiumUtility::JsonHelpers::getStringOrDefault(
       ionResponse,
       "accessToken",
       "");
+  endpoint.expiryTime = getTokenExpiryTime(endpoint.accessToken);
+
+  std::string externalType = CesiumUtility::JsonHelpers::getStringOrDefault(
+      ionResponse,
+      "externalType",
+      "");
+  if (!externalType.empty()) {
+    endpoint.type = externalType;
+    const auto optionsIt = ionResponse.FindMember("options");
+    if (optionsIt != ionResponse.MemberEnd() && optionsIt->value.IsObject()) {
+      endpoint.url = CesiumUtility::JsonHelpers::getStringOrDefault(
+          optionsIt->value,
+          "url",
+          endpoint.url);
+    }
+  }
+
+  if (endpoint.type == "TERRAIN") {
+    // For terrain resources, we need to append `/layer.json` to the end of
+    // the URL.
+    endpoint.url =
+        CesiumUtility::Uri::resolve(endpoint.url, "layer.json", true);
+  }
+
+  return result;
+}
+
+CesiumAsync::Future<AssetEndpointResult> requestAssetEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache,
+    const std::string& ionUrl) {
+  return pAssetAccessor->get(asyncSystem, ionUrl)
+      .thenInWorkerThread(
+          [pEndpointCache,
+           ionUrl](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
+            if (!pResponse) {
+              AssetEndpointResult result;
+              result.errors.emplaceError(fmt::format(
+                  "No response received for asset request {}",
+                  pRequest->url()));
+              return result;
+            }
+
+            AssetEndpointResult result = parseAssetEndpoint(
+                pRequest->url(),
+                pResponse->statusCode(),
+                pResponse->data());
+
+            // Only endpoints whose tokens are known to expire are kept across
+            // sessions, so that a cached token is never used after it expires.
+            if (pEndpointCache && result.endpoint &&
+                result.endpoint->expiryTime !=
+                    std::numeric_limits<std::time_t>::max()) {
+              pEndpointCache->storeEntry(
+                  ionUrl,
+                  result.endpoint->expiryTime,
+                  pRequest->url(),
+                  pRequest->method(),
+                  pRequest->headers(),
+                  pResponse->statusCode(),
+                  pResponse->headers(),
+                  pResponse->data());
+            }
+
+            return result;
+          });
+}
+
+CesiumAsync::Future<AssetEndpointResult> loadAssetEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache,
+    const std::string& ionUrl,
+    bool useCache) {
+  if (!useCache || !pEndpointCache) {
+    return requestAssetEndpoint(
+        asyncSystem,
+        pAssetAccessor,
+        pEndpointCache,
+        ionUrl);
+  }
+
+  return asyncSystem
+      .runInWorkerThread(
+          [pEndpointCache, ionUrl]() -> std::optional<AssetEndpoint> {
+            std::optional<CesiumAsync::CacheItem> maybeCacheItem =
+                pEndpointCache->getEntry(ionUrl);
+            if (!maybeCacheItem) {
+              return std::nullopt;
+            }
+
+            AssetEndpointResult cached = parseAssetEndpoint(
+                ionUrl,
+                maybeCacheItem->cacheResponse.statusCode,
+                maybeCacheItem->cacheResponse.data);
+            if (!cached.endpoint || isExpiring(cached.endpoint->expiryTime)) {
+              return std::nullopt;
+            }
+
+            return std::move(cached.endpoint);
+          })
+      .thenInMainThread(
+          [asyncSystem, pAssetAccessor, pEndpointCache, ionUrl](
+              std::optional<AssetEndpoint>&& maybeEndpoint) {
+            if (maybeEndpoint) {
+              AssetEndpointResult result;
+              result.endpoint = std::move(maybeEndpoint);
+              result.fromCache = true;
+              return asyncSystem.createResolvedFuture(std::move(result));
+            }
+
+            return requestAssetEndpoint(
+                asyncSystem,
+                pAssetAccessor,
+                pEndpointCache,
+                ionUrl);
+          });
+}
+
+/**
+ * @brief Gets an asset endpoint, from the endpoints that have already been
+ * received if possible. Must be called from the main thread.
+ *
+ * Only one request is made at a time for each endpoint, and its result is
+ * shared by everything that gets the endpoint while it is in progress.
+ *
+ * @param useCache Whether an endpoint that has already been received may be
+ * used. If false, the endpoint is requested from Cesium ion, unless a request
+ * for it is already in progress.
+ */
+CesiumAsync::Future<AssetEndpointResult> getAssetEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache,
+    const std::string& ionUrl,
+    bool useCache) {
+  if (useCache) {
+    auto cacheIt = endpointCache.find(ionUrl);
+    if (cacheIt != endpointCache.end() &&
+        !isExpiring(cacheIt->second.expiryTime)) {
+      AssetEndpointResult result;
+      result.endpoint = cacheIt->second;
+      result.fromCache = true;
+      return asyncSystem.createResolvedFuture(std::move(result));
+    }
+  }
+
+  auto copyResult = [](const AssetEndpointResult& result) { return result; };
+
+  auto requestIt = endpointRequests.find(ionUrl);
+  if (requestIt == endpointRequests.end()) {
+    CesiumAsync::SharedFuture<AssetEndpointResult> future =
+        loadAssetEndpoint(
+            asyncSystem,
+            pAssetAccessor,
+            pEndpointCache,
+            ionUrl,
+            useCache)
+            .thenInMainThread([ionUrl](AssetEndpointResult&& result) {
+              endpointRequests.erase(ionUrl);
+              if (result.endpoint) {
+                endpointCache[ionUrl] = *result.endpoint;
+              }
+              return std::move(result);
+            })
+            .share();
+
+    // The endpoint may have been found in the cache right away.
+    if (future.isReady()) {
+      return future.thenImmediately(copyResult);
+    }
+
+    requestIt = endpointRequests.emplace(ionUrl, std::move(future)).first;
+  }
+
+  return requestIt->second.thenImmediately(copyResult);
 }
 
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
 mainThreadLoadTilesetJsonFromAssetEndpoint(
     const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
     const AssetEndpoint& endpoint,
     int64_t ionAssetID,
     std::string ionAccessToken,
@@ -97,9 +402,13 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
   return TilesetJsonLoader::createLoader(
              externals,
              endpoint.url,
-             requestHeaders)
+             requestHeaders,
+             contentOptions.createExplicitTileChildrenOnDemand)
       .thenImmediately([credits = std::move(credits),
                         requestHeaders,
+                        endpointAccessToken = endpoint.accessToken,
+                        tokenExpiryTime = endpoint.expiryTime,
+                        pEndpointCache = externals.pIonEndpointCache,
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
@@ -122,7 +431,10 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
               std::move(tilesetJsonResult.pLoader),
-              std::move(headerChangeListener));
+              std::move(headerChangeListener),
+              std::move(endpointAccessToken),
+              tokenExpiryTime,
+              pEndpointCache);
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
           result.credits = std::move(tilesetJsonResult.credits);
           result.requestHeaders = std::move(requestHeaders);
@@ -170,6 +482,9 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
              requestHeaders)
       .thenImmediately([credits = std::move(credits),
                         requestHeaders,
+                        endpointAccessToken = endpoint.accessToken,
+                        tokenExpiryTime = endpoint.expiryTime,
+                        pEndpointCache = externals.pIonEndpointCache,
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
@@ -192,7 +507,10 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
               std::move(tilesetJsonResult.pLoader),
-              std::move(headerChangeListener));
+              std::move(headerChangeListener),
+              std::move(endpointAccessToken),
+              tokenExpiryTime,
+              pEndpointCache);
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
           result.credits = std::move(tilesetJsonResult.credits);
           result.requestHeaders = std::move(requestHeaders);
@@ -204,134 +522,81 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
 }
 
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
-mainThreadHandleEndpointResponse(
+mainThreadLoadFromAssetEndpoint(
     const TilesetExternals& externals,
-    std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest,
-    int64_t ionAssetID,
-    std::string&& ionAccessToken,
-    std::string&& ionAssetEndpointUrl,
     const TilesetContentOptions& contentOptions,
-    CesiumIonTilesetLoader::AuthorizationHeaderChangeListener&&
+    AssetEndpointResult&& endpointResult,
+    int64_t ionAssetID,
+    const std::string& ionAccessToken,
+    const std::string& ionAssetEndpointUrl,
+    const CesiumIonTilesetLoader::AuthorizationHeaderChangeListener&
         headerChangeListener,
     bool showCreditsOnScreen) {
-  const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
-  const std::string& requestUrl = pRequest->url();
-  if (!pResponse) {
+  if (!endpointResult.endpoint) {
     TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(
-        fmt::format("No response received for asset request {}", requestUrl));
+    result.errors = std::move(endpointResult.errors);
+    result.statusCode = endpointResult.statusCode;
     return externals.asyncSystem.createResolvedFuture(std::move(result));
   }
 
-  uint16_t statusCode = pResponse->statusCode();
-  if (statusCode < 200 || statusCode >= 300) {
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Received status code {} for asset response {}",
-        statusCode,
-        requestUrl));
-    result.statusCode = statusCode;
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
-  }
-
-  const gsl::span<const std::byte> data = pResponse->data();
+  const AssetEndpoint& endpoint = *endpointResult.endpoint;
 
-  rapidjson::Document ionResponse;
-  ionResponse.Parse(reinterpret_cast<const char*>(data.data()), data.size());
-
-  if (ionResponse.HasParseError()) {
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Error when parsing Cesium ion response JSON, error code {} at byte "
-        "offset {}",
-        ionResponse.GetParseError(),
-        ionResponse.GetErrorOffset()));
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
-  }
-
-  AssetEndpoint endpoint;
-  if (externals.pCreditSystem) {
-    const auto attributionsIt = ionResponse.FindMember("attributions");
-    if (attributionsIt != ionResponse.MemberEnd() &&
-        attributionsIt->value.IsArray()) {
-
-      for (const rapidjson::Value& attribution :
-           attributionsIt->value.GetArray()) {
-        AssetEndpointAttribution& endpointAttribution =
-            endpoint.attributions.emplace_back();
-        const auto html = attribution.FindMember("html");
-        if (html != attribution.MemberEnd() && html->value.IsString()) {
-          endpointAttribution.html = html->value.GetString();
-        }
-        auto collapsible = attribution.FindMember("collapsible");
-        if (collapsible != attribution.MemberEnd() &&
-            collapsible->value.IsBool()) {
-          endpointAttribution.collapsible = collapsible->value.GetBool();
+  CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
+      future = [&]() {
+        if (endpoint.type == "TERRAIN") {
+          return mainThreadLoadLayerJsonFromAssetEndpoint(
+              externals,
+              contentOptions,
+              endpoint,
+              ionAssetID,
+              ionAccessToken,
+              ionAssetEndpointUrl,
+              headerChangeListener,
+              showCreditsOnScreen);
+        } else if (endpoint.type == "3DTILES") {
+          return mainThreadLoadTilesetJsonFromAssetEndpoint(
+              externals,
+              contentOptions,
+              endpoint,
+              ionAssetID,
+              ionAccessToken,
+              ionAssetEndpointUrl,
+              headerChangeListener,
+              showCreditsOnScreen);
         }
-      }
-    }
-  }
-
-  std::string type =
-      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "type", "");
-  std::string url =
-      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "url", "");
-  std::string accessToken = CesiumUtility::JsonHelpers::getStringOrDefault(
-      ionResponse,
-      "accessToken",
-      "");
-  std::string externalType = CesiumUtility::JsonHelpers::getStringOrDefault(
-      ionResponse,
-      "externalType",
-      "");
-
-  if (!externalType.empty()) {
-    type = externalType;
-    const auto optionsIt = ionResponse.FindMember("options");
-    if (optionsIt != ionResponse.MemberEnd() && optionsIt->value.IsObject()) {
-      url = CesiumUtility::JsonHelpers::getStringOrDefault(
-          optionsIt->value,
-          "url",
-          url);
-    }
-  }
 
-  if (type == "TERRAIN") {
-    // For terrain resources, we need to append `/layer.json` to the end of
-    // the URL.
-    url = CesiumUtility::Uri::resolve(url, "layer.json", true);
-    endpoint.type = type;
-    endpoint.url = url;
-    endpoint.accessToken = accessToken;
-    endpointCache[requestUrl] = endpoint;
-    return mainThreadLoadLayerJsonFromAssetEndpoint(
-        externals,
-        contentOptions,
-        endpoint,
-        ionAssetID,
-        std::move(ionAccessToken),
-        std::move(ionAssetEndpointUrl),
-        std::move(headerChangeListener),
-        showCreditsOnScreen);
-  } else if (type == "3DTILES") {
-    endpoint.type = type;
-    endpoint.url = url;
-    endpoint.accessToken = accessToken;
-    endpointCache[requestUrl] = endpoint;
-    return mainThreadLoadTilesetJsonFromAssetEndpoint(
-        externals,
-        endpoint,
-        ionAssetID,
-        std::move(ionAccessToken),
-        std::move(ionAssetEndpointUrl),
-        std::move(headerChangeListener),
-        showCreditsOnScreen);
+        TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
+        result.errors.emplaceError(fmt::format(
+            "Received unsupported asset response type: {}",
+            endpoint.type));
+        return externals.asyncSystem.createResolvedFuture(std::move(result));
+      }();
+
+  if (!endpointResult.fromCache) {
+    return future;
   }
 
-  TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-  result.errors.emplaceError(
-      fmt::format("Received unsupported asset response type: {}", type));
-  return externals.asyncSystem.createResolvedFuture(std::move(result));
+  // The cached access token may have been revoked, so request the endpoint
+  // again if it's rejected.
+  return std::move(future).thenInMainThread(
+      [externals,
+       contentOptions,
+       ionAssetID,
+       ionAccessToken,
+       ionAssetEndpointUrl,
+       headerChangeListener,
+       showCreditsOnScreen](
+          TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
+        return CesiumIonTilesetLoader::refreshTokenIfNeeded(
+            externals,
+            contentOptions,
+            ionAssetID,
+            ionAccessToken,
+            ionAssetEndpointUrl,
+            headerChangeListener,
+            showCreditsOnScreen,
+            std::move(result));
+      });
 }
 } // namespace
 
@@ -342,13 +607,19 @@ CesiumIonTilesetLoader::CesiumIonTilesetLoader(
     std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
     std::function<
         void(const std::string& header, const std::string& headerValue)>&&
-        headerChangeListener)
+        headerChangeListener,
+    std::string&& endpointAccessToken,
+    std::time_t tokenExpiryTime,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache)
     : _refreshTokenState{TokenRefreshState::None},
       _ionAssetID{ionAssetID},
       _ionAccessToken{std::move(ionAccessToken)},
       _ionAssetEndpointUrl{std::move(ionAssetEndpointUrl)},
       _pAggregatedLoader{std::move(pAggregatedLoader)},
-      _headerChangeListener{std::move(headerChangeListener)} {}
+      _headerChangeListener{std::move(headerChangeListener)},
+      _endpointAccessToken{std::move(endpointAccessToken)},
+      _tokenExpiryTime{tokenExpiryTime},
+      _pEndpointCache{pEndpointCache} {}
 
 CesiumAsync::Future<TileLoadResult>
 CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
@@ -364,13 +635,23 @@ CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
   const auto& pAssetAccessor = loadInput.pAssetAccessor;
   const auto& pLogger = loadInput.pLogger;
 
+  // Get a new token before this one expires, while tiles keep loading with
+  // this one.
+  if (isExpiring(this->_tokenExpiryTime)) {
+    this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem, false);
+  }
+
   // TODO: the way this is structured, requests already in progress
   // with the old key might complete after the key has been updated,
   // and there's nothing here clever enough to avoid refreshing the
   // key _again_ in that instance.
   auto refreshTokenInMainThread =
       [this, pLogger, pAssetAccessor, asyncSystem]() {
-        this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem);
+        this->refreshTokenInMainThread(
+            pLogger,
+            pAssetAccessor,
+            asyncSystem,
+            true);
       };
 
   return this->_pAggregatedLoader->loadTileContent(loadInput).thenImmediately(
@@ -397,53 +678,91 @@ CesiumIonTilesetLoader::createTileChildren(const Tile& tile) {
   return pLoader->createTileChildren(tile);
 }
 
+bool CesiumIonTilesetLoader::releaseTileChildren(const Tile& tile) {
+  auto pLoader = tile.getLoader();
+  return pLoader->releaseTileChildren(tile);
+}
+
+int64_t CesiumIonTilesetLoader::getLoaderDataBytes() const noexcept {
+  return this->_pAggregatedLoader->getLoaderDataBytes();
+}
+
+void CesiumIonTilesetLoader::unloadLoaderData(int64_t maximumBytes) {
+  this->_pAggregatedLoader->unloadLoaderData(maximumBytes);
+}
+
 void CesiumIonTilesetLoader::refreshTokenInMainThread(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
-    const CesiumAsync::AsyncSystem& asyncSystem) {
-  if (this->_refreshTokenState == TokenRefreshState::Loading) {
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    bool tokenRejected) {
+  if (this->_refreshTokenState == TokenRefreshState::Refreshing &&
+      tokenRejected) {
+    // The token is already being refreshed, but now tiles must wait for it.
+    this->_refreshTokenState = TokenRefreshState::Loading;
     return;
   }
 
-  this->_refreshTokenState = TokenRefreshState::Loading;
+  if (this->_refreshTokenState == TokenRefreshState::Loading ||
+      this->_refreshTokenState == TokenRefreshState::Refreshing) {
+    return;
+  }
 
   std::string url = createEndpointResource(
       this->_ionAssetID,
       this->_ionAccessToken,
       this->_ionAssetEndpointUrl);
-  pAssetAccessor->get(asyncSystem, url)
-      .thenInMainThread(
-          [this,
-           pLogger](std::shared_ptr<CesiumAsync::IAssetRequest>&& pIonRequest) {
-            const CesiumAsync::IAssetResponse* pIonResponse =
-                pIonRequest->response();
-
-            if (!pIonResponse) {
-              this->_refreshTokenState = TokenRefreshState::Failed;
-              return;
-            }
 
-            uint16_t statusCode = pIonResponse->statusCode();
-            if (statusCode >= 200 && statusCode < 300) {
-              auto accessToken = getNewAccessToken(pIonResponse, pLogger);
-              if (accessToken) {
-                this->_headerChangeListener(
-                    "Authorization",
-                    "Bearer " + *accessToken);
-
-                // update cache with new access token
-                auto cacheIt = endpointCache.find(pIonRequest->url());
-                if (cacheIt != endpointCache.end()) {
-                  cacheIt->second.accessToken = accessToken.value();
-                }
-
-                this->_refreshTokenState = TokenRefreshState::Done;
-                return;
-              }
-            }
+  // Another tileset using the same asset may have already refreshed the token.
+  auto cacheIt = endpointCache.find(url);
+  if (cacheIt != endpointCache.end() &&
+      cacheIt->second.accessToken != this->_endpointAccessToken &&
+      !isExpiring(cacheIt->second.expiryTime)) {
+    this->updateAccessToken(
+        cacheIt->second.accessToken,
+        cacheIt->second.expiryTime);
+    this->_refreshTokenState = TokenRefreshState::Done;
+    return;
+  }
 
-            this->_refreshTokenState = TokenRefreshState::Failed;
-          });
+  this->_refreshTokenState = tokenRejected ? TokenRefreshState::Loading
+                                           : TokenRefreshState::Refreshing;
+
+  getAssetEndpoint(
+      asyncSystem,
+      pAssetAccessor,
+      this->_pEndpointCache,
+      url,
+      false)
+      .thenInMainThread([this, pLogger](AssetEndpointResult&& result) {
+        if (result.endpoint && !result.endpoint->accessToken.empty()) {
+          this->updateAccessToken(
+              result.endpoint->accessToken,
+              result.endpoint->expiryTime);
+          this->_refreshTokenState = TokenRefreshState::Done;
+          return;
+        }
+
+        result.errors.logError(
+            pLogger,
+            "Failed to refresh the Cesium ion access token");
+        if (this->_refreshTokenState == TokenRefreshState::Refreshing) {
+          // The current token still works, so keep using it, and don't try to
+          // refresh it again until it's rejected.
+          this->_tokenExpiryTime = std::numeric_limits<std::time_t>::max();
+          this->_refreshTokenState = TokenRefreshState::Done;
+        } else {
+          this->_refreshTokenState = TokenRefreshState::Failed;
+        }
+      });
+}
+
+void CesiumIonTilesetLoader::updateAccessToken(
+    const std::string& accessToken,
+    std::time_t expiryTime) {
+  this->_headerChangeListener("Authorization", "Bearer " + accessToken);
+  this->_endpointAccessToken = accessToken;
+  this->_tokenExpiryTime = expiryTime;
 }
 
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
@@ -457,96 +776,32 @@ CesiumIonTilesetLoader::createLoader(
     bool showCreditsOnScreen) {
   std::string ionUrl =
       createEndpointResource(ionAssetID, ionAccessToken, ionAssetEndpointUrl);
-  auto cacheIt = endpointCache.find(ionUrl);
-  if (cacheIt != endpointCache.end()) {
-    const auto& endpoint = cacheIt->second;
-    if (endpoint.type == "TERRAIN") {
-      return mainThreadLoadLayerJsonFromAssetEndpoint(
-                 externals,
-                 contentOptions,
-                 endpoint,
-                 ionAssetID,
-                 ionAccessToken,
-                 ionAssetEndpointUrl,
-                 headerChangeListener,
-                 showCreditsOnScreen)
-          .thenInMainThread(
-              [externals,
-               contentOptions,
-               ionAssetID,
-               ionAccessToken,
-               ionAssetEndpointUrl,
-               headerChangeListener,
-               showCreditsOnScreen](
-                  TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
-                return refreshTokenIfNeeded(
-                    externals,
-                    contentOptions,
-                    ionAssetID,
-                    ionAccessToken,
-                    ionAssetEndpointUrl,
-                    headerChangeListener,
-                    showCreditsOnScreen,
-                    std::move(result));
-              });
-    } else if (endpoint.type == "3DTILES") {
-      return mainThreadLoadTilesetJsonFromAssetEndpoint(
-                 externals,
-                 endpoint,
-                 ionAssetID,
-                 ionAccessToken,
-                 ionAssetEndpointUrl,
-                 headerChangeListener,
-                 showCreditsOnScreen)
-          .thenInMainThread(
-              [externals,
-               contentOptions,
-               ionAssetID,
-               ionAccessToken,
-               ionAssetEndpointUrl,
-               headerChangeListener,
-               showCreditsOnScreen](
-                  TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
-                return refreshTokenIfNeeded(
-                    externals,
-                    contentOptions,
-                    ionAssetID,
-                    ionAccessToken,
-                    ionAssetEndpointUrl,
-                    headerChangeListener,
-                    showCreditsOnScreen,
-                    std::move(result));
-              });
-    }
-
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Received unsupported asset response type: {}",
-        endpoint.type));
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
-  } else {
-    return externals.pAssetAccessor->get(externals.asyncSystem, ionUrl)
-        .thenInMainThread(
-            [externals,
-             ionAssetID,
-             ionAccessToken = ionAccessToken,
-             ionAssetEndpointUrl = ionAssetEndpointUrl,
-             headerChangeListener = headerChangeListener,
-             showCreditsOnScreen,
-             contentOptions](std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                 pRequest) mutable {
-              return mainThreadHandleEndpointResponse(
-                  externals,
-                  std::move(pRequest),
-                  ionAssetID,
-                  std::move(ionAccessToken),
-                  std::move(ionAssetEndpointUrl),
-                  contentOptions,
-                  std::move(headerChangeListener),
-                  showCreditsOnScreen);
-            });
-  }
+  return getAssetEndpoint(
+             externals.asyncSystem,
+             externals.pAssetAccessor,
+             externals.pIonEndpointCache,
+             ionUrl,
+             true)
+      .thenInMainThread(
+          [externals,
+           contentOptions,
+           ionAssetID,
+           ionAccessToken,
+           ionAssetEndpointUrl,
+           headerChangeListener,
+           showCreditsOnScreen](AssetEndpointResult&& endpointResult) {
+            return mainThreadLoadFromAssetEndpoint(
+                externals,
+                contentOptions,
+                std::move(endpointResult),
+                ionAssetID,
+                ionAccessToken,
+                ionAssetEndpointUrl,
+                headerChangeListener,
+                showCreditsOnScreen);
+          });
 }
+
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
 CesiumIonTilesetLoader::refreshTokenIfNeeded(
     const TilesetExternals& externals,
@@ -559,18 +814,37 @@ CesiumIonTilesetLoader::refreshTokenIfNeeded(
     TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
   if (result.errors.hasErrors()) {
     if (result.statusCode == 401) {
-      endpointCache.erase(createEndpointResource(
-          ionAssetID,
-          ionAccessToken,
-          ionAssetEndpointUrl));
-      return CesiumIonTilesetLoader::createLoader(
-          externals,
-          contentOptions,
+      std::string ionUrl = createEndpointResource(
           ionAssetID,
           ionAccessToken,
-          ionAssetEndpointUrl,
-          headerChangeListener,
-          showCreditsOnScreen);
+          ionAssetEndpointUrl);
+      endpointCache.erase(ionUrl);
+      return getAssetEndpoint(
+                 externals.asyncSystem,
+                 externals.pAssetAccessor,
+                 externals.pIonEndpointCache,
+                 ionUrl,
+                 false)
+          .thenInMainThread(
+              [externals,
+               contentOptions,
+               ionAssetID,
+               ionAccessToken,
+               ionAssetEndpointUrl,
+               headerChangeListener,
+               showCreditsOnScreen](AssetEndpointResult&& endpointResult) {
+                // Don't retry again if the new token is rejected, too.
+                endpointResult.fromCache = false;
+                return mainThreadLoadFromAssetEndpoint(
+                    externals,
+                    contentOptions,
+                    std::move(endpointResult),
+                    ionAssetID,
+                    ionAccessToken,
+                    ionAssetEndpointUrl,
+                    headerChangeListener,
+                    showCreditsOnScreen);
+              });
     }
   }
   return externals.asyncSystem.createResolvedFuture(std::move(result));
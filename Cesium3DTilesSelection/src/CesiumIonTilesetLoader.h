@@ -5,12 +5,20 @@
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 
+#include <ctime>
 #include <functional>
+#include <memory>
 #include <string>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace Cesium3DTilesSelection {
 class CesiumIonTilesetLoader : public TilesetContentLoader {
-  enum class TokenRefreshState { None, Loading, Done, Failed };
+  // Tiles wait for the token while it's Loading, but not while it's
+  // Refreshing, which happens shortly before the current token expires.
+  enum class TokenRefreshState { None, Loading, Refreshing, Done, Failed };
 
 public:
   using AuthorizationHeaderChangeListener = std::function<
@@ -21,13 +29,22 @@ public:
       std::string&& ionAccessToken,
       std::string&& ionAssetEndpointUrl,
       std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
-      AuthorizationHeaderChangeListener&& headerChangeListener);
+      AuthorizationHeaderChangeListener&& headerChangeListener,
+      std::string&& endpointAccessToken,
+      std::time_t tokenExpiryTime,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache);
 
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  bool releaseTileChildren(const Tile& tile) override;
+
+  int64_t getLoaderDataBytes() const noexcept override;
+
+  void unloadLoaderData(int64_t maximumBytes) override;
+
   static CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
   createLoader(
       const TilesetExternals& externals,
@@ -53,7 +70,11 @@ private:
   void refreshTokenInMainThread(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
-      const CesiumAsync::AsyncSystem& asyncSystem);
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      bool tokenRejected);
+
+  void
+  updateAccessToken(const std::string& accessToken, std::time_t expiryTime);
 
   TokenRefreshState _refreshTokenState;
   int64_t _ionAssetID;
@@ -61,5 +82,8 @@ private:
   std::string _ionAssetEndpointUrl;
   std::unique_ptr<TilesetContentLoader> _pAggregatedLoader;
   AuthorizationHeaderChangeListener _headerChangeListener;
+  std::string _endpointAccessToken;
+  std::time_t _tokenExpiryTime;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pEndpointCache;
 };
 } // namespace Cesium3DTilesSelection
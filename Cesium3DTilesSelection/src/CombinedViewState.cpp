@@ -0,0 +1,154 @@
+#include "CombinedViewState.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// The tangent of the largest half-angle of a combined frustum. Views that need
+// a wider frustum are too different to be worth combining.
+constexpr double maximumTangent = 20.0;
+
+// Widens the combined frustum slightly, so that rounding doesn't cull a tile
+// that touches the frustum of one of the views.
+constexpr double tangentMargin = 1.0 + 1e-6;
+
+} // namespace
+
+/*static*/ std::optional<CombinedViewState>
+CombinedViewState::create(const std::vector<ViewState>& frustums) {
+  if (frustums.size() < 2) {
+    return std::nullopt;
+  }
+
+  glm::dvec3 center(0.0);
+  glm::dvec3 direction(0.0);
+  glm::dvec3 up(0.0);
+  for (const ViewState& frustum : frustums) {
+    center += frustum.getPosition();
+    direction += frustum.getDirection();
+    up += frustum.getUp();
+  }
+  center /= double(frustums.size());
+
+  const double directionLength = glm::length(direction);
+  if (directionLength < Math::Epsilon5) {
+    return std::nullopt;
+  }
+  direction /= directionLength;
+
+  up -= direction * glm::dot(up, direction);
+  const double upLength = glm::length(up);
+  if (upLength < Math::Epsilon5) {
+    return std::nullopt;
+  }
+  up /= upLength;
+
+  const glm::dvec3 right = glm::cross(direction, up);
+
+  // The combined frustum must contain the directions of the edges of every
+  // view's frustum, which are the directions toward the corners of its near
+  // plane.
+  double tangentX = 0.0;
+  double tangentY = 0.0;
+  for (const ViewState& frustum : frustums) {
+    const glm::dvec3& viewDirection = frustum.getDirection();
+    const glm::dvec3& viewUp = frustum.getUp();
+    const glm::dvec3 viewRight = glm::cross(viewDirection, viewUp);
+    const double viewTangentX =
+        glm::tan(0.5 * frustum.getHorizontalFieldOfView());
+    const double viewTangentY =
+        glm::tan(0.5 * frustum.getVerticalFieldOfView());
+
+    for (const double x : {-viewTangentX, viewTangentX}) {
+      for (const double y : {-viewTangentY, viewTangentY}) {
+        const glm::dvec3 edge = viewDirection + x * viewRight + y * viewUp;
+        const double forward = glm::dot(edge, direction);
+        if (forward <= 0.0) {
+          return std::nullopt;
+        }
+        tangentX =
+            std::max(tangentX, glm::abs(glm::dot(edge, right)) / forward);
+        tangentY =
+            std::max(tangentY, glm::abs(glm::dot(edge, up)) / forward);
+      }
+    }
+  }
+
+  tangentX *= tangentMargin;
+  tangentY *= tangentMargin;
+  if (tangentX > maximumTangent || tangentY > maximumTangent ||
+      tangentX <= 0.0 || tangentY <= 0.0) {
+    return std::nullopt;
+  }
+
+  // With every edge inside of it, the combined frustum contains the frustum of
+  // a view whose position it contains. Move it back from the center until it
+  // contains all of the positions.
+  double pullback = 0.0;
+  double spread = 0.0;
+  for (const ViewState& frustum : frustums) {
+    const glm::dvec3 offset = frustum.getPosition() - center;
+    const double forward = glm::dot(offset, direction);
+    pullback = std::max(
+        pullback,
+        glm::abs(glm::dot(offset, right)) / tangentX - forward);
+    pullback =
+        std::max(pullback, glm::abs(glm::dot(offset, up)) / tangentY - forward);
+    spread = std::max(spread, glm::length(offset));
+  }
+  pullback *= tangentMargin;
+
+  const ViewState& first = frustums.front();
+  return CombinedViewState(
+      ViewState::create(
+          center - direction * pullback,
+          direction,
+          up,
+          first.getViewportSize(),
+          2.0 * glm::atan(tangentX),
+          2.0 * glm::atan(tangentY)),
+      ViewState::create(
+          center,
+          direction,
+          up,
+          first.getViewportSize(),
+          first.getHorizontalFieldOfView(),
+          first.getVerticalFieldOfView()),
+      spread);
+}
+
+bool CombinedViewState::computeDistances(
+    const BoundingVolume& boundingVolume,
+    gsl::span<double> distances) const noexcept {
+  const double distance = glm::sqrt(glm::max(
+      this->_center.computeDistanceSquaredToBoundingVolume(boundingVolume),
+      0.0));
+  if (this->_spread > distance * maximumRelativeSpread) {
+    return false;
+  }
+
+  // Each view is at most the spread away from the center, so it is at least
+  // this far from the bounding volume.
+  std::fill(
+      distances.begin(),
+      distances.end(),
+      glm::max(distance - this->_spread, 0.0));
+  return true;
+}
+
+CombinedViewState::CombinedViewState(
+    const ViewState& bounds,
+    const ViewState& center,
+    double spread) noexcept
+    : _bounds(bounds), _center(center), _spread(spread) {}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/PackedBoundingVolumes.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A single frustum that contains several similar views, such as the two
+ * eyes of a VR headset, used to cull and measure a tile once for all of the
+ * views instead of once for each.
+ *
+ * A tile outside of the combined frustum is outside of every view, so only a
+ * tile inside of it needs to be tested against the views one by one.
+ */
+class CombinedViewState final {
+public:
+  /**
+   * @brief The largest distance between a view and the center of the views,
+   * relative to the distance from the center to a tile, for which the
+   * distance to the tile is estimated from the center for every view.
+   *
+   * The estimate is never farther than the actual distance, so the
+   * screen-space error of the tile is overestimated by at most
+   * `1 / (1 - maximumRelativeSpread)`.
+   */
+  static constexpr double maximumRelativeSpread = 0.01;
+
+  /**
+   * @brief Combines the given views.
+   *
+   * @return The combined view, or `std::nullopt` if there are fewer than two
+   * views, or if they face in such different directions that no frustum
+   * narrower than a half-space contains them all.
+   */
+  static std::optional<CombinedViewState>
+  create(const std::vector<ViewState>& frustums);
+
+  /**
+   * @brief Returns whether the given bounding volume may be visible in any of
+   * the views. If this returns `false`, it is not visible in any of them.
+   */
+  bool
+  isBoundingVolumeVisible(const BoundingVolume& boundingVolume) const noexcept {
+    return this->_bounds.isBoundingVolumeVisible(boundingVolume);
+  }
+
+  /**
+   * @brief Determines which of a batch of bounding volumes may be visible in
+   * any of the views, like {@link isBoundingVolumeVisible}.
+   */
+  void computeBoundingVolumesVisibility(
+      const CesiumGeometry::PackedBoundingVolumes& boundingVolumes,
+      gsl::span<uint8_t> visibility) const {
+    this->_bounds.computeBoundingVolumesVisibility(boundingVolumes, visibility);
+  }
+
+  /**
+   * @brief Estimates the distance from every view to the given bounding
+   * volume with a single distance computation.
+   *
+   * @param boundingVolume The bounding volume.
+   * @param distances Receives the estimated distance for each view, if the
+   * estimate is close enough.
+   * @return `true` if the distances were estimated, or `false` if the bounding
+   * volume is too close to the views to estimate them, and they must be
+   * computed for each view.
+   */
+  bool computeDistances(
+      const BoundingVolume& boundingVolume,
+      gsl::span<double> distances) const noexcept;
+
+private:
+  CombinedViewState(
+      const ViewState& bounds,
+      const ViewState& center,
+      double spread) noexcept;
+
+  // The frustum that contains the frustums of all of the views.
+  ViewState _bounds;
+
+  // A view at the average position of the views.
+  ViewState _center;
+
+  // The largest distance between a view and the center.
+  double _spread;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,40 @@
+#include "Cesium3DTilesSelection/CostAwareTileEvictionPolicy.h"
+
+#include "Cesium3DTilesSelection/Tile.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace Cesium3DTilesSelection;
+
+CostAwareTileEvictionPolicy::CostAwareTileEvictionPolicy(
+    ReloadCostEstimator estimateReloadCost) noexcept
+    : _estimateReloadCost(std::move(estimateReloadCost)) {}
+
+void CostAwareTileEvictionPolicy::orderForEviction(
+    const gsl::span<Tile*>& candidates,
+    const std::vector<ViewState>& /*frustums*/) {
+  std::vector<std::pair<double, Tile*>> scored;
+  scored.reserve(candidates.size());
+  for (Tile* pTile : candidates) {
+    const double reloadCost = this->_estimateReloadCost
+                                  ? this->_estimateReloadCost(*pTile)
+                                  : pTile->getLastLoadDuration();
+    const int64_t bytes = std::max(pTile->getByteSize(), int64_t(1));
+    scored.emplace_back(reloadCost / double(bytes), pTile);
+  }
+
+  std::stable_sort(
+      scored.begin(),
+      scored.end(),
+      [](const std::pair<double, Tile*>& lhs,
+         const std::pair<double, Tile*>& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+  std::transform(
+      scored.begin(),
+      scored.end(),
+      candidates.begin(),
+      [](const std::pair<double, Tile*>& score) { return score.second; });
+}
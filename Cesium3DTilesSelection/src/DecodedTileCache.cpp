@@ -0,0 +1,309 @@
+#include "DecodedTileCache.h"
+
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfWriter/GltfWriter.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <type_traits>
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+using namespace CesiumGltfReader;
+using namespace CesiumGltfWriter;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// Bump the version whenever the layout changes, so that the tiles cached by an
+// older version are decoded again.
+constexpr char DECODED_TILE_MAGIC[4] = {'C', 'D', 'T', 'C'};
+constexpr uint32_t DECODED_TILE_VERSION = 1;
+
+template <typename T>
+void write(std::vector<std::byte>& output, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const size_t offset = output.size();
+  output.resize(offset + sizeof(T));
+  std::memcpy(output.data() + offset, &value, sizeof(T));
+}
+
+void writeBytes(
+    std::vector<std::byte>& output,
+    const gsl::span<const std::byte>& bytes) {
+  write(output, static_cast<uint64_t>(bytes.size()));
+  output.insert(output.end(), bytes.begin(), bytes.end());
+}
+
+class DecodedTileReader {
+public:
+  explicit DecodedTileReader(gsl::span<const std::byte> data) : _data(data) {}
+
+  template <typename T> bool read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (this->_data.size() - this->_offset < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, this->_data.data() + this->_offset, sizeof(T));
+    this->_offset += sizeof(T);
+    return true;
+  }
+
+  bool readBytes(gsl::span<const std::byte>& bytes) {
+    uint64_t size;
+    if (!this->read(size) || size > this->_data.size() - this->_offset) {
+      return false;
+    }
+    bytes = this->_data.subspan(this->_offset, size_t(size));
+    this->_offset += size_t(size);
+    return true;
+  }
+
+  bool isAtEnd() const noexcept { return this->_offset == this->_data.size(); }
+
+private:
+  gsl::span<const std::byte> _data;
+  size_t _offset = 0;
+};
+
+const GltfWriter& getGltfWriter() {
+  static const GltfWriter writer;
+  return writer;
+}
+
+const GltfReader& getGltfReader() {
+  static const GltfReader reader;
+  return reader;
+}
+
+void writeImage(std::vector<std::byte>& output, const ImageCesium& image) {
+  write(output, image.width);
+  write(output, image.height);
+  write(output, image.channels);
+  write(output, image.bytesPerChannel);
+  write(output, static_cast<int32_t>(image.compressedPixelFormat));
+  write(output, image.sizeBytes);
+  write(output, static_cast<uint64_t>(image.mipPositions.size()));
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    write(output, static_cast<uint64_t>(mip.byteOffset));
+    write(output, static_cast<uint64_t>(mip.byteSize));
+  }
+  writeBytes(output, image.pixelData);
+}
+
+bool readImage(DecodedTileReader& reader, ImageCesium& image) {
+  int32_t compressedPixelFormat;
+  uint64_t mipCount;
+  if (!reader.read(image.width) || !reader.read(image.height) ||
+      !reader.read(image.channels) || !reader.read(image.bytesPerChannel) ||
+      !reader.read(compressedPixelFormat) || !reader.read(image.sizeBytes) ||
+      !reader.read(mipCount)) {
+    return false;
+  }
+
+  image.compressedPixelFormat = GpuCompressedPixelFormat(compressedPixelFormat);
+  image.mipPositions.clear();
+  for (uint64_t i = 0; i < mipCount; ++i) {
+    uint64_t byteOffset;
+    uint64_t byteSize;
+    if (!reader.read(byteOffset) || !reader.read(byteSize)) {
+      return false;
+    }
+    image.mipPositions.push_back(
+        ImageCesiumMipPosition{size_t(byteOffset), size_t(byteSize)});
+  }
+
+  gsl::span<const std::byte> pixelData;
+  if (!reader.readBytes(pixelData)) {
+    return false;
+  }
+  image.pixelData.assign(pixelData.begin(), pixelData.end());
+  return true;
+}
+} // namespace
+
+std::optional<std::string> getDecodedTileCacheKey(
+    const IAssetRequest& request,
+    const TilesetContentOptions& contentOptions) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return std::nullopt;
+  }
+
+  const HttpHeaders& headers = pResponse->headers();
+  auto etagIt = headers.find("ETag");
+  if (etagIt == headers.end() || etagIt->second.empty()) {
+    return std::nullopt;
+  }
+
+  const Ktx2TranscodeTargets& targets = contentOptions.ktx2TranscodeTargets;
+  const GpuCompressedPixelFormat formats[] = {
+      targets.ETC1S_R,
+      targets.ETC1S_RG,
+      targets.ETC1S_RGB,
+      targets.ETC1S_RGBA,
+      targets.UASTC_R,
+      targets.UASTC_RG,
+      targets.UASTC_RGB,
+      targets.UASTC_RGBA,
+      targets.ETC1S_NormalMap,
+      targets.UASTC_NormalMap};
+
+  std::string key = "decoded-tile:";
+  for (GpuCompressedPixelFormat format : formats) {
+    key += std::to_string(int32_t(format)) + ",";
+  }
+  key += contentOptions.applyTextureTransform ? '1' : '0';
+  key += contentOptions.dequantizeMeshData ? '1' : '0';
+  key += contentOptions.shufflePointClouds ? '1' : '0';
+  key += contentOptions.decodeOpaqueImagesToRgb ? '1' : '0';
+  key += contentOptions.decodeEmbeddedImages ? '1' : '0';
+  key += "," + std::to_string(contentOptions.maximumImageDimension) + ",";
+  key += std::to_string(contentOptions.maximumKtx2Dimension) + ",";
+  for (const std::string& property : contentOptions.batchTableProperties) {
+    key += std::to_string(property.size()) + ":" + property;
+  }
+
+  return key + ":" + request.url() + ":" + etagIt->second;
+}
+
+std::vector<std::byte> writeDecodedTile(Model& model) {
+  for (const Buffer& buffer : model.buffers) {
+    if (buffer.uri ||
+        buffer.byteLength != static_cast<int64_t>(buffer.cesium.data.size())) {
+      return {};
+    }
+  }
+
+  for (const Image& image : model.images) {
+    if (image.uri) {
+      return {};
+    }
+  }
+
+  GltfUtilities::collapseToSingleBuffer(model);
+  gsl::span<const std::byte> bufferData;
+  if (!model.buffers.empty()) {
+    bufferData = model.buffers[0].cesium.data;
+  }
+
+  GltfWriterResult glb = getGltfWriter().writeGlb(model, bufferData);
+  if (!glb.errors.empty()) {
+    return {};
+  }
+
+  std::vector<std::byte> output;
+  write(output, DECODED_TILE_MAGIC);
+  write(output, DECODED_TILE_VERSION);
+  writeBytes(output, glb.gltfBytes);
+  write(output, static_cast<uint64_t>(model.images.size()));
+  for (const Image& image : model.images) {
+    writeImage(output, image.cesium);
+  }
+
+  return output;
+}
+
+std::optional<Model> readDecodedTile(gsl::span<const std::byte> data) {
+  DecodedTileReader reader(data);
+
+  char magic[4];
+  uint32_t version;
+  gsl::span<const std::byte> glb;
+  uint64_t imageCount;
+  if (!reader.read(magic) ||
+      std::memcmp(magic, DECODED_TILE_MAGIC, sizeof(magic)) != 0 ||
+      !reader.read(version) || version != DECODED_TILE_VERSION ||
+      !reader.readBytes(glb) || !reader.read(imageCount)) {
+    return std::nullopt;
+  }
+
+  // Everything was decoded before the tile was cached, so the GLB is only
+  // parsed.
+  GltfReaderOptions options;
+  options.decodeDataUrls = false;
+  options.decodeEmbeddedImages = false;
+  options.decodeDraco = false;
+  options.decodeMeshOptData = false;
+  options.dequantizeMeshData = false;
+  options.applyTextureTransform = false;
+  GltfReaderResult result = getGltfReader().readGltf(glb, options);
+  if (!result.model || !result.errors.empty() ||
+      imageCount != result.model->images.size()) {
+    return std::nullopt;
+  }
+
+  for (Image& image : result.model->images) {
+    if (!readImage(reader, image.cesium)) {
+      return std::nullopt;
+    }
+  }
+
+  if (!reader.isAtEnd()) {
+    return std::nullopt;
+  }
+
+  return std::move(result.model);
+}
+
+std::optional<Model> loadDecodedTileFromCache(
+    const IAssetRequest& request,
+    const TilesetContentOptions& contentOptions) {
+  if (!contentOptions.pDecodedTileCache) {
+    return std::nullopt;
+  }
+
+  std::optional<std::string> maybeKey =
+      getDecodedTileCacheKey(request, contentOptions);
+  if (!maybeKey) {
+    return std::nullopt;
+  }
+
+  std::optional<CacheItem> maybeCacheItem =
+      contentOptions.pDecodedTileCache->getEntry(*maybeKey);
+  if (!maybeCacheItem ||
+      std::difftime(maybeCacheItem->expiryTime, std::time(nullptr)) <= 0.0) {
+    return std::nullopt;
+  }
+
+  CESIUM_TRACE_CATEGORY(Decode, "read decoded tile");
+  return readDecodedTile(maybeCacheItem->cacheResponse.data);
+}
+
+void storeDecodedTileInCache(
+    const IAssetRequest& request,
+    const TilesetContentOptions& contentOptions,
+    Model& model) {
+  if (!contentOptions.pDecodedTileCache) {
+    return;
+  }
+
+  std::optional<std::string> maybeKey =
+      getDecodedTileCacheKey(request, contentOptions);
+  if (!maybeKey) {
+    return;
+  }
+
+  CESIUM_TRACE_CATEGORY(Decode, "store decoded tile");
+  std::vector<std::byte> decoded = writeDecodedTile(model);
+  if (decoded.empty()) {
+    return;
+  }
+
+  contentOptions.pDecodedTileCache->storeEntry(
+      *maybeKey,
+      std::time(nullptr) +
+          static_cast<std::time_t>(contentOptions.decodedTileCacheSeconds),
+      request.url(),
+      request.method(),
+      HttpHeaders{},
+      200,
+      HttpHeaders{},
+      decoded);
+}
+} // namespace Cesium3DTilesSelection
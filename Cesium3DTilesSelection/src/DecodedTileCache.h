@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumGltf/Model.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief Gets the key under which the glTF decoded from the given tile content
+ * response is cached, or `std::nullopt` if the response has no ETag to tell
+ * its versions apart.
+ *
+ * The key includes every content option that changes how the content is
+ * decoded, so that content decoded with different options is cached
+ * separately.
+ */
+std::optional<std::string> getDecodedTileCacheKey(
+    const CesiumAsync::IAssetRequest& request,
+    const TilesetContentOptions& contentOptions);
+
+/**
+ * @brief Serializes a decoded glTF into a versioned binary blob holding a GLB
+ * followed by the decoded pixels of its images.
+ *
+ * The buffers of the model are merged into one, as a GLB requires, which
+ * changes its buffer views but not the data that they refer to.
+ *
+ * @param model The decoded glTF.
+ * @return The blob, or an empty vector if the model can't be represented, such
+ * as because it refers to external buffers or images that haven't been loaded
+ * yet.
+ */
+std::vector<std::byte> writeDecodedTile(CesiumGltf::Model& model);
+
+/**
+ * @brief Reads a glTF written by {@link writeDecodedTile}.
+ *
+ * Nothing in the glTF is decoded again.
+ *
+ * @param data The blob.
+ * @return The glTF, or `std::nullopt` if the blob was written by another
+ * version or is malformed.
+ */
+std::optional<CesiumGltf::Model>
+readDecodedTile(gsl::span<const std::byte> data);
+
+/**
+ * @brief Reads the glTF decoded from the given tile content response from the
+ * {@link TilesetContentOptions::pDecodedTileCache}, if it has an unexpired
+ * entry for it.
+ */
+std::optional<CesiumGltf::Model> loadDecodedTileFromCache(
+    const CesiumAsync::IAssetRequest& request,
+    const TilesetContentOptions& contentOptions);
+
+/**
+ * @brief Stores the glTF decoded from the given tile content response in the
+ * {@link TilesetContentOptions::pDecodedTileCache}, if it is set and the
+ * response has an ETag.
+ */
+void storeDecodedTileInCache(
+    const CesiumAsync::IAssetRequest& request,
+    const TilesetContentOptions& contentOptions,
+    CesiumGltf::Model& model);
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,76 @@
+#include "ExternalTilesetCache.h"
+
+#include <rapidjson/document.h>
+
+#include <iterator>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+const ParsedExternalTileset*
+ExternalTilesetCache::find(const std::string& url) noexcept {
+  auto indexIt = this->_index.find(url);
+  if (indexIt == this->_index.end()) {
+    return nullptr;
+  }
+
+  this->markUsed(indexIt->second);
+  return &indexIt->second->tileset;
+}
+
+void ExternalTilesetCache::add(
+    const std::string& url,
+    ParsedExternalTileset&& tileset) {
+  this->_loadingUrls.erase(url);
+
+  auto indexIt = this->_index.find(url);
+  if (indexIt != this->_index.end()) {
+    Entry& entry = *indexIt->second;
+    this->_sizeBytes += tileset.sizeBytes - entry.tileset.sizeBytes;
+    entry.tileset = std::move(tileset);
+    this->markUsed(indexIt->second);
+    return;
+  }
+
+  this->_sizeBytes += tileset.sizeBytes;
+  this->_entries.emplace_back(
+      Entry{url, std::move(tileset), this->_generation});
+  this->_index.emplace(url, std::prev(this->_entries.end()));
+}
+
+bool ExternalTilesetCache::isLoading(const std::string& url) const noexcept {
+  return this->_loadingUrls.count(url) > 0;
+}
+
+void ExternalTilesetCache::markLoading(const std::string& url) {
+  this->_loadingUrls.insert(url);
+}
+
+void ExternalTilesetCache::markLoadFailed(const std::string& url) {
+  this->_loadingUrls.erase(url);
+}
+
+int64_t ExternalTilesetCache::getSizeBytes() const noexcept {
+  return this->_sizeBytes;
+}
+
+void ExternalTilesetCache::unload(int64_t maximumBytes) {
+  auto it = this->_entries.begin();
+  while (this->_sizeBytes > maximumBytes && it != this->_entries.end()) {
+    if (it->lastUsedGeneration == this->_generation) {
+      ++it;
+      continue;
+    }
+
+    this->_sizeBytes -= it->tileset.sizeBytes;
+    this->_index.erase(it->url);
+    it = this->_entries.erase(it);
+  }
+
+  ++this->_generation;
+}
+
+void ExternalTilesetCache::markUsed(EntryList::iterator it) noexcept {
+  it->lastUsedGeneration = this->_generation;
+  this->_entries.splice(this->_entries.end(), this->_entries, it);
+}
+} // namespace Cesium3DTilesSelection
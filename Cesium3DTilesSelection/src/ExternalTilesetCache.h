@@ -0,0 +1,112 @@
+#pragma once
+
+#include <CesiumAsync/IAssetRequest.h>
+
+#include <rapidjson/fwd.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief The JSON of an external tileset, parsed from the response to its
+ * request.
+ */
+struct ParsedExternalTileset {
+  /**
+   * @brief The completed request for the external tileset.
+   */
+  std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+
+  /**
+   * @brief The parsed JSON of the external tileset.
+   */
+  std::shared_ptr<const rapidjson::Document> pTilesetJson;
+
+  /**
+   * @brief The number of bytes used by the response and the parsed JSON.
+   */
+  int64_t sizeBytes = 0;
+};
+
+/**
+ * @brief The parsed JSON of the external tilesets that were prefetched or
+ * loaded, by URL, in least-recently-used order, so that loading the same
+ * external tileset again doesn't need to request and parse it again.
+ *
+ * The cache is only used in the main thread.
+ */
+class ExternalTilesetCache {
+public:
+  /**
+   * @brief Finds a parsed external tileset and marks it as the most recently
+   * used.
+   *
+   * @return The parsed external tileset, or nullptr if it isn't cached.
+   */
+  const ParsedExternalTileset* find(const std::string& url) noexcept;
+
+  /**
+   * @brief Adds a parsed external tileset as the most recently used, replacing
+   * the one with the same URL if there is one.
+   */
+  void add(const std::string& url, ParsedExternalTileset&& tileset);
+
+  /**
+   * @brief Determines whether the external tileset with the given URL is
+   * being prefetched.
+   */
+  bool isLoading(const std::string& url) const noexcept;
+
+  /**
+   * @brief Records that the external tileset with the given URL is being
+   * prefetched, until it is added or {@link markLoadFailed} is called for it.
+   */
+  void markLoading(const std::string& url);
+
+  /**
+   * @brief Records that the prefetch of the given external tileset failed.
+   */
+  void markLoadFailed(const std::string& url);
+
+  /**
+   * @brief Gets the number of bytes used by the cached external tilesets.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+  /**
+   * @brief Removes the least recently used external tilesets until at most
+   * `maximumBytes` remain or no more can be removed.
+   *
+   * The external tilesets used or added since the previous call are kept, so
+   * that a prefetched external tileset is still there when its tile is
+   * loaded in the next frame.
+   */
+  void unload(int64_t maximumBytes);
+
+private:
+  struct Entry {
+    std::string url;
+    ParsedExternalTileset tileset;
+    uint64_t lastUsedGeneration;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void markUsed(EntryList::iterator it) noexcept;
+
+  // The entries from least to most recently used, and their index by URL.
+  EntryList _entries;
+  std::unordered_map<std::string, EntryList::iterator> _index;
+
+  // The URLs of the external tilesets that are being prefetched.
+  std::unordered_set<std::string> _loadingUrls;
+
+  int64_t _sizeBytes = 0;
+  uint64_t _generation = 0;
+};
+} // namespace Cesium3DTilesSelection
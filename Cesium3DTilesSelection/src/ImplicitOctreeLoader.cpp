@@ -1,4 +1,5 @@
 #include "ImplicitOctreeLoader.h"
+#include "DecodedTileCache.h"
 
 #include "logTileLoadResult.h"
 
@@ -48,50 +49,58 @@ std::vector<Tile> populateSubtree(
     return {};
   }
 
-  OctreeChildren childIDs = ImplicitTilingUtilities::getChildren(octreeID);
+  // Get the availability of all children at once. The children of the
+  // leaves of the subtree are the roots of child subtrees, whose content is
+  // unknown until those subtrees are loaded.
+  uint64_t relativeTileMortonID =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(
+          subtreeRootID,
+          octreeID);
+  uint32_t relativeChildLevel = relativeTileLevel + 1;
+  uint8_t availableChildren;
+  uint8_t childrenWithContent;
+  if (relativeChildLevel == subtreeLevels) {
+    availableChildren = subtreeAvailability.getChildSubtreeAvailabilityMask(
+        relativeTileMortonID);
+    childrenWithContent = availableChildren;
+  } else {
+    availableChildren = subtreeAvailability.getChildTileAvailabilityMask(
+        relativeTileLevel,
+        relativeTileMortonID);
+    childrenWithContent = subtreeAvailability.getChildContentAvailabilityMask(
+        relativeTileLevel,
+        relativeTileMortonID,
+        0);
+  }
 
   std::vector<Tile> children;
+  if (availableChildren == 0) {
+    return children;
+  }
+
+  OctreeChildren childIDs = ImplicitTilingUtilities::getChildren(octreeID);
   children.reserve(childIDs.size());
 
+  uint32_t childIndex = 0;
   for (const CesiumGeometry::OctreeTileID& childID : childIDs) {
-    uint64_t relativeChildMortonID =
-        ImplicitTilingUtilities::computeRelativeMortonIndex(
-            subtreeRootID,
-            childID);
-
-    uint32_t relativeChildLevel = relativeTileLevel + 1;
-    if (relativeChildLevel == subtreeLevels) {
-      if (subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)) {
-        Tile& child = children.emplace_back(&loader);
-        child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
-        child.setGeometricError(tile.getGeometricError() * 0.5);
-        child.setRefine(tile.getRefine());
-        child.setTileID(childID);
-      }
-    } else {
-      if (subtreeAvailability.isTileAvailable(
-              relativeChildLevel,
-              relativeChildMortonID)) {
-        if (subtreeAvailability.isContentAvailable(
-                relativeChildLevel,
-                relativeChildMortonID,
-                0)) {
-          children.emplace_back(&loader);
-        } else {
-          children.emplace_back(&loader, TileEmptyContent{});
-        }
+    const uint32_t childBit = 1U << childIndex++;
+    if ((availableChildren & childBit) == 0) {
+      continue;
+    }
 
-        Tile& child = children.back();
-        child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
-        child.setGeometricError(tile.getGeometricError() * 0.5);
-        child.setRefine(tile.getRefine());
-        child.setTileID(childID);
-      }
+    if (childrenWithContent & childBit) {
+      children.emplace_back(&loader);
+    } else {
+      children.emplace_back(&loader, TileEmptyContent{});
     }
+
+    Tile& child = children.back();
+    child.setTransform(tile.getTransform());
+    child.setBoundingVolume(
+        subdivideBoundingVolume(childID, loader.getBoundingVolume()));
+    child.setGeometricError(tile.getGeometricError() * 0.5);
+    child.setRefine(tile.getRefine());
+    child.setTileID(childID);
   }
 
   return children;
@@ -103,14 +112,23 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const std::string& tileUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
-    CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets,
-    bool applyTextureTransform) {
-  return pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders)
+    const TilesetContentOptions& contentOptions,
+    const CesiumAsync::AssetRequestOptions& requestOptions) {
+  const CesiumAsync::CancellationToken& cancellationToken =
+      requestOptions.cancellationToken;
+  return pAssetAccessor
+      ->getWithOptions(asyncSystem, tileUrl, requestHeaders, requestOptions)
       .thenInWorkerThread([pLogger,
-                           ktx2TranscodeTargets,
-                           applyTextureTransform](
+                           asyncSystem,
+                           contentOptions,
+                           cancellationToken](
                               std::shared_ptr<CesiumAsync::IAssetRequest>&&
                                   pCompletedRequest) mutable {
+        if (cancellationToken.isCanceled()) {
+          return TileLoadResult::createCanceledResult(
+              std::move(pCompletedRequest));
+        }
+
         const CesiumAsync::IAssetResponse* pResponse =
             pCompletedRequest->response();
         const std::string& tileUrl = pCompletedRequest->url();
@@ -143,11 +161,47 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
         }
 
         if (converter) {
+          std::optional<CesiumGltf::Model> maybeCachedModel =
+              loadDecodedTileFromCache(*pCompletedRequest, contentOptions);
+          if (maybeCachedModel) {
+            return TileLoadResult{
+                std::move(*maybeCachedModel),
+                CesiumGeometry::Axis::Y,
+                std::nullopt,
+                std::nullopt,
+                std::nullopt,
+                std::move(pCompletedRequest),
+                {},
+                TileLoadResultState::Success};
+          }
+
           // Convert to gltf
           CesiumGltfReader::GltfReaderOptions gltfOptions;
-          gltfOptions.ktx2TranscodeTargets = ktx2TranscodeTargets;
-          gltfOptions.applyTextureTransform = applyTextureTransform;
+          gltfOptions.ktx2TranscodeTargets =
+              contentOptions.ktx2TranscodeTargets;
+          gltfOptions.applyTextureTransform =
+              contentOptions.applyTextureTransform;
+          gltfOptions.dequantizeMeshData = contentOptions.dequantizeMeshData;
+          gltfOptions.shufflePointClouds = contentOptions.shufflePointClouds;
+          gltfOptions.batchTableProperties =
+              contentOptions.batchTableProperties;
+          gltfOptions.maximumImageDimension =
+              contentOptions.maximumImageDimension;
+          gltfOptions.maximumKtx2Dimension =
+              contentOptions.maximumKtx2Dimension;
+          gltfOptions.decodeOpaqueImagesToRgb =
+              contentOptions.decodeOpaqueImagesToRgb;
+          gltfOptions.decodeEmbeddedImages =
+              contentOptions.decodeEmbeddedImages;
+          gltfOptions.cancellationToken = cancellationToken;
+          gltfOptions.asyncSystem = asyncSystem;
+          gltfOptions.pDecodedDataAllocator =
+              contentOptions.pDecodedDataAllocator;
           GltfConverterResult result = converter(responseData, gltfOptions);
+          if (cancellationToken.isCanceled()) {
+            return TileLoadResult::createCanceledResult(
+                std::move(pCompletedRequest));
+          }
 
           // Report any errors if there are any
           logTileLoadResult(pLogger, tileUrl, result.errors);
@@ -156,6 +210,11 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
                 std::move(pCompletedRequest));
           }
 
+          storeDecodedTileInCache(
+              *pCompletedRequest,
+              contentOptions,
+              *result.model);
+
           return TileLoadResult{
               std::move(*result.model),
               CesiumGeometry::Axis::Y,
@@ -196,36 +255,27 @@ ImplicitOctreeLoader::loadTileContent(const TileLoadInput& loadInput) {
           this->_subtreeLevels,
           *pOctreeID);
   uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= _loadedSubtrees.size()) {
+  if (subtreeLevelIdx >= this->_loadedSubtrees.getSubtreeLevelCount()) {
     return asyncSystem.createResolvedFuture<TileLoadResult>(
         TileLoadResult::createFailedResult(nullptr));
   }
 
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt == this->_loadedSubtrees[subtreeLevelIdx].end()) {
-    // subtree is not loaded, so load it now.
-    std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
-        this->_baseUrl,
-        this->_subtreeUrlTemplate,
-        subtreeID);
-    return SubtreeAvailability::loadSubtree(
-               ImplicitTileSubdivisionScheme::Octree,
-               this->_subtreeLevels,
-               asyncSystem,
-               pAssetAccessor,
-               pLogger,
-               subtreeUrl,
-               requestHeaders)
-        .thenInMainThread([this, subtreeID](std::optional<SubtreeAvailability>&&
-                                                subtreeAvailability) mutable {
-          if (subtreeAvailability) {
-            this->addSubtreeAvailability(
-                subtreeID,
-                std::move(*subtreeAvailability));
+  const SubtreeAvailability* pSubtree =
+      this->_loadedSubtrees.find(subtreeLevelIdx, subtreeMortonIdx);
+  if (!pSubtree) {
+    if (this->_loadedSubtrees.isLoading(subtreeLevelIdx, subtreeMortonIdx)) {
+      // subtree is already being loaded, such as by a prefetch, so tell client
+      // to retry later
+      return asyncSystem.createResolvedFuture<TileLoadResult>(
+          TileLoadResult::createRetryLaterResult(nullptr));
+    }
 
+    // subtree is not loaded, so load it now.
+    return this->loadSubtree(loadInput, subtreeID)
+        .thenImmediately([](bool loaded) {
+          if (loaded) {
             // tell client to retry later
             return TileLoadResult::createRetryLaterResult(nullptr);
           } else {
@@ -237,7 +287,7 @@ ImplicitOctreeLoader::loadTileContent(const TileLoadInput& loadInput) {
 
   // subtree is available, so check if tile has content or not. If it has, then
   // request it
-  if (!subtreeIt->second.isContentAvailable(subtreeID, *pOctreeID, 0)) {
+  if (!pSubtree->isContentAvailable(subtreeID, *pOctreeID, 0)) {
     // check if tile has empty content
     return asyncSystem.createResolvedFuture(TileLoadResult{
         TileEmptyContent{},
@@ -260,8 +310,8 @@ ImplicitOctreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       pAssetAccessor,
       tileUrl,
       requestHeaders,
-      contentOptions.ktx2TranscodeTargets,
-      contentOptions.applyTextureTransform);
+      contentOptions,
+      loadInput.getRequestOptions());
 }
 
 TileChildrenResult ImplicitOctreeLoader::createTileChildren(const Tile& tile) {
@@ -276,23 +326,31 @@ TileChildrenResult ImplicitOctreeLoader::createTileChildren(const Tile& tile) {
           *pOctreeID);
 
   uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
-  if (subtreeLevelIdx >= this->_loadedSubtrees.size()) {
+  if (subtreeLevelIdx >= this->_loadedSubtrees.getSubtreeLevelCount()) {
     return {{}, TileLoadResultState::Failed};
   }
 
   uint64_t subtreeMortonIdx =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
 
-  auto subtreeIt =
-      this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
-  if (subtreeIt != this->_loadedSubtrees[subtreeLevelIdx].end()) {
+  const SubtreeAvailability* pSubtree =
+      this->_loadedSubtrees.find(subtreeLevelIdx, subtreeMortonIdx);
+  if (pSubtree) {
     auto children = populateSubtree(
-        subtreeIt->second,
+        *pSubtree,
         this->_subtreeLevels,
         subtreeID,
         tile,
         *this);
 
+    // Children on the last level of the subtree create their own children
+    // from child subtrees.
+    uint32_t relativeChildLevel = pOctreeID->level - subtreeID.level + 1;
+    this->_loadedSubtrees.markTileChildrenCreated(
+        subtreeLevelIdx,
+        subtreeMortonIdx,
+        relativeChildLevel < this->_subtreeLevels ? children.size() : 0);
+
     return {std::move(children), TileLoadResultState::Success};
   }
 
@@ -316,15 +374,122 @@ void ImplicitOctreeLoader::addSubtreeAvailability(
     const CesiumGeometry::OctreeTileID& subtreeID,
     SubtreeAvailability&& subtreeAvailability) {
   uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
-  if (levelIndex >= this->_loadedSubtrees.size()) {
-    return;
-  }
-
   uint64_t subtreeMortonID =
       ImplicitTilingUtilities::computeMortonIndex(subtreeID);
 
-  this->_loadedSubtrees[levelIndex].insert_or_assign(
+  this->_loadedSubtrees.add(
+      levelIndex,
       subtreeMortonID,
       std::move(subtreeAvailability));
 }
+
+std::vector<CesiumAsync::Future<void>>
+ImplicitOctreeLoader::prefetchTileChildren(
+    const TileLoadInput& loadInput,
+    size_t maximumLoads) {
+  const CesiumGeometry::OctreeTileID* pOctreeID =
+      std::get_if<CesiumGeometry::OctreeTileID>(&loadInput.tile.getTileID());
+  if (!pOctreeID) {
+    return {};
+  }
+
+  // Only the children of the tiles on the last level of a subtree are the
+  // roots of child subtrees.
+  CesiumGeometry::OctreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(
+          this->_subtreeLevels,
+          *pOctreeID);
+  if (pOctreeID->level - subtreeID.level + 1 != this->_subtreeLevels) {
+    return {};
+  }
+
+  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
+  uint32_t childSubtreeLevelIdx = subtreeLevelIdx + 1;
+  if (childSubtreeLevelIdx >= this->_loadedSubtrees.getSubtreeLevelCount()) {
+    return {};
+  }
+
+  const SubtreeAvailability* pSubtree = this->_loadedSubtrees.find(
+      subtreeLevelIdx,
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID));
+  if (!pSubtree) {
+    return {};
+  }
+
+  uint8_t availableChildSubtrees = pSubtree->getChildSubtreeAvailabilityMask(
+      ImplicitTilingUtilities::computeRelativeMortonIndex(
+          subtreeID,
+          *pOctreeID));
+
+  std::vector<CesiumAsync::Future<void>> loads;
+  uint32_t childIndex = 0;
+  for (const CesiumGeometry::OctreeTileID& childID :
+       ImplicitTilingUtilities::getChildren(*pOctreeID)) {
+    const uint32_t childBit = 1U << childIndex++;
+    if ((availableChildSubtrees & childBit) == 0) {
+      continue;
+    }
+
+    if (loads.size() >= maximumLoads) {
+      break;
+    }
+
+    uint64_t childMortonIdx =
+        ImplicitTilingUtilities::computeMortonIndex(childID);
+    if (this->_loadedSubtrees.isLoading(childSubtreeLevelIdx, childMortonIdx) ||
+        this->_loadedSubtrees.find(childSubtreeLevelIdx, childMortonIdx)) {
+      continue;
+    }
+
+    loads.emplace_back(
+        this->loadSubtree(loadInput, childID).thenImmediately([](bool) {}));
+  }
+
+  return loads;
+}
+
+int64_t ImplicitOctreeLoader::getLoaderDataBytes() const noexcept {
+  return this->_loadedSubtrees.getSizeBytes();
+}
+
+void ImplicitOctreeLoader::unloadLoaderData(int64_t maximumBytes) {
+  this->_loadedSubtrees.unload(maximumBytes);
+}
+
+CesiumAsync::Future<bool> ImplicitOctreeLoader::loadSubtree(
+    const TileLoadInput& loadInput,
+    const CesiumGeometry::OctreeTileID& subtreeID) {
+  uint32_t subtreeLevelIdx = subtreeID.level / this->_subtreeLevels;
+  uint64_t subtreeMortonIdx =
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  this->_loadedSubtrees.markLoading(subtreeLevelIdx, subtreeMortonIdx);
+
+  std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_subtreeUrlTemplate,
+      subtreeID);
+  return SubtreeAvailability::loadSubtree(
+             ImplicitTileSubdivisionScheme::Octree,
+             this->_subtreeLevels,
+             loadInput.asyncSystem,
+             loadInput.pAssetAccessor,
+             loadInput.pLogger,
+             subtreeUrl,
+             loadInput.requestHeaders)
+      .thenInMainThread(
+          [this, subtreeID, subtreeLevelIdx, subtreeMortonIdx](
+              std::optional<SubtreeAvailability>&& subtreeAvailability) {
+            if (!subtreeAvailability) {
+              this->_loadedSubtrees.markLoadFailed(
+                  subtreeLevelIdx,
+                  subtreeMortonIdx);
+              return false;
+            }
+
+            this->addSubtreeAvailability(
+                subtreeID,
+                std::move(*subtreeAvailability));
+            return true;
+          });
+}
 } // namespace Cesium3DTilesSelection
@@ -1,14 +1,17 @@
 #pragma once
 
+#include "SubtreeAvailabilityCache.h"
+
 #include <Cesium3DTilesContent/SubtreeAvailability.h>
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumUtility/UriResolver.h>
+#include <CesiumUtility/UriTemplate.h>
 
 #include <cmath>
 #include <string>
-#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -42,6 +45,14 @@ public:
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  int64_t getLoaderDataBytes() const noexcept override;
+
+  void unloadLoaderData(int64_t maximumBytes) override;
+
+  std::vector<CesiumAsync::Future<void>> prefetchTileChildren(
+      const TileLoadInput& loadInput,
+      size_t maximumLoads) override;
+
   uint32_t getSubtreeLevels() const noexcept;
 
   uint32_t getAvailableLevels() const noexcept;
@@ -53,14 +64,16 @@ public:
       Cesium3DTilesContent::SubtreeAvailability&& subtreeAvailability);
 
 private:
-  std::string _baseUrl;
-  std::string _contentUrlTemplate;
-  std::string _subtreeUrlTemplate;
+  CesiumAsync::Future<bool> loadSubtree(
+      const TileLoadInput& loadInput,
+      const CesiumGeometry::OctreeTileID& subtreeID);
+
+  CesiumUtility::UriResolver _baseUrl;
+  CesiumUtility::UriTemplate _contentUrlTemplate;
+  CesiumUtility::UriTemplate _subtreeUrlTemplate;
   uint32_t _subtreeLevels;
   uint32_t _availableLevels;
   ImplicitOctreeBoundingVolume _boundingVolume;
-  std::vector<
-      std::unordered_map<uint64_t, Cesium3DTilesContent::SubtreeAvailability>>
-      _loadedSubtrees;
+  SubtreeAvailabilityCache _loadedSubtrees;
 };
 } // namespace Cesium3DTilesSelection
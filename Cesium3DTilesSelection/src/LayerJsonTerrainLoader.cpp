@@ -30,6 +30,10 @@ struct LoadLayersResult {
   std::vector<std::string> layerCredits;
   ErrorList errors;
   uint16_t statusCode{200};
+
+  // The availability of each layer, which is built in a worker thread while
+  // the parent layers are loaded.
+  std::vector<Future<QuadtreeRectangleAvailability>> layerAvailability{};
 };
 
 /**
@@ -302,21 +306,35 @@ Future<LoadLayersResult> loadLayersRecursive(
   const auto availabilityLevelsIt =
       layerJson.FindMember("metadataAvailability");
 
-  QuadtreeRectangleAvailability availability(tilingScheme, uint32_t(maxZoom));
-
   int32_t availabilityLevels = -1;
 
   if (availabilityLevelsIt != layerJson.MemberEnd() &&
       availabilityLevelsIt->value.IsInt()) {
     availabilityLevels = availabilityLevelsIt->value.GetInt();
+    loadLayersResult.layerAvailability.emplace_back(
+        asyncSystem.createResolvedFuture(
+            QuadtreeRectangleAvailability(tilingScheme, uint32_t(maxZoom))));
   } else {
     QuantizedMeshMetadataResult metadata =
         QuantizedMeshLoader::loadAvailabilityRectangles(layerJson, 0);
     loadLayersResult.errors.merge(metadata.errors);
 
-    for (const auto& rectangle : metadata.availability) {
-      availability.addAvailableTileRange(rectangle);
-    }
+    // Adding the rectangles to the quadtree takes much longer than reading
+    // them, so it's done in parallel with the other layers and the requests
+    // for the parent layers.
+    loadLayersResult.layerAvailability.emplace_back(
+        asyncSystem.runInWorkerThread(
+            [tilingScheme,
+             maxZoom,
+             rectangles = std::move(metadata.availability)]() {
+              QuadtreeRectangleAvailability availability(
+                  tilingScheme,
+                  uint32_t(maxZoom));
+              for (const auto& rectangle : rectangles) {
+                availability.addAvailableTileRange(rectangle);
+              }
+              return availability;
+            }));
   }
 
   const auto attributionIt = layerJson.FindMember("attribution");
@@ -331,7 +349,7 @@ Future<LoadLayersResult> loadLayersRecursive(
       baseUrl,
       std::move(version),
       std::move(urls),
-      std::move(availability),
+      QuadtreeRectangleAvailability(tilingScheme, uint32_t(maxZoom)),
       static_cast<uint32_t>(maxZoom),
       availabilityLevels});
 
@@ -413,6 +431,28 @@ Future<LoadLayersResult> loadLayersRecursive(
   return asyncSystem.createResolvedFuture(std::move(loadLayersResult));
 }
 
+Future<LoadLayersResult> waitForLayerAvailability(
+    const AsyncSystem& asyncSystem,
+    LoadLayersResult&& loadLayersResult) {
+  std::vector<Future<QuadtreeRectangleAvailability>> layerAvailability =
+      std::move(loadLayersResult.layerAvailability);
+  loadLayersResult.layerAvailability.clear();
+
+  return asyncSystem.all(std::move(layerAvailability))
+      .thenImmediately(
+          [loadLayersResult = std::move(loadLayersResult)](
+              std::vector<QuadtreeRectangleAvailability>&&
+                  availability) mutable {
+            for (size_t i = 0;
+                 i < availability.size() && i < loadLayersResult.layers.size();
+                 ++i) {
+              loadLayersResult.layers[i].contentAvailability =
+                  std::move(availability[i]);
+            }
+            return std::move(loadLayersResult);
+          });
+}
+
 Future<LoadLayersResult> loadLayerJson(
     const AsyncSystem& asyncSystem,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
@@ -466,14 +506,17 @@ Future<LoadLayersResult> loadLayerJson(
       loadLayersResult{tilingScheme, projection, boundingVolume, {}, {}, {}};
 
   return loadLayersRecursive(
-      asyncSystem,
-      pAssetAccessor,
-      baseUrl,
-      requestHeaders,
-      layerJson,
-      tilingScheme,
-      useWaterMask,
-      std::move(loadLayersResult));
+             asyncSystem,
+             pAssetAccessor,
+             baseUrl,
+             requestHeaders,
+             layerJson,
+             tilingScheme,
+             useWaterMask,
+             std::move(loadLayersResult))
+      .thenImmediately([asyncSystem](LoadLayersResult&& result) {
+        return waitForLayerAvailability(asyncSystem, std::move(result));
+      });
 }
 
 Future<LoadLayersResult> loadLayerJson(
@@ -644,12 +687,27 @@ Future<QuantizedMeshLoadResult> requestTileContent(
     const BoundingRegion& boundingRegion,
     const LayerJsonTerrainLoader::Layer& layer,
     const std::vector<IAssetAccessor::THeader>& requestHeaders,
-    bool enableWaterMask) {
+    bool enableWaterMask,
+    bool keepOctEncodedNormals,
+    bool generateMissingNormals,
+    bool skirtsAsEdgeIndices,
+    bool downsampleWaterMask,
+    bool packWaterMaskBits,
+    bool parseMetadata) {
   std::string url = resolveTileUrl(tileID, layer);
   return pAssetAccessor->get(asyncSystem, url, requestHeaders)
       .thenInWorkerThread(
-          [asyncSystem, pLogger, tileID, boundingRegion, enableWaterMask](
-              std::shared_ptr<IAssetRequest>&& pRequest) {
+          [asyncSystem,
+           pLogger,
+           tileID,
+           boundingRegion,
+           enableWaterMask,
+           keepOctEncodedNormals,
+           generateMissingNormals,
+           skirtsAsEdgeIndices,
+           downsampleWaterMask,
+           packWaterMaskBits,
+           parseMetadata](std::shared_ptr<IAssetRequest>&& pRequest) {
             const IAssetResponse* pResponse = pRequest->response();
             if (!pResponse) {
               QuantizedMeshLoadResult result;
@@ -677,7 +735,13 @@ Future<QuantizedMeshLoadResult> requestTileContent(
                 boundingRegion,
                 pRequest->url(),
                 pResponse->data(),
-                enableWaterMask);
+                enableWaterMask,
+                keepOctEncodedNormals,
+                generateMissingNormals,
+                skirtsAsEdgeIndices,
+                downsampleWaterMask,
+                packWaterMaskBits,
+                parseMetadata);
           });
 }
 
@@ -793,21 +857,12 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
         TileLoadResult::createFailedResult(nullptr));
   }
 
-  // Start the actual content request.
   auto& currentLayer = *firstAvailableIt;
-  Future<QuantizedMeshLoadResult> futureQuantizedMesh = requestTileContent(
-      pLogger,
-      asyncSystem,
-      pAssetAccessor,
-      *pQuadtreeTileID,
-      *pRegion,
-      currentLayer,
-      requestHeaders,
-      contentOptions.enableWaterMask);
 
   // determine if this tile is at the availability level of the current layer
   // and if we need to add the availability rectangles to the current layer. We
-  // only add the rectangles if those are not not loaded
+  // only add the rectangles if those are not not loaded, and only parse the
+  // tile's metadata extension when we do.
   bool shouldCurrLayerLoadAvailability = false;
   if (firstAvailableIt->availabilityLevels >= 1 &&
       int32_t(pQuadtreeTileID->level) % currentLayer.availabilityLevels == 0) {
@@ -815,6 +870,23 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
         !isSubtreeLoadedInLayer(*pQuadtreeTileID, currentLayer);
   }
 
+  // Start the actual content request.
+  Future<QuantizedMeshLoadResult> futureQuantizedMesh = requestTileContent(
+      pLogger,
+      asyncSystem,
+      pAssetAccessor,
+      *pQuadtreeTileID,
+      *pRegion,
+      currentLayer,
+      requestHeaders,
+      contentOptions.enableWaterMask,
+      contentOptions.keepTerrainNormalsOctEncoded,
+      contentOptions.generateMissingTerrainNormals,
+      contentOptions.terrainSkirtsAsEdgeIndices,
+      contentOptions.downsampleWaterMask,
+      contentOptions.packWaterMaskBits,
+      shouldCurrLayerLoadAvailability);
+
   // If this tile has availability data, we need to add it to the layer in the
   // main thread.
   if (!availabilityRequests.empty() || shouldCurrLayerLoadAvailability) {
@@ -946,19 +1018,13 @@ bool LayerJsonTerrainLoader::tileHasUpsampledChild(const Tile& tile) const {
     const QuadtreeTileID* pQuadtreeTileID =
         std::get_if<QuadtreeTileID>(&tile.getTileID());
 
-    const QuadtreeTileID swID(
-        pQuadtreeTileID->level + 1,
-        pQuadtreeTileID->x * 2,
-        pQuadtreeTileID->y * 2);
-    const QuadtreeTileID seID(swID.level, swID.x + 1, swID.y);
-    const QuadtreeTileID nwID(swID.level, swID.x, swID.y + 1);
-    const QuadtreeTileID neID(swID.level, swID.x + 1, swID.y + 1);
+    const std::array<bool, 4> available =
+        this->childTilesAreAvailableInAnyLayer(*pQuadtreeTileID);
 
     uint32_t totalChildren = 0;
-    totalChildren += this->tileIsAvailableInAnyLayer(swID);
-    totalChildren += this->tileIsAvailableInAnyLayer(seID);
-    totalChildren += this->tileIsAvailableInAnyLayer(nwID);
-    totalChildren += this->tileIsAvailableInAnyLayer(neID);
+    for (bool isAvailable : available) {
+      totalChildren += isAvailable;
+    }
     return totalChildren > 0 && totalChildren < 4;
   } else {
     for (const auto& child : tileChildren) {
@@ -987,10 +1053,12 @@ LayerJsonTerrainLoader::createTileChildrenImpl(const Tile& tile) {
   const QuadtreeTileID neID(swID.level, swID.x + 1, swID.y + 1);
 
   // If _any_ child is available, we create _all_ children
-  bool sw = this->tileIsAvailableInAnyLayer(swID);
-  bool se = this->tileIsAvailableInAnyLayer(seID);
-  bool nw = this->tileIsAvailableInAnyLayer(nwID);
-  bool ne = this->tileIsAvailableInAnyLayer(neID);
+  const std::array<bool, 4> available =
+      this->childTilesAreAvailableInAnyLayer(*pQuadtreeTileID);
+  const bool sw = available[0];
+  const bool se = available[1];
+  const bool nw = available[2];
+  const bool ne = available[3];
 
   if (sw || se || nw || ne) {
     std::vector<Tile> children;
@@ -1006,16 +1074,24 @@ LayerJsonTerrainLoader::createTileChildrenImpl(const Tile& tile) {
   return {};
 }
 
-bool LayerJsonTerrainLoader::tileIsAvailableInAnyLayer(
+std::array<bool, 4> LayerJsonTerrainLoader::childTilesAreAvailableInAnyLayer(
     const QuadtreeTileID& tileID) const {
+  std::array<bool, 4> result{};
   for (const Layer& layer : this->_layers) {
-    auto availableState = tileIsAvailableInLayer(tileID, layer);
-    if (availableState == AvailableState::Available) {
-      return true;
+    const std::array<uint8_t, 4> available =
+        layer.contentAvailability.areChildTilesAvailable(tileID);
+    bool all = true;
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = result[i] || available[i] != 0;
+      all = all && result[i];
+    }
+
+    if (all) {
+      break;
     }
   }
 
-  return false;
+  return result;
 }
 
 LayerJsonTerrainLoader::AvailableState
@@ -12,6 +12,7 @@
 
 #include <rapidjson/fwd.h>
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
@@ -82,8 +83,10 @@ private:
 
   std::vector<Tile> createTileChildrenImpl(const Tile& tile);
 
-  bool
-  tileIsAvailableInAnyLayer(const CesiumGeometry::QuadtreeTileID& tileID) const;
+  // Whether each of the four children of the tile is available in any layer,
+  // in the order southwest, southeast, northwest, northeast.
+  std::array<bool, 4> childTilesAreAvailableInAnyLayer(
+      const CesiumGeometry::QuadtreeTileID& tileID) const;
 
   AvailableState tileIsAvailableInLayer(
       const CesiumGeometry::QuadtreeTileID& tileID,
@@ -0,0 +1,9 @@
+#include "Cesium3DTilesSelection/LruTileEvictionPolicy.h"
+
+using namespace Cesium3DTilesSelection;
+
+void LruTileEvictionPolicy::orderForEviction(
+    const gsl::span<Tile*>& /*candidates*/,
+    const std::vector<ViewState>& /*frustums*/) {
+  // The candidates are already in least-recently-used order.
+}
@@ -58,7 +58,8 @@ RasterMappedTo3DTile::RasterMappedTo3DTile(
       _translation(0.0, 0.0),
       _scale(1.0, 1.0),
       _state(AttachmentState::Unattached),
-      _originalFailed(false) {
+      _originalFailed(false),
+      _lastTileStateVersion() {
   assert(this->_pLoadingTile != nullptr);
 }
 
@@ -75,6 +76,19 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
                : RasterOverlayTile::MoreDetailAvailable::No;
   }
 
+  // While there is a loading tile, the outcome below can only change after the
+  // loading tile or the tile of an ancestor loads or fails, and those are
+  // tiles of the same provider. So skip the work until the provider reports a
+  // change.
+  if (this->_pLoadingTile) {
+    const uint64_t tileStateVersion =
+        this->_pLoadingTile->getTileProvider().getTileStateVersion();
+    if (this->_lastTileStateVersion == tileStateVersion) {
+      return RasterOverlayTile::MoreDetailAvailable::Unknown;
+    }
+    this->_lastTileStateVersion = tileStateVersion;
+  }
+
   // If the loading tile has failed, try its parent's loading tile.
   Tile* pTile = &tile;
   while (this->_pLoadingTile &&
@@ -97,19 +111,15 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
     }
   }
 
+  // The raster tile attached to the renderer, if any. When the ready tile
+  // changes below, the renderer replaces this one with it in one step.
+  const CesiumUtility::IntrusivePointer<RasterOverlayTile> pAttachedTile =
+      this->getState() != AttachmentState::Unattached ? this->_pReadyTile
+                                                      : nullptr;
+
   // If the loading tile is now ready, make it the ready tile.
   if (this->_pLoadingTile &&
       this->_pLoadingTile->getState() >= RasterOverlayTile::LoadState::Loaded) {
-    // Unattach the old tile
-    if (this->_pReadyTile && this->getState() != AttachmentState::Unattached) {
-      prepareRendererResources.detachRasterInMainThread(
-          tile,
-          this->getTextureCoordinateID(),
-          *this->_pReadyTile,
-          this->_pReadyTile->getRendererResources());
-      this->_state = AttachmentState::Unattached;
-    }
-
     // Mark the loading tile ready.
     this->_pReadyTile = this->_pLoadingTile;
     this->_pLoadingTile = nullptr;
@@ -118,9 +128,10 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
     this->computeTranslationAndScale(tile);
   }
 
-  // Find the closest ready ancestor tile.
+  // Find the closest ready ancestor tile. The ancestors keep their overlay
+  // tiles alive, so there's no need to count references while searching.
   if (this->_pLoadingTile) {
-    CesiumUtility::IntrusivePointer<RasterOverlayTile> pCandidate;
+    RasterOverlayTile* pCandidate = nullptr;
 
     pTile = tile.getParent();
     while (pTile) {
@@ -137,15 +148,6 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
     if (pCandidate &&
         pCandidate->getState() >= RasterOverlayTile::LoadState::Loaded &&
         this->_pReadyTile != pCandidate) {
-      if (this->getState() != AttachmentState::Unattached) {
-        prepareRendererResources.detachRasterInMainThread(
-            tile,
-            this->getTextureCoordinateID(),
-            *this->_pReadyTile,
-            this->_pReadyTile->getRendererResources());
-        this->_state = AttachmentState::Unattached;
-      }
-
       this->_pReadyTile = pCandidate;
 
       // Compute the translation and scale for the new tile.
@@ -153,21 +155,37 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
     }
   }
 
-  // Attach the ready tile if it's not already attached.
-  if (this->_pReadyTile &&
-      this->getState() == RasterMappedTo3DTile::AttachmentState::Unattached) {
+  // Attach the ready tile if it's not already attached, or replace the
+  // attached tile with it, such as when a finer tile replaces the part of an
+  // ancestor tile shown while the finer tile was loading.
+  if (this->_pReadyTile && this->_pReadyTile != pAttachedTile) {
     this->_pReadyTile->loadInMainThread();
 
-    prepareRendererResources.attachRasterInMainThread(
-        tile,
-        this->getTextureCoordinateID(),
-        *this->_pReadyTile,
-        this->_pReadyTile->getRendererResources(),
-        this->getTranslation(),
-        this->getScale());
+    if (pAttachedTile) {
+      prepareRendererResources.replaceRasterInMainThread(
+          tile,
+          this->getTextureCoordinateID(),
+          *pAttachedTile,
+          pAttachedTile->getRendererResources(),
+          *this->_pReadyTile,
+          this->_pReadyTile->getRendererResources(),
+          this->getTranslation(),
+          this->getScale());
+    } else {
+      prepareRendererResources.attachRasterInMainThread(
+          tile,
+          this->getTextureCoordinateID(),
+          *this->_pReadyTile,
+          this->_pReadyTile->getRendererResources(),
+          this->getTranslation(),
+          this->getScale());
+    }
 
     this->_state = this->_pLoadingTile ? AttachmentState::TemporarilyAttached
                                        : AttachmentState::Attached;
+  } else if (this->_pReadyTile && !this->_pLoadingTile) {
+    // The tile that was loading is the one already attached.
+    this->_state = AttachmentState::Attached;
   }
 
   assert(this->_pLoadingTile != nullptr || this->_pReadyTile != nullptr);
@@ -211,15 +229,16 @@ void RasterMappedTo3DTile::detachFromTile(
   this->_state = AttachmentState::Unattached;
 }
 
-bool RasterMappedTo3DTile::loadThrottled() noexcept {
-  CESIUM_TRACE("RasterMappedTo3DTile::loadThrottled");
+bool RasterMappedTo3DTile::loadThrottled(
+    CesiumAsync::TileLoadScheduler::Priority priority) noexcept {
+  CESIUM_TRACE_CATEGORY(Raster, "RasterMappedTo3DTile::loadThrottled");
   RasterOverlayTile* pLoading = this->getLoadingTile();
   if (!pLoading) {
     return true;
   }
 
   RasterOverlayTileProvider& provider = pLoading->getTileProvider();
-  return provider.loadTileThrottled(*pLoading);
+  return provider.loadTileThrottled(*pLoading, priority);
 }
 
 namespace {
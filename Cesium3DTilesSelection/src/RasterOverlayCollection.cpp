@@ -107,9 +107,18 @@ void RasterOverlayCollection::add(
                     "Error while creating tile provider: {0}",
                     e.what())});
           })
-      .thenInMainThread([pOverlay, pList, pLogger = this->_externals.pLogger](
+      .thenInMainThread([pOverlay,
+                         pList,
+                         pLogger = this->_externals.pLogger,
+                         pTileLoadScheduler =
+                             this->_externals.pTileLoadScheduler,
+                         pTileImageCache =
+                             this->_externals.pRasterOverlayTileImageCache](
                             RasterOverlay::CreateTileProviderResult&& result) {
         if (result) {
+          (*result)->setTileLoadScheduler(pTileLoadScheduler);
+          (*result)->setTileImageCache(pTileImageCache);
+
           // Find the overlay's current location in the list.
           // It's possible it has been removed completely.
           auto it = std::find(
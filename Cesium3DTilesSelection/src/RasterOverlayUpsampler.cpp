@@ -8,13 +8,71 @@
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <variant>
+#include <vector>
 
 using namespace Cesium3DTilesContent;
 using namespace CesiumRasterOverlays;
 
 namespace Cesium3DTilesSelection {
+namespace {
+// Gets the index of the overlay texture coordinates that divide the tile, which
+// are those of the first overlay that has more detail than the tile has.
+int32_t getTextureCoordinateIndex(
+    const Tile& tile,
+    const TileRenderContent& renderContent) {
+  const std::vector<CesiumGeospatial::Projection>& projections =
+      renderContent.getRasterOverlayDetails().rasterOverlayProjections;
+  for (const RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
+    if (mapped.isMoreDetailAvailable()) {
+      const CesiumGeospatial::Projection& projection =
+          mapped.getReadyTile()->getTileProvider().getProjection();
+      auto it = std::find(projections.begin(), projections.end(), projection);
+      return int32_t(it - projections.begin());
+    }
+  }
+
+  return 0;
+}
+
+int64_t computeSizeBytes(const CesiumGltf::Model& model) {
+  int64_t bytes = int64_t(sizeof(TileUpsamplingSource));
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+  for (const CesiumGltf::Image& image : model.images) {
+    bytes += int64_t(image.cesium.pixelData.size());
+  }
+
+  return bytes;
+}
+} // namespace
+
+std::shared_ptr<const TileUpsamplingSource>
+RasterOverlayUpsampler::createUpsamplingSource(const Tile& tile) {
+  if (tile.getState() != TileLoadState::Done) {
+    return nullptr;
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent || pRenderContent->isCpuDataReleased()) {
+    // Without the model, the children are upsampled from the reloaded model.
+    return nullptr;
+  }
+
+  CesiumGltf::Model model =
+      createGltfUpsamplingSource(pRenderContent->getModel());
+  const int64_t sizeBytes = computeSizeBytes(model);
+  return std::make_shared<const TileUpsamplingSource>(TileUpsamplingSource{
+      std::move(model),
+      getTextureCoordinateIndex(tile, *pRenderContent),
+      sizeBytes});
+}
+
 CesiumAsync::Future<TileLoadResult>
 RasterOverlayUpsampler::loadTileContent(const TileLoadInput& loadInput) {
   const Tile* pParent = loadInput.tile.getParent();
@@ -32,65 +90,170 @@ RasterOverlayUpsampler::loadTileContent(const TileLoadInput& loadInput) {
         TileLoadResult::createFailedResult(nullptr));
   }
 
-  // The tile content manager guarantees that the parent tile is already loaded
-  // before upsampled tile is loaded. If that's not the case, it's a bug
+  // The tile content manager guarantees that the parent tile is already loaded,
+  // or that it kept what's needed to upsample the parent tile when its content
+  // was unloaded, before upsampled tile is loaded. If that's not the case, it's
+  // a bug
+  const std::shared_ptr<const TileUpsamplingSource>& pSource =
+      pParent->_pUpsamplingSource;
   assert(
-      pParent->getState() == TileLoadState::Done &&
+      (pParent->getState() == TileLoadState::Done || pSource) &&
       "Parent must be loaded before upsampling");
 
-  const TileContent& parentContent = pParent->getContent();
   const TileRenderContent* pParentRenderContent =
-      parentContent.getRenderContent();
-  if (!pParentRenderContent) {
+      pParent->getState() == TileLoadState::Done
+          ? pParent->getContent().getRenderContent()
+          : nullptr;
+  if (!pParentRenderContent && !pSource) {
     // parent doesn't have mesh, so it's not possible to upsample
     return loadInput.asyncSystem.createResolvedFuture(
         TileLoadResult::createFailedResult(nullptr));
   }
 
-  int32_t index = 0;
-  const std::vector<CesiumGeospatial::Projection>& parentProjections =
-      pParentRenderContent->getRasterOverlayDetails().rasterOverlayProjections;
-  for (const RasterMappedTo3DTile& mapped : pParent->getMappedRasterTiles()) {
-    if (mapped.isMoreDetailAvailable()) {
-      const CesiumGeospatial::Projection& projection =
-          mapped.getReadyTile()->getTileProvider().getProjection();
-      auto it = std::find(
-          parentProjections.begin(),
-          parentProjections.end(),
-          projection);
-      index = int32_t(it - parentProjections.begin());
-      break;
-    }
+  const CesiumGltf::Model& parentModel = pParentRenderContent
+                                             ? pParentRenderContent->getModel()
+                                             : pSource->model;
+  const int32_t index =
+      pParentRenderContent
+          ? getTextureCoordinateIndex(*pParent, *pParentRenderContent)
+          : pSource->textureCoordinateIndex;
+
+  // The four children are almost always loaded together, so they're upsampled
+  // together, in one pass over the parent's triangles, when the first of them
+  // is loaded.
+  const CesiumGeometry::QuadtreeTileID& tileID = pTileID->tileID;
+  const size_t childIndex = size_t((tileID.y % 2) * 2 + tileID.x % 2);
+
+  auto it = this->_upsampledChildren.find(pParent);
+  if (it != this->_upsampledChildren.end() &&
+      (it->second.pParentModel != &parentModel ||
+       it->second.textureCoordinateIndex != index ||
+       it->second.loaded[childIndex])) {
+    // The parent's content changed, or this child is loaded again, so
+    // upsample again.
+    this->_upsampledChildren.erase(it);
+    it = this->_upsampledChildren.end();
+  }
+
+  if (it == this->_upsampledChildren.end()) {
+    const CesiumGeometry::QuadtreeTileID swID(
+        tileID.level,
+        tileID.x - tileID.x % 2,
+        tileID.y - tileID.y % 2);
+    std::vector<CesiumGeometry::UpsampledQuadtreeNode> childIDs{
+        CesiumGeometry::UpsampledQuadtreeNode{swID},
+        CesiumGeometry::UpsampledQuadtreeNode{
+            CesiumGeometry::QuadtreeTileID(swID.level, swID.x + 1, swID.y)},
+        CesiumGeometry::UpsampledQuadtreeNode{
+            CesiumGeometry::QuadtreeTileID(swID.level, swID.x, swID.y + 1)},
+        CesiumGeometry::UpsampledQuadtreeNode{
+            CesiumGeometry::QuadtreeTileID(
+                swID.level,
+                swID.x + 1,
+                swID.y + 1)}};
+
+    auto upsample = [textureCoordinateIndex = index,
+                     childIDs = std::move(childIDs)](
+                        const CesiumGltf::Model& model) {
+      return std::make_shared<UpsampledModels>(
+          upsampleGltfForRasterOverlayChildren(
+              model,
+              childIDs,
+              textureCoordinateIndex));
+    };
+
+    auto startUpsampling =
+        [&]() -> CesiumAsync::Future<std::shared_ptr<UpsampledModels>> {
+      if (!pParentRenderContent) {
+        // Keep the parent's upsampling source alive until it is upsampled.
+        return loadInput.asyncSystem.runInWorkerThread(
+            [pSource, upsample = std::move(upsample)]() {
+              return upsample(pSource->model);
+            });
+      }
+
+      // If the parent's CPU data was released after it was prepared for
+      // rendering, upsample from its full model instead, if it can be
+      // provided.
+      if (pParentRenderContent->isCpuDataReleased() &&
+          loadInput.contentOptions.reloadReleasedModel) {
+        return loadInput.contentOptions.reloadReleasedModel(*pParent)
+            .thenInWorkerThread(
+                [&parentModel, upsample = std::move(upsample)](
+                    std::optional<CesiumGltf::Model>&& maybeFullModel) {
+                  return upsample(
+                      maybeFullModel ? *maybeFullModel : parentModel);
+                });
+      }
+
+      return loadInput.asyncSystem.runInWorkerThread(
+          [&parentModel, upsample = std::move(upsample)]() {
+            return upsample(parentModel);
+          });
+    };
+
+    it = this->_upsampledChildren
+             .emplace(
+                 pParent,
+                 UpsampledChildren{
+                     &parentModel,
+                     index,
+                     startUpsampling().share(),
+                     {false, false, false, false},
+                     this->_generation})
+             .first;
   }
 
-  const CesiumGltf::Model& parentModel = pParentRenderContent->getModel();
-  return loadInput.asyncSystem.runInWorkerThread(
-      [&parentModel,
-       transform = loadInput.tile.getTransform(),
-       textureCoordinateIndex = index,
-       TileID = *pTileID]() mutable {
-        auto model = upsampleGltfForRasterOverlays(
-            parentModel,
-            TileID,
-            textureCoordinateIndex);
-        if (!model) {
-          return TileLoadResult::createFailedResult(nullptr);
-        }
-
-        return TileLoadResult{
-            std::move(*model),
-            CesiumGeometry::Axis::Y,
-            std::nullopt,
-            std::nullopt,
-            std::nullopt,
-            nullptr,
-            {},
-            TileLoadResultState::Success};
-      });
+  UpsampledChildren& upsampledChildren = it->second;
+  upsampledChildren.loaded[childIndex] = true;
+  upsampledChildren.lastUsedGeneration = this->_generation;
+
+  // Each child takes its own model, so it isn't copied.
+  CesiumAsync::Future<TileLoadResult> result =
+      upsampledChildren.models.thenImmediately(
+          [childIndex](const std::shared_ptr<UpsampledModels>& pModels) {
+            std::optional<CesiumGltf::Model>& upsampledModel =
+                (*pModels)[childIndex];
+            if (!upsampledModel) {
+              return TileLoadResult::createFailedResult(nullptr);
+            }
+
+            return TileLoadResult{
+                std::move(*upsampledModel),
+                CesiumGeometry::Axis::Y,
+                std::nullopt,
+                std::nullopt,
+                std::nullopt,
+                nullptr,
+                {},
+                TileLoadResultState::Success};
+          });
+
+  if (std::all_of(
+          upsampledChildren.loaded.begin(),
+          upsampledChildren.loaded.end(),
+          [](bool loaded) { return loaded; })) {
+    this->_upsampledChildren.erase(it);
+  }
+
+  return result;
 }
 
 TileChildrenResult
 RasterOverlayUpsampler::createTileChildren([[maybe_unused]] const Tile& tile) {
   return {{}, TileLoadResultState::Failed};
 }
+
+void RasterOverlayUpsampler::unloadLoaderData(int64_t /* maximumBytes */) {
+  for (auto it = this->_upsampledChildren.begin();
+       it != this->_upsampledChildren.end();) {
+    if (it->second.lastUsedGeneration == this->_generation) {
+      ++it;
+    } else {
+      it = this->_upsampledChildren.erase(it);
+    }
+  }
+
+  ++this->_generation;
+}
 } // namespace Cesium3DTilesSelection
@@ -1,13 +1,80 @@
 #pragma once
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumGltf/Model.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
+/**
+ * @brief What's needed to upsample the children of a tile for raster overlays
+ * after the tile's content is unloaded.
+ */
+struct TileUpsamplingSource {
+  /**
+   * @brief The compact copy of the tile's model, from
+   * {@link Cesium3DTilesContent::createGltfUpsamplingSource}.
+   */
+  CesiumGltf::Model model;
+
+  /**
+   * @brief The index of the overlay texture coordinates that divide the model.
+   */
+  int32_t textureCoordinateIndex;
+
+  /**
+   * @brief The number of bytes used by the source.
+   */
+  int64_t sizeBytes;
+};
+
 class RasterOverlayUpsampler : public TilesetContentLoader {
 public:
+  /**
+   * @brief Creates what's needed to upsample the children of the given tile
+   * after its content is unloaded.
+   *
+   * @return The upsampling source, or nullptr if the tile has no model to
+   * upsample.
+   */
+  static std::shared_ptr<const TileUpsamplingSource>
+  createUpsamplingSource(const Tile& tile);
+
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
+
+  /**
+   * @brief Releases the upsampled models of the children that weren't loaded
+   * since the previous call.
+   *
+   * The upsampled models aren't counted by {@link getLoaderDataBytes}, because
+   * they are only kept until the children are loaded, which is almost always
+   * in the same frame.
+   */
+  void unloadLoaderData(int64_t maximumBytes) override;
+
+private:
+  using UpsampledModels = std::vector<std::optional<CesiumGltf::Model>>;
+
+  // The models of all four children of a tile, which are upsampled together
+  // when the first of them is loaded, until the others are loaded too.
+  struct UpsampledChildren {
+    const CesiumGltf::Model* pParentModel;
+    int32_t textureCoordinateIndex;
+    CesiumAsync::SharedFuture<std::shared_ptr<UpsampledModels>> models;
+    std::array<bool, 4> loaded;
+    uint64_t lastUsedGeneration;
+  };
+
+  std::unordered_map<const Tile*, UpsampledChildren> _upsampledChildren;
+  uint64_t _generation = 0;
 };
 } // namespace Cesium3DTilesSelection
@@ -2,25 +2,105 @@
 
 #include "Cesium3DTilesSelection/Tile.h"
 #include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
-#include "TileUtilities.h"
+
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <optional>
 
 using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+namespace {
+
+std::vector<GlobeRectangle> getBoundingRectangles(
+    const std::vector<CartographicPolygon>& polygons,
+    std::vector<size_t>& polygonIndices) {
+  std::vector<GlobeRectangle> rectangles;
+  rectangles.reserve(polygons.size());
+  polygonIndices.reserve(polygons.size());
+
+  // A polygon without a bounding rectangle never contains or intersects a
+  // tile, so it is left out.
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    const std::optional<GlobeRectangle>& maybeRectangle =
+        polygons[i].getBoundingRectangle();
+    if (maybeRectangle) {
+      rectangles.emplace_back(*maybeRectangle);
+      polygonIndices.emplace_back(i);
+    }
+  }
+
+  return rectangles;
+}
+
+} // namespace
 
 RasterizedPolygonsTileExcluder::RasterizedPolygonsTileExcluder(
     const CesiumUtility::IntrusivePointer<
-        const CesiumRasterOverlays::RasterizedPolygonsOverlay>&
-        pOverlay) noexcept
-    : _pOverlay(pOverlay) {}
+        const CesiumRasterOverlays::RasterizedPolygonsOverlay>& pOverlay)
+    : _pOverlay(pOverlay), _polygonTree(), _polygonIndices() {
+  this->_polygonTree = GlobeRectangleTree(
+      getBoundingRectangles(pOverlay->getPolygons(), this->_polygonIndices));
+}
 
 bool RasterizedPolygonsTileExcluder::shouldExclude(
     const Tile& tile) const noexcept {
+  return this->checkExclusion(tile) == TileExclusionResult::Excluded;
+}
+
+TileExclusionResult RasterizedPolygonsTileExcluder::checkExclusion(
+    const Tile& tile) const noexcept {
+  std::optional<GlobeRectangle> maybeRectangle =
+      tile.getEstimatedGlobeRectangle();
+  if (!maybeRectangle) {
+    return TileExclusionResult::Included;
+  }
+
+  // The descendants of a tile are within its bounding volume, so they are no
+  // nearer to any polygon than the tile is.
+  std::vector<size_t> candidates;
+  this->_polygonTree.findIntersecting(*maybeRectangle, candidates);
+
+  const std::vector<CartographicPolygon>& polygons =
+      this->_pOverlay->getPolygons();
+
   if (this->_pOverlay->getInvertSelection()) {
-    return Cesium3DTilesSelection::CesiumImpl::outsidePolygons(
-        tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
-  } else {
-    return Cesium3DTilesSelection::CesiumImpl::withinPolygons(
-        tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
+    // Tiles outside of every polygon are excluded, and tiles completely inside
+    // of one are kept along with all of their descendants.
+    bool intersectsPolygon = false;
+    for (const size_t candidate : candidates) {
+      const CartographicPolygon& polygon =
+          polygons[this->_polygonIndices[candidate]];
+      if (polygon.containsRectangle(*maybeRectangle)) {
+        return TileExclusionResult::SubtreeIncluded;
+      }
+      if (!intersectsPolygon) {
+        intersectsPolygon = polygon.intersectsRectangle(*maybeRectangle);
+      }
+    }
+
+    return intersectsPolygon ? TileExclusionResult::Included
+                             : TileExclusionResult::Excluded;
+  }
+
+  // Tiles completely inside of a polygon are excluded, and tiles away from
+  // every polygon are kept along with all of their descendants.
+  if (candidates.empty()) {
+    return TileExclusionResult::SubtreeIncluded;
+  }
+
+  for (const size_t candidate : candidates) {
+    if (polygons[this->_polygonIndices[candidate]].containsRectangle(
+            *maybeRectangle)) {
+      return TileExclusionResult::Excluded;
+    }
   }
+
+  return TileExclusionResult::Included;
+}
+
+const CesiumRasterOverlays::RasterizedPolygonsOverlay&
+RasterizedPolygonsTileExcluder::getOverlay() const {
+  return *this->_pOverlay;
 }
@@ -0,0 +1,49 @@
+#include "Cesium3DTilesSelection/ScreenSpaceErrorTileEvictionPolicy.h"
+
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace Cesium3DTilesSelection;
+
+void ScreenSpaceErrorTileEvictionPolicy::orderForEviction(
+    const gsl::span<Tile*>& candidates,
+    const std::vector<ViewState>& frustums) {
+  if (frustums.empty()) {
+    return;
+  }
+
+  std::vector<std::pair<double, Tile*>> scored;
+  scored.reserve(candidates.size());
+  for (Tile* pTile : candidates) {
+    double largestError = 0.0;
+    for (const ViewState& frustum : frustums) {
+      const double distance =
+          std::sqrt(frustum.computeDistanceSquaredToBoundingVolume(
+              pTile->getBoundingVolume()));
+      largestError = std::max(
+          largestError,
+          frustum.computeScreenSpaceError(
+              pTile->getGeometricError(),
+              distance));
+    }
+    scored.emplace_back(largestError, pTile);
+  }
+
+  std::stable_sort(
+      scored.begin(),
+      scored.end(),
+      [](const std::pair<double, Tile*>& lhs,
+         const std::pair<double, Tile*>& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+  std::transform(
+      scored.begin(),
+      scored.end(),
+      candidates.begin(),
+      [](const std::pair<double, Tile*>& score) { return score.second; });
+}
@@ -0,0 +1,459 @@
+#include "Cesium3DTilesSelection/SoftwareTileOcclusionProxyPool.h"
+
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <variant>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// Geometry closer to the camera than this, in meters, is neither rasterized
+// nor tested, because its projection is unstable.
+const double nearDistance = 1.0;
+
+const float emptyDepth = std::numeric_limits<float>::max();
+
+class SoftwareTileOcclusionProxy : public TileOcclusionRendererProxy {
+public:
+  explicit SoftwareTileOcclusionProxy(
+      const SoftwareTileOcclusionProxyPool& pool) noexcept
+      : _pPool(&pool),
+        _pTile(nullptr),
+        _frameNumber(std::numeric_limits<uint64_t>::max()),
+        _state(TileOcclusionState::NotOccluded) {}
+
+  TileOcclusionState getOcclusionState() const override {
+    if (!this->_pTile) {
+      return TileOcclusionState::NotOccluded;
+    }
+
+    // The state only changes when the depth buffers of a new frame are built,
+    // so compute it at most once per frame.
+    const uint64_t frameNumber = this->_pPool->getFrameNumber();
+    if (this->_frameNumber != frameNumber) {
+      this->_state = this->_pPool->computeOcclusionState(*this->_pTile);
+      this->_frameNumber = frameNumber;
+    }
+
+    return this->_state;
+  }
+
+protected:
+  void reset(const Tile* pTile) override {
+    this->_pTile = pTile;
+    this->_frameNumber = std::numeric_limits<uint64_t>::max();
+  }
+
+private:
+  const SoftwareTileOcclusionProxyPool* _pPool;
+  const Tile* _pTile;
+  mutable uint64_t _frameNumber;
+  mutable TileOcclusionState _state;
+};
+} // namespace
+
+SoftwareTileOcclusionProxyPool::SoftwareTileOcclusionProxyPool(
+    int32_t maximumPoolSize,
+    uint32_t width,
+    uint32_t height,
+    int64_t maximumOccluderTriangles)
+    : TileOcclusionRendererProxyPool(maximumPoolSize),
+      _width(glm::max(width, 1U)),
+      _height(glm::max(height, 1U)),
+      _maximumOccluderTriangles(maximumOccluderTriangles),
+      _frameNumber(0),
+      _depthBuffers(),
+      _cameraSpacePositions() {}
+
+SoftwareTileOcclusionProxyPool::~SoftwareTileOcclusionProxyPool() noexcept {
+  // The base class can't call our destroyProxy once we're destroyed.
+  this->destroyPool();
+}
+
+void SoftwareTileOcclusionProxyPool::startNewFrame(
+    const std::vector<ViewState>& frustums,
+    const std::vector<Tile*>& tilesRenderedLastFrame) {
+  ++this->_frameNumber;
+
+  this->_depthBuffers.resize(frustums.size());
+  for (size_t i = 0; i < frustums.size(); ++i) {
+    const ViewState& frustum = frustums[i];
+    DepthBuffer& buffer = this->_depthBuffers[i];
+
+    buffer.position = frustum.getPosition();
+    buffer.direction = glm::normalize(frustum.getDirection());
+    buffer.up = glm::normalize(
+        frustum.getUp() -
+        glm::dot(frustum.getUp(), buffer.direction) * buffer.direction);
+    buffer.right = glm::cross(buffer.direction, buffer.up);
+    buffer.xScale = 1.0 / glm::tan(frustum.getHorizontalFieldOfView() * 0.5);
+    buffer.yScale = 1.0 / glm::tan(frustum.getVerticalFieldOfView() * 0.5);
+
+    // The sizes of the levels only depend on the size of the buffer, so the
+    // levels are allocated once and reused by every frame.
+    if (buffer.levels.empty()) {
+      uint32_t levelWidth = this->_width;
+      uint32_t levelHeight = this->_height;
+      for (;;) {
+        buffer.widths.push_back(levelWidth);
+        buffer.heights.push_back(levelHeight);
+        buffer.levels.emplace_back(size_t(levelWidth) * levelHeight);
+        if (levelWidth == 1 && levelHeight == 1) {
+          break;
+        }
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+      }
+    }
+
+    std::fill(buffer.levels[0].begin(), buffer.levels[0].end(), emptyDepth);
+  }
+
+  if (this->_depthBuffers.empty()) {
+    return;
+  }
+
+  int64_t remainingTriangles = this->_maximumOccluderTriangles;
+  for (const Tile* pTile : tilesRenderedLastFrame) {
+    if (remainingTriangles <= 0) {
+      break;
+    }
+    if (pTile) {
+      this->rasterizeTile(*pTile, remainingTriangles);
+    }
+  }
+
+  // Each texel of a level is the maximum depth of the 2x2 texels below it. At
+  // odd sizes, the last row and column only cover a single texel.
+  for (DepthBuffer& buffer : this->_depthBuffers) {
+    for (size_t level = 1; level < buffer.levels.size(); ++level) {
+      const std::vector<float>& source = buffer.levels[level - 1];
+      std::vector<float>& target = buffer.levels[level];
+      const uint32_t sourceWidth = buffer.widths[level - 1];
+      const uint32_t sourceHeight = buffer.heights[level - 1];
+      const uint32_t targetWidth = buffer.widths[level];
+      const uint32_t targetHeight = buffer.heights[level];
+
+      for (uint32_t y = 0; y < targetHeight; ++y) {
+        const size_t y0 = size_t(2 * y) * sourceWidth;
+        const size_t y1 =
+            size_t(glm::min(2 * y + 1, sourceHeight - 1)) * sourceWidth;
+        for (uint32_t x = 0; x < targetWidth; ++x) {
+          const size_t x0 = 2 * x;
+          const size_t x1 = glm::min(2 * x + 1, sourceWidth - 1);
+          target[size_t(y) * targetWidth + x] = glm::max(
+              glm::max(source[y0 + x0], source[y0 + x1]),
+              glm::max(source[y1 + x0], source[y1 + x1]));
+        }
+      }
+    }
+  }
+}
+
+TileOcclusionState SoftwareTileOcclusionProxyPool::computeOcclusionState(
+    const Tile& tile) const {
+  if (this->_depthBuffers.empty()) {
+    return TileOcclusionState::NotOccluded;
+  }
+
+  const CesiumGeometry::OrientedBoundingBox box =
+      getOrientedBoundingBoxFromBoundingVolume(tile.getBoundingVolume());
+  const glm::dvec3& center = box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  std::vector<glm::dvec3> corners;
+  corners.reserve(8);
+  for (int i = 0; i < 8; ++i) {
+    corners.emplace_back(
+        center + ((i & 1) ? halfAxes[0] : -halfAxes[0]) +
+        ((i & 2) ? halfAxes[1] : -halfAxes[1]) +
+        ((i & 4) ? halfAxes[2] : -halfAxes[2]));
+  }
+
+  for (const DepthBuffer& buffer : this->_depthBuffers) {
+    if (!isOccluded(buffer, corners)) {
+      return TileOcclusionState::NotOccluded;
+    }
+  }
+
+  return TileOcclusionState::Occluded;
+}
+
+TileOcclusionRendererProxy* SoftwareTileOcclusionProxyPool::createProxy() {
+  return new SoftwareTileOcclusionProxy(*this);
+}
+
+void SoftwareTileOcclusionProxyPool::destroyProxy(
+    TileOcclusionRendererProxy* pProxy) {
+  // The proxy doesn't have a virtual destructor.
+  delete static_cast<SoftwareTileOcclusionProxy*>(pProxy);
+}
+
+void SoftwareTileOcclusionProxyPool::rasterizeTile(
+    const Tile& tile,
+    int64_t& remainingTriangles) {
+  if (tile.getState() != TileLoadState::Done) {
+    return;
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent) {
+    return;
+  }
+
+  const Model& model = pRenderContent->getModel();
+  const glm::dmat4 rootTransform = GltfUtilities::applyGltfUpAxisTransform(
+      model,
+      GltfUtilities::applyRtcCenter(model, tile.getTransform()));
+
+  // Pushing each triangle back by the geometric error of its tile keeps the
+  // tile from hiding its own children, which may extend beyond it by up to
+  // that error.
+  const double depthOffset = tile.getGeometricError();
+
+  model.forEachPrimitiveInScene(
+      -1,
+      [this, &rootTransform, depthOffset, &remainingTriangles](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        if (remainingTriangles <= 0) {
+          return;
+        }
+
+        if (primitive.mode != MeshPrimitive::Mode::TRIANGLES &&
+            primitive.mode != MeshPrimitive::Mode::TRIANGLE_STRIP &&
+            primitive.mode != MeshPrimitive::Mode::TRIANGLE_FAN) {
+          return;
+        }
+
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const Accessor* pPositionAccessor =
+            Model::getSafe(&gltf.accessors, positionIt->second);
+        if (!pPositionAccessor) {
+          return;
+        }
+
+        const QuantizedPositionAccessorType positionView =
+            getQuantizedPositionAccessorView(gltf, primitive);
+        if (std::visit(StatusFromAccessor{}, positionView) !=
+            AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const IndexAccessorType indexView =
+            getIndexAccessorView(gltf, primitive);
+        const bool hasIndices =
+            !std::holds_alternative<std::monostate>(indexView);
+        if (hasIndices && std::visit(StatusFromAccessor{}, indexView) !=
+                              AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const int64_t vertexCount =
+            std::visit(CountFromAccessor{}, positionView);
+        const int64_t indexCount =
+            hasIndices ? std::visit(CountFromAccessor{}, indexView)
+                       : vertexCount;
+        const int64_t faceCount =
+            primitive.mode == MeshPrimitive::Mode::TRIANGLES
+                ? indexCount / 3
+                : glm::max(indexCount - 2, int64_t(0));
+
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+        const bool normalized = pPositionAccessor->normalized;
+
+        for (DepthBuffer& buffer : this->_depthBuffers) {
+          // Project every vertex once, as (pixel x, pixel y, view depth).
+          std::vector<glm::dvec3>& projected = this->_cameraSpacePositions;
+          projected.resize(static_cast<size_t>(vertexCount));
+          std::visit(
+              [&](const auto& view) {
+                for (int64_t i = 0; i < vertexCount; ++i) {
+                  const std::optional<glm::vec3> maybePosition =
+                      PositionFromAccessor{i, normalized}(view);
+                  if (!maybePosition) {
+                    // Treated like a vertex behind the camera.
+                    projected[static_cast<size_t>(i)] = glm::dvec3(0.0);
+                    continue;
+                  }
+
+                  const glm::dvec3 offset =
+                      glm::dvec3(
+                          fullTransform * glm::dvec4(*maybePosition, 1.0)) -
+                      buffer.position;
+                  const double z = glm::dot(offset, buffer.direction);
+                  const double x =
+                      glm::dot(offset, buffer.right) * buffer.xScale / z;
+                  const double y =
+                      glm::dot(offset, buffer.up) * buffer.yScale / z;
+                  projected[static_cast<size_t>(i)] = glm::dvec3(
+                      (x * 0.5 + 0.5) * this->_width,
+                      (y * 0.5 + 0.5) * this->_height,
+                      z);
+                }
+              },
+              positionView);
+
+          std::vector<float>& depths = buffer.levels[0];
+          const int64_t faceLimit = glm::min(faceCount, remainingTriangles);
+          for (int64_t face = 0; face < faceLimit; ++face) {
+            const std::array<int64_t, 3> indices = std::visit(
+                IndicesForFaceFromAccessor{face, vertexCount, primitive.mode},
+                indexView);
+            if (indices[0] < 0 || indices[1] < 0 || indices[2] < 0 ||
+                indices[0] >= vertexCount || indices[1] >= vertexCount ||
+                indices[2] >= vertexCount) {
+              continue;
+            }
+
+            const glm::dvec3& a = projected[static_cast<size_t>(indices[0])];
+            const glm::dvec3& b = projected[static_cast<size_t>(indices[1])];
+            const glm::dvec3& c = projected[static_cast<size_t>(indices[2])];
+            if (a.z < nearDistance || b.z < nearDistance ||
+                c.z < nearDistance) {
+              continue;
+            }
+
+            const double area =
+                (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+            if (area == 0.0) {
+              continue;
+            }
+            const double sign = area > 0.0 ? 1.0 : -1.0;
+
+            // Cover the pixels whose centers are inside the triangle.
+            const double firstX =
+                std::ceil(glm::min(glm::min(a.x, b.x), c.x) - 0.5);
+            const double firstY =
+                std::ceil(glm::min(glm::min(a.y, b.y), c.y) - 0.5);
+            const double lastX = glm::min(
+                std::floor(glm::max(glm::max(a.x, b.x), c.x) - 0.5),
+                double(this->_width - 1));
+            const double lastY = glm::min(
+                std::floor(glm::max(glm::max(a.y, b.y), c.y) - 0.5),
+                double(this->_height - 1));
+            if (lastX < 0.0 || lastY < 0.0 || firstX > lastX ||
+                firstY > lastY) {
+              continue;
+            }
+
+            const float depth = static_cast<float>(
+                glm::max(glm::max(a.z, b.z), c.z) + depthOffset);
+
+            const uint32_t x0 = static_cast<uint32_t>(glm::max(firstX, 0.0));
+            const uint32_t x1 = static_cast<uint32_t>(lastX);
+            const uint32_t y0 = static_cast<uint32_t>(glm::max(firstY, 0.0));
+            const uint32_t y1 = static_cast<uint32_t>(lastY);
+            for (uint32_t py = y0; py <= y1; ++py) {
+              const double sy = double(py) + 0.5;
+              for (uint32_t px = x0; px <= x1; ++px) {
+                const double sx = double(px) + 0.5;
+                const double w0 = sign * ((b.x - a.x) * (sy - a.y) -
+                                          (b.y - a.y) * (sx - a.x));
+                const double w1 = sign * ((c.x - b.x) * (sy - b.y) -
+                                          (c.y - b.y) * (sx - b.x));
+                const double w2 = sign * ((a.x - c.x) * (sy - c.y) -
+                                          (a.y - c.y) * (sx - c.x));
+                if (w0 >= 0.0 && w1 >= 0.0 && w2 >= 0.0) {
+                  float& pixel = depths[size_t(py) * this->_width + px];
+                  pixel = glm::min(pixel, depth);
+                }
+              }
+            }
+          }
+        }
+
+        remainingTriangles -= glm::min(faceCount, remainingTriangles);
+      });
+}
+
+bool SoftwareTileOcclusionProxyPool::isOccluded(
+    const DepthBuffer& buffer,
+    const std::vector<glm::dvec3>& corners) noexcept {
+  double minX = std::numeric_limits<double>::max();
+  double minY = std::numeric_limits<double>::max();
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = std::numeric_limits<double>::lowest();
+  double minZ = std::numeric_limits<double>::max();
+
+  for (const glm::dvec3& corner : corners) {
+    const glm::dvec3 offset = corner - buffer.position;
+    const double z = glm::dot(offset, buffer.direction);
+    if (z < nearDistance) {
+      // The volume is too close to or behind the camera.
+      return false;
+    }
+
+    const double x = glm::dot(offset, buffer.right) * buffer.xScale / z;
+    const double y = glm::dot(offset, buffer.up) * buffer.yScale / z;
+    minX = glm::min(minX, x);
+    minY = glm::min(minY, y);
+    maxX = glm::max(maxX, x);
+    maxY = glm::max(maxY, y);
+    minZ = glm::min(minZ, z);
+  }
+
+  const double width = double(buffer.widths[0]);
+  const double height = double(buffer.heights[0]);
+  minX = (minX * 0.5 + 0.5) * width;
+  maxX = (maxX * 0.5 + 0.5) * width;
+  minY = (minY * 0.5 + 0.5) * height;
+  maxY = (maxY * 0.5 + 0.5) * height;
+  if (maxX < 0.0 || maxY < 0.0 || minX >= width || minY >= height) {
+    // Outside of this frustum, so not hidden by anything in it.
+    return false;
+  }
+
+  uint32_t x0 = static_cast<uint32_t>(glm::clamp(minX, 0.0, width - 1.0));
+  uint32_t x1 = static_cast<uint32_t>(glm::clamp(maxX, 0.0, width - 1.0));
+  uint32_t y0 = static_cast<uint32_t>(glm::clamp(minY, 0.0, height - 1.0));
+  uint32_t y1 = static_cast<uint32_t>(glm::clamp(maxY, 0.0, height - 1.0));
+
+  // Use the first level at which the rectangle covers at most 2x2 texels.
+  size_t level = 0;
+  while (level + 1 < buffer.levels.size() && (x1 - x0 > 1 || y1 - y0 > 1)) {
+    x0 /= 2;
+    x1 /= 2;
+    y0 /= 2;
+    y1 /= 2;
+    ++level;
+  }
+
+  const std::vector<float>& depths = buffer.levels[level];
+  const uint32_t levelWidth = buffer.widths[level];
+  for (uint32_t y = y0; y <= y1; ++y) {
+    for (uint32_t x = x0; x <= x1; ++x) {
+      if (double(depths[size_t(y) * levelWidth + x]) >= minZ) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,164 @@
+#include "SubtreeAvailabilityCache.h"
+
+#include <iterator>
+#include <utility>
+
+using namespace Cesium3DTilesContent;
+
+namespace Cesium3DTilesSelection {
+namespace {
+int64_t computeSizeBytes(const SubtreeAvailability& subtreeAvailability) {
+  int64_t bytes = int64_t(sizeof(SubtreeAvailability));
+  for (const Cesium3DTiles::Buffer& buffer :
+       subtreeAvailability.getSubtree().buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+
+  return bytes;
+}
+} // namespace
+
+SubtreeAvailabilityCache::SubtreeAvailabilityCache(size_t subtreeLevelCount)
+    : _entries{},
+      _index(subtreeLevelCount),
+      _completedSubtrees(subtreeLevelCount),
+      _loadingSubtrees(subtreeLevelCount),
+      _sizeBytes{0},
+      _generation{0} {}
+
+size_t SubtreeAvailabilityCache::getSubtreeLevelCount() const noexcept {
+  return this->_index.size();
+}
+
+SubtreeAvailability* SubtreeAvailabilityCache::find(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex) noexcept {
+  if (subtreeLevelIndex >= this->_index.size()) {
+    return nullptr;
+  }
+
+  auto& levelIndex = this->_index[subtreeLevelIndex];
+  auto indexIt = levelIndex.find(subtreeMortonIndex);
+  if (indexIt == levelIndex.end()) {
+    return nullptr;
+  }
+
+  this->markUsed(indexIt->second);
+  return &indexIt->second->availability;
+}
+
+void SubtreeAvailabilityCache::add(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex,
+    SubtreeAvailability&& subtreeAvailability) {
+  if (subtreeLevelIndex >= this->_index.size()) {
+    return;
+  }
+
+  this->_loadingSubtrees[subtreeLevelIndex].erase(subtreeMortonIndex);
+
+  const int64_t sizeBytes = computeSizeBytes(subtreeAvailability);
+
+  auto& levelIndex = this->_index[subtreeLevelIndex];
+  auto indexIt = levelIndex.find(subtreeMortonIndex);
+  if (indexIt != levelIndex.end()) {
+    Entry& entry = *indexIt->second;
+    this->_sizeBytes += sizeBytes - entry.sizeBytes;
+    entry.availability = std::move(subtreeAvailability);
+    entry.sizeBytes = sizeBytes;
+    this->markUsed(indexIt->second);
+    return;
+  }
+
+  // Only the root tile of a subtree that was never loaded has its children
+  // still to be created.
+  const bool isCompleted =
+      this->_completedSubtrees[subtreeLevelIndex].count(subtreeMortonIndex) >
+      0;
+
+  this->_entries.emplace_back(Entry{
+      subtreeLevelIndex,
+      subtreeMortonIndex,
+      std::move(subtreeAvailability),
+      sizeBytes,
+      isCompleted ? size_t(0) : size_t(1),
+      this->_generation});
+  levelIndex.emplace(subtreeMortonIndex, std::prev(this->_entries.end()));
+  this->_sizeBytes += sizeBytes;
+}
+
+bool SubtreeAvailabilityCache::isLoading(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex) const noexcept {
+  return subtreeLevelIndex < this->_loadingSubtrees.size() &&
+         this->_loadingSubtrees[subtreeLevelIndex].count(subtreeMortonIndex) >
+             0;
+}
+
+void SubtreeAvailabilityCache::markLoading(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex) {
+  if (subtreeLevelIndex < this->_loadingSubtrees.size()) {
+    this->_loadingSubtrees[subtreeLevelIndex].insert(subtreeMortonIndex);
+  }
+}
+
+void SubtreeAvailabilityCache::markLoadFailed(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex) {
+  if (subtreeLevelIndex < this->_loadingSubtrees.size()) {
+    this->_loadingSubtrees[subtreeLevelIndex].erase(subtreeMortonIndex);
+  }
+}
+
+void SubtreeAvailabilityCache::markTileChildrenCreated(
+    uint32_t subtreeLevelIndex,
+    uint64_t subtreeMortonIndex,
+    size_t childrenInSubtree) {
+  if (subtreeLevelIndex >= this->_index.size()) {
+    return;
+  }
+
+  auto& levelIndex = this->_index[subtreeLevelIndex];
+  auto indexIt = levelIndex.find(subtreeMortonIndex);
+  if (indexIt == levelIndex.end()) {
+    return;
+  }
+
+  Entry& entry = *indexIt->second;
+  entry.tilesAwaitingChildren += childrenInSubtree;
+  if (entry.tilesAwaitingChildren > 0) {
+    --entry.tilesAwaitingChildren;
+  }
+
+  if (entry.tilesAwaitingChildren == 0) {
+    this->_completedSubtrees[subtreeLevelIndex].insert(subtreeMortonIndex);
+  }
+}
+
+int64_t SubtreeAvailabilityCache::getSizeBytes() const noexcept {
+  return this->_sizeBytes;
+}
+
+void SubtreeAvailabilityCache::unload(int64_t maximumBytes) {
+  auto it = this->_entries.begin();
+  while (this->_sizeBytes > maximumBytes && it != this->_entries.end()) {
+    if (it->tilesAwaitingChildren > 0 ||
+        it->lastUsedGeneration == this->_generation) {
+      ++it;
+      continue;
+    }
+
+    this->_sizeBytes -= it->sizeBytes;
+    this->_index[it->levelIndex].erase(it->mortonIndex);
+    it = this->_entries.erase(it);
+  }
+
+  ++this->_generation;
+}
+
+void SubtreeAvailabilityCache::markUsed(EntryList::iterator it) noexcept {
+  it->lastUsedGeneration = this->_generation;
+  this->_entries.splice(this->_entries.end(), this->_entries, it);
+}
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Cesium3DTilesContent/SubtreeAvailability.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief The availability of the subtrees of an implicit tileset that are
+ * loaded, in least-recently-used order, so that the ones that no tile needs
+ * can be unloaded and loaded again later.
+ *
+ * A subtree is needed until the children of each of its tiles have been
+ * created, because {@link TilesetContentLoader::createTileChildren} can't load
+ * it again. After that, only loading the content of one of its tiles needs it,
+ * which loads it again first if it was unloaded.
+ */
+class SubtreeAvailabilityCache {
+public:
+  /**
+   * @brief Creates an empty cache for the subtrees of an implicit tileset that
+   * has the given number of levels of subtrees.
+   */
+  explicit SubtreeAvailabilityCache(size_t subtreeLevelCount);
+
+  /**
+   * @brief Gets the number of levels of subtrees.
+   */
+  size_t getSubtreeLevelCount() const noexcept;
+
+  /**
+   * @brief Finds a loaded subtree and marks it as the most recently used.
+   *
+   * @param subtreeLevelIndex The level of the subtree divided by the number of
+   * levels in each subtree.
+   * @param subtreeMortonIndex The Morton index of the root tile of the subtree.
+   * @return The availability of the subtree, or nullptr if it isn't loaded.
+   */
+  Cesium3DTilesContent::SubtreeAvailability*
+  find(uint32_t subtreeLevelIndex, uint64_t subtreeMortonIndex) noexcept;
+
+  /**
+   * @brief Adds a loaded subtree as the most recently used, replacing the
+   * subtree with the same index if there is one.
+   */
+  void add(
+      uint32_t subtreeLevelIndex,
+      uint64_t subtreeMortonIndex,
+      Cesium3DTilesContent::SubtreeAvailability&& subtreeAvailability);
+
+  /**
+   * @brief Determines whether the given subtree is being loaded.
+   */
+  bool isLoading(uint32_t subtreeLevelIndex, uint64_t subtreeMortonIndex)
+      const noexcept;
+
+  /**
+   * @brief Records that the given subtree is being loaded, until it is added
+   * or {@link markLoadFailed} is called for it.
+   */
+  void markLoading(uint32_t subtreeLevelIndex, uint64_t subtreeMortonIndex);
+
+  /**
+   * @brief Records that the load of the given subtree failed.
+   */
+  void markLoadFailed(uint32_t subtreeLevelIndex, uint64_t subtreeMortonIndex);
+
+  /**
+   * @brief Records that the children of one of the tiles of a subtree were
+   * created.
+   *
+   * @param subtreeLevelIndex The level index of the subtree.
+   * @param subtreeMortonIndex The Morton index of the subtree.
+   * @param childrenInSubtree The number of those children that are in the same
+   * subtree, rather than roots of child subtrees, and so need it to create
+   * their own children.
+   */
+  void markTileChildrenCreated(
+      uint32_t subtreeLevelIndex,
+      uint64_t subtreeMortonIndex,
+      size_t childrenInSubtree);
+
+  /**
+   * @brief Gets the number of bytes used by the loaded subtrees.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+  /**
+   * @brief Unloads the least recently used subtrees that no tile needs until at
+   * most `maximumBytes` remain or no more can be unloaded.
+   *
+   * The subtrees used since the previous call are kept, so that a subtree that
+   * was just loaded for a tile is still there when the tile's load is retried.
+   */
+  void unload(int64_t maximumBytes);
+
+private:
+  struct Entry {
+    uint32_t levelIndex;
+    uint64_t mortonIndex;
+    Cesium3DTilesContent::SubtreeAvailability availability;
+    int64_t sizeBytes;
+    size_t tilesAwaitingChildren;
+    uint64_t lastUsedGeneration;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void markUsed(EntryList::iterator it) noexcept;
+
+  // The entries from least to most recently used, and their index by level and
+  // Morton index.
+  EntryList _entries;
+  std::vector<std::unordered_map<uint64_t, EntryList::iterator>> _index;
+
+  // The subtrees, by level and Morton index, whose tiles all have their
+  // children created, so that loading one of them again doesn't make it wait
+  // for children that already exist.
+  std::vector<std::unordered_set<uint64_t>> _completedSubtrees;
+
+  // The subtrees, by level and Morton index, that are being loaded.
+  std::vector<std::unordered_set<uint64_t>> _loadingSubtrees;
+
+  int64_t _sizeBytes;
+  uint64_t _generation;
+};
+} // namespace Cesium3DTilesSelection
@@ -45,36 +45,58 @@ Tile::Tile(
     TileContentArgs&&... args)
     : _pParent(nullptr),
       _children(),
-      _id(""s),
+      _geometricError(0.0),
+      _lastSelectionState(),
+      _refine(TileRefine::Replace),
+      _loadState{loadState},
+      _isFadingOut(false),
       _boundingVolume(OrientedBoundingBox(glm::dvec3(), glm::dmat3())),
+      _globeRectangleState(GlobeRectangleState::NotEstimated),
+      _globeRectangle(),
+      _id(""s),
       _viewerRequestVolume(),
       _contentBoundingVolume(),
-      _geometricError(0.0),
-      _refine(TileRefine::Replace),
       _transform(1.0),
-      _lastSelectionState(),
       _loadedTilesLinks(),
       _content{std::forward<TileContentArgs>(args)...},
       _pLoader{pLoader},
-      _loadState{loadState},
-      _shouldContentContinueUpdating{true} {}
+      _shouldContentContinueUpdating{true},
+      _lastLoadDuration(0.0),
+      _temporaryFailureCount(0),
+      _lastTemporaryFailureTime(),
+      _cpuByteSize(0),
+      _gpuByteSize(0),
+      _pUpsamplingSource() {}
 
 Tile::Tile(Tile&& rhs) noexcept
     : _pParent(rhs._pParent),
       _children(std::move(rhs._children)),
-      _id(std::move(rhs._id)),
+      _geometricError(rhs._geometricError),
+      _lastSelectionState(rhs._lastSelectionState),
+      _refine(rhs._refine),
+      _loadState{rhs._loadState},
+      _isFadingOut(rhs._isFadingOut),
       _boundingVolume(rhs._boundingVolume),
+      _globeRectangleState(
+          rhs._globeRectangleState.load(std::memory_order_acquire) ==
+                  GlobeRectangleState::Estimated
+              ? GlobeRectangleState::Estimated
+              : GlobeRectangleState::NotEstimated),
+      _globeRectangle(rhs._globeRectangle),
+      _id(std::move(rhs._id)),
       _viewerRequestVolume(rhs._viewerRequestVolume),
       _contentBoundingVolume(rhs._contentBoundingVolume),
-      _geometricError(rhs._geometricError),
-      _refine(rhs._refine),
       _transform(rhs._transform),
-      _lastSelectionState(rhs._lastSelectionState),
       _loadedTilesLinks(),
       _content(std::move(rhs._content)),
       _pLoader{rhs._pLoader},
-      _loadState{rhs._loadState},
-      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating} {
+      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating},
+      _lastLoadDuration(rhs._lastLoadDuration),
+      _temporaryFailureCount(rhs._temporaryFailureCount),
+      _lastTemporaryFailureTime(rhs._lastTemporaryFailureTime),
+      _cpuByteSize(rhs._cpuByteSize),
+      _gpuByteSize(rhs._gpuByteSize),
+      _pUpsamplingSource(std::move(rhs._pUpsamplingSource)) {
   // since children of rhs will have the parent pointed to rhs,
   // we will reparent them to this tile as rhs will be destroyed after this
   for (Tile& tile : this->_children) {
@@ -96,6 +118,13 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
 
     this->_id = std::move(rhs._id);
     this->_boundingVolume = rhs._boundingVolume;
+    this->_globeRectangle = rhs._globeRectangle;
+    this->_globeRectangleState.store(
+        rhs._globeRectangleState.load(std::memory_order_acquire) ==
+                GlobeRectangleState::Estimated
+            ? GlobeRectangleState::Estimated
+            : GlobeRectangleState::NotEstimated,
+        std::memory_order_relaxed);
     this->_viewerRequestVolume = rhs._viewerRequestVolume;
     this->_contentBoundingVolume = rhs._contentBoundingVolume;
     this->_geometricError = rhs._geometricError;
@@ -105,7 +134,14 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
     this->_content = std::move(rhs._content);
     this->_pLoader = rhs._pLoader;
     this->_loadState = rhs._loadState;
+    this->_isFadingOut = rhs._isFadingOut;
     this->_shouldContentContinueUpdating = rhs._shouldContentContinueUpdating;
+    this->_lastLoadDuration = rhs._lastLoadDuration;
+    this->_temporaryFailureCount = rhs._temporaryFailureCount;
+    this->_lastTemporaryFailureTime = rhs._lastTemporaryFailureTime;
+    this->_cpuByteSize = rhs._cpuByteSize;
+    this->_gpuByteSize = rhs._gpuByteSize;
+    this->_pUpsamplingSource = std::move(rhs._pUpsamplingSource);
   }
 
   return *this;
@@ -150,6 +186,31 @@ double Tile::getNonZeroGeometricError() const noexcept {
   return Math::Epsilon5;
 }
 
+std::optional<GlobeRectangle> Tile::getEstimatedGlobeRectangle() const {
+  uint8_t state = this->_globeRectangleState.load(std::memory_order_acquire);
+  if (state == GlobeRectangleState::Estimated) {
+    return this->_globeRectangle;
+  }
+
+  std::optional<GlobeRectangle> rectangle =
+      estimateGlobeRectangle(this->_boundingVolume);
+
+  // Only one thread stores the estimate. Any other thread that needs it in
+  // the meantime returns the one it computed itself.
+  if (state == GlobeRectangleState::NotEstimated &&
+      this->_globeRectangleState.compare_exchange_strong(
+          state,
+          GlobeRectangleState::Estimating,
+          std::memory_order_relaxed)) {
+    this->_globeRectangle = rectangle;
+    this->_globeRectangleState.store(
+        GlobeRectangleState::Estimated,
+        std::memory_order_release);
+  }
+
+  return rectangle;
+}
+
 int64_t Tile::computeByteSize() const noexcept {
   int64_t bytes = 0;
 
@@ -235,4 +296,8 @@ void Tile::setContentShouldContinueUpdating(
     bool shouldContentContinueUpdating) noexcept {
   this->_shouldContentContinueUpdating = shouldContentContinueUpdating;
 }
+
+void Tile::setLastLoadDuration(double lastLoadDuration) noexcept {
+  this->_lastLoadDuration = lastLoadDuration;
+}
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,144 @@
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileBoundsBuffer.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+
+#include <algorithm>
+#include <variant>
+
+using namespace CesiumGeometry;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+bool boundsEqual(const TileBounds& lhs, const TileBounds& rhs) noexcept {
+  return lhs.center == rhs.center && lhs.radius == rhs.radius &&
+         lhs.halfAxisX == rhs.halfAxisX &&
+         lhs.geometricError == rhs.geometricError &&
+         lhs.halfAxisY == rhs.halfAxisY &&
+         lhs.parentIndex == rhs.parentIndex &&
+         lhs.halfAxisZ == rhs.halfAxisZ && lhs.occupied == rhs.occupied;
+}
+
+TileBounds computeTileBounds(
+    const Tile& tile,
+    const glm::dvec3& center,
+    int32_t parentIndex) {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+  const OrientedBoundingBox box =
+      getOrientedBoundingBoxFromBoundingVolume(boundingVolume);
+
+  // A sphere's own radius is tighter than that of the box around it.
+  const BoundingSphere* pSphere = std::get_if<BoundingSphere>(&boundingVolume);
+  const BoundingSphere sphere = pSphere ? *pSphere : box.toSphere();
+
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  TileBounds bounds;
+  bounds.center = glm::vec3(sphere.getCenter() - center);
+  bounds.radius = static_cast<float>(sphere.getRadius());
+  bounds.halfAxisX = glm::vec3(halfAxes[0]);
+  bounds.geometricError = static_cast<float>(tile.getGeometricError());
+  bounds.halfAxisY = glm::vec3(halfAxes[1]);
+  bounds.parentIndex = parentIndex;
+  bounds.halfAxisZ = glm::vec3(halfAxes[2]);
+  bounds.occupied = 1;
+  return bounds;
+}
+} // namespace
+
+TileBoundsBuffer::TileBoundsBuffer(const glm::dvec3& center)
+    : _center(center),
+      _rewriteAll(false),
+      _bounds(),
+      _tiles(),
+      _freeSlots(),
+      _changedSlots(),
+      _slots() {}
+
+void TileBoundsBuffer::setCenter(const glm::dvec3& center) noexcept {
+  if (center != this->_center) {
+    this->_center = center;
+    this->_rewriteAll = true;
+  }
+}
+
+void TileBoundsBuffer::update(gsl::span<const Tile* const> tiles) {
+  this->_changedSlots.clear();
+
+  // Find the tiles that are already in the buffer, and free the slots of the
+  // tiles that are not in the new set.
+  std::vector<uint8_t> kept(this->_tiles.size(), 0);
+  std::vector<const Tile*> addedTiles;
+  for (const Tile* pTile : tiles) {
+    auto it = this->_slots.find(pTile);
+    if (it != this->_slots.end()) {
+      kept[it->second] = 1;
+    } else {
+      addedTiles.emplace_back(pTile);
+    }
+  }
+
+  for (uint32_t slot = 0; slot < kept.size(); ++slot) {
+    if (kept[slot] || this->_tiles[slot] == nullptr) {
+      continue;
+    }
+
+    this->_slots.erase(this->_tiles[slot]);
+    this->_tiles[slot] = nullptr;
+    this->_bounds[slot] = TileBounds();
+    this->_freeSlots.emplace_back(slot);
+    this->_changedSlots.emplace_back(slot);
+  }
+
+  for (const Tile* pTile : addedTiles) {
+    uint32_t slot;
+    if (!this->_freeSlots.empty()) {
+      slot = this->_freeSlots.back();
+      this->_freeSlots.pop_back();
+      this->_tiles[slot] = pTile;
+    } else {
+      slot = static_cast<uint32_t>(this->_tiles.size());
+      this->_tiles.emplace_back(pTile);
+      this->_bounds.emplace_back();
+    }
+    this->_slots.emplace(pTile, slot);
+  }
+
+  // Bring the bounds of every tile up to date. A tile's bounding volume and
+  // geometric error can change when its content loads, and its parent slot
+  // changes when its ancestors are added or removed.
+  for (const Tile* pTile : tiles) {
+    const Tile* pParent = pTile->getParent();
+    auto parentIt = this->_slots.end();
+    while (pParent) {
+      parentIt = this->_slots.find(pParent);
+      if (parentIt != this->_slots.end()) {
+        break;
+      }
+      pParent = pParent->getParent();
+    }
+
+    const int32_t parentIndex = parentIt != this->_slots.end()
+                                    ? static_cast<int32_t>(parentIt->second)
+                                    : -1;
+
+    const uint32_t slot = this->_slots[pTile];
+    const TileBounds bounds =
+        computeTileBounds(*pTile, this->_center, parentIndex);
+    if (this->_rewriteAll || !boundsEqual(bounds, this->_bounds[slot])) {
+      this->_bounds[slot] = bounds;
+      this->_changedSlots.emplace_back(slot);
+    }
+  }
+
+  this->_rewriteAll = false;
+
+  std::sort(this->_changedSlots.begin(), this->_changedSlots.end());
+  this->_changedSlots.erase(
+      std::unique(this->_changedSlots.begin(), this->_changedSlots.end()),
+      this->_changedSlots.end());
+}
+
+} // namespace Cesium3DTilesSelection
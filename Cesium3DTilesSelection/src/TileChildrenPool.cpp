@@ -0,0 +1,102 @@
+#include "TileChildrenPool.h"
+
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+bool isBlock(const std::vector<Tile>& children) noexcept {
+  for (size_t blockSize : TileChildrenPool::BlockSizes) {
+    if (children.capacity() == blockSize) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+TileChildrenPool::TileChildrenPool(size_t maximumBlocksPerSize) noexcept
+    : _blocks(), _maximumBlocksPerSize(maximumBlocksPerSize) {}
+
+std::vector<Tile> TileChildrenPool::acquire(size_t count) {
+  for (size_t i = 0; i < BlockSizeCount; ++i) {
+    if (count > BlockSizes[i]) {
+      continue;
+    }
+
+    std::vector<std::vector<Tile>>& blocks = this->_blocks[i];
+    if (!blocks.empty()) {
+      std::vector<Tile> block = std::move(blocks.back());
+      blocks.pop_back();
+      return block;
+    }
+
+    std::vector<Tile> block;
+    block.reserve(BlockSizes[i]);
+    return block;
+  }
+
+  std::vector<Tile> block;
+  block.reserve(count);
+  return block;
+}
+
+void TileChildrenPool::createChildTiles(
+    Tile& parent,
+    std::vector<Tile>&& children) {
+  if (children.empty() || isBlock(children)) {
+    parent.createChildTiles(std::move(children));
+    return;
+  }
+
+  for (size_t i = 0; i < BlockSizeCount; ++i) {
+    std::vector<std::vector<Tile>>& blocks = this->_blocks[i];
+    if (children.size() > BlockSizes[i] || blocks.empty()) {
+      continue;
+    }
+
+    std::vector<Tile> block = std::move(blocks.back());
+    blocks.pop_back();
+    for (Tile& child : children) {
+      block.emplace_back(std::move(child));
+    }
+
+    parent.createChildTiles(std::move(block));
+    return;
+  }
+
+  parent.createChildTiles(std::move(children));
+}
+
+void TileChildrenPool::releaseChildTiles(Tile& parent) {
+  std::vector<Tile> children = std::move(parent._children);
+  parent._children.clear();
+
+  for (Tile& child : children) {
+    this->releaseChildTiles(child);
+  }
+
+  children.clear();
+  this->recycle(std::move(children));
+}
+
+size_t TileChildrenPool::getPooledBlockCount() const noexcept {
+  size_t count = 0;
+  for (const std::vector<std::vector<Tile>>& blocks : this->_blocks) {
+    count += blocks.size();
+  }
+  return count;
+}
+
+void TileChildrenPool::recycle(std::vector<Tile>&& block) {
+  for (size_t i = 0; i < BlockSizeCount; ++i) {
+    std::vector<std::vector<Tile>>& blocks = this->_blocks[i];
+    if (block.capacity() == BlockSizes[i] &&
+        blocks.size() < this->_maximumBlocksPerSize) {
+      blocks.emplace_back(std::move(block));
+      return;
+    }
+  }
+}
+
+} // namespace Cesium3DTilesSelection
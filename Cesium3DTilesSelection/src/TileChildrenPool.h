@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief Recycles the blocks of memory that hold the children of tiles, so
+ * that creating and releasing children as the camera moves doesn't keep
+ * allocating and freeing them.
+ *
+ * Almost every tile of a quadtree or octree has 4 or 8 children, so blocks
+ * for up to 4 and up to 8 children are kept when the children of a tile and
+ * all of their descendants are released, and given to the next tiles whose
+ * children are created. Other blocks are allocated and freed as usual.
+ *
+ * This class is not thread-safe. It is only used in the main thread.
+ */
+class TileChildrenPool {
+public:
+  /**
+   * @brief The number of children that fits in each kind of block that is
+   * recycled.
+   */
+  static constexpr size_t BlockSizes[] = {4, 8};
+
+  /**
+   * @brief Creates an empty pool.
+   *
+   * @param maximumBlocksPerSize The maximum number of unused blocks of each
+   * size to keep.
+   */
+  explicit TileChildrenPool(size_t maximumBlocksPerSize = 256) noexcept;
+
+  /**
+   * @brief Gets an empty vector with room for at least the given number of
+   * children, using a recycled block if there is one.
+   */
+  std::vector<Tile> acquire(size_t count);
+
+  /**
+   * @brief Creates the children of a tile, moving them to a recycled block if
+   * they aren't already in a block of one of the {@link BlockSizes}.
+   *
+   * @param parent The tile to create the children of. It must not have any
+   * children yet.
+   * @param children The children to create.
+   */
+  void createChildTiles(Tile& parent, std::vector<Tile>&& children);
+
+  /**
+   * @brief Destroys the children of a tile and all of their descendants,
+   * keeping the blocks that held them to be used again.
+   */
+  void releaseChildTiles(Tile& parent);
+
+  /**
+   * @brief Gets the number of unused blocks in this pool.
+   */
+  size_t getPooledBlockCount() const noexcept;
+
+private:
+  void recycle(std::vector<Tile>&& block);
+
+  static constexpr size_t BlockSizeCount =
+      sizeof(BlockSizes) / sizeof(BlockSizes[0]);
+
+  std::vector<std::vector<Tile>> _blocks[BlockSizeCount];
+  size_t _maximumBlocksPerSize;
+};
+} // namespace Cesium3DTilesSelection
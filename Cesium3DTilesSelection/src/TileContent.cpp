@@ -9,7 +9,12 @@ TileRenderContent::TileRenderContent(CesiumGltf::Model&& model)
       _pRenderResources{nullptr},
       _rasterOverlayDetails{},
       _credits{},
-      _lodTransitionFadePercentage{0.0f} {}
+      _lodTransitionFadePercentage{0.0f},
+      _pointBudgetFraction{1.0f},
+      _cpuDataReleased{false},
+      _triangleHierarchy{},
+      _instanceGrids{},
+      _imageContentHashes{} {}
 
 const CesiumGltf::Model& TileRenderContent::getModel() const noexcept {
   return _model;
@@ -19,10 +24,16 @@ CesiumGltf::Model& TileRenderContent::getModel() noexcept { return _model; }
 
 void TileRenderContent::setModel(const CesiumGltf::Model& model) {
   _model = model;
+  this->_triangleHierarchy.reset();
+  this->_instanceGrids.clear();
+  this->_imageContentHashes.clear();
 }
 
 void TileRenderContent::setModel(CesiumGltf::Model&& model) {
   _model = std::move(model);
+  this->_triangleHierarchy.reset();
+  this->_instanceGrids.clear();
+  this->_imageContentHashes.clear();
 }
 
 const RasterOverlayDetails&
@@ -77,6 +88,52 @@ void TileRenderContent::setLodTransitionFadePercentage(
   this->_lodTransitionFadePercentage = percentage;
 }
 
+float TileRenderContent::getPointBudgetFraction() const noexcept {
+  return this->_pointBudgetFraction;
+}
+
+void TileRenderContent::setPointBudgetFraction(float fraction) noexcept {
+  this->_pointBudgetFraction = fraction;
+}
+
+bool TileRenderContent::isCpuDataReleased() const noexcept {
+  return this->_cpuDataReleased;
+}
+
+void TileRenderContent::setCpuDataReleased(bool released) noexcept {
+  this->_cpuDataReleased = released;
+}
+
+const CesiumGeometry::TriangleBoundingVolumeHierarchy*
+TileRenderContent::getTriangleHierarchy() const noexcept {
+  return this->_triangleHierarchy ? &*this->_triangleHierarchy : nullptr;
+}
+
+void TileRenderContent::setTriangleHierarchy(
+    CesiumGeometry::TriangleBoundingVolumeHierarchy&& hierarchy) noexcept {
+  this->_triangleHierarchy = std::move(hierarchy);
+}
+
+const std::vector<CesiumGltfContent::NodeInstanceGrid>&
+TileRenderContent::getInstanceGrids() const noexcept {
+  return this->_instanceGrids;
+}
+
+void TileRenderContent::setInstanceGrids(
+    std::vector<CesiumGltfContent::NodeInstanceGrid>&& grids) noexcept {
+  this->_instanceGrids = std::move(grids);
+}
+
+const std::vector<uint64_t>&
+TileRenderContent::getImageContentHashes() const noexcept {
+  return this->_imageContentHashes;
+}
+
+void TileRenderContent::setImageContentHashes(
+    std::vector<uint64_t>&& hashes) noexcept {
+  this->_imageContentHashes = std::move(hashes);
+}
+
 TileContent::TileContent() : _contentKind{TileUnknownContent{}} {}
 
 TileContent::TileContent(TileEmptyContent content) : _contentKind{content} {}
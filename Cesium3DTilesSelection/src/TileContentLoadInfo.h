@@ -7,16 +7,29 @@
 #include <Cesium3DTilesSelection/TileRefine.h>
 #include <Cesium3DTilesSelection/TilesetOptions.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CancellationToken.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGeometry/Axis.h>
 
 #include <gsl/span>
 #include <spdlog/fwd.h>
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 
 namespace Cesium3DTilesSelection {
+// When each stage of a tile's load ended, for the tileset's
+// TileLoadStatistics. The worker threads only write the stages that they
+// finish, before the load's result is handed on to the main thread.
+struct TileLoadTimestamps {
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point loaded;
+  std::optional<std::chrono::steady_clock::time_point> postProcessed;
+  std::optional<std::chrono::steady_clock::time_point> preparedInLoadThread;
+};
+
 struct TileContentLoadInfo {
   TileContentLoadInfo(
       const CesiumAsync::AsyncSystem& asyncSystem,
@@ -48,5 +61,13 @@ struct TileContentLoadInfo {
   glm::dmat4 tileTransform;
 
   TilesetContentOptions contentOptions;
+
+  CesiumAsync::CancellationToken cancellationToken;
+
+  // Whether this load leaves the embedded images undecoded and skips
+  // IPrepareRendererResources::prepareInLoadThread, until the tile is needed.
+  bool deferImageDecoding = false;
+
+  std::shared_ptr<TileLoadTimestamps> pTimestamps;
 };
 } // namespace Cesium3DTilesSelection
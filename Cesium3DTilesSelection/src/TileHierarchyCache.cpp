@@ -0,0 +1,390 @@
+#include "TileHierarchyCache.h"
+
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// Bump the version whenever the layout changes, so that the hierarchies cached
+// by an older version are parsed from the tileset.json again.
+constexpr char TILE_HIERARCHY_MAGIC[4] = {'C', 'T', 'H', 'C'};
+constexpr uint32_t TILE_HIERARCHY_VERSION = 1;
+
+enum TileRecordFlags : uint8_t {
+  HasContentUri = 1 << 0,
+  HasTransform = 1 << 1,
+  HasViewerRequestVolume = 1 << 2,
+  HasContentBoundingVolume = 1 << 3
+};
+
+template <typename T>
+void write(std::vector<std::byte>& output, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const size_t offset = output.size();
+  output.resize(offset + sizeof(T));
+  std::memcpy(output.data() + offset, &value, sizeof(T));
+}
+
+void writeString(std::vector<std::byte>& output, const std::string& value) {
+  write(output, static_cast<uint32_t>(value.size()));
+  const size_t offset = output.size();
+  output.resize(offset + value.size());
+  std::memcpy(output.data() + offset, value.data(), value.size());
+}
+
+void writeBoundingVolume(
+    std::vector<std::byte>& output,
+    const BoundingVolume& boundingVolume) {
+  struct Operation {
+    std::vector<std::byte>& output;
+
+    void operator()(const BoundingSphere& boundingSphere) {
+      write(output, boundingSphere.getCenter());
+      write(output, boundingSphere.getRadius());
+    }
+
+    void operator()(const OrientedBoundingBox& boundingBox) {
+      write(output, boundingBox.getCenter());
+      write(output, boundingBox.getHalfAxes());
+    }
+
+    void operator()(const BoundingRegion& boundingRegion) {
+      const GlobeRectangle& rectangle = boundingRegion.getRectangle();
+      write(output, rectangle.getWest());
+      write(output, rectangle.getSouth());
+      write(output, rectangle.getEast());
+      write(output, rectangle.getNorth());
+      write(output, boundingRegion.getMinimumHeight());
+      write(output, boundingRegion.getMaximumHeight());
+    }
+
+    void operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) {
+      (*this)(boundingRegion.getBoundingRegion());
+    }
+
+    void operator()(const S2CellBoundingVolume& s2CellBoundingVolume) {
+      write(output, s2CellBoundingVolume.getCellID().getID());
+      write(output, s2CellBoundingVolume.getMinimumHeight());
+      write(output, s2CellBoundingVolume.getMaximumHeight());
+    }
+  };
+
+  write(output, static_cast<uint8_t>(boundingVolume.index()));
+  std::visit(Operation{output}, boundingVolume);
+}
+
+bool writeTileRecursively(
+    std::vector<std::byte>& output,
+    const Tile& tile,
+    const TilesetContentLoader* pLoader) {
+  // Only the tiles that are parsed from the tileset.json alone can be
+  // represented, not the roots of implicit tilesets or tiles of child loaders.
+  const TileContent& content = tile.getContent();
+  const CesiumUtility::InternedString* pContentUri =
+      std::get_if<CesiumUtility::InternedString>(&tile.getTileID());
+  if (tile.getLoader() != pLoader || !pContentUri ||
+      (!content.isEmptyContent() && !content.isUnknownContent())) {
+    return false;
+  }
+
+  const bool hasContentUri = content.isUnknownContent();
+  const bool hasTransform = tile.getTransform() != glm::dmat4(1.0);
+  const std::optional<BoundingVolume>& viewerRequestVolume =
+      tile.getViewerRequestVolume();
+  const std::optional<BoundingVolume>& contentBoundingVolume =
+      tile.getContentBoundingVolume();
+
+  const uint8_t flags = static_cast<uint8_t>(
+      (hasContentUri ? HasContentUri : 0) | (hasTransform ? HasTransform : 0) |
+      (viewerRequestVolume ? HasViewerRequestVolume : 0) |
+      (contentBoundingVolume ? HasContentBoundingVolume : 0));
+
+  write(output, flags);
+  write(output, static_cast<uint8_t>(tile.getRefine()));
+  write(output, tile.getGeometricError());
+  if (hasContentUri) {
+    writeString(output, *pContentUri);
+  }
+  if (hasTransform) {
+    write(output, tile.getTransform());
+  }
+  writeBoundingVolume(output, tile.getBoundingVolume());
+  if (viewerRequestVolume) {
+    writeBoundingVolume(output, *viewerRequestVolume);
+  }
+  if (contentBoundingVolume) {
+    writeBoundingVolume(output, *contentBoundingVolume);
+  }
+
+  gsl::span<const Tile> children = tile.getChildren();
+  write(output, static_cast<uint32_t>(children.size()));
+  for (const Tile& child : children) {
+    if (!writeTileRecursively(output, child, pLoader)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+class TileHierarchyReader {
+public:
+  explicit TileHierarchyReader(gsl::span<const std::byte> data) noexcept
+      : _data{data}, _offset{0} {}
+
+  template <typename T> bool read(T& value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (this->remaining() < sizeof(T)) {
+      return false;
+    }
+
+    std::memcpy(&value, this->_data.data() + this->_offset, sizeof(T));
+    this->_offset += sizeof(T);
+    return true;
+  }
+
+  bool readString(std::string& value) {
+    uint32_t size;
+    if (!this->read(size) || this->remaining() < size) {
+      return false;
+    }
+
+    value.assign(
+        reinterpret_cast<const char*>(this->_data.data() + this->_offset),
+        size);
+    this->_offset += size;
+    return true;
+  }
+
+  std::optional<BoundingVolume> readBoundingVolume() {
+    uint8_t type;
+    if (!this->read(type)) {
+      return std::nullopt;
+    }
+
+    switch (type) {
+    case 0: {
+      glm::dvec3 center;
+      double radius;
+      if (this->read(center) && this->read(radius)) {
+        return BoundingSphere(center, radius);
+      }
+      return std::nullopt;
+    }
+    case 1: {
+      glm::dvec3 center;
+      glm::dmat3 halfAxes;
+      if (this->read(center) && this->read(halfAxes)) {
+        return OrientedBoundingBox(center, halfAxes);
+      }
+      return std::nullopt;
+    }
+    case 2:
+    case 3: {
+      std::optional<BoundingRegion> maybeRegion = this->readBoundingRegion();
+      if (!maybeRegion) {
+        return std::nullopt;
+      }
+      if (type == 2) {
+        return *maybeRegion;
+      }
+      return BoundingRegionWithLooseFittingHeights(*maybeRegion);
+    }
+    case 4: {
+      uint64_t cellID;
+      double minimumHeight;
+      double maximumHeight;
+      if (this->read(cellID) && this->read(minimumHeight) &&
+          this->read(maximumHeight)) {
+        return S2CellBoundingVolume(
+            S2CellID(cellID),
+            minimumHeight,
+            maximumHeight);
+      }
+      return std::nullopt;
+    }
+    default:
+      return std::nullopt;
+    }
+  }
+
+  std::optional<Tile> readTileRecursively(TilesetContentLoader& loader) {
+    uint8_t flags;
+    uint8_t refine;
+    double geometricError;
+    if (!this->read(flags) || !this->read(refine) ||
+        !this->read(geometricError) ||
+        refine > static_cast<uint8_t>(TileRefine::Replace)) {
+      return std::nullopt;
+    }
+
+    std::string contentUri;
+    glm::dmat4 transform(1.0);
+    if (((flags & HasContentUri) && !this->readString(contentUri)) ||
+        ((flags & HasTransform) && !this->read(transform))) {
+      return std::nullopt;
+    }
+
+    std::optional<BoundingVolume> boundingVolume = this->readBoundingVolume();
+    if (!boundingVolume) {
+      return std::nullopt;
+    }
+
+    std::optional<BoundingVolume> viewerRequestVolume;
+    if (flags & HasViewerRequestVolume) {
+      viewerRequestVolume = this->readBoundingVolume();
+      if (!viewerRequestVolume) {
+        return std::nullopt;
+      }
+    }
+
+    std::optional<BoundingVolume> contentBoundingVolume;
+    if (flags & HasContentBoundingVolume) {
+      contentBoundingVolume = this->readBoundingVolume();
+      if (!contentBoundingVolume) {
+        return std::nullopt;
+      }
+    }
+
+    // Every child takes more than one byte, so a count beyond the remaining
+    // bytes is malformed and would only make the reserve below huge.
+    uint32_t childCount;
+    if (!this->read(childCount) || childCount > this->remaining()) {
+      return std::nullopt;
+    }
+
+    std::vector<Tile> children;
+    children.reserve(childCount);
+    for (uint32_t i = 0; i < childCount; ++i) {
+      std::optional<Tile> maybeChild = this->readTileRecursively(loader);
+      if (!maybeChild) {
+        return std::nullopt;
+      }
+      children.emplace_back(std::move(*maybeChild));
+    }
+
+    std::optional<Tile> maybeTile;
+    if (flags & HasContentUri) {
+      maybeTile.emplace(&loader);
+      maybeTile->setTileID(std::move(contentUri));
+    } else {
+      maybeTile.emplace(&loader, TileEmptyContent{});
+      maybeTile->setTileID("");
+    }
+
+    Tile& tile = *maybeTile;
+    tile.setTransform(transform);
+    tile.setBoundingVolume(*boundingVolume);
+    tile.setViewerRequestVolume(viewerRequestVolume);
+    tile.setGeometricError(geometricError);
+    tile.setRefine(static_cast<TileRefine>(refine));
+    tile.setContentBoundingVolume(contentBoundingVolume);
+    tile.createChildTiles(std::move(children));
+
+    return maybeTile;
+  }
+
+  size_t remaining() const noexcept {
+    return this->_data.size() - this->_offset;
+  }
+
+private:
+  std::optional<BoundingRegion> readBoundingRegion() noexcept {
+    double west;
+    double south;
+    double east;
+    double north;
+    double minimumHeight;
+    double maximumHeight;
+    if (this->read(west) && this->read(south) && this->read(east) &&
+        this->read(north) && this->read(minimumHeight) &&
+        this->read(maximumHeight)) {
+      return BoundingRegion(
+          GlobeRectangle(west, south, east, north),
+          minimumHeight,
+          maximumHeight);
+    }
+    return std::nullopt;
+  }
+
+  gsl::span<const std::byte> _data;
+  size_t _offset;
+};
+} // namespace
+
+std::optional<std::string>
+getTileHierarchyCacheKey(const CesiumAsync::IAssetRequest& request) {
+  const CesiumAsync::IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return std::nullopt;
+  }
+
+  const CesiumAsync::HttpHeaders& headers = pResponse->headers();
+  auto etagIt = headers.find("ETag");
+  if (etagIt == headers.end() || etagIt->second.empty()) {
+    return std::nullopt;
+  }
+
+  return "tile-hierarchy:" + request.url() + ":" + etagIt->second;
+}
+
+std::vector<std::byte> writeTileHierarchy(
+    const Tile& rootTile,
+    CesiumGeometry::Axis upAxis,
+    const std::string& metadataJson) {
+  std::vector<std::byte> output;
+  write(output, TILE_HIERARCHY_MAGIC);
+  write(output, TILE_HIERARCHY_VERSION);
+  write(output, static_cast<uint8_t>(upAxis));
+  writeString(output, metadataJson);
+  if (!writeTileRecursively(output, rootTile, rootTile.getLoader())) {
+    return {};
+  }
+
+  return output;
+}
+
+std::optional<CachedTileHierarchy>
+readTileHierarchy(const std::string& baseUrl, gsl::span<const std::byte> data) {
+  TileHierarchyReader reader(data);
+
+  char magic[4];
+  uint32_t version;
+  uint8_t upAxis;
+  if (!reader.read(magic) ||
+      std::memcmp(magic, TILE_HIERARCHY_MAGIC, sizeof(magic)) != 0 ||
+      !reader.read(version) || version != TILE_HIERARCHY_VERSION ||
+      !reader.read(upAxis) || upAxis > static_cast<uint8_t>(Axis::Z)) {
+    return std::nullopt;
+  }
+
+  CachedTileHierarchy result;
+  if (!reader.readString(result.metadataJson)) {
+    return std::nullopt;
+  }
+
+  result.pLoader = std::make_unique<TilesetJsonLoader>(
+      baseUrl,
+      static_cast<CesiumGeometry::Axis>(upAxis));
+  std::optional<Tile> maybeRootTile =
+      reader.readTileRecursively(*result.pLoader);
+  if (!maybeRootTile || reader.remaining() != 0) {
+    return std::nullopt;
+  }
+
+  result.pRootTile = std::make_unique<Tile>(std::move(*maybeRootTile));
+  return result;
+}
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "TilesetJsonLoader.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumGeometry/Axis.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief Gets the key under which the tile hierarchy of the given tileset.json
+ * response is cached, or `std::nullopt` if the response has no ETag to tell
+ * its versions apart.
+ */
+std::optional<std::string>
+getTileHierarchyCacheKey(const CesiumAsync::IAssetRequest& request);
+
+/**
+ * @brief Serializes the given tile and its descendants, along with the glTF
+ * up-axis of their tileset and the JSON of its metadata, into a versioned
+ * binary blob holding the tiles as a flat array in depth-first order.
+ *
+ * @param rootTile The root tile of the tileset.json.
+ * @param upAxis The glTF up-axis of the tileset.
+ * @param metadataJson The JSON object with the `schema`, `schemaUri`,
+ * `metadata`, and `groups` of the tileset.
+ * @return The blob, or an empty vector if a tile can't be represented, such as
+ * the root of an implicit tileset.
+ */
+std::vector<std::byte> writeTileHierarchy(
+    const Tile& rootTile,
+    CesiumGeometry::Axis upAxis,
+    const std::string& metadataJson);
+
+/**
+ * @brief A tile hierarchy read by {@link readTileHierarchy}.
+ */
+struct CachedTileHierarchy {
+  /**
+   * @brief The loader of the tiles.
+   */
+  std::unique_ptr<TilesetJsonLoader> pLoader;
+
+  /**
+   * @brief The root tile of the tileset.json.
+   */
+  std::unique_ptr<Tile> pRootTile;
+
+  /**
+   * @brief The JSON object with the metadata of the tileset.
+   */
+  std::string metadataJson;
+};
+
+/**
+ * @brief Reads a tile hierarchy written by {@link writeTileHierarchy}.
+ *
+ * @param baseUrl The URL of the tileset.json.
+ * @param data The blob.
+ * @return The hierarchy, or `std::nullopt` if the blob was written by another
+ * version or is malformed.
+ */
+std::optional<CachedTileHierarchy>
+readTileHierarchy(const std::string& baseUrl, gsl::span<const std::byte> data);
+} // namespace Cesium3DTilesSelection
@@ -1,16 +1,23 @@
 #include "Cesium3DTilesSelection/TileID.h"
 
 #include <string>
+#include <type_traits>
 #include <variant>
 
 namespace Cesium3DTilesSelection {
 
+static_assert(
+    std::is_trivially_copyable_v<TileID>,
+    "Tile IDs are copied and hashed often, so they must stay small.");
+
 /*static*/ std::string
 TileIdUtilities::createTileIdString(const TileID& tileId) {
 
   struct Operation {
 
-    std::string operator()(const std::string& url) { return url; }
+    std::string operator()(const CesiumUtility::InternedString& url) {
+      return url.str();
+    }
 
     std::string
     operator()(const CesiumGeometry::QuadtreeTileID& quadtreeTileId) {
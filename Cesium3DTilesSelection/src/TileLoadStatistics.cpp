@@ -0,0 +1,69 @@
+#include <Cesium3DTilesSelection/TileLoadStatistics.h>
+
+#include <algorithm>
+
+namespace Cesium3DTilesSelection {
+
+void TileLoadStageHistogram::add(double milliseconds) noexcept {
+  milliseconds = std::max(milliseconds, 0.0);
+
+  const auto boundIt = std::lower_bound(
+      bucketUpperBounds.begin(),
+      bucketUpperBounds.end(),
+      milliseconds);
+  ++this->bucketCounts[size_t(boundIt - bucketUpperBounds.begin())];
+
+  ++this->count;
+  this->totalMilliseconds += milliseconds;
+  this->maximumMilliseconds = std::max(this->maximumMilliseconds, milliseconds);
+}
+
+double
+TileLoadStageHistogram::estimatePercentile(double percentile) const noexcept {
+  if (this->count == 0) {
+    return 0.0;
+  }
+
+  const double rank =
+      std::clamp(percentile, 0.0, 100.0) / 100.0 * double(this->count);
+  double countBelow = 0.0;
+  for (size_t i = 0; i < this->bucketCounts.size(); ++i) {
+    const double bucketCount = double(this->bucketCounts[i]);
+    if (bucketCount == 0.0 || countBelow + bucketCount < rank) {
+      countBelow += bucketCount;
+      continue;
+    }
+
+    // No duration in the bucket is longer than the longest duration, which
+    // also bounds the last bucket.
+    const double lower = i == 0 ? 0.0 : bucketUpperBounds[i - 1];
+    double upper = this->maximumMilliseconds;
+    if (i < bucketUpperBounds.size()) {
+      upper = std::min(upper, bucketUpperBounds[i]);
+    }
+    const double fraction = (rank - countBelow) / bucketCount;
+    return lower + (upper - lower) * fraction;
+  }
+
+  return this->maximumMilliseconds;
+}
+
+const TileLoadStageHistogram* TileLoadStatistics::getHistogram(
+    const std::string& contentType,
+    TileLoadStage stage) const noexcept {
+  auto it = this->contentTypes.find(contentType);
+  if (it == this->contentTypes.end()) {
+    return nullptr;
+  }
+
+  return &it->second[size_t(stage)];
+}
+
+void TileLoadStatistics::add(
+    const std::string& contentType,
+    TileLoadStage stage,
+    double milliseconds) {
+  this->contentTypes[contentType][size_t(stage)].add(milliseconds);
+}
+
+} // namespace Cesium3DTilesSelection
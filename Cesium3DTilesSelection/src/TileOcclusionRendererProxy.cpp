@@ -1,5 +1,7 @@
 #include "Cesium3DTilesSelection/TileOcclusionRendererProxy.h"
 
+#include <algorithm>
+
 namespace Cesium3DTilesSelection {
 
 TileOcclusionRendererProxyPool::TileOcclusionRendererProxyPool(
@@ -7,7 +9,13 @@ TileOcclusionRendererProxyPool::TileOcclusionRendererProxyPool(
     : _pFreeProxiesHead(nullptr),
       _currentSize(0),
       _maxSize(maximumPoolSize < 0 ? 0 : maximumPoolSize),
-      _tileToOcclusionProxyMappings(size_t(this->_maxSize)) {}
+      _tileToOcclusionProxyMappings(size_t(this->_maxSize)),
+      _retainUnusedProxyFrames(0),
+      _maximumNewProxiesPerFrame(-1),
+      _newProxiesThisFrame(0),
+      _frame(0),
+      _retainedTiles(),
+      _nextRetainedTile(0) {}
 
 TileOcclusionRendererProxyPool::~TileOcclusionRendererProxyPool() {
   this->destroyPool();
@@ -19,6 +27,8 @@ void TileOcclusionRendererProxyPool::destroyPool() {
   }
 
   this->_tileToOcclusionProxyMappings.clear();
+  this->_retainedTiles.clear();
+  this->_nextRetainedTile = 0;
 
   while (this->_pFreeProxiesHead) {
     TileOcclusionRendererProxy* pNext = this->_pFreeProxiesHead->_pNext;
@@ -36,11 +46,17 @@ TileOcclusionRendererProxyPool::fetchOcclusionProxyForTile(
   auto mappingIt = this->_tileToOcclusionProxyMappings.find(&tile);
   if (mappingIt != this->_tileToOcclusionProxyMappings.end()) {
     TileOcclusionRendererProxy* pProxy = mappingIt->second;
-    pProxy->_usedLastFrame = true;
+    pProxy->_lastUsedFrame = this->_frame;
 
     return pProxy;
   }
 
+  if (this->_maximumNewProxiesPerFrame >= 0 &&
+      this->_newProxiesThisFrame >= this->_maximumNewProxiesPerFrame) {
+    // Out of budget for this frame.
+    return nullptr;
+  }
+
   if (!this->_pFreeProxiesHead && this->_currentSize < this->_maxSize) {
     this->_pFreeProxiesHead = this->createProxy();
     if (this->_pFreeProxiesHead) {
@@ -48,15 +64,22 @@ TileOcclusionRendererProxyPool::fetchOcclusionProxyForTile(
     }
   }
 
-  if (!this->_pFreeProxiesHead) {
+  TileOcclusionRendererProxy* pAssignedProxy = nullptr;
+  if (this->_pFreeProxiesHead) {
+    pAssignedProxy = this->_pFreeProxiesHead;
+    this->_pFreeProxiesHead = this->_pFreeProxiesHead->_pNext;
+    pAssignedProxy->_pNext = nullptr;
+  } else {
+    pAssignedProxy = this->takeRetainedProxy();
+  }
+
+  if (!pAssignedProxy) {
     // Pool is full or createProxy returned nullptr
     return nullptr;
   }
 
-  TileOcclusionRendererProxy* pAssignedProxy = this->_pFreeProxiesHead;
-  this->_pFreeProxiesHead = this->_pFreeProxiesHead->_pNext;
-  pAssignedProxy->_pNext = nullptr;
-  pAssignedProxy->_usedLastFrame = true;
+  pAssignedProxy->_lastUsedFrame = this->_frame;
+  ++this->_newProxiesThisFrame;
 
   this->_tileToOcclusionProxyMappings.emplace(&tile, pAssignedProxy);
   pAssignedProxy->reset(&tile);
@@ -65,21 +88,76 @@ TileOcclusionRendererProxyPool::fetchOcclusionProxyForTile(
 }
 
 void TileOcclusionRendererProxyPool::pruneOcclusionProxyMappings() {
+  this->_retainedTiles.clear();
+  this->_nextRetainedTile = 0;
+
   for (auto iter = this->_tileToOcclusionProxyMappings.begin();
        iter != this->_tileToOcclusionProxyMappings.end();) {
-    if (!iter->second->_usedLastFrame) {
-      // This tile was not traversed last frame, unmap the proxy and re-add it
+    TileOcclusionRendererProxy* pProxy = iter->second;
+    const int64_t unusedFrames = this->_frame - pProxy->_lastUsedFrame;
+    if (unusedFrames > this->_retainUnusedProxyFrames) {
+      // This tile was not traversed recently, unmap the proxy and re-add it
       // to the free list.
-      iter->second->reset(nullptr);
-      iter->second->_pNext = this->_pFreeProxiesHead;
-      this->_pFreeProxiesHead = iter->second;
+      pProxy->reset(nullptr);
+      pProxy->_pNext = this->_pFreeProxiesHead;
+      this->_pFreeProxiesHead = pProxy;
       iter = this->_tileToOcclusionProxyMappings.erase(iter);
     } else {
-      // Reset the flag.
-      iter->second->_usedLastFrame = false;
+      if (unusedFrames > 0) {
+        this->_retainedTiles.emplace_back(pProxy->_lastUsedFrame, iter->first);
+      }
       ++iter;
     }
   }
+
+  std::sort(
+      this->_retainedTiles.begin(),
+      this->_retainedTiles.end(),
+      [](const auto& left, const auto& right) {
+        return left.first < right.first;
+      });
+
+  ++this->_frame;
+  this->_newProxiesThisFrame = 0;
+}
+
+void TileOcclusionRendererProxyPool::releaseOcclusionProxyForTile(
+    const Tile& tile) {
+  auto mappingIt = this->_tileToOcclusionProxyMappings.find(&tile);
+  if (mappingIt == this->_tileToOcclusionProxyMappings.end()) {
+    return;
+  }
+
+  TileOcclusionRendererProxy* pProxy = mappingIt->second;
+  pProxy->reset(nullptr);
+  pProxy->_pNext = this->_pFreeProxiesHead;
+  this->_pFreeProxiesHead = pProxy;
+  this->_tileToOcclusionProxyMappings.erase(mappingIt);
+}
+
+void TileOcclusionRendererProxyPool::startNewFrame(
+    const std::vector<ViewState>& /*frustums*/,
+    const std::vector<Tile*>& /*tilesRenderedLastFrame*/) {}
+
+TileOcclusionRendererProxy*
+TileOcclusionRendererProxyPool::takeRetainedProxy() {
+  while (this->_nextRetainedTile < this->_retainedTiles.size()) {
+    const Tile* pTile = this->_retainedTiles[this->_nextRetainedTile].second;
+    ++this->_nextRetainedTile;
+
+    // The tile may have been used again, or released, since it was retained.
+    auto mappingIt = this->_tileToOcclusionProxyMappings.find(pTile);
+    if (mappingIt == this->_tileToOcclusionProxyMappings.end() ||
+        mappingIt->second->_lastUsedFrame == this->_frame) {
+      continue;
+    }
+
+    TileOcclusionRendererProxy* pProxy = mappingIt->second;
+    this->_tileToOcclusionProxyMappings.erase(mappingIt);
+    return pProxy;
+  }
+
+  return nullptr;
 }
 
 } // namespace Cesium3DTilesSelection
@@ -1,6 +1,9 @@
+#include "CombinedViewState.h"
 #include "TileUtilities.h"
 #include "TilesetContentManager.h"
 
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+#include <Cesium3DTilesSelection/ITileEvictionPolicy.h>
 #include <Cesium3DTilesSelection/ITileExcluder.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
@@ -8,8 +11,14 @@
 #include <Cesium3DTilesSelection/TilesetMetadata.h>
 #include <Cesium3DTilesSelection/spdlog-cesium.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/NetworkThroughputEstimator.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumGeometry/IntersectionTests.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/Math.h>
@@ -18,11 +27,13 @@
 #include <CesiumUtility/joinToString.h>
 
 #include <glm/common.hpp>
+#include <glm/trigonometric.hpp>
 #include <rapidjson/document.h>
 
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 #include <unordered_set>
 
 using namespace CesiumAsync;
@@ -44,6 +55,29 @@ Tileset::Tileset(
       _previousFrameNumber(0),
       _distances(),
       _childOcclusionProxies(),
+      _lastTraversalInputs(),
+      _screenSpaceErrorScale(1.0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _effectiveCulledScreenSpaceError(options.culledScreenSpaceError),
+      _effectiveLoadingDescendantLimit(options.loadingDescendantLimit),
+      _networkSimultaneousTileLoads(
+          double(options.maximumSimultaneousTileLoads)),
+      _networkScreenSpaceErrorScale(1.0),
+      _lowestNetworkLatency(0.0),
+      _lastNetworkAdjustmentTime(),
+      _lastNetworkRequestCount(0),
+      _effectiveMaximumSimultaneousTileLoads(
+          options.maximumSimultaneousTileLoads),
+      _tileViewEvaluations(),
+      _traversalThreadPool(),
+      _traversalThreadPoolSize(0),
+      _constructionTime(std::chrono::steady_clock::now()),
+      _viewChangeTime(_constructionTime),
+      _loadTimingFrustums(),
+      _viewFullyLoaded(false),
+      _loadTimings(),
+      _mainThreadLoadBatch(),
+      _mainThreadBatchMillisecondsPerTile(0.0),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -62,6 +96,29 @@ Tileset::Tileset(
       _previousFrameNumber(0),
       _distances(),
       _childOcclusionProxies(),
+      _lastTraversalInputs(),
+      _screenSpaceErrorScale(1.0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _effectiveCulledScreenSpaceError(options.culledScreenSpaceError),
+      _effectiveLoadingDescendantLimit(options.loadingDescendantLimit),
+      _networkSimultaneousTileLoads(
+          double(options.maximumSimultaneousTileLoads)),
+      _networkScreenSpaceErrorScale(1.0),
+      _lowestNetworkLatency(0.0),
+      _lastNetworkAdjustmentTime(),
+      _lastNetworkRequestCount(0),
+      _effectiveMaximumSimultaneousTileLoads(
+          options.maximumSimultaneousTileLoads),
+      _tileViewEvaluations(),
+      _traversalThreadPool(),
+      _traversalThreadPoolSize(0),
+      _constructionTime(std::chrono::steady_clock::now()),
+      _viewChangeTime(_constructionTime),
+      _loadTimingFrustums(),
+      _viewFullyLoaded(false),
+      _loadTimings(),
+      _mainThreadLoadBatch(),
+      _mainThreadBatchMillisecondsPerTile(0.0),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -80,6 +137,29 @@ Tileset::Tileset(
       _previousFrameNumber(0),
       _distances(),
       _childOcclusionProxies(),
+      _lastTraversalInputs(),
+      _screenSpaceErrorScale(1.0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _effectiveCulledScreenSpaceError(options.culledScreenSpaceError),
+      _effectiveLoadingDescendantLimit(options.loadingDescendantLimit),
+      _networkSimultaneousTileLoads(
+          double(options.maximumSimultaneousTileLoads)),
+      _networkScreenSpaceErrorScale(1.0),
+      _lowestNetworkLatency(0.0),
+      _lastNetworkAdjustmentTime(),
+      _lastNetworkRequestCount(0),
+      _effectiveMaximumSimultaneousTileLoads(
+          options.maximumSimultaneousTileLoads),
+      _tileViewEvaluations(),
+      _traversalThreadPool(),
+      _traversalThreadPoolSize(0),
+      _constructionTime(std::chrono::steady_clock::now()),
+      _viewChangeTime(_constructionTime),
+      _loadTimingFrustums(),
+      _viewFullyLoaded(false),
+      _loadTimings(),
+      _mainThreadLoadBatch(),
+      _mainThreadBatchMillisecondsPerTile(0.0),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -89,7 +169,10 @@ Tileset::Tileset(
           ionAssetEndpointUrl)} {}
 
 Tileset::~Tileset() noexcept {
-  this->_pTilesetContentManager->unloadAll();
+  // Nothing will use the content of tiles that are still loading, so don't
+  // spend more time on them than necessary, and free each one as soon as its
+  // load stops.
+  this->_pTilesetContentManager->abandon();
   if (this->_externals.pTileOcclusionProxyPool) {
     this->_externals.pTileOcclusionProxyPool->destroyPool();
   }
@@ -133,6 +216,19 @@ const RasterOverlayCollection& Tileset::getOverlays() const noexcept {
   return this->_pTilesetContentManager->getRasterOverlayCollection();
 }
 
+static double
+millisecondsSince(std::chrono::system_clock::time_point start) noexcept {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::system_clock::now() - start)
+      .count();
+}
+
+static double millisecondsBetween(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) noexcept {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
 static bool
 operator<(const FogDensityAtHeight& fogDensity, double height) noexcept {
   return fogDensity.cameraHeight < height;
@@ -182,6 +278,20 @@ static double computeFogDensity(
   return density;
 }
 
+static void addTileFadingOut(Tile& tile, ViewUpdateResult& result) {
+  if (!tile.isFadingOut()) {
+    tile.setFadingOut(true);
+    result.tilesFadingOut.emplace_back(&tile);
+  }
+}
+
+static void clearTilesFadingOut(ViewUpdateResult& result) noexcept {
+  for (Tile* pTile : result.tilesFadingOut) {
+    pTile->setFadingOut(false);
+  }
+  result.tilesFadingOut.clear();
+}
+
 void Tileset::_updateLodTransitions(
     const FrameState& frameState,
     float deltaTime,
@@ -193,54 +303,65 @@ void Tileset::_updateLodTransitions(
     float deltaTransitionPercentage =
         deltaTime / this->_options.lodTransitionLength;
 
-    // Update fade out
-    for (auto tileIt = result.tilesFadingOut.begin();
-         tileIt != result.tilesFadingOut.end();) {
+    // Update fade out. Tiles that are done fading out are removed from the
+    // list, keeping the others in order.
+    auto isDoneFadingOut = [&frameState,
+                            deltaTransitionPercentage](Tile* pTile) {
       TileRenderContent* pRenderContent =
-          (*tileIt)->getContent().getRenderContent();
+          pTile->getContent().getRenderContent();
 
+      bool done = false;
       if (!pRenderContent) {
         // This tile is done fading out and was immediately kicked from the
         // cache.
-        tileIt = result.tilesFadingOut.erase(tileIt);
-        continue;
-      }
-
-      // Remove tile from fade-out list if it is back on the render list.
-      TileSelectionState::Result selectionResult =
-          (*tileIt)->getLastSelectionState().getResult(
-              frameState.currentFrameNumber);
-      if (selectionResult == TileSelectionState::Result::Rendered) {
+        done = true;
+      } else if (
+          pTile->getLastSelectionState().getResult(
+              frameState.currentFrameNumber) ==
+          TileSelectionState::Result::Rendered) {
+        // Remove tile from fade-out list if it is back on the render list.
         // This tile will already be on the render list.
         pRenderContent->setLodTransitionFadePercentage(0.0f);
-        tileIt = result.tilesFadingOut.erase(tileIt);
-        continue;
+        done = true;
+      } else {
+        float currentPercentage =
+            pRenderContent->getLodTransitionFadePercentage();
+        if (currentPercentage >= 1.0f) {
+          // Remove this tile from the fading out list if it is already done.
+          // The client will already have had a chance to stop rendering the
+          // tile last frame.
+          pRenderContent->setLodTransitionFadePercentage(0.0f);
+          done = true;
+        } else {
+          float newPercentage =
+              glm::min(currentPercentage + deltaTransitionPercentage, 1.0f);
+          pRenderContent->setLodTransitionFadePercentage(newPercentage);
+        }
       }
 
-      float currentPercentage =
-          pRenderContent->getLodTransitionFadePercentage();
-      if (currentPercentage >= 1.0f) {
-        // Remove this tile from the fading out list if it is already done.
-        // The client will already have had a chance to stop rendering the tile
-        // last frame.
-        pRenderContent->setLodTransitionFadePercentage(0.0f);
-        tileIt = result.tilesFadingOut.erase(tileIt);
-        continue;
+      if (done) {
+        pTile->setFadingOut(false);
       }
-
-      float newPercentage =
-          glm::min(currentPercentage + deltaTransitionPercentage, 1.0f);
-      pRenderContent->setLodTransitionFadePercentage(newPercentage);
-      ++tileIt;
-    }
+      return done;
+    };
+    result.tilesFadingOut.erase(
+        std::remove_if(
+            result.tilesFadingOut.begin(),
+            result.tilesFadingOut.end(),
+            isDoneFadingOut),
+        result.tilesFadingOut.end());
 
     // Update fade in
     for (Tile* pTile : result.tilesToRenderThisFrame) {
       TileRenderContent* pRenderContent =
           pTile->getContent().getRenderContent();
-      if (pRenderContent) {
-        float transitionPercentage =
-            pRenderContent->getLodTransitionFadePercentage();
+      if (!pRenderContent) {
+        continue;
+      }
+
+      float transitionPercentage =
+          pRenderContent->getLodTransitionFadePercentage();
+      if (transitionPercentage < 1.0f) {
         float newTransitionPercentage =
             glm::min(transitionPercentage + deltaTransitionPercentage, 1.0f);
         pRenderContent->setLodTransitionFadePercentage(newTransitionPercentage);
@@ -259,6 +380,126 @@ void Tileset::_updateLodTransitions(
   }
 }
 
+static int64_t countPoints(const CesiumGltf::Model& model) noexcept {
+  int64_t points = 0;
+  for (const CesiumGltf::Mesh& mesh : model.meshes) {
+    for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
+      if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS) {
+        continue;
+      }
+
+      auto positionIt = primitive.attributes.find("POSITION");
+      if (positionIt == primitive.attributes.end()) {
+        continue;
+      }
+
+      const CesiumGltf::Accessor* pAccessor =
+          CesiumGltf::Model::getSafe(&model.accessors, positionIt->second);
+      if (pAccessor) {
+        points += pAccessor->count;
+      }
+    }
+  }
+
+  return points;
+}
+
+std::optional<double> Tileset::_intersectRayWithTile(
+    Tile& tile,
+    const Ray& ray,
+    double maximumDistance) {
+  std::optional<double> closest;
+  double closestDistance = maximumDistance;
+
+  // Visit the children nearest first, so that the farther ones can be skipped
+  // once a hit closer than where they start is found.
+  std::vector<std::pair<double, Tile*>> children;
+  for (Tile& child : tile.getChildren()) {
+    const std::optional<double> entryDistance =
+        IntersectionTests::rayOBBParametric(
+            ray,
+            getOrientedBoundingBoxFromBoundingVolume(
+                child.getBoundingVolume()));
+    if (entryDistance && *entryDistance <= closestDistance) {
+      children.emplace_back(*entryDistance, &child);
+    }
+  }
+  std::sort(
+      children.begin(),
+      children.end(),
+      [](const std::pair<double, Tile*>& a, const std::pair<double, Tile*>& b) {
+        return a.first < b.first;
+      });
+
+  for (const auto& [entryDistance, pChild] : children) {
+    if (entryDistance > closestDistance) {
+      break;
+    }
+
+    const std::optional<double> distance =
+        this->_intersectRayWithTile(*pChild, ray, closestDistance);
+    if (distance) {
+      closest = distance;
+      closestDistance = *distance;
+    }
+  }
+
+  // The more detailed content of the children replaces this tile's content
+  // where it was hit.
+  if (closest && tile.getRefine() == TileRefine::Replace) {
+    return closest;
+  }
+
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  if (tile.getState() != TileLoadState::Done || !pRenderContent) {
+    return closest;
+  }
+
+  if (!pRenderContent->getTriangleHierarchy()) {
+    pRenderContent->setTriangleHierarchy(
+        CesiumGltfContent::GltfUtilities::createTriangleBoundingVolumeHierarchy(
+            pRenderContent->getModel(),
+            tile.getTransform()));
+  }
+
+  const std::optional<double> distance =
+      pRenderContent->getTriangleHierarchy()->intersectRayParametric(
+          ray,
+          closestDistance);
+  if (distance) {
+    closest = distance;
+  }
+
+  return closest;
+}
+
+void Tileset::_updatePointBudget(ViewUpdateResult& result) const noexcept {
+  float fraction = 1.0f;
+  if (this->_options.maximumPointsRendered > 0) {
+    int64_t totalPoints = 0;
+    for (const Tile* pTile : result.tilesToRenderThisFrame) {
+      const TileRenderContent* pRenderContent =
+          pTile->getContent().getRenderContent();
+      if (pRenderContent) {
+        totalPoints += countPoints(pRenderContent->getModel());
+      }
+    }
+
+    if (totalPoints > this->_options.maximumPointsRendered) {
+      fraction = static_cast<float>(
+          static_cast<double>(this->_options.maximumPointsRendered) /
+          static_cast<double>(totalPoints));
+    }
+  }
+
+  for (Tile* pTile : result.tilesToRenderThisFrame) {
+    TileRenderContent* pRenderContent = pTile->getContent().getRenderContent();
+    if (pRenderContent) {
+      pRenderContent->setPointBudgetFraction(fraction);
+    }
+  }
+}
+
 const ViewUpdateResult&
 Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
   std::vector<Tile*> tilesSelectedPrevFrame =
@@ -274,7 +515,7 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
     this->updateView(frustums, 0.0f);
   }
 
-  this->_updateResult.tilesFadingOut.clear();
+  clearTilesFadingOut(this->_updateResult);
 
   std::unordered_set<Tile*> uniqueTilesToRenderThisFrame(
       this->_updateResult.tilesToRenderThisFrame.begin(),
@@ -285,7 +526,7 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
       TileRenderContent* pRenderContent = tile->getContent().getRenderContent();
       if (pRenderContent) {
         pRenderContent->setLodTransitionFadePercentage(1.0f);
-        this->_updateResult.tilesFadingOut.insert(tile);
+        addTileFadingOut(*tile, this->_updateResult);
       }
     }
   }
@@ -295,21 +536,42 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
 
 const ViewUpdateResult&
 Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
-  CESIUM_TRACE("Tileset::updateView");
+  CESIUM_TRACE_CATEGORY(MainThread, "Tileset::updateView");
   // Fixup TilesetOptions to ensure lod transitions works correctly.
   _options.enableFrustumCulling =
       _options.enableFrustumCulling && !_options.enableLodTransitionPeriod;
   _options.enableFogCulling =
       _options.enableFogCulling && !_options.enableLodTransitionPeriod;
 
-  this->_asyncSystem.dispatchMainThreadTasks();
+  const int64_t bytesAtStartOfFrame = this->getTotalDataBytes();
 
-  const int32_t previousFrameNumber = this->_previousFrameNumber;
-  const int32_t currentFrameNumber = previousFrameNumber + 1;
+  // With a main-thread loading time limit, continuations left over after
+  // the limit elapses carry over to the next frame.
+  if (this->_options.mainThreadLoadingTimeLimit > 0.0) {
+    this->_asyncSystem.dispatchMainThreadTasks(
+        this->_options.mainThreadLoadingTimeLimit);
+  } else {
+    this->_asyncSystem.dispatchMainThreadTasks();
+  }
 
   ViewUpdateResult& result = this->_updateResult;
-  result.frameNumber = currentFrameNumber;
-  result.tilesToRenderThisFrame.clear();
+  result.traversalTime = 0.0;
+  result.workerThreadLoadQueueDispatchTime = 0.0;
+  result.mainThreadLoadingTime = 0.0;
+  result.tileCacheUnloadTime = 0.0;
+  result.lodTransitionTime = 0.0;
+  result.bytesLoaded = 0;
+  result.bytesFreed = 0;
+  result.timeToFullDetail.reset();
+
+  this->_startLoadTimingsFrame(frustums);
+  this->_updateNetworkAdaptiveLoading();
+  this->_updateEffectiveDetailOptions(result);
+  this->_pTilesetContentManager->startRasterOverlayMapping(
+      this->_options.rasterOverlayMappingTimeLimit);
+
+  const bool reuseSelection = this->_canReuseLastSelection(frustums);
+  result.selectionReused = reuseSelection;
   result.tilesVisited = 0;
   result.culledTilesVisited = 0;
   result.tilesCulled = 0;
@@ -318,12 +580,49 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
   result.tilesKicked = 0;
   result.maxDepthVisited = 0;
 
+  if (reuseSelection) {
+    // Nothing that affects the selection has changed since the last
+    // traversal, so the tiles to render, the (empty) load queues, and the
+    // frame number all stay as they were.
+    this->_unloadCachedTilesAndMeasure(bytesAtStartOfFrame, result);
+    this->_computeVisibilityPerView(frustums, result);
+    this->_addCreditsToFrame(result);
+    this->_previousViewPositions.clear();
+    this->_finishLoadTimingsFrame(result);
+    return result;
+  }
+
+  const int32_t previousFrameNumber = this->_previousFrameNumber;
+  const int32_t currentFrameNumber = previousFrameNumber + 1;
+
+  result.frameNumber = currentFrameNumber;
+  if (this->_options.traversalTimeLimit > 0.0) {
+    this->_previousTilesToRender.assign(
+        result.tilesToRenderThisFrame.begin(),
+        result.tilesToRenderThisFrame.end());
+  } else {
+    this->_previousTilesToRender.clear();
+  }
+  this->_previousTilesToRenderSet.clear();
+
+  const std::shared_ptr<TileOcclusionRendererProxyPool>& pOcclusionPool =
+      this->getExternals().pTileOcclusionProxyPool;
+  if (pOcclusionPool && this->_options.enableOcclusionCulling) {
+    // The tiles rendered last frame are still loaded at this point.
+    pOcclusionPool->startNewFrame(frustums, result.tilesToRenderThisFrame);
+  }
+
+  result.tilesToRenderThisFrame.clear();
+
   if (!_options.enableLodTransitionPeriod) {
-    result.tilesFadingOut.clear();
+    clearTilesFadingOut(result);
   }
 
+  result.tileVisibilityPerView.clear();
+
   Tile* pRootTile = this->getRootTile();
   if (!pRootTile) {
+    this->_finishLoadTimingsFrame(result);
     return result;
   }
 
@@ -331,9 +630,17 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
        this->_options.excluders) {
     pExcluder->startNewFrame();
   }
+  this->_excluderSubtreeIncludedDepths.assign(
+      this->_options.excluders.size(),
+      std::numeric_limits<uint32_t>::max());
+  this->_skipLevelOfDetailAncestor.reset();
 
   this->_workerThreadLoadQueue.clear();
   this->_mainThreadLoadQueue.clear();
+  this->_subtreePrefetchQueue.clear();
+
+  // Cleared by _visitTileIfNeeded if any visited tile may still change.
+  this->_lastTraversalInputs.allVisitedTilesSettled = true;
 
   std::vector<double> fogDensities(frustums.size());
   std::transform(
@@ -345,34 +652,422 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
         return computeFogDensity(fogDensityTable, frustum);
       });
 
+  if (this->_options.evictionPolicy) {
+    this->_evictionFrustums = frustums;
+  } else {
+    this->_evictionFrustums.clear();
+  }
+
+  const auto traversalStart = std::chrono::system_clock::now();
+
+  std::optional<CombinedViewState> combinedView;
+  if (this->_options.enableCombinedViewTraversal) {
+    combinedView = CombinedViewState::create(frustums);
+  }
+  const CombinedViewState* pCombinedView =
+      combinedView ? &*combinedView : nullptr;
+
+  this->_evaluateTilesInParallel(frustums, pCombinedView, previousFrameNumber);
+
   FrameState frameState{
       frustums,
       std::move(fogDensities),
       previousFrameNumber,
-      currentFrameNumber};
+      currentFrameNumber,
+      &this->_tileViewEvaluations,
+      pCombinedView};
+
+  this->_deferredTraversalTiles.swap(this->_nextDeferredTraversalTiles);
+  this->_nextDeferredTraversalTiles.clear();
+  if (this->_options.traversalTimeLimit > 0.0) {
+    this->_traversalDeadline =
+        std::chrono::system_clock::now() +
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::duration<double, std::milli>(
+                this->_options.traversalTimeLimit));
+  } else {
+    this->_traversalDeadline.reset();
+  }
 
   if (!frustums.empty()) {
     this->_visitTileIfNeeded(frameState, 0, false, *pRootTile, result);
   } else {
     result = ViewUpdateResult();
+    this->_updateEffectiveDetailOptions(result);
   }
 
+  result.traversalTime = millisecondsSince(traversalStart);
+
   result.workerThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_workerThreadLoadQueue.size());
   result.mainThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_mainThreadLoadQueue.size());
 
-  const std::shared_ptr<TileOcclusionRendererProxyPool>& pOcclusionPool =
-      this->getExternals().pTileOcclusionProxyPool;
+  this->_queuePredictedTileLoads(frustums, deltaTime);
+
+  // A traversal that ran out of time didn't visit every tile that it needs.
+  if (this->_options.cancelUnneededTileLoads &&
+      this->_nextDeferredTraversalTiles.empty()) {
+    this->_cancelUnneededTileLoads();
+  }
+
   if (pOcclusionPool) {
     pOcclusionPool->pruneOcclusionProxyMappings();
   }
 
-  this->_unloadCachedTiles(this->_options.tileCacheUnloadTimeLimit);
+  this->_unloadCachedTilesAndMeasure(bytesAtStartOfFrame, result);
+
+  auto phaseStart = std::chrono::system_clock::now();
   this->_processWorkerThreadLoadQueue();
+  this->_processSubtreePrefetchQueue();
+  result.workerThreadLoadQueueDispatchTime = millisecondsSince(phaseStart);
+
+  phaseStart = std::chrono::system_clock::now();
+  const int64_t bytesBeforeMainThreadLoads = this->getTotalDataBytes();
   this->_processMainThreadLoadQueue();
+  result.bytesLoaded += std::max(
+      this->getTotalDataBytes() - bytesBeforeMainThreadLoads,
+      int64_t(0));
+  result.mainThreadLoadingTime = millisecondsSince(phaseStart);
+
+  phaseStart = std::chrono::system_clock::now();
   this->_updateLodTransitions(frameState, deltaTime, result);
+  result.lodTransitionTime = millisecondsSince(phaseStart);
+
+  this->_updatePointBudget(result);
+
+  this->_releaseUnusedTileChildren(currentFrameNumber);
+
+  if (this->_options.enableCachedTraversal) {
+    this->_recordTraversalInputs(frustums);
+  }
+
+  this->_computeVisibilityPerView(frustums, result);
+  this->_addCreditsToFrame(result);
+  this->_finishLoadTimingsFrame(result);
+
+  this->_previousFrameNumber = currentFrameNumber;
+
+  return result;
+}
+
+static bool isViewNearlyUnchanged(
+    const ViewState& previous,
+    const ViewState& current,
+    double positionTolerance,
+    double directionTolerance) noexcept {
+  if (previous.getViewportSize() != current.getViewportSize() ||
+      previous.getHorizontalFieldOfView() !=
+          current.getHorizontalFieldOfView() ||
+      previous.getVerticalFieldOfView() != current.getVerticalFieldOfView()) {
+    return false;
+  }
+
+  if (glm::length(current.getPosition() - previous.getPosition()) >
+      positionTolerance) {
+    return false;
+  }
+
+  const double minimumCosine = glm::cos(directionTolerance);
+  return glm::dot(current.getDirection(), previous.getDirection()) >=
+             minimumCosine &&
+         glm::dot(current.getUp(), previous.getUp()) >= minimumCosine &&
+         glm::dot(current.getGazeDirection(), previous.getGazeDirection()) >=
+             minimumCosine;
+}
+
+static bool isSameSkipLevelOfDetail(
+    const SkipLevelOfDetailOptions& a,
+    const SkipLevelOfDetailOptions& b) noexcept {
+  return a.enabled == b.enabled &&
+         a.baseScreenSpaceError == b.baseScreenSpaceError &&
+         a.skipScreenSpaceErrorFactor == b.skipScreenSpaceErrorFactor &&
+         a.skipLevels == b.skipLevels &&
+         a.immediatelyLoadDesiredLevelOfDetail ==
+             b.immediatelyLoadDesiredLevelOfDetail;
+}
+
+static bool isSameFoveatedLoading(
+    const FoveatedLoadingOptions& a,
+    const FoveatedLoadingOptions& b) noexcept {
+  return a.enabled == b.enabled && a.fovealAngle == b.fovealAngle &&
+         a.peripheralScreenSpaceErrorFactor ==
+             b.peripheralScreenSpaceErrorFactor;
+}
+
+bool Tileset::_canReuseLastSelection(
+    const std::vector<ViewState>& frustums) const noexcept {
+  const TilesetOptions& options = this->_options;
+  const LastTraversalInputs& last = this->_lastTraversalInputs;
+
+  if (!options.enableCachedTraversal || !last.allVisitedTilesSettled ||
+      frustums.empty() || frustums.size() != last.frustums.size() ||
+      this->getRootTile() == nullptr) {
+    return false;
+  }
+
+  // These make the selection depend on more than the view.
+  if (!options.excluders.empty() || options.enableLodTransitionPeriod ||
+      (options.enableOcclusionCulling &&
+       this->_externals.pTileOcclusionProxyPool)) {
+    return false;
+  }
+
+  if (this->_effectiveMaximumScreenSpaceError !=
+          last.maximumScreenSpaceError ||
+      this->_effectiveCulledScreenSpaceError != last.culledScreenSpaceError ||
+      this->_effectiveLoadingDescendantLimit != last.loadingDescendantLimit ||
+      options.enforceCulledScreenSpaceError !=
+          last.enforceCulledScreenSpaceError ||
+      options.forbidHoles != last.forbidHoles ||
+      options.enableFrustumCulling != last.enableFrustumCulling ||
+      options.enableFogCulling != last.enableFogCulling ||
+      options.renderTilesUnderCamera != last.renderTilesUnderCamera ||
+      options.preloadAncestors != last.preloadAncestors ||
+      options.preloadSiblings != last.preloadSiblings ||
+      !isSameSkipLevelOfDetail(
+          options.skipLevelOfDetail,
+          last.skipLevelOfDetail) ||
+      !isSameFoveatedLoading(options.foveatedLoading, last.foveatedLoading)) {
+    return false;
+  }
+
+  // If anything was waiting to load, the next traversal may select
+  // differently even if the view is unchanged.
+  const ViewUpdateResult& lastResult = this->_updateResult;
+  if (lastResult.workerThreadTileLoadQueueLength > 0 ||
+      lastResult.mainThreadTileLoadQueueLength > 0 ||
+      lastResult.tilesKicked > 0 || !lastResult.tilesFadingOut.empty() ||
+      this->_pTilesetContentManager->getNumberOfTilesLoading() > 0) {
+    return false;
+  }
+
+  for (const auto& pTileProvider :
+       this->_pTilesetContentManager->getRasterOverlayCollection()
+           .getTileProviders()) {
+    if (pTileProvider->getNumberOfTilesLoading() > 0) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < frustums.size(); ++i) {
+    if (!isViewNearlyUnchanged(
+            last.frustums[i],
+            frustums[i],
+            options.cachedTraversalPositionTolerance,
+            options.cachedTraversalDirectionTolerance)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Tileset::_updateNetworkAdaptiveLoading() noexcept {
+  const NetworkAdaptiveLoadingOptions& adaptive =
+      this->_options.networkAdaptiveLoading;
+  const std::shared_ptr<NetworkThroughputEstimator>& pEstimator =
+      this->_externals.pNetworkThroughputEstimator;
+  const double maximumLoads =
+      double(this->_options.maximumSimultaneousTileLoads);
+  if (!adaptive.enabled || !pEstimator) {
+    this->_networkSimultaneousTileLoads = maximumLoads;
+    this->_networkScreenSpaceErrorScale = 1.0;
+    return;
+  }
+
+  const double minimumLoads = glm::min(
+      glm::max(double(adaptive.minimumSimultaneousTileLoads), 1.0),
+      maximumLoads);
+  const auto clampLoads = [this, minimumLoads, maximumLoads]() {
+    this->_networkSimultaneousTileLoads = glm::clamp(
+        this->_networkSimultaneousTileLoads,
+        minimumLoads,
+        maximumLoads);
+  };
+
+  // Adjust at most once per round trip, so that each adjustment is measured
+  // before the next one is made.
+  const uint64_t requestCount = pEstimator->getFinishedRequestCount();
+  const double latency = pEstimator->getLatency();
+  const std::chrono::steady_clock::time_point now =
+      std::chrono::steady_clock::now();
+  const std::chrono::duration<double> sinceLastAdjustment =
+      now - this->_lastNetworkAdjustmentTime;
+  if (requestCount == this->_lastNetworkRequestCount ||
+      sinceLastAdjustment.count() < glm::max(latency, 0.1)) {
+    clampLoads();
+    return;
+  }
+
+  this->_lastNetworkRequestCount = requestCount;
+  this->_lastNetworkAdjustmentTime = now;
+
+  // Packet loss isn't visible here, so a latency well above the lowest one
+  // measured is taken as the sign that requests are queuing in the network.
+  // The lowest latency drifts up slowly so that a network that has become
+  // slower for good is eventually accepted.
+  this->_lowestNetworkLatency =
+      this->_lowestNetworkLatency > 0.0
+          ? glm::min(latency, this->_lowestNetworkLatency * 1.01)
+          : latency;
+  const int32_t tilesLoading =
+      this->_pTilesetContentManager->getNumberOfTilesLoading();
+  const double congestedLatency =
+      this->_lowestNetworkLatency * adaptive.congestionLatencyFactor;
+  if (latency > congestedLatency) {
+    this->_networkSimultaneousTileLoads *= adaptive.multiplicativeDecrease;
+  } else if (
+      double(tilesLoading) >= glm::floor(this->_networkSimultaneousTileLoads)) {
+    this->_networkSimultaneousTileLoads += adaptive.additiveIncrease;
+  }
+  clampLoads();
+
+  const double bytesPerSecond = pEstimator->getBytesPerSecond();
+  if (adaptive.targetTimeToFullDetail <= 0.0 || bytesPerSecond <= 0.0) {
+    this->_networkScreenSpaceErrorScale = 1.0;
+    return;
+  }
+
+  // The tiles still to be downloaded are those queued by the last frame's
+  // traversal and those loading now.
+  const double pendingTiles = double(
+      this->_updateResult.workerThreadTileLoadQueueLength + tilesLoading);
+  const double timeToFullDetail =
+      pendingTiles * pEstimator->getAverageResponseBytes() / bytesPerSecond;
+  if (timeToFullDetail > adaptive.targetTimeToFullDetail) {
+    this->_networkScreenSpaceErrorScale = glm::min(
+        this->_networkScreenSpaceErrorScale * adaptive.scaleStep,
+        glm::max(adaptive.maximumScale, 1.0));
+  } else if (timeToFullDetail < adaptive.targetTimeToFullDetail * 0.5) {
+    this->_networkScreenSpaceErrorScale = glm::max(
+        this->_networkScreenSpaceErrorScale / adaptive.scaleStep,
+        1.0);
+  }
+}
+
+void Tileset::_updateEffectiveDetailOptions(
+    ViewUpdateResult& result) noexcept {
+  const TilesetOptions& options = this->_options;
+  if (!options.adaptiveScreenSpaceError.enabled) {
+    this->_screenSpaceErrorScale = 1.0;
+  }
+
+  const double scale =
+      this->_screenSpaceErrorScale * this->_networkScreenSpaceErrorScale;
+  this->_effectiveMaximumScreenSpaceError =
+      options.maximumScreenSpaceError * scale;
+  this->_effectiveCulledScreenSpaceError =
+      options.culledScreenSpaceError * scale;
+
+  // A limit of zero means never wait for descendants, so keep it that way.
+  const uint32_t limit = options.loadingDescendantLimit;
+  this->_effectiveLoadingDescendantLimit =
+      limit == 0 ? 0
+                 : static_cast<uint32_t>(
+                       glm::max(glm::round(double(limit) / scale), 1.0));
+
+  result.effectiveMaximumScreenSpaceError =
+      this->_effectiveMaximumScreenSpaceError;
+  result.effectiveCulledScreenSpaceError =
+      this->_effectiveCulledScreenSpaceError;
+  result.effectiveLoadingDescendantLimit =
+      this->_effectiveLoadingDescendantLimit;
+
+  this->_effectiveMaximumSimultaneousTileLoads = static_cast<uint32_t>(
+      glm::floor(this->_networkSimultaneousTileLoads));
+  result.effectiveMaximumSimultaneousTileLoads =
+      this->_effectiveMaximumSimultaneousTileLoads;
+}
 
+void Tileset::_recordTraversalInputs(const std::vector<ViewState>& frustums) {
+  LastTraversalInputs& last = this->_lastTraversalInputs;
+
+  // ViewState is not assignable, so copy-construct the new list and swap.
+  std::vector<ViewState> frustumsCopy(frustums);
+  last.frustums.swap(frustumsCopy);
+
+  const TilesetOptions& options = this->_options;
+  last.maximumScreenSpaceError = this->_effectiveMaximumScreenSpaceError;
+  last.culledScreenSpaceError = this->_effectiveCulledScreenSpaceError;
+  last.loadingDescendantLimit = this->_effectiveLoadingDescendantLimit;
+  last.enforceCulledScreenSpaceError = options.enforceCulledScreenSpaceError;
+  last.forbidHoles = options.forbidHoles;
+  last.enableFrustumCulling = options.enableFrustumCulling;
+  last.enableFogCulling = options.enableFogCulling;
+  last.renderTilesUnderCamera = options.renderTilesUnderCamera;
+  last.preloadAncestors = options.preloadAncestors;
+  last.preloadSiblings = options.preloadSiblings;
+  last.skipLevelOfDetail = options.skipLevelOfDetail;
+  last.foveatedLoading = options.foveatedLoading;
+}
+
+void Tileset::_startLoadTimingsFrame(const std::vector<ViewState>& frustums) {
+  // Compare with the views of the last change rather than of the previous
+  // frame, so that a camera that drifts slowly still changes the view.
+  const TilesetOptions& options = this->_options;
+  bool viewChanged = this->_loadTimings.viewChangeCount == 0 ||
+                     frustums.size() != this->_loadTimingFrustums.size();
+  for (size_t i = 0; !viewChanged && i < frustums.size(); ++i) {
+    viewChanged = !isViewNearlyUnchanged(
+        this->_loadTimingFrustums[i],
+        frustums[i],
+        options.cachedTraversalPositionTolerance,
+        options.cachedTraversalDirectionTolerance);
+  }
+
+  if (!viewChanged) {
+    return;
+  }
+
+  // The first views are measured from the construction of the tileset.
+  if (this->_loadTimings.viewChangeCount > 0) {
+    this->_viewChangeTime = std::chrono::steady_clock::now();
+  }
+  ++this->_loadTimings.viewChangeCount;
+  this->_loadTimings.timeToFullDetail.reset();
+  this->_viewFullyLoaded = false;
+  this->_loadTimingFrustums = frustums;
+}
+
+void Tileset::_finishLoadTimingsFrame(ViewUpdateResult& result) {
+  const auto now = std::chrono::steady_clock::now();
+  if (!this->_loadTimings.timeToFirstRenderableFrame &&
+      !result.tilesToRenderThisFrame.empty()) {
+    this->_loadTimings.timeToFirstRenderableFrame =
+        millisecondsBetween(this->_constructionTime, now);
+  }
+
+  if (!this->_viewFullyLoaded && this->_isViewFullyLoaded(result)) {
+    this->_viewFullyLoaded = true;
+    const double timeToFullDetail =
+        millisecondsBetween(this->_viewChangeTime, now);
+    this->_loadTimings.timeToFullDetail = timeToFullDetail;
+    result.timeToFullDetail = timeToFullDetail;
+  }
+}
+
+bool Tileset::_isViewFullyLoaded(
+    const ViewUpdateResult& result) const noexcept {
+  if (!this->getRootTile() || result.workerThreadTileLoadQueueLength > 0 ||
+      result.mainThreadTileLoadQueueLength > 0 || result.tilesKicked > 0 ||
+      !this->_nextDeferredTraversalTiles.empty() ||
+      this->_pTilesetContentManager->getNumberOfTilesLoading() > 0) {
+    return false;
+  }
+
+  for (const auto& pTileProvider :
+       this->_pTilesetContentManager->getRasterOverlayCollection()
+           .getTileProviders()) {
+    if (pTileProvider->getNumberOfTilesLoading() > 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Tileset::_addCreditsToFrame(const ViewUpdateResult& result) {
   // aggregate all the credits needed from this tileset for the current frame
   const std::shared_ptr<CreditSystem>& pCreditSystem =
       this->_externals.pCreditSystem;
@@ -423,11 +1118,41 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
       }
     }
   }
+}
 
-  this->_previousFrameNumber = currentFrameNumber;
+void Tileset::reportFrameStatistics(double frameTime, int64_t gpuMemoryUsage) {
+  const AdaptiveScreenSpaceErrorOptions& adaptive =
+      this->_options.adaptiveScreenSpaceError;
+  if (!adaptive.enabled) {
+    return;
+  }
 
-  return result;
+  const double high = 1.0 + adaptive.hysteresis;
+  const double low = 1.0 - adaptive.hysteresis;
+
+  const bool checkFrameTime = adaptive.targetFrameTime > 0.0;
+  const bool checkMemory = adaptive.gpuMemoryBudget > 0 && gpuMemoryUsage >= 0;
+  const double budget = double(adaptive.gpuMemoryBudget);
+  const double memory = double(gpuMemoryUsage);
+
+  const bool overBudget =
+      (checkFrameTime && frameTime > adaptive.targetFrameTime * high) ||
+      (checkMemory && memory > budget * high);
+  const bool underBudget =
+      (!checkFrameTime || frameTime < adaptive.targetFrameTime * low) &&
+      (!checkMemory || memory < budget * low);
+
+  // Within the hysteresis band, leave the scale alone.
+  if (overBudget) {
+    this->_screenSpaceErrorScale = glm::min(
+        this->_screenSpaceErrorScale * adaptive.scaleStep,
+        glm::max(adaptive.maximumScale, 1.0));
+  } else if (underBudget) {
+    this->_screenSpaceErrorScale =
+        glm::max(this->_screenSpaceErrorScale / adaptive.scaleStep, 1.0);
+  }
 }
+
 int32_t Tileset::getNumberOfTilesLoaded() const {
   return this->_pTilesetContentManager->getNumberOfTilesLoaded();
 }
@@ -455,20 +1180,164 @@ float Tileset::computeLoadProgress() noexcept {
   return (percentage * 100.f);
 }
 
-void Tileset::forEachLoadedTile(
-    const std::function<void(Tile& tile)>& callback) {
-  Tile* pCurrent = this->_loadedTiles.head();
-  while (pCurrent) {
-    Tile* pNext = this->_loadedTiles.next(pCurrent);
-    callback(*pCurrent);
-    pCurrent = pNext;
+void Tileset::forEachLoadedTileInParallel(
+    const std::function<void(const Tile& tile)>& callback) {
+  CESIUM_TRACE_CATEGORY(MainThread, "Tileset::forEachLoadedTileInParallel");
+
+  std::vector<Tile*> tiles;
+  this->getLoadedTiles(tiles);
+
+  const uint32_t threadCount = this->_options.parallelTraversalThreadCount;
+  const size_t tileCount = tiles.size();
+  if (threadCount == 0 || tileCount < 2) {
+    for (const Tile* pTile : tiles) {
+      callback(*pTile);
+    }
+    return;
+  }
+
+  ThreadPool& threadPool = this->_getTraversalThreadPool(threadCount);
+
+  auto visitBatch = [&tiles, &callback](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      callback(*tiles[i]);
+    }
+  };
+
+  // The calling thread visits the first batch itself.
+  const size_t batchCount = size_t(threadCount) + 1;
+  const size_t batchSize = (tileCount + batchCount - 1) / batchCount;
+
+  std::vector<Future<void>> futures;
+  futures.reserve(batchCount - 1);
+  for (size_t begin = batchSize; begin < tileCount; begin += batchSize) {
+    const size_t end = std::min(begin + batchSize, tileCount);
+    futures.emplace_back(this->_asyncSystem.runInThreadPool(
+        threadPool,
+        [&visitBatch, begin, end]() { visitBatch(begin, end); }));
+  }
+
+  visitBatch(0, std::min(batchSize, tileCount));
+
+  for (Future<void>& future : futures) {
+    future.wait();
+  }
+}
+
+void Tileset::getLoadedTiles(std::vector<Tile*>& tiles) {
+  tiles.clear();
+  for (Tile* pTile = this->_loadedTiles.head(); pTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    tiles.emplace_back(pTile);
+  }
+}
+
+void Tileset::updateTileBoundsBuffer(TileBoundsBuffer& buffer) {
+  std::vector<const Tile*> tiles;
+  for (const Tile* pTile = this->_loadedTiles.head(); pTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    if (pTile->getState() == TileLoadState::Done && pTile->isRenderContent()) {
+      tiles.emplace_back(pTile);
+    }
+  }
+
+  buffer.update(tiles);
+}
+
+std::optional<double> Tileset::intersectRay(const Ray& ray) {
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return std::nullopt;
+  }
+
+  const std::optional<double> entryDistance =
+      IntersectionTests::rayOBBParametric(
+          ray,
+          getOrientedBoundingBoxFromBoundingVolume(
+              pRootTile->getBoundingVolume()));
+  if (!entryDistance) {
+    return std::nullopt;
   }
+
+  return this->_intersectRayWithTile(
+      *pRootTile,
+      ray,
+      std::numeric_limits<double>::max());
+}
+
+std::vector<std::optional<double>>
+Tileset::intersectRays(const std::vector<Ray>& rays) {
+  std::vector<std::optional<double>> result;
+  result.reserve(rays.size());
+  for (const Ray& ray : rays) {
+    result.emplace_back(this->intersectRay(ray));
+  }
+
+  return result;
+}
+
+std::vector<std::optional<double>>
+Tileset::sampleHeights(const std::vector<Cartographic>& positions) {
+  // Above the highest mountains and buildings.
+  const double rayStartHeight = 100000.0;
+
+  std::vector<Cartographic> rayStarts;
+  rayStarts.reserve(positions.size());
+  for (const Cartographic& position : positions) {
+    rayStarts.emplace_back(
+        position.longitude,
+        position.latitude,
+        rayStartHeight);
+  }
+
+  std::vector<glm::dvec3> origins(positions.size());
+  Ellipsoid::WGS84.cartographicToCartesian(rayStarts, origins);
+
+  // The normal is the same at every height above a position.
+  std::vector<glm::dvec3> normals(positions.size());
+  Ellipsoid::WGS84.geodeticSurfaceNormal(origins, normals);
+
+  std::vector<std::optional<double>> result;
+  result.reserve(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const std::optional<double> distance =
+        this->intersectRay(Ray(origins[i], -normals[i]));
+    result.emplace_back(
+        distance ? std::optional<double>(rayStartHeight - *distance)
+                 : std::nullopt);
+  }
+
+  return result;
 }
 
 int64_t Tileset::getTotalDataBytes() const noexcept {
   return this->_pTilesetContentManager->getTotalDataUsed();
 }
 
+const TileLoadStatistics& Tileset::getLoadStatistics() const noexcept {
+  return this->_pTilesetContentManager->getLoadStatistics();
+}
+
+void Tileset::resetLoadStatistics() noexcept {
+  this->_pTilesetContentManager->resetLoadStatistics();
+}
+
+TilesetLoadTimings Tileset::getLoadTimings() const noexcept {
+  TilesetLoadTimings result = this->_loadTimings;
+  const std::optional<std::chrono::steady_clock::time_point>&
+      rootTileAvailableTime =
+          this->_pTilesetContentManager->getRootTileAvailableTime();
+  if (rootTileAvailableTime) {
+    result.timeToRootTileAvailable =
+        millisecondsBetween(this->_constructionTime, *rootTileAvailableTime);
+  }
+  return result;
+}
+
+int64_t Tileset::getTotalGpuDataBytes() const noexcept {
+  return this->_pTilesetContentManager->getTotalGpuDataUsed();
+}
+
 const TilesetMetadata* Tileset::getMetadata(const Tile* pTile) const {
   if (pTile == nullptr) {
     pTile = this->getRootTile();
@@ -531,7 +1400,7 @@ static void markTileNonRendered(
   if (lastResult == TileSelectionState::Result::Rendered ||
       (lastResult == TileSelectionState::Result::Refined &&
        tile.getRefine() == TileRefine::Add)) {
-    result.tilesFadingOut.insert(&tile);
+    addTileFadingOut(tile, result);
     TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
     if (pRenderContent) {
       pRenderContent->setLodTransitionFadePercentage(0.0f);
@@ -583,11 +1452,36 @@ static void markTileAndChildrenNonRendered(
 }
 
 /**
- * @brief Returns whether a tile with the given bounding volume is visible for
- * the camera.
+ * @brief Returns whether the camera is above or below a tile.
+ *
+ * @param viewState The {@link ViewState}
+ * @param tile The tile
+ * @return Whether the camera's cartographic position is within the tile's
+ * estimated globe rectangle
+ */
+static bool isUnderCamera(const ViewState& viewState, const Tile& tile) {
+  const std::optional<CesiumGeospatial::Cartographic>& position =
+      viewState.getPositionCartographic();
+  if (!position) {
+    return false;
+  }
+
+  // TODO: it would be better to test a line pointing down (and up?) from the
+  // camera against the bounding volume itself, rather than transforming the
+  // bounding volume to a region.
+  std::optional<GlobeRectangle> maybeRectangle =
+      tile.getEstimatedGlobeRectangle();
+  if (maybeRectangle) {
+    return maybeRectangle->contains(position.value());
+  }
+  return false;
+}
+
+/**
+ * @brief Returns whether a tile is visible for the camera.
  *
  * @param viewState The {@link ViewState}
- * @param boundingVolume The bounding volume of the tile
+ * @param tile The tile
  * @param forceRenderTilesUnderCamera Whether tiles under the camera should
  * always be considered visible and rendered (see
  * {@link Cesium3DTilesSelection::TilesetOptions}).
@@ -596,27 +1490,36 @@ static void markTileAndChildrenNonRendered(
  */
 static bool isVisibleFromCamera(
     const ViewState& viewState,
-    const BoundingVolume& boundingVolume,
+    const Tile& tile,
     bool forceRenderTilesUnderCamera) {
-  if (viewState.isBoundingVolumeVisible(boundingVolume)) {
+  if (viewState.isBoundingVolumeVisible(tile.getBoundingVolume())) {
     return true;
   }
   if (!forceRenderTilesUnderCamera) {
     return false;
   }
 
-  const std::optional<CesiumGeospatial::Cartographic>& position =
-      viewState.getPositionCartographic();
+  return isUnderCamera(viewState, tile);
+}
 
-  // TODO: it would be better to test a line pointing down (and up?) from the
-  // camera against the bounding volume itself, rather than transforming the
-  // bounding volume to a region.
-  std::optional<GlobeRectangle> maybeRectangle =
-      estimateGlobeRectangle(boundingVolume);
-  if (position && maybeRectangle) {
-    return maybeRectangle->contains(position.value());
+void Tileset::_computeVisibilityPerView(
+    const std::vector<ViewState>& frustums,
+    ViewUpdateResult& result) const {
+  result.tileVisibilityPerView.clear();
+  if (!this->_options.computeVisibilityPerView) {
+    return;
+  }
+
+  const bool renderTilesUnderCamera = this->_options.renderTilesUnderCamera;
+  result.tileVisibilityPerView.reserve(
+      result.tilesToRenderThisFrame.size() * frustums.size());
+  for (const Tile* pTile : result.tilesToRenderThisFrame) {
+    for (const ViewState& frustum : frustums) {
+      result.tileVisibilityPerView.emplace_back(
+          isVisibleFromCamera(frustum, *pTile, renderTilesUnderCamera) ? 1
+                                                                       : 0);
+    }
   }
-  return false;
 }
 
 /**
@@ -646,43 +1549,105 @@ void Tileset::_frustumCull(
   }
 
   const std::vector<ViewState>& frustums = frameState.frustums;
+  const TileViewEvaluations& evaluations = *frameState.pTileViewEvaluations;
+  const CombinedViewState* pCombinedView = frameState.pCombinedView;
+  const bool renderTilesUnderCamera = this->_options.renderTilesUnderCamera;
+
+  // Visibility comes from the evaluations computed ahead of the traversal if
+  // available, then from a batch of children culled together (which doesn't
+  // account for tiles under the camera), and finally from culling the tile on
+  // its own, against the combined frustum first if there is one.
+  auto isVisibleInAnyFrustum = [&frustums,
+                                &evaluations,
+                                pCombinedView,
+                                renderTilesUnderCamera](
+                                   const Tile& candidate,
+                                   const uint8_t* pBatchVisibility) {
+    const std::optional<size_t> maybeOffset = evaluations.find(candidate);
+    const BoundingVolume& boundingVolume = candidate.getBoundingVolume();
+    const bool outsideCombinedView =
+        !maybeOffset && !pBatchVisibility && pCombinedView &&
+        !pCombinedView->isBoundingVolumeVisible(boundingVolume);
+    if (outsideCombinedView && !renderTilesUnderCamera) {
+      return false;
+    }
+
+    for (size_t i = 0; i < frustums.size(); ++i) {
+      bool visible;
+      if (maybeOffset) {
+        visible = evaluations.visibility[*maybeOffset + i] != 0;
+      } else if (pBatchVisibility) {
+        visible = pBatchVisibility[i] != 0 ||
+                  (renderTilesUnderCamera &&
+                   isUnderCamera(frustums[i], candidate));
+      } else if (outsideCombinedView) {
+        visible = isUnderCamera(frustums[i], candidate);
+      } else {
+        visible = isVisibleFromCamera(
+            frustums[i],
+            candidate,
+            renderTilesUnderCamera);
+      }
+
+      if (visible) {
+        return true;
+      }
+    }
+
+    return false;
+  };
+
+  const size_t frustumCount = frustums.size();
+
   // Frustum cull using the children's bounds.
   if (cullWithChildrenBounds) {
-    if (std::any_of(
-            frustums.begin(),
-            frustums.end(),
-            [children = tile.getChildren(),
-             renderTilesUnderCamera = this->_options.renderTilesUnderCamera](
-                const ViewState& frustum) {
-              for (const Tile& child : children) {
-                if (isVisibleFromCamera(
-                        frustum,
-                        child.getBoundingVolume(),
-                        renderTilesUnderCamera)) {
-                  return true;
-                }
-              }
-
-              return false;
-            })) {
-      // At least one child is visible in at least one frustum, so don't cull.
+    gsl::span<const Tile> children = tile.getChildren();
+    const bool cullAsBatch = !evaluations.find(children[0]);
+    const size_t offset =
+        cullAsBatch
+            ? this->_computeChildVisibility(tile, frustums, pCombinedView)
+            : 0;
+
+    bool anyChildVisible = false;
+    for (size_t i = 0; i < children.size(); ++i) {
+      const uint8_t* pBatchVisibility =
+          cullAsBatch
+              ? this->_childVisibility.data() + offset + i * frustumCount
+              : nullptr;
+      if (isVisibleInAnyFrustum(children[i], pBatchVisibility)) {
+        anyChildVisible = true;
+        break;
+      }
+    }
+
+    if (cullAsBatch) {
+      this->_childVisibility.resize(offset);
+    }
+
+    if (anyChildVisible) {
+      // At least one child is visible in at least one frustum, so don't
+      // cull.
       return;
     }
     // Frustum cull based on the actual tile's bounds.
-  } else if (std::any_of(
-                 frustums.begin(),
-                 frustums.end(),
-                 [&boundingVolume = tile.getBoundingVolume(),
-                  renderTilesUnderCamera =
-                      this->_options.renderTilesUnderCamera](
-                     const ViewState& frustum) {
-                   return isVisibleFromCamera(
-                       frustum,
-                       boundingVolume,
-                       renderTilesUnderCamera);
-                 })) {
-    // The tile is visible in at least one frustum, so don't cull.
-    return;
+  } else {
+    // Use the batch computed when visiting this tile's parent, if there is
+    // one.
+    const uint8_t* pBatchVisibility = nullptr;
+    const Tile* pParent = tile.getParent();
+    if (pParent && !this->_childVisibilityBatches.empty() &&
+        this->_childVisibilityBatches.back().pParent == pParent) {
+      const size_t childIndex =
+          size_t(&tile - pParent->getChildren().data());
+      pBatchVisibility = this->_childVisibility.data() +
+                         this->_childVisibilityBatches.back().offset +
+                         childIndex * frustumCount;
+    }
+
+    if (isVisibleInAnyFrustum(tile, pBatchVisibility)) {
+      // The tile is visible in at least one frustum, so don't cull.
+      return;
+    }
   }
 
   // If we haven't returned yet, this tile is frustum culled.
@@ -728,10 +1693,50 @@ void Tileset::_fogCull(
   }
 }
 
+// Computes the angle between the viewer's gaze and the nearest part of a
+// tile, given the direction and distance to the center of the tile and the
+// distance to its bounding volume. The angular radius of the tile is estimated
+// from the difference between the two distances.
+static double computeAngleFromGaze(
+    const ViewState& frustum,
+    const glm::dvec3& tileDirection,
+    double centerDistance,
+    double distance) noexcept {
+  const double cosine = glm::dot(tileDirection, frustum.getGazeDirection());
+  const double angleToCenter = glm::acos(glm::clamp(cosine, -1.0, 1.0));
+  const double angularRadius = glm::asin(
+      glm::clamp((centerDistance - distance) / centerDistance, 0.0, 1.0));
+  return glm::max(angleToCenter - angularRadius, 0.0);
+}
+
+// The factor by which FoveatedLoadingOptions relaxes the maximum screen-space
+// error of a tile at the given angle from the viewer's gaze.
+static double computePeripheralScreenSpaceErrorFactor(
+    const FoveatedLoadingOptions& foveation,
+    const ViewState& frustum,
+    double angle) noexcept {
+  if (angle <= foveation.fovealAngle) {
+    return 1.0;
+  }
+
+  const double tanHalfHorizontal =
+      glm::tan(0.5 * frustum.getHorizontalFieldOfView());
+  const double tanHalfVertical =
+      glm::tan(0.5 * frustum.getVerticalFieldOfView());
+  const double cornerAngle = glm::atan(glm::sqrt(
+      tanHalfHorizontal * tanHalfHorizontal +
+      tanHalfVertical * tanHalfVertical));
+  const double span = cornerAngle - foveation.fovealAngle;
+  const double fraction =
+      span > 0.0 ? glm::min((angle - foveation.fovealAngle) / span, 1.0) : 1.0;
+  return 1.0 + (foveation.peripheralScreenSpaceErrorFactor - 1.0) * fraction;
+}
+
 static double computeTilePriority(
     const Tile& tile,
     const std::vector<ViewState>& frustums,
-    const std::vector<double>& distances) {
+    const std::vector<double>& distances,
+    const FoveatedLoadingOptions& foveation) {
   double highestLoadPriority = std::numeric_limits<double>::max();
   const glm::dvec3 boundingVolumeCenter =
       getBoundingVolumeCenter(tile.getBoundingVolume());
@@ -745,8 +1750,21 @@ static double computeTilePriority(
 
     if (magnitude >= CesiumUtility::Math::Epsilon5) {
       tileDirection /= magnitude;
-      const double loadPriority =
-          (1.0 - glm::dot(tileDirection, frustum.getDirection())) * distance;
+      double loadPriority;
+      if (foveation.enabled) {
+        // Tiles in the fovea load in order of distance, and the priority of
+        // the others grows with their angle outside of it.
+        const double fovealAngle =
+            glm::max(foveation.fovealAngle, CesiumUtility::Math::Epsilon5);
+        const double angle =
+            computeAngleFromGaze(frustum, tileDirection, magnitude, distance);
+        loadPriority =
+            (1.0 + glm::max(angle - fovealAngle, 0.0) / fovealAngle) *
+            distance;
+      } else {
+        loadPriority =
+            (1.0 - glm::dot(tileDirection, frustum.getDirection())) * distance;
+      }
       if (loadPriority < highestLoadPriority) {
         highestLoadPriority = loadPriority;
       }
@@ -759,46 +1777,117 @@ static double computeTilePriority(
 void computeDistances(
     const Tile& tile,
     const std::vector<ViewState>& frustums,
+    const CombinedViewState* pCombinedView,
     std::vector<double>& distances) {
   const BoundingVolume& boundingVolume = tile.getBoundingVolume();
 
   distances.clear();
   distances.resize(frustums.size());
 
+  if (pCombinedView &&
+      pCombinedView->computeDistances(boundingVolume, distances)) {
+    return;
+  }
+
   std::transform(
       frustums.begin(),
       frustums.end(),
       distances.begin(),
-      [boundingVolume](const ViewState& frustum) -> double {
+      [&boundingVolume](const ViewState& frustum) -> double {
         return glm::sqrt(glm::max(
             frustum.computeDistanceSquaredToBoundingVolume(boundingVolume),
             0.0));
       });
 }
 
-bool Tileset::_meetsSse(
+static double computeLargestSse(
     const std::vector<ViewState>& frustums,
     const Tile& tile,
     const std::vector<double>& distances,
-    bool culled) const noexcept {
-
+    const FoveatedLoadingOptions& foveation) noexcept {
   double largestSse = 0.0;
 
+  // Peripheral tiles are only relaxed if the factor would change anything.
+  const bool relaxPeriphery =
+      foveation.enabled && foveation.peripheralScreenSpaceErrorFactor != 1.0;
+  const glm::dvec3 boundingVolumeCenter =
+      relaxPeriphery ? getBoundingVolumeCenter(tile.getBoundingVolume())
+                     : glm::dvec3(0.0);
+
   for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
     const ViewState& frustum = frustums[i];
     const double distance = distances[i];
 
-    // Does this tile meet the screen-space error?
-    const double sse =
+    double sse =
         frustum.computeScreenSpaceError(tile.getGeometricError(), distance);
+
+    if (relaxPeriphery) {
+      const glm::dvec3 tileDirection =
+          boundingVolumeCenter - frustum.getPosition();
+      const double magnitude = glm::length(tileDirection);
+      if (magnitude >= CesiumUtility::Math::Epsilon5) {
+        const double angle = computeAngleFromGaze(
+            frustum,
+            tileDirection / magnitude,
+            magnitude,
+            distance);
+        sse /=
+            computePeripheralScreenSpaceErrorFactor(foveation, frustum, angle);
+      }
+    }
+
     if (sse > largestSse) {
       largestSse = sse;
     }
   }
 
+  return largestSse;
+}
+
+bool Tileset::_meetsSse(
+    const std::vector<ViewState>& frustums,
+    const Tile& tile,
+    const std::vector<double>& distances,
+    bool culled) const noexcept {
+  // Does this tile meet the screen-space error?
+  const double largestSse = computeLargestSse(
+      frustums,
+      tile,
+      distances,
+      this->_options.foveatedLoading);
+
   return culled ? !this->_options.enforceCulledScreenSpaceError ||
-                      largestSse < this->_options.culledScreenSpaceError
-                : largestSse < this->_options.maximumScreenSpaceError;
+                      largestSse < this->_effectiveCulledScreenSpaceError
+                : largestSse < this->_effectiveMaximumScreenSpaceError;
+}
+
+bool Tileset::_isNearSse(
+    const std::vector<ViewState>& frustums,
+    const Tile& tile,
+    const std::vector<double>& distances) const noexcept {
+  return computeLargestSse(
+             frustums,
+             tile,
+             distances,
+             this->_options.foveatedLoading) >=
+         this->_effectiveMaximumScreenSpaceError *
+             this->_options.subtreePrefetchScreenSpaceErrorFraction;
+}
+
+// Culling with children bounds will give us incorrect results with Add
+// refinement, but is a useful optimization for Replace refinement.
+static bool shouldCullWithChildrenBounds(const Tile& tile) noexcept {
+  if (tile.getRefine() != TileRefine::Replace || tile.getChildren().empty()) {
+    return false;
+  }
+
+  for (const Tile& child : tile.getChildren()) {
+    if (child.getUnconditionallyRefine()) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 // Visits a tile for possible rendering. When we call this function with a tile:
@@ -815,33 +1904,62 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     ViewUpdateResult& result) {
 
   std::vector<double>& distances = this->_distances;
-  computeDistances(tile, frameState.frustums, distances);
-  double tilePriority =
-      computeTilePriority(tile, frameState.frustums, distances);
+  const TileViewEvaluations& evaluations = *frameState.pTileViewEvaluations;
+  const std::optional<size_t> maybeEvaluationOffset = evaluations.find(tile);
+  if (maybeEvaluationOffset) {
+    auto first = evaluations.distances.begin() +
+                 static_cast<std::vector<double>::difference_type>(
+                     *maybeEvaluationOffset);
+    distances.assign(
+        first,
+        first + static_cast<std::vector<double>::difference_type>(
+                    evaluations.frustumCount));
+  } else {
+    computeDistances(
+        tile,
+        frameState.frustums,
+        frameState.pCombinedView,
+        distances);
+  }
+  double tilePriority = computeTilePriority(
+      tile,
+      frameState.frustums,
+      distances,
+      this->_options.foveatedLoading);
 
   this->_pTilesetContentManager->updateTileContent(tile, _options);
   this->_markTileVisited(tile);
 
+  if (this->_options.enableCachedTraversal &&
+      this->_pTilesetContentManager->tileNeedsContentUpdate(tile)) {
+    this->_lastTraversalInputs.allVisitedTilesSettled = false;
+  }
+
   CullResult cullResult{};
 
-  // Culling with children bounds will give us incorrect results with Add
-  // refinement, but is a useful optimization for Replace refinement.
-  bool cullWithChildrenBounds =
-      tile.getRefine() == TileRefine::Replace && !tile.getChildren().empty();
-  for (Tile& child : tile.getChildren()) {
-    if (child.getUnconditionallyRefine()) {
-      cullWithChildrenBounds = false;
-      break;
-    }
-  }
+  const bool cullWithChildrenBounds = shouldCullWithChildrenBounds(tile);
 
   // TODO: add cullWithChildrenBounds to the tile excluder interface?
-  for (const std::shared_ptr<ITileExcluder>& pExcluder :
-       this->_options.excluders) {
-    if (pExcluder->shouldExclude(tile)) {
+  const std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+      this->_options.excluders;
+  for (size_t i = 0; i < excluders.size(); ++i) {
+    // Skip the excluder if it included the whole subtree of an ancestor.
+    uint32_t& includedDepth = this->_excluderSubtreeIncludedDepths[i];
+    if (includedDepth < depth) {
+      continue;
+    }
+    includedDepth = std::numeric_limits<uint32_t>::max();
+
+    if (cullResult.culled) {
+      continue;
+    }
+
+    const TileExclusionResult exclusion = excluders[i]->checkExclusion(tile);
+    if (exclusion == TileExclusionResult::Excluded) {
       cullResult.culled = true;
       cullResult.shouldVisit = false;
-      break;
+    } else if (exclusion == TileExclusionResult::SubtreeIncluded) {
+      includedDepth = depth;
     }
   }
 
@@ -899,10 +2017,28 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
   bool meetsSse =
       this->_meetsSse(frameState.frustums, tile, distances, cullResult.culled);
 
+  // Only needed to decide which refined tiles to skip.
+  const double screenSpaceError =
+      this->_options.skipLevelOfDetail.enabled
+          ? computeLargestSse(
+                frameState.frustums,
+                tile,
+                distances,
+                this->_options.foveatedLoading)
+          : 0.0;
+
+  // The tile may be refined soon, so get ready to create its children.
+  if (this->_options.prefetchSubtrees && meetsSse && !cullResult.culled &&
+      this->_isNearSse(frameState.frustums, tile, distances)) {
+    this->_subtreePrefetchQueue.push_back(
+        {&tile, TileLoadPriorityGroup::Preload, tilePriority});
+  }
+
   return this->_visitTile(
       frameState,
       depth,
       meetsSse,
+      screenSpaceError,
       ancestorMeetsSse,
       tile,
       tilePriority,
@@ -1062,7 +2198,7 @@ bool Tileset::_kickDescendantsAndRenderTile(
 
   if (!wasReallyRenderedLastFrame &&
       traversalDetails.notYetRenderableCount >
-          this->_options.loadingDescendantLimit &&
+          this->_effectiveLoadingDescendantLimit &&
       !tile.isExternalContent() && !tile.getUnconditionallyRefine()) {
 
     // Remove all descendants from the load queues.
@@ -1201,6 +2337,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
     const FrameState& frameState,
     uint32_t depth,
     bool meetsSse,
+    double screenSpaceError,
     bool ancestorMeetsSse, // Careful: May be modified before being passed to
                            // children!
     Tile& tile,
@@ -1248,6 +2385,18 @@ Tileset::TraversalDetails Tileset::_visitTile(
                               wantToRefine && !unconditionallyRefine &&
                               (!tileLastRefined || !childLastRefined);
 
+  // Optionally, spend occlusion checks only on tiles whose children still
+  // need to be loaded.
+  if (shouldCheckOcclusion && this->_options.checkOcclusionOnlyBeforeLoading) {
+    shouldCheckOcclusion = false;
+    for (const Tile& child : tile.getChildren()) {
+      if (!child.isRenderable()) {
+        shouldCheckOcclusion = true;
+        break;
+      }
+    }
+  }
+
   if (shouldCheckOcclusion) {
     TileOcclusionState occlusion = this->_checkOcclusion(tile, frameState);
     if (occlusion == TileOcclusionState::Occluded) {
@@ -1266,6 +2415,29 @@ Tileset::TraversalDetails Tileset::_visitTile(
     }
   }
 
+  // With skipLevelOfDetail, a tile that is refined below the base is only
+  // loaded if it is far enough below the last tile loaded above it. The tiles
+  // in between are skipped.
+  const SkipLevelOfDetailOptions& skip = this->_options.skipLevelOfDetail;
+  const std::optional<SkipLevelOfDetailAncestor> skipAncestor =
+      this->_skipLevelOfDetailAncestor;
+  bool belowSkipBase = false;
+  bool loadBelowSkipBase = false;
+  if (skip.enabled && wantToRefine && !unconditionallyRefine) {
+    const double baseScreenSpaceError = glm::max(
+        skip.baseScreenSpaceError * this->_screenSpaceErrorScale *
+            this->_networkScreenSpaceErrorScale,
+        this->_effectiveMaximumScreenSpaceError);
+    belowSkipBase = skip.immediatelyLoadDesiredLevelOfDetail ||
+                    screenSpaceError < baseScreenSpaceError;
+    loadBelowSkipBase =
+        belowSkipBase && !skip.immediatelyLoadDesiredLevelOfDetail &&
+        (!skipAncestor ||
+         (depth > skipAncestor->depth + skip.skipLevels &&
+          screenSpaceError < skipAncestor->screenSpaceError /
+                                 skip.skipScreenSpaceErrorFactor));
+  }
+
   bool queuedForLoad = false;
 
   if (!wantToRefine) {
@@ -1321,6 +2493,16 @@ Tileset::TraversalDetails Tileset::_visitTile(
                       queuedForLoad) ||
                   queuedForLoad;
 
+  if (loadBelowSkipBase) {
+    // Render this tile in place of its descendants until they have loaded.
+    if (!queuedForLoad) {
+      addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+      queuedForLoad = true;
+    }
+    this->_skipLevelOfDetailAncestor =
+        SkipLevelOfDetailAncestor{depth, screenSpaceError};
+  }
+
   const size_t firstRenderedDescendantIndex =
       result.tilesToRenderThisFrame.size();
   const size_t workerThreadLoadQueueIndex = this->_workerThreadLoadQueue.size();
@@ -1333,6 +2515,8 @@ Tileset::TraversalDetails Tileset::_visitTile(
       tile,
       result);
 
+  this->_skipLevelOfDetailAncestor = skipAncestor;
+
   // Zero or more descendant tiles were added to the render list.
   // The traversalDetails tell us what happened while visiting the children.
 
@@ -1341,6 +2525,13 @@ Tileset::TraversalDetails Tileset::_visitTile(
   bool kickDueToNonReadyDescendant = !traversalDetails.allAreRenderable &&
                                      !traversalDetails.anyWereRenderedLastFrame;
 
+  // Below the base of skipLevelOfDetail, the descendants are only kicked in
+  // favor of a tile that can be rendered in their place. Otherwise they are
+  // kicked by the nearest ancestor that can.
+  if (belowSkipBase && kickDueToNonReadyDescendant && !tile.isRenderable()) {
+    kickDueToNonReadyDescendant = false;
+  }
+
   // Descendants may also be kicked if this tile was rendered last frame and
   // has not finished fading in yet.
   const TileRenderContent* pRenderContent =
@@ -1373,7 +2564,8 @@ Tileset::TraversalDetails Tileset::_visitTile(
         TileSelectionState::Result::Refined));
   }
 
-  if (this->_options.preloadAncestors && !queuedForLoad) {
+  // Skipped tiles are not preloaded either.
+  if (this->_options.preloadAncestors && !queuedForLoad && !belowSkipBase) {
     addTileToLoadQueue(tile, TileLoadPriorityGroup::Preload, tilePriority);
   }
 
@@ -1390,82 +2582,677 @@ Tileset::TraversalDetails Tileset::_visitVisibleChildrenNearToFar(
 
   // TODO: actually visit near-to-far, rather than in order of occurrence.
   gsl::span<Tile> children = tile.getChildren();
-  for (Tile& child : children) {
-    const TraversalDetails childTraversal = this->_visitTileIfNeeded(
-        frameState,
-        depth + 1,
-        ancestorMeetsSse,
-        child,
-        result);
+
+  // Cull all children that will be culled using their own bounds in one pass,
+  // rather than one at a time as each is visited. Children that were evaluated
+  // ahead of the traversal don't need it.
+  const bool cullAsBatch =
+      !children.empty() &&
+      !frameState.pTileViewEvaluations->find(children[0]) &&
+      std::any_of(children.begin(), children.end(), [](const Tile& child) {
+        return !shouldCullWithChildrenBounds(child);
+      });
+  if (cullAsBatch) {
+    this->_childVisibilityBatches.push_back(ChildVisibilityBatch{
+        &tile,
+        this->_computeChildVisibility(
+            tile,
+            frameState.frustums,
+            frameState.pCombinedView)});
+  }
+
+  const auto visitChild = [&](Tile& child) {
+    TraversalDetails childTraversal;
+    if (depth > 0 && this->_traversalDeadline &&
+        std::chrono::system_clock::now() >= *this->_traversalDeadline) {
+      // Out of time: repeat last frame's selection for this subtree, and
+      // remember it (and its ancestors) so that it is visited first next frame.
+      for (const Tile* pTile = &child; pTile; pTile = pTile->getParent()) {
+        if (!this->_nextDeferredTraversalTiles.insert(pTile).second) {
+          break;
+        }
+      }
+      this->_lastTraversalInputs.allVisitedTilesSettled = false;
+      childTraversal =
+          this->_reuseLastSelectionOfSubtree(frameState, child, result);
+    } else {
+      childTraversal = this->_visitTileIfNeeded(
+          frameState,
+          depth + 1,
+          ancestorMeetsSse,
+          child,
+          result);
+    }
 
     traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
     traversalDetails.anyWereRenderedLastFrame |=
         childTraversal.anyWereRenderedLastFrame;
     traversalDetails.notYetRenderableCount +=
         childTraversal.notYetRenderableCount;
+  };
+
+  if (this->_deferredTraversalTiles.empty()) {
+    for (Tile& child : children) {
+      visitChild(child);
+    }
+  } else {
+    // Visit the subtrees that the previous traversal ran out of time for
+    // first, so that a traversal that keeps running out of time does not
+    // starve them.
+    const auto isDeferred = [this](const Tile& child) {
+      return this->_deferredTraversalTiles.find(&child) !=
+             this->_deferredTraversalTiles.end();
+    };
+    for (Tile& child : children) {
+      if (isDeferred(child)) {
+        visitChild(child);
+      }
+    }
+    for (Tile& child : children) {
+      if (!isDeferred(child)) {
+        visitChild(child);
+      }
+    }
+  }
+
+  if (cullAsBatch) {
+    this->_childVisibility.resize(this->_childVisibilityBatches.back().offset);
+    this->_childVisibilityBatches.pop_back();
   }
 
   return traversalDetails;
 }
 
-void Tileset::_processWorkerThreadLoadQueue() {
-  CESIUM_TRACE("Tileset::_processWorkerThreadLoadQueue");
+Tileset::TraversalDetails Tileset::_reuseLastSelectionOfSubtree(
+    const FrameState& frameState,
+    Tile& tile,
+    ViewUpdateResult& result) {
+  TraversalDetails traversalDetails;
 
-  int32_t maximumSimultaneousTileLoads =
-      static_cast<int32_t>(this->_options.maximumSimultaneousTileLoads);
+  const TileSelectionState::Result lastFrameResult =
+      tile.getLastSelectionState().getResult(frameState.lastFrameNumber);
+  if (lastFrameResult == TileSelectionState::Result::None) {
+    // Not visited last frame either, so there is nothing to repeat.
+    return traversalDetails;
+  }
+
+  this->_markTileVisited(tile);
+  tile.setLastSelectionState(
+      TileSelectionState(frameState.currentFrameNumber, lastFrameResult));
+
+  if (this->_previousTilesToRenderSet.empty()) {
+    this->_previousTilesToRenderSet.insert(
+        this->_previousTilesToRender.begin(),
+        this->_previousTilesToRender.end());
+  }
 
-  if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-      maximumSimultaneousTileLoads) {
+  if (this->_previousTilesToRenderSet.find(&tile) !=
+      this->_previousTilesToRenderSet.end()) {
+    if (tile.isRenderable()) {
+      result.tilesToRenderThisFrame.push_back(&tile);
+      traversalDetails.anyWereRenderedLastFrame = true;
+    } else {
+      traversalDetails.allAreRenderable = false;
+      ++traversalDetails.notYetRenderableCount;
+    }
+  }
+
+  if (lastFrameResult == TileSelectionState::Result::Refined) {
+    for (Tile& child : tile.getChildren()) {
+      const TraversalDetails childTraversal =
+          this->_reuseLastSelectionOfSubtree(frameState, child, result);
+      traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
+      traversalDetails.anyWereRenderedLastFrame |=
+          childTraversal.anyWereRenderedLastFrame;
+      traversalDetails.notYetRenderableCount +=
+          childTraversal.notYetRenderableCount;
+    }
+  }
+
+  return traversalDetails;
+}
+
+size_t Tileset::_computeChildVisibility(
+    const Tile& tile,
+    const std::vector<ViewState>& frustums,
+    const CombinedViewState* pCombinedView) {
+  gsl::span<const Tile> children = tile.getChildren();
+  const size_t frustumCount = frustums.size();
+  const size_t offset = this->_childVisibility.size();
+  this->_childVisibility.resize(offset + children.size() * frustumCount);
+
+  // Pack the children that can be culled as a batch, and cull the rest (S2
+  // cells) one at a time.
+  PackedBoundingVolumes& packed = this->_packedChildBounds;
+  std::vector<size_t>& packedIndices = this->_packedChildIndices;
+  packed.clear();
+  packedIndices.clear();
+  for (size_t i = 0; i < children.size(); ++i) {
+    const BoundingVolume& boundingVolume = children[i].getBoundingVolume();
+    if (packBoundingVolume(boundingVolume, packed)) {
+      packedIndices.emplace_back(i);
+      continue;
+    }
+
+    // The flags are already zero for a child outside the combined frustum.
+    if (pCombinedView &&
+        !pCombinedView->isBoundingVolumeVisible(boundingVolume)) {
+      continue;
+    }
+
+    for (size_t j = 0; j < frustumCount; ++j) {
+      this->_childVisibility[offset + i * frustumCount + j] =
+          frustums[j].isBoundingVolumeVisible(boundingVolume) ? 1 : 0;
+    }
+  }
+
+  if (packed.empty()) {
+    return offset;
+  }
+
+  std::vector<uint8_t>& packedVisibility = this->_packedChildVisibility;
+  packedVisibility.resize(packed.size());
+
+  // Only cull against each frustum if some child is inside the combined one.
+  if (pCombinedView) {
+    pCombinedView->computeBoundingVolumesVisibility(packed, packedVisibility);
+    if (std::all_of(
+            packedVisibility.begin(),
+            packedVisibility.end(),
+            [](uint8_t visible) { return visible == 0; })) {
+      return offset;
+    }
+  }
+
+  for (size_t j = 0; j < frustumCount; ++j) {
+    frustums[j].computeBoundingVolumesVisibility(packed, packedVisibility);
+    for (size_t k = 0; k < packedIndices.size(); ++k) {
+      this->_childVisibility[offset + packedIndices[k] * frustumCount + j] =
+          packedVisibility[k];
+    }
+  }
+
+  return offset;
+}
+
+std::optional<size_t>
+Tileset::TileViewEvaluations::find(const Tile& tile) const noexcept {
+  auto it = this->tileIndices.find(&tile);
+  if (it == this->tileIndices.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void Tileset::TileViewEvaluations::clear() noexcept {
+  this->frustumCount = 0;
+  this->tiles.clear();
+  this->tileIndices.clear();
+  this->distances.clear();
+  this->visibility.clear();
+}
+
+ThreadPool& Tileset::_getTraversalThreadPool(uint32_t threadCount) {
+  if (!this->_traversalThreadPool ||
+      this->_traversalThreadPoolSize != threadCount) {
+    this->_traversalThreadPool.emplace(
+        this->_asyncSystem.createThreadPool(static_cast<int32_t>(threadCount)));
+    this->_traversalThreadPoolSize = threadCount;
+  }
+  return *this->_traversalThreadPool;
+}
+
+void Tileset::_evaluateTilesInParallel(
+    const std::vector<ViewState>& frustums,
+    const CombinedViewState* pCombinedView,
+    int32_t lastFrameNumber) {
+  TileViewEvaluations& evaluations = this->_tileViewEvaluations;
+  evaluations.clear();
+
+  const uint32_t threadCount = this->_options.parallelTraversalThreadCount;
+  const Tile* pRootTile = this->getRootTile();
+  if (threadCount == 0 || frustums.empty() || pRootTile == nullptr) {
+    return;
+  }
+
+  CESIUM_TRACE_CATEGORY(Selection, "Tileset::_evaluateTilesInParallel");
+
+  // Gather the tiles that were visited last frame, which are very likely to be
+  // visited again this frame. The children of each visited tile are gathered
+  // as well, because their bounds may be used to cull their parent.
+  std::vector<const Tile*>& tiles = evaluations.tiles;
+  tiles.push_back(pRootTile);
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    const Tile* pTile = tiles[i];
+    if (pTile->getLastSelectionState().getFrameNumber() != lastFrameNumber) {
+      continue;
+    }
+    for (const Tile& child : pTile->getChildren()) {
+      tiles.push_back(&child);
+    }
+  }
+
+  const size_t tileCount = tiles.size();
+  if (tileCount < this->_options.parallelTraversalMinimumTiles) {
+    evaluations.clear();
     return;
   }
 
-  std::vector<TileLoadTask>& queue = this->_workerThreadLoadQueue;
-  std::sort(queue.begin(), queue.end());
+  const size_t frustumCount = frustums.size();
+  evaluations.frustumCount = frustumCount;
+  evaluations.distances.resize(tileCount * frustumCount);
+  evaluations.visibility.resize(tileCount * frustumCount);
+  evaluations.tileIndices.reserve(tileCount);
+  for (size_t i = 0; i < tileCount; ++i) {
+    evaluations.tileIndices.emplace(tiles[i], i * frustumCount);
+  }
+
+  ThreadPool& threadPool = this->_getTraversalThreadPool(threadCount);
+
+  // Each batch writes to a disjoint range of the output vectors, and nothing
+  // mutates the tiles until every batch is complete.
+  auto evaluateBatch = [&evaluations,
+                        &frustums,
+                        pCombinedView,
+                        renderTilesUnderCamera =
+                            this->_options.renderTilesUnderCamera](
+                           size_t begin,
+                           size_t end) {
+    const size_t count = evaluations.frustumCount;
+    for (size_t i = begin; i < end; ++i) {
+      const Tile& tile = *evaluations.tiles[i];
+      const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+      const size_t offset = i * count;
+
+      const bool distancesEstimated =
+          pCombinedView &&
+          pCombinedView->computeDistances(
+              boundingVolume,
+              gsl::span<double>(evaluations.distances).subspan(offset, count));
+      const bool outsideCombinedView =
+          pCombinedView &&
+          !pCombinedView->isBoundingVolumeVisible(boundingVolume);
+
+      for (size_t j = 0; j < count; ++j) {
+        const ViewState& frustum = frustums[j];
+        if (!distancesEstimated) {
+          evaluations.distances[offset + j] = glm::sqrt(glm::max(
+              frustum.computeDistanceSquaredToBoundingVolume(boundingVolume),
+              0.0));
+        }
+
+        bool visible;
+        if (outsideCombinedView) {
+          visible = renderTilesUnderCamera && isUnderCamera(frustum, tile);
+        } else {
+          visible =
+              isVisibleFromCamera(frustum, tile, renderTilesUnderCamera);
+        }
+        evaluations.visibility[offset + j] = visible ? 1 : 0;
+      }
+    }
+  };
+
+  // The calling thread evaluates the first batch itself.
+  const size_t batchCount = size_t(threadCount) + 1;
+  const size_t batchSize = (tileCount + batchCount - 1) / batchCount;
+
+  std::vector<Future<void>> futures;
+  futures.reserve(batchCount - 1);
+  for (size_t begin = batchSize; begin < tileCount; begin += batchSize) {
+    const size_t end = std::min(begin + batchSize, tileCount);
+    futures.emplace_back(this->_asyncSystem.runInThreadPool(
+        threadPool,
+        [&evaluateBatch, begin, end]() { evaluateBatch(begin, end); }));
+  }
+
+  evaluateBatch(0, std::min(batchSize, tileCount));
+
+  for (Future<void>& future : futures) {
+    future.wait();
+  }
+}
 
-  for (TileLoadTask& task : queue) {
-    this->_pTilesetContentManager->loadTileContent(*task.pTile, _options);
-    if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-        maximumSimultaneousTileLoads) {
+/**
+ * @brief Invokes a callback for the tasks in a load queue, in priority order,
+ * until the callback returns false.
+ *
+ * Only the tasks that are actually visited are put in order. Building the heap
+ * is linear and each visited task costs a logarithmic pop, which is much
+ * cheaper than sorting the entire queue when only a few of its tasks fit in
+ * the frame's load budget.
+ */
+template <typename Task, typename Callback>
+static void
+forEachInPriorityOrder(std::vector<Task>& queue, Callback&& callback) {
+  // The standard heap functions put the greatest element first, so invert the
+  // comparison to put the task that would sort first at the front.
+  auto sortsAfter = [](const Task& lhs, const Task& rhs) noexcept {
+    return rhs < lhs;
+  };
+
+  auto heapEnd = queue.end();
+  std::make_heap(queue.begin(), heapEnd, sortsAfter);
+  while (heapEnd != queue.begin()) {
+    std::pop_heap(queue.begin(), heapEnd, sortsAfter);
+    --heapEnd;
+    if (!callback(*heapEnd)) {
       break;
     }
   }
 }
+
+void Tileset::_queuePredictedTileLoads(
+    const std::vector<ViewState>& frustums,
+    float deltaTime) {
+  std::vector<glm::dvec3>& previousPositions = this->_previousViewPositions;
+  const double predictionTime = this->_options.predictiveLoadTime;
+
+  // Extrapolate each view from its velocity since the last call. Without a
+  // previous position or a frame time, there's nothing to extrapolate from.
+  std::vector<ViewState> predictedFrustums;
+  if (predictionTime > 0.0 && deltaTime > 0.0f &&
+      previousPositions.size() == frustums.size()) {
+    predictedFrustums.reserve(frustums.size());
+    for (size_t i = 0; i < frustums.size(); ++i) {
+      const ViewState& frustum = frustums[i];
+      const glm::dvec3 velocity =
+          (frustum.getPosition() - previousPositions[i]) / double(deltaTime);
+      if (glm::length(velocity) * predictionTime <
+          CesiumUtility::Math::Epsilon2) {
+        continue;
+      }
+      predictedFrustums.emplace_back(ViewState::create(
+          frustum.getPosition() + velocity * predictionTime,
+          frustum.getDirection(),
+          frustum.getUp(),
+          frustum.getViewportSize(),
+          frustum.getHorizontalFieldOfView(),
+          frustum.getVerticalFieldOfView()));
+    }
+  }
+
+  previousPositions.resize(frustums.size());
+  std::transform(
+      frustums.begin(),
+      frustums.end(),
+      previousPositions.begin(),
+      [](const ViewState& frustum) { return frustum.getPosition(); });
+
+  Tile* pRootTile = this->getRootTile();
+  if (predictedFrustums.empty() || pRootTile == nullptr) {
+    return;
+  }
+
+  CESIUM_TRACE_CATEGORY(Selection, "Tileset::_queuePredictedTileLoads");
+
+  // Tiles that the real traversal already queued keep their priority.
+  std::unordered_set<const Tile*> queuedTiles;
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+  for (const TileLoadTask& task : this->_mainThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+
+  // Walk down the tiles that are visible in a predicted view until they meet
+  // the screen-space error there, or until reaching a tile that isn't loaded
+  // yet. Its descendants can be considered once it is.
+  const bool renderTilesUnderCamera = this->_options.renderTilesUnderCamera;
+  auto queuedTileCount = [this]() {
+    return this->_workerThreadLoadQueue.size() +
+           this->_mainThreadLoadQueue.size();
+  };
+
+  std::vector<double> distances;
+  std::vector<Tile*> tilesToVisit{pRootTile};
+  while (!tilesToVisit.empty()) {
+    Tile& tile = *tilesToVisit.back();
+    tilesToVisit.pop_back();
+
+    const bool visible = std::any_of(
+        predictedFrustums.begin(),
+        predictedFrustums.end(),
+        [&tile, renderTilesUnderCamera](const ViewState& frustum) {
+          return isVisibleFromCamera(frustum, tile, renderTilesUnderCamera);
+        });
+    if (!visible) {
+      continue;
+    }
+
+    computeDistances(tile, predictedFrustums, nullptr, distances);
+
+    // The tile will be needed soon, so treat it as used this frame. This also
+    // keeps its load from being canceled as unneeded. The root tile must stay
+    // first among the tiles used this frame.
+    if (&tile != pRootTile) {
+      this->_markTileVisited(tile);
+    }
+
+    bool loading = false;
+    if (queuedTiles.find(&tile) == queuedTiles.end()) {
+      const size_t queuedBefore = queuedTileCount();
+      addTileToLoadQueue(
+          tile,
+          TileLoadPriorityGroup::Preload,
+          computeTilePriority(
+              tile,
+              predictedFrustums,
+              distances,
+              this->_options.foveatedLoading));
+      loading = queuedTileCount() != queuedBefore;
+      queuedTiles.insert(&tile);
+    } else {
+      loading = true;
+    }
+
+    if ((loading && !tile.getUnconditionallyRefine()) ||
+        this->_meetsSse(predictedFrustums, tile, distances, false)) {
+      continue;
+    }
+
+    for (Tile& child : tile.getChildren()) {
+      tilesToVisit.emplace_back(&child);
+    }
+  }
+}
+
+void Tileset::_processWorkerThreadLoadQueue() {
+  CESIUM_TRACE_CATEGORY(Selection, "Tileset::_processWorkerThreadLoadQueue");
+
+  int32_t maximumSimultaneousTileLoads =
+      static_cast<int32_t>(this->_effectiveMaximumSimultaneousTileLoads);
+  const int64_t maximumSimultaneousTileLoadBytes =
+      this->_options.maximumSimultaneousTileLoadBytes;
+
+  auto canStartLoad = [this,
+                       maximumSimultaneousTileLoads,
+                       maximumSimultaneousTileLoadBytes]() {
+    const TilesetContentManager& manager = *this->_pTilesetContentManager;
+    const int32_t loading = manager.getNumberOfTilesLoading();
+    if (loading >= maximumSimultaneousTileLoads) {
+      return false;
+    }
+
+    return maximumSimultaneousTileLoadBytes <= 0 || loading == 0 ||
+           manager.getTileLoadBytesInProgress() +
+                   manager.getEstimatedTileLoadBytes() <=
+               maximumSimultaneousTileLoadBytes;
+  };
+
+  if (!canStartLoad()) {
+    return;
+  }
+
+  const std::shared_ptr<TileLoadScheduler>& pScheduler =
+      this->_externals.pTileLoadScheduler;
+
+  forEachInPriorityOrder(
+      this->_workerThreadLoadQueue,
+      [this, &canStartLoad, &pScheduler](TileLoadTask& task) {
+        // The priority groups have the same values as the scheduler's
+        // priorities. Tasks are visited in priority order, so if this one
+        // can't start, no later one can either.
+        if (pScheduler &&
+            !pScheduler->canStartLoad(
+                static_cast<TileLoadScheduler::Priority>(task.group))) {
+          return false;
+        }
+
+        // Worker thread work for this load, such as decoding the response,
+        // runs ahead of the work for lower priority groups. The groups also
+        // have the same values as the task priorities.
+        ScopedTaskPriority priorityScope(static_cast<TaskPriority>(task.group));
+        this->_pTilesetContentManager->loadTileContent(
+            *task.pTile,
+            this->_options,
+            task.group == TileLoadPriorityGroup::Preload,
+            task.priority);
+        return canStartLoad();
+      });
+}
+void Tileset::_processSubtreePrefetchQueue() {
+  CESIUM_TRACE_CATEGORY(Selection, "Tileset::_processSubtreePrefetchQueue");
+
+  const std::shared_ptr<TileLoadScheduler>& pScheduler =
+      this->_externals.pTileLoadScheduler;
+
+  forEachInPriorityOrder(
+      this->_subtreePrefetchQueue,
+      [this, &pScheduler](TileLoadTask& task) {
+        if (pScheduler &&
+            !pScheduler->canStartLoad(
+                static_cast<TileLoadScheduler::Priority>(task.group))) {
+          return false;
+        }
+
+        ScopedTaskPriority priorityScope(static_cast<TaskPriority>(task.group));
+        return this->_pTilesetContentManager->prefetchTileChildren(
+            *task.pTile,
+            this->_options);
+      });
+}
+
 void Tileset::_processMainThreadLoadQueue() {
-  CESIUM_TRACE("Tileset::_processMainThreadLoadQueue");
+  CESIUM_TRACE_CATEGORY(MainThread, "Tileset::_processMainThreadLoadQueue");
   // Process deferred main-thread load tasks with a time budget.
 
-  std::sort(
-      this->_mainThreadLoadQueue.begin(),
-      this->_mainThreadLoadQueue.end());
-
   double timeBudget = this->_options.mainThreadLoadingTimeLimit;
 
+  const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources =
+      this->_externals.pPrepareRendererResources;
+  if (pPrepareRendererResources &&
+      pPrepareRendererResources->supportsPrepareInMainThreadBatch()) {
+    this->_processMainThreadLoadQueueInBatch(timeBudget);
+    return;
+  }
+
   auto start = std::chrono::system_clock::now();
   auto end =
       start + std::chrono::milliseconds(static_cast<long long>(timeBudget));
-  for (TileLoadTask& task : this->_mainThreadLoadQueue) {
-    // We double-check that the tile is still in the ContentLoaded state here,
-    // in case something (such as a child that needs to upsample from this
-    // parent) already pushed the tile into the Done state. Because in that
-    // case, calling finishLoading here would assert or crash.
-    if (task.pTile->getState() == TileLoadState::ContentLoaded &&
-        task.pTile->isRenderContent()) {
-      this->_pTilesetContentManager->finishLoading(*task.pTile, this->_options);
-    }
-    auto time = std::chrono::system_clock::now();
-    if (timeBudget > 0.0 && time >= end) {
-      break;
-    }
+  forEachInPriorityOrder(
+      this->_mainThreadLoadQueue,
+      [this, timeBudget, end](TileLoadTask& task) {
+        // We double-check that the tile is still in the ContentLoaded state
+        // here, in case something (such as a child that needs to upsample
+        // from this parent) already pushed the tile into the Done state.
+        // Because in that case, calling finishLoading here would assert or
+        // crash.
+        if (task.pTile->getState() == TileLoadState::ContentLoaded &&
+            task.pTile->isRenderContent()) {
+          this->_pTilesetContentManager->finishLoading(
+              *task.pTile,
+              this->_options);
+        }
+        auto time = std::chrono::system_clock::now();
+        return !(timeBudget > 0.0 && time >= end);
+      });
+
+  this->_mainThreadLoadQueue.clear();
+}
+
+void Tileset::_processMainThreadLoadQueueInBatch(double timeBudget) {
+  // The time to prepare a batch can't be checked while it's being prepared,
+  // so limit its size to what fit in the time budget in previous frames. With
+  // no previous frames to go by, start with a single tile.
+  size_t maximumBatchSize = std::numeric_limits<size_t>::max();
+  if (timeBudget > 0.0) {
+    const double estimate = this->_mainThreadBatchMillisecondsPerTile;
+    maximumBatchSize = estimate > 0.0
+                           ? std::max(size_t(timeBudget / estimate), size_t(1))
+                           : size_t(1);
   }
 
+  std::vector<Tile*>& batch = this->_mainThreadLoadBatch;
+  batch.clear();
+  forEachInPriorityOrder(
+      this->_mainThreadLoadQueue,
+      [&batch, maximumBatchSize](TileLoadTask& task) {
+        // As in _processMainThreadLoadQueue, skip tiles that are already
+        // done.
+        if (task.pTile->getState() == TileLoadState::ContentLoaded &&
+            task.pTile->isRenderContent()) {
+          batch.emplace_back(task.pTile);
+        }
+        return batch.size() < maximumBatchSize;
+      });
   this->_mainThreadLoadQueue.clear();
+
+  if (batch.empty()) {
+    return;
+  }
+
+  const auto start = std::chrono::system_clock::now();
+  this->_pTilesetContentManager->finishLoadingBatch(batch, this->_options);
+  const double millisecondsPerTile =
+      millisecondsSince(start) / double(batch.size());
+
+  // Smooth the estimate, so that one slow frame doesn't shrink the next batch
+  // too much.
+  this->_mainThreadBatchMillisecondsPerTile =
+      this->_mainThreadBatchMillisecondsPerTile > 0.0
+          ? glm::mix(
+                this->_mainThreadBatchMillisecondsPerTile,
+                millisecondsPerTile,
+                0.25)
+          : millisecondsPerTile;
+  batch.clear();
+}
+
+void Tileset::_unloadCachedTilesAndMeasure(
+    int64_t bytesAtStartOfFrame,
+    ViewUpdateResult& result) {
+  const int64_t bytesBeforeUnload = this->getTotalDataBytes();
+  result.bytesLoaded +=
+      std::max(bytesBeforeUnload - bytesAtStartOfFrame, int64_t(0));
+
+  const auto start = std::chrono::system_clock::now();
+  this->_unloadCachedTiles(
+      this->_options.tileCacheUnloadTimeLimit,
+      this->_options.maximumCachedBytes,
+      this->_options.maximumCachedGpuBytes);
+  this->_pTilesetContentManager->unloadLoaderData(
+      this->_options.maximumCachedBytes);
+  result.tileCacheUnloadTime = millisecondsSince(start);
+
+  result.bytesFreed =
+      std::max(bytesBeforeUnload - this->getTotalDataBytes(), int64_t(0));
 }
 
-void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
-  const int64_t maxBytes = this->getOptions().maximumCachedBytes;
+void Tileset::handleMemoryPressure() {
+  this->_unloadCachedTiles(
+      0.0,
+      this->_options.memoryPressureCachedBytes,
+      this->_options.maximumCachedGpuBytes);
+  this->_pTilesetContentManager->unloadLoaderData(
+      this->_options.memoryPressureCachedBytes);
+}
 
+void Tileset::_unloadCachedTiles(
+    double timeBudget,
+    int64_t maxBytes,
+    int64_t maxGpuBytes) {
   const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
-  Tile* pTile = this->_loadedTiles.head();
 
   // A time budget of 0.0 indicates we shouldn't throttle cache unloads. So set
   // the end time to the max time_point in that case.
@@ -1475,33 +3262,58 @@ void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
                  : (start + std::chrono::milliseconds(
                                 static_cast<long long>(timeBudget)));
 
-  while (this->getTotalDataBytes() > maxBytes) {
-    if (pTile == nullptr || pTile == pRootTile) {
-      // We've either removed all tiles or the next tile is the root.
-      // The root tile marks the beginning of the tiles that were used
-      // for rendering last frame.
-      break;
+  auto isOverLimit = [this, maxBytes, maxGpuBytes]() {
+    return this->getTotalDataBytes() > maxBytes ||
+           this->getTotalGpuDataBytes() > maxGpuBytes;
+  };
+
+  // Unloads the given tile, returning true if no time remains to unload more.
+  auto unloadTile = [this, end](Tile& tile) {
+    // The tile's upsampled children can still be loaded after it's unloaded.
+    this->_pTilesetContentManager->keepUpsamplingSource(tile);
+    const bool removed = this->_pTilesetContentManager->unloadTileContent(tile);
+    if (removed) {
+      this->_loadedTiles.remove(tile);
     }
 
-    // Don't unload this tile if it is still fading out.
-    if (_updateResult.tilesFadingOut.find(pTile) !=
-        _updateResult.tilesFadingOut.end()) {
-      pTile = this->_loadedTiles.next(*pTile);
-      continue;
+    return std::chrono::system_clock::now() >= end;
+  };
+
+  // The root tile marks the beginning of the tiles that were used for
+  // rendering last frame, so only the tiles before it may be unloaded.
+  Tile* pTile = this->_loadedTiles.head();
+
+  if (!this->_options.evictionPolicy) {
+    // Unload in least-recently-used order, which is the order of the list.
+    while (isOverLimit() && pTile != nullptr && pTile != pRootTile) {
+      Tile* pNext = this->_loadedTiles.next(*pTile);
+      if (!pTile->isFadingOut() && unloadTile(*pTile)) {
+        break;
+      }
+      pTile = pNext;
     }
+    return;
+  }
 
-    Tile* pNext = this->_loadedTiles.next(*pTile);
+  if (!isOverLimit()) {
+    return;
+  }
 
-    const bool removed =
-        this->_pTilesetContentManager->unloadTileContent(*pTile);
-    if (removed) {
-      this->_loadedTiles.remove(*pTile);
+  std::vector<Tile*>& candidates = this->_evictionCandidates;
+  candidates.clear();
+  for (; pTile != nullptr && pTile != pRootTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    if (!pTile->isFadingOut()) {
+      candidates.push_back(pTile);
     }
+  }
 
-    pTile = pNext;
+  this->_options.evictionPolicy->orderForEviction(
+      candidates,
+      this->_evictionFrustums);
 
-    auto time = std::chrono::system_clock::now();
-    if (time >= end) {
+  for (Tile* pCandidate : candidates) {
+    if (!isOverLimit() || unloadTile(*pCandidate)) {
       break;
     }
   }
@@ -1511,6 +3323,93 @@ void Tileset::_markTileVisited(Tile& tile) noexcept {
   this->_loadedTiles.insertAtTail(tile);
 }
 
+template <typename Predicate>
+static bool anyDescendant(Tile& tile, Predicate&& predicate) {
+  for (Tile& child : tile.getChildren()) {
+    if (predicate(child) || anyDescendant(child, predicate)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void
+removeDescendants(Tile::LoadedLinkedList& loadedTiles, Tile& tile) noexcept {
+  for (Tile& child : tile.getChildren()) {
+    loadedTiles.remove(child);
+    removeDescendants(loadedTiles, child);
+  }
+}
+
+void Tileset::_releaseUnusedTileChildren(int32_t currentFrameNumber) {
+  const TilesetContentOptions& contentOptions = this->_options.contentOptions;
+  if (!contentOptions.createExplicitTileChildrenOnDemand ||
+      contentOptions.releaseUnusedTileChildrenAfterFrames <= 0) {
+    return;
+  }
+
+  // As in _unloadCachedTiles, the root tile and the tiles after it were used
+  // this frame.
+  Tile* pRootTile = this->getRootTile();
+  std::unordered_set<const Tile*>& usedTiles = this->_tilesUsedThisFrame;
+  usedTiles.clear();
+  for (Tile* pTile = pRootTile; pTile != nullptr;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    usedTiles.insert(pTile);
+  }
+
+  // Only the unused children of used tiles are considered, so that each
+  // unused subtree is released from its top.
+  std::vector<Tile*>& candidates = this->_childrenReleaseCandidates;
+  candidates.clear();
+  for (Tile* pTile = pRootTile; pTile != nullptr;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    for (Tile& child : pTile->getChildren()) {
+      const int32_t unusedFrames =
+          currentFrameNumber - child.getLastSelectionState().getFrameNumber();
+      if (!child.getChildren().empty() &&
+          unusedFrames >= contentOptions.releaseUnusedTileChildrenAfterFrames &&
+          usedTiles.find(&child) == usedTiles.end()) {
+        candidates.emplace_back(&child);
+      }
+    }
+  }
+
+  auto isReferenced = [this, &usedTiles](Tile& tile) {
+    return usedTiles.find(&tile) != usedTiles.end() || tile.isFadingOut() ||
+           this->_deferredTraversalTiles.find(&tile) !=
+               this->_deferredTraversalTiles.end() ||
+           this->_nextDeferredTraversalTiles.find(&tile) !=
+               this->_nextDeferredTraversalTiles.end();
+  };
+
+  for (Tile* pCandidate : candidates) {
+    if (anyDescendant(*pCandidate, isReferenced)) {
+      continue;
+    }
+
+    // Tiles without content stay in the list of loaded tiles, so they must
+    // leave it before they are destroyed. This is harmless if the children
+    // end up being kept.
+    removeDescendants(this->_loadedTiles, *pCandidate);
+    this->_pTilesetContentManager->releaseTileChildren(*pCandidate);
+  }
+}
+
+void Tileset::_cancelUnneededTileLoads() noexcept {
+  // As in _unloadCachedTiles, the tiles before the root tile were not visited
+  // this frame.
+  const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
+  for (Tile* pTile = this->_loadedTiles.head();
+       pTile != nullptr && pTile != pRootTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    if (pTile->getState() == TileLoadState::ContentLoading) {
+      this->_pTilesetContentManager->cancelTileContentLoad(*pTile);
+    }
+  }
+}
+
 void Tileset::addTileToLoadQueue(
     Tile& tile,
     TileLoadPriorityGroup priorityGroup,
@@ -1533,6 +3432,13 @@ void Tileset::addTileToLoadQueue(
     this->_workerThreadLoadQueue.push_back({&tile, priorityGroup, priority});
   } else if (this->_pTilesetContentManager->tileNeedsMainThreadLoading(tile)) {
     this->_mainThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+  } else if (tile.getState() == TileLoadState::ContentLoading) {
+    // Let the asset accessor reorder the requests of tiles that are already
+    // loading. The groups have the same values as the task priorities.
+    this->_pTilesetContentManager->updateTileLoadPriority(
+        tile,
+        static_cast<TaskPriority>(priorityGroup),
+        priority);
   }
 }
 
@@ -15,6 +15,13 @@ TileLoadInput::TileLoadInput(
       pLogger{pLogger_},
       requestHeaders{requestHeaders_} {}
 
+CesiumAsync::AssetRequestOptions TileLoadInput::getRequestOptions() const {
+  CesiumAsync::AssetRequestOptions options;
+  options.pPriority = this->pRequestPriority;
+  options.cancellationToken = this->cancellationToken;
+  return options;
+}
+
 TileLoadResult TileLoadResult::createFailedResult(
     std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest) {
   return TileLoadResult{
@@ -40,4 +47,32 @@ TileLoadResult TileLoadResult::createRetryLaterResult(
       {},
       TileLoadResultState::RetryLater};
 }
+
+TileLoadResult TileLoadResult::createCanceledResult(
+    std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest) {
+  return TileLoadResult{
+      TileUnknownContent{},
+      CesiumGeometry::Axis::Y,
+      std::nullopt,
+      std::nullopt,
+      std::nullopt,
+      std::move(pCompletedRequest),
+      {},
+      TileLoadResultState::Canceled};
+}
+
+bool TilesetContentLoader::releaseTileChildren(const Tile& /* tile */) {
+  return false;
+}
+
+int64_t TilesetContentLoader::getLoaderDataBytes() const noexcept { return 0; }
+
+void TilesetContentLoader::unloadLoaderData(int64_t /* maximumBytes */) {}
+
+std::vector<CesiumAsync::Future<void>>
+TilesetContentLoader::prefetchTileChildren(
+    const TileLoadInput& /* input */,
+    size_t /* maximumLoads */) {
+  return {};
+}
 } // namespace Cesium3DTilesSelection
@@ -8,6 +8,9 @@
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/TaskAffinity.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumAsync/TileLoadScheduler.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
@@ -15,12 +18,17 @@
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/joinToString.h>
 
 #include <rapidjson/document.h>
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 using namespace CesiumGltfContent;
 using namespace CesiumRasterOverlays;
@@ -28,6 +36,9 @@ using namespace CesiumUtility;
 
 namespace Cesium3DTilesSelection {
 namespace {
+// How much each finished load moves the estimate of the bytes of the next one.
+constexpr double tileLoadBytesSmoothing = 0.1;
+
 struct RegionAndCenter {
   CesiumGeospatial::BoundingRegion region;
   CesiumGeospatial::Cartographic center;
@@ -81,6 +92,113 @@ void unloadTileRecursively(
   }
 }
 
+// The type of content a tile loaded, as it is counted in the tileset's
+// TileLoadStatistics.
+std::string
+getTileContentType(const Tile& tile, const TileLoadResult& result) {
+  if (std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+          tile.getTileID())) {
+    return "upsampled";
+  }
+
+  if (std::holds_alternative<TileExternalContent>(result.contentKind)) {
+    return "external";
+  }
+
+  if (std::holds_alternative<TileEmptyContent>(result.contentKind)) {
+    return "empty";
+  }
+
+  const CesiumAsync::IAssetResponse* pResponse =
+      result.pCompletedRequest ? result.pCompletedRequest->response()
+                               : nullptr;
+  if (!pResponse) {
+    return "unknown";
+  }
+
+  const gsl::span<const std::byte> data = pResponse->data();
+  if (data.size() >= 4) {
+    const std::string_view magic(
+        reinterpret_cast<const char*>(data.data()),
+        4);
+    if (magic == "b3dm" || magic == "i3dm" || magic == "pnts" ||
+        magic == "cmpt") {
+      return std::string(magic);
+    }
+
+    if (magic == "glTF") {
+      return "glb";
+    }
+  }
+
+  if (pResponse->contentType().find("quantized-mesh") != std::string::npos ||
+      result.pCompletedRequest->url().find(".terrain") != std::string::npos) {
+    return "quantized-mesh";
+  }
+
+  if (!data.empty() && data[0] == std::byte('{')) {
+    return "gltf";
+  }
+
+  return "unknown";
+}
+
+// Whether a tile whose loads have failed temporarily, most recently at the
+// given time, has waited long enough to be loaded again.
+bool isRetryDue(
+    uint32_t failureCount,
+    std::chrono::steady_clock::time_point lastFailureTime,
+    const TilesetOptions& options) {
+  if (failureCount == 0) {
+    return true;
+  }
+
+  // Cap the exponent as well as the delay, so that the delay of a tile that
+  // has failed many times doesn't overflow.
+  const int doublings = int(std::min(failureCount - 1, 30U));
+  const double delay = std::min(
+      std::ldexp(options.retryDelay, doublings),
+      std::max(options.maximumRetryDelay, options.retryDelay));
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - lastFailureTime;
+  return elapsed.count() >= delay;
+}
+
+double millisecondsBetween(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Whether none of the tile's descendants has content or raster overlays that
+// would be lost if they were destroyed. Tiles that were created without
+// content, and so were never loaded or counted, hold nothing either.
+bool descendantsHoldNothing(const Tile& tile) noexcept {
+  for (const Tile& child : tile.getChildren()) {
+    const InternedString* pUrl =
+        std::get_if<InternedString>(&child.getTileID());
+    const bool createdEmpty =
+        child.getContent().isEmptyContent() && pUrl && pUrl->empty();
+    const bool holdsNothing =
+        child.getState() == TileLoadState::Unloaded || createdEmpty;
+    if (!holdsNothing || !child.getMappedRasterTiles().empty() ||
+        !descendantsHoldNothing(child)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void releaseOcclusionProxies(
+    TileOcclusionRendererProxyPool& occlusionPool,
+    const Tile& tile) {
+  for (const Tile& child : tile.getChildren()) {
+    occlusionPool.releaseOcclusionProxyForTile(child);
+    releaseOcclusionProxies(occlusionPool, child);
+  }
+}
+
 bool anyRasterOverlaysNeedLoading(const Tile& tile) noexcept {
   for (const RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
     const RasterOverlayTile* pLoading = mapped.getLoadingTile();
@@ -138,7 +256,8 @@ getTileBoundingRegionForUpsampling(const Tile& parent) {
 
 void createQuadtreeSubdividedChildren(
     Tile& parent,
-    RasterOverlayUpsampler& upsampler) {
+    RasterOverlayUpsampler& upsampler,
+    TileChildrenPool& childrenPool) {
   std::optional<RegionAndCenter> maybeRegionAndCenter =
       getTileBoundingRegionForUpsampling(parent);
   if (!maybeRegionAndCenter) {
@@ -182,12 +301,11 @@ void createQuadtreeSubdividedChildren(
   parent.setRefine(TileRefine::Replace);
 
   // add 4 children for parent
-  std::vector<Tile> children;
-  children.reserve(4);
+  std::vector<Tile> children = childrenPool.acquire(4);
   for (std::size_t i = 0; i < 4; ++i) {
     children.emplace_back(&upsampler);
   }
-  parent.createChildTiles(std::move(children));
+  childrenPool.createChildTiles(parent, std::move(children));
 
   // populate children metadata
   gsl::span<Tile> childrenView = parent.getChildren();
@@ -271,6 +389,15 @@ void createQuadtreeSubdividedChildren(
   ne.setTransform(parent.getTransform());
 }
 
+// The priority of the raster overlay tile loads started while loading a
+// geometry tile. The Tileset loads each geometry tile within a
+// ScopedTaskPriority for its priority group, which has the same values as the
+// load priorities, so the raster overlay tiles inherit the tile's priority.
+CesiumAsync::TileLoadScheduler::Priority getRasterLoadPriority() noexcept {
+  return static_cast<CesiumAsync::TileLoadScheduler::Priority>(
+      CesiumAsync::getCurrentTaskPriority());
+}
+
 std::vector<CesiumGeospatial::Projection> mapOverlaysToTile(
     Tile& tile,
     RasterOverlayCollection& overlays,
@@ -299,7 +426,7 @@ std::vector<CesiumGeospatial::Projection> mapOverlaysToTile(
     if (pMapped) {
       // Try to load now, but if the mapped raster tile is a placeholder this
       // won't do anything.
-      pMapped->loadThrottled();
+      pMapped->loadThrottled(getRasterLoadPriority());
     }
   }
 
@@ -396,7 +523,8 @@ void calcRasterOverlayDetailsInWorkerThread(
           std::move(projections),
           false,
           "_CESIUMOVERLAY_",
-          firstRasterOverlayTexCoord);
+          firstRasterOverlayTexCoord,
+          tileLoadInfo.contentOptions.quantizeRasterOverlayTextureCoordinates);
 
   if (pRegion && overlayDetails) {
     // If the original bounding region was wrong, report it.
@@ -460,9 +588,14 @@ void calcFittestBoundingRegionForLooseTile(
           result.rasterOverlayDetails->boundingRegion;
     } else {
       // We need to compute an accurate bounding region
-      result.updatedBoundingVolume = GltfUtilities::computeBoundingRegion(
-          model,
-          tileLoadInfo.tileTransform);
+      result.updatedBoundingVolume =
+          tileLoadInfo.contentOptions.approximateLooseBoundingRegions
+              ? GltfUtilities::computeApproximateBoundingRegion(
+                    model,
+                    tileLoadInfo.tileTransform)
+              : GltfUtilities::computeBoundingRegion(
+                    model,
+                    tileLoadInfo.tileTransform);
     }
   }
 }
@@ -482,6 +615,11 @@ void postProcessGltfInWorkerThread(
       static_cast<std::underlying_type_t<CesiumGeometry::Axis>>(
           result.glTFUpAxis);
 
+  // Merge first, so that the steps below have fewer primitives to process.
+  if (tileLoadInfo.contentOptions.mergePrimitives) {
+    GltfUtilities::mergePrimitives(model);
+  }
+
   // calculate raster overlay details
   calcRasterOverlayDetailsInWorkerThread(
       result,
@@ -493,7 +631,104 @@ void postProcessGltfInWorkerThread(
 
   // generate missing smooth normal
   if (tileLoadInfo.contentOptions.generateMissingNormalsSmooth) {
-    model.generateMissingNormalsSmooth();
+    model.generateMissingNormalsSmooth(
+        tileLoadInfo.contentOptions.octEncodeGeneratedNormals);
+  }
+
+  if (tileLoadInfo.contentOptions.optimizeMeshes) {
+    GltfUtilities::optimizeMeshes(
+        model,
+        tileLoadInfo.contentOptions.compressMeshIndices);
+  }
+
+  // The hierarchy is handed to the render content on the main thread, after
+  // the content is created.
+  if (tileLoadInfo.contentOptions.createTriangleHierarchies) {
+    auto pHierarchy =
+        std::make_shared<CesiumGeometry::TriangleBoundingVolumeHierarchy>(
+            GltfUtilities::createTriangleBoundingVolumeHierarchy(
+                model,
+                tileLoadInfo.tileTransform));
+    result.tileInitializer =
+        [pHierarchy, initializer = std::move(result.tileInitializer)](
+            Tile& tile) {
+          if (initializer) {
+            initializer(tile);
+          }
+
+          TileRenderContent* pRenderContent =
+              tile.getContent().getRenderContent();
+          if (pRenderContent) {
+            pRenderContent->setTriangleHierarchy(std::move(*pHierarchy));
+          }
+        };
+  }
+
+  // This reorders the instances of the model, so it must happen before the
+  // renderer reads them. The grids are handed over like the hierarchy.
+  if (tileLoadInfo.contentOptions.createInstanceGrids) {
+    auto pGrids = std::make_shared<std::vector<NodeInstanceGrid>>(
+        GltfUtilities::createInstanceGrids(model, tileLoadInfo.tileTransform));
+    if (!pGrids->empty()) {
+      result.tileInitializer =
+          [pGrids, initializer = std::move(result.tileInitializer)](
+              Tile& tile) {
+            if (initializer) {
+              initializer(tile);
+            }
+
+            TileRenderContent* pRenderContent =
+                tile.getContent().getRenderContent();
+            if (pRenderContent) {
+              pRenderContent->setInstanceGrids(std::move(*pGrids));
+            }
+          };
+    }
+  }
+
+  // Merge after the steps above, which leave shared accessors alone.
+  if (tileLoadInfo.contentOptions.deduplicateContent) {
+    GltfUtilities::mergeDuplicateImages(model);
+    GltfUtilities::mergeDuplicateAccessors(model);
+
+    auto pHashes = std::make_shared<std::vector<uint64_t>>();
+    pHashes->reserve(model.images.size());
+    for (const CesiumGltf::Image& image : model.images) {
+      pHashes->push_back(
+          image.cesium.pixelData.empty()
+              ? 0
+              : GltfUtilities::computeImageContentHash(image.cesium));
+    }
+
+    if (!pHashes->empty()) {
+      result.tileInitializer =
+          [pHashes, initializer = std::move(result.tileInitializer)](
+              Tile& tile) {
+            if (initializer) {
+              initializer(tile);
+            }
+
+            TileRenderContent* pRenderContent =
+                tile.getContent().getRenderContent();
+            if (pRenderContent) {
+              pRenderContent->setImageContentHashes(std::move(*pHashes));
+            }
+          };
+    }
+  }
+}
+
+// Writes the vertices and indices of the glTF into the renderer's memory, if
+// it provides it, right before the renderer is given the result.
+void writeVertexStreamsInWorkerThread(
+    TileLoadResult& result,
+    const std::shared_ptr<CesiumGltfContent::IStagingBufferAllocator>&
+        pAllocator) {
+  CesiumGltf::Model* pModel =
+      std::get_if<CesiumGltf::Model>(&result.contentKind);
+  if (pAllocator && pModel) {
+    result.vertexStreams =
+        GltfUtilities::writeVertexStreams(*pModel, *pAllocator);
   }
 }
 
@@ -524,6 +759,26 @@ postProcessContentInWorkerThread(
       tileLoadInfo.contentOptions.ktx2TranscodeTargets;
   gltfOptions.applyTextureTransform =
       tileLoadInfo.contentOptions.applyTextureTransform;
+  gltfOptions.dequantizeMeshData =
+      tileLoadInfo.contentOptions.dequantizeMeshData;
+  gltfOptions.shufflePointClouds =
+      tileLoadInfo.contentOptions.shufflePointClouds;
+  gltfOptions.batchTableProperties =
+      tileLoadInfo.contentOptions.batchTableProperties;
+  gltfOptions.maximumImageDimension =
+      tileLoadInfo.contentOptions.maximumImageDimension;
+  gltfOptions.maximumKtx2Dimension =
+      tileLoadInfo.contentOptions.maximumKtx2Dimension;
+  gltfOptions.decodeOpaqueImagesToRgb =
+      tileLoadInfo.contentOptions.decodeOpaqueImagesToRgb;
+  gltfOptions.decodeEmbeddedImages =
+      tileLoadInfo.contentOptions.decodeEmbeddedImages;
+  gltfOptions.cancellationToken = tileLoadInfo.cancellationToken;
+  gltfOptions.asyncSystem = tileLoadInfo.asyncSystem;
+  gltfOptions.pExternalDataCache =
+      tileLoadInfo.contentOptions.pExternalDataCache;
+  gltfOptions.pDecodedDataAllocator =
+      tileLoadInfo.contentOptions.pDecodedDataAllocator;
 
   auto asyncSystem = tileLoadInfo.asyncSystem;
   auto pAssetAccessor = tileLoadInfo.pAssetAccessor;
@@ -540,6 +795,14 @@ postProcessContentInWorkerThread(
            tileLoadInfo = std::move(tileLoadInfo),
            rendererOptions](
               CesiumGltfReader::GltfReaderResult&& gltfResult) mutable {
+            if (tileLoadInfo.cancellationToken.isCanceled()) {
+              return tileLoadInfo.asyncSystem.createResolvedFuture(
+                  TileLoadResultAndRenderResources{
+                      TileLoadResult::createCanceledResult(
+                          std::move(result.pCompletedRequest)),
+                      nullptr});
+            }
+
             if (!gltfResult.errors.empty()) {
               if (result.pCompletedRequest) {
                 SPDLOG_LOGGER_ERROR(
@@ -585,14 +848,130 @@ postProcessContentInWorkerThread(
                 std::move(projections),
                 tileLoadInfo);
 
+            std::shared_ptr<TileLoadTimestamps> pTimestamps =
+                tileLoadInfo.pTimestamps;
+            if (pTimestamps) {
+              pTimestamps->postProcessed = std::chrono::steady_clock::now();
+            }
+
+            if (tileLoadInfo.cancellationToken.isCanceled()) {
+              return tileLoadInfo.asyncSystem.createResolvedFuture(
+                  TileLoadResultAndRenderResources{
+                      TileLoadResult::createCanceledResult(
+                          std::move(result.pCompletedRequest)),
+                      nullptr});
+            }
+
+            if (tileLoadInfo.deferImageDecoding) {
+              // The images are decoded and the render resources are created
+              // once the tile is needed for rendering.
+              return tileLoadInfo.asyncSystem.createResolvedFuture(
+                  TileLoadResultAndRenderResources{std::move(result), nullptr});
+            }
+
+            writeVertexStreamsInWorkerThread(
+                result,
+                tileLoadInfo.contentOptions.pStagingBufferAllocator);
+
             // create render resources
-            return tileLoadInfo.pPrepareRendererResources->prepareInLoadThread(
-                tileLoadInfo.asyncSystem,
-                std::move(result),
-                tileLoadInfo.tileTransform,
-                rendererOptions);
+            return tileLoadInfo.pPrepareRendererResources
+                ->prepareInLoadThread(
+                    tileLoadInfo.asyncSystem,
+                    std::move(result),
+                    tileLoadInfo.tileTransform,
+                    rendererOptions)
+                .thenImmediately(
+                    [pTimestamps = std::move(pTimestamps)](
+                        TileLoadResultAndRenderResources&& pair) {
+                      if (pTimestamps) {
+                        pTimestamps->preparedInLoadThread =
+                            std::chrono::steady_clock::now();
+                      }
+                      return std::move(pair);
+                    });
           });
 }
+
+void markAccessorBufferViewNeeded(
+    const CesiumGltf::Model& model,
+    int32_t accessorIndex,
+    std::vector<bool>& neededBufferViews) {
+  if (accessorIndex < 0 ||
+      accessorIndex >= static_cast<int32_t>(model.accessors.size())) {
+    return;
+  }
+
+  const int32_t bufferView =
+      model.accessors[static_cast<size_t>(accessorIndex)].bufferView;
+  if (bufferView >= 0 &&
+      bufferView < static_cast<int32_t>(neededBufferViews.size())) {
+    neededBufferViews[static_cast<size_t>(bufferView)] = true;
+  }
+}
+
+// Releases the CPU copies of everything in the model except the positions,
+// indices, and raster overlay texture coordinates of its primitives. The
+// buffer views that are released are detached from their buffers, so that
+// accessors using them report an invalid buffer rather than reading the wrong
+// data.
+void releaseCpuData(CesiumGltf::Model& model) {
+  std::vector<bool> neededBufferViews(model.bufferViews.size(), false);
+  for (const CesiumGltf::Mesh& mesh : model.meshes) {
+    for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
+      markAccessorBufferViewNeeded(
+          model,
+          primitive.indices,
+          neededBufferViews);
+      for (const auto& [name, accessor] : primitive.attributes) {
+        if (name == "POSITION" || name.find("_CESIUMOVERLAY_") == 0) {
+          markAccessorBufferViewNeeded(model, accessor, neededBufferViews);
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < model.buffers.size(); ++i) {
+    std::vector<std::byte>& data = model.buffers[i].cesium.data;
+
+    // Copy the needed buffer views into a new, smaller buffer.
+    std::vector<std::byte> keptData;
+    for (size_t j = 0; j < model.bufferViews.size(); ++j) {
+      CesiumGltf::BufferView& bufferView = model.bufferViews[j];
+      if (bufferView.buffer != static_cast<int32_t>(i)) {
+        continue;
+      }
+
+      const bool inRange =
+          bufferView.byteOffset >= 0 && bufferView.byteLength >= 0 &&
+          bufferView.byteOffset + bufferView.byteLength <=
+              static_cast<int64_t>(data.size());
+      if (!neededBufferViews[j] || !inRange) {
+        bufferView.buffer = -1;
+        continue;
+      }
+
+      // Keep each buffer view 8-byte aligned, as in the original buffer.
+      const size_t offset = (keptData.size() + 7) & ~size_t(7);
+      keptData.resize(offset + static_cast<size_t>(bufferView.byteLength));
+      std::copy_n(
+          data.begin() + bufferView.byteOffset,
+          bufferView.byteLength,
+          keptData.begin() + static_cast<std::ptrdiff_t>(offset));
+      bufferView.byteOffset = static_cast<int64_t>(offset);
+    }
+
+    model.buffers[i].byteLength = static_cast<int64_t>(keptData.size());
+    data = std::move(keptData);
+  }
+
+  for (CesiumGltf::Image& image : model.images) {
+    image.bufferView = -1;
+    image.cesium.pixelData = std::vector<std::byte>();
+    image.cesium.mipPositions.clear();
+    image.cesium.mipPositions.shrink_to_fit();
+    image.cesium.sizeBytes = 0;
+  }
+}
 } // namespace
 
 TilesetContentManager::TilesetContentManager(
@@ -615,14 +994,27 @@ TilesetContentManager::TilesetContentManager(
       _tilesetCredits{},
       _overlayCollection{std::move(overlayCollection)},
       _tileLoadsInProgress{0},
+      _prefetchesInProgress{0},
+      _tileLoadBytesInProgress{0},
+      _estimatedTileLoadBytes{0.0},
+      _tileLoadByteEstimates{},
+      _tileLoadCancellations{},
+      _abandonment{},
+      _tileLoadPriorities{},
+      _tilesWithDeferredImages{},
+      _tilesAwaitingFinish{},
+      _loadStatistics{},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _upsamplingSourcesDataUsed{0},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
       _rootTileAvailablePromise{externals.asyncSystem.createPromise<void>()},
       _rootTileAvailableFuture{
-          this->_rootTileAvailablePromise.getFuture().share()} {
+          this->_rootTileAvailablePromise.getFuture().share()},
+      _rootTileAvailableTime{std::chrono::steady_clock::now()} {
   this->_rootTileAvailablePromise.resolve();
 }
 
@@ -644,14 +1036,27 @@ TilesetContentManager::TilesetContentManager(
       _tilesetCredits{},
       _overlayCollection{std::move(overlayCollection)},
       _tileLoadsInProgress{0},
+      _prefetchesInProgress{0},
+      _tileLoadBytesInProgress{0},
+      _estimatedTileLoadBytes{0.0},
+      _tileLoadByteEstimates{},
+      _tileLoadCancellations{},
+      _abandonment{},
+      _tileLoadPriorities{},
+      _tilesWithDeferredImages{},
+      _tilesAwaitingFinish{},
+      _loadStatistics{},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _upsamplingSourcesDataUsed{0},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
       _rootTileAvailablePromise{externals.asyncSystem.createPromise<void>()},
       _rootTileAvailableFuture{
-          this->_rootTileAvailablePromise.getFuture().share()} {
+          this->_rootTileAvailablePromise.getFuture().share()},
+      _rootTileAvailableTime{} {
   if (!url.empty()) {
     this->notifyTileStartLoading(nullptr);
 
@@ -663,6 +1068,7 @@ TilesetContentManager::TilesetContentManager(
             [pLogger = externals.pLogger,
              asyncSystem = externals.asyncSystem,
              pAssetAccessor = externals.pAssetAccessor,
+             pTileHierarchyCache = externals.pTileHierarchyCache,
              contentOptions = tilesetOptions.contentOptions](
                 const std::shared_ptr<CesiumAsync::IAssetRequest>&
                     pCompletedRequest) {
@@ -688,6 +1094,22 @@ TilesetContentManager::TilesetContentManager(
                 return asyncSystem.createResolvedFuture(std::move(result));
               }
 
+              // A tile hierarchy cached for this version of a tileset.json
+              // makes parsing it unnecessary
+              if (pTileHierarchyCache &&
+                  !contentOptions.createExplicitTileChildrenOnDemand) {
+                std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+                    maybeCachedResult =
+                        TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+                            *pTileHierarchyCache,
+                            *pCompletedRequest);
+                if (maybeCachedResult) {
+                  TilesetContentLoaderResult<TilesetContentLoader> result =
+                      std::move(*maybeCachedResult);
+                  return asyncSystem.createResolvedFuture(std::move(result));
+                }
+              }
+
               // Parse Json response
               gsl::span<const std::byte> tilesetJsonBinary = pResponse->data();
               rapidjson::Document tilesetJson;
@@ -709,7 +1131,12 @@ TilesetContentManager::TilesetContentManager(
               const auto rootIt = tilesetJson.FindMember("root");
               if (rootIt != tilesetJson.MemberEnd()) {
                 TilesetContentLoaderResult<TilesetContentLoader> result =
-                    TilesetJsonLoader::createLoader(pLogger, url, tilesetJson);
+                    TilesetJsonLoader::createLoader(
+                        pLogger,
+                        *pCompletedRequest,
+                        std::move(tilesetJson),
+                        contentOptions.createExplicitTileChildrenOnDemand,
+                        pTileHierarchyCache);
                 return asyncSystem.createResolvedFuture(std::move(result));
               } else {
                 const auto formatIt = tilesetJson.FindMember("format");
@@ -749,6 +1176,7 @@ TilesetContentManager::TilesetContentManager(
                   TilesetLoadType::TilesetJson,
                   errorCallback,
                   std::move(result));
+              thiz->_rootTileAvailableTime = std::chrono::steady_clock::now();
               thiz->_rootTileAvailablePromise.resolve();
             })
         .catchInMainThread([thiz](std::exception&& e) {
@@ -783,14 +1211,27 @@ TilesetContentManager::TilesetContentManager(
       _tilesetCredits{},
       _overlayCollection{std::move(overlayCollection)},
       _tileLoadsInProgress{0},
+      _prefetchesInProgress{0},
+      _tileLoadBytesInProgress{0},
+      _estimatedTileLoadBytes{0.0},
+      _tileLoadByteEstimates{},
+      _tileLoadCancellations{},
+      _abandonment{},
+      _tileLoadPriorities{},
+      _tilesWithDeferredImages{},
+      _tilesAwaitingFinish{},
+      _loadStatistics{},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _tilesGpuDataUsed{0},
+      _upsamplingSourcesDataUsed{0},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
       _rootTileAvailablePromise{externals.asyncSystem.createPromise<void>()},
       _rootTileAvailableFuture{
-          this->_rootTileAvailablePromise.getFuture().share()} {
+          this->_rootTileAvailablePromise.getFuture().share()},
+      _rootTileAvailableTime{} {
   if (ionAssetID > 0) {
     auto authorizationChangeListener = [this](
                                            const std::string& header,
@@ -827,6 +1268,7 @@ TilesetContentManager::TilesetContentManager(
                   TilesetLoadType::CesiumIon,
                   errorCallback,
                   std::move(result));
+              thiz->_rootTileAvailableTime = std::chrono::steady_clock::now();
               thiz->_rootTileAvailablePromise.resolve();
             })
         .catchInMainThread([thiz](std::exception&& e) {
@@ -851,8 +1293,14 @@ TilesetContentManager::getRootTileAvailableEvent() {
   return this->_rootTileAvailableFuture;
 }
 
+const std::optional<std::chrono::steady_clock::time_point>&
+TilesetContentManager::getRootTileAvailableTime() const noexcept {
+  return this->_rootTileAvailableTime;
+}
+
 TilesetContentManager::~TilesetContentManager() noexcept {
   assert(this->_tileLoadsInProgress == 0);
+  assert(this->_prefetchesInProgress == 0);
   this->unloadAll();
 
   this->_destructionCompletePromise.resolve();
@@ -860,7 +1308,9 @@ TilesetContentManager::~TilesetContentManager() noexcept {
 
 void TilesetContentManager::loadTileContent(
     Tile& tile,
-    const TilesetOptions& tilesetOptions) {
+    const TilesetOptions& tilesetOptions,
+    bool isPreload,
+    double priority) {
   CESIUM_TRACE("TilesetContentManager::loadTileContent");
 
   if (tile.getState() == TileLoadState::Unloading) {
@@ -868,17 +1318,37 @@ void TilesetContentManager::loadTileContent(
     return;
   }
 
+  if (this->_abandonment.isCanceled()) {
+    return;
+  }
+
   if (tile.getState() != TileLoadState::Unloaded &&
       tile.getState() != TileLoadState::FailedTemporarily) {
+    // A preloaded tile is now needed, so finish the work it put off.
+    if (!isPreload && tile.getState() == TileLoadState::ContentLoaded &&
+        this->tileHasDeferredImages(tile)) {
+      this->decodeDeferredImages(tile, tilesetOptions);
+    }
+
     // No need to load geometry, but give previously-throttled
     // raster overlay tiles a chance to load.
+    const CesiumAsync::TileLoadScheduler::Priority rasterLoadPriority =
+        getRasterLoadPriority();
     for (RasterMappedTo3DTile& rasterTile : tile.getMappedRasterTiles()) {
-      rasterTile.loadThrottled();
+      rasterTile.loadThrottled(rasterLoadPriority);
     }
 
     return;
   }
 
+  // Back off from a tile whose loads keep failing temporarily.
+  if (!isRetryDue(
+          tile._temporaryFailureCount,
+          tile._lastTemporaryFailureTime,
+          tilesetOptions)) {
+    return;
+  }
+
   // Below are the guarantees the loader can assume about upsampled tile. If any
   // of those guarantees are wrong, it's a bug:
   // - Any tile that is marked as upsampled tile, we will guarantee that the
@@ -896,7 +1366,10 @@ void TilesetContentManager::loadTileContent(
     // We can't upsample this tile until its parent tile is done loading.
     Tile* pParentTile = tile.getParent();
     if (pParentTile) {
-      if (pParentTile->getState() != TileLoadState::Done) {
+      // A parent that was unloaded doesn't need to be loaded again if what's
+      // needed to upsample it was kept.
+      if (pParentTile->getState() != TileLoadState::Done &&
+          !pParentTile->_pUpsamplingSource) {
         loadTileContent(*pParentTile, tilesetOptions);
 
         // Finalize the parent if necessary, otherwise it may never reach the
@@ -905,7 +1378,8 @@ void TilesetContentManager::loadTileContent(
         // be a problem in a pathological tileset with a non-renderable leaf
         // tile, but that sort of thing does happen.
         if (pParentTile->getState() == TileLoadState::ContentLoaded &&
-            pParentTile->isRenderContent()) {
+            pParentTile->isRenderContent() &&
+            !this->tileHasDeferredImages(*pParentTile)) {
           finishLoading(*pParentTile, tilesetOptions);
         }
         return;
@@ -924,13 +1398,38 @@ void TilesetContentManager::loadTileContent(
   notifyTileStartLoading(&tile);
   tile.setState(TileLoadState::ContentLoading);
 
+  CesiumAsync::CancellationTokenSource& cancellation =
+      this->_tileLoadCancellations[&tile];
+  cancellation = CesiumAsync::CancellationTokenSource();
+
+  std::shared_ptr<CesiumAsync::AssetRequestPriority> pRequestPriority =
+      std::make_shared<CesiumAsync::AssetRequestPriority>(
+          CesiumAsync::getCurrentTaskPriority(),
+          priority);
+  this->_tileLoadPriorities[&tile] = pRequestPriority;
+
+  const bool deferImageDecoding =
+      isPreload && tilesetOptions.contentOptions.deferPreloadedImageDecoding &&
+      tilesetOptions.contentOptions.decodeEmbeddedImages;
+  TilesetContentOptions contentOptions = tilesetOptions.contentOptions;
+  if (deferImageDecoding) {
+    contentOptions.decodeEmbeddedImages = false;
+  }
+
   TileContentLoadInfo tileLoadInfo{
       this->_externals.asyncSystem,
       this->_externals.pAssetAccessor,
       this->_externals.pPrepareRendererResources,
       this->_externals.pLogger,
-      tilesetOptions.contentOptions,
+      contentOptions,
       tile};
+  tileLoadInfo.cancellationToken = cancellation.getToken();
+  tileLoadInfo.deferImageDecoding = deferImageDecoding;
+
+  std::shared_ptr<TileLoadTimestamps> pTimestamps =
+      std::make_shared<TileLoadTimestamps>();
+  pTimestamps->start = std::chrono::steady_clock::now();
+  tileLoadInfo.pTimestamps = pTimestamps;
 
   TilesetContentLoader* pLoader;
   if (tile.getLoader() == &this->_upsampler) {
@@ -941,20 +1440,31 @@ void TilesetContentManager::loadTileContent(
 
   TileLoadInput loadInput{
       tile,
-      tilesetOptions.contentOptions,
+      contentOptions,
       this->_externals.asyncSystem,
       this->_externals.pAssetAccessor,
       this->_externals.pLogger,
       this->_requestHeaders};
+  loadInput.cancellationToken = cancellation.getToken();
+  loadInput.pRequestPriority = std::move(pRequestPriority);
 
   // Keep the manager alive while the load is in progress.
   CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
 
+  const auto loadStart = std::chrono::system_clock::now();
+
+  // Give all of this tile's worker thread work, from the loader's requests to
+  // post-processing, the same affinity, so that a task processor with more
+  // than one group of threads keeps the tile's buffers in one group.
+  const uint64_t affinityKey =
+      static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&tile));
+  CesiumAsync::ScopedTaskAffinity affinityScope(affinityKey);
+
   pLoader->loadTileContent(loadInput)
       .thenImmediately([tileLoadInfo = std::move(tileLoadInfo),
                         projections = std::move(projections),
-                        rendererOptions = tilesetOptions.rendererOptions](
-                           TileLoadResult&& result) mutable {
+                        rendererOptions = tilesetOptions.rendererOptions,
+                        affinityKey](TileLoadResult&& result) mutable {
         // the reason we run immediate continuation, instead of in the
         // worker thread, is that the loader may run the task in the main
         // thread. And most often than not, those main thread task is very
@@ -962,8 +1472,23 @@ void TilesetContentManager::loadTileContent(
         // spawn another worker thread if the result of the task isn't
         // related to render content. We only ever spawn a new task in the
         // worker thread if the content is a render content
+        tileLoadInfo.pTimestamps->loaded = std::chrono::steady_clock::now();
+
+        if (tileLoadInfo.cancellationToken.isCanceled()) {
+          // Whatever the loader produced, including a failure caused by
+          // abandoning its request, is no longer needed.
+          return tileLoadInfo.asyncSystem
+              .createResolvedFuture<TileLoadResultAndRenderResources>(
+                  {TileLoadResult::createCanceledResult(
+                       std::move(result.pCompletedRequest)),
+                   nullptr});
+        }
+
         if (result.state == TileLoadResultState::Success) {
           if (std::holds_alternative<CesiumGltf::Model>(result.contentKind)) {
+            // This may run in whichever thread completed the request.
+            CesiumAsync::ScopedTaskAffinity postProcessAffinityScope(
+                affinityKey);
             auto asyncSystem = tileLoadInfo.asyncSystem;
             return asyncSystem.runInWorkerThread(
                 [result = std::move(result),
@@ -983,14 +1508,66 @@ void TilesetContentManager::loadTileContent(
             .createResolvedFuture<TileLoadResultAndRenderResources>(
                 {std::move(result), nullptr});
       })
-      .thenInMainThread([&tile, thiz](TileLoadResultAndRenderResources&& pair) {
+      .thenInMainThread([&tile,
+                         thiz,
+                         loadStart,
+                         pTimestamps = std::move(pTimestamps),
+                         cancellationToken = loadInput.cancellationToken,
+                         deferImageDecoding](
+                            TileLoadResultAndRenderResources&& pair) {
+        tile.setLastLoadDuration(
+            std::chrono::duration<double>(
+                std::chrono::system_clock::now() - loadStart)
+                .count());
+        thiz->_tileLoadCancellations.erase(&tile);
+        thiz->_tileLoadPriorities.erase(&tile);
+
+        if (cancellationToken.isCanceled() &&
+            pair.result.state != TileLoadResultState::Canceled) {
+          // The load finished before it noticed the cancellation, so discard
+          // what it produced.
+          if (pair.pRenderResources) {
+            thiz->_externals.pPrepareRendererResources->free(
+                tile,
+                pair.pRenderResources,
+                nullptr);
+          }
+          pair = TileLoadResultAndRenderResources{
+              TileLoadResult::createCanceledResult(
+                  std::move(pair.result.pCompletedRequest)),
+              nullptr};
+        }
+
+        if (deferImageDecoding &&
+            pair.result.state == TileLoadResultState::Success &&
+            std::holds_alternative<CesiumGltf::Model>(
+                pair.result.contentKind)) {
+          thiz->_tilesWithDeferredImages.insert(&tile);
+        }
+
+        if (pair.result.state == TileLoadResultState::Success) {
+          thiz->recordLoadTimes(
+              tile,
+              pair.result,
+              *pTimestamps,
+              thiz->tileHasDeferredImages(tile));
+        }
+
         setTileContent(tile, std::move(pair.result), pair.pRenderResources);
 
         thiz->notifyTileDoneLoading(&tile);
+        if (thiz->_abandonment.isCanceled()) {
+          thiz->unloadAbandonedTile(tile);
+        }
       })
       .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
                              std::exception&& e) {
+        thiz->_tileLoadCancellations.erase(&tile);
+        thiz->_tileLoadPriorities.erase(&tile);
         thiz->notifyTileDoneLoading(&tile);
+        if (thiz->_abandonment.isCanceled()) {
+          thiz->unloadAbandonedTile(tile);
+        }
         SPDLOG_LOGGER_ERROR(
             pLogger,
             "An unexpected error occurs when loading tile: {}",
@@ -1017,7 +1594,9 @@ void TilesetContentManager::updateTileContent(
     TileChildrenResult childrenResult =
         this->_pLoader->createTileChildren(tile);
     if (childrenResult.state == TileLoadResultState::Success) {
-      tile.createChildTiles(std::move(childrenResult.children));
+      this->_childrenPool.createChildTiles(
+          tile,
+          std::move(childrenResult.children));
     }
 
     bool shouldTileContinueUpdated =
@@ -1026,6 +1605,58 @@ void TilesetContentManager::updateTileContent(
   }
 }
 
+bool TilesetContentManager::prefetchTileChildren(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  CESIUM_TRACE("TilesetContentManager::prefetchTileChildren");
+
+  const int32_t maximumPrefetches =
+      static_cast<int32_t>(tilesetOptions.maximumSimultaneousSubtreeLoads);
+  if (this->_prefetchesInProgress >= maximumPrefetches) {
+    return false;
+  }
+
+  TilesetContentLoader* pLoader = tile.getLoader();
+  if (!pLoader || pLoader == &this->_upsampler) {
+    return true;
+  }
+
+  TileLoadInput loadInput{
+      tile,
+      tilesetOptions.contentOptions,
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      this->_externals.pLogger,
+      this->_requestHeaders};
+
+  std::vector<CesiumAsync::Future<void>> prefetches =
+      pLoader->prefetchTileChildren(
+          loadInput,
+          static_cast<size_t>(maximumPrefetches - this->_prefetchesInProgress));
+
+  // Keep the manager, and so the loader, alive while the prefetches are in
+  // progress.
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+  for (CesiumAsync::Future<void>& prefetch : prefetches) {
+    ++this->_prefetchesInProgress;
+    if (this->_externals.pTileLoadScheduler) {
+      this->_externals.pTileLoadScheduler->notifyLoadStarted();
+    }
+
+    auto notifyDone = [thiz]() {
+      --thiz->_prefetchesInProgress;
+      if (thiz->_externals.pTileLoadScheduler) {
+        thiz->_externals.pTileLoadScheduler->notifyLoadFinished();
+      }
+    };
+    std::move(prefetch)
+        .thenInMainThread(notifyDone)
+        .catchInMainThread([notifyDone](std::exception&&) { notifyDone(); });
+  }
+
+  return this->_prefetchesInProgress < maximumPrefetches;
+}
+
 bool TilesetContentManager::unloadTileContent(Tile& tile) {
   TileLoadState state = tile.getState();
   if (state == TileLoadState::Unloaded) {
@@ -1079,12 +1710,85 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
   }
 
   // If we make it this far, the tile's content will be fully unloaded.
+  this->_tilesAwaitingFinish.erase(&tile);
   notifyTileUnloading(&tile);
   content.setContentKind(TileUnknownContent{});
   tile.setState(TileLoadState::Unloaded);
   return true;
 }
 
+void TilesetContentManager::keepUpsamplingSource(Tile& tile) {
+  if (tile._pUpsamplingSource || tile.getChildren().empty() ||
+      tile.getChildren().front().getLoader() != &this->_upsampler) {
+    return;
+  }
+
+  this->setUpsamplingSource(
+      tile,
+      RasterOverlayUpsampler::createUpsamplingSource(tile));
+}
+
+void TilesetContentManager::unloadLoaderData(int64_t maximumTotalBytes) {
+  this->_upsampler.unloadLoaderData(0);
+
+  if (!this->_pLoader) {
+    return;
+  }
+
+  const int64_t loaderBytes = this->_pLoader->getLoaderDataBytes();
+  const int64_t otherBytes = this->getTotalDataUsed() - loaderBytes;
+  this->_pLoader->unloadLoaderData(
+      std::max(maximumTotalBytes - otherBytes, int64_t(0)));
+}
+
+bool TilesetContentManager::releaseTileChildren(Tile& tile) {
+  if (tile.getChildren().empty() || !descendantsHoldNothing(tile) ||
+      !this->_pLoader->releaseTileChildren(tile)) {
+    return false;
+  }
+
+  this->releaseUpsamplingSources(tile);
+  if (this->_externals.pTileOcclusionProxyPool) {
+    // The occlusion pool may be keeping proxies for the children.
+    releaseOcclusionProxies(*this->_externals.pTileOcclusionProxyPool, tile);
+  }
+  this->_childrenPool.releaseChildTiles(tile);
+  tile.setContentShouldContinueUpdating(true);
+  return true;
+}
+
+bool TilesetContentManager::cancelTileContentLoad(const Tile& tile) noexcept {
+  auto it = this->_tileLoadCancellations.find(&tile);
+  if (it == this->_tileLoadCancellations.end()) {
+    return false;
+  }
+
+  it->second.cancel();
+  return true;
+}
+
+void TilesetContentManager::updateTileLoadPriority(
+    const Tile& tile,
+    CesiumAsync::TaskPriority urgency,
+    double priority) noexcept {
+  auto it = this->_tileLoadPriorities.find(&tile);
+  if (it != this->_tileLoadPriorities.end()) {
+    it->second->set(urgency, priority);
+  }
+}
+
+void TilesetContentManager::cancelAllTileContentLoads() noexcept {
+  for (auto& pair : this->_tileLoadCancellations) {
+    pair.second.cancel();
+  }
+}
+
+void TilesetContentManager::abandon() {
+  this->_abandonment.cancel();
+  this->cancelAllTileContentLoads();
+  this->unloadAll();
+}
+
 void TilesetContentManager::unloadAll() {
   // TODO: use the linked-list of loaded tiles instead of walking the entire
   // tile tree.
@@ -1097,7 +1801,7 @@ void TilesetContentManager::waitUntilIdle() {
   // Wait for all asynchronous loading to terminate.
   // If you're hanging here, it's most likely caused by _tileLoadsInProgress not
   // being decremented correctly when an async load ends.
-  while (this->_tileLoadsInProgress > 0) {
+  while (this->_tileLoadsInProgress > 0 || this->_prefetchesInProgress > 0) {
     this->_externals.pAssetAccessor->tick();
     this->_externals.asyncSystem.dispatchMainThreadTasks();
   }
@@ -1161,12 +1865,23 @@ int32_t TilesetContentManager::getNumberOfTilesLoading() const noexcept {
   return this->_tileLoadsInProgress;
 }
 
+int64_t TilesetContentManager::getTileLoadBytesInProgress() const noexcept {
+  return this->_tileLoadBytesInProgress;
+}
+
+int64_t TilesetContentManager::getEstimatedTileLoadBytes() const noexcept {
+  return static_cast<int64_t>(this->_estimatedTileLoadBytes);
+}
+
 int32_t TilesetContentManager::getNumberOfTilesLoaded() const noexcept {
   return this->_loadedTilesCount;
 }
 
 int64_t TilesetContentManager::getTotalDataUsed() const noexcept {
-  int64_t bytes = this->_tilesDataUsed;
+  int64_t bytes = this->_tilesDataUsed + this->_upsamplingSourcesDataUsed;
+  if (this->_pLoader) {
+    bytes += this->_pLoader->getLoaderDataBytes();
+  }
   for (const auto& pTileProvider :
        this->_overlayCollection.getTileProviders()) {
     bytes += pTileProvider->getTileDataBytes();
@@ -1175,61 +1890,168 @@ int64_t TilesetContentManager::getTotalDataUsed() const noexcept {
   return bytes;
 }
 
+const TileLoadStatistics&
+TilesetContentManager::getLoadStatistics() const noexcept {
+  return this->_loadStatistics;
+}
+
+void TilesetContentManager::resetLoadStatistics() noexcept {
+  this->_loadStatistics = TileLoadStatistics();
+}
+
+int64_t TilesetContentManager::getTotalGpuDataUsed() const noexcept {
+  int64_t bytes = this->_tilesGpuDataUsed;
+  for (const auto& pTileProvider :
+       this->_overlayCollection.getTileProviders()) {
+    bytes += pTileProvider->getTileGpuDataBytes();
+  }
+
+  return bytes;
+}
+
 bool TilesetContentManager::tileNeedsWorkerThreadLoading(
     const Tile& tile) const noexcept {
   auto state = tile.getState();
   return state == TileLoadState::Unloaded ||
          state == TileLoadState::FailedTemporarily ||
+         (state == TileLoadState::ContentLoaded &&
+          this->tileHasDeferredImages(tile)) ||
          anyRasterOverlaysNeedLoading(tile);
 }
 
 bool TilesetContentManager::tileNeedsMainThreadLoading(
     const Tile& tile) const noexcept {
   return tile.getState() == TileLoadState::ContentLoaded &&
-         tile.isRenderContent();
+         tile.isRenderContent() && !this->tileHasDeferredImages(tile);
+}
+
+bool TilesetContentManager::tileNeedsContentUpdate(
+    const Tile& tile) const noexcept {
+  const TileLoadState state = tile.getState();
+  if (state == TileLoadState::Unloading ||
+      state == TileLoadState::ContentLoading ||
+      state == TileLoadState::ContentLoaded) {
+    return true;
+  }
+
+  if (tile.shouldContentContinueUpdating()) {
+    return true;
+  }
+
+  const std::vector<RasterMappedTo3DTile>& rasterTiles =
+      tile.getMappedRasterTiles();
+  return std::any_of(
+      rasterTiles.begin(),
+      rasterTiles.end(),
+      [](const RasterMappedTo3DTile& rasterTile) noexcept {
+        return rasterTile.getLoadingTile() != nullptr;
+      });
 }
 
 void TilesetContentManager::finishLoading(
     Tile& tile,
     const TilesetOptions& tilesetOptions) {
-  assert(tile.getState() == TileLoadState::ContentLoaded);
+  Tile* pTile = &tile;
+  this->finishLoadingBatch(gsl::span<Tile* const>(&pTile, 1), tilesetOptions);
+}
+
+void TilesetContentManager::finishLoadingBatch(
+    gsl::span<Tile* const> tiles,
+    const TilesetOptions& tilesetOptions) {
+  if (tiles.empty()) {
+    return;
+  }
 
   // Run the main thread part of loading.
-  TileContent& content = tile.getContent();
-  TileRenderContent* pRenderContent = content.getRenderContent();
+  std::vector<void*> workerRenderResources(tiles.size());
+  CreditSystem* pCreditSystem = this->_externals.pCreditSystem.get();
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    Tile& tile = *tiles[i];
+    assert(tile.getState() == TileLoadState::ContentLoaded);
 
-  assert(pRenderContent != nullptr);
+    TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+    assert(pRenderContent != nullptr);
 
-  // add copyright
-  CreditSystem* pCreditSystem = this->_externals.pCreditSystem.get();
-  if (pCreditSystem) {
-    std::vector<std::string_view> creditStrings =
-        GltfUtilities::parseGltfCopyright(pRenderContent->getModel());
+    // add copyright
+    if (pCreditSystem) {
+      std::vector<std::string_view> creditStrings =
+          GltfUtilities::parseGltfCopyright(pRenderContent->getModel());
 
-    std::vector<Credit> credits;
-    credits.reserve(creditStrings.size());
+      std::vector<Credit> credits;
+      credits.reserve(creditStrings.size());
 
-    for (const std::string_view& creditString : creditStrings) {
-      credits.emplace_back(pCreditSystem->createCredit(
-          std::string(creditString),
-          tilesetOptions.showCreditsOnScreen));
+      for (const std::string_view& creditString : creditStrings) {
+        credits.emplace_back(pCreditSystem->createCredit(
+            std::string(creditString),
+            tilesetOptions.showCreditsOnScreen));
+      }
+
+      pRenderContent->setCredits(credits);
     }
 
-    pRenderContent->setCredits(credits);
+    workerRenderResources[i] = pRenderContent->getRenderResources();
   }
 
-  void* pWorkerRenderResources = pRenderContent->getRenderResources();
-  void* pMainThreadRenderResources =
-      this->_externals.pPrepareRendererResources->prepareInMainThread(
-          tile,
-          pWorkerRenderResources);
+  IPrepareRendererResources& prepareRendererResources =
+      *this->_externals.pPrepareRendererResources;
+  std::vector<void*> mainThreadRenderResources(tiles.size(), nullptr);
+
+  const auto prepareStart = std::chrono::steady_clock::now();
+  if (prepareRendererResources.supportsPrepareInMainThreadBatch()) {
+    prepareRendererResources.prepareInMainThreadBatch(
+        tiles,
+        workerRenderResources,
+        mainThreadRenderResources);
+  } else {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+      mainThreadRenderResources[i] =
+          prepareRendererResources.prepareInMainThread(
+              *tiles[i],
+              workerRenderResources[i]);
+    }
+  }
+  const auto prepareEnd = std::chrono::steady_clock::now();
+
+  // The tiles are prepared together, so they share the time equally.
+  const double prepareMilliseconds =
+      millisecondsBetween(prepareStart, prepareEnd) / double(tiles.size());
+
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    Tile& tile = *tiles[i];
+    void* pMainThreadRenderResources = mainThreadRenderResources[i];
+    TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+
+    auto awaitingIt = this->_tilesAwaitingFinish.find(&tile);
+    if (awaitingIt != this->_tilesAwaitingFinish.end()) {
+      const TileAwaitingFinish& awaiting = awaitingIt->second;
+      this->_loadStatistics.add(
+          awaiting.contentType,
+          TileLoadStage::PrepareInMainThread,
+          prepareMilliseconds);
+      this->_loadStatistics.add(
+          awaiting.contentType,
+          TileLoadStage::Total,
+          millisecondsBetween(awaiting.start, prepareEnd));
+      this->_tilesAwaitingFinish.erase(awaitingIt);
+    }
+
+    pRenderContent->setRenderResources(pMainThreadRenderResources);
+    tile.setState(TileLoadState::Done);
 
-  pRenderContent->setRenderResources(pMainThreadRenderResources);
-  tile.setState(TileLoadState::Done);
+    // The children are upsampled from the content again.
+    this->setUpsamplingSource(tile, nullptr);
 
-  // This allows the raster tile to be updated and children to be created, if
-  // necessary.
-  updateTileContent(tile, tilesetOptions);
+    if (tilesetOptions.contentOptions.releaseCpuDataAfterPreparing) {
+      releaseCpuData(pRenderContent->getModel());
+      pRenderContent->setCpuDataReleased(true);
+    }
+
+    notifyTileRendererResourcesPrepared(tile, pMainThreadRenderResources);
+
+    // This allows the raster tile to be updated and children to be created, if
+    // necessary.
+    updateTileContent(tile, tilesetOptions);
+  }
 }
 
 void TilesetContentManager::setTileContent(
@@ -1242,6 +2064,11 @@ void TilesetContentManager::setTileContent(
   } else if (result.state == TileLoadResultState::RetryLater) {
     tile.getMappedRasterTiles().clear();
     tile.setState(TileLoadState::FailedTemporarily);
+    ++tile._temporaryFailureCount;
+    tile._lastTemporaryFailureTime = std::chrono::steady_clock::now();
+  } else if (result.state == TileLoadResultState::Canceled) {
+    tile.getMappedRasterTiles().clear();
+    tile.setState(TileLoadState::Unloaded);
   } else {
     // update tile if the result state is success
     if (result.updatedBoundingVolume) {
@@ -1264,6 +2091,7 @@ void TilesetContentManager::setTileContent(
       result.tileInitializer(tile);
     }
 
+    tile._temporaryFailureCount = 0;
     tile.setState(TileLoadState::ContentLoaded);
   }
 }
@@ -1281,7 +2109,9 @@ void TilesetContentManager::updateContentLoadedState(
     // If the main thread part of render content loading is not throttled,
     // do it right away. Otherwise we'll do it later in
     // Tileset::_processMainThreadLoadQueue with prioritization and throttling.
-    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0) {
+    // A tile with deferred images waits until it is needed.
+    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0 &&
+        !this->tileHasDeferredImages(tile)) {
       finishLoading(tile, tilesetOptions);
     }
   } else if (content.isEmptyContent()) {
@@ -1359,8 +2189,10 @@ void TilesetContentManager::updateDoneState(
             this->_overlayCollection.findPlaceholderTileProviderForOverlay(
                 pLoadingTile->getOverlay());
 
-        // Try to replace this placeholder with real tiles.
-        if (pProvider && pPlaceholder && !pProvider->isPlaceholder()) {
+        // Try to replace this placeholder with real tiles, unless the time
+        // for doing so this frame is up.
+        if (pProvider && pPlaceholder && !pProvider->isPlaceholder() &&
+            this->hasRasterOverlayMappingTime()) {
           // Remove the existing placeholder mapping
           rasterTiles.erase(
               rasterTiles.begin() +
@@ -1411,7 +2243,10 @@ void TilesetContentManager::updateDoneState(
     // children to hang more detailed rasters on by subdividing this tile.
     if (!skippedUnknown && moreRasterDetailAvailable &&
         tile.getChildren().empty()) {
-      createQuadtreeSubdividedChildren(tile, this->_upsampler);
+      createQuadtreeSubdividedChildren(
+          tile,
+          this->_upsampler,
+          this->_childrenPool);
     }
   } else {
     // We can't hang raster images on a tile without geometry, and their
@@ -1421,11 +2256,31 @@ void TilesetContentManager::updateDoneState(
   }
 }
 
+void TilesetContentManager::startRasterOverlayMapping(
+    double timeLimit) noexcept {
+  if (timeLimit > 0.0) {
+    this->_rasterOverlayMappingDeadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(timeLimit));
+  } else {
+    this->_rasterOverlayMappingDeadline.reset();
+  }
+}
+
+bool TilesetContentManager::hasRasterOverlayMappingTime() const noexcept {
+  return !this->_rasterOverlayMappingDeadline ||
+         std::chrono::steady_clock::now() <
+             *this->_rasterOverlayMappingDeadline;
+}
+
 void TilesetContentManager::unloadContentLoadedState(Tile& tile) {
   TileContent& content = tile.getContent();
   TileRenderContent* pRenderContent = content.getRenderContent();
   assert(pRenderContent && "Tile must have render content to be unloaded");
 
+  this->_tilesWithDeferredImages.erase(&tile);
+
   void* pWorkerRenderResources = pRenderContent->getRenderResources();
   this->_externals.pPrepareRendererResources->free(
       tile,
@@ -1447,31 +2302,323 @@ void TilesetContentManager::unloadDoneState(Tile& tile) {
   pRenderContent->setRenderResources(nullptr);
 }
 
-void TilesetContentManager::notifyTileStartLoading(
-    [[maybe_unused]] const Tile* pTile) noexcept {
+void TilesetContentManager::recordLoadTimes(
+    const Tile& tile,
+    const TileLoadResult& result,
+    const TileLoadTimestamps& timestamps,
+    bool deferredImages) {
+  const std::string contentType = getTileContentType(tile, result);
+  const auto now = std::chrono::steady_clock::now();
+
+  this->_loadStatistics.add(
+      contentType,
+      TileLoadStage::Load,
+      millisecondsBetween(timestamps.start, timestamps.loaded));
+
+  auto workerEnd = timestamps.loaded;
+  if (timestamps.postProcessed) {
+    this->_loadStatistics.add(
+        contentType,
+        TileLoadStage::PostProcess,
+        millisecondsBetween(workerEnd, *timestamps.postProcessed));
+    workerEnd = *timestamps.postProcessed;
+  }
+
+  if (timestamps.preparedInLoadThread) {
+    this->_loadStatistics.add(
+        contentType,
+        TileLoadStage::PrepareInLoadThread,
+        millisecondsBetween(workerEnd, *timestamps.preparedInLoadThread));
+    workerEnd = *timestamps.preparedInLoadThread;
+  }
+
+  this->_loadStatistics.add(
+      contentType,
+      TileLoadStage::MainThreadWait,
+      millisecondsBetween(workerEnd, now));
+
+  // Render content is only ready once finishLoading prepares it in the main
+  // thread. Preloaded tiles whose images are deferred may wait indefinitely
+  // for that, so their load ends here.
+  if (std::holds_alternative<CesiumGltf::Model>(result.contentKind) &&
+      !deferredImages) {
+    this->_tilesAwaitingFinish[&tile] =
+        TileAwaitingFinish{timestamps.start, contentType};
+  } else {
+    this->_loadStatistics.add(
+        contentType,
+        TileLoadStage::Total,
+        millisecondsBetween(timestamps.start, now));
+  }
+}
+
+bool TilesetContentManager::tileHasDeferredImages(
+    const Tile& tile) const noexcept {
+  return this->_tilesWithDeferredImages.find(&tile) !=
+         this->_tilesWithDeferredImages.end();
+}
+
+void TilesetContentManager::decodeDeferredImages(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  CESIUM_TRACE_CATEGORY(Decode, "TilesetContentManager::decodeDeferredImages");
+
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  assert(pRenderContent && "Only render content has deferred images");
+
+  this->_tilesWithDeferredImages.erase(&tile);
+  notifyTileStartLoading(&tile);
+  tile.setState(TileLoadState::ContentLoading);
+
+  // Rebuild the load result that the renderer would have been given when the
+  // tile was loaded. The up axis was recorded in the model's extras.
+  CesiumGltf::Model& model = pRenderContent->getModel();
+  int32_t upAxis = static_cast<int32_t>(CesiumGeometry::Axis::Y);
+  auto upAxisIt = model.extras.find("gltfUpAxis");
+  if (upAxisIt != model.extras.end()) {
+    upAxis = upAxisIt->second.getSafeNumberOrDefault<int32_t>(upAxis);
+  }
+  const CesiumRasterOverlays::RasterOverlayDetails& overlayDetails =
+      pRenderContent->getRasterOverlayDetails();
+
+  TileLoadResult result{
+      std::move(model),
+      static_cast<CesiumGeometry::Axis>(upAxis),
+      std::nullopt,
+      std::nullopt,
+      std::nullopt,
+      nullptr,
+      {},
+      TileLoadResultState::Success};
+  if (!overlayDetails.rasterOverlayProjections.empty()) {
+    result.rasterOverlayDetails = overlayDetails;
+  }
+
+  const TilesetContentOptions& contentOptions = tilesetOptions.contentOptions;
+  CesiumGltfReader::GltfReaderOptions gltfOptions;
+  gltfOptions.ktx2TranscodeTargets = contentOptions.ktx2TranscodeTargets;
+  gltfOptions.maximumImageDimension = contentOptions.maximumImageDimension;
+  gltfOptions.maximumKtx2Dimension = contentOptions.maximumKtx2Dimension;
+  gltfOptions.decodeOpaqueImagesToRgb = contentOptions.decodeOpaqueImagesToRgb;
+  gltfOptions.asyncSystem = this->_externals.asyncSystem;
+  gltfOptions.pDecodedDataAllocator = contentOptions.pDecodedDataAllocator;
+
+  std::shared_ptr<CesiumGltfContent::IStagingBufferAllocator>
+      pStagingBufferAllocator = contentOptions.pStagingBufferAllocator;
+
+  // Keep the manager alive while the images are decoded.
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+
+  this->_externals.asyncSystem
+      .runInWorkerThread([result = std::move(result),
+                          gltfOptions,
+                          asyncSystem = this->_externals.asyncSystem,
+                          pLogger = this->_externals.pLogger,
+                          pPrepareRendererResources =
+                              this->_externals.pPrepareRendererResources,
+                          tileTransform = tile.getTransform(),
+                          rendererOptions = tilesetOptions.rendererOptions,
+                          pStagingBufferAllocator =
+                              std::move(pStagingBufferAllocator),
+                          abandonment =
+                              this->_abandonment.getToken()]() mutable {
+        if (abandonment.isCanceled()) {
+          // The tile will be unloaded as soon as this returns.
+          return asyncSystem
+              .createResolvedFuture<TileLoadResultAndRenderResources>(
+                  {std::move(result), nullptr});
+        }
+
+        CesiumGltf::Model& deferredModel =
+            std::get<CesiumGltf::Model>(result.contentKind);
+        CesiumGltfReader::GltfReaderResult gltfResult{
+            std::move(deferredModel),
+            {},
+            {}};
+        CesiumGltfReader::GltfReader::decodeEmbeddedImages(
+            gltfResult,
+            gltfOptions);
+        if (!gltfResult.errors.empty()) {
+          SPDLOG_LOGGER_ERROR(
+              pLogger,
+              "Failed decoding deferred glTF images:\n- {}",
+              CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+        }
+        deferredModel = std::move(*gltfResult.model);
+
+        writeVertexStreamsInWorkerThread(result, pStagingBufferAllocator);
+
+        return pPrepareRendererResources->prepareInLoadThread(
+            asyncSystem,
+            std::move(result),
+            tileTransform,
+            rendererOptions);
+      })
+      .thenInMainThread([&tile, thiz](TileLoadResultAndRenderResources&& pair) {
+        TileRenderContent* pContent = tile.getContent().getRenderContent();
+        if (std::holds_alternative<CesiumGltf::Model>(
+                pair.result.contentKind)) {
+          pContent->setModel(
+              std::get<CesiumGltf::Model>(std::move(pair.result.contentKind)));
+        }
+        pContent->setRenderResources(pair.pRenderResources);
+        tile.setState(TileLoadState::ContentLoaded);
+
+        thiz->notifyDeferredImagesDecoded(tile);
+        if (thiz->_abandonment.isCanceled()) {
+          thiz->unloadAbandonedTile(tile);
+        }
+      })
+      .catchInMainThread([&tile, thiz](std::exception&& e) {
+        // The model was moved to the failed task, so the tile can't be used.
+        tile.setState(TileLoadState::Failed);
+        thiz->notifyDeferredImagesDecoded(tile);
+        if (thiz->_abandonment.isCanceled()) {
+          thiz->unloadAbandonedTile(tile);
+        }
+        SPDLOG_LOGGER_ERROR(
+            thiz->_externals.pLogger,
+            "An unexpected error occurs when decoding deferred tile images: {}",
+            e.what());
+      });
+}
+
+void TilesetContentManager::notifyTileStartLoading(const Tile* pTile) noexcept {
   ++this->_tileLoadsInProgress;
+
+  // The load is counted with the estimate that was current when it started,
+  // so that the same amount is removed when it is done.
+  if (pTile) {
+    const int64_t estimate = this->getEstimatedTileLoadBytes();
+    this->_tileLoadByteEstimates[pTile] = estimate;
+    this->_tileLoadBytesInProgress += estimate;
+  }
+
+  if (this->_externals.pTileLoadScheduler) {
+    this->_externals.pTileLoadScheduler->notifyLoadStarted();
+  }
 }
 
-void TilesetContentManager::notifyTileDoneLoading(const Tile* pTile) noexcept {
+void TilesetContentManager::notifyTileDoneLoading(Tile* pTile) noexcept {
   assert(
       this->_tileLoadsInProgress > 0 &&
       "There are no tile loads currently in flight");
   --this->_tileLoadsInProgress;
   ++this->_loadedTilesCount;
 
+  if (this->_externals.pTileLoadScheduler) {
+    this->_externals.pTileLoadScheduler->notifyLoadFinished();
+  }
+
   if (pTile) {
-    this->_tilesDataUsed += pTile->computeByteSize();
+    this->removeTileLoadByteEstimate(*pTile);
+
+    pTile->_cpuByteSize = pTile->computeByteSize();
+    this->_tilesDataUsed += pTile->_cpuByteSize;
+    CESIUM_TRACE_ALLOC(pTile, pTile->_cpuByteSize, "Tile content");
+
+    // The size of the decoded content stands in for the work and the
+    // transient memory needed to load it. Loads that produced nothing, such
+    // as failed or canceled ones, say nothing about that.
+    if (pTile->_cpuByteSize > 0) {
+      if (this->_estimatedTileLoadBytes == 0.0) {
+        this->_estimatedTileLoadBytes = double(pTile->_cpuByteSize);
+      } else {
+        this->_estimatedTileLoadBytes +=
+            tileLoadBytesSmoothing *
+            (double(pTile->_cpuByteSize) - this->_estimatedTileLoadBytes);
+      }
+    }
+  }
+}
+
+void TilesetContentManager::removeTileLoadByteEstimate(
+    const Tile& tile) noexcept {
+  auto it = this->_tileLoadByteEstimates.find(&tile);
+  if (it != this->_tileLoadByteEstimates.end()) {
+    this->_tileLoadBytesInProgress -= it->second;
+    this->_tileLoadByteEstimates.erase(it);
+  }
+}
+
+void TilesetContentManager::notifyDeferredImagesDecoded(Tile& tile) noexcept {
+  assert(
+      this->_tileLoadsInProgress > 0 &&
+      "There are no tile loads currently in flight");
+  --this->_tileLoadsInProgress;
+  this->removeTileLoadByteEstimate(tile);
+
+  if (this->_externals.pTileLoadScheduler) {
+    this->_externals.pTileLoadScheduler->notifyLoadFinished();
   }
+
+  // The tile was already counted as loaded when it was preloaded, so only its
+  // size changes.
+  const int64_t cpuByteSize = tile.computeByteSize();
+  this->_tilesDataUsed += cpuByteSize - tile._cpuByteSize;
+  tile._cpuByteSize = cpuByteSize;
+  CESIUM_TRACE_FREE(&tile, "Tile content");
+  CESIUM_TRACE_ALLOC(&tile, cpuByteSize, "Tile content");
 }
 
-void TilesetContentManager::notifyTileUnloading(const Tile* pTile) noexcept {
+void TilesetContentManager::notifyTileRendererResourcesPrepared(
+    Tile& tile,
+    void* pMainThreadRenderResources) noexcept {
+  const int64_t cpuByteSize = tile.computeByteSize();
+  this->_tilesDataUsed += cpuByteSize - tile._cpuByteSize;
+  tile._cpuByteSize = cpuByteSize;
+  CESIUM_TRACE_FREE(&tile, "Tile content");
+  CESIUM_TRACE_ALLOC(&tile, cpuByteSize, "Tile content");
+
+  const int64_t gpuByteSize =
+      this->_externals.pPrepareRendererResources->getGpuByteSize(
+          tile,
+          pMainThreadRenderResources);
+  this->_tilesGpuDataUsed += gpuByteSize - tile._gpuByteSize;
+  tile._gpuByteSize = gpuByteSize;
+}
+
+void TilesetContentManager::notifyTileUnloading(Tile* pTile) noexcept {
   if (pTile) {
-    this->_tilesDataUsed -= pTile->computeByteSize();
+    CESIUM_TRACE_FREE(pTile, "Tile content");
+    this->_tilesDataUsed -= pTile->_cpuByteSize;
+    this->_tilesGpuDataUsed -= pTile->_gpuByteSize;
+    pTile->_cpuByteSize = 0;
+    pTile->_gpuByteSize = 0;
   }
 
   --this->_loadedTilesCount;
 }
 
+void TilesetContentManager::setUpsamplingSource(
+    Tile& tile,
+    std::shared_ptr<const TileUpsamplingSource>&& pSource) noexcept {
+  if (tile._pUpsamplingSource) {
+    this->_upsamplingSourcesDataUsed -= tile._pUpsamplingSource->sizeBytes;
+  }
+
+  tile._pUpsamplingSource = std::move(pSource);
+  if (tile._pUpsamplingSource) {
+    this->_upsamplingSourcesDataUsed += tile._pUpsamplingSource->sizeBytes;
+  }
+}
+
+void TilesetContentManager::releaseUpsamplingSources(Tile& tile) noexcept {
+  this->setUpsamplingSource(tile, nullptr);
+  for (Tile& child : tile.getChildren()) {
+    this->releaseUpsamplingSources(child);
+  }
+}
+
+void TilesetContentManager::unloadAbandonedTile(Tile& tile) {
+  this->unloadTileContent(tile);
+
+  Tile* pParent = tile.getParent();
+  if (pParent && pParent->getState() == TileLoadState::Unloading) {
+    this->unloadTileContent(*pParent);
+  }
+}
+
 template <class TilesetContentLoaderType>
 void TilesetContentManager::propagateTilesetContentLoaderResult(
     TilesetLoadType type,
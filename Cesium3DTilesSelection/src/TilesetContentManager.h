@@ -1,22 +1,34 @@
 #pragma once
 
 #include "RasterOverlayUpsampler.h"
+#include "TileChildrenPool.h"
 #include "TilesetContentLoaderResult.h"
 
 #include <Cesium3DTilesSelection/RasterOverlayCollection.h>
 #include <Cesium3DTilesSelection/Tile.h>
 #include <Cesium3DTilesSelection/TileContent.h>
+#include <Cesium3DTilesSelection/TileLoadStatistics.h>
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <Cesium3DTilesSelection/TilesetLoadFailureDetails.h>
 #include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/AssetRequestOptions.h>
+#include <CesiumAsync/CancellationToken.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/ReferenceCounted.h>
 
+#include <gsl/span>
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+struct TileLoadTimestamps;
 
 class TilesetContentManager
     : public CesiumUtility::ReferenceCountedNonThreadSafe<
@@ -58,14 +70,127 @@ public:
    */
   CesiumAsync::SharedFuture<void>& getRootTileAvailableEvent();
 
+  /**
+   * @brief The time at which {@link getRootTileAvailableEvent} resolved, or
+   * `std::nullopt` if it hasn't yet.
+   */
+  const std::optional<std::chrono::steady_clock::time_point>&
+  getRootTileAvailableTime() const noexcept;
+
   ~TilesetContentManager() noexcept;
 
-  void loadTileContent(Tile& tile, const TilesetOptions& tilesetOptions);
+  // Preloads may defer the decoding of the tile's images. See
+  // TilesetContentOptions::deferPreloadedImageDecoding. The load's requests
+  // have the urgency of the calling task and the given priority within it.
+  void loadTileContent(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      bool isPreload = false,
+      double priority = 0.0);
+
+  /**
+   * @brief Changes the priority of the requests of a tile whose content is
+   * loading, so that an asset accessor that queues requests can send them
+   * sooner or later.
+   *
+   * @param tile The tile.
+   * @param urgency The new group of the tile's requests.
+   * @param priority The new order of the tile's requests within the group.
+   * Requests with a _lower_ value are sent sooner.
+   */
+  void updateTileLoadPriority(
+      const Tile& tile,
+      CesiumAsync::TaskPriority urgency,
+      double priority) noexcept;
+
+  /**
+   * @brief Starts loading the data that the tile's loader needs to create the
+   * tile's children and load their content, such as child subtrees of an
+   * implicit tileset, while fewer than
+   * {@link TilesetOptions::maximumSimultaneousSubtreeLoads} are in progress.
+   *
+   * @return Whether more prefetches may start.
+   */
+  bool prefetchTileChildren(Tile& tile, const TilesetOptions& tilesetOptions);
 
   void updateTileContent(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  /**
+   * @brief Starts the time that {@link updateTileContent} may spend this frame
+   * mapping raster overlays whose tile providers became ready to the tiles
+   * that show their placeholders.
+   *
+   * The tiles that don't fit in the time keep their placeholders until a later
+   * frame. Tiles are updated in the order in which they are visited, so the
+   * tiles closer to the root are mapped first.
+   *
+   * @param timeLimit The time limit in milliseconds, or 0.0 for no limit.
+   */
+  void startRasterOverlayMapping(double timeLimit) noexcept;
+
   bool unloadTileContent(Tile& tile);
 
+  /**
+   * @brief Keeps what's needed to upsample the children of the given tile for
+   * raster overlays, so that they can still be loaded after the tile's content
+   * is unloaded, without loading the tile again.
+   *
+   * This does nothing unless the tile's children are upsampled and its content
+   * is done loading. The upsampling source is counted in
+   * {@link getTotalDataUsed} until the tile is loaded again or its children
+   * are destroyed.
+   */
+  void keepUpsamplingSource(Tile& tile);
+
+  /**
+   * @brief Unloads the loader's data that can be loaded again, such as the
+   * availability of implicit subtrees, until the total data used is at most
+   * the given number of bytes or no more can be unloaded.
+   */
+  void unloadLoaderData(int64_t maximumTotalBytes);
+
+  /**
+   * @brief Destroys the children of the given tile if none of its descendants
+   * has content and the loader can create them again.
+   *
+   * The tile's children are created again by the loader the next time the
+   * tile is updated. The caller must make sure that nothing else refers to
+   * the descendants.
+   *
+   * @return true if the children were destroyed, false otherwise.
+   */
+  bool releaseTileChildren(Tile& tile);
+
+  /**
+   * @brief Asks the in-progress load of the given tile's content, if any, to
+   * stop at its next opportunity.
+   *
+   * The tile stays in the {@link TileLoadState::ContentLoading} state until
+   * the load actually stops, and then returns to
+   * {@link TileLoadState::Unloaded}.
+   *
+   * @return true if the tile's content was loading, false otherwise.
+   */
+  bool cancelTileContentLoad(const Tile& tile) noexcept;
+
+  /**
+   * @brief Asks every in-progress tile content load to stop at its next
+   * opportunity.
+   */
+  void cancelAllTileContentLoads() noexcept;
+
+  /**
+   * @brief Stops all work for the tileset, because the tileset that owns this
+   * manager is being destroyed.
+   *
+   * Every in-progress load is canceled and every tile that is safe to unload
+   * is unloaded right away. Nothing is loaded after this, and each tile that
+   * is still loading is unloaded as soon as its load stops, rather than when
+   * the last one does. The loaders are freed, along with this manager, once
+   * every in-progress load has stopped.
+   */
+  void abandon();
+
   void waitUntilIdle();
 
   /**
@@ -96,16 +221,48 @@ public:
 
   int32_t getNumberOfTilesLoading() const noexcept;
 
+  /**
+   * @brief Gets the sum of the estimated bytes of the tile loads in progress.
+   *
+   * Each load counts with {@link getEstimatedTileLoadBytes} as of when it
+   * started.
+   */
+  int64_t getTileLoadBytesInProgress() const noexcept;
+
+  /**
+   * @brief Gets the estimated bytes of the next tile load, which is a moving
+   * average of the sizes of the content of recently loaded tiles, or 0 before
+   * any tile has loaded.
+   */
+  int64_t getEstimatedTileLoadBytes() const noexcept;
+
   int32_t getNumberOfTilesLoaded() const noexcept;
 
   int64_t getTotalDataUsed() const noexcept;
 
+  int64_t getTotalGpuDataUsed() const noexcept;
+
+  const TileLoadStatistics& getLoadStatistics() const noexcept;
+
+  void resetLoadStatistics() noexcept;
+
   bool tileNeedsWorkerThreadLoading(const Tile& tile) const noexcept;
   bool tileNeedsMainThreadLoading(const Tile& tile) const noexcept;
 
+  // Whether the tile's content, children, or raster overlays may still change
+  // on a later call to updateTileContent, even if no new load is requested.
+  bool tileNeedsContentUpdate(const Tile& tile) const noexcept;
+
   // Transition the tile from the ContentLoaded to the Done state.
   void finishLoading(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  // Transition the tiles from the ContentLoaded to the Done state, preparing
+  // their renderer resources together with
+  // IPrepareRendererResources::prepareInMainThreadBatch if it is supported.
+  void finishLoadingBatch(
+      gsl::span<Tile* const> tiles,
+      const TilesetOptions& tilesetOptions);
+
 private:
   static void setTileContent(
       Tile& tile,
@@ -121,11 +278,51 @@ private:
 
   void unloadDoneState(Tile& tile);
 
+  // Whether there is time left this frame to replace raster overlay
+  // placeholders. See startRasterOverlayMapping.
+  bool hasRasterOverlayMappingTime() const noexcept;
+
+  // Counts the stages of a successful load that ended in worker threads, once
+  // its result reaches the main thread.
+  void recordLoadTimes(
+      const Tile& tile,
+      const TileLoadResult& result,
+      const TileLoadTimestamps& timestamps,
+      bool deferredImages);
+
+  bool tileHasDeferredImages(const Tile& tile) const noexcept;
+
+  // Decodes the images of a tile that was preloaded without them and prepares
+  // its renderer resources in a worker thread, leaving the tile in the
+  // ContentLoaded state with its resources ready for finishLoading.
+  void decodeDeferredImages(Tile& tile, const TilesetOptions& tilesetOptions);
+
   void notifyTileStartLoading(const Tile* pTile) noexcept;
 
-  void notifyTileDoneLoading(const Tile* pTile) noexcept;
+  void notifyTileDoneLoading(Tile* pTile) noexcept;
 
-  void notifyTileUnloading(const Tile* pTile) noexcept;
+  void notifyDeferredImagesDecoded(Tile& tile) noexcept;
+
+  void removeTileLoadByteEstimate(const Tile& tile) noexcept;
+
+  // Recounts the tile's CPU and GPU bytes after its renderer resources are
+  // prepared, because the renderer may free CPU copies of uploaded data.
+  void notifyTileRendererResourcesPrepared(
+      Tile& tile,
+      void* pMainThreadRenderResources) noexcept;
+
+  void notifyTileUnloading(Tile* pTile) noexcept;
+
+  void setUpsamplingSource(
+      Tile& tile,
+      std::shared_ptr<const TileUpsamplingSource>&& pSource) noexcept;
+
+  // Releases the upsampling sources of the tile and all of its descendants.
+  void releaseUpsamplingSources(Tile& tile) noexcept;
+
+  // Unloads a tile whose load stopped after the manager was abandoned, along
+  // with its parent if it was waiting for the tile to stop upsampling from it.
+  void unloadAbandonedTile(Tile& tile);
 
   template <class TilesetContentLoaderType>
   void propagateTilesetContentLoaderResult(
@@ -141,15 +338,48 @@ private:
   std::optional<CesiumUtility::Credit> _userCredit;
   std::vector<CesiumUtility::Credit> _tilesetCredits;
   RasterOverlayUpsampler _upsampler;
+  TileChildrenPool _childrenPool;
   RasterOverlayCollection _overlayCollection;
   int32_t _tileLoadsInProgress;
+  int32_t _prefetchesInProgress;
+
+  // The estimated cost of the tile loads in progress, for
+  // TilesetOptions::maximumSimultaneousTileLoadBytes.
+  int64_t _tileLoadBytesInProgress;
+  double _estimatedTileLoadBytes;
+  std::unordered_map<const Tile*, int64_t> _tileLoadByteEstimates;
+  std::unordered_map<const Tile*, CesiumAsync::CancellationTokenSource>
+      _tileLoadCancellations;
+  CesiumAsync::CancellationTokenSource _abandonment;
+  std::unordered_map<
+      const Tile*,
+      std::shared_ptr<CesiumAsync::AssetRequestPriority>>
+      _tileLoadPriorities;
+  std::unordered_set<const Tile*> _tilesWithDeferredImages;
+
+  // The loads of render content that are waiting for finishLoading, to be
+  // counted in _loadStatistics once they are done.
+  struct TileAwaitingFinish {
+    std::chrono::steady_clock::time_point start;
+    std::string contentType;
+  };
+  std::unordered_map<const Tile*, TileAwaitingFinish> _tilesAwaitingFinish;
+  TileLoadStatistics _loadStatistics;
+
   int32_t _loadedTilesCount;
   int64_t _tilesDataUsed;
+  int64_t _tilesGpuDataUsed;
+  int64_t _upsamplingSourcesDataUsed;
 
   CesiumAsync::Promise<void> _destructionCompletePromise;
   CesiumAsync::SharedFuture<void> _destructionCompleteFuture;
 
   CesiumAsync::Promise<void> _rootTileAvailablePromise;
   CesiumAsync::SharedFuture<void> _rootTileAvailableFuture;
+  std::optional<std::chrono::steady_clock::time_point> _rootTileAvailableTime;
+
+  // When to stop replacing raster overlay placeholders this frame, if ever.
+  std::optional<std::chrono::steady_clock::time_point>
+      _rasterOverlayMappingDeadline;
 };
 } // namespace Cesium3DTilesSelection
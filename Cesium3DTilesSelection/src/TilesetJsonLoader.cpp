@@ -1,7 +1,9 @@
 #include "TilesetJsonLoader.h"
+#include "DecodedTileCache.h"
 
 #include "ImplicitOctreeLoader.h"
 #include "ImplicitQuadtreeLoader.h"
+#include "TileHierarchyCache.h"
 #include "logTileLoadResult.h"
 
 #include <Cesium3DTilesContent/GltfConverters.h>
@@ -10,6 +12,7 @@
 #include <Cesium3DTilesReader/SchemaReader.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
@@ -20,9 +23,14 @@
 #include <CesiumUtility/joinToString.h>
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <cctype>
+#include <ctime>
+#include <string_view>
 
 using namespace CesiumUtility;
 using namespace Cesium3DTilesContent;
@@ -38,7 +46,22 @@ struct ExternalContentInitializer {
   TilesetJsonLoader* tilesetJsonLoader;
   TileExternalContent externalContent;
 
+  // The JSON of the children of the external tileset's root tile, if they are
+  // created on demand.
+  const rapidjson::Value* pRootChildrenJsonOnDemand = nullptr;
+
+  // The external tileset that was requested and parsed for the tile, to be
+  // cached by the loader under its URL. Empty if it came from the cache.
+  std::string tilesetUrl;
+  ParsedExternalTileset parsedTileset;
+
   void operator()(Tile& tile) {
+    if (parsedTileset.pTilesetJson) {
+      tilesetJsonLoader->cacheExternalTileset(
+          tilesetUrl,
+          std::move(parsedTileset));
+    }
+
     TileExternalContent* pExternalContent =
         tile.getContent().getExternalContent();
     if (pExternalContent) {
@@ -50,6 +73,12 @@ struct ExternalContentInitializer {
         children.emplace_back(std::move(*pExternalRoot));
         tile.createChildTiles(std::move(children));
 
+        if (pRootChildrenJsonOnDemand) {
+          pExternalTilesetLoaders->pLoader->addTileChildrenJson(
+              tile.getChildren()[0],
+              *pRootChildrenJsonOnDemand);
+        }
+
         // save the loader of the external tileset in this loader
         tilesetJsonLoader->addChildLoader(
             std::move(pExternalTilesetLoaders->pLoader));
@@ -390,13 +419,26 @@ void parseImplicitTileset(
   }
 }
 
+/**
+ * @brief Parses the given tile JSON, along with its children.
+ *
+ * If `ppChildrenJsonOnDemand` is not null, the children are not parsed.
+ * Instead, it is set to the JSON array of the children, or to nullptr if the
+ * tile has none, so that they can be created later by
+ * TilesetJsonLoader::createTileChildren.
+ */
 std::optional<Tile> parseTileJsonRecursively(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const rapidjson::Value& tileJson,
     const glm::dmat4& parentTransform,
     TileRefine parentRefine,
     double parentGeometricError,
-    TilesetJsonLoader& currentLoader) {
+    TilesetJsonLoader& currentLoader,
+    const rapidjson::Value** ppChildrenJsonOnDemand = nullptr) {
+  if (ppChildrenJsonOnDemand) {
+    *ppChildrenJsonOnDemand = nullptr;
+  }
+
   if (!tileJson.IsObject()) {
     return std::nullopt;
   }
@@ -550,19 +592,25 @@ std::optional<Tile> parseTileJsonRecursively(
   const auto childrenIt = tileJson.FindMember("children");
   if (childrenIt != tileJson.MemberEnd() && childrenIt->value.IsArray()) {
     const auto& childrenJson = childrenIt->value;
-    childTiles.reserve(childrenJson.Size());
-    for (rapidjson::SizeType i = 0; i < childrenJson.Size(); ++i) {
-      const auto& childJson = childrenJson[i];
-      auto maybeChild = parseTileJsonRecursively(
-          pLogger,
-          childJson,
-          tileTransform,
-          tileRefine,
-          tileGeometricError,
-          currentLoader);
-
-      if (maybeChild) {
-        childTiles.emplace_back(std::move(*maybeChild));
+    if (ppChildrenJsonOnDemand) {
+      if (!childrenJson.Empty()) {
+        *ppChildrenJsonOnDemand = &childrenJson;
+      }
+    } else {
+      childTiles.reserve(childrenJson.Size());
+      for (rapidjson::SizeType i = 0; i < childrenJson.Size(); ++i) {
+        const auto& childJson = childrenJson[i];
+        auto maybeChild = parseTileJsonRecursively(
+            pLogger,
+            childJson,
+            tileTransform,
+            tileRefine,
+            tileGeometricError,
+            currentLoader);
+
+        if (maybeChild) {
+          childTiles.emplace_back(std::move(*maybeChild));
+        }
       }
     }
   }
@@ -599,7 +647,8 @@ TilesetContentLoaderResult<TilesetJsonLoader> parseTilesetJson(
     const std::string& baseUrl,
     const rapidjson::Document& tilesetJson,
     const glm::dmat4& parentTransform,
-    TileRefine parentRefine) {
+    TileRefine parentRefine,
+    const rapidjson::Value** ppRootChildrenJsonOnDemand = nullptr) {
   std::unique_ptr<Tile> pRootTile;
   auto gltfUpAxis = obtainGltfUpAxis(tilesetJson, pLogger);
   auto pLoader = std::make_unique<TilesetJsonLoader>(baseUrl, gltfUpAxis);
@@ -612,7 +661,8 @@ TilesetContentLoaderResult<TilesetJsonLoader> parseTilesetJson(
         parentTransform,
         parentRefine,
         10000000.0,
-        *pLoader);
+        *pLoader,
+        ppRootChildrenJsonOnDemand);
 
     if (maybeRootTile) {
       pRootTile = std::make_unique<Tile>(std::move(*maybeRootTile));
@@ -629,7 +679,7 @@ TilesetContentLoaderResult<TilesetJsonLoader> parseTilesetJson(
 
 void parseTilesetMetadata(
     const std::string& baseUrl,
-    const rapidjson::Document& tilesetJson,
+    const rapidjson::Value& tilesetJson,
     TileExternalContent& externalContent) {
   auto schemaIt = tilesetJson.FindMember("schema");
   if (schemaIt != tilesetJson.MemberEnd()) {
@@ -665,31 +715,70 @@ void parseTilesetMetadata(
   }
 }
 
-TileLoadResult parseExternalTilesetInWorkerThread(
-    const glm::dmat4& tileTransform,
-    CesiumGeometry::Axis upAxis,
-    TileRefine tileRefine,
+/**
+ * @brief Parses the JSON of an external tileset from the response to its
+ * request.
+ *
+ * @param pLogger The logger for the parse error, or nullptr to not log it.
+ * @param pCompletedRequest The completed request.
+ * @return The parsed external tileset, or `std::nullopt` if the response
+ * isn't a JSON object.
+ */
+std::optional<ParsedExternalTileset> parseExternalTileset(
     const std::shared_ptr<spdlog::logger>& pLogger,
-    std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest,
-    ExternalContentInitializer&& externalContentInitializer) {
-  // create external tileset
+    const std::shared_ptr<CesiumAsync::IAssetRequest>& pCompletedRequest) {
   const CesiumAsync::IAssetResponse* pResponse = pCompletedRequest->response();
   const auto& responseData = pResponse->data();
-  const auto& tileUrl = pCompletedRequest->url();
 
-  rapidjson::Document tilesetJson;
+  auto pTilesetJson = std::make_shared<rapidjson::Document>();
+  rapidjson::Document& tilesetJson = *pTilesetJson;
   tilesetJson.Parse(
       reinterpret_cast<const char*>(responseData.data()),
       responseData.size());
   if (tilesetJson.HasParseError()) {
-    SPDLOG_LOGGER_ERROR(
-        pLogger,
-        "Error when parsing tileset JSON, error code {} at byte offset {}",
-        tilesetJson.GetParseError(),
-        tilesetJson.GetErrorOffset());
-    return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
+    if (pLogger) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Error when parsing tileset JSON, error code {} at byte offset {}",
+          tilesetJson.GetParseError(),
+          tilesetJson.GetErrorOffset());
+    }
+    return std::nullopt;
+  }
+
+  if (!tilesetJson.IsObject()) {
+    if (pLogger) {
+      SPDLOG_LOGGER_ERROR(pLogger, "Tileset JSON must be an object");
+    }
+    return std::nullopt;
   }
 
+  const int64_t sizeBytes =
+      int64_t(responseData.size()) + int64_t(tilesetJson.GetAllocator().Size());
+  return ParsedExternalTileset{
+      pCompletedRequest,
+      std::move(pTilesetJson),
+      sizeBytes};
+}
+
+TileLoadResult createExternalTilesetInWorkerThread(
+    const glm::dmat4& tileTransform,
+    CesiumGeometry::Axis upAxis,
+    TileRefine tileRefine,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const ParsedExternalTileset& parsedTileset,
+    ExternalContentInitializer&& externalContentInitializer,
+    bool createChildrenOnDemand) {
+  // create external tileset
+  std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest =
+      parsedTileset.pRequest;
+  const auto& tileUrl = pCompletedRequest->url();
+
+  // The JSON is shared with the cache of the loader of the tile, and kept by
+  // the external tileset's loader if the children of its tiles are created on
+  // demand.
+  const rapidjson::Document& tilesetJson = *parsedTileset.pTilesetJson;
+
   // Save the parsed external tileset into custom data.
   // We will propagate it back to tile later in the main
   // thread
@@ -699,7 +788,10 @@ TileLoadResult parseExternalTilesetInWorkerThread(
           tileUrl,
           tilesetJson,
           tileTransform,
-          tileRefine);
+          tileRefine,
+          createChildrenOnDemand
+              ? &externalContentInitializer.pRootChildrenJsonOnDemand
+              : nullptr);
 
   // Populate the root tile with metadata
   parseTilesetMetadata(
@@ -716,6 +808,12 @@ TileLoadResult parseExternalTilesetInWorkerThread(
     return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
   }
 
+  if (createChildrenOnDemand) {
+    externalTilesetLoader.pLoader->keepTilesetJson(
+        pLogger,
+        parsedTileset.pTilesetJson);
+  }
+
   externalContentInitializer.pExternalTilesetLoaders =
       std::make_shared<TilesetContentLoaderResult<TilesetJsonLoader>>(
           std::move(externalTilesetLoader));
@@ -732,21 +830,189 @@ TileLoadResult parseExternalTilesetInWorkerThread(
       TileLoadResultState::Success};
 }
 
+/**
+ * @brief Determines whether the path of the given URL ends with `.json`, and
+ * so is probably the URL of an external tileset.
+ */
+bool isTilesetJsonUrl(const std::string& url) {
+  std::string_view path = url;
+  path = path.substr(0, path.find_first_of("?#"));
+
+  constexpr std::string_view extension = ".json";
+  if (path.size() < extension.size()) {
+    return false;
+  }
+
+  const std::string_view ending = path.substr(path.size() - extension.size());
+  return std::equal(
+      ending.begin(),
+      ending.end(),
+      extension.begin(),
+      [](char a, char b) {
+        return char(std::tolower(static_cast<unsigned char>(a))) == b;
+      });
+}
+
+bool allDescendantsUseLoader(
+    const Tile& tile,
+    const TilesetContentLoader* pLoader) {
+  for (const Tile& child : tile.getChildren()) {
+    if (child.getLoader() != pLoader ||
+        !allDescendantsUseLoader(child, pLoader)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Creates a root tile to represent the tileset.json itself, above the
+ * root tile parsed from it, and populates it with the tileset's metadata.
+ */
+void addTilesetRootTile(
+    TilesetContentLoaderResult<TilesetJsonLoader>& result,
+    const std::string& tilesetJsonUrl,
+    const rapidjson::Value& metadataJson) {
+  std::vector<Tile> children;
+  children.emplace_back(std::move(*result.pRootTile));
+
+  result.pRootTile = std::make_unique<Tile>(
+      children[0].getLoader(),
+      std::make_unique<TileExternalContent>());
+
+  result.pRootTile->setTileID("");
+  result.pRootTile->setTransform(children[0].getTransform());
+  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
+  result.pRootTile->setUnconditionallyRefine();
+  result.pRootTile->setRefine(children[0].getRefine());
+  result.pRootTile->createChildTiles(std::move(children));
+
+  // Populate the root tile with metadata
+  TileExternalContent* pExternal =
+      result.pRootTile->getContent().getExternalContent();
+  assert(pExternal);
+  if (pExternal) {
+    parseTilesetMetadata(tilesetJsonUrl, metadataJson, *pExternal);
+  }
+}
+
+/**
+ * @brief Creates a loader for the given tileset JSON. If `pTilesetJson` is not
+ * null, it is the same JSON, and the loader keeps it to create the children of
+ * the tiles on demand.
+ */
+TilesetContentLoaderResult<TilesetJsonLoader> createLoaderFromTilesetJson(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& tilesetJsonUrl,
+    const rapidjson::Document& tilesetJson,
+    std::shared_ptr<const rapidjson::Document> pTilesetJson) {
+  const rapidjson::Value* pRootChildrenJsonOnDemand = nullptr;
+  TilesetContentLoaderResult<TilesetJsonLoader> result = parseTilesetJson(
+      pLogger,
+      tilesetJsonUrl,
+      tilesetJson,
+      glm::dmat4(1.0),
+      TileRefine::Replace,
+      pTilesetJson ? &pRootChildrenJsonOnDemand : nullptr);
+
+  addTilesetRootTile(result, tilesetJsonUrl, tilesetJson);
+
+  // The tiles are at their final addresses now, so the children of the
+  // tileset's root tile can be created on demand.
+  if (pTilesetJson) {
+    result.pLoader->keepTilesetJson(pLogger, std::move(pTilesetJson));
+    if (pRootChildrenJsonOnDemand) {
+      result.pLoader->addTileChildrenJson(
+          result.pRootTile->getChildren()[0],
+          *pRootChildrenJsonOnDemand);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Writes the members of the given tileset JSON that
+ * parseTilesetMetadata reads, so that they can be cached along with the tile
+ * hierarchy.
+ */
+std::string writeTilesetMetadataJson(const rapidjson::Document& tilesetJson) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  for (const char* name : {"schema", "schemaUri", "metadata", "groups"}) {
+    const auto it = tilesetJson.FindMember(name);
+    if (it != tilesetJson.MemberEnd()) {
+      writer.Key(name);
+      it->value.Accept(writer);
+    }
+  }
+  writer.EndObject();
+
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+// How long a cached tile hierarchy is kept. Its key includes the ETag of the
+// tileset.json, so it is never used once the tileset.json changes anyway.
+constexpr std::time_t TILE_HIERARCHY_CACHE_LIFETIME_SECONDS =
+    30 * 24 * 60 * 60;
+
+void cacheTileHierarchy(
+    CesiumAsync::ICacheDatabase& tileHierarchyCache,
+    const CesiumAsync::IAssetRequest& tilesetJsonRequest,
+    const rapidjson::Document& tilesetJson,
+    const TilesetContentLoaderResult<TilesetJsonLoader>& result) {
+  std::optional<std::string> maybeKey =
+      getTileHierarchyCacheKey(tilesetJsonRequest);
+  if (!maybeKey || !result.pLoader || !result.pRootTile ||
+      result.pRootTile->getChildren().size() != 1) {
+    return;
+  }
+
+  std::vector<std::byte> hierarchy = writeTileHierarchy(
+      result.pRootTile->getChildren()[0],
+      result.pLoader->getUpAxis(),
+      writeTilesetMetadataJson(tilesetJson));
+  if (hierarchy.empty()) {
+    return;
+  }
+
+  tileHierarchyCache.storeEntry(
+      *maybeKey,
+      std::time(nullptr) + TILE_HIERARCHY_CACHE_LIFETIME_SECONDS,
+      tilesetJsonRequest.url(),
+      tilesetJsonRequest.method(),
+      CesiumAsync::HttpHeaders{},
+      200,
+      CesiumAsync::HttpHeaders{},
+      hierarchy);
+}
+
 } // namespace
 
 TilesetJsonLoader::TilesetJsonLoader(
     const std::string& baseUrl,
     CesiumGeometry::Axis upAxis)
-    : _baseUrl{baseUrl}, _upAxis{upAxis}, _children{} {}
+    : _baseUrl{baseUrl},
+      _upAxis{upAxis},
+      _children{},
+      _externalTilesets{},
+      _pLogger{},
+      _pTilesetJson{},
+      _tileChildrenJson{} {}
 
 CesiumAsync::Future<TilesetContentLoaderResult<TilesetJsonLoader>>
 TilesetJsonLoader::createLoader(
     const TilesetExternals& externals,
     const std::string& tilesetJsonUrl,
-    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    bool createChildrenOnDemand) {
   return externals.pAssetAccessor
       ->get(externals.asyncSystem, tilesetJsonUrl, requestHeaders)
-      .thenInWorkerThread([pLogger = externals.pLogger](
+      .thenInWorkerThread([pLogger = externals.pLogger,
+                           pTileHierarchyCache = externals.pTileHierarchyCache,
+                           createChildrenOnDemand](
                               const std::shared_ptr<CesiumAsync::IAssetRequest>&
                                   pCompletedRequest) {
         const CesiumAsync::IAssetResponse* pResponse =
@@ -771,6 +1037,17 @@ TilesetJsonLoader::createLoader(
           return result;
         }
 
+        if (pTileHierarchyCache && !createChildrenOnDemand) {
+          std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+              maybeCachedResult =
+                  TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+                      *pTileHierarchyCache,
+                      *pCompletedRequest);
+          if (maybeCachedResult) {
+            return std::move(*maybeCachedResult);
+          }
+        }
+
         gsl::span<const std::byte> data = pResponse->data();
 
         rapidjson::Document tilesetJson;
@@ -789,8 +1066,10 @@ TilesetJsonLoader::createLoader(
 
         return TilesetJsonLoader::createLoader(
             pLogger,
-            pCompletedRequest->url(),
-            tilesetJson);
+            *pCompletedRequest,
+            std::move(tilesetJson),
+            createChildrenOnDemand,
+            pTileHierarchyCache);
       });
 }
 
@@ -798,36 +1077,86 @@ TilesetContentLoaderResult<TilesetJsonLoader> TilesetJsonLoader::createLoader(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& tilesetJsonUrl,
     const rapidjson::Document& tilesetJson) {
-  TilesetContentLoaderResult<TilesetJsonLoader> result = parseTilesetJson(
+  return createLoaderFromTilesetJson(
       pLogger,
       tilesetJsonUrl,
       tilesetJson,
-      glm::dmat4(1.0),
-      TileRefine::Replace);
+      nullptr);
+}
 
-  // Create a root tile to represent the tileset.json itself.
-  std::vector<Tile> children;
-  children.emplace_back(std::move(*result.pRootTile));
+TilesetContentLoaderResult<TilesetJsonLoader> TilesetJsonLoader::createLoader(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const CesiumAsync::IAssetRequest& tilesetJsonRequest,
+    rapidjson::Document&& tilesetJson,
+    bool createChildrenOnDemand,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pTileHierarchyCache) {
+  const std::string& tilesetJsonUrl = tilesetJsonRequest.url();
+  if (!createChildrenOnDemand) {
+    TilesetContentLoaderResult<TilesetJsonLoader> result =
+        createLoaderFromTilesetJson(
+            pLogger,
+            tilesetJsonUrl,
+            tilesetJson,
+            nullptr);
+    if (pTileHierarchyCache) {
+      cacheTileHierarchy(
+          *pTileHierarchyCache,
+          tilesetJsonRequest,
+          tilesetJson,
+          result);
+    }
+    return result;
+  }
 
-  result.pRootTile = std::make_unique<Tile>(
-      children[0].getLoader(),
-      std::make_unique<TileExternalContent>());
+  auto pTilesetJson =
+      std::make_shared<const rapidjson::Document>(std::move(tilesetJson));
+  return createLoaderFromTilesetJson(
+      pLogger,
+      tilesetJsonUrl,
+      *pTilesetJson,
+      pTilesetJson);
+}
 
-  result.pRootTile->setTileID("");
-  result.pRootTile->setTransform(children[0].getTransform());
-  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
-  result.pRootTile->setUnconditionallyRefine();
-  result.pRootTile->setRefine(children[0].getRefine());
-  result.pRootTile->createChildTiles(std::move(children));
+std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+    const CesiumAsync::ICacheDatabase& tileHierarchyCache,
+    const CesiumAsync::IAssetRequest& tilesetJsonRequest) {
+  std::optional<std::string> maybeKey =
+      getTileHierarchyCacheKey(tilesetJsonRequest);
+  if (!maybeKey) {
+    return std::nullopt;
+  }
 
-  // Populate the root tile with metadata
-  TileExternalContent* pExternal =
-      result.pRootTile->getContent().getExternalContent();
-  assert(pExternal);
-  if (pExternal) {
-    parseTilesetMetadata(tilesetJsonUrl, tilesetJson, *pExternal);
+  std::optional<CesiumAsync::CacheItem> maybeCacheItem =
+      tileHierarchyCache.getEntry(*maybeKey);
+  if (!maybeCacheItem) {
+    return std::nullopt;
   }
 
+  const std::string& tilesetJsonUrl = tilesetJsonRequest.url();
+  std::optional<CachedTileHierarchy> maybeHierarchy = readTileHierarchy(
+      tilesetJsonUrl,
+      maybeCacheItem->cacheResponse.data);
+  if (!maybeHierarchy) {
+    return std::nullopt;
+  }
+
+  rapidjson::Document metadataJson;
+  metadataJson.Parse(
+      maybeHierarchy->metadataJson.data(),
+      maybeHierarchy->metadataJson.size());
+  if (metadataJson.HasParseError() || !metadataJson.IsObject()) {
+    return std::nullopt;
+  }
+
+  TilesetContentLoaderResult<TilesetJsonLoader> result{
+      std::move(maybeHierarchy->pLoader),
+      std::move(maybeHierarchy->pRootTile),
+      std::vector<LoaderCreditResult>{},
+      std::vector<CesiumAsync::IAssetAccessor::THeader>{},
+      ErrorList{}};
+  addTilesetRootTile(result, tilesetJsonUrl, metadataJson);
+
   return result;
 }
 
@@ -841,7 +1170,7 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   }
 
   // this loader only handles Url ID
-  const std::string* url = std::get_if<std::string>(&tile.getTileID());
+  const InternedString* url = std::get_if<InternedString>(&tile.getTileID());
   if (!url) {
     return loadInput.asyncSystem.createResolvedFuture<TileLoadResult>(
         TileLoadResult::createFailedResult(nullptr));
@@ -850,25 +1179,67 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   const glm::dmat4& tileTransform = tile.getTransform();
   TileRefine tileRefine = tile.getRefine();
 
-  ExternalContentInitializer externalContentInitializer{nullptr, this, {}};
+  ExternalContentInitializer externalContentInitializer{
+      nullptr,
+      this,
+      {},
+      nullptr};
 
   const auto& asyncSystem = loadInput.asyncSystem;
   const auto& pAssetAccessor = loadInput.pAssetAccessor;
   const auto& pLogger = loadInput.pLogger;
   const auto& requestHeaders = loadInput.requestHeaders;
   const auto& contentOptions = loadInput.contentOptions;
-  std::string resolvedUrl =
-      CesiumUtility::Uri::resolve(this->_baseUrl, *url, true);
-  return pAssetAccessor->get(asyncSystem, resolvedUrl, requestHeaders)
+  std::string resolvedUrl = this->_baseUrl.resolve(*url, true);
+  const auto& cancellationToken = loadInput.cancellationToken;
+
+  // An external tileset that was prefetched or loaded before doesn't need to
+  // be requested and parsed again.
+  const ParsedExternalTileset* pCachedTileset =
+      this->_externalTilesets.find(resolvedUrl);
+  if (pCachedTileset) {
+    return asyncSystem.runInWorkerThread(
+        [pLogger,
+         tileTransform,
+         tileRefine,
+         upAxis = _upAxis,
+         parsedTileset = *pCachedTileset,
+         externalContentInitializer = std::move(externalContentInitializer),
+         createChildrenOnDemand =
+             contentOptions.createExplicitTileChildrenOnDemand]() mutable {
+          return createExternalTilesetInWorkerThread(
+              tileTransform,
+              upAxis,
+              tileRefine,
+              pLogger,
+              parsedTileset,
+              std::move(externalContentInitializer),
+              createChildrenOnDemand);
+        });
+  }
+
+  externalContentInitializer.tilesetUrl = resolvedUrl;
+  return pAssetAccessor
+      ->getWithOptions(
+          asyncSystem,
+          resolvedUrl,
+          requestHeaders,
+          loadInput.getRequestOptions())
       .thenInWorkerThread(
           [pLogger,
+           asyncSystem,
            contentOptions,
            tileTransform,
            tileRefine,
            upAxis = _upAxis,
-           externalContentInitializer = std::move(externalContentInitializer)](
-              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                  pCompletedRequest) mutable {
+           externalContentInitializer = std::move(externalContentInitializer),
+           cancellationToken](std::shared_ptr<CesiumAsync::IAssetRequest>&&
+                                  pCompletedRequest) mutable {
+            if (cancellationToken.isCanceled()) {
+              return TileLoadResult::createCanceledResult(
+                  std::move(pCompletedRequest));
+            }
+
             auto pResponse = pCompletedRequest->response();
             const std::string& tileUrl = pCompletedRequest->url();
             if (!pResponse) {
@@ -899,13 +1270,49 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
             }
 
             if (converter) {
+              std::optional<CesiumGltf::Model> maybeCachedModel =
+                  loadDecodedTileFromCache(*pCompletedRequest, contentOptions);
+              if (maybeCachedModel) {
+                return TileLoadResult{
+                    std::move(*maybeCachedModel),
+                    upAxis,
+                    std::nullopt,
+                    std::nullopt,
+                    std::nullopt,
+                    std::move(pCompletedRequest),
+                    {},
+                    TileLoadResultState::Success};
+              }
+
               // Convert to gltf
               CesiumGltfReader::GltfReaderOptions gltfOptions;
               gltfOptions.ktx2TranscodeTargets =
                   contentOptions.ktx2TranscodeTargets;
               gltfOptions.applyTextureTransform =
                   contentOptions.applyTextureTransform;
+              gltfOptions.dequantizeMeshData =
+                  contentOptions.dequantizeMeshData;
+              gltfOptions.shufflePointClouds =
+                  contentOptions.shufflePointClouds;
+              gltfOptions.batchTableProperties =
+                  contentOptions.batchTableProperties;
+              gltfOptions.maximumImageDimension =
+                  contentOptions.maximumImageDimension;
+              gltfOptions.maximumKtx2Dimension =
+                  contentOptions.maximumKtx2Dimension;
+              gltfOptions.decodeOpaqueImagesToRgb =
+                  contentOptions.decodeOpaqueImagesToRgb;
+              gltfOptions.decodeEmbeddedImages =
+                  contentOptions.decodeEmbeddedImages;
+              gltfOptions.cancellationToken = cancellationToken;
+              gltfOptions.asyncSystem = asyncSystem;
+              gltfOptions.pDecodedDataAllocator =
+                  contentOptions.pDecodedDataAllocator;
               GltfConverterResult result = converter(responseData, gltfOptions);
+              if (cancellationToken.isCanceled()) {
+                return TileLoadResult::createCanceledResult(
+                    std::move(pCompletedRequest));
+              }
 
               // Report any errors if there are any
               logTileLoadResult(pLogger, tileUrl, result.errors);
@@ -914,6 +1321,11 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
                     std::move(pCompletedRequest));
               }
 
+              storeDecodedTileInCache(
+                  *pCompletedRequest,
+                  contentOptions,
+                  *result.model);
+
               return TileLoadResult{
                   std::move(*result.model),
                   upAxis,
@@ -925,13 +1337,22 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
                   TileLoadResultState::Success};
             } else {
               // not a renderable content, then it must be external tileset
-              return parseExternalTilesetInWorkerThread(
+              std::optional<ParsedExternalTileset> maybeTileset =
+                  parseExternalTileset(pLogger, pCompletedRequest);
+              if (!maybeTileset) {
+                return TileLoadResult::createFailedResult(
+                    std::move(pCompletedRequest));
+              }
+
+              externalContentInitializer.parsedTileset = *maybeTileset;
+              return createExternalTilesetInWorkerThread(
                   tileTransform,
                   upAxis,
                   tileRefine,
                   pLogger,
-                  std::move(pCompletedRequest),
-                  std::move(externalContentInitializer));
+                  *maybeTileset,
+                  std::move(externalContentInitializer),
+                  contentOptions.createExplicitTileChildrenOnDemand);
             }
           });
 }
@@ -942,11 +1363,181 @@ TileChildrenResult TilesetJsonLoader::createTileChildren(const Tile& tile) {
     return pLoader->createTileChildren(tile);
   }
 
-  return {{}, TileLoadResultState::Failed};
+  auto childrenJsonIt = this->_tileChildrenJson.find(&tile);
+  if (childrenJsonIt == this->_tileChildrenJson.end()) {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  const rapidjson::Value& childrenJson = *childrenJsonIt->second;
+  std::vector<Tile> children;
+  std::vector<const rapidjson::Value*> grandchildrenJson;
+  children.reserve(childrenJson.Size());
+  grandchildrenJson.reserve(childrenJson.Size());
+  for (rapidjson::SizeType i = 0; i < childrenJson.Size(); ++i) {
+    const rapidjson::Value* pGrandchildrenJson = nullptr;
+    auto maybeChild = parseTileJsonRecursively(
+        this->_pLogger,
+        childrenJson[i],
+        tile.getTransform(),
+        tile.getRefine(),
+        tile.getGeometricError(),
+        *this,
+        &pGrandchildrenJson);
+
+    if (maybeChild) {
+      children.emplace_back(std::move(*maybeChild));
+      grandchildrenJson.emplace_back(pGrandchildrenJson);
+    }
+  }
+
+  // The vector is moved into the tile, so the children keep these addresses.
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (grandchildrenJson[i]) {
+      this->addTileChildrenJson(children[i], *grandchildrenJson[i]);
+    }
+  }
+
+  return {std::move(children), TileLoadResultState::Success};
+}
+
+bool TilesetJsonLoader::releaseTileChildren(const Tile& tile) {
+  auto pLoader = tile.getLoader();
+  if (pLoader != this) {
+    return pLoader->releaseTileChildren(tile);
+  }
+
+  if (this->_tileChildrenJson.find(&tile) == this->_tileChildrenJson.end()) {
+    return false;
+  }
+
+  // Tiles of external or implicit tilesets can't be created again from this
+  // loader's JSON.
+  if (!allDescendantsUseLoader(tile, this)) {
+    return false;
+  }
+
+  for (const Tile& child : tile.getChildren()) {
+    this->forgetTileChildrenJson(child);
+  }
+
+  return true;
+}
+
+std::vector<CesiumAsync::Future<void>> TilesetJsonLoader::prefetchTileChildren(
+    const TileLoadInput& loadInput,
+    size_t maximumLoads) {
+  const Tile& tile = loadInput.tile;
+  auto pLoader = tile.getLoader();
+  if (pLoader != this) {
+    return pLoader->prefetchTileChildren(loadInput, maximumLoads);
+  }
+
+  std::vector<CesiumAsync::Future<void>> loads;
+  for (const Tile& child : tile.getChildren()) {
+    if (loads.size() >= maximumLoads) {
+      break;
+    }
+
+    if (child.getLoader() != this ||
+        child.getState() != TileLoadState::Unloaded) {
+      continue;
+    }
+
+    const InternedString* pUrl =
+        std::get_if<InternedString>(&child.getTileID());
+    if (!pUrl) {
+      continue;
+    }
+
+    std::string resolvedUrl = this->_baseUrl.resolve(*pUrl, true);
+    if (!isTilesetJsonUrl(resolvedUrl) ||
+        this->_externalTilesets.isLoading(resolvedUrl) ||
+        this->_externalTilesets.find(resolvedUrl)) {
+      continue;
+    }
+
+    loads.emplace_back(
+        this->prefetchExternalTileset(loadInput, std::move(resolvedUrl)));
+  }
+
+  return loads;
+}
+
+int64_t TilesetJsonLoader::getLoaderDataBytes() const noexcept {
+  int64_t bytes = this->_externalTilesets.getSizeBytes();
+  for (const std::unique_ptr<TilesetContentLoader>& pChild : this->_children) {
+    bytes += pChild->getLoaderDataBytes();
+  }
+
+  return bytes;
+}
+
+void TilesetJsonLoader::unloadLoaderData(int64_t maximumBytes) {
+  // The cached external tilesets are the cheapest to load again, so they are
+  // removed first.
+  const int64_t childrenBytes =
+      this->getLoaderDataBytes() - this->_externalTilesets.getSizeBytes();
+  this->_externalTilesets.unload(
+      std::max(maximumBytes - childrenBytes, int64_t(0)));
+
+  // Each child loader unloads its share of the excess, in turn, until the
+  // rest fit.
+  int64_t excessBytes = this->getLoaderDataBytes() - maximumBytes;
+  for (const std::unique_ptr<TilesetContentLoader>& pChild : this->_children) {
+    if (excessBytes <= 0) {
+      break;
+    }
+
+    const int64_t childBytes = pChild->getLoaderDataBytes();
+    pChild->unloadLoaderData(std::max(childBytes - excessBytes, int64_t(0)));
+    excessBytes -= childBytes - pChild->getLoaderDataBytes();
+  }
+}
+
+CesiumAsync::Future<void> TilesetJsonLoader::prefetchExternalTileset(
+    const TileLoadInput& loadInput,
+    std::string&& url) {
+  this->_externalTilesets.markLoading(url);
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> request =
+      loadInput.pAssetAccessor->getWithOptions(
+          loadInput.asyncSystem,
+          url,
+          loadInput.requestHeaders,
+          loadInput.getRequestOptions());
+  return std::move(request)
+      .thenInWorkerThread(
+          [](std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest)
+              -> std::optional<ParsedExternalTileset> {
+            // Failures aren't logged, because loading the tile requests the
+            // external tileset again and logs them.
+            const CesiumAsync::IAssetResponse* pResponse =
+                pCompletedRequest->response();
+            if (!pResponse) {
+              return std::nullopt;
+            }
+
+            uint16_t statusCode = pResponse->statusCode();
+            if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
+              return std::nullopt;
+            }
+
+            return parseExternalTileset(nullptr, pCompletedRequest);
+          })
+      .thenInMainThread(
+          [this, url = std::move(url)](
+              std::optional<ParsedExternalTileset>&& maybeTileset) {
+            if (!maybeTileset) {
+              this->_externalTilesets.markLoadFailed(url);
+              return;
+            }
+
+            this->_externalTilesets.add(url, std::move(*maybeTileset));
+          });
 }
 
 const std::string& TilesetJsonLoader::getBaseUrl() const noexcept {
-  return this->_baseUrl;
+  return this->_baseUrl.getBase();
 }
 
 CesiumGeometry::Axis TilesetJsonLoader::getUpAxis() const noexcept {
@@ -957,4 +1548,30 @@ void TilesetJsonLoader::addChildLoader(
     std::unique_ptr<TilesetContentLoader> pLoader) {
   this->_children.emplace_back(std::move(pLoader));
 }
+
+void TilesetJsonLoader::cacheExternalTileset(
+    const std::string& url,
+    ParsedExternalTileset&& tileset) {
+  this->_externalTilesets.add(url, std::move(tileset));
+}
+
+void TilesetJsonLoader::keepTilesetJson(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    std::shared_ptr<const rapidjson::Document> pTilesetJson) noexcept {
+  this->_pLogger = pLogger;
+  this->_pTilesetJson = std::move(pTilesetJson);
+}
+
+void TilesetJsonLoader::addTileChildrenJson(
+    const Tile& tile,
+    const rapidjson::Value& childrenJson) {
+  this->_tileChildrenJson[&tile] = &childrenJson;
+}
+
+void TilesetJsonLoader::forgetTileChildrenJson(const Tile& tile) {
+  this->_tileChildrenJson.erase(&tile);
+  for (const Tile& child : tile.getChildren()) {
+    this->forgetTileChildrenJson(child);
+  }
+}
 } // namespace Cesium3DTilesSelection
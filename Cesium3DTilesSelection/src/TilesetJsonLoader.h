@@ -1,16 +1,20 @@
 #pragma once
 
+#include "ExternalTilesetCache.h"
 #include "TilesetContentLoaderResult.h"
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumUtility/UriResolver.h>
 
 #include <rapidjson/fwd.h>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -23,25 +27,112 @@ public:
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  bool releaseTileChildren(const Tile& tile) override;
+
+  int64_t getLoaderDataBytes() const noexcept override;
+
+  void unloadLoaderData(int64_t maximumBytes) override;
+
+  /**
+   * @brief Starts loading and parsing the JSON of the external tilesets that
+   * are the content of the given tile's children, so that loading a child
+   * doesn't need to wait for its external tileset to be requested and parsed.
+   *
+   * Only the children whose content URL ends with `.json` are considered to be
+   * external tilesets. The parsed JSON is kept by this loader, along with the
+   * JSON of the external tilesets that it loaded, until
+   * {@link unloadLoaderData} removes it.
+   */
+  std::vector<CesiumAsync::Future<void>> prefetchTileChildren(
+      const TileLoadInput& loadInput,
+      size_t maximumLoads) override;
+
   const std::string& getBaseUrl() const noexcept;
 
   CesiumGeometry::Axis getUpAxis() const noexcept;
 
   void addChildLoader(std::unique_ptr<TilesetContentLoader> pLoader);
 
+  /**
+   * @brief Keeps the parsed JSON of an external tileset that this loader
+   * loaded, so that it can be loaded again without requesting and parsing it.
+   *
+   * @param url The resolved URL of the external tileset.
+   * @param tileset The parsed external tileset.
+   */
+  void cacheExternalTileset(
+      const std::string& url,
+      ParsedExternalTileset&& tileset);
+
+  /**
+   * @brief Keeps the parsed tileset JSON that this loader's tiles came from,
+   * so that their children can be created from it on demand.
+   *
+   * @param pLogger The logger for the problems found in the JSON of the
+   * children.
+   * @param pTilesetJson The tileset JSON.
+   */
+  void keepTilesetJson(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      std::shared_ptr<const rapidjson::Document> pTilesetJson) noexcept;
+
+  /**
+   * @brief Creates the children of the given tile from the given element of
+   * the JSON passed to {@link keepTilesetJson} when
+   * {@link createTileChildren} is first called for the tile.
+   *
+   * @param tile The tile, which must stay at its address.
+   * @param childrenJson The array of the JSON of the tile's children.
+   */
+  void addTileChildrenJson(
+      const Tile& tile,
+      const rapidjson::Value& childrenJson);
+
   static CesiumAsync::Future<TilesetContentLoaderResult<TilesetJsonLoader>>
   createLoader(
       const TilesetExternals& externals,
       const std::string& tilesetJsonUrl,
-      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      bool createChildrenOnDemand = false);
 
   static TilesetContentLoaderResult<TilesetJsonLoader> createLoader(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& tilesetJsonUrl,
       const rapidjson::Document& tilesetJson);
 
+  /**
+   * @brief Creates a loader from the tileset JSON received for the given
+   * request, optionally keeping it to create the children of each tile only
+   * when they are first needed.
+   *
+   * Unless the children are created on demand, the tile hierarchy is also
+   * stored in `pTileHierarchyCache`, if it isn't null, so that
+   * {@link createLoaderFromCachedTileHierarchy} can create the loader without
+   * parsing the same tileset JSON again.
+   */
+  static TilesetContentLoaderResult<TilesetJsonLoader> createLoader(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const CesiumAsync::IAssetRequest& tilesetJsonRequest,
+      rapidjson::Document&& tilesetJson,
+      bool createChildrenOnDemand,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pTileHierarchyCache);
+
+  /**
+   * @brief Creates a loader from the tile hierarchy cached for the tileset JSON
+   * received for the given request, if the cache has it for the same ETag.
+   */
+  static std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+  createLoaderFromCachedTileHierarchy(
+      const CesiumAsync::ICacheDatabase& tileHierarchyCache,
+      const CesiumAsync::IAssetRequest& tilesetJsonRequest);
+
 private:
-  std::string _baseUrl;
+  void forgetTileChildrenJson(const Tile& tile);
+
+  CesiumAsync::Future<void>
+  prefetchExternalTileset(const TileLoadInput& loadInput, std::string&& url);
+
+  CesiumUtility::UriResolver _baseUrl;
 
   /**
    * @brief The axis that was declared as the "up-axis" for glTF content.
@@ -56,5 +147,16 @@ private:
   CesiumGeometry::Axis _upAxis;
 
   std::vector<std::unique_ptr<TilesetContentLoader>> _children;
+
+  // The parsed JSON of the external tilesets that are the content of this
+  // loader's tiles.
+  ExternalTilesetCache _externalTilesets;
+
+  // The tileset JSON kept for creating tile children on demand, and the JSON
+  // array of the children of each tile whose children haven't been created or
+  // were released. Only used when the children are created on demand.
+  std::shared_ptr<spdlog::logger> _pLogger;
+  std::shared_ptr<const rapidjson::Document> _pTilesetJson;
+  std::unordered_map<const Tile*, const rapidjson::Value*> _tileChildrenJson;
 };
 } // namespace Cesium3DTilesSelection
@@ -5,12 +5,87 @@
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumUtility/joinToString.h>
 
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
 using namespace CesiumAsync;
+using namespace Cesium3DTiles;
 using namespace Cesium3DTilesReader;
 using namespace CesiumUtility;
 
 namespace Cesium3DTilesSelection {
 
+namespace {
+// The schemas loaded from each schema URI that are still used by the metadata
+// of some tileset, so that tilesets with the same schema URI only request and
+// parse it once.
+struct SchemaCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<const Schema>> schemas;
+};
+
+SchemaCache& getSchemaCache() {
+  static SchemaCache cache;
+  return cache;
+}
+
+std::shared_ptr<const Schema> findCachedSchema(const std::string& schemaUri) {
+  SchemaCache& cache = getSchemaCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto it = cache.schemas.find(schemaUri);
+  return it == cache.schemas.end() ? nullptr : it->second.lock();
+}
+
+void cacheSchema(
+    const std::string& schemaUri,
+    const std::shared_ptr<const Schema>& pSchema) {
+  SchemaCache& cache = getSchemaCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  for (auto it = cache.schemas.begin(); it != cache.schemas.end();) {
+    if (it->second.expired()) {
+      it = cache.schemas.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  cache.schemas[schemaUri] = pSchema;
+}
+
+std::shared_ptr<const Schema> readSchema(const IAssetRequest& request) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    throw std::runtime_error(fmt::format(
+        "Did not receive a valid response for schema URI {}",
+        request.url()));
+  }
+
+  uint16_t statusCode = pResponse->statusCode();
+  if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
+    throw std::runtime_error(fmt::format(
+        "Received status code {} for schema URI {}.",
+        statusCode,
+        request.url()));
+  }
+
+  SchemaReader reader;
+  auto result = reader.readFromJson(pResponse->data());
+  if (!result.value) {
+    std::string errors = CesiumUtility::joinToString(result.errors, "\n - ");
+    if (!errors.empty()) {
+      errors = " Errors:\n - " + errors;
+    }
+    throw std::runtime_error(
+        fmt::format("Error reading Schema from {}.{}", request.url(), errors));
+  }
+
+  return std::make_shared<const Schema>(std::move(*result.value));
+}
+} // namespace
+
 TilesetMetadata::~TilesetMetadata() noexcept {
   if (this->_pLoadingCanceled) {
     *this->_pLoadingCanceled = true;
@@ -28,60 +103,38 @@ SharedFuture<void>& TilesetMetadata::loadSchemaUri(
       this->_pLoadingCanceled.reset();
     }
 
-    if (!this->schemaUri) {
+    // Another tileset may have loaded the same schema already.
+    this->_pSharedSchema =
+        this->schemaUri ? findCachedSchema(*this->schemaUri) : nullptr;
+    if (this->_pSharedSchema) {
+      this->schema = *this->_pSharedSchema;
+    }
+
+    if (!this->schemaUri || this->_pSharedSchema) {
       this->_loadingFuture = asyncSystem.createResolvedFuture().share();
     } else {
       std::shared_ptr<bool> pLoadingCanceled = std::make_shared<bool>(false);
       this->_pLoadingCanceled = pLoadingCanceled;
       this->_loadingFuture =
           pAssetAccessor->get(asyncSystem, *this->schemaUri)
-              .thenInMainThread([pLoadingCanceled, this, asyncSystem](
-                                    std::shared_ptr<IAssetRequest>&& pRequest) {
-                Promise<void> promise = asyncSystem.createPromise<void>();
-
+              .thenInWorkerThread(
+                  [](std::shared_ptr<IAssetRequest>&& pRequest)
+                      -> std::shared_ptr<const Schema> {
+                    return readSchema(*pRequest);
+                  })
+              .thenInMainThread([pLoadingCanceled,
+                                 this,
+                                 schemaUri = *this->schemaUri](
+                                    std::shared_ptr<const Schema>&& pSchema) {
                 if (*pLoadingCanceled) {
-                  promise.reject(std::runtime_error(fmt::format(
+                  throw std::runtime_error(fmt::format(
                       "Loading of schema URI {} was canceled.",
-                      pRequest->url())));
-                  return promise.getFuture();
+                      schemaUri));
                 }
 
-                const IAssetResponse* pResponse = pRequest->response();
-                if (!pResponse) {
-                  promise.reject(std::runtime_error(fmt::format(
-                      "Did not receive a valid response for schema URI {}",
-                      pRequest->url())));
-                  return promise.getFuture();
-                }
-
-                uint16_t statusCode = pResponse->statusCode();
-                if (statusCode != 0 &&
-                    (statusCode < 200 || statusCode >= 300)) {
-                  promise.reject(std::runtime_error(fmt::format(
-                      "Received status code {} for schema URI {}.",
-                      statusCode,
-                      pRequest->url())));
-                  return promise.getFuture();
-                }
-
-                SchemaReader reader;
-                auto result = reader.readFromJson(pResponse->data());
-                if (!result.value) {
-                  std::string errors =
-                      CesiumUtility::joinToString(result.errors, "\n - ");
-                  if (!errors.empty()) {
-                    errors = " Errors:\n - " + errors;
-                  }
-                  promise.reject(std::runtime_error(fmt::format(
-                      "Error reading Schema from {}.{}",
-                      pRequest->url(),
-                      errors)));
-                }
-
-                this->schema = std::move(*result.value);
-
-                promise.resolve();
-                return promise.getFuture();
+                cacheSchema(schemaUri, pSchema);
+                this->schema = *pSchema;
+                this->_pSharedSchema = std::move(pSchema);
               })
               .share();
     }
@@ -4,6 +4,8 @@
 
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 
@@ -24,7 +26,20 @@ namespace Cesium3DTilesSelection {
       viewportSize,
       horizontalFieldOfView,
       verticalFieldOfView,
-      ellipsoid.cartesianToCartographic(position));
+      ellipsoid.cartesianToCartographic(position),
+      direction);
+}
+
+ViewState ViewState::withGazeDirection(const glm::dvec3& gazeDirection) const {
+  return ViewState(
+      this->_position,
+      this->_direction,
+      this->_up,
+      this->_viewportSize,
+      this->_horizontalFieldOfView,
+      this->_verticalFieldOfView,
+      this->_positionCartographic,
+      gazeDirection);
 }
 
 ViewState::ViewState(
@@ -34,10 +49,12 @@ ViewState::ViewState(
     const glm::dvec2& viewportSize,
     double horizontalFieldOfView,
     double verticalFieldOfView,
-    const std::optional<CesiumGeospatial::Cartographic>& positionCartographic)
+    const std::optional<CesiumGeospatial::Cartographic>& positionCartographic,
+    const glm::dvec3& gazeDirection)
     : _position(position),
       _direction(direction),
       _up(up),
+      _gazeDirection(gazeDirection),
       _viewportSize(viewportSize),
       _horizontalFieldOfView(horizontalFieldOfView),
       _verticalFieldOfView(verticalFieldOfView),
@@ -81,6 +98,31 @@ static bool isBoundingVolumeVisible(
   return true;
 }
 
+// Tests the bounding sphere of a volume first, which decides the visibility of
+// the volume too when the sphere is outside a frustum plane or inside all of
+// them. Only a sphere that intersects a plane needs the exact test.
+template <class T>
+static bool isBoundingVolumeVisibleWithSphere(
+    const T& boundingVolume,
+    const BoundingSphere& boundingSphere,
+    const CullingVolume& cullingVolume) noexcept {
+  bool sphereIsInside = true;
+  for (const Plane* pPlane :
+       {&cullingVolume.leftPlane,
+        &cullingVolume.rightPlane,
+        &cullingVolume.topPlane,
+        &cullingVolume.bottomPlane}) {
+    const CullingResult result = boundingSphere.intersectPlane(*pPlane);
+    if (result == CullingResult::Outside) {
+      return false;
+    }
+    sphereIsInside = sphereIsInside && result == CullingResult::Inside;
+  }
+
+  return sphereIsInside ||
+         isBoundingVolumeVisible(boundingVolume, cullingVolume);
+}
+
 bool ViewState::isBoundingVolumeVisible(
     const BoundingVolume& boundingVolume) const noexcept {
   // TODO: use plane masks
@@ -94,8 +136,9 @@ bool ViewState::isBoundingVolumeVisible(
     }
 
     bool operator()(const BoundingRegion& boundingRegion) noexcept {
-      return Cesium3DTilesSelection::isBoundingVolumeVisible(
+      return isBoundingVolumeVisibleWithSphere(
           boundingRegion,
+          boundingRegion.getBoundingSphere(),
           viewState._cullingVolume);
     }
 
@@ -107,14 +150,16 @@ bool ViewState::isBoundingVolumeVisible(
 
     bool operator()(
         const BoundingRegionWithLooseFittingHeights& boundingRegion) noexcept {
-      return Cesium3DTilesSelection::isBoundingVolumeVisible(
+      return isBoundingVolumeVisibleWithSphere(
           boundingRegion.getBoundingRegion(),
+          boundingRegion.getBoundingRegion().getBoundingSphere(),
           viewState._cullingVolume);
     }
 
     bool operator()(const S2CellBoundingVolume& s2Cell) noexcept {
-      return Cesium3DTilesSelection::isBoundingVolumeVisible(
+      return isBoundingVolumeVisibleWithSphere(
           s2Cell,
+          s2Cell.getBoundingSphere(),
           viewState._cullingVolume);
     }
   };
@@ -122,6 +167,43 @@ bool ViewState::isBoundingVolumeVisible(
   return std::visit(Operation{*this}, boundingVolume);
 }
 
+void ViewState::computeBoundingVolumesVisibility(
+    const PackedBoundingVolumes& boundingVolumes,
+    gsl::span<uint8_t> visibility) const {
+  const gsl::span<uint8_t> batchVisibility =
+      visibility.first(boundingVolumes.size());
+  std::fill(batchVisibility.begin(), batchVisibility.end(), uint8_t(1));
+
+  const CullingVolume& cullingVolume = this->_cullingVolume;
+  boundingVolumes.cullAgainstPlane(cullingVolume.leftPlane, batchVisibility);
+  boundingVolumes.cullAgainstPlane(cullingVolume.rightPlane, batchVisibility);
+  boundingVolumes.cullAgainstPlane(cullingVolume.topPlane, batchVisibility);
+  boundingVolumes.cullAgainstPlane(cullingVolume.bottomPlane, batchVisibility);
+}
+
+void ViewState::computeVisibleInstanceRanges(
+    const InstanceGrid& grid,
+    std::vector<InstanceGrid::Range>& ranges) const {
+  ranges.clear();
+  for (const InstanceGrid::Cell& cell : grid.getCells()) {
+    if (!Cesium3DTilesSelection::isBoundingVolumeVisible(
+            cell.boundingBox,
+            this->_cullingVolume)) {
+      continue;
+    }
+
+    // The cells are in the order of their instances, so a visible cell
+    // directly after another extends its range.
+    if (!ranges.empty() &&
+        ranges.back().firstInstance + ranges.back().instanceCount ==
+            cell.instances.firstInstance) {
+      ranges.back().instanceCount += cell.instances.instanceCount;
+    } else {
+      ranges.emplace_back(cell.instances);
+    }
+  }
+}
+
 double ViewState::computeDistanceSquaredToBoundingVolume(
     const BoundingVolume& boundingVolume) const noexcept {
   struct Operation {
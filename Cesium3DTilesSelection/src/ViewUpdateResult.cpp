@@ -0,0 +1,23 @@
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+
+namespace Cesium3DTilesSelection {
+
+std::vector<Tile*> ViewUpdateResult::getTilesToRenderInView(
+    size_t viewIndex,
+    size_t viewCount) const {
+  const size_t tileCount = this->tilesToRenderThisFrame.size();
+  if (viewIndex >= viewCount ||
+      this->tileVisibilityPerView.size() != tileCount * viewCount) {
+    return this->tilesToRenderThisFrame;
+  }
+
+  std::vector<Tile*> tiles;
+  for (size_t i = 0; i < tileCount; ++i) {
+    if (this->tileVisibilityPerView[i * viewCount + viewIndex]) {
+      tiles.emplace_back(this->tilesToRenderThisFrame[i]);
+    }
+  }
+  return tiles;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -7,7 +7,13 @@ void logTileLoadResult(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& url,
     const ErrorList& errorLists) {
-  errorLists.logError(pLogger, fmt::format("Failed to load {}", url));
-  errorLists.logWarning(pLogger, fmt::format("Warning when loading {}", url));
+  // Don't format the prompts for messages that won't be logged.
+  if (!errorLists.errors.empty() && pLogger->should_log(spdlog::level::err)) {
+    errorLists.logError(pLogger, fmt::format("Failed to load {}", url));
+  }
+  if (!errorLists.warnings.empty() &&
+      pLogger->should_log(spdlog::level::warn)) {
+    errorLists.logWarning(pLogger, fmt::format("Warning when loading {}", url));
+  }
 }
 } // namespace Cesium3DTilesSelection
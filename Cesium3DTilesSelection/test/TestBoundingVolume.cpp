@@ -1,8 +1,11 @@
 #include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
 
 #include <catch2/catch.hpp>
 
+#include <optional>
+
 using namespace Cesium3DTilesSelection;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -56,3 +59,30 @@ TEST_CASE("getOrientedBoundingBoxFromBoundingVolume") {
         newObb.getHalfAxes());
   }
 }
+
+TEST_CASE("Tile::getEstimatedGlobeRectangle") {
+  const GlobeRectangle first(0.1, 0.2, 0.3, 0.4);
+  const GlobeRectangle second(-0.4, -0.3, -0.2, -0.1);
+
+  Tile tile(nullptr);
+  tile.setBoundingVolume(BoundingRegion(first, 0.0, 100.0));
+
+  std::optional<GlobeRectangle> estimate = tile.getEstimatedGlobeRectangle();
+  REQUIRE(estimate);
+  CHECK(GlobeRectangle::equals(*estimate, first));
+  CHECK(GlobeRectangle::equals(*tile.getEstimatedGlobeRectangle(), first));
+
+  SECTION("is estimated again when the bounding volume changes") {
+    tile.setBoundingVolume(BoundingRegion(second, 0.0, 100.0));
+    estimate = tile.getEstimatedGlobeRectangle();
+    REQUIRE(estimate);
+    CHECK(GlobeRectangle::equals(*estimate, second));
+  }
+
+  SECTION("is kept when the tile is moved") {
+    Tile moved(std::move(tile));
+    estimate = moved.getEstimatedGlobeRectangle();
+    REQUIRE(estimate);
+    CHECK(GlobeRectangle::equals(*estimate, first));
+  }
+}
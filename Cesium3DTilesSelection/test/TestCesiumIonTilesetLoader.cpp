@@ -0,0 +1,213 @@
+#include "CesiumIonTilesetLoader.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <CesiumAsync/MemoryCacheDatabase.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumNativeTests/waitForFuture.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+
+const std::string ionAssetEndpointUrl = "https://api.example.com/";
+const std::string tilesetUrl = "https://assets.example.com/tileset.json";
+
+// JSON Web Tokens whose payloads expire in 2100 and in 1970.
+const std::time_t laterExpiryTime = 4102444800;
+const std::string tokenExpiringLater =
+    "eyJhbGciOiJIUzI1NiJ9.eyJleHAiOjQxMDI0NDQ4MDB9.signature";
+const std::string expiredToken =
+    "eyJhbGciOiJIUzI1NiJ9.eyJleHAiOjEwMDB9.signature";
+
+std::string getEndpointUrl(int64_t ionAssetID) {
+  return ionAssetEndpointUrl + "v1/assets/" + std::to_string(ionAssetID) +
+         "/endpoint?access_token=token";
+}
+
+std::vector<std::byte> createEndpointResponse(const std::string& accessToken) {
+  const std::string json = R"({"type":"3DTILES","url":")" + tilesetUrl +
+                           R"(","accessToken":")" + accessToken + R"("})";
+  std::vector<std::byte> data(json.size());
+  std::memcpy(data.data(), json.data(), json.size());
+  return data;
+}
+
+std::shared_ptr<SimpleAssetRequest>
+createRequest(const std::string& url, std::vector<std::byte>&& data) {
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "doesn't matter",
+          HttpHeaders{},
+          std::move(data)));
+}
+
+TilesetExternals createExternals(
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>>&& requests,
+    const std::shared_ptr<ICacheDatabase>& pIonEndpointCache) {
+  requests.emplace(
+      tilesetUrl,
+      createRequest(
+          tilesetUrl,
+          readFile(testDataPath / "ReplaceTileset" / "tileset.json")));
+
+  TilesetExternals externals{
+      std::make_shared<SimpleAssetAccessor>(std::move(requests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+  externals.pIonEndpointCache = pIonEndpointCache;
+  return externals;
+}
+
+TilesetContentLoaderResult<CesiumIonTilesetLoader>
+createLoader(TilesetExternals& externals, int64_t ionAssetID) {
+  return waitForFuture(
+      externals.asyncSystem,
+      CesiumIonTilesetLoader::createLoader(
+          externals,
+          TilesetContentOptions{},
+          ionAssetID,
+          "token",
+          ionAssetEndpointUrl,
+          [](const std::string&, const std::string&) {},
+          false));
+}
+} // namespace
+
+TEST_CASE("CesiumIonTilesetLoader caches asset endpoints") {
+  // The endpoints received by one test are shared with the others, so each
+  // one uses its own asset.
+  std::shared_ptr<ICacheDatabase> pCache =
+      std::make_shared<MemoryCacheDatabase>(nullptr);
+
+  SECTION("stores endpoints until their tokens expire") {
+    const int64_t assetID = 1001;
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+    requests.emplace(
+        getEndpointUrl(assetID),
+        createRequest(
+            getEndpointUrl(assetID),
+            createEndpointResponse(tokenExpiringLater)));
+    TilesetExternals externals = createExternals(std::move(requests), pCache);
+
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result =
+        createLoader(externals, assetID);
+    CHECK(!result.errors.hasErrors());
+    CHECK(result.pLoader);
+
+    std::optional<CacheItem> maybeItem =
+        pCache->getEntry(getEndpointUrl(assetID));
+    REQUIRE(maybeItem);
+    CHECK(maybeItem->expiryTime == laterExpiryTime);
+  }
+
+  SECTION("doesn't store endpoints whose tokens aren't known to expire") {
+    const int64_t assetID = 1002;
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+    requests.emplace(
+        getEndpointUrl(assetID),
+        createRequest(
+            getEndpointUrl(assetID),
+            createEndpointResponse("opaque-token")));
+    TilesetExternals externals = createExternals(std::move(requests), pCache);
+
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result =
+        createLoader(externals, assetID);
+    CHECK(!result.errors.hasErrors());
+    CHECK(!pCache->getEntry(getEndpointUrl(assetID)));
+  }
+
+  SECTION("uses endpoints stored by a previous session") {
+    const int64_t assetID = 1003;
+    const std::vector<std::byte> response =
+        createEndpointResponse(tokenExpiringLater);
+    pCache->storeEntry(
+        getEndpointUrl(assetID),
+        laterExpiryTime,
+        getEndpointUrl(assetID),
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{},
+        response);
+
+    // There's no response for the endpoint, so the test fails if it's
+    // requested.
+    TilesetExternals externals = createExternals({}, pCache);
+
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result =
+        createLoader(externals, assetID);
+    CHECK(!result.errors.hasErrors());
+    CHECK(result.pLoader);
+  }
+
+  SECTION("requests endpoints whose stored tokens have expired") {
+    const int64_t assetID = 1004;
+    const std::vector<std::byte> expiredResponse =
+        createEndpointResponse(expiredToken);
+    pCache->storeEntry(
+        getEndpointUrl(assetID),
+        std::time(nullptr) + 60,
+        getEndpointUrl(assetID),
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{},
+        expiredResponse);
+
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+    requests.emplace(
+        getEndpointUrl(assetID),
+        createRequest(
+            getEndpointUrl(assetID),
+            createEndpointResponse(tokenExpiringLater)));
+    TilesetExternals externals = createExternals(std::move(requests), pCache);
+
+    TilesetContentLoaderResult<CesiumIonTilesetLoader> result =
+        createLoader(externals, assetID);
+    CHECK(!result.errors.hasErrors());
+
+    std::optional<CacheItem> maybeItem =
+        pCache->getEntry(getEndpointUrl(assetID));
+    REQUIRE(maybeItem);
+    CHECK(maybeItem->expiryTime == laterExpiryTime);
+  }
+
+  SECTION("shares endpoints between tilesets in the same session") {
+    const int64_t assetID = 1005;
+    std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+    requests.emplace(
+        getEndpointUrl(assetID),
+        createRequest(
+            getEndpointUrl(assetID),
+            createEndpointResponse(tokenExpiringLater)));
+    TilesetExternals first = createExternals(std::move(requests), nullptr);
+    CHECK(!createLoader(first, assetID).errors.hasErrors());
+
+    // There's no response for the endpoint this time.
+    TilesetExternals second = createExternals({}, nullptr);
+    CHECK(!createLoader(second, assetID).errors.hasErrors());
+  }
+}
@@ -0,0 +1,134 @@
+#include "CombinedViewState.h"
+
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/exponential.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumUtility;
+
+namespace {
+
+ViewState createView(const glm::dvec3& position, const glm::dvec3& direction) {
+  return ViewState::create(
+      position,
+      direction,
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(800.0, 600.0),
+      Math::degreesToRadians(90.0),
+      Math::degreesToRadians(60.0));
+}
+
+// Two views ten meters to either side of the origin, looking along +Y.
+std::vector<ViewState> createEyes() {
+  return {
+      createView(glm::dvec3(-10.0, 0.0, 0.0), glm::dvec3(0.0, 1.0, 0.0)),
+      createView(glm::dvec3(10.0, 0.0, 0.0), glm::dvec3(0.0, 1.0, 0.0))};
+}
+
+double computeDistance(
+    const ViewState& view,
+    const BoundingVolume& boundingVolume) {
+  return glm::sqrt(view.computeDistanceSquaredToBoundingVolume(boundingVolume));
+}
+
+} // namespace
+
+TEST_CASE("CombinedViewState") {
+  SECTION("is not created for fewer than two views") {
+    CHECK(!CombinedViewState::create({}));
+    CHECK(!CombinedViewState::create(
+        {createView(glm::dvec3(0.0), glm::dvec3(0.0, 1.0, 0.0))}));
+  }
+
+  SECTION("is not created for views that face in opposite directions") {
+    CHECK(!CombinedViewState::create(
+        {createView(glm::dvec3(0.0), glm::dvec3(0.0, 1.0, 0.0)),
+         createView(glm::dvec3(0.0), glm::dvec3(0.0, -1.0, 0.0))}));
+  }
+
+  SECTION("contains the frustum of every view") {
+    const std::vector<ViewState> eyes = createEyes();
+    std::optional<CombinedViewState> maybeCombined =
+        CombinedViewState::create(eyes);
+    REQUIRE(maybeCombined);
+
+    // Visible from the left view only.
+    const BoundingVolume leftOnly =
+        BoundingSphere(glm::dvec3(-19.5, 10.0, 0.0), 0.1);
+    REQUIRE(eyes[0].isBoundingVolumeVisible(leftOnly));
+    REQUIRE(!eyes[1].isBoundingVolumeVisible(leftOnly));
+    CHECK(maybeCombined->isBoundingVolumeVisible(leftOnly));
+
+    // Behind both views.
+    const BoundingVolume behind =
+        BoundingSphere(glm::dvec3(0.0, -50.0, 0.0), 1.0);
+    CHECK(!maybeCombined->isBoundingVolumeVisible(behind));
+
+    // A fan of spheres around the views.
+    for (int32_t x = -40; x <= 40; x += 2) {
+      for (int32_t y = -10; y <= 40; y += 2) {
+        for (int32_t z = -30; z <= 30; z += 5) {
+          const BoundingVolume sphere =
+              BoundingSphere(glm::dvec3(double(x), double(y), double(z)), 0.5);
+          if (eyes[0].isBoundingVolumeVisible(sphere) ||
+              eyes[1].isBoundingVolumeVisible(sphere)) {
+            CHECK(maybeCombined->isBoundingVolumeVisible(sphere));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("estimates the distance to far tiles") {
+    const std::vector<ViewState> eyes = createEyes();
+    std::optional<CombinedViewState> maybeCombined =
+        CombinedViewState::create(eyes);
+    REQUIRE(maybeCombined);
+
+    std::array<double, 2> distances{};
+
+    const BoundingVolume farSphere =
+        BoundingSphere(glm::dvec3(0.0, 10000.0, 0.0), 1.0);
+    REQUIRE(maybeCombined->computeDistances(farSphere, distances));
+    for (size_t i = 0; i < eyes.size(); ++i) {
+      const double actual = computeDistance(eyes[i], farSphere);
+      CHECK(distances[i] <= actual);
+      CHECK(
+          distances[i] >=
+          actual * (1.0 - CombinedViewState::maximumRelativeSpread));
+    }
+
+    // Too close, compared with the distance between the views.
+    const BoundingVolume nearSphere =
+        BoundingSphere(glm::dvec3(0.0, 100.0, 0.0), 1.0);
+    CHECK(!maybeCombined->computeDistances(nearSphere, distances));
+  }
+
+  SECTION("computes exact distances for views at the same position") {
+    const std::vector<ViewState> views{
+        createView(glm::dvec3(0.0), glm::dvec3(0.0, 1.0, 0.0)),
+        createView(glm::dvec3(0.0), glm::normalize(glm::dvec3(1.0, 1.0, 0.0)))};
+    std::optional<CombinedViewState> maybeCombined =
+        CombinedViewState::create(views);
+    REQUIRE(maybeCombined);
+
+    std::array<double, 2> distances{};
+    const BoundingVolume nearSphere =
+        BoundingSphere(glm::dvec3(0.0, 5.0, 0.0), 1.0);
+    REQUIRE(maybeCombined->computeDistances(nearSphere, distances));
+    CHECK(distances[0] == Approx(4.0));
+    CHECK(distances[1] == Approx(4.0));
+  }
+}
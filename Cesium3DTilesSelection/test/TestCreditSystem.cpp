@@ -146,3 +146,36 @@ TEST_CASE("Test setting showOnScreen on credits") {
   CHECK(creditSystem.shouldBeShownOnScreen(credit1) == true);
   CHECK(creditSystem.shouldBeShownOnScreen(credit2) == true);
 }
+
+TEST_CASE("Test credits added after querying the credits to no longer show") {
+
+  CreditSystem creditSystem;
+
+  std::vector<Credit> credits;
+  for (int i = 0; i < 100; i++) {
+    credits.push_back(creditSystem.createCredit(
+        "<html>Credit" + std::to_string(i) + "</html>"));
+  }
+
+  // Creating a credit again returns the existing one.
+  REQUIRE(creditSystem.createCredit("<html>Credit42</html>") == credits[42]);
+
+  for (const Credit& credit : credits) {
+    creditSystem.addCreditToFrame(credit);
+  }
+
+  creditSystem.startNextFrame();
+
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame().size() == 100);
+
+  // Add back every credit but the first and the last.
+  for (size_t i = 1; i < 99; i++) {
+    creditSystem.addCreditToFrame(credits[i]);
+    if (i == 50) {
+      REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame().size() == 50);
+    }
+  }
+
+  std::vector<Credit> expectedHide{credits[0], credits[99]};
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame() == expectedHide);
+}
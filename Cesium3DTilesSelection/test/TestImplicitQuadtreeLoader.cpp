@@ -540,3 +540,147 @@ TEST_CASE("Test tile subdivision for implicit quadtree loader") {
     CHECK(box_1_1_1.getCellID().toToken() == "14");
   }
 }
+
+TEST_CASE("Test unloading the subtrees of implicit quadtree loader") {
+  OrientedBoundingBox loaderBoundingVolume{glm::dvec3(0.0), glm::dmat3(20.0)};
+  ImplicitQuadtreeLoader loader{
+      "tileset.json",
+      "content/{level}.{x}.{y}.b3dm",
+      "subtrees/{level}.{x}.{y}.json",
+      2,
+      4,
+      loaderBoundingVolume};
+
+  CHECK(loader.getLoaderDataBytes() == 0);
+
+  loader.addSubtreeAvailability(
+      QuadtreeTileID{0, 0, 0},
+      SubtreeAvailability{
+          ImplicitTileSubdivisionScheme::Quadtree,
+          2,
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          {SubtreeAvailability::SubtreeConstantAvailability{true}},
+          {}});
+
+  const int64_t subtreeBytes = loader.getLoaderDataBytes();
+  CHECK(subtreeBytes > 0);
+
+  Tile tile(&loader);
+  tile.setTileID(QuadtreeTileID(0, 0, 0));
+  tile.setBoundingVolume(loaderBoundingVolume);
+
+  auto tileChildrenResult = loader.createTileChildren(tile);
+  REQUIRE(tileChildrenResult.state == TileLoadResultState::Success);
+  REQUIRE(tileChildrenResult.children.size() == 4);
+
+  // the children of the root still need the subtree to create their own
+  // children, so it isn't unloaded even once it's no longer recently used
+  loader.unloadLoaderData(0);
+  loader.unloadLoaderData(0);
+  CHECK(loader.getLoaderDataBytes() == subtreeBytes);
+
+  for (const Tile& child : tileChildrenResult.children) {
+    auto grandchildrenResult = loader.createTileChildren(child);
+    CHECK(grandchildrenResult.state == TileLoadResultState::Success);
+    CHECK(grandchildrenResult.children.size() == 4);
+  }
+
+  // the subtree used since the previous unload is kept
+  loader.unloadLoaderData(0);
+  CHECK(loader.getLoaderDataBytes() == subtreeBytes);
+
+  // the subtree is no longer needed
+  loader.unloadLoaderData(0);
+  CHECK(loader.getLoaderDataBytes() == 0);
+}
+
+TEST_CASE("Test prefetching the child subtrees of implicit quadtree loader") {
+  auto pMockedAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{});
+
+  std::vector<std::byte> subtreeData =
+      readFile(testDataPath / "ImplicitTileset" / "subtrees" / "0.0.0.json");
+  for (const std::string& url :
+       {"subtrees/2.0.0.json",
+        "subtrees/2.1.0.json",
+        "subtrees/2.0.1.json",
+        "subtrees/2.1.1.json"}) {
+    auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
+        static_cast<uint16_t>(200),
+        "doesn't matter",
+        CesiumAsync::HttpHeaders{},
+        subtreeData);
+    pMockedAssetAccessor->mockCompletedRequests.insert(
+        {url,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             "doesn't matter",
+             CesiumAsync::HttpHeaders{},
+             std::move(pMockCompletedResponse))});
+  }
+
+  CesiumAsync::AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  OrientedBoundingBox loaderBoundingVolume{glm::dvec3(0.0), glm::dmat3(20.0)};
+  ImplicitQuadtreeLoader loader{
+      "tileset.json",
+      "content/{level}.{x}.{y}.b3dm",
+      "subtrees/{level}.{x}.{y}.json",
+      2,
+      4,
+      loaderBoundingVolume};
+
+  loader.addSubtreeAvailability(
+      QuadtreeTileID{0, 0, 0},
+      SubtreeAvailability{
+          ImplicitTileSubdivisionScheme::Quadtree,
+          2,
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          {SubtreeAvailability::SubtreeConstantAvailability{true}},
+          {}});
+  const int64_t rootSubtreeBytes = loader.getLoaderDataBytes();
+
+  auto prefetch = [&](const QuadtreeTileID& tileID, size_t maximumLoads) {
+    Tile tile(&loader);
+    tile.setTileID(tileID);
+    TileLoadInput loadInput{
+        tile,
+        {},
+        asyncSystem,
+        pMockedAssetAccessor,
+        spdlog::default_logger(),
+        {}};
+    return loader.prefetchTileChildren(loadInput, maximumLoads);
+  };
+
+  SECTION("Prefetch nothing for tiles above the last level of a subtree") {
+    CHECK(prefetch(QuadtreeTileID{0, 0, 0}, 8).empty());
+    CHECK(loader.getLoaderDataBytes() == rootSubtreeBytes);
+  }
+
+  SECTION("Prefetch the child subtrees of a tile on the last level") {
+    std::vector<CesiumAsync::Future<void>> loads =
+        prefetch(QuadtreeTileID{1, 0, 0}, 3);
+    CHECK(loads.size() == 3);
+
+    // the subtrees that are being loaded aren't loaded again
+    CHECK(prefetch(QuadtreeTileID{1, 0, 0}, 8).size() == 1);
+
+    asyncSystem.dispatchMainThreadTasks();
+    for (CesiumAsync::Future<void>& load : loads) {
+      load.wait();
+    }
+
+    CHECK(loader.getLoaderDataBytes() > rootSubtreeBytes);
+
+    // once loaded, the child tiles don't need to load their subtrees
+    Tile child(&loader);
+    child.setTileID(QuadtreeTileID{2, 0, 0});
+    auto tileChildrenResult = loader.createTileChildren(child);
+    CHECK(tileChildrenResult.state == TileLoadResultState::Success);
+
+    CHECK(prefetch(QuadtreeTileID{1, 0, 0}, 8).empty());
+  }
+}
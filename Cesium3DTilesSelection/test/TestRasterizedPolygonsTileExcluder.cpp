@@ -0,0 +1,115 @@
+#include <Cesium3DTilesSelection/RasterizedPolygonsTileExcluder.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumRasterOverlays/RasterizedPolygonsOverlay.h>
+#include <CesiumUtility/IntrusivePointer.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+// A one-degree square with its south-west corner at the given position.
+CartographicPolygon createSquare(double west, double south) {
+  return CartographicPolygon(std::vector<glm::dvec2>{
+      glm::dvec2(
+          Math::degreesToRadians(west),
+          Math::degreesToRadians(south)),
+      glm::dvec2(
+          Math::degreesToRadians(west + 1.0),
+          Math::degreesToRadians(south)),
+      glm::dvec2(
+          Math::degreesToRadians(west + 1.0),
+          Math::degreesToRadians(south + 1.0)),
+      glm::dvec2(
+          Math::degreesToRadians(west),
+          Math::degreesToRadians(south + 1.0))});
+}
+
+RasterizedPolygonsTileExcluder createExcluder(bool invertSelection) {
+  // A row of squares, one every ten degrees of longitude.
+  std::vector<CartographicPolygon> polygons;
+  for (int32_t i = 0; i < 20; ++i) {
+    polygons.emplace_back(createSquare(double(i) * 10.0, 0.0));
+  }
+
+  IntrusivePointer<const RasterizedPolygonsOverlay> pOverlay =
+      new RasterizedPolygonsOverlay(
+          "Test",
+          polygons,
+          invertSelection,
+          Ellipsoid::WGS84,
+          GeographicProjection());
+  return RasterizedPolygonsTileExcluder(pOverlay);
+}
+
+TileExclusionResult checkRectangle(
+    const RasterizedPolygonsTileExcluder& excluder,
+    const GlobeRectangle& rectangle) {
+  Tile tile(nullptr);
+  tile.setBoundingVolume(BoundingRegion(rectangle, 0.0, 100.0));
+
+  const TileExclusionResult result = excluder.checkExclusion(tile);
+  CHECK(
+      excluder.shouldExclude(tile) ==
+      (result == TileExclusionResult::Excluded));
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("RasterizedPolygonsTileExcluder") {
+  const GlobeRectangle insideSquare =
+      GlobeRectangle::fromDegrees(50.25, 0.25, 50.75, 0.75);
+  const GlobeRectangle acrossSquare =
+      GlobeRectangle::fromDegrees(50.5, 0.5, 51.5, 1.5);
+  const GlobeRectangle betweenSquares =
+      GlobeRectangle::fromDegrees(53.0, 0.0, 57.0, 1.0);
+  const GlobeRectangle awayFromSquares =
+      GlobeRectangle::fromDegrees(-60.0, 30.0, -50.0, 40.0);
+
+  SECTION("excludes tiles inside of a polygon") {
+    const RasterizedPolygonsTileExcluder excluder = createExcluder(false);
+    CHECK(
+        checkRectangle(excluder, insideSquare) ==
+        TileExclusionResult::Excluded);
+    CHECK(
+        checkRectangle(excluder, acrossSquare) ==
+        TileExclusionResult::Included);
+    CHECK(
+        checkRectangle(excluder, betweenSquares) ==
+        TileExclusionResult::SubtreeIncluded);
+    CHECK(
+        checkRectangle(excluder, awayFromSquares) ==
+        TileExclusionResult::SubtreeIncluded);
+  }
+
+  SECTION("excludes tiles outside of every polygon when inverted") {
+    const RasterizedPolygonsTileExcluder excluder = createExcluder(true);
+    CHECK(
+        checkRectangle(excluder, insideSquare) ==
+        TileExclusionResult::SubtreeIncluded);
+    CHECK(
+        checkRectangle(excluder, acrossSquare) ==
+        TileExclusionResult::Included);
+    CHECK(
+        checkRectangle(excluder, betweenSquares) ==
+        TileExclusionResult::Excluded);
+    CHECK(
+        checkRectangle(excluder, awayFromSquares) ==
+        TileExclusionResult::Excluded);
+  }
+}
@@ -0,0 +1,155 @@
+#include "Cesium3DTilesSelection/SoftwareTileOcclusionProxyPool.h"
+#include "MockTilesetContentManager.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+// A square facing the camera, 100 meters in front of it and 40 meters wide.
+// The glTF y-up to z-up transform leaves it unchanged.
+Model createSquareModel() {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(100.0f, -20.0f, -20.0f),
+      glm::vec3(100.0f, 20.0f, -20.0f),
+      glm::vec3(100.0f, 20.0f, 20.0f),
+      glm::vec3(100.0f, -20.0f, -20.0f),
+      glm::vec3(100.0f, 20.0f, 20.0f),
+      glm::vec3(100.0f, -20.0f, 20.0f)};
+
+  Model model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength =
+      static_cast<int64_t>(positions.size() * sizeof(glm::vec3));
+  buffer.cesium.data.resize(static_cast<size_t>(buffer.byteLength));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      positions.data(),
+      static_cast<size_t>(buffer.byteLength));
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.count = int64_t(positions.size());
+  accessor.type = Accessor::Type::VEC3;
+
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.attributes["POSITION"] = 0;
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = 0;
+
+  return model;
+}
+
+ViewState createViewState() {
+  return ViewState::create(
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(1024.0, 512.0),
+      Math::OnePi / 3.0,
+      Math::OnePi / 4.0);
+}
+} // namespace
+
+TEST_CASE("SoftwareTileOcclusionProxyPool") {
+  Tile occluder(nullptr);
+  occluder.setBoundingVolume(BoundingSphere(glm::dvec3(100.0, 0.0, 0.0), 30.0));
+  occluder.setGeometricError(1.0);
+  occluder.getContent().setContentKind(
+      std::make_unique<TileRenderContent>(createSquareModel()));
+  MockTilesetContentManagerTestFixture::setTileLoadState(
+      occluder,
+      TileLoadState::Done);
+
+  Tile behind(nullptr);
+  behind.setBoundingVolume(BoundingSphere(glm::dvec3(1000.0, 0.0, 0.0), 10.0));
+
+  Tile inFront(nullptr);
+  inFront.setBoundingVolume(BoundingSphere(glm::dvec3(50.0, 0.0, 0.0), 5.0));
+
+  Tile besideIt(nullptr);
+  besideIt.setBoundingVolume(
+      BoundingSphere(glm::dvec3(1000.0, 400.0, 0.0), 10.0));
+
+  SoftwareTileOcclusionProxyPool pool(10);
+  const std::vector<Tile*> rendered{&occluder};
+
+  SECTION("nothing is occluded before the first frame") {
+    CHECK(
+        pool.computeOcclusionState(behind) == TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("occludes the tiles behind the rendered tiles") {
+    pool.startNewFrame({createViewState()}, rendered);
+
+    CHECK(pool.computeOcclusionState(behind) == TileOcclusionState::Occluded);
+    CHECK(
+        pool.computeOcclusionState(inFront) == TileOcclusionState::NotOccluded);
+    CHECK(
+        pool.computeOcclusionState(besideIt) ==
+        TileOcclusionState::NotOccluded);
+
+    // A tile doesn't occlude itself.
+    CHECK(
+        pool.computeOcclusionState(occluder) ==
+        TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("reports the occlusion state through its proxies") {
+    pool.startNewFrame({createViewState()}, rendered);
+
+    const TileOcclusionRendererProxy* pProxy =
+        pool.fetchOcclusionProxyForTile(behind, 0);
+    REQUIRE(pProxy);
+    CHECK(pProxy->getOcclusionState() == TileOcclusionState::Occluded);
+
+    // The state is updated by the next frame.
+    pool.startNewFrame({createViewState()}, {});
+    CHECK(pProxy->getOcclusionState() == TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("a tile must be occluded in every frustum") {
+    const ViewState behindTheBackTile = ViewState::create(
+        glm::dvec3(2000.0, 0.0, 0.0),
+        glm::dvec3(-1.0, 0.0, 0.0),
+        glm::dvec3(0.0, 0.0, 1.0),
+        glm::dvec2(1024.0, 512.0),
+        Math::OnePi / 3.0,
+        Math::OnePi / 4.0);
+    pool.startNewFrame({createViewState(), behindTheBackTile}, rendered);
+
+    CHECK(
+        pool.computeOcclusionState(behind) == TileOcclusionState::NotOccluded);
+  }
+
+  SECTION("doesn't rasterize more than the maximum number of triangles") {
+    SoftwareTileOcclusionProxyPool limitedPool(10, 128, 64, 0);
+    limitedPool.startNewFrame({createViewState()}, rendered);
+
+    CHECK(
+        limitedPool.computeOcclusionState(behind) ==
+        TileOcclusionState::NotOccluded);
+  }
+}
@@ -0,0 +1,106 @@
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileBoundsBuffer.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+TEST_CASE("TileBoundsBuffer") {
+  const glm::dvec3 center(6378137.0, 0.0, 0.0);
+
+  Tile root(nullptr);
+  root.setBoundingVolume(BoundingSphere(center, 100.0));
+  root.setGeometricError(64.0);
+
+  std::vector<Tile> children;
+  children.emplace_back(nullptr);
+  children.emplace_back(nullptr);
+  root.createChildTiles(std::move(children));
+
+  Tile& left = root.getChildren()[0];
+  left.setBoundingVolume(OrientedBoundingBox(
+      center + glm::dvec3(0.0, -50.0, 0.0),
+      glm::dmat3(
+          glm::dvec3(10.0, 0.0, 0.0),
+          glm::dvec3(0.0, 20.0, 0.0),
+          glm::dvec3(0.0, 0.0, 30.0))));
+  left.setGeometricError(32.0);
+
+  Tile& right = root.getChildren()[1];
+  right.setBoundingVolume(
+      BoundingSphere(center + glm::dvec3(0.0, 50.0, 0.0), 50.0));
+  right.setGeometricError(32.0);
+
+  TileBoundsBuffer buffer(center);
+
+  SECTION("writes the bounds relative to the center") {
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+
+    REQUIRE(buffer.getTileCount() == 3);
+    CHECK(buffer.getChangedSlots() == std::vector<uint32_t>{0, 1, 2});
+    CHECK(buffer.getTiles() == std::vector<const Tile*>{&root, &left, &right});
+
+    const TileBounds& rootBounds = buffer.getBounds()[0];
+    CHECK(rootBounds.center == glm::vec3(0.0f));
+    CHECK(rootBounds.radius == 100.0f);
+    CHECK(rootBounds.halfAxisX == glm::vec3(100.0f, 0.0f, 0.0f));
+    CHECK(rootBounds.geometricError == 64.0f);
+    CHECK(rootBounds.parentIndex == -1);
+    CHECK(rootBounds.occupied == 1);
+
+    const TileBounds& leftBounds = buffer.getBounds()[1];
+    CHECK(leftBounds.center == glm::vec3(0.0f, -50.0f, 0.0f));
+    CHECK(leftBounds.radius == Approx(glm::length(glm::dvec3(10, 20, 30))));
+    CHECK(leftBounds.halfAxisX == glm::vec3(10.0f, 0.0f, 0.0f));
+    CHECK(leftBounds.halfAxisY == glm::vec3(0.0f, 20.0f, 0.0f));
+    CHECK(leftBounds.halfAxisZ == glm::vec3(0.0f, 0.0f, 30.0f));
+    CHECK(leftBounds.geometricError == 32.0f);
+    CHECK(leftBounds.parentIndex == 0);
+
+    CHECK(buffer.getBounds()[2].parentIndex == 0);
+  }
+
+  SECTION("reports only the slots that changed") {
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+    CHECK(buffer.getChangedSlots().empty());
+
+    right.setGeometricError(16.0);
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+    CHECK(buffer.getChangedSlots() == std::vector<uint32_t>{2});
+    CHECK(buffer.getBounds()[2].geometricError == 16.0f);
+  }
+
+  SECTION("reuses the slots of removed tiles and updates parent slots") {
+    buffer.update(std::vector<const Tile*>{&root, &left});
+
+    // Removing the root frees its slot and leaves the left child without a
+    // parent in the buffer.
+    buffer.update(std::vector<const Tile*>{&left});
+    CHECK(buffer.getTileCount() == 1);
+    CHECK(buffer.getChangedSlots() == std::vector<uint32_t>{0, 1});
+    CHECK(buffer.getTiles()[0] == nullptr);
+    CHECK(buffer.getBounds()[0].occupied == 0);
+    CHECK(buffer.getBounds()[1].parentIndex == -1);
+
+    buffer.update(std::vector<const Tile*>{&left, &right});
+    CHECK(buffer.getBounds().size() == 2);
+    CHECK(buffer.getTiles()[0] == &right);
+    CHECK(buffer.getChangedSlots() == std::vector<uint32_t>{0});
+    CHECK(buffer.getBounds()[0].occupied == 1);
+  }
+
+  SECTION("rewrites every slot when the center changes") {
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+    buffer.setCenter(center + glm::dvec3(0.0, 0.0, 10.0));
+    buffer.update(std::vector<const Tile*>{&root, &left, &right});
+    CHECK(buffer.getChangedSlots() == std::vector<uint32_t>{0, 1, 2});
+    CHECK(buffer.getBounds()[0].center == glm::vec3(0.0f, 0.0f, -10.0f));
+  }
+}
@@ -0,0 +1,96 @@
+#include "TileChildrenPool.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+void createChildren(TileChildrenPool& pool, Tile& parent, size_t count) {
+  std::vector<Tile> children = pool.acquire(count);
+  for (size_t i = 0; i < count; ++i) {
+    children.emplace_back(nullptr);
+  }
+  pool.createChildTiles(parent, std::move(children));
+}
+} // namespace
+
+TEST_CASE("TileChildrenPool") {
+  TileChildrenPool pool;
+
+  SECTION("allocates blocks for 4 and 8 children") {
+    CHECK(pool.acquire(3).capacity() == 4);
+    CHECK(pool.acquire(4).capacity() == 4);
+    CHECK(pool.acquire(5).capacity() == 8);
+    CHECK(pool.acquire(20).capacity() >= 20);
+    CHECK(pool.getPooledBlockCount() == 0);
+  }
+
+  SECTION("recycles the blocks of released descendants") {
+    Tile root(nullptr);
+    createChildren(pool, root, 4);
+    createChildren(pool, root.getChildren()[0], 8);
+    createChildren(pool, root.getChildren()[1], 4);
+    createChildren(pool, root.getChildren()[0].getChildren()[2], 20);
+
+    const Tile* pFourBlock = root.getChildren().data();
+    const Tile* pEightBlock = root.getChildren()[0].getChildren().data();
+
+    pool.releaseChildTiles(root);
+    CHECK(root.getChildren().empty());
+    CHECK(pool.getPooledBlockCount() == 3);
+
+    Tile other(nullptr);
+    createChildren(pool, other, 6);
+    CHECK(other.getChildren().data() == pEightBlock);
+    CHECK(pool.getPooledBlockCount() == 2);
+
+    std::vector<Tile> block = pool.acquire(4);
+    CHECK(block.empty());
+    CHECK(block.data() == pFourBlock);
+    CHECK(pool.getPooledBlockCount() == 1);
+  }
+
+  SECTION("moves other children to a recycled block") {
+    Tile first(nullptr);
+    createChildren(pool, first, 8);
+    const Tile* pBlock = first.getChildren().data();
+    pool.releaseChildTiles(first);
+    REQUIRE(pool.getPooledBlockCount() == 1);
+
+    std::vector<Tile> children;
+    children.reserve(7);
+    for (size_t i = 0; i < 7; ++i) {
+      children.emplace_back(nullptr);
+    }
+    createChildren(pool, children[3], 2);
+
+    Tile parent(nullptr);
+    pool.createChildTiles(parent, std::move(children));
+    REQUIRE(parent.getChildren().size() == 7);
+    CHECK(parent.getChildren().data() == pBlock);
+    CHECK(pool.getPooledBlockCount() == 0);
+
+    for (const Tile& child : parent.getChildren()) {
+      CHECK(child.getParent() == &parent);
+    }
+
+    const Tile& movedChild = parent.getChildren()[3];
+    REQUIRE(movedChild.getChildren().size() == 2);
+    CHECK(movedChild.getChildren()[0].getParent() == &movedChild);
+  }
+
+  SECTION("keeps at most the maximum number of blocks") {
+    TileChildrenPool smallPool(1);
+    Tile root(nullptr);
+    createChildren(smallPool, root, 4);
+    createChildren(smallPool, root.getChildren()[0], 4);
+    createChildren(smallPool, root.getChildren()[1], 4);
+
+    smallPool.releaseChildTiles(root);
+    CHECK(smallPool.getPooledBlockCount() == 1);
+  }
+}
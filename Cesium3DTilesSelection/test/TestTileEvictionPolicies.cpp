@@ -0,0 +1,93 @@
+#include <Cesium3DTilesSelection/CostAwareTileEvictionPolicy.h>
+#include <Cesium3DTilesSelection/LruTileEvictionPolicy.h>
+#include <Cesium3DTilesSelection/ScreenSpaceErrorTileEvictionPolicy.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumUtility;
+
+namespace {
+ViewState createViewState() {
+  return ViewState::create(
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(1024.0, 768.0),
+      Math::OnePi / 3.0,
+      Math::OnePi / 4.0);
+}
+} // namespace
+
+TEST_CASE("LruTileEvictionPolicy keeps the least-recently-used order") {
+  Tile a(nullptr), b(nullptr), c(nullptr);
+  std::vector<Tile*> candidates{&a, &b, &c};
+
+  LruTileEvictionPolicy policy;
+  policy.orderForEviction(candidates, {createViewState()});
+
+  CHECK(candidates == std::vector<Tile*>{&a, &b, &c});
+}
+
+TEST_CASE("CostAwareTileEvictionPolicy evicts cheap tiles first") {
+  Tile a(nullptr), b(nullptr), c(nullptr), d(nullptr);
+  std::map<const Tile*, double> costs{
+      {&a, 3.0},
+      {&b, 1.0},
+      {&c, 2.0},
+      {&d, 1.0}};
+
+  CostAwareTileEvictionPolicy policy(
+      [&costs](const Tile& tile) { return costs[&tile]; });
+
+  std::vector<Tile*> candidates{&a, &b, &c, &d};
+  policy.orderForEviction(candidates, {});
+
+  // Ties stay in least-recently-used order.
+  CHECK(candidates == std::vector<Tile*>{&b, &d, &c, &a});
+}
+
+TEST_CASE("CostAwareTileEvictionPolicy defaults to the last load duration") {
+  // None of these tiles has been loaded, so all costs are equal.
+  Tile a(nullptr), b(nullptr);
+  std::vector<Tile*> candidates{&a, &b};
+
+  CostAwareTileEvictionPolicy policy;
+  policy.orderForEviction(candidates, {});
+
+  CHECK(a.getLastLoadDuration() == 0.0);
+  CHECK(candidates == std::vector<Tile*>{&a, &b});
+}
+
+TEST_CASE("ScreenSpaceErrorTileEvictionPolicy evicts distant tiles first") {
+  Tile nearTile(nullptr), middleTile(nullptr), farTile(nullptr);
+  nearTile.setBoundingVolume(BoundingSphere(glm::dvec3(1.0e2, 0.0, 0.0), 1.0));
+  middleTile.setBoundingVolume(
+      BoundingSphere(glm::dvec3(1.0e3, 0.0, 0.0), 1.0));
+  farTile.setBoundingVolume(BoundingSphere(glm::dvec3(1.0e4, 0.0, 0.0), 1.0));
+  for (Tile* pTile : {&nearTile, &middleTile, &farTile}) {
+    pTile->setGeometricError(10.0);
+  }
+
+  ScreenSpaceErrorTileEvictionPolicy policy;
+
+  SECTION("with a view") {
+    std::vector<Tile*> candidates{&nearTile, &farTile, &middleTile};
+    policy.orderForEviction(candidates, {createViewState()});
+    CHECK(candidates == std::vector<Tile*>{&farTile, &middleTile, &nearTile});
+  }
+
+  SECTION("without a view, the order is unchanged") {
+    std::vector<Tile*> candidates{&nearTile, &farTile, &middleTile};
+    policy.orderForEviction(candidates, {});
+    CHECK(candidates == std::vector<Tile*>{&nearTile, &farTile, &middleTile});
+  }
+}
@@ -0,0 +1,70 @@
+#include <Cesium3DTilesSelection/TileLoadStatistics.h>
+
+#include <catch2/catch.hpp>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("TileLoadStageHistogram") {
+  TileLoadStageHistogram histogram;
+
+  SECTION("is empty at first") {
+    CHECK(histogram.count == 0);
+    CHECK(histogram.estimatePercentile(50.0) == 0.0);
+  }
+
+  SECTION("counts each duration in its bucket") {
+    histogram.add(0.5);
+    histogram.add(1.0);
+    histogram.add(3.0);
+    histogram.add(20000.0);
+    histogram.add(-1.0);
+
+    CHECK(histogram.count == 5);
+    CHECK(histogram.bucketCounts[0] == 3);
+    CHECK(histogram.bucketCounts[2] == 1);
+    CHECK(histogram.bucketCounts.back() == 1);
+    CHECK(histogram.totalMilliseconds == Approx(20004.5));
+    CHECK(histogram.maximumMilliseconds == 20000.0);
+  }
+
+  SECTION("estimates percentiles within the buckets") {
+    for (int i = 0; i < 10; ++i) {
+      histogram.add(15.0);
+    }
+    for (int i = 0; i < 10; ++i) {
+      histogram.add(150.0);
+    }
+
+    // Half of the durations are in the (10, 20] bucket.
+    CHECK(histogram.estimatePercentile(25.0) == Approx(15.0));
+    CHECK(histogram.estimatePercentile(50.0) == Approx(20.0));
+
+    // The other half are in the (100, 200] bucket, which is bounded by the
+    // longest duration.
+    CHECK(histogram.estimatePercentile(75.0) == Approx(125.0));
+    CHECK(histogram.estimatePercentile(100.0) == Approx(150.0));
+  }
+}
+
+TEST_CASE("TileLoadStatistics") {
+  TileLoadStatistics statistics;
+  CHECK(!statistics.getHistogram("b3dm", TileLoadStage::Load));
+
+  statistics.add("b3dm", TileLoadStage::Load, 10.0);
+  statistics.add("b3dm", TileLoadStage::Load, 30.0);
+  statistics.add("glb", TileLoadStage::Total, 5.0);
+
+  const TileLoadStageHistogram* pLoad =
+      statistics.getHistogram("b3dm", TileLoadStage::Load);
+  REQUIRE(pLoad);
+  CHECK(pLoad->count == 2);
+  CHECK(pLoad->totalMilliseconds == 40.0);
+
+  const TileLoadStageHistogram* pTotal =
+      statistics.getHistogram("b3dm", TileLoadStage::Total);
+  REQUIRE(pTotal);
+  CHECK(pTotal->count == 0);
+
+  CHECK(statistics.getHistogram("glb", TileLoadStage::Total)->count == 1);
+  CHECK(statistics.contentTypes.size() == 2);
+}
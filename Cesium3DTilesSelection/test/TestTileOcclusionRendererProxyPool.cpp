@@ -0,0 +1,149 @@
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+class MockOcclusionProxy final : public TileOcclusionRendererProxy {
+public:
+  TileOcclusionState getOcclusionState() const override {
+    return this->pTile ? TileOcclusionState::Occluded
+                       : TileOcclusionState::NotOccluded;
+  }
+
+  const Tile* pTile = nullptr;
+  int32_t resets = 0;
+
+protected:
+  void reset(const Tile* pNewTile) override {
+    this->pTile = pNewTile;
+    ++this->resets;
+  }
+};
+
+class MockOcclusionProxyPool : public TileOcclusionRendererProxyPool {
+public:
+  explicit MockOcclusionProxyPool(int32_t maximumPoolSize)
+      : TileOcclusionRendererProxyPool(maximumPoolSize) {}
+
+  ~MockOcclusionProxyPool() override { this->destroyPool(); }
+
+  int32_t created = 0;
+
+protected:
+  TileOcclusionRendererProxy* createProxy() override {
+    ++this->created;
+    return new MockOcclusionProxy();
+  }
+
+  void destroyProxy(TileOcclusionRendererProxy* pProxy) override {
+    delete static_cast<MockOcclusionProxy*>(pProxy);
+  }
+};
+
+const MockOcclusionProxy*
+fetch(MockOcclusionProxyPool& pool, const Tile& tile) {
+  return static_cast<const MockOcclusionProxy*>(
+      pool.fetchOcclusionProxyForTile(tile, 0));
+}
+} // namespace
+
+TEST_CASE("TileOcclusionRendererProxyPool") {
+  std::vector<Tile> tiles;
+  for (int i = 0; i < 4; ++i) {
+    tiles.emplace_back(nullptr);
+  }
+
+  SECTION("frees proxies that weren't used in the last frame by default") {
+    MockOcclusionProxyPool pool(2);
+    const MockOcclusionProxy* pProxy = fetch(pool, tiles[0]);
+    REQUIRE(pProxy);
+    CHECK(pProxy->pTile == &tiles[0]);
+    CHECK(fetch(pool, tiles[0]) == pProxy);
+    pool.pruneOcclusionProxyMappings();
+
+    // Unused in this frame, so the proxy goes back to the free list.
+    pool.pruneOcclusionProxyMappings();
+    CHECK(pProxy->pTile == nullptr);
+
+    CHECK(fetch(pool, tiles[1]) == pProxy);
+    CHECK(pool.created == 1);
+  }
+
+  SECTION("keeps proxies of unused tiles for the retained frames") {
+    MockOcclusionProxyPool pool(2);
+    pool.setRetainUnusedProxyFrames(2);
+
+    const MockOcclusionProxy* pProxy = fetch(pool, tiles[0]);
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    CHECK(fetch(pool, tiles[0]) == pProxy);
+    CHECK(pProxy->resets == 1);
+
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    CHECK(pProxy->pTile == nullptr);
+  }
+
+  SECTION("takes the least recently used retained proxy when full") {
+    MockOcclusionProxyPool pool(2);
+    pool.setRetainUnusedProxyFrames(10);
+
+    const MockOcclusionProxy* pFirst = fetch(pool, tiles[0]);
+    pool.pruneOcclusionProxyMappings();
+    const MockOcclusionProxy* pSecond = fetch(pool, tiles[1]);
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+
+    // Both tiles are retained and tiles[0] was used least recently.
+    CHECK(fetch(pool, tiles[2]) == pFirst);
+    CHECK(pFirst->pTile == &tiles[2]);
+    CHECK(fetch(pool, tiles[3]) == pSecond);
+    CHECK(fetch(pool, tiles[0]) == nullptr);
+    CHECK(pool.created == 2);
+  }
+
+  SECTION("doesn't take proxies used in the current frame") {
+    MockOcclusionProxyPool pool(1);
+    pool.setRetainUnusedProxyFrames(10);
+
+    const MockOcclusionProxy* pProxy = fetch(pool, tiles[0]);
+    pool.pruneOcclusionProxyMappings();
+    pool.pruneOcclusionProxyMappings();
+    CHECK(fetch(pool, tiles[0]) == pProxy);
+    CHECK(fetch(pool, tiles[1]) == nullptr);
+    CHECK(pProxy->pTile == &tiles[0]);
+  }
+
+  SECTION("limits the new proxies in each frame") {
+    MockOcclusionProxyPool pool(4);
+    pool.setMaximumNewProxiesPerFrame(2);
+
+    CHECK(fetch(pool, tiles[0]));
+    CHECK(fetch(pool, tiles[1]));
+    CHECK(fetch(pool, tiles[2]) == nullptr);
+
+    // Tiles that already have a proxy still get it.
+    CHECK(fetch(pool, tiles[0]));
+
+    pool.pruneOcclusionProxyMappings();
+    CHECK(fetch(pool, tiles[2]));
+  }
+
+  SECTION("releases the proxy of a tile") {
+    MockOcclusionProxyPool pool(1);
+    pool.setRetainUnusedProxyFrames(10);
+
+    const MockOcclusionProxy* pProxy = fetch(pool, tiles[0]);
+    pool.releaseOcclusionProxyForTile(tiles[0]);
+    CHECK(pProxy->pTile == nullptr);
+    CHECK(fetch(pool, tiles[1]) == pProxy);
+  }
+}
@@ -51,6 +51,49 @@ public:
   TileChildrenResult mockCreateTileChildren;
 };
 
+// Loads an empty model for every tile.
+class ModelTilesetContentLoader : public TilesetContentLoader {
+public:
+  CesiumAsync::Future<TileLoadResult>
+  loadTileContent(const TileLoadInput& input) override {
+    return input.asyncSystem.createResolvedFuture(TileLoadResult{
+        CesiumGltf::Model(),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success});
+  }
+
+  TileChildrenResult
+  createTileChildren([[maybe_unused]] const Tile& tile) override {
+    return {{}, TileLoadResultState::Failed};
+  }
+};
+
+// Prepares tiles in batches, and records the size of each batch.
+class BatchPrepareRendererResource : public SimplePrepareRendererResource {
+public:
+  std::vector<size_t> batchSizes;
+
+  virtual bool supportsPrepareInMainThreadBatch() const noexcept override {
+    return true;
+  }
+
+  virtual void prepareInMainThreadBatch(
+      gsl::span<Tile* const> tiles,
+      gsl::span<void* const> loadThreadResults,
+      gsl::span<void*> mainThreadResults) override {
+    this->batchSizes.emplace_back(tiles.size());
+    SimplePrepareRendererResource::prepareInMainThreadBatch(
+        tiles,
+        loadThreadResults,
+        mainThreadResults);
+  }
+};
+
 std::shared_ptr<SimpleAssetRequest>
 createMockRequest(const std::filesystem::path& path) {
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
@@ -225,7 +268,7 @@ TEST_CASE("Test the manager can be initialized with correct loaders") {
     REQUIRE(pTilesetJson);
     REQUIRE(pTilesetJson->getChildren().size() == 1);
     const Tile* pRootTile = &pTilesetJson->getChildren()[0];
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<InternedString>(pRootTile->getTileID()) == "parent.b3dm");
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Add);
   }
@@ -390,6 +433,57 @@ TEST_CASE("Test tile state machine") {
       CHECK(!tile.getContent().getRenderContent());
     }
 
+    SECTION("Estimate the bytes of the loads in progress") {
+      // There's no estimate until a tile has loaded.
+      CHECK(pManager->getEstimatedTileLoadBytes() == 0);
+      CHECK(pManager->getTileLoadBytesInProgress() == 0);
+
+      pManager->waitUntilIdle();
+      const int64_t byteSize = tile.getByteSize();
+      CHECK(pManager->getEstimatedTileLoadBytes() == byteSize);
+
+      pManager->unloadTileContent(tile);
+      pManager->loadTileContent(tile, options);
+      CHECK(pManager->getTileLoadBytesInProgress() == byteSize);
+
+      pManager->waitUntilIdle();
+      CHECK(pManager->getTileLoadBytesInProgress() == 0);
+    }
+
+    SECTION("Record how long each stage of the load takes") {
+      pManager->waitUntilIdle();
+
+      // The mocked loader has no request to tell the content's type.
+      const TileLoadStatistics& statistics = pManager->getLoadStatistics();
+      REQUIRE(statistics.contentTypes.size() == 1);
+      for (TileLoadStage stage :
+           {TileLoadStage::Load,
+            TileLoadStage::PostProcess,
+            TileLoadStage::PrepareInLoadThread,
+            TileLoadStage::MainThreadWait}) {
+        const TileLoadStageHistogram* pHistogram =
+            statistics.getHistogram("unknown", stage);
+        REQUIRE(pHistogram);
+        CHECK(pHistogram->count == 1);
+      }
+      CHECK(
+          statistics.getHistogram("unknown", TileLoadStage::Total)->count ==
+          0);
+
+      pManager->updateTileContent(tile, options);
+      CHECK(tile.getState() == TileLoadState::Done);
+      CHECK(
+          statistics
+              .getHistogram("unknown", TileLoadStage::PrepareInMainThread)
+              ->count == 1);
+      CHECK(
+          statistics.getHistogram("unknown", TileLoadStage::Total)->count ==
+          1);
+
+      pManager->resetLoadStatistics();
+      CHECK(pManager->getLoadStatistics().contentTypes.empty());
+    }
+
     SECTION("Try to unload tile when it's still loading") {
       // unload tile to move from Done -> Unload
       pManager->unloadTileContent(tile);
@@ -414,6 +508,42 @@ TEST_CASE("Test tile state machine") {
       CHECK(!tile.getContent().isRenderContent());
       CHECK(!tile.getContent().getRenderContent());
     }
+
+    SECTION("Cancel the load of a tile that is still loading") {
+      CHECK(pManager->cancelTileContentLoad(tile));
+      CHECK(pManager->getNumberOfTilesLoading() == 1);
+      CHECK(tile.getState() == TileLoadState::ContentLoading);
+
+      // ContentLoading -> Unloaded
+      pManager->waitUntilIdle();
+      CHECK(pManager->getNumberOfTilesLoading() == 0);
+      CHECK(tile.getState() == TileLoadState::Unloaded);
+      CHECK(tile.getContent().isUnknownContent());
+      CHECK(!tile.getContent().getRenderContent());
+      CHECK(!initializerCall);
+      CHECK(pMockedPrepareRendererResources->totalAllocation == 0);
+
+      // Nothing is loading anymore, so there is nothing to cancel
+      CHECK(!pManager->cancelTileContentLoad(tile));
+    }
+
+    SECTION("Abandon the manager while a tile is still loading") {
+      pManager->abandon();
+      CHECK(pManager->getNumberOfTilesLoading() == 1);
+      CHECK(tile.getState() == TileLoadState::ContentLoading);
+
+      // ContentLoading -> Unloaded, without waiting for the caller to unload
+      pManager->waitUntilIdle();
+      CHECK(pManager->getNumberOfTilesLoading() == 0);
+      CHECK(tile.getState() == TileLoadState::Unloaded);
+      CHECK(!tile.getContent().getRenderContent());
+      CHECK(pMockedPrepareRendererResources->totalAllocation == 0);
+
+      // Nothing is loaded after the manager is abandoned
+      pManager->loadTileContent(tile, options);
+      CHECK(pManager->getNumberOfTilesLoading() == 0);
+      CHECK(tile.getState() == TileLoadState::Unloaded);
+    }
   }
 
   SECTION("Loader requests retry later") {
@@ -485,10 +615,23 @@ TEST_CASE("Test tile state machine") {
     CHECK(!tile.getContent().getRenderContent());
     CHECK(!initializerCall);
 
+    // FailedTemporarily -> FailedTemporarily
+    // the tile isn't loaded again until the retry delay has passed
+    CHECK(tile.getTemporaryFailureCount() == 1);
+    pManager->loadTileContent(tile, options);
+    CHECK(pManager->getNumberOfTilesLoading() == 0);
+    CHECK(tile.getState() == TileLoadState::FailedTemporarily);
+
     // FailedTemporarily -> ContentLoading
+    options.retryDelay = 0.0;
     pManager->loadTileContent(tile, options);
     CHECK(pManager->getNumberOfTilesLoading() == 1);
     CHECK(tile.getState() == TileLoadState::ContentLoading);
+
+    // ContentLoading -> FailedTemporarily
+    pManager->waitUntilIdle();
+    CHECK(tile.getState() == TileLoadState::FailedTemporarily);
+    CHECK(tile.getTemporaryFailureCount() == 2);
   }
 
   SECTION("Loader requests failed") {
@@ -709,6 +852,81 @@ TEST_CASE("Test tile state machine") {
   }
 }
 
+TEST_CASE("Test finishing the loads of tiles in a batch") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto pMockedAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{});
+  auto pMockedPrepareRendererResources =
+      std::make_shared<BatchPrepareRendererResource>();
+  CesiumAsync::AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  TilesetExternals externals{
+      pMockedAssetAccessor,
+      pMockedPrepareRendererResources,
+      asyncSystem,
+      nullptr};
+
+  auto pLoader = std::make_unique<ModelTilesetContentLoader>();
+  auto pRootTile = std::make_unique<Tile>(pLoader.get());
+  std::vector<Tile> children;
+  for (size_t i = 0; i < 3; ++i) {
+    children.emplace_back(pLoader.get());
+  }
+  pRootTile->createChildTiles(std::move(children));
+
+  // With a main thread time limit, loads are finished only when asked to.
+  TilesetOptions options{};
+  options.mainThreadLoadingTimeLimit = 5.0;
+
+  Tile::LoadedLinkedList loadedTiles;
+  IntrusivePointer<TilesetContentManager> pManager = new TilesetContentManager{
+      externals,
+      options,
+      RasterOverlayCollection{loadedTiles, externals},
+      {},
+      std::move(pLoader),
+      std::move(pRootTile)};
+
+  Tile& rootTile = *pManager->getRootTile();
+  std::vector<Tile*> tiles;
+  for (Tile& child : rootTile.getChildren()) {
+    pManager->loadTileContent(child, options);
+    tiles.emplace_back(&child);
+  }
+  pManager->waitUntilIdle();
+
+  for (Tile* pTile : tiles) {
+    pManager->updateTileContent(*pTile, options);
+    REQUIRE(pTile->getState() == TileLoadState::ContentLoaded);
+  }
+  CHECK(pMockedPrepareRendererResources->batchSizes.empty());
+
+  pManager->finishLoadingBatch(tiles, options);
+  CHECK(
+      pMockedPrepareRendererResources->batchSizes == std::vector<size_t>{3});
+  for (Tile* pTile : tiles) {
+    CHECK(pTile->getState() == TileLoadState::Done);
+    CHECK(pTile->getContent().getRenderContent()->getRenderResources());
+  }
+
+  // A single tile is prepared in a batch of one.
+  pManager->loadTileContent(rootTile, options);
+  pManager->waitUntilIdle();
+  pManager->updateTileContent(rootTile, options);
+  REQUIRE(rootTile.getState() == TileLoadState::ContentLoaded);
+  pManager->finishLoading(rootTile, options);
+  CHECK(
+      pMockedPrepareRendererResources->batchSizes ==
+      std::vector<size_t>{3, 1});
+  CHECK(rootTile.getState() == TileLoadState::Done);
+
+  for (Tile* pTile : tiles) {
+    pManager->unloadTileContent(*pTile);
+  }
+  pManager->unloadTileContent(rootTile);
+}
+
 TEST_CASE("Test the tileset content manager's post processing for gltf") {
   Cesium3DTilesContent::registerAllTileContentTypes();
 
@@ -924,6 +1142,200 @@ TEST_CASE("Test the tileset content manager's post processing for gltf") {
     pManager->unloadTileContent(tile);
   }
 
+  SECTION("Release CPU data after the renderer resources are prepared") {
+    // A buffer with positions, normals, and indices, and an image.
+    CesiumGltf::Model model;
+    CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+    buffer.cesium.data.resize(80);
+    buffer.byteLength = 80;
+    for (size_t i = 0; i < buffer.cesium.data.size(); ++i) {
+      buffer.cesium.data[i] = std::byte(i);
+    }
+
+    const std::vector<std::pair<int64_t, int64_t>> ranges{
+        {0, 36},
+        {40, 36},
+        {76, 4}};
+    for (const auto& [byteOffset, byteLength] : ranges) {
+      CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+      bufferView.buffer = 0;
+      bufferView.byteOffset = byteOffset;
+      bufferView.byteLength = byteLength;
+      model.accessors.emplace_back().bufferView =
+          int32_t(model.bufferViews.size() - 1);
+    }
+
+    CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.emplace_back().primitives.emplace_back();
+    primitive.attributes["POSITION"] = 0;
+    primitive.attributes["NORMAL"] = 1;
+    primitive.indices = 2;
+
+    model.images.emplace_back().cesium.pixelData.resize(16);
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    pMockedLoader->mockLoadTileContent = {
+        std::move(model),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Failed};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    options.contentOptions.releaseCpuDataAfterPreparing = true;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    CHECK(pManager->getTotalDataUsed() == 80 + 16);
+
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+
+    const TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    CHECK(pRenderContent->isCpuDataReleased());
+
+    const CesiumGltf::Model& released = pRenderContent->getModel();
+    const std::vector<std::byte>& data = released.buffers[0].cesium.data;
+    CHECK(data.size() == 44);
+    CHECK(released.buffers[0].byteLength == 44);
+
+    // The positions and indices are kept, the normals are not.
+    CHECK(released.bufferViews[0].buffer == 0);
+    CHECK(released.bufferViews[0].byteOffset == 0);
+    CHECK(data[35] == std::byte(35));
+    CHECK(released.bufferViews[1].buffer == -1);
+    CHECK(released.bufferViews[2].buffer == 0);
+    CHECK(released.bufferViews[2].byteOffset == 40);
+    CHECK(data[40] == std::byte(76));
+
+    CHECK(released.images[0].cesium.pixelData.empty());
+    CHECK(released.images[0].cesium.sizeBytes == 0);
+
+    CHECK(pManager->getTotalDataUsed() == 44);
+    CHECK(tile.computeByteSize() == 44);
+    CHECK(tile.getByteSize() == 44);
+
+    pManager->unloadTileContent(tile);
+    CHECK(pManager->getTotalDataUsed() == 0);
+    CHECK(tile.getByteSize() == 0);
+  }
+
+  SECTION("Defer decoding the images of a preloaded tile") {
+    // A 1x1 PNG embedded in the model's only buffer.
+    const std::vector<uint8_t> png{
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00,
+        0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1f,
+        0x15, 0xc4, 0x89, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x44, 0x41,
+        0x54, 0x78, 0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xf0, 0x1f, 0x00,
+        0x05, 0x00, 0x01, 0xff, 0x89, 0x99, 0x3d, 0x1d, 0x00, 0x00,
+        0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82};
+
+    CesiumGltf::Model model;
+    CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+    for (uint8_t byte : png) {
+      buffer.cesium.data.push_back(std::byte(byte));
+    }
+    buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+    CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteLength = buffer.byteLength;
+
+    CesiumGltf::Image& image = model.images.emplace_back();
+    image.bufferView = 0;
+    image.mimeType = CesiumGltf::Image::MimeType::image_png;
+
+    model.meshes.emplace_back().primitives.emplace_back();
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    pMockedLoader->mockLoadTileContent = {
+        std::move(model),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Failed};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    options.contentOptions.deferPreloadedImageDecoding = true;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, options, true);
+    pManager->waitUntilIdle();
+
+    // The preloaded tile waits with its image still encoded.
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::ContentLoaded);
+    const TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    CHECK(pRenderContent->getRenderResources() == nullptr);
+    CHECK(pRenderContent->getModel().images[0].cesium.pixelData.empty());
+    CHECK(!pManager->tileNeedsMainThreadLoading(tile));
+    CHECK(pManager->tileNeedsWorkerThreadLoading(tile));
+
+    // Another preload doesn't decode it either.
+    pManager->loadTileContent(tile, options, true);
+    CHECK(tile.getState() == TileLoadState::ContentLoaded);
+
+    // Once the tile is needed, the image is decoded and the renderer
+    // resources are prepared.
+    pManager->loadTileContent(tile, options);
+    CHECK(tile.getState() == TileLoadState::ContentLoading);
+    pManager->waitUntilIdle();
+    REQUIRE(tile.getState() == TileLoadState::ContentLoaded);
+    pRenderContent = tile.getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    CHECK(pRenderContent->getRenderResources() != nullptr);
+    const CesiumGltf::ImageCesium& decoded =
+        pRenderContent->getModel().images[0].cesium;
+    CHECK(decoded.width == 1);
+    CHECK(decoded.height == 1);
+    CHECK(!decoded.pixelData.empty());
+    CHECK(pManager->tileNeedsMainThreadLoading(tile));
+    CHECK(!pManager->tileNeedsWorkerThreadLoading(tile));
+
+    pManager->updateTileContent(tile, options);
+    CHECK(tile.getState() == TileLoadState::Done);
+
+    pManager->unloadTileContent(tile);
+  }
+
   SECTION("Generate raster overlay projections") {
     // add raster overlay
     Tile::LoadedLinkedList loadedTiles;
@@ -1139,6 +1551,47 @@ TEST_CASE("Test the tileset content manager's post processing for gltf") {
           tileRegion.getRectangle().getNorth() ==
           Approx(beginCarto.latitude + 9 * 0.01));
     }
+
+    SECTION("Map an added overlay within the time limit") {
+      Tile& tile = *pManager->getRootTile();
+      pManager->loadTileContent(tile, {});
+      pManager->waitUntilIdle();
+      pManager->updateTileContent(tile, {});
+      REQUIRE(tile.getState() == TileLoadState::Done);
+      REQUIRE(tile.getMappedRasterTiles().size() == 1);
+
+      // The new overlay uses the projection of the first one, so the tile
+      // doesn't need to be loaded again for it.
+      loadedTiles.insertAtTail(tile);
+      pManager->getRasterOverlayCollection().add(
+          new DebugColorizeTilesRasterOverlay("SecondOverlay"));
+      asyncSystem.dispatchMainThreadTasks();
+      REQUIRE(tile.getMappedRasterTiles().size() == 2);
+
+      auto isPlaceholder = [&tile]() {
+        const RasterOverlayTile* pLoading =
+            tile.getMappedRasterTiles().back().getLoadingTile();
+        return pLoading && pLoading->getState() ==
+                               RasterOverlayTile::LoadState::Placeholder;
+      };
+      REQUIRE(isPlaceholder());
+
+      // Without time left, the tile keeps the placeholder.
+      pManager->startRasterOverlayMapping(1.0e-9);
+      pManager->updateTileContent(tile, {});
+      CHECK(tile.getMappedRasterTiles().size() == 2);
+      CHECK(isPlaceholder());
+      CHECK(pManager->tileNeedsContentUpdate(tile));
+
+      // In a later frame without a limit, it is mapped.
+      pManager->startRasterOverlayMapping(0.0);
+      pManager->updateTileContent(tile, {});
+      CHECK(tile.getState() == TileLoadState::Done);
+      CHECK(tile.getMappedRasterTiles().size() == 2);
+      CHECK(!isPlaceholder());
+
+      loadedTiles.remove(tile);
+    }
   }
 
   SECTION("Don't generate raster overlay for existing projection") {
@@ -3,6 +3,7 @@
 #include "TilesetJsonLoader.h"
 
 #include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumAsync/MemoryCacheDatabase.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleAssetRequest.h>
 #include <CesiumNativeTests/SimpleAssetResponse.h>
@@ -12,6 +13,7 @@
 #include <catch2/catch.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -23,12 +25,14 @@ using namespace CesiumUtility;
 namespace {
 std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
 
-TilesetExternals createMockTilesetExternals(const std::string& tilesetPath) {
+TilesetExternals createMockTilesetExternals(
+    const std::string& tilesetPath,
+    const CesiumAsync::HttpHeaders& responseHeaders = {}) {
   auto tilesetContent = readFile(tilesetPath);
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
       static_cast<uint16_t>(200),
       "doesn't matter",
-      CesiumAsync::HttpHeaders{},
+      CesiumAsync::HttpHeaders(responseHeaders),
       std::move(tilesetContent));
 
   auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
@@ -58,29 +62,59 @@ TilesetExternals createMockTilesetExternals(const std::string& tilesetPath) {
       std::move(pMockCreditSystem)};
 }
 
-TilesetContentLoaderResult<TilesetJsonLoader>
-createLoader(const std::filesystem::path& tilesetPath) {
+TilesetContentLoaderResult<TilesetJsonLoader> createLoader(
+    const std::filesystem::path& tilesetPath,
+    bool createChildrenOnDemand = false) {
   std::string tilesetPathStr = tilesetPath.string();
   auto externals = createMockTilesetExternals(tilesetPathStr);
-  auto loaderResultFuture =
-      TilesetJsonLoader::createLoader(externals, tilesetPathStr, {});
+  auto loaderResultFuture = TilesetJsonLoader::createLoader(
+      externals,
+      tilesetPathStr,
+      {},
+      createChildrenOnDemand);
   externals.asyncSystem.dispatchMainThreadTasks();
 
   return loaderResultFuture.wait();
 }
 
+void checkSameTiles(const Tile& expected, const Tile& actual) {
+  CHECK(
+      std::get<InternedString>(actual.getTileID()) ==
+      std::get<InternedString>(expected.getTileID()));
+  CHECK(actual.isEmptyContent() == expected.isEmptyContent());
+  CHECK(actual.getGeometricError() == expected.getGeometricError());
+  CHECK(actual.getRefine() == expected.getRefine());
+  CHECK(actual.getTransform() == expected.getTransform());
+  CHECK(
+      getBoundingVolumeCenter(actual.getBoundingVolume()) ==
+      getBoundingVolumeCenter(expected.getBoundingVolume()));
+  CHECK(
+      actual.getContentBoundingVolume().has_value() ==
+      expected.getContentBoundingVolume().has_value());
+
+  REQUIRE(actual.getChildren().size() == expected.getChildren().size());
+  for (size_t i = 0; i < expected.getChildren().size(); ++i) {
+    CHECK(actual.getChildren()[i].getParent() == &actual);
+    checkSameTiles(expected.getChildren()[i], actual.getChildren()[i]);
+  }
+}
+
 TileLoadResult loadTileContent(
     const std::filesystem::path& tilePath,
     TilesetContentLoader& loader,
-    Tile& tile) {
+    Tile& tile,
+    std::vector<std::byte>&& data,
+    const std::string& requestUrl,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const TilesetContentOptions& contentOptions) {
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
       static_cast<uint16_t>(200),
       "doesn't matter",
-      CesiumAsync::HttpHeaders{},
-      readFile(tilePath));
+      CesiumAsync::HttpHeaders(responseHeaders),
+      std::move(data));
   auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
       "GET",
-      "doesn't matter",
+      requestUrl,
       CesiumAsync::HttpHeaders{},
       std::move(pMockCompletedResponse));
 
@@ -96,7 +130,7 @@ TileLoadResult loadTileContent(
 
   TileLoadInput loadInput{
       tile,
-      {},
+      contentOptions,
       asyncSystem,
       pMockAssetAccessor,
       spdlog::default_logger(),
@@ -108,6 +142,20 @@ TileLoadResult loadTileContent(
 
   return tileLoadResultFuture.wait();
 }
+
+TileLoadResult loadTileContent(
+    const std::filesystem::path& tilePath,
+    TilesetContentLoader& loader,
+    Tile& tile) {
+  return loadTileContent(
+      tilePath,
+      loader,
+      tile,
+      readFile(tilePath),
+      "doesn't matter",
+      CesiumAsync::HttpHeaders{},
+      TilesetContentOptions{});
+}
 } // namespace
 
 TEST_CASE("Test creating tileset json loader") {
@@ -129,7 +177,7 @@ TEST_CASE("Test creating tileset json loader") {
     REQUIRE(pRootTile->getChildren().size() == 4);
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<InternedString>(pRootTile->getTileID()) == "parent.b3dm");
 
     const auto& boundingVolume = pRootTile->getBoundingVolume();
     const auto* pRegion =
@@ -148,7 +196,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[0].getChildren().size() == 1);
     CHECK(children[0].getGeometricError() == 5.0);
     CHECK(children[0].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[0].getTileID()) == "ll.b3dm");
+    CHECK(std::get<InternedString>(children[0].getTileID()) == "ll.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[0].getBoundingVolume()));
 
@@ -156,7 +204,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[1].getChildren().size() == 0);
     CHECK(children[1].getGeometricError() == 0.0);
     CHECK(children[1].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[1].getTileID()) == "lr.b3dm");
+    CHECK(std::get<InternedString>(children[1].getTileID()) == "lr.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[1].getBoundingVolume()));
 
@@ -164,7 +212,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[2].getChildren().size() == 0);
     CHECK(children[2].getGeometricError() == 0.0);
     CHECK(children[2].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[2].getTileID()) == "ur.b3dm");
+    CHECK(std::get<InternedString>(children[2].getTileID()) == "ur.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[2].getBoundingVolume()));
 
@@ -172,7 +220,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[3].getChildren().size() == 0);
     CHECK(children[3].getGeometricError() == 0.0);
     CHECK(children[3].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[3].getTileID()) == "ul.b3dm");
+    CHECK(std::get<InternedString>(children[3].getTileID()) == "ul.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[3].getBoundingVolume()));
 
@@ -196,7 +244,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(pRootTile->getChildren().size() == 4);
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Add);
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<InternedString>(pRootTile->getTileID()) == "parent.b3dm");
 
     const auto& boundingVolume = pRootTile->getBoundingVolume();
     const auto* pRegion =
@@ -218,7 +266,7 @@ TEST_CASE("Test creating tileset json loader") {
       CHECK(child.getChildren().size() == 0);
       CHECK(child.getGeometricError() == 0.0);
       CHECK(child.getRefine() == TileRefine::Add);
-      CHECK(std::get<std::string>(child.getTileID()) == *expectedUrlIt);
+      CHECK(std::get<InternedString>(child.getTileID()) == *expectedUrlIt);
       CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
           child.getBoundingVolume()));
       ++expectedUrlIt;
@@ -421,6 +469,321 @@ TEST_CASE("Test creating tileset json loader") {
   }
 }
 
+TEST_CASE("Test creating tile children on demand") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto loaderResult = createLoader(
+      testDataPath / "ReplaceTileset" / "tileset.json",
+      true);
+  REQUIRE(!loaderResult.errors.hasErrors());
+  REQUIRE(loaderResult.pRootTile);
+  TilesetJsonLoader& loader = *loaderResult.pLoader;
+
+  // Only the tile of the tileset's root is created with the loader.
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+  Tile& rootTile = loaderResult.pRootTile->getChildren()[0];
+  CHECK(std::get<InternedString>(rootTile.getTileID()) == "parent.b3dm");
+  CHECK(rootTile.getChildren().empty());
+
+  TileChildrenResult rootChildren = loader.createTileChildren(rootTile);
+  CHECK(rootChildren.state == TileLoadResultState::Success);
+  REQUIRE(rootChildren.children.size() == 4);
+  rootTile.createChildTiles(std::move(rootChildren.children));
+
+  auto children = rootTile.getChildren();
+  CHECK(children[0].getParent() == &rootTile);
+  CHECK(children[0].getGeometricError() == 5.0);
+  CHECK(children[0].getRefine() == TileRefine::Replace);
+  CHECK(std::get<InternedString>(children[0].getTileID()) == "ll.b3dm");
+  CHECK(children[0].getChildren().empty());
+  CHECK(std::get<InternedString>(children[3].getTileID()) == "ul.b3dm");
+
+  // The children of the children are created on demand as well.
+  TileChildrenResult llChildren = loader.createTileChildren(children[0]);
+  CHECK(llChildren.state == TileLoadResultState::Success);
+  CHECK(llChildren.children.size() == 1);
+
+  // Tiles without children have nothing to create.
+  TileChildrenResult lrChildren = loader.createTileChildren(children[1]);
+  CHECK(lrChildren.state == TileLoadResultState::Failed);
+  CHECK(lrChildren.children.empty());
+
+  // Released children can be created again.
+  CHECK(loader.releaseTileChildren(rootTile));
+  TileChildrenResult recreatedChildren = loader.createTileChildren(rootTile);
+  CHECK(recreatedChildren.state == TileLoadResultState::Success);
+  CHECK(recreatedChildren.children.size() == 4);
+
+  // Children that were created along with the tileset can't be released.
+  auto eagerResult =
+      createLoader(testDataPath / "ReplaceTileset" / "tileset.json");
+  REQUIRE(eagerResult.pRootTile);
+  const Tile& eagerRootTile = eagerResult.pRootTile->getChildren()[0];
+  CHECK(eagerRootTile.getChildren().size() == 4);
+  CHECK(!eagerResult.pLoader->releaseTileChildren(eagerRootTile));
+}
+
+TEST_CASE("Test prefetching external tilesets") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto loaderResult =
+      createLoader(testDataPath / "AddTileset" / "tileset.json");
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+  TilesetJsonLoader& loader = *loaderResult.pLoader;
+  Tile& externalTile = loaderResult.pRootTile->getChildren()[0];
+  CHECK(std::get<InternedString>(externalTile.getTileID()) == "tileset2.json");
+
+  auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
+      "GET",
+      "tileset2.json",
+      CesiumAsync::HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "doesn't matter",
+          CesiumAsync::HttpHeaders{},
+          readFile(testDataPath / "AddTileset" / "tileset2.json")));
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests{{"tileset2.json", pMockCompletedRequest}};
+  auto pMockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetContentOptions contentOptions;
+
+  TileLoadInput prefetchInput{
+      *loaderResult.pRootTile,
+      contentOptions,
+      asyncSystem,
+      pMockAssetAccessor,
+      spdlog::default_logger(),
+      {}};
+  std::vector<Future<void>> prefetches =
+      loader.prefetchTileChildren(prefetchInput, 10);
+  REQUIRE(prefetches.size() == 1);
+  asyncSystem.dispatchMainThreadTasks();
+  prefetches[0].wait();
+  CHECK(loader.getLoaderDataBytes() > 0);
+
+  // An external tileset that is already cached isn't prefetched again.
+  CHECK(loader.prefetchTileChildren(prefetchInput, 10).empty());
+
+  // Loading the tile uses the prefetched external tileset without requesting
+  // it again.
+  auto pEmptyAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{});
+  TileLoadInput loadInput{
+      externalTile,
+      contentOptions,
+      asyncSystem,
+      pEmptyAssetAccessor,
+      spdlog::default_logger(),
+      {}};
+  auto loadFuture = loader.loadTileContent(loadInput);
+  asyncSystem.dispatchMainThreadTasks();
+  TileLoadResult result = loadFuture.wait();
+  CHECK(result.state == TileLoadResultState::Success);
+  CHECK(std::holds_alternative<TileExternalContent>(result.contentKind));
+  REQUIRE(result.tileInitializer);
+
+  externalTile.getContent().setContentKind(
+      std::make_unique<TileExternalContent>(
+          std::get<TileExternalContent>(result.contentKind)));
+  result.tileInitializer(externalTile);
+  REQUIRE(externalTile.getChildren().size() == 1);
+  CHECK(
+      std::get<InternedString>(externalTile.getChildren()[0].getTileID()) ==
+      "parent.b3dm");
+
+  // The cached external tileset is unloaded once it hasn't been used since the
+  // previous unload.
+  loader.unloadLoaderData(0);
+  CHECK(loader.getLoaderDataBytes() > 0);
+  loader.unloadLoaderData(0);
+  CHECK(loader.getLoaderDataBytes() == 0);
+}
+
+TEST_CASE("Test caching the tile hierarchy of tileset json") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto pCache = std::make_shared<MemoryCacheDatabase>(nullptr);
+  auto createCachingLoader = [&pCache](const std::string& tilesetPath) {
+    auto externals = createMockTilesetExternals(
+        tilesetPath,
+        CesiumAsync::HttpHeaders{{"ETag", "\"v1\""}});
+    externals.pTileHierarchyCache = pCache;
+    auto loaderResultFuture =
+        TilesetJsonLoader::createLoader(externals, tilesetPath, {});
+    externals.asyncSystem.dispatchMainThreadTasks();
+
+    return loaderResultFuture.wait();
+  };
+
+  // The request of a later session, which doesn't need to be parsed when the
+  // version of the tileset.json is the same.
+  auto createRequest = [](const std::string& tilesetPath,
+                          const std::string& etag) {
+    const std::string notJson = "not json";
+    std::vector<std::byte> data(notJson.size());
+    std::memcpy(data.data(), notJson.data(), notJson.size());
+    return SimpleAssetRequest(
+        "GET",
+        tilesetPath,
+        CesiumAsync::HttpHeaders{},
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{{"ETag", etag}},
+            std::move(data)));
+  };
+
+  SECTION("Cached tiles are the same as the parsed tiles") {
+    std::string tilesetPath =
+        (testDataPath / "ReplaceTileset" / "tileset.json").string();
+    auto parsedResult = createCachingLoader(tilesetPath);
+    REQUIRE(!parsedResult.errors.hasErrors());
+    REQUIRE(parsedResult.pRootTile);
+
+    auto maybeCachedResult =
+        TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+            *pCache,
+            createRequest(tilesetPath, "\"v1\""));
+    REQUIRE(maybeCachedResult);
+    REQUIRE(maybeCachedResult->pLoader);
+    REQUIRE(maybeCachedResult->pRootTile);
+    CHECK(
+        maybeCachedResult->pLoader->getUpAxis() ==
+        parsedResult.pLoader->getUpAxis());
+    CHECK(maybeCachedResult->pRootTile->isExternalContent());
+    CHECK(maybeCachedResult->pRootTile->getUnconditionallyRefine());
+    checkSameTiles(*parsedResult.pRootTile, *maybeCachedResult->pRootTile);
+
+    // A different version of the tileset.json has to be parsed again.
+    CHECK(!TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+        *pCache,
+        createRequest(tilesetPath, "\"v2\"")));
+  }
+
+  SECTION("Cached tiles keep the metadata of the tileset") {
+    std::string tilesetPath =
+        (testDataPath / "WithMetadata" / "tileset.json").string();
+    auto parsedResult = createCachingLoader(tilesetPath);
+    REQUIRE(!parsedResult.errors.hasErrors());
+
+    auto maybeCachedResult =
+        TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+            *pCache,
+            createRequest(tilesetPath, "\"v1\""));
+    REQUIRE(maybeCachedResult);
+    REQUIRE(maybeCachedResult->pRootTile);
+
+    TileExternalContent* pExternal =
+        maybeCachedResult->pRootTile->getContent().getExternalContent();
+    REQUIRE(pExternal);
+    const std::optional<Cesium3DTiles::Schema>& schema =
+        pExternal->metadata.schema;
+    REQUIRE(schema);
+    CHECK(schema->id == "foo");
+  }
+
+  SECTION("Implicit tilesets are not cached") {
+    std::string tilesetPath = (testDataPath / "MultipleKindsOfTilesets" /
+                               "QuadtreeImplicitTileset.json")
+                                  .string();
+    auto parsedResult = createCachingLoader(tilesetPath);
+    REQUIRE(!parsedResult.errors.hasErrors());
+
+    CHECK(!TilesetJsonLoader::createLoaderFromCachedTileHierarchy(
+        *pCache,
+        createRequest(tilesetPath, "\"v1\"")));
+  }
+}
+
+TEST_CASE("Test caching the decoded content of tiles") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto loaderResult =
+      createLoader(testDataPath / "ReplaceTileset" / "tileset.json");
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+  Tile& tile = loaderResult.pRootTile->getChildren()[0];
+
+  TilesetContentOptions contentOptions;
+  contentOptions.pDecodedTileCache =
+      std::make_shared<MemoryCacheDatabase>(nullptr);
+
+  const std::filesystem::path tilePath =
+      testDataPath / "ReplaceTileset" / "parent.b3dm";
+  const std::string tileUrl = tilePath.filename().string();
+  TileLoadResult decodedResult = loadTileContent(
+      tilePath,
+      *loaderResult.pLoader,
+      tile,
+      readFile(tilePath),
+      tileUrl,
+      CesiumAsync::HttpHeaders{{"ETag", "\"v1\""}},
+      contentOptions);
+  REQUIRE(decodedResult.state == TileLoadResultState::Success);
+  const CesiumGltf::Model* pDecoded =
+      std::get_if<CesiumGltf::Model>(&decodedResult.contentKind);
+  REQUIRE(pDecoded);
+
+  // The content of a later session, which isn't decoded when its version is
+  // the same.
+  auto notB3dm = []() {
+    const std::string notB3dm = "not b3dm";
+    std::vector<std::byte> data(notB3dm.size());
+    std::memcpy(data.data(), notB3dm.data(), notB3dm.size());
+    return data;
+  };
+
+  SECTION("The same version of the content is read from the cache") {
+    TileLoadResult cachedResult = loadTileContent(
+        tilePath,
+        *loaderResult.pLoader,
+        tile,
+        notB3dm(),
+        tileUrl,
+        CesiumAsync::HttpHeaders{{"ETag", "\"v1\""}},
+        contentOptions);
+    REQUIRE(cachedResult.state == TileLoadResultState::Success);
+    const CesiumGltf::Model* pCached =
+        std::get_if<CesiumGltf::Model>(&cachedResult.contentKind);
+    REQUIRE(pCached);
+    CHECK(pCached->meshes.size() == pDecoded->meshes.size());
+    CHECK(pCached->accessors.size() == pDecoded->accessors.size());
+    CHECK(pCached->bufferViews.size() == pDecoded->bufferViews.size());
+    REQUIRE(pCached->buffers.size() == 1);
+    REQUIRE(pDecoded->buffers.size() == 1);
+    CHECK(pCached->buffers[0].cesium.data == pDecoded->buffers[0].cesium.data);
+  }
+
+  SECTION("A different version of the content is decoded again") {
+    TileLoadResult result = loadTileContent(
+        tilePath,
+        *loaderResult.pLoader,
+        tile,
+        notB3dm(),
+        tileUrl,
+        CesiumAsync::HttpHeaders{{"ETag", "\"v2\""}},
+        contentOptions);
+    CHECK(result.state == TileLoadResultState::Failed);
+  }
+
+  SECTION("Content decoded with different options is decoded again") {
+    contentOptions.dequantizeMeshData = false;
+    TileLoadResult result = loadTileContent(
+        tilePath,
+        *loaderResult.pLoader,
+        tile,
+        notB3dm(),
+        tileUrl,
+        CesiumAsync::HttpHeaders{{"ETag", "\"v1\""}},
+        contentOptions);
+    CHECK(result.state == TileLoadResultState::Failed);
+  }
+}
+
 TEST_CASE("Test loading individual tile of tileset json") {
   Cesium3DTilesContent::registerAllTileContentTypes();
 
@@ -432,7 +795,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
 
     auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
 
-    const auto& tileID = std::get<std::string>(pRootTile->getTileID());
+    const std::string& tileID =
+        std::get<InternedString>(pRootTile->getTileID()).str();
     CHECK(tileID == "parent.b3dm");
 
     // check tile content
@@ -457,7 +821,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
 
     auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
 
-    const auto& tileID = std::get<std::string>(pRootTile->getTileID());
+    const std::string& tileID =
+        std::get<InternedString>(pRootTile->getTileID()).str();
     CHECK(tileID == "tileset2.json");
 
     // check tile content
@@ -481,7 +846,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
     REQUIRE(children.size() == 1);
 
     const Tile& parentB3dmTile = children[0];
-    CHECK(std::get<std::string>(parentB3dmTile.getTileID()) == "parent.b3dm");
+    CHECK(
+        std::get<InternedString>(parentB3dmTile.getTileID()) == "parent.b3dm");
     CHECK(parentB3dmTile.getGeometricError() == Approx(70.0));
 
     std::vector<std::string> expectedChildUrls{
@@ -492,7 +858,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
     const auto& parentB3dmChildren = parentB3dmTile.getChildren();
     for (std::size_t i = 0; i < parentB3dmChildren.size(); ++i) {
       const Tile& child = parentB3dmChildren[i];
-      CHECK(std::get<std::string>(child.getTileID()) == expectedChildUrls[i]);
+      CHECK(
+          std::get<InternedString>(child.getTileID()) == expectedChildUrls[i]);
       CHECK(child.getGeometricError() == Approx(0.0));
       CHECK(child.getRefine() == TileRefine::Add);
       CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
@@ -18,6 +18,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -621,7 +622,7 @@ TEST_CASE("Test additive refinement") {
       for (const Tile& child : parentB3DM.getChildren()) {
         REQUIRE(child.getState() == TileLoadState::Done);
 
-        if (*std::get_if<std::string>(&child.getTileID()) !=
+        if (*std::get_if<InternedString>(&child.getTileID()) !=
             "tileset3/tileset3.json") {
           REQUIRE(doesTileMeetSSE(viewState, child, tileset));
         } else {
@@ -938,6 +939,34 @@ TEST_CASE("Test multiple frustums") {
       REQUIRE(result.tilesCulled == 2);
     }
   }
+
+  SECTION("Visibility per view tells each view which tiles it sees") {
+    ViewState zoomToTileViewState = zoomToTile(root->getChildren()[0]);
+    const std::vector<ViewState> views{viewState, zoomToTileViewState};
+
+    // Only the frustums decide what is visible in each view.
+    tileset.getOptions().renderTilesUnderCamera = false;
+
+    ViewUpdateResult result = tileset.updateView(views);
+    CHECK(result.tileVisibilityPerView.empty());
+
+    tileset.getOptions().computeVisibilityPerView = true;
+    result = tileset.updateView(views);
+    REQUIRE(!result.tilesToRenderThisFrame.empty());
+    REQUIRE(
+        result.tileVisibilityPerView.size() ==
+        result.tilesToRenderThisFrame.size() * views.size());
+
+    for (size_t view = 0; view < views.size(); ++view) {
+      std::vector<Tile*> expected;
+      for (Tile* pTile : result.tilesToRenderThisFrame) {
+        if (views[view].isBoundingVolumeVisible(pTile->getBoundingVolume())) {
+          expected.emplace_back(pTile);
+        }
+      }
+      CHECK(result.getTilesToRenderInView(view, views.size()) == expected);
+    }
+  }
 }
 
 TEST_CASE("Can load example tileset.json from 3DTILES_bounding_volume_S2 "
@@ -1395,6 +1424,23 @@ TEST_CASE("Allows access to material variants in an external schema") {
   CHECK(!wasCalled);
   initializeTileset(tileset);
   CHECK(wasCalled);
+
+  // Another tileset with the same schema URI uses the schema loaded by the
+  // first one instead of requesting it again.
+  mockAssetAccessor->mockCompletedRequests.erase("schema.json");
+  Tileset otherTileset(tilesetExternals, "tileset-external-schema.json");
+
+  bool wasOtherCalled = false;
+  otherTileset.loadMetadata().thenInMainThread(
+      [&wasOtherCalled](const TilesetMetadata* pMetadata) {
+        wasOtherCalled = true;
+        REQUIRE(pMetadata);
+        REQUIRE(pMetadata->schema);
+        CHECK(pMetadata->schema->classes.count("MaterialVariants") == 1);
+      });
+
+  initializeTileset(otherTileset);
+  CHECK(wasOtherCalled);
 }
 
 TEST_CASE("Future from loadSchema rejects if schemaUri can't be loaded") {
@@ -1677,4 +1723,855 @@ TEST_CASE("Additive-refined tiles are added to the tilesFadingOut array") {
   // two are fading out.
   CHECK(updateResult.tilesToRenderThisFrame.size() == 2);
   CHECK(updateResult.tilesFadingOut.size() == 2);
+  for (const Tile* pTile : updateResult.tilesFadingOut) {
+    CHECK(pTile->isFadingOut());
+  }
+
+  // Once the tiles are visible again, they're no longer fading out.
+  updateResult = tileset.updateView({viewState});
+  CHECK(updateResult.tilesToRenderThisFrame.size() == 4);
+  CHECK(updateResult.tilesFadingOut.empty());
+  for (const Tile* pTile : updateResult.tilesToRenderThisFrame) {
+    CHECK(!pTile->isFadingOut());
+  }
+}
+
+TEST_CASE("Parallel tile evaluation selects the same tiles as a serial "
+          "traversal") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions parallelOptions;
+  parallelOptions.parallelTraversalThreadCount = 2;
+  parallelOptions.parallelTraversalMinimumTiles = 0;
+
+  Tileset serialTileset(tilesetExternals, "tileset.json");
+  Tileset parallelTileset(tilesetExternals, "tileset.json", parallelOptions);
+  initializeTileset(serialTileset);
+  initializeTileset(parallelTileset);
+
+  ViewState viewState = zoomToTileset(serialTileset);
+  ViewState zoomedOut = ViewState::create(
+      viewState.getPosition() - viewState.getDirection() * 2500.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  auto getRenderedTileIds = [](const ViewUpdateResult& result) {
+    std::vector<std::string> ids;
+    for (const Tile* pTile : result.tilesToRenderThisFrame) {
+      ids.emplace_back(
+          TileIdUtilities::createTileIdString(pTile->getTileID()));
+    }
+    return ids;
+  };
+
+  for (int frame = 0; frame < 6; ++frame) {
+    const ViewState& frameView = frame < 3 ? viewState : zoomedOut;
+    const ViewUpdateResult& serialResult =
+        serialTileset.updateView({frameView});
+    const ViewUpdateResult& parallelResult =
+        parallelTileset.updateView({frameView});
+
+    CHECK(
+        getRenderedTileIds(serialResult) ==
+        getRenderedTileIds(parallelResult));
+    CHECK(serialResult.tilesVisited == parallelResult.tilesVisited);
+    CHECK(serialResult.tilesCulled == parallelResult.tilesCulled);
+    CHECK(
+        serialResult.culledTilesVisited == parallelResult.culledTilesVisited);
+    CHECK(serialResult.tilesKicked == parallelResult.tilesKicked);
+    CHECK(
+        serialResult.workerThreadTileLoadQueueLength ==
+        parallelResult.workerThreadTileLoadQueueLength);
+  }
+}
+
+TEST_CASE("Cached traversal reuses the selection while the view is unchanged") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.enableCachedTraversal = true;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+
+  // Load everything needed for this view.
+  ViewUpdateResult result;
+  int64_t bytesLoaded = 0;
+  for (int frame = 0; frame < 10; ++frame) {
+    result = tileset.updateView({viewState});
+    bytesLoaded += result.bytesLoaded;
+    CHECK(result.traversalTime >= 0.0);
+    CHECK(result.mainThreadLoadingTime >= 0.0);
+    CHECK(result.bytesFreed == 0);
+  }
+  REQUIRE(tileset.computeLoadProgress() == 100.0f);
+  REQUIRE(!result.tilesToRenderThisFrame.empty());
+  CHECK(bytesLoaded > 0);
+  CHECK(bytesLoaded <= tileset.getTotalDataBytes());
+
+  SECTION("An unchanged view reuses the previous selection") {
+    const ViewUpdateResult& reused = tileset.updateView({viewState});
+    CHECK(reused.selectionReused);
+    CHECK(reused.tilesVisited == 0);
+    CHECK(reused.frameNumber == result.frameNumber);
+    CHECK(reused.tilesToRenderThisFrame == result.tilesToRenderThisFrame);
+    CHECK(reused.traversalTime == 0.0);
+    CHECK(reused.bytesLoaded == 0);
+  }
+
+  SECTION("A moved view traverses the tileset again") {
+    ViewState movedViewState = ViewState::create(
+        viewState.getPosition() - viewState.getDirection() * 100.0,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+    const ViewUpdateResult& traversed = tileset.updateView({movedViewState});
+    CHECK(!traversed.selectionReused);
+    CHECK(traversed.tilesVisited > 0);
+    CHECK(traversed.frameNumber == result.frameNumber + 1);
+  }
+
+  SECTION("Changing the maximum screen-space error traverses the tileset "
+          "again") {
+    tileset.getOptions().maximumScreenSpaceError *= 2.0;
+    const ViewUpdateResult& traversed = tileset.updateView({viewState});
+    CHECK(!traversed.selectionReused);
+    CHECK(traversed.tilesVisited > 0);
+  }
+}
+
+TEST_CASE("Load timings report when the view is fully loaded") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  CHECK(!tileset.getLoadTimings().timeToFirstRenderableFrame);
+  CHECK(tileset.getLoadTimings().viewChangeCount == 0);
+
+  initializeTileset(tileset);
+  TilesetLoadTimings timings = tileset.getLoadTimings();
+  REQUIRE(timings.timeToRootTileAvailable);
+  CHECK(*timings.timeToRootTileAvailable >= 0.0);
+  CHECK(timings.viewChangeCount == 1);
+
+  ViewState viewState = zoomToTileset(tileset);
+
+  // Exactly one frame reports reaching full detail for the new view.
+  int fullDetailFrames = 0;
+  for (int frame = 0; frame < 10; ++frame) {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    if (result.timeToFullDetail) {
+      CHECK(*result.timeToFullDetail >= 0.0);
+      CHECK(result.workerThreadTileLoadQueueLength == 0);
+      CHECK(result.mainThreadTileLoadQueueLength == 0);
+      ++fullDetailFrames;
+    }
+  }
+  CHECK(fullDetailFrames == 1);
+  REQUIRE(tileset.computeLoadProgress() == 100.0f);
+
+  timings = tileset.getLoadTimings();
+  CHECK(timings.viewChangeCount == 2);
+  REQUIRE(timings.timeToFirstRenderableFrame);
+  CHECK(
+      *timings.timeToFirstRenderableFrame >=
+      *timings.timeToRootTileAvailable);
+  REQUIRE(timings.timeToFullDetail);
+
+  SECTION("A moved view starts measuring again") {
+    ViewState movedViewState = ViewState::create(
+        viewState.getPosition() - viewState.getDirection() * 100.0,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+    fullDetailFrames = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+      const ViewUpdateResult& result = tileset.updateView({movedViewState});
+      if (result.timeToFullDetail) {
+        ++fullDetailFrames;
+      }
+    }
+    CHECK(fullDetailFrames == 1);
+    CHECK(tileset.getLoadTimings().viewChangeCount == 3);
+    CHECK(tileset.getLoadTimings().timeToFullDetail);
+  }
+
+  SECTION("An unchanged view doesn't report full detail again") {
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(!result.timeToFullDetail);
+    CHECK(tileset.getLoadTimings().viewChangeCount == 2);
+  }
+}
+
+TEST_CASE("Adaptive screen-space error responds to reported frame times") {
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  mockCompletedRequests.insert(
+      {"tileset.json",
+       std::make_shared<SimpleAssetRequest>(
+           "GET",
+           "tileset.json",
+           CesiumAsync::HttpHeaders{},
+           std::make_unique<SimpleAssetResponse>(
+               static_cast<uint16_t>(200),
+               "doesn't matter",
+               CesiumAsync::HttpHeaders{},
+               readFile(testDataPath / "tileset.json")))});
+
+  TilesetExternals tilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.maximumScreenSpaceError = 16.0;
+  options.culledScreenSpaceError = 64.0;
+  options.loadingDescendantLimit = 20;
+  options.adaptiveScreenSpaceError.enabled = true;
+  options.adaptiveScreenSpaceError.targetFrameTime = 0.02;
+  options.adaptiveScreenSpaceError.hysteresis = 0.1;
+  options.adaptiveScreenSpaceError.scaleStep = 2.0;
+  options.adaptiveScreenSpaceError.maximumScale = 4.0;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+
+  const ViewUpdateResult& initial = tileset.updateView({});
+  CHECK(initial.effectiveMaximumScreenSpaceError == 16.0);
+  CHECK(initial.effectiveCulledScreenSpaceError == 64.0);
+  CHECK(initial.effectiveLoadingDescendantLimit == 20);
+
+  SECTION("Slow frames coarsen the detail up to the maximum scale") {
+    tileset.reportFrameStatistics(0.05);
+    const ViewUpdateResult& slower = tileset.updateView({});
+    CHECK(slower.effectiveMaximumScreenSpaceError == 32.0);
+    CHECK(slower.effectiveCulledScreenSpaceError == 128.0);
+    CHECK(slower.effectiveLoadingDescendantLimit == 10);
+
+    tileset.reportFrameStatistics(0.05);
+    tileset.reportFrameStatistics(0.05);
+    const ViewUpdateResult& slowest = tileset.updateView({});
+    CHECK(slowest.effectiveMaximumScreenSpaceError == 64.0);
+    CHECK(slowest.effectiveLoadingDescendantLimit == 5);
+  }
+
+  SECTION("Frames near the target leave the detail unchanged") {
+    tileset.reportFrameStatistics(0.05);
+    tileset.reportFrameStatistics(0.019);
+    tileset.reportFrameStatistics(0.021);
+    const ViewUpdateResult& result = tileset.updateView({});
+    CHECK(result.effectiveMaximumScreenSpaceError == 32.0);
+  }
+
+  SECTION("Fast frames restore the configured detail") {
+    tileset.reportFrameStatistics(0.05);
+    tileset.reportFrameStatistics(0.01);
+    tileset.reportFrameStatistics(0.01);
+    const ViewUpdateResult& result = tileset.updateView({});
+    CHECK(result.effectiveMaximumScreenSpaceError == 16.0);
+    CHECK(result.effectiveLoadingDescendantLimit == 20);
+  }
+
+  SECTION("A GPU memory budget also coarsens the detail") {
+    tileset.getOptions().adaptiveScreenSpaceError.gpuMemoryBudget = 1000;
+    tileset.reportFrameStatistics(0.01, 2000);
+    const ViewUpdateResult& result = tileset.updateView({});
+    CHECK(result.effectiveMaximumScreenSpaceError == 32.0);
+  }
+}
+
+TEST_CASE("Traversal time limit keeps the previous selection of unvisited "
+          "subtrees") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+
+  // Load everything needed for this view without a time limit.
+  ViewUpdateResult result;
+  for (int frame = 0; frame < 10; ++frame) {
+    result = tileset.updateView({viewState});
+  }
+  REQUIRE(tileset.computeLoadProgress() == 100.0f);
+  REQUIRE(!result.tilesToRenderThisFrame.empty());
+
+  std::vector<Tile*> expected = result.tilesToRenderThisFrame;
+  std::sort(expected.begin(), expected.end());
+
+  // With a limit that is exhausted immediately, only the top of the tileset
+  // is traversed, but the selection stays the same.
+  tileset.getOptions().traversalTimeLimit = 1.0e-9;
+  for (int frame = 0; frame < 3; ++frame) {
+    const ViewUpdateResult& limited = tileset.updateView({viewState});
+    CHECK(limited.tilesVisited <= result.tilesVisited);
+
+    std::vector<Tile*> selected = limited.tilesToRenderThisFrame;
+    std::sort(selected.begin(), selected.end());
+    CHECK(selected == expected);
+  }
+
+  tileset.getOptions().traversalTimeLimit = 0.0;
+  const ViewUpdateResult& unlimited = tileset.updateView({viewState});
+  CHECK(unlimited.tilesVisited == result.tilesVisited);
+}
+
+TEST_CASE("Skipping levels of detail loads fewer intermediate tiles") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  // Don't load the tiles that are culled while the tileset is initialized.
+  TilesetOptions options;
+  options.preloadSiblings = false;
+
+  SECTION("Without skipping, the tiles between the root and the desired "
+          "tiles are loaded") {}
+
+  SECTION("The coarsest tile below the base is loaded, and the tiles below "
+          "it are skipped") {
+    options.skipLevelOfDetail.enabled = true;
+  }
+
+  SECTION("Immediately loading the desired tiles skips every other tile") {
+    options.skipLevelOfDetail.enabled = true;
+    options.skipLevelOfDetail.immediatelyLoadDesiredLevelOfDetail = true;
+  }
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& parent = pTilesetJson->getChildren()[0];
+  const Tile& ll = parent.getChildren()[0];
+  const Tile& llll = ll.getChildren()[0];
+  REQUIRE(parent.getState() == TileLoadState::Unloaded);
+
+  // Look at the lower-left tile from just outside the tileset, so that only
+  // its child meets the screen-space error, and the parent is well below the
+  // default base screen-space error.
+  const ViewState llViewState = zoomToTile(ll);
+  const ViewState viewState = ViewState::create(
+      llViewState.getPosition() - llViewState.getDirection() * 70.0,
+      llViewState.getDirection(),
+      llViewState.getUp(),
+      llViewState.getViewportSize(),
+      llViewState.getHorizontalFieldOfView(),
+      llViewState.getVerticalFieldOfView());
+  REQUIRE(!doesTileMeetSSE(viewState, parent, tileset));
+  REQUIRE(!doesTileMeetSSE(viewState, ll, tileset));
+
+  ViewUpdateResult result;
+  for (int frame = 0; frame < 10; ++frame) {
+    result = tileset.updateView({viewState});
+  }
+
+  CHECK(llll.getState() == TileLoadState::Done);
+  CHECK(
+      std::find(
+          result.tilesToRenderThisFrame.begin(),
+          result.tilesToRenderThisFrame.end(),
+          &llll) != result.tilesToRenderThisFrame.end());
+
+  if (!options.skipLevelOfDetail.enabled) {
+    CHECK(parent.getState() == TileLoadState::Done);
+    CHECK(ll.getState() == TileLoadState::Done);
+  } else if (!options.skipLevelOfDetail.immediatelyLoadDesiredLevelOfDetail) {
+    CHECK(parent.getState() == TileLoadState::Done);
+    CHECK(ll.getState() == TileLoadState::Unloaded);
+  } else {
+    CHECK(parent.getState() == TileLoadState::Unloaded);
+    CHECK(ll.getState() == TileLoadState::Unloaded);
+  }
+}
+
+TEST_CASE("Foveated loading relaxes the detail of tiles away from the gaze") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.foveatedLoading.enabled = true;
+  options.foveatedLoading.peripheralScreenSpaceErrorFactor = 1.0e6;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& parent = pTilesetJson->getChildren()[0];
+  const Tile& ll = parent.getChildren()[0];
+
+  // Look at the lower-left tile from just outside the tileset, so that the
+  // parent does not meet the screen-space error.
+  const ViewState llViewState = zoomToTile(ll);
+  const ViewState viewState = ViewState::create(
+      llViewState.getPosition() - llViewState.getDirection() * 70.0,
+      llViewState.getDirection(),
+      llViewState.getUp(),
+      llViewState.getViewportSize(),
+      llViewState.getHorizontalFieldOfView(),
+      llViewState.getVerticalFieldOfView());
+  REQUIRE(!doesTileMeetSSE(viewState, parent, tileset));
+  CHECK(viewState.getGazeDirection() == viewState.getDirection());
+
+  SECTION("Tiles near the gaze are refined as usual") {
+    for (int frame = 0; frame < 10; ++frame) {
+      tileset.updateView({viewState});
+    }
+    CHECK(ll.getState() == TileLoadState::Done);
+  }
+
+  SECTION("Tiles far from the gaze are given the relaxed screen-space error") {
+    // Looking away from the tileset puts the whole of it in the periphery.
+    const ViewState awayViewState =
+        viewState.withGazeDirection(-viewState.getDirection());
+    CHECK(awayViewState.getDirection() == viewState.getDirection());
+    CHECK(awayViewState.getGazeDirection() == -viewState.getDirection());
+
+    ViewUpdateResult result;
+    for (int frame = 0; frame < 10; ++frame) {
+      result = tileset.updateView({awayViewState});
+    }
+    REQUIRE(result.tilesToRenderThisFrame.size() == 1);
+    CHECK(result.tilesToRenderThisFrame.front() == &parent);
+    CHECK(ll.getState() == TileLoadState::Unloaded);
+  }
+}
+
+namespace {
+class GpuReportingPrepareRendererResource
+    : public SimplePrepareRendererResource {
+public:
+  virtual int64_t getGpuByteSize(
+      const Tile& /*tile*/,
+      void* /*pMainThreadResult*/) const noexcept override {
+    return 1000;
+  }
+};
+} // namespace
+
+TEST_CASE("GPU bytes reported by the renderer are counted separately") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<GpuReportingPrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  for (int frame = 0; frame < 10; ++frame) {
+    tileset.updateView({viewState});
+  }
+  REQUIRE(tileset.computeLoadProgress() == 100.0f);
+
+  int64_t tileGpuBytes = 0;
+  int64_t tileCpuBytes = 0;
+  tileset.forEachLoadedTile([&](Tile& tile) {
+    tileGpuBytes += tile.getGpuByteSize();
+    tileCpuBytes += tile.getByteSize();
+    CHECK(tile.getByteSize() == tile.computeByteSize());
+    if (tile.getState() == TileLoadState::Done && tile.isRenderContent()) {
+      CHECK(tile.getGpuByteSize() == 1000);
+    }
+  });
+
+  CHECK(tileGpuBytes > 0);
+  CHECK(tileset.getTotalGpuDataBytes() == tileGpuBytes);
+  CHECK(tileset.getTotalDataBytes() == tileCpuBytes);
+
+  SECTION("visits the same tiles in parallel") {
+    std::vector<Tile*> loadedTiles;
+    tileset.getLoadedTiles(loadedTiles);
+    REQUIRE(!loadedTiles.empty());
+
+    tileset.getOptions().parallelTraversalThreadCount = 2;
+
+    std::mutex mutex;
+    std::vector<const Tile*> visitedTiles;
+    tileset.forEachLoadedTileInParallel([&](const Tile& tile) {
+      std::lock_guard<std::mutex> lock(mutex);
+      visitedTiles.emplace_back(&tile);
+    });
+
+    std::vector<const Tile*> expectedTiles(
+        loadedTiles.begin(),
+        loadedTiles.end());
+    std::sort(expectedTiles.begin(), expectedTiles.end());
+    std::sort(visitedTiles.begin(), visitedTiles.end());
+    CHECK(visitedTiles == expectedTiles);
+  }
+}
+
+namespace {
+
+CesiumGltf::Model createPointCloudModel(int64_t pointsLength) {
+  CesiumGltf::Model model;
+
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(
+      static_cast<size_t>(pointsLength) * sizeof(glm::vec3));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
+  accessor.type = CesiumGltf::Accessor::Type::VEC3;
+  accessor.count = pointsLength;
+
+  CesiumGltf::MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.mode = CesiumGltf::MeshPrimitive::Mode::POINTS;
+  primitive.attributes.emplace("POSITION", 0);
+
+  return model;
+}
+
+float computePointBudgetFraction(int64_t maximumPointsRendered) {
+  class PointCloudLoader : public TilesetContentLoader {
+  public:
+    virtual CesiumAsync::Future<TileLoadResult>
+    loadTileContent(const TileLoadInput& input) override {
+      TileLoadResult result{};
+      result.contentKind = createPointCloudModel(1000);
+      return input.asyncSystem.createResolvedFuture(std::move(result));
+    }
+
+    virtual TileChildrenResult createTileChildren(const Tile&) override {
+      return TileChildrenResult{{}, TileLoadResultState::Success};
+    }
+  };
+
+  TilesetExternals tilesetExternals{
+      nullptr,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  auto pLoader = std::make_unique<PointCloudLoader>();
+  auto pRootTile = std::make_unique<Tile>(pLoader.get());
+  Cartographic center = Cartographic::fromDegrees(118.0, 32.0, 0.0);
+  pRootTile->setBoundingVolume(CesiumGeospatial::BoundingRegion(
+      GlobeRectangle(
+          center.longitude - 0.001,
+          center.latitude - 0.001,
+          center.longitude + 0.001,
+          center.latitude + 0.001),
+      0.0,
+      10.0));
+  pRootTile->setGeometricError(0.0);
+
+  TilesetOptions options;
+  options.maximumPointsRendered = maximumPointsRendered;
+  Tileset tileset(
+      tilesetExternals,
+      std::move(pLoader),
+      std::move(pRootTile),
+      options);
+
+  for (int frame = 0; frame < 3; ++frame) {
+    initializeTileset(tileset);
+  }
+
+  const ViewUpdateResult& result = tileset.updateView({zoomToTileset(tileset)});
+  REQUIRE(result.tilesToRenderThisFrame.size() == 1);
+  const TileRenderContent* pRenderContent =
+      result.tilesToRenderThisFrame[0]->getContent().getRenderContent();
+  REQUIRE(pRenderContent);
+  return pRenderContent->getPointBudgetFraction();
+}
+
+} // namespace
+
+TEST_CASE("The point budget limits the fraction of points to render") {
+  SECTION("Without a budget, all points are rendered") {
+    CHECK(computePointBudgetFraction(0) == 1.0f);
+  }
+
+  SECTION("A budget larger than the points renders all of them") {
+    CHECK(computePointBudgetFraction(5000) == 1.0f);
+  }
+
+  SECTION("A smaller budget renders a fraction of the points") {
+    CHECK(computePointBudgetFraction(250) == Approx(0.25f));
+  }
 }
@@ -3,6 +3,9 @@
 #include "Cesium3DTilesWriter/Library.h"
 
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+
+#include <string_view>
 
 // forward declarations
 namespace Cesium3DTiles {
@@ -74,6 +77,23 @@ public:
       const Cesium3DTiles::Schema& schema,
       const SchemaWriterOptions& options = SchemaWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided schema object with the given JSON writer,
+   * without copying the result.
+   *
+   * The JSON writer is reset first, so one writer can be reused to write many
+   * schemas without allocating a new buffer for each. Whether the JSON is
+   * pretty printed depends on the type of the writer.
+   *
+   * @param schema The schema.
+   * @param jsonWriter The JSON writer to write with.
+   * @return The JSON of the schema, which is valid until the JSON writer is
+   * next written to, reset, or destroyed.
+   */
+  std::string_view writeSchema(
+      const Cesium3DTiles::Schema& schema,
+      CesiumJsonWriter::JsonWriter& jsonWriter) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -2,7 +2,14 @@
 
 #include "Cesium3DTilesWriter/Library.h"
 
+#include <Cesium3DTiles/ImplicitTiling.h>
+#include <CesiumAsync/AsyncSystem.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+
+#include <optional>
+#include <string_view>
+#include <vector>
 
 // forward declarations
 namespace Cesium3DTiles {
@@ -17,7 +24,8 @@ namespace Cesium3DTilesWriter {
  */
 struct CESIUM3DTILESWRITER_API SubtreeWriterResult {
   /**
-   * @brief The final generated std::vector<std::byte> of the subtree JSON.
+   * @brief The final generated std::vector<std::byte> of the subtree JSON, or
+   * of the binary subtree if {@link SubtreeWriterOptions::binary} is set.
    */
   std::vector<std::byte> subtreeBytes;
 
@@ -40,6 +48,20 @@ struct CESIUM3DTILESWRITER_API SubtreeWriterOptions {
    * @brief If the subtree JSON should be pretty printed.
    */
   bool prettyPrint = false;
+
+  /**
+   * @brief If the subtree should be written in the binary `.subtree` format,
+   * with the data of its first buffer, which must not have a URI, as the
+   * binary chunk.
+   */
+  bool binary = false;
+
+  /**
+   * @brief The implicit tiling of the subtree. When set, the availability
+   * bitstreams whose bits are all 0 or all 1 are written as constants, as
+   * with {@link SubtreeWriter::compactConstantAvailability}.
+   */
+  std::optional<Cesium3DTiles::ImplicitTiling> implicitTiling;
 };
 
 /**
@@ -74,6 +96,62 @@ public:
       const Cesium3DTiles::Subtree& subtree,
       const SubtreeWriterOptions& options = SubtreeWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided subtree object with the given JSON writer,
+   * without copying the result.
+   *
+   * The JSON writer is reset first, so one writer can be reused to write many
+   * subtrees without allocating a new buffer for each. Whether the JSON is
+   * pretty printed depends on the type of the writer.
+   *
+   * @param subtree The subtree.
+   * @param jsonWriter The JSON writer to write with.
+   * @return The JSON of the subtree, which is valid until the JSON writer is
+   * next written to, reset, or destroyed.
+   */
+  std::string_view writeSubtree(
+      const Cesium3DTiles::Subtree& subtree,
+      CesiumJsonWriter::JsonWriter& jsonWriter) const;
+
+  /**
+   * @brief Serializes many subtrees in parallel in worker threads.
+   *
+   * The subtrees are split into one chunk per hardware thread, and the
+   * subtrees of each chunk are written one after another with a single JSON
+   * writer that is reset for each subtree. The constant availability of
+   * {@link SubtreeWriterOptions::implicitTiling} is detected in the worker
+   * threads too, without copying the subtrees. This writer and its extensions
+   * must not be modified or destroyed until the returned future resolves.
+   *
+   * @param asyncSystem The async system whose worker threads write the
+   * subtrees.
+   * @param subtrees The subtrees.
+   * @param options Options for how to write the subtrees.
+   * @return A future that resolves to the result of writing each subtree, in
+   * the same order as the subtrees.
+   */
+  CesiumAsync::Future<std::vector<SubtreeWriterResult>> writeSubtrees(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      std::vector<Cesium3DTiles::Subtree>&& subtrees,
+      const SubtreeWriterOptions& options = SubtreeWriterOptions()) const;
+
+  /**
+   * @brief Replaces the availability bitstreams of a subtree whose bits are
+   * all 0 or all 1 with constants.
+   *
+   * The buffer views that are no longer used are removed, and the buffers
+   * that have data are rebuilt without them, so that the subtree is smaller
+   * when written and quicker to read. Bitstreams in buffers without data,
+   * such as external buffers that have not been loaded, are left as they are.
+   *
+   * @param subtree The subtree.
+   * @param implicitTiling The implicit tiling of the subtree, which determines
+   * the number of bits in each bitstream.
+   */
+  static void compactConstantAvailability(
+      Cesium3DTiles::Subtree& subtree,
+      const Cesium3DTiles::ImplicitTiling& implicitTiling);
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -2,7 +2,12 @@
 
 #include "Cesium3DTilesWriter/Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+
+#include <string_view>
+#include <vector>
 
 // forward declarations
 namespace Cesium3DTiles {
@@ -74,6 +79,43 @@ public:
       const Cesium3DTiles::Tileset& tileset,
       const TilesetWriterOptions& options = TilesetWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided tileset object with the given JSON writer,
+   * without copying the result.
+   *
+   * The JSON writer is reset first, so one writer can be reused to write many
+   * tilesets without allocating a new buffer for each. Whether the JSON is
+   * pretty printed depends on the type of the writer.
+   *
+   * @param tileset The tileset.
+   * @param jsonWriter The JSON writer to write with.
+   * @return The JSON of the tileset, which is valid until the JSON writer is
+   * next written to, reset, or destroyed.
+   */
+  std::string_view writeTileset(
+      const Cesium3DTiles::Tileset& tileset,
+      CesiumJsonWriter::JsonWriter& jsonWriter) const;
+
+  /**
+   * @brief Serializes many tilesets in parallel in worker threads.
+   *
+   * The tilesets are split into one chunk per hardware thread, and the
+   * tilesets of each chunk are written one after another with a single JSON
+   * writer that is reset for each tileset. This writer and its extensions must
+   * not be modified or destroyed until the returned future resolves.
+   *
+   * @param asyncSystem The async system whose worker threads write the
+   * tilesets.
+   * @param tilesets The tilesets.
+   * @param options Options for how to write the tilesets.
+   * @return A future that resolves to the result of writing each tileset, in
+   * the same order as the tilesets.
+   */
+  CesiumAsync::Future<std::vector<TilesetWriterResult>> writeTilesets(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      std::vector<Cesium3DTiles::Tileset>&& tilesets,
+      const TilesetWriterOptions& options = TilesetWriterOptions()) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
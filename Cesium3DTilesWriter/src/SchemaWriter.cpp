@@ -42,4 +42,14 @@ SchemaWriterResult SchemaWriter::writeSchema(
 
   return result;
 }
+
+std::string_view SchemaWriter::writeSchema(
+    const Cesium3DTiles::Schema& schema,
+    CesiumJsonWriter::JsonWriter& jsonWriter) const {
+  CESIUM_TRACE("SchemaWriter::writeSchema");
+
+  jsonWriter.reset();
+  SchemaJsonWriter::write(schema, jsonWriter, this->getExtensions());
+  return jsonWriter.toStringView();
+}
 } // namespace Cesium3DTilesWriter
@@ -2,13 +2,269 @@
 
 #include "TilesetJsonWriter.h"
 #include "registerWriterExtensions.h"
+#include "writeInParallel.h"
 
+#include <Cesium3DTiles/Subtree.h>
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <gsl/span>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
 namespace Cesium3DTilesWriter {
 
+namespace {
+// The header of a binary subtree, as in the 3D Tiles specification.
+struct SubtreeHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint64_t jsonByteLength;
+  uint64_t binaryByteLength;
+};
+
+size_t padTo8(size_t byteLength) { return (byteLength + 7) / 8 * 8; }
+
+// Writes a binary subtree with the given JSON, padded with spaces, and the
+// data of the first buffer, padded with zeros, if it has no URI.
+std::vector<std::byte> writeBinarySubtree(
+    std::string_view json,
+    const Cesium3DTiles::Subtree& subtree) {
+  gsl::span<const std::byte> binary;
+  if (!subtree.buffers.empty() && !subtree.buffers[0].uri) {
+    binary = subtree.buffers[0].cesium.data;
+  }
+
+  SubtreeHeader header{{'s', 'u', 'b', 't'}, 1, 0, 0};
+  header.jsonByteLength = padTo8(json.size());
+  header.binaryByteLength = padTo8(binary.size());
+
+  std::vector<std::byte> result(
+      sizeof(SubtreeHeader) + header.jsonByteLength + header.binaryByteLength,
+      std::byte(0));
+  std::memcpy(result.data(), &header, sizeof(SubtreeHeader));
+
+  std::byte* pJson = result.data() + sizeof(SubtreeHeader);
+  std::memcpy(pJson, json.data(), json.size());
+  std::fill(pJson + json.size(), pJson + header.jsonByteLength, std::byte(' '));
+
+  if (!binary.empty()) {
+    std::memcpy(pJson + header.jsonByteLength, binary.data(), binary.size());
+  }
+
+  return result;
+}
+
+SubtreeWriterResult writeSubtreeWithWriter(
+    const Cesium3DTiles::Subtree& subtree,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const CesiumJsonWriter::ExtensionWriterContext& context,
+    bool binary) {
+  SubtreeWriterResult result;
+
+  jsonWriter.reset();
+  SubtreeJsonWriter::write(subtree, jsonWriter, context);
+  if (binary) {
+    result.subtreeBytes =
+        writeBinarySubtree(jsonWriter.toStringView(), subtree);
+  } else {
+    result.subtreeBytes = jsonWriter.toBytes();
+  }
+
+  return result;
+}
+
+// Determines if the first `bitCount` bits of the bitstream are all 0 or all 1.
+std::optional<int32_t>
+getConstantValue(gsl::span<const std::byte> bitstream, uint64_t bitCount) {
+  if (bitCount == 0 || bitstream.size() * 8 < bitCount) {
+    return std::nullopt;
+  }
+
+  // Every bit must equal the first one.
+  const uint8_t fill = (std::to_integer<uint8_t>(bitstream[0]) & 1) != 0
+                           ? uint8_t(0xff)
+                           : uint8_t(0x00);
+
+  const size_t fullBytes = static_cast<size_t>(bitCount / 8);
+  for (size_t i = 0; i < fullBytes; ++i) {
+    if (std::to_integer<uint8_t>(bitstream[i]) != fill) {
+      return std::nullopt;
+    }
+  }
+
+  const uint32_t remainingBits = static_cast<uint32_t>(bitCount % 8);
+  if (remainingBits != 0) {
+    const uint8_t mask = static_cast<uint8_t>((1U << remainingBits) - 1);
+    const uint8_t last = std::to_integer<uint8_t>(bitstream[fullBytes]);
+    if ((last & mask) != (fill & mask)) {
+      return std::nullopt;
+    }
+  }
+
+  return fill == 0xff ? Cesium3DTiles::Availability::Constant::AVAILABLE
+                       : Cesium3DTiles::Availability::Constant::UNAVAILABLE;
+}
+
+// Replaces the bitstream with a constant if its bits are all equal, and
+// returns whether it did.
+bool compactAvailability(
+    const Cesium3DTiles::Subtree& subtree,
+    Cesium3DTiles::Availability& availability,
+    uint64_t bitCount) {
+  if (!availability.bitstream || *availability.bitstream < 0 ||
+      size_t(*availability.bitstream) >= subtree.bufferViews.size()) {
+    return false;
+  }
+
+  const Cesium3DTiles::BufferView& bufferView =
+      subtree.bufferViews[size_t(*availability.bitstream)];
+  if (bufferView.buffer < 0 ||
+      size_t(bufferView.buffer) >= subtree.buffers.size() ||
+      bufferView.byteOffset < 0 || bufferView.byteLength < 0) {
+    return false;
+  }
+
+  const std::vector<std::byte>& data =
+      subtree.buffers[size_t(bufferView.buffer)].cesium.data;
+  if (size_t(bufferView.byteOffset + bufferView.byteLength) > data.size()) {
+    return false;
+  }
+
+  const std::optional<int32_t> constant = getConstantValue(
+      gsl::span<const std::byte>(data).subspan(
+          size_t(bufferView.byteOffset),
+          size_t(bufferView.byteLength)),
+      bitCount);
+  if (!constant) {
+    return false;
+  }
+
+  availability.bitstream.reset();
+  availability.availableCount.reset();
+  availability.constant = *constant;
+  return true;
+}
+
+// Calls the callback with each reference to a buffer view in the subtree.
+template <typename Callback>
+void forEachBufferViewIndex(Cesium3DTiles::Subtree& subtree, Callback&& f) {
+  auto visitAvailability = [&f](Cesium3DTiles::Availability& availability) {
+    if (availability.bitstream) {
+      f(*availability.bitstream);
+    }
+  };
+
+  visitAvailability(subtree.tileAvailability);
+  for (Cesium3DTiles::Availability& availability :
+       subtree.contentAvailability) {
+    visitAvailability(availability);
+  }
+  visitAvailability(subtree.childSubtreeAvailability);
+
+  for (Cesium3DTiles::PropertyTable& propertyTable : subtree.propertyTables) {
+    for (auto& [name, property] : propertyTable.properties) {
+      f(property.values);
+      if (property.arrayOffsets) {
+        f(*property.arrayOffsets);
+      }
+      if (property.stringOffsets) {
+        f(*property.stringOffsets);
+      }
+    }
+  }
+}
+
+// Removes the buffer views that are not referenced anymore, and rebuilds the
+// buffers that have data from the views that remain.
+void removeUnusedBufferViews(Cesium3DTiles::Subtree& subtree) {
+  std::vector<int64_t> newIndices(subtree.bufferViews.size(), -1);
+  forEachBufferViewIndex(subtree, [&newIndices](int64_t& index) {
+    if (index >= 0 && size_t(index) < newIndices.size()) {
+      newIndices[size_t(index)] = 0;
+    }
+  });
+
+  std::vector<Cesium3DTiles::BufferView> bufferViews;
+  std::vector<bool> bufferChanged(subtree.buffers.size(), false);
+  for (size_t i = 0; i < subtree.bufferViews.size(); ++i) {
+    Cesium3DTiles::BufferView& bufferView = subtree.bufferViews[i];
+    if (newIndices[i] < 0) {
+      if (bufferView.buffer >= 0 &&
+          size_t(bufferView.buffer) < bufferChanged.size()) {
+        bufferChanged[size_t(bufferView.buffer)] = true;
+      }
+      continue;
+    }
+
+    newIndices[i] = int64_t(bufferViews.size());
+    bufferViews.emplace_back(std::move(bufferView));
+  }
+
+  subtree.bufferViews = std::move(bufferViews);
+  forEachBufferViewIndex(subtree, [&newIndices](int64_t& index) {
+    if (index >= 0 && size_t(index) < newIndices.size()) {
+      index = newIndices[size_t(index)];
+    }
+  });
+
+  for (size_t bufferIndex = 0; bufferIndex < subtree.buffers.size();
+       ++bufferIndex) {
+    Cesium3DTiles::Buffer& buffer = subtree.buffers[bufferIndex];
+    if (!bufferChanged[bufferIndex] || buffer.cesium.data.empty()) {
+      continue;
+    }
+
+    std::vector<Cesium3DTiles::BufferView*> views;
+    for (Cesium3DTiles::BufferView& bufferView : subtree.bufferViews) {
+      if (bufferView.buffer == int64_t(bufferIndex)) {
+        views.emplace_back(&bufferView);
+      }
+    }
+    std::sort(
+        views.begin(),
+        views.end(),
+        [](const Cesium3DTiles::BufferView* pLeft,
+           const Cesium3DTiles::BufferView* pRight) {
+          return pLeft->byteOffset < pRight->byteOffset;
+        });
+
+    // Views that lie within the previously copied view share its copy.
+    std::vector<std::byte> data;
+    int64_t copiedBegin = 0;
+    int64_t copiedEnd = 0;
+    int64_t copiedNewBegin = 0;
+    for (Cesium3DTiles::BufferView* pView : views) {
+      const int64_t begin = pView->byteOffset;
+      const int64_t end = begin + pView->byteLength;
+      if (begin < 0 || end > int64_t(buffer.cesium.data.size())) {
+        continue;
+      }
+
+      if (begin < copiedBegin || end > copiedEnd) {
+        copiedBegin = begin;
+        copiedEnd = end;
+        copiedNewBegin = int64_t(padTo8(data.size()));
+        data.resize(size_t(copiedNewBegin));
+        data.insert(
+            data.end(),
+            buffer.cesium.data.begin() + begin,
+            buffer.cesium.data.begin() + end);
+      }
+
+      pView->byteOffset = copiedNewBegin + (begin - copiedBegin);
+    }
+
+    buffer.cesium.data = std::move(data);
+    buffer.byteLength = int64_t(buffer.cesium.data.size());
+  }
+}
+} // namespace
+
 SubtreeWriter::SubtreeWriter() { registerWriterExtensions(this->_context); }
 
 CesiumJsonWriter::ExtensionWriterContext& SubtreeWriter::getExtensions() {
@@ -28,7 +284,6 @@ SubtreeWriterResult SubtreeWriter::writeSubtree(
   const CesiumJsonWriter::ExtensionWriterContext& context =
       this->getExtensions();
 
-  SubtreeWriterResult result;
   std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
 
   if (options.prettyPrint) {
@@ -37,9 +292,87 @@ SubtreeWriterResult SubtreeWriter::writeSubtree(
     writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
   }
 
-  SubtreeJsonWriter::write(subtree, *writer, context);
-  result.subtreeBytes = writer->toBytes();
+  if (options.implicitTiling) {
+    Cesium3DTiles::Subtree compacted = subtree;
+    compactConstantAvailability(compacted, *options.implicitTiling);
+    return writeSubtreeWithWriter(compacted, *writer, context, options.binary);
+  }
+
+  return writeSubtreeWithWriter(subtree, *writer, context, options.binary);
+}
 
-  return result;
+std::string_view SubtreeWriter::writeSubtree(
+    const Cesium3DTiles::Subtree& subtree,
+    CesiumJsonWriter::JsonWriter& jsonWriter) const {
+  CESIUM_TRACE("SubtreeWriter::writeSubtree");
+
+  jsonWriter.reset();
+  SubtreeJsonWriter::write(subtree, jsonWriter, this->getExtensions());
+  return jsonWriter.toStringView();
+}
+
+CesiumAsync::Future<std::vector<SubtreeWriterResult>>
+SubtreeWriter::writeSubtrees(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    std::vector<Cesium3DTiles::Subtree>&& subtrees,
+    const SubtreeWriterOptions& options) const {
+  return writeInParallel<SubtreeWriterResult>(
+      asyncSystem,
+      std::move(subtrees),
+      options.prettyPrint,
+      [this, options](
+          Cesium3DTiles::Subtree& subtree,
+          CesiumJsonWriter::JsonWriter& jsonWriter) {
+        CESIUM_TRACE("SubtreeWriter::writeSubtrees");
+
+        if (options.implicitTiling) {
+          compactConstantAvailability(subtree, *options.implicitTiling);
+        }
+
+        return writeSubtreeWithWriter(
+            subtree,
+            jsonWriter,
+            this->getExtensions(),
+            options.binary);
+      });
+}
+
+/*static*/ void SubtreeWriter::compactConstantAvailability(
+    Cesium3DTiles::Subtree& subtree,
+    const Cesium3DTiles::ImplicitTiling& implicitTiling) {
+  const uint64_t childCount =
+      implicitTiling.subdivisionScheme ==
+              Cesium3DTiles::ImplicitTiling::SubdivisionScheme::OCTREE
+          ? 8
+          : 4;
+
+  // A subtree with L levels has (N^L - 1) / (N - 1) tiles and N^L child
+  // subtrees, where N is the number of children of each tile.
+  uint64_t childSubtreeCount = 1;
+  for (int64_t level = 0; level < implicitTiling.subtreeLevels; ++level) {
+    childSubtreeCount *= childCount;
+  }
+  const uint64_t tileCount = (childSubtreeCount - 1) / (childCount - 1);
+
+  size_t compactedCount = 0;
+  if (compactAvailability(subtree, subtree.tileAvailability, tileCount)) {
+    ++compactedCount;
+  }
+  for (Cesium3DTiles::Availability& availability :
+       subtree.contentAvailability) {
+    if (compactAvailability(subtree, availability, tileCount)) {
+      ++compactedCount;
+    }
+  }
+  if (compactAvailability(
+          subtree,
+          subtree.childSubtreeAvailability,
+          childSubtreeCount)) {
+    ++compactedCount;
+  }
+
+  if (compactedCount > 0) {
+    removeUnusedBufferViews(subtree);
+  }
 }
 } // namespace Cesium3DTilesWriter
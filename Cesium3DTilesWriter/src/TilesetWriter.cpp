@@ -2,6 +2,7 @@
 
 #include "TilesetJsonWriter.h"
 #include "registerWriterExtensions.h"
+#include "writeInParallel.h"
 
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
@@ -42,4 +43,36 @@ TilesetWriterResult TilesetWriter::writeTileset(
 
   return result;
 }
+
+std::string_view TilesetWriter::writeTileset(
+    const Cesium3DTiles::Tileset& tileset,
+    CesiumJsonWriter::JsonWriter& jsonWriter) const {
+  CESIUM_TRACE("TilesetWriter::writeTileset");
+
+  jsonWriter.reset();
+  TilesetJsonWriter::write(tileset, jsonWriter, this->getExtensions());
+  return jsonWriter.toStringView();
+}
+
+CesiumAsync::Future<std::vector<TilesetWriterResult>>
+TilesetWriter::writeTilesets(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    std::vector<Cesium3DTiles::Tileset>&& tilesets,
+    const TilesetWriterOptions& options) const {
+  return writeInParallel<TilesetWriterResult>(
+      asyncSystem,
+      std::move(tilesets),
+      options.prettyPrint,
+      [this](
+          const Cesium3DTiles::Tileset& tileset,
+          CesiumJsonWriter::JsonWriter& jsonWriter) {
+        CESIUM_TRACE("TilesetWriter::writeTilesets");
+
+        TilesetWriterResult result;
+        jsonWriter.reset();
+        TilesetJsonWriter::write(tileset, jsonWriter, this->getExtensions());
+        result.tilesetBytes = jsonWriter.toBytes();
+        return result;
+      });
+}
 } // namespace Cesium3DTilesWriter
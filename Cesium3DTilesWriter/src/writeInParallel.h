@@ -0,0 +1,68 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Cesium3DTilesWriter {
+/**
+ * Calls `write` for each of the items in worker threads, and resolves to the
+ * results in the same order as the items.
+ *
+ * The items are split into one contiguous chunk per hardware thread. Each
+ * chunk is written in a single worker thread with a single JSON writer, which
+ * is reset for each item, so its buffer is only allocated once per chunk.
+ */
+template <typename TResult, typename TItem, typename TWrite>
+CesiumAsync::Future<std::vector<TResult>> writeInParallel(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    std::vector<TItem>&& items,
+    bool prettyPrint,
+    TWrite&& write) {
+  struct State {
+    std::vector<TItem> items;
+    std::vector<TResult> results;
+  };
+
+  auto pState = std::make_shared<State>();
+  pState->items = std::move(items);
+  pState->results.resize(pState->items.size());
+
+  const size_t itemCount = pState->items.size();
+  const size_t chunkCount = std::min(
+      itemCount,
+      size_t(std::max(1U, std::thread::hardware_concurrency())));
+
+  std::vector<CesiumAsync::Future<size_t>> futures;
+  futures.reserve(chunkCount);
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+    const size_t begin = itemCount * chunk / chunkCount;
+    const size_t end = itemCount * (chunk + 1) / chunkCount;
+    futures.emplace_back(asyncSystem.runInWorkerThread(
+        [pState, begin, end, prettyPrint, write]() {
+          std::unique_ptr<CesiumJsonWriter::JsonWriter> pWriter;
+          if (prettyPrint) {
+            pWriter = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+          } else {
+            pWriter = std::make_unique<CesiumJsonWriter::JsonWriter>();
+          }
+
+          for (size_t i = begin; i < end; ++i) {
+            pState->results[i] = write(pState->items[i], *pWriter);
+          }
+          return end - begin;
+        }));
+  }
+
+  return asyncSystem.all(std::move(futures))
+      .thenImmediately([pState](std::vector<size_t>&&) {
+        return std::move(pState->results);
+      });
+}
+} // namespace Cesium3DTilesWriter
@@ -0,0 +1,135 @@
+#include "Cesium3DTilesWriter/SubtreeWriter.h"
+
+#include <Cesium3DTiles/Subtree.h>
+#include <CesiumNativeTests/ThreadTaskProcessor.h>
+#include <CesiumNativeTests/waitForFuture.h>
+
+#include <catch2/catch.hpp>
+#include <rapidjson/document.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTiles;
+using namespace Cesium3DTilesWriter;
+
+namespace {
+// A quadtree subtree with two levels, so five tiles and 16 child subtrees,
+// whose tiles are all available, whose content is partly available, and
+// whose child subtrees are all unavailable.
+Subtree createSubtree() {
+  Subtree subtree;
+
+  Buffer& buffer = subtree.buffers.emplace_back();
+  buffer.cesium.data.resize(18, std::byte(0));
+  buffer.cesium.data[0] = std::byte(0x1f);
+  buffer.cesium.data[8] = std::byte(0x0b);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  for (int64_t byteOffset : {0, 8, 16}) {
+    BufferView& bufferView = subtree.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteOffset = byteOffset;
+    bufferView.byteLength = byteOffset == 16 ? 2 : 1;
+  }
+
+  subtree.tileAvailability.bitstream = 0;
+  subtree.tileAvailability.availableCount = 5;
+  subtree.contentAvailability.emplace_back().bitstream = 1;
+  subtree.childSubtreeAvailability.bitstream = 2;
+  return subtree;
+}
+
+ImplicitTiling createImplicitTiling() {
+  ImplicitTiling implicitTiling;
+  implicitTiling.subdivisionScheme =
+      ImplicitTiling::SubdivisionScheme::QUADTREE;
+  implicitTiling.subtreeLevels = 2;
+  return implicitTiling;
+}
+} // namespace
+
+TEST_CASE("SubtreeWriter::compactConstantAvailability") {
+  Subtree subtree = createSubtree();
+  SubtreeWriter::compactConstantAvailability(subtree, createImplicitTiling());
+
+  CHECK(!subtree.tileAvailability.bitstream);
+  CHECK(!subtree.tileAvailability.availableCount);
+  CHECK(subtree.tileAvailability.constant == Availability::Constant::AVAILABLE);
+
+  CHECK(
+      subtree.childSubtreeAvailability.constant ==
+      Availability::Constant::UNAVAILABLE);
+
+  // The content availability is the only bitstream left.
+  REQUIRE(subtree.contentAvailability.size() == 1);
+  CHECK(subtree.contentAvailability[0].bitstream == 0);
+  REQUIRE(subtree.bufferViews.size() == 1);
+  CHECK(subtree.bufferViews[0].byteOffset == 0);
+  CHECK(subtree.bufferViews[0].byteLength == 1);
+  REQUIRE(subtree.buffers[0].cesium.data.size() == 1);
+  CHECK(subtree.buffers[0].cesium.data[0] == std::byte(0x0b));
+  CHECK(subtree.buffers[0].byteLength == 1);
+}
+
+TEST_CASE("Writes binary subtrees") {
+  SubtreeWriterOptions options;
+  options.binary = true;
+  options.implicitTiling = createImplicitTiling();
+
+  SubtreeWriter writer;
+  SubtreeWriterResult result = writer.writeSubtree(createSubtree(), options);
+  REQUIRE(result.errors.empty());
+
+  const std::vector<std::byte>& bytes = result.subtreeBytes;
+  REQUIRE(bytes.size() >= 24);
+  CHECK(std::memcmp(bytes.data(), "subt", 4) == 0);
+
+  uint32_t version;
+  uint64_t jsonByteLength;
+  uint64_t binaryByteLength;
+  std::memcpy(&version, bytes.data() + 4, sizeof(version));
+  std::memcpy(&jsonByteLength, bytes.data() + 8, sizeof(jsonByteLength));
+  std::memcpy(&binaryByteLength, bytes.data() + 16, sizeof(binaryByteLength));
+  CHECK(version == 1);
+  CHECK(jsonByteLength % 8 == 0);
+  CHECK(binaryByteLength == 8);
+  REQUIRE(bytes.size() == 24 + jsonByteLength + binaryByteLength);
+  CHECK(bytes[24 + jsonByteLength] == std::byte(0x0b));
+
+  const std::string json(
+      reinterpret_cast<const char*>(bytes.data() + 24),
+      jsonByteLength);
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+  REQUIRE(!document.HasParseError());
+  CHECK(document["tileAvailability"]["constant"].GetInt() == 1);
+  CHECK(document["childSubtreeAvailability"]["constant"].GetInt() == 0);
+  CHECK(document["bufferViews"].Size() == 1);
+}
+
+TEST_CASE("Writes subtrees in parallel") {
+  CesiumAsync::AsyncSystem asyncSystem(
+      std::make_shared<CesiumNativeTests::ThreadTaskProcessor>());
+
+  SubtreeWriterOptions options;
+  options.binary = true;
+  options.implicitTiling = createImplicitTiling();
+
+  SubtreeWriter writer;
+  const std::vector<std::byte> expected =
+      writer.writeSubtree(createSubtree(), options).subtreeBytes;
+
+  std::vector<Subtree> subtrees(20, createSubtree());
+  std::vector<SubtreeWriterResult> results = CesiumNativeTests::waitForFuture(
+      asyncSystem,
+      writer.writeSubtrees(asyncSystem, std::move(subtrees), options));
+
+  REQUIRE(results.size() == 20);
+  for (const SubtreeWriterResult& result : results) {
+    CHECK(result.errors.empty());
+    CHECK(result.subtreeBytes == expected);
+  }
+}
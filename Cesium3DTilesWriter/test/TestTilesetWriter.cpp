@@ -2,6 +2,9 @@
 
 #include <Cesium3DTiles/Extension3dTilesBoundingVolumeS2.h>
 #include <Cesium3DTilesReader/TilesetReader.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumNativeTests/ThreadTaskProcessor.h>
+#include <CesiumNativeTests/waitForFuture.h>
 
 #include <catch2/catch.hpp>
 #include <rapidjson/document.h>
@@ -266,3 +269,75 @@ TEST_CASE("Writes tileset with prettyPrint") {
 
   REQUIRE(hasSpaces(tilesetStringPretty));
 }
+
+TEST_CASE("Writes tilesets with a reused JSON writer") {
+  Cesium3DTiles::Tileset first;
+  first.asset.version = "1.0";
+  first.geometricError = 100.0;
+
+  Cesium3DTiles::Tileset second;
+  second.asset.version = "1.1";
+  second.geometricError = 5.0;
+  second.root.geometricError = 2.0;
+
+  Cesium3DTilesWriter::TilesetWriter writer;
+
+  auto toString = [](const std::vector<std::byte>& bytes) {
+    return std::string(
+        reinterpret_cast<const char*>(bytes.data()),
+        bytes.size());
+  };
+
+  SECTION("compact") {
+    CesiumJsonWriter::JsonWriter jsonWriter;
+    const std::string firstJson(writer.writeTileset(first, jsonWriter));
+    CHECK(firstJson == toString(writer.writeTileset(first).tilesetBytes));
+
+    const std::string secondJson(writer.writeTileset(second, jsonWriter));
+    CHECK(secondJson == toString(writer.writeTileset(second).tilesetBytes));
+  }
+
+  SECTION("pretty") {
+    Cesium3DTilesWriter::TilesetWriterOptions options;
+    options.prettyPrint = true;
+
+    CesiumJsonWriter::PrettyJsonWriter jsonWriter;
+    const std::string firstJson(writer.writeTileset(first, jsonWriter));
+    CHECK(
+        firstJson ==
+        toString(writer.writeTileset(first, options).tilesetBytes));
+
+    const std::string secondJson(writer.writeTileset(second, jsonWriter));
+    CHECK(
+        secondJson ==
+        toString(writer.writeTileset(second, options).tilesetBytes));
+  }
+}
+
+TEST_CASE("Writes tilesets in parallel") {
+  CesiumAsync::AsyncSystem asyncSystem(
+      std::make_shared<CesiumNativeTests::ThreadTaskProcessor>());
+
+  std::vector<Cesium3DTiles::Tileset> tilesets(20);
+  for (size_t i = 0; i < tilesets.size(); ++i) {
+    tilesets[i].asset.version = "1.1";
+    tilesets[i].geometricError = double(i);
+  }
+
+  Cesium3DTilesWriter::TilesetWriter writer;
+  std::vector<std::vector<std::byte>> expected;
+  for (const Cesium3DTiles::Tileset& tileset : tilesets) {
+    expected.emplace_back(writer.writeTileset(tileset).tilesetBytes);
+  }
+
+  std::vector<Cesium3DTilesWriter::TilesetWriterResult> results =
+      CesiumNativeTests::waitForFuture(
+          asyncSystem,
+          writer.writeTilesets(asyncSystem, std::move(tilesets)));
+
+  REQUIRE(results.size() == expected.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    CHECK(results[i].errors.empty());
+    CHECK(results[i].tilesetBytes == expected[i]);
+  }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CancellationToken.h"
+#include "Library.h"
+#include "TaskPriority.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The priority of a request made with
+ * {@link IAssetAccessor::getWithOptions}, which may change while the request
+ * is queued or in progress.
+ *
+ * The requester keeps the instance and updates it, such as when a tile that is
+ * loading comes closer to the center of the view. An accessor that queues its
+ * requests reads it again whenever it chooses the next request to send, and
+ * an accessor for a protocol with stream priorities, like HTTP/2 or HTTP/3,
+ * may send the new priority to the server. This class is thread-safe.
+ */
+class CESIUMASYNC_API AssetRequestPriority final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param urgency The group of the request. Every request of a more urgent
+   * group should be sent before any request of a less urgent one.
+   * @param priority The order of the request within its group. Requests with
+   * a _lower_ value should be sent sooner.
+   */
+  explicit AssetRequestPriority(
+      TaskPriority urgency = TaskPriority::Normal,
+      double priority = 0.0) noexcept;
+
+  /**
+   * @brief Gets the group of the request.
+   */
+  TaskPriority getUrgency() const noexcept;
+
+  /**
+   * @brief Gets the order of the request within its group. Requests with a
+   * _lower_ value should be sent sooner.
+   */
+  double getPriority() const noexcept;
+
+  /**
+   * @brief Changes the priority of the request.
+   *
+   * @param urgency The new group of the request.
+   * @param priority The new order of the request within its group.
+   */
+  void set(TaskPriority urgency, double priority) noexcept;
+
+  /**
+   * @brief Gets the value of the HTTP `Priority` header, as defined by
+   * RFC 9218, that corresponds to the urgency of the request, such as `u=3`
+   * for {@link TaskPriority::Normal}.
+   *
+   * The order within the group has no equivalent in the header.
+   */
+  std::string getHttpPriorityHeaderValue() const;
+
+private:
+  mutable std::mutex _mutex;
+  TaskPriority _urgency;
+  double _priority;
+};
+
+/**
+ * @brief Options for a request made with
+ * {@link IAssetAccessor::getWithOptions}.
+ *
+ * Every option is a hint. An accessor that ignores them still produces a
+ * correct response, if not as soon as it could have.
+ */
+struct CESIUMASYNC_API AssetRequestOptions {
+  /**
+   * @brief The priority of the request, or nullptr if it has the priority of
+   * the calling task, from {@link getCurrentTaskPriority}.
+   */
+  std::shared_ptr<const AssetRequestPriority> pPriority = nullptr;
+
+  /**
+   * @brief The token that reports when the asset is no longer needed.
+   *
+   * An accessor that abandons the request should resolve it with a request
+   * that has no response.
+   */
+  CancellationToken cancellationToken{};
+
+  /**
+   * @brief The time after which the asset is no longer useful, if any.
+   *
+   * An accessor may abandon a request that is still queued or in progress at
+   * this time, as it would a canceled one.
+   */
+  std::optional<std::chrono::steady_clock::time_point> deadline =
+      std::nullopt;
+};
+
+} // namespace CesiumAsync
@@ -42,6 +42,26 @@ public:
    */
   AsyncSystem(const std::shared_ptr<ITaskProcessor>& pTaskProcessor) noexcept;
 
+  /**
+   * @brief Constructs a new instance with separate task processors for
+   * CPU-bound and I/O-bound work.
+   *
+   * Work started with {@link runInIOThread} or {@link Future::thenInIOThread},
+   * such as blocking file and cache reads, runs with `pIOTaskProcessor`. All
+   * other worker thread work, such as decoding, runs with `pTaskProcessor`.
+   * That lets a renderer keep every core busy with CPU-bound work while
+   * additional threads wait on I/O.
+   *
+   * @param pTaskProcessor The interface used to run CPU-bound tasks in
+   * background threads.
+   * @param pIOTaskProcessor The interface used to run I/O-bound tasks in
+   * background threads. If nullptr, I/O-bound tasks also use
+   * `pTaskProcessor`.
+   */
+  AsyncSystem(
+      const std::shared_ptr<ITaskProcessor>& pTaskProcessor,
+      const std::shared_ptr<ITaskProcessor>& pIOTaskProcessor) noexcept;
+
   /**
    * @brief Creates a new Future by immediately invoking a function and giving
    * it the opportunity to resolve or reject a {@link Promise}.
@@ -120,7 +140,74 @@ public:
     return CesiumImpl::ContinuationFutureType_t<Func, void>(
         this->_pSchedulers,
         async::spawn(
-            this->_pSchedulers->workerThread.immediate,
+            this->_pSchedulers->workerThread.immediate(),
+            CesiumImpl::WithTracing<void>::end(
+                tracingName,
+                std::forward<Func>(f))));
+  }
+
+  /**
+   * @brief Runs a function in a new worker thread task, returning a Future
+   * that resolves when the function completes.
+   *
+   * Unlike {@link runInWorkerThread}, the function is never invoked
+   * immediately, even when this method is called from a worker thread. This
+   * lets a worker thread task hand independent parts of its work to other
+   * worker threads. The calling task must not block waiting for a function
+   * started this way, because that function may be queued behind the calling
+   * task itself. It may instead do the work itself if the function hasn't
+   * started yet.
+   *
+   * If the function itself returns a `Future`, the function will not be
+   * considered complete until that returned `Future` also resolves.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, void>
+  runInNewWorkerTask(Func&& f) const {
+    static const char* tracingName = "waiting for worker thread";
+
+    CESIUM_TRACE_BEGIN_IN_TRACK(tracingName);
+
+    return CesiumImpl::ContinuationFutureType_t<Func, void>(
+        this->_pSchedulers,
+        async::spawn(
+            this->_pSchedulers->workerThread.deferred(),
+            CesiumImpl::WithTracing<void>::end(
+                tracingName,
+                std::forward<Func>(f))));
+  }
+
+  /**
+   * @brief Runs an I/O-bound function in a background thread, returning a
+   * Future that resolves when the function completes.
+   *
+   * The function runs with the I/O task processor given to the constructor,
+   * or with the worker thread task processor if there isn't one. If the
+   * function itself returns a `Future`, the function will not be considered
+   * complete until that returned `Future` also resolves.
+   *
+   * If this method is called from a designated I/O thread, the callback will
+   * be invoked immediately and complete before this function returns.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, void>
+  runInIOThread(Func&& f) const {
+    static const char* tracingName = "waiting for I/O thread";
+
+    CESIUM_TRACE_BEGIN_IN_TRACK(tracingName);
+
+    return CesiumImpl::ContinuationFutureType_t<Func, void>(
+        this->_pSchedulers,
+        async::spawn(
+            this->_pSchedulers->ioThread().immediate(),
             CesiumImpl::WithTracing<void>::end(
                 tracingName,
                 std::forward<Func>(f))));
@@ -256,6 +343,25 @@ public:
    */
   void dispatchMainThreadTasks();
 
+  /**
+   * @brief Runs tasks that are queued for the main thread until they have all
+   * run or the given time has elapsed.
+   *
+   * Tasks run in priority order: a continuation takes the
+   * {@link TaskPriority} that is current when it is scheduled, and tasks of a
+   * higher priority run before tasks of a lower one. The time is checked after
+   * each task, so at least one task runs if any are queued, and a single long
+   * task may exceed the limit. Tasks that don't run stay queued for a later
+   * dispatch.
+   *
+   * The tasks are run in the calling thread.
+   *
+   * @param maximumTimeInMilliseconds The time after which no further tasks are
+   * started.
+   * @return True if no tasks remain queued, or false if the time ran out first.
+   */
+  bool dispatchMainThreadTasks(double maximumTimeInMilliseconds);
+
   /**
    * @brief Runs a single waiting task that is currently queued for the main
    * thread. If there are no tasks waiting, it returns immediately without
@@ -276,6 +382,52 @@ public:
    */
   ThreadPool createThreadPool(int32_t numberOfThreads) const;
 
+  /**
+   * @brief Gets an object that a C++20 coroutine can `co_await` to continue
+   * in a worker thread.
+   *
+   * If the coroutine is already running in a worker thread, it continues
+   * immediately. The coroutine continues with the {@link TaskPriority} that
+   * is current when this method is called.
+   *
+   * @return The awaitable object.
+   */
+  auto workerThread() const {
+    return CesiumImpl::SchedulerAwaitable(
+        this->_pSchedulers,
+        this->_pSchedulers->workerThread.immediate());
+  }
+
+  /**
+   * @brief Gets an object that a C++20 coroutine can `co_await` to continue
+   * in an I/O thread.
+   *
+   * See {@link runInIOThread} for the thread that is used.
+   *
+   * @return The awaitable object.
+   */
+  auto ioThread() const {
+    return CesiumImpl::SchedulerAwaitable(
+        this->_pSchedulers,
+        this->_pSchedulers->ioThread().immediate());
+  }
+
+  /**
+   * @brief Gets an object that a C++20 coroutine can `co_await` to continue
+   * in the main thread.
+   *
+   * If the coroutine is already running in the main thread, it continues
+   * immediately. Otherwise, it continues the next time
+   * {@link dispatchMainThreadTasks} is called.
+   *
+   * @return The awaitable object.
+   */
+  auto mainThread() const {
+    return CesiumImpl::SchedulerAwaitable(
+        this->_pSchedulers,
+        this->_pSchedulers->mainThread.immediate);
+  }
+
   /**
    * Returns true if this instance and the right-hand side can be used
    * interchangeably because they schedule continuations identically. Otherwise,
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <ctime>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace CesiumAsync {
@@ -117,4 +118,20 @@ public:
    */
   CacheResponse cacheResponse;
 };
+
+/**
+ * @brief A cache item and the key that it is stored with, such as when cache
+ * entries are imported into or exported from a cache database in bulk.
+ */
+struct CESIUMASYNC_API CacheEntry {
+  /**
+   * @brief The unique key associated with the cache item.
+   */
+  std::string key;
+
+  /**
+   * @brief The cache item.
+   */
+  CacheItem item;
+};
 } // namespace CesiumAsync
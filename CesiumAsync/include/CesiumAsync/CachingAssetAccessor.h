@@ -9,8 +9,10 @@
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -21,9 +23,108 @@ class AsyncSystem;
  *
  * This can be used to improve asset loading performance by caching assets
  * across runs.
+ *
+ * Concurrent `get` requests for the same URL and headers are coalesced: while
+ * a request is in flight, later identical requests share its result instead of
+ * starting another cache lookup and network request.
+ *
+ * A stale cached response is normally revalidated with the server before it is
+ * returned. With a {@link StaleWhileRevalidate} policy other than
+ * {@link StaleWhileRevalidate::Never}, it may instead be returned immediately,
+ * while the revalidation updates the cache in the background.
+ *
+ * Responses that report that there is no content, `404 Not Found` and
+ * `204 No Content`, are normally only cached if their headers allow it. With a
+ * negative cache duration, they are cached for that long otherwise, so that
+ * sparse imagery or terrain servers are not asked for the same missing tiles
+ * in every session.
+ *
+ * Responses are cached under a key computed from the request by a
+ * {@link CacheKeyFunction}. By default the key is the URL, so a URL with a
+ * short-lived access token in its query string is cached again every time the
+ * token changes. {@link createCacheKeyFunction} creates a function that leaves
+ * such query parameters out of the key.
  */
 class CachingAssetAccessor : public IAssetAccessor {
 public:
+  /**
+   * @brief When a stale cached response is returned without waiting for its
+   * revalidation.
+   *
+   * A response with a `no-cache` or `must-revalidate` directive in its
+   * `Cache-Control` header is always revalidated before it is returned.
+   */
+  enum class StaleWhileRevalidate {
+    /**
+     * @brief Always wait for the revalidation of a stale response.
+     */
+    Never,
+
+    /**
+     * @brief Return a stale response immediately if it is within the time
+     * allowed by the `stale-while-revalidate` directive of its `Cache-Control`
+     * header.
+     */
+    CacheControl,
+
+    /**
+     * @brief Always return a stale response immediately.
+     */
+    Always
+  };
+
+  /**
+   * @brief Computes the key under which the response to a `GET` request for
+   * the given URL, with the given headers, is cached.
+   *
+   * Requests with the same key share a cached response, so the key must
+   * include every part of the request that can change the response.
+   */
+  using CacheKeyFunction = std::function<std::string(
+      const std::string& url,
+      const std::vector<THeader>& headers)>;
+
+  /**
+   * @brief A query parameter that {@link createCacheKeyFunction} leaves out of
+   * cache keys.
+   */
+  struct IgnoredQueryParameter {
+    /**
+     * @brief The name of the query parameter.
+     */
+    std::string name;
+
+    /**
+     * @brief The host of the URLs from which the parameter is removed, which
+     * also matches its subdomains. If this is empty, the parameter is removed
+     * from URLs with any host.
+     */
+    std::string host;
+  };
+
+  /**
+   * @brief Gets the query parameters that carry short-lived access tokens and
+   * session keys of well-known services, and don't change their responses.
+   *
+   * These are the `access_token` parameter of Cesium ion asset URLs, and the
+   * `key` parameter of Bing Maps URLs, which can be a session key.
+   */
+  static const std::vector<IgnoredQueryParameter>& getTokenQueryParameters();
+
+  /**
+   * @brief Creates a {@link CacheKeyFunction} that uses the URL without the
+   * given query parameters as the key.
+   *
+   * Headers are never part of the key, so a token sent in a header, such as
+   * `Authorization`, doesn't change it either.
+   *
+   * @param ignoredQueryParameters The query parameters to leave out, such as
+   * those from {@link getTokenQueryParameters}.
+   */
+  static CacheKeyFunction createCacheKeyFunction(
+      const std::vector<IgnoredQueryParameter>& ignoredQueryParameters =
+          getTokenQueryParameters());
+
   /**
    * @brief Constructs a new instance.
    *
@@ -35,12 +136,22 @@ public:
    * responses.
    * @param requestsPerCachePrune The number of requests to handle before each
    * {@link ICacheDatabase::prune} of old cached results from the database.
+   * @param staleWhileRevalidate When to return a stale cached response without
+   * waiting for its revalidation.
+   * @param negativeCacheDuration The time, in seconds, for which `404 Not
+   * Found` and `204 No Content` responses whose headers don't allow caching
+   * are cached anyway. Zero doesn't cache them.
+   * @param cacheKeyFunction Computes the key under which each response is
+   * cached. If it is empty, the URL is used.
    */
   CachingAssetAccessor(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-      int32_t requestsPerCachePrune = 10000);
+      int32_t requestsPerCachePrune = 10000,
+      StaleWhileRevalidate staleWhileRevalidate = StaleWhileRevalidate::Never,
+      int32_t negativeCacheDuration = 0,
+      CacheKeyFunction cacheKeyFunction = CacheKeyFunction());
 
   virtual ~CachingAssetAccessor() noexcept override;
 
@@ -61,12 +172,23 @@ public:
   virtual void tick() noexcept override;
 
 private:
+  Future<std::shared_ptr<IAssetRequest>> _getWithoutCoalescing(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+
+  struct InFlightRequests;
+
   int32_t _requestsPerCachePrune;
+  StaleWhileRevalidate _staleWhileRevalidate;
+  int32_t _negativeCacheDuration;
+  CacheKeyFunction _cacheKeyFunction;
   std::atomic<int32_t> _requestSinceLastPrune;
   std::shared_ptr<spdlog::logger> _pLogger;
   std::shared_ptr<IAssetAccessor> _pAssetAccessor;
   std::shared_ptr<ICacheDatabase> _pCacheDatabase;
   ThreadPool _cacheThreadPool;
+  std::shared_ptr<InFlightRequests> _pInFlightRequests;
   CESIUM_TRACE_DECLARE_TRACK_SET(_pruneSlots, "Prune cache database");
 };
 } // namespace CesiumAsync
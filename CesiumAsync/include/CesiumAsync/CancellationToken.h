@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Reports whether the work it was passed to is no longer needed.
+ *
+ * Long-running work checks {@link isCanceled} at convenient points and stops
+ * early if it returns true. Cancellation is advisory: work that ignores the
+ * token still produces a correct, if unwanted, result.
+ *
+ * Tokens are obtained from a {@link CancellationTokenSource}. A
+ * default-constructed token is never canceled. Tokens are cheap to copy and may
+ * be checked from any thread.
+ */
+class CancellationToken {
+public:
+  /**
+   * @brief Creates a token that is never canceled.
+   */
+  CancellationToken() noexcept = default;
+
+  /**
+   * @brief Returns true if the {@link CancellationTokenSource} that created
+   * this token has been canceled.
+   */
+  bool isCanceled() const noexcept {
+    return this->_pCanceled &&
+           this->_pCanceled->load(std::memory_order_relaxed);
+  }
+
+private:
+  explicit CancellationToken(
+      const std::shared_ptr<const std::atomic<bool>>& pCanceled) noexcept
+      : _pCanceled(pCanceled) {}
+
+  std::shared_ptr<const std::atomic<bool>> _pCanceled;
+
+  friend class CancellationTokenSource;
+};
+
+/**
+ * @brief Creates {@link CancellationToken} instances and cancels them.
+ */
+class CancellationTokenSource {
+public:
+  /**
+   * @brief Creates a new source that is not yet canceled.
+   */
+  CancellationTokenSource()
+      : _pCanceled(std::make_shared<std::atomic<bool>>(false)) {}
+
+  /**
+   * @brief Gets a token that is canceled when this source is.
+   */
+  CancellationToken getToken() const noexcept {
+    return CancellationToken(this->_pCanceled);
+  }
+
+  /**
+   * @brief Cancels every token obtained from this source, including tokens
+   * that are obtained later.
+   */
+  void cancel() noexcept {
+    this->_pCanceled->store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns true if {@link cancel} has been called.
+   */
+  bool isCanceled() const noexcept {
+    return this->_pCanceled->load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> _pCanceled;
+};
+
+} // namespace CesiumAsync
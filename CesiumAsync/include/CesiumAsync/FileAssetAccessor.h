@@ -0,0 +1,64 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief An {@link IAssetAccessor} that serves `file://` URLs from the local
+ * file system.
+ *
+ * Files are memory-mapped instead of read into heap buffers, and
+ * {@link IAssetResponse::data} of a response exposes the mapped region
+ * directly. The mapping is released when the last reference to the request is
+ * released.
+ *
+ * Entries of `.3tz` archives (and other zip archives with that extension) are
+ * served from URLs that continue past the archive, such as
+ * `file:///data/city.3tz/tileset.json`. Entries that are stored without
+ * compression are exposed directly from the mapped archive; deflated entries
+ * are inflated into a heap buffer. Archives are opened on first use and kept
+ * mapped for the lifetime of the accessor.
+ *
+ * A missing file or archive entry produces a response with status code 404.
+ * URLs that do not use the `file` scheme are rejected.
+ */
+class FileAssetAccessor : public IAssetAccessor {
+public:
+  FileAssetAccessor();
+  virtual ~FileAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /**
+   * @copydoc IAssetAccessor::request
+   *
+   * Only the `GET` verb is supported. Other verbs produce a response with
+   * status code 405.
+   */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+private:
+  struct ArchiveCache;
+  std::shared_ptr<ArchiveCache> _pArchives;
+};
+
+} // namespace CesiumAsync
@@ -3,6 +3,7 @@
 #include "Impl/AsyncSystemSchedulers.h"
 #include "Impl/CatchFunction.h"
 #include "Impl/ContinuationFutureType.h"
+#include "Impl/Coroutines.h"
 #include "Impl/WithTracing.h"
 #include "SharedFuture.h"
 #include "ThreadPool.h"
@@ -28,6 +29,18 @@ struct TaskUnwrapper;
  */
 template <typename T> class Future final {
 public:
+  /**
+   * @brief The promise type of a C++20 coroutine that returns this future.
+   *
+   * This allows a function returning a `Future<T>` to be written as a
+   * coroutine using `co_await` and `co_return`. The coroutine starts running
+   * immediately in the calling thread. One of its parameters must be an
+   * {@link AsyncSystem}, or an object with an `asyncSystem` member of that
+   * type. The future resolves with the value passed to `co_return`, or
+   * rejects with any exception thrown by the coroutine.
+   */
+  using promise_type = CesiumImpl::CoroutinePromise<T>;
+
   /**
    * @brief Move constructor
    */
@@ -66,11 +79,36 @@ public:
   CesiumImpl::ContinuationFutureType_t<Func, T>
   thenInWorkerThread(Func&& f) && {
     return std::move(*this).thenWithScheduler(
-        this->_pSchedulers->workerThread.immediate,
+        this->_pSchedulers->workerThread.immediate(),
         "waiting for worker thread",
         std::forward<Func>(f));
   }
 
+  /**
+   * @brief Registers an I/O-bound continuation function to be invoked in a
+   * background thread when this Future resolves, and invalidates this Future.
+   *
+   * The continuation runs with the {@link AsyncSystem}'s I/O task processor,
+   * or with its worker thread task processor if it doesn't have one.
+   *
+   * If the function itself returns a `Future`, the function will not be
+   * considered complete until that returned `Future` also resolves.
+   *
+   * If this Future is resolved from a designated I/O thread, the continuation
+   * function will be invoked immediately rather than in a separate task.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, T> thenInIOThread(Func&& f) && {
+    return std::move(*this).thenWithScheduler(
+        this->_pSchedulers->ioThread().immediate(),
+        "waiting for I/O thread",
+        std::forward<Func>(f));
+  }
+
   /**
    * @brief Registers a continuation function to be invoked in the main thread
    * when this Future resolves, and invalidates this Future.
@@ -116,7 +154,7 @@ public:
   template <typename Func>
   CesiumImpl::ContinuationFutureType_t<Func, T> thenImmediately(Func&& f) && {
     return CesiumImpl::ContinuationFutureType_t<Func, T>(
-        this->_pSchedulers,
+        std::move(this->_pSchedulers),
         _task.then(
             async::inline_scheduler(),
             CesiumImpl::WithTracing<T>::end(nullptr, std::forward<Func>(f))));
@@ -271,6 +309,46 @@ public:
    */
   bool isReady() const { return this->_task.ready(); }
 
+  /**
+   * @brief Determines if a coroutine awaiting this future with `co_await` can
+   * continue without suspending.
+   *
+   * This and the other `await_` methods let C++20 coroutines `co_await` a
+   * future. A coroutine that awaits a future that is not yet resolved
+   * continues in whichever thread resolves it. Use
+   * `co_await asyncSystem.workerThread()` or
+   * `co_await asyncSystem.mainThread()` afterward to continue in a particular
+   * thread.
+   *
+   * @return True if this future is already resolved or rejected.
+   */
+  bool await_ready() const { return this->isReady(); }
+
+  /**
+   * @brief Arranges for the given suspended coroutine to be resumed when this
+   * future resolves or rejects.
+   *
+   * @param handle The handle of the awaiting coroutine.
+   */
+  template <typename THandle> void await_suspend(THandle handle) {
+    std::move(this->_task)
+        .then(
+            async::inline_scheduler(),
+            [this, handle](async::task<T>&& task) mutable {
+              this->_task = std::move(task);
+              handle.resume();
+            });
+  }
+
+  /**
+   * @brief Gets the result of this future when a coroutine continues after
+   * awaiting it.
+   *
+   * @return The value if the future resolved successfully.
+   * @throws An exception if the future rejected.
+   */
+  T await_resume() { return this->_task.get(); }
+
   /**
    * @brief Creates a version of this future that can be shared, meaning that
    * its value may be accessed multiple times and multiple continuations may be
@@ -281,14 +359,16 @@ public:
    * @return The `SharedFuture`.
    */
   SharedFuture<T> share() && {
-    return SharedFuture<T>(this->_pSchedulers, this->_task.share());
+    return SharedFuture<T>(
+        std::move(this->_pSchedulers),
+        this->_task.share());
   }
 
 private:
   Future(
-      const std::shared_ptr<CesiumImpl::AsyncSystemSchedulers>& pSchedulers,
+      std::shared_ptr<CesiumImpl::AsyncSystemSchedulers> pSchedulers,
       async::task<T>&& task) noexcept
-      : _pSchedulers(pSchedulers), _task(std::move(task)) {}
+      : _pSchedulers(std::move(pSchedulers)), _task(std::move(task)) {}
 
   template <typename Func, typename Scheduler>
   CesiumImpl::ContinuationFutureType_t<Func, T> thenWithScheduler(
@@ -310,7 +390,7 @@ private:
 #endif
 
     return CesiumImpl::ContinuationFutureType_t<Func, T>(
-        this->_pSchedulers,
+        std::move(this->_pSchedulers),
         task.then(
             scheduler,
             CesiumImpl::WithTracing<T>::end(
@@ -322,7 +402,7 @@ private:
   CesiumImpl::ContinuationFutureType_t<Func, std::exception>
   catchWithScheduler(Scheduler& scheduler, Func&& f) && {
     return CesiumImpl::ContinuationFutureType_t<Func, std::exception>(
-        this->_pSchedulers,
+        std::move(this->_pSchedulers),
         this->_task.then(
             async::inline_scheduler(),
             CesiumImpl::CatchFunction<Func, T, Scheduler>{
@@ -9,6 +9,11 @@ class AsyncSystem;
 /**
  * @brief A decorator for an {@link IAssetAccessor} that automatically unzips
  * gzipped asset responses from the underlying Asset Accessor.
+ *
+ * Responses that start with the gzip magic bytes are gunzipped, and responses
+ * with a `Content-Encoding` of `deflate` are inflated. The decoding happens in
+ * a worker thread. Other encodings, such as `br` and `zstd`, are passed
+ * through unchanged, so the underlying accessor must decode them.
  */
 class GunzipAssetAccessor : public IAssetAccessor {
 public:
@@ -28,6 +33,26 @@ public:
       const std::string& url,
       const std::vector<THeader>& headers) override;
 
+  /** @copydoc IAssetAccessor::getWithCancellation */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithCancellation(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken) override;
+
+  /** @copydoc IAssetAccessor::getWithOptions */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithOptions(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const AssetRequestOptions& options) override;
+
+  /** @copydoc IAssetAccessor::getBatch */
+  virtual std::vector<Future<std::shared_ptr<IAssetRequest>>> getBatch(
+      const AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers) override;
+
   virtual Future<std::shared_ptr<IAssetRequest>> request(
       const AsyncSystem& asyncSystem,
       const std::string& verb,
@@ -1,7 +1,13 @@
 #pragma once
 
-#include <map>
+#include "Library.h"
+
+#include <cstddef>
+#include <initializer_list>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace CesiumAsync {
 
@@ -19,6 +25,241 @@ struct CaseInsensitiveCompare {
 
 /**
  * @brief Http Headers that maps case-insensitive header key with header value.
+ *
+ * The headers are kept in a single vector sorted by name, rather than in a
+ * node per header like a `std::map`, so that a request or response with a
+ * dozen headers costs one allocation for the headers themselves. Most header
+ * names are short enough to be stored inside their `std::string` without
+ * another allocation. Lookups are binary searches.
+ *
+ * The interface is the subset of the `std::map` interface that is useful for
+ * headers, so a `HttpHeaders` can be used like the
+ * `std::map<std::string, std::string, CaseInsensitiveCompare>` that it
+ * replaces. Unlike with a `std::map`, inserting or erasing a header
+ * invalidates the iterators to the other headers, and the name of a header
+ * must not be modified through an iterator.
  */
-using HttpHeaders = std::map<std::string, std::string, CaseInsensitiveCompare>;
+class CESIUMASYNC_API HttpHeaders {
+public:
+  /** @brief The type of the name of a header. */
+  using key_type = std::string;
+
+  /** @brief The type of the value of a header. */
+  using mapped_type = std::string;
+
+  /** @brief The type of a header, a pair of its name and its value. */
+  using value_type = std::pair<std::string, std::string>;
+
+  /** @brief The type of the number of headers. */
+  using size_type = size_t;
+
+  /** @brief An iterator over the headers. */
+  using iterator = std::vector<value_type>::iterator;
+
+  /** @brief A constant iterator over the headers. */
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  /**
+   * @brief Creates an empty set of headers.
+   */
+  HttpHeaders() noexcept = default;
+
+  /**
+   * @brief Creates headers from a list of name and value pairs.
+   *
+   * If a name appears more than once, ignoring case, the first value is kept.
+   */
+  HttpHeaders(std::initializer_list<value_type> headers)
+      : HttpHeaders(headers.begin(), headers.end()) {}
+
+  /**
+   * @brief Creates headers from a range of name and value pairs, such as a
+   * `std::vector<IAssetAccessor::THeader>`.
+   *
+   * If a name appears more than once, ignoring case, the first value is kept.
+   */
+  template <typename InputIt> HttpHeaders(InputIt first, InputIt last) {
+    this->_headers.assign(first, last);
+    this->sortAndRemoveDuplicates();
+  }
+
+  /** @brief Returns an iterator to the first header. */
+  iterator begin() noexcept { return this->_headers.begin(); }
+
+  /** @brief Returns an iterator to the first header. */
+  const_iterator begin() const noexcept { return this->_headers.begin(); }
+
+  /** @brief Returns an iterator to the first header. */
+  const_iterator cbegin() const noexcept { return this->_headers.cbegin(); }
+
+  /** @brief Returns an iterator past the last header. */
+  iterator end() noexcept { return this->_headers.end(); }
+
+  /** @brief Returns an iterator past the last header. */
+  const_iterator end() const noexcept { return this->_headers.end(); }
+
+  /** @brief Returns an iterator past the last header. */
+  const_iterator cend() const noexcept { return this->_headers.cend(); }
+
+  /** @brief Determines if there are no headers. */
+  bool empty() const noexcept { return this->_headers.empty(); }
+
+  /** @brief Gets the number of headers. */
+  size_t size() const noexcept { return this->_headers.size(); }
+
+  /** @brief Removes all of the headers. */
+  void clear() noexcept { this->_headers.clear(); }
+
+  /** @brief Reserves room for the given number of headers. */
+  void reserve(size_t count) { this->_headers.reserve(count); }
+
+  /**
+   * @brief Finds the header with the given name, ignoring case.
+   *
+   * @return An iterator to the header, or {@link end} if there is none.
+   */
+  iterator find(std::string_view name) noexcept;
+
+  /** @copydoc find */
+  const_iterator find(std::string_view name) const noexcept;
+
+  /**
+   * @brief Gets the number of headers with the given name, ignoring case,
+   * which is either 0 or 1.
+   */
+  size_t count(std::string_view name) const noexcept {
+    return this->find(name) == this->end() ? 0 : 1;
+  }
+
+  /**
+   * @brief Gets the value of the header with the given name, ignoring case.
+   *
+   * @throws std::out_of_range If there is no such header.
+   */
+  std::string& at(std::string_view name);
+
+  /** @copydoc at */
+  const std::string& at(std::string_view name) const;
+
+  /**
+   * @brief Gets the value of the header with the given name, ignoring case,
+   * adding the header with an empty value if there is none.
+   */
+  std::string& operator[](std::string_view name) {
+    return this->emplace(name, std::string()).first->second;
+  }
+
+  /**
+   * @brief Adds a header, unless there is already one with the same name,
+   * ignoring case.
+   *
+   * @param name The name of the header.
+   * @param value The value of the header.
+   * @return An iterator to the header with the name, and whether it was
+   * added.
+   */
+  template <typename TName, typename TValue>
+  std::pair<iterator, bool> emplace(TName&& name, TValue&& value) {
+    const std::string_view nameView(name);
+    const iterator it = this->lowerBound(nameView);
+    if (it != this->end() && equalsIgnoringCase(it->first, nameView)) {
+      return {it, false};
+    }
+
+    return {
+        this->_headers.emplace(
+            it,
+            std::string(std::forward<TName>(name)),
+            std::string(std::forward<TValue>(value))),
+        true};
+  }
+
+  /**
+   * @brief Adds a header like {@link emplace}, but first checks whether it
+   * belongs right before `hint`, such as when headers are added in order at
+   * {@link end}.
+   */
+  template <typename TName, typename TValue>
+  iterator emplace_hint(const_iterator hint, TName&& name, TValue&& value) {
+    const std::string_view nameView(name);
+    if ((hint == this->cbegin() ||
+         compareIgnoringCase((hint - 1)->first, nameView) < 0) &&
+        (hint == this->cend() ||
+         compareIgnoringCase(nameView, hint->first) < 0)) {
+      return this->_headers.emplace(
+          hint,
+          std::string(std::forward<TName>(name)),
+          std::string(std::forward<TValue>(value)));
+    }
+
+    return this->emplace(std::forward<TName>(name), std::forward<TValue>(value))
+        .first;
+  }
+
+  /**
+   * @brief Adds a header, unless there is already one with the same name,
+   * ignoring case.
+   */
+  std::pair<iterator, bool> insert(const value_type& header) {
+    return this->emplace(header.first, header.second);
+  }
+
+  /** @copydoc insert(const value_type&) */
+  std::pair<iterator, bool> insert(value_type&& header) {
+    return this->emplace(std::move(header.first), std::move(header.second));
+  }
+
+  /**
+   * @brief Sets the value of a header, adding it if there is none with the
+   * same name, ignoring case.
+   */
+  template <typename TValue>
+  std::pair<iterator, bool>
+  insert_or_assign(std::string_view name, TValue&& value) {
+    std::pair<iterator, bool> result =
+        this->emplace(name, std::forward<TValue>(value));
+    if (!result.second) {
+      result.first->second = std::forward<TValue>(value);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Removes the header at the given position.
+   *
+   * @return An iterator to the header after the removed one.
+   */
+  iterator erase(const_iterator it) { return this->_headers.erase(it); }
+
+  /**
+   * @brief Removes the header with the given name, ignoring case.
+   *
+   * @return The number of headers removed, either 0 or 1.
+   */
+  size_t erase(std::string_view name);
+
+  /**
+   * @brief Determines if two sets of headers have the same names, compared
+   * case-sensitively, and values.
+   */
+  bool operator==(const HttpHeaders& rhs) const {
+    return this->_headers == rhs._headers;
+  }
+
+  /** @brief Determines if two sets of headers differ. */
+  bool operator!=(const HttpHeaders& rhs) const {
+    return this->_headers != rhs._headers;
+  }
+
+private:
+  static int compareIgnoringCase(std::string_view lhs, std::string_view rhs);
+  static bool equalsIgnoringCase(std::string_view lhs, std::string_view rhs) {
+    return lhs.size() == rhs.size() && compareIgnoringCase(lhs, rhs) == 0;
+  }
+
+  iterator lowerBound(std::string_view name) noexcept;
+  void sortAndRemoveDuplicates();
+
+  std::vector<value_type> _headers;
+};
 } // namespace CesiumAsync
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "AssetRequestOptions.h"
 #include "AsyncSystem.h"
+#include "CancellationToken.h"
 #include "IAssetRequest.h"
+#include "IAssetResponse.h"
 #include "Library.h"
 
 #include <gsl/span>
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +29,13 @@ public:
    */
   typedef std::pair<std::string, std::string> THeader;
 
+  /**
+   * @brief A function that receives consecutive pieces of a response body as
+   * they are downloaded.
+   */
+  typedef std::function<void(const gsl::span<const std::byte>& data)>
+      TDataCallback;
+
   virtual ~IAssetAccessor() = default;
 
   /**
@@ -41,6 +52,131 @@ public:
       const std::string& url,
       const std::vector<THeader>& headers = {}) = 0;
 
+  /**
+   * @brief Starts a new request for the asset with the given URL, which may
+   * be abandoned when the given token is canceled.
+   *
+   * An implementation that abandons a request should resolve the returned
+   * future with a request that has no response. The default implementation
+   * ignores the token and calls {@link get}.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param url The URL of the asset.
+   * @param headers The headers to include in the request.
+   * @param cancellationToken The token that reports when the asset is no
+   * longer needed.
+   * @return The in-progress asset request.
+   */
+  virtual CesiumAsync::Future<std::shared_ptr<IAssetRequest>>
+  getWithCancellation(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken) {
+    (void)cancellationToken;
+    return this->get(asyncSystem, url, headers);
+  }
+
+  /**
+   * @brief Starts a new request for the asset with the given URL, with hints
+   * about how soon it is needed and when it may be abandoned.
+   *
+   * An accessor that queues its requests, or that uses a protocol with stream
+   * priorities like HTTP/2 or HTTP/3, should send more urgent requests first,
+   * and may read {@link AssetRequestOptions::pPriority} again later to
+   * reprioritize requests that are still queued. The default implementation
+   * ignores the priority and the deadline and calls
+   * {@link getWithCancellation}.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param url The URL of the asset.
+   * @param headers The headers to include in the request.
+   * @param options The priority, cancellation token, and deadline of the
+   * request.
+   * @return The in-progress asset request.
+   */
+  virtual CesiumAsync::Future<std::shared_ptr<IAssetRequest>> getWithOptions(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const AssetRequestOptions& options) {
+    return this->getWithCancellation(
+        asyncSystem,
+        url,
+        headers,
+        options.cancellationToken);
+  }
+
+  /**
+   * @brief Starts a new request for the asset with the given URL, passing the
+   * body of the response to a callback as it arrives.
+   *
+   * The callback receives consecutive pieces of the body, in order, and is
+   * never invoked concurrently. Every invocation happens before the returned
+   * future resolves, and the response of the resolved request still contains
+   * the complete body. The callback may be invoked in any thread, so it should
+   * return quickly. It may receive only part of the body, or nothing at all,
+   * if the request fails or is abandoned.
+   *
+   * The default implementation calls {@link getWithCancellation} and passes
+   * the complete body to the callback once, in a worker thread, when the
+   * request finishes.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param url The URL of the asset.
+   * @param headers The headers to include in the request.
+   * @param cancellationToken The token that reports when the asset is no
+   * longer needed.
+   * @param onData The callback that receives the body as it arrives.
+   * @return The in-progress asset request.
+   */
+  virtual CesiumAsync::Future<std::shared_ptr<IAssetRequest>> getStreaming(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken,
+      TDataCallback onData) {
+    return this
+        ->getWithCancellation(asyncSystem, url, headers, cancellationToken)
+        .thenInWorkerThread(
+            [onData = std::move(onData)](
+                std::shared_ptr<IAssetRequest>&& pRequest) {
+              const IAssetResponse* pResponse = pRequest->response();
+              if (pResponse && !pResponse->data().empty()) {
+                onData(pResponse->data());
+              }
+              return std::move(pRequest);
+            });
+  }
+
+  /**
+   * @brief Starts new requests for several assets that are needed together,
+   * such as the images of a raster overlay that cover one geometry tile.
+   *
+   * The assets usually come from the same origin and are all needed at the
+   * priority of the calling task, from {@link getCurrentTaskPriority}, so an
+   * accessor for a protocol that multiplexes requests over one connection,
+   * like HTTP/2 or HTTP/3, may submit them together instead of one at a time.
+   * The default implementation calls {@link get} for each URL.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param urls The URLs of the assets.
+   * @param headers The headers to include in every request.
+   * @return The in-progress asset requests, in the same order as the URLs.
+   */
+  virtual std::vector<CesiumAsync::Future<std::shared_ptr<IAssetRequest>>>
+  getBatch(
+      const AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers = {}) {
+    std::vector<CesiumAsync::Future<std::shared_ptr<IAssetRequest>>> result;
+    result.reserve(urls.size());
+    for (const std::string& url : urls) {
+      result.emplace_back(this->get(asyncSystem, url, headers));
+    }
+    return result;
+  }
+
   /**
    * @brief Starts a new request to the given URL, using the provided HTTP verb
    * and the provided content payload.
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace CesiumAsync {
 /**
@@ -53,6 +54,37 @@ public:
       const HttpHeaders& responseHeaders,
       const gsl::span<const std::byte>& responseData) = 0;
 
+  /**
+   * @brief Stores many cache entries at once, such as to fill a cache before it
+   * is used offline.
+   *
+   * The default implementation stores each entry with {@link storeEntry}.
+   * Implementations may store them more efficiently.
+   *
+   * @param entries The entries to store. An entry replaces any existing entry
+   * with the same key.
+   * @return The number of entries that were stored. If an error occurs, the
+   * entries after the ones that were stored may not be stored.
+   */
+  virtual size_t storeEntries(const std::vector<CacheEntry>& entries) {
+    size_t storedEntries = 0;
+    for (const CacheEntry& entry : entries) {
+      const CacheItem& item = entry.item;
+      if (this->storeEntry(
+              entry.key,
+              item.expiryTime,
+              item.cacheRequest.url,
+              item.cacheRequest.method,
+              item.cacheRequest.headers,
+              item.cacheResponse.statusCode,
+              item.cacheResponse.headers,
+              item.cacheResponse.data)) {
+        ++storedEntries;
+      }
+    }
+    return storedEntries;
+  }
+
   /**
    * @brief Remove cache entries from the database to satisfy the database
    * invariant condition (.e.g exired response or LRU).
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Library.h"
+#include "TaskPriority.h"
 
 #include <functional>
+#include <utility>
 
 namespace CesiumAsync {
 /**
@@ -25,5 +27,22 @@ public:
    * @param f The function to execute
    */
   virtual void startTask(std::function<void()> f) = 0;
+
+  /**
+   * @brief Starts a task with the given priority that executes the given
+   * function in a background thread.
+   *
+   * Implementations that support priorities should run ready tasks of a higher
+   * priority before ready tasks of a lower priority. The default
+   * implementation ignores the priority and calls {@link startTask}.
+   *
+   * @param f The function to execute
+   * @param priority The priority of the task.
+   */
+  virtual void
+  startTaskWithPriority(std::function<void()> f, TaskPriority priority) {
+    (void)priority;
+    this->startTask(std::move(f));
+  }
 };
 } // namespace CesiumAsync
@@ -4,6 +4,8 @@
 #include "TaskScheduler.h"
 #include "cesium-async++.h"
 
+#include <memory>
+
 namespace CesiumAsync {
 
 class ITaskProcessor;
@@ -14,11 +16,25 @@ namespace CesiumImpl {
 
 class AsyncSystemSchedulers {
 public:
-  AsyncSystemSchedulers(const std::shared_ptr<ITaskProcessor>& pTaskProcessor)
-      : mainThread(), workerThread(pTaskProcessor) {}
+  AsyncSystemSchedulers(
+      const std::shared_ptr<ITaskProcessor>& pTaskProcessor,
+      const std::shared_ptr<ITaskProcessor>& pIOTaskProcessor = nullptr)
+      : mainThread(),
+        workerThread(pTaskProcessor),
+        pIOThread(
+            pIOTaskProcessor
+                ? std::make_unique<TaskScheduler>(pIOTaskProcessor)
+                : nullptr) {}
+
+  // Without a separate I/O task processor, I/O work shares the worker thread
+  // scheduler, so hopping between the two is free.
+  TaskScheduler& ioThread() noexcept {
+    return this->pIOThread ? *this->pIOThread : this->workerThread;
+  }
 
   QueuedScheduler mainThread;
   TaskScheduler workerThread;
+  std::unique_ptr<TaskScheduler> pIOThread;
 };
 
 //! @endcond
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../Promise.h"
+#include "AsyncSystemSchedulers.h"
+#include "cesium-async++.h"
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// The types below only use the coroutine_handle they are given, so they don't
+// need <coroutine> themselves. But a coroutine can't be compiled without
+// std::coroutine_traits, so make it available to C++20 code that awaits a
+// Future.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#endif
+#endif
+
+namespace CesiumAsync {
+
+class AsyncSystem;
+template <typename T> class Future;
+
+namespace CesiumImpl {
+// Begin omitting doxgen warnings for Impl namespace
+//! @cond Doxygen_Suppress
+
+struct SuspendNever {
+  bool await_ready() const noexcept { return true; }
+  template <typename THandle> void await_suspend(THandle) const noexcept {}
+  void await_resume() const noexcept {}
+};
+
+template <typename T, typename = void>
+struct HasAsyncSystemMember : std::false_type {};
+
+template <typename T>
+struct HasAsyncSystemMember<
+    T,
+    std::void_t<decltype(std::declval<const T&>().asyncSystem)>>
+    : std::is_same<
+          std::decay_t<decltype(std::declval<const T&>().asyncSystem)>,
+          AsyncSystem> {};
+
+// Finds the AsyncSystem among the parameters of a coroutine. It may be passed
+// directly or as the `asyncSystem` member of a parameter, such as a
+// TileLoadInput.
+template <typename TFirst, typename... TRest>
+const auto& findAsyncSystem(const TFirst& first, const TRest&... rest) {
+  if constexpr (std::is_same_v<TFirst, AsyncSystem>) {
+    return first;
+  } else if constexpr (HasAsyncSystemMember<TFirst>::value) {
+    return first.asyncSystem;
+  } else {
+    static_assert(
+        sizeof...(TRest) > 0,
+        "A coroutine that returns a CesiumAsync::Future must have an "
+        "AsyncSystem parameter, or a parameter with an asyncSystem member.");
+    return findAsyncSystem(rest...);
+  }
+}
+
+// The promise_type of a coroutine that returns a Future. The coroutine starts
+// running immediately, like a function passed to AsyncSystem::createFuture,
+// and the Future resolves or rejects when the coroutine completes.
+template <typename T> class CoroutinePromiseBase {
+public:
+  template <typename... TArgs>
+  explicit CoroutinePromiseBase(const TArgs&... args)
+      : _promise(findAsyncSystem(args...).template createPromise<T>()) {}
+
+  Future<T> get_return_object() const { return this->_promise.getFuture(); }
+
+  SuspendNever initial_suspend() const noexcept { return {}; }
+  SuspendNever final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() const {
+    this->_promise.reject(std::current_exception());
+  }
+
+protected:
+  Promise<T> _promise;
+};
+
+template <typename T> class CoroutinePromise : public CoroutinePromiseBase<T> {
+public:
+  using CoroutinePromiseBase<T>::CoroutinePromiseBase;
+
+  void return_value(T&& value) const {
+    this->_promise.resolve(std::move(value));
+  }
+
+  void return_value(const T& value) const { this->_promise.resolve(value); }
+};
+
+template <>
+class CoroutinePromise<void> : public CoroutinePromiseBase<void> {
+public:
+  using CoroutinePromiseBase<void>::CoroutinePromiseBase;
+
+  void return_void() const { this->_promise.resolve(); }
+};
+
+// Continues a coroutine with the given scheduler when awaited.
+template <typename TScheduler> class SchedulerAwaitable {
+public:
+  SchedulerAwaitable(
+      const std::shared_ptr<AsyncSystemSchedulers>& pSchedulers,
+      TScheduler& scheduler) noexcept
+      : _pSchedulers(pSchedulers), _pScheduler(&scheduler) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  template <typename THandle> void await_suspend(THandle handle) const {
+    async::spawn(*this->_pScheduler, [handle]() mutable { handle.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  // Keeps the scheduler alive.
+  std::shared_ptr<AsyncSystemSchedulers> _pSchedulers;
+  TScheduler* _pScheduler;
+};
+
+//! @endcond
+// End omitting doxgen warnings for Impl namespace
+} // namespace CesiumImpl
+} // namespace CesiumAsync
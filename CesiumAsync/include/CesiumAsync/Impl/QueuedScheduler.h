@@ -15,6 +15,7 @@ public:
 
   void schedule(async::task_run_handle t);
   void dispatchQueuedContinuations();
+  bool dispatchQueuedContinuations(double maximumTimeInMilliseconds);
   bool dispatchZeroOrOneContinuation();
 
   template <typename T> T dispatchUntilTaskCompletes(async::task<T>&& task) {
@@ -81,6 +82,7 @@ public:
 
 private:
   bool dispatchInternal(bool blockIfNoTasks);
+  bool hasQueuedContinuations();
   void unblock();
 
   struct Impl;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ITaskProcessor.h"
+#include "../TaskPriority.h"
 #include "ImmediateScheduler.h"
 
 #include <memory>
@@ -9,14 +10,54 @@ namespace CesiumAsync {
 namespace CesiumImpl {
 
 class TaskScheduler {
+  // Continuations are scheduled with the priority that was current when they
+  // were created, which may be long before they are ready to run and on a
+  // different thread. So each priority gets its own scheduler that remembers
+  // it.
+  class Lane {
+  public:
+    Lane(TaskScheduler* pParent, TaskPriority priority) noexcept
+        : _pParent(pParent), _priority(priority) {}
+
+    Lane(const Lane&) = delete;
+    Lane& operator=(const Lane&) = delete;
+
+    void schedule(async::task_run_handle t) {
+      this->_pParent->schedule(std::move(t), this->_priority);
+    }
+
+    ImmediateScheduler<Lane> immediate{this};
+
+  private:
+    TaskScheduler* _pParent;
+    TaskPriority _priority;
+
+    friend class TaskScheduler;
+  };
+
 public:
   TaskScheduler(const std::shared_ptr<ITaskProcessor>& pTaskProcessor);
-  void schedule(async::task_run_handle t);
+  void schedule(async::task_run_handle t, TaskPriority priority);
 
-  ImmediateScheduler<TaskScheduler> immediate{this};
+  /**
+   * @brief Gets the immediate scheduler for the current thread's
+   * {@link TaskPriority}.
+   */
+  ImmediateScheduler<Lane>& immediate() noexcept;
+
+  /**
+   * @brief Gets the scheduler for the current thread's {@link TaskPriority}
+   * that always starts a new task, even in a worker thread.
+   */
+  Lane& deferred() noexcept;
 
 private:
+  Lane& lane(TaskPriority priority) noexcept;
+
   std::shared_ptr<ITaskProcessor> _pTaskProcessor;
+  Lane _low{this, TaskPriority::Low};
+  Lane _normal{this, TaskPriority::Normal};
+  Lane _high{this, TaskPriority::High};
 };
 
 } // namespace CesiumImpl
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ICacheDatabase.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace CesiumAsync {
+
+/**
+ * @brief An in-memory, byte-bounded, least-recently-used cache of responses
+ * that can be stacked in front of another {@link ICacheDatabase}, such as
+ * {@link SqliteCache}.
+ *
+ * Entries are stored both in memory and in the underlying database. Lookups
+ * that hit the memory tier are served without touching the underlying
+ * database, and entries read from the underlying database are added to the
+ * memory tier. This makes re-requesting a recently used asset, such as a tile
+ * that was unloaded and is needed again a few seconds later, much cheaper.
+ */
+class CESIUMASYNC_API MemoryCacheDatabase : public ICacheDatabase {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pUnderlyingDatabase The database behind the memory tier, or nullptr
+   * to cache in memory only.
+   * @param maximumBytes The maximum number of bytes of responses to keep in
+   * memory. Responses larger than this are only stored in the underlying
+   * database.
+   */
+  MemoryCacheDatabase(
+      const std::shared_ptr<ICacheDatabase>& pUnderlyingDatabase,
+      int64_t maximumBytes = 64 * 1024 * 1024);
+
+  /** @copydoc ICacheDatabase::getEntry*/
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::storeEntry*/
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * @copydoc ICacheDatabase::prune
+   *
+   * Expired entries are removed from memory, and the underlying database is
+   * pruned.
+   */
+  virtual bool prune() override;
+
+  /** @copydoc ICacheDatabase::clearAll*/
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the number of bytes of responses currently held in memory.
+   */
+  int64_t getTotalBytes() const;
+
+private:
+  using EntryList = std::list<std::pair<std::string, CacheItem>>;
+
+  void insert(const std::string& key, CacheItem&& item) const;
+  void remove(EntryList::iterator it) const;
+
+  std::shared_ptr<ICacheDatabase> _pUnderlyingDatabase;
+  int64_t _maximumBytes;
+
+  // The most recently used entry is at the front of the list.
+  mutable std::mutex _mutex;
+  mutable EntryList _entries;
+  mutable std::unordered_map<std::string, EntryList::iterator> _entriesByKey;
+  mutable int64_t _totalBytes;
+};
+
+} // namespace CesiumAsync
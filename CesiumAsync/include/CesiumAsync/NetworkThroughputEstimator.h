@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Library.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Estimates the throughput and latency of the network from the
+ * requests that complete over it.
+ *
+ * The throughput is the number of bytes received per second while at least
+ * one request is in progress, so several requests that share a connection
+ * are measured together rather than each receiving a fraction of it. The
+ * latency is the time from the start of a request until it finishes, which
+ * grows as more requests queue for the same connection. Both are
+ * exponentially smoothed.
+ *
+ * Requests are usually reported by a {@link ThroughputMeasuringAssetAccessor}.
+ * This class is thread-safe.
+ */
+class CESIUMASYNC_API NetworkThroughputEstimator final {
+public:
+  /**
+   * @brief The clock with which the times of requests are measured.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param smoothing The weight, between 0.0 and 1.0, of each new measurement
+   * in the estimates. Larger values follow changes in the network sooner,
+   * but are noisier.
+   */
+  explicit NetworkThroughputEstimator(double smoothing = 0.25) noexcept;
+
+  /**
+   * @brief Notifies this estimator that a request has started.
+   *
+   * @param time The time at which the request started.
+   */
+  void notifyRequestStarted(Clock::time_point time) noexcept;
+
+  /**
+   * @brief Notifies this estimator that a request has finished, whether it
+   * succeeded or failed.
+   *
+   * This must balance a call to {@link notifyRequestStarted}.
+   *
+   * @param startTime The time at which the request started.
+   * @param endTime The time at which the request finished.
+   * @param byteCount The number of bytes in the response, or zero if there
+   * was none.
+   */
+  void notifyRequestFinished(
+      Clock::time_point startTime,
+      Clock::time_point endTime,
+      size_t byteCount) noexcept;
+
+  /**
+   * @brief Gets the estimated throughput, in bytes per second, or zero if it
+   * is not known yet.
+   */
+  double getBytesPerSecond() const noexcept;
+
+  /**
+   * @brief Gets the estimated time from the start of a request until it
+   * finishes, in seconds, or zero if it is not known yet.
+   */
+  double getLatency() const noexcept;
+
+  /**
+   * @brief Gets the smoothed size of the responses, in bytes.
+   */
+  double getAverageResponseBytes() const noexcept;
+
+  /**
+   * @brief Gets the number of requests that have finished.
+   */
+  uint64_t getFinishedRequestCount() const noexcept;
+
+  /**
+   * @brief Gets the number of requests that are in progress.
+   */
+  uint32_t getRequestsInProgress() const noexcept;
+
+private:
+  void measureThroughput() noexcept;
+
+  double _smoothing;
+
+  mutable std::mutex _mutex;
+  uint32_t _requestsInProgress;
+  uint64_t _finishedRequestCount;
+
+  // The bytes received, and the time spent with requests in progress, since
+  // the last throughput measurement.
+  Clock::time_point _busySince;
+  double _busySeconds;
+  size_t _busyBytes;
+
+  double _bytesPerSecond;
+  double _latency;
+  double _averageResponseBytes;
+};
+
+} // namespace CesiumAsync
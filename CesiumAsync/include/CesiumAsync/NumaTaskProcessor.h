@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ITaskProcessor.h"
+#include "Library.h"
+#include "TaskPriority.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace CesiumAsync {
+
+/**
+ * @brief An {@link ITaskProcessor} that runs tasks on one group of threads per
+ * NUMA node, honoring {@link TaskPriority} and {@link ScopedTaskAffinity}.
+ *
+ * This is intended for many-socket machines, such as servers rendering views
+ * offline, where moving a tile's buffers between sockets is expensive. Each
+ * node has its own queues and one thread per CPU. On Linux, those threads can
+ * be pinned to their CPUs.
+ *
+ * A task with a {@link getCurrentTaskAffinity} key runs on the node chosen by
+ * that key, so tasks with the same key share a node. A task without a key
+ * runs on the same node as the task that started it, or on the next node in
+ * turn if it was started from another thread. Tasks don't move between nodes
+ * once they are queued.
+ *
+ * Tasks that are still queued when this object is destroyed are run before the
+ * destructor returns.
+ */
+class CESIUMASYNC_API NumaTaskProcessor : public ITaskProcessor {
+public:
+  /**
+   * @brief A group of CPUs that share local memory.
+   */
+  struct Node {
+    /**
+     * @brief The indices of the CPUs in this node, as used by the operating
+     * system.
+     */
+    std::vector<uint32_t> cpus;
+  };
+
+  /**
+   * @brief Finds the NUMA nodes of this machine.
+   *
+   * On Linux, the nodes are read from `/sys/devices/system/node`. Elsewhere,
+   * or if they can't be read, a single node with every hardware thread is
+   * returned.
+   */
+  static std::vector<Node> detectNodes();
+
+  /**
+   * @brief Creates a new instance and starts its threads.
+   *
+   * @param nodes The nodes to create threads for. Nodes without CPUs are
+   * ignored. If no node has a CPU, a single node with every hardware thread is
+   * used instead.
+   * @param pinThreads Whether to pin each thread to its CPU. This is only
+   * supported on Linux and is ignored elsewhere.
+   */
+  explicit NumaTaskProcessor(
+      std::vector<Node> nodes = detectNodes(),
+      bool pinThreads = true);
+
+  /**
+   * @brief Runs any remaining tasks and then stops the threads.
+   */
+  virtual ~NumaTaskProcessor() noexcept override;
+
+  NumaTaskProcessor(const NumaTaskProcessor&) = delete;
+  NumaTaskProcessor& operator=(const NumaTaskProcessor&) = delete;
+
+  /**
+   * @brief Starts a task with {@link TaskPriority::Normal}.
+   *
+   * @param f The function to execute.
+   */
+  virtual void startTask(std::function<void()> f) override;
+
+  /** @copydoc ITaskProcessor::startTaskWithPriority */
+  virtual void startTaskWithPriority(
+      std::function<void()> f,
+      TaskPriority priority) override;
+
+  /**
+   * @brief Gets the number of nodes that have threads.
+   */
+  size_t getNumberOfNodes() const noexcept;
+
+  /**
+   * @brief Gets the total number of threads across all nodes.
+   */
+  uint32_t getNumberOfThreads() const noexcept;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> _pImpl;
+};
+
+} // namespace CesiumAsync
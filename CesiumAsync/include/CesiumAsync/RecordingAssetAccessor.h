@@ -0,0 +1,99 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that keeps every completed
+ * request of the underlying Asset Accessor, so that a session can be replayed
+ * later without the network.
+ *
+ * Requests are recorded in the order in which they complete. Requests that
+ * finish without a response, such as abandoned ones, are not recorded. The
+ * recorded requests, and the data of their responses, stay in memory until
+ * {@link clear} is called.
+ */
+class CESIUMASYNC_API RecordingAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} whose requests
+   * are recorded.
+   */
+  RecordingAssetAccessor(const std::shared_ptr<IAssetAccessor>& pAssetAccessor);
+
+  virtual ~RecordingAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::getWithCancellation */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithCancellation(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken) override;
+
+  /** @copydoc IAssetAccessor::getWithOptions */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithOptions(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const AssetRequestOptions& options) override;
+
+  /** @copydoc IAssetAccessor::getBatch */
+  virtual std::vector<Future<std::shared_ptr<IAssetRequest>>> getBatch(
+      const AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the requests that have completed so far, in the order in
+   * which they completed.
+   *
+   * This may be called from any thread.
+   */
+  std::vector<std::shared_ptr<IAssetRequest>> getRecordedRequests() const;
+
+  /**
+   * @brief Forgets the requests that have completed so far.
+   */
+  void clear();
+
+private:
+  Future<std::shared_ptr<IAssetRequest>>
+  record(Future<std::shared_ptr<IAssetRequest>>&& future);
+
+  struct Recording {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<IAssetRequest>> requests;
+  };
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<Recording> _pRecording;
+};
+} // namespace CesiumAsync
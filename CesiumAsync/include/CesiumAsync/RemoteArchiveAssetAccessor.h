@@ -0,0 +1,100 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that serves the entries of
+ * `.3tz` archives on a web server with HTTP range requests, so that a tileset
+ * packaged in a single archive can be streamed without downloading or
+ * extracting the whole archive.
+ *
+ * Entries are requested with URLs that continue past the archive, such as
+ * `https://example.com/city.3tz/tileset.json`. The central directory of each
+ * archive is read once, with a request for the end of the archive and, if the
+ * directory is larger than that, a request for the rest of it. It is kept for
+ * the lifetime of the accessor. Each entry is then read with one request for
+ * its range of the archive, and is inflated if it is compressed. The query
+ * of the URL, such as an access token, is kept in the requests for the
+ * archive.
+ *
+ * The entries requested together with {@link getBatch}, such as the children
+ * of a tile, are usually close together within the archive, so entries of the
+ * same archive that are separated by at most a given number of bytes are read
+ * with a single request.
+ *
+ * A missing entry produces a response with status code 404, and a failed
+ * request for the archive produces a response with the status code of that
+ * request. Servers that ignore the `Range` header and send the whole archive
+ * are supported, if slowly. Other URLs, including `file://` URLs of archives,
+ * which {@link FileAssetAccessor} maps instead, are passed to the underlying
+ * accessor unchanged.
+ */
+class RemoteArchiveAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} used to
+   * request the ranges of the archives, and all other assets.
+   * @param maximumCoalescingGap The largest number of unneeded bytes between
+   * two entries that are read with a single request.
+   */
+  RemoteArchiveAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      uint64_t maximumCoalescingGap = 65536);
+
+  virtual ~RemoteArchiveAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::getWithCancellation */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithCancellation(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken) override;
+
+  /** @copydoc IAssetAccessor::getWithOptions */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithOptions(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const AssetRequestOptions& options) override;
+
+  /** @copydoc IAssetAccessor::getBatch */
+  virtual std::vector<Future<std::shared_ptr<IAssetRequest>>> getBatch(
+      const AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers) override;
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+private:
+  struct IndexCache;
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  uint64_t _maximumCoalescingGap;
+  std::shared_ptr<IndexCache> _pIndices;
+};
+} // namespace CesiumAsync
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ICacheDatabase.h"
+#include "Library.h"
+
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A cache that spreads its entries across several other
+ * {@link ICacheDatabase} instances, called shards, by the hash of their keys.
+ *
+ * Each key is always stored in and looked up from the same shard. When the
+ * shards are {@link SqliteCache} instances with their own database files, each
+ * has its own lock, connection, and write-ahead log, so lookups and stores on
+ * many threads no longer all wait on a single database.
+ */
+class CESIUMASYNC_API ShardedCacheDatabase : public ICacheDatabase {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * The shards must not be shared with another {@link ShardedCacheDatabase},
+   * and must be given in the same order every time, because the order
+   * determines which shard holds each key.
+   *
+   * @param shards The databases that store the entries.
+   * @throws std::invalid_argument If there are no shards, or one is nullptr.
+   */
+  explicit ShardedCacheDatabase(
+      std::vector<std::shared_ptr<ICacheDatabase>>&& shards);
+
+  /**
+   * @brief Creates {@link SqliteCache} shards, each with its own database file.
+   *
+   * The database files are named `databaseName` followed by a dash and the
+   * index of the shard, such as `cache.sqlite-0`.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param databaseName The path of the database files, before the index of
+   * the shard.
+   * @param shardCount The number of shards.
+   * @param maxItems The maximum number of items to keep across all shards
+   * after pruning. Each shard keeps an equal share of them.
+   * @return The shards, to pass to the constructor.
+   */
+  static std::vector<std::shared_ptr<ICacheDatabase>> createSqliteShards(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& databaseName,
+      uint32_t shardCount,
+      uint64_t maxItems = 4096);
+
+  /** @copydoc ICacheDatabase::getEntry*/
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::storeEntry*/
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * @copydoc ICacheDatabase::storeEntries
+   *
+   * The entries are grouped by shard, and each shard stores its group at
+   * once.
+   */
+  virtual size_t storeEntries(const std::vector<CacheEntry>& entries) override;
+
+  /**
+   * @copydoc ICacheDatabase::prune
+   *
+   * Every shard is pruned, even if pruning an earlier one fails.
+   */
+  virtual bool prune() override;
+
+  /**
+   * @copydoc ICacheDatabase::clearAll
+   *
+   * Every shard is cleared, even if clearing an earlier one fails.
+   */
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the shards that store the entries.
+   */
+  const std::vector<std::shared_ptr<ICacheDatabase>>& getShards() const {
+    return this->_shards;
+  }
+
+  /**
+   * @brief Gets the index of the shard that stores the entry with the given
+   * key.
+   */
+  size_t getShardIndex(const std::string& key) const;
+
+private:
+  std::vector<std::shared_ptr<ICacheDatabase>> _shards;
+};
+
+} // namespace CesiumAsync
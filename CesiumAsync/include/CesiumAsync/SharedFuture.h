@@ -3,6 +3,7 @@
 #include "Impl/AsyncSystemSchedulers.h"
 #include "Impl/CatchFunction.h"
 #include "Impl/ContinuationFutureType.h"
+#include "Impl/Coroutines.h"
 #include "Impl/WithTracing.h"
 #include "ThreadPool.h"
 
@@ -51,11 +52,36 @@ public:
   template <typename Func>
   CesiumImpl::ContinuationFutureType_t<Func, T> thenInWorkerThread(Func&& f) {
     return this->thenWithScheduler(
-        this->_pSchedulers->workerThread.immediate,
+        this->_pSchedulers->workerThread.immediate(),
         "waiting for worker thread",
         std::forward<Func>(f));
   }
 
+  /**
+   * @brief Registers an I/O-bound continuation function to be invoked in a
+   * background thread when this Future resolves.
+   *
+   * The continuation runs with the {@link AsyncSystem}'s I/O task processor,
+   * or with its worker thread task processor if it doesn't have one.
+   *
+   * If the function itself returns a `Future`, the function will not be
+   * considered complete until that returned `Future` also resolves.
+   *
+   * If this Future is resolved from a designated I/O thread, the continuation
+   * function will be invoked immediately rather than in a separate task.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  CesiumImpl::ContinuationFutureType_t<Func, T> thenInIOThread(Func&& f) {
+    return this->thenWithScheduler(
+        this->_pSchedulers->ioThread().immediate(),
+        "waiting for I/O thread",
+        std::forward<Func>(f));
+  }
+
   /**
    * @brief Registers a continuation function to be invoked in the main thread
    * when this Future resolves.
@@ -269,11 +295,46 @@ public:
    */
   bool isReady() const { return this->_task.ready(); }
 
+  /**
+   * @brief Determines if a coroutine awaiting this future with `co_await` can
+   * continue without suspending.
+   *
+   * This and the other `await_` methods let C++20 coroutines `co_await` a
+   * shared future. A coroutine that awaits a future that is not yet resolved
+   * continues in whichever thread resolves it.
+   *
+   * @return True if this future is already resolved or rejected.
+   */
+  bool await_ready() const { return this->isReady(); }
+
+  /**
+   * @brief Arranges for the given suspended coroutine to be resumed when this
+   * future resolves or rejects.
+   *
+   * @param handle The handle of the awaiting coroutine.
+   */
+  template <typename THandle> void await_suspend(THandle handle) {
+    this->_task.then(
+        async::inline_scheduler(),
+        [handle](const async::shared_task<T>& /*task*/) mutable {
+          handle.resume();
+        });
+  }
+
+  /**
+   * @brief Gets the result of this future when a coroutine continues after
+   * awaiting it.
+   *
+   * @return The value if the future resolved successfully.
+   * @throws An exception if the future rejected.
+   */
+  decltype(auto) await_resume() const { return this->wait(); }
+
 private:
   SharedFuture(
-      const std::shared_ptr<CesiumImpl::AsyncSystemSchedulers>& pSchedulers,
+      std::shared_ptr<CesiumImpl::AsyncSystemSchedulers> pSchedulers,
       async::shared_task<T>&& task) noexcept
-      : _pSchedulers(pSchedulers), _task(std::move(task)) {}
+      : _pSchedulers(std::move(pSchedulers)), _task(std::move(task)) {}
 
   template <typename Func, typename Scheduler>
   CesiumImpl::ContinuationFutureType_t<Func, T>
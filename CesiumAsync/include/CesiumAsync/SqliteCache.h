@@ -4,13 +4,36 @@
 
 #include <spdlog/fwd.h>
 
+#include <chrono>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 
 namespace CesiumAsync {
 
+/**
+ * @brief How {@link SqliteCache} compresses the response data that it stores.
+ */
+enum class SqliteCacheCompression {
+  /**
+   * @brief Response data is stored as it is.
+   */
+  None,
+
+  /**
+   * @brief Response data that is likely to compress well, such as JSON and
+   * uncompressed binary, is deflated with zlib.
+   *
+   * Images, data with a `Content-Encoding`, data that starts with the
+   * signature of a compressed format such as KTX2 or Draco, and small
+   * responses are stored as they are, as is any response that deflating
+   * doesn't make at least an eighth smaller.
+   */
+  Deflate
+};
+
 /**
  * @brief Cache storage using SQLITE to store completed response.
  */
@@ -25,13 +48,43 @@ public:
    *
    * @param pLogger The logger that receives error messages.
    * @param databaseName the database path.
+   * When `writeBatchSize` is greater than one, {@link storeEntry} buffers
+   * entries in memory and writes them in a single transaction once
+   * `writeBatchSize` entries are pending, or once the oldest pending entry is
+   * older than `writeBatchInterval` when the next entry is stored. Pending
+   * entries are served by {@link getEntry} and are also written by
+   * {@link flush}, {@link prune}, and the destructor.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param databaseName the database path.
    * @param maxItems the maximum number of items should be kept in the database
    * after prunning.
+   * @param writeBatchSize The maximum number of entries to buffer before they
+   * are written to the database. A value of 1 writes each entry immediately.
+   * @param writeBatchInterval The maximum age of a buffered entry before the
+   * buffer is written on the next store.
+   * @param readConnections The number of read-only connections used by
+   * {@link getEntry}. With more than one, cache lookups on different threads
+   * run concurrently instead of sharing the single writer connection. This
+   * requires a database file, because each connection opens it separately.
+   * @param compression How newly stored response data is compressed. Each
+   * entry records how it was compressed, so a database can be opened with a
+   * different setting than the one its entries were stored with.
+   * @param mmapSize The maximum number of bytes of the database file that
+   * SQLite reads through a memory mapping instead of copying them into its page
+   * cache, see `PRAGMA mmap_size`. Zero uses SQLite's default, which is usually
+   * no memory mapping.
    */
   SqliteCache(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& databaseName,
-      uint64_t maxItems = 4096);
+      uint64_t maxItems = 4096,
+      uint32_t writeBatchSize = 1,
+      std::chrono::milliseconds writeBatchInterval =
+          std::chrono::milliseconds(100),
+      uint32_t readConnections = 1,
+      SqliteCacheCompression compression = SqliteCacheCompression::None,
+      uint64_t mmapSize = 0);
   ~SqliteCache();
 
   /** @copydoc ICacheDatabase::getEntry*/
@@ -49,16 +102,58 @@ public:
       const HttpHeaders& responseHeaders,
       const gsl::span<const std::byte>& responseData) override;
 
+  /**
+   * @brief Stores many cache entries at once, such as to fill a cache before it
+   * is used offline.
+   *
+   * The entries are written with one transaction for each batch of up to 1024
+   * entries, which is much faster than storing them one at a time. Other
+   * threads may use the cache between batches. Entries buffered by
+   * {@link storeEntry} are written first.
+   *
+   * @param entries The entries to store. An entry replaces any existing entry
+   * with the same key.
+   * @return The number of entries that were stored. If an error occurs, the
+   * batch in which it occurred and all the later batches are not stored.
+   */
+  virtual size_t storeEntries(const std::vector<CacheEntry>& entries) override;
+
+  /**
+   * @brief Reads every entry in the cache, such as to copy it into another
+   * cache with {@link storeEntries}.
+   *
+   * Entries buffered by {@link storeEntry} are written first. The entries are
+   * read in chunks, and the callback is called without holding the cache's
+   * lock, so other threads may use the cache during an export. An entry that
+   * is stored during the export may or may not be exported, and may be
+   * exported twice if it replaces an entry with the same key. Reading an entry
+   * doesn't update the time that it was last accessed.
+   *
+   * @param callback The function that receives each entry. It returns `false`
+   * to stop the export.
+   * @return `true` if the entries were read, or `false` if there was an error.
+   */
+  bool exportEntries(const std::function<bool(CacheEntry&& entry)>& callback);
+
   /** @copydoc ICacheDatabase::prune*/
   virtual bool prune() override;
 
   /** @copydoc ICacheDatabase::clearAll*/
   virtual bool clearAll() override;
 
+  /**
+   * @brief Writes all entries buffered by {@link storeEntry} to the database
+   * in a single transaction.
+   *
+   * @return true if the entries were written, false if there was an error.
+   */
+  bool flush();
+
 private:
   struct Impl;
   std::unique_ptr<Impl> _pImpl;
   void createConnection() const;
   void destroyDatabase();
+  bool flushPendingWrites();
 };
 } // namespace CesiumAsync
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Gets the affinity key of worker thread tasks started by the current
+ * thread.
+ *
+ * An {@link ITaskProcessor} with more than one group of threads, such as
+ * {@link NumaTaskProcessor}, runs tasks with the same key on the same group of
+ * threads, so that data shared by those tasks stays close to them. A key of 0,
+ * the default, means that the task has no affinity. Inside a task started by
+ * such a task processor, it is the key of that task, so work started from a
+ * task inherits its key.
+ */
+CESIUMASYNC_API uint64_t getCurrentTaskAffinity() noexcept;
+
+/**
+ * @brief Sets the affinity key of worker thread tasks started by the current
+ * thread for the lifetime of this object.
+ */
+class CESIUMASYNC_API ScopedTaskAffinity {
+public:
+  /**
+   * @brief Sets the current thread's task affinity key.
+   *
+   * @param key The key to use until this object is destroyed, or 0 for no
+   * affinity.
+   */
+  explicit ScopedTaskAffinity(uint64_t key) noexcept;
+
+  /**
+   * @brief Restores the task affinity key that was in effect before this
+   * object was created.
+   */
+  ~ScopedTaskAffinity() noexcept;
+
+  ScopedTaskAffinity(const ScopedTaskAffinity&) = delete;
+  ScopedTaskAffinity& operator=(const ScopedTaskAffinity&) = delete;
+
+private:
+  uint64_t _previous;
+};
+
+} // namespace CesiumAsync
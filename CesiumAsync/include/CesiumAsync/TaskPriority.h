@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The priority of a task started in a worker thread.
+ *
+ * An {@link ITaskProcessor} that supports priorities runs all ready tasks of a
+ * higher priority before any ready task of a lower priority.
+ */
+enum class TaskPriority : uint8_t {
+  /**
+   * @brief Work that is not needed right now, such as preloading.
+   */
+  Low = 0,
+
+  /**
+   * @brief Work that does not specify a priority.
+   */
+  Normal = 1,
+
+  /**
+   * @brief Work that is needed urgently.
+   */
+  High = 2
+};
+
+/**
+ * @brief Gets the priority of worker thread tasks created by the current
+ * thread.
+ *
+ * This is {@link TaskPriority::Normal} unless changed by a
+ * {@link ScopedTaskPriority}. Inside a worker thread task, it is the priority
+ * of that task, so work started from a task inherits the task's priority.
+ */
+CESIUMASYNC_API TaskPriority getCurrentTaskPriority() noexcept;
+
+/**
+ * @brief Sets the priority of worker thread tasks created by the current
+ * thread for the lifetime of this object.
+ *
+ * The priority applies to continuations at the time they are created, such as
+ * by {@link AsyncSystem::runInWorkerThread} or
+ * {@link Future::thenInWorkerThread}, not at the time they are run.
+ */
+class CESIUMASYNC_API ScopedTaskPriority {
+public:
+  /**
+   * @brief Sets the current thread's task priority.
+   *
+   * @param priority The priority to use until this object is destroyed.
+   */
+  explicit ScopedTaskPriority(TaskPriority priority) noexcept;
+
+  /**
+   * @brief Restores the task priority that was in effect before this object
+   * was created.
+   */
+  ~ScopedTaskPriority() noexcept;
+
+  ScopedTaskPriority(const ScopedTaskPriority&) = delete;
+  ScopedTaskPriority& operator=(const ScopedTaskPriority&) = delete;
+
+private:
+  TaskPriority _previous;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+#include "NetworkThroughputEstimator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that reports the time and
+ * size of every request of the underlying Asset Accessor to a
+ * {@link NetworkThroughputEstimator}.
+ *
+ * A request is measured from the call that starts it until the future it
+ * returns resolves or rejects.
+ */
+class CESIUMASYNC_API ThroughputMeasuringAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} whose requests
+   * are measured.
+   * @param pEstimator The estimator to report the requests to.
+   */
+  ThroughputMeasuringAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<NetworkThroughputEstimator>& pEstimator);
+
+  virtual ~ThroughputMeasuringAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::getWithCancellation */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithCancellation(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CancellationToken& cancellationToken) override;
+
+  /** @copydoc IAssetAccessor::getWithOptions */
+  virtual Future<std::shared_ptr<IAssetRequest>> getWithOptions(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const AssetRequestOptions& options) override;
+
+  /** @copydoc IAssetAccessor::getBatch */
+  virtual std::vector<Future<std::shared_ptr<IAssetRequest>>> getBatch(
+      const AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers) override;
+
+  /** @copydoc IAssetAccessor::request */
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the estimator that the requests are reported to.
+   */
+  const std::shared_ptr<NetworkThroughputEstimator>&
+  getEstimator() const noexcept {
+    return this->_pEstimator;
+  }
+
+private:
+  NetworkThroughputEstimator::Clock::time_point startRequest() noexcept;
+  Future<std::shared_ptr<IAssetRequest>> measure(
+      NetworkThroughputEstimator::Clock::time_point startTime,
+      Future<std::shared_ptr<IAssetRequest>>&& future);
+
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<NetworkThroughputEstimator> _pEstimator;
+};
+} // namespace CesiumAsync
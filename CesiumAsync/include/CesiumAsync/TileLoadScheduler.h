@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Shares a single budget of simultaneous tile loads between several
+ * tilesets and raster overlays.
+ *
+ * Each tileset and raster overlay tile provider still applies its own
+ * `maximumSimultaneousTileLoads`, and a load is only started when both it and
+ * this scheduler have capacity.
+ *
+ * So that the high-priority loads of one tileset are not starved by the
+ * low-priority loads of another, lower priorities can't fill the entire
+ * budget. Normal loads leave {@link getReservedLoads} slots free for urgent
+ * loads, and preloads leave twice as many free. Every priority is always
+ * allowed at least one load.
+ *
+ * Loads are started and finished in the main thread, so this class is not
+ * thread-safe.
+ */
+class CESIUMASYNC_API TileLoadScheduler final {
+public:
+  /**
+   * @brief The priority of a load, from lowest to highest.
+   */
+  enum class Priority {
+    /**
+     * @brief A load of a tile that isn't needed yet, but probably will be
+     * soon.
+     */
+    Preload = 0,
+
+    /**
+     * @brief A load of a tile that is needed to render the current view.
+     */
+    Normal = 1,
+
+    /**
+     * @brief A load of a tile that is blocking other tiles from rendering.
+     */
+    Urgent = 2
+  };
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumSimultaneousLoads The maximum number of loads that may be in
+   * progress at once, across everything that shares this scheduler.
+   * @param reservedLoads The number of load slots that normal-priority loads
+   * leave free for urgent ones.
+   */
+  TileLoadScheduler(
+      uint32_t maximumSimultaneousLoads,
+      uint32_t reservedLoads = 0) noexcept;
+
+  /**
+   * @brief Gets the maximum number of loads that may be in progress at once.
+   */
+  uint32_t getMaximumSimultaneousLoads() const noexcept {
+    return this->_maximumSimultaneousLoads;
+  }
+
+  /**
+   * @brief Sets the maximum number of loads that may be in progress at once.
+   *
+   * Loads that are already in progress are not affected.
+   */
+  void setMaximumSimultaneousLoads(uint32_t value) noexcept {
+    this->_maximumSimultaneousLoads = value;
+  }
+
+  /**
+   * @brief Gets the number of load slots that normal-priority loads leave free
+   * for urgent ones.
+   */
+  uint32_t getReservedLoads() const noexcept { return this->_reservedLoads; }
+
+  /**
+   * @brief Sets the number of load slots that normal-priority loads leave free
+   * for urgent ones.
+   */
+  void setReservedLoads(uint32_t value) noexcept {
+    this->_reservedLoads = value;
+  }
+
+  /**
+   * @brief Gets the number of loads currently in progress.
+   */
+  uint32_t getNumberOfLoadsInProgress() const noexcept {
+    return this->_loadsInProgress;
+  }
+
+  /**
+   * @brief Determines whether a load with the given priority may start now.
+   *
+   * @param priority The priority of the load.
+   * @return True if the load may start, false if it should wait for other
+   * loads to finish.
+   */
+  bool canStartLoad(Priority priority) const noexcept;
+
+  /**
+   * @brief Notifies this scheduler that a load has started.
+   *
+   * This must be called for every load, even ones that start without checking
+   * {@link canStartLoad}, and must be balanced by a call to
+   * {@link notifyLoadFinished}.
+   */
+  void notifyLoadStarted() noexcept;
+
+  /**
+   * @brief Notifies this scheduler that a load has finished, whether it
+   * succeeded or failed.
+   */
+  void notifyLoadFinished() noexcept;
+
+private:
+  uint32_t _maximumSimultaneousLoads;
+  uint32_t _reservedLoads;
+  uint32_t _loadsInProgress;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ITaskProcessor.h"
+#include "Library.h"
+#include "TaskPriority.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace CesiumAsync {
+
+/**
+ * @brief An {@link ITaskProcessor} that runs tasks on its own pool of threads,
+ * honoring {@link TaskPriority}.
+ *
+ * Each thread has its own queue per priority. Tasks started from one of the
+ * pool's threads are added to that thread's queue, where they are run in
+ * last-in first-out order while their data is still in the CPU cache. Tasks
+ * started from other threads go to a shared queue. A thread with nothing to do
+ * steals the oldest task from another thread's queue.
+ *
+ * A thread always looks for work of a higher priority, in every queue, before
+ * running work of a lower priority. So, for example, an urgent tile's decode
+ * jumps ahead of a backlog of preloading decodes.
+ *
+ * Tasks that are still queued when this object is destroyed are run before the
+ * destructor returns.
+ */
+class CESIUMASYNC_API WorkStealingTaskProcessor : public ITaskProcessor {
+public:
+  /**
+   * @brief Creates a new instance and starts its threads.
+   *
+   * @param numberOfThreads The number of threads to create. If zero, one
+   * thread is created per hardware thread.
+   */
+  explicit WorkStealingTaskProcessor(uint32_t numberOfThreads = 0);
+
+  /**
+   * @brief Runs any remaining tasks and then stops the threads.
+   */
+  virtual ~WorkStealingTaskProcessor() noexcept override;
+
+  WorkStealingTaskProcessor(const WorkStealingTaskProcessor&) = delete;
+  WorkStealingTaskProcessor&
+  operator=(const WorkStealingTaskProcessor&) = delete;
+
+  /**
+   * @brief Starts a task with {@link TaskPriority::Normal}.
+   *
+   * @param f The function to execute.
+   */
+  virtual void startTask(std::function<void()> f) override;
+
+  /** @copydoc ITaskProcessor::startTaskWithPriority */
+  virtual void startTaskWithPriority(
+      std::function<void()> f,
+      TaskPriority priority) override;
+
+  /**
+   * @brief Gets the number of threads in the pool.
+   */
+  uint32_t getNumberOfThreads() const noexcept;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> _pImpl;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,39 @@
+#include "CesiumAsync/AssetRequestOptions.h"
+
+namespace CesiumAsync {
+
+AssetRequestPriority::AssetRequestPriority(
+    TaskPriority urgency,
+    double priority) noexcept
+    : _mutex(), _urgency(urgency), _priority(priority) {}
+
+TaskPriority AssetRequestPriority::getUrgency() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_urgency;
+}
+
+double AssetRequestPriority::getPriority() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_priority;
+}
+
+void AssetRequestPriority::set(TaskPriority urgency, double priority) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_urgency = urgency;
+  this->_priority = priority;
+}
+
+std::string AssetRequestPriority::getHttpPriorityHeaderValue() const {
+  // RFC 9218 urgencies run from 0, the most urgent, to 7, with 3 the default.
+  switch (this->getUrgency()) {
+  case TaskPriority::High:
+    return "u=1";
+  case TaskPriority::Low:
+    return "u=5";
+  case TaskPriority::Normal:
+  default:
+    return "u=3";
+  }
+}
+
+} // namespace CesiumAsync
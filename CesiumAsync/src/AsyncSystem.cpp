@@ -9,10 +9,22 @@ AsyncSystem::AsyncSystem(
           std::make_shared<CesiumImpl::AsyncSystemSchedulers>(pTaskProcessor)) {
 }
 
+AsyncSystem::AsyncSystem(
+    const std::shared_ptr<ITaskProcessor>& pTaskProcessor,
+    const std::shared_ptr<ITaskProcessor>& pIOTaskProcessor) noexcept
+    : _pSchedulers(std::make_shared<CesiumImpl::AsyncSystemSchedulers>(
+          pTaskProcessor,
+          pIOTaskProcessor)) {}
+
 void AsyncSystem::dispatchMainThreadTasks() {
   this->_pSchedulers->mainThread.dispatchQueuedContinuations();
 }
 
+bool AsyncSystem::dispatchMainThreadTasks(double maximumTimeInMilliseconds) {
+  return this->_pSchedulers->mainThread.dispatchQueuedContinuations(
+      maximumTimeInMilliseconds);
+}
+
 bool AsyncSystem::dispatchOneMainThreadTask() {
   return this->_pSchedulers->mainThread.dispatchZeroOrOneContinuation();
 }
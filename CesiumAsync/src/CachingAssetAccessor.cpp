@@ -3,15 +3,24 @@
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/CacheItem.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumAsync/SharedFuture.h"
 #include "InternalTimegm.h"
 #include "ResponseCacheControl.h"
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <cctype>
 #include <cstddef>
+#include <ctime>
 #include <iomanip>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace CesiumAsync {
 class CacheAssetResponse : public IAssetResponse {
@@ -73,7 +82,31 @@ private:
 
 static std::time_t convertHttpDateToTime(const std::string& httpDate);
 
-static bool shouldRevalidateCache(const CacheItem& cacheItem);
+static bool shouldRevalidateCache(
+    const CacheItem& cacheItem,
+    const std::optional<ResponseCacheControl>& cacheControl);
+
+static bool canServeStale(
+    const CacheItem& cacheItem,
+    const std::optional<ResponseCacheControl>& cacheControl,
+    CachingAssetAccessor::StaleWhileRevalidate staleWhileRevalidate);
+
+static std::vector<IAssetAccessor::THeader> createRevalidationHeaders(
+    const CacheItem& cacheItem,
+    const std::vector<IAssetAccessor::THeader>& headers);
+
+static std::shared_ptr<IAssetRequest> storeRevalidationResponse(
+    CacheItem&& cacheItem,
+    std::shared_ptr<IAssetRequest>&& pCompletedRequest,
+    ICacheDatabase& cacheDatabase,
+    int32_t negativeCacheDuration,
+    const std::string& cacheKey);
+
+static void storeResponse(
+    const IAssetRequest& request,
+    ICacheDatabase& cacheDatabase,
+    int32_t negativeCacheDuration,
+    const std::string& cacheKey);
 
 static bool isCacheStale(const CacheItem& cacheItem) noexcept;
 
@@ -81,7 +114,15 @@ static bool shouldCacheRequest(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl);
 
-static std::string calculateCacheKey(const IAssetRequest& request);
+static bool shouldNegativelyCacheRequest(
+    const IAssetRequest& request,
+    const std::optional<ResponseCacheControl>& cacheControl,
+    int32_t negativeCacheDuration);
+
+static std::string removeQueryParameters(
+    const std::string& url,
+    const std::vector<CachingAssetAccessor::IgnoredQueryParameter>&
+        parameters);
 
 static std::time_t calculateExpiryTime(
     const IAssetRequest& request,
@@ -90,39 +131,145 @@ static std::time_t calculateExpiryTime(
 static std::unique_ptr<IAssetRequest>
 updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request);
 
+static std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers);
+
+struct CachingAssetAccessor::InFlightRequests {
+  std::mutex mutex;
+  std::unordered_map<std::string, SharedFuture<std::shared_ptr<IAssetRequest>>>
+      requests;
+
+  // The URLs of stale responses that were returned before they were
+  // revalidated, and are still being revalidated.
+  std::unordered_set<std::string> revalidations;
+
+  void remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->requests.erase(key);
+  }
+
+  bool startRevalidation(const std::string& url) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->revalidations.insert(url).second;
+  }
+
+  void finishRevalidation(const std::string& url) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->revalidations.erase(url);
+  }
+};
+
 CachingAssetAccessor::CachingAssetAccessor(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-    int32_t requestsPerCachePrune)
+    int32_t requestsPerCachePrune,
+    StaleWhileRevalidate staleWhileRevalidate,
+    int32_t negativeCacheDuration,
+    CacheKeyFunction cacheKeyFunction)
     : _requestsPerCachePrune(requestsPerCachePrune),
+      _staleWhileRevalidate(staleWhileRevalidate),
+      _negativeCacheDuration(negativeCacheDuration),
+      _cacheKeyFunction(std::move(cacheKeyFunction)),
       _requestSinceLastPrune(0),
       _pLogger(pLogger),
       _pAssetAccessor(pAssetAccessor),
       _pCacheDatabase(pCacheDatabase),
-      _cacheThreadPool(1) {}
+      _cacheThreadPool(1),
+      _pInFlightRequests(std::make_shared<InFlightRequests>()) {}
 
 CachingAssetAccessor::~CachingAssetAccessor() noexcept {}
 
+const std::vector<CachingAssetAccessor::IgnoredQueryParameter>&
+CachingAssetAccessor::getTokenQueryParameters() {
+  static const std::vector<IgnoredQueryParameter> parameters{
+      {"access_token", "assets.ion.cesium.com"},
+      {"access_token", "assets.cesium.com"},
+      {"key", "virtualearth.net"}};
+  return parameters;
+}
+
+CachingAssetAccessor::CacheKeyFunction
+CachingAssetAccessor::createCacheKeyFunction(
+    const std::vector<IgnoredQueryParameter>& ignoredQueryParameters) {
+  return [ignoredQueryParameters](
+             const std::string& url,
+             const std::vector<THeader>& /*headers*/) {
+    return removeQueryParameters(url, ignoredQueryParameters);
+  };
+}
+
 Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
     const AsyncSystem& asyncSystem,
     const std::string& url,
     const std::vector<THeader>& headers) {
+  const auto shareRequest =
+      [](const std::shared_ptr<IAssetRequest>& pRequest) { return pRequest; };
+
+  std::string key = calculateInFlightKey(url, headers);
+  std::optional<Promise<std::shared_ptr<IAssetRequest>>> maybePromise;
+  std::optional<SharedFuture<std::shared_ptr<IAssetRequest>>> maybeShared;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_pInFlightRequests->mutex);
+    auto it = this->_pInFlightRequests->requests.find(key);
+    if (it != this->_pInFlightRequests->requests.end()) {
+      return it->second.thenImmediately(shareRequest);
+    }
+
+    maybePromise = asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+    maybeShared = maybePromise->getFuture().share();
+    this->_pInFlightRequests->requests.emplace(key, *maybeShared);
+  }
+
+  // The request is removed from the map before the promise is resolved, so a
+  // request that starts after this one completes always gets a fresh result,
+  // even if the underlying request completes synchronously.
+  this->_getWithoutCoalescing(asyncSystem, url, headers)
+      .thenImmediately([pInFlightRequests = this->_pInFlightRequests,
+                        key,
+                        promise = *maybePromise](
+                           std::shared_ptr<IAssetRequest>&& pRequest) {
+        pInFlightRequests->remove(key);
+        promise.resolve(std::move(pRequest));
+      })
+      .catchImmediately([pInFlightRequests = this->_pInFlightRequests,
+                         key,
+                         promise = *maybePromise](std::exception&& e) {
+        pInFlightRequests->remove(key);
+        promise.reject(std::move(e));
+      });
+
+  return maybeShared->thenImmediately(shareRequest);
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+CachingAssetAccessor::_getWithoutCoalescing(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
   const int32_t requestSinceLastPrune = ++this->_requestSinceLastPrune;
   if (requestSinceLastPrune == this->_requestsPerCachePrune) {
     // More requests may have started and incremented _requestSinceLastPrune
     // beyond _requestsPerCachePrune before this next line. That's ok.
     this->_requestSinceLastPrune = 0;
 
+    // Prune in an I/O thread rather than the cache thread, so that cache
+    // lookups are not queued behind it. The database prunes incrementally, so
+    // lookups and stores can interleave with a long prune.
     CESIUM_TRACE_USE_TRACK_SET(this->_pruneSlots);
-    asyncSystem.runInThreadPool(this->_cacheThreadPool, [this]() {
-      this->_pCacheDatabase->prune();
+    asyncSystem.runInIOThread([pCacheDatabase = this->_pCacheDatabase]() {
+      pCacheDatabase->prune();
     });
   }
 
-  CESIUM_TRACE_BEGIN_IN_TRACK("IAssetAccessor::get (cached)");
+  CESIUM_TRACE_BEGIN_IN_TRACK_CATEGORY(Network, "IAssetAccessor::get (cached)");
 
   const ThreadPool& threadPool = this->_cacheThreadPool;
+  std::string cacheKey = this->_cacheKeyFunction
+                             ? this->_cacheKeyFunction(url, headers)
+                             : url;
 
   return asyncSystem
       .runInThreadPool(
@@ -131,114 +278,96 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
            pAssetAccessor = this->_pAssetAccessor,
            pCacheDatabase = this->_pCacheDatabase,
            pLogger = this->_pLogger,
+           pInFlightRequests = this->_pInFlightRequests,
+           staleWhileRevalidate = this->_staleWhileRevalidate,
+           negativeCacheDuration = this->_negativeCacheDuration,
            url,
            headers,
+           cacheKey = std::move(cacheKey),
            threadPool]() -> Future<std::shared_ptr<IAssetRequest>> {
             std::optional<CacheItem> cacheLookup =
-                pCacheDatabase->getEntry(url);
+                pCacheDatabase->getEntry(cacheKey);
             if (!cacheLookup) {
               // No cache item found, request directly from the server
               return pAssetAccessor->get(asyncSystem, url, headers)
                   .thenInThreadPool(
                       threadPool,
-                      [pCacheDatabase, pLogger](
+                      [pCacheDatabase, negativeCacheDuration, cacheKey](
                           std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
-                        const IAssetResponse* pResponse =
-                            pCompletedRequest->response();
-                        if (!pResponse) {
-                          return std::move(pCompletedRequest);
-                        }
-
-                        const std::optional<ResponseCacheControl> cacheControl =
-                            ResponseCacheControl::parseFromResponseHeaders(
-                                pResponse->headers());
-
-                        if (pResponse && shouldCacheRequest(
-                                             *pCompletedRequest,
-                                             cacheControl)) {
-                          pCacheDatabase->storeEntry(
-                              calculateCacheKey(*pCompletedRequest),
-                              calculateExpiryTime(
-                                  *pCompletedRequest,
-                                  cacheControl),
-                              pCompletedRequest->url(),
-                              pCompletedRequest->method(),
-                              pCompletedRequest->headers(),
-                              pResponse->statusCode(),
-                              pResponse->headers(),
-                              pResponse->data());
-                        }
-
+                        storeResponse(
+                            *pCompletedRequest,
+                            *pCacheDatabase,
+                            negativeCacheDuration,
+                            cacheKey);
                         return std::move(pCompletedRequest);
                       });
             }
 
             CacheItem& cacheItem = cacheLookup.value();
 
-            if (shouldRevalidateCache(cacheItem)) {
+            const std::optional<ResponseCacheControl> cacheControl =
+                ResponseCacheControl::parseFromResponseHeaders(
+                    cacheItem.cacheResponse.headers);
+
+            if (shouldRevalidateCache(cacheItem, cacheControl)) {
               // Cache is stale and needs revalidation
-              std::vector<THeader> newHeaders = headers;
-              const CacheResponse& cacheResponse = cacheItem.cacheResponse;
-              const HttpHeaders& responseHeaders = cacheResponse.headers;
-              HttpHeaders::const_iterator etagHeader =
-                  responseHeaders.find("Etag");
-              if (etagHeader != responseHeaders.end()) {
-                newHeaders.emplace_back("If-None-Match", etagHeader->second);
-              } else {
-                HttpHeaders::const_iterator lastModifiedHeader =
-                    responseHeaders.find("Last-Modified");
-                if (lastModifiedHeader != responseHeaders.end())
-                  newHeaders.emplace_back(
-                      "If-Modified-Since",
-                      lastModifiedHeader->second);
+              std::vector<THeader> newHeaders =
+                  createRevalidationHeaders(cacheItem, headers);
+
+              if (!canServeStale(
+                      cacheItem,
+                      cacheControl,
+                      staleWhileRevalidate)) {
+                return pAssetAccessor->get(asyncSystem, url, newHeaders)
+                    .thenInThreadPool(
+                        threadPool,
+                        [cacheItem = std::move(cacheItem),
+                         pCacheDatabase,
+                         negativeCacheDuration,
+                         cacheKey](std::shared_ptr<IAssetRequest>&&
+                                       pCompletedRequest) mutable {
+                          return storeRevalidationResponse(
+                              std::move(cacheItem),
+                              std::move(pCompletedRequest),
+                              *pCacheDatabase,
+                              negativeCacheDuration,
+                              cacheKey);
+                        });
               }
 
-              return pAssetAccessor->get(asyncSystem, url, newHeaders)
-                  .thenInThreadPool(
-                      threadPool,
-                      [cacheItem = std::move(cacheItem),
-                       pCacheDatabase,
-                       pLogger](std::shared_ptr<IAssetRequest>&&
-                                    pCompletedRequest) mutable {
-                        if (!pCompletedRequest) {
-                          return std::move(pCompletedRequest);
-                        }
-
-                        std::shared_ptr<IAssetRequest> pRequestToStore;
-                        if (pCompletedRequest->response()->statusCode() ==
-                            304) { // status Not-Modified
-                          pRequestToStore = updateCacheItem(
+              // Return the stale response now, and update the cache with the
+              // revalidation when it completes. Only one revalidation of a URL
+              // is started at a time.
+              if (pInFlightRequests->startRevalidation(url)) {
+                pAssetAccessor->get(asyncSystem, url, newHeaders)
+                    .thenInThreadPool(
+                        threadPool,
+                        [cacheItem = CacheItem(cacheItem),
+                         pCacheDatabase,
+                         negativeCacheDuration,
+                         cacheKey](std::shared_ptr<IAssetRequest>&&
+                                       pCompletedRequest) mutable {
+                          storeRevalidationResponse(
                               std::move(cacheItem),
-                              *pCompletedRequest);
-                        } else {
-                          pRequestToStore = pCompletedRequest;
-                        }
-
-                        const IAssetResponse* pResponseToStore =
-                            pRequestToStore->response();
-                        const std::optional<ResponseCacheControl> cacheControl =
-                            ResponseCacheControl::parseFromResponseHeaders(
-                                pResponseToStore->headers());
-
-                        if (shouldCacheRequest(
-                                *pRequestToStore,
-                                cacheControl)) {
-
-                          pCacheDatabase->storeEntry(
-                              calculateCacheKey(*pRequestToStore),
-                              calculateExpiryTime(
-                                  *pRequestToStore,
-                                  cacheControl),
-                              pRequestToStore->url(),
-                              pRequestToStore->method(),
-                              pRequestToStore->headers(),
-                              pResponseToStore->statusCode(),
-                              pResponseToStore->headers(),
-                              pResponseToStore->data());
-                        }
-
-                        return pRequestToStore;
-                      });
+                              std::move(pCompletedRequest),
+                              *pCacheDatabase,
+                              negativeCacheDuration,
+                              cacheKey);
+                        })
+                    .thenImmediately([pInFlightRequests, url]() {
+                      pInFlightRequests->finishRevalidation(url);
+                    })
+                    .catchImmediately(
+                        [pInFlightRequests, pLogger, url](std::exception&& e) {
+                          pInFlightRequests->finishRevalidation(url);
+                          SPDLOG_LOGGER_WARN(
+                              pLogger,
+                              "Failed to revalidate the stale cached response "
+                              "for {}: {}",
+                              url,
+                              e.what());
+                        });
+              }
             }
 
             // Good cache item that doesn't need to be revalidated, just return
@@ -248,7 +377,9 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
             return asyncSystem.createResolvedFuture(std::move(pRequest));
           })
       .thenImmediately([](std::shared_ptr<IAssetRequest>&& pRequest) noexcept {
-        CESIUM_TRACE_END_IN_TRACK("IAssetAccessor::get (cached)");
+        CESIUM_TRACE_END_IN_TRACK_CATEGORY(
+            Network,
+            "IAssetAccessor::get (cached)");
         return std::move(pRequest);
       });
 }
@@ -265,10 +396,9 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::request(
 
 void CachingAssetAccessor::tick() noexcept { _pAssetAccessor->tick(); }
 
-bool shouldRevalidateCache(const CacheItem& cacheItem) {
-  std::optional<ResponseCacheControl> cacheControl =
-      ResponseCacheControl::parseFromResponseHeaders(
-          cacheItem.cacheResponse.headers);
+bool shouldRevalidateCache(
+    const CacheItem& cacheItem,
+    const std::optional<ResponseCacheControl>& cacheControl) {
   if (cacheControl && cacheControl->noCache())
     return true;
 
@@ -277,6 +407,116 @@ bool shouldRevalidateCache(const CacheItem& cacheItem) {
   return isCacheStale(cacheItem);
 }
 
+bool canServeStale(
+    const CacheItem& cacheItem,
+    const std::optional<ResponseCacheControl>& cacheControl,
+    CachingAssetAccessor::StaleWhileRevalidate staleWhileRevalidate) {
+  if (staleWhileRevalidate ==
+      CachingAssetAccessor::StaleWhileRevalidate::Never) {
+    return false;
+  }
+
+  // These directives forbid using a response without revalidating it first,
+  // whatever the policy.
+  if (cacheControl &&
+      (cacheControl->noCache() || cacheControl->mustRevalidate())) {
+    return false;
+  }
+
+  if (staleWhileRevalidate ==
+      CachingAssetAccessor::StaleWhileRevalidate::Always) {
+    return true;
+  }
+
+  if (!cacheControl || !cacheControl->staleWhileRevalidateExists()) {
+    return false;
+  }
+
+  const std::time_t currentTime = std::time(nullptr);
+  return std::difftime(
+             cacheItem.expiryTime + cacheControl->staleWhileRevalidateValue(),
+             currentTime) >= 0.0;
+}
+
+std::vector<IAssetAccessor::THeader> createRevalidationHeaders(
+    const CacheItem& cacheItem,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  std::vector<IAssetAccessor::THeader> newHeaders = headers;
+  const HttpHeaders& responseHeaders = cacheItem.cacheResponse.headers;
+  HttpHeaders::const_iterator etagHeader = responseHeaders.find("Etag");
+  if (etagHeader != responseHeaders.end()) {
+    newHeaders.emplace_back("If-None-Match", etagHeader->second);
+  } else {
+    HttpHeaders::const_iterator lastModifiedHeader =
+        responseHeaders.find("Last-Modified");
+    if (lastModifiedHeader != responseHeaders.end())
+      newHeaders.emplace_back("If-Modified-Since", lastModifiedHeader->second);
+  }
+  return newHeaders;
+}
+
+std::shared_ptr<IAssetRequest> storeRevalidationResponse(
+    CacheItem&& cacheItem,
+    std::shared_ptr<IAssetRequest>&& pCompletedRequest,
+    ICacheDatabase& cacheDatabase,
+    int32_t negativeCacheDuration,
+    const std::string& cacheKey) {
+  if (!pCompletedRequest) {
+    return std::move(pCompletedRequest);
+  }
+
+  std::shared_ptr<IAssetRequest> pRequestToStore;
+  if (pCompletedRequest->response()->statusCode() ==
+      304) { // status Not-Modified
+    pRequestToStore = updateCacheItem(std::move(cacheItem), *pCompletedRequest);
+  } else {
+    pRequestToStore = pCompletedRequest;
+  }
+
+  storeResponse(
+      *pRequestToStore,
+      cacheDatabase,
+      negativeCacheDuration,
+      cacheKey);
+  return pRequestToStore;
+}
+
+void storeResponse(
+    const IAssetRequest& request,
+    ICacheDatabase& cacheDatabase,
+    int32_t negativeCacheDuration,
+    const std::string& cacheKey) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return;
+  }
+
+  const std::optional<ResponseCacheControl> cacheControl =
+      ResponseCacheControl::parseFromResponseHeaders(pResponse->headers());
+
+  std::time_t expiryTime;
+  if (shouldCacheRequest(request, cacheControl)) {
+    expiryTime = calculateExpiryTime(request, cacheControl);
+  } else if (shouldNegativelyCacheRequest(
+                 request,
+                 cacheControl,
+                 negativeCacheDuration)) {
+    expiryTime = std::time(nullptr) + negativeCacheDuration;
+  } else {
+    return;
+  }
+
+  cacheDatabase.storeEntry(
+      cacheKey,
+      expiryTime,
+      request.url(),
+      request.method(),
+      request.headers(),
+      pResponse->statusCode(),
+      pResponse->headers(),
+      pResponse->data());
+}
+
 bool isCacheStale(const CacheItem& cacheItem) noexcept {
   const std::time_t currentTime = std::time(nullptr);
   return std::difftime(cacheItem.expiryTime, currentTime) < 0.0;
@@ -362,9 +602,128 @@ bool shouldCacheRequest(
   return false;
 }
 
-std::string calculateCacheKey(const IAssetRequest& request) {
-  // TODO: more complete cache key
-  return request.url();
+bool shouldNegativelyCacheRequest(
+    const IAssetRequest& request,
+    const std::optional<ResponseCacheControl>& cacheControl,
+    int32_t negativeCacheDuration) {
+  if (negativeCacheDuration <= 0 || request.method() != "GET") {
+    return false;
+  }
+
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return false;
+  }
+
+  const uint16_t statusCode = pResponse->statusCode();
+  if (statusCode != 404 && // status Not Found
+      statusCode != 204)   // status No-Content
+  {
+    return false;
+  }
+
+  // The server can still forbid storing the response at all.
+  return !cacheControl || !cacheControl->noStore();
+}
+
+// Gets the host of a URL, without user information or port, or an empty
+// string if it has none.
+static std::string_view getHost(std::string_view url) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string_view::npos) {
+    return std::string_view();
+  }
+
+  std::string_view authority = url.substr(schemeEnd + 3);
+  authority = authority.substr(0, authority.find_first_of("/?#"));
+
+  const size_t userInfoEnd = authority.rfind('@');
+  if (userInfoEnd != std::string_view::npos) {
+    authority = authority.substr(userInfoEnd + 1);
+  }
+
+  return authority.substr(0, authority.find(':'));
+}
+
+static bool isHostOrSubdomain(std::string_view host, std::string_view domain) {
+  const auto equalsIgnoreCase = [](std::string_view a, std::string_view b) {
+    return std::equal(
+        a.begin(),
+        a.end(),
+        b.begin(),
+        b.end(),
+        [](char x, char y) {
+          return std::tolower(static_cast<unsigned char>(x)) ==
+                 std::tolower(static_cast<unsigned char>(y));
+        });
+  };
+
+  if (host.size() == domain.size()) {
+    return equalsIgnoreCase(host, domain);
+  }
+
+  return host.size() > domain.size() &&
+         host[host.size() - domain.size() - 1] == '.' &&
+         equalsIgnoreCase(host.substr(host.size() - domain.size()), domain);
+}
+
+std::string removeQueryParameters(
+    const std::string& url,
+    const std::vector<CachingAssetAccessor::IgnoredQueryParameter>&
+        parameters) {
+  const size_t queryStart = url.find('?');
+  if (queryStart == std::string::npos) {
+    return url;
+  }
+
+  const size_t queryEnd = std::min(url.find('#', queryStart), url.size());
+  const std::string_view host = getHost(url);
+
+  // Keep the other parameters in their original order.
+  std::string key = url.substr(0, queryStart);
+  char separator = '?';
+  size_t parameterStart = queryStart + 1;
+  while (parameterStart <= queryEnd) {
+    const size_t parameterEnd =
+        std::min(url.find('&', parameterStart), queryEnd);
+    const std::string_view parameter(
+        url.data() + parameterStart,
+        parameterEnd - parameterStart);
+    const std::string_view name = parameter.substr(0, parameter.find('='));
+
+    const bool ignore = std::any_of(
+        parameters.begin(),
+        parameters.end(),
+        [name, host](const CachingAssetAccessor::IgnoredQueryParameter& p) {
+          return name == p.name &&
+                 (p.host.empty() || isHostOrSubdomain(host, p.host));
+        });
+    if (!ignore && !parameter.empty()) {
+      key += separator;
+      key += parameter;
+      separator = '&';
+    }
+
+    parameterStart = parameterEnd + 1;
+  }
+
+  key.append(url, queryEnd, std::string::npos);
+  return key;
+}
+
+std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  // Headers such as authorization can change the response, so only identical
+  // requests are coalesced.
+  std::string key = url;
+  for (const IAssetAccessor::THeader& header : headers) {
+    key += '\n';
+    key += header.first;
+    key += ": ";
+    key += header.second;
+  }
+  return key;
 }
 
 std::time_t calculateExpiryTime(
@@ -397,15 +756,13 @@ std::time_t calculateExpiryTime(
 
 std::unique_ptr<IAssetRequest>
 updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request) {
-  for (const std::pair<const std::string, std::string>& header :
-       request.headers()) {
+  for (const HttpHeaders::value_type& header : request.headers()) {
     cacheItem.cacheRequest.headers[header.first] = header.second;
   }
 
   const IAssetResponse* pResponse = request.response();
   if (pResponse) {
-    for (const std::pair<const std::string, std::string>& header :
-         pResponse->headers()) {
+    for (const HttpHeaders::value_type& header : pResponse->headers()) {
       cacheItem.cacheResponse.headers[header.first] = header.second;
     }
   }
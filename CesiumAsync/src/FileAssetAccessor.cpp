@@ -0,0 +1,310 @@
+#include "CesiumAsync/FileAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "MemoryMappedFile.h"
+#include "ZipArchive.h"
+
+#include <CesiumUtility/Uri.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace CesiumUtility;
+
+namespace CesiumAsync {
+
+namespace {
+
+class FileAssetResponse : public IAssetResponse {
+public:
+  FileAssetResponse(uint16_t statusCode) noexcept : _statusCode(statusCode) {}
+
+  FileAssetResponse(
+      std::shared_ptr<const MemoryMappedFile>&& pFile,
+      const gsl::span<const std::byte>& data) noexcept
+      : _statusCode(200), _pFile(std::move(pFile)), _data(data) {}
+
+  FileAssetResponse(std::vector<std::byte>&& data) noexcept
+      : _statusCode(200), _ownedData(std::move(data)), _data(_ownedData) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  std::shared_ptr<const MemoryMappedFile> _pFile;
+  std::vector<std::byte> _ownedData;
+  gsl::span<const std::byte> _data;
+};
+
+class FileAssetRequest : public IAssetRequest {
+public:
+  FileAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      std::unique_ptr<FileAssetResponse>&& pResponse)
+      : _method(method),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _pResponse(std::move(pResponse)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return this->_pResponse.get();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  std::unique_ptr<FileAssetResponse> _pResponse;
+};
+
+struct MappedArchive {
+  std::shared_ptr<const MemoryMappedFile> pFile;
+  std::unordered_map<std::string, ZipEntry> entries;
+};
+
+/**
+ * @brief Converts a `file://` URL to a local path, or std::nullopt if the URL
+ * does not use the file scheme.
+ */
+std::optional<std::string> getLocalPath(const std::string& url) {
+  const std::string scheme = "file:";
+  if (url.size() < scheme.size() ||
+      !std::equal(
+          scheme.begin(),
+          scheme.end(),
+          url.begin(),
+          [](char a, char b) {
+            return a == std::tolower(static_cast<unsigned char>(b));
+          })) {
+    return std::nullopt;
+  }
+
+  std::string path = percentDecode(Uri::getPath(url));
+
+  // A URL such as file:///C:/tileset.json has the path /C:/tileset.json.
+  if (path.size() >= 3 && path[0] == '/' && path[2] == ':' &&
+      std::isalpha(static_cast<unsigned char>(path[1]))) {
+    path.erase(0, 1);
+  }
+
+  return path;
+}
+
+std::unique_ptr<FileAssetResponse> readFile(const std::string& path) {
+  std::shared_ptr<const MemoryMappedFile> pFile =
+      MemoryMappedFile::open(std::filesystem::u8path(path));
+  if (!pFile) {
+    return std::make_unique<FileAssetResponse>(uint16_t(404));
+  }
+
+  const gsl::span<const std::byte> data = pFile->data();
+  return std::make_unique<FileAssetResponse>(std::move(pFile), data);
+}
+
+std::unique_ptr<FileAssetResponse>
+readArchiveEntry(const MappedArchive& archive, const std::string& entryName) {
+  auto it = archive.entries.find(entryName);
+  if (it == archive.entries.end()) {
+    return std::make_unique<FileAssetResponse>(uint16_t(404));
+  }
+
+  const ZipEntry& entry = it->second;
+  std::optional<gsl::span<const std::byte>> maybeData =
+      getZipEntryData(archive.pFile->data(), 0, entry);
+  if (!maybeData) {
+    return std::make_unique<FileAssetResponse>(uint16_t(500));
+  }
+
+  if (isZipEntryStored(entry)) {
+    std::shared_ptr<const MemoryMappedFile> pFile = archive.pFile;
+    return std::make_unique<FileAssetResponse>(std::move(pFile), *maybeData);
+  }
+
+  std::vector<std::byte> inflated;
+  if (!inflateZipEntry(*maybeData, entry, inflated)) {
+    return std::make_unique<FileAssetResponse>(uint16_t(500));
+  }
+
+  return std::make_unique<FileAssetResponse>(std::move(inflated));
+}
+
+} // namespace
+
+struct FileAssetAccessor::ArchiveCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<const MappedArchive>>
+      archives;
+
+  /**
+   * @brief Gets the mapped archive at the given path, mapping it and reading
+   * its central directory on first use.
+   *
+   * @return The archive, or nullptr if it could not be mapped or read.
+   */
+  std::shared_ptr<const MappedArchive> get(const std::string& path) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto it = this->archives.find(path);
+      if (it != this->archives.end()) {
+        return it->second;
+      }
+    }
+
+    std::shared_ptr<const MemoryMappedFile> pFile =
+        MemoryMappedFile::open(std::filesystem::u8path(path));
+    if (!pFile) {
+      return nullptr;
+    }
+
+    std::optional<std::unordered_map<std::string, ZipEntry>> maybeEntries =
+        readZipCentralDirectory(pFile->data());
+    if (!maybeEntries) {
+      return nullptr;
+    }
+
+    auto pArchive = std::make_shared<const MappedArchive>(
+        MappedArchive{std::move(pFile), std::move(*maybeEntries)});
+
+    // Another thread may have opened the same archive in the meantime; keep
+    // whichever was stored first so that all requests share one mapping.
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->archives.emplace(path, std::move(pArchive)).first->second;
+  }
+
+  /**
+   * @brief Splits a path into the path of an archive and the name of an entry
+   * within it, if the path points into a `.3tz` file.
+   */
+  static std::optional<std::pair<std::string, std::string>>
+  splitArchivePath(const std::string& path) {
+    const std::string extension = ".3tz/";
+    std::string lowerPath = path;
+    std::transform(
+        lowerPath.begin(),
+        lowerPath.end(),
+        lowerPath.begin(),
+        [](unsigned char c) { return char(std::tolower(c)); });
+
+    size_t searchStart = 0;
+    while (true) {
+      const size_t position = lowerPath.find(extension, searchStart);
+      if (position == std::string::npos) {
+        return std::nullopt;
+      }
+
+      // A directory may also have a name ending in .3tz, such as an extracted
+      // archive, so only split at regular files.
+      const size_t archiveEnd = position + extension.size() - 1;
+      std::string archivePath = path.substr(0, archiveEnd);
+      std::error_code ec;
+      if (std::filesystem::is_regular_file(
+              std::filesystem::u8path(archivePath),
+              ec)) {
+        return std::make_pair(
+            std::move(archivePath),
+            path.substr(archiveEnd + 1));
+      }
+
+      searchStart = archiveEnd;
+    }
+  }
+};
+
+FileAssetAccessor::FileAssetAccessor()
+    : _pArchives(std::make_shared<ArchiveCache>()) {}
+
+FileAssetAccessor::~FileAssetAccessor() noexcept = default;
+
+Future<std::shared_ptr<IAssetRequest>> FileAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return asyncSystem.runInIOThread(
+      [pArchives = this->_pArchives,
+       url,
+       headers]() -> std::shared_ptr<IAssetRequest> {
+        std::optional<std::string> maybePath = getLocalPath(url);
+        if (!maybePath) {
+          throw std::runtime_error(
+              "FileAssetAccessor only supports file:// URLs, but was given " +
+              url);
+        }
+
+        std::unique_ptr<FileAssetResponse> pResponse;
+
+        std::optional<std::pair<std::string, std::string>> maybeArchivePath =
+            ArchiveCache::splitArchivePath(*maybePath);
+        if (maybeArchivePath) {
+          std::shared_ptr<const MappedArchive> pArchive =
+              pArchives->get(maybeArchivePath->first);
+          pResponse = pArchive ? readArchiveEntry(
+                                     *pArchive,
+                                     maybeArchivePath->second)
+                               : std::make_unique<FileAssetResponse>(
+                                     uint16_t(500));
+        } else {
+          pResponse = readFile(*maybePath);
+        }
+
+        return std::make_shared<FileAssetRequest>(
+            "GET",
+            url,
+            headers,
+            std::move(pResponse));
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>> FileAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& /* contentPayload */) {
+  if (verb == "GET") {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+      std::make_shared<FileAssetRequest>(
+          verb,
+          url,
+          headers,
+          std::make_unique<FileAssetResponse>(uint16_t(405))));
+}
+
+void FileAssetAccessor::tick() noexcept {}
+
+} // namespace CesiumAsync
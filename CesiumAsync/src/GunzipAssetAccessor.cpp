@@ -8,13 +8,44 @@ namespace CesiumAsync {
 
 namespace {
 
+// How the body of a response is encoded. Brotli and Zstandard aren't
+// supported, so those bodies are passed through unchanged.
+enum class ContentEncoding { Identity, Gzip, Deflate };
+
+// Gzip is recognized by its magic bytes, because many servers send gzipped
+// files without a `Content-Encoding`. A `deflate` body is only decoded if the
+// header says so, and is passed through if it turns out to be decoded
+// already.
+ContentEncoding getContentEncoding(const IAssetResponse& response) {
+  if (CesiumUtility::isGzip(response.data())) {
+    return ContentEncoding::Gzip;
+  }
+
+  const HttpHeaders& headers = response.headers();
+  auto it = headers.find("Content-Encoding");
+  const CaseInsensitiveCompare compare;
+  if (it != headers.end() && !compare(it->second, "deflate") &&
+      !compare("deflate", it->second)) {
+    return ContentEncoding::Deflate;
+  }
+
+  return ContentEncoding::Identity;
+}
+
 class GunzippedAssetResponse : public IAssetResponse {
 public:
-  GunzippedAssetResponse(const IAssetResponse* pOther) noexcept
+  GunzippedAssetResponse(
+      const IAssetResponse* pOther,
+      ContentEncoding encoding) noexcept
       : _pAssetResponse{pOther} {
-    this->_dataValid = CesiumUtility::gunzip(
-        this->_pAssetResponse->data(),
-        this->_gunzippedData);
+    this->_dataValid =
+        encoding == ContentEncoding::Gzip
+            ? CesiumUtility::gunzip(
+                  this->_pAssetResponse->data(),
+                  this->_gunzippedData)
+            : CesiumUtility::inflateZlib(
+                  this->_pAssetResponse->data(),
+                  this->_gunzippedData);
   }
 
   virtual uint16_t statusCode() const noexcept override {
@@ -42,9 +73,11 @@ private:
 
 class GunzippedAssetRequest : public IAssetRequest {
 public:
-  GunzippedAssetRequest(std::shared_ptr<IAssetRequest>&& pOther)
+  GunzippedAssetRequest(
+      std::shared_ptr<IAssetRequest>&& pOther,
+      ContentEncoding encoding)
       : _pAssetRequest(std::move(pOther)),
-        _AssetResponse(_pAssetRequest->response()){};
+        _AssetResponse(_pAssetRequest->response(), encoding){};
   virtual const std::string& method() const noexcept override {
     return this->_pAssetRequest->method();
   }
@@ -66,16 +99,21 @@ private:
   GunzippedAssetResponse _AssetResponse;
 };
 
+// Responses are decoded in a worker thread, whichever thread they completed
+// in, so that large bodies don't stall the main thread.
 Future<std::shared_ptr<IAssetRequest>> gunzipIfNeeded(
     const AsyncSystem& asyncSystem,
     std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
   const IAssetResponse* pResponse = pCompletedRequest->response();
-  if (pResponse && CesiumUtility::isGzip(pResponse->data())) {
+  const ContentEncoding encoding =
+      pResponse ? getContentEncoding(*pResponse) : ContentEncoding::Identity;
+  if (encoding != ContentEncoding::Identity) {
     return asyncSystem.runInWorkerThread(
-        [pCompletedRequest = std::move(
-             pCompletedRequest)]() mutable -> std::shared_ptr<IAssetRequest> {
+        [pCompletedRequest = std::move(pCompletedRequest),
+         encoding]() mutable -> std::shared_ptr<IAssetRequest> {
           return std::make_shared<GunzippedAssetRequest>(
-              std::move(pCompletedRequest));
+              std::move(pCompletedRequest),
+              encoding);
         });
   }
   return asyncSystem.createResolvedFuture(std::move(pCompletedRequest));
@@ -100,6 +138,51 @@ Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::get(
           });
 }
 
+Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::getWithCancellation(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const CancellationToken& cancellationToken) {
+  return this->_pAssetAccessor
+      ->getWithCancellation(asyncSystem, url, headers, cancellationToken)
+      .thenImmediately(
+          [asyncSystem](std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+            return gunzipIfNeeded(asyncSystem, std::move(pCompletedRequest));
+          });
+}
+
+Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::getWithOptions(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const AssetRequestOptions& options) {
+  return this->_pAssetAccessor
+      ->getWithOptions(asyncSystem, url, headers, options)
+      .thenImmediately(
+          [asyncSystem](std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+            return gunzipIfNeeded(asyncSystem, std::move(pCompletedRequest));
+          });
+}
+
+std::vector<Future<std::shared_ptr<IAssetRequest>>>
+GunzipAssetAccessor::getBatch(
+    const AsyncSystem& asyncSystem,
+    const std::vector<std::string>& urls,
+    const std::vector<THeader>& headers) {
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> requests =
+      this->_pAssetAccessor->getBatch(asyncSystem, urls, headers);
+
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> result;
+  result.reserve(requests.size());
+  for (Future<std::shared_ptr<IAssetRequest>>& request : requests) {
+    result.emplace_back(std::move(request).thenImmediately(
+        [asyncSystem](std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+          return gunzipIfNeeded(asyncSystem, std::move(pCompletedRequest));
+        }));
+  }
+  return result;
+}
+
 Future<std::shared_ptr<IAssetRequest>> GunzipAssetAccessor::request(
     const AsyncSystem& asyncSystem,
     const std::string& verb,
@@ -1,6 +1,8 @@
 #include "CesiumAsync/HttpHeaders.h"
 
 #include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
 namespace CesiumAsync {
 struct NocaseCompare {
@@ -19,4 +21,84 @@ bool CaseInsensitiveCompare::operator()(
       s2.end(),
       NocaseCompare());
 }
+
+HttpHeaders::iterator HttpHeaders::find(std::string_view name) noexcept {
+  const iterator it = this->lowerBound(name);
+  if (it != this->end() && equalsIgnoringCase(it->first, name)) {
+    return it;
+  }
+  return this->end();
+}
+
+HttpHeaders::const_iterator
+HttpHeaders::find(std::string_view name) const noexcept {
+  return const_cast<HttpHeaders*>(this)->find(name);
+}
+
+std::string& HttpHeaders::at(std::string_view name) {
+  const iterator it = this->find(name);
+  if (it == this->end()) {
+    throw std::out_of_range("The header does not exist.");
+  }
+  return it->second;
+}
+
+const std::string& HttpHeaders::at(std::string_view name) const {
+  return const_cast<HttpHeaders*>(this)->at(name);
+}
+
+size_t HttpHeaders::erase(std::string_view name) {
+  const iterator it = this->find(name);
+  if (it == this->end()) {
+    return 0;
+  }
+  this->_headers.erase(it);
+  return 1;
+}
+
+/*static*/ int
+HttpHeaders::compareIgnoringCase(std::string_view lhs, std::string_view rhs) {
+  const size_t length = std::min(lhs.size(), rhs.size());
+  for (size_t i = 0; i < length; ++i) {
+    const int c1 = tolower(static_cast<unsigned char>(lhs[i]));
+    const int c2 = tolower(static_cast<unsigned char>(rhs[i]));
+    if (c1 != c2) {
+      return c1 < c2 ? -1 : 1;
+    }
+  }
+
+  if (lhs.size() == rhs.size()) {
+    return 0;
+  }
+  return lhs.size() < rhs.size() ? -1 : 1;
+}
+
+HttpHeaders::iterator HttpHeaders::lowerBound(std::string_view name) noexcept {
+  return std::lower_bound(
+      this->_headers.begin(),
+      this->_headers.end(),
+      name,
+      [](const value_type& header, std::string_view value) {
+        return compareIgnoringCase(header.first, value) < 0;
+      });
+}
+
+void HttpHeaders::sortAndRemoveDuplicates() {
+  // A stable sort keeps the first of the headers with the same name first, so
+  // that it is the one kept, as when inserting them into a std::map in order.
+  std::stable_sort(
+      this->_headers.begin(),
+      this->_headers.end(),
+      [](const value_type& lhs, const value_type& rhs) {
+        return compareIgnoringCase(lhs.first, rhs.first) < 0;
+      });
+  this->_headers.erase(
+      std::unique(
+          this->_headers.begin(),
+          this->_headers.end(),
+          [](const value_type& lhs, const value_type& rhs) {
+            return equalsIgnoringCase(lhs.first, rhs.first);
+          }),
+      this->_headers.end());
+}
 } // namespace CesiumAsync
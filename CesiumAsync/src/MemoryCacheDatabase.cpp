@@ -0,0 +1,178 @@
+#include "CesiumAsync/MemoryCacheDatabase.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <ctime>
+#include <iterator>
+#include <vector>
+
+namespace CesiumAsync {
+
+namespace {
+
+int64_t computeHeadersByteSize(const HttpHeaders& headers) {
+  int64_t result = 0;
+  for (const auto& [name, value] : headers) {
+    result += int64_t(name.size() + value.size());
+  }
+  return result;
+}
+
+int64_t computeByteSize(const std::string& key, const CacheItem& item) {
+  return int64_t(key.size()) + int64_t(item.cacheRequest.url.size()) +
+         int64_t(item.cacheRequest.method.size()) +
+         computeHeadersByteSize(item.cacheRequest.headers) +
+         computeHeadersByteSize(item.cacheResponse.headers) +
+         int64_t(item.cacheResponse.data.size());
+}
+
+} // namespace
+
+MemoryCacheDatabase::MemoryCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pUnderlyingDatabase,
+    int64_t maximumBytes)
+    : _pUnderlyingDatabase(pUnderlyingDatabase),
+      _maximumBytes(maximumBytes),
+      _mutex(),
+      _entries(),
+      _entriesByKey(),
+      _totalBytes(0) {}
+
+std::optional<CacheItem>
+MemoryCacheDatabase::getEntry(const std::string& key) const {
+  CESIUM_TRACE_CATEGORY(Cache, "MemoryCacheDatabase::getEntry");
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it != this->_entriesByKey.end()) {
+      // Move the entry to the front to mark it as most recently used.
+      this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+      return it->second->second;
+    }
+  }
+
+  if (!this->_pUnderlyingDatabase) {
+    return std::nullopt;
+  }
+
+  std::optional<CacheItem> maybeItem =
+      this->_pUnderlyingDatabase->getEntry(key);
+  if (maybeItem) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->insert(key, CacheItem(*maybeItem));
+  }
+
+  return maybeItem;
+}
+
+bool MemoryCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE_CATEGORY(Cache, "MemoryCacheDatabase::storeEntry");
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->insert(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+  }
+
+  if (!this->_pUnderlyingDatabase) {
+    return true;
+  }
+
+  return this->_pUnderlyingDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+bool MemoryCacheDatabase::prune() {
+  CESIUM_TRACE_CATEGORY(Cache, "MemoryCacheDatabase::prune");
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    const std::time_t now = std::time(nullptr);
+    for (auto it = this->_entries.begin(); it != this->_entries.end();) {
+      auto next = std::next(it);
+      if (it->second.expiryTime < now) {
+        this->remove(it);
+      }
+      it = next;
+    }
+  }
+
+  return this->_pUnderlyingDatabase ? this->_pUnderlyingDatabase->prune()
+                                    : true;
+}
+
+bool MemoryCacheDatabase::clearAll() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+    this->_entriesByKey.clear();
+    this->_totalBytes = 0;
+  }
+
+  return this->_pUnderlyingDatabase ? this->_pUnderlyingDatabase->clearAll()
+                                    : true;
+}
+
+int64_t MemoryCacheDatabase::getTotalBytes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_totalBytes;
+}
+
+void MemoryCacheDatabase::insert(const std::string& key, CacheItem&& item)
+    const {
+  auto existingIt = this->_entriesByKey.find(key);
+  if (existingIt != this->_entriesByKey.end()) {
+    this->remove(existingIt->second);
+  }
+
+  const int64_t byteSize = computeByteSize(key, item);
+  if (byteSize > this->_maximumBytes) {
+    return;
+  }
+
+  // Evict the least recently used entries until the new one fits.
+  while (!this->_entries.empty() &&
+         this->_totalBytes + byteSize > this->_maximumBytes) {
+    this->remove(std::prev(this->_entries.end()));
+  }
+
+  this->_entries.emplace_front(key, std::move(item));
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+  this->_totalBytes += byteSize;
+}
+
+void MemoryCacheDatabase::remove(EntryList::iterator it) const {
+  this->_totalBytes -= computeByteSize(it->first, it->second);
+  this->_entriesByKey.erase(it->first);
+  this->_entries.erase(it);
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,121 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CesiumAsync {
+
+#ifdef _WIN32
+
+std::shared_ptr<MemoryMappedFile>
+MemoryMappedFile::open(const std::filesystem::path& path) {
+  HANDLE file = CreateFileW(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  std::shared_ptr<MemoryMappedFile> pResult(new MemoryMappedFile());
+  if (size.QuadPart == 0) {
+    // Empty files cannot be mapped, but they are valid files.
+    CloseHandle(file);
+    return pResult;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  // The mapping keeps the file open, so the file handle is no longer needed.
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+
+  const void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (pView == nullptr) {
+    CloseHandle(mapping);
+    return nullptr;
+  }
+
+  pResult->_pData = static_cast<const std::byte*>(pView);
+  pResult->_size = static_cast<size_t>(size.QuadPart);
+  pResult->_mappingHandle = mapping;
+  return pResult;
+}
+
+MemoryMappedFile::~MemoryMappedFile() noexcept {
+  if (this->_pData) {
+    UnmapViewOfFile(this->_pData);
+  }
+  if (this->_mappingHandle) {
+    CloseHandle(this->_mappingHandle);
+  }
+}
+
+#else
+
+std::shared_ptr<MemoryMappedFile>
+MemoryMappedFile::open(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+    ::close(fd);
+    return nullptr;
+  }
+
+  std::shared_ptr<MemoryMappedFile> pResult(new MemoryMappedFile());
+  const size_t size = static_cast<size_t>(fileStat.st_size);
+  if (size == 0) {
+    // Empty files cannot be mapped, but they are valid files.
+    ::close(fd);
+    return pResult;
+  }
+
+  void* pMapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  if (pMapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  pResult->_pData = static_cast<const std::byte*>(pMapping);
+  pResult->_size = size;
+  return pResult;
+}
+
+MemoryMappedFile::~MemoryMappedFile() noexcept {
+  if (this->_pData) {
+    munmap(const_cast<std::byte*>(this->_pData), this->_size);
+  }
+}
+
+#endif
+
+} // namespace CesiumAsync
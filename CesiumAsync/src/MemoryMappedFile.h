@@ -0,0 +1,51 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A read-only view of an entire file mapped into memory.
+ *
+ * The mapping stays valid for as long as the instance is alive, so responses
+ * that expose parts of the file hold a shared pointer to it.
+ */
+class MemoryMappedFile {
+public:
+  /**
+   * @brief Maps the file at the given path.
+   *
+   * @param path The path of the file to map.
+   * @return The mapped file, or nullptr if the file could not be opened or
+   * mapped.
+   */
+  static std::shared_ptr<MemoryMappedFile>
+  open(const std::filesystem::path& path);
+
+  ~MemoryMappedFile() noexcept;
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  /**
+   * @brief Gets the mapped contents of the file.
+   */
+  gsl::span<const std::byte> data() const noexcept {
+    return gsl::span<const std::byte>(this->_pData, this->_size);
+  }
+
+private:
+  MemoryMappedFile() noexcept = default;
+
+  const std::byte* _pData = nullptr;
+  size_t _size = 0;
+#ifdef _WIN32
+  void* _mappingHandle = nullptr;
+#endif
+};
+
+} // namespace CesiumAsync
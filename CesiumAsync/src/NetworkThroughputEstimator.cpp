@@ -0,0 +1,129 @@
+#include "CesiumAsync/NetworkThroughputEstimator.h"
+
+#include <algorithm>
+
+namespace CesiumAsync {
+
+namespace {
+
+// While requests are in progress, the throughput is only measured once they
+// have been in progress for at least this long, so that requests that finish
+// at nearly the same time don't each produce a wildly different measurement.
+constexpr double minimumMeasurementSeconds = 0.05;
+
+double secondsBetween(
+    NetworkThroughputEstimator::Clock::time_point start,
+    NetworkThroughputEstimator::Clock::time_point end) noexcept {
+  return std::max(std::chrono::duration<double>(end - start).count(), 0.0);
+}
+
+double smooth(
+    double estimate,
+    double measurement,
+    double smoothing,
+    bool hasEstimate) noexcept {
+  return hasEstimate ? estimate + (measurement - estimate) * smoothing
+                     : measurement;
+}
+
+} // namespace
+
+NetworkThroughputEstimator::NetworkThroughputEstimator(
+    double smoothing) noexcept
+    : _smoothing(std::clamp(smoothing, 0.0, 1.0)),
+      _mutex(),
+      _requestsInProgress(0),
+      _finishedRequestCount(0),
+      _busySince(),
+      _busySeconds(0.0),
+      _busyBytes(0),
+      _bytesPerSecond(0.0),
+      _latency(0.0),
+      _averageResponseBytes(0.0) {}
+
+void NetworkThroughputEstimator::notifyRequestStarted(
+    Clock::time_point time) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_requestsInProgress == 0) {
+    this->_busySince = time;
+  }
+  ++this->_requestsInProgress;
+}
+
+void NetworkThroughputEstimator::notifyRequestFinished(
+    Clock::time_point startTime,
+    Clock::time_point endTime,
+    size_t byteCount) noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  if (this->_requestsInProgress > 0) {
+    --this->_requestsInProgress;
+  }
+
+  this->_averageResponseBytes = smooth(
+      this->_averageResponseBytes,
+      double(byteCount),
+      this->_smoothing,
+      this->_finishedRequestCount > 0);
+  this->_latency = smooth(
+      this->_latency,
+      secondsBetween(startTime, endTime),
+      this->_smoothing,
+      this->_finishedRequestCount > 0);
+  ++this->_finishedRequestCount;
+
+  // The bytes of requests that are still in progress are not known yet, so
+  // only measure once time has passed since the last request that finished,
+  // so that all of the requests that finished together are included, or once
+  // there are no more requests in progress.
+  const double elapsedSeconds = secondsBetween(this->_busySince, endTime);
+  if (elapsedSeconds > 0.0 &&
+      this->_busySeconds >= minimumMeasurementSeconds) {
+    this->measureThroughput();
+  }
+
+  this->_busySeconds += elapsedSeconds;
+  this->_busySince = endTime;
+  this->_busyBytes += byteCount;
+
+  if (this->_requestsInProgress == 0 && this->_busySeconds > 0.0) {
+    this->measureThroughput();
+  }
+}
+
+void NetworkThroughputEstimator::measureThroughput() noexcept {
+  this->_bytesPerSecond = smooth(
+      this->_bytesPerSecond,
+      double(this->_busyBytes) / this->_busySeconds,
+      this->_smoothing,
+      this->_bytesPerSecond > 0.0);
+  this->_busySeconds = 0.0;
+  this->_busyBytes = 0;
+}
+
+double NetworkThroughputEstimator::getBytesPerSecond() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_bytesPerSecond;
+}
+
+double NetworkThroughputEstimator::getLatency() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_latency;
+}
+
+double NetworkThroughputEstimator::getAverageResponseBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_averageResponseBytes;
+}
+
+uint64_t NetworkThroughputEstimator::getFinishedRequestCount() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_finishedRequestCount;
+}
+
+uint32_t NetworkThroughputEstimator::getRequestsInProgress() const noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_requestsInProgress;
+}
+
+} // namespace CesiumAsync
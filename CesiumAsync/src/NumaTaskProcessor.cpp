@@ -0,0 +1,279 @@
+#include "CesiumAsync/NumaTaskProcessor.h"
+
+#include "CesiumAsync/TaskAffinity.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace CesiumAsync {
+
+namespace {
+
+constexpr size_t PRIORITY_COUNT = 3;
+
+size_t laneIndex(TaskPriority priority) noexcept {
+  return std::min(static_cast<size_t>(priority), PRIORITY_COUNT - 1);
+}
+
+struct QueuedTask {
+  std::function<void()> f;
+  uint64_t affinity = 0;
+};
+
+struct NodeQueue {
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::array<std::deque<QueuedTask>, PRIORITY_COUNT> lanes;
+  bool stopping = false;
+};
+
+// The processor and node of the thread that is running on the current thread,
+// if any.
+struct CurrentWorker {
+  const void* pOwner = nullptr;
+  size_t node = 0;
+};
+
+CurrentWorker& currentWorker() noexcept {
+  static thread_local CurrentWorker worker;
+  return worker;
+}
+
+// Affinity keys are often addresses, whose low bits are all zero, so mix the
+// bits before choosing a node. This is the SplitMix64 finalizer.
+uint64_t mixKey(uint64_t key) noexcept {
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+// Parses a Linux CPU list such as "0-15,32-47".
+std::vector<uint32_t> parseCpuList(const std::string& list) {
+  std::vector<uint32_t> cpus;
+  std::istringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    const size_t dash = range.find('-');
+    try {
+      const unsigned long first = std::stoul(range.substr(0, dash));
+      const unsigned long last = dash == std::string::npos
+                                     ? first
+                                     : std::stoul(range.substr(dash + 1));
+      for (unsigned long cpu = first; cpu <= last; ++cpu) {
+        cpus.emplace_back(static_cast<uint32_t>(cpu));
+      }
+    } catch (const std::exception&) {
+      // Ignore anything we can't parse, such as the trailing newline.
+    }
+  }
+  return cpus;
+}
+
+std::vector<NumaTaskProcessor::Node> allHardwareThreads() {
+  NumaTaskProcessor::Node node;
+  const uint32_t count = std::max(1U, std::thread::hardware_concurrency());
+  node.cpus.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    node.cpus.emplace_back(i);
+  }
+  return {std::move(node)};
+}
+
+void pinCurrentThread([[maybe_unused]] uint32_t cpu) noexcept {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  // Failing to pin only costs locality, so the result is ignored.
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+} // namespace
+
+struct NumaTaskProcessor::Impl {
+  Impl(std::vector<NumaTaskProcessor::Node>&& nodes, bool pinThreads)
+      : queues() {
+    for (NumaTaskProcessor::Node& node : nodes) {
+      if (!node.cpus.empty()) {
+        this->queues.emplace_back(std::make_unique<NodeQueue>());
+      }
+    }
+
+    size_t nodeIndex = 0;
+    for (const NumaTaskProcessor::Node& node : nodes) {
+      if (node.cpus.empty()) {
+        continue;
+      }
+
+      for (uint32_t cpu : node.cpus) {
+        this->threads.emplace_back([this, nodeIndex, cpu, pinThreads]() {
+          if (pinThreads) {
+            pinCurrentThread(cpu);
+          }
+          this->run(nodeIndex);
+        });
+      }
+      ++nodeIndex;
+    }
+  }
+
+  ~Impl() noexcept {
+    for (std::unique_ptr<NodeQueue>& pQueue : this->queues) {
+      {
+        std::lock_guard<std::mutex> lock(pQueue->mutex);
+        pQueue->stopping = true;
+      }
+      pQueue->wake.notify_all();
+    }
+
+    for (std::thread& thread : this->threads) {
+      thread.join();
+    }
+  }
+
+  size_t chooseNode() noexcept {
+    const uint64_t key = getCurrentTaskAffinity();
+    if (key != 0) {
+      return static_cast<size_t>(mixKey(key) % this->queues.size());
+    }
+
+    const CurrentWorker& worker = currentWorker();
+    if (worker.pOwner == this) {
+      return worker.node;
+    }
+
+    return this->nextNode++ % this->queues.size();
+  }
+
+  void push(std::function<void()>&& f, TaskPriority priority) {
+    NodeQueue& queue = *this->queues[this->chooseNode()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.lanes[laneIndex(priority)].push_back(
+          QueuedTask{std::move(f), getCurrentTaskAffinity()});
+    }
+    queue.wake.notify_one();
+  }
+
+  void run(size_t nodeIndex) {
+    CurrentWorker& worker = currentWorker();
+    worker.pOwner = this;
+    worker.node = nodeIndex;
+
+    NodeQueue& queue = *this->queues[nodeIndex];
+    while (true) {
+      QueuedTask task;
+      size_t lane = PRIORITY_COUNT;
+
+      {
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        queue.wake.wait(lock, [&queue]() {
+          return queue.stopping ||
+                 std::any_of(
+                     queue.lanes.begin(),
+                     queue.lanes.end(),
+                     [](const std::deque<QueuedTask>& tasks) {
+                       return !tasks.empty();
+                     });
+        });
+
+        while (lane > 0 && queue.lanes[lane - 1].empty()) {
+          --lane;
+        }
+        if (lane == 0) {
+          // Stopping, and nothing is left to run.
+          return;
+        }
+
+        --lane;
+        task = std::move(queue.lanes[lane].front());
+        queue.lanes[lane].pop_front();
+      }
+
+      ScopedTaskPriority priorityScope(static_cast<TaskPriority>(lane));
+      ScopedTaskAffinity affinityScope(task.affinity);
+      task.f();
+    }
+  }
+
+  std::vector<std::unique_ptr<NodeQueue>> queues;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> nextNode{0};
+};
+
+std::vector<NumaTaskProcessor::Node> NumaTaskProcessor::detectNodes() {
+  std::vector<Node> nodes;
+
+#ifdef __linux__
+  for (size_t i = 0;; ++i) {
+    std::ifstream file(
+        "/sys/devices/system/node/node" + std::to_string(i) + "/cpulist");
+    if (!file) {
+      break;
+    }
+
+    std::string list;
+    std::getline(file, list);
+    nodes.emplace_back(Node{parseCpuList(list)});
+  }
+#endif
+
+  const bool anyCpus =
+      std::any_of(nodes.begin(), nodes.end(), [](const Node& node) {
+        return !node.cpus.empty();
+      });
+  return anyCpus ? nodes : allHardwareThreads();
+}
+
+NumaTaskProcessor::NumaTaskProcessor(std::vector<Node> nodes, bool pinThreads)
+    : _pImpl() {
+  const bool anyCpus =
+      std::any_of(nodes.begin(), nodes.end(), [](const Node& node) {
+        return !node.cpus.empty();
+      });
+  if (!anyCpus) {
+    nodes = allHardwareThreads();
+  }
+  this->_pImpl = std::make_unique<Impl>(std::move(nodes), pinThreads);
+}
+
+NumaTaskProcessor::~NumaTaskProcessor() noexcept = default;
+
+void NumaTaskProcessor::startTask(std::function<void()> f) {
+  this->_pImpl->push(std::move(f), TaskPriority::Normal);
+}
+
+void NumaTaskProcessor::startTaskWithPriority(
+    std::function<void()> f,
+    TaskPriority priority) {
+  this->_pImpl->push(std::move(f), priority);
+}
+
+size_t NumaTaskProcessor::getNumberOfNodes() const noexcept {
+  return this->_pImpl->queues.size();
+}
+
+uint32_t NumaTaskProcessor::getNumberOfThreads() const noexcept {
+  return static_cast<uint32_t>(this->_pImpl->threads.size());
+}
+
+} // namespace CesiumAsync
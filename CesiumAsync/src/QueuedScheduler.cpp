@@ -1,5 +1,8 @@
 #include "CesiumAsync/Impl/QueuedScheduler.h"
 
+#include "CesiumAsync/TaskPriority.h"
+
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -13,7 +16,9 @@
 namespace CesiumAsync::CesiumImpl {
 
 struct QueuedScheduler::Impl {
-  async::detail::fifo_queue queue;
+  // One queue per TaskPriority, indexed by its value.
+  async::detail::fifo_queue queues[3];
+  size_t numberOfQueued = 0;
   std::mutex mutex;
   std::condition_variable conditionVariable;
 };
@@ -23,7 +28,11 @@ QueuedScheduler::~QueuedScheduler() = default;
 
 void QueuedScheduler::schedule(async::task_run_handle t) {
   std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
-  this->_pImpl->queue.push(std::move(t));
+  // Continuations keep the priority of the work that scheduled them, so main
+  // thread work for urgent tiles is dispatched before work for preloads.
+  const size_t lane = static_cast<size_t>(getCurrentTaskPriority());
+  this->_pImpl->queues[lane].push(std::move(t));
+  ++this->_pImpl->numberOfQueued;
 
   // Notify listeners that there is new work.
   this->_pImpl->conditionVariable.notify_all();
@@ -34,16 +43,39 @@ void QueuedScheduler::dispatchQueuedContinuations() {
   }
 }
 
+bool QueuedScheduler::dispatchQueuedContinuations(
+    double maximumTimeInMilliseconds) {
+  // Always dispatch at least one continuation so that work makes progress
+  // even with a tiny budget.
+  const auto start = std::chrono::steady_clock::now();
+  while (this->dispatchZeroOrOneContinuation()) {
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() >= maximumTimeInMilliseconds) {
+      return !this->hasQueuedContinuations();
+    }
+  }
+  return true;
+}
+
 bool QueuedScheduler::dispatchZeroOrOneContinuation() {
   return this->dispatchInternal(false);
 }
 
 bool QueuedScheduler::dispatchInternal(bool blockIfNoTasks) {
   async::task_run_handle t;
+  size_t lane = 3;
 
   {
     std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
-    t = this->_pImpl->queue.pop();
+    // Dispatch continuations in priority order, highest first.
+    while (!t && lane > 0) {
+      --lane;
+      t = this->_pImpl->queues[lane].pop();
+    }
+    if (t) {
+      --this->_pImpl->numberOfQueued;
+    }
     if (blockIfNoTasks && !t) {
       this->_pImpl->conditionVariable.wait(guard);
     }
@@ -51,6 +83,7 @@ bool QueuedScheduler::dispatchInternal(bool blockIfNoTasks) {
 
   if (t) {
     auto scope = this->immediate.scope();
+    ScopedTaskPriority priorityScope(static_cast<TaskPriority>(lane));
     t.run();
     return true;
   } else {
@@ -58,6 +91,11 @@ bool QueuedScheduler::dispatchInternal(bool blockIfNoTasks) {
   }
 }
 
+bool QueuedScheduler::hasQueuedContinuations() {
+  std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
+  return this->_pImpl->numberOfQueued > 0;
+}
+
 void QueuedScheduler::unblock() {
   std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
   this->_pImpl->conditionVariable.notify_all();
@@ -0,0 +1,102 @@
+#include "CesiumAsync/RecordingAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+
+namespace CesiumAsync {
+
+RecordingAssetAccessor::RecordingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor),
+      _pRecording(std::make_shared<Recording>()) {}
+
+RecordingAssetAccessor::~RecordingAssetAccessor() noexcept {}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->record(this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+RecordingAssetAccessor::getWithCancellation(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const CancellationToken& cancellationToken) {
+  return this->record(this->_pAssetAccessor->getWithCancellation(
+      asyncSystem,
+      url,
+      headers,
+      cancellationToken));
+}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::getWithOptions(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const AssetRequestOptions& options) {
+  return this->record(
+      this->_pAssetAccessor
+          ->getWithOptions(asyncSystem, url, headers, options));
+}
+
+std::vector<Future<std::shared_ptr<IAssetRequest>>>
+RecordingAssetAccessor::getBatch(
+    const AsyncSystem& asyncSystem,
+    const std::vector<std::string>& urls,
+    const std::vector<THeader>& headers) {
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> requests =
+      this->_pAssetAccessor->getBatch(asyncSystem, urls, headers);
+
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> result;
+  result.reserve(requests.size());
+  for (Future<std::shared_ptr<IAssetRequest>>& request : requests) {
+    result.emplace_back(this->record(std::move(request)));
+  }
+  return result;
+}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->record(this->_pAssetAccessor->request(
+      asyncSystem,
+      verb,
+      url,
+      headers,
+      contentPayload));
+}
+
+void RecordingAssetAccessor::tick() noexcept { this->_pAssetAccessor->tick(); }
+
+std::vector<std::shared_ptr<IAssetRequest>>
+RecordingAssetAccessor::getRecordedRequests() const {
+  std::lock_guard<std::mutex> lock(this->_pRecording->mutex);
+  return this->_pRecording->requests;
+}
+
+void RecordingAssetAccessor::clear() {
+  std::lock_guard<std::mutex> lock(this->_pRecording->mutex);
+  this->_pRecording->requests.clear();
+}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::record(
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  // The recording is shared with the continuation, so requests that complete
+  // after this accessor is destroyed are still safe to record.
+  return std::move(future).thenImmediately(
+      [pRecording = this->_pRecording](
+          std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+        if (pCompletedRequest && pCompletedRequest->response()) {
+          std::lock_guard<std::mutex> lock(pRecording->mutex);
+          pRecording->requests.emplace_back(pCompletedRequest);
+        }
+        return std::move(pCompletedRequest);
+      });
+}
+
+} // namespace CesiumAsync
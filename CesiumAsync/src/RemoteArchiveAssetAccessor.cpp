@@ -0,0 +1,853 @@
+#include "CesiumAsync/RemoteArchiveAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumAsync/SharedFuture.h"
+#include "ZipArchive.h"
+
+#include <CesiumUtility/Uri.h>
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+using namespace CesiumUtility;
+
+namespace CesiumAsync {
+
+namespace {
+
+class ArchiveEntryResponse : public IAssetResponse {
+public:
+  ArchiveEntryResponse(
+      uint16_t statusCode,
+      HttpHeaders&& headers,
+      std::vector<std::byte>&& data) noexcept
+      : _statusCode(statusCode),
+        _headers(std::move(headers)),
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class ArchiveEntryRequest : public IAssetRequest {
+public:
+  ArchiveEntryRequest(
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      std::unique_ptr<ArchiveEntryResponse>&& pResponse)
+      : _method("GET"),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _pResponse(std::move(pResponse)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return this->_pResponse.get();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  std::unique_ptr<ArchiveEntryResponse> _pResponse;
+};
+
+std::shared_ptr<IAssetRequest> createEntryRequest(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    std::unique_ptr<ArchiveEntryResponse>&& pResponse) {
+  return std::make_shared<ArchiveEntryRequest>(
+      url,
+      headers,
+      std::move(pResponse));
+}
+
+/**
+ * @brief Creates the response for an entry from the response for its range
+ * of the archive, keeping the headers that apply to the whole archive, such
+ * as the `ETag` and `Cache-Control`.
+ *
+ * @return The response, or nullptr if the request for the archive was
+ * abandoned and has no response either.
+ */
+std::unique_ptr<ArchiveEntryResponse> createEntryResponse(
+    const IAssetResponse* pArchiveResponse,
+    uint16_t statusCode,
+    std::vector<std::byte>&& data = {}) {
+  if (!pArchiveResponse) {
+    return nullptr;
+  }
+
+  HttpHeaders headers = pArchiveResponse->headers();
+  headers.erase("Content-Encoding");
+  headers.erase("Content-Length");
+  headers.erase("Content-Range");
+  headers.erase("Content-Type");
+  return std::make_unique<ArchiveEntryResponse>(
+      statusCode,
+      std::move(headers),
+      std::move(data));
+}
+
+struct ArchiveUrl {
+  std::string archiveUrl;
+  std::string entryName;
+};
+
+/**
+ * @brief Splits a URL into the URL of an archive, with the same query, and the
+ * name of an entry within it, if the path of the URL continues past a `.3tz`
+ * file.
+ */
+std::optional<ArchiveUrl> splitArchiveUrl(const std::string& url) {
+  const auto toLower = [](std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
+      return char(std::tolower(c));
+    });
+    return s;
+  };
+
+  // Local archives are mapped by FileAssetAccessor instead.
+  if (toLower(url.substr(0, 5)) == "file:") {
+    return std::nullopt;
+  }
+
+  const std::string extension = ".3tz/";
+  const std::string path = Uri::getPath(url);
+  const size_t position = toLower(path).find(extension);
+  if (position == std::string::npos ||
+      position + extension.size() == path.size()) {
+    return std::nullopt;
+  }
+
+  ArchiveUrl result;
+  result.archiveUrl =
+      Uri::setPath(url, path.substr(0, position + extension.size() - 1));
+  result.entryName = percentDecode(path.substr(position + extension.size()));
+  return result;
+}
+
+/**
+ * @brief Gets the headers of a request for a range of an archive.
+ *
+ * @param headers The headers of the request for the entry.
+ * @param range The value of the `Range` header.
+ * @param keepConditions Whether to keep the conditional headers, such as
+ * `If-None-Match`, which are only kept when the response for the range becomes
+ * the response for the entry.
+ */
+std::vector<IAssetAccessor::THeader> getRangeHeaders(
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const std::string& range,
+    bool keepConditions) {
+  const CaseInsensitiveCompare compare;
+  const auto isNamed = [&compare](const std::string& name, const char* s) {
+    return !compare(name, s) && !compare(s, name);
+  };
+
+  std::vector<IAssetAccessor::THeader> result;
+  result.reserve(headers.size() + 1);
+  for (const IAssetAccessor::THeader& header : headers) {
+    if (isNamed(header.first, "Range") ||
+        (!keepConditions && (isNamed(header.first, "If-None-Match") ||
+                             isNamed(header.first, "If-Modified-Since")))) {
+      continue;
+    }
+    result.emplace_back(header);
+  }
+  result.emplace_back("Range", range);
+  return result;
+}
+
+std::string getByteRange(uint64_t begin, uint64_t end) {
+  return "bytes=" + std::to_string(begin) + "-" + std::to_string(end - 1);
+}
+
+/**
+ * @brief Gets the offset within the archive of the first byte of a response
+ * for a range of it.
+ *
+ * A server that does not support range requests responds with the whole
+ * archive instead.
+ *
+ * @return The offset, or std::nullopt if the request failed.
+ */
+std::optional<uint64_t> getResponseOffset(const IAssetResponse& response) {
+  if (response.statusCode() == 200) {
+    return 0;
+  }
+
+  if (response.statusCode() != 206) {
+    return std::nullopt;
+  }
+
+  // The header has the form `bytes 100-199/1000`.
+  const HttpHeaders& headers = response.headers();
+  auto it = headers.find("Content-Range");
+  const std::string unit = "bytes ";
+  if (it == headers.end() || it->second.compare(0, unit.size(), unit) != 0 ||
+      it->second.size() == unit.size() ||
+      !std::isdigit(static_cast<unsigned char>(it->second[unit.size()]))) {
+    return std::nullopt;
+  }
+
+  uint64_t offset = 0;
+  for (size_t i = unit.size(); i < it->second.size() &&
+                               std::isdigit(static_cast<unsigned char>(
+                                   it->second[i]));
+       ++i) {
+    offset = offset * 10 + uint64_t(it->second[i] - '0');
+  }
+  return offset;
+}
+
+/**
+ * @brief Gets a range of an archive from the response for a range that
+ * contains it.
+ *
+ * @return The range, or std::nullopt if the request failed or the response
+ * does not contain the whole range.
+ */
+std::optional<gsl::span<const std::byte>> getArchiveRange(
+    const IAssetResponse* pResponse,
+    uint64_t offset,
+    uint64_t size) {
+  std::optional<uint64_t> maybeResponseOffset =
+      pResponse ? getResponseOffset(*pResponse) : std::nullopt;
+  if (!maybeResponseOffset || offset < *maybeResponseOffset) {
+    return std::nullopt;
+  }
+
+  const gsl::span<const std::byte> data = pResponse->data();
+  const uint64_t start = offset - *maybeResponseOffset;
+  if (start > data.size() || data.size() - start < size) {
+    return std::nullopt;
+  }
+
+  return data.subspan(static_cast<size_t>(start), static_cast<size_t>(size));
+}
+
+/**
+ * @brief Gets the status code for the entries that could not be read from a
+ * response for the archive, or 0 if the request was abandoned.
+ */
+uint16_t getFailureStatusCode(const IAssetResponse* pResponse) {
+  if (!pResponse) {
+    return 0;
+  }
+
+  // A successful request that did not contain the expected range means that
+  // the archive is corrupt.
+  const uint16_t statusCode = pResponse->statusCode();
+  return statusCode == 200 || statusCode == 206 ? uint16_t(500) : statusCode;
+}
+
+std::unique_ptr<ArchiveEntryResponse>
+createFailureResponse(const IAssetResponse* pArchiveResponse) {
+  return createEntryResponse(
+      pArchiveResponse,
+      getFailureStatusCode(pArchiveResponse));
+}
+
+struct ArchiveIndex {
+  // The status code of the failed request for the central directory, 0 if it
+  // was abandoned, or 200 if the directory was read.
+  uint16_t statusCode;
+  uint64_t directoryOffset;
+  std::unordered_map<std::string, ZipEntry> entries;
+};
+
+std::shared_ptr<const ArchiveIndex> createFailedIndex(uint16_t statusCode) {
+  auto pIndex = std::make_shared<ArchiveIndex>();
+  pIndex->statusCode = statusCode;
+  pIndex->directoryOffset = 0;
+  return pIndex;
+}
+
+std::shared_ptr<const ArchiveIndex> readIndex(
+    const IAssetResponse* pResponse,
+    const ZipCentralDirectoryLocation& location) {
+  std::optional<gsl::span<const std::byte>> maybeDirectory =
+      getArchiveRange(pResponse, location.offset, location.size);
+  if (!maybeDirectory) {
+    return createFailedIndex(getFailureStatusCode(pResponse));
+  }
+
+  std::optional<std::unordered_map<std::string, ZipEntry>> maybeEntries =
+      readZipCentralDirectoryEntries(*maybeDirectory, location.entryCount);
+  if (!maybeEntries) {
+    return createFailedIndex(500);
+  }
+
+  auto pIndex = std::make_shared<ArchiveIndex>();
+  pIndex->statusCode = 200;
+  pIndex->directoryOffset = location.offset;
+  pIndex->entries = std::move(*maybeEntries);
+  return pIndex;
+}
+
+/**
+ * @brief Reads the central directory of an archive, with a request for the
+ * end of the archive and, if the directory does not fit in it, a request for
+ * the directory.
+ */
+Future<std::shared_ptr<const ArchiveIndex>> requestIndex(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    const std::string& archiveUrl,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const AssetRequestOptions& options) {
+  const std::string tailRange =
+      "bytes=-" + std::to_string(zipEndOfCentralDirectorySearchSize);
+  return pAccessor
+      ->getWithOptions(
+          asyncSystem,
+          archiveUrl,
+          getRangeHeaders(headers, tailRange, false),
+          options)
+      .thenInWorkerThread(
+          [asyncSystem, pAccessor, archiveUrl, headers, options](
+              std::shared_ptr<IAssetRequest>&& pTailRequest)
+              -> Future<std::shared_ptr<const ArchiveIndex>> {
+            const IAssetResponse* pResponse = pTailRequest->response();
+            std::optional<uint64_t> maybeTailOffset =
+                pResponse ? getResponseOffset(*pResponse) : std::nullopt;
+            if (!maybeTailOffset) {
+              return asyncSystem.createResolvedFuture(
+                  createFailedIndex(getFailureStatusCode(pResponse)));
+            }
+
+            std::optional<ZipCentralDirectoryLocation> maybeLocation =
+                findZipCentralDirectory(pResponse->data(), *maybeTailOffset);
+            if (!maybeLocation) {
+              return asyncSystem.createResolvedFuture(createFailedIndex(500));
+            }
+
+            if (maybeLocation->size == 0 ||
+                getArchiveRange(
+                    pResponse,
+                    maybeLocation->offset,
+                    maybeLocation->size)) {
+              return asyncSystem.createResolvedFuture(
+                  readIndex(pResponse, *maybeLocation));
+            }
+
+            return pAccessor
+                ->getWithOptions(
+                    asyncSystem,
+                    archiveUrl,
+                    getRangeHeaders(
+                        headers,
+                        getByteRange(
+                            maybeLocation->offset,
+                            maybeLocation->offset + maybeLocation->size),
+                        false),
+                    options)
+                .thenInWorkerThread(
+                    [location = *maybeLocation](
+                        std::shared_ptr<IAssetRequest>&& pDirectoryRequest) {
+                      return readIndex(pDirectoryRequest->response(), location);
+                    });
+          });
+}
+
+/**
+ * @brief Creates the response for an entry from its contents.
+ */
+std::shared_ptr<IAssetRequest> decodeEntry(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const ZipEntry& entry,
+    const IAssetResponse* pArchiveResponse,
+    const gsl::span<const std::byte>& contents) {
+  std::vector<std::byte> data;
+  if (isZipEntryStored(entry)) {
+    data.assign(contents.begin(), contents.end());
+  } else if (!inflateZipEntry(contents, entry, data)) {
+    return createEntryRequest(
+        url,
+        headers,
+        createEntryResponse(pArchiveResponse, 500));
+  }
+
+  return createEntryRequest(
+      url,
+      headers,
+      createEntryResponse(pArchiveResponse, 200, std::move(data)));
+}
+
+/**
+ * @brief Reads an entry from the response for a range of the archive that
+ * starts at or before its local header.
+ *
+ * The range was estimated from the central directory, which does not record
+ * the length of the extra field of the local header, so the rest of the
+ * contents are requested if the range turns out to be too short.
+ */
+Future<std::shared_ptr<IAssetRequest>> readEntry(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    const std::string& archiveUrl,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const AssetRequestOptions& options,
+    const std::string& url,
+    const ZipEntry& entry,
+    const IAssetRequest& rangeRequest) {
+  const IAssetResponse* pResponse = rangeRequest.response();
+  std::optional<gsl::span<const std::byte>> maybeHeader = getArchiveRange(
+      pResponse,
+      entry.localHeaderOffset,
+      zipLocalFileHeaderSize);
+  std::optional<uint64_t> maybeDataOffset =
+      maybeHeader ? getZipEntryDataOffset(*maybeHeader) : std::nullopt;
+  if (!maybeDataOffset) {
+    return asyncSystem.createResolvedFuture(
+        createEntryRequest(url, headers, createFailureResponse(pResponse)));
+  }
+
+  const uint64_t contentsOffset = entry.localHeaderOffset + *maybeDataOffset;
+  std::optional<gsl::span<const std::byte>> maybeContents =
+      getArchiveRange(pResponse, contentsOffset, entry.compressedSize);
+  if (maybeContents || entry.compressedSize == 0) {
+    return asyncSystem.createResolvedFuture(decodeEntry(
+        url,
+        headers,
+        entry,
+        pResponse,
+        maybeContents.value_or(gsl::span<const std::byte>())));
+  }
+
+  return pAccessor
+      ->getWithOptions(
+          asyncSystem,
+          archiveUrl,
+          getRangeHeaders(
+              headers,
+              getByteRange(
+                  contentsOffset,
+                  contentsOffset + entry.compressedSize),
+              true),
+          options)
+      .thenInWorkerThread(
+          [url, headers, entry, contentsOffset](
+              std::shared_ptr<IAssetRequest>&& pContentsRequest) {
+            const IAssetResponse* pContentsResponse =
+                pContentsRequest->response();
+            std::optional<gsl::span<const std::byte>> maybeRest =
+                getArchiveRange(
+                    pContentsResponse,
+                    contentsOffset,
+                    entry.compressedSize);
+            if (!maybeRest) {
+              return createEntryRequest(
+                  url,
+                  headers,
+                  createFailureResponse(pContentsResponse));
+            }
+
+            return decodeEntry(
+                url,
+                headers,
+                entry,
+                pContentsResponse,
+                *maybeRest);
+          });
+}
+
+// The local header of an entry repeats its name, and usually has an extra
+// field no longer than this.
+const uint64_t localExtraFieldAllowance = 256;
+
+struct PendingEntry {
+  std::string url;
+  std::string name;
+  Promise<std::shared_ptr<IAssetRequest>> promise;
+};
+
+/**
+ * @brief Reads entries of an archive whose central directory has been read,
+ * with one request for each group of entries that are close together.
+ */
+void readIndexedEntries(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    uint64_t maximumCoalescingGap,
+    const ArchiveIndex& index,
+    const std::string& archiveUrl,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const AssetRequestOptions& options,
+    const std::vector<PendingEntry>& entries) {
+  std::vector<std::pair<ZipEntry, const PendingEntry*>> found;
+  found.reserve(entries.size());
+  for (const PendingEntry& pending : entries) {
+    if (index.statusCode != 200) {
+      pending.promise.resolve(createEntryRequest(
+          pending.url,
+          headers,
+          index.statusCode == 0 ? nullptr
+                                : std::make_unique<ArchiveEntryResponse>(
+                                      index.statusCode,
+                                      HttpHeaders(),
+                                      std::vector<std::byte>())));
+      continue;
+    }
+
+    auto it = index.entries.find(pending.name);
+    if (it == index.entries.end()) {
+      pending.promise.resolve(createEntryRequest(
+          pending.url,
+          headers,
+          std::make_unique<ArchiveEntryResponse>(
+              uint16_t(404),
+              HttpHeaders(),
+              std::vector<std::byte>())));
+      continue;
+    }
+
+    found.emplace_back(it->second, &pending);
+  }
+
+  std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+    return a.first.localHeaderOffset < b.first.localHeaderOffset;
+  });
+
+  const auto getEstimatedEnd = [&index](const ZipEntry& entry,
+                                        const std::string& name) {
+    const uint64_t begin = entry.localHeaderOffset;
+    const uint64_t end = begin + zipLocalFileHeaderSize + name.size() +
+                         localExtraFieldAllowance + entry.compressedSize;
+    return std::max(
+        std::min(end, index.directoryOffset),
+        begin + zipLocalFileHeaderSize);
+  };
+
+  size_t groupStart = 0;
+  while (groupStart < found.size()) {
+    const uint64_t begin = found[groupStart].first.localHeaderOffset;
+    uint64_t end = getEstimatedEnd(
+        found[groupStart].first,
+        found[groupStart].second->name);
+    size_t groupEnd = groupStart + 1;
+    while (groupEnd < found.size() &&
+           found[groupEnd].first.localHeaderOffset <=
+               end + maximumCoalescingGap) {
+      end = std::max(
+          end,
+          getEstimatedEnd(found[groupEnd].first, found[groupEnd].second->name));
+      ++groupEnd;
+    }
+
+    SharedFuture<std::shared_ptr<IAssetRequest>> rangeRequest =
+        pAccessor
+            ->getWithOptions(
+                asyncSystem,
+                archiveUrl,
+                getRangeHeaders(headers, getByteRange(begin, end), true),
+                options)
+            .share();
+
+    for (size_t i = groupStart; i < groupEnd; ++i) {
+      const ZipEntry& entry = found[i].first;
+      const Promise<std::shared_ptr<IAssetRequest>>& promise =
+          found[i].second->promise;
+      rangeRequest
+          .thenInWorkerThread(
+              [asyncSystem,
+               pAccessor,
+               archiveUrl,
+               headers,
+               options,
+               url = found[i].second->url,
+               entry](const std::shared_ptr<IAssetRequest>& pRangeRequest) {
+                return readEntry(
+                    asyncSystem,
+                    pAccessor,
+                    archiveUrl,
+                    headers,
+                    options,
+                    url,
+                    entry,
+                    *pRangeRequest);
+              })
+          .thenImmediately(
+              [promise](std::shared_ptr<IAssetRequest>&& pRequest) {
+                promise.resolve(std::move(pRequest));
+              })
+          .catchImmediately([promise](std::exception&& e) {
+            promise.reject(std::move(e));
+          });
+    }
+
+    groupStart = groupEnd;
+  }
+}
+
+void readEntries(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    uint64_t maximumCoalescingGap,
+    SharedFuture<std::shared_ptr<const ArchiveIndex>>&& index,
+    const std::string& archiveUrl,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const AssetRequestOptions& options,
+    std::vector<PendingEntry>&& entries) {
+  std::vector<Promise<std::shared_ptr<IAssetRequest>>> promises;
+  promises.reserve(entries.size());
+  for (const PendingEntry& pending : entries) {
+    promises.emplace_back(pending.promise);
+  }
+
+  index
+      .thenImmediately(
+          [asyncSystem,
+           pAccessor,
+           maximumCoalescingGap,
+           archiveUrl,
+           headers,
+           options,
+           entries = std::move(entries)](
+              const std::shared_ptr<const ArchiveIndex>& pIndex) {
+            readIndexedEntries(
+                asyncSystem,
+                pAccessor,
+                maximumCoalescingGap,
+                *pIndex,
+                archiveUrl,
+                headers,
+                options,
+                entries);
+          })
+      .catchImmediately([promises = std::move(promises)](std::exception&& e) {
+        for (const Promise<std::shared_ptr<IAssetRequest>>& promise :
+             promises) {
+          promise.reject(e);
+        }
+      });
+}
+
+} // namespace
+
+struct RemoteArchiveAssetAccessor::IndexCache {
+  std::mutex mutex;
+  std::unordered_map<
+      std::string,
+      SharedFuture<std::shared_ptr<const ArchiveIndex>>>
+      indices;
+
+  /**
+   * @brief Gets the central directory of the archive at the given URL,
+   * requesting it on first use, or again if the previous request failed.
+   */
+  SharedFuture<std::shared_ptr<const ArchiveIndex>>
+  get(const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAccessor,
+      const std::string& archiveUrl,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      const AssetRequestOptions& options) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->indices.find(archiveUrl);
+    if (it != this->indices.end() && !hasFailed(it->second)) {
+      return it->second;
+    }
+
+    SharedFuture<std::shared_ptr<const ArchiveIndex>> index =
+        requestIndex(asyncSystem, pAccessor, archiveUrl, headers, options)
+            .share();
+    this->indices.insert_or_assign(archiveUrl, index);
+    return index;
+  }
+
+  static bool
+  hasFailed(const SharedFuture<std::shared_ptr<const ArchiveIndex>>& index) {
+    if (!index.isReady()) {
+      return false;
+    }
+
+    try {
+      return index.wait()->statusCode != 200;
+    } catch (...) {
+      return true;
+    }
+  }
+};
+
+RemoteArchiveAssetAccessor::RemoteArchiveAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    uint64_t maximumCoalescingGap)
+    : _pAssetAccessor(pAssetAccessor),
+      _maximumCoalescingGap(maximumCoalescingGap),
+      _pIndices(std::make_shared<IndexCache>()) {}
+
+RemoteArchiveAssetAccessor::~RemoteArchiveAssetAccessor() noexcept = default;
+
+Future<std::shared_ptr<IAssetRequest>> RemoteArchiveAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  if (!splitArchiveUrl(url)) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+  return this->getWithOptions(asyncSystem, url, headers, {});
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+RemoteArchiveAssetAccessor::getWithCancellation(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const CancellationToken& cancellationToken) {
+  if (!splitArchiveUrl(url)) {
+    return this->_pAssetAccessor
+        ->getWithCancellation(asyncSystem, url, headers, cancellationToken);
+  }
+
+  AssetRequestOptions options;
+  options.cancellationToken = cancellationToken;
+  return this->getWithOptions(asyncSystem, url, headers, options);
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+RemoteArchiveAssetAccessor::getWithOptions(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const AssetRequestOptions& options) {
+  std::optional<ArchiveUrl> maybeArchiveUrl = splitArchiveUrl(url);
+  if (!maybeArchiveUrl) {
+    return this->_pAssetAccessor
+        ->getWithOptions(asyncSystem, url, headers, options);
+  }
+
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  std::vector<PendingEntry> entries;
+  entries.emplace_back(
+      PendingEntry{url, std::move(maybeArchiveUrl->entryName), promise});
+
+  readEntries(
+      asyncSystem,
+      this->_pAssetAccessor,
+      this->_maximumCoalescingGap,
+      this->_pIndices->get(
+          asyncSystem,
+          this->_pAssetAccessor,
+          maybeArchiveUrl->archiveUrl,
+          headers,
+          options),
+      maybeArchiveUrl->archiveUrl,
+      headers,
+      options,
+      std::move(entries));
+
+  return promise.getFuture();
+}
+
+std::vector<Future<std::shared_ptr<IAssetRequest>>>
+RemoteArchiveAssetAccessor::getBatch(
+    const AsyncSystem& asyncSystem,
+    const std::vector<std::string>& urls,
+    const std::vector<THeader>& headers) {
+  std::vector<std::optional<Future<std::shared_ptr<IAssetRequest>>>> slots(
+      urls.size());
+  std::vector<std::string> otherUrls;
+  std::vector<size_t> otherSlots;
+  std::unordered_map<std::string, std::vector<PendingEntry>> archives;
+
+  for (size_t i = 0; i < urls.size(); ++i) {
+    std::optional<ArchiveUrl> maybeArchiveUrl = splitArchiveUrl(urls[i]);
+    if (!maybeArchiveUrl) {
+      otherUrls.emplace_back(urls[i]);
+      otherSlots.emplace_back(i);
+      continue;
+    }
+
+    Promise<std::shared_ptr<IAssetRequest>> promise =
+        asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+    slots[i] = promise.getFuture();
+    archives[maybeArchiveUrl->archiveUrl].emplace_back(PendingEntry{
+        urls[i],
+        std::move(maybeArchiveUrl->entryName),
+        std::move(promise)});
+  }
+
+  if (!otherUrls.empty()) {
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> otherRequests =
+        this->_pAssetAccessor->getBatch(asyncSystem, otherUrls, headers);
+    for (size_t i = 0; i < otherRequests.size(); ++i) {
+      slots[otherSlots[i]] = std::move(otherRequests[i]);
+    }
+  }
+
+  for (auto& [archiveUrl, entries] : archives) {
+    readEntries(
+        asyncSystem,
+        this->_pAssetAccessor,
+        this->_maximumCoalescingGap,
+        this->_pIndices->get(
+            asyncSystem,
+            this->_pAssetAccessor,
+            archiveUrl,
+            headers,
+            {}),
+        archiveUrl,
+        headers,
+        {},
+        std::move(entries));
+  }
+
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> result;
+  result.reserve(slots.size());
+  for (std::optional<Future<std::shared_ptr<IAssetRequest>>>& slot : slots) {
+    result.emplace_back(std::move(*slot));
+  }
+  return result;
+}
+
+Future<std::shared_ptr<IAssetRequest>> RemoteArchiveAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void RemoteArchiveAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+} // namespace CesiumAsync
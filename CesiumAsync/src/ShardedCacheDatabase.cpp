@@ -0,0 +1,127 @@
+#include "CesiumAsync/ShardedCacheDatabase.h"
+
+#include "CesiumAsync/SqliteCache.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+
+// A 64-bit FNV-1a hash. Unlike std::hash, it is the same on every platform
+// and in every run, so a key maps to the same shard file every time the cache
+// is opened.
+uint64_t hashKey(const std::string& key) noexcept {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : key) {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+} // namespace
+
+ShardedCacheDatabase::ShardedCacheDatabase(
+    std::vector<std::shared_ptr<ICacheDatabase>>&& shards)
+    : _shards(std::move(shards)) {
+  if (this->_shards.empty()) {
+    throw std::invalid_argument("A sharded cache needs at least one shard.");
+  }
+
+  for (const std::shared_ptr<ICacheDatabase>& pShard : this->_shards) {
+    if (!pShard) {
+      throw std::invalid_argument("A cache shard must not be nullptr.");
+    }
+  }
+}
+
+std::vector<std::shared_ptr<ICacheDatabase>>
+ShardedCacheDatabase::createSqliteShards(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& databaseName,
+    uint32_t shardCount,
+    uint64_t maxItems) {
+  const uint64_t maxItemsPerShard =
+      shardCount > 0 ? (maxItems + shardCount - 1) / shardCount : maxItems;
+
+  std::vector<std::shared_ptr<ICacheDatabase>> shards;
+  shards.reserve(shardCount);
+  for (uint32_t i = 0; i < shardCount; ++i) {
+    shards.emplace_back(std::make_shared<SqliteCache>(
+        pLogger,
+        databaseName + "-" + std::to_string(i),
+        maxItemsPerShard));
+  }
+  return shards;
+}
+
+std::optional<CacheItem>
+ShardedCacheDatabase::getEntry(const std::string& key) const {
+  return this->_shards[this->getShardIndex(key)]->getEntry(key);
+}
+
+bool ShardedCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  return this->_shards[this->getShardIndex(key)]->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+size_t
+ShardedCacheDatabase::storeEntries(const std::vector<CacheEntry>& entries) {
+  CESIUM_TRACE_CATEGORY(Cache, "ShardedCacheDatabase::storeEntries");
+
+  std::vector<std::vector<CacheEntry>> entriesByShard(this->_shards.size());
+  for (const CacheEntry& entry : entries) {
+    entriesByShard[this->getShardIndex(entry.key)].emplace_back(entry);
+  }
+
+  size_t storedEntries = 0;
+  for (size_t i = 0; i < this->_shards.size(); ++i) {
+    if (!entriesByShard[i].empty()) {
+      storedEntries += this->_shards[i]->storeEntries(entriesByShard[i]);
+    }
+  }
+  return storedEntries;
+}
+
+bool ShardedCacheDatabase::prune() {
+  CESIUM_TRACE_CATEGORY(Cache, "ShardedCacheDatabase::prune");
+
+  bool result = true;
+  for (const std::shared_ptr<ICacheDatabase>& pShard : this->_shards) {
+    result = pShard->prune() && result;
+  }
+  return result;
+}
+
+bool ShardedCacheDatabase::clearAll() {
+  bool result = true;
+  for (const std::shared_ptr<ICacheDatabase>& pShard : this->_shards) {
+    result = pShard->clearAll() && result;
+  }
+  return result;
+}
+
+size_t ShardedCacheDatabase::getShardIndex(const std::string& key) const {
+  return size_t(hashKey(key) % this->_shards.size());
+}
+
+} // namespace CesiumAsync
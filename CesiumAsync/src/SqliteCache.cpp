@@ -2,16 +2,22 @@
 
 #include "CesiumAsync/IAssetResponse.h"
 
+#include <CesiumUtility/Gunzip.h>
 #include <CesiumUtility/Tracing.h>
 #include <cesium-sqlite3.h>
 
 #include <rapidjson/document.h>
-#include <rapidjson/writer.h>
 #include <spdlog/spdlog.h>
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 using namespace CesiumAsync;
@@ -29,6 +35,7 @@ const std::string CACHE_TABLE_RESPONSE_DATA_COLUMN = "responseData";
 const std::string CACHE_TABLE_REQUEST_HEADER_COLUMN = "requestHeader";
 const std::string CACHE_TABLE_REQUEST_METHOD_COLUMN = "requestMethod";
 const std::string CACHE_TABLE_REQUEST_URL_COLUMN = "requestUrl";
+const std::string CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN = "responseDataCodec";
 const std::string CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN = "totalItems";
 
 // Sql commands for setting up database
@@ -41,7 +48,17 @@ const std::string CREATE_CACHE_TABLE_SQL =
     " INTEGER NOT NULL," + CACHE_TABLE_RESPONSE_DATA_COLUMN + " BLOB," +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + " TEXT NOT NULL," +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + " TEXT NOT NULL," +
-    CACHE_TABLE_REQUEST_URL_COLUMN + " TEXT NOT NULL)";
+    CACHE_TABLE_REQUEST_URL_COLUMN + " TEXT NOT NULL," +
+    CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN + " INTEGER NOT NULL DEFAULT 0)";
+
+// Sql commands for upgrading a database created before the codec column
+const std::string CHECK_CODEC_COLUMN_SQL =
+    "SELECT " + CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN + " FROM " +
+    CACHE_TABLE + " LIMIT 0";
+
+const std::string ADD_CODEC_COLUMN_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN + " INTEGER NOT NULL DEFAULT 0";
 
 const std::string PRAGMA_WAL_SQL = "PRAGMA journal_mode=WAL";
 
@@ -49,6 +66,8 @@ const std::string PRAGMA_SYNC_SQL = "PRAGMA synchronous=OFF";
 
 const std::string PRAGMA_PAGE_SIZE_SQL = "PRAGMA page_size=4096";
 
+const std::string PRAGMA_MMAP_SIZE_SQL = "PRAGMA mmap_size=";
+
 // Sql commands for getting entry from database
 const std::string GET_ENTRY_SQL =
     "SELECT rowid, " + CACHE_TABLE_EXPIRY_TIME_COLUMN + ", " +
@@ -57,7 +76,8 @@ const std::string GET_ENTRY_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    " FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
+    ", " + CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN + " FROM " + CACHE_TABLE +
+    " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
 
 const std::string UPDATE_LAST_ACCESSED_TIME_SQL =
     "UPDATE " + CACHE_TABLE + " SET " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
@@ -72,7 +92,9 @@ const std::string STORE_RESPONSE_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    ", " + CACHE_TABLE_KEY_COLUMN + ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    ", " + CACHE_TABLE_KEY_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN +
+    ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
 
 // Sql commands for prunning the database
 const std::string TOTAL_ITEMS_QUERY_SQL =
@@ -80,55 +102,269 @@ const std::string TOTAL_ITEMS_QUERY_SQL =
     CACHE_TABLE;
 
 const std::string DELETE_EXPIRED_ITEMS_SQL =
-    "DELETE FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
-    " < strftime('%s','now')";
+    "DELETE FROM " + CACHE_TABLE + " WHERE rowid IN (SELECT rowid FROM " +
+    CACHE_TABLE + " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
+    " < strftime('%s','now') LIMIT ?)";
 
 const std::string DELETE_LRU_ITEMS_SQL =
     "DELETE FROM " + CACHE_TABLE + " WHERE rowid " + " IN (SELECT rowid FROM " +
     CACHE_TABLE + " ORDER BY " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
     " ASC " + " LIMIT ?)";
 
+// Sql commands for exporting entries, in chunks in the order of their rows.
+// The columns are the same as in GET_ENTRY_SQL, followed by the key.
+const std::string EXPORT_ENTRIES_SQL =
+    "SELECT rowid, " + CACHE_TABLE_EXPIRY_TIME_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_HEADER_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_STATUS_CODE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
+    CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
+    CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
+    ", " + CACHE_TABLE_RESPONSE_DATA_CODEC_COLUMN + ", " +
+    CACHE_TABLE_KEY_COLUMN + " FROM " + CACHE_TABLE +
+    " WHERE rowid > ? ORDER BY rowid LIMIT ?";
+
+const std::string ENTRY_EXISTS_SQL = "SELECT 1 FROM " + CACHE_TABLE +
+                                     " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
+
+// The maximum number of rows deleted while holding the lock during a prune.
+const int64_t PRUNE_CHUNK_SIZE = 256;
+
+// The maximum number of entries written in one transaction during an import.
+const size_t IMPORT_BATCH_SIZE = 1024;
+
+// The maximum number of rows read while holding the lock during an export.
+const int64_t EXPORT_CHUNK_SIZE = 256;
+
+// Sql commands for batching writes
+const std::string BEGIN_TRANSACTION_SQL = "BEGIN TRANSACTION";
+const std::string COMMIT_TRANSACTION_SQL = "COMMIT TRANSACTION";
+const std::string ROLLBACK_TRANSACTION_SQL = "ROLLBACK TRANSACTION";
+
 // Sql commands for clean all items
 const std::string CLEAR_ALL_SQL = "DELETE FROM " + CACHE_TABLE;
 
-std::string convertHeadersToString(const HttpHeaders& headers) {
-  rapidjson::Document document;
-  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-  rapidjson::Value root(rapidjson::kObjectType);
-  rapidjson::Value key(rapidjson::kStringType);
-  rapidjson::Value value(rapidjson::kStringType);
-  for (const std::pair<const std::string, std::string>& header : headers) {
-    key.SetString(header.first.c_str(), allocator);
-    value.SetString(header.second.c_str(), allocator);
-    root.AddMember(key, value, allocator);
-  }
-
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-  root.Accept(writer);
-  return buffer.GetString();
+// The codecs of the stored response data.
+const int RESPONSE_DATA_CODEC_NONE = 0;
+const int RESPONSE_DATA_CODEC_DEFLATE = 1;
+
+// Response data smaller than this is stored as-is, because compressing it
+// saves too little to be worth the time.
+const size_t MINIMUM_COMPRESSIBLE_SIZE = 512;
+
+// Checks whether response data is likely to compress well. Images and data
+// that is already compressed, such as KTX2 and Draco, are not.
+bool isLikelyCompressible(
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data) {
+  if (data.size() < MINIMUM_COMPRESSIBLE_SIZE) {
+    return false;
+  }
+
+  auto encodingIt = responseHeaders.find("Content-Encoding");
+  if (encodingIt != responseHeaders.end() &&
+      encodingIt->second != "identity") {
+    return false;
+  }
+
+  auto typeIt = responseHeaders.find("Content-Type");
+  if (typeIt != responseHeaders.end()) {
+    const std::string& contentType = typeIt->second;
+    if (contentType.rfind("image/", 0) == 0 ||
+        contentType.rfind("video/", 0) == 0 ||
+        contentType.rfind("audio/", 0) == 0 ||
+        contentType.find("zip") != std::string::npos) {
+      return false;
+    }
+  }
+
+  // Many servers send every binary file as application/octet-stream, so
+  // check the signatures of common compressed formats, too.
+  const auto startsWith = [&data](const char* signature, size_t size) {
+    return std::equal(
+        data.begin(),
+        data.begin() + static_cast<std::ptrdiff_t>(size),
+        reinterpret_cast<const std::byte*>(signature));
+  };
+  return !CesiumUtility::isGzip(data) && !startsWith("\xFF\xD8\xFF", 3) &&
+         !startsWith("\x89PNG", 4) && !startsWith("\xABKTX", 4) &&
+         !startsWith("RIFF", 4) && !startsWith("DRACO", 5);
 }
 
-std::optional<HttpHeaders> convertStringToHeaders(
-    const std::string& serializedHeaders,
-    const std::shared_ptr<spdlog::logger>& pLogger) {
+// Compresses response data for storage, if compression is enabled and the
+// data compresses well. Returns the codec of the stored data; the compressed
+// data is only written to `encoded` if it is not RESPONSE_DATA_CODEC_NONE.
+int encodeResponseData(
+    SqliteCacheCompression compression,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& encoded) {
+  if (compression == SqliteCacheCompression::None ||
+      !isLikelyCompressible(responseHeaders, data)) {
+    return RESPONSE_DATA_CODEC_NONE;
+  }
+
+  // Keep the compressed data only if it saves at least an eighth, so that
+  // incompressible data is not inflated on every read for nothing.
+  if (!CesiumUtility::deflateZlib(data, encoded) ||
+      encoded.size() > data.size() - data.size() / 8) {
+    encoded.clear();
+    return RESPONSE_DATA_CODEC_NONE;
+  }
+
+  return RESPONSE_DATA_CODEC_DEFLATE;
+}
+
+// Restores stored response data with the given codec.
+bool decodeResponseData(
+    int codec,
+    const gsl::span<const std::byte>& stored,
+    std::vector<std::byte>& out) {
+  switch (codec) {
+  case RESPONSE_DATA_CODEC_NONE:
+    out.assign(stored.begin(), stored.end());
+    return true;
+  case RESPONSE_DATA_CODEC_DEFLATE:
+    return CesiumUtility::inflateZlib(stored, out);
+  default:
+    return false;
+  }
+}
+
+// The version of the binary encoding of stored headers, which is its first
+// byte. Headers stored as text are JSON objects, as written by older versions.
+const uint8_t HEADERS_ENCODING_VERSION = 1;
+
+void writeVarint(std::vector<std::byte>& out, size_t value) {
+  while (value >= 0x80) {
+    out.emplace_back(std::byte((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.emplace_back(std::byte(value));
+}
+
+bool readVarint(const std::byte*& pData, const std::byte* pEnd, size_t& value) {
+  value = 0;
+  for (size_t shift = 0; shift < sizeof(size_t) * 8 && pData < pEnd;
+       shift += 7) {
+    const uint8_t byte = uint8_t(*pData++);
+    value |= size_t(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void writeString(std::vector<std::byte>& out, const std::string& value) {
+  writeVarint(out, value.size());
+  const std::byte* pValue = reinterpret_cast<const std::byte*>(value.data());
+  out.insert(out.end(), pValue, pValue + value.size());
+}
+
+bool readString(
+    const std::byte*& pData,
+    const std::byte* pEnd,
+    std::string& value) {
+  size_t size;
+  if (!readVarint(pData, pEnd, size) || size_t(pEnd - pData) < size) {
+    return false;
+  }
+  value.assign(reinterpret_cast<const char*>(pData), size);
+  pData += size;
+  return true;
+}
+
+// Encodes headers as the version byte, the number of headers, and the name
+// and value of each header, each prefixed with its length. Lengths and the
+// count are unsigned LEB128 varints.
+void encodeHeaders(const HttpHeaders& headers, std::vector<std::byte>& out) {
+  out.clear();
+  out.emplace_back(std::byte(HEADERS_ENCODING_VERSION));
+  writeVarint(out, headers.size());
+  for (const HttpHeaders::value_type& header : headers) {
+    writeString(out, header.first);
+    writeString(out, header.second);
+  }
+}
+
+std::optional<HttpHeaders>
+decodeBinaryHeaders(const std::byte* pData, const std::byte* pEnd) {
+  if (pData == pEnd || uint8_t(*pData) != HEADERS_ENCODING_VERSION) {
+    return std::nullopt;
+  }
+  ++pData;
+
+  size_t count;
+  if (!readVarint(pData, pEnd, count)) {
+    return std::nullopt;
+  }
+
+  // The headers were written in order, so each one is inserted at the end.
+  HttpHeaders headers;
+  std::string name;
+  std::string value;
+  for (size_t i = 0; i < count; ++i) {
+    if (!readString(pData, pEnd, name) || !readString(pData, pEnd, value)) {
+      return std::nullopt;
+    }
+    headers.emplace_hint(headers.end(), std::move(name), std::move(value));
+  }
+
+  return headers;
+}
+
+std::optional<HttpHeaders> decodeJsonHeaders(const char* pJson, size_t size) {
   rapidjson::Document document;
-  document.Parse(serializedHeaders.c_str());
-  if (document.HasParseError()) {
-    SPDLOG_LOGGER_ERROR(
-        pLogger,
-        "Unable to parse http header string from cache.");
+  document.Parse(pJson, size);
+  if (document.HasParseError() || !document.IsObject()) {
     return std::nullopt;
   }
   std::optional<HttpHeaders> headers = std::make_optional<HttpHeaders>();
   for (rapidjson::Document::ConstMemberIterator it = document.MemberBegin();
        it != document.MemberEnd();
        ++it) {
-    headers->insert({it->name.GetString(), it->value.GetString()});
+    if (it->value.IsString()) {
+      headers->insert({it->name.GetString(), it->value.GetString()});
+    }
+  }
+  return headers;
+}
+
+// Decodes the headers in a column of the current row, which are binary for
+// entries stored by this version and JSON text for older ones.
+std::optional<HttpHeaders> readHeadersColumn(
+    CESIUM_SQLITE(sqlite3_stmt*) pStatement,
+    int column,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  std::optional<HttpHeaders> headers;
+  if (CESIUM_SQLITE(sqlite3_column_type)(pStatement, column) == SQLITE_TEXT) {
+    const char* pJson = reinterpret_cast<const char*>(
+        CESIUM_SQLITE(sqlite3_column_text)(pStatement, column));
+    const int size = CESIUM_SQLITE(sqlite3_column_bytes)(pStatement, column);
+    headers = decodeJsonHeaders(pJson, static_cast<size_t>(size));
+  } else {
+    const std::byte* pData = reinterpret_cast<const std::byte*>(
+        CESIUM_SQLITE(sqlite3_column_blob)(pStatement, column));
+    const int size = CESIUM_SQLITE(sqlite3_column_bytes)(pStatement, column);
+    headers = decodeBinaryHeaders(pData, pData + size);
+  }
+
+  if (!headers) {
+    SPDLOG_LOGGER_ERROR(pLogger, "Unable to parse http headers from cache.");
   }
   return headers;
 }
 
+// Reads a text column of the current row without measuring its length again.
+std::string
+readTextColumn(CESIUM_SQLITE(sqlite3_stmt*) pStatement, int column) {
+  const char* pText = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pStatement, column));
+  const int size = CESIUM_SQLITE(sqlite3_column_bytes)(pStatement, column);
+  return pText ? std::string(pText, static_cast<size_t>(size)) : std::string();
+}
+
 struct DeleteSqliteConnection {
   void operator()(CESIUM_SQLITE(sqlite3*) pConnection) noexcept {
     CESIUM_SQLITE(sqlite3_close_v2)(pConnection);
@@ -168,41 +404,557 @@ SqliteStatementPtr prepareStatement(
 namespace CesiumAsync {
 
 struct SqliteCache::Impl {
+  /**
+   * @brief An entry that has been stored but not yet written to the database.
+   */
+  struct PendingWrite {
+    std::time_t expiryTime;
+    std::time_t storeTime;
+    std::string url;
+    std::string requestMethod;
+    HttpHeaders requestHeaders;
+    uint16_t statusCode;
+    HttpHeaders responseHeaders;
+    // The response data as it will be stored, with the given codec.
+    std::vector<std::byte> responseData;
+    int responseDataCodec;
+  };
+
   Impl(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& databaseName,
-      uint64_t maxItems)
+      uint64_t maxItems,
+      uint32_t writeBatchSize,
+      std::chrono::milliseconds writeBatchInterval,
+      uint32_t readConnectionCount,
+      SqliteCacheCompression compression,
+      uint64_t mmapSize)
       : _pLogger(pLogger),
         _pConnection(nullptr),
         _databaseName(databaseName),
         _maxItems(maxItems),
+        _writeBatchSize(writeBatchSize),
+        _writeBatchInterval(writeBatchInterval),
+        _pendingWrites(),
+        _oldestPendingWrite(),
+        _totalItems(),
+        _readConnectionCount(readConnectionCount),
+        _compression(compression),
+        _mmapSize(mmapSize),
+        _requestHeadersBuffer(),
+        _responseHeadersBuffer(),
+        _readConnections(),
+        _freeReadConnections(),
         _getEntryStmtWrapper(),
         _updateLastAccessedTimeStmtWrapper(),
         _storeResponseStmtWrapper(),
         _totalItemsQueryStmtWrapper(),
+        _entryExistsStmtWrapper(),
         _deleteExpiredStmtWrapper(),
         _deleteLRUStmtWrapper(),
-        _clearAllStmtWrapper() {}
+        _clearAllStmtWrapper(),
+        _exportEntriesStmtWrapper() {}
+
+  // Writes one entry with the store statement, logging any error. Returns
+  // SQLITE_DONE on success, or the failing status code.
+  int writeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      std::time_t storeTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData,
+      int responseDataCodec) {
+    // Only a new key changes the number of rows; REPLACE keeps it the same.
+    bool isNewEntry = false;
+    if (this->_totalItems) {
+      std::optional<bool> maybeExists = this->entryExists(key);
+      if (maybeExists) {
+        isNewEntry = !*maybeExists;
+      } else {
+        this->_totalItems.reset();
+      }
+    }
+
+    // cache the request with the key
+    int status = CESIUM_SQLITE(sqlite3_reset)(
+        this->_storeResponseStmtWrapper.get());
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_clear_bindings)(
+        this->_storeResponseStmtWrapper.get());
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_int64)(
+        this->_storeResponseStmtWrapper.get(),
+        1,
+        static_cast<int64_t>(expiryTime));
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_int64)(
+        this->_storeResponseStmtWrapper.get(),
+        2,
+        static_cast<int64_t>(storeTime));
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    encodeHeaders(responseHeaders, this->_responseHeadersBuffer);
+    status = CESIUM_SQLITE(sqlite3_bind_blob)(
+        this->_storeResponseStmtWrapper.get(),
+        3,
+        this->_responseHeadersBuffer.data(),
+        static_cast<int>(this->_responseHeadersBuffer.size()),
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_int)(
+        this->_storeResponseStmtWrapper.get(),
+        4,
+        static_cast<int>(statusCode));
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_blob)(
+        this->_storeResponseStmtWrapper.get(),
+        5,
+        responseData.data(),
+        static_cast<int>(responseData.size()),
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    encodeHeaders(requestHeaders, this->_requestHeadersBuffer);
+    status = CESIUM_SQLITE(sqlite3_bind_blob)(
+        this->_storeResponseStmtWrapper.get(),
+        6,
+        this->_requestHeadersBuffer.data(),
+        static_cast<int>(this->_requestHeadersBuffer.size()),
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        this->_storeResponseStmtWrapper.get(),
+        7,
+        requestMethod.c_str(),
+        -1,
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        this->_storeResponseStmtWrapper.get(),
+        8,
+        url.c_str(),
+        -1,
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        this->_storeResponseStmtWrapper.get(),
+        9,
+        key.c_str(),
+        -1,
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_int)(
+        this->_storeResponseStmtWrapper.get(),
+        10,
+        responseDataCodec);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return status;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_step)(this->_storeResponseStmtWrapper.get());
+    if (status != SQLITE_DONE) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+    } else if (isNewEntry && this->_totalItems) {
+      ++*this->_totalItems;
+    }
+
+    return status;
+  }
+
+  // Checks whether an entry with the given key exists, or std::nullopt if
+  // there was an error.
+  std::optional<bool> entryExists(const std::string& key) const {
+    CESIUM_SQLITE(sqlite3_stmt*) pStatement =
+        this->_entryExistsStmtWrapper.get();
+    int status = CESIUM_SQLITE(sqlite3_reset)(pStatement);
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStatement);
+    }
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_bind_text)(
+          pStatement,
+          1,
+          key.c_str(),
+          -1,
+          SQLITE_STATIC);
+    }
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_step)(pStatement);
+    }
+
+    if (status == SQLITE_ROW) {
+      return true;
+    }
+    if (status == SQLITE_DONE) {
+      return false;
+    }
+
+    SPDLOG_LOGGER_ERROR(this->_pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+    return std::nullopt;
+  }
+
+  // Resets and steps a statement that takes an optional integer parameter,
+  // logging any error. Returns the status of the step.
+  int runStatement(
+      CESIUM_SQLITE(sqlite3_stmt*) pStatement,
+      std::optional<int64_t> parameter = std::nullopt) const {
+    int status = CESIUM_SQLITE(sqlite3_reset)(pStatement);
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStatement);
+    }
+    if (status == SQLITE_OK && parameter) {
+      status = CESIUM_SQLITE(sqlite3_bind_int64)(pStatement, 1, *parameter);
+    }
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_step)(pStatement);
+    }
+
+    if (status != SQLITE_DONE && status != SQLITE_ROW) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+    }
+
+    return status;
+  }
+
+  // Reads the entry with the given key using a prepared GET_ENTRY_SQL
+  // statement, returning the entry and its row ID.
+  std::optional<std::pair<int64_t, CacheItem>> readEntry(
+      CESIUM_SQLITE(sqlite3_stmt*) pStatement,
+      const std::string& key) const {
+    // get entry based on key
+    int status = CESIUM_SQLITE(sqlite3_reset)(pStatement);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return std::nullopt;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStatement);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return std::nullopt;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        pStatement,
+        1,
+        key.c_str(),
+        -1,
+        SQLITE_STATIC);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return std::nullopt;
+    }
+
+    status = CESIUM_SQLITE(sqlite3_step)(pStatement);
+    if (status == SQLITE_DONE) {
+      // Cache miss
+      return std::nullopt;
+    }
+
+    if (status != SQLITE_ROW) {
+      // Something went wrong.
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      return std::nullopt;
+    }
+
+    // Cache hit - unpack and return it.
+    const int64_t itemIndex =
+        CESIUM_SQLITE(sqlite3_column_int64)(pStatement, 0);
+
+    std::optional<CacheItem> maybeItem = this->readEntryColumns(pStatement);
+    if (!maybeItem) {
+      return std::nullopt;
+    }
+
+    return std::make_pair(itemIndex, std::move(*maybeItem));
+  }
+
+  // Unpacks the entry in the current row of a statement with the columns of
+  // GET_ENTRY_SQL.
+  std::optional<CacheItem>
+  readEntryColumns(CESIUM_SQLITE(sqlite3_stmt*) pStatement) const {
+    // parse cache item metadata
+    const std::time_t expiryTime =
+        CESIUM_SQLITE(sqlite3_column_int64)(pStatement, 1);
+
+    // parse response cache
+    std::optional<HttpHeaders> responseHeaders =
+        readHeadersColumn(pStatement, 2, this->_pLogger);
+    if (!responseHeaders) {
+      return std::nullopt;
+    }
+    const uint16_t statusCode = static_cast<uint16_t>(
+        CESIUM_SQLITE(sqlite3_column_int)(pStatement, 3));
+
+    const std::byte* rawResponseData =
+        reinterpret_cast<const std::byte*>(
+            CESIUM_SQLITE(sqlite3_column_blob)(pStatement, 4));
+    const int responseDataSize =
+        CESIUM_SQLITE(sqlite3_column_bytes)(pStatement, 4);
+    const int responseDataCodec =
+        CESIUM_SQLITE(sqlite3_column_int)(pStatement, 8);
+    // The blob is only valid until the statement is reset, so it is copied
+    // once, straight into the response.
+    std::vector<std::byte> responseData;
+    if (!decodeResponseData(
+            responseDataCodec,
+            gsl::span<const std::byte>(
+                rawResponseData,
+                static_cast<size_t>(responseDataSize)),
+            responseData)) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          "Unable to decode response data from cache.");
+      return std::nullopt;
+    }
+
+    // parse request
+    std::optional<HttpHeaders> requestHeaders =
+        readHeadersColumn(pStatement, 5, this->_pLogger);
+    if (!requestHeaders) {
+      return std::nullopt;
+    }
+
+    std::string requestMethod = readTextColumn(pStatement, 6);
+    std::string requestUrl = readTextColumn(pStatement, 7);
+
+    return CacheItem{
+        expiryTime,
+        CacheRequest{
+            std::move(*requestHeaders),
+            std::move(requestMethod),
+            std::move(requestUrl)},
+        CacheResponse{
+            statusCode,
+            std::move(*responseHeaders),
+            std::move(responseData)}};
+  }
+
+  // Runs a statement without results on the writer connection, logging any
+  // error. Returns the status.
+  int executeSql(const std::string& sql) const {
+    char* pError = nullptr;
+    const int status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pConnection.get(),
+        sql.c_str(),
+        nullptr,
+        nullptr,
+        &pError);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          pError ? pError : CESIUM_SQLITE(sqlite3_errstr)(status));
+      CESIUM_SQLITE(sqlite3_free)(pError);
+    }
+    return status;
+  }
+
+  // Records that the entry with the given row ID was just accessed.
+  void touchEntry(int64_t itemIndex) const {
+    int updateStatus = CESIUM_SQLITE(sqlite3_reset)(
+        this->_updateLastAccessedTimeStmtWrapper.get());
+    if (updateStatus != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+      return;
+    }
+
+    updateStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
+        this->_updateLastAccessedTimeStmtWrapper.get());
+    if (updateStatus != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+      return;
+    }
+
+    updateStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
+        this->_updateLastAccessedTimeStmtWrapper.get(),
+        1,
+        itemIndex);
+    if (updateStatus != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+      return;
+    }
+
+    updateStatus = CESIUM_SQLITE(sqlite3_step)(
+        this->_updateLastAccessedTimeStmtWrapper.get());
+    if (updateStatus != SQLITE_DONE) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
+      return;
+    }
+  }
+
+  /**
+   * @brief A read-only connection with its own prepared statements, used by
+   * {@link SqliteCache::getEntry} when the cache has a pool of readers.
+   */
+  struct ReadConnection {
+    SqliteConnectionPtr pConnection;
+    SqliteStatementPtr getEntryStmtWrapper;
+  };
+
+  // Takes a free read connection from the pool, waiting for one to be released
+  // if they are all in use.
+  ReadConnection* acquireReadConnection() const {
+    std::unique_lock<std::mutex> lock(this->_readPoolMutex);
+    this->_readPoolCondition.wait(lock, [this]() {
+      return !this->_freeReadConnections.empty();
+    });
+    ReadConnection* pReader = this->_freeReadConnections.back();
+    this->_freeReadConnections.pop_back();
+    return pReader;
+  }
+
+  void releaseReadConnection(ReadConnection* pReader) const {
+    {
+      std::lock_guard<std::mutex> lock(this->_readPoolMutex);
+      this->_freeReadConnections.emplace_back(pReader);
+    }
+    this->_readPoolCondition.notify_one();
+  }
 
   std::shared_ptr<spdlog::logger> _pLogger;
   SqliteConnectionPtr _pConnection;
   std::string _databaseName;
   uint64_t _maxItems;
+  uint32_t _writeBatchSize;
+  std::chrono::milliseconds _writeBatchInterval;
+  std::unordered_map<std::string, PendingWrite> _pendingWrites;
+  std::chrono::system_clock::time_point _oldestPendingWrite;
+  // The number of rows in the cache table, counted on first use by prune and
+  // then kept up to date by each write, so prune does not need to scan the
+  // table again.
+  std::optional<int64_t> _totalItems;
+  uint32_t _readConnectionCount;
+  SqliteCacheCompression _compression;
+  uint64_t _mmapSize;
+  // The encoded headers bound to the store statement, kept to reuse their
+  // allocations. They are only used while holding the lock.
+  std::vector<std::byte> _requestHeadersBuffer;
+  std::vector<std::byte> _responseHeadersBuffer;
+  std::vector<ReadConnection> _readConnections;
+  mutable std::vector<ReadConnection*> _freeReadConnections;
+  mutable std::mutex _readPoolMutex;
+  mutable std::condition_variable _readPoolCondition;
   mutable std::mutex _mutex;
   SqliteStatementPtr _getEntryStmtWrapper;
   SqliteStatementPtr _updateLastAccessedTimeStmtWrapper;
   SqliteStatementPtr _storeResponseStmtWrapper;
   SqliteStatementPtr _totalItemsQueryStmtWrapper;
+  SqliteStatementPtr _entryExistsStmtWrapper;
   SqliteStatementPtr _deleteExpiredStmtWrapper;
   SqliteStatementPtr _deleteLRUStmtWrapper;
   SqliteStatementPtr _clearAllStmtWrapper;
+  SqliteStatementPtr _exportEntriesStmtWrapper;
 };
 
 SqliteCache::SqliteCache(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& databaseName,
-    uint64_t maxItems)
-    : _pImpl(std::make_unique<Impl>(pLogger, databaseName, maxItems)) {
+    uint64_t maxItems,
+    uint32_t writeBatchSize,
+    std::chrono::milliseconds writeBatchInterval,
+    uint32_t readConnections,
+    SqliteCacheCompression compression,
+    uint64_t mmapSize)
+    : _pImpl(std::make_unique<Impl>(
+          pLogger,
+          databaseName,
+          maxItems,
+          std::max(writeBatchSize, uint32_t(1)),
+          writeBatchInterval,
+          readConnections,
+          compression,
+          mmapSize)) {
   createConnection();
 }
 
@@ -233,6 +985,31 @@ void SqliteCache::createConnection() const {
     throw std::runtime_error(errorStr);
   }
 
+  // add the codec column to a table created before it existed; its rows are
+  // uncompressed
+  CESIUM_SQLITE(sqlite3_stmt*) pCheckCodecStmt = nullptr;
+  status = CESIUM_SQLITE(sqlite3_prepare_v2)(
+      this->_pImpl->_pConnection.get(),
+      CHECK_CODEC_COLUMN_SQL.c_str(),
+      int(CHECK_CODEC_COLUMN_SQL.size()),
+      &pCheckCodecStmt,
+      nullptr);
+  CESIUM_SQLITE(sqlite3_finalize)(pCheckCodecStmt);
+  if (status != SQLITE_OK) {
+    char* addColumnError = nullptr;
+    status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pImpl->_pConnection.get(),
+        ADD_CODEC_COLUMN_SQL.c_str(),
+        nullptr,
+        nullptr,
+        &addColumnError);
+    if (status != SQLITE_OK) {
+      std::string errorStr(addColumnError);
+      CESIUM_SQLITE(sqlite3_free)(addColumnError);
+      throw std::runtime_error(errorStr);
+    }
+  }
+
   // turn on WAL mode
   char* walError = nullptr;
   status = CESIUM_SQLITE(sqlite3_exec)(
@@ -275,6 +1052,25 @@ void SqliteCache::createConnection() const {
     throw std::runtime_error(errorStr);
   }
 
+  // memory-map the database file, so that reads don't copy pages into the
+  // page cache
+  const std::string mmapSizeSql =
+      PRAGMA_MMAP_SIZE_SQL + std::to_string(this->_pImpl->_mmapSize);
+  if (this->_pImpl->_mmapSize > 0) {
+    char* mmapError = nullptr;
+    status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pImpl->_pConnection.get(),
+        mmapSizeSql.c_str(),
+        nullptr,
+        nullptr,
+        &mmapError);
+    if (status != SQLITE_OK) {
+      std::string errorStr(mmapError);
+      CESIUM_SQLITE(sqlite3_free)(mmapError);
+      throw std::runtime_error(errorStr);
+    }
+  }
+
   // get entry based on key
   this->_pImpl->_getEntryStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, GET_ENTRY_SQL);
@@ -292,6 +1088,10 @@ void SqliteCache::createConnection() const {
   this->_pImpl->_totalItemsQueryStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, TOTAL_ITEMS_QUERY_SQL);
 
+  // check whether an item exists
+  this->_pImpl->_entryExistsStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, ENTRY_EXISTS_SQL);
+
   // delete expired items
   this->_pImpl->_deleteExpiredStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, DELETE_EXPIRED_ITEMS_SQL);
@@ -303,155 +1103,106 @@ void SqliteCache::createConnection() const {
   // clear all items
   this->_pImpl->_clearAllStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, CLEAR_ALL_SQL);
-}
 
-SqliteCache::~SqliteCache() = default;
+  // export items
+  this->_pImpl->_exportEntriesStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, EXPORT_ENTRIES_SQL);
+
+  // open the pool of readers, which see the writer's committed changes
+  // through WAL mode
+  if (this->_pImpl->_readConnectionCount > 1) {
+    this->_pImpl->_readConnections.resize(this->_pImpl->_readConnectionCount);
+    for (Impl::ReadConnection& reader : this->_pImpl->_readConnections) {
+      CESIUM_SQLITE(sqlite3*) pReaderConnection;
+      status = CESIUM_SQLITE(sqlite3_open_v2)(
+          this->_pImpl->_databaseName.c_str(),
+          &pReaderConnection,
+          SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+          nullptr);
+      reader.pConnection = SqliteConnectionPtr(pReaderConnection);
+      if (status != SQLITE_OK) {
+        throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
+      }
 
-std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
-  CESIUM_TRACE("SqliteCache::getEntry");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+      if (this->_pImpl->_mmapSize > 0) {
+        status = CESIUM_SQLITE(sqlite3_exec)(
+            pReaderConnection,
+            mmapSizeSql.c_str(),
+            nullptr,
+            nullptr,
+            nullptr);
+        if (status != SQLITE_OK) {
+          throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
+        }
+      }
 
-  // get entry based on key
-  int status =
-      CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_getEntryStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+      reader.getEntryStmtWrapper =
+          prepareStatement(reader.pConnection, GET_ENTRY_SQL);
+      this->_pImpl->_freeReadConnections.emplace_back(&reader);
+    }
   }
+}
 
-  status = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_getEntryStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
-  }
-
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_getEntryStmtWrapper.get(),
-      1,
-      key.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+SqliteCache::~SqliteCache() {
+  if (this->_pImpl) {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    this->flushPendingWrites();
   }
+}
 
-  status =
-      CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_getEntryStmtWrapper.get());
-  if (status == SQLITE_DONE) {
-    // Cache miss
-    return std::nullopt;
+std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::getEntry");
+  std::unique_lock<std::mutex> guard(this->_pImpl->_mutex);
+
+  // Entries that have not been written yet are served from memory.
+  auto pendingIt = this->_pImpl->_pendingWrites.find(key);
+  if (pendingIt != this->_pImpl->_pendingWrites.end()) {
+    const Impl::PendingWrite& pending = pendingIt->second;
+    std::vector<std::byte> responseData;
+    if (!decodeResponseData(
+            pending.responseDataCodec,
+            pending.responseData,
+            responseData)) {
+      return std::nullopt;
+    }
+    return CacheItem{
+        pending.expiryTime,
+        CacheRequest{
+            HttpHeaders(pending.requestHeaders),
+            std::string(pending.requestMethod),
+            std::string(pending.url)},
+        CacheResponse{
+            pending.statusCode,
+            HttpHeaders(pending.responseHeaders),
+            std::move(responseData)}};
   }
 
-  if (status != SQLITE_ROW) {
-    // Something went wrong.
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return std::nullopt;
+  std::optional<std::pair<int64_t, CacheItem>> maybeEntry;
+  if (this->_pImpl->_readConnections.empty()) {
+    maybeEntry = this->_pImpl->readEntry(
+        this->_pImpl->_getEntryStmtWrapper.get(),
+        key);
+  } else {
+    // Read on a pooled connection without holding the writer lock, so that
+    // reads on other threads proceed concurrently.
+    guard.unlock();
+
+    Impl::ReadConnection* pReader = this->_pImpl->acquireReadConnection();
+    maybeEntry =
+        this->_pImpl->readEntry(pReader->getEntryStmtWrapper.get(), key);
+    this->_pImpl->releaseReadConnection(pReader);
+
+    guard.lock();
   }
 
-  // Cache hit - unpack and return it.
-  const int64_t itemIndex = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 0);
-
-  // parse cache item metadata
-  const std::time_t expiryTime = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 1);
-
-  // parse response cache
-  std::string serializedResponseHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 2));
-  std::optional<HttpHeaders> responseHeaders =
-      convertStringToHeaders(serializedResponseHeaders, this->_pImpl->_pLogger);
-  if (!responseHeaders) {
-    return std::nullopt;
-  }
-  const uint16_t statusCode = static_cast<uint16_t>(CESIUM_SQLITE(
-      sqlite3_column_int)(this->_pImpl->_getEntryStmtWrapper.get(), 3));
-
-  const std::byte* rawResponseData =
-      reinterpret_cast<const std::byte*>(CESIUM_SQLITE(
-          sqlite3_column_blob)(this->_pImpl->_getEntryStmtWrapper.get(), 4));
-  const int responseDataSize = CESIUM_SQLITE(
-      sqlite3_column_bytes)(this->_pImpl->_getEntryStmtWrapper.get(), 4);
-  std::vector<std::byte> responseData(
-      rawResponseData,
-      rawResponseData + responseDataSize);
-
-  // parse request
-  std::string serializedRequestHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 5));
-  std::optional<HttpHeaders> requestHeaders =
-      convertStringToHeaders(serializedRequestHeaders, this->_pImpl->_pLogger);
-  if (!requestHeaders) {
+  if (!maybeEntry) {
     return std::nullopt;
   }
 
-  std::string requestMethod = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 6));
-
-  std::string requestUrl = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 7));
-
   // update the last accessed time
-  int updateStatus = CESIUM_SQLITE(sqlite3_reset)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
+  this->_pImpl->touchEntry(maybeEntry->first);
 
-  updateStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
-
-  updateStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get(),
-      1,
-      itemIndex);
-  if (updateStatus != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
-
-  updateStatus = CESIUM_SQLITE(sqlite3_step)(
-      this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
-  if (updateStatus != SQLITE_DONE) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
-  }
-
-  return CacheItem{
-      expiryTime,
-      CacheRequest{
-          std::move(*requestHeaders),
-          std::move(requestMethod),
-          std::move(requestUrl)},
-      CacheResponse{
-          statusCode,
-          std::move(*responseHeaders),
-          std::move(responseData)}};
+  return std::move(maybeEntry->second);
 }
 
 bool SqliteCache::storeEntry(
@@ -463,301 +1214,383 @@ bool SqliteCache::storeEntry(
     uint16_t statusCode,
     const HttpHeaders& responseHeaders,
     const gsl::span<const std::byte>& responseData) {
-  CESIUM_TRACE("SqliteCache::storeEntry");
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::storeEntry");
+
+  // Compress before taking the lock, so that other threads don't wait for it.
+  std::vector<std::byte> encodedData;
+  const int responseDataCodec = encodeResponseData(
+      this->_pImpl->_compression,
+      responseHeaders,
+      responseData,
+      encodedData);
+  const gsl::span<const std::byte> storedData =
+      responseDataCodec == RESPONSE_DATA_CODEC_NONE
+          ? responseData
+          : gsl::span<const std::byte>(encodedData);
+
   std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
-  // cache the request with the key
-  int status = CESIUM_SQLITE(sqlite3_reset)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+  if (this->_pImpl->_writeBatchSize <= 1) {
+    const int status = this->_pImpl->writeEntry(
+        key,
+        expiryTime,
+        std::time(nullptr),
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        responseHeaders,
+        storedData,
+        responseDataCodec);
+    if (status == SQLITE_CORRUPT) {
+      destroyDatabase();
+    }
+    return status == SQLITE_DONE;
   }
 
-  status = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+  const auto now = std::chrono::system_clock::now();
+  if (this->_pImpl->_pendingWrites.empty()) {
+    this->_pImpl->_oldestPendingWrite = now;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      1,
-      static_cast<int64_t>(expiryTime));
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+  this->_pImpl->_pendingWrites.insert_or_assign(
+      key,
+      Impl::PendingWrite{
+          expiryTime,
+          std::time(nullptr),
+          url,
+          requestMethod,
+          requestHeaders,
+          statusCode,
+          responseHeaders,
+          responseDataCodec == RESPONSE_DATA_CODEC_NONE
+              ? std::vector<std::byte>(responseData.begin(), responseData.end())
+              : std::move(encodedData),
+          responseDataCodec});
+
+  if (this->_pImpl->_pendingWrites.size() >= this->_pImpl->_writeBatchSize ||
+      now - this->_pImpl->_oldestPendingWrite >=
+          this->_pImpl->_writeBatchInterval) {
+    return this->flushPendingWrites();
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_int64)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      2,
-      static_cast<int64_t>(std::time(nullptr)));
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
-  }
+  return true;
+}
 
-  std::string responseHeaderString = convertHeadersToString(responseHeaders);
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      3,
-      responseHeaderString.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
-  }
+bool SqliteCache::flush() {
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::flush");
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  return this->flushPendingWrites();
+}
 
-  status = CESIUM_SQLITE(sqlite3_bind_int)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      4,
-      static_cast<int>(statusCode));
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+bool SqliteCache::flushPendingWrites() {
+  if (this->_pImpl->_pendingWrites.empty()) {
+    return true;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_blob)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      5,
-      responseData.data(),
-      static_cast<int>(responseData.size()),
-      SQLITE_STATIC);
+  // Take the pending writes first, because a corrupt database is destroyed and
+  // recreated along with its Impl.
+  std::unordered_map<std::string, Impl::PendingWrite> pendingWrites =
+      std::move(this->_pImpl->_pendingWrites);
+  this->_pImpl->_pendingWrites.clear();
+
+  CESIUM_SQLITE(sqlite3*) pConnection = this->_pImpl->_pConnection.get();
+  char* beginError = nullptr;
+  int status = CESIUM_SQLITE(sqlite3_exec)(
+      pConnection,
+      BEGIN_TRANSACTION_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &beginError);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
+    SPDLOG_LOGGER_ERROR(this->_pImpl->_pLogger, beginError);
+    CESIUM_SQLITE(sqlite3_free)(beginError);
     return false;
   }
 
-  std::string requestHeaderString = convertHeadersToString(requestHeaders);
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      6,
-      requestHeaderString.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+  for (const auto& [key, pending] : pendingWrites) {
+    status = this->_pImpl->writeEntry(
+        key,
+        pending.expiryTime,
+        pending.storeTime,
+        pending.url,
+        pending.requestMethod,
+        pending.requestHeaders,
+        pending.statusCode,
+        pending.responseHeaders,
+        pending.responseData,
+        pending.responseDataCodec);
+    if (status != SQLITE_DONE) {
+      this->_pImpl->_totalItems.reset();
+      CESIUM_SQLITE(sqlite3_exec)(
+          pConnection,
+          ROLLBACK_TRANSACTION_SQL.c_str(),
+          nullptr,
+          nullptr,
+          nullptr);
+      if (status == SQLITE_CORRUPT) {
+        destroyDatabase();
+      }
+      return false;
+    }
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      7,
-      requestMethod.c_str(),
-      -1,
-      SQLITE_STATIC);
+  char* commitError = nullptr;
+  status = CESIUM_SQLITE(sqlite3_exec)(
+      pConnection,
+      COMMIT_TRANSACTION_SQL.c_str(),
+      nullptr,
+      nullptr,
+      &commitError);
   if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
+    SPDLOG_LOGGER_ERROR(this->_pImpl->_pLogger, commitError);
+    CESIUM_SQLITE(sqlite3_free)(commitError);
+    // The rolled-back rows may have been counted.
+    this->_pImpl->_totalItems.reset();
+    CESIUM_SQLITE(sqlite3_exec)(
+        pConnection,
+        ROLLBACK_TRANSACTION_SQL.c_str(),
+        nullptr,
+        nullptr,
+        nullptr);
     return false;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      8,
-      url.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
-  }
+  return true;
+}
 
-  status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      9,
-      key.c_str(),
-      -1,
-      SQLITE_STATIC);
-  if (status != SQLITE_OK) {
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
-  }
+size_t SqliteCache::storeEntries(const std::vector<CacheEntry>& entries) {
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::storeEntries");
+
+  const std::time_t storeTime = std::time(nullptr);
+  size_t storedEntries = 0;
+
+  // Each batch is written in its own transaction, and the lock is released
+  // between batches so that cache lookups and stores are not stalled while a
+  // large import runs.
+  while (storedEntries < entries.size()) {
+    const size_t batchEnd =
+        std::min(entries.size(), storedEntries + IMPORT_BATCH_SIZE);
+
+    // Compress the batch before taking the lock.
+    std::vector<int> codecs(batchEnd - storedEntries);
+    std::vector<std::vector<std::byte>> encodedData(codecs.size());
+    for (size_t i = storedEntries; i < batchEnd; ++i) {
+      const CacheResponse& response = entries[i].item.cacheResponse;
+      codecs[i - storedEntries] = encodeResponseData(
+          this->_pImpl->_compression,
+          response.headers,
+          response.data,
+          encodedData[i - storedEntries]);
+    }
 
-  status = CESIUM_SQLITE(sqlite3_step)(
-      this->_pImpl->_storeResponseStmtWrapper.get());
-  if (status != SQLITE_DONE) {
-    if (status == SQLITE_CORRUPT) {
-      destroyDatabase();
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+
+    // Write the pending entries first, so that they don't replace the
+    // imported ones later.
+    if (!this->flushPendingWrites()) {
+      return storedEntries;
     }
-    SPDLOG_LOGGER_ERROR(
-        this->_pImpl->_pLogger,
-        CESIUM_SQLITE(sqlite3_errstr)(status));
-    return false;
+
+    if (this->_pImpl->executeSql(BEGIN_TRANSACTION_SQL) != SQLITE_OK) {
+      return storedEntries;
+    }
+
+    for (size_t i = storedEntries; i < batchEnd; ++i) {
+      const CacheEntry& entry = entries[i];
+      const int codec = codecs[i - storedEntries];
+      const int status = this->_pImpl->writeEntry(
+          entry.key,
+          entry.item.expiryTime,
+          storeTime,
+          entry.item.cacheRequest.url,
+          entry.item.cacheRequest.method,
+          entry.item.cacheRequest.headers,
+          entry.item.cacheResponse.statusCode,
+          entry.item.cacheResponse.headers,
+          codec == RESPONSE_DATA_CODEC_NONE
+              ? gsl::span<const std::byte>(entry.item.cacheResponse.data)
+              : gsl::span<const std::byte>(encodedData[i - storedEntries]),
+          codec);
+      if (status != SQLITE_DONE) {
+        this->_pImpl->_totalItems.reset();
+        this->_pImpl->executeSql(ROLLBACK_TRANSACTION_SQL);
+        if (status == SQLITE_CORRUPT) {
+          destroyDatabase();
+        }
+        return storedEntries;
+      }
+    }
+
+    if (this->_pImpl->executeSql(COMMIT_TRANSACTION_SQL) != SQLITE_OK) {
+      // The rolled-back rows may have been counted.
+      this->_pImpl->_totalItems.reset();
+      this->_pImpl->executeSql(ROLLBACK_TRANSACTION_SQL);
+      return storedEntries;
+    }
+
+    storedEntries = batchEnd;
   }
 
-  return true;
+  return storedEntries;
 }
 
-bool SqliteCache::prune() {
-  CESIUM_TRACE("SqliteCache::prune");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+bool SqliteCache::exportEntries(
+    const std::function<bool(CacheEntry&& entry)>& callback) {
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::exportEntries");
 
-  int64_t totalItems = 0;
-
-  // query total size of response's data
   {
-    int totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_reset)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
-    if (totalItemsQueryStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    if (!this->flushPendingWrites()) {
       return false;
     }
+  }
 
-    totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
-    if (totalItemsQueryStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
-      return false;
-    }
+  // Row IDs start at 1.
+  int64_t lastRowId = 0;
+  while (true) {
+    std::vector<CacheEntry> chunk;
+    int64_t rowsRead = 0;
 
-    totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_step)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get());
+    {
+      std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
-    if (totalItemsQueryStatus == SQLITE_DONE) {
-      return true;
+      CESIUM_SQLITE(sqlite3_stmt*) pStatement =
+          this->_pImpl->_exportEntriesStmtWrapper.get();
+      int status = CESIUM_SQLITE(sqlite3_reset)(pStatement);
+      if (status == SQLITE_OK) {
+        status = CESIUM_SQLITE(sqlite3_clear_bindings)(pStatement);
+      }
+      if (status == SQLITE_OK) {
+        status = CESIUM_SQLITE(sqlite3_bind_int64)(pStatement, 1, lastRowId);
+      }
+      if (status == SQLITE_OK) {
+        status = CESIUM_SQLITE(
+            sqlite3_bind_int64)(pStatement, 2, EXPORT_CHUNK_SIZE);
+      }
+      if (status == SQLITE_OK) {
+        while ((status = CESIUM_SQLITE(sqlite3_step)(pStatement)) ==
+               SQLITE_ROW) {
+          ++rowsRead;
+          lastRowId = CESIUM_SQLITE(sqlite3_column_int64)(pStatement, 0);
+
+          // An entry that can't be read is skipped, as getEntry treats it as
+          // a cache miss.
+          std::optional<CacheItem> maybeItem =
+              this->_pImpl->readEntryColumns(pStatement);
+          if (maybeItem) {
+            chunk.emplace_back(CacheEntry{
+                readTextColumn(pStatement, 9),
+                std::move(*maybeItem)});
+          }
+        }
+      }
+
+      if (status != SQLITE_DONE) {
+        SPDLOG_LOGGER_ERROR(
+            this->_pImpl->_pLogger,
+            CESIUM_SQLITE(sqlite3_errstr)(status));
+        return false;
+      }
     }
 
-    if (totalItemsQueryStatus != SQLITE_ROW) {
-      if (totalItemsQueryStatus == SQLITE_CORRUPT) {
-        destroyDatabase();
+    for (CacheEntry& entry : chunk) {
+      if (!callback(std::move(entry))) {
+        return true;
       }
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(totalItemsQueryStatus));
-      return false;
     }
 
-    // prune the rows if over maximum
-    totalItems = CESIUM_SQLITE(sqlite3_column_int64)(
-        this->_pImpl->_totalItemsQueryStmtWrapper.get(),
-        0);
-    if (totalItems > 0 &&
-        totalItems <= static_cast<int64_t>(this->_pImpl->_maxItems)) {
+    if (rowsRead < EXPORT_CHUNK_SIZE) {
       return true;
     }
   }
+}
 
-  // delete expired rows first
+bool SqliteCache::prune() {
+  CESIUM_TRACE_CATEGORY(Cache, "SqliteCache::prune");
+
+  // Rows are deleted in chunks of at most PRUNE_CHUNK_SIZE, and the lock is
+  // released between chunks so that cache lookups and stores are not stalled
+  // while a large cache is pruned.
   {
-    int deleteExpiredStatus = CESIUM_SQLITE(sqlite3_reset)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
-    }
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
+    // Count and evict the pending entries along with the rest.
+    if (!this->flushPendingWrites()) {
       return false;
     }
 
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_step)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_DONE) {
-      if (deleteExpiredStatus == SQLITE_CORRUPT) {
-        destroyDatabase();
+    if (!this->_pImpl->_totalItems) {
+      const int status = this->_pImpl->runStatement(
+          this->_pImpl->_totalItemsQueryStmtWrapper.get());
+      if (status == SQLITE_DONE) {
+        return true;
+      }
+      if (status != SQLITE_ROW) {
+        if (status == SQLITE_CORRUPT) {
+          destroyDatabase();
+        }
+        return false;
       }
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
-    }
-  }
 
-  // check if we should delete more
-  const int deletedRows =
-      CESIUM_SQLITE(sqlite3_changes)(this->_pImpl->_pConnection.get());
-  if (totalItems - deletedRows < static_cast<int>(this->_pImpl->_maxItems)) {
-    return true;
+      this->_pImpl->_totalItems = CESIUM_SQLITE(sqlite3_column_int64)(
+          this->_pImpl->_totalItemsQueryStmtWrapper.get(),
+          0);
+    }
   }
 
-  totalItems -= deletedRows;
+  // delete expired rows first, then the least recently used rows while we are
+  // still over the maximum
+  bool expiredRemaining = true;
+  while (true) {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
-  // delete rows LRU if we are still over maximum
-  {
-    int deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
+    if (!this->_pImpl->_totalItems) {
+      // The count was lost, such as by a failed write; the next prune will
+      // count again.
+      return true;
     }
 
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
+    const int64_t overLimit = *this->_pImpl->_totalItems -
+                              static_cast<int64_t>(this->_pImpl->_maxItems);
+    if (overLimit <= 0) {
+      return true;
     }
 
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
-        this->_pImpl->_deleteLRUStmtWrapper.get(),
-        1,
-        totalItems - static_cast<int64_t>(this->_pImpl->_maxItems));
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
-    }
+    CESIUM_SQLITE(sqlite3_stmt*) pStatement =
+        expiredRemaining ? this->_pImpl->_deleteExpiredStmtWrapper.get()
+                         : this->_pImpl->_deleteLRUStmtWrapper.get();
+    const int64_t chunkSize = expiredRemaining
+                                  ? PRUNE_CHUNK_SIZE
+                                  : std::min(overLimit, PRUNE_CHUNK_SIZE);
 
-    deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_DONE) {
-      if (deleteLLRUStatus == SQLITE_CORRUPT) {
+    const int status = this->_pImpl->runStatement(pStatement, chunkSize);
+    if (status != SQLITE_DONE) {
+      if (status == SQLITE_CORRUPT) {
         destroyDatabase();
       }
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
       return false;
     }
-  }
 
-  return true;
+    const int deletedRows =
+        CESIUM_SQLITE(sqlite3_changes)(this->_pImpl->_pConnection.get());
+    *this->_pImpl->_totalItems -= deletedRows;
+
+    if (deletedRows < chunkSize) {
+      if (!expiredRemaining) {
+        // The table is empty.
+        return true;
+      }
+      expiredRemaining = false;
+    }
+  }
 }
 
 bool SqliteCache::clearAll() {
   std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
+  this->_pImpl->_pendingWrites.clear();
+
   int status =
       CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_clearAllStmtWrapper.get());
   if (status != SQLITE_OK) {
@@ -779,6 +1612,7 @@ bool SqliteCache::clearAll() {
     return false;
   }
 
+  this->_pImpl->_totalItems = 0;
   return true;
 }
 
@@ -786,8 +1620,21 @@ void SqliteCache::destroyDatabase() {
   std::shared_ptr<spdlog::logger> pLogger = _pImpl->_pLogger;
   std::string databaseName = _pImpl->_databaseName;
   uint64_t maxItems = _pImpl->_maxItems;
+  uint32_t writeBatchSize = _pImpl->_writeBatchSize;
+  std::chrono::milliseconds writeBatchInterval = _pImpl->_writeBatchInterval;
+  uint32_t readConnectionCount = _pImpl->_readConnectionCount;
+  SqliteCacheCompression compression = _pImpl->_compression;
+  uint64_t mmapSize = _pImpl->_mmapSize;
   _pImpl.reset();
-  _pImpl = std::make_unique<Impl>(pLogger, databaseName, maxItems);
+  _pImpl = std::make_unique<Impl>(
+      pLogger,
+      databaseName,
+      maxItems,
+      writeBatchSize,
+      writeBatchInterval,
+      readConnectionCount,
+      compression,
+      mmapSize);
   if (remove(_pImpl->_databaseName.c_str()) != 0) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
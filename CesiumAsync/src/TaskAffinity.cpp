@@ -0,0 +1,27 @@
+#include "CesiumAsync/TaskAffinity.h"
+
+namespace CesiumAsync {
+
+namespace {
+
+uint64_t& currentTaskAffinity() noexcept {
+  // A static local rather than a namespace-scope thread_local, for the same
+  // reason as in ImmediateScheduler.
+  static thread_local uint64_t key = 0;
+  return key;
+}
+
+} // namespace
+
+uint64_t getCurrentTaskAffinity() noexcept { return currentTaskAffinity(); }
+
+ScopedTaskAffinity::ScopedTaskAffinity(uint64_t key) noexcept
+    : _previous(currentTaskAffinity()) {
+  currentTaskAffinity() = key;
+}
+
+ScopedTaskAffinity::~ScopedTaskAffinity() noexcept {
+  currentTaskAffinity() = this->_previous;
+}
+
+} // namespace CesiumAsync
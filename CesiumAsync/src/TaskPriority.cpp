@@ -0,0 +1,27 @@
+#include "CesiumAsync/TaskPriority.h"
+
+namespace CesiumAsync {
+
+namespace {
+
+TaskPriority& currentTaskPriority() noexcept {
+  // A static local rather than a namespace-scope thread_local, for the same
+  // reason as in ImmediateScheduler.
+  static thread_local TaskPriority priority = TaskPriority::Normal;
+  return priority;
+}
+
+} // namespace
+
+TaskPriority getCurrentTaskPriority() noexcept { return currentTaskPriority(); }
+
+ScopedTaskPriority::ScopedTaskPriority(TaskPriority priority) noexcept
+    : _previous(currentTaskPriority()) {
+  currentTaskPriority() = priority;
+}
+
+ScopedTaskPriority::~ScopedTaskPriority() noexcept {
+  currentTaskPriority() = this->_previous;
+}
+
+} // namespace CesiumAsync
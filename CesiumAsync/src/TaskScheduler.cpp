@@ -6,22 +6,51 @@ TaskScheduler::TaskScheduler(
     const std::shared_ptr<CesiumAsync::ITaskProcessor>& pTaskProcessor)
     : _pTaskProcessor(pTaskProcessor) {}
 
-void TaskScheduler::schedule(async::task_run_handle t) {
+void TaskScheduler::schedule(
+    async::task_run_handle t,
+    CesiumAsync::TaskPriority priority) {
   // std::function must be copyable, so we can't put a move-only
   // task_run_handle in the capture list of a lambda we want to use with it.
-  // So, we wrap it with a copyable type (shared_ptr).
-  // https://riptutorial.com/cplusplus/example/1950/generalized-capture has
-  // a good explanation of this problem.
+  // Instead of wrapping the handle in a heap-allocated, copyable shared_ptr,
+  // we pass it through as the raw pointer it holds. Together with the lane,
+  // that keeps the capture small and trivially copyable, so std::function
+  // stores it inline rather than allocating. The task is only released when
+  // it runs, so a task processor must eventually run every task it starts.
+  Lane* pLane = &this->lane(priority);
+  void* pTask = t.to_void_ptr();
 
-  struct Receiver {
-    async::task_run_handle taskHandle;
-  };
+  this->_pTaskProcessor->startTaskWithPriority(
+      [pLane, pTask]() {
+        TaskScheduler& scheduler = *pLane->_pParent;
 
-  std::shared_ptr<Receiver> pReceiver = std::make_shared<Receiver>();
-  pReceiver->taskHandle = std::move(t);
+        // Any worker thread is suitable for every priority, so continuations
+        // of any priority may run immediately from here. Work created by this
+        // task inherits its priority.
+        auto lowScope = scheduler._low.immediate.scope();
+        auto normalScope = scheduler._normal.immediate.scope();
+        auto highScope = scheduler._high.immediate.scope();
+        CesiumAsync::ScopedTaskPriority priorityScope(pLane->_priority);
+        async::task_run_handle::from_void_ptr(pTask).run();
+      },
+      priority);
+}
+
+TaskScheduler::Lane& TaskScheduler::lane(TaskPriority priority) noexcept {
+  switch (priority) {
+  case CesiumAsync::TaskPriority::Low:
+    return this->_low;
+  case CesiumAsync::TaskPriority::High:
+    return this->_high;
+  case CesiumAsync::TaskPriority::Normal:
+  default:
+    return this->_normal;
+  }
+}
+
+ImmediateScheduler<TaskScheduler::Lane>& TaskScheduler::immediate() noexcept {
+  return this->lane(CesiumAsync::getCurrentTaskPriority()).immediate;
+}
 
-  this->_pTaskProcessor->startTask([this, pReceiver]() mutable {
-    auto scope = this->immediate.scope();
-    pReceiver->taskHandle.run();
-  });
+TaskScheduler::Lane& TaskScheduler::deferred() noexcept {
+  return this->lane(CesiumAsync::getCurrentTaskPriority());
 }
@@ -0,0 +1,142 @@
+#include "CesiumAsync/ThroughputMeasuringAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/NetworkThroughputEstimator.h"
+
+#include <stdexcept>
+
+namespace CesiumAsync {
+
+ThroughputMeasuringAssetAccessor::ThroughputMeasuringAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<NetworkThroughputEstimator>& pEstimator)
+    : _pAssetAccessor(pAssetAccessor), _pEstimator(pEstimator) {}
+
+ThroughputMeasuringAssetAccessor::~ThroughputMeasuringAssetAccessor() noexcept {
+}
+
+Future<std::shared_ptr<IAssetRequest>> ThroughputMeasuringAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  const NetworkThroughputEstimator::Clock::time_point startTime =
+      this->startRequest();
+  return this->measure(
+      startTime,
+      this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+ThroughputMeasuringAssetAccessor::getWithCancellation(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const CancellationToken& cancellationToken) {
+  const NetworkThroughputEstimator::Clock::time_point startTime =
+      this->startRequest();
+  return this->measure(
+      startTime,
+      this->_pAssetAccessor->getWithCancellation(
+          asyncSystem,
+          url,
+          headers,
+          cancellationToken));
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+ThroughputMeasuringAssetAccessor::getWithOptions(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const AssetRequestOptions& options) {
+  const NetworkThroughputEstimator::Clock::time_point startTime =
+      this->startRequest();
+  return this->measure(
+      startTime,
+      this->_pAssetAccessor
+          ->getWithOptions(asyncSystem, url, headers, options));
+}
+
+std::vector<Future<std::shared_ptr<IAssetRequest>>>
+ThroughputMeasuringAssetAccessor::getBatch(
+    const AsyncSystem& asyncSystem,
+    const std::vector<std::string>& urls,
+    const std::vector<THeader>& headers) {
+  std::vector<NetworkThroughputEstimator::Clock::time_point> startTimes;
+  startTimes.reserve(urls.size());
+  for (size_t i = 0; i < urls.size(); ++i) {
+    startTimes.emplace_back(this->startRequest());
+  }
+
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> requests =
+      this->_pAssetAccessor->getBatch(asyncSystem, urls, headers);
+
+  std::vector<Future<std::shared_ptr<IAssetRequest>>> result;
+  result.reserve(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    result.emplace_back(this->measure(startTimes[i], std::move(requests[i])));
+  }
+  return result;
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+ThroughputMeasuringAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  const NetworkThroughputEstimator::Clock::time_point startTime =
+      this->startRequest();
+  return this->measure(
+      startTime,
+      this->_pAssetAccessor->request(
+          asyncSystem,
+          verb,
+          url,
+          headers,
+          contentPayload));
+}
+
+void ThroughputMeasuringAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+NetworkThroughputEstimator::Clock::time_point
+ThroughputMeasuringAssetAccessor::startRequest() noexcept {
+  const NetworkThroughputEstimator::Clock::time_point startTime =
+      NetworkThroughputEstimator::Clock::now();
+  this->_pEstimator->notifyRequestStarted(startTime);
+  return startTime;
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+ThroughputMeasuringAssetAccessor::measure(
+    NetworkThroughputEstimator::Clock::time_point startTime,
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  // The estimator is shared with the continuations, so requests that complete
+  // after this accessor is destroyed are still safe to report.
+  return std::move(future)
+      .thenImmediately([pEstimator = this->_pEstimator, startTime](
+                           std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+        const IAssetResponse* pResponse =
+            pCompletedRequest ? pCompletedRequest->response() : nullptr;
+        pEstimator->notifyRequestFinished(
+            startTime,
+            NetworkThroughputEstimator::Clock::now(),
+            pResponse ? pResponse->data().size() : 0);
+        return std::move(pCompletedRequest);
+      })
+      .catchImmediately([pEstimator = this->_pEstimator, startTime](
+                            std::exception&& e)
+                            -> std::shared_ptr<IAssetRequest> {
+        pEstimator->notifyRequestFinished(
+            startTime,
+            NetworkThroughputEstimator::Clock::now(),
+            0);
+        throw std::runtime_error(e.what());
+      });
+}
+
+} // namespace CesiumAsync
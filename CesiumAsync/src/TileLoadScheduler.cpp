@@ -0,0 +1,44 @@
+#include "CesiumAsync/TileLoadScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CesiumAsync {
+
+TileLoadScheduler::TileLoadScheduler(
+    uint32_t maximumSimultaneousLoads,
+    uint32_t reservedLoads) noexcept
+    : _maximumSimultaneousLoads(maximumSimultaneousLoads),
+      _reservedLoads(reservedLoads),
+      _loadsInProgress(0) {}
+
+bool TileLoadScheduler::canStartLoad(Priority priority) const noexcept {
+  uint32_t reserved = 0;
+  switch (priority) {
+  case Priority::Urgent:
+    reserved = 0;
+    break;
+  case Priority::Normal:
+    reserved = this->_reservedLoads;
+    break;
+  case Priority::Preload:
+    reserved = 2 * this->_reservedLoads;
+    break;
+  }
+
+  const uint32_t maximum = this->_maximumSimultaneousLoads;
+  const uint32_t limit =
+      std::max(maximum > reserved ? maximum - reserved : 0U, 1U);
+  return this->_loadsInProgress < limit;
+}
+
+void TileLoadScheduler::notifyLoadStarted() noexcept {
+  ++this->_loadsInProgress;
+}
+
+void TileLoadScheduler::notifyLoadFinished() noexcept {
+  assert(this->_loadsInProgress > 0 && "There are no loads in progress");
+  --this->_loadsInProgress;
+}
+
+} // namespace CesiumAsync
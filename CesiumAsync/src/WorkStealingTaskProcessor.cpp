@@ -0,0 +1,194 @@
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CesiumAsync {
+
+namespace {
+
+constexpr size_t PRIORITY_COUNT = 3;
+
+size_t laneIndex(TaskPriority priority) noexcept {
+  return std::min(static_cast<size_t>(priority), PRIORITY_COUNT - 1);
+}
+
+struct TaskQueue {
+  std::mutex mutex;
+  std::array<std::deque<std::function<void()>>, PRIORITY_COUNT> lanes;
+};
+
+// The processor and queue index of the pool thread that is running on the
+// current thread, if any.
+struct CurrentWorker {
+  const void* pOwner = nullptr;
+  size_t index = 0;
+};
+
+CurrentWorker& currentWorker() noexcept {
+  static thread_local CurrentWorker worker;
+  return worker;
+}
+
+} // namespace
+
+struct WorkStealingTaskProcessor::Impl {
+  explicit Impl(uint32_t numberOfThreads) : queues(numberOfThreads) {
+    for (std::unique_ptr<TaskQueue>& pQueue : this->queues) {
+      pQueue = std::make_unique<TaskQueue>();
+    }
+
+    this->threads.reserve(numberOfThreads);
+    for (uint32_t i = 0; i < numberOfThreads; ++i) {
+      this->threads.emplace_back([this, i]() { this->run(i); });
+    }
+  }
+
+  ~Impl() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(this->sleepMutex);
+      this->stopping = true;
+    }
+    this->wake.notify_all();
+
+    for (std::thread& thread : this->threads) {
+      thread.join();
+    }
+  }
+
+  void push(std::function<void()>&& f, TaskPriority priority) {
+    const CurrentWorker& worker = currentWorker();
+    TaskQueue& queue = worker.pOwner == this ? *this->queues[worker.index]
+                                             : this->injected;
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.lanes[laneIndex(priority)].push_back(std::move(f));
+    }
+
+    {
+      // Incremented under the lock so that a thread that just found no work
+      // can't miss the notification.
+      std::lock_guard<std::mutex> lock(this->sleepMutex);
+      ++this->pending;
+    }
+    this->wake.notify_one();
+  }
+
+  bool tryPop(size_t self, std::function<void()>& task) {
+    for (size_t lane = PRIORITY_COUNT; lane > 0; --lane) {
+      // Newest first from our own queue.
+      if (popFrom(*this->queues[self], lane - 1, true, task)) {
+        return true;
+      }
+
+      // Oldest first from everyone else's.
+      if (popFrom(this->injected, lane - 1, false, task)) {
+        return true;
+      }
+
+      const size_t count = this->queues.size();
+      for (size_t i = 1; i < count; ++i) {
+        if (popFrom(
+                *this->queues[(self + i) % count],
+                lane - 1,
+                false,
+                task)) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  static bool popFrom(
+      TaskQueue& queue,
+      size_t lane,
+      bool newest,
+      std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    std::deque<std::function<void()>>& tasks = queue.lanes[lane];
+    if (tasks.empty()) {
+      return false;
+    }
+
+    if (newest) {
+      task = std::move(tasks.back());
+      tasks.pop_back();
+    } else {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+
+    return true;
+  }
+
+  void run(size_t index) {
+    CurrentWorker& worker = currentWorker();
+    worker.pOwner = this;
+    worker.index = index;
+
+    std::function<void()> task;
+    while (true) {
+      if (this->tryPop(index, task)) {
+        --this->pending;
+        task();
+        task = nullptr;
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(this->sleepMutex);
+      this->wake.wait(lock, [this]() {
+        return this->stopping || this->pending > 0;
+      });
+      if (this->stopping && this->pending <= 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+  TaskQueue injected;
+  std::vector<std::thread> threads;
+
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+
+  // The number of queued tasks. It can be briefly negative, because a task is
+  // counted after it is queued.
+  std::atomic<int64_t> pending{0};
+  bool stopping = false;
+};
+
+WorkStealingTaskProcessor::WorkStealingTaskProcessor(uint32_t numberOfThreads)
+    : _pImpl() {
+  if (numberOfThreads == 0) {
+    numberOfThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  this->_pImpl = std::make_unique<Impl>(numberOfThreads);
+}
+
+WorkStealingTaskProcessor::~WorkStealingTaskProcessor() noexcept = default;
+
+void WorkStealingTaskProcessor::startTask(std::function<void()> f) {
+  this->_pImpl->push(std::move(f), TaskPriority::Normal);
+}
+
+void WorkStealingTaskProcessor::startTaskWithPriority(
+    std::function<void()> f,
+    TaskPriority priority) {
+  this->_pImpl->push(std::move(f), priority);
+}
+
+uint32_t WorkStealingTaskProcessor::getNumberOfThreads() const noexcept {
+  return static_cast<uint32_t>(this->_pImpl->threads.size());
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,262 @@
+#include "ZipArchive.h"
+
+#include <CesiumUtility/Gunzip.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace CesiumAsync {
+
+namespace {
+
+template <typename T>
+bool readLittleEndian(
+    const gsl::span<const std::byte>& data,
+    uint64_t offset,
+    T& value) {
+  if (offset > data.size() || data.size() - offset < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return true;
+}
+
+const uint32_t endOfCentralDirectorySignature = 0x06054b50;
+const uint32_t zip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+const uint32_t zip64EndOfCentralDirectorySignature = 0x06064b50;
+const uint32_t centralDirectoryHeaderSignature = 0x02014b50;
+const uint32_t localFileHeaderSignature = 0x04034b50;
+
+const uint16_t storedCompressionMethod = 0;
+const uint16_t deflateCompressionMethod = 8;
+
+} // namespace
+
+std::optional<ZipCentralDirectoryLocation> findZipCentralDirectory(
+    const gsl::span<const std::byte>& tail,
+    uint64_t tailOffset) {
+  const size_t endRecordSize = 22;
+  if (tail.size() < endRecordSize) {
+    return std::nullopt;
+  }
+
+  // The end of central directory record is followed by a comment of at most
+  // 65535 bytes, so search backwards for its signature.
+  const size_t searchEnd =
+      tail.size() > endRecordSize + 0xFFFF ? tail.size() - endRecordSize - 0xFFFF
+                                           : 0;
+  std::optional<size_t> endRecordOffset;
+  for (size_t offset = tail.size() - endRecordSize + 1; offset-- > searchEnd;) {
+    uint32_t signature = 0;
+    readLittleEndian(tail, offset, signature);
+    if (signature == endOfCentralDirectorySignature) {
+      endRecordOffset = offset;
+      break;
+    }
+  }
+
+  if (!endRecordOffset) {
+    return std::nullopt;
+  }
+
+  uint16_t entryCount16 = 0;
+  uint32_t directorySize32 = 0;
+  uint32_t directoryOffset32 = 0;
+  readLittleEndian(tail, *endRecordOffset + 10, entryCount16);
+  readLittleEndian(tail, *endRecordOffset + 12, directorySize32);
+  readLittleEndian(tail, *endRecordOffset + 16, directoryOffset32);
+
+  ZipCentralDirectoryLocation location{};
+  location.offset = directoryOffset32;
+  location.size = directorySize32;
+  location.entryCount = entryCount16;
+
+  // The zip64 end of central directory record is located by its offset in
+  // the archive, and is usually just before the locator.
+  uint32_t locatorSignature = 0;
+  if (*endRecordOffset >= 20 &&
+      readLittleEndian(tail, *endRecordOffset - 20, locatorSignature) &&
+      locatorSignature == zip64EndOfCentralDirectoryLocatorSignature) {
+    uint64_t zip64RecordOffset = 0;
+    uint32_t zip64Signature = 0;
+    if (!readLittleEndian(tail, *endRecordOffset - 12, zip64RecordOffset) ||
+        zip64RecordOffset < tailOffset) {
+      return std::nullopt;
+    }
+
+    zip64RecordOffset -= tailOffset;
+    if (!readLittleEndian(tail, zip64RecordOffset, zip64Signature) ||
+        zip64Signature != zip64EndOfCentralDirectorySignature ||
+        !readLittleEndian(tail, zip64RecordOffset + 32, location.entryCount) ||
+        !readLittleEndian(tail, zip64RecordOffset + 40, location.size) ||
+        !readLittleEndian(tail, zip64RecordOffset + 48, location.offset)) {
+      return std::nullopt;
+    }
+  }
+
+  return location;
+}
+
+std::optional<std::unordered_map<std::string, ZipEntry>>
+readZipCentralDirectoryEntries(
+    const gsl::span<const std::byte>& directory,
+    uint64_t entryCount) {
+  std::unordered_map<std::string, ZipEntry> entries;
+  entries.reserve(static_cast<size_t>(
+      std::min(entryCount, uint64_t(directory.size() / 46))));
+
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < entryCount; ++i) {
+    uint32_t signature = 0;
+    ZipEntry entry{};
+    uint32_t compressedSize32 = 0;
+    uint32_t uncompressedSize32 = 0;
+    uint32_t localHeaderOffset32 = 0;
+    uint16_t nameLength = 0;
+    uint16_t extraLength = 0;
+    uint16_t commentLength = 0;
+    if (!readLittleEndian(directory, offset, signature) ||
+        signature != centralDirectoryHeaderSignature ||
+        !readLittleEndian(directory, offset + 10, entry.compressionMethod) ||
+        !readLittleEndian(directory, offset + 20, compressedSize32) ||
+        !readLittleEndian(directory, offset + 24, uncompressedSize32) ||
+        !readLittleEndian(directory, offset + 28, nameLength) ||
+        !readLittleEndian(directory, offset + 30, extraLength) ||
+        !readLittleEndian(directory, offset + 32, commentLength) ||
+        !readLittleEndian(directory, offset + 42, localHeaderOffset32)) {
+      return std::nullopt;
+    }
+
+    const uint64_t nameOffset = offset + 46;
+    if (nameOffset + nameLength + extraLength > directory.size()) {
+      return std::nullopt;
+    }
+
+    entry.compressedSize = compressedSize32;
+    entry.uncompressedSize = uncompressedSize32;
+    entry.localHeaderOffset = localHeaderOffset32;
+
+    // Values that do not fit in 32 bits are stored in the zip64 extra field,
+    // in this order, and only if the 32-bit field is saturated.
+    uint64_t extraOffset = nameOffset + nameLength;
+    const uint64_t extraEnd = extraOffset + extraLength;
+    while (extraOffset + 4 <= extraEnd) {
+      uint16_t headerId = 0;
+      uint16_t fieldSize = 0;
+      readLittleEndian(directory, extraOffset, headerId);
+      readLittleEndian(directory, extraOffset + 2, fieldSize);
+      if (headerId == 0x0001) {
+        uint64_t valueOffset = extraOffset + 4;
+        if (uncompressedSize32 == 0xFFFFFFFF) {
+          readLittleEndian(directory, valueOffset, entry.uncompressedSize);
+          valueOffset += 8;
+        }
+        if (compressedSize32 == 0xFFFFFFFF) {
+          readLittleEndian(directory, valueOffset, entry.compressedSize);
+          valueOffset += 8;
+        }
+        if (localHeaderOffset32 == 0xFFFFFFFF) {
+          readLittleEndian(directory, valueOffset, entry.localHeaderOffset);
+        }
+        break;
+      }
+      extraOffset += 4 + uint64_t(fieldSize);
+    }
+
+    entries.emplace(
+        std::string(
+            reinterpret_cast<const char*>(directory.data() + nameOffset),
+            nameLength),
+        entry);
+
+    offset = extraEnd + commentLength;
+  }
+
+  return entries;
+}
+
+std::optional<std::unordered_map<std::string, ZipEntry>>
+readZipCentralDirectory(const gsl::span<const std::byte>& data) {
+  std::optional<ZipCentralDirectoryLocation> maybeLocation =
+      findZipCentralDirectory(data, 0);
+  if (!maybeLocation || maybeLocation->offset > data.size()) {
+    return std::nullopt;
+  }
+
+  return readZipCentralDirectoryEntries(
+      data.subspan(static_cast<size_t>(maybeLocation->offset)),
+      maybeLocation->entryCount);
+}
+
+std::optional<uint64_t>
+getZipEntryDataOffset(const gsl::span<const std::byte>& localHeader) {
+  uint32_t signature = 0;
+  uint16_t nameLength = 0;
+  uint16_t extraLength = 0;
+  if (!readLittleEndian(localHeader, 0, signature) ||
+      signature != localFileHeaderSignature ||
+      !readLittleEndian(localHeader, 26, nameLength) ||
+      !readLittleEndian(localHeader, 28, extraLength)) {
+    return std::nullopt;
+  }
+
+  return zipLocalFileHeaderSize + nameLength + extraLength;
+}
+
+std::optional<gsl::span<const std::byte>> getZipEntryData(
+    const gsl::span<const std::byte>& data,
+    uint64_t dataOffset,
+    const ZipEntry& entry) {
+  if (entry.localHeaderOffset < dataOffset ||
+      entry.localHeaderOffset - dataOffset > data.size()) {
+    return std::nullopt;
+  }
+
+  const uint64_t headerOffset = entry.localHeaderOffset - dataOffset;
+  std::optional<uint64_t> maybeContentOffset =
+      getZipEntryDataOffset(data.subspan(static_cast<size_t>(headerOffset)));
+  if (!maybeContentOffset) {
+    return std::nullopt;
+  }
+
+  const uint64_t contentOffset = headerOffset + *maybeContentOffset;
+  if (contentOffset > data.size() ||
+      data.size() - contentOffset < entry.compressedSize) {
+    return std::nullopt;
+  }
+
+  return data.subspan(
+      static_cast<size_t>(contentOffset),
+      static_cast<size_t>(entry.compressedSize));
+}
+
+bool inflateZipEntry(
+    const gsl::span<const std::byte>& compressed,
+    const ZipEntry& entry,
+    std::vector<std::byte>& out) {
+  return entry.compressionMethod == deflateCompressionMethod &&
+         CesiumUtility::inflateRaw(compressed, out);
+}
+
+bool isZipEntryStored(const ZipEntry& entry) noexcept {
+  return entry.compressionMethod == storedCompressionMethod;
+}
+
+std::string percentDecode(const std::string& s) {
+  std::string result;
+  result.reserve(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size() &&
+        std::isxdigit(static_cast<unsigned char>(s[i + 1])) &&
+        std::isxdigit(static_cast<unsigned char>(s[i + 2]))) {
+      result += static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else {
+      result += s[i];
+    }
+  }
+  return result;
+}
+
+} // namespace CesiumAsync
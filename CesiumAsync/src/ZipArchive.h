@@ -0,0 +1,135 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The location of one entry of a zip archive.
+ */
+struct ZipEntry {
+  uint16_t compressionMethod;
+  uint64_t compressedSize;
+  uint64_t uncompressedSize;
+  uint64_t localHeaderOffset;
+};
+
+/**
+ * @brief The location of the central directory of a zip archive.
+ */
+struct ZipCentralDirectoryLocation {
+  uint64_t offset;
+  uint64_t size;
+  uint64_t entryCount;
+};
+
+/**
+ * @brief The number of bytes at the end of a zip archive that always contain
+ * its end of central directory record: the record itself, the longest
+ * possible comment, and the zip64 locator that may precede it.
+ */
+const uint64_t zipEndOfCentralDirectorySearchSize = 22 + 0xFFFF + 20;
+
+/**
+ * @brief The size of the fixed part of the local header of a zip entry, which
+ * is followed by the name and extra field of the entry.
+ */
+const uint64_t zipLocalFileHeaderSize = 30;
+
+/**
+ * @brief Finds the central directory of a zip archive from the end of the
+ * archive, including archives using the zip64 extensions that are needed for
+ * archives over 4 GB.
+ *
+ * @param tail The last bytes of the archive, usually the last
+ * {@link zipEndOfCentralDirectorySearchSize} bytes, or the whole archive.
+ * @param tailOffset The offset of the first byte of the tail in the archive.
+ * @return The location of the central directory, or std::nullopt if the tail
+ * does not end with a valid end of central directory record.
+ */
+std::optional<ZipCentralDirectoryLocation> findZipCentralDirectory(
+    const gsl::span<const std::byte>& tail,
+    uint64_t tailOffset);
+
+/**
+ * @brief Reads the entries of a zip central directory.
+ *
+ * @param directory The central directory, starting with its first header.
+ * @param entryCount The number of entries in the directory.
+ * @return The entries by name, or std::nullopt if the directory is invalid.
+ */
+std::optional<std::unordered_map<std::string, ZipEntry>>
+readZipCentralDirectoryEntries(
+    const gsl::span<const std::byte>& directory,
+    uint64_t entryCount);
+
+/**
+ * @brief Reads the central directory of a complete zip archive.
+ *
+ * @return The entries by name, or std::nullopt if the archive is not a valid
+ * zip archive.
+ */
+std::optional<std::unordered_map<std::string, ZipEntry>>
+readZipCentralDirectory(const gsl::span<const std::byte>& data);
+
+/**
+ * @brief Gets the offset of the contents of an entry from the start of its
+ * local header, which varies with the length of the local extra field.
+ *
+ * @param localHeader The data starting at the local header of the entry. Only
+ * the first {@link zipLocalFileHeaderSize} bytes are needed.
+ * @return The offset, or std::nullopt if the local header is invalid.
+ */
+std::optional<uint64_t>
+getZipEntryDataOffset(const gsl::span<const std::byte>& localHeader);
+
+/**
+ * @brief Gets the contents of an entry within a zip archive, a copy of which
+ * is in memory.
+ *
+ * @param data The archive, or the part of it that starts at the given offset.
+ * @param dataOffset The offset of the first byte of the data in the archive.
+ * @param entry The entry.
+ * @return The entry contents, which may still be compressed, or std::nullopt
+ * if the local header of the entry is invalid or the contents are not within
+ * the data.
+ */
+std::optional<gsl::span<const std::byte>> getZipEntryData(
+    const gsl::span<const std::byte>& data,
+    uint64_t dataOffset,
+    const ZipEntry& entry);
+
+/**
+ * @brief Decompresses the contents of an entry that is deflated.
+ *
+ * Entries that are stored without compression must be used as they are.
+ *
+ * @param compressed The contents of the entry, from {@link getZipEntryData}.
+ * @param entry The entry.
+ * @param out The decompressed contents.
+ * @return True if the entry was decompressed, or false if it uses an
+ * unsupported compression method or is corrupt.
+ */
+bool inflateZipEntry(
+    const gsl::span<const std::byte>& compressed,
+    const ZipEntry& entry,
+    std::vector<std::byte>& out);
+
+/**
+ * @brief Determines whether an entry is stored without compression.
+ */
+bool isZipEntryStored(const ZipEntry& entry) noexcept;
+
+/**
+ * @brief Decodes the percent-encoded octets of a URL path, such as `%20`.
+ */
+std::string percentDecode(const std::string& s);
+
+} // namespace CesiumAsync
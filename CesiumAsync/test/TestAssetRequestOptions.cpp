@@ -0,0 +1,77 @@
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumAsync/AssetRequestOptions.h>
+#include <CesiumAsync/GunzipAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using namespace CesiumAsync;
+
+TEST_CASE("AssetRequestPriority") {
+  SECTION("defaults to the normal urgency") {
+    AssetRequestPriority priority;
+    CHECK(priority.getUrgency() == TaskPriority::Normal);
+    CHECK(priority.getPriority() == 0.0);
+    CHECK(priority.getHttpPriorityHeaderValue() == "u=3");
+  }
+
+  SECTION("can be changed while a request is in progress") {
+    AssetRequestPriority priority(TaskPriority::Low, 10.0);
+    CHECK(priority.getHttpPriorityHeaderValue() == "u=5");
+
+    priority.set(TaskPriority::High, 2.0);
+    CHECK(priority.getUrgency() == TaskPriority::High);
+    CHECK(priority.getPriority() == 2.0);
+    CHECK(priority.getHttpPriorityHeaderValue() == "u=1");
+  }
+}
+
+TEST_CASE("IAssetAccessor::getWithOptions") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  std::shared_ptr<IAssetRequest> pRequest = std::make_shared<MockAssetRequest>(
+      "GET",
+      "https://example.com/tile.glb",
+      HttpHeaders{},
+      std::make_unique<MockAssetResponse>(
+          static_cast<uint16_t>(200),
+          "model/gltf-binary",
+          HttpHeaders{},
+          std::vector<std::byte>{std::byte(1)}));
+
+  AssetRequestOptions options;
+  options.pPriority =
+      std::make_shared<AssetRequestPriority>(TaskPriority::High, 1.0);
+
+  SECTION("falls back to get by default") {
+    MockAssetAccessor accessor(pRequest);
+    std::shared_ptr<IAssetRequest> pCompleted =
+        accessor
+            .getWithOptions(
+                asyncSystem,
+                "https://example.com/tile.glb",
+                {},
+                options)
+            .wait();
+    CHECK(pCompleted == pRequest);
+  }
+
+  SECTION("is forwarded by decorators") {
+    GunzipAssetAccessor accessor(std::make_shared<MockAssetAccessor>(pRequest));
+    std::shared_ptr<IAssetRequest> pCompleted =
+        accessor
+            .getWithOptions(
+                asyncSystem,
+                "https://example.com/tile.glb",
+                {},
+                options)
+            .wait();
+    REQUIRE(pCompleted);
+    REQUIRE(pCompleted->response());
+    CHECK(pCompleted->response()->data().size() == 1);
+  }
+}
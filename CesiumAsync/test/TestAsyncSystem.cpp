@@ -5,6 +5,7 @@
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -36,6 +37,32 @@ TEST_CASE("AsyncSystem") {
     CHECK(executed);
   }
 
+  SECTION("runs I/O tasks with the I/O task processor") {
+    std::shared_ptr<MockTaskProcessor> pIOTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+    AsyncSystem ioAsyncSystem(pTaskProcessor, pIOTaskProcessor);
+
+    int32_t executed = 0;
+    ioAsyncSystem.runInIOThread([&executed]() { ++executed; }).wait();
+    ioAsyncSystem.createResolvedFuture()
+        .thenInIOThread([&executed]() { ++executed; })
+        .wait();
+
+    CHECK(pIOTaskProcessor->tasksStarted == 2);
+    CHECK(pTaskProcessor->tasksStarted == 0);
+    CHECK(executed == 2);
+  }
+
+  SECTION("runs I/O tasks with the task processor when there is no I/O task "
+          "processor") {
+    bool executed = false;
+
+    asyncSystem.runInIOThread([&executed]() { executed = true; }).wait();
+
+    CHECK(pTaskProcessor->tasksStarted == 1);
+    CHECK(executed);
+  }
+
   SECTION("worker continuations are run via the task processor") {
     bool executed = false;
 
@@ -664,4 +691,43 @@ TEST_CASE("AsyncSystem") {
       CHECK(called3);
     }
   }
+
+  SECTION("dispatchMainThreadTasks with a time limit leaves the remaining "
+          "tasks queued") {
+    int32_t count = 0;
+    for (int32_t i = 0; i < 3; ++i) {
+      asyncSystem.runInMainThread([&count]() {
+        using namespace std::chrono_literals;
+        std::this_thread::sleep_for(5ms);
+        ++count;
+      });
+    }
+
+    CHECK(!asyncSystem.dispatchMainThreadTasks(1.0));
+    CHECK(count == 1);
+    CHECK(asyncSystem.dispatchMainThreadTasks(1000.0));
+    CHECK(count == 3);
+  }
+
+  SECTION("main thread tasks are dispatched in priority order") {
+    std::vector<TaskPriority> order;
+    {
+      ScopedTaskPriority low(TaskPriority::Low);
+      asyncSystem.runInMainThread(
+          [&order]() { order.emplace_back(getCurrentTaskPriority()); });
+    }
+    asyncSystem.runInMainThread(
+        [&order]() { order.emplace_back(getCurrentTaskPriority()); });
+    {
+      ScopedTaskPriority high(TaskPriority::High);
+      asyncSystem.runInMainThread(
+          [&order]() { order.emplace_back(getCurrentTaskPriority()); });
+    }
+
+    asyncSystem.dispatchMainThreadTasks();
+    REQUIRE(order.size() == 3);
+    CHECK(order[0] == TaskPriority::High);
+    CHECK(order[1] == TaskPriority::Normal);
+    CHECK(order[2] == TaskPriority::Low);
+  }
 }
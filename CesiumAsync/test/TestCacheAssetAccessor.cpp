@@ -11,8 +11,12 @@
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <cstddef>
+#include <ctime>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 using namespace CesiumAsync;
 
@@ -38,8 +42,9 @@ public:
         clearAllCall{false} {}
 
   virtual std::optional<CacheItem>
-  getEntry(const std::string& /*key*/) const override {
+  getEntry(const std::string& key) const override {
     this->getEntryCall = true;
+    this->getEntryKey = key;
     return this->cacheItem;
   }
 
@@ -76,6 +81,7 @@ public:
   }
 
   mutable bool getEntryCall;
+  mutable std::string getEntryKey;
   bool storeResponseCall;
   bool pruneCall;
   bool clearAllCall;
@@ -84,6 +90,66 @@ public:
   std::optional<CacheItem> cacheItem;
 };
 
+// An asset accessor whose requests do not complete until `complete` is
+// called, so that overlapping requests can be observed.
+class DeferredAssetAccessor : public IAssetAccessor {
+public:
+  DeferredAssetAccessor(const std::shared_ptr<IAssetRequest>& pRequest)
+      : getCount(0), _pRequest(pRequest) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& /* url */,
+      const std::vector<THeader>& /* headers */) override {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    Promise<std::shared_ptr<IAssetRequest>> promise =
+        asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+    this->_promises.emplace_back(promise);
+    ++this->getCount;
+    return promise.getFuture();
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /* contentPayload */) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  // Waits for a request to reach this accessor and then completes the oldest
+  // pending request.
+  void complete() {
+    while (true) {
+      std::optional<Promise<std::shared_ptr<IAssetRequest>>> maybePromise;
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        if (!this->_promises.empty()) {
+          maybePromise = this->_promises.front();
+          this->_promises.erase(this->_promises.begin());
+        }
+      }
+
+      if (maybePromise) {
+        maybePromise->resolve(this->_pRequest);
+        return;
+      }
+
+      std::this_thread::yield();
+    }
+  }
+
+  std::atomic<int32_t> getCount;
+
+private:
+  std::shared_ptr<IAssetRequest> _pRequest;
+  std::mutex _mutex;
+  std::vector<Promise<std::shared_ptr<IAssetRequest>>> _promises;
+};
+
 } // namespace
 
 bool runResponseCacheTest(
@@ -900,3 +966,301 @@ TEST_CASE("Test serving cache item") {
         .wait();
   }
 }
+
+TEST_CASE("Concurrent identical requests are coalesced") {
+  std::shared_ptr<IAssetRequest> pMockRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(200),
+              "app/json",
+              HttpHeaders{},
+              std::vector<std::byte>()));
+
+  auto pDeferredAccessor =
+      std::make_shared<DeferredAssetAccessor>(pMockRequest);
+  std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+      std::make_shared<CachingAssetAccessor>(
+          spdlog::default_logger(),
+          pDeferredAccessor,
+          std::make_unique<MockStoreCacheDatabase>());
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  Future<std::shared_ptr<IAssetRequest>> first =
+      pCachingAccessor->get(asyncSystem, "test.com", {});
+  Future<std::shared_ptr<IAssetRequest>> second =
+      pCachingAccessor->get(asyncSystem, "test.com", {});
+  Future<std::shared_ptr<IAssetRequest>> withHeaders =
+      pCachingAccessor->get(asyncSystem, "test.com", {{"Authorization", "a"}});
+
+  pDeferredAccessor->complete();
+  pDeferredAccessor->complete();
+
+  std::shared_ptr<IAssetRequest> pFirst = first.wait();
+  std::shared_ptr<IAssetRequest> pSecond = second.wait();
+  withHeaders.wait();
+
+  CHECK(pFirst == pSecond);
+  CHECK(pDeferredAccessor->getCount == 2);
+
+  // Once a request completes, a new one is started for the same URL.
+  Future<std::shared_ptr<IAssetRequest>> third =
+      pCachingAccessor->get(asyncSystem, "test.com", {});
+  pDeferredAccessor->complete();
+  third.wait();
+  CHECK(pDeferredAccessor->getCount == 3);
+}
+
+TEST_CASE("Cache keys can leave out query parameters") {
+  const CachingAssetAccessor::CacheKeyFunction tokenKey =
+      CachingAssetAccessor::createCacheKeyFunction();
+
+  CHECK(
+      tokenKey(
+          "https://assets.ion.cesium.com/1/tileset.json?v=1&access_token=abc",
+          {}) == "https://assets.ion.cesium.com/1/tileset.json?v=1");
+  CHECK(
+      tokenKey("https://assets.ion.cesium.com/1/a.glb?access_token=a#x", {}) ==
+      "https://assets.ion.cesium.com/1/a.glb#x");
+  CHECK(
+      tokenKey(
+          "https://dev.virtualearth.net/REST/V1/Imagery/Metadata/Aerial?"
+          "incl=ImageryProviders&key=xyz&uriScheme=https",
+          {}) ==
+      "https://dev.virtualearth.net/REST/V1/Imagery/Metadata/Aerial?"
+      "incl=ImageryProviders&uriScheme=https");
+
+  // The ion endpoint's response depends on the token, so it is kept there.
+  const std::string endpointUrl =
+      "https://api.cesium.com/v1/assets/1/endpoint?access_token=a";
+  CHECK(tokenKey(endpointUrl, {}) == endpointUrl);
+  CHECK(
+      tokenKey("https://example.com/tile?key=1&x=2", {}) ==
+      "https://example.com/tile?key=1&x=2");
+
+  const CachingAssetAccessor::CacheKeyFunction sessionKey =
+      CachingAssetAccessor::createCacheKeyFunction({{"session", ""}});
+  CHECK(sessionKey("http://a.com/t?session=1", {}) == "http://a.com/t");
+  CHECK(sessionKey("http://a.com/t?x=1&session=1", {}) == "http://a.com/t?x=1");
+
+  SECTION("the accessor looks up and stores responses by the key") {
+    std::shared_ptr<IAssetRequest> pMockRequest =
+        std::make_shared<MockAssetRequest>(
+            "GET",
+            "https://assets.ion.cesium.com/1/a.glb?access_token=abc",
+            HttpHeaders{},
+            std::make_unique<MockAssetResponse>(
+                static_cast<uint16_t>(200),
+                "model/gltf-binary",
+                HttpHeaders{{"Cache-Control", "max-age=100"}},
+                std::vector<std::byte>()));
+
+    std::unique_ptr<MockStoreCacheDatabase> pOwnedCacheDatabase =
+        std::make_unique<MockStoreCacheDatabase>();
+    MockStoreCacheDatabase* pCacheDatabase = pOwnedCacheDatabase.get();
+    std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            std::make_shared<MockAssetAccessor>(pMockRequest),
+            std::move(pOwnedCacheDatabase),
+            10000,
+            CachingAssetAccessor::StaleWhileRevalidate::Never,
+            0,
+            tokenKey);
+    AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+    pCachingAccessor
+        ->get(
+            asyncSystem,
+            "https://assets.ion.cesium.com/1/a.glb?access_token=abc",
+            {})
+        .wait();
+
+    CHECK(
+        pCacheDatabase->getEntryKey ==
+        "https://assets.ion.cesium.com/1/a.glb");
+    REQUIRE(pCacheDatabase->storeRequestParam);
+    CHECK(
+        pCacheDatabase->storeRequestParam->key ==
+        "https://assets.ion.cesium.com/1/a.glb");
+    CHECK(
+        pCacheDatabase->storeRequestParam->url ==
+        "https://assets.ion.cesium.com/1/a.glb?access_token=abc");
+  }
+}
+
+TEST_CASE("Stale cached responses can be returned while they are revalidated") {
+  std::shared_ptr<IAssetRequest> pNotModifiedRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(304),
+              "app/json",
+              HttpHeaders{
+                  {"Revalidation-Response-Header",
+                   "Revalidation-Response-Value"},
+                  {"Cache-Control", "max-age=300, private"}},
+              std::vector<std::byte>()));
+
+  const auto createStaleCacheItem = [](const std::string& cacheControl) {
+    return CacheItem(
+        std::time(nullptr) - 100,
+        CacheRequest(HttpHeaders{}, "GET", "cache.com"),
+        CacheResponse(
+            static_cast<uint16_t>(200),
+            HttpHeaders{
+                {"Content-Type", "app/json"},
+                {"Cache-Control", cacheControl}},
+            std::vector<std::byte>{std::byte(1), std::byte(2)}));
+  };
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("within the stale-while-revalidate time") {
+    std::unique_ptr<MockStoreCacheDatabase> pOwnedCacheDatabase =
+        std::make_unique<MockStoreCacheDatabase>();
+    MockStoreCacheDatabase* pCacheDatabase = pOwnedCacheDatabase.get();
+    pCacheDatabase->cacheItem =
+        createStaleCacheItem("max-age=100, stale-while-revalidate=1000");
+
+    auto pDeferredAccessor =
+        std::make_shared<DeferredAssetAccessor>(pNotModifiedRequest);
+    std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            pDeferredAccessor,
+            std::move(pOwnedCacheDatabase),
+            10000,
+            CachingAssetAccessor::StaleWhileRevalidate::CacheControl);
+
+    // The stale response is returned before the revalidation completes.
+    std::shared_ptr<IAssetRequest> pFirst =
+        pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    REQUIRE(pFirst);
+    REQUIRE(pFirst->response());
+    CHECK(pFirst->url() == "cache.com");
+    CHECK(pFirst->response()->data().size() == 2);
+    CHECK(
+        pFirst->response()->headers().find("Revalidation-Response-Header") ==
+        pFirst->response()->headers().end());
+
+    // A second request doesn't start another revalidation.
+    pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    CHECK(pDeferredAccessor->getCount == 1);
+    CHECK(!pCacheDatabase->storeResponseCall);
+
+    // Completing the revalidation updates the cached response. The cache
+    // thread stores it before it looks up the next request.
+    pDeferredAccessor->complete();
+    pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    CHECK(pDeferredAccessor->getCount == 2);
+    REQUIRE(pCacheDatabase->storeRequestParam);
+    CHECK(pCacheDatabase->storeRequestParam->statusCode == 200);
+    CHECK(pCacheDatabase->storeRequestParam->responseData.size() == 2);
+    CHECK(
+        pCacheDatabase->storeRequestParam->responseHeaders.at(
+            "Revalidation-Response-Header") == "Revalidation-Response-Value");
+
+    pDeferredAccessor->complete();
+    pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    pDeferredAccessor->complete();
+  }
+
+  SECTION("revalidates first when must-revalidate is present") {
+    std::unique_ptr<MockStoreCacheDatabase> pOwnedCacheDatabase =
+        std::make_unique<MockStoreCacheDatabase>();
+    pOwnedCacheDatabase->cacheItem =
+        createStaleCacheItem("max-age=100, must-revalidate");
+
+    std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            std::make_shared<MockAssetAccessor>(pNotModifiedRequest),
+            std::move(pOwnedCacheDatabase),
+            10000,
+            CachingAssetAccessor::StaleWhileRevalidate::Always);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    REQUIRE(pRequest);
+    REQUIRE(pRequest->response());
+    CHECK(
+        pRequest->response()->headers().at("Revalidation-Response-Header") ==
+        "Revalidation-Response-Value");
+  }
+}
+
+TEST_CASE("Missing content is cached for the negative cache duration") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  const auto createNotFoundRequest = [](const HttpHeaders& responseHeaders) {
+    return std::make_shared<MockAssetRequest>(
+        "GET",
+        "test.com",
+        HttpHeaders{},
+        std::make_unique<MockAssetResponse>(
+            static_cast<uint16_t>(404),
+            "text/plain",
+            responseHeaders,
+            std::vector<std::byte>()));
+  };
+
+  const auto getWithCache = [&asyncSystem](
+                                const std::shared_ptr<IAssetRequest>& pRequest,
+                                MockStoreCacheDatabase*& pCacheDatabase,
+                                int32_t negativeCacheDuration) {
+    std::unique_ptr<MockStoreCacheDatabase> pOwnedCacheDatabase =
+        std::make_unique<MockStoreCacheDatabase>();
+    pCacheDatabase = pOwnedCacheDatabase.get();
+    std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            std::make_shared<MockAssetAccessor>(pRequest),
+            std::move(pOwnedCacheDatabase),
+            10000,
+            CachingAssetAccessor::StaleWhileRevalidate::Never,
+            negativeCacheDuration);
+    std::shared_ptr<IAssetRequest> pCompleted =
+        pCachingAccessor->get(asyncSystem, "test.com", {}).wait();
+    REQUIRE(pCompleted);
+    REQUIRE(pCompleted->response());
+    CHECK(pCompleted->response()->statusCode() == 404);
+    return pCachingAccessor;
+  };
+
+  // The accessor owns the database, so each section keeps it alive while it
+  // checks what was stored.
+  SECTION("isn't cached without a negative cache duration") {
+    MockStoreCacheDatabase* pCacheDatabase = nullptr;
+    std::shared_ptr<CachingAssetAccessor> pAccessor =
+        getWithCache(createNotFoundRequest(HttpHeaders{}), pCacheDatabase, 0);
+    CHECK(!pCacheDatabase->storeResponseCall);
+  }
+
+  SECTION("is cached for the negative cache duration") {
+    const std::time_t before = std::time(nullptr);
+    MockStoreCacheDatabase* pCacheDatabase = nullptr;
+    std::shared_ptr<CachingAssetAccessor> pAccessor = getWithCache(
+        createNotFoundRequest(HttpHeaders{}),
+        pCacheDatabase,
+        3600);
+    REQUIRE(pCacheDatabase->storeRequestParam);
+    CHECK(pCacheDatabase->storeRequestParam->statusCode == 404);
+    CHECK(pCacheDatabase->storeRequestParam->expiryTime >= before + 3600);
+    CHECK(
+        pCacheDatabase->storeRequestParam->expiryTime <=
+        std::time(nullptr) + 3600);
+  }
+
+  SECTION("isn't cached if the server forbids it") {
+    MockStoreCacheDatabase* pCacheDatabase = nullptr;
+    std::shared_ptr<CachingAssetAccessor> pAccessor = getWithCache(
+        createNotFoundRequest(HttpHeaders{{"Cache-Control", "no-store"}}),
+        pCacheDatabase,
+        3600);
+    CHECK(!pCacheDatabase->storeResponseCall);
+  }
+}
@@ -0,0 +1,154 @@
+#include "CesiumAsync/AsyncSystem.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class MockTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) {
+    std::thread(f).detach();
+  }
+};
+
+// Stands in for a std::coroutine_handle so that the awaiter protocol can be
+// tested without compiling as C++20.
+struct MockCoroutineHandle {
+  std::shared_ptr<std::atomic<int>> pResumeCount;
+  void resume() { ++*this->pResumeCount; }
+};
+
+struct ObjectWithAsyncSystem {
+  AsyncSystem asyncSystem;
+};
+
+#if defined(__cpp_impl_coroutine)
+Future<int> addOneInWorkerThread(const AsyncSystem& asyncSystem, int value) {
+  co_await asyncSystem.workerThread();
+  co_return value + 1;
+}
+
+Future<int> addInMainThread(const AsyncSystem& asyncSystem, int value) {
+  int result = co_await addOneInWorkerThread(asyncSystem, value);
+  co_await asyncSystem.mainThread();
+  co_return result + 1;
+}
+
+Future<void> throwInWorkerThread(const AsyncSystem& asyncSystem) {
+  co_await asyncSystem.workerThread();
+  throw std::runtime_error("test");
+}
+#endif
+
+} // namespace
+
+TEST_CASE("Coroutine support") {
+  std::shared_ptr<MockTaskProcessor> pTaskProcessor =
+      std::make_shared<MockTaskProcessor>();
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  SECTION("a resolved Future is ready to be awaited") {
+    Future<int> future = asyncSystem.createResolvedFuture(42);
+    CHECK(future.await_ready());
+    CHECK(future.await_resume() == 42);
+  }
+
+  SECTION("awaiting a Future resumes when it resolves") {
+    Promise<int> promise = asyncSystem.createPromise<int>();
+    Future<int> future = promise.getFuture();
+    CHECK(!future.await_ready());
+
+    MockCoroutineHandle handle{std::make_shared<std::atomic<int>>(0)};
+    future.await_suspend(handle);
+    CHECK(*handle.pResumeCount == 0);
+
+    promise.resolve(4);
+    CHECK(*handle.pResumeCount == 1);
+    CHECK(future.await_resume() == 4);
+  }
+
+  SECTION("awaiting a rejected Future throws when it resumes") {
+    Promise<int> promise = asyncSystem.createPromise<int>();
+    Future<int> future = promise.getFuture();
+
+    MockCoroutineHandle handle{std::make_shared<std::atomic<int>>(0)};
+    future.await_suspend(handle);
+    promise.reject(std::runtime_error("test"));
+    CHECK(*handle.pResumeCount == 1);
+    CHECK_THROWS_AS(future.await_resume(), std::runtime_error);
+  }
+
+  SECTION("a SharedFuture can be awaited more than once") {
+    Promise<int> promise = asyncSystem.createPromise<int>();
+    SharedFuture<int> future = promise.getFuture().share();
+
+    MockCoroutineHandle handle{std::make_shared<std::atomic<int>>(0)};
+    future.await_suspend(handle);
+    future.await_suspend(handle);
+    promise.resolve(7);
+    CHECK(*handle.pResumeCount == 2);
+    CHECK(future.await_resume() == 7);
+    CHECK(future.await_resume() == 7);
+  }
+
+  SECTION("awaiting the main thread resumes when main thread tasks are "
+          "dispatched") {
+    MockCoroutineHandle handle{std::make_shared<std::atomic<int>>(0)};
+    auto awaitable = asyncSystem.mainThread();
+    CHECK(!awaitable.await_ready());
+    awaitable.await_suspend(handle);
+    CHECK(*handle.pResumeCount == 0);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(*handle.pResumeCount == 1);
+  }
+
+  SECTION("awaiting a worker thread resumes in a worker thread") {
+    MockCoroutineHandle handle{std::make_shared<std::atomic<int>>(0)};
+    asyncSystem.workerThread().await_suspend(handle);
+    while (*handle.pResumeCount == 0) {
+      std::this_thread::yield();
+    }
+    CHECK(*handle.pResumeCount == 1);
+  }
+
+  SECTION("the coroutine promise finds the AsyncSystem and resolves its "
+          "Future") {
+    ObjectWithAsyncSystem object{asyncSystem};
+    Future<int>::promise_type coroutinePromise(0, object);
+    Future<int> future = coroutinePromise.get_return_object();
+    CHECK(!future.isReady());
+    coroutinePromise.return_value(3);
+    CHECK(future.wait() == 3);
+  }
+
+  SECTION("the coroutine promise rejects its Future with an unhandled "
+          "exception") {
+    Future<void>::promise_type coroutinePromise(asyncSystem);
+    Future<void> future = coroutinePromise.get_return_object();
+    try {
+      throw std::runtime_error("test");
+    } catch (...) {
+      coroutinePromise.unhandled_exception();
+    }
+    CHECK_THROWS_AS(future.wait(), std::runtime_error);
+  }
+
+#if defined(__cpp_impl_coroutine)
+  SECTION("a coroutine can await futures and switch threads") {
+    Future<int> future = addInMainThread(asyncSystem, 1);
+    CHECK(future.waitInMainThread() == 3);
+  }
+
+  SECTION("a coroutine that throws rejects its future") {
+    Future<void> future = throwInWorkerThread(asyncSystem);
+    CHECK_THROWS_AS(future.wait(), std::runtime_error);
+  }
+#endif
+}
@@ -6,7 +6,13 @@
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -171,6 +177,43 @@ TEST_CASE("Test disk cache with Sqlite") {
     }
   }
 
+  SECTION("Test prune deletes more items than one chunk") {
+    const int32_t itemCount = 600;
+    const std::vector<std::byte> responseData{std::byte(0)};
+    for (int32_t i = 0; i < itemCount; ++i) {
+      REQUIRE(diskCache.storeEntry(
+          "TestKey" + std::to_string(i),
+          std::time(nullptr) + 1000,
+          "test.com",
+          "GET",
+          HttpHeaders{},
+          200,
+          HttpHeaders{},
+          responseData));
+    }
+
+    // Storing an existing key again must not be counted as a new item.
+    REQUIRE(diskCache.storeEntry(
+        "TestKey0",
+        std::time(nullptr) + 1000,
+        "test.com",
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{},
+        responseData));
+
+    REQUIRE(diskCache.prune());
+
+    int32_t remaining = 0;
+    for (int32_t i = 0; i < itemCount; ++i) {
+      if (diskCache.getEntry("TestKey" + std::to_string(i))) {
+        ++remaining;
+      }
+    }
+    CHECK(remaining == 3);
+  }
+
   SECTION("Test clear all") {
     // store data in the cache first
     HttpHeaders responseHeaders{
@@ -214,3 +257,316 @@ TEST_CASE("Test disk cache with Sqlite") {
     }
   }
 }
+
+TEST_CASE("Test batched writes to the Sqlite disk cache") {
+  SqliteCache batchedCache(
+      spdlog::default_logger(),
+      "test-batched.db",
+      4096,
+      3,
+      std::chrono::hours(1));
+  REQUIRE(batchedCache.clearAll());
+
+  // A second connection to the same database only sees written entries.
+  SqliteCache readerCache(spdlog::default_logger(), "test-batched.db");
+
+  std::vector<std::byte> responseData{std::byte(7), std::byte(8)};
+  const auto store = [&](const std::string& key) {
+    return batchedCache.storeEntry(
+        key,
+        std::time(nullptr) + 100,
+        "test.com/" + key,
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{{"Content-Type", "application/octet-stream"}},
+        responseData);
+  };
+
+  SECTION("pending entries are served from memory") {
+    REQUIRE(store("first"));
+
+    std::optional<CacheItem> pendingItem = batchedCache.getEntry("first");
+    REQUIRE(pendingItem);
+    CHECK(pendingItem->cacheRequest.url == "test.com/first");
+    CHECK(pendingItem->cacheResponse.data == responseData);
+
+    CHECK(!readerCache.getEntry("first"));
+  }
+
+  SECTION("entries are written once the batch is full") {
+    REQUIRE(store("first"));
+    REQUIRE(store("second"));
+    CHECK(!readerCache.getEntry("first"));
+
+    REQUIRE(store("third"));
+    CHECK(readerCache.getEntry("first"));
+    CHECK(readerCache.getEntry("second"));
+    CHECK(readerCache.getEntry("third"));
+  }
+
+  SECTION("flush writes pending entries") {
+    REQUIRE(store("first"));
+    REQUIRE(batchedCache.flush());
+
+    std::optional<CacheItem> writtenItem = readerCache.getEntry("first");
+    REQUIRE(writtenItem);
+    CHECK(writtenItem->cacheResponse.data == responseData);
+  }
+
+  SECTION("clearAll discards pending entries") {
+    REQUIRE(store("first"));
+    REQUIRE(batchedCache.clearAll());
+    CHECK(!batchedCache.getEntry("first"));
+    REQUIRE(batchedCache.flush());
+    CHECK(!readerCache.getEntry("first"));
+  }
+}
+
+TEST_CASE("Test reading the Sqlite disk cache from a pool of connections") {
+  SqliteCache pooledCache(
+      spdlog::default_logger(),
+      "test-pooled.db",
+      4096,
+      1,
+      std::chrono::milliseconds(0),
+      4);
+  REQUIRE(pooledCache.clearAll());
+
+  const int32_t entryCount = 16;
+  for (int32_t i = 0; i < entryCount; ++i) {
+    const std::string key = "key" + std::to_string(i);
+    REQUIRE(pooledCache.storeEntry(
+        key,
+        std::time(nullptr) + 100,
+        "test.com/" + key,
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{},
+        std::vector<std::byte>{std::byte(i)}));
+  }
+
+  std::atomic<int32_t> hits = 0;
+  std::vector<std::thread> readers;
+  for (int32_t thread = 0; thread < 8; ++thread) {
+    readers.emplace_back([&pooledCache, &hits]() {
+      for (int32_t i = 0; i < entryCount; ++i) {
+        std::optional<CacheItem> item =
+            pooledCache.getEntry("key" + std::to_string(i));
+        if (item &&
+            item->cacheRequest.url == "test.com/key" + std::to_string(i) &&
+            item->cacheResponse.data == std::vector<std::byte>{std::byte(i)}) {
+          ++hits;
+        }
+      }
+    });
+  }
+
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  CHECK(hits == 8 * entryCount);
+  CHECK(!pooledCache.getEntry("missing"));
+}
+
+TEST_CASE("Test storing headers in a memory-mapped Sqlite disk cache") {
+  SqliteCache diskCache(
+      spdlog::default_logger(),
+      "test-mmap.db",
+      10,
+      1,
+      std::chrono::milliseconds(0),
+      2,
+      SqliteCacheCompression::None,
+      uint64_t(1) << 24);
+  REQUIRE(diskCache.clearAll());
+
+  // Long enough that its length takes more than one byte to encode.
+  const std::string longValue(300, 'x');
+  const HttpHeaders requestHeaders{
+      {"Accept", "*/*"},
+      {"Empty", ""},
+      {"Long", longValue}};
+  const HttpHeaders responseHeaders{
+      {"Content-Type", "application/octet-stream"},
+      {"ETag", "\"abc\""}};
+  REQUIRE(diskCache.storeEntry(
+      "key",
+      std::time(nullptr) + 100,
+      "test.com/tile.glb",
+      "GET",
+      requestHeaders,
+      200,
+      responseHeaders,
+      std::vector<std::byte>{std::byte(1), std::byte(2)}));
+  REQUIRE(diskCache.storeEntry(
+      "noHeaders",
+      std::time(nullptr) + 100,
+      "test.com/tile.b3dm",
+      "GET",
+      HttpHeaders{},
+      200,
+      HttpHeaders{},
+      std::vector<std::byte>{}));
+
+  std::optional<CacheItem> item = diskCache.getEntry("key");
+  REQUIRE(item);
+  CHECK(item->cacheRequest.headers == requestHeaders);
+  CHECK(item->cacheRequest.url == "test.com/tile.glb");
+  CHECK(item->cacheResponse.headers == responseHeaders);
+  CHECK(
+      item->cacheResponse.headers.at("content-type") ==
+      "application/octet-stream");
+  CHECK(
+      item->cacheResponse.data ==
+      std::vector<std::byte>{std::byte(1), std::byte(2)});
+
+  std::optional<CacheItem> emptyItem = diskCache.getEntry("noHeaders");
+  REQUIRE(emptyItem);
+  CHECK(emptyItem->cacheRequest.headers.empty());
+  CHECK(emptyItem->cacheResponse.headers.empty());
+  CHECK(emptyItem->cacheResponse.data.empty());
+}
+
+TEST_CASE("Test importing and exporting Sqlite disk cache entries") {
+  SqliteCache sourceCache(spdlog::default_logger(), "test-import.db", 10000);
+  REQUIRE(sourceCache.clearAll());
+
+  // More entries than fit in one import transaction.
+  std::vector<CacheEntry> entries;
+  for (int i = 0; i < 2500; ++i) {
+    const std::string index = std::to_string(i);
+    entries.emplace_back(CacheEntry{
+        "key" + index,
+        CacheItem(
+            std::time(nullptr) + 100,
+            CacheRequest(
+                HttpHeaders{{"Request-Header", "Request-Value"}},
+                "GET",
+                "test.com/" + index),
+            CacheResponse(
+                static_cast<uint16_t>(200),
+                HttpHeaders{{"Content-Type", "application/octet-stream"}},
+                std::vector<std::byte>(size_t(i % 5), std::byte(i % 256))))});
+  }
+
+  REQUIRE(sourceCache.storeEntries(entries) == entries.size());
+
+  std::optional<CacheItem> importedItem = sourceCache.getEntry("key1234");
+  REQUIRE(importedItem);
+  CHECK(importedItem->cacheRequest.url == "test.com/1234");
+  CHECK(
+      importedItem->cacheRequest.headers.at("Request-Header") ==
+      "Request-Value");
+  CHECK(importedItem->cacheResponse.data.size() == 1234 % 5);
+
+  SECTION("exports every entry") {
+    std::vector<CacheEntry> exported;
+    REQUIRE(sourceCache.exportEntries([&exported](CacheEntry&& entry) {
+      exported.emplace_back(std::move(entry));
+      return true;
+    }));
+    REQUIRE(exported.size() == entries.size());
+
+    SqliteCache targetCache(spdlog::default_logger(), "test-export.db", 10000);
+    REQUIRE(targetCache.clearAll());
+    REQUIRE(targetCache.storeEntries(exported) == exported.size());
+
+    std::optional<CacheItem> copiedItem = targetCache.getEntry("key2499");
+    REQUIRE(copiedItem);
+    CHECK(copiedItem->expiryTime == entries.back().item.expiryTime);
+    CHECK(copiedItem->cacheResponse.statusCode == 200);
+    CHECK(
+        copiedItem->cacheResponse.data ==
+        entries.back().item.cacheResponse.data);
+  }
+
+  SECTION("stops exporting when the callback returns false") {
+    size_t exportedCount = 0;
+    REQUIRE(sourceCache.exportEntries([&exportedCount](CacheEntry&&) {
+      return ++exportedCount < 10;
+    }));
+    CHECK(exportedCount == 10);
+  }
+}
+
+TEST_CASE("Test compressing Sqlite disk cache entries") {
+  const std::string json(4096, ' ');
+  std::vector<std::byte> jsonData(json.size());
+  std::transform(json.begin(), json.end(), jsonData.begin(), [](char c) {
+    return std::byte(c);
+  });
+
+  // Starts with the signature of a JPEG, so it is stored as it is.
+  std::vector<std::byte> jpegData(4096, std::byte(0));
+  jpegData[0] = std::byte(0xFF);
+  jpegData[1] = std::byte(0xD8);
+  jpegData[2] = std::byte(0xFF);
+
+  const uint32_t writeBatchSize = GENERATE(uint32_t(1), uint32_t(8));
+
+  {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-compressed.db",
+        10,
+        writeBatchSize,
+        std::chrono::milliseconds(100),
+        1,
+        SqliteCacheCompression::Deflate);
+    REQUIRE(diskCache.clearAll());
+
+    const HttpHeaders requestHeaders{};
+    const HttpHeaders jsonHeaders{{"Content-Type", "application/json"}};
+    const HttpHeaders jpegHeaders{{"Content-Type", "image/jpeg"}};
+    REQUIRE(diskCache.storeEntry(
+        "json",
+        std::time(nullptr) + 100,
+        "test.com/tileset.json",
+        "GET",
+        requestHeaders,
+        200,
+        jsonHeaders,
+        jsonData));
+    REQUIRE(diskCache.storeEntry(
+        "jpeg",
+        std::time(nullptr) + 100,
+        "test.com/image.jpg",
+        "GET",
+        requestHeaders,
+        200,
+        jpegHeaders,
+        jpegData));
+
+    // Pending entries are returned uncompressed, too.
+    std::optional<CacheItem> jsonItem = diskCache.getEntry("json");
+    REQUIRE(jsonItem);
+    CHECK(jsonItem->cacheResponse.data == jsonData);
+  }
+
+  // The entries can be read without compression enabled.
+  SqliteCache diskCache(spdlog::default_logger(), "test-compressed.db", 10);
+
+  std::optional<CacheItem> jsonItem = diskCache.getEntry("json");
+  REQUIRE(jsonItem);
+  CHECK(jsonItem->cacheResponse.data == jsonData);
+  CHECK(
+      jsonItem->cacheResponse.headers.at("Content-Type") ==
+      "application/json");
+
+  std::optional<CacheItem> jpegItem = diskCache.getEntry("jpeg");
+  REQUIRE(jpegItem);
+  CHECK(jpegItem->cacheResponse.data == jpegData);
+
+  std::vector<CacheEntry> exported;
+  REQUIRE(diskCache.exportEntries([&exported](CacheEntry&& entry) {
+    exported.emplace_back(std::move(entry));
+    return true;
+  }));
+  REQUIRE(exported.size() == 2);
+  for (const CacheEntry& entry : exported) {
+    CHECK(entry.item.cacheResponse.data.size() == 4096);
+  }
+}
@@ -0,0 +1,194 @@
+#include "MockTaskProcessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/FileAssetAccessor.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+void writeFile(const std::filesystem::path& path, const std::string& contents) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  REQUIRE(file);
+  file.write(contents.data(), std::streamsize(contents.size()));
+}
+
+template <typename T> void appendLittleEndian(std::string& out, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+// Builds a zip archive whose entries are all stored without compression.
+std::string createStoredZip(
+    const std::vector<std::pair<std::string, std::string>>& entries) {
+  std::string archive;
+  std::string centralDirectory;
+
+  for (const auto& [name, contents] : entries) {
+    const uint32_t localHeaderOffset = uint32_t(archive.size());
+
+    appendLittleEndian<uint32_t>(archive, 0x04034b50);
+    appendLittleEndian<uint16_t>(archive, 10); // version needed
+    appendLittleEndian<uint16_t>(archive, 0);  // flags
+    appendLittleEndian<uint16_t>(archive, 0);  // stored
+    appendLittleEndian<uint32_t>(archive, 0);  // time and date
+    appendLittleEndian<uint32_t>(archive, 0);  // CRC-32, unchecked
+    appendLittleEndian<uint32_t>(archive, uint32_t(contents.size()));
+    appendLittleEndian<uint32_t>(archive, uint32_t(contents.size()));
+    appendLittleEndian<uint16_t>(archive, uint16_t(name.size()));
+    appendLittleEndian<uint16_t>(archive, 0); // extra field length
+    archive += name;
+    archive += contents;
+
+    appendLittleEndian<uint32_t>(centralDirectory, 0x02014b50);
+    appendLittleEndian<uint16_t>(centralDirectory, 10); // version made by
+    appendLittleEndian<uint16_t>(centralDirectory, 10); // version needed
+    appendLittleEndian<uint16_t>(centralDirectory, 0);  // flags
+    appendLittleEndian<uint16_t>(centralDirectory, 0);  // stored
+    appendLittleEndian<uint32_t>(centralDirectory, 0);  // time and date
+    appendLittleEndian<uint32_t>(centralDirectory, 0);  // CRC-32
+    appendLittleEndian<uint32_t>(centralDirectory, uint32_t(contents.size()));
+    appendLittleEndian<uint32_t>(centralDirectory, uint32_t(contents.size()));
+    appendLittleEndian<uint16_t>(centralDirectory, uint16_t(name.size()));
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // extra field length
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // comment length
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // disk number
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // internal attributes
+    appendLittleEndian<uint32_t>(centralDirectory, 0); // external attributes
+    appendLittleEndian<uint32_t>(centralDirectory, localHeaderOffset);
+    centralDirectory += name;
+  }
+
+  const uint32_t centralDirectoryOffset = uint32_t(archive.size());
+  archive += centralDirectory;
+
+  appendLittleEndian<uint32_t>(archive, 0x06054b50);
+  appendLittleEndian<uint16_t>(archive, 0); // disk number
+  appendLittleEndian<uint16_t>(archive, 0); // central directory disk
+  appendLittleEndian<uint16_t>(archive, uint16_t(entries.size()));
+  appendLittleEndian<uint16_t>(archive, uint16_t(entries.size()));
+  appendLittleEndian<uint32_t>(archive, uint32_t(centralDirectory.size()));
+  appendLittleEndian<uint32_t>(archive, centralDirectoryOffset);
+  appendLittleEndian<uint16_t>(archive, 0); // comment length
+
+  return archive;
+}
+
+std::string toFileUrl(const std::filesystem::path& path) {
+  return "file:///" + path.generic_u8string();
+}
+
+std::string asString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+TEST_CASE("FileAssetAccessor") {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "TestFileAssetAccessor";
+  std::filesystem::create_directories(directory);
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  auto pAccessor = std::make_shared<FileAssetAccessor>();
+
+  SECTION("maps a file") {
+    const std::filesystem::path path = directory / "tileset.json";
+    writeFile(path, "{\"asset\":{\"version\":\"1.0\"}}");
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        pAccessor->get(asyncSystem, toFileUrl(path), {}).wait();
+    CHECK(pRequest->method() == "GET");
+    CHECK(pRequest->url() == toFileUrl(path));
+
+    const IAssetResponse* pResponse = pRequest->response();
+    REQUIRE(pResponse);
+    CHECK(pResponse->statusCode() == 200);
+    CHECK(asString(pResponse->data()) == "{\"asset\":{\"version\":\"1.0\"}}");
+  }
+
+  SECTION("decodes percent-encoded paths") {
+    const std::filesystem::path path = directory / "with space.json";
+    writeFile(path, "spaced");
+
+    std::string url = toFileUrl(directory) + "/with%20space.json";
+    std::shared_ptr<IAssetRequest> pRequest =
+        pAccessor->get(asyncSystem, url, {}).wait();
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->response()->statusCode() == 200);
+    CHECK(asString(pRequest->response()->data()) == "spaced");
+  }
+
+  SECTION("reports missing files with a 404") {
+    std::shared_ptr<IAssetRequest> pRequest =
+        pAccessor
+            ->get(asyncSystem, toFileUrl(directory / "does-not-exist"), {})
+            .wait();
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->response()->statusCode() == 404);
+  }
+
+  SECTION("serves entries of a 3tz archive") {
+    const std::filesystem::path path = directory / "packaged.3tz";
+    writeFile(
+        path,
+        createStoredZip(
+            {{"tileset.json", "{\"root\":{}}"},
+             {"content/0.glb", "glTF-content"}}));
+
+    std::shared_ptr<IAssetRequest> pTileset =
+        pAccessor->get(asyncSystem, toFileUrl(path) + "/tileset.json", {})
+            .wait();
+    REQUIRE(pTileset->response());
+    CHECK(pTileset->response()->statusCode() == 200);
+    CHECK(asString(pTileset->response()->data()) == "{\"root\":{}}");
+
+    std::shared_ptr<IAssetRequest> pContent =
+        pAccessor->get(asyncSystem, toFileUrl(path) + "/content/0.glb", {})
+            .wait();
+    REQUIRE(pContent->response());
+    CHECK(pContent->response()->statusCode() == 200);
+    CHECK(asString(pContent->response()->data()) == "glTF-content");
+
+    std::shared_ptr<IAssetRequest> pMissing =
+        pAccessor->get(asyncSystem, toFileUrl(path) + "/content/1.glb", {})
+            .wait();
+    REQUIRE(pMissing->response());
+    CHECK(pMissing->response()->statusCode() == 404);
+  }
+
+  SECTION("rejects other schemes") {
+    CHECK_THROWS(
+        pAccessor->get(asyncSystem, "https://example.com/tileset.json", {})
+            .wait());
+  }
+
+  SECTION("only supports GET") {
+    std::shared_ptr<IAssetRequest> pRequest =
+        pAccessor
+            ->request(
+                asyncSystem,
+                "POST",
+                toFileUrl(directory / "tileset.json"),
+                {},
+                {})
+            .wait();
+    CHECK(pRequest->method() == "POST");
+    REQUIRE(pRequest->response());
+    CHECK(pRequest->response()->statusCode() == 405);
+  }
+
+  pAccessor.reset();
+  std::filesystem::remove_all(directory);
+}
@@ -145,6 +145,73 @@ TEST_CASE("GunzipAssetAccessor") {
         asBytes(std::vector<int>{0x1F, 0x8B, 0x01, 0x02, 0x03}));
   }
 
+  SECTION("inflates a deflate Content-Encoding") {
+    auto pAccessor = std::make_shared<GunzipAssetAccessor>(
+        std::make_shared<MockAssetAccessor>(std::make_shared<MockAssetRequest>(
+            "GET",
+            "https://example.com",
+            HttpHeaders{std::make_pair("Foo", "Bar")},
+            std::make_unique<MockAssetResponse>(
+                static_cast<uint16_t>(200),
+                "Application/Whatever",
+                HttpHeaders{std::make_pair("Content-Encoding", "Deflate")},
+                asBytes(std::vector<int>{
+                    0x78,
+                    0x9C,
+                    0x63,
+                    0x64,
+                    0x62,
+                    0x06,
+                    0x00,
+                    0x00,
+                    0x0D,
+                    0x00,
+                    0x07})))));
+
+    std::shared_ptr<MockTaskProcessor> mockTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+    AsyncSystem asyncSystem(mockTaskProcessor);
+
+    auto pCompletedRequest =
+        pAccessor->get(asyncSystem, "https://example.com", {}).wait();
+    const IAssetResponse* pResponse = pCompletedRequest->response();
+    REQUIRE(pResponse != nullptr);
+    CHECK(pResponse->statusCode() == 200);
+    CHECK(
+        std::vector<std::byte>(
+            pResponse->data().data(),
+            pResponse->data().data() + pResponse->data().size()) ==
+        asBytes(std::vector<int>{0x01, 0x02, 0x03}));
+  }
+
+  SECTION("passes through a deflate Content-Encoding that was already "
+          "decoded") {
+    auto pAccessor = std::make_shared<GunzipAssetAccessor>(
+        std::make_shared<MockAssetAccessor>(std::make_shared<MockAssetRequest>(
+            "GET",
+            "https://example.com",
+            HttpHeaders{std::make_pair("Foo", "Bar")},
+            std::make_unique<MockAssetResponse>(
+                static_cast<uint16_t>(200),
+                "Application/Whatever",
+                HttpHeaders{std::make_pair("Content-Encoding", "deflate")},
+                asBytes(std::vector<int>{0x01, 0x02, 0x03})))));
+
+    std::shared_ptr<MockTaskProcessor> mockTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+    AsyncSystem asyncSystem(mockTaskProcessor);
+
+    auto pCompletedRequest =
+        pAccessor->get(asyncSystem, "https://example.com", {}).wait();
+    const IAssetResponse* pResponse = pCompletedRequest->response();
+    REQUIRE(pResponse != nullptr);
+    CHECK(
+        std::vector<std::byte>(
+            pResponse->data().data(),
+            pResponse->data().data() + pResponse->data().size()) ==
+        asBytes(std::vector<int>{0x01, 0x02, 0x03}));
+  }
+
   SECTION("works with request method") {
     auto pAccessor = std::make_shared<GunzipAssetAccessor>(
         std::make_shared<MockAssetAccessor>(std::make_shared<MockAssetRequest>(
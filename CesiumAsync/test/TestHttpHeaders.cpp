@@ -0,0 +1,72 @@
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+
+TEST_CASE("HttpHeaders") {
+  SECTION("finds headers ignoring case") {
+    HttpHeaders headers{{"Content-Type", "text/plain"}, {"ETag", "abc"}};
+    REQUIRE(headers.size() == 2);
+
+    HttpHeaders::const_iterator it = headers.find("content-type");
+    REQUIRE(it != headers.end());
+    CHECK(it->first == "Content-Type");
+    CHECK(it->second == "text/plain");
+    CHECK(headers.at("ETAG") == "abc");
+    CHECK(headers.count("Etag") == 1);
+    CHECK(headers.find("Content") == headers.end());
+    CHECK_THROWS_AS(headers.at("Expires"), std::out_of_range);
+  }
+
+  SECTION("keeps the headers sorted and the first of duplicate names") {
+    std::vector<std::pair<std::string, std::string>> pairs{
+        {"b", "1"},
+        {"A", "2"},
+        {"B", "3"},
+        {"c", "4"}};
+    HttpHeaders headers(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<std::string, std::string>> expected{
+        {"A", "2"},
+        {"b", "1"},
+        {"c", "4"}};
+    CHECK(std::vector<std::pair<std::string, std::string>>(
+              headers.begin(),
+              headers.end()) == expected);
+  }
+
+  SECTION("adds headers at the hint or in order") {
+    HttpHeaders headers;
+    headers.emplace_hint(headers.end(), "b", "1");
+    headers.emplace_hint(headers.end(), "d", "2");
+    headers.emplace_hint(headers.end(), "a", "3");
+    headers.emplace_hint(headers.end(), "D", "4");
+
+    REQUIRE(headers.size() == 3);
+    CHECK(headers.begin()->first == "a");
+    CHECK(headers.at("d") == "2");
+  }
+
+  SECTION("inserts, assigns, and erases headers") {
+    HttpHeaders headers;
+    CHECK(headers.insert({"Accept", "*/*"}).second);
+    CHECK(!headers.insert({"accept", "text/html"}).second);
+    CHECK(headers.at("Accept") == "*/*");
+
+    CHECK(!headers.insert_or_assign("ACCEPT", "text/html").second);
+    CHECK(headers.at("Accept") == "text/html");
+
+    headers["Range"] = "bytes=0-99";
+    CHECK(headers.at("range") == "bytes=0-99");
+
+    CHECK(headers.erase("accept") == 1);
+    CHECK(headers.erase("accept") == 0);
+    CHECK(headers == HttpHeaders{{"Range", "bytes=0-99"}});
+  }
+}
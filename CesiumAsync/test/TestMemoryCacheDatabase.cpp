@@ -0,0 +1,139 @@
+#include "CesiumAsync/MemoryCacheDatabase.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class CountingCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    ++this->getEntryCount;
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  mutable int32_t getEntryCount = 0;
+  std::map<std::string, CacheItem> items;
+};
+
+bool storeBytes(ICacheDatabase& database, const std::string& key, size_t size) {
+  return database.storeEntry(
+      key,
+      std::time(nullptr) + 100,
+      key,
+      "GET",
+      HttpHeaders{},
+      200,
+      HttpHeaders{},
+      std::vector<std::byte>(size, std::byte(1)));
+}
+
+} // namespace
+
+TEST_CASE("MemoryCacheDatabase") {
+  auto pUnderlying = std::make_shared<CountingCacheDatabase>();
+
+  SECTION("serves stored entries from memory") {
+    MemoryCacheDatabase database(pUnderlying);
+    REQUIRE(storeBytes(database, "a", 100));
+    CHECK(pUnderlying->items.count("a") == 1);
+
+    std::optional<CacheItem> maybeItem = database.getEntry("a");
+    REQUIRE(maybeItem);
+    CHECK(maybeItem->cacheResponse.data.size() == 100);
+    CHECK(pUnderlying->getEntryCount == 0);
+  }
+
+  SECTION("adds entries read from the underlying database") {
+    REQUIRE(storeBytes(*pUnderlying, "a", 100));
+
+    MemoryCacheDatabase database(pUnderlying);
+    CHECK(database.getEntry("a"));
+    CHECK(database.getEntry("a"));
+    CHECK(pUnderlying->getEntryCount == 1);
+    CHECK(!database.getEntry("missing"));
+  }
+
+  SECTION("evicts the least recently used entries to stay within its limit") {
+    MemoryCacheDatabase database(pUnderlying, 350);
+    REQUIRE(storeBytes(database, "a", 100));
+    REQUIRE(storeBytes(database, "b", 100));
+    REQUIRE(storeBytes(database, "c", 100));
+
+    // Use "a" so that "b" becomes the least recently used entry.
+    CHECK(database.getEntry("a"));
+    REQUIRE(storeBytes(database, "d", 100));
+    CHECK(database.getTotalBytes() <= 350);
+
+    pUnderlying->getEntryCount = 0;
+    CHECK(database.getEntry("a"));
+    CHECK(database.getEntry("c"));
+    CHECK(database.getEntry("d"));
+    CHECK(pUnderlying->getEntryCount == 0);
+
+    // "b" was evicted from memory, but is still in the underlying database.
+    CHECK(database.getEntry("b"));
+    CHECK(pUnderlying->getEntryCount == 1);
+  }
+
+  SECTION("does not keep entries larger than the limit in memory") {
+    MemoryCacheDatabase database(pUnderlying, 50);
+    REQUIRE(storeBytes(database, "big", 100));
+    CHECK(database.getTotalBytes() == 0);
+    CHECK(pUnderlying->items.count("big") == 1);
+  }
+
+  SECTION("works without an underlying database") {
+    MemoryCacheDatabase database(nullptr);
+    REQUIRE(storeBytes(database, "a", 10));
+    CHECK(database.getEntry("a"));
+    REQUIRE(database.clearAll());
+    CHECK(!database.getEntry("a"));
+    CHECK(database.getTotalBytes() == 0);
+  }
+}
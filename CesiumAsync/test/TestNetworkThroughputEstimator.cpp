@@ -0,0 +1,121 @@
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumAsync/NetworkThroughputEstimator.h>
+#include <CesiumAsync/ThroughputMeasuringAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <memory>
+
+using namespace CesiumAsync;
+
+namespace {
+
+using Clock = NetworkThroughputEstimator::Clock;
+
+Clock::time_point atSeconds(double seconds) {
+  return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(seconds)));
+}
+
+} // namespace
+
+TEST_CASE("NetworkThroughputEstimator") {
+  NetworkThroughputEstimator estimator(1.0);
+
+  SECTION("knows nothing before requests finish") {
+    estimator.notifyRequestStarted(atSeconds(0.0));
+    CHECK(estimator.getBytesPerSecond() == 0.0);
+    CHECK(estimator.getLatency() == 0.0);
+    CHECK(estimator.getFinishedRequestCount() == 0);
+    CHECK(estimator.getRequestsInProgress() == 1);
+  }
+
+  SECTION("measures the throughput of a single request") {
+    estimator.notifyRequestStarted(atSeconds(0.0));
+    estimator.notifyRequestFinished(atSeconds(0.0), atSeconds(2.0), 2000);
+    CHECK(estimator.getBytesPerSecond() == Approx(1000.0));
+    CHECK(estimator.getLatency() == Approx(2.0));
+    CHECK(estimator.getAverageResponseBytes() == Approx(2000.0));
+    CHECK(estimator.getFinishedRequestCount() == 1);
+    CHECK(estimator.getRequestsInProgress() == 0);
+
+    // With a smoothing of 1.0, each measurement replaces the last.
+    estimator.notifyRequestStarted(atSeconds(10.0));
+    estimator.notifyRequestFinished(atSeconds(10.0), atSeconds(11.0), 500);
+    CHECK(estimator.getBytesPerSecond() == Approx(500.0));
+    CHECK(estimator.getLatency() == Approx(1.0));
+    CHECK(estimator.getAverageResponseBytes() == Approx(500.0));
+  }
+
+  SECTION("measures simultaneous requests together") {
+    // Two requests that each take two seconds to receive 1000 bytes share a
+    // network of 1000 bytes per second.
+    estimator.notifyRequestStarted(atSeconds(0.0));
+    estimator.notifyRequestStarted(atSeconds(0.0));
+    estimator.notifyRequestFinished(atSeconds(0.0), atSeconds(2.0), 1000);
+    estimator.notifyRequestFinished(atSeconds(0.0), atSeconds(2.0), 1000);
+    CHECK(estimator.getBytesPerSecond() == Approx(1000.0));
+    CHECK(estimator.getLatency() == Approx(2.0));
+  }
+
+  SECTION("does not count time without requests in progress") {
+    estimator.notifyRequestStarted(atSeconds(0.0));
+    estimator.notifyRequestFinished(atSeconds(0.0), atSeconds(1.0), 1000);
+    estimator.notifyRequestStarted(atSeconds(5.0));
+    estimator.notifyRequestFinished(atSeconds(5.0), atSeconds(6.0), 1000);
+    CHECK(estimator.getBytesPerSecond() == Approx(1000.0));
+  }
+
+  SECTION("smooths the estimates") {
+    NetworkThroughputEstimator smoothed(0.5);
+    smoothed.notifyRequestStarted(atSeconds(0.0));
+    smoothed.notifyRequestFinished(atSeconds(0.0), atSeconds(1.0), 1000);
+    smoothed.notifyRequestStarted(atSeconds(2.0));
+    smoothed.notifyRequestFinished(atSeconds(2.0), atSeconds(5.0), 9000);
+    CHECK(smoothed.getBytesPerSecond() == Approx(2000.0));
+    CHECK(smoothed.getLatency() == Approx(2.0));
+    CHECK(smoothed.getAverageResponseBytes() == Approx(5000.0));
+  }
+}
+
+TEST_CASE("ThroughputMeasuringAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  auto pMockAccessor =
+      std::make_shared<MockAssetAccessor>(std::make_shared<MockAssetRequest>(
+          "GET",
+          "https://example.com/tile.glb",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(200),
+              "model/gltf-binary",
+              HttpHeaders{},
+              std::vector<std::byte>(100))));
+  auto pEstimator = std::make_shared<NetworkThroughputEstimator>();
+  auto pAccessor = std::make_shared<ThroughputMeasuringAssetAccessor>(
+      pMockAccessor,
+      pEstimator);
+
+  std::shared_ptr<IAssetRequest> pCompletedRequest =
+      pAccessor->get(asyncSystem, "https://example.com/tile.glb", {}).wait();
+  CHECK(pCompletedRequest == pMockAccessor->testRequest);
+
+  pAccessor
+      ->request(
+          asyncSystem,
+          "GET",
+          "https://example.com/tile.glb",
+          {},
+          std::vector<std::byte>())
+      .wait();
+
+  CHECK(pAccessor->getEstimator() == pEstimator);
+  CHECK(pEstimator->getFinishedRequestCount() == 2);
+  CHECK(pEstimator->getRequestsInProgress() == 0);
+  CHECK(pEstimator->getAverageResponseBytes() == Approx(100.0));
+}
@@ -0,0 +1,103 @@
+#include "CesiumAsync/NumaTaskProcessor.h"
+#include "CesiumAsync/TaskAffinity.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace CesiumAsync;
+
+TEST_CASE("NumaTaskProcessor") {
+  SECTION("creates one thread per CPU of each node with CPUs") {
+    NumaTaskProcessor processor({{{0, 1}}, {{}}, {{2}}}, false);
+    CHECK(processor.getNumberOfNodes() == 2);
+    CHECK(processor.getNumberOfThreads() == 3);
+  }
+
+  SECTION("uses every hardware thread when no node has a CPU") {
+    NumaTaskProcessor processor({}, false);
+    CHECK(processor.getNumberOfNodes() == 1);
+    CHECK(processor.getNumberOfThreads() >= 1);
+  }
+
+  SECTION("detects at least one node with a CPU") {
+    std::vector<NumaTaskProcessor::Node> nodes =
+        NumaTaskProcessor::detectNodes();
+    REQUIRE(!nodes.empty());
+    CHECK(!nodes[0].cpus.empty());
+  }
+
+  SECTION("runs every task, including tasks started by tasks") {
+    std::atomic<int32_t> count = 0;
+    {
+      NumaTaskProcessor processor({{{0}}, {{0}}, {{0}}}, false);
+
+      for (int32_t i = 0; i < 100; ++i) {
+        processor.startTask([&processor, &count]() {
+          ++count;
+          for (int32_t j = 0; j < 10; ++j) {
+            processor.startTask([&count]() { ++count; });
+          }
+        });
+      }
+
+      // The destructor waits for every queued task.
+    }
+
+    CHECK(count == 1100);
+  }
+
+  SECTION("runs tasks with the same affinity key on the same node") {
+    std::mutex mutex;
+    std::map<uint64_t, std::set<std::thread::id>> threadsByKey;
+
+    {
+      // One thread per node, so a node is identified by its thread.
+      NumaTaskProcessor processor({{{0}}, {{0}}, {{0}}, {{0}}}, false);
+
+      for (uint64_t key = 1; key <= 8; ++key) {
+        ScopedTaskAffinity affinity(key);
+        for (int32_t i = 0; i < 10; ++i) {
+          processor.startTask([&processor, &mutex, &threadsByKey]() {
+            const uint64_t currentKey = getCurrentTaskAffinity();
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              threadsByKey[currentKey].insert(std::this_thread::get_id());
+            }
+
+            // A task started by this task inherits its key.
+            processor.startTask([&mutex, &threadsByKey, currentKey]() {
+              std::lock_guard<std::mutex> lock(mutex);
+              CHECK(getCurrentTaskAffinity() == currentKey);
+              threadsByKey[currentKey].insert(std::this_thread::get_id());
+            });
+          });
+        }
+      }
+    }
+
+    CHECK(threadsByKey.size() == 8);
+    for (const auto& pair : threadsByKey) {
+      CHECK(pair.second.size() == 1);
+    }
+  }
+}
+
+TEST_CASE("ScopedTaskAffinity") {
+  CHECK(getCurrentTaskAffinity() == 0);
+  {
+    ScopedTaskAffinity outer(1);
+    CHECK(getCurrentTaskAffinity() == 1);
+    {
+      ScopedTaskAffinity inner(2);
+      CHECK(getCurrentTaskAffinity() == 2);
+    }
+    CHECK(getCurrentTaskAffinity() == 1);
+  }
+  CHECK(getCurrentTaskAffinity() == 0);
+}
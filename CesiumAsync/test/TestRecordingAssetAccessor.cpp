@@ -0,0 +1,103 @@
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumAsync/RecordingAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumAsync;
+
+namespace {
+
+std::shared_ptr<MockAssetRequest> createRequest(bool withResponse) {
+  std::unique_ptr<MockAssetResponse> pResponse;
+  if (withResponse) {
+    pResponse = std::make_unique<MockAssetResponse>(
+        static_cast<uint16_t>(200),
+        "application/json",
+        HttpHeaders{},
+        std::vector<std::byte>{std::byte(1), std::byte(2)});
+  }
+
+  return std::make_shared<MockAssetRequest>(
+      "GET",
+      "https://example.com/tileset.json",
+      HttpHeaders{},
+      std::move(pResponse));
+}
+
+} // namespace
+
+TEST_CASE("RecordingAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("records completed requests") {
+    auto pMockAccessor =
+        std::make_shared<MockAssetAccessor>(createRequest(true));
+    auto pAccessor = std::make_shared<RecordingAssetAccessor>(pMockAccessor);
+
+    auto pCompletedRequest =
+        pAccessor->get(asyncSystem, "https://example.com/tileset.json", {})
+            .wait();
+    REQUIRE(pCompletedRequest);
+    CHECK(pCompletedRequest == pMockAccessor->testRequest);
+
+    pAccessor
+        ->request(
+            asyncSystem,
+            "GET",
+            "https://example.com/tileset.json",
+            {},
+            std::vector<std::byte>())
+        .wait();
+
+    std::vector<std::shared_ptr<IAssetRequest>> recorded =
+        pAccessor->getRecordedRequests();
+    REQUIRE(recorded.size() == 2);
+    CHECK(recorded[0] == pMockAccessor->testRequest);
+    CHECK(recorded[1] == pMockAccessor->testRequest);
+    REQUIRE(recorded[0]->response());
+    CHECK(recorded[0]->response()->data().size() == 2);
+  }
+
+  SECTION("records each request of a batch") {
+    auto pAccessor = std::make_shared<RecordingAssetAccessor>(
+        std::make_shared<MockAssetAccessor>(createRequest(true)));
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> futures =
+        pAccessor->getBatch(
+            asyncSystem,
+            {"https://example.com/a.png", "https://example.com/b.png"},
+            {});
+    for (Future<std::shared_ptr<IAssetRequest>>& future : futures) {
+      std::move(future).wait();
+    }
+
+    CHECK(pAccessor->getRecordedRequests().size() == 2);
+  }
+
+  SECTION("doesn't record requests without a response") {
+    auto pAccessor = std::make_shared<RecordingAssetAccessor>(
+        std::make_shared<MockAssetAccessor>(createRequest(false)));
+
+    auto pCompletedRequest =
+        pAccessor->get(asyncSystem, "https://example.com/tileset.json", {})
+            .wait();
+    REQUIRE(pCompletedRequest);
+    CHECK(pCompletedRequest->response() == nullptr);
+    CHECK(pAccessor->getRecordedRequests().empty());
+  }
+
+  SECTION("forgets the recorded requests when cleared") {
+    auto pAccessor = std::make_shared<RecordingAssetAccessor>(
+        std::make_shared<MockAssetAccessor>(createRequest(true)));
+
+    pAccessor->get(asyncSystem, "https://example.com/tileset.json", {}).wait();
+    REQUIRE(pAccessor->getRecordedRequests().size() == 1);
+
+    pAccessor->clear();
+    CHECK(pAccessor->getRecordedRequests().empty());
+  }
+}
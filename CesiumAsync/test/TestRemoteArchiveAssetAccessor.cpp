@@ -0,0 +1,371 @@
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/RemoteArchiveAssetAccessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+template <typename T> void appendLittleEndian(std::string& out, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+// Builds a zip archive whose entries are all stored without compression, with
+// local extra fields of the given length.
+std::string createStoredZip(
+    const std::vector<std::pair<std::string, std::string>>& entries,
+    uint16_t localExtraLength = 0) {
+  std::string archive;
+  std::string centralDirectory;
+
+  for (const auto& [name, contents] : entries) {
+    const uint32_t localHeaderOffset = uint32_t(archive.size());
+
+    appendLittleEndian<uint32_t>(archive, 0x04034b50);
+    appendLittleEndian<uint16_t>(archive, 10); // version needed
+    appendLittleEndian<uint16_t>(archive, 0);  // flags
+    appendLittleEndian<uint16_t>(archive, 0);  // stored
+    appendLittleEndian<uint32_t>(archive, 0);  // time and date
+    appendLittleEndian<uint32_t>(archive, 0);  // CRC-32, unchecked
+    appendLittleEndian<uint32_t>(archive, uint32_t(contents.size()));
+    appendLittleEndian<uint32_t>(archive, uint32_t(contents.size()));
+    appendLittleEndian<uint16_t>(archive, uint16_t(name.size()));
+    appendLittleEndian<uint16_t>(archive, localExtraLength);
+    archive += name;
+    archive += std::string(localExtraLength, '\0');
+    archive += contents;
+
+    appendLittleEndian<uint32_t>(centralDirectory, 0x02014b50);
+    appendLittleEndian<uint16_t>(centralDirectory, 10); // version made by
+    appendLittleEndian<uint16_t>(centralDirectory, 10); // version needed
+    appendLittleEndian<uint16_t>(centralDirectory, 0);  // flags
+    appendLittleEndian<uint16_t>(centralDirectory, 0);  // stored
+    appendLittleEndian<uint32_t>(centralDirectory, 0);  // time and date
+    appendLittleEndian<uint32_t>(centralDirectory, 0);  // CRC-32
+    appendLittleEndian<uint32_t>(centralDirectory, uint32_t(contents.size()));
+    appendLittleEndian<uint32_t>(centralDirectory, uint32_t(contents.size()));
+    appendLittleEndian<uint16_t>(centralDirectory, uint16_t(name.size()));
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // extra field length
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // comment length
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // disk number
+    appendLittleEndian<uint16_t>(centralDirectory, 0); // internal attributes
+    appendLittleEndian<uint32_t>(centralDirectory, 0); // external attributes
+    appendLittleEndian<uint32_t>(centralDirectory, localHeaderOffset);
+    centralDirectory += name;
+  }
+
+  const uint32_t centralDirectoryOffset = uint32_t(archive.size());
+  archive += centralDirectory;
+
+  appendLittleEndian<uint32_t>(archive, 0x06054b50);
+  appendLittleEndian<uint16_t>(archive, 0); // disk number
+  appendLittleEndian<uint16_t>(archive, 0); // central directory disk
+  appendLittleEndian<uint16_t>(archive, uint16_t(entries.size()));
+  appendLittleEndian<uint16_t>(archive, uint16_t(entries.size()));
+  appendLittleEndian<uint32_t>(archive, uint32_t(centralDirectory.size()));
+  appendLittleEndian<uint32_t>(archive, centralDirectoryOffset);
+  appendLittleEndian<uint16_t>(archive, 0); // comment length
+
+  return archive;
+}
+
+std::vector<std::byte> toBytes(const std::string& s) {
+  std::vector<std::byte> result(s.size());
+  std::memcpy(result.data(), s.data(), s.size());
+  return result;
+}
+
+std::string asString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+// Serves one archive, and the ranges of it that are requested with a `Range`
+// header of the form `bytes=first-last` or `bytes=-length`.
+class RangeAssetAccessor : public IAssetAccessor {
+public:
+  RangeAssetAccessor(
+      const std::string& archiveUrl,
+      const std::string& archive,
+      bool supportsRanges = true)
+      : ranges(),
+        _archiveUrl(archiveUrl),
+        _archive(archive),
+        _supportsRanges(supportsRanges) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    HttpHeaders requestHeaders(headers.begin(), headers.end());
+    if (url != this->_archiveUrl) {
+      return createResponse(asyncSystem, url, requestHeaders, 404, {}, "");
+    }
+
+    auto it = requestHeaders.find("Range");
+    if (it == requestHeaders.end() || !this->_supportsRanges) {
+      return createResponse(
+          asyncSystem,
+          url,
+          requestHeaders,
+          200,
+          {},
+          this->_archive);
+    }
+
+    this->ranges.emplace_back(it->second);
+
+    const std::string range = it->second.substr(std::string("bytes=").size());
+    const size_t dash = range.find('-');
+    size_t first = 0;
+    size_t last = this->_archive.size() - 1;
+    if (dash == 0) {
+      const size_t length = std::stoull(range.substr(1));
+      first = length < this->_archive.size() ? this->_archive.size() - length
+                                             : 0;
+    } else {
+      first = std::stoull(range.substr(0, dash));
+      last = std::min(last, size_t(std::stoull(range.substr(dash + 1))));
+    }
+
+    return createResponse(
+        asyncSystem,
+        url,
+        requestHeaders,
+        206,
+        {{"Content-Range",
+          "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+              std::to_string(this->_archive.size())},
+         {"ETag", "\"archive\""}},
+        this->_archive.substr(first, last - first + 1));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /* contentPayload */) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  std::vector<std::string> ranges;
+
+private:
+  static Future<std::shared_ptr<IAssetRequest>> createResponse(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const std::string& body) {
+    return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+        std::make_shared<MockAssetRequest>(
+            "GET",
+            url,
+            requestHeaders,
+            std::make_unique<MockAssetResponse>(
+                statusCode,
+                "application/zip",
+                responseHeaders,
+                toBytes(body))));
+  }
+
+  std::string _archiveUrl;
+  std::string _archive;
+  bool _supportsRanges;
+};
+
+} // namespace
+
+TEST_CASE("RemoteArchiveAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  const std::string archiveUrl = "https://example.com/city.3tz?key=1";
+  const std::string archive = createStoredZip(
+      {{"tileset.json", "{\"root\":{}}"},
+       {"content/0.glb", "glTF-zero"},
+       {"content/1.glb", "glTF-one"}});
+
+  SECTION("reads entries with range requests") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(archiveUrl, archive);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pTileset =
+        accessor
+            .get(
+                asyncSystem,
+                "https://example.com/city.3tz/tileset.json?key=1",
+                {})
+            .wait();
+    CHECK(pTileset->url() == "https://example.com/city.3tz/tileset.json?key=1");
+    REQUIRE(pTileset->response());
+    CHECK(pTileset->response()->statusCode() == 200);
+    CHECK(asString(pTileset->response()->data()) == "{\"root\":{}}");
+    CHECK(pTileset->response()->headers().count("Content-Range") == 0);
+    CHECK(pTileset->response()->headers().count("ETag") == 1);
+
+    // The central directory and the entry.
+    CHECK(pRanges->ranges.size() == 2);
+
+    std::shared_ptr<IAssetRequest> pContent =
+        accessor
+            .get(
+                asyncSystem,
+                "https://example.com/city.3tz/content/1.glb?key=1",
+                {})
+            .wait();
+    REQUIRE(pContent->response());
+    CHECK(pContent->response()->statusCode() == 200);
+    CHECK(asString(pContent->response()->data()) == "glTF-one");
+
+    // The central directory is only requested once.
+    CHECK(pRanges->ranges.size() == 3);
+  }
+
+  SECTION("reports missing entries with a 404") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(archiveUrl, archive);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pMissing =
+        accessor
+            .get(
+                asyncSystem,
+                "https://example.com/city.3tz/content/2.glb?key=1",
+                {})
+            .wait();
+    REQUIRE(pMissing->response());
+    CHECK(pMissing->response()->statusCode() == 404);
+  }
+
+  SECTION("reports missing archives with their status code") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(archiveUrl, archive);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pMissing =
+        accessor
+            .get(asyncSystem, "https://example.com/town.3tz/tileset.json", {})
+            .wait();
+    REQUIRE(pMissing->response());
+    CHECK(pMissing->response()->statusCode() == 404);
+  }
+
+  SECTION("reads nearby entries of a batch with one request") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(archiveUrl, archive);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> requests =
+        accessor.getBatch(
+            asyncSystem,
+            {"https://example.com/city.3tz/content/1.glb?key=1",
+             "https://example.com/city.3tz/content/0.glb?key=1",
+             "https://example.com/other.json"},
+            {});
+    REQUIRE(requests.size() == 3);
+
+    std::shared_ptr<IAssetRequest> pOne = std::move(requests[0]).wait();
+    std::shared_ptr<IAssetRequest> pZero = std::move(requests[1]).wait();
+    std::shared_ptr<IAssetRequest> pOther = std::move(requests[2]).wait();
+    REQUIRE(pOne->response());
+    REQUIRE(pZero->response());
+    REQUIRE(pOther->response());
+    CHECK(asString(pOne->response()->data()) == "glTF-one");
+    CHECK(asString(pZero->response()->data()) == "glTF-zero");
+    CHECK(pOther->url() == "https://example.com/other.json");
+    CHECK(pOther->response()->statusCode() == 404);
+
+    // The central directory, and both entries together.
+    CHECK(pRanges->ranges.size() == 2);
+  }
+
+  SECTION("reads entries that are separated by more than the gap separately") {
+    // The estimated range of the first entry includes part of the second,
+    // but not the third.
+    auto pRanges = std::make_shared<RangeAssetAccessor>(
+        archiveUrl,
+        createStoredZip(
+            {{"content/0.glb", std::string(1000, 'a')},
+             {"content/1.glb", std::string(1000, 'b')},
+             {"content/2.glb", std::string(1000, 'c')}}));
+    RemoteArchiveAssetAccessor accessor(pRanges, 0);
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> requests =
+        accessor.getBatch(
+            asyncSystem,
+            {"https://example.com/city.3tz/content/0.glb?key=1",
+             "https://example.com/city.3tz/content/2.glb?key=1"},
+            {});
+    REQUIRE(requests.size() == 2);
+    CHECK(
+        asString(std::move(requests[0]).wait()->response()->data()) ==
+        std::string(1000, 'a'));
+    CHECK(
+        asString(std::move(requests[1]).wait()->response()->data()) ==
+        std::string(1000, 'c'));
+
+    // The central directory, and each entry.
+    CHECK(pRanges->ranges.size() == 3);
+  }
+
+  SECTION("requests the rest of entries with long local extra fields") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(
+        archiveUrl,
+        createStoredZip({{"tileset.json", "{\"root\":{}}"}}, 1000));
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pTileset =
+        accessor
+            .get(
+                asyncSystem,
+                "https://example.com/city.3tz/tileset.json?key=1",
+                {})
+            .wait();
+    REQUIRE(pTileset->response());
+    CHECK(pTileset->response()->statusCode() == 200);
+    CHECK(asString(pTileset->response()->data()) == "{\"root\":{}}");
+    CHECK(pRanges->ranges.size() == 3);
+  }
+
+  SECTION("supports servers that ignore ranges") {
+    auto pRanges =
+        std::make_shared<RangeAssetAccessor>(archiveUrl, archive, false);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pContent =
+        accessor
+            .get(
+                asyncSystem,
+                "https://example.com/city.3tz/content/0.glb?key=1",
+                {})
+            .wait();
+    REQUIRE(pContent->response());
+    CHECK(pContent->response()->statusCode() == 200);
+    CHECK(asString(pContent->response()->data()) == "glTF-zero");
+  }
+
+  SECTION("passes other URLs through") {
+    auto pRanges = std::make_shared<RangeAssetAccessor>(archiveUrl, archive);
+    RemoteArchiveAssetAccessor accessor(pRanges);
+
+    std::shared_ptr<IAssetRequest> pArchive =
+        accessor.get(asyncSystem, archiveUrl, {}).wait();
+    REQUIRE(pArchive->response());
+    CHECK(pArchive->response()->statusCode() == 200);
+    CHECK(pArchive->response()->data().size() == archive.size());
+    CHECK(pRanges->ranges.empty());
+  }
+}
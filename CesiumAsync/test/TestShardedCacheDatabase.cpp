@@ -0,0 +1,163 @@
+#include "CesiumAsync/MemoryCacheDatabase.h"
+#include "CesiumAsync/ShardedCacheDatabase.h"
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+bool storeEntry(ICacheDatabase& database, const std::string& key) {
+  const std::vector<std::byte> data{std::byte(1), std::byte(2)};
+  return database.storeEntry(
+      key,
+      std::time(nullptr) + 100,
+      "test.com/" + key,
+      "GET",
+      HttpHeaders{},
+      200,
+      HttpHeaders{{"Content-Type", "application/octet-stream"}},
+      data);
+}
+
+std::vector<std::shared_ptr<ICacheDatabase>> createMemoryShards(size_t count) {
+  std::vector<std::shared_ptr<ICacheDatabase>> shards;
+  for (size_t i = 0; i < count; ++i) {
+    shards.emplace_back(std::make_shared<MemoryCacheDatabase>(nullptr));
+  }
+  return shards;
+}
+
+} // namespace
+
+TEST_CASE("ShardedCacheDatabase") {
+  std::vector<std::shared_ptr<ICacheDatabase>> shards = createMemoryShards(4);
+  ShardedCacheDatabase database{std::vector(shards)};
+
+  SECTION("stores each key in one shard") {
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(storeEntry(database, "key" + std::to_string(i)));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+      const std::string key = "key" + std::to_string(i);
+      std::optional<CacheItem> maybeItem = database.getEntry(key);
+      REQUIRE(maybeItem);
+      CHECK(maybeItem->cacheRequest.url == "test.com/" + key);
+
+      const size_t shardIndex = database.getShardIndex(key);
+      for (size_t j = 0; j < shards.size(); ++j) {
+        CHECK(shards[j]->getEntry(key).has_value() == (j == shardIndex));
+      }
+    }
+
+    // Every shard receives some of the keys.
+    for (const std::shared_ptr<ICacheDatabase>& pShard : shards) {
+      CHECK(static_cast<MemoryCacheDatabase&>(*pShard).getTotalBytes() > 0);
+    }
+  }
+
+  SECTION("maps a key to the same shard every time") {
+    ShardedCacheDatabase other{createMemoryShards(4)};
+    for (int i = 0; i < 100; ++i) {
+      const std::string key = "key" + std::to_string(i);
+      CHECK(database.getShardIndex(key) == other.getShardIndex(key));
+    }
+  }
+
+  SECTION("stores many entries in their shards") {
+    std::vector<CacheEntry> entries;
+    for (int i = 0; i < 100; ++i) {
+      const std::string key = "key" + std::to_string(i);
+      entries.emplace_back(CacheEntry{
+          key,
+          CacheItem(
+              std::time(nullptr) + 100,
+              CacheRequest(HttpHeaders{}, "GET", "test.com/" + key),
+              CacheResponse(200, HttpHeaders{}, std::vector<std::byte>()))});
+    }
+
+    REQUIRE(database.storeEntries(entries) == entries.size());
+    for (const CacheEntry& entry : entries) {
+      CHECK(shards[database.getShardIndex(entry.key)]->getEntry(entry.key));
+    }
+  }
+
+  SECTION("clears every shard") {
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(storeEntry(database, "key" + std::to_string(i)));
+    }
+
+    REQUIRE(database.clearAll());
+    for (int i = 0; i < 100; ++i) {
+      CHECK(!database.getEntry("key" + std::to_string(i)));
+    }
+  }
+
+  SECTION("rejects missing shards") {
+    CHECK_THROWS_AS(
+        ShardedCacheDatabase(std::vector<std::shared_ptr<ICacheDatabase>>()),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        ShardedCacheDatabase(
+            std::vector<std::shared_ptr<ICacheDatabase>>{nullptr}),
+        std::invalid_argument);
+  }
+}
+
+TEST_CASE("ShardedCacheDatabase with Sqlite shards") {
+  ShardedCacheDatabase database{ShardedCacheDatabase::createSqliteShards(
+      spdlog::default_logger(),
+      "test-sharded.db",
+      4,
+      40)};
+  REQUIRE(database.getShards().size() == 4);
+  REQUIRE(database.clearAll());
+
+  // Store and look up entries on several threads at once.
+  std::atomic<int32_t> hits = 0;
+  std::vector<std::thread> threads;
+  for (int32_t thread = 0; thread < 4; ++thread) {
+    threads.emplace_back([&database, &hits, thread]() {
+      for (int32_t i = 0; i < 25; ++i) {
+        const std::string key =
+            "key" + std::to_string(thread) + "-" + std::to_string(i);
+        if (storeEntry(database, key) && database.getEntry(key)) {
+          ++hits;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  CHECK(hits == 100);
+
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(database.storeEntry(
+        "expired" + std::to_string(i),
+        std::time(nullptr) - 100,
+        "test.com",
+        "GET",
+        HttpHeaders{},
+        200,
+        HttpHeaders{},
+        std::vector<std::byte>()));
+  }
+
+  // Pruning removes the expired entries from every shard.
+  REQUIRE(database.prune());
+  for (int i = 0; i < 100; ++i) {
+    CHECK(!database.getEntry("expired" + std::to_string(i)));
+  }
+}
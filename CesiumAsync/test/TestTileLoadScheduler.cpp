@@ -0,0 +1,48 @@
+#include "CesiumAsync/TileLoadScheduler.h"
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumAsync;
+
+TEST_CASE("TileLoadScheduler") {
+  SECTION("limits the number of simultaneous loads") {
+    TileLoadScheduler scheduler(2);
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Normal));
+    scheduler.notifyLoadStarted();
+    scheduler.notifyLoadStarted();
+    CHECK(scheduler.getNumberOfLoadsInProgress() == 2);
+    CHECK(!scheduler.canStartLoad(TileLoadScheduler::Priority::Urgent));
+
+    scheduler.notifyLoadFinished();
+    CHECK(scheduler.getNumberOfLoadsInProgress() == 1);
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Normal));
+  }
+
+  SECTION("keeps reserved slots free for higher priorities") {
+    TileLoadScheduler scheduler(6, 2);
+    for (int i = 0; i < 2; ++i) {
+      scheduler.notifyLoadStarted();
+    }
+    CHECK(!scheduler.canStartLoad(TileLoadScheduler::Priority::Preload));
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Normal));
+
+    for (int i = 0; i < 2; ++i) {
+      scheduler.notifyLoadStarted();
+    }
+    CHECK(!scheduler.canStartLoad(TileLoadScheduler::Priority::Normal));
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Urgent));
+
+    for (int i = 0; i < 2; ++i) {
+      scheduler.notifyLoadStarted();
+    }
+    CHECK(!scheduler.canStartLoad(TileLoadScheduler::Priority::Urgent));
+  }
+
+  SECTION("always allows at least one load of every priority") {
+    TileLoadScheduler scheduler(2, 4);
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Preload));
+    scheduler.notifyLoadStarted();
+    CHECK(!scheduler.canStartLoad(TileLoadScheduler::Priority::Preload));
+    CHECK(scheduler.canStartLoad(TileLoadScheduler::Priority::Urgent));
+  }
+}
@@ -0,0 +1,117 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/TaskPriority.h"
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace CesiumAsync;
+
+TEST_CASE("WorkStealingTaskProcessor") {
+  SECTION("runs every task, including tasks started by tasks") {
+    std::atomic<int32_t> count = 0;
+    {
+      WorkStealingTaskProcessor processor(4);
+      CHECK(processor.getNumberOfThreads() == 4);
+
+      for (int32_t i = 0; i < 100; ++i) {
+        processor.startTask([&processor, &count]() {
+          ++count;
+          for (int32_t j = 0; j < 10; ++j) {
+            processor.startTask([&count]() { ++count; });
+          }
+        });
+      }
+
+      // The destructor waits for every queued task.
+    }
+
+    CHECK(count == 1100);
+  }
+
+  SECTION("runs higher priority tasks first") {
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    std::mutex mutex;
+    std::vector<TaskPriority> order;
+
+    {
+      WorkStealingTaskProcessor processor(1);
+
+      // Keep the only thread busy while the other tasks are queued.
+      processor.startTask([&started, released]() {
+        started.set_value();
+        released.wait();
+      });
+      started.get_future().wait();
+
+      auto record = [&mutex, &order](TaskPriority priority) {
+        return [&mutex, &order, priority]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(priority);
+        };
+      };
+
+      for (int32_t i = 0; i < 3; ++i) {
+        processor.startTaskWithPriority(
+            record(TaskPriority::Low),
+            TaskPriority::Low);
+        processor.startTask(record(TaskPriority::Normal));
+        processor.startTaskWithPriority(
+            record(TaskPriority::High),
+            TaskPriority::High);
+      }
+
+      release.set_value();
+    }
+
+    std::vector<TaskPriority> expected{
+        TaskPriority::High,
+        TaskPriority::High,
+        TaskPriority::High,
+        TaskPriority::Normal,
+        TaskPriority::Normal,
+        TaskPriority::Normal,
+        TaskPriority::Low,
+        TaskPriority::Low,
+        TaskPriority::Low};
+    CHECK(order == expected);
+  }
+
+  SECTION("worker thread continuations inherit the current priority") {
+    std::shared_ptr<WorkStealingTaskProcessor> pProcessor =
+        std::make_shared<WorkStealingTaskProcessor>(2);
+    AsyncSystem asyncSystem(pProcessor);
+
+    CHECK(getCurrentTaskPriority() == TaskPriority::Normal);
+
+    Future<TaskPriority> future = [&asyncSystem]() {
+      ScopedTaskPriority scope(TaskPriority::High);
+      CHECK(getCurrentTaskPriority() == TaskPriority::High);
+
+      return asyncSystem.runInWorkerThread(
+          []() { return getCurrentTaskPriority(); });
+    }();
+
+    CHECK(getCurrentTaskPriority() == TaskPriority::Normal);
+    CHECK(future.wait() == TaskPriority::High);
+
+    Future<TaskPriority> nested =
+        asyncSystem
+            .runInWorkerThread([asyncSystem]() {
+              ScopedTaskPriority scope(TaskPriority::Low);
+              return asyncSystem.createResolvedFuture().thenInWorkerThread(
+                  []() { return getCurrentTaskPriority(); });
+            })
+            .thenInWorkerThread(
+                [](TaskPriority priority) { return priority; });
+    CHECK(nested.wait() == TaskPriority::Low);
+  }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Library.h"
+#include "OrientedBoundingBox.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGeometry {
+
+/**
+ * @brief A uniform grid over a set of instances of a model, used to quickly
+ * find the instances within a view.
+ *
+ * The instances are ordered by the cell they are in, so that the instances of
+ * each cell, and of consecutive cells, form a contiguous range. The instance
+ * data must be stored in this order, given by {@link getInstanceOrder}, for the
+ * ranges to refer to it.
+ */
+class CESIUMGEOMETRY_API InstanceGrid final {
+public:
+  /**
+   * @brief A range of consecutive instances, in the order of the grid.
+   */
+  struct Range {
+    /**
+     * @brief The index of the first instance of the range.
+     */
+    uint32_t firstInstance;
+
+    /**
+     * @brief The number of instances in the range.
+     */
+    uint32_t instanceCount;
+  };
+
+  /**
+   * @brief A cell of the grid that contains at least one instance.
+   */
+  struct Cell {
+    /**
+     * @brief An axis-aligned box that encloses the instances of the cell.
+     */
+    OrientedBoundingBox boundingBox;
+
+    /**
+     * @brief The instances of the cell.
+     */
+    Range instances;
+  };
+
+  /**
+   * @brief Constructs a grid without any instances.
+   */
+  InstanceGrid() noexcept;
+
+  /**
+   * @brief Builds a grid over the given instances.
+   *
+   * @param centers The center of each instance.
+   * @param radii The radius of a sphere around the center of each instance
+   * that encloses it. It must have the same size as `centers`.
+   * @param targetInstancesPerCell The average number of instances to put in
+   * each cell. The instances are not usually spread evenly, so some cells have
+   * more.
+   */
+  InstanceGrid(
+      const std::vector<glm::dvec3>& centers,
+      const std::vector<double>& radii,
+      uint32_t targetInstancesPerCell = 256);
+
+  /**
+   * @brief Gets the number of instances in the grid.
+   */
+  size_t getInstanceCount() const noexcept {
+    return this->_instanceOrder.size();
+  }
+
+  /**
+   * @brief Gets the cells of the grid that contain instances, in the order of
+   * their instances.
+   */
+  const std::vector<Cell>& getCells() const noexcept { return this->_cells; }
+
+  /**
+   * @brief Gets the original index of each instance, in the order of the grid.
+   */
+  const std::vector<uint32_t>& getInstanceOrder() const noexcept {
+    return this->_instanceOrder;
+  }
+
+private:
+  std::vector<Cell> _cells;
+  std::vector<uint32_t> _instanceOrder;
+};
+
+} // namespace CesiumGeometry
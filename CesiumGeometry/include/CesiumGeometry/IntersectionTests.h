@@ -10,6 +10,8 @@
 namespace CesiumGeometry {
 class Ray;
 class Plane;
+struct AxisAlignedBox;
+class OrientedBoundingBox;
 
 /**
  * @brief Functions for computing the intersection between geometries such as
@@ -28,6 +30,49 @@ public:
   static std::optional<glm::dvec3>
   rayPlane(const Ray& ray, const Plane& plane) noexcept;
 
+  /**
+   * @brief Computes the intersection of a ray and a triangle.
+   *
+   * @param ray The ray.
+   * @param p0 The first vertex of the triangle.
+   * @param p1 The second vertex of the triangle.
+   * @param p2 The third vertex of the triangle.
+   * @param cullBackFaces Whether to ignore the triangle when the ray hits it
+   * from behind, where the vertices are in clockwise order.
+   * @return The distance along the ray to the point of intersection, or
+   * `std::nullopt` if there is no intersection.
+   */
+  static std::optional<double> rayTriangleParametric(
+      const Ray& ray,
+      const glm::dvec3& p0,
+      const glm::dvec3& p1,
+      const glm::dvec3& p2,
+      bool cullBackFaces = false) noexcept;
+
+  /**
+   * @brief Computes the intersection of a ray and an axis-aligned box.
+   *
+   * @param ray The ray.
+   * @param aabb The box.
+   * @return The distance along the ray to the point where it enters the box,
+   * which is 0 if the origin of the ray is inside it, or `std::nullopt` if
+   * there is no intersection.
+   */
+  static std::optional<double>
+  rayAABBParametric(const Ray& ray, const AxisAlignedBox& aabb) noexcept;
+
+  /**
+   * @brief Computes the intersection of a ray and an oriented bounding box.
+   *
+   * @param ray The ray.
+   * @param obb The box.
+   * @return The distance along the ray to the point where it enters the box,
+   * which is 0 if the origin of the ray is inside it, or `std::nullopt` if
+   * there is no intersection.
+   */
+  static std::optional<double>
+  rayOBBParametric(const Ray& ray, const OrientedBoundingBox& obb) noexcept;
+
   /**
    * @brief Determines whether a given point is completely inside a triangle
    * defined by three 2D points.
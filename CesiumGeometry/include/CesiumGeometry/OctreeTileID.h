@@ -2,7 +2,9 @@
 
 #include "Library.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 namespace CesiumGeometry {
 
@@ -74,3 +76,21 @@ struct CESIUMGEOMETRY_API OctreeTileID {
 };
 
 } // namespace CesiumGeometry
+
+namespace std {
+
+/**
+ * @brief A hash function for {@link CesiumGeometry::OctreeTileID} objects.
+ */
+template <> struct hash<CesiumGeometry::OctreeTileID> {
+
+  /**
+   * @brief A specialization of the `std::hash` template for
+   * {@link CesiumGeometry::OctreeTileID} objects.
+   */
+  size_t operator()(const CesiumGeometry::OctreeTileID& key) const noexcept {
+    std::hash<uint32_t> h;
+    return h(key.level) ^ (h(key.x) << 1) ^ (h(key.y) << 2) ^ (h(key.z) << 3);
+  }
+};
+} // namespace std
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGeometry {
+
+class BoundingSphere;
+class OrientedBoundingBox;
+class Plane;
+
+/**
+ * @brief A batch of bounding spheres and oriented bounding boxes, stored as a
+ * structure of arrays so that they can be culled against a plane in a single
+ * pass.
+ *
+ * Each volume is stored as a center, a radius, and three half-axes. A sphere
+ * has zero-length half-axes and an oriented bounding box has a zero radius,
+ * so every volume is tested against a plane with the same branch-free
+ * arithmetic, which compilers are able to vectorize.
+ */
+class CESIUMGEOMETRY_API PackedBoundingVolumes final {
+public:
+  /**
+   * @brief Gets the number of bounding volumes in this batch.
+   */
+  size_t size() const noexcept { return this->_centerX.size(); }
+
+  /**
+   * @brief Determines whether this batch contains no bounding volumes.
+   */
+  bool empty() const noexcept { return this->_centerX.empty(); }
+
+  /**
+   * @brief Reserves space for the given number of bounding volumes.
+   *
+   * @param count The number of bounding volumes.
+   */
+  void reserve(size_t count);
+
+  /**
+   * @brief Removes all bounding volumes from this batch, retaining the
+   * allocated storage.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Adds a bounding sphere to the end of this batch.
+   *
+   * @param sphere The bounding sphere.
+   */
+  void addBoundingSphere(const BoundingSphere& sphere);
+
+  /**
+   * @brief Adds an oriented bounding box to the end of this batch.
+   *
+   * @param box The oriented bounding box.
+   */
+  void addOrientedBoundingBox(const OrientedBoundingBox& box);
+
+  /**
+   * @brief Clears the visibility flag of every bounding volume that lies
+   * entirely on the negative side of a plane.
+   *
+   * Flags of volumes that are at least partially on the positive side of the
+   * plane are left unchanged, so calling this once for each plane of a
+   * culling volume leaves a nonzero flag only for the volumes that are not
+   * outside of any plane. A volume that exactly touches the plane from the
+   * negative side is considered to be on the positive side.
+   *
+   * @param plane The plane to test against.
+   * @param visibility One flag for each bounding volume in this batch. Must
+   * contain at least {@link size} elements.
+   */
+  void
+  cullAgainstPlane(const Plane& plane, gsl::span<uint8_t> visibility) const;
+
+private:
+  std::vector<double> _centerX;
+  std::vector<double> _centerY;
+  std::vector<double> _centerZ;
+  std::vector<double> _radius;
+
+  // The components of the three half-axes, in the order x0, y0, z0, x1, ...
+  std::array<std::vector<double>, 9> _halfAxes;
+};
+
+} // namespace CesiumGeometry
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace CesiumGeometry {
@@ -160,6 +161,11 @@ private:
   uint32_t _maximumLevel;
   uint32_t _maximumChildrenSubtrees;
   std::unique_ptr<AvailabilityNode> _pRoot;
+
+  // The node of each subtree, keyed by the ID of the subtree's root tile, so
+  // that the subtree containing a tile is found without walking down to it
+  // from the root.
+  std::unordered_map<QuadtreeTileID, const AvailabilityNode*> _subtreeNodes;
 };
 
 } // namespace CesiumGeometry
@@ -7,7 +7,8 @@
 
 #include <glm/vec2.hpp>
 
-#include <memory>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace CesiumGeometry {
@@ -64,58 +65,61 @@ public:
    */
   uint8_t isTileAvailable(const QuadtreeTileID& id) const noexcept;
 
+  /**
+   * @brief Returns whether each of the four children of a tile is available.
+   *
+   * This gives the same flags as calling {@link isTileAvailable} for each
+   * child, but the quadtree is only descended once to the given tile.
+   *
+   * @param id The quadtree tile ID of the parent tile.
+   * @returns The {@link CesiumGeometry::TileAvailabilityFlags} of the
+   * children, in the order lower left, lower right, upper left, upper right.
+   */
+  std::array<uint8_t, 4>
+  areChildTilesAvailable(const QuadtreeTileID& id) const noexcept;
+
 private:
-  struct RectangleWithLevel {
-    uint32_t level;
-    Rectangle rectangle;
-  };
+  static constexpr uint32_t noIndex = ~uint32_t(0);
 
+  // The nodes are kept in a single vector and refer to each other by index.
+  // The root nodes come first, row by row, and the four children of a node are
+  // next to each other in Morton order: lower left, lower right, upper left,
+  // upper right.
   struct QuadtreeNode {
-    QuadtreeNode(
-        const QuadtreeTileID& id_,
-        const Rectangle& extent_,
-        QuadtreeNode* pParent_) noexcept
-        : id(id_),
-          extent(extent_),
-          pParent(pParent_),
-          ll(),
-          lr(),
-          ul(),
-          ur(),
-          rectangles() {}
-
     QuadtreeTileID id;
+    Rectangle extent;
+    uint32_t parent;
+    uint32_t firstChild;
+    // The first of the node's rectangles, which are linked from the highest
+    // level to the lowest.
+    uint32_t firstRectangle;
+  };
 
-    CesiumGeometry::Rectangle extent;
-
-    QuadtreeNode* pParent;
-    std::unique_ptr<QuadtreeNode> ll;
-    std::unique_ptr<QuadtreeNode> lr;
-    std::unique_ptr<QuadtreeNode> ul;
-    std::unique_ptr<QuadtreeNode> ur;
-
-    std::vector<RectangleWithLevel> rectangles;
+  // The rectangles of all nodes, as a structure of arrays.
+  struct Rectangles {
+    std::vector<uint32_t> level;
+    std::vector<double> minimumX;
+    std::vector<double> minimumY;
+    std::vector<double> maximumX;
+    std::vector<double> maximumY;
+    std::vector<uint32_t> next;
   };
 
   QuadtreeTilingScheme _tilingScheme;
   uint32_t _maximumLevel;
-  std::vector<std::unique_ptr<QuadtreeNode>> _rootNodes;
-
-  static void putRectangleInQuadtree(
-      const QuadtreeTilingScheme& tilingScheme,
-      uint32_t maximumLevel,
-      QuadtreeRectangleAvailability::QuadtreeNode& node,
-      const QuadtreeRectangleAvailability::RectangleWithLevel&
-          rectangle) noexcept;
-  static bool rectangleLevelComparator(
-      const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-      const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept;
-  static uint32_t findMaxLevelFromNode(
-      QuadtreeNode* pStopNode,
-      QuadtreeNode& node,
-      const glm::dvec2& position) noexcept;
-  static void createNodeChildrenIfNecessary(
-      QuadtreeNode& node,
-      const QuadtreeTilingScheme& tilingScheme) noexcept;
+  uint32_t _rootNodeCount;
+  std::vector<QuadtreeNode> _nodes;
+  Rectangles _rectangles;
+
+  void putRectangleInQuadtree(
+      uint32_t nodeIndex,
+      uint32_t level,
+      const Rectangle& rectangle) noexcept;
+  uint32_t findMaxLevelFromNode(
+      uint32_t stopNodeIndex,
+      uint32_t nodeIndex,
+      const glm::dvec2& position) const noexcept;
+  uint32_t findRootNode(const glm::dvec2& position) const noexcept;
+  void createNodeChildrenIfNecessary(uint32_t nodeIndex) noexcept;
 };
 } // namespace CesiumGeometry
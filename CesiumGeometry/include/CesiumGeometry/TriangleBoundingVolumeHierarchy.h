@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Library.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace CesiumGeometry {
+
+class Ray;
+
+/**
+ * @brief A bounding volume hierarchy of axis-aligned boxes over a set of
+ * triangles, used to quickly find where a ray first hits them.
+ *
+ * The nodes are stored depth first in a single array, so the first child of a
+ * node directly follows it. The triangles are reordered so that each leaf
+ * refers to a contiguous range of them.
+ */
+class CESIUMGEOMETRY_API TriangleBoundingVolumeHierarchy final {
+public:
+  /**
+   * @brief Constructs a hierarchy without any triangles.
+   */
+  TriangleBoundingVolumeHierarchy() noexcept;
+
+  /**
+   * @brief Builds a hierarchy over the given triangles.
+   *
+   * @param triangleVertices The vertices of the triangles, three per triangle.
+   * Any vertices beyond the last complete triangle are ignored.
+   * @param maximumTrianglesPerLeaf The maximum number of triangles in a leaf
+   * of the hierarchy.
+   */
+  explicit TriangleBoundingVolumeHierarchy(
+      std::vector<glm::dvec3>&& triangleVertices,
+      uint32_t maximumTrianglesPerLeaf = 4);
+
+  /**
+   * @brief Gets the number of triangles in the hierarchy.
+   */
+  size_t getTriangleCount() const noexcept {
+    return this->_triangleVertices.size() / 3;
+  }
+
+  /**
+   * @brief Gets the number of nodes in the hierarchy.
+   */
+  size_t getNodeCount() const noexcept { return this->_nodes.size(); }
+
+  /**
+   * @brief Computes where a ray first hits any of the triangles.
+   *
+   * @param ray The ray.
+   * @param maximumDistance Hits farther along the ray than this distance are
+   * ignored.
+   * @return The distance along the ray to the closest hit, or `std::nullopt`
+   * if the ray doesn't hit any of the triangles.
+   */
+  std::optional<double> intersectRayParametric(
+      const Ray& ray,
+      double maximumDistance =
+          std::numeric_limits<double>::max()) const noexcept;
+
+private:
+  struct Node {
+    glm::dvec3 minimum;
+    glm::dvec3 maximum;
+    // For a leaf, the index of its first triangle. Otherwise, the index of its
+    // second child.
+    uint32_t index;
+    // The number of triangles of a leaf, or 0 if this node has children.
+    uint32_t triangleCount;
+  };
+
+  uint32_t buildNode(
+      std::vector<uint32_t>& triangles,
+      const std::vector<glm::dvec3>& centroids,
+      uint32_t begin,
+      uint32_t end,
+      uint32_t maximumTrianglesPerLeaf);
+
+  std::vector<Node> _nodes;
+  std::vector<glm::dvec3> _triangleVertices;
+};
+
+} // namespace CesiumGeometry
@@ -0,0 +1,119 @@
+#include "CesiumGeometry/InstanceGrid.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace CesiumGeometry {
+
+InstanceGrid::InstanceGrid() noexcept : _cells(), _instanceOrder() {}
+
+InstanceGrid::InstanceGrid(
+    const std::vector<glm::dvec3>& centers,
+    const std::vector<double>& radii,
+    uint32_t targetInstancesPerCell)
+    : _cells(), _instanceOrder() {
+  const uint32_t instanceCount =
+      static_cast<uint32_t>(std::min(centers.size(), radii.size()));
+  if (instanceCount == 0) {
+    return;
+  }
+
+  glm::dvec3 minimum = centers[0];
+  glm::dvec3 maximum = centers[0];
+  for (uint32_t i = 1; i < instanceCount; ++i) {
+    minimum = glm::min(minimum, centers[i]);
+    maximum = glm::max(maximum, centers[i]);
+  }
+
+  // The cells are cubes over only the axes along which the instances are
+  // spread, so that instances along a plane or a line get a grid of one or two
+  // dimensions.
+  const glm::dvec3 extent = maximum - minimum;
+  const double minimumExtent =
+      glm::max(extent.x, glm::max(extent.y, extent.z)) * 1e-6;
+  const double targetCellCount = glm::max(
+      1.0,
+      double(instanceCount) / double(glm::max(targetInstancesPerCell, 1U)));
+
+  double volume = 1.0;
+  int spreadAxes = 0;
+  for (glm::length_t i = 0; i < 3; ++i) {
+    if (extent[i] > minimumExtent) {
+      volume *= extent[i];
+      ++spreadAxes;
+    }
+  }
+
+  glm::dvec3 dimensions(1.0);
+  if (spreadAxes > 0) {
+    const double cellSize =
+        std::pow(volume / targetCellCount, 1.0 / double(spreadAxes));
+    for (glm::length_t i = 0; i < 3; ++i) {
+      if (extent[i] > minimumExtent) {
+        dimensions[i] =
+            glm::clamp(std::ceil(extent[i] / cellSize), 1.0, 1024.0);
+      }
+    }
+  }
+
+  std::vector<uint64_t> cellIndices(instanceCount);
+  for (uint32_t i = 0; i < instanceCount; ++i) {
+    glm::dvec3 cell(0.0);
+    for (glm::length_t j = 0; j < 3; ++j) {
+      if (extent[j] > minimumExtent) {
+        const double fraction = (centers[i][j] - minimum[j]) / extent[j];
+        cell[j] =
+            glm::min(std::floor(fraction * dimensions[j]), dimensions[j] - 1.0);
+      }
+    }
+    cellIndices[i] =
+        (uint64_t(cell.z) * uint64_t(dimensions.y) + uint64_t(cell.y)) *
+            uint64_t(dimensions.x) +
+        uint64_t(cell.x);
+  }
+
+  this->_instanceOrder.resize(instanceCount);
+  std::iota(this->_instanceOrder.begin(), this->_instanceOrder.end(), 0U);
+  std::stable_sort(
+      this->_instanceOrder.begin(),
+      this->_instanceOrder.end(),
+      [&cellIndices](uint32_t a, uint32_t b) {
+        return cellIndices[a] < cellIndices[b];
+      });
+
+  uint32_t first = 0;
+  while (first < instanceCount) {
+    const uint64_t cellIndex = cellIndices[this->_instanceOrder[first]];
+    glm::dvec3 cellMinimum(std::numeric_limits<double>::max());
+    glm::dvec3 cellMaximum(std::numeric_limits<double>::lowest());
+
+    uint32_t end = first;
+    for (; end < instanceCount &&
+           cellIndices[this->_instanceOrder[end]] == cellIndex;
+         ++end) {
+      const uint32_t instance = this->_instanceOrder[end];
+      cellMinimum = glm::min(cellMinimum, centers[instance] - radii[instance]);
+      cellMaximum = glm::max(cellMaximum, centers[instance] + radii[instance]);
+    }
+
+    // Keep the box invertible even for a single point.
+    const glm::dvec3 halfExtent =
+        glm::max((cellMaximum - cellMinimum) * 0.5, glm::dvec3(1e-9));
+    this->_cells.emplace_back(Cell{
+        OrientedBoundingBox(
+            (cellMinimum + cellMaximum) * 0.5,
+            glm::dmat3(
+                glm::dvec3(halfExtent.x, 0.0, 0.0),
+                glm::dvec3(0.0, halfExtent.y, 0.0),
+                glm::dvec3(0.0, 0.0, halfExtent.z))),
+        Range{first, end - first}});
+
+    first = end;
+  }
+}
+
+} // namespace CesiumGeometry
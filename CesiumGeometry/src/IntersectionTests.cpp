@@ -1,5 +1,7 @@
 #include "CesiumGeometry/IntersectionTests.h"
 
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
@@ -8,10 +10,51 @@
 #include <glm/geometric.hpp>
 #include <glm/gtx/norm.hpp>
 
+#include <limits>
+#include <utility>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeometry {
 
+namespace {
+// Intersects the ray origin + t * direction with the box from minimum to
+// maximum, with slabs. The direction does not have to be normalized.
+std::optional<double> raySlabsParametric(
+    const glm::dvec3& origin,
+    const glm::dvec3& direction,
+    const glm::dvec3& minimum,
+    const glm::dvec3& maximum) noexcept {
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+
+  for (glm::length_t i = 0; i < 3; ++i) {
+    if (glm::abs(direction[i]) < Math::Epsilon15) {
+      // Parallel to this slab, so the origin must be inside it.
+      if (origin[i] < minimum[i] || origin[i] > maximum[i]) {
+        return std::nullopt;
+      }
+      continue;
+    }
+
+    const double inverseDirection = 1.0 / direction[i];
+    double t0 = (minimum[i] - origin[i]) * inverseDirection;
+    double t1 = (maximum[i] - origin[i]) * inverseDirection;
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+
+    tMin = glm::max(tMin, t0);
+    tMax = glm::min(tMax, t1);
+    if (tMin > tMax) {
+      return std::nullopt;
+    }
+  }
+
+  return tMin;
+}
+} // namespace
+
 /*static*/ std::optional<glm::dvec3>
 IntersectionTests::rayPlane(const Ray& ray, const Plane& plane) noexcept {
   const double denominator = glm::dot(plane.getNormal(), ray.getDirection());
@@ -32,6 +75,76 @@ IntersectionTests::rayPlane(const Ray& ray, const Plane& plane) noexcept {
   return ray.getOrigin() + ray.getDirection() * t;
 }
 
+/*static*/ std::optional<double> IntersectionTests::rayTriangleParametric(
+    const Ray& ray,
+    const glm::dvec3& p0,
+    const glm::dvec3& p1,
+    const glm::dvec3& p2,
+    bool cullBackFaces) noexcept {
+  // Moller-Trumbore
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3& direction = ray.getDirection();
+
+  const glm::dvec3 edge0 = p1 - p0;
+  const glm::dvec3 edge1 = p2 - p0;
+
+  const glm::dvec3 p = glm::cross(direction, edge1);
+  const double determinant = glm::dot(edge0, p);
+
+  if (cullBackFaces) {
+    if (determinant < Math::Epsilon12) {
+      return std::nullopt;
+    }
+  } else if (glm::abs(determinant) < Math::Epsilon12) {
+    return std::nullopt;
+  }
+
+  const double inverseDeterminant = 1.0 / determinant;
+
+  const glm::dvec3 tvec = origin - p0;
+  const double u = glm::dot(tvec, p) * inverseDeterminant;
+  if (u < 0.0 || u > 1.0) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3 q = glm::cross(tvec, edge0);
+  const double v = glm::dot(direction, q) * inverseDeterminant;
+  if (v < 0.0 || u + v > 1.0) {
+    return std::nullopt;
+  }
+
+  const double t = glm::dot(edge1, q) * inverseDeterminant;
+  if (t < 0.0) {
+    return std::nullopt;
+  }
+
+  return t;
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayAABBParametric(
+    const Ray& ray,
+    const AxisAlignedBox& aabb) noexcept {
+  return raySlabsParametric(
+      ray.getOrigin(),
+      ray.getDirection(),
+      glm::dvec3(aabb.minimumX, aabb.minimumY, aabb.minimumZ),
+      glm::dvec3(aabb.maximumX, aabb.maximumY, aabb.maximumZ));
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayOBBParametric(
+    const Ray& ray,
+    const OrientedBoundingBox& obb) noexcept {
+  // In the space of the box it spans -1 to 1 on each axis. The distance along
+  // the ray is the same in both spaces, because the direction isn't
+  // normalized again.
+  const glm::dmat3& inverseHalfAxes = obb.getInverseHalfAxes();
+  return raySlabsParametric(
+      inverseHalfAxes * (ray.getOrigin() - obb.getCenter()),
+      inverseHalfAxes * ray.getDirection(),
+      glm::dvec3(-1.0),
+      glm::dvec3(1.0));
+}
+
 bool IntersectionTests::pointInTriangle(
     const glm::dvec2& point,
     const glm::dvec2& triangleVertA,
@@ -32,6 +32,65 @@ static uint32_t getMortonIndex(uint32_t x, uint32_t y, uint32_t z) {
   return spread3(z) << 2 | spread3(y) << 1 | spread3(x);
 }
 
+// Computes the availability of a tile from the loaded subtree that contains it,
+// where the tile is the given number of levels below the subtree's root.
+static uint8_t computeAvailabilityWithinSubtree(
+    const OctreeTileID& tileID,
+    const AvailabilitySubtree& subtree,
+    uint32_t relativeLevel) noexcept {
+  AvailabilityAccessor tileAvailabilityAccessor(
+      subtree.tileAvailability,
+      subtree);
+  AvailabilityAccessor contentAvailabilityAccessor(
+      subtree.contentAvailability,
+      subtree);
+
+  uint32_t subtreeRelativeMask = ~(0xFFFFFFFF << relativeLevel);
+
+  uint8_t availability = TileAvailabilityFlags::REACHABLE;
+
+  uint32_t relativeMortonIndex = getMortonIndex(
+      tileID.x & subtreeRelativeMask,
+      tileID.y & subtreeRelativeMask,
+      tileID.z & subtreeRelativeMask);
+
+  // For reference:
+  // https://github.com/CesiumGS/3d-tiles/tree/3d-tiles-next/extensions/3DTILES_implicit_tiling#availability-bitstream-lengths
+  // The below is identical to:
+  // (8^levelRelativeToSubtree - 1) / 7
+  uint32_t offset = ((1U << (3U * relativeLevel)) - 1U) / 7U;
+
+  uint32_t availabilityIndex = relativeMortonIndex + offset;
+  uint32_t byteIndex = availabilityIndex >> 3;
+  uint8_t bitIndex = static_cast<uint8_t>(availabilityIndex & 7);
+  uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
+
+  // Check tile availability.
+  if ((tileAvailabilityAccessor.isConstant() &&
+       tileAvailabilityAccessor.getConstant()) ||
+      (tileAvailabilityAccessor.isBufferView() &&
+       (uint8_t)tileAvailabilityAccessor[byteIndex] & bitMask)) {
+    availability |= TileAvailabilityFlags::TILE_AVAILABLE;
+  }
+
+  // Check content availability.
+  if ((contentAvailabilityAccessor.isConstant() &&
+       contentAvailabilityAccessor.getConstant()) ||
+      (contentAvailabilityAccessor.isBufferView() &&
+       (uint8_t)contentAvailabilityAccessor[byteIndex] & bitMask)) {
+    availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
+  }
+
+  // If this is the 0th level within the subtree, we know this tile's
+  // subtree is available and loaded.
+  if (relativeLevel == 0) {
+    availability |= TileAvailabilityFlags::SUBTREE_AVAILABLE;
+    availability |= TileAvailabilityFlags::SUBTREE_LOADED;
+  }
+
+  return availability;
+}
+
 OctreeAvailability::OctreeAvailability(
     uint32_t subtreeLevels,
     uint32_t maximumLevel) noexcept
@@ -53,18 +112,27 @@ uint8_t OctreeAvailability::computeAvailability(
     return 0;
   }
 
+  // Look up the subtree that contains the tile. When it is loaded, the tile's
+  // availability is read from it instead of walking down to it from the root.
+  const uint32_t relativeLevel = tileID.level % this->_subtreeLevels;
+  const auto subtreeIt = this->_subtreeNodes.find(OctreeTileID(
+      tileID.level - relativeLevel,
+      tileID.x >> relativeLevel,
+      tileID.y >> relativeLevel,
+      tileID.z >> relativeLevel));
+  if (subtreeIt != this->_subtreeNodes.end() && subtreeIt->second->subtree) {
+    return computeAvailabilityWithinSubtree(
+        tileID,
+        *subtreeIt->second->subtree,
+        relativeLevel);
+  }
+
   uint32_t level = 0;
   AvailabilityNode* pNode = this->_pRoot.get();
 
   while (pNode && pNode->subtree && tileID.level >= level) {
     const AvailabilitySubtree& subtree = *pNode->subtree;
 
-    AvailabilityAccessor tileAvailabilityAccessor(
-        subtree.tileAvailability,
-        subtree);
-    AvailabilityAccessor contentAvailabilityAccessor(
-        subtree.contentAvailability,
-        subtree);
     AvailabilityAccessor subtreeAvailabilityAccessor(
         subtree.subtreeAvailability,
         subtree);
@@ -74,48 +142,7 @@ uint8_t OctreeAvailability::computeAvailability(
 
     if (levelsLeft < this->_subtreeLevels) {
       // The availability info is within this subtree.
-      uint8_t availability = TileAvailabilityFlags::REACHABLE;
-
-      uint32_t relativeMortonIndex = getMortonIndex(
-          tileID.x & subtreeRelativeMask,
-          tileID.y & subtreeRelativeMask,
-          tileID.z & subtreeRelativeMask);
-
-      // For reference:
-      // https://github.com/CesiumGS/3d-tiles/tree/3d-tiles-next/extensions/3DTILES_implicit_tiling#availability-bitstream-lengths
-      // The below is identical to:
-      // (8^levelRelativeToSubtree - 1) / 7
-      uint32_t offset = ((1U << (3U * levelsLeft)) - 1U) / 7U;
-
-      uint32_t availabilityIndex = relativeMortonIndex + offset;
-      uint32_t byteIndex = availabilityIndex >> 3;
-      uint8_t bitIndex = static_cast<uint8_t>(availabilityIndex & 7);
-      uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-      // Check tile availability.
-      if ((tileAvailabilityAccessor.isConstant() &&
-           tileAvailabilityAccessor.getConstant()) ||
-          (tileAvailabilityAccessor.isBufferView() &&
-           (uint8_t)tileAvailabilityAccessor[byteIndex] & bitMask)) {
-        availability |= TileAvailabilityFlags::TILE_AVAILABLE;
-      }
-
-      // Check content availability.
-      if ((contentAvailabilityAccessor.isConstant() &&
-           contentAvailabilityAccessor.getConstant()) ||
-          (contentAvailabilityAccessor.isBufferView() &&
-           (uint8_t)contentAvailabilityAccessor[byteIndex] & bitMask)) {
-        availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
-      }
-
-      // If this is the 0th level within the subtree, we know this tile's
-      // subtree is available and loaded.
-      if (levelsLeft == 0) {
-        availability |= TileAvailabilityFlags::SUBTREE_AVAILABLE;
-        availability |= TileAvailabilityFlags::SUBTREE_LOADED;
-      }
-
-      return availability;
+      return computeAvailabilityWithinSubtree(tileID, subtree, levelsLeft);
     }
 
     uint32_t levelsLeftAfterNextLevel = levelsLeft - this->_subtreeLevels;
@@ -197,6 +224,7 @@ bool OctreeAvailability::addSubtree(
       this->_pRoot->setLoadedSubtree(
           std::move(newSubtree),
           this->_maximumChildrenSubtrees);
+      this->_subtreeNodes.emplace(OctreeTileID(0, 0, 0, 0), this->_pRoot.get());
       return true;
     }
   }
@@ -280,6 +308,9 @@ bool OctreeAvailability::addSubtree(
         pNode->childNodes[childSubtreeIndex]->setLoadedSubtree(
             std::move(newSubtree),
             this->_maximumChildrenSubtrees);
+        this->_subtreeNodes.emplace(
+            tileID,
+            pNode->childNodes[childSubtreeIndex].get());
         return true;
       } else {
         // We need to traverse this child subtree to find where to add the new
@@ -314,61 +345,14 @@ uint8_t OctreeAvailability::computeAvailability(
     return 0;
   }
 
-  AvailabilityAccessor tileAvailabilityAccessor(
-      pNode->subtree->tileAvailability,
-      *pNode->subtree);
-  AvailabilityAccessor contentAvailabilityAccessor(
-      pNode->subtree->contentAvailability,
-      *pNode->subtree);
-  AvailabilityAccessor subtreeAvailability(
-      pNode->subtree->subtreeAvailability,
-      *pNode->subtree);
+  uint8_t availability = computeAvailabilityWithinSubtree(
+      tileID,
+      *pNode->subtree,
+      relativeLevel);
 
-  uint32_t subtreeRelativeMask = ~(0xFFFFFFFF << relativeLevel);
-
-  // Assume the availability info is within this subtree.
-  // If this is not the case, we may return an incorrect availability.
-  uint8_t availability = TileAvailabilityFlags::REACHABLE;
-
-  uint32_t relativeMortonIndex = getMortonIndex(
-      tileID.x & subtreeRelativeMask,
-      tileID.y & subtreeRelativeMask,
-      tileID.z & subtreeRelativeMask);
-
-  // For reference:
-  // https://github.com/CesiumGS/3d-tiles/tree/3d-tiles-next/extensions/3DTILES_implicit_tiling#availability-bitstream-lengths
-  // The below is identical to:
-  // (8^levelRelativeToSubtree - 1) / 7
-  uint32_t offset = ((1U << (3U * relativeLevel)) - 1U) / 7U;
-
-  uint32_t availabilityIndex = relativeMortonIndex + offset;
-  uint32_t byteIndex = availabilityIndex >> 3;
-  uint8_t bitIndex = static_cast<uint8_t>(availabilityIndex & 7);
-  uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-  // Check tile availability.
-  if ((tileAvailabilityAccessor.isConstant() &&
-       tileAvailabilityAccessor.getConstant()) ||
-      (tileAvailabilityAccessor.isBufferView() &&
-       (uint8_t)tileAvailabilityAccessor[byteIndex] & bitMask)) {
-    availability |= TileAvailabilityFlags::TILE_AVAILABLE;
-  }
-
-  // Check content availability.
-  if ((contentAvailabilityAccessor.isConstant() &&
-       contentAvailabilityAccessor.getConstant()) ||
-      (contentAvailabilityAccessor.isBufferView() &&
-       (uint8_t)contentAvailabilityAccessor[byteIndex] & bitMask)) {
-    availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
-  }
-
-  // If this is the 0th level within the subtree, we know this tile's
-  // subtree is available and loaded.
   if (relativeLevel == 0) {
     // Setting TILE_AVAILABLE here may technically be redundant.
     availability |= TileAvailabilityFlags::TILE_AVAILABLE;
-    availability |= TileAvailabilityFlags::SUBTREE_AVAILABLE;
-    availability |= TileAvailabilityFlags::SUBTREE_LOADED;
   }
 
   return availability;
@@ -385,6 +369,7 @@ AvailabilityNode* OctreeAvailability::addNode(
     } else {
       // Set the root node.
       this->_pRoot = std::make_unique<AvailabilityNode>();
+      this->_subtreeNodes.emplace(OctreeTileID(0, 0, 0, 0), this->_pRoot.get());
       return this->_pRoot.get();
     }
   }
@@ -441,9 +426,18 @@ AvailabilityNode* OctreeAvailability::addNode(
   }
 
   if (subtreeAvailable) {
-    pParentNode->childNodes[subtreeIndex] =
-        std::make_unique<AvailabilityNode>();
-    return pParentNode->childNodes[subtreeIndex].get();
+    std::unique_ptr<AvailabilityNode>& pChildNode =
+        pParentNode->childNodes[subtreeIndex];
+    if (pChildNode) {
+      // Replacing a node also destroys the nodes below it, so forget all of
+      // the nodes. Tiles in their subtrees are found by walking down from the
+      // root instead.
+      this->_subtreeNodes.clear();
+    }
+
+    pChildNode = std::make_unique<AvailabilityNode>();
+    this->_subtreeNodes.insert_or_assign(tileID, pChildNode.get());
+    return pChildNode.get();
   }
 
   return nullptr;
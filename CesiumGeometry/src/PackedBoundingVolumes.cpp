@@ -0,0 +1,100 @@
+#include "CesiumGeometry/PackedBoundingVolumes.h"
+
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Plane.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace CesiumGeometry {
+
+void PackedBoundingVolumes::reserve(size_t count) {
+  this->_centerX.reserve(count);
+  this->_centerY.reserve(count);
+  this->_centerZ.reserve(count);
+  this->_radius.reserve(count);
+  for (std::vector<double>& component : this->_halfAxes) {
+    component.reserve(count);
+  }
+}
+
+void PackedBoundingVolumes::clear() noexcept {
+  this->_centerX.clear();
+  this->_centerY.clear();
+  this->_centerZ.clear();
+  this->_radius.clear();
+  for (std::vector<double>& component : this->_halfAxes) {
+    component.clear();
+  }
+}
+
+void PackedBoundingVolumes::addBoundingSphere(const BoundingSphere& sphere) {
+  const glm::dvec3& center = sphere.getCenter();
+  this->_centerX.emplace_back(center.x);
+  this->_centerY.emplace_back(center.y);
+  this->_centerZ.emplace_back(center.z);
+  this->_radius.emplace_back(sphere.getRadius());
+  for (std::vector<double>& component : this->_halfAxes) {
+    component.emplace_back(0.0);
+  }
+}
+
+void PackedBoundingVolumes::addOrientedBoundingBox(
+    const OrientedBoundingBox& box) {
+  const glm::dvec3& center = box.getCenter();
+  this->_centerX.emplace_back(center.x);
+  this->_centerY.emplace_back(center.y);
+  this->_centerZ.emplace_back(center.z);
+  this->_radius.emplace_back(0.0);
+
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+  for (glm::length_t axis = 0; axis < 3; ++axis) {
+    for (glm::length_t component = 0; component < 3; ++component) {
+      this->_halfAxes[size_t(axis * 3 + component)].emplace_back(
+          halfAxes[axis][component]);
+    }
+  }
+}
+
+void PackedBoundingVolumes::cullAgainstPlane(
+    const Plane& plane,
+    gsl::span<uint8_t> visibility) const {
+  assert(visibility.size() >= this->size());
+
+  const glm::dvec3& normal = plane.getNormal();
+  const double nx = normal.x;
+  const double ny = normal.y;
+  const double nz = normal.z;
+  const double distance = plane.getDistance();
+
+  const double* pCenterX = this->_centerX.data();
+  const double* pCenterY = this->_centerY.data();
+  const double* pCenterZ = this->_centerZ.data();
+  const double* pRadius = this->_radius.data();
+  const double* pX0 = this->_halfAxes[0].data();
+  const double* pY0 = this->_halfAxes[1].data();
+  const double* pZ0 = this->_halfAxes[2].data();
+  const double* pX1 = this->_halfAxes[3].data();
+  const double* pY1 = this->_halfAxes[4].data();
+  const double* pZ1 = this->_halfAxes[5].data();
+  const double* pX2 = this->_halfAxes[6].data();
+  const double* pY2 = this->_halfAxes[7].data();
+  const double* pZ2 = this->_halfAxes[8].data();
+  uint8_t* pVisibility = visibility.data();
+
+  // This loop is deliberately free of branches and function calls so that it
+  // can be auto-vectorized for whatever SIMD instruction set is targeted.
+  const size_t count = this->size();
+  for (size_t i = 0; i < count; ++i) {
+    const double distanceToPlane = nx * pCenterX[i] + ny * pCenterY[i] +
+                                   nz * pCenterZ[i] + distance;
+    const double radEffective =
+        pRadius[i] + std::abs(nx * pX0[i] + ny * pY0[i] + nz * pZ0[i]) +
+        std::abs(nx * pX1[i] + ny * pY1[i] + nz * pZ1[i]) +
+        std::abs(nx * pX2[i] + ny * pY2[i] + nz * pZ2[i]);
+    pVisibility[i] &= static_cast<uint8_t>(distanceToPlane >= -radEffective);
+  }
+}
+
+} // namespace CesiumGeometry
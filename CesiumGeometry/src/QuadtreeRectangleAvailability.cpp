@@ -4,8 +4,6 @@
 
 #include <glm/common.hpp>
 
-#include <algorithm>
-
 namespace CesiumGeometry {
 
 QuadtreeRectangleAvailability::QuadtreeRectangleAvailability(
@@ -13,16 +11,21 @@ QuadtreeRectangleAvailability::QuadtreeRectangleAvailability(
     uint32_t maximumLevel) noexcept
     : _tilingScheme(tilingScheme),
       _maximumLevel(maximumLevel),
-      _rootNodes(
+      _rootNodeCount(
           this->_tilingScheme.getRootTilesX() *
-          this->_tilingScheme.getRootTilesY()) {
+          this->_tilingScheme.getRootTilesY()),
+      _nodes(),
+      _rectangles() {
+  this->_nodes.reserve(this->_rootNodeCount);
   for (uint32_t j = 0; j < this->_tilingScheme.getRootTilesY(); ++j) {
-    const uint32_t rowStart = j * this->_tilingScheme.getRootTilesX();
     for (uint32_t i = 0; i < this->_tilingScheme.getRootTilesX(); ++i) {
       QuadtreeTileID id(0, i, j);
-      Rectangle extent = tilingScheme.tileToRectangle(id);
-      this->_rootNodes[rowStart + i] =
-          std::make_unique<QuadtreeNode>(id, extent, nullptr);
+      this->_nodes.push_back(QuadtreeNode{
+          id,
+          tilingScheme.tileToRectangle(id),
+          noIndex,
+          noIndex,
+          noIndex});
     }
   }
 }
@@ -34,31 +37,23 @@ void QuadtreeRectangleAvailability::addAvailableTileRange(
   const Rectangle ur = this->_tilingScheme.tileToRectangle(
       QuadtreeTileID(range.level, range.maximumX, range.maximumY));
 
-  RectangleWithLevel rectangleWithLevel{
-      range.level,
-      Rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY)};
-
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.overlaps(rectangleWithLevel.rectangle)) {
-      putRectangleInQuadtree(
-          this->_tilingScheme,
-          this->_maximumLevel,
-          *pNode,
-          rectangleWithLevel);
+  const Rectangle rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY);
+
+  for (uint32_t i = 0; i < this->_rootNodeCount; ++i) {
+    if (this->_nodes[i].extent.overlaps(rectangle)) {
+      this->putRectangleInQuadtree(i, range.level, rectangle);
     }
   }
 }
 
 uint32_t QuadtreeRectangleAvailability::computeMaximumLevelAtPosition(
     const glm::dvec2& position) const noexcept {
-  // Find the root node that contains this position.
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.contains(position)) {
-      return findMaxLevelFromNode(nullptr, *pNode, position);
-    }
+  const uint32_t rootIndex = this->findRootNode(position);
+  if (rootIndex == noIndex) {
+    return 0;
   }
 
-  return 0;
+  return this->findMaxLevelFromNode(noIndex, rootIndex, position);
 }
 
 uint8_t QuadtreeRectangleAvailability::isTileAvailable(
@@ -80,159 +75,205 @@ uint8_t QuadtreeRectangleAvailability::isTileAvailable(
   return 0;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::putRectangleInQuadtree(
-    const QuadtreeTilingScheme& tilingScheme,
-    uint32_t maximumLevel,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeRectangleAvailability::RectangleWithLevel&
-        rectangle) noexcept {
-  QuadtreeNode* pNode = &node;
-
-  while (pNode->id.level < maximumLevel) {
-    createNodeChildrenIfNecessary(*pNode, tilingScheme);
-    if (pNode->ll && pNode->ll->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ll.get();
-    } else if (
-        pNode->lr && pNode->lr->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->lr.get();
-    } else if (
-        pNode->ul && pNode->ul->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ul.get();
-    } else if (
-        pNode->ur && pNode->ur->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ur.get();
-    } else {
+std::array<uint8_t, 4> QuadtreeRectangleAvailability::areChildTilesAvailable(
+    const QuadtreeTileID& id) const noexcept {
+  std::array<uint8_t, 4> result{};
+
+  const glm::dvec2 parentCenter =
+      this->_tilingScheme.tileToRectangle(id).getCenter();
+  uint32_t nodeIndex = this->findRootNode(parentCenter);
+  if (nodeIndex == noIndex) {
+    return result;
+  }
+
+  // The center of the parent tile is only on the boundary of tiles below it,
+  // so the node of the parent tile, or of its deepest ancestor in the
+  // quadtree, is found by following the single child that contains the
+  // center. The centers of the children are inside that node as well.
+  while (this->_nodes[nodeIndex].id.level < id.level &&
+         this->_nodes[nodeIndex].firstChild != noIndex) {
+    const uint32_t firstChild = this->_nodes[nodeIndex].firstChild;
+    uint32_t containingChild = noIndex;
+    uint32_t containingCount = 0;
+    for (uint32_t i = firstChild; i < firstChild + 4; ++i) {
+      if (this->_nodes[i].extent.contains(parentCenter)) {
+        containingChild = i;
+        ++containingCount;
+      }
+    }
+
+    if (containingCount != 1) {
       break;
     }
+    nodeIndex = containingChild;
   }
 
-  if (pNode->rectangles.empty() ||
-      pNode->rectangles.back().level <= rectangle.level) {
-    pNode->rectangles.push_back(rectangle);
-  } else {
-    // Maintain ordering by level when inserting.
-    std::push_heap(
-        pNode->rectangles.begin(),
-        pNode->rectangles.end(),
-        QuadtreeRectangleAvailability::rectangleLevelComparator);
+  const QuadtreeTileID llID(id.level + 1, id.x * 2, id.y * 2);
+  const std::array<QuadtreeTileID, 4> childIDs{
+      llID,
+      QuadtreeTileID(llID.level, llID.x + 1, llID.y),
+      QuadtreeTileID(llID.level, llID.x, llID.y + 1),
+      QuadtreeTileID(llID.level, llID.x + 1, llID.y + 1)};
+
+  for (size_t i = 0; i < childIDs.size(); ++i) {
+    const glm::dvec2 center =
+        this->_tilingScheme.tileToRectangle(childIDs[i]).getCenter();
+    if (this->findMaxLevelFromNode(noIndex, nodeIndex, center) >=
+        childIDs[i].level) {
+      result[i] = TileAvailabilityFlags::TILE_AVAILABLE |
+                  TileAvailabilityFlags::REACHABLE;
+    }
   }
+
+  return result;
 }
 
-/*static*/ bool QuadtreeRectangleAvailability::rectangleLevelComparator(
-    const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-    const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept {
-  return a.level < b.level;
+void QuadtreeRectangleAvailability::putRectangleInQuadtree(
+    uint32_t nodeIndex,
+    uint32_t level,
+    const Rectangle& rectangle) noexcept {
+  while (this->_nodes[nodeIndex].id.level < this->_maximumLevel) {
+    this->createNodeChildrenIfNecessary(nodeIndex);
+
+    const uint32_t firstChild = this->_nodes[nodeIndex].firstChild;
+    uint32_t containingChild = noIndex;
+    for (uint32_t i = firstChild; i < firstChild + 4; ++i) {
+      if (this->_nodes[i].extent.fullyContains(rectangle)) {
+        containingChild = i;
+        break;
+      }
+    }
+
+    if (containingChild == noIndex) {
+      break;
+    }
+    nodeIndex = containingChild;
+  }
+
+  Rectangles& rectangles = this->_rectangles;
+  const uint32_t rectangleIndex =
+      static_cast<uint32_t>(rectangles.level.size());
+  rectangles.level.push_back(level);
+  rectangles.minimumX.push_back(rectangle.minimumX);
+  rectangles.minimumY.push_back(rectangle.minimumY);
+  rectangles.maximumX.push_back(rectangle.maximumX);
+  rectangles.maximumY.push_back(rectangle.maximumY);
+
+  // Maintain ordering by level, highest first, when inserting.
+  uint32_t previous = noIndex;
+  uint32_t next = this->_nodes[nodeIndex].firstRectangle;
+  while (next != noIndex && rectangles.level[next] > level) {
+    previous = next;
+    next = rectangles.next[next];
+  }
+
+  rectangles.next.push_back(next);
+  if (previous == noIndex) {
+    this->_nodes[nodeIndex].firstRectangle = rectangleIndex;
+  } else {
+    rectangles.next[previous] = rectangleIndex;
+  }
 }
 
-/*static*/ uint32_t QuadtreeRectangleAvailability::findMaxLevelFromNode(
-    QuadtreeRectangleAvailability::QuadtreeNode* pStopNode,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const glm::dvec2& position) noexcept {
+uint32_t QuadtreeRectangleAvailability::findMaxLevelFromNode(
+    uint32_t stopNodeIndex,
+    uint32_t nodeIndex,
+    const glm::dvec2& position) const noexcept {
   uint32_t maxLevel = 0;
-  QuadtreeRectangleAvailability::QuadtreeNode* pNode = &node;
 
   // Find the deepest quadtree node containing this point.
-  bool found = false;
-  while (!found) {
-    const uint32_t ll =
-        pNode->ll && pNode->ll->extent.contains(position) ? 1 : 0;
-    const uint32_t lr =
-        pNode->lr && pNode->lr->extent.contains(position) ? 1 : 0;
-    const uint32_t ul =
-        pNode->ul && pNode->ul->extent.contains(position) ? 1 : 0;
-    const uint32_t ur =
-        pNode->ur && pNode->ur->extent.contains(position) ? 1 : 0;
+  for (;;) {
+    const uint32_t firstChild = this->_nodes[nodeIndex].firstChild;
+    if (firstChild == noIndex) {
+      break;
+    }
+
+    uint32_t containingChild = noIndex;
+    uint32_t containingCount = 0;
+    for (uint32_t i = firstChild; i < firstChild + 4; ++i) {
+      if (this->_nodes[i].extent.contains(position)) {
+        containingChild = i;
+        ++containingCount;
+      }
+    }
 
     // The common scenario is that the point is in only one quadrant and we can
     // simply iterate down the tree.  But if the point is on a boundary between
     // tiles, it is in multiple tiles and we need to check all of them, so use
     // recursion.
-    if (ll + lr + ul + ur > 1) {
-      if (ll) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ll, position));
-      }
-      if (lr) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->lr, position));
-      }
-      if (ul) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ul, position));
-      }
-      if (ur) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ur, position));
+    if (containingCount > 1) {
+      for (uint32_t i = firstChild; i < firstChild + 4; ++i) {
+        if (this->_nodes[i].extent.contains(position)) {
+          maxLevel = glm::max(
+              maxLevel,
+              this->findMaxLevelFromNode(nodeIndex, i, position));
+        }
       }
       break;
     }
-    if (ll) {
-      pNode = pNode->ll.get();
-    } else if (lr) {
-      pNode = pNode->lr.get();
-    } else if (ul) {
-      pNode = pNode->ul.get();
-    } else if (ur) {
-      pNode = pNode->ur.get();
-    } else {
-      found = true;
+    if (containingCount == 0) {
+      break;
     }
+    nodeIndex = containingChild;
   }
 
-  // Wal up the tree until we find a rectangle that contains this point.
-  while (pNode != pStopNode) {
-    const std::vector<RectangleWithLevel>& rectangles = pNode->rectangles;
-
-    // Rectangles are sorted by level, lowest first.
-    for (int32_t i = static_cast<int32_t>(rectangles.size()) - 1;
-         i >= 0 && rectangles[static_cast<size_t>(i)].level > maxLevel;
-         --i) {
-      const RectangleWithLevel& rectangle = rectangles[static_cast<size_t>(i)];
-      if (rectangle.rectangle.contains(position)) {
-        maxLevel = rectangle.level;
+  // Walk up the tree until we find a rectangle that contains this point.
+  const Rectangles& rectangles = this->_rectangles;
+  while (nodeIndex != stopNodeIndex) {
+    // Rectangles are linked by level, highest first.
+    for (uint32_t i = this->_nodes[nodeIndex].firstRectangle;
+         i != noIndex && rectangles.level[i] > maxLevel;
+         i = rectangles.next[i]) {
+      if (position.x >= rectangles.minimumX[i] &&
+          position.y >= rectangles.minimumY[i] &&
+          position.x <= rectangles.maximumX[i] &&
+          position.y <= rectangles.maximumY[i]) {
+        maxLevel = rectangles.level[i];
       }
     }
 
-    pNode = pNode->pParent;
+    nodeIndex = this->_nodes[nodeIndex].parent;
   }
 
   return maxLevel;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::createNodeChildrenIfNecessary(
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeTilingScheme& tilingScheme) noexcept {
-  if (node.ll) {
+uint32_t QuadtreeRectangleAvailability::findRootNode(
+    const glm::dvec2& position) const noexcept {
+  for (uint32_t i = 0; i < this->_rootNodeCount; ++i) {
+    if (this->_nodes[i].extent.contains(position)) {
+      return i;
+    }
+  }
+
+  return noIndex;
+}
+
+void QuadtreeRectangleAvailability::createNodeChildrenIfNecessary(
+    uint32_t nodeIndex) noexcept {
+  if (this->_nodes[nodeIndex].firstChild != noIndex) {
     return;
   }
 
-  QuadtreeTileID llID(node.id.level + 1, node.id.x * 2, node.id.y * 2);
-  node.ll = std::make_unique<QuadtreeNode>(
+  const QuadtreeTileID id = this->_nodes[nodeIndex].id;
+  const uint32_t firstChild = static_cast<uint32_t>(this->_nodes.size());
+  this->_nodes[nodeIndex].firstChild = firstChild;
+
+  const QuadtreeTileID llID(id.level + 1, id.x * 2, id.y * 2);
+  const std::array<QuadtreeTileID, 4> childIDs{
       llID,
-      tilingScheme.tileToRectangle(llID),
-      &node);
-
-  QuadtreeTileID lrID(llID.level, llID.x + 1, llID.y);
-  node.lr = std::make_unique<QuadtreeNode>(
-      lrID,
-      tilingScheme.tileToRectangle(lrID),
-      &node);
-
-  QuadtreeTileID ulID(llID.level, llID.x, llID.y + 1);
-  node.ul = std::make_unique<QuadtreeNode>(
-      ulID,
-      tilingScheme.tileToRectangle(ulID),
-      &node);
-
-  QuadtreeTileID urID(llID.level, llID.x + 1, llID.y + 1);
-  node.ur = std::make_unique<QuadtreeNode>(
-      urID,
-      tilingScheme.tileToRectangle(urID),
-      &node);
+      QuadtreeTileID(llID.level, llID.x + 1, llID.y),
+      QuadtreeTileID(llID.level, llID.x, llID.y + 1),
+      QuadtreeTileID(llID.level, llID.x + 1, llID.y + 1)};
+
+  for (const QuadtreeTileID& childID : childIDs) {
+    this->_nodes.push_back(QuadtreeNode{
+        childID,
+        this->_tilingScheme.tileToRectangle(childID),
+        nodeIndex,
+        noIndex,
+        noIndex});
+  }
 }
 
 } // namespace CesiumGeometry
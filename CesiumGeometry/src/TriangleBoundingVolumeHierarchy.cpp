@@ -0,0 +1,252 @@
+#include "CesiumGeometry/TriangleBoundingVolumeHierarchy.h"
+
+#include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/Ray.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace CesiumGeometry {
+
+namespace {
+// The ray of a query, with the reciprocal of its direction precomputed for the
+// many box tests.
+struct RaySlabs {
+  explicit RaySlabs(const Ray& ray) noexcept : origin(ray.getOrigin()) {
+    const glm::dvec3& direction = ray.getDirection();
+    for (glm::length_t i = 0; i < 3; ++i) {
+      parallel[size_t(i)] = direction[i] == 0.0;
+      inverseDirection[i] = parallel[size_t(i)] ? 0.0 : 1.0 / direction[i];
+    }
+  }
+
+  std::optional<double> intersect(
+      const glm::dvec3& minimum,
+      const glm::dvec3& maximum,
+      double maximumDistance) const noexcept {
+    double tMin = 0.0;
+    double tMax = maximumDistance;
+    for (glm::length_t i = 0; i < 3; ++i) {
+      if (parallel[size_t(i)]) {
+        if (origin[i] < minimum[i] || origin[i] > maximum[i]) {
+          return std::nullopt;
+        }
+        continue;
+      }
+
+      double t0 = (minimum[i] - origin[i]) * inverseDirection[i];
+      double t1 = (maximum[i] - origin[i]) * inverseDirection[i];
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+
+      tMin = glm::max(tMin, t0);
+      tMax = glm::min(tMax, t1);
+      if (tMin > tMax) {
+        return std::nullopt;
+      }
+    }
+
+    return tMin;
+  }
+
+  glm::dvec3 origin;
+  glm::dvec3 inverseDirection{0.0};
+  std::array<bool, 3> parallel{};
+};
+} // namespace
+
+TriangleBoundingVolumeHierarchy::TriangleBoundingVolumeHierarchy() noexcept
+    : _nodes(), _triangleVertices() {}
+
+TriangleBoundingVolumeHierarchy::TriangleBoundingVolumeHierarchy(
+    std::vector<glm::dvec3>&& triangleVertices,
+    uint32_t maximumTrianglesPerLeaf)
+    : _nodes(), _triangleVertices(std::move(triangleVertices)) {
+  const uint32_t triangleCount =
+      static_cast<uint32_t>(this->_triangleVertices.size() / 3);
+  this->_triangleVertices.resize(size_t(triangleCount) * 3);
+  if (triangleCount == 0) {
+    return;
+  }
+
+  std::vector<uint32_t> triangles(triangleCount);
+  std::vector<glm::dvec3> centroids(triangleCount);
+  for (uint32_t i = 0; i < triangleCount; ++i) {
+    triangles[i] = i;
+    centroids[i] = (this->_triangleVertices[size_t(i) * 3] +
+                    this->_triangleVertices[size_t(i) * 3 + 1] +
+                    this->_triangleVertices[size_t(i) * 3 + 2]) /
+                   3.0;
+  }
+
+  // A balanced tree has fewer than two nodes per leaf.
+  this->_nodes.reserve(
+      2 * (size_t(triangleCount) / glm::max(maximumTrianglesPerLeaf, 1U)) + 1);
+  this->buildNode(
+      triangles,
+      centroids,
+      0,
+      triangleCount,
+      glm::max(maximumTrianglesPerLeaf, 1U));
+
+  // Store the triangles in the order of the leaves.
+  std::vector<glm::dvec3> sortedVertices;
+  sortedVertices.reserve(this->_triangleVertices.size());
+  for (const uint32_t triangle : triangles) {
+    sortedVertices.push_back(this->_triangleVertices[size_t(triangle) * 3]);
+    sortedVertices.push_back(this->_triangleVertices[size_t(triangle) * 3 + 1]);
+    sortedVertices.push_back(this->_triangleVertices[size_t(triangle) * 3 + 2]);
+  }
+  this->_triangleVertices = std::move(sortedVertices);
+}
+
+std::optional<double> TriangleBoundingVolumeHierarchy::intersectRayParametric(
+    const Ray& ray,
+    double maximumDistance) const noexcept {
+  if (this->_nodes.empty()) {
+    return std::nullopt;
+  }
+
+  const RaySlabs slabs(ray);
+  const std::optional<double> rootDistance = slabs.intersect(
+      this->_nodes[0].minimum,
+      this->_nodes[0].maximum,
+      maximumDistance);
+  if (!rootDistance) {
+    return std::nullopt;
+  }
+
+  std::optional<double> closest;
+  double closestDistance = maximumDistance;
+
+  // Each level of the tree adds at most one entry to the stack, and a median
+  // split of 32-bit triangle indices is less than 64 levels deep.
+  std::array<std::pair<uint32_t, double>, 64> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = {0, *rootDistance};
+
+  while (stackSize > 0) {
+    const auto [nodeIndex, entryDistance] = stack[--stackSize];
+    if (entryDistance > closestDistance) {
+      continue;
+    }
+
+    const Node& node = this->_nodes[nodeIndex];
+    if (node.triangleCount > 0) {
+      for (uint32_t i = node.index; i < node.index + node.triangleCount; ++i) {
+        const std::optional<double> distance =
+            IntersectionTests::rayTriangleParametric(
+                ray,
+                this->_triangleVertices[size_t(i) * 3],
+                this->_triangleVertices[size_t(i) * 3 + 1],
+                this->_triangleVertices[size_t(i) * 3 + 2]);
+        if (distance && *distance <= closestDistance) {
+          closest = distance;
+          closestDistance = *distance;
+        }
+      }
+      continue;
+    }
+
+    const uint32_t firstChild = nodeIndex + 1;
+    const uint32_t secondChild = node.index;
+    const std::optional<double> firstDistance = slabs.intersect(
+        this->_nodes[firstChild].minimum,
+        this->_nodes[firstChild].maximum,
+        closestDistance);
+    const std::optional<double> secondDistance = slabs.intersect(
+        this->_nodes[secondChild].minimum,
+        this->_nodes[secondChild].maximum,
+        closestDistance);
+
+    // Push the farther child first, so that the nearer one is visited first
+    // and more of the farther one can be skipped.
+    if (firstDistance && secondDistance) {
+      if (*firstDistance <= *secondDistance) {
+        stack[stackSize++] = {secondChild, *secondDistance};
+        stack[stackSize++] = {firstChild, *firstDistance};
+      } else {
+        stack[stackSize++] = {firstChild, *firstDistance};
+        stack[stackSize++] = {secondChild, *secondDistance};
+      }
+    } else if (firstDistance) {
+      stack[stackSize++] = {firstChild, *firstDistance};
+    } else if (secondDistance) {
+      stack[stackSize++] = {secondChild, *secondDistance};
+    }
+  }
+
+  return closest;
+}
+
+uint32_t TriangleBoundingVolumeHierarchy::buildNode(
+    std::vector<uint32_t>& triangles,
+    const std::vector<glm::dvec3>& centroids,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t maximumTrianglesPerLeaf) {
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  glm::dvec3 centroidMinimum(std::numeric_limits<double>::max());
+  glm::dvec3 centroidMaximum(std::numeric_limits<double>::lowest());
+  for (uint32_t i = begin; i < end; ++i) {
+    const size_t firstVertex = size_t(triangles[i]) * 3;
+    for (size_t j = firstVertex; j < firstVertex + 3; ++j) {
+      minimum = glm::min(minimum, this->_triangleVertices[j]);
+      maximum = glm::max(maximum, this->_triangleVertices[j]);
+    }
+    centroidMinimum = glm::min(centroidMinimum, centroids[triangles[i]]);
+    centroidMaximum = glm::max(centroidMaximum, centroids[triangles[i]]);
+  }
+
+  const uint32_t nodeIndex = static_cast<uint32_t>(this->_nodes.size());
+  this->_nodes.push_back(Node{minimum, maximum, begin, end - begin});
+
+  // Split at the median along the longest axis of the centroids. If they are
+  // all the same, the triangles can't be separated.
+  const glm::dvec3 extent = centroidMaximum - centroidMinimum;
+  glm::length_t axis = 0;
+  if (extent.y > extent[axis]) {
+    axis = 1;
+  }
+  if (extent.z > extent[axis]) {
+    axis = 2;
+  }
+
+  if (end - begin <= maximumTrianglesPerLeaf || extent[axis] <= 0.0) {
+    return nodeIndex;
+  }
+
+  const uint32_t middle = begin + (end - begin) / 2;
+  std::nth_element(
+      triangles.begin() + begin,
+      triangles.begin() + middle,
+      triangles.begin() + end,
+      [&centroids, axis](uint32_t a, uint32_t b) {
+        return centroids[a][axis] < centroids[b][axis];
+      });
+
+  this->buildNode(
+      triangles,
+      centroids,
+      begin,
+      middle,
+      maximumTrianglesPerLeaf);
+  const uint32_t secondChild = this->buildNode(
+      triangles,
+      centroids,
+      middle,
+      end,
+      maximumTrianglesPerLeaf);
+
+  this->_nodes[nodeIndex].index = secondChild;
+  this->_nodes[nodeIndex].triangleCount = 0;
+
+  return nodeIndex;
+}
+
+} // namespace CesiumGeometry
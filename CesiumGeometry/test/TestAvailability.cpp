@@ -301,6 +301,25 @@ TEST_CASE("Test OctreeAvailability") {
         }
       }
     }
+
+    // Tiles below the root of a loaded child subtree are found in it.
+    for (const OctreeTileID& subtreeId : mockChildrenSubtreeIds) {
+      OctreeTileID id(
+          4,
+          subtreeId.x * 2 + 1,
+          subtreeId.y * 2,
+          subtreeId.z * 2 + 1);
+      CHECK(
+          octreeAvailability.computeAvailability(id) ==
+          (TileAvailabilityFlags::REACHABLE |
+           TileAvailabilityFlags::TILE_AVAILABLE |
+           TileAvailabilityFlags::CONTENT_AVAILABLE));
+    }
+
+    // Tiles below an available child subtree that isn't loaded are unknown.
+    CHECK(
+        octreeAvailability.computeAvailability(OctreeTileID(4, 14, 14, 14)) ==
+        0);
   }
 }
 
@@ -490,5 +509,20 @@ TEST_CASE("Test QuadtreeAvailability") {
         REQUIRE((pChildNode != nullptr) == subtreeShouldBeLoaded);
       }
     }
+
+    // Tiles below the root of a loaded child subtree are found in it.
+    for (const QuadtreeTileID& subtreeId : mockChildrenSubtreeIds) {
+      QuadtreeTileID id(4, subtreeId.x * 2 + 1, subtreeId.y * 2);
+      CHECK(
+          quadtreeAvailability.computeAvailability(id) ==
+          (TileAvailabilityFlags::REACHABLE |
+           TileAvailabilityFlags::TILE_AVAILABLE |
+           TileAvailabilityFlags::CONTENT_AVAILABLE));
+    }
+
+    // Tiles below an available child subtree that isn't loaded are unknown.
+    CHECK(
+        quadtreeAvailability.computeAvailability(QuadtreeTileID(4, 14, 14)) ==
+        0);
   }
 }
@@ -0,0 +1,74 @@
+#include "CesiumGeometry/InstanceGrid.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+bool isInsideBox(const OrientedBoundingBox& box, const glm::dvec3& point) {
+  const glm::dvec3 local = box.getInverseHalfAxes() * (point - box.getCenter());
+  const double tolerance = 1e-9;
+  return local.x >= -1.0 - tolerance && local.x <= 1.0 + tolerance &&
+         local.y >= -1.0 - tolerance && local.y <= 1.0 + tolerance &&
+         local.z >= -1.0 - tolerance && local.z <= 1.0 + tolerance;
+}
+} // namespace
+
+TEST_CASE("InstanceGrid") {
+  SECTION("is empty without instances") {
+    const InstanceGrid grid({}, {});
+    CHECK(grid.getInstanceCount() == 0);
+    CHECK(grid.getCells().empty());
+    CHECK(grid.getInstanceOrder().empty());
+  }
+
+  SECTION("covers every instance exactly once") {
+    // A 40x25 field of instances on a plane.
+    std::vector<glm::dvec3> centers;
+    for (int y = 0; y < 25; ++y) {
+      for (int x = 0; x < 40; ++x) {
+        centers.emplace_back(x * 10.0, y * 10.0, 5.0);
+      }
+    }
+    const std::vector<double> radii(centers.size(), 1.0);
+
+    const InstanceGrid grid(centers, radii, 16);
+    REQUIRE(grid.getInstanceCount() == centers.size());
+    CHECK(grid.getCells().size() > 1);
+
+    std::vector<uint32_t> sortedOrder = grid.getInstanceOrder();
+    std::sort(sortedOrder.begin(), sortedOrder.end());
+    for (uint32_t i = 0; i < sortedOrder.size(); ++i) {
+      CHECK(sortedOrder[i] == i);
+    }
+
+    uint32_t next = 0;
+    for (const InstanceGrid::Cell& cell : grid.getCells()) {
+      CHECK(cell.instances.firstInstance == next);
+      CHECK(cell.instances.instanceCount > 0);
+      next += cell.instances.instanceCount;
+
+      for (uint32_t i = 0; i < cell.instances.instanceCount; ++i) {
+        const uint32_t instance =
+            grid.getInstanceOrder()[cell.instances.firstInstance + i];
+        const glm::dvec3& center = centers[instance];
+        CHECK(isInsideBox(cell.boundingBox, center - radii[instance]));
+        CHECK(isInsideBox(cell.boundingBox, center + radii[instance]));
+      }
+    }
+    CHECK(next == centers.size());
+  }
+
+  SECTION("puts coincident instances in a single cell") {
+    const std::vector<glm::dvec3> centers(10, glm::dvec3(1.0, 2.0, 3.0));
+    const std::vector<double> radii(10, 0.5);
+
+    const InstanceGrid grid(centers, radii, 1);
+    REQUIRE(grid.getCells().size() == 1);
+    CHECK(grid.getCells()[0].instances.instanceCount == 10);
+    CHECK(grid.getCells()[0].boundingBox.getCenter() == centers[0]);
+  }
+}
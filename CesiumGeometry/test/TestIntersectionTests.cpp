@@ -1,13 +1,18 @@
+#include "CesiumGeometry/AxisAlignedBox.h"
 #include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
+#include <CesiumUtility/Math.h>
+
 #include <catch2/catch.hpp>
 #include <glm/glm.hpp>
 
 #include <array>
 
 using namespace CesiumGeometry;
+using namespace CesiumUtility;
 
 TEST_CASE("IntersectionTests::rayPlane") {
   struct TestCase {
@@ -38,6 +43,101 @@ TEST_CASE("IntersectionTests::rayPlane") {
   CHECK(intersectionPoint == testCase.expectedIntersectionPoint);
 }
 
+TEST_CASE("IntersectionTests::rayTriangleParametric") {
+  struct TestCase {
+    Ray ray;
+    bool cullBackFaces;
+    std::optional<double> expectedDistance;
+  };
+
+  const glm::dvec3 p0(0.0, 0.0, 0.0);
+  const glm::dvec3 p1(1.0, 0.0, 0.0);
+  const glm::dvec3 p2(0.0, 1.0, 0.0);
+
+  auto testCase = GENERATE(
+      // hits the front face
+      TestCase{
+          Ray(glm::dvec3(0.25, 0.25, 2.0), glm::dvec3(0.0, 0.0, -1.0)),
+          false,
+          2.0},
+      // hits the back face
+      TestCase{
+          Ray(glm::dvec3(0.25, 0.25, -3.0), glm::dvec3(0.0, 0.0, 1.0)),
+          false,
+          3.0},
+      // ignores the back face when culling
+      TestCase{
+          Ray(glm::dvec3(0.25, 0.25, -3.0), glm::dvec3(0.0, 0.0, 1.0)),
+          true,
+          std::nullopt},
+      // misses beside the triangle
+      TestCase{
+          Ray(glm::dvec3(0.75, 0.75, 2.0), glm::dvec3(0.0, 0.0, -1.0)),
+          false,
+          std::nullopt},
+      // misses behind the origin
+      TestCase{
+          Ray(glm::dvec3(0.25, 0.25, 2.0), glm::dvec3(0.0, 0.0, 1.0)),
+          false,
+          std::nullopt},
+      // misses (parallel)
+      TestCase{
+          Ray(glm::dvec3(-1.0, 0.25, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          false,
+          std::nullopt});
+
+  const std::optional<double> distance =
+      IntersectionTests::rayTriangleParametric(
+          testCase.ray,
+          p0,
+          p1,
+          p2,
+          testCase.cullBackFaces);
+  CHECK(distance == testCase.expectedDistance);
+}
+
+TEST_CASE("IntersectionTests::rayAABBParametric and rayOBBParametric") {
+  struct TestCase {
+    Ray ray;
+    std::optional<double> expectedDistance;
+  };
+
+  auto testCase = GENERATE(
+      // enters the box
+      TestCase{
+          Ray(glm::dvec3(-5.0, 0.5, 0.5), glm::dvec3(1.0, 0.0, 0.0)),
+          4.0},
+      // starts inside the box
+      TestCase{
+          Ray(glm::dvec3(0.5, 0.5, 0.5), glm::dvec3(0.0, 1.0, 0.0)),
+          0.0},
+      // points away from the box
+      TestCase{
+          Ray(glm::dvec3(-5.0, 0.5, 0.5), glm::dvec3(-1.0, 0.0, 0.0)),
+          std::nullopt},
+      // passes beside the box
+      TestCase{
+          Ray(glm::dvec3(-5.0, 2.0, 0.5), glm::dvec3(1.0, 0.0, 0.0)),
+          std::nullopt});
+
+  const AxisAlignedBox aabb(-1.0, -1.0, -1.0, 1.0, 1.0, 1.0);
+  CHECK(
+      IntersectionTests::rayAABBParametric(testCase.ray, aabb) ==
+      testCase.expectedDistance);
+
+  const OrientedBoundingBox obb(glm::dvec3(0.0), glm::dmat3(1.0));
+  const std::optional<double> obbDistance =
+      IntersectionTests::rayOBBParametric(testCase.ray, obb);
+  REQUIRE(obbDistance.has_value() == testCase.expectedDistance.has_value());
+  if (obbDistance) {
+    CHECK(Math::equalsEpsilon(
+        *obbDistance,
+        *testCase.expectedDistance,
+        0.0,
+        Math::Epsilon12));
+  }
+}
+
 TEST_CASE("IntersectionTests::pointInTriangle (2D overload)") {
   struct TestCase {
     glm::dvec2 point;
@@ -0,0 +1,83 @@
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/PackedBoundingVolumes.h"
+#include "CesiumGeometry/Plane.h"
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat3x3.hpp>
+
+#include <vector>
+
+using namespace CesiumGeometry;
+
+TEST_CASE("PackedBoundingVolumes::cullAgainstPlane") {
+  const std::vector<BoundingSphere> spheres{
+      BoundingSphere(glm::dvec3(0.0), 0.5),
+      BoundingSphere(glm::dvec3(-3.0, 1.0, 2.0), 1.0),
+      BoundingSphere(glm::dvec3(2.5, -4.0, 0.0), 2.0),
+      BoundingSphere(glm::dvec3(10.0, 10.0, 10.0), 0.1)};
+
+  const std::vector<OrientedBoundingBox> boxes{
+      OrientedBoundingBox(glm::dvec3(0.0), glm::dmat3(0.5)),
+      OrientedBoundingBox(
+          glm::dvec3(-5.1, 0.0, 0.1),
+          glm::dmat3(glm::rotate(
+              glm::scale(glm::dmat4(1.0), glm::dvec3(1.5, 8.4, 2.6)),
+              1.2,
+              glm::dvec3(0.5, 1.5, -1.2)))),
+      OrientedBoundingBox(
+          glm::dvec3(3.0, 3.0, -3.0),
+          glm::dmat3(glm::rotate(glm::dmat4(1.0), 0.7, glm::dvec3(0, 0, 1))))};
+
+  const std::vector<Plane> planes{
+      Plane(glm::dvec3(1.0, 0.0, 0.0), 0.0),
+      Plane(glm::dvec3(-1.0, 0.0, 0.0), 1.0),
+      Plane(glm::normalize(glm::dvec3(1.0, 1.0, -1.0)), -2.0),
+      Plane(glm::normalize(glm::dvec3(-0.3, 0.5, 0.8)), 4.0)};
+
+  // Interleave the spheres and boxes to check that each keeps its place.
+  PackedBoundingVolumes packed;
+  packed.reserve(spheres.size() + boxes.size());
+  std::vector<bool> isSphere;
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < spheres.size() || i < boxes.size(); ++i) {
+    if (i < spheres.size()) {
+      packed.addBoundingSphere(spheres[i]);
+      isSphere.emplace_back(true);
+      indices.emplace_back(i);
+    }
+    if (i < boxes.size()) {
+      packed.addOrientedBoundingBox(boxes[i]);
+      isSphere.emplace_back(false);
+      indices.emplace_back(i);
+    }
+  }
+  REQUIRE(packed.size() == spheres.size() + boxes.size());
+
+  for (const Plane& plane : planes) {
+    std::vector<uint8_t> visibility(packed.size(), 1);
+    packed.cullAgainstPlane(plane, visibility);
+
+    for (size_t i = 0; i < packed.size(); ++i) {
+      const CullingResult expected =
+          isSphere[i] ? spheres[indices[i]].intersectPlane(plane)
+                      : boxes[indices[i]].intersectPlane(plane);
+      CHECK((visibility[i] != 0) == (expected != CullingResult::Outside));
+    }
+  }
+
+  SECTION("leaves already-culled volumes culled") {
+    std::vector<uint8_t> visibility(packed.size(), 0);
+    packed.cullAgainstPlane(planes[0], visibility);
+    for (uint8_t visible : visibility) {
+      CHECK(visible == 0);
+    }
+  }
+
+  SECTION("clear removes every volume") {
+    packed.clear();
+    CHECK(packed.empty());
+    CHECK(packed.size() == 0);
+  }
+}
@@ -0,0 +1,85 @@
+#include "CesiumGeometry/QuadtreeRectangleAvailability.h"
+#include "CesiumGeometry/TileAvailabilityFlags.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+TEST_CASE("QuadtreeRectangleAvailability") {
+  const QuadtreeTilingScheme tilingScheme(
+      Rectangle(-180.0, -90.0, 180.0, 90.0),
+      2,
+      1);
+  QuadtreeRectangleAvailability availability(tilingScheme, 10);
+
+  // Both root tiles, all of level 1, the two lower left tiles of level 2, and
+  // a single tile of level 5 that is added before the lower level ranges.
+  availability.addAvailableTileRange({5, 3, 2, 3, 2});
+  availability.addAvailableTileRange({0, 0, 0, 1, 0});
+  availability.addAvailableTileRange({1, 0, 0, 3, 1});
+  availability.addAvailableTileRange({2, 0, 0, 1, 0});
+
+  const uint8_t available =
+      TileAvailabilityFlags::TILE_AVAILABLE | TileAvailabilityFlags::REACHABLE;
+
+  SECTION("finds the tiles of every range") {
+    CHECK(availability.isTileAvailable(QuadtreeTileID(0, 1, 0)) == available);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(1, 3, 1)) == available);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 1, 0)) == available);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(5, 3, 2)) == available);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 2, 0)) == 0);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(5, 3, 3)) == 0);
+    CHECK(availability.isTileAvailable(QuadtreeTileID(6, 0, 0)) == 0);
+  }
+
+  SECTION("computes the maximum level at a position") {
+    const glm::dvec2 level5Center =
+        tilingScheme.tileToRectangle(QuadtreeTileID(5, 3, 2)).getCenter();
+    CHECK(availability.computeMaximumLevelAtPosition(level5Center) == 5);
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(90.0, 45.0)) ==
+        1);
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(200.0, 0.0)) ==
+        0);
+  }
+
+  SECTION("gives the same children as querying them one by one") {
+    const std::vector<QuadtreeTileID> parents{
+        QuadtreeTileID(0, 0, 0),
+        QuadtreeTileID(0, 1, 0),
+        QuadtreeTileID(1, 0, 0),
+        QuadtreeTileID(1, 2, 1),
+        QuadtreeTileID(2, 1, 0),
+        QuadtreeTileID(3, 0, 0),
+        QuadtreeTileID(4, 1, 1),
+        QuadtreeTileID(10, 4, 4)};
+
+    for (const QuadtreeTileID& parent : parents) {
+      const std::array<uint8_t, 4> children =
+          availability.areChildTilesAvailable(parent);
+      const QuadtreeTileID llID(parent.level + 1, parent.x * 2, parent.y * 2);
+      CHECK(children[0] == availability.isTileAvailable(llID));
+      CHECK(
+          children[1] == availability.isTileAvailable(
+                             QuadtreeTileID(llID.level, llID.x + 1, llID.y)));
+      CHECK(
+          children[2] == availability.isTileAvailable(
+                             QuadtreeTileID(llID.level, llID.x, llID.y + 1)));
+      CHECK(
+          children[3] ==
+          availability.isTileAvailable(
+              QuadtreeTileID(llID.level, llID.x + 1, llID.y + 1)));
+    }
+
+    const std::array<uint8_t, 4> level1Children =
+        availability.areChildTilesAvailable(QuadtreeTileID(1, 0, 0));
+    CHECK(level1Children[0] == available);
+    CHECK(level1Children[1] == available);
+    CHECK(level1Children[2] == 0);
+    CHECK(level1Children[3] == 0);
+  }
+}
@@ -0,0 +1,85 @@
+#include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/Ray.h"
+#include "CesiumGeometry/TriangleBoundingVolumeHierarchy.h"
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+TEST_CASE("TriangleBoundingVolumeHierarchy") {
+  // A bumpy 20x20 grid of quads, two triangles each.
+  std::vector<glm::dvec3> vertices;
+  auto height = [](int x, int y) { return double((x * 7 + y * 3) % 5); };
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 20; ++x) {
+      const glm::dvec3 p00(x, y, height(x, y));
+      const glm::dvec3 p10(x + 1, y, height(x + 1, y));
+      const glm::dvec3 p01(x, y + 1, height(x, y + 1));
+      const glm::dvec3 p11(x + 1, y + 1, height(x + 1, y + 1));
+      vertices.insert(vertices.end(), {p00, p10, p11, p00, p11, p01});
+    }
+  }
+
+  const std::vector<glm::dvec3> triangles = vertices;
+  const TriangleBoundingVolumeHierarchy hierarchy(std::move(vertices));
+  REQUIRE(hierarchy.getTriangleCount() == 800);
+  CHECK(hierarchy.getNodeCount() > 1);
+
+  auto bruteForce = [&triangles](const Ray& ray) {
+    std::optional<double> closest;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+      const std::optional<double> distance =
+          IntersectionTests::rayTriangleParametric(
+              ray,
+              triangles[i],
+              triangles[i + 1],
+              triangles[i + 2]);
+      if (distance && (!closest || *distance < *closest)) {
+        closest = distance;
+      }
+    }
+    return closest;
+  };
+
+  SECTION("finds the same closest hit as testing every triangle") {
+    for (int i = 0; i < 50; ++i) {
+      const glm::dvec3 origin(
+          double(i % 7) * 3.1 - 2.0,
+          double(i % 11) * 1.9 - 1.0,
+          10.0 + double(i % 3));
+      const glm::dvec3 target(
+          double(i % 5) * 4.3,
+          double(i % 13) * 1.6,
+          double(i % 4));
+      const Ray ray(origin, glm::normalize(target - origin));
+
+      const std::optional<double> expected = bruteForce(ray);
+      const std::optional<double> actual =
+          hierarchy.intersectRayParametric(ray);
+      REQUIRE(actual.has_value() == expected.has_value());
+      if (actual) {
+        CHECK(*actual == Approx(*expected));
+      }
+    }
+  }
+
+  SECTION("ignores hits beyond the maximum distance") {
+    const Ray ray(glm::dvec3(10.5, 10.5, 20.0), glm::dvec3(0.0, 0.0, -1.0));
+    const std::optional<double> distance =
+        hierarchy.intersectRayParametric(ray);
+    REQUIRE(distance);
+    CHECK(!hierarchy.intersectRayParametric(ray, *distance - 0.5));
+  }
+
+  SECTION("an empty hierarchy is never hit") {
+    const TriangleBoundingVolumeHierarchy empty;
+    CHECK(empty.getTriangleCount() == 0);
+    CHECK(!empty.intersectRayParametric(
+        Ray(glm::dvec3(0.0), glm::dvec3(0.0, 0.0, 1.0))));
+  }
+}
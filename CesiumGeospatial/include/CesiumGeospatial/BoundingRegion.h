@@ -4,6 +4,7 @@
 #include "GlobeRectangle.h"
 #include "Library.h"
 
+#include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/CullingResult.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
 
@@ -58,6 +59,15 @@ public:
     return this->_boundingBox;
   }
 
+  /**
+   * @brief Gets a bounding sphere containing this region.
+   *
+   * This is a cheaper, but looser, volume to test against a plane first.
+   */
+  const CesiumGeometry::BoundingSphere& getBoundingSphere() const noexcept {
+    return this->_boundingSphere;
+  }
+
   /**
    * @brief Determines on which side of a plane the bounding region is located.
    *
@@ -138,6 +148,7 @@ private:
   double _minimumHeight;
   double _maximumHeight;
   CesiumGeometry::OrientedBoundingBox _boundingBox;
+  CesiumGeometry::BoundingSphere _boundingSphere;
 
   glm::dvec3 _southwestCornerCartesian;
   glm::dvec3 _northeastCornerCartesian;
@@ -5,6 +5,8 @@
 
 #include <glm/vec2.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -64,6 +66,28 @@ public:
     return this->_boundingRectangle;
   }
 
+  /**
+   * @brief Determines whether a globe rectangle is completely inside this
+   * polygon.
+   *
+   * @param rectangle The {@link CesiumGeospatial::GlobeRectangle} to check.
+   * @return True if the rectangle is completely inside the polygon; otherwise,
+   * false.
+   */
+  bool containsRectangle(
+      const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept;
+
+  /**
+   * @brief Determines whether a globe rectangle overlaps this polygon. This is
+   * the opposite of the rectangle being completely outside of it.
+   *
+   * @param rectangle The {@link CesiumGeospatial::GlobeRectangle} to check.
+   * @return True if any part of the rectangle is inside the polygon;
+   * otherwise, false.
+   */
+  bool intersectsRectangle(
+      const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept;
+
   /**
    * @brief Determines whether a globe rectangle is completely inside any of the
    * polygons in a list.
@@ -93,9 +117,27 @@ public:
           cartographicPolygons) noexcept;
 
 private:
+  struct RectangleOutline;
+  struct SpatialIndex;
+
+  bool outlineIsWithin(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      const RectangleOutline& outline) const noexcept;
+  bool outlineIntersects(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      const RectangleOutline& outline) const noexcept;
+  bool containsPoint(const glm::dvec2& point) const noexcept;
+  bool
+  perimeterIntersectsOutline(const RectangleOutline& outline) const noexcept;
+
   std::vector<glm::dvec2> _vertices;
   std::vector<uint32_t> _indices;
   std::optional<CesiumGeospatial::GlobeRectangle> _boundingRectangle;
+
+  // Finds the triangles and perimeter edges near a point or rectangle, so that
+  // queries don't test all of them. Null for polygons with few vertices. It is
+  // immutable, so copies of the polygon share it.
+  std::shared_ptr<const SpatialIndex> _pSpatialIndex;
 };
 
 } // namespace CesiumGeospatial
@@ -6,6 +6,7 @@
 #include <CesiumUtility/Math.h>
 
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -70,6 +71,19 @@ public:
    */
   glm::dvec3 geodeticSurfaceNormal(const glm::dvec3& position) const noexcept;
 
+  /**
+   * @brief Computes the geodetic surface normals at many cartesian positions.
+   *
+   * This gives the same normals as calling
+   * {@link geodeticSurfaceNormal(const glm::dvec3&) const} for each position.
+   *
+   * @param positions The cartesian positions.
+   * @param normals The normals, which must have the same size as `positions`.
+   */
+  void geodeticSurfaceNormal(
+      gsl::span<const glm::dvec3> positions,
+      gsl::span<glm::dvec3> normals) const noexcept;
+
   /**
    * @brief Computes the normal of the plane tangent to the surface of the
    * ellipsoid at the provided position.
@@ -91,6 +105,22 @@ public:
   glm::dvec3
   cartographicToCartesian(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many {@link Cartographic} positions to cartesian
+   * representation.
+   *
+   * This gives the same positions as calling
+   * {@link cartographicToCartesian(const Cartographic&) const} for each
+   * position, in a single pass over them that the compiler can vectorize.
+   *
+   * @param cartographics The {@link Cartographic} positions.
+   * @param cartesians The cartesian representations, which must have the same
+   * size as `cartographics`.
+   */
+  void cartographicToCartesian(
+      gsl::span<const Cartographic> cartographics,
+      gsl::span<glm::dvec3> cartesians) const noexcept;
+
   /**
    * @brief Converts the provided cartesian to a {@link Cartographic}
    * representation.
@@ -105,6 +135,23 @@ public:
   std::optional<Cartographic>
   cartesianToCartographic(const glm::dvec3& cartesian) const noexcept;
 
+  /**
+   * @brief Converts many cartesian positions to {@link Cartographic}
+   * representation.
+   *
+   * This gives the same positions as calling
+   * {@link cartesianToCartographic(const glm::dvec3&) const} for each
+   * position.
+   *
+   * @param cartesians The cartesian positions.
+   * @param cartographics The {@link Cartographic} representations, which must
+   * have the same size as `cartesians`. An element is the empty optional if
+   * its cartesian is at the center of this ellipsoid.
+   */
+  void cartesianToCartographic(
+      gsl::span<const glm::dvec3> cartesians,
+      gsl::span<std::optional<Cartographic>> cartographics) const noexcept;
+
   /**
    * @brief Scales the given cartesian position along the geodetic surface
    * normal so that it is on the surface of this ellipsoid.
@@ -119,6 +166,22 @@ public:
   std::optional<glm::dvec3>
   scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept;
 
+  /**
+   * @brief Scales many cartesian positions along their geodetic surface
+   * normals so that they are on the surface of this ellipsoid.
+   *
+   * This gives the same positions as calling
+   * {@link scaleToGeodeticSurface(const glm::dvec3&) const} for each position.
+   *
+   * @param cartesians The cartesian positions.
+   * @param scaled The scaled positions, which must have the same size as
+   * `cartesians`. An element is the empty optional if its cartesian is at the
+   * center of this ellipsoid.
+   */
+  void scaleToGeodeticSurface(
+      gsl::span<const glm::dvec3> cartesians,
+      gsl::span<std::optional<glm::dvec3>> scaled) const noexcept;
+
   /**
    * @brief Scales the provided cartesian position along the geocentric
    * surface normal so that it is on the surface of this ellipsoid.
@@ -8,6 +8,7 @@
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 
@@ -82,6 +83,21 @@ public:
    */
   glm::dvec3 project(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many geodetic ellipsoid coordinates to geographic X and Y
+   * coordinates.
+   *
+   * This gives the same X and Y coordinates as calling
+   * {@link project(const Cartographic&) const} for each position.
+   *
+   * @param cartographics The geodetic coordinates in radians.
+   * @param projected The equivalent geographic X and Y coordinates, in meters,
+   * which must have the same size as `cartographics`.
+   */
+  void project(
+      gsl::span<const Cartographic> cartographics,
+      gsl::span<glm::dvec2> projected) const noexcept;
+
   /**
    * @brief Projects a globe rectangle to geographic coordinates.
    *
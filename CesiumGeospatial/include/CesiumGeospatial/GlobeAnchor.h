@@ -5,6 +5,7 @@
 #include <CesiumGeospatial/Ellipsoid.h>
 
 #include <glm/mat4x4.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -97,6 +98,26 @@ public:
   glm::dmat4 getAnchorToLocalTransform(
       const LocalHorizontalCoordinateSystem& localCoordinateSystem) const;
 
+  /**
+   * @brief Gets the transformations from the coordinate systems of many
+   * anchors to the given local-horizontal coordinate system.
+   *
+   * This gives the same transformations as calling
+   * {@link getAnchorToLocalTransform} on each anchor, such as to update all of
+   * the objects in a scene when the origin of its local coordinate system
+   * changes, in a single pass over them.
+   *
+   * @param anchors The anchors.
+   * @param localCoordinateSystem The local coordinate system that is the target
+   * of the transformations.
+   * @param anchorToLocalTransforms The transformations, which must have the
+   * same size as `anchors`.
+   */
+  static void getAnchorToLocalTransforms(
+      gsl::span<const GlobeAnchor> anchors,
+      const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+      gsl::span<glm::dmat4> anchorToLocalTransforms);
+
   /**
    * @brief Sets the globe-fixed transformation based on a new transformation
    * from anchor coordinates to a local-horizontal coordinate system.
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "GlobeRectangle.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace CesiumGeospatial {
+
+/**
+ * @brief An R-tree of {@link GlobeRectangle} instances, used to quickly find
+ * the rectangles that may intersect a given rectangle.
+ *
+ * The tree is built once from all of its rectangles, and cannot be modified
+ * afterward. Rectangles that cross the anti-meridian are supported.
+ */
+class CESIUMGEOSPATIAL_API GlobeRectangleTree final {
+public:
+  /**
+   * @brief Constructs an empty tree.
+   */
+  GlobeRectangleTree() noexcept = default;
+
+  /**
+   * @brief Constructs a tree of the given rectangles.
+   *
+   * @param rectangles The rectangles. Each one is identified by its index in
+   * this list.
+   */
+  explicit GlobeRectangleTree(const std::vector<GlobeRectangle>& rectangles);
+
+  /**
+   * @brief Finds the rectangles that may intersect the given rectangle.
+   *
+   * Every rectangle for which {@link GlobeRectangle::computeIntersection}
+   * returns an intersection is found. A rectangle that only touches the given
+   * one may be found as well.
+   *
+   * @param rectangle The rectangle to test.
+   * @param result Receives the indices of the found rectangles, in ascending
+   * order. Any previous contents are cleared.
+   */
+  void findIntersecting(
+      const GlobeRectangle& rectangle,
+      std::vector<size_t>& result) const;
+
+  /**
+   * @brief Returns the number of rectangles in the tree.
+   */
+  size_t size() const noexcept { return this->_size; }
+
+private:
+  // A longitude-latitude box that does not cross the anti-meridian.
+  struct Box {
+    double west;
+    double south;
+    double east;
+    double north;
+  };
+
+  // A box of one of the rectangles. A rectangle that crosses the
+  // anti-meridian is split into two entries.
+  struct Entry {
+    Box box;
+    size_t index;
+  };
+
+  // The children of an inner node are the nodes [first, first + count), and
+  // those of a leaf are the entries [first, first + count).
+  struct Node {
+    Box box;
+    size_t first;
+    size_t count;
+    bool isLeaf;
+  };
+
+  void buildNode(size_t nodeIndex, size_t begin, size_t end);
+  void findIntersecting(
+      size_t nodeIndex,
+      const Box& box,
+      std::vector<size_t>& result) const;
+
+  std::vector<Entry> _entries;
+  std::vector<Node> _nodes;
+  size_t _size = 0;
+};
+
+} // namespace CesiumGeospatial
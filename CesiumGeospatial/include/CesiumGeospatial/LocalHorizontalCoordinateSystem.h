@@ -5,6 +5,7 @@
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 class Cartographic;
@@ -140,6 +141,42 @@ public:
   glm::dvec3
   localPositionToEcef(const glm::dvec3& localPosition) const noexcept;
 
+  /**
+   * @brief Converts many positions in the local horizontal coordinate system
+   * managed by this instance to Earth-Centered, Earth-Fixed (ECEF).
+   *
+   * This gives the same positions as calling
+   * {@link localPositionToEcef(const glm::dvec3&) const} for each position,
+   * in a single pass over them that the compiler can vectorize.
+   *
+   * @param localPositions The positions in the local coordinate system.
+   * @param ecefPositions The equivalent positions in the ECEF coordinate
+   * system, which must have the same size as `localPositions`.
+   */
+  void localPositionToEcef(
+      gsl::span<const glm::dvec3> localPositions,
+      gsl::span<glm::dvec3> ecefPositions) const noexcept;
+
+  /**
+   * @brief Converts many positions in the local horizontal coordinate system
+   * managed by this instance to single-precision positions relative to a
+   * center in Earth-Centered, Earth-Fixed (ECEF) coordinates.
+   *
+   * The positions are transformed in double precision and only the offsets
+   * from the center are rounded to single precision, so they are precise
+   * enough for rendering near the center, such as with a model matrix that
+   * translates by the center.
+   *
+   * @param localPositions The positions in the local coordinate system.
+   * @param centerEcef The center in the ECEF coordinate system.
+   * @param relativePositions The ECEF positions minus `centerEcef`, which must
+   * have the same size as `localPositions`.
+   */
+  void localPositionToEcefRelativeToCenter(
+      gsl::span<const glm::dvec3> localPositions,
+      const glm::dvec3& centerEcef,
+      gsl::span<glm::vec3> relativePositions) const noexcept;
+
   /**
    * @brief Converts a position in the Earth-Centered, Earth-Fixed (ECEF)
    * coordinate system to the local horizontal coordinate system managed by this
@@ -150,6 +187,23 @@ public:
    */
   glm::dvec3 ecefPositionToLocal(const glm::dvec3& ecefPosition) const noexcept;
 
+  /**
+   * @brief Converts many positions in the Earth-Centered, Earth-Fixed (ECEF)
+   * coordinate system to the local horizontal coordinate system managed by this
+   * instance.
+   *
+   * This gives the same positions as calling
+   * {@link ecefPositionToLocal(const glm::dvec3&) const} for each position,
+   * in a single pass over them that the compiler can vectorize.
+   *
+   * @param ecefPositions The positions in the ECEF coordinate system.
+   * @param localPositions The equivalent positions in the local coordinate
+   * system, which must have the same size as `ecefPositions`.
+   */
+  void ecefPositionToLocal(
+      gsl::span<const glm::dvec3> ecefPositions,
+      gsl::span<glm::dvec3> localPositions) const noexcept;
+
   /**
    * @brief Converts a direction in the local horizontal coordinate system
    * managed by this instance to Earth-Centered, Earth-Fixed (ECEF).
@@ -7,6 +7,7 @@
 #include "WebMercatorProjection.h"
 
 #include <glm/vec2.hpp>
+#include <gsl/span>
 
 #include <variant>
 
@@ -34,6 +35,24 @@ typedef std::variant<GeographicProjection, WebMercatorProjection> Projection;
 glm::dvec3
 projectPosition(const Projection& projection, const Cartographic& position);
 
+/**
+ * @brief Projects many positions on the globe using the given
+ * {@link Projection}.
+ *
+ * This gives the same X and Y coordinates as calling {@link projectPosition}
+ * for each position, but only dispatches on the type of the projection once.
+ *
+ * @param projection The projection.
+ * @param positions The {@link Cartographic} positions.
+ * @param projected The X and Y coordinates of the projected points, in the
+ * coordinate system of the given projection, which must have the same size as
+ * `positions`.
+ */
+void projectPositions(
+    const Projection& projection,
+    gsl::span<const Cartographic> positions,
+    gsl::span<glm::dvec2> projected);
+
 /**
  * @brief Unprojects a position from the globe using the given
  * {@link Projection}.
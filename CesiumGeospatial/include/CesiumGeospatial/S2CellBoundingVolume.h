@@ -4,6 +4,7 @@
 #include "Ellipsoid.h"
 #include "S2CellID.h"
 
+#include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/CullingResult.h>
 #include <CesiumGeometry/Plane.h>
 
@@ -62,6 +63,16 @@ public:
    */
   gsl::span<const glm::dvec3> getVertices() const noexcept;
 
+  /**
+   * @brief Gets a bounding sphere containing the eight vertices of this
+   * volume.
+   *
+   * This is a cheaper, but looser, volume to test against a plane first.
+   */
+  const CesiumGeometry::BoundingSphere& getBoundingSphere() const noexcept {
+    return this->_boundingSphere;
+  }
+
   /**
    * @brief Determines on which side of a plane the bounding volume is located.
    *
@@ -109,6 +120,7 @@ private:
   glm::dvec3 _center;
   std::array<CesiumGeometry::Plane, 6> _boundingPlanes;
   std::array<glm::dvec3, 8> _vertices;
+  CesiumGeometry::BoundingSphere _boundingSphere;
 };
 
 } // namespace CesiumGeospatial
@@ -7,6 +7,7 @@
 #include <CesiumGeometry/Ray.h>
 #include <CesiumUtility/Math.h>
 
+#include <array>
 #include <stdexcept>
 
 using namespace CesiumUtility;
@@ -26,6 +27,7 @@ BoundingRegion::BoundingRegion(
           minimumHeight,
           maximumHeight,
           ellipsoid)),
+      _boundingSphere(this->_boundingBox.toSphere()),
       _southwestCornerCartesian(
           ellipsoid.cartographicToCartesian(rectangle.getSouthwest())),
       _northeastCornerCartesian(
@@ -316,16 +318,22 @@ static OrientedBoundingBox fromPlaneExtents(
         rectangle.getSouth(),
         maximumHeight);
 
-    const glm::dvec3 perimeterCartesianNC =
-        ellipsoid.cartographicToCartesian(perimeterCartographicNC);
-    glm::dvec3 perimeterCartesianNW =
-        ellipsoid.cartographicToCartesian(perimeterCartographicNW);
-    const glm::dvec3 perimeterCartesianCW =
-        ellipsoid.cartographicToCartesian(perimeterCartographicCW);
-    glm::dvec3 perimeterCartesianSW =
-        ellipsoid.cartographicToCartesian(perimeterCartographicSW);
-    const glm::dvec3 perimeterCartesianSC =
-        ellipsoid.cartographicToCartesian(perimeterCartographicSC);
+    const std::array<Cartographic, 5> perimeterCartographics{
+        perimeterCartographicNC,
+        perimeterCartographicNW,
+        perimeterCartographicCW,
+        perimeterCartographicSW,
+        perimeterCartographicSC};
+    std::array<glm::dvec3, 5> perimeterCartesians;
+    ellipsoid.cartographicToCartesian(
+        perimeterCartographics,
+        perimeterCartesians);
+
+    const glm::dvec3 perimeterCartesianNC = perimeterCartesians[0];
+    glm::dvec3 perimeterCartesianNW = perimeterCartesians[1];
+    const glm::dvec3 perimeterCartesianCW = perimeterCartesians[2];
+    glm::dvec3 perimeterCartesianSW = perimeterCartesians[3];
+    const glm::dvec3 perimeterCartesianSC = perimeterCartesians[4];
 
     const glm::dvec2 perimeterProjectedNC =
         tangentPlane.projectPointToNearestOnPlane(perimeterCartesianNC);
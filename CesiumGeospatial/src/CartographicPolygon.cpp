@@ -2,10 +2,15 @@
 
 #include <CesiumGeometry/IntersectionTests.h>
 
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
 #include <glm/mat2x2.hpp>
 #include <mapbox/earcut.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <memory>
 
 using namespace CesiumGeometry;
 
@@ -106,95 +111,261 @@ computeBoundingRectangle(const std::vector<glm::dvec2>& polygon) {
   return CesiumGeospatial::GlobeRectangle(west, south, east, north);
 }
 
-CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
-    : _vertices(polygon),
-      _indices(triangulatePolygon(polygon)),
-      _boundingRectangle(computeBoundingRectangle(polygon)) {}
+namespace {
+
+// Polygons with fewer vertices than this test all of their triangles and edges,
+// which is faster than building and looking up a spatial index.
+constexpr size_t MINIMUM_INDEXED_VERTEX_COUNT = 32;
+
+// The largest number of cells along each axis of a spatial index.
+constexpr uint32_t MAXIMUM_INDEX_GRID_SIZE = 256;
+
+// Returns whether the point is inside the given triangle of the polygon.
+bool pointInIndexedTriangle(
+    const glm::dvec2& point,
+    const std::vector<glm::dvec2>& vertices,
+    const std::vector<uint32_t>& indices,
+    size_t triangle) noexcept {
+  const size_t first = triangle * 3;
+  return IntersectionTests::pointInTriangle(
+      point,
+      vertices[indices[first]],
+      vertices[indices[first + 1]],
+      vertices[indices[first + 2]]);
+}
 
-/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
+bool boundingRectanglesIntersect(
     const CesiumGeospatial::GlobeRectangle& rectangle,
-    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+    const CartographicPolygon& polygon) noexcept {
+  const std::optional<CesiumGeospatial::GlobeRectangle>&
+      polygonBoundingRectangle = polygon.getBoundingRectangle();
+  return polygonBoundingRectangle &&
+         rectangle.computeIntersection(*polygonBoundingRectangle);
+}
+
+} // namespace
+
+// The corners and edges of a globe rectangle in longitude-latitude space.
+struct CartographicPolygon::RectangleOutline {
+  explicit RectangleOutline(
+      const CesiumGeospatial::GlobeRectangle& rectangle) noexcept
+      : corners{
+            glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
+            glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
+            glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
+            glm::dvec2(rectangle.getEast(), rectangle.getSouth())},
+        edges{
+            corners[1] - corners[0],
+            corners[2] - corners[1],
+            corners[3] - corners[2],
+            corners[0] - corners[3]},
+        minimum(glm::min(corners[0], corners[2])),
+        maximum(glm::max(corners[0], corners[2])) {}
+
+  // Returns whether the line segment from a to b intersects the edges.
+  bool intersectsSegment(const glm::dvec2& a, const glm::dvec2& b)
+      const noexcept {
+    // A segment that doesn't overlap the box around the edges can't intersect
+    // them, which is much cheaper to check than each edge.
+    if (glm::max(a.x, b.x) < this->minimum.x ||
+        glm::min(a.x, b.x) > this->maximum.x ||
+        glm::max(a.y, b.y) < this->minimum.y ||
+        glm::min(a.y, b.y) > this->maximum.y) {
+      return false;
+    }
 
-  glm::dvec2 rectangleCorners[] = {
-      glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
-      glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getSouth())};
+    const glm::dvec2 ba = a - b;
 
-  glm::dvec2 rectangleEdges[] = {
-      rectangleCorners[1] - rectangleCorners[0],
-      rectangleCorners[2] - rectangleCorners[1],
-      rectangleCorners[3] - rectangleCorners[2],
-      rectangleCorners[0] - rectangleCorners[3]};
+    // Check each rectangle edge.
+    for (size_t k = 0; k < 4; ++k) {
+      const glm::dvec2& cd = this->edges[k];
+      const glm::dmat2 lineSegmentMatrix(cd, ba);
+      const glm::dvec2 ca = a - this->corners[k];
 
-  // Iterate through all polygons.
-  for (size_t i = 0; i < cartographicPolygons.size(); ++i) {
-    const CartographicPolygon& selection = cartographicPolygons[i];
-
-    const std::optional<CesiumGeospatial::GlobeRectangle>&
-        polygonBoundingRectangle = selection.getBoundingRectangle();
-    if (!polygonBoundingRectangle ||
-        !rectangle.computeIntersection(*polygonBoundingRectangle)) {
-      continue;
-    }
+      // s and t are calculated such that:
+      // line_intersection = a + t * ab = c + s * cd
+      const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
 
-    const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
-
-    // First check if an arbitrary point on the bounding globe rectangle is
-    // inside the polygon.
-    bool inside = false;
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        inside = true;
-        break;
+      // check that the intersection is within the line segments
+      if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
+        return true;
       }
     }
 
-    // If the arbitrary point was outside, then this polygon does not entirely
-    // cull the tile.
-    if (!inside) {
-      continue;
+    return false;
+  }
+
+  std::array<glm::dvec2, 4> corners;
+  std::array<glm::dvec2, 4> edges;
+  glm::dvec2 minimum;
+  glm::dvec2 maximum;
+};
+
+// A uniform grid over the box around the polygon's vertices, listing the
+// triangles and the perimeter edges that overlap each cell. Like the queries,
+// it works in the longitude-latitude coordinates of the vertices.
+struct CartographicPolygon::SpatialIndex {
+  static std::shared_ptr<const SpatialIndex> create(
+      const std::vector<glm::dvec2>& vertices,
+      const std::vector<uint32_t>& indices) {
+    if (vertices.size() < MINIMUM_INDEXED_VERTEX_COUNT) {
+      return nullptr;
     }
 
-    // Check if the polygon perimeter intersects the bounding globe rectangle
-    // edges.
-    bool intersectionFound = false;
-    for (size_t j = 0; j < vertices.size(); ++j) {
-      const glm::dvec2& a = vertices[j];
-      const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
+    std::shared_ptr<SpatialIndex> pIndex = std::make_shared<SpatialIndex>();
+    SpatialIndex& index = *pIndex;
 
-      const glm::dvec2 ba = a - b;
+    index.minimum = vertices[0];
+    index.maximum = vertices[0];
+    for (const glm::dvec2& vertex : vertices) {
+      index.minimum = glm::min(index.minimum, vertex);
+      index.maximum = glm::max(index.maximum, vertex);
+    }
 
-      // Check each rectangle edge.
-      for (size_t k = 0; k < 4; ++k) {
-        const glm::dvec2& cd = rectangleEdges[k];
-        const glm::dmat2 lineSegmentMatrix(cd, ba);
-        const glm::dvec2 ca = a - rectangleCorners[k];
+    // Aim for about one perimeter edge per cell along each axis.
+    const double gridSize = glm::clamp(
+        glm::ceil(glm::sqrt(double(vertices.size()))),
+        1.0,
+        double(MAXIMUM_INDEX_GRID_SIZE));
+    index.columns = uint32_t(gridSize);
+    index.rows = uint32_t(gridSize);
+
+    const glm::dvec2 extent = index.maximum - index.minimum;
+    index.cellsPerRadian = glm::dvec2(
+        extent.x > 0.0 ? gridSize / extent.x : 0.0,
+        extent.y > 0.0 ? gridSize / extent.y : 0.0);
+
+    index.fillCells(
+        indices.size() / 3,
+        [&vertices, &indices](
+            size_t triangle,
+            glm::dvec2& minimum,
+            glm::dvec2& maximum) {
+          const glm::dvec2& a = vertices[indices[triangle * 3]];
+          const glm::dvec2& b = vertices[indices[triangle * 3 + 1]];
+          const glm::dvec2& c = vertices[indices[triangle * 3 + 2]];
+          minimum = glm::min(glm::min(a, b), c);
+          maximum = glm::max(glm::max(a, b), c);
+        },
+        index.triangleStarts,
+        index.triangles);
+
+    index.fillCells(
+        vertices.size(),
+        [&vertices](size_t edge, glm::dvec2& minimum, glm::dvec2& maximum) {
+          const glm::dvec2& a = vertices[edge];
+          const glm::dvec2& b = vertices[(edge + 1) % vertices.size()];
+          minimum = glm::min(a, b);
+          maximum = glm::max(a, b);
+        },
+        index.edgeStarts,
+        index.edges);
+
+    return pIndex;
+  }
 
-        // s and t are calculated such that:
-        // line_intersection = a + t * ab = c + s * cd
-        const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
+  // The cell column of a longitude, clamped to the grid.
+  uint32_t column(double longitude) const noexcept {
+    const double cell =
+        glm::floor((longitude - this->minimum.x) * this->cellsPerRadian.x);
+    return uint32_t(glm::clamp(cell, 0.0, double(this->columns - 1)));
+  }
 
-        // check that the intersection is within the line segments
-        if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
-          intersectionFound = true;
-          break;
+  // The cell row of a latitude, clamped to the grid.
+  uint32_t row(double latitude) const noexcept {
+    const double cell =
+        glm::floor((latitude - this->minimum.y) * this->cellsPerRadian.y);
+    return uint32_t(glm::clamp(cell, 0.0, double(this->rows - 1)));
+  }
+
+  size_t cell(uint32_t column, uint32_t row) const noexcept {
+    return size_t(row) * this->columns + column;
+  }
+
+  // Lists each item in the cells that its bounding box overlaps. The items in
+  // cell i end up at items[starts[i]] up to items[starts[i + 1]].
+  template <typename ComputeBounds>
+  void fillCells(
+      size_t count,
+      const ComputeBounds& computeBounds,
+      std::vector<uint32_t>& starts,
+      std::vector<uint32_t>& items) const {
+    const auto forEachCell = [this, &computeBounds](size_t item, auto&& f) {
+      glm::dvec2 minimum;
+      glm::dvec2 maximum;
+      computeBounds(item, minimum, maximum);
+      const uint32_t lastRow = this->row(maximum.y);
+      const uint32_t lastColumn = this->column(maximum.x);
+      for (uint32_t row = this->row(minimum.y); row <= lastRow; ++row) {
+        for (uint32_t column = this->column(minimum.x); column <= lastColumn;
+             ++column) {
+          f(this->cell(column, row));
         }
       }
+    };
+
+    // Count the items in each cell, then turn the counts into the start of
+    // each cell's items.
+    starts.assign(size_t(this->columns) * this->rows + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+      forEachCell(i, [&starts](size_t cell) { ++starts[cell + 1]; });
+    }
+    for (size_t i = 1; i < starts.size(); ++i) {
+      starts[i] += starts[i - 1];
+    }
+
+    items.resize(starts.back());
+    std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+      forEachCell(i, [&items, &next, i](size_t cell) {
+        items[next[cell]++] = uint32_t(i);
+      });
+    }
+  }
+
+  glm::dvec2 minimum;
+  glm::dvec2 maximum;
+  glm::dvec2 cellsPerRadian;
+  uint32_t columns;
+  uint32_t rows;
 
-      if (intersectionFound) {
-        break;
+  std::vector<uint32_t> triangleStarts;
+  std::vector<uint32_t> triangles;
+  std::vector<uint32_t> edgeStarts;
+  std::vector<uint32_t> edges;
+};
+
+CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
+    : _vertices(polygon),
+      _indices(triangulatePolygon(polygon)),
+      _boundingRectangle(computeBoundingRectangle(polygon)),
+      _pSpatialIndex(SpatialIndex::create(this->_vertices, this->_indices)) {}
+
+bool CartographicPolygon::containsPoint(
+    const glm::dvec2& point) const noexcept {
+  const std::vector<glm::dvec2>& vertices = this->_vertices;
+  const std::vector<uint32_t>& indices = this->_indices;
+
+  if (!this->_pSpatialIndex) {
+    for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
+      if (pointInIndexedTriangle(point, vertices, indices, triangle)) {
+        return true;
       }
     }
+    return false;
+  }
 
-    // There is no intersection with the perimeter and at least one point is
-    // inside the polygon so the tile is completely inside this polygon.
-    if (!intersectionFound) {
+  const SpatialIndex& index = *this->_pSpatialIndex;
+  if (point.x < index.minimum.x || point.x > index.maximum.x ||
+      point.y < index.minimum.y || point.y > index.maximum.y) {
+    return false;
+  }
+
+  const size_t cell = index.cell(index.column(point.x), index.row(point.y));
+  for (uint32_t i = index.triangleStarts[cell];
+       i < index.triangleStarts[cell + 1];
+       ++i) {
+    if (pointInIndexedTriangle(point, vertices, indices, index.triangles[i])) {
       return true;
     }
   }
@@ -202,87 +373,144 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
   return false;
 }
 
-/*static*/ bool CartographicPolygon::rectangleIsOutsidePolygons(
-    const CesiumGeospatial::GlobeRectangle& rectangle,
-    const std::vector<CesiumGeospatial::CartographicPolygon>&
-        cartographicPolygons) noexcept {
-
-  glm::dvec2 rectangleCorners[] = {
-      glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
-      glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getNorth()),
-      glm::dvec2(rectangle.getEast(), rectangle.getSouth())};
+bool CartographicPolygon::perimeterIntersectsOutline(
+    const RectangleOutline& outline) const noexcept {
+  const std::vector<glm::dvec2>& vertices = this->_vertices;
 
-  glm::dvec2 rectangleEdges[] = {
-      rectangleCorners[1] - rectangleCorners[0],
-      rectangleCorners[2] - rectangleCorners[1],
-      rectangleCorners[3] - rectangleCorners[2],
-      rectangleCorners[0] - rectangleCorners[3]};
-
-  // Iterate through all polygons.
-  for (size_t i = 0; i < cartographicPolygons.size(); ++i) {
-    const CartographicPolygon& selection = cartographicPolygons[i];
-
-    const std::optional<CesiumGeospatial::GlobeRectangle>&
-        polygonBoundingRectangle = selection.getBoundingRectangle();
-    if (!polygonBoundingRectangle ||
-        !rectangle.computeIntersection(*polygonBoundingRectangle)) {
-      continue;
+  if (!this->_pSpatialIndex) {
+    for (size_t j = 0; j < vertices.size(); ++j) {
+      if (outline.intersectsSegment(
+              vertices[j],
+              vertices[(j + 1) % vertices.size()])) {
+        return true;
+      }
     }
+    return false;
+  }
 
-    const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
-
-    // Check if an arbitrary point on the polygon is in the globe rectangle.
-    if (IntersectionTests::pointInTriangle(
-            vertices[0],
-            rectangleCorners[0],
-            rectangleCorners[1],
-            rectangleCorners[2]) ||
-        IntersectionTests::pointInTriangle(
-            vertices[0],
-            rectangleCorners[0],
-            rectangleCorners[2],
-            rectangleCorners[3])) {
-      return false;
-    }
+  const SpatialIndex& index = *this->_pSpatialIndex;
+  const uint32_t firstColumn = index.column(outline.minimum.x);
+  const uint32_t lastColumn = index.column(outline.maximum.x);
+  const uint32_t firstRow = index.row(outline.minimum.y);
+  const uint32_t lastRow = index.row(outline.maximum.y);
+
+  for (uint32_t row = firstRow; row <= lastRow; ++row) {
+    for (uint32_t column = firstColumn; column <= lastColumn; ++column) {
+      const size_t cell = index.cell(column, row);
+      for (uint32_t i = index.edgeStarts[cell]; i < index.edgeStarts[cell + 1];
+           ++i) {
+        const uint32_t edge = index.edges[i];
+        const glm::dvec2& a = vertices[edge];
+        const glm::dvec2& b = vertices[(edge + 1) % vertices.size()];
+
+        // An edge listed in several of these cells is only checked in the
+        // first one.
+        const uint32_t edgeColumn =
+            std::max(index.column(glm::min(a.x, b.x)), firstColumn);
+        const uint32_t edgeRow =
+            std::max(index.row(glm::min(a.y, b.y)), firstRow);
+        if (edgeColumn != column || edgeRow != row) {
+          continue;
+        }
 
-    // Check if an arbitrary point on the bounding globe rectangle is
-    // inside the polygon.
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        return false;
+        if (outline.intersectsSegment(a, b)) {
+          return true;
+        }
       }
     }
+  }
 
-    // Now we know the rectangle does not fully contain the polygon and the
-    // polygon does not fully contain the rectangle. Now check if the polygon
-    // perimeter intersects the bounding globe rectangle edges.
-    for (size_t j = 0; j < vertices.size(); ++j) {
-      const glm::dvec2& a = vertices[j];
-      const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
+  return false;
+}
 
-      const glm::dvec2 ba = a - b;
+bool CartographicPolygon::outlineIsWithin(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const RectangleOutline& outline) const noexcept {
+  if (!boundingRectanglesIntersect(rectangle, *this)) {
+    return false;
+  }
 
-      // Check each rectangle edge.
-      for (size_t k = 0; k < 4; ++k) {
-        const glm::dvec2& cd = rectangleEdges[k];
-        const glm::dmat2 lineSegmentMatrix(cd, ba);
-        const glm::dvec2 ca = a - rectangleCorners[k];
+  // First check if an arbitrary point on the bounding globe rectangle is
+  // inside the polygon. If it is outside, then this polygon does not entirely
+  // cull the tile.
+  if (!this->containsPoint(outline.corners[0])) {
+    return false;
+  }
 
-        // s and t are calculated such that:
-        // line_intersection = a + t * ab = c + s * cd
-        const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
+  // There is no intersection with the perimeter and at least one point is
+  // inside the polygon so the tile is completely inside this polygon.
+  return !this->perimeterIntersectsOutline(outline);
+}
 
-        // check that the intersection is within the line segments
-        if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
-          return false;
-        }
-      }
+bool CartographicPolygon::outlineIntersects(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const RectangleOutline& outline) const noexcept {
+  if (!boundingRectanglesIntersect(rectangle, *this)) {
+    return false;
+  }
+
+  // Check if an arbitrary point on the polygon is in the globe rectangle.
+  const glm::dvec2& vertex = this->_vertices[0];
+  if (IntersectionTests::pointInTriangle(
+          vertex,
+          outline.corners[0],
+          outline.corners[1],
+          outline.corners[2]) ||
+      IntersectionTests::pointInTriangle(
+          vertex,
+          outline.corners[0],
+          outline.corners[2],
+          outline.corners[3])) {
+    return true;
+  }
+
+  // Check if an arbitrary point on the bounding globe rectangle is
+  // inside the polygon.
+  if (this->containsPoint(outline.corners[0])) {
+    return true;
+  }
+
+  // Now we know the rectangle does not fully contain the polygon and the
+  // polygon does not fully contain the rectangle. Now check if the polygon
+  // perimeter intersects the bounding globe rectangle edges.
+  return this->perimeterIntersectsOutline(outline);
+}
+
+bool CartographicPolygon::containsRectangle(
+    const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
+  return this->outlineIsWithin(rectangle, RectangleOutline(rectangle));
+}
+
+bool CartographicPolygon::intersectsRectangle(
+    const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
+  return this->outlineIntersects(rectangle, RectangleOutline(rectangle));
+}
+
+/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+  const RectangleOutline outline(rectangle);
+
+  // Iterate through all polygons.
+  for (const CartographicPolygon& selection : cartographicPolygons) {
+    if (selection.outlineIsWithin(rectangle, outline)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*static*/ bool CartographicPolygon::rectangleIsOutsidePolygons(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const std::vector<CesiumGeospatial::CartographicPolygon>&
+        cartographicPolygons) noexcept {
+  const RectangleOutline outline(rectangle);
+
+  // Iterate through all polygons.
+  for (const CartographicPolygon& selection : cartographicPolygons) {
+    if (selection.outlineIntersects(rectangle, outline)) {
+      return false;
     }
   }
 
@@ -5,6 +5,8 @@
 #include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <cassert>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeospatial {
@@ -16,6 +18,17 @@ Ellipsoid::geodeticSurfaceNormal(const glm::dvec3& position) const noexcept {
   return glm::normalize(position * this->_oneOverRadiiSquared);
 }
 
+void Ellipsoid::geodeticSurfaceNormal(
+    gsl::span<const glm::dvec3> positions,
+    gsl::span<glm::dvec3> normals) const noexcept {
+  assert(positions.size() == normals.size());
+
+  const glm::dvec3 oneOverRadiiSquared = this->_oneOverRadiiSquared;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    normals[i] = glm::normalize(positions[i] * oneOverRadiiSquared);
+  }
+}
+
 glm::dvec3 Ellipsoid::geodeticSurfaceNormal(
     const Cartographic& cartographic) const noexcept {
   const double longitude = cartographic.longitude;
@@ -38,6 +51,35 @@ glm::dvec3 Ellipsoid::cartographicToCartesian(
   return k + n;
 }
 
+void Ellipsoid::cartographicToCartesian(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec3> cartesians) const noexcept {
+  assert(cartographics.size() == cartesians.size());
+
+  // The trigonometric functions are evaluated in a first pass, so that the
+  // remaining arithmetic is a second pass without function calls, which the
+  // compiler can vectorize.
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const double longitude = cartographics[i].longitude;
+    const double latitude = cartographics[i].latitude;
+    const double cosLatitude = glm::cos(latitude);
+    cartesians[i] = glm::dvec3(
+        cosLatitude * glm::cos(longitude),
+        cosLatitude * glm::sin(longitude),
+        glm::sin(latitude));
+  }
+
+  const glm::dvec3 radiiSquared = this->_radiiSquared;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    glm::dvec3 n = glm::normalize(cartesians[i]);
+    glm::dvec3 k = radiiSquared * n;
+    const double gamma = sqrt(glm::dot(n, k));
+    k /= gamma;
+    n *= cartographics[i].height;
+    cartesians[i] = k + n;
+  }
+}
+
 std::optional<Cartographic>
 Ellipsoid::cartesianToCartographic(const glm::dvec3& cartesian) const noexcept {
   std::optional<glm::dvec3> p = this->scaleToGeodeticSurface(cartesian);
@@ -56,6 +98,16 @@ Ellipsoid::cartesianToCartographic(const glm::dvec3& cartesian) const noexcept {
   return Cartographic(longitude, latitude, height);
 }
 
+void Ellipsoid::cartesianToCartographic(
+    gsl::span<const glm::dvec3> cartesians,
+    gsl::span<std::optional<Cartographic>> cartographics) const noexcept {
+  assert(cartesians.size() == cartographics.size());
+
+  for (size_t i = 0; i < cartesians.size(); ++i) {
+    cartographics[i] = this->cartesianToCartographic(cartesians[i]);
+  }
+}
+
 std::optional<glm::dvec3>
 Ellipsoid::scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept {
   const double positionX = cartesian.x;
@@ -145,6 +197,16 @@ Ellipsoid::scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept {
       positionZ * zMultiplier);
 }
 
+void Ellipsoid::scaleToGeodeticSurface(
+    gsl::span<const glm::dvec3> cartesians,
+    gsl::span<std::optional<glm::dvec3>> scaled) const noexcept {
+  assert(cartesians.size() == scaled.size());
+
+  for (size_t i = 0; i < cartesians.size(); ++i) {
+    scaled[i] = this->scaleToGeodeticSurface(cartesians[i]);
+  }
+}
+
 std::optional<glm::dvec3> Ellipsoid::scaleToGeocentricSurface(
     const glm::dvec3& cartesian) const noexcept {
 
@@ -4,6 +4,8 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 GeographicProjection::GeographicProjection(const Ellipsoid& ellipsoid) noexcept
@@ -20,6 +22,19 @@ GeographicProjection::project(const Cartographic& cartographic) const noexcept {
       cartographic.height);
 }
 
+void GeographicProjection::project(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec2> projected) const noexcept {
+  assert(cartographics.size() == projected.size());
+
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    projected[i] = glm::dvec2(
+        cartographics[i].longitude * semimajorAxis,
+        cartographics[i].latitude * semimajorAxis);
+  }
+}
+
 CesiumGeometry::Rectangle GeographicProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
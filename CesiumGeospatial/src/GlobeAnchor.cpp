@@ -4,6 +4,8 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <cassert>
+
 namespace {
 
 glm::dmat4 adjustOrientationForMove(
@@ -75,6 +77,19 @@ glm::dmat4 GlobeAnchor::getAnchorToLocalTransform(
          this->_anchorToFixed;
 }
 
+/*static*/ void GlobeAnchor::getAnchorToLocalTransforms(
+    gsl::span<const GlobeAnchor> anchors,
+    const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+    gsl::span<glm::dmat4> anchorToLocalTransforms) {
+  assert(anchors.size() == anchorToLocalTransforms.size());
+
+  const glm::dmat4 ecefToLocal =
+      localCoordinateSystem.getEcefToLocalTransformation();
+  for (size_t i = 0; i < anchors.size(); ++i) {
+    anchorToLocalTransforms[i] = ecefToLocal * anchors[i]._anchorToFixed;
+  }
+}
+
 void GlobeAnchor::setAnchorToLocalTransform(
     const LocalHorizontalCoordinateSystem& localCoordinateSystem,
     const glm::dmat4& newAnchorToLocal,
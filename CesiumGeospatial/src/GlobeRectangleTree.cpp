@@ -0,0 +1,190 @@
+#include "CesiumGeospatial/GlobeRectangleTree.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace CesiumUtility;
+
+namespace CesiumGeospatial {
+
+namespace {
+
+// Each node is split into this many slices by longitude, and each slice into
+// this many groups by latitude, so a node has up to the square of this many
+// children. A leaf holds up to that many entries.
+constexpr size_t sliceCount = 3;
+constexpr size_t maximumChildren = sliceCount * sliceCount;
+
+size_t divideRoundingUp(size_t numerator, size_t denominator) noexcept {
+  return (numerator + denominator - 1) / denominator;
+}
+
+} // namespace
+
+GlobeRectangleTree::GlobeRectangleTree(
+    const std::vector<GlobeRectangle>& rectangles)
+    : _size(rectangles.size()) {
+  this->_entries.reserve(rectangles.size());
+  for (size_t i = 0; i < rectangles.size(); ++i) {
+    const GlobeRectangle& rectangle = rectangles[i];
+    if (rectangle.isEmpty()) {
+      continue;
+    }
+
+    if (rectangle.getWest() <= rectangle.getEast()) {
+      this->_entries.emplace_back(Entry{
+          Box{rectangle.getWest(),
+              rectangle.getSouth(),
+              rectangle.getEast(),
+              rectangle.getNorth()},
+          i});
+    } else {
+      this->_entries.emplace_back(Entry{
+          Box{rectangle.getWest(),
+              rectangle.getSouth(),
+              Math::OnePi,
+              rectangle.getNorth()},
+          i});
+      this->_entries.emplace_back(Entry{
+          Box{-Math::OnePi,
+              rectangle.getSouth(),
+              rectangle.getEast(),
+              rectangle.getNorth()},
+          i});
+    }
+  }
+
+  if (this->_entries.empty()) {
+    return;
+  }
+
+  this->_nodes.emplace_back();
+  this->buildNode(0, 0, this->_entries.size());
+}
+
+void GlobeRectangleTree::findIntersecting(
+    const GlobeRectangle& rectangle,
+    std::vector<size_t>& result) const {
+  result.clear();
+  if (this->_nodes.empty() || rectangle.isEmpty()) {
+    return;
+  }
+
+  if (rectangle.getWest() <= rectangle.getEast()) {
+    this->findIntersecting(
+        0,
+        Box{rectangle.getWest(),
+            rectangle.getSouth(),
+            rectangle.getEast(),
+            rectangle.getNorth()},
+        result);
+  } else {
+    this->findIntersecting(
+        0,
+        Box{rectangle.getWest(),
+            rectangle.getSouth(),
+            Math::OnePi,
+            rectangle.getNorth()},
+        result);
+    this->findIntersecting(
+        0,
+        Box{-Math::OnePi,
+            rectangle.getSouth(),
+            rectangle.getEast(),
+            rectangle.getNorth()},
+        result);
+  }
+
+  // A rectangle split at the anti-meridian may be found twice.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+void GlobeRectangleTree::buildNode(size_t nodeIndex, size_t begin, size_t end) {
+  const auto entriesBegin = this->_entries.begin();
+
+  Box box = this->_entries[begin].box;
+  for (size_t i = begin + 1; i < end; ++i) {
+    const Box& entryBox = this->_entries[i].box;
+    box.west = std::min(box.west, entryBox.west);
+    box.south = std::min(box.south, entryBox.south);
+    box.east = std::max(box.east, entryBox.east);
+    box.north = std::max(box.north, entryBox.north);
+  }
+
+  const size_t count = end - begin;
+  if (count <= maximumChildren) {
+    this->_nodes[nodeIndex] = Node{box, begin, count, true};
+    return;
+  }
+
+  // Sort-Tile-Recursive packing: sort the entries into vertical slices by
+  // longitude, then each slice into groups by latitude. Each group becomes a
+  // child.
+  std::sort(
+      entriesBegin + std::ptrdiff_t(begin),
+      entriesBegin + std::ptrdiff_t(end),
+      [](const Entry& a, const Entry& b) {
+        return a.box.west + a.box.east < b.box.west + b.box.east;
+      });
+
+  std::vector<std::pair<size_t, size_t>> groups;
+  groups.reserve(maximumChildren);
+
+  const size_t sliceSize = divideRoundingUp(count, sliceCount);
+  for (size_t sliceBegin = begin; sliceBegin < end; sliceBegin += sliceSize) {
+    const size_t sliceEnd = std::min(sliceBegin + sliceSize, end);
+    std::sort(
+        entriesBegin + std::ptrdiff_t(sliceBegin),
+        entriesBegin + std::ptrdiff_t(sliceEnd),
+        [](const Entry& a, const Entry& b) {
+          return a.box.south + a.box.north < b.box.south + b.box.north;
+        });
+
+    const size_t groupSize =
+        divideRoundingUp(sliceEnd - sliceBegin, sliceCount);
+    for (size_t groupBegin = sliceBegin; groupBegin < sliceEnd;
+         groupBegin += groupSize) {
+      groups.emplace_back(
+          groupBegin,
+          std::min(groupBegin + groupSize, sliceEnd));
+    }
+  }
+
+  // The children of a node are adjacent, so allocate them all before building
+  // any of their own children.
+  const size_t firstChild = this->_nodes.size();
+  this->_nodes.resize(firstChild + groups.size());
+  this->_nodes[nodeIndex] = Node{box, firstChild, groups.size(), false};
+
+  for (size_t i = 0; i < groups.size(); ++i) {
+    this->buildNode(firstChild + i, groups[i].first, groups[i].second);
+  }
+}
+
+void GlobeRectangleTree::findIntersecting(
+    size_t nodeIndex,
+    const Box& box,
+    std::vector<size_t>& result) const {
+  const auto overlaps = [&box](const Box& other) {
+    return other.west <= box.east && other.east >= box.west &&
+           other.south <= box.north && other.north >= box.south;
+  };
+
+  const Node& node = this->_nodes[nodeIndex];
+  if (!overlaps(node.box)) {
+    return;
+  }
+
+  for (size_t i = node.first; i < node.first + node.count; ++i) {
+    if (!node.isLeaf) {
+      this->findIntersecting(i, box, result);
+    } else if (overlaps(this->_entries[i].box)) {
+      result.emplace_back(this->_entries[i].index);
+    }
+  }
+}
+
+} // namespace CesiumGeospatial
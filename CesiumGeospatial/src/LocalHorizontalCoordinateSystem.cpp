@@ -5,6 +5,8 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/mat3x3.hpp>
 
+#include <cassert>
+
 using namespace CesiumGeospatial;
 
 namespace {
@@ -44,6 +46,25 @@ glm::dvec3 directionToEnuVector(LocalDirection direction) {
   }
 }
 
+// Transforms positions by the rotation, scale, and translation of a matrix,
+// ignoring its last row like the single-position conversions do. The 3x3 part
+// and the translation are hoisted out of the loop so that it is a plain
+// multiply-add per component.
+template <typename TOutput>
+void transformPositions(
+    const glm::dmat4& transform,
+    const glm::dvec3& offset,
+    gsl::span<const glm::dvec3> positions,
+    gsl::span<TOutput> results) noexcept {
+  assert(positions.size() == results.size());
+
+  const glm::dmat3 rotationScale(transform);
+  const glm::dvec3 translation = glm::dvec3(transform[3]) - offset;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    results[i] = TOutput(rotationScale * positions[i] + translation);
+  }
+}
+
 } // namespace
 
 LocalHorizontalCoordinateSystem::LocalHorizontalCoordinateSystem(
@@ -102,11 +123,42 @@ glm::dvec3 LocalHorizontalCoordinateSystem::localPositionToEcef(
   return glm::dvec3(this->_localToEcef * glm::dvec4(localPosition, 1.0));
 }
 
+void LocalHorizontalCoordinateSystem::localPositionToEcef(
+    gsl::span<const glm::dvec3> localPositions,
+    gsl::span<glm::dvec3> ecefPositions) const noexcept {
+  transformPositions(
+      this->_localToEcef,
+      glm::dvec3(0.0),
+      localPositions,
+      ecefPositions);
+}
+
+void LocalHorizontalCoordinateSystem::localPositionToEcefRelativeToCenter(
+    gsl::span<const glm::dvec3> localPositions,
+    const glm::dvec3& centerEcef,
+    gsl::span<glm::vec3> relativePositions) const noexcept {
+  transformPositions(
+      this->_localToEcef,
+      centerEcef,
+      localPositions,
+      relativePositions);
+}
+
 glm::dvec3 LocalHorizontalCoordinateSystem::ecefPositionToLocal(
     const glm::dvec3& ecefPosition) const noexcept {
   return glm::dvec3(this->_ecefToLocal * glm::dvec4(ecefPosition, 1.0));
 }
 
+void LocalHorizontalCoordinateSystem::ecefPositionToLocal(
+    gsl::span<const glm::dvec3> ecefPositions,
+    gsl::span<glm::dvec3> localPositions) const noexcept {
+  transformPositions(
+      this->_ecefToLocal,
+      glm::dvec3(0.0),
+      ecefPositions,
+      localPositions);
+}
+
 glm::dvec3 LocalHorizontalCoordinateSystem::localDirectionToEcef(
     const glm::dvec3& localDirection) const noexcept {
   return glm::dvec3(this->_localToEcef * glm::dvec4(localDirection, 0.0));
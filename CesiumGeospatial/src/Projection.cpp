@@ -22,6 +22,26 @@ projectPosition(const Projection& projection, const Cartographic& position) {
   return std::visit(Operation{position}, projection);
 }
 
+void projectPositions(
+    const Projection& projection,
+    gsl::span<const Cartographic> positions,
+    gsl::span<glm::dvec2> projected) {
+  struct Operation {
+    gsl::span<const Cartographic> positions;
+    gsl::span<glm::dvec2> projected;
+
+    void operator()(const GeographicProjection& geographic) noexcept {
+      geographic.project(positions, projected);
+    }
+
+    void operator()(const WebMercatorProjection& webMercator) noexcept {
+      webMercator.project(positions, projected);
+    }
+  };
+
+  std::visit(Operation{positions, projected}, projection);
+}
+
 Cartographic
 unprojectPosition(const Projection& projection, const glm::dvec3& position) {
   struct Operation {
@@ -2,6 +2,8 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
 #include <glm/geometric.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/matrix.hpp>
@@ -136,12 +138,21 @@ S2CellBoundingVolume::S2CellBoundingVolume(
     const Ellipsoid& ellipsoid)
     : _cellID(cellID),
       _minimumHeight(minimumHeight),
-      _maximumHeight(maximumHeight) {
+      _maximumHeight(maximumHeight),
+      _boundingSphere(glm::dvec3(0.0), 0.0) {
   Cartographic result = this->_cellID.getCenter();
   result.height = (this->_minimumHeight + this->_maximumHeight) * 0.5;
   this->_center = ellipsoid.cartographicToCartesian(result);
   this->_boundingPlanes = computeBoundingPlanes(*this, ellipsoid);
   this->_vertices = computeVertices(this->_boundingPlanes);
+
+  double radiusSquared = 0.0;
+  for (const glm::dvec3& vertex : this->_vertices) {
+    const glm::dvec3 offset = vertex - this->_center;
+    radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+  }
+  this->_boundingSphere =
+      CesiumGeometry::BoundingSphere(this->_center, glm::sqrt(radiusSquared));
 }
 
 glm::dvec3 S2CellBoundingVolume::getCenter() const noexcept {
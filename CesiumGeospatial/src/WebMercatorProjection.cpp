@@ -7,6 +7,8 @@
 #include <glm/exponential.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 /*static*/ const double WebMercatorProjection::MAXIMUM_LATITUDE =
@@ -37,6 +39,32 @@ glm::dvec3 WebMercatorProjection::project(
       cartographic.height);
 }
 
+void WebMercatorProjection::project(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec2> projected) const noexcept {
+  assert(cartographics.size() == projected.size());
+
+  // This is geodeticLatitudeToMercatorAngle split in two passes, so that the
+  // calls to sin and to log are each in a loop of their own, which the
+  // compiler can turn into calls of a vector math library.
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const double latitude = CesiumUtility::Math::clamp(
+        cartographics[i].latitude,
+        -WebMercatorProjection::MAXIMUM_LATITUDE,
+        WebMercatorProjection::MAXIMUM_LATITUDE);
+    projected[i] = glm::dvec2(
+        cartographics[i].longitude * semimajorAxis,
+        glm::sin(latitude));
+  }
+
+  for (glm::dvec2& position : projected) {
+    const double sinLatitude = position.y;
+    position.y = 0.5 * glm::log((1.0 + sinLatitude) / (1.0 - sinLatitude)) *
+                 semimajorAxis;
+  }
+}
+
 CesiumGeometry::Rectangle WebMercatorProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
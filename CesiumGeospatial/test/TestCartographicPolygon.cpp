@@ -0,0 +1,109 @@
+#include "CesiumGeospatial/CartographicPolygon.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumUtility/Math.h"
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+// A star around longitude and latitude 0 with the given number of spikes,
+// which reach out 10 degrees, with notches 5 degrees from the center between
+// them.
+CartographicPolygon createStar(size_t spikeCount) {
+  std::vector<glm::dvec2> vertices;
+  const size_t vertexCount = spikeCount * 2;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const double angle = Math::TwoPi * double(i) / double(vertexCount);
+    const double radius = Math::degreesToRadians(i % 2 == 0 ? 10.0 : 5.0);
+    vertices.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+  }
+  return CartographicPolygon(vertices);
+}
+
+// A rectangle of the given size in degrees around a point in degrees.
+GlobeRectangle
+createRectangle(double longitude, double latitude, double halfSize) {
+  return GlobeRectangle::fromDegrees(
+      longitude - halfSize,
+      latitude - halfSize,
+      longitude + halfSize,
+      latitude + halfSize);
+}
+
+} // namespace
+
+TEST_CASE("CartographicPolygon rectangle queries") {
+  // Few spikes test every triangle and edge, many spikes use the spatial
+  // index.
+  const size_t spikeCount = GENERATE(as<size_t>{}, 5, 50, 500);
+  const CartographicPolygon star = createStar(spikeCount);
+  const std::vector<CartographicPolygon> polygons{star};
+
+  // The angle of the first notch, between the first two spikes.
+  const double notchAngle = Math::OnePi / double(spikeCount);
+
+  SECTION("a rectangle in the center is inside") {
+    const GlobeRectangle rectangle = createRectangle(0.0, 0.0, 1.0);
+    CHECK(star.containsRectangle(rectangle));
+    CHECK(star.intersectsRectangle(rectangle));
+    CHECK(CartographicPolygon::rectangleIsWithinPolygons(rectangle, polygons));
+    CHECK(
+        !CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+  }
+
+  SECTION("a rectangle beyond the spikes is outside") {
+    const GlobeRectangle rectangle = createRectangle(20.0, 0.0, 1.0);
+    CHECK(!star.containsRectangle(rectangle));
+    CHECK(!star.intersectsRectangle(rectangle));
+    CHECK(!CartographicPolygon::rectangleIsWithinPolygons(rectangle, polygons));
+    CHECK(CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+  }
+
+  SECTION("a rectangle around the tip of a spike intersects") {
+    const GlobeRectangle rectangle = createRectangle(10.0, 0.0, 0.01);
+    CHECK(!star.containsRectangle(rectangle));
+    CHECK(star.intersectsRectangle(rectangle));
+    CHECK(!CartographicPolygon::rectangleIsWithinPolygons(rectangle, polygons));
+    CHECK(
+        !CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+  }
+
+  SECTION("a rectangle across a spike intersects") {
+    // A thin rectangle from the notch on one side of the first spike to the
+    // notch on the other side, so that only the spike's edges cross it.
+    const double halfHeight = 7.5 * std::sin(notchAngle);
+    const GlobeRectangle rectangle =
+        GlobeRectangle::fromDegrees(7.499, -halfHeight, 7.501, halfHeight);
+    CHECK(!star.containsRectangle(rectangle));
+    CHECK(star.intersectsRectangle(rectangle));
+    CHECK(
+        !CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+  }
+
+  SECTION("a rectangle in a notch is outside") {
+    // Halfway between the notch and the tips of the spikes on either side,
+    // where the notch is narrowest with the most spikes.
+    const double radius = 7.5;
+    const GlobeRectangle rectangle = createRectangle(
+        radius * std::cos(notchAngle),
+        radius * std::sin(notchAngle),
+        0.001);
+    CHECK(!star.containsRectangle(rectangle));
+    CHECK(!star.intersectsRectangle(rectangle));
+    CHECK(CartographicPolygon::rectangleIsOutsidePolygons(rectangle, polygons));
+  }
+
+  SECTION("a copy gives the same answers") {
+    const CartographicPolygon copy = star;
+    CHECK(copy.containsRectangle(createRectangle(0.0, 0.0, 1.0)));
+    CHECK(!copy.intersectsRectangle(createRectangle(20.0, 0.0, 1.0)));
+    CHECK(copy.intersectsRectangle(createRectangle(10.0, 0.0, 0.01)));
+  }
+}
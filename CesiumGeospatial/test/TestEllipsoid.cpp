@@ -0,0 +1,80 @@
+#include "CesiumGeospatial/Ellipsoid.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <optional>
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+TEST_CASE("Ellipsoid batch conversions") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+
+  const std::vector<Cartographic> cartographics{
+      Cartographic(0.0, 0.0, 0.0),
+      Cartographic::fromDegrees(-75.6, 40.04, 100.0),
+      Cartographic::fromDegrees(179.9, -89.5, -50.0),
+      Cartographic::fromDegrees(12.5, 41.9, 20000.0)};
+
+  std::vector<glm::dvec3> cartesians(cartographics.size());
+  ellipsoid.cartographicToCartesian(cartographics, cartesians);
+
+  SECTION("cartographicToCartesian matches the single conversion") {
+    for (size_t i = 0; i < cartographics.size(); ++i) {
+      const glm::dvec3 expected =
+          ellipsoid.cartographicToCartesian(cartographics[i]);
+      CHECK(Math::equalsEpsilon(cartesians[i], expected, 0.0, 1e-8));
+    }
+  }
+
+  SECTION("cartesianToCartographic matches the single conversion") {
+    std::vector<glm::dvec3> withCenter = cartesians;
+    withCenter.emplace_back(0.0, 0.0, 0.0);
+
+    std::vector<std::optional<Cartographic>> result(withCenter.size());
+    ellipsoid.cartesianToCartographic(withCenter, result);
+
+    for (size_t i = 0; i < cartographics.size(); ++i) {
+      const std::optional<Cartographic> expected =
+          ellipsoid.cartesianToCartographic(withCenter[i]);
+      REQUIRE(result[i]);
+      REQUIRE(expected);
+      CHECK(result[i]->longitude == expected->longitude);
+      CHECK(result[i]->latitude == expected->latitude);
+      CHECK(result[i]->height == expected->height);
+      CHECK(Math::equalsEpsilon(
+          result[i]->height,
+          cartographics[i].height,
+          0.0,
+          1e-4));
+    }
+    CHECK(!result.back());
+  }
+
+  SECTION("geodeticSurfaceNormal matches the single computation") {
+    std::vector<glm::dvec3> normals(cartesians.size());
+    ellipsoid.geodeticSurfaceNormal(cartesians, normals);
+
+    for (size_t i = 0; i < cartesians.size(); ++i) {
+      CHECK(normals[i] == ellipsoid.geodeticSurfaceNormal(cartesians[i]));
+      CHECK(Math::equalsEpsilon(
+          normals[i],
+          ellipsoid.geodeticSurfaceNormal(cartographics[i]),
+          0.0,
+          1e-12));
+    }
+  }
+
+  SECTION("scaleToGeodeticSurface matches the single computation") {
+    std::vector<std::optional<glm::dvec3>> scaled(cartesians.size());
+    ellipsoid.scaleToGeodeticSurface(cartesians, scaled);
+
+    for (size_t i = 0; i < cartesians.size(); ++i) {
+      CHECK(scaled[i] == ellipsoid.scaleToGeodeticSurface(cartesians[i]));
+    }
+  }
+}
@@ -5,6 +5,8 @@
 #include <catch2/catch.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -179,3 +181,27 @@ TEST_CASE("GlobeAnchor") {
         Math::Epsilon10));
   }
 }
+
+TEST_CASE("GlobeAnchor::getAnchorToLocalTransforms") {
+  LocalHorizontalCoordinateSystem local(
+      Cartographic::fromDegrees(12.0, 23.0, 1000.0),
+      LocalDirection::East,
+      LocalDirection::Up,
+      LocalDirection::North);
+
+  const std::vector<GlobeAnchor> anchors{
+      GlobeAnchor(glm::dmat4(1.0)),
+      GlobeAnchor::fromAnchorToLocalTransform(
+          local,
+          Transforms::createTranslationRotationScaleMatrix(
+              glm::dvec3(10.0, 20.0, 30.0),
+              glm::dquat(glm::dvec3(0.1, 0.2, 0.3)),
+              glm::dvec3(2.0)))};
+
+  std::vector<glm::dmat4> anchorToLocal(anchors.size());
+  GlobeAnchor::getAnchorToLocalTransforms(anchors, local, anchorToLocal);
+
+  for (size_t i = 0; i < anchors.size(); ++i) {
+    CHECK(anchorToLocal[i] == anchors[i].getAnchorToLocalTransform(local));
+  }
+}
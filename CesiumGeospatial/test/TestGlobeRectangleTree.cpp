@@ -0,0 +1,100 @@
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumGeospatial/GlobeRectangleTree.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace CesiumGeospatial;
+
+namespace {
+
+// A grid of small rectangles covering the globe, plus a few that cross the
+// anti-meridian.
+std::vector<GlobeRectangle> createRectangles() {
+  std::vector<GlobeRectangle> rectangles;
+  for (int32_t x = -180; x < 180; x += 7) {
+    for (int32_t y = -90; y < 84; y += 6) {
+      rectangles.emplace_back(GlobeRectangle::fromDegrees(
+          double(x),
+          double(y),
+          double(x) + 4.0,
+          double(y) + 5.0));
+    }
+  }
+
+  rectangles.emplace_back(
+      GlobeRectangle::fromDegrees(170.0, -10.0, -170.0, 10.0));
+  rectangles.emplace_back(
+      GlobeRectangle::fromDegrees(179.0, 40.0, -179.0, 50.0));
+  rectangles.emplace_back(GlobeRectangle::EMPTY);
+  return rectangles;
+}
+
+std::vector<size_t> findIntersectingSlowly(
+    const std::vector<GlobeRectangle>& rectangles,
+    const GlobeRectangle& rectangle) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < rectangles.size(); ++i) {
+    if (rectangles[i].computeIntersection(rectangle)) {
+      result.emplace_back(i);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("GlobeRectangleTree") {
+  const std::vector<GlobeRectangle> rectangles = createRectangles();
+  const GlobeRectangleTree tree(rectangles);
+  CHECK(tree.size() == rectangles.size());
+
+  std::vector<size_t> found;
+
+  SECTION("finds every intersecting rectangle") {
+    const std::vector<GlobeRectangle> queries{
+        GlobeRectangle::fromDegrees(-1.0, -1.0, 1.0, 1.0),
+        GlobeRectangle::fromDegrees(10.5, 20.5, 45.0, 60.0),
+        GlobeRectangle::fromDegrees(175.0, -5.0, -175.0, 45.0),
+        GlobeRectangle::fromDegrees(-180.0, -90.0, 180.0, 90.0),
+        GlobeRectangle::fromDegrees(-179.9, 42.0, -179.8, 43.0)};
+
+    for (const GlobeRectangle& query : queries) {
+      tree.findIntersecting(query, found);
+      CHECK(std::is_sorted(found.begin(), found.end()));
+      CHECK(std::adjacent_find(found.begin(), found.end()) == found.end());
+
+      for (const size_t expected : findIntersectingSlowly(rectangles, query)) {
+        CHECK(std::binary_search(found.begin(), found.end(), expected));
+      }
+    }
+  }
+
+  SECTION("finds nothing far from every rectangle") {
+    const GlobeRectangleTree sparseTree(std::vector<GlobeRectangle>{
+        GlobeRectangle::fromDegrees(0.0, 0.0, 1.0, 1.0),
+        GlobeRectangle::fromDegrees(170.0, 0.0, -170.0, 1.0)});
+
+    found.emplace_back(42);
+    sparseTree.findIntersecting(
+        GlobeRectangle::fromDegrees(50.0, 50.0, 60.0, 60.0),
+        found);
+    CHECK(found.empty());
+
+    sparseTree.findIntersecting(
+        GlobeRectangle::fromDegrees(-175.0, 0.25, -174.0, 0.5),
+        found);
+    CHECK(found == std::vector<size_t>{1});
+  }
+
+  SECTION("an empty tree finds nothing") {
+    const GlobeRectangleTree emptyTree;
+    CHECK(emptyTree.size() == 0);
+    emptyTree.findIntersecting(GlobeRectangle::MAXIMUM, found);
+    CHECK(found.empty());
+  }
+}
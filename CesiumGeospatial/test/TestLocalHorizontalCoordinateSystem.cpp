@@ -3,6 +3,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <vector>
+
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
 
@@ -169,3 +171,44 @@ TEST_CASE("LocalHorizontalCoordinateSystem") {
     CHECK(Math::equalsEpsilon(computedByTransform, samePointInTarget, 1e-15));
   }
 }
+
+TEST_CASE("LocalHorizontalCoordinateSystem converts many positions") {
+  LocalHorizontalCoordinateSystem lh(
+      Cartographic::fromDegrees(12.0, 23.0, 1000.0),
+      LocalDirection::East,
+      LocalDirection::South,
+      LocalDirection::Up,
+      1.0 / 100.0);
+
+  const std::vector<glm::dvec3> localPositions{
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(1781.0, 373.0, 7777.2),
+      glm::dvec3(-50.0, 120000.0, -3.5)};
+
+  std::vector<glm::dvec3> ecefPositions(localPositions.size());
+  lh.localPositionToEcef(localPositions, ecefPositions);
+
+  std::vector<glm::dvec3> roundTrip(localPositions.size());
+  lh.ecefPositionToLocal(ecefPositions, roundTrip);
+
+  const glm::dvec3 centerEcef = lh.localPositionToEcef(glm::dvec3(10.0));
+  std::vector<glm::vec3> relativePositions(localPositions.size());
+  lh.localPositionToEcefRelativeToCenter(
+      localPositions,
+      centerEcef,
+      relativePositions);
+
+  for (size_t i = 0; i < localPositions.size(); ++i) {
+    CHECK(Math::equalsEpsilon(
+        ecefPositions[i],
+        lh.localPositionToEcef(localPositions[i]),
+        0.0,
+        1e-8));
+    CHECK(Math::equalsEpsilon(roundTrip[i], localPositions[i], 0.0, 1e-6));
+    CHECK(Math::equalsEpsilon(
+        glm::dvec3(relativePositions[i]),
+        ecefPositions[i] - centerEcef,
+        0.0,
+        1e-3));
+  }
+}
@@ -6,6 +6,8 @@
 #include <catch2/catch.hpp>
 #include <glm/geometric.hpp>
 
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -105,3 +107,23 @@ TEST_CASE("computeProjectedRectangleSize") {
         1.0));
   }
 }
+
+TEST_CASE("projectPositions") {
+  const std::vector<Cartographic> positions{
+      Cartographic(0.0, 0.0, 0.0),
+      Cartographic::fromDegrees(-75.6, 40.04, 100.0),
+      Cartographic::fromDegrees(179.9, -84.0, -50.0),
+      Cartographic::fromDegrees(12.5, 89.9, 20000.0)};
+
+  auto projection = GENERATE(
+      Projection(GeographicProjection()),
+      Projection(WebMercatorProjection()));
+
+  std::vector<glm::dvec2> projected(positions.size());
+  projectPositions(projection, positions, projected);
+
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const glm::dvec3 expected = projectPosition(projection, positions[i]);
+    CHECK(Math::equalsEpsilon(projected[i], glm::dvec2(expected), 0.0, 1e-6));
+  }
+}
@@ -127,6 +127,22 @@ TEST_CASE("S2CellBoundingVolume") {
         CullingResult::Inside);
   }
 
+  SECTION("bounding sphere contains the vertices") {
+    const BoundingSphere& sphere = tileS2Cell.getBoundingSphere();
+    CHECK(sphere.getCenter() == tileS2Cell.getCenter());
+    for (const glm::dvec3& vertex : tileS2Cell.getVertices()) {
+      CHECK(
+          glm::distance(vertex, sphere.getCenter()) <=
+          sphere.getRadius() + Math::Epsilon7);
+    }
+
+    Plane outsidePlane(
+        Plane::ORIGIN_YZ_PLANE.getNormal(),
+        Plane::ORIGIN_YZ_PLANE.getDistance() -
+            2 * Ellipsoid::WGS84.getMaximumRadius());
+    CHECK(sphere.intersectPlane(outsidePlane) == CullingResult::Outside);
+  }
+
   SECTION("can construct face 2 (North pole)") {
     S2CellBoundingVolume face2Root(S2CellID::fromToken("5"), 1000.0, 2000.0);
     CHECK(face2Root.getCellID().isValid());
@@ -5,7 +5,11 @@
 #include <CesiumGltf/MeshPrimitive.h>
 
 #include <glm/common.hpp>
+#include <glm/vec3.hpp>
 
+#include <limits>
+#include <optional>
+#include <type_traits>
 #include <variant>
 
 namespace CesiumGltf {
@@ -49,6 +53,76 @@ typedef AccessorView<AccessorTypes::VEC3<float>> PositionAccessorType;
 PositionAccessorType
 getPositionAccessorView(const Model& model, const MeshPrimitive& primitive);
 
+/**
+ * Type definition for all kinds of position accessors, including the quantized
+ * ones allowed by the KHR_mesh_quantization extension.
+ */
+typedef std::variant<
+    AccessorView<AccessorTypes::VEC3<float>>,
+    AccessorView<AccessorTypes::VEC3<int8_t>>,
+    AccessorView<AccessorTypes::VEC3<uint8_t>>,
+    AccessorView<AccessorTypes::VEC3<int16_t>>,
+    AccessorView<AccessorTypes::VEC3<uint16_t>>>
+    QuantizedPositionAccessorType;
+
+/**
+ * Retrieves an accessor view for the position attribute from the given glTF
+ * primitive and model, which may be quantized according to the
+ * KHR_mesh_quantization extension. This verifies that the accessor is of a
+ * valid type. If not, the returned accessor view will be invalid.
+ */
+QuantizedPositionAccessorType getQuantizedPositionAccessorView(
+    const Model& model,
+    const MeshPrimitive& primitive);
+
+/**
+ * Visitor that retrieves the position from the given accessor type as a
+ * glm::vec3. This should be initialized with the target index and with
+ * whether the accessor is normalized. Quantized components of a normalized
+ * accessor are mapped to floats as described by the glTF specification, and
+ * are otherwise converted without scaling.
+ *
+ * std::nullopt is returned if the index is out-of-bounds.
+ */
+struct PositionFromAccessor {
+  template <typename T>
+  std::optional<glm::vec3>
+  operator()(const AccessorView<AccessorTypes::VEC3<T>>& value) {
+    if (index < 0 || index >= value.size()) {
+      return std::nullopt;
+    }
+
+    return toVec3(value.begin()[index], normalized);
+  }
+
+  /**
+   * @brief Converts a position element to a glm::vec3 the same way as the
+   * call operator, so that loops over all of the elements of an accessor can
+   * use {@link AccessorView::begin} instead of checking every index.
+   */
+  template <typename T>
+  static glm::vec3
+  toVec3(const AccessorTypes::VEC3<T>& quantized, bool isNormalized) noexcept {
+    glm::vec3 position(
+        static_cast<float>(quantized.value[0]),
+        static_cast<float>(quantized.value[1]),
+        static_cast<float>(quantized.value[2]));
+    if constexpr (!std::is_same_v<T, float>) {
+      if (isNormalized) {
+        position /= static_cast<float>(std::numeric_limits<T>::max());
+        if constexpr (std::is_signed_v<T>) {
+          position = glm::max(position, glm::vec3(-1.0f));
+        }
+      }
+    }
+
+    return position;
+  }
+
+  int64_t index;
+  bool normalized;
+};
+
 /**
  * Type definition for normal accessor.
  */
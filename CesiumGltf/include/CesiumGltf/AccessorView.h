@@ -2,7 +2,11 @@
 
 #include "CesiumGltf/Model.h"
 
+#include <gsl/span>
+
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <stdexcept>
 
 namespace CesiumGltf {
@@ -91,6 +95,160 @@ public:
    */
   typedef T value_type;
 
+  /**
+   * @brief A random access iterator over the elements of an
+   * {@link AccessorView}, taking the stride into account.
+   *
+   * Unlike {@link AccessorView::operator[]}, the iterator does not check that
+   * it points to an element of the accessor, so loops over all elements don't
+   * pay for a range check of each of them.
+   */
+  class const_iterator {
+  public:
+    /** @brief The category of the iterator. */
+    using iterator_category = std::random_access_iterator_tag;
+    /** @brief The type of the elements. */
+    using value_type = T;
+    /** @brief The type of the distance between two iterators. */
+    using difference_type = std::ptrdiff_t;
+    /** @brief The type of a pointer to an element. */
+    using pointer = const T*;
+    /** @brief The type of a reference to an element. */
+    using reference = const T&;
+
+    /**
+     * @brief Constructs an iterator that doesn't point to any element.
+     */
+    const_iterator() noexcept : _pElement(nullptr), _stride(0) {}
+
+    /**
+     * @brief Constructs an iterator pointing to an element.
+     *
+     * @param pElement The first byte of the element.
+     * @param stride The stride, in bytes, between successive elements.
+     */
+    const_iterator(const std::byte* pElement, int64_t stride) noexcept
+        : _pElement(pElement), _stride(stride) {}
+
+    /** @brief Gets the element this iterator points to. */
+    reference operator*() const noexcept {
+      return *reinterpret_cast<const T*>(this->_pElement);
+    }
+
+    /** @brief Gets a pointer to the element this iterator points to. */
+    pointer operator->() const noexcept {
+      return reinterpret_cast<const T*>(this->_pElement);
+    }
+
+    /** @brief Gets the element at an offset from this iterator. */
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator& operator++() noexcept {
+      this->_pElement += this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator operator++(int) noexcept {
+      const_iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator& operator--() noexcept {
+      this->_pElement -= this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator operator--(int) noexcept {
+      const_iterator result = *this;
+      --(*this);
+      return result;
+    }
+
+    /** @brief Moves forward by a number of elements. */
+    const_iterator& operator+=(difference_type n) noexcept {
+      this->_pElement += n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves back by a number of elements. */
+    const_iterator& operator-=(difference_type n) noexcept {
+      this->_pElement -= n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Gets an iterator a number of elements forward. */
+    friend const_iterator
+    operator+(const_iterator it, difference_type n) noexcept {
+      return it += n;
+    }
+
+    /** @brief Gets an iterator a number of elements forward. */
+    friend const_iterator
+    operator+(difference_type n, const_iterator it) noexcept {
+      return it += n;
+    }
+
+    /** @brief Gets an iterator a number of elements back. */
+    friend const_iterator
+    operator-(const_iterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+
+    /** @brief Gets the number of elements between two iterators. */
+    friend difference_type
+    operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._stride == 0 ? 0
+                              : (lhs._pElement - rhs._pElement) / lhs._stride;
+    }
+
+    /** @brief Checks if two iterators point to the same element. */
+    friend bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement == rhs._pElement;
+    }
+
+    /** @brief Checks if two iterators point to different elements. */
+    friend bool
+    operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement != rhs._pElement;
+    }
+
+    /** @brief Checks if an iterator points to an earlier element. */
+    friend bool
+    operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement < rhs._pElement;
+    }
+
+    /** @brief Checks if an iterator points to a later element. */
+    friend bool
+    operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement > rhs._pElement;
+    }
+
+    /** @brief Checks if an iterator doesn't point to a later element. */
+    friend bool
+    operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement <= rhs._pElement;
+    }
+
+    /** @brief Checks if an iterator doesn't point to an earlier element. */
+    friend bool
+    operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs._pElement >= rhs._pElement;
+    }
+
+  private:
+    const std::byte* _pElement;
+    int64_t _stride;
+  };
+
   /**
    * @brief Construct a new instance not pointing to any data.
    *
@@ -217,6 +375,49 @@ public:
     return this->_pData + this->_offset;
   }
 
+  /**
+   * @brief Returns an iterator to the first element of this accessor.
+   */
+  const_iterator begin() const noexcept {
+    return const_iterator(this->data(), this->_stride);
+  }
+
+  /**
+   * @brief Returns an iterator past the last element of this accessor.
+   */
+  const_iterator end() const noexcept {
+    return const_iterator(
+        this->data() + this->_size * this->_stride,
+        this->_stride);
+  }
+
+  /**
+   * @brief Determines if the elements of this accessor are tightly packed,
+   * without any bytes between them, so that they can be viewed by
+   * {@link asSpan}.
+   */
+  bool isContiguous() const noexcept {
+    return this->_status == AccessorViewStatus::Valid &&
+           this->_stride == static_cast<int64_t>(sizeof(T));
+  }
+
+  /**
+   * @brief Views the elements of this accessor as a span, without copying
+   * them.
+   *
+   * @returns The elements, or an empty span if they are not
+   * {@link isContiguous}.
+   */
+  gsl::span<const T> asSpan() const noexcept {
+    if (!this->isContiguous()) {
+      return gsl::span<const T>();
+    }
+
+    return gsl::span<const T>(
+        reinterpret_cast<const T*>(this->data()),
+        static_cast<size_t>(this->_size));
+  }
+
 private:
   void create(const Model& model, const Accessor& accessor) noexcept {
     const CesiumGltf::BufferView* pBufferView =
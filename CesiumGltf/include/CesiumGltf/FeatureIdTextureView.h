@@ -125,6 +125,20 @@ public:
    */
   int64_t getFeatureID(double u, double v) const noexcept;
 
+  /**
+   * @brief Get the feature IDs from the texture at each of the given texture
+   * coordinates, just like {@link getFeatureID}, but much faster than getting
+   * them one at a time. If the texture is somehow invalid, every feature ID is
+   * -1.
+   *
+   * @param uvs The texture coordinates.
+   * @param featureIds Receives the feature ID at the nearest pixel to each of
+   * the texture coordinates. It must be the same size as `uvs`.
+   */
+  void getFeatureIDs(
+      gsl::span<const glm::dvec2> uvs,
+      gsl::span<int64_t> featureIds) const noexcept;
+
   /**
    * @brief Get the status of this view.
    *
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Library.h"
+#include "CesiumGltf/MeshPrimitive.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltf/PropertyTablePropertyView.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <gsl/span>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <vector>
+
+namespace CesiumGltf {
+
+/**
+ * @brief The values of a property for each feature or each vertex, tightly
+ * packed so that they can be given to the GPU as they are.
+ *
+ * @tparam T The type of the values.
+ */
+template <typename T> struct FeaturePropertyBuffer {
+  /**
+   * @brief The value for each feature or vertex. Those without a value are
+   * zero.
+   */
+  std::vector<T> values;
+
+  /**
+   * @brief 1 for each feature or vertex that has a value, and 0 for each one
+   * that doesn't, because its value is the property's "no data" value or
+   * because it isn't associated with a feature.
+   */
+  std::vector<uint8_t> hasValue;
+};
+
+/**
+ * @brief The type of the values that a {@link PropertyTablePropertyView} with
+ * the given template arguments returns.
+ */
+template <typename T, bool Normalized> struct FeaturePropertyValueType {
+  /** @brief The type of the values. */
+  using type = T;
+};
+
+/** @copydoc FeaturePropertyValueType */
+template <typename T> struct FeaturePropertyValueType<T, true> {
+  /** @brief The type of the values. */
+  using type = typename TypeToNormalizedType<T>::type;
+};
+
+/**
+ * @brief Gets the ID of the feature of each vertex of a primitive.
+ *
+ * The IDs are read from the feature ID attribute or the feature ID texture of
+ * the feature ID set, or are the vertex indices if it has neither.
+ *
+ * @param model The model containing the primitive.
+ * @param primitive The primitive.
+ * @param featureId The feature ID set of the primitive's `EXT_mesh_features`.
+ * @return The feature ID of each vertex of the primitive's `POSITION`
+ * attribute. A vertex whose feature ID is the set's null feature ID, or whose
+ * feature ID can't be read, gets -1.
+ */
+std::vector<int64_t> getFeatureIdsPerVertex(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FeatureId& featureId);
+
+/**
+ * @brief Gets the values of a property for all features of its property
+ * table.
+ *
+ * @param property The view of the property. Only scalar, vecN, and matN
+ * properties are supported.
+ * @return The value for each feature, with all value transforms applied.
+ */
+template <typename T, bool Normalized>
+FeaturePropertyBuffer<typename FeaturePropertyValueType<T, Normalized>::type>
+createPerFeatureBuffer(
+    const PropertyTablePropertyView<T, Normalized>& property) {
+  using ValueType = typename FeaturePropertyValueType<T, Normalized>::type;
+
+  FeaturePropertyBuffer<ValueType> result;
+  result.values.resize(static_cast<size_t>(property.size()), ValueType(0));
+  result.hasValue.resize(result.values.size(), 0);
+  property.getValues(0, result.values, result.hasValue);
+  return result;
+}
+
+/**
+ * @brief Gathers the values for each feature into values for each vertex.
+ *
+ * @param perFeature The value for each feature.
+ * @param featureIds The ID of the feature of each vertex, such as those
+ * returned by {@link getFeatureIdsPerVertex}.
+ * @return The value for each vertex. Vertices whose feature ID is out of range
+ * don't have a value.
+ */
+template <typename T>
+FeaturePropertyBuffer<T> createPerVertexBuffer(
+    const FeaturePropertyBuffer<T>& perFeature,
+    gsl::span<const int64_t> featureIds) {
+  FeaturePropertyBuffer<T> result;
+  result.values.resize(featureIds.size(), T(0));
+  result.hasValue.resize(featureIds.size(), 0);
+
+  const int64_t featureCount = static_cast<int64_t>(perFeature.values.size());
+  for (size_t i = 0; i < featureIds.size(); ++i) {
+    const int64_t featureId = featureIds[i];
+    if (featureId >= 0 && featureId < featureCount) {
+      result.values[i] = perFeature.values[static_cast<size_t>(featureId)];
+      result.hasValue[i] = perFeature.hasValue[static_cast<size_t>(featureId)];
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Caches the values of properties for each vertex of primitives, so
+ * that the feature IDs and the property table are only read once for each
+ * combination of primitive, feature ID set, and property.
+ *
+ * The cache doesn't know when a model changes. Call
+ * {@link invalidatePropertyTable} or {@link invalidatePrimitive} after
+ * changing a property table or a primitive, and {@link clear} before a model
+ * is destroyed.
+ */
+class CESIUMGLTF_API FeaturePropertyBufferCache final {
+public:
+  /**
+   * @brief Gets the value of a property for each vertex of a primitive,
+   * computing it if it isn't cached yet.
+   *
+   * @tparam T The type of the property. Only scalar, vecN, and matN properties
+   * are supported.
+   * @tparam Normalized Whether the property is normalized.
+   * @param model The model containing the primitive.
+   * @param primitive The primitive.
+   * @param featureIdSetIndex The index of the feature ID set in the
+   * primitive's `EXT_mesh_features`.
+   * @param propertyId The ID of the property in the feature ID set's property
+   * table.
+   * @return The value for each vertex, or nullptr if the primitive doesn't
+   * have the feature ID set, the set doesn't have a property table, or the
+   * property doesn't exist or doesn't have this type.
+   */
+  template <typename T, bool Normalized = false>
+  std::shared_ptr<const FeaturePropertyBuffer<
+      typename FeaturePropertyValueType<T, Normalized>::type>>
+  getPerVertexBuffer(
+      const Model& model,
+      const MeshPrimitive& primitive,
+      int64_t featureIdSetIndex,
+      const std::string& propertyId) {
+    using BufferType = FeaturePropertyBuffer<
+        typename FeaturePropertyValueType<T, Normalized>::type>;
+
+    const ExtensionExtMeshFeatures* pMeshFeatures =
+        primitive.getExtension<ExtensionExtMeshFeatures>();
+    const ExtensionModelExtStructuralMetadata* pMetadata =
+        model.getExtension<ExtensionModelExtStructuralMetadata>();
+    if (!pMeshFeatures || !pMetadata) {
+      return nullptr;
+    }
+
+    const FeatureId* pFeatureId = Model::getSafe(
+        &pMeshFeatures->featureIds,
+        static_cast<int32_t>(featureIdSetIndex));
+    if (!pFeatureId || !pFeatureId->propertyTable) {
+      return nullptr;
+    }
+
+    const PropertyTable* pPropertyTable = Model::getSafe(
+        &pMetadata->propertyTables,
+        static_cast<int32_t>(*pFeatureId->propertyTable));
+    if (!pPropertyTable) {
+      return nullptr;
+    }
+
+    Key key{
+        &primitive,
+        featureIdSetIndex,
+        *pFeatureId->propertyTable,
+        propertyId,
+        std::type_index(typeid(BufferType))};
+    auto it = this->_buffers.find(key);
+    if (it != this->_buffers.end()) {
+      return std::static_pointer_cast<const BufferType>(it->second);
+    }
+
+    const PropertyTableView propertyTable(model, *pPropertyTable);
+    const PropertyTablePropertyView<T, Normalized> property =
+        propertyTable.getPropertyView<T, Normalized>(propertyId);
+    if (property.status() != PropertyTablePropertyViewStatus::Valid &&
+        property.status() !=
+            PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      return nullptr;
+    }
+
+    const std::vector<int64_t> featureIds =
+        getFeatureIdsPerVertex(model, primitive, *pFeatureId);
+    std::shared_ptr<const BufferType> pBuffer = std::make_shared<BufferType>(
+        createPerVertexBuffer(createPerFeatureBuffer(property), featureIds));
+    this->_buffers.emplace(std::move(key), pBuffer);
+    return pBuffer;
+  }
+
+  /**
+   * @brief Removes the cached values of the properties of a property table.
+   *
+   * @param propertyTableIndex The index of the property table in the model's
+   * `EXT_structural_metadata`.
+   */
+  void invalidatePropertyTable(int64_t propertyTableIndex) noexcept;
+
+  /**
+   * @brief Removes the cached values for the vertices of a primitive.
+   *
+   * @param primitive The primitive.
+   */
+  void invalidatePrimitive(const MeshPrimitive& primitive) noexcept;
+
+  /**
+   * @brief Removes all cached values.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Gets the number of cached buffers.
+   */
+  size_t size() const noexcept { return this->_buffers.size(); }
+
+private:
+  struct Key {
+    const MeshPrimitive* pPrimitive;
+    int64_t featureIdSetIndex;
+    int64_t propertyTableIndex;
+    std::string propertyId;
+    std::type_index type;
+
+    bool operator<(const Key& rhs) const noexcept {
+      return std::tie(
+                 pPrimitive,
+                 featureIdSetIndex,
+                 propertyTableIndex,
+                 propertyId,
+                 type) < std::tie(
+                             rhs.pPrimitive,
+                             rhs.featureIdSetIndex,
+                             rhs.propertyTableIndex,
+                             rhs.propertyId,
+                             rhs.type);
+    }
+  };
+
+  std::map<Key, std::shared_ptr<const void>> _buffers;
+};
+
+} // namespace CesiumGltf
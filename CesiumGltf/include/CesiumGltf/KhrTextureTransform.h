@@ -64,6 +64,17 @@ public:
    */
   glm::dvec2 applyTransform(double u, double v) const noexcept;
 
+  /**
+   * @brief Gets this texture transformation as a 3x3 matrix that transforms
+   * homogeneous texture coordinates.
+   *
+   * Multiplying `glm::dvec3(u, v, 1.0)` by this matrix gives the same result
+   * as {@link applyTransform}. A renderer can pass it to a shader to
+   * transform the original texture coordinates there, instead of loading
+   * glTFs with texture coordinates that were transformed on the CPU.
+   */
+  glm::dmat3 toMatrix() const noexcept;
+
   /**
    * @brief Gets the texture coordinate set index used by this texture
    * transform. If defined, this should override the set index of the texture's
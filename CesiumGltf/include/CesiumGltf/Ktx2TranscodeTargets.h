@@ -110,6 +110,26 @@ struct CESIUMGLTF_API Ktx2TranscodeTargets {
    */
   GpuCompressedPixelFormat UASTC_RGBA = GpuCompressedPixelFormat::NONE;
 
+  /**
+   * @brief The gpu pixel compression format to transcode ETC1S normal maps
+   * into. If NONE, normal maps are transcoded like any other ETC1S texture
+   * with the same number of channels.
+   *
+   * A two-channel target such as BC5_RG keeps only the X and Y components of
+   * each normal. The renderer must then reconstruct Z.
+   */
+  GpuCompressedPixelFormat ETC1S_NormalMap = GpuCompressedPixelFormat::NONE;
+
+  /**
+   * @brief The gpu pixel compression format to transcode UASTC normal maps
+   * into. If NONE, normal maps are transcoded like any other UASTC texture
+   * with the same number of channels.
+   *
+   * A two-channel target such as BC5_RG keeps only the X and Y components of
+   * each normal. The renderer must then reconstruct Z.
+   */
+  GpuCompressedPixelFormat UASTC_NormalMap = GpuCompressedPixelFormat::NONE;
+
   Ktx2TranscodeTargets() = default;
 
   /**
@@ -120,10 +140,14 @@ struct CESIUMGLTF_API Ktx2TranscodeTargets {
    * @param preserveHighQuality Whether to preserve texture quality when
    * transcoding KTXv2 textures. If this is true, the texture may be fully
    * decompressed instead of picking a lossy target gpu compressed pixel format.
+   * @param twoChannelNormalMaps Whether to transcode normal maps to a
+   * two-channel format, such as BC5_RG, when one is supported. The renderer
+   * must reconstruct the Z component of these normals.
    */
   Ktx2TranscodeTargets(
       const SupportedGpuCompressedPixelFormats& supportedFormats,
-      bool preserveHighQuality);
+      bool preserveHighQuality,
+      bool twoChannelNormalMaps = false);
 };
 
 } // namespace CesiumGltf
\ No newline at end of file
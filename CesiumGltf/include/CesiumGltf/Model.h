@@ -7,6 +7,7 @@
 #include <glm/mat4x4.hpp>
 
 #include <functional>
+#include <vector>
 
 namespace CesiumGltf {
 
@@ -25,6 +26,18 @@ struct CESIUMGLTF_API Model : public ModelSpec {
    */
   CesiumUtility::ErrorList merge(Model&& rhs);
 
+  /**
+   * @brief Merges several other models into this one.
+   *
+   * This is equivalent to merging each of them in turn with
+   * {@link merge(Model&&)}, except that the default scene is combined only
+   * once, and the element arrays of this model are grown only once, so that
+   * merging many models takes time proportional to their total size.
+   *
+   * @param models The models to merge into this one.
+   */
+  CesiumUtility::ErrorList merge(std::vector<Model>&& models);
+
   /**
    * @brief A callback function for {@link forEachRootNodeInScene}.
    */
@@ -117,8 +130,14 @@ struct CESIUMGLTF_API Model : public ModelSpec {
 
   /**
    * @brief Fills in smooth normals for any primitives with missing normals.
+   *
+   * @param octEncode Whether to generate the normals oct-encoded, as two
+   * `UNSIGNED_SHORT` components per vertex in the `_OCT_ENCODED_NORMAL`
+   * attribute, instead of as three floats in `NORMAL`. This takes a third of
+   * the memory, but the renderer has to decode them in its shaders, with a
+   * range maximum of 65535.
    */
-  void generateMissingNormalsSmooth();
+  void generateMissingNormalsSmooth(bool octEncode = false);
 
   /**
    * @brief Safely gets the element with a given index, returning a default
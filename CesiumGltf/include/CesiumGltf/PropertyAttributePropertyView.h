@@ -6,8 +6,12 @@
 #include "CesiumGltf/PropertyTypeTraits.h"
 #include "CesiumGltf/PropertyView.h"
 
+#include <gsl/span>
+
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 namespace CesiumGltf {
@@ -251,6 +255,95 @@ public:
    */
   int64_t size() const noexcept { return _size; }
 
+  /**
+   * @brief Gets the raw values of all vertices without copying them.
+   *
+   * The values do not have offset or scale applied, and vertices that equal
+   * the "no data" value are included as they are. This is only possible when
+   * the attribute's accessor is tightly packed; see
+   * {@link AccessorView::isContiguous}.
+   *
+   * @return The values of all vertices, or an empty span if the view is not
+   * valid or its accessor is not tightly packed.
+   */
+  gsl::span<const ElementType> getRawValues() const noexcept {
+    if (this->_status != PropertyAttributePropertyViewStatus::Valid) {
+      return {};
+    }
+
+    return this->_accessor.asSpan();
+  }
+
+  /**
+   * @brief Gets the values of a range of vertices with all value transforms
+   * applied.
+   *
+   * Each value is the same as the one returned by {@link get}, but the offset,
+   * scale, and "no data" value are each applied to the whole range at once,
+   * which is much faster than getting the vertices one at a time.
+   *
+   * @param firstIndex The index of the first vertex.
+   * @param values Receives the values of the vertices from `firstIndex` to
+   * `firstIndex + values.size()`. A vertex for which {@link get} would return
+   * std::nullopt is set to zero.
+   * @param hasValue If not empty, receives 1 for each vertex that has a value
+   * and 0 for each vertex for which {@link get} would return std::nullopt. It
+   * must be the same size as `values`.
+   * @return The number of vertices that have a value.
+   */
+  int64_t getValues(
+      int64_t firstIndex,
+      gsl::span<ElementType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    assert(firstIndex >= 0 && "index must be non-negative");
+    assert(
+        firstIndex + static_cast<int64_t>(values.size()) <= size() &&
+        "range must not extend past the end of the property");
+    assert(
+        (hasValue.empty() || hasValue.size() == values.size()) &&
+        "hasValue must be empty or the same size as values");
+
+    const std::optional<ElementType> defaultValue = this->defaultValue();
+    if (this->_status ==
+        PropertyAttributePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+      return static_cast<int64_t>(values.size());
+    }
+
+    assert(
+        this->_status == PropertyAttributePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+
+    const auto rawBegin = this->_accessor.begin() + firstIndex;
+    std::copy(
+        rawBegin,
+        rawBegin + static_cast<std::ptrdiff_t>(values.size()),
+        values.begin());
+    transformValues<ElementType>(values, this->offset(), this->scale());
+
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    const std::optional<ElementType> noData = this->noData();
+    if (!noData) {
+      return static_cast<int64_t>(values.size());
+    }
+
+    const ElementType replacement = defaultValue.value_or(ElementType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (rawBegin[static_cast<std::ptrdiff_t>(i)] == *noData) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
 private:
   AccessorView<ElementType> _accessor;
   int64_t _size;
@@ -432,6 +525,103 @@ public:
    */
   int64_t size() const noexcept { return _size; }
 
+  /**
+   * @brief Gets the raw values of all vertices without copying them.
+   *
+   * The values are not normalized and do not have offset or scale applied,
+   * and vertices that equal the "no data" value are included as they are.
+   * This is only possible when the attribute's accessor is tightly packed;
+   * see {@link AccessorView::isContiguous}.
+   *
+   * @return The values of all vertices, or an empty span if the view is not
+   * valid or its accessor is not tightly packed.
+   */
+  gsl::span<const ElementType> getRawValues() const noexcept {
+    if (this->_status != PropertyAttributePropertyViewStatus::Valid) {
+      return {};
+    }
+
+    return this->_accessor.asSpan();
+  }
+
+  /**
+   * @brief Gets the values of a range of vertices, normalized and with all
+   * value transforms applied.
+   *
+   * Each value is the same as the one returned by {@link get}, but the
+   * normalization, offset, scale, and "no data" value are each applied to the
+   * whole range at once, which is much faster than getting the vertices one at
+   * a time.
+   *
+   * @param firstIndex The index of the first vertex.
+   * @param values Receives the values of the vertices from `firstIndex` to
+   * `firstIndex + values.size()`. A vertex for which {@link get} would return
+   * std::nullopt is set to zero.
+   * @param hasValue If not empty, receives 1 for each vertex that has a value
+   * and 0 for each vertex for which {@link get} would return std::nullopt. It
+   * must be the same size as `values`.
+   * @return The number of vertices that have a value.
+   */
+  int64_t getValues(
+      int64_t firstIndex,
+      gsl::span<NormalizedType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    assert(firstIndex >= 0 && "index must be non-negative");
+    assert(
+        firstIndex + static_cast<int64_t>(values.size()) <= size() &&
+        "range must not extend past the end of the property");
+    assert(
+        (hasValue.empty() || hasValue.size() == values.size()) &&
+        "hasValue must be empty or the same size as values");
+
+    const std::optional<NormalizedType> defaultValue = this->defaultValue();
+    if (this->_status ==
+        PropertyAttributePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+      return static_cast<int64_t>(values.size());
+    }
+
+    assert(
+        this->_status == PropertyAttributePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+
+    const auto rawBegin = this->_accessor.begin() + firstIndex;
+    for (size_t i = 0; i < values.size(); ++i) {
+      const ElementType& raw = rawBegin[static_cast<std::ptrdiff_t>(i)];
+      if constexpr (IsMetadataScalar<ElementType>::value) {
+        values[i] = normalize<ElementType>(raw);
+      } else {
+        constexpr glm::length_t N = ElementType::length();
+        using T = typename ElementType::value_type;
+        values[i] = normalize<N, T>(raw);
+      }
+    }
+    transformValues<NormalizedType>(values, this->offset(), this->scale());
+
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    const std::optional<ElementType> noData = this->noData();
+    if (!noData) {
+      return static_cast<int64_t>(values.size());
+    }
+
+    const NormalizedType replacement =
+        defaultValue.value_or(NormalizedType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (rawBegin[static_cast<std::ptrdiff_t>(i)] == *noData) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
 private:
   AccessorView<ElementType> _accessor;
   int64_t _size;
@@ -7,6 +7,7 @@
 
 #include <gsl/span>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -384,6 +385,171 @@ public:
    */
   int64_t size() const noexcept { return _size; }
 
+  /**
+   * @brief Gets the raw values of all elements of the {@link PropertyTable},
+   * without copying them. This is only available for scalar, vecN, and matN
+   * properties.
+   *
+   * The values do not have offset or scale applied, and elements that equal
+   * the "no data" value are included as they are.
+   *
+   * @return The values of all elements, or an empty span if the view is not
+   * valid.
+   */
+  gsl::span<const ElementType> getRawValues() const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar, vecN, and matN properties can be read in bulk");
+    if (this->_status != PropertyTablePropertyViewStatus::Valid) {
+      return {};
+    }
+
+    return gsl::span<const ElementType>(
+        reinterpret_cast<const ElementType*>(_values.data()),
+        static_cast<size_t>(_size));
+  }
+
+  /**
+   * @brief Gets the values of a range of elements in the {@link PropertyTable},
+   * with all value transforms applied. This is only available for scalar,
+   * vecN, and matN properties.
+   *
+   * Each value is the same as the one returned by {@link get}, but the offset,
+   * scale, and "no data" value are each applied to the whole range at once,
+   * which is much faster than getting the elements one at a time.
+   *
+   * @param firstIndex The index of the first element.
+   * @param values Receives the values of the elements from `firstIndex` to
+   * `firstIndex + values.size()`. An element for which {@link get} would
+   * return std::nullopt is set to zero.
+   * @param hasValue If not empty, receives 1 for each element that has a value
+   * and 0 for each element for which {@link get} would return std::nullopt.
+   * It must be the same size as `values`.
+   * @return The number of elements that have a value.
+   */
+  int64_t getValues(
+      int64_t firstIndex,
+      gsl::span<ElementType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar, vecN, and matN properties can be read in bulk");
+    assert(firstIndex >= 0 && "index must be non-negative");
+    assert(
+        firstIndex + static_cast<int64_t>(values.size()) <= size() &&
+        "range must not extend past the end of the property");
+    assert(
+        (hasValue.empty() || hasValue.size() == values.size()) &&
+        "hasValue must be empty or the same size as values");
+
+    const std::optional<ElementType> defaultValue = this->defaultValue();
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+      return static_cast<int64_t>(values.size());
+    }
+
+    assert(
+        this->_status == PropertyTablePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+
+    const ElementType* pRaw =
+        reinterpret_cast<const ElementType*>(_values.data()) + firstIndex;
+    std::copy(pRaw, pRaw + values.size(), values.begin());
+    transformValues<ElementType>(values, this->offset(), this->scale());
+
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    const std::optional<ElementType> noData = this->noData();
+    if (!noData) {
+      return static_cast<int64_t>(values.size());
+    }
+
+    const ElementType replacement = defaultValue.value_or(ElementType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (pRaw[i] == *noData) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Gets the values of a range of elements of a boolean property as a
+   * bitmask.
+   *
+   * Bit `i % 8` of byte `i / 8` of the bitmask receives the value of element
+   * `firstIndex + i`, just as booleans are packed in a
+   * {@link PropertyTable}. Any bits of the last byte past the end of the range
+   * are set to zero. A boolean property cannot have a "no data" value, so
+   * every element has a value.
+   *
+   * @param firstIndex The index of the first element.
+   * @param count The number of elements.
+   * @param bits Receives the bitmask. It must have at least `(count + 7) / 8`
+   * bytes.
+   */
+  void getBooleanValues(
+      int64_t firstIndex,
+      int64_t count,
+      gsl::span<std::byte> bits) const noexcept {
+    static_assert(
+        IsMetadataBoolean<ElementType>::value,
+        "Only boolean properties can be read as a bitmask");
+    assert(firstIndex >= 0 && "index must be non-negative");
+    assert(count >= 0 && "count must be non-negative");
+    assert(
+        firstIndex + count <= size() &&
+        "range must not extend past the end of the property");
+
+    const size_t byteCount = static_cast<size_t>((count + 7) / 8);
+    assert(bits.size() >= byteCount && "bits must be large enough");
+    if (byteCount == 0) {
+      return;
+    }
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      const std::byte fill =
+          *this->defaultValue() ? std::byte(0xff) : std::byte(0);
+      std::fill(bits.data(), bits.data() + byteCount, fill);
+    } else {
+      assert(
+          this->_status == PropertyTablePropertyViewStatus::Valid &&
+          "Check the status() first to make sure view is valid");
+
+      const size_t firstByte = static_cast<size_t>(firstIndex / 8);
+      const int shift = static_cast<int>(firstIndex % 8);
+      if (shift == 0) {
+        std::copy(
+            _values.data() + firstByte,
+            _values.data() + firstByte + byteCount,
+            bits.data());
+      } else {
+        for (size_t i = 0; i < byteCount; ++i) {
+          const size_t byteIndex = firstByte + i;
+          const std::byte next = byteIndex + 1 < _values.size()
+                                     ? _values[byteIndex + 1] << (8 - shift)
+                                     : std::byte(0);
+          bits[i] = (_values[byteIndex] >> shift) | next;
+        }
+      }
+    }
+
+    const int remainder = static_cast<int>(count % 8);
+    if (remainder != 0) {
+      bits[byteCount - 1] &=
+          std::byte(static_cast<uint8_t>((1 << remainder) - 1));
+    }
+  }
+
 private:
   ElementType getNumericValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
@@ -760,6 +926,112 @@ public:
     return this->_status == PropertyTablePropertyViewStatus::Valid ? _size : 0;
   }
 
+  /**
+   * @brief Gets the raw values of all elements of the {@link PropertyTable},
+   * without copying them. This is only available for scalar, vecN, and matN
+   * properties.
+   *
+   * The values are not normalized and do not have offset or scale applied, and
+   * elements that equal the "no data" value are included as they are.
+   *
+   * @return The values of all elements, or an empty span if the view is not
+   * valid.
+   */
+  gsl::span<const ElementType> getRawValues() const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar, vecN, and matN properties can be read in bulk");
+    if (this->_status != PropertyTablePropertyViewStatus::Valid) {
+      return {};
+    }
+
+    return gsl::span<const ElementType>(
+        reinterpret_cast<const ElementType*>(_values.data()),
+        static_cast<size_t>(_size));
+  }
+
+  /**
+   * @brief Gets the values of a range of elements in the {@link PropertyTable},
+   * normalized and with all value transforms applied. This is only available
+   * for scalar, vecN, and matN properties.
+   *
+   * Each value is the same as the one returned by {@link get}, but the
+   * normalization, offset, scale, and "no data" value are each applied to the
+   * whole range at once, which is much faster than getting the elements one at
+   * a time.
+   *
+   * @param firstIndex The index of the first element.
+   * @param values Receives the values of the elements from `firstIndex` to
+   * `firstIndex + values.size()`. An element for which {@link get} would
+   * return std::nullopt is set to zero.
+   * @param hasValue If not empty, receives 1 for each element that has a value
+   * and 0 for each element for which {@link get} would return std::nullopt.
+   * It must be the same size as `values`.
+   * @return The number of elements that have a value.
+   */
+  int64_t getValues(
+      int64_t firstIndex,
+      gsl::span<NormalizedType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar, vecN, and matN properties can be read in bulk");
+    assert(firstIndex >= 0 && "index must be non-negative");
+    assert(
+        firstIndex + static_cast<int64_t>(values.size()) <= size() &&
+        "range must not extend past the end of the property");
+    assert(
+        (hasValue.empty() || hasValue.size() == values.size()) &&
+        "hasValue must be empty or the same size as values");
+
+    const std::optional<NormalizedType> defaultValue = this->defaultValue();
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+      return static_cast<int64_t>(values.size());
+    }
+
+    assert(
+        this->_status == PropertyTablePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+
+    const ElementType* pRaw =
+        reinterpret_cast<const ElementType*>(_values.data()) + firstIndex;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if constexpr (IsMetadataScalar<ElementType>::value) {
+        values[i] = normalize<ElementType>(pRaw[i]);
+      } else {
+        constexpr glm::length_t N = ElementType::length();
+        using T = typename ElementType::value_type;
+        values[i] = normalize<N, T>(pRaw[i]);
+      }
+    }
+    transformValues<NormalizedType>(values, this->offset(), this->scale());
+
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    const std::optional<ElementType> noData = this->noData();
+    if (!noData) {
+      return static_cast<int64_t>(values.size());
+    }
+
+    const NormalizedType replacement =
+        defaultValue.value_or(NormalizedType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (pRaw[i] == *noData) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
 private:
   ElementType getValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
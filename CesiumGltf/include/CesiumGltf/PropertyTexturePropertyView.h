@@ -9,11 +9,13 @@
 #include "CesiumGltf/Sampler.h"
 #include "CesiumGltf/TextureView.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace CesiumGltf {
 /**
@@ -419,6 +421,104 @@ public:
         gsl::span(sample.data(), this->_channels.size()));
   }
 
+  /**
+   * @brief Gets the raw values of the property for each of the given texture
+   * coordinates, just like {@link getRaw}, but much faster than getting them
+   * one at a time. This is only available for scalar and vecN properties.
+   *
+   * @param uvs The texture coordinates.
+   * @param values Receives the value at the nearest pixel to each of the
+   * texture coordinates. It must be the same size as `uvs`.
+   */
+  void getRawValues(
+      gsl::span<const glm::dvec2> uvs,
+      gsl::span<ElementType> values) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar and vecN properties can be sampled in bulk");
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(
+        values.size() == uvs.size() && "values must be the same size as uvs");
+
+    const size_t channelCount = this->_channels.size();
+    std::vector<uint8_t> samples(uvs.size() * channelCount);
+    this->sampleNearestPixels(uvs, this->_channels, samples);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = assembleValueFromChannels<ElementType>(
+          gsl::span(samples.data() + i * channelCount, channelCount));
+    }
+  }
+
+  /**
+   * @brief Gets the values of the property for each of the given texture
+   * coordinates with all value transforms applied, just like {@link get}, but
+   * much faster than getting them one at a time. This is only available for
+   * scalar and vecN properties.
+   *
+   * @param uvs The texture coordinates.
+   * @param values Receives the value for each of the texture coordinates. A
+   * value for which {@link get} would return std::nullopt is set to zero. It
+   * must be the same size as `uvs`.
+   * @param hasValue If not empty, receives 1 for each value and 0 for each
+   * value for which {@link get} would return std::nullopt. It must be the same
+   * size as `uvs`.
+   * @return The number of texture coordinates that have a value.
+   */
+  int64_t getValues(
+      gsl::span<const glm::dvec2> uvs,
+      gsl::span<ElementType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar and vecN properties can be sampled in bulk");
+    assert(
+        values.size() == uvs.size() && "values must be the same size as uvs");
+    assert(
+        (hasValue.empty() || hasValue.size() == uvs.size()) &&
+        "hasValue must be empty or the same size as uvs");
+
+    const std::optional<ElementType> defaultValue = this->defaultValue();
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      return static_cast<int64_t>(values.size());
+    }
+
+    this->getRawValues(uvs, values);
+
+    // The "no data" value is compared with the raw values, so find them before
+    // the values are transformed.
+    const std::optional<ElementType> noData = this->noData();
+    std::vector<uint8_t> isNoData;
+    if (noData) {
+      isNoData.resize(values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        isNoData[i] = values[i] == *noData ? 1 : 0;
+      }
+    }
+
+    transformValues<ElementType>(values, this->offset(), this->scale());
+
+    const ElementType replacement = defaultValue.value_or(ElementType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < isNoData.size(); ++i) {
+      if (isNoData[i]) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
   /**
    * @brief Gets the channels of this property texture property.
    */
@@ -676,6 +776,109 @@ public:
         gsl::span(sample.data(), this->_channels.size()));
   }
 
+  /**
+   * @brief Gets the raw values of the property for each of the given texture
+   * coordinates, just like {@link getRaw}, but much faster than getting them
+   * one at a time. This is only available for scalar and vecN properties.
+   *
+   * @param uvs The texture coordinates.
+   * @param values Receives the value at the nearest pixel to each of the
+   * texture coordinates. It must be the same size as `uvs`.
+   */
+  void getRawValues(
+      gsl::span<const glm::dvec2> uvs,
+      gsl::span<ElementType> values) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar and vecN properties can be sampled in bulk");
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(
+        values.size() == uvs.size() && "values must be the same size as uvs");
+
+    const size_t channelCount = this->_channels.size();
+    std::vector<uint8_t> samples(uvs.size() * channelCount);
+    this->sampleNearestPixels(uvs, this->_channels, samples);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = assembleValueFromChannels<ElementType>(
+          gsl::span(samples.data() + i * channelCount, channelCount));
+    }
+  }
+
+  /**
+   * @brief Gets the values of the property for each of the given texture
+   * coordinates, normalized and with all value transforms applied, just like
+   * {@link get}, but much faster than getting them one at a time. This is only
+   * available for scalar and vecN properties.
+   *
+   * @param uvs The texture coordinates.
+   * @param values Receives the value for each of the texture coordinates. A
+   * value for which {@link get} would return std::nullopt is set to zero. It
+   * must be the same size as `uvs`.
+   * @param hasValue If not empty, receives 1 for each value and 0 for each
+   * value for which {@link get} would return std::nullopt. It must be the same
+   * size as `uvs`.
+   * @return The number of texture coordinates that have a value.
+   */
+  int64_t getValues(
+      gsl::span<const glm::dvec2> uvs,
+      gsl::span<NormalizedType> values,
+      gsl::span<uint8_t> hasValue = {}) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only scalar and vecN properties can be sampled in bulk");
+    assert(
+        values.size() == uvs.size() && "values must be the same size as uvs");
+    assert(
+        (hasValue.empty() || hasValue.size() == uvs.size()) &&
+        "hasValue must be empty or the same size as uvs");
+
+    const std::optional<NormalizedType> defaultValue = this->defaultValue();
+    std::fill(hasValue.begin(), hasValue.end(), uint8_t(1));
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill(values.begin(), values.end(), *defaultValue);
+      return static_cast<int64_t>(values.size());
+    }
+
+    std::vector<ElementType> rawValues(uvs.size());
+    this->getRawValues(uvs, rawValues);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      if constexpr (IsMetadataScalar<ElementType>::value) {
+        values[i] = normalize<ElementType>(rawValues[i]);
+      } else {
+        constexpr glm::length_t N = ElementType::length();
+        using T = typename ElementType::value_type;
+        values[i] = normalize<N, T>(rawValues[i]);
+      }
+    }
+    transformValues<NormalizedType>(values, this->offset(), this->scale());
+
+    const std::optional<ElementType> noData = this->noData();
+    if (!noData) {
+      return static_cast<int64_t>(values.size());
+    }
+
+    const NormalizedType replacement =
+        defaultValue.value_or(NormalizedType(0));
+    const uint8_t replacementHasValue = defaultValue ? 1 : 0;
+    int64_t count = static_cast<int64_t>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (rawValues[i] == *noData) {
+        values[i] = replacement;
+        if (!hasValue.empty()) {
+          hasValue[i] = replacementHasValue;
+        }
+        count -= 1 - replacementHasValue;
+      }
+    }
+
+    return count;
+  }
+
   /**
    * @brief Gets the channels of this property texture property.
    */
@@ -4,6 +4,7 @@
 #include "CesiumGltf/PropertyTypeTraits.h"
 
 #include <glm/common.hpp>
+#include <gsl/span>
 
 #include <algorithm>
 #include <cstdint>
@@ -78,6 +79,28 @@ T transformValue(
   return result;
 }
 
+// Transforms the values in place, one pass per transform, so that the loops
+// are simple enough for the compiler to vectorize.
+template <typename T>
+void transformValues(
+    gsl::span<T> values,
+    const std::optional<T>& offset,
+    const std::optional<T>& scale) {
+  if (scale) {
+    const T scaleValue = *scale;
+    for (T& value : values) {
+      value = applyScale<T>(value, scaleValue);
+    }
+  }
+
+  if (offset) {
+    const T offsetValue = *offset;
+    for (T& value : values) {
+      value += offsetValue;
+    }
+  }
+}
+
 template <typename T>
 PropertyArrayView<T> transformArray(
     const PropertyArrayView<T>& value,
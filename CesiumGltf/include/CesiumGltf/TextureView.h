@@ -5,6 +5,9 @@
 #include "CesiumGltf/Sampler.h"
 #include "CesiumGltf/TextureInfo.h"
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
 #include <vector>
 
 namespace CesiumGltf {
@@ -206,6 +209,24 @@ public:
       double v,
       const std::vector<int64_t>& channels) const noexcept;
 
+  /**
+   * @brief Samples the image at each of the specified texture coordinates
+   * using NEAREST pixel filtering, just like {@link sampleNearestPixel}.
+   *
+   * The texture transform, sampler, and image are only looked up once for all
+   * of the samples, which is much faster than sampling them one at a time.
+   *
+   * @param uvs The texture coordinates to sample.
+   * @param channels The image channels to retrieve, in order.
+   * @param result Receives the bytes of the channels for each sample, one
+   * sample after another. It must have room for `uvs.size() * channels.size()`
+   * bytes.
+   */
+  void sampleNearestPixels(
+      gsl::span<const glm::dvec2> uvs,
+      const std::vector<int64_t>& channels,
+      gsl::span<uint8_t> result) const noexcept;
+
 private:
   TextureViewStatus _textureViewStatus;
 
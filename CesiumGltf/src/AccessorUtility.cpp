@@ -20,6 +20,36 @@ getPositionAccessorView(const Model& model, const MeshPrimitive& primitive) {
   return PositionAccessorType(model, *pAccessor);
 }
 
+QuantizedPositionAccessorType getQuantizedPositionAccessorView(
+    const Model& model,
+    const MeshPrimitive& primitive) {
+  auto positionAttribute = primitive.attributes.find("POSITION");
+  if (positionAttribute == primitive.attributes.end()) {
+    return QuantizedPositionAccessorType();
+  }
+
+  const Accessor* pAccessor =
+      model.getSafe<Accessor>(&model.accessors, positionAttribute->second);
+  if (!pAccessor || pAccessor->type != Accessor::Type::VEC3) {
+    return QuantizedPositionAccessorType();
+  }
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::BYTE:
+    return AccessorView<AccessorTypes::VEC3<int8_t>>(model, *pAccessor);
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return AccessorView<AccessorTypes::VEC3<uint8_t>>(model, *pAccessor);
+  case Accessor::ComponentType::SHORT:
+    return AccessorView<AccessorTypes::VEC3<int16_t>>(model, *pAccessor);
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return AccessorView<AccessorTypes::VEC3<uint16_t>>(model, *pAccessor);
+  case Accessor::ComponentType::FLOAT:
+    return AccessorView<AccessorTypes::VEC3<float>>(model, *pAccessor);
+  default:
+    return QuantizedPositionAccessorType();
+  }
+}
+
 NormalAccessorType
 getNormalAccessorView(const Model& model, const MeshPrimitive& primitive) {
   auto normalAttribute = primitive.attributes.find("NORMAL");
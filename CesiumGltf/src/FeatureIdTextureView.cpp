@@ -4,6 +4,9 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/SamplerUtility.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace CesiumGltf {
 FeatureIdTextureView::FeatureIdTextureView() noexcept
     : TextureView(),
@@ -79,4 +82,31 @@ int64_t FeatureIdTextureView::getFeatureID(double u, double v) const noexcept {
 
   return value;
 }
+
+void FeatureIdTextureView::getFeatureIDs(
+    gsl::span<const glm::dvec2> uvs,
+    gsl::span<int64_t> featureIds) const noexcept {
+  assert(
+      featureIds.size() == uvs.size() &&
+      "featureIds must be the same size as uvs");
+
+  if (this->_status != FeatureIdTextureViewStatus::Valid) {
+    std::fill(featureIds.begin(), featureIds.end(), -1);
+    return;
+  }
+
+  const size_t channelCount = this->_channels.size();
+  std::vector<uint8_t> samples(uvs.size() * channelCount);
+  this->sampleNearestPixels(uvs, this->_channels, samples);
+
+  for (size_t i = 0; i < featureIds.size(); i++) {
+    int64_t value = 0;
+    int64_t bitOffset = 0;
+    for (size_t j = 0; j < channelCount; j++) {
+      value |= static_cast<int64_t>(samples[i * channelCount + j]) << bitOffset;
+      bitOffset += 8;
+    }
+    featureIds[i] = value;
+  }
+}
 } // namespace CesiumGltf
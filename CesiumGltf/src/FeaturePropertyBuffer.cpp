@@ -0,0 +1,116 @@
+#include "CesiumGltf/FeaturePropertyBuffer.h"
+
+#include "CesiumGltf/AccessorUtility.h"
+#include "CesiumGltf/FeatureIdTextureView.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+namespace CesiumGltf {
+
+std::vector<int64_t> getFeatureIdsPerVertex(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FeatureId& featureId) {
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return {};
+  }
+
+  const Accessor* pPositions =
+      Model::getSafe(&model.accessors, positionIt->second);
+  if (!pPositions || pPositions->count <= 0) {
+    return {};
+  }
+
+  std::vector<int64_t> result(static_cast<size_t>(pPositions->count), -1);
+
+  if (featureId.attribute) {
+    const FeatureIdAccessorType accessor = getFeatureIdAccessorView(
+        model,
+        primitive,
+        static_cast<int32_t>(*featureId.attribute));
+    std::visit(
+        [&result](const auto& view) {
+          if (view.status() != AccessorViewStatus::Valid) {
+            return;
+          }
+
+          const int64_t count =
+              std::min(view.size(), static_cast<int64_t>(result.size()));
+          for (int64_t i = 0; i < count; ++i) {
+            if constexpr (std::is_same_v<
+                              std::decay_t<decltype(view[i])>,
+                              float>) {
+              result[static_cast<size_t>(i)] =
+                  static_cast<int64_t>(glm::round(view[i]));
+            } else {
+              result[static_cast<size_t>(i)] = static_cast<int64_t>(view[i]);
+            }
+          }
+        },
+        accessor);
+  } else if (featureId.texture) {
+    const FeatureIdTextureView texture(model, *featureId.texture);
+    if (texture.status() != FeatureIdTextureViewStatus::Valid) {
+      return result;
+    }
+
+    const TexCoordAccessorType texCoords = getTexCoordAccessorView(
+        model,
+        primitive,
+        static_cast<int32_t>(texture.getTexCoordSetIndex()));
+    for (size_t i = 0; i < result.size(); ++i) {
+      const std::optional<glm::dvec2> uv = std::visit(
+          TexCoordFromAccessor{static_cast<int64_t>(i)},
+          texCoords);
+      if (uv) {
+        result[i] = texture.getFeatureID(uv->x, uv->y);
+      }
+    }
+  } else {
+    // Without an attribute or a texture, the feature ID is the vertex index.
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = static_cast<int64_t>(i);
+    }
+  }
+
+  if (featureId.nullFeatureId) {
+    std::replace(
+        result.begin(),
+        result.end(),
+        *featureId.nullFeatureId,
+        int64_t(-1));
+  }
+
+  return result;
+}
+
+void FeaturePropertyBufferCache::invalidatePropertyTable(
+    int64_t propertyTableIndex) noexcept {
+  for (auto it = this->_buffers.begin(); it != this->_buffers.end();) {
+    if (it->first.propertyTableIndex == propertyTableIndex) {
+      it = this->_buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FeaturePropertyBufferCache::invalidatePrimitive(
+    const MeshPrimitive& primitive) noexcept {
+  for (auto it = this->_buffers.begin(); it != this->_buffers.end();) {
+    if (it->first.pPrimitive == &primitive) {
+      it = this->_buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FeaturePropertyBufferCache::clear() noexcept { this->_buffers.clear(); }
+
+} // namespace CesiumGltf
@@ -53,3 +53,12 @@ KhrTextureTransform::applyTransform(double u, double v) const noexcept {
 
   return scaledAndRotated + this->_offset;
 }
+
+glm::dmat3 KhrTextureTransform::toMatrix() const noexcept {
+  const double sin = this->_rotationSineCosine.x;
+  const double cos = this->_rotationSineCosine.y;
+  return glm::dmat3(
+      glm::dvec3(this->_scale.x * cos, -this->_scale.x * sin, 0.0),
+      glm::dvec3(this->_scale.y * sin, this->_scale.y * cos, 0.0),
+      glm::dvec3(this->_offset, 1.0));
+}
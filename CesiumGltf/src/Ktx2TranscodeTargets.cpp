@@ -7,7 +7,8 @@ using namespace CesiumGltf;
 
 Ktx2TranscodeTargets::Ktx2TranscodeTargets(
     const SupportedGpuCompressedPixelFormats& supportedFormats,
-    bool preserveHighQuality) {
+    bool preserveHighQuality,
+    bool twoChannelNormalMaps) {
 
   // Attempts to determine ideal transcode target formats using the logic here:
   // https://github.com/KhronosGroup/3D-Formats-Guidelines/blob/main/KTXDeveloperGuide.md
@@ -121,6 +122,19 @@ Ktx2TranscodeTargets::Ktx2TranscodeTargets(
   }
   // TODO: else { decode to R8 or RGR565 }
 
+  // Find the transcode targets for normal maps. BC5 and EAC RG11 spend a whole
+  // block on just two channels, so they keep normals more precisely than the
+  // four-channel formats, at the cost of reconstructing Z in the renderer.
+  if (twoChannelNormalMaps) {
+    if (supportedFormats.BC5_RG) {
+      this->ETC1S_NormalMap = GpuCompressedPixelFormat::BC5_RG;
+      this->UASTC_NormalMap = GpuCompressedPixelFormat::BC5_RG;
+    } else if (supportedFormats.ETC2_EAC_RG11) {
+      this->ETC1S_NormalMap = GpuCompressedPixelFormat::ETC2_EAC_RG11;
+      this->UASTC_NormalMap = GpuCompressedPixelFormat::ETC2_EAC_RG11;
+    }
+  }
+
   // If any of the transmission formats stil has std::nullopt as it's transcode
   // target, then it will be fully decompressed into RGBA8 pixels.
 }
\ No newline at end of file
@@ -6,13 +6,19 @@
 #include "CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h"
 #include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
 
+#include <CesiumUtility/AttributeCompression.h>
+
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/span>
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <limits>
+#include <string>
+#include <vector>
 
 using namespace CesiumUtility;
 
@@ -50,43 +56,47 @@ void mergeSchemas(
     Schema& rhs,
     std::map<std::string, std::string>& classNameMap);
 
-} // namespace
+template <typename T>
+void reserveElements(
+    std::vector<T>& to,
+    const std::vector<Model>& models,
+    std::vector<T> Model::*pElements) {
+  size_t count = to.size();
+  for (const Model& model : models) {
+    count += (model.*pElements).size();
+  }
+  to.reserve(count);
+}
 
-ErrorList Model::merge(Model&& rhs) {
-  ErrorList result;
+void sortAndRemoveDuplicates(std::vector<std::string>& strings) {
+  std::sort(strings.begin(), strings.end());
+  strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+}
 
+// Moves the elements of `rhs` to the end of the elements of `lhs` and updates
+// the indices in them. Returns the new index of the default scene of `rhs`, or
+// -1 if it doesn't have one.
+int32_t mergeModel(Model& lhs, Model& rhs, ErrorList& result) {
   // TODO: we could generate this pretty easily if the glTF JSON schema made
   // it clear which index properties refer to which types of objects.
 
   // Copy all the source data into this instance.
-  copyElements(this->extensionsUsed, rhs.extensionsUsed);
-  std::sort(this->extensionsUsed.begin(), this->extensionsUsed.end());
-  this->extensionsUsed.erase(
-      std::unique(this->extensionsUsed.begin(), this->extensionsUsed.end()),
-      this->extensionsUsed.end());
-
-  copyElements(this->extensionsRequired, rhs.extensionsRequired);
-  std::sort(this->extensionsRequired.begin(), this->extensionsRequired.end());
-  this->extensionsRequired.erase(
-      std::unique(
-          this->extensionsRequired.begin(),
-          this->extensionsRequired.end()),
-      this->extensionsRequired.end());
-
-  const size_t firstAccessor = copyElements(this->accessors, rhs.accessors);
-  const size_t firstAnimation = copyElements(this->animations, rhs.animations);
-  const size_t firstBuffer = copyElements(this->buffers, rhs.buffers);
-  const size_t firstBufferView =
-      copyElements(this->bufferViews, rhs.bufferViews);
-  const size_t firstCamera = copyElements(this->cameras, rhs.cameras);
-  const size_t firstImage = copyElements(this->images, rhs.images);
-  const size_t firstMaterial = copyElements(this->materials, rhs.materials);
-  const size_t firstMesh = copyElements(this->meshes, rhs.meshes);
-  const size_t firstNode = copyElements(this->nodes, rhs.nodes);
-  const size_t firstSampler = copyElements(this->samplers, rhs.samplers);
-  const size_t firstScene = copyElements(this->scenes, rhs.scenes);
-  const size_t firstSkin = copyElements(this->skins, rhs.skins);
-  const size_t firstTexture = copyElements(this->textures, rhs.textures);
+  copyElements(lhs.extensionsUsed, rhs.extensionsUsed);
+  copyElements(lhs.extensionsRequired, rhs.extensionsRequired);
+
+  const size_t firstAccessor = copyElements(lhs.accessors, rhs.accessors);
+  const size_t firstAnimation = copyElements(lhs.animations, rhs.animations);
+  const size_t firstBuffer = copyElements(lhs.buffers, rhs.buffers);
+  const size_t firstBufferView = copyElements(lhs.bufferViews, rhs.bufferViews);
+  const size_t firstCamera = copyElements(lhs.cameras, rhs.cameras);
+  const size_t firstImage = copyElements(lhs.images, rhs.images);
+  const size_t firstMaterial = copyElements(lhs.materials, rhs.materials);
+  const size_t firstMesh = copyElements(lhs.meshes, rhs.meshes);
+  const size_t firstNode = copyElements(lhs.nodes, rhs.nodes);
+  const size_t firstSampler = copyElements(lhs.samplers, rhs.samplers);
+  const size_t firstScene = copyElements(lhs.scenes, rhs.scenes);
+  const size_t firstSkin = copyElements(lhs.skins, rhs.skins);
+  const size_t firstTexture = copyElements(lhs.textures, rhs.textures);
 
   size_t firstPropertyTable = 0;
   size_t firstPropertyTexture = 0;
@@ -96,7 +106,7 @@ ErrorList Model::merge(Model&& rhs) {
       rhs.getExtension<ExtensionModelExtStructuralMetadata>();
   if (pRhsMetadata) {
     ExtensionModelExtStructuralMetadata& metadata =
-        this->addExtension<ExtensionModelExtStructuralMetadata>();
+        lhs.addExtension<ExtensionModelExtStructuralMetadata>();
 
     if (metadata.schemaUri && pRhsMetadata->schemaUri &&
         *metadata.schemaUri != *pRhsMetadata->schemaUri) {
@@ -166,8 +176,8 @@ ErrorList Model::merge(Model&& rhs) {
   }
 
   // Update the copied indices
-  for (size_t i = firstAccessor; i < this->accessors.size(); ++i) {
-    Accessor& accessor = this->accessors[i];
+  for (size_t i = firstAccessor; i < lhs.accessors.size(); ++i) {
+    Accessor& accessor = lhs.accessors[i];
     updateIndex(accessor.bufferView, firstBufferView);
 
     if (accessor.sparse) {
@@ -176,8 +186,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstAnimation; i < this->animations.size(); ++i) {
-    Animation& animation = this->animations[i];
+  for (size_t i = firstAnimation; i < lhs.animations.size(); ++i) {
+    Animation& animation = lhs.animations[i];
 
     for (AnimationChannel& channel : animation.channels) {
       updateIndex(channel.sampler, firstSampler);
@@ -190,18 +200,18 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstBufferView; i < this->bufferViews.size(); ++i) {
-    BufferView& bufferView = this->bufferViews[i];
+  for (size_t i = firstBufferView; i < lhs.bufferViews.size(); ++i) {
+    BufferView& bufferView = lhs.bufferViews[i];
     updateIndex(bufferView.buffer, firstBuffer);
   }
 
-  for (size_t i = firstImage; i < this->images.size(); ++i) {
-    Image& image = this->images[i];
+  for (size_t i = firstImage; i < lhs.images.size(); ++i) {
+    Image& image = lhs.images[i];
     updateIndex(image.bufferView, firstBufferView);
   }
 
-  for (size_t i = firstMesh; i < this->meshes.size(); ++i) {
-    Mesh& mesh = this->meshes[i];
+  for (size_t i = firstMesh; i < lhs.meshes.size(); ++i) {
+    Mesh& mesh = lhs.meshes[i];
 
     for (MeshPrimitive& primitive : mesh.primitives) {
       updateIndex(primitive.indices, firstAccessor);
@@ -251,8 +261,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstNode; i < this->nodes.size(); ++i) {
-    Node& node = this->nodes[i];
+  for (size_t i = firstNode; i < lhs.nodes.size(); ++i) {
+    Node& node = lhs.nodes[i];
 
     updateIndex(node.camera, firstCamera);
     updateIndex(node.skin, firstSkin);
@@ -263,15 +273,15 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstScene; i < this->scenes.size(); ++i) {
-    Scene& currentScene = this->scenes[i];
+  for (size_t i = firstScene; i < lhs.scenes.size(); ++i) {
+    Scene& currentScene = lhs.scenes[i];
     for (int32_t& node : currentScene.nodes) {
       updateIndex(node, firstNode);
     }
   }
 
-  for (size_t i = firstSkin; i < this->skins.size(); ++i) {
-    Skin& skin = this->skins[i];
+  for (size_t i = firstSkin; i < lhs.skins.size(); ++i) {
+    Skin& skin = lhs.skins[i];
 
     updateIndex(skin.inverseBindMatrices, firstAccessor);
     updateIndex(skin.skeleton, firstNode);
@@ -281,15 +291,15 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstTexture; i < this->textures.size(); ++i) {
-    Texture& texture = this->textures[i];
+  for (size_t i = firstTexture; i < lhs.textures.size(); ++i) {
+    Texture& texture = lhs.textures[i];
 
     updateIndex(texture.sampler, firstSampler);
     updateIndex(texture.source, firstImage);
   }
 
-  for (size_t i = firstMaterial; i < this->materials.size(); ++i) {
-    Material& material = this->materials[i];
+  for (size_t i = firstMaterial; i < lhs.materials.size(); ++i) {
+    Material& material = lhs.materials[i];
 
     if (material.normalTexture) {
       updateIndex(material.normalTexture.value().index, firstTexture);
@@ -311,34 +321,76 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  Scene* pThisDefaultScene = Model::getSafe(&this->scenes, this->scene);
-  Scene* pRhsDefaultScene =
-      Model::getSafe(&this->scenes, rhs.scene + int32_t(firstScene));
+  if (!Model::getSafe(&rhs.scenes, rhs.scene)) {
+    return -1;
+  }
+  return rhs.scene + int32_t(firstScene);
+}
+
+} // namespace
 
-  if (!pThisDefaultScene) {
-    this->scene = rhs.scene;
-    updateIndex(this->scene, firstScene);
-  } else if (pRhsDefaultScene) {
+ErrorList Model::merge(Model&& rhs) {
+  std::vector<Model> models;
+  models.emplace_back(std::move(rhs));
+  return this->merge(std::move(models));
+}
+
+ErrorList Model::merge(std::vector<Model>&& models) {
+  ErrorList result;
+
+  // Reserve room for the elements of all the models up front, so that the
+  // elements are moved once rather than each time a vector grows.
+  reserveElements(this->accessors, models, &Model::accessors);
+  reserveElements(this->animations, models, &Model::animations);
+  reserveElements(this->buffers, models, &Model::buffers);
+  reserveElements(this->bufferViews, models, &Model::bufferViews);
+  reserveElements(this->cameras, models, &Model::cameras);
+  reserveElements(this->images, models, &Model::images);
+  reserveElements(this->materials, models, &Model::materials);
+  reserveElements(this->meshes, models, &Model::meshes);
+  reserveElements(this->nodes, models, &Model::nodes);
+  reserveElements(this->samplers, models, &Model::samplers);
+  reserveElements(this->scenes, models, &Model::scenes);
+  reserveElements(this->skins, models, &Model::skins);
+  reserveElements(this->textures, models, &Model::textures);
+
+  std::vector<int32_t> defaultScenes;
+  if (Model::getSafe(&this->scenes, this->scene)) {
+    defaultScenes.push_back(this->scene);
+  }
+
+  for (Model& model : models) {
+    const int32_t defaultScene = mergeModel(*this, model, result);
+    if (defaultScene >= 0) {
+      defaultScenes.push_back(defaultScene);
+    }
+  }
+
+  sortAndRemoveDuplicates(this->extensionsUsed);
+  sortAndRemoveDuplicates(this->extensionsRequired);
+
+  if (defaultScenes.size() == 1) {
+    this->scene = defaultScenes[0];
+  } else if (defaultScenes.size() > 1) {
     // Create a new default scene that has all the root nodes in
-    // the default scene of either model.
-    Scene& newScene = this->scenes.emplace_back();
-
-    // Refresh the scene pointers potentially invalidated by the above.
-    pThisDefaultScene = Model::getSafe(&this->scenes, this->scene);
-    pRhsDefaultScene =
-        Model::getSafe(&this->scenes, rhs.scene + int32_t(firstScene));
-
-    newScene.nodes = pThisDefaultScene->nodes;
-    const size_t originalNodeCount = newScene.nodes.size();
-    newScene.nodes.resize(originalNodeCount + pRhsDefaultScene->nodes.size());
-    std::copy(
-        pRhsDefaultScene->nodes.begin(),
-        pRhsDefaultScene->nodes.end(),
-        newScene.nodes.begin() + int64_t(originalNodeCount));
+    // the default scene of every model.
+    Scene newScene;
+
+    size_t nodeCount = 0;
+    for (int32_t sceneIndex : defaultScenes) {
+      nodeCount += this->scenes[size_t(sceneIndex)].nodes.size();
+    }
+    newScene.nodes.reserve(nodeCount);
 
     // No need to update indices because they've already been updated when
-    // we copied them from rhs to this.
+    // we copied them from each model to this.
+    for (int32_t sceneIndex : defaultScenes) {
+      const std::vector<int32_t>& nodes =
+          this->scenes[size_t(sceneIndex)].nodes;
+      newScene.nodes.insert(newScene.nodes.end(), nodes.begin(), nodes.end());
+    }
 
+    this->scenes.emplace_back(std::move(newScene));
     this->scene = int32_t(this->scenes.size() - 1);
   }
 
@@ -547,80 +599,121 @@ void Model::forEachPrimitiveInScene(
 }
 
 namespace {
-template <typename TIndex>
-void addTriangleNormalToVertexNormals(
-    const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
-    TIndex tIndex0,
-    TIndex tIndex1,
-    TIndex tIndex2) {
-
-  // Add the triangle's normal to each vertex's accumulated normal.
+// The name of the attribute that oct-encoded normals are generated into. It is
+// the same attribute that QuantizedMeshLoader keeps the oct-encoded normals of
+// terrain in.
+const std::string OCT_ENCODED_NORMAL_ATTRIBUTE = "_OCT_ENCODED_NORMAL";
+
+// The number of triangles whose face normals are computed at a time.
+constexpr size_t NORMAL_CHUNK_SIZE = 256;
+
+// Adds the face normals of triangles to the normals of their vertices.
+//
+// The triangles are buffered in chunks. Gathering the positions of a triangle's
+// vertices is inherently scalar, but once the edges of a whole chunk are in
+// separate arrays of x, y, and z components, the cross products are computed
+// in a loop without dependencies between iterations, which the compiler
+// vectorizes. The face normals are then added to the vertex normals.
+class NormalAccumulator {
+public:
+  NormalAccumulator(
+      const gsl::span<const glm::vec3>& positions,
+      const gsl::span<glm::vec3>& normals) noexcept
+      : _positions(positions), _normals(normals) {}
+
+  void addTriangle(size_t index0, size_t index1, size_t index2) noexcept {
+    const size_t vertexCount = this->_positions.size();
+    if (index0 >= vertexCount || index1 >= vertexCount ||
+        index2 >= vertexCount) {
+      return;
+    }
 
-  const uint32_t index0 = static_cast<uint32_t>(tIndex0);
-  const uint32_t index1 = static_cast<uint32_t>(tIndex1);
-  const uint32_t index2 = static_cast<uint32_t>(tIndex2);
+    const glm::vec3& vertex0 = this->_positions[index0];
+    const glm::vec3& vertex1 = this->_positions[index1];
+    const glm::vec3& vertex2 = this->_positions[index2];
+
+    const size_t i = this->_triangleCount;
+    this->_edge1X[i] = vertex1.x - vertex0.x;
+    this->_edge1Y[i] = vertex1.y - vertex0.y;
+    this->_edge1Z[i] = vertex1.z - vertex0.z;
+    this->_edge2X[i] = vertex2.x - vertex0.x;
+    this->_edge2Y[i] = vertex2.y - vertex0.y;
+    this->_edge2Z[i] = vertex2.z - vertex0.z;
+    this->_indices[i * 3] = index0;
+    this->_indices[i * 3 + 1] = index1;
+    this->_indices[i * 3 + 2] = index2;
+
+    if (++this->_triangleCount == NORMAL_CHUNK_SIZE) {
+      this->flush();
+    }
+  }
 
-  const glm::vec3& vertex0 = positionView[index0];
-  const glm::vec3& vertex1 = positionView[index1];
-  const glm::vec3& vertex2 = positionView[index2];
+  void flush() noexcept {
+    const size_t triangleCount = this->_triangleCount;
+
+    // The cross products of the edges, which are the face normals weighted by
+    // the areas of the triangles.
+    for (size_t i = 0; i < triangleCount; ++i) {
+      this->_normalX[i] = this->_edge1Y[i] * this->_edge2Z[i] -
+                          this->_edge1Z[i] * this->_edge2Y[i];
+      this->_normalY[i] = this->_edge1Z[i] * this->_edge2X[i] -
+                          this->_edge1X[i] * this->_edge2Z[i];
+      this->_normalZ[i] = this->_edge1X[i] * this->_edge2Y[i] -
+                          this->_edge1Y[i] * this->_edge2X[i];
+    }
 
-  const glm::vec3 triangleNormal =
-      glm::cross(vertex1 - vertex0, vertex2 - vertex0);
+    // Add the triangle normal to each vertex's accumulated normal. At the end
+    // we will normalize the accumulated vertex normals to average.
+    for (size_t i = 0; i < triangleCount; ++i) {
+      const glm::vec3 triangleNormal(
+          this->_normalX[i],
+          this->_normalY[i],
+          this->_normalZ[i]);
+      this->_normals[this->_indices[i * 3]] += triangleNormal;
+      this->_normals[this->_indices[i * 3 + 1]] += triangleNormal;
+      this->_normals[this->_indices[i * 3 + 2]] += triangleNormal;
+    }
 
-  // Add the triangle normal to each vertex's accumulated normal. At the end
-  // we will normalize the accumulated vertex normals to average.
-  normals[index0] += triangleNormal;
-  normals[index1] += triangleNormal;
-  normals[index2] += triangleNormal;
-}
+    this->_triangleCount = 0;
+  }
 
-template <typename TIndex, typename GetIndex>
+private:
+  gsl::span<const glm::vec3> _positions;
+  gsl::span<glm::vec3> _normals;
+  size_t _triangleCount = 0;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge1X;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge1Y;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge1Z;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge2X;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge2Y;
+  std::array<float, NORMAL_CHUNK_SIZE> _edge2Z;
+  std::array<float, NORMAL_CHUNK_SIZE> _normalX;
+  std::array<float, NORMAL_CHUNK_SIZE> _normalY;
+  std::array<float, NORMAL_CHUNK_SIZE> _normalZ;
+  std::array<size_t, NORMAL_CHUNK_SIZE * 3> _indices;
+};
+
+template <typename GetIndex>
 bool accumulateNormals(
     int32_t meshPrimitiveMode,
-    const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
+    NormalAccumulator& accumulator,
     int64_t numIndices,
     GetIndex getIndex) {
 
   switch (meshPrimitiveMode) {
   case MeshPrimitive::Mode::TRIANGLES:
     for (int64_t i = 2; i < numIndices; i += 3) {
-      TIndex index0 = getIndex(i - 2);
-      TIndex index1 = getIndex(i - 1);
-      TIndex index2 = getIndex(i);
-
-      addTriangleNormalToVertexNormals<TIndex>(
-          normals,
-          positionView,
-          index0,
-          index1,
-          index2);
+      accumulator.addTriangle(getIndex(i - 2), getIndex(i - 1), getIndex(i));
     }
     break;
 
   case MeshPrimitive::Mode::TRIANGLE_STRIP:
     for (int64_t i = 0; i < numIndices - 2; ++i) {
-      TIndex index0;
-      TIndex index1;
-      TIndex index2;
-
       if (i % 2) {
-        index0 = getIndex(i);
-        index1 = getIndex(i + 2);
-        index2 = getIndex(i + 1);
+        accumulator.addTriangle(getIndex(i), getIndex(i + 2), getIndex(i + 1));
       } else {
-        index0 = getIndex(i);
-        index1 = getIndex(i + 1);
-        index2 = getIndex(i + 2);
+        accumulator.addTriangle(getIndex(i), getIndex(i + 1), getIndex(i + 2));
       }
-
-      addTriangleNormalToVertexNormals<TIndex>(
-          normals,
-          positionView,
-          index0,
-          index1,
-          index2);
     }
     break;
 
@@ -630,17 +723,9 @@ bool accumulateNormals(
     }
 
     {
-      TIndex index0 = getIndex(0);
+      const size_t index0 = getIndex(0);
       for (int64_t i = 2; i < numIndices; ++i) {
-        TIndex index1 = getIndex(i - 1);
-        TIndex index2 = getIndex(i);
-
-        addTriangleNormalToVertexNormals<TIndex>(
-            normals,
-            positionView,
-            index0,
-            index1,
-            index2);
+        accumulator.addTriangle(index0, getIndex(i - 1), getIndex(i));
       }
     }
     break;
@@ -649,49 +734,104 @@ bool accumulateNormals(
     return false;
   }
 
+  accumulator.flush();
   return true;
 }
 
 template <typename TIndex>
+bool accumulateIndexedNormals(
+    const Model& gltf,
+    int32_t meshPrimitiveMode,
+    NormalAccumulator& accumulator,
+    const Accessor& indexAccessor) {
+  const AccessorView<TIndex> indexView(gltf, indexAccessor);
+  if (indexView.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  const gsl::span<const TIndex> indices = indexView.asSpan();
+  if (!indices.empty()) {
+    return accumulateNormals(
+        meshPrimitiveMode,
+        accumulator,
+        indexView.size(),
+        [indices](int64_t index) {
+          return static_cast<size_t>(indices[static_cast<size_t>(index)]);
+        });
+  }
+
+  return accumulateNormals(
+      meshPrimitiveMode,
+      accumulator,
+      indexView.size(),
+      [&indexView](int64_t index) {
+        return static_cast<size_t>(indexView[index]);
+      });
+}
+
 void generateSmoothNormals(
     Model& gltf,
     MeshPrimitive& primitive,
     const AccessorView<glm::vec3>& positionView,
-    const std::optional<Accessor>& indexAccessor) {
+    const Accessor* pIndexAccessor,
+    bool octEncode) {
 
   const size_t count = static_cast<size_t>(positionView.size());
-  const size_t normalBufferStride = sizeof(glm::vec3);
-  const size_t normalBufferSize = count * normalBufferStride;
 
-  std::vector<std::byte> normalByteBuffer(normalBufferSize);
+  // Read the positions in place if they are tightly packed, so that gathering
+  // them doesn't go through the accessor view.
+  std::vector<glm::vec3> positionsCopy;
+  gsl::span<const glm::vec3> positions = positionView.asSpan();
+  if (positions.empty() && count > 0) {
+    positionsCopy.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      positionsCopy[i] = positionView[int64_t(i)];
+    }
+    positions = positionsCopy;
+  }
+
+  std::vector<std::byte> normalByteBuffer(count * sizeof(glm::vec3));
   gsl::span<glm::vec3> normals(
       reinterpret_cast<glm::vec3*>(normalByteBuffer.data()),
       count);
+  NormalAccumulator accumulator(positions, normals);
 
   // In the indexed case, the positions are accessed with the
-  // indices from the indexView. Otherwise, the elements are
+  // indices from the index accessor. Otherwise, the elements are
   // accessed directly.
   bool accumulationResult = false;
-  if (indexAccessor) {
-    CesiumGltf::AccessorView<TIndex> indexView(gltf, *indexAccessor);
-    if (indexView.status() != AccessorViewStatus::Valid) {
-      return;
+  if (pIndexAccessor) {
+    switch (pIndexAccessor->componentType) {
+    case Accessor::ComponentType::UNSIGNED_BYTE:
+      accumulationResult = accumulateIndexedNormals<uint8_t>(
+          gltf,
+          primitive.mode,
+          accumulator,
+          *pIndexAccessor);
+      break;
+    case Accessor::ComponentType::UNSIGNED_SHORT:
+      accumulationResult = accumulateIndexedNormals<uint16_t>(
+          gltf,
+          primitive.mode,
+          accumulator,
+          *pIndexAccessor);
+      break;
+    case Accessor::ComponentType::UNSIGNED_INT:
+      accumulationResult = accumulateIndexedNormals<uint32_t>(
+          gltf,
+          primitive.mode,
+          accumulator,
+          *pIndexAccessor);
+      break;
+    default:
+      break;
     }
-
-    accumulationResult = accumulateNormals<TIndex>(
-        primitive.mode,
-        normals,
-        positionView,
-        indexView.size(),
-        [&indexView](int64_t index) { return indexView[index]; });
-
   } else {
-    accumulationResult = accumulateNormals<TIndex>(
+    accumulationResult = accumulateNormals(
         primitive.mode,
-        normals,
-        positionView,
+        accumulator,
         int64_t(count),
-        [](int64_t index) { return static_cast<TIndex>(index); });
+        [](int64_t index) { return static_cast<size_t>(index); });
   }
 
   if (!accumulationResult) {
@@ -708,6 +848,27 @@ void generateSmoothNormals(
     }
   }
 
+  size_t normalBufferStride = sizeof(glm::vec3);
+  if (octEncode) {
+    constexpr uint16_t rangeMax = std::numeric_limits<uint16_t>::max();
+    normalBufferStride = sizeof(glm::u16vec2);
+    std::vector<std::byte> octEncodedByteBuffer(count * normalBufferStride);
+    gsl::span<glm::u16vec2> octEncodedNormals(
+        reinterpret_cast<glm::u16vec2*>(octEncodedByteBuffer.data()),
+        count);
+    for (size_t i = 0; i < count; ++i) {
+      // A vertex without a normal can't be oct-encoded, so it gets an
+      // arbitrary one.
+      const glm::dvec3 normal = normals[i] == glm::vec3(0.0f)
+                                    ? glm::dvec3(0.0, 0.0, 1.0)
+                                    : glm::dvec3(normals[i]);
+      octEncodedNormals[i] =
+          AttributeCompression::octEncodeInRange(normal, rangeMax);
+    }
+    normalByteBuffer = std::move(octEncodedByteBuffer);
+  }
+
+  const size_t normalBufferSize = normalByteBuffer.size();
   const size_t normalBufferId = gltf.buffers.size();
   Buffer& normalBuffer = gltf.buffers.emplace_back();
   normalBuffer.byteLength = static_cast<int64_t>(normalBufferSize);
@@ -725,67 +886,34 @@ void generateSmoothNormals(
   Accessor& normalAccessor = gltf.accessors.emplace_back();
   normalAccessor.byteOffset = 0;
   normalAccessor.bufferView = static_cast<int32_t>(normalBufferViewId);
-  normalAccessor.componentType = Accessor::ComponentType::FLOAT;
   normalAccessor.count = positionView.size();
-  normalAccessor.type = Accessor::Type::VEC3;
+  if (octEncode) {
+    normalAccessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+    normalAccessor.type = Accessor::Type::VEC2;
+  } else {
+    normalAccessor.componentType = Accessor::ComponentType::FLOAT;
+    normalAccessor.type = Accessor::Type::VEC3;
+  }
 
   primitive.attributes.emplace(
-      "NORMAL",
+      octEncode ? OCT_ENCODED_NORMAL_ATTRIBUTE : "NORMAL",
       static_cast<int32_t>(normalAccessorId));
 }
-
-void generateSmoothNormals(
-    Model& gltf,
-    MeshPrimitive& primitive,
-    const AccessorView<glm::vec3>& positionView,
-    const std::optional<Accessor>& indexAccessor) {
-  if (indexAccessor) {
-    switch (indexAccessor->componentType) {
-    case Accessor::ComponentType::UNSIGNED_BYTE:
-      generateSmoothNormals<uint8_t>(
-          gltf,
-          primitive,
-          positionView,
-          indexAccessor);
-      break;
-    case Accessor::ComponentType::UNSIGNED_SHORT:
-      generateSmoothNormals<uint16_t>(
-          gltf,
-          primitive,
-          positionView,
-          indexAccessor);
-      break;
-    case Accessor::ComponentType::UNSIGNED_INT:
-      generateSmoothNormals<uint32_t>(
-          gltf,
-          primitive,
-          positionView,
-          indexAccessor);
-      break;
-    default:
-      return;
-    };
-  } else {
-    generateSmoothNormals<uint32_t>(
-        gltf,
-        primitive,
-        positionView,
-        std::nullopt);
-  }
-}
 } // namespace
 
-void Model::generateMissingNormalsSmooth() {
+void Model::generateMissingNormalsSmooth(bool octEncode) {
   forEachPrimitiveInScene(
       -1,
-      [](Model& gltf_,
-         Node& /*node*/,
-         Mesh& /*mesh*/,
-         MeshPrimitive& primitive,
-         const glm::dmat4& /*transform*/) {
+      [octEncode](
+          Model& gltf_,
+          Node& /*node*/,
+          Mesh& /*mesh*/,
+          MeshPrimitive& primitive,
+          const glm::dmat4& /*transform*/) {
         // if normals already exist, there is nothing to do
-        auto normalIt = primitive.attributes.find("NORMAL");
-        if (normalIt != primitive.attributes.end()) {
+        const auto& attributes = primitive.attributes;
+        if (attributes.find("NORMAL") != attributes.end() ||
+            attributes.find(OCT_ENCODED_NORMAL_ATTRIBUTE) != attributes.end()) {
           return;
         }
 
@@ -801,14 +929,14 @@ void Model::generateMissingNormalsSmooth() {
           return;
         }
 
-        if (primitive.indices < 0 ||
-            static_cast<size_t>(primitive.indices) >= gltf_.accessors.size()) {
-          generateSmoothNormals(gltf_, primitive, positionView, std::nullopt);
-        } else {
-          Accessor& indexAccessor =
-              gltf_.accessors[static_cast<size_t>(primitive.indices)];
-          generateSmoothNormals(gltf_, primitive, positionView, indexAccessor);
-        }
+        const Accessor* pIndexAccessor =
+            Model::getSafe(&gltf_.accessors, primitive.indices);
+        generateSmoothNormals(
+            gltf_,
+            primitive,
+            positionView,
+            pIndexAccessor,
+            octEncode);
       });
 }
 
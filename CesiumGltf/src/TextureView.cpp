@@ -112,55 +112,76 @@ std::vector<uint8_t> TextureView::sampleNearestPixel(
     double u,
     double v,
     const std::vector<int64_t>& channels) const noexcept {
-  assert(this->_textureViewStatus == TextureViewStatus::Valid);
   std::vector<uint8_t> result(channels.size());
+  const glm::dvec2 uv(u, v);
+  this->sampleNearestPixels(gsl::span(&uv, 1), channels, result);
+  return result;
+}
 
-  if (channels.size() == 0) {
-    return result;
-  }
+void TextureView::sampleNearestPixels(
+    gsl::span<const glm::dvec2> uvs,
+    const std::vector<int64_t>& channels,
+    gsl::span<uint8_t> result) const noexcept {
+  assert(this->_textureViewStatus == TextureViewStatus::Valid);
+  assert(
+      result.size() >= uvs.size() * channels.size() &&
+      "result must have room for the channels of every sample");
 
-  if (this->_applyTextureTransform && this->_textureTransform) {
-    glm::dvec2 transformedUvs = this->_textureTransform->applyTransform(u, v);
-    u = transformedUvs.x;
-    v = transformedUvs.y;
+  if (channels.size() == 0) {
+    return;
   }
 
-  u = applySamplerWrapS(u, this->_pSampler->wrapS);
-  v = applySamplerWrapT(v, this->_pSampler->wrapT);
-
-  const ImageCesium& image = this->_imageCopy.value_or(*this->_pImage);
-
-  // For nearest filtering, std::floor is used instead of std::round.
-  // This is because filtering is supposed to consider the pixel centers. But
-  // memory access here acts as sampling the beginning of the pixel. Example:
-  // 0.4 * 2 = 0.8. In a 2x1 pixel image, that should be closer to the left
-  // pixel's center. But it will round to 1.0 which corresponds to the right
-  // pixel. So the right pixel has a bigger range than the left one, which is
-  // incorrect.
-  double xCoord = std::floor(u * image.width);
-  double yCoord = std::floor(v * image.height);
-
-  // Clamp to ensure no out-of-bounds data access
-  int64_t x = glm::clamp(
-      static_cast<int64_t>(xCoord),
-      static_cast<int64_t>(0),
-      static_cast<int64_t>(image.width) - 1);
-  int64_t y = glm::clamp(
-      static_cast<int64_t>(yCoord),
-      static_cast<int64_t>(0),
-      static_cast<int64_t>(image.height) - 1);
-
-  int64_t pixelIndex =
-      image.bytesPerChannel * image.channels * (y * image.width + x);
+  // Look up everything that is the same for all samples once, rather than for
+  // each of them.
+  const ImageCesium& image =
+      this->_imageCopy ? *this->_imageCopy : *this->_pImage;
+  const KhrTextureTransform* pTextureTransform =
+      this->_applyTextureTransform && this->_textureTransform
+          ? &*this->_textureTransform
+          : nullptr;
+  const int32_t wrapS = this->_pSampler->wrapS;
+  const int32_t wrapT = this->_pSampler->wrapT;
+  const int64_t width = static_cast<int64_t>(image.width);
+  const int64_t height = static_cast<int64_t>(image.height);
+  const int64_t pixelStride =
+      static_cast<int64_t>(image.bytesPerChannel * image.channels);
 
   // TODO: Currently stb only outputs uint8 pixel types. If that
   // changes this should account for additional pixel byte sizes.
-  const uint8_t* pValue =
-      reinterpret_cast<const uint8_t*>(image.pixelData.data() + pixelIndex);
-  for (size_t i = 0; i < result.size(); i++) {
-    result[i] = *(pValue + channels[i]);
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(image.pixelData.data());
+  uint8_t* pResult = result.data();
+
+  for (const glm::dvec2& uv : uvs) {
+    const glm::dvec2 transformedUv =
+        pTextureTransform ? pTextureTransform->applyTransform(uv.x, uv.y) : uv;
+    const double u = applySamplerWrapS(transformedUv.x, wrapS);
+    const double v = applySamplerWrapT(transformedUv.y, wrapT);
+
+    // For nearest filtering, std::floor is used instead of std::round.
+    // This is because filtering is supposed to consider the pixel centers. But
+    // memory access here acts as sampling the beginning of the pixel. Example:
+    // 0.4 * 2 = 0.8. In a 2x1 pixel image, that should be closer to the left
+    // pixel's center. But it will round to 1.0 which corresponds to the right
+    // pixel. So the right pixel has a bigger range than the left one, which is
+    // incorrect.
+    const double xCoord = std::floor(u * static_cast<double>(width));
+    const double yCoord = std::floor(v * static_cast<double>(height));
+
+    // Clamp to ensure no out-of-bounds data access
+    const int64_t x = glm::clamp(
+        static_cast<int64_t>(xCoord),
+        static_cast<int64_t>(0),
+        width - 1);
+    const int64_t y = glm::clamp(
+        static_cast<int64_t>(yCoord),
+        static_cast<int64_t>(0),
+        height - 1);
+
+    const uint8_t* pValue = pPixels + pixelStride * (y * width + x);
+    for (const int64_t channel : channels) {
+      *pResult++ = pValue[channel];
+    }
   }
-
-  return result;
 }
 } // namespace CesiumGltf
@@ -118,6 +118,89 @@ TEST_CASE("Test getPositionAccessorView") {
   }
 }
 
+TEST_CASE("Test getQuantizedPositionAccessorView") {
+  Model model;
+  // Padded to four bytes per element, as KHR_mesh_quantization requires.
+  std::vector<int8_t> positions{0, 127, -127, 0, -128, 64, 1, 0};
+
+  {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.cesium.data.resize(positions.size() * sizeof(int8_t));
+    std::memcpy(
+        buffer.cesium.data.data(),
+        positions.data(),
+        buffer.cesium.data.size());
+    buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteLength = buffer.byteLength;
+    bufferView.byteStride = 4;
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.bufferView = 0;
+    accessor.componentType = Accessor::ComponentType::BYTE;
+    accessor.type = Accessor::Type::VEC3;
+    accessor.count = 2;
+  }
+
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive primitive = mesh.primitives.emplace_back();
+  primitive.attributes.insert({"POSITION", 0});
+
+  SECTION("Handles invalid accessor type") {
+    model.accessors[0].type = Accessor::Type::VEC2;
+
+    QuantizedPositionAccessorType positionAccessor =
+        getQuantizedPositionAccessorView(model, primitive);
+    REQUIRE(
+        std::visit(StatusFromAccessor{}, positionAccessor) !=
+        AccessorViewStatus::Valid);
+  }
+
+  SECTION("Handles unsupported accessor component type") {
+    model.accessors[0].componentType = Accessor::ComponentType::UNSIGNED_INT;
+
+    QuantizedPositionAccessorType positionAccessor =
+        getQuantizedPositionAccessorView(model, primitive);
+    REQUIRE(
+        std::visit(StatusFromAccessor{}, positionAccessor) !=
+        AccessorViewStatus::Valid);
+  }
+
+  SECTION("Reads unnormalized positions") {
+    QuantizedPositionAccessorType positionAccessor =
+        getQuantizedPositionAccessorView(model, primitive);
+    REQUIRE(
+        std::visit(StatusFromAccessor{}, positionAccessor) ==
+        AccessorViewStatus::Valid);
+    REQUIRE(std::visit(CountFromAccessor{}, positionAccessor) == 2);
+
+    CHECK(
+        std::visit(PositionFromAccessor{0, false}, positionAccessor) ==
+        glm::vec3(0.0f, 127.0f, -127.0f));
+    CHECK(
+        std::visit(PositionFromAccessor{1, false}, positionAccessor) ==
+        glm::vec3(-128.0f, 64.0f, 1.0f));
+    CHECK(!std::visit(PositionFromAccessor{2, false}, positionAccessor));
+  }
+
+  SECTION("Reads normalized positions") {
+    QuantizedPositionAccessorType positionAccessor =
+        getQuantizedPositionAccessorView(model, primitive);
+    CHECK(
+        std::visit(PositionFromAccessor{0, true}, positionAccessor) ==
+        glm::vec3(0.0f, 1.0f, -1.0f));
+
+    std::optional<glm::vec3> maybePosition =
+        std::visit(PositionFromAccessor{1, true}, positionAccessor);
+    REQUIRE(maybePosition);
+    CHECK(maybePosition->x == -1.0f);
+    CHECK(maybePosition->y == 64.0f / 127.0f);
+    CHECK(maybePosition->z == 1.0f / 127.0f);
+  }
+}
+
 TEST_CASE("Test getNormalAccessorView") {
   Model model;
   std::vector<glm::vec3> normals{
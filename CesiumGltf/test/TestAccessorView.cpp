@@ -4,6 +4,10 @@
 #include <catch2/catch.hpp>
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
 TEST_CASE("AccessorView construct and read example") {
   auto anyOldFunctionToGetAModel = []() {
     CesiumGltf::Model model;
@@ -90,3 +94,58 @@ TEST_CASE("Create AccessorView of unknown type with lambda") {
     CHECK(int64_t(accessorView[0].value[0]) == int64_t(0x0201));
   });
 }
+
+TEST_CASE("Iterate over an AccessorView") {
+  using namespace CesiumGltf;
+
+  Model model;
+
+  // Three uint16 elements with two bytes of padding after each.
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(12);
+  for (size_t i = 0; i < buffer.cesium.data.size(); ++i) {
+    buffer.cesium.data[i] = std::byte(i);
+  }
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.count = 3;
+  accessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+  accessor.type = Accessor::Type::SCALAR;
+
+  SECTION("with a stride") {
+    bufferView.byteStride = 4;
+    AccessorView<uint16_t> view(model, accessor);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    CHECK(!view.isContiguous());
+    CHECK(view.asSpan().empty());
+
+    REQUIRE(view.end() - view.begin() == 3);
+    std::vector<uint16_t> values(view.begin(), view.end());
+    CHECK(values == std::vector<uint16_t>{0x0100, 0x0504, 0x0908});
+    CHECK(view.begin()[2] == view[2]);
+    CHECK(*(view.end() - 1) == view[2]);
+  }
+
+  SECTION("tightly packed") {
+    AccessorView<uint16_t> view(model, accessor);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    REQUIRE(view.isContiguous());
+
+    const gsl::span<const uint16_t> span = view.asSpan();
+    REQUIRE(span.size() == 3);
+    CHECK(std::equal(span.begin(), span.end(), view.begin(), view.end()));
+    CHECK(span[1] == 0x0302);
+  }
+
+  SECTION("an invalid view is empty") {
+    AccessorView<uint16_t> view;
+    CHECK(view.begin() == view.end());
+    CHECK(view.asSpan().empty());
+  }
+}
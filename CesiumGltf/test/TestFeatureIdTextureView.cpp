@@ -444,6 +444,11 @@ TEST_CASE("Test getFeatureID on invalid feature ID texture view") {
   FeatureIdTextureView view(model, featureIdTexture);
   REQUIRE(view.status() == FeatureIdTextureViewStatus::ErrorInvalidChannels);
   REQUIRE(view.getFeatureID(0, 0) == -1);
+
+  const std::vector<glm::dvec2> uvs{glm::dvec2(0, 0), glm::dvec2(1, 1)};
+  std::vector<int64_t> batch(uvs.size(), 0);
+  view.getFeatureIDs(uvs, batch);
+  REQUIRE(batch == std::vector<int64_t>{-1, -1});
 }
 
 TEST_CASE("Test getFeatureID on valid feature ID texture view") {
@@ -488,6 +493,16 @@ TEST_CASE("Test getFeatureID on valid feature ID texture view") {
   REQUIRE(view.getFeatureID(1, 0) == 2);
   REQUIRE(view.getFeatureID(0, 1) == 0);
   REQUIRE(view.getFeatureID(1, 1) == 7);
+
+  const std::vector<glm::dvec2> uvs{
+      glm::dvec2(0, 0),
+      glm::dvec2(1, 0),
+      glm::dvec2(0, 1),
+      glm::dvec2(1, 1),
+      glm::dvec2(0.25, 0.75)};
+  std::vector<int64_t> batch(uvs.size());
+  view.getFeatureIDs(uvs, batch);
+  REQUIRE(batch == std::vector<int64_t>{1, 2, 0, 7, 0});
 }
 
 TEST_CASE("Test getFeatureID on view with applyKhrTextureTransformExtension = "
@@ -0,0 +1,176 @@
+#include "CesiumGltf/FeaturePropertyBuffer.h"
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+template <typename T>
+int32_t addAccessorToModel(
+    Model& model,
+    const std::vector<T>& values,
+    const std::string& type,
+    int32_t componentType) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.count = static_cast<int64_t>(values.size());
+  accessor.type = type;
+  accessor.componentType = componentType;
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+// A model with four vertices and a property table of three features, whose
+// "height" property has a scale of 2 and a "no data" value of 2.
+Model createModel() {
+  Model model;
+
+  const std::vector<float> heights{1.0f, 2.0f, 3.0f};
+  addAccessorToModel(
+      model,
+      heights,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::FLOAT);
+
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+
+  Schema& schema = metadata.schema.emplace();
+  ClassProperty& classProperty =
+      schema.classes["Building"].properties["height"];
+  classProperty.type = ClassProperty::Type::SCALAR;
+  classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+  classProperty.scale = JsonValue(2.0);
+  classProperty.noData = JsonValue(2.0);
+
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "Building";
+  propertyTable.count = static_cast<int64_t>(heights.size());
+  propertyTable.properties["height"].values =
+      static_cast<int32_t>(model.bufferViews.size() - 1);
+
+  const std::vector<glm::vec3> positions(4, glm::vec3(0.0f));
+  const int32_t positionAccessor = addAccessorToModel(
+      model,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+
+  const std::vector<uint8_t> featureIds{2, 0, 1, 255};
+  const int32_t featureIdAccessor = addAccessorToModel(
+      model,
+      featureIds,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_BYTE);
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = positionAccessor;
+  primitive.attributes["_FEATURE_ID_0"] = featureIdAccessor;
+
+  ExtensionExtMeshFeatures& meshFeatures =
+      primitive.addExtension<ExtensionExtMeshFeatures>();
+  FeatureId& byAttribute = meshFeatures.featureIds.emplace_back();
+  byAttribute.featureCount = 3;
+  byAttribute.attribute = 0;
+  byAttribute.nullFeatureId = 255;
+  byAttribute.propertyTable = 0;
+
+  FeatureId& byVertex = meshFeatures.featureIds.emplace_back();
+  byVertex.featureCount = 3;
+  byVertex.propertyTable = 0;
+
+  return model;
+}
+} // namespace
+
+TEST_CASE("getFeatureIdsPerVertex") {
+  const Model model = createModel();
+  const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  REQUIRE(pMeshFeatures);
+
+  SECTION("reads the feature ID attribute") {
+    CHECK(
+        getFeatureIdsPerVertex(
+            model,
+            primitive,
+            pMeshFeatures->featureIds[0]) ==
+        std::vector<int64_t>{2, 0, 1, -1});
+  }
+
+  SECTION("uses the vertex index without an attribute or texture") {
+    CHECK(
+        getFeatureIdsPerVertex(
+            model,
+            primitive,
+            pMeshFeatures->featureIds[1]) ==
+        std::vector<int64_t>{0, 1, 2, 3});
+  }
+}
+
+TEST_CASE("FeaturePropertyBufferCache") {
+  const Model model = createModel();
+  const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+  FeaturePropertyBufferCache cache;
+
+  SECTION("gathers the property for each vertex") {
+    std::shared_ptr<const FeaturePropertyBuffer<float>> pBuffer =
+        cache.getPerVertexBuffer<float>(model, primitive, 0, "height");
+    REQUIRE(pBuffer);
+    CHECK(pBuffer->values == std::vector<float>{6.0f, 2.0f, 0.0f, 0.0f});
+    CHECK(pBuffer->hasValue == std::vector<uint8_t>{1, 1, 0, 0});
+
+    pBuffer = cache.getPerVertexBuffer<float>(model, primitive, 1, "height");
+    REQUIRE(pBuffer);
+    CHECK(pBuffer->values == std::vector<float>{2.0f, 0.0f, 6.0f, 0.0f});
+    CHECK(pBuffer->hasValue == std::vector<uint8_t>{1, 0, 1, 0});
+  }
+
+  SECTION("reuses the cached buffer until it is invalidated") {
+    std::shared_ptr<const FeaturePropertyBuffer<float>> pFirst =
+        cache.getPerVertexBuffer<float>(model, primitive, 0, "height");
+    std::shared_ptr<const FeaturePropertyBuffer<float>> pSecond =
+        cache.getPerVertexBuffer<float>(model, primitive, 0, "height");
+    REQUIRE(pFirst);
+    CHECK(pFirst == pSecond);
+    CHECK(cache.size() == 1);
+
+    cache.invalidatePropertyTable(1);
+    CHECK(cache.size() == 1);
+
+    cache.invalidatePropertyTable(0);
+    CHECK(cache.size() == 0);
+    CHECK(
+        cache.getPerVertexBuffer<float>(model, primitive, 0, "height") !=
+        pFirst);
+
+    cache.invalidatePrimitive(primitive);
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("returns nullptr for a missing or mistyped property") {
+    CHECK(!cache.getPerVertexBuffer<float>(model, primitive, 0, "missing"));
+    CHECK(!cache.getPerVertexBuffer<double>(model, primitive, 0, "height"));
+    CHECK(!cache.getPerVertexBuffer<float>(model, primitive, 2, "height"));
+    CHECK(cache.size() == 0);
+  }
+}
@@ -93,3 +93,29 @@ TEST_CASE("Test KhrTextureTransform applies non-identity transform") {
       10.0,
       CesiumUtility::Math::Epsilon6));
 }
+
+TEST_CASE("Test KhrTextureTransform matrix matches applyTransform") {
+  ExtensionKhrTextureTransform extension;
+  extension.offset = {5, 12};
+  extension.rotation = 0.3;
+  extension.scale = {2.0, 0.5};
+
+  KhrTextureTransform textureTransform(extension);
+  const glm::dmat3 matrix = textureTransform.toMatrix();
+  for (const glm::dvec2& uv :
+       {glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0), glm::dvec2(0.25, 0.75)}) {
+    const glm::dvec2 expected = textureTransform.applyTransform(uv.x, uv.y);
+    const glm::dvec3 actual = matrix * glm::dvec3(uv, 1.0);
+    CHECK(CesiumUtility::Math::equalsEpsilon(
+        actual.x,
+        expected.x,
+        CesiumUtility::Math::Epsilon12));
+    CHECK(CesiumUtility::Math::equalsEpsilon(
+        actual.y,
+        expected.y,
+        CesiumUtility::Math::Epsilon12));
+    CHECK(actual.z == 1.0);
+  }
+
+  CHECK(KhrTextureTransform().toMatrix() == glm::dmat3(1.0));
+}
@@ -5,6 +5,8 @@
 #include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 
+#include <CesiumUtility/AttributeCompression.h>
+
 #include <catch2/catch.hpp>
 #include <glm/common.hpp>
 #include <glm/gtc/epsilon.hpp>
@@ -15,6 +17,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -485,6 +488,35 @@ TEST_CASE("Test smooth normal generation") {
     REQUIRE(glm::all(
         glm::epsilonEqual(vertex0Normal, expectedNormal, DEFAULT_EPSILON)));
   }
+
+  SECTION("Test oct-encoded normal generation") {
+    Model model = createCubeGltf();
+
+    model.generateMissingNormalsSmooth(true);
+
+    MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    CHECK(primitive.attributes.find("NORMAL") == primitive.attributes.end());
+    auto normalIt = primitive.attributes.find("_OCT_ENCODED_NORMAL");
+    REQUIRE(normalIt != primitive.attributes.end());
+
+    AccessorView<glm::u16vec2> normalView(model, normalIt->second);
+    REQUIRE(normalView.status() == AccessorViewStatus::Valid);
+    REQUIRE(normalView.size() == 8);
+
+    const glm::u16vec2& encoded = normalView[6];
+    const glm::dvec3 vertex6Normal = AttributeCompression::octDecodeInRange(
+        encoded.x,
+        encoded.y,
+        uint16_t(65535));
+    const glm::dvec3 expectedNormal = glm::normalize(glm::dvec3(1.0, 1.0, 1.0));
+
+    REQUIRE(glm::all(glm::epsilonEqual(vertex6Normal, expectedNormal, 1e-3)));
+
+    // The normals are not generated again.
+    const size_t accessorCount = model.accessors.size();
+    model.generateMissingNormalsSmooth();
+    CHECK(model.accessors.size() == accessorCount);
+  }
 }
 
 TEST_CASE("Model::addExtensionUsed") {
@@ -700,6 +732,58 @@ TEST_CASE("Model::merge") {
     CHECK(m1.nodes[size_t(defaultScene.nodes[3])].name == "node3");
   }
 
+  SECTION("merges several models at once") {
+    Model m1;
+    m1.nodes.emplace_back().name = "node1";
+    m1.scenes.emplace_back().nodes.push_back(0);
+    m1.scene = 0;
+    m1.extensionsUsed.emplace_back("A");
+
+    std::vector<Model> others(3);
+    std::vector<const std::byte*> bufferData;
+    for (size_t i = 0; i < others.size(); ++i) {
+      Model& model = others[i];
+      model.nodes.emplace_back().name = "node" + std::to_string(i + 2);
+      model.scenes.emplace_back().nodes.push_back(0);
+      model.scene = 0;
+      model.extensionsUsed.emplace_back("A");
+
+      Buffer& buffer = model.buffers.emplace_back();
+      buffer.cesium.data.resize(16);
+      buffer.byteLength = 16;
+      bufferData.emplace_back(buffer.cesium.data.data());
+
+      BufferView& bufferView = model.bufferViews.emplace_back();
+      bufferView.buffer = 0;
+      bufferView.byteLength = 16;
+    }
+
+    ErrorList errors = m1.merge(std::move(others));
+    CHECK(errors.errors.empty());
+    CHECK(errors.warnings.empty());
+
+    CHECK(m1.extensionsUsed == std::vector<std::string>{"A"});
+
+    // One scene per model, and one that combines them all.
+    REQUIRE(m1.scenes.size() == 5);
+    REQUIRE(m1.scene == 4);
+    const Scene& defaultScene = m1.scenes[4];
+    REQUIRE(defaultScene.nodes.size() == 4);
+    for (size_t i = 0; i < defaultScene.nodes.size(); ++i) {
+      CHECK(
+          m1.nodes[size_t(defaultScene.nodes[i])].name ==
+          "node" + std::to_string(i + 1));
+    }
+
+    // The buffers are moved, not copied.
+    REQUIRE(m1.buffers.size() == 3);
+    REQUIRE(m1.bufferViews.size() == 3);
+    for (size_t i = 0; i < m1.buffers.size(); ++i) {
+      CHECK(m1.buffers[i].cesium.data.data() == bufferData[i]);
+      CHECK(m1.bufferViews[i].buffer == int32_t(i));
+    }
+  }
+
   SECTION("merges metadata") {
     Model m1;
     Model m2;
@@ -111,6 +111,16 @@ template <typename T> void checkAttributeValues(const std::vector<T>& values) {
     REQUIRE(view.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(view.get(i) == view.getRaw(i));
   }
+
+  gsl::span<const T> rawValues = view.getRawValues();
+  if (accessorView.isContiguous()) {
+    REQUIRE(rawValues.size() == values.size());
+    for (size_t i = 0; i < rawValues.size(); ++i) {
+      REQUIRE(rawValues[i] == values[i]);
+    }
+  } else {
+    REQUIRE(rawValues.empty());
+  }
 }
 
 template <typename T>
@@ -148,6 +158,25 @@ void checkAttributeValues(
     REQUIRE(view.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(view.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  std::vector<T> bulkValues(expected.size());
+  std::vector<uint8_t> hasValue(expected.size());
+  int64_t expectedCount = 0;
+  REQUIRE(view.getValues(0, bulkValues, hasValue) >= 0);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(hasValue[i] == (expected[i] ? 1 : 0));
+    if (!expected[i]) {
+      continue;
+    }
+
+    ++expectedCount;
+    if constexpr (IsMetadataFloating<T>::value) {
+      REQUIRE(bulkValues[i] == Approx(*expected[i]));
+    } else {
+      REQUIRE(bulkValues[i] == *expected[i]);
+    }
+  }
+  REQUIRE(view.getValues(0, bulkValues) == expectedCount);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -190,6 +219,19 @@ void checkNormalizedAttributeValues(
     REQUIRE(view.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(view.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  std::vector<D> bulkValues(expected.size());
+  std::vector<uint8_t> hasValue(expected.size());
+  int64_t expectedCount = 0;
+  REQUIRE(view.getValues(0, bulkValues, hasValue) >= 0);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(hasValue[i] == (expected[i] ? 1 : 0));
+    if (expected[i]) {
+      ++expectedCount;
+      REQUIRE(bulkValues[i] == *expected[i]);
+    }
+  }
+  REQUIRE(view.getValues(0, bulkValues) == expectedCount);
 }
 } // namespace
 
@@ -51,6 +51,12 @@ template <typename T> static void checkNumeric(const std::vector<T>& expected) {
     REQUIRE(property.getRaw(i) == expected[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == property.getRaw(i));
   }
+
+  gsl::span<const T> rawValues = property.getRawValues();
+  REQUIRE(rawValues.size() == expected.size());
+  for (size_t i = 0; i < rawValues.size(); ++i) {
+    REQUIRE(rawValues[i] == expected[i]);
+  }
 }
 
 template <typename T>
@@ -96,6 +102,25 @@ static void checkNumeric(
       REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
     }
   }
+
+  std::vector<T> bulkValues(expected.size());
+  std::vector<uint8_t> hasValue(expected.size());
+  int64_t expectedCount = 0;
+  REQUIRE(property.getValues(0, bulkValues, hasValue) >= 0);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(hasValue[i] == (expected[i] ? 1 : 0));
+    if (!expected[i]) {
+      continue;
+    }
+
+    ++expectedCount;
+    if constexpr (IsMetadataFloating<T>::value) {
+      REQUIRE(bulkValues[i] == Approx(*expected[i]));
+    } else {
+      REQUIRE(bulkValues[i] == *expected[i]);
+    }
+  }
+  REQUIRE(property.getValues(0, bulkValues) == expectedCount);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -139,6 +164,19 @@ static void checkNormalizedNumeric(
     REQUIRE(property.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  std::vector<D> bulkValues(expected.size());
+  std::vector<uint8_t> hasValue(expected.size());
+  int64_t expectedCount = 0;
+  REQUIRE(property.getValues(0, bulkValues, hasValue) >= 0);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(hasValue[i] == (expected[i] ? 1 : 0));
+    if (expected[i]) {
+      ++expectedCount;
+      REQUIRE(bulkValues[i] == *expected[i]);
+    }
+  }
+  REQUIRE(property.getValues(0, bulkValues) == expectedCount);
 }
 
 template <typename DataType, typename OffsetType>
@@ -1297,6 +1335,22 @@ TEST_CASE("Check boolean PropertyTablePropertyView") {
     REQUIRE(property.getRaw(i) == bits[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == property.getRaw(i));
   }
+
+  for (int64_t firstIndex : {0, 3, 8, 13}) {
+    const int64_t count = 11;
+    std::vector<std::byte> bitmask(2, std::byte(0xff));
+    property.getBooleanValues(firstIndex, count, bitmask);
+    for (int64_t i = 0; i < 16; ++i) {
+      const bool bit =
+          ((bitmask[static_cast<size_t>(i / 8)] >> (i % 8)) & std::byte(1)) ==
+          std::byte(1);
+      if (i < count) {
+        REQUIRE(bit == property.getRaw(firstIndex + i));
+      } else {
+        REQUIRE(!bit);
+      }
+    }
+  }
 }
 
 TEST_CASE("Check string PropertyTablePropertyView") {
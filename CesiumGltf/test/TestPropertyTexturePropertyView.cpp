@@ -73,6 +73,14 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expected[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expected[i]);
   }
+
+  std::vector<T> values(texCoords.size());
+  view.getRawValues(texCoords, values);
+  REQUIRE(values == expected);
+  REQUIRE(
+      view.getValues(texCoords, values) ==
+      static_cast<int64_t>(texCoords.size()));
+  REQUIRE(values == expected);
 }
 
 template <typename T>
@@ -145,6 +153,23 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  std::vector<T> rawValues(texCoords.size());
+  view.getRawValues(texCoords, rawValues);
+  REQUIRE(rawValues == expectedRaw);
+
+  std::vector<T> values(texCoords.size());
+  std::vector<uint8_t> hasValue(texCoords.size());
+  int64_t expectedCount = 0;
+  const int64_t count = view.getValues(texCoords, values, hasValue);
+  for (size_t i = 0; i < texCoords.size(); i++) {
+    REQUIRE(hasValue[i] == (expectedTransformed[i] ? 1 : 0));
+    if (expectedTransformed[i]) {
+      ++expectedCount;
+      REQUIRE(values[i] == *expectedTransformed[i]);
+    }
+  }
+  REQUIRE(count == expectedCount);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -223,6 +248,23 @@ void checkNormalizedTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  std::vector<T> rawValues(texCoords.size());
+  view.getRawValues(texCoords, rawValues);
+  REQUIRE(rawValues == expectedRaw);
+
+  std::vector<D> values(texCoords.size());
+  std::vector<uint8_t> hasValue(texCoords.size());
+  int64_t expectedCount = 0;
+  const int64_t count = view.getValues(texCoords, values, hasValue);
+  for (size_t i = 0; i < texCoords.size(); i++) {
+    REQUIRE(hasValue[i] == (expectedTransformed[i] ? 1 : 0));
+    if (expectedTransformed[i]) {
+      ++expectedCount;
+      REQUIRE(values[i] == *expectedTransformed[i]);
+    }
+  }
+  REQUIRE(count == expectedCount);
 }
 
 template <typename T>
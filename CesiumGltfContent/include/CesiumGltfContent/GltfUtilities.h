@@ -1,18 +1,23 @@
 #pragma once
 
 #include "Library.h"
+#include "NodeInstanceGrid.h"
+#include "VertexStreams.h"
 
+#include <CesiumGeometry/TriangleBoundingVolumeHierarchy.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 
 #include <glm/fwd.hpp>
 
+#include <cstdint>
 #include <optional>
 #include <string_view>
 #include <vector>
 
 namespace CesiumGltf {
 struct Buffer;
+struct ImageCesium;
 struct Model;
 struct Node;
 } // namespace CesiumGltf
@@ -109,6 +114,68 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
       const CesiumGltf::Model& gltf,
       const glm::dmat4& transform);
 
+  /**
+   * @brief Quickly computes an approximate bounding region of the vertex
+   * positions in a glTF model.
+   *
+   * Rather than converting every vertex position to cartographic like
+   * {@link computeBoundingRegion}, this converts only the corners, edge
+   * midpoints, face centers, and center of the bounding box of each
+   * primitive. The box comes from the `min` and `max` of the `POSITION`
+   * accessor when it has floating-point components and the primitive has no
+   * skirts, and is otherwise found from the positions. Because the box is not
+   * curved like the ellipsoid, the region may be slightly too small or too
+   * large, especially for models spanning a large area.
+   *
+   * @param gltf The model.
+   * @param transform The transform from model coordinates to ECEF coordinates.
+   * @return The approximate bounding region.
+   */
+  static CesiumGeospatial::BoundingRegion computeApproximateBoundingRegion(
+      const CesiumGltf::Model& gltf,
+      const glm::dmat4& transform);
+
+  /**
+   * @brief Builds a bounding volume hierarchy over the triangles of a glTF
+   * model, for fast ray intersections.
+   *
+   * Only primitives of triangles, triangle strips, and triangle fans are
+   * included. The skirts of terrain meshes are left out, so that rays along
+   * the edges of a tile don't hit them.
+   *
+   * @param gltf The model.
+   * @param transform The transform from model coordinates to ECEF coordinates.
+   * @return The hierarchy, in ECEF coordinates.
+   */
+  static CesiumGeometry::TriangleBoundingVolumeHierarchy
+  createTriangleBoundingVolumeHierarchy(
+      const CesiumGltf::Model& gltf,
+      const glm::dmat4& transform);
+
+  /**
+   * @brief Builds a grid over the instances of each node with the
+   * `EXT_mesh_gpu_instancing` extension, so that the instances outside a view
+   * can be culled, and puts the instance attributes in the order of the grid.
+   *
+   * Nodes with the same instance attributes and transform share a grid. Nodes
+   * whose instance attributes are only partly shared with other nodes, are
+   * sparse, or are not in the model's buffers are left as they are, as are
+   * nodes whose mesh has a `POSITION` accessor without a `min` and `max`. The
+   * implicit feature IDs of `EXT_instance_features`, which are the instance
+   * indices, are replaced by an attribute with the original indices, so that
+   * the instances keep their features.
+   *
+   * @param gltf The model.
+   * @param transform The transform from model coordinates to ECEF coordinates.
+   * @param targetInstancesPerCell The average number of instances in each cell
+   * of a grid.
+   * @return The grids.
+   */
+  static std::vector<NodeInstanceGrid> createInstanceGrids(
+      CesiumGltf::Model& gltf,
+      const glm::dmat4& transform,
+      uint32_t targetInstancesPerCell = 256);
+
   /**
    * @brief Parse the copyright field of a glTF model and return the individual
    * credits.
@@ -182,5 +249,117 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
    * @param bufferIndex The index of the buffer to compact.
    */
   static void compactBuffer(CesiumGltf::Model& gltf, int32_t bufferIndex);
+
+  /**
+   * @brief Reorders the triangles and vertices of the glTF's indexed triangle
+   * primitives, in place, so that they render faster.
+   *
+   * The triangles are reordered for the GPU's vertex cache and then to reduce
+   * overdraw, and the vertices are reordered into the order in which the
+   * triangles use them. The same triangles are rendered afterward.
+   *
+   * Primitives whose accessors or buffer views are used by anything else, and
+   * terrain primitives with skirts, are not changed. The vertices of a
+   * primitive are not reordered if the order is significant, such as when its
+   * feature IDs are its vertex indices or it has tile edges or outlines.
+   *
+   * @param gltf The glTF to modify.
+   * @param compressIndices Whether to also store 32-bit indices as 16-bit ones
+   * when there are few enough vertices. The buffers are compacted afterward.
+   */
+  static void
+  optimizeMeshes(CesiumGltf::Model& gltf, bool compressIndices = false);
+
+  /**
+   * @brief Merges the triangle primitives of the glTF's scene that have the
+   * same material and attributes into one primitive each, so that they take
+   * fewer draw calls to render.
+   *
+   * The transforms of the nodes of the merged primitives are baked into their
+   * positions, normals, and tangents, relative to the node of the first one,
+   * which holds the merged primitive. Feature ID attributes are merged like any
+   * other attribute, so features can still be picked.
+   *
+   * Only primitives with float positions, normals, and tangents are merged,
+   * and not if they have morph targets, extras, or extensions other than
+   * `EXT_mesh_features`, or if their mesh is used by more than one node or by
+   * a skinned or instanced node. Meshes whose primitives are all merged into
+   * others are removed, as are the accessors, buffer views, and buffer bytes
+   * that are no longer used.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void mergePrimitives(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Computes a hash of the decoded pixels of an image, and of its size
+   * and format, that identifies an image with the same content.
+   *
+   * The hash is an xxHash that is the same on every platform and in every run,
+   * so a renderer can use it as the key of a cache of textures, to create one
+   * texture for identical images of different models.
+   *
+   * @param image The decoded image.
+   * @return The hash.
+   */
+  static uint64_t
+  computeImageContentHash(const CesiumGltf::ImageCesium& image) noexcept;
+
+  /**
+   * @brief Makes the textures of identical decoded images use one of them,
+   * and removes the others.
+   *
+   * Images are first compared by {@link computeImageContentHash} and then byte
+   * by byte, so only images with exactly the same pixels are merged. Images
+   * that are not decoded are left alone. The buffer views and buffer bytes of
+   * the removed images are removed too.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void mergeDuplicateImages(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Makes everything that refers to accessors with identical elements
+   * refer to one of them, and removes the others.
+   *
+   * This shares the geometry of meshes that repeat the same vertices and
+   * indices, such as an element of a building model that has been copied with
+   * its own accessors. Accessors are compared by their type, component type,
+   * and count, and by the bytes of their elements, regardless of the layout of
+   * their buffer views. Sparse accessors and accessors without bytes, such as
+   * those of Draco-compressed primitives that have not been decoded, are left
+   * alone. The buffer views and buffer bytes that are no longer used are
+   * removed.
+   *
+   * Primitives then share accessors, which {@link optimizeMeshes} and
+   * {@link mergePrimitives} don't change, so merge the accessors after
+   * calling those.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void mergeDuplicateAccessors(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Writes the vertices and indices of each primitive of the glTF in
+   * the form that a GPU reads them, into memory provided by the renderer.
+   *
+   * The vertex attributes are interleaved and aligned as described in
+   * {@link PrimitiveVertexStreams}, so a renderer can upload them from the
+   * memory, or use it as a vertex buffer directly, without reading the
+   * accessors itself. Primitives without positions are skipped, as are
+   * attributes that are sparse, not in the primitive's buffers, or of a
+   * different count than the positions.
+   *
+   * @param gltf The glTF to read.
+   * @param allocator Allocates the memory to write to. If an allocation fails,
+   * the primitive it was for is skipped, and any memory already allocated for
+   * it is freed.
+   * @param alignment The alignment, in bytes, of the memory to allocate.
+   * @return The streams of each primitive that was written.
+   */
+  static std::vector<PrimitiveVertexStreams> writeVertexStreams(
+      const CesiumGltf::Model& gltf,
+      IStagingBufferAllocator& allocator,
+      size_t alignment = 16);
 };
 } // namespace CesiumGltfContent
@@ -2,8 +2,12 @@
 
 #include "Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 // Forward declarations
 namespace CesiumGltf {
@@ -12,6 +16,24 @@ struct ImageCesium;
 
 namespace CesiumGltfContent {
 
+/**
+ * @brief How {@link ImageManipulation::savePng} compresses an image.
+ */
+enum class PngEncoding {
+  /**
+   * @brief Compresses with stb_image_write, which tries every filter on every
+   * row and searches hard for repeated data. This writes small files, slowly.
+   */
+  Default,
+
+  /**
+   * @brief Filters every row by its difference from the row above and
+   * compresses with zlib at its fastest level. This is several times faster
+   * than {@link PngEncoding::Default}, and the files are somewhat larger.
+   */
+  Fast
+};
+
 /**
  * @brief Specifies a rectangle of pixels in an image.
  */
@@ -96,25 +118,77 @@ public:
       const CesiumGltf::ImageCesium& source,
       const PixelRectangle& sourcePixels);
 
+  /**
+   * @brief Block-compresses an image in place to a gpu-compressed pixel
+   * format.
+   *
+   * Only {@link CesiumGltf::GpuCompressedPixelFormat::BC1_RGB} and
+   * {@link CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA} are supported, and
+   * only for uncompressed images with 4 channels of 1 byte each and no mips.
+   * BC1 drops the alpha channel. An image whose width or height is not a
+   * multiple of 4 repeats its last column or row to fill its last blocks.
+   *
+   * The endpoints of each block are picked quickly rather than optimally, so
+   * this is meant for images that are created at runtime, like the images of
+   * raster overlay tiles, rather than for offline compression.
+   *
+   * @param image The image to compress. Its pixel data is replaced with the
+   * compressed blocks and its `compressedPixelFormat` is set to `format`.
+   * @param format The format to compress the image to.
+   * @returns True if the image was compressed, or false if the format or the
+   * image is not supported, in which case the image is not changed.
+   */
+  static bool compressImage(
+      CesiumGltf::ImageCesium& image,
+      CesiumGltf::GpuCompressedPixelFormat format);
+
   /**
    * @brief Saves an image to a new byte buffer in PNG format.
    *
    * @param image The image to save.
+   * @param encoding How to compress the image.
    * @return The byte buffer containing the image. If the buffer is empty, the
    * image could not be written.
    */
-  static std::vector<std::byte> savePng(const CesiumGltf::ImageCesium& image);
+  static std::vector<std::byte> savePng(
+      const CesiumGltf::ImageCesium& image,
+      PngEncoding encoding = PngEncoding::Default);
 
   /**
    * @brief Saves an image to an existing byte buffer in PNG format.
    *
+   * To save many images without allocating for each one, clear the same
+   * buffer before each call, which keeps its capacity.
+   *
    * @param image The image to save.
    * @param output The buffer in which to store the PNG. The image is written to
    * the end of the buffer. If the buffer size is unchanged on return the image
    * could not be written.
+   * @param encoding How to compress the image.
+   */
+  static void savePng(
+      const CesiumGltf::ImageCesium& image,
+      std::vector<std::byte>& output,
+      PngEncoding encoding = PngEncoding::Default);
+
+  /**
+   * @brief Saves an image in PNG format with {@link PngEncoding::Fast}, using
+   * several worker threads for a large image.
+   *
+   * The image is split into horizontal stripes that are compressed
+   * independently and joined into one PNG, so the file is slightly larger
+   * than one written by {@link savePng} with the same encoding. An image that
+   * is too small to be worth splitting is written in a single worker thread.
+   *
+   * @param asyncSystem The async system whose worker threads compress the
+   * stripes.
+   * @param image The image to save. Move the image in to avoid copying it.
+   * @return A future that resolves to the byte buffer containing the image.
+   * If the buffer is empty, the image could not be written.
    */
-  static void
-  savePng(const CesiumGltf::ImageCesium& image, std::vector<std::byte>& output);
+  static CesiumAsync::Future<std::vector<std::byte>> savePngInParallel(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumGltf::ImageCesium image);
 };
 
 } // namespace CesiumGltfContent
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/InstanceGrid.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGltfContent {
+
+/**
+ * @brief A grid over the `EXT_mesh_gpu_instancing` instances of one or more
+ * nodes of a glTF, from {@link GltfUtilities::createInstanceGrids}.
+ */
+struct CESIUMGLTFCONTENT_API NodeInstanceGrid {
+  /**
+   * @brief The indices of the nodes whose instances are in the grid. All of
+   * them have the same instance attributes and the same transform.
+   */
+  std::vector<int32_t> nodes;
+
+  /**
+   * @brief The grid, in ECEF coordinates. The instance attributes of the nodes
+   * are in the order of the grid, so its ranges are ranges of their instances.
+   */
+  CesiumGeometry::InstanceGrid grid;
+};
+
+} // namespace CesiumGltfContent
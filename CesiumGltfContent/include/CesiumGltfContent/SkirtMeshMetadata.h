@@ -2,6 +2,7 @@
 
 #include <glm/vec3.hpp>
 
+#include <cstdint>
 #include <optional>
 
 namespace CesiumGltfContent {
@@ -15,7 +16,12 @@ struct SkirtMeshMetadata {
         skirtWestHeight{0.0},
         skirtSouthHeight{0.0},
         skirtEastHeight{0.0},
-        skirtNorthHeight{0.0} {}
+        skirtNorthHeight{0.0},
+        skirtEdgeIndicesAccessor{-1},
+        skirtWestEdgeCount{0},
+        skirtSouthEdgeCount{0},
+        skirtEastEdgeCount{0},
+        skirtNorthEdgeCount{0} {}
 
   static std::optional<SkirtMeshMetadata>
   parseFromGltfExtras(const CesiumUtility::JsonValue::Object& extras);
@@ -32,5 +38,18 @@ struct SkirtMeshMetadata {
   double skirtSouthHeight;
   double skirtEastHeight;
   double skirtNorthHeight;
+
+  // The index of the accessor with the indices of the vertices along the edges
+  // of the mesh, when the skirts are left for the renderer to create from them
+  // instead of being part of the mesh, or -1 otherwise. The accessor traverses
+  // the west edge from south to north, then the south edge from east to west,
+  // the east edge from north to south, and the north edge from west to east,
+  // with the given number of vertices along each edge. The skirt of each edge
+  // goes down by its height from these vertices.
+  int32_t skirtEdgeIndicesAccessor;
+  uint32_t skirtWestEdgeCount;
+  uint32_t skirtSouthEdgeCount;
+  uint32_t skirtEastEdgeCount;
+  uint32_t skirtNorthEdgeCount;
 };
 } // namespace CesiumGltfContent
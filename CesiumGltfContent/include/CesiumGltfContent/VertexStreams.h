@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CesiumGltfContent {
+
+/**
+ * @brief Memory provided by a renderer, such as part of a mapped staging
+ * buffer, that receives vertex or index data.
+ */
+struct CESIUMGLTFCONTENT_API StagingAllocation {
+  /**
+   * @brief The memory to write to. An empty span indicates that the memory
+   * could not be allocated.
+   */
+  gsl::span<std::byte> data;
+
+  /**
+   * @brief An arbitrary handle that identifies the allocation to the renderer,
+   * such as the staging buffer it is in.
+   */
+  void* pHandle = nullptr;
+};
+
+/**
+ * @brief Allocates the memory that {@link GltfUtilities::writeVertexStreams}
+ * writes vertex and index data to.
+ *
+ * Instances of this class may be called from several worker threads at once.
+ */
+class CESIUMGLTFCONTENT_API IStagingBufferAllocator {
+public:
+  virtual ~IStagingBufferAllocator() = default;
+
+  /**
+   * @brief Allocates memory.
+   *
+   * @param byteSize The number of bytes to allocate.
+   * @param alignment The alignment of the start of the memory, in bytes.
+   * @return The allocation, whose data is at least `byteSize` bytes long, or
+   * an allocation with empty data if it could not be allocated.
+   */
+  virtual StagingAllocation allocate(size_t byteSize, size_t alignment) = 0;
+
+  /**
+   * @brief Frees memory that was allocated by {@link allocate} and is no
+   * longer needed, such as when a tile's load is canceled before its streams
+   * are given to the renderer.
+   *
+   * @param allocation The allocation to free.
+   */
+  virtual void free(const StagingAllocation& allocation) noexcept = 0;
+};
+
+/**
+ * @brief An attribute of the interleaved vertices in
+ * {@link PrimitiveVertexStreams::vertices}.
+ */
+struct CESIUMGLTFCONTENT_API VertexStreamAttribute {
+  /**
+   * @brief The name of the attribute in the primitive, such as `POSITION`.
+   */
+  std::string name;
+
+  /**
+   * @brief The index of the attribute's accessor in the model.
+   */
+  int32_t accessor = -1;
+
+  /**
+   * @brief The offset of the attribute from the start of each vertex, in
+   * bytes. It is a multiple of four.
+   */
+  size_t byteOffset = 0;
+
+  /**
+   * @brief The size of the attribute, in bytes. Its components are the type
+   * and component type of its accessor.
+   */
+  size_t byteSize = 0;
+};
+
+/**
+ * @brief The vertices and indices of a glTF primitive, written in the form
+ * that a GPU reads them.
+ *
+ * The vertices are interleaved, with each attribute at an offset that is a
+ * multiple of four bytes and a stride that is a multiple of four bytes. The
+ * indices are either 16-bit or 32-bit, with 8-bit indices widened to 16-bit.
+ */
+struct CESIUMGLTFCONTENT_API PrimitiveVertexStreams {
+  /**
+   * @brief The index of the primitive's mesh in the model.
+   */
+  int32_t meshIndex = -1;
+
+  /**
+   * @brief The index of the primitive in its mesh.
+   */
+  int32_t primitiveIndex = -1;
+
+  /**
+   * @brief The attributes of each vertex, in order of their offsets.
+   */
+  std::vector<VertexStreamAttribute> attributes;
+
+  /**
+   * @brief The number of vertices.
+   */
+  size_t vertexCount = 0;
+
+  /**
+   * @brief The distance from the start of one vertex to the next, in bytes.
+   */
+  size_t vertexByteStride = 0;
+
+  /**
+   * @brief The memory holding the vertices.
+   */
+  StagingAllocation vertices;
+
+  /**
+   * @brief The number of indices, or zero if the primitive is not indexed.
+   */
+  size_t indexCount = 0;
+
+  /**
+   * @brief The size of each index, in bytes: 2 or 4, or 0 if the primitive is
+   * not indexed.
+   */
+  size_t indexByteSize = 0;
+
+  /**
+   * @brief The memory holding the indices, if the primitive is indexed.
+   */
+  StagingAllocation indices;
+};
+
+} // namespace CesiumGltfContent
@@ -1,6 +1,7 @@
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGeometry/Transforms.h>
 #include <CesiumGeospatial/BoundingRegionBuilder.h>
+#include <CesiumGltf/AccessorUtility.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionCesiumPrimitiveOutline.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
@@ -15,11 +16,27 @@
 #include <CesiumGltf/FeatureId.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
+#include <CesiumUtility/Hash.h>
 
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <meshoptimizer.h>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 using namespace CesiumGltf;
@@ -179,9 +196,13 @@ GltfUtilities::computeBoundingRegion(
   // at such extreme latitudes.
   CesiumGeospatial::BoundingRegionBuilder computedBounds;
 
+  // Reused for the positions of every primitive.
+  std::vector<glm::dvec3> positionsEcef;
+  std::vector<std::optional<CesiumGeospatial::Cartographic>> cartographics;
+
   gltf.forEachPrimitiveInScene(
       -1,
-      [&rootTransform, &computedBounds](
+      [&rootTransform, &computedBounds, &positionsEcef, &cartographics](
           const CesiumGltf::Model& gltf_,
           const CesiumGltf::Node& /*node*/,
           const CesiumGltf::Mesh& /*mesh*/,
@@ -200,10 +221,10 @@ GltfUtilities::computeBoundingRegion(
 
         const glm::dmat4 fullTransform = rootTransform * nodeTransform;
 
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
-            gltf_,
-            positionAccessorIndex);
-        if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+        const CesiumGltf::QuantizedPositionAccessorType positionView =
+            CesiumGltf::getQuantizedPositionAccessorView(gltf_, primitive);
+        if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+            CesiumGltf::AccessorViewStatus::Valid) {
           return;
         }
 
@@ -216,30 +237,633 @@ GltfUtilities::computeBoundingRegion(
                       skirtMeshMetadata->noSkirtVerticesCount;
         } else {
           vertexBegin = 0;
-          vertexEnd = positionView.size();
+          vertexEnd = std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+        }
+
+        const bool normalized =
+            gltf_.accessors[static_cast<size_t>(positionAccessorIndex)]
+                .normalized;
+        // Get the ECEF positions
+        positionsEcef.clear();
+        std::visit(
+            [&](const auto& view) {
+              const int64_t begin = glm::max(vertexBegin, int64_t(0));
+              const int64_t end = glm::min(vertexEnd, view.size());
+              if (begin >= end) {
+                return;
+              }
+
+              positionsEcef.reserve(static_cast<size_t>(end - begin));
+              for (auto it = view.begin() + begin; it != view.begin() + end;
+                   ++it) {
+                positionsEcef.emplace_back(
+                    fullTransform *
+                    glm::dvec4(
+                        CesiumGltf::PositionFromAccessor::toVec3(
+                            *it,
+                            normalized),
+                        1.0));
+              }
+            },
+            positionView);
+
+        // Convert them to cartographic
+        cartographics.resize(positionsEcef.size());
+        CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
+            positionsEcef,
+            cartographics);
+        for (const std::optional<CesiumGeospatial::Cartographic>& cartographic :
+             cartographics) {
+          if (cartographic) {
+            computedBounds.expandToIncludePosition(*cartographic);
+          }
         }
+      });
 
-        for (int64_t i = vertexBegin; i < vertexEnd; ++i) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[i];
-          const glm::dvec3 positionEcef =
-              glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
+  return computedBounds.toRegion();
+}
 
-          // Convert it to cartographic
-          std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
-          if (!cartographic) {
-            continue;
+namespace {
+// The minimum and maximum corners of a box.
+using PositionBox = std::pair<glm::dvec3, glm::dvec3>;
+
+// Finds the bounding box of the positions of a primitive in its own
+// coordinates, from the accessor's min and max when they can be trusted.
+std::optional<PositionBox> computePositionBox(
+    const CesiumGltf::Model& gltf,
+    const CesiumGltf::MeshPrimitive& primitive,
+    const CesiumGltf::Accessor& positionAccessor) {
+  const std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+
+  // The min and max of quantized positions are quantized too, and the skirts
+  // of a terrain mesh hang below the rest of it.
+  if (!skirtMeshMetadata &&
+      positionAccessor.componentType ==
+          CesiumGltf::Accessor::ComponentType::FLOAT &&
+      positionAccessor.min.size() == 3 && positionAccessor.max.size() == 3) {
+    return std::make_pair(
+        glm::dvec3(
+            positionAccessor.min[0],
+            positionAccessor.min[1],
+            positionAccessor.min[2]),
+        glm::dvec3(
+            positionAccessor.max[0],
+            positionAccessor.max[1],
+            positionAccessor.max[2]));
+  }
+
+  const CesiumGltf::QuantizedPositionAccessorType positionView =
+      CesiumGltf::getQuantizedPositionAccessorView(gltf, primitive);
+  if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+      CesiumGltf::AccessorViewStatus::Valid) {
+    return std::nullopt;
+  }
+
+  int64_t vertexBegin = 0;
+  int64_t vertexEnd = std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+  if (skirtMeshMetadata) {
+    vertexBegin = skirtMeshMetadata->noSkirtVerticesBegin;
+    vertexEnd = skirtMeshMetadata->noSkirtVerticesBegin +
+                skirtMeshMetadata->noSkirtVerticesCount;
+  }
+
+  return std::visit(
+      [vertexBegin, vertexEnd, normalized = positionAccessor.normalized](
+          const auto& view) -> std::optional<PositionBox> {
+        const int64_t begin = glm::max(vertexBegin, int64_t(0));
+        const int64_t end = glm::min(vertexEnd, view.size());
+        if (begin >= end) {
+          return std::nullopt;
+        }
+
+        glm::dvec3 minimum(std::numeric_limits<double>::max());
+        glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+        for (auto it = view.begin() + begin; it != view.begin() + end; ++it) {
+          const glm::dvec3 position(
+              CesiumGltf::PositionFromAccessor::toVec3(*it, normalized));
+          minimum = glm::min(minimum, position);
+          maximum = glm::max(maximum, position);
+        }
+
+        return std::make_pair(minimum, maximum);
+      },
+      positionView);
+}
+} // namespace
+
+/*static*/ CesiumGeospatial::BoundingRegion
+GltfUtilities::computeApproximateBoundingRegion(
+    const CesiumGltf::Model& gltf,
+    const glm::dmat4& transform) {
+  glm::dmat4 rootTransform = transform;
+  rootTransform = applyRtcCenter(gltf, rootTransform);
+  rootTransform = applyGltfUpAxisTransform(gltf, rootTransform);
+
+  CesiumGeospatial::BoundingRegionBuilder computedBounds;
+
+  // Reused for every primitive.
+  std::vector<glm::dvec3> pointsEcef;
+  std::vector<std::optional<CesiumGeospatial::Cartographic>> cartographics;
+
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&rootTransform, &computedBounds, &pointsEcef, &cartographics](
+          const CesiumGltf::Model& gltf_,
+          const CesiumGltf::Node& /*node*/,
+          const CesiumGltf::Mesh& /*mesh*/,
+          const CesiumGltf::MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const CesiumGltf::Accessor* pPositionAccessor =
+            CesiumGltf::Model::getSafe(&gltf_.accessors, positionIt->second);
+        if (!pPositionAccessor) {
+          return;
+        }
+
+        const std::optional<PositionBox> maybeBox =
+            computePositionBox(gltf_, primitive, *pPositionAccessor);
+        if (!maybeBox) {
+          return;
+        }
+
+        // Sample the box on a 3x3x3 lattice, so that the middles of its faces
+        // and edges, which are nearer to or farther from the ellipsoid than
+        // the corners, are also included.
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+        pointsEcef.clear();
+        for (int x = 0; x < 3; ++x) {
+          for (int y = 0; y < 3; ++y) {
+            for (int z = 0; z < 3; ++z) {
+              const glm::dvec3 position = glm::mix(
+                  maybeBox->first,
+                  maybeBox->second,
+                  glm::dvec3(x, y, z) * 0.5);
+              pointsEcef.emplace_back(
+                  fullTransform * glm::dvec4(position, 1.0));
+            }
           }
+        }
 
-          computedBounds.expandToIncludePosition(*cartographic);
+        cartographics.resize(pointsEcef.size());
+        CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
+            pointsEcef,
+            cartographics);
+        for (const std::optional<CesiumGeospatial::Cartographic>& cartographic :
+             cartographics) {
+          if (cartographic) {
+            computedBounds.expandToIncludePosition(*cartographic);
+          }
         }
       });
 
   return computedBounds.toRegion();
 }
 
+/*static*/ CesiumGeometry::TriangleBoundingVolumeHierarchy
+GltfUtilities::createTriangleBoundingVolumeHierarchy(
+    const CesiumGltf::Model& gltf,
+    const glm::dmat4& transform) {
+  glm::dmat4 rootTransform = transform;
+  rootTransform = applyRtcCenter(gltf, rootTransform);
+  rootTransform = applyGltfUpAxisTransform(gltf, rootTransform);
+
+  std::vector<glm::dvec3> triangleVertices;
+
+  // Reused for the positions of every primitive.
+  std::vector<glm::dvec3> positionsEcef;
+
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&rootTransform, &triangleVertices, &positionsEcef](
+          const CesiumGltf::Model& gltf_,
+          const CesiumGltf::Node& /*node*/,
+          const CesiumGltf::Mesh& /*mesh*/,
+          const CesiumGltf::MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::TRIANGLES &&
+            primitive.mode !=
+                CesiumGltf::MeshPrimitive::Mode::TRIANGLE_STRIP &&
+            primitive.mode != CesiumGltf::MeshPrimitive::Mode::TRIANGLE_FAN) {
+          return;
+        }
+
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const CesiumGltf::Accessor* pPositionAccessor =
+            CesiumGltf::Model::getSafe(&gltf_.accessors, positionIt->second);
+        if (!pPositionAccessor) {
+          return;
+        }
+
+        const CesiumGltf::QuantizedPositionAccessorType positionView =
+            CesiumGltf::getQuantizedPositionAccessorView(gltf_, primitive);
+        if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+            CesiumGltf::AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const CesiumGltf::IndexAccessorType indexView =
+            CesiumGltf::getIndexAccessorView(gltf_, primitive);
+        const bool hasIndices =
+            !std::holds_alternative<std::monostate>(indexView);
+        if (hasIndices &&
+            std::visit(CesiumGltf::StatusFromAccessor{}, indexView) !=
+                CesiumGltf::AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const int64_t vertexCount =
+            std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+        const int64_t indexCount =
+            hasIndices ? std::visit(CesiumGltf::CountFromAccessor{}, indexView)
+                       : vertexCount;
+
+        int64_t faceBegin = 0;
+        int64_t faceEnd =
+            primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES
+                ? indexCount / 3
+                : glm::max(indexCount - 2, int64_t(0));
+
+        // The skirts come after the other triangles of a terrain mesh.
+        std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+            SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+        if (skirtMeshMetadata && hasIndices &&
+            primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES) {
+          faceBegin = skirtMeshMetadata->noSkirtIndicesBegin / 3;
+          faceEnd = glm::min(
+              faceEnd,
+              faceBegin + skirtMeshMetadata->noSkirtIndicesCount / 3);
+        }
+
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+        const bool normalized = pPositionAccessor->normalized;
+
+        positionsEcef.resize(static_cast<size_t>(vertexCount));
+        std::visit(
+            [&](const auto& view) {
+              std::transform(
+                  view.begin(),
+                  view.end(),
+                  positionsEcef.begin(),
+                  [&fullTransform, normalized](const auto& position) {
+                    return glm::dvec3(
+                        fullTransform *
+                        glm::dvec4(
+                            CesiumGltf::PositionFromAccessor::toVec3(
+                                position,
+                                normalized),
+                            1.0));
+                  });
+            },
+            positionView);
+
+        for (int64_t face = faceBegin; face < faceEnd; ++face) {
+          const std::array<int64_t, 3> indices = std::visit(
+              CesiumGltf::IndicesForFaceFromAccessor{
+                  face,
+                  vertexCount,
+                  primitive.mode},
+              indexView);
+          if (indices[0] < 0 || indices[1] < 0 || indices[2] < 0 ||
+              indices[0] >= vertexCount || indices[1] >= vertexCount ||
+              indices[2] >= vertexCount) {
+            continue;
+          }
+
+          for (const int64_t index : indices) {
+            triangleVertices.push_back(
+                positionsEcef[static_cast<size_t>(index)]);
+          }
+        }
+      });
+
+  return CesiumGeometry::TriangleBoundingVolumeHierarchy(
+      std::move(triangleVertices));
+}
+
+namespace {
+// The elements of an accessor within its buffer, which may be interleaved with
+// other data.
+struct AccessorElements {
+  std::byte* pData;
+  int64_t byteStride;
+  int64_t elementSize;
+  int64_t count;
+};
+
+std::optional<AccessorElements>
+getAccessorElements(Model& gltf, int32_t accessorId) {
+  const Accessor* pAccessor = Model::getSafe(&gltf.accessors, accessorId);
+  if (!pAccessor || pAccessor->sparse) {
+    return std::nullopt;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&gltf.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return std::nullopt;
+  }
+
+  Buffer* pBuffer = Model::getSafe(&gltf.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeBytesPerVertex();
+  const int64_t byteStride = pAccessor->computeByteStride(gltf);
+  const int64_t byteOffset = pBufferView->byteOffset + pAccessor->byteOffset;
+  const int64_t byteEnd = glm::min(
+      pBufferView->byteOffset + pBufferView->byteLength,
+      static_cast<int64_t>(pBuffer->cesium.data.size()));
+  if (elementSize <= 0 || byteStride < elementSize || pAccessor->count <= 0 ||
+      byteOffset < 0 ||
+      byteOffset + byteStride * (pAccessor->count - 1) + elementSize >
+          byteEnd) {
+    return std::nullopt;
+  }
+
+  return AccessorElements{
+      pBuffer->cesium.data.data() + byteOffset,
+      byteStride,
+      elementSize,
+      pAccessor->count};
+}
+
+void permuteAccessorElements(
+    const AccessorElements& elements,
+    const std::vector<uint32_t>& order) {
+  const size_t elementSize = static_cast<size_t>(elements.elementSize);
+  std::vector<std::byte> original(order.size() * elementSize);
+  for (size_t i = 0; i < order.size(); ++i) {
+    std::memcpy(
+        original.data() + i * elementSize,
+        elements.pData + int64_t(i) * elements.byteStride,
+        elementSize);
+  }
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    std::memcpy(
+        elements.pData + int64_t(i) * elements.byteStride,
+        original.data() + size_t(order[i]) * elementSize,
+        elementSize);
+  }
+}
+
+// Gets the radius of a sphere around the origin of a mesh that encloses it,
+// from the bounds of its positions.
+std::optional<double> getMeshRadius(const Model& gltf, const Mesh& mesh) {
+  double radius = 0.0;
+  for (const MeshPrimitive& primitive : mesh.primitives) {
+    auto positionIt = primitive.attributes.find("POSITION");
+    if (positionIt == primitive.attributes.end()) {
+      continue;
+    }
+
+    const Accessor* pPositions =
+        Model::getSafe(&gltf.accessors, positionIt->second);
+    if (!pPositions || pPositions->min.size() != 3 ||
+        pPositions->max.size() != 3) {
+      return std::nullopt;
+    }
+
+    const glm::dvec3 minimum(
+        pPositions->min[0],
+        pPositions->min[1],
+        pPositions->min[2]);
+    const glm::dvec3 maximum(
+        pPositions->max[0],
+        pPositions->max[1],
+        pPositions->max[2]);
+    radius = glm::max(
+        radius,
+        glm::length(glm::max(glm::abs(minimum), glm::abs(maximum))));
+  }
+  return radius;
+}
+
+// Replaces the implicit feature IDs of the instances, which are their indices,
+// with an attribute of the original indices of the reordered instances.
+void addOriginalInstanceFeatureIds(
+    Model& gltf,
+    const std::vector<int32_t>& nodes,
+    const std::vector<uint32_t>& order) {
+  // The feature ID set index and accessor of the original indices, which are
+  // shared by all the nodes.
+  std::optional<std::pair<int64_t, int32_t>> originalIds;
+  for (int32_t nodeId : nodes) {
+    Node& node = gltf.nodes[size_t(nodeId)];
+    ExtensionExtInstanceFeatures* pFeatures =
+        node.getExtension<ExtensionExtInstanceFeatures>();
+    if (!pFeatures) {
+      continue;
+    }
+
+    ExtensionExtMeshGpuInstancing& instancing =
+        *node.getExtension<ExtensionExtMeshGpuInstancing>();
+    for (ExtensionExtInstanceFeaturesFeatureId& featureId :
+         pFeatures->featureIds) {
+      if (featureId.attribute) {
+        continue;
+      }
+
+      if (!originalIds) {
+        int64_t setIndex = 0;
+        while (instancing.attributes.count(
+                   "_FEATURE_ID_" + std::to_string(setIndex)) > 0) {
+          ++setIndex;
+        }
+
+        std::vector<std::byte> data(order.size() * sizeof(float));
+        float* pIds = reinterpret_cast<float*>(data.data());
+        for (size_t i = 0; i < order.size(); ++i) {
+          pIds[i] = static_cast<float>(order[i]);
+        }
+
+        const int32_t bufferId = static_cast<int32_t>(gltf.buffers.size());
+        Buffer& buffer = gltf.buffers.emplace_back();
+        buffer.byteLength = static_cast<int64_t>(data.size());
+        buffer.cesium.data = std::move(data);
+
+        const int32_t bufferViewId =
+            static_cast<int32_t>(gltf.bufferViews.size());
+        BufferView& bufferView = gltf.bufferViews.emplace_back();
+        bufferView.buffer = bufferId;
+        bufferView.byteLength = buffer.byteLength;
+
+        const int32_t accessorId = static_cast<int32_t>(gltf.accessors.size());
+        Accessor& accessor = gltf.accessors.emplace_back();
+        accessor.bufferView = bufferViewId;
+        accessor.componentType = Accessor::ComponentType::FLOAT;
+        accessor.count = static_cast<int64_t>(order.size());
+        accessor.type = Accessor::Type::SCALAR;
+
+        originalIds = {setIndex, accessorId};
+      }
+
+      instancing.attributes
+          ["_FEATURE_ID_" + std::to_string(originalIds->first)] =
+          originalIds->second;
+      featureId.attribute = originalIds->first;
+    }
+  }
+}
+} // namespace
+
+/*static*/ std::vector<NodeInstanceGrid> GltfUtilities::createInstanceGrids(
+    CesiumGltf::Model& gltf,
+    const glm::dmat4& transform,
+    uint32_t targetInstancesPerCell) {
+  glm::dmat4 rootTransform = transform;
+  rootTransform = applyRtcCenter(gltf, rootTransform);
+  rootTransform = applyGltfUpAxisTransform(gltf, rootTransform);
+
+  struct Group {
+    std::vector<int32_t> nodes;
+    glm::dmat4 transform;
+  };
+  std::vector<Group> groups;
+
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&groups](
+          CesiumGltf::Model& gltf_,
+          CesiumGltf::Node& node,
+          CesiumGltf::Mesh& /*mesh*/,
+          CesiumGltf::MeshPrimitive& /*primitive*/,
+          const glm::dmat4& nodeTransform) {
+        const ExtensionExtMeshGpuInstancing* pInstancing =
+            node.getExtension<ExtensionExtMeshGpuInstancing>();
+        if (!pInstancing || gltf_.nodes.empty()) {
+          return;
+        }
+
+        const int32_t nodeId =
+            static_cast<int32_t>(&node - gltf_.nodes.data());
+        for (const Group& group : groups) {
+          if (std::find(group.nodes.begin(), group.nodes.end(), nodeId) !=
+              group.nodes.end()) {
+            return;
+          }
+        }
+
+        // Each primitive of the mesh is visited, but the node only needs to be
+        // added once.
+        auto groupIt =
+            std::find_if(groups.begin(), groups.end(), [&](const Group& group) {
+              const Node& first = gltf_.nodes[size_t(group.nodes[0])];
+              return group.transform == nodeTransform &&
+                     first.getExtension<ExtensionExtMeshGpuInstancing>()
+                             ->attributes == pInstancing->attributes;
+            });
+        if (groupIt != groups.end()) {
+          groupIt->nodes.emplace_back(nodeId);
+        } else {
+          groups.emplace_back(Group{{nodeId}, nodeTransform});
+        }
+      });
+
+  // The attributes of a group are reordered for its grid, so they must not be
+  // used by any other group.
+  std::map<int32_t, size_t> groupsUsingAccessor;
+  for (const Group& group : groups) {
+    for (const auto& pair :
+         gltf.nodes[size_t(group.nodes[0])]
+             .getExtension<ExtensionExtMeshGpuInstancing>()
+             ->attributes) {
+      ++groupsUsingAccessor[pair.second];
+    }
+  }
+
+  std::vector<NodeInstanceGrid> result;
+  for (const Group& group : groups) {
+    const Node& node = gltf.nodes[size_t(group.nodes[0])];
+    const ExtensionExtMeshGpuInstancing& instancing =
+        *node.getExtension<ExtensionExtMeshGpuInstancing>();
+
+    std::vector<AccessorElements> attributes;
+    int64_t instanceCount = -1;
+    bool valid = !instancing.attributes.empty();
+    for (const auto& pair : instancing.attributes) {
+      std::optional<AccessorElements> maybeElements =
+          getAccessorElements(gltf, pair.second);
+      if (!maybeElements || groupsUsingAccessor[pair.second] > 1 ||
+          (instanceCount >= 0 && maybeElements->count != instanceCount)) {
+        valid = false;
+        break;
+      }
+      instanceCount = maybeElements->count;
+      attributes.emplace_back(*maybeElements);
+    }
+
+    // The original indices of the instances are stored as floats if needed.
+    const Mesh* pMesh = Model::getSafe(&gltf.meshes, node.mesh);
+    const std::optional<double> maybeMeshRadius =
+        pMesh ? getMeshRadius(gltf, *pMesh) : std::nullopt;
+    if (!valid || !maybeMeshRadius || instanceCount > (int64_t(1) << 24)) {
+      continue;
+    }
+
+    std::vector<glm::dvec3> translations(size_t(instanceCount), glm::dvec3(0));
+    std::vector<glm::dvec3> scales(size_t(instanceCount), glm::dvec3(1));
+    auto translationIt = instancing.attributes.find("TRANSLATION");
+    if (translationIt != instancing.attributes.end()) {
+      AccessorView<glm::vec3> view(gltf, translationIt->second);
+      for (int64_t i = 0; i < view.size(); ++i) {
+        translations[size_t(i)] = glm::dvec3(view[i]);
+      }
+    }
+    auto scaleIt = instancing.attributes.find("SCALE");
+    if (scaleIt != instancing.attributes.end()) {
+      AccessorView<glm::vec3> view(gltf, scaleIt->second);
+      for (int64_t i = 0; i < view.size(); ++i) {
+        scales[size_t(i)] = glm::dvec3(view[i]);
+      }
+    }
+
+    // Rotations don't change the size of the sphere around each instance.
+    const glm::dmat4 instancesToEcef = rootTransform * group.transform;
+    const double nodeScale = glm::max(
+        glm::length(glm::dvec3(instancesToEcef[0])),
+        glm::max(
+            glm::length(glm::dvec3(instancesToEcef[1])),
+            glm::length(glm::dvec3(instancesToEcef[2]))));
+
+    std::vector<glm::dvec3> centers(size_t(instanceCount));
+    std::vector<double> radii(size_t(instanceCount));
+    for (size_t i = 0; i < centers.size(); ++i) {
+      const glm::dvec3 scale = glm::abs(scales[i]);
+      centers[i] =
+          glm::dvec3(instancesToEcef * glm::dvec4(translations[i], 1.0));
+      radii[i] = *maybeMeshRadius * nodeScale *
+                 glm::max(scale.x, glm::max(scale.y, scale.z));
+    }
+
+    NodeInstanceGrid& grid = result.emplace_back();
+    grid.nodes = group.nodes;
+    grid.grid = CesiumGeometry::InstanceGrid(
+        centers,
+        radii,
+        targetInstancesPerCell);
+
+    const std::vector<uint32_t>& order = grid.grid.getInstanceOrder();
+    for (const AccessorElements& elements : attributes) {
+      permuteAccessorElements(elements, order);
+    }
+
+    addOriginalInstanceFeatureIds(gltf, group.nodes, order);
+  }
+
+  return result;
+}
+
 std::vector<std::string_view>
 GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   std::vector<std::string_view> result;
@@ -267,11 +891,43 @@ GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   if (gltf.buffers.empty())
     return;
 
+  // Find where the content of each buffer goes, aligned to a 4-byte boundary
+  // like moveBufferContent does, so that the destination is only resized once.
+  std::vector<size_t> starts(gltf.buffers.size(), 0);
+  size_t size = gltf.buffers[0].cesium.data.size();
+  for (size_t i = 1; i < gltf.buffers.size(); ++i) {
+    assert(
+        gltf.buffers[i].byteLength ==
+        int64_t(gltf.buffers[i].cesium.data.size()));
+    size = (size + 3) / 4 * 4;
+    starts[i] = size;
+    size += gltf.buffers[i].cesium.data.size();
+  }
+
   Buffer& destinationBuffer = gltf.buffers[0];
+  assert(
+      destinationBuffer.byteLength ==
+      int64_t(destinationBuffer.cesium.data.size()));
+  destinationBuffer.cesium.data.resize(size);
+  destinationBuffer.byteLength = int64_t(size);
 
   for (size_t i = 1; i < gltf.buffers.size(); ++i) {
-    Buffer& sourceBuffer = gltf.buffers[i];
-    GltfUtilities::moveBufferContent(gltf, destinationBuffer, sourceBuffer);
+    std::vector<std::byte>& sourceData = gltf.buffers[i].cesium.data;
+    if (!sourceData.empty()) {
+      std::memcpy(
+          destinationBuffer.cesium.data.data() + starts[i],
+          sourceData.data(),
+          sourceData.size());
+    }
+  }
+
+  for (BufferView& bufferView : gltf.bufferViews) {
+    if (bufferView.buffer <= 0 ||
+        size_t(bufferView.buffer) >= gltf.buffers.size())
+      continue;
+
+    bufferView.byteOffset += int64_t(starts[size_t(bufferView.buffer)]);
+    bufferView.buffer = 0;
   }
 
   // Remove all the old buffers
@@ -432,6 +1088,12 @@ struct VisitAccessorIds {
           callback(pair.second);
         }
 
+        for (auto& target : primitive.targets) {
+          for (auto& pair : target) {
+            callback(pair.second);
+          }
+        }
+
         ExtensionCesiumTileEdges* pTileEdges =
             primitive.getExtension<ExtensionCesiumTileEdges>();
         if (pTileEdges) {
@@ -605,56 +1267,118 @@ void GltfUtilities::removeUnusedBufferViews(
       VisitBufferViewIds());
 }
 
-void GltfUtilities::compactBuffers(CesiumGltf::Model& gltf) {
-  for (size_t i = 0;
-       i < gltf.buffers.size() && i < std::numeric_limits<int32_t>::max();
-       ++i) {
-    GltfUtilities::compactBuffer(gltf, int32_t(i));
-  }
-}
-
 namespace {
 
-void deleteBufferRange(
-    CesiumGltf::Model& gltf,
-    int32_t bufferIndex,
-    int64_t start,
-    int64_t end) {
-  Buffer* pBuffer = gltf.getSafe(&gltf.buffers, bufferIndex);
-  if (pBuffer == nullptr)
-    return;
+// Removes the bytes of the buffer that aren't in any of its buffer views, and
+// updates their offsets. The used ranges are sorted and merged once, and each
+// one is moved only once.
+void compactBufferViews(
+    Buffer& buffer,
+    const std::vector<BufferView*>& bufferViews) {
+  assert(size_t(buffer.byteLength) == buffer.cesium.data.size());
 
-  assert(size_t(pBuffer->byteLength) == pBuffer->cesium.data.size());
+  struct BufferRange {
+    int64_t start; // first byte
+    int64_t end;   // one past last byte
+  };
 
-  int64_t bytesToRemove = end - start;
+  const int64_t byteLength = int64_t(buffer.cesium.data.size());
+  auto getRange = [byteLength](const BufferView& bufferView) {
+    const int64_t start =
+        std::clamp(bufferView.byteOffset, int64_t(0), byteLength);
+    const int64_t end = std::clamp(
+        bufferView.byteOffset + bufferView.byteLength,
+        start,
+        byteLength);
+    return BufferRange{start, end};
+  };
 
-  // Adjust bufferView offets for the removed bytes.
-  for (BufferView& bufferView : gltf.bufferViews) {
-    if (bufferView.buffer != bufferIndex)
-      continue;
+  std::vector<BufferRange> ranges;
+  ranges.reserve(bufferViews.size());
+  for (const BufferView* pBufferView : bufferViews) {
+    ranges.emplace_back(getRange(*pBufferView));
+  }
 
-    // Sanity check that we're not removing a part of the buffer used by this
-    // bufferView.
-    assert(
-        bufferView.byteOffset >= end ||
-        (bufferView.byteOffset + bufferView.byteLength) <= start);
+  std::sort(
+      ranges.begin(),
+      ranges.end(),
+      [](const BufferRange& lhs, const BufferRange& rhs) {
+        return lhs.start < rhs.start;
+      });
+
+  // Combine the ranges that overlap or touch.
+  std::vector<BufferRange> usedRanges;
+  for (const BufferRange& range : ranges) {
+    if (!usedRanges.empty() && range.start <= usedRanges.back().end) {
+      usedRanges.back().end = std::max(usedRanges.back().end, range.end);
+    } else {
+      usedRanges.emplace_back(range);
+    }
+  }
+
+  const bool isCompact =
+      byteLength == 0 ||
+      (usedRanges.size() == 1 && usedRanges[0].start == 0 &&
+       usedRanges[0].end == byteLength);
+  if (isCompact) {
+    return;
+  }
 
-    // If this bufferView starts after the bytes we're removing, adjust the
-    // start position accordingly.
-    if (bufferView.byteOffset >= start) {
-      bufferView.byteOffset -= bytesToRemove;
+  // Move each used range down to just after the previous one.
+  std::vector<int64_t> newStarts(usedRanges.size());
+  int64_t nextStart = 0;
+  for (size_t i = 0; i < usedRanges.size(); ++i) {
+    const BufferRange& range = usedRanges[i];
+    if (nextStart != range.start) {
+      std::memmove(
+          buffer.cesium.data.data() + nextStart,
+          buffer.cesium.data.data() + range.start,
+          size_t(range.end - range.start));
     }
+    newStarts[i] = nextStart;
+    nextStart += range.end - range.start;
   }
 
-  // Actually remove the bytes from the buffer.
-  pBuffer->byteLength -= bytesToRemove;
-  pBuffer->cesium.data.erase(
-      pBuffer->cesium.data.begin() + start,
-      pBuffer->cesium.data.begin() + end);
+  buffer.cesium.data.resize(size_t(nextStart));
+  buffer.byteLength = nextStart;
+
+  for (BufferView* pBufferView : bufferViews) {
+    const int64_t start = getRange(*pBufferView).start;
+
+    // Find the used range that contains this buffer view, which is the last
+    // one that starts at or before it.
+    auto it = std::upper_bound(
+        usedRanges.begin(),
+        usedRanges.end(),
+        start,
+        [](int64_t value, const BufferRange& range) {
+          return value < range.start;
+        });
+    assert(it != usedRanges.begin());
+    --it;
+
+    pBufferView->byteOffset =
+        start - it->start + newStarts[size_t(it - usedRanges.begin())];
+  }
 }
 
 } // namespace
 
+void GltfUtilities::compactBuffers(CesiumGltf::Model& gltf) {
+  std::vector<std::vector<BufferView*>> bufferViewsByBuffer(
+      gltf.buffers.size());
+  for (BufferView& bufferView : gltf.bufferViews) {
+    if (bufferView.buffer >= 0 &&
+        size_t(bufferView.buffer) < bufferViewsByBuffer.size()) {
+      bufferViewsByBuffer[size_t(bufferView.buffer)].emplace_back(&bufferView);
+    }
+  }
+
+  for (size_t i = 0; i < gltf.buffers.size(); ++i) {
+    compactBufferViews(gltf.buffers[i], bufferViewsByBuffer[i]);
+  }
+}
+
 void GltfUtilities::compactBuffer(
     CesiumGltf::Model& gltf,
     int32_t bufferIndex) {
@@ -662,71 +1386,1222 @@ void GltfUtilities::compactBuffer(
   if (!pBuffer)
     return;
 
-  assert(size_t(pBuffer->byteLength) == pBuffer->cesium.data.size());
-
-  struct BufferRange {
-    int64_t start; // first byte
-    int64_t end;   // one past last byte
-
-    // Order ranges by their start
-    bool operator<(const BufferRange& rhs) const {
-      return this->start < rhs.start;
+  std::vector<BufferView*> bufferViews;
+  for (BufferView& bufferView : gltf.bufferViews) {
+    if (bufferView.buffer == bufferIndex) {
+      bufferViews.emplace_back(&bufferView);
     }
-  };
+  }
 
-  std::vector<BufferRange> usedRanges;
+  compactBufferViews(*pBuffer, bufferViews);
+}
 
-  for (BufferView& bufferView : gltf.bufferViews) {
-    if (bufferView.buffer != bufferIndex)
-      continue;
+namespace {
+// The bytes of the elements of an accessor, within its buffer.
+struct ConstAccessorBytes {
+  const Accessor* pAccessor;
+  const std::byte* pData;
+  size_t elementSize;
+  size_t stride;
+};
 
-    int64_t start = bufferView.byteOffset;
-    int64_t end = start + bufferView.byteLength;
+std::optional<ConstAccessorBytes>
+getAccessorBytes(const Model& gltf, int32_t accessorIndex) {
+  const Accessor* pAccessor = Model::getSafe(&gltf.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0 ||
+      pAccessor->byteOffset < 0) {
+    return std::nullopt;
+  }
 
-    auto it = std::lower_bound(
-        usedRanges.begin(),
-        usedRanges.end(),
-        BufferRange{start, end});
-    it = usedRanges.insert(it, BufferRange{start, end});
-
-    // Check if we can merge with the previous range.
-    if (it != usedRanges.begin()) {
-      auto previousIt = it - 1;
-      if (previousIt->end >= it->start) {
-        // New range overlaps the previous, so combine them.
-        previousIt->end = std::max(previousIt->end, it->end);
-        it = usedRanges.erase(it) - 1;
+  const BufferView* pBufferView =
+      Model::getSafe(&gltf.bufferViews, pAccessor->bufferView);
+  if (!pBufferView || pBufferView->byteOffset < 0) {
+    return std::nullopt;
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&gltf.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeBytesPerVertex();
+  const int64_t stride = pAccessor->computeByteStride(gltf);
+  if (elementSize <= 0 || stride < elementSize) {
+    return std::nullopt;
+  }
+
+  const int64_t size = (pAccessor->count - 1) * stride + elementSize;
+  const int64_t start = pBufferView->byteOffset + pAccessor->byteOffset;
+  if (pAccessor->byteOffset + size > pBufferView->byteLength ||
+      start + size > int64_t(pBuffer->cesium.data.size())) {
+    return std::nullopt;
+  }
+
+  return ConstAccessorBytes{
+      pAccessor,
+      pBuffer->cesium.data.data() + start,
+      size_t(elementSize),
+      size_t(stride)};
+}
+
+// The bytes of the elements of an accessor of a glTF that may be modified.
+struct AccessorBytes {
+  Accessor* pAccessor;
+  std::byte* pData;
+  size_t elementSize;
+  size_t stride;
+};
+
+std::optional<AccessorBytes>
+getAccessorBytes(Model& gltf, int32_t accessorIndex) {
+  const std::optional<ConstAccessorBytes> maybeBytes =
+      getAccessorBytes(std::as_const(gltf), accessorIndex);
+  if (!maybeBytes) {
+    return std::nullopt;
+  }
+
+  // The glTF isn't const, so neither are its accessors and buffers.
+  return AccessorBytes{
+      const_cast<Accessor*>(maybeBytes->pAccessor),
+      const_cast<std::byte*>(maybeBytes->pData),
+      maybeBytes->elementSize,
+      maybeBytes->stride};
+}
+
+// Moves element i of the accessor to element remap[i].
+void remapElements(
+    const AccessorBytes& bytes,
+    const std::vector<uint32_t>& remap) {
+  std::vector<std::byte> remapped(remap.size() * bytes.elementSize);
+  for (size_t i = 0; i < remap.size(); ++i) {
+    std::memcpy(
+        remapped.data() + size_t(remap[i]) * bytes.elementSize,
+        bytes.pData + i * bytes.stride,
+        bytes.elementSize);
+  }
+
+  for (size_t i = 0; i < remap.size(); ++i) {
+    std::memcpy(
+        bytes.pData + i * bytes.stride,
+        remapped.data() + i * bytes.elementSize,
+        bytes.elementSize);
+  }
+}
+
+template <typename T>
+void writeIndices(std::byte* pData, const std::vector<uint32_t>& indices) {
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const T index = static_cast<T>(indices[i]);
+    std::memcpy(pData + i * sizeof(T), &index, sizeof(T));
+  }
+}
+
+// Whether some of the primitive's data refers to its vertices by index, so
+// that they can't be reordered.
+bool dependsOnVertexOrder(const MeshPrimitive& primitive) {
+  if (primitive.hasExtension<ExtensionCesiumTileEdges>() ||
+      primitive.hasExtension<ExtensionCesiumPrimitiveOutline>()) {
+    return true;
+  }
+
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    for (const FeatureId& featureId : pMeshFeatures->featureIds) {
+      // Without an attribute or a texture, the feature ID is the vertex index.
+      if (!featureId.attribute && !featureId.texture) {
+        return true;
       }
     }
+  }
 
-    // Check if we can merge with the next range.
-    auto nextIt = it + 1;
-    if (nextIt != usedRanges.end()) {
-      if (it->end >= nextIt->start) {
-        // New range overlaps the next, so combine them.
-        it->end = std::max(it->end, nextIt->end);
-        it = usedRanges.erase(nextIt) - 1;
+  return false;
+}
+
+// Optimizes one primitive, and returns whether its indices were compressed.
+bool optimizePrimitive(
+    Model& gltf,
+    MeshPrimitive& primitive,
+    const std::vector<int32_t>& accessorUses,
+    const std::vector<int32_t>& bufferViewUses,
+    bool compressIndices) {
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      primitive.indices < 0) {
+    return false;
+  }
+
+  // The skirts of a terrain mesh are found by their vertex and index ranges.
+  if (SkirtMeshMetadata::parseFromGltfExtras(primitive.extras)) {
+    return false;
+  }
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return false;
+  }
+
+  const Accessor* pPositionAccessor =
+      Model::getSafe(&gltf.accessors, positionIt->second);
+  if (!pPositionAccessor || pPositionAccessor->count <= 0 ||
+      pPositionAccessor->count >
+          int64_t(std::numeric_limits<uint32_t>::max())) {
+    return false;
+  }
+  const size_t vertexCount = size_t(pPositionAccessor->count);
+
+  std::vector<int32_t> vertexAccessors;
+  for (const auto& pair : primitive.attributes) {
+    vertexAccessors.emplace_back(pair.second);
+  }
+  for (const auto& target : primitive.targets) {
+    for (const auto& pair : target) {
+      vertexAccessors.emplace_back(pair.second);
+    }
+  }
+
+  // Nothing but this primitive may use its accessors or their buffer views,
+  // because they are modified in place.
+  std::map<int32_t, int32_t> bufferViewUsesHere;
+  auto getExclusiveBytes =
+      [&gltf, &accessorUses, &bufferViewUsesHere](
+          int32_t accessorIndex) -> std::optional<AccessorBytes> {
+    if (accessorIndex < 0 || size_t(accessorIndex) >= accessorUses.size() ||
+        accessorUses[size_t(accessorIndex)] != 1) {
+      return std::nullopt;
+    }
+
+    std::optional<AccessorBytes> bytes = getAccessorBytes(gltf, accessorIndex);
+    if (bytes) {
+      ++bufferViewUsesHere[bytes->pAccessor->bufferView];
+    }
+    return bytes;
+  };
+
+  std::vector<AccessorBytes> vertexBytes;
+  for (const int32_t accessorIndex : vertexAccessors) {
+    std::optional<AccessorBytes> bytes = getExclusiveBytes(accessorIndex);
+    if (!bytes || bytes->pAccessor->count != int64_t(vertexCount)) {
+      return false;
+    }
+    vertexBytes.emplace_back(*bytes);
+  }
+
+  const std::optional<AccessorBytes> indexBytes =
+      getExclusiveBytes(primitive.indices);
+  if (!indexBytes || indexBytes->stride != indexBytes->elementSize) {
+    return false;
+  }
+
+  for (const auto& pair : bufferViewUsesHere) {
+    if (bufferViewUses[size_t(pair.first)] != pair.second) {
+      return false;
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  const bool indicesValid = std::visit(
+      [&indices, vertexCount](const auto& view) {
+        if constexpr (std::is_same_v<
+                          std::decay_t<decltype(view)>,
+                          std::monostate>) {
+          return false;
+        } else {
+          if (view.status() != AccessorViewStatus::Valid) {
+            return false;
+          }
+
+          indices.resize(size_t(view.size()));
+          for (int64_t i = 0; i < view.size(); ++i) {
+            const uint32_t index = static_cast<uint32_t>(view[i]);
+            if (index >= vertexCount) {
+              return false;
+            }
+            indices[size_t(i)] = index;
+          }
+          return true;
+        }
+      },
+      getIndexAccessorView(gltf, primitive));
+  if (!indicesValid || indices.empty() || indices.size() % 3 != 0) {
+    return false;
+  }
+
+  const QuantizedPositionAccessorType positionView =
+      getQuantizedPositionAccessorView(gltf, primitive);
+  if (std::visit(StatusFromAccessor{}, positionView) !=
+      AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  std::vector<glm::vec3> positions;
+  positions.reserve(vertexCount);
+  std::visit(
+      [&positions, normalized = pPositionAccessor->normalized](
+          const auto& view) {
+        for (const auto& position : view) {
+          positions.emplace_back(
+              PositionFromAccessor::toVec3(position, normalized));
+        }
+      },
+      positionView);
+
+  meshopt_optimizeVertexCache(
+      indices.data(),
+      indices.data(),
+      indices.size(),
+      vertexCount);
+
+  // Allow the vertex cache efficiency to get up to 5% worse.
+  meshopt_optimizeOverdraw(
+      indices.data(),
+      indices.data(),
+      indices.size(),
+      &positions[0].x,
+      vertexCount,
+      sizeof(glm::vec3),
+      1.05f);
+
+  if (!dependsOnVertexOrder(primitive)) {
+    std::vector<uint32_t> remap(vertexCount);
+    const size_t usedVertexCount = meshopt_optimizeVertexFetchRemap(
+        remap.data(),
+        indices.data(),
+        indices.size(),
+        vertexCount);
+
+    // Keep the unused vertices, after the used ones, so that the counts and
+    // bounds of the accessors stay the same.
+    uint32_t nextUnusedVertex = static_cast<uint32_t>(usedVertexCount);
+    for (uint32_t& newIndex : remap) {
+      if (newIndex == ~0U) {
+        newIndex = nextUnusedVertex++;
       }
     }
+
+    meshopt_remapIndexBuffer(
+        indices.data(),
+        indices.data(),
+        indices.size(),
+        remap.data());
+    for (const AccessorBytes& bytes : vertexBytes) {
+      remapElements(bytes, remap);
+    }
+  }
+
+  Accessor& indexAccessor = *indexBytes->pAccessor;
+  const bool compress =
+      compressIndices &&
+      indexAccessor.componentType == Accessor::ComponentType::UNSIGNED_INT &&
+      vertexCount <= size_t(std::numeric_limits<uint16_t>::max());
+
+  if (compress) {
+    indexAccessor.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+
+    // Let compactBuffers remove the unused half of the indices.
+    BufferView& bufferView = gltf.bufferViews[size_t(indexAccessor.bufferView)];
+    bufferView.byteLength =
+        indexAccessor.byteOffset +
+        int64_t(indices.size() * sizeof(uint16_t));
+  }
+
+  switch (indexAccessor.componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    writeIndices<uint8_t>(indexBytes->pData, indices);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    writeIndices<uint16_t>(indexBytes->pData, indices);
+    break;
+  default:
+    writeIndices<uint32_t>(indexBytes->pData, indices);
+    break;
+  }
+
+  return compress;
+}
+} // namespace
+
+/*static*/ void
+GltfUtilities::optimizeMeshes(CesiumGltf::Model& gltf, bool compressIndices) {
+  std::vector<int32_t> accessorUses(gltf.accessors.size(), 0);
+  auto countAccessorUse = [&accessorUses](int32_t accessorIndex) {
+    if (accessorIndex >= 0 && size_t(accessorIndex) < accessorUses.size()) {
+      ++accessorUses[size_t(accessorIndex)];
+    }
+  };
+  VisitAccessorIds()(gltf, countAccessorUse);
+
+  std::vector<int32_t> bufferViewUses(gltf.bufferViews.size(), 0);
+  VisitBufferViewIds()(gltf, [&bufferViewUses](int32_t bufferViewIndex) {
+    if (bufferViewIndex >= 0 &&
+        size_t(bufferViewIndex) < bufferViewUses.size()) {
+      ++bufferViewUses[size_t(bufferViewIndex)];
+    }
+  });
+
+  bool anyCompressed = false;
+  for (Mesh& mesh : gltf.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      anyCompressed = optimizePrimitive(
+                          gltf,
+                          primitive,
+                          accessorUses,
+                          bufferViewUses,
+                          compressIndices) ||
+                      anyCompressed;
+    }
+  }
+
+  if (anyCompressed) {
+    GltfUtilities::compactBuffers(gltf);
+  }
+}
+
+namespace {
+// A primitive of the scene that may be merged with others.
+struct MergeCandidate {
+  size_t meshIndex;
+  size_t primitiveIndex;
+  glm::dmat4 transform;
+  size_t vertexCount;
+  std::vector<uint32_t> indices;
+  bool mergeable;
+};
+
+bool isFloatAttribute(const Accessor& accessor, const std::string& type) {
+  return accessor.type == type &&
+         accessor.componentType == Accessor::ComponentType::FLOAT &&
+         !accessor.normalized;
+}
+
+// Checks whether a primitive can be merged with others, and gets its vertex
+// count and triangle indices if it can.
+bool readMergeCandidate(
+    Model& gltf,
+    const MeshPrimitive& primitive,
+    MergeCandidate& candidate) {
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      !primitive.targets.empty() || !primitive.extras.empty()) {
+    return false;
+  }
+
+  for (const auto& pair : primitive.extensions) {
+    if (pair.first != ExtensionExtMeshFeatures::ExtensionName &&
+        pair.first != ExtensionKhrDracoMeshCompression::ExtensionName) {
+      return false;
+    }
+  }
+
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    for (const FeatureId& featureId : pMeshFeatures->featureIds) {
+      // Feature ID textures use texture coordinates, which are merged, but
+      // implicit feature IDs are vertex indices, which are not.
+      if (featureId.texture || !featureId.attribute) {
+        return false;
+      }
+    }
+  }
+
+  if (primitive.attributes.find("POSITION") == primitive.attributes.end()) {
+    return false;
+  }
+
+  std::optional<int64_t> vertexCount;
+  for (const auto& pair : primitive.attributes) {
+    const std::optional<AccessorBytes> bytes =
+        getAccessorBytes(gltf, pair.second);
+    if (!bytes || (vertexCount && bytes->pAccessor->count != *vertexCount)) {
+      return false;
+    }
+    vertexCount = bytes->pAccessor->count;
+
+    // These are transformed, so they must be floats.
+    if (((pair.first == "POSITION" || pair.first == "NORMAL") &&
+         !isFloatAttribute(*bytes->pAccessor, Accessor::Type::VEC3)) ||
+        (pair.first == "TANGENT" &&
+         !isFloatAttribute(*bytes->pAccessor, Accessor::Type::VEC4))) {
+      return false;
+    }
+  }
+
+  if (!vertexCount ||
+      *vertexCount > int64_t(std::numeric_limits<uint32_t>::max())) {
+    return false;
+  }
+  candidate.vertexCount = size_t(*vertexCount);
+
+  candidate.indices.clear();
+  if (primitive.indices < 0) {
+    candidate.indices.resize(candidate.vertexCount);
+    for (size_t i = 0; i < candidate.indices.size(); ++i) {
+      candidate.indices[i] = static_cast<uint32_t>(i);
+    }
+  } else {
+    const IndexAccessorType indexView = getIndexAccessorView(gltf, primitive);
+    if (std::visit(StatusFromAccessor{}, indexView) !=
+        AccessorViewStatus::Valid) {
+      return false;
+    }
+
+    const bool indicesValid = std::visit(
+        [&candidate](const auto& view) {
+          if constexpr (std::is_same_v<
+                            std::decay_t<decltype(view)>,
+                            std::monostate>) {
+            return false;
+          } else {
+            candidate.indices.resize(size_t(view.size()));
+            for (int64_t i = 0; i < view.size(); ++i) {
+              const uint32_t index = static_cast<uint32_t>(view[i]);
+              if (index >= candidate.vertexCount) {
+                return false;
+              }
+              candidate.indices[size_t(i)] = index;
+            }
+            return true;
+          }
+        },
+        indexView);
+    if (!indicesValid) {
+      return false;
+    }
+  }
+
+  return candidate.indices.size() % 3 == 0;
+}
+
+bool haveSameFeatureIds(const MeshPrimitive& a, const MeshPrimitive& b) {
+  const ExtensionExtMeshFeatures* pA =
+      a.getExtension<ExtensionExtMeshFeatures>();
+  const ExtensionExtMeshFeatures* pB =
+      b.getExtension<ExtensionExtMeshFeatures>();
+  if (!pA || !pB) {
+    return !pA && !pB;
+  }
+
+  if (pA->featureIds.size() != pB->featureIds.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < pA->featureIds.size(); ++i) {
+    const FeatureId& featureIdA = pA->featureIds[i];
+    const FeatureId& featureIdB = pB->featureIds[i];
+    if (featureIdA.featureCount != featureIdB.featureCount ||
+        featureIdA.nullFeatureId != featureIdB.nullFeatureId ||
+        featureIdA.label != featureIdB.label ||
+        featureIdA.attribute != featureIdB.attribute ||
+        featureIdA.propertyTable != featureIdB.propertyTable) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool canMerge(
+    const Model& gltf,
+    const MeshPrimitive& a,
+    const MeshPrimitive& b) {
+  if (a.material != b.material || a.attributes.size() != b.attributes.size() ||
+      !haveSameFeatureIds(a, b)) {
+    return false;
   }
 
-  // At this point, any gaps in the usedRanges represent buffer bytes that are
-  // not referenced by any bufferView. Work through it backwards so that we
-  // don't need to update the ranges as we delete unused data from the buffer.
-  BufferRange nextRange{pBuffer->byteLength, pBuffer->byteLength};
-  for (int64_t i = int64_t(usedRanges.size()) - 1; i >= 0; --i) {
-    BufferRange& usedRange = usedRanges[size_t(i)];
-    if (usedRange.end < nextRange.start) {
-      // This is a gap.
-      deleteBufferRange(gltf, bufferIndex, usedRange.end, nextRange.start);
+  for (const auto& pair : a.attributes) {
+    auto it = b.attributes.find(pair.first);
+    if (it == b.attributes.end()) {
+      return false;
     }
-    nextRange = usedRange;
+
+    const Accessor& accessorA = gltf.accessors[size_t(pair.second)];
+    const Accessor& accessorB = gltf.accessors[size_t(it->second)];
+    if (accessorA.type != accessorB.type ||
+        accessorA.componentType != accessorB.componentType ||
+        accessorA.normalized != accessorB.normalized) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Adds an accessor for the data, in its own buffer.
+int32_t addAccessor(
+    Model& gltf,
+    std::vector<std::byte>&& data,
+    size_t count,
+    const std::string& type,
+    int32_t componentType,
+    bool normalized,
+    std::optional<int64_t> byteStride,
+    int32_t target) {
+  const size_t bufferId = gltf.buffers.size();
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(data.size());
+  buffer.cesium.data = std::move(data);
+
+  const size_t bufferViewId = gltf.bufferViews.size();
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(bufferId);
+  bufferView.byteLength = buffer.byteLength;
+  bufferView.byteOffset = 0;
+  bufferView.byteStride = byteStride;
+  bufferView.target = target;
+
+  const size_t accessorId = gltf.accessors.size();
+  Accessor& accessor = gltf.accessors.emplace_back();
+  accessor.byteOffset = 0;
+  accessor.bufferView = static_cast<int32_t>(bufferViewId);
+  accessor.componentType = componentType;
+  accessor.normalized = normalized;
+  accessor.count = static_cast<int64_t>(count);
+  accessor.type = type;
+  return static_cast<int32_t>(accessorId);
+}
+
+enum class MergedAttribute { Position, Normal, Tangent, Other };
+
+// Merges the attributes and indices of the candidates, baking their
+// transforms relative to the first one's.
+MeshPrimitive
+mergeCandidates(Model& gltf, const std::vector<const MergeCandidate*>& group) {
+  const MergeCandidate& first = *group[0];
+  const MeshPrimitive& firstPrimitive =
+      gltf.meshes[first.meshIndex].primitives[first.primitiveIndex];
+  const glm::dmat4 inverseFirstTransform = glm::inverse(first.transform);
+
+  std::vector<glm::dmat4> transforms;
+  size_t vertexCount = 0;
+  size_t indexCount = 0;
+  for (const MergeCandidate* pCandidate : group) {
+    transforms.emplace_back(inverseFirstTransform * pCandidate->transform);
+    vertexCount += pCandidate->vertexCount;
+    indexCount += pCandidate->indices.size();
   }
 
-  if (nextRange.start > 0) {
-    // There is a gap at the start of the buffer.
-    deleteBufferRange(gltf, bufferIndex, 0, nextRange.start);
+  MeshPrimitive merged;
+  merged.mode = MeshPrimitive::Mode::TRIANGLES;
+  merged.material = firstPrimitive.material;
+
+  const ExtensionExtMeshFeatures* pMeshFeatures =
+      firstPrimitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pMeshFeatures) {
+    merged.addExtension<ExtensionExtMeshFeatures>() = *pMeshFeatures;
   }
+
+  for (const auto& pair : firstPrimitive.attributes) {
+    const Accessor& firstAccessor = gltf.accessors[size_t(pair.second)];
+    const std::string type = firstAccessor.type;
+    const int32_t componentType = firstAccessor.componentType;
+    const bool normalized = firstAccessor.normalized;
+
+    MergedAttribute kind = MergedAttribute::Other;
+    if (pair.first == "POSITION") {
+      kind = MergedAttribute::Position;
+    } else if (pair.first == "NORMAL") {
+      kind = MergedAttribute::Normal;
+    } else if (pair.first == "TANGENT") {
+      kind = MergedAttribute::Tangent;
+    }
+
+    // Each vertex attribute element must be aligned to 4 bytes.
+    const size_t elementSize = size_t(firstAccessor.computeBytesPerVertex());
+    const size_t stride = (elementSize + 3) / 4 * 4;
+    std::vector<std::byte> data(vertexCount * stride);
+    glm::dvec3 minimum(std::numeric_limits<double>::max());
+    glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+
+    size_t firstVertex = 0;
+    for (size_t i = 0; i < group.size(); ++i) {
+      const MeshPrimitive& primitive =
+          gltf.meshes[group[i]->meshIndex].primitives[group[i]->primitiveIndex];
+      const AccessorBytes bytes =
+          *getAccessorBytes(gltf, primitive.attributes.at(pair.first));
+      const glm::dmat4& transform = transforms[i];
+      const glm::dmat3 normalTransform =
+          glm::inverseTranspose(glm::dmat3(transform));
+
+      for (size_t j = 0; j < group[i]->vertexCount; ++j) {
+        const std::byte* pSource = bytes.pData + j * bytes.stride;
+        std::byte* pTarget = data.data() + (firstVertex + j) * stride;
+
+        if (kind == MergedAttribute::Position) {
+          glm::vec3 position;
+          std::memcpy(&position, pSource, sizeof(position));
+          const glm::dvec3 transformed(
+              transform * glm::dvec4(glm::dvec3(position), 1.0));
+          minimum = glm::min(minimum, transformed);
+          maximum = glm::max(maximum, transformed);
+          position = glm::vec3(transformed);
+          std::memcpy(pTarget, &position, sizeof(position));
+        } else if (kind == MergedAttribute::Normal) {
+          glm::vec3 normal;
+          std::memcpy(&normal, pSource, sizeof(normal));
+          const glm::dvec3 transformed = normalTransform * glm::dvec3(normal);
+          if (glm::dot(transformed, transformed) > 0.0) {
+            normal = glm::vec3(glm::normalize(transformed));
+          }
+          std::memcpy(pTarget, &normal, sizeof(normal));
+        } else if (kind == MergedAttribute::Tangent) {
+          glm::vec4 tangent;
+          std::memcpy(&tangent, pSource, sizeof(tangent));
+          const glm::dvec3 transformed =
+              glm::dmat3(transform) * glm::dvec3(tangent);
+          if (glm::dot(transformed, transformed) > 0.0) {
+            tangent =
+                glm::vec4(glm::vec3(glm::normalize(transformed)), tangent.w);
+          }
+          std::memcpy(pTarget, &tangent, sizeof(tangent));
+        } else {
+          std::memcpy(pTarget, pSource, elementSize);
+        }
+      }
+
+      firstVertex += group[i]->vertexCount;
+    }
+
+    const int32_t accessorId = addAccessor(
+        gltf,
+        std::move(data),
+        vertexCount,
+        type,
+        componentType,
+        normalized,
+        int64_t(stride),
+        BufferView::Target::ARRAY_BUFFER);
+    if (kind == MergedAttribute::Position) {
+      Accessor& accessor = gltf.accessors[size_t(accessorId)];
+      accessor.min = {minimum.x, minimum.y, minimum.z};
+      accessor.max = {maximum.x, maximum.y, maximum.z};
+    }
+
+    merged.attributes[pair.first] = accessorId;
+  }
+
+  std::vector<uint32_t> indices;
+  indices.reserve(indexCount);
+  size_t firstVertex = 0;
+  for (size_t i = 0; i < group.size(); ++i) {
+    const uint32_t offset = static_cast<uint32_t>(firstVertex);
+
+    // A mirroring transform turns the triangles inside out.
+    const bool flip = glm::determinant(glm::dmat3(transforms[i])) < 0.0;
+    const std::vector<uint32_t>& candidateIndices = group[i]->indices;
+    for (size_t j = 0; j < candidateIndices.size(); j += 3) {
+      indices.emplace_back(candidateIndices[j] + offset);
+      indices.emplace_back(candidateIndices[j + (flip ? 2 : 1)] + offset);
+      indices.emplace_back(candidateIndices[j + (flip ? 1 : 2)] + offset);
+    }
+
+    firstVertex += group[i]->vertexCount;
+  }
+
+  const bool shortIndices =
+      vertexCount <= size_t(std::numeric_limits<uint16_t>::max());
+  std::vector<std::byte> indexData(
+      indices.size() * (shortIndices ? sizeof(uint16_t) : sizeof(uint32_t)));
+  if (shortIndices) {
+    writeIndices<uint16_t>(indexData.data(), indices);
+  } else {
+    writeIndices<uint32_t>(indexData.data(), indices);
+  }
+
+  merged.indices = addAccessor(
+      gltf,
+      std::move(indexData),
+      indices.size(),
+      Accessor::Type::SCALAR,
+      shortIndices ? Accessor::ComponentType::UNSIGNED_SHORT
+                   : Accessor::ComponentType::UNSIGNED_INT,
+      false,
+      std::nullopt,
+      BufferView::Target::ELEMENT_ARRAY_BUFFER);
+
+  return merged;
+}
+} // namespace
+
+/*static*/ void GltfUtilities::mergePrimitives(CesiumGltf::Model& gltf) {
+  std::vector<int32_t> meshUses(gltf.meshes.size(), 0);
+  for (const Node& node : gltf.nodes) {
+    if (node.mesh >= 0 && size_t(node.mesh) < meshUses.size()) {
+      ++meshUses[size_t(node.mesh)];
+    }
+  }
+
+  std::vector<MergeCandidate> candidates;
+  std::map<std::pair<size_t, size_t>, size_t> candidateIndices;
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&gltf, &meshUses, &candidates, &candidateIndices](
+          const Model& /*gltf_*/,
+          const Node& node,
+          const Mesh& mesh,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        const size_t meshIndex = size_t(&mesh - gltf.meshes.data());
+        const size_t primitiveIndex =
+            size_t(&primitive - mesh.primitives.data());
+
+        // A node that is visited more than once has more than one transform.
+        auto it = candidateIndices.find({meshIndex, primitiveIndex});
+        if (it != candidateIndices.end()) {
+          candidates[it->second].mergeable = false;
+          return;
+        }
+
+        MergeCandidate& candidate = candidates.emplace_back();
+        candidateIndices[{meshIndex, primitiveIndex}] = candidates.size() - 1;
+        candidate.meshIndex = meshIndex;
+        candidate.primitiveIndex = primitiveIndex;
+        candidate.transform = transform;
+        candidate.mergeable =
+            meshUses[meshIndex] == 1 && mesh.weights.empty() &&
+            node.skin < 0 && node.weights.empty() &&
+            !node.hasExtension<ExtensionExtMeshGpuInstancing>() &&
+            readMergeCandidate(gltf, primitive, candidate);
+      });
+
+  std::vector<std::vector<const MergeCandidate*>> groups;
+  for (const MergeCandidate& candidate : candidates) {
+    if (!candidate.mergeable) {
+      continue;
+    }
+
+    const MeshPrimitive& primitive =
+        gltf.meshes[candidate.meshIndex].primitives[candidate.primitiveIndex];
+    auto groupIt = std::find_if(
+        groups.begin(),
+        groups.end(),
+        [&gltf, &primitive](const std::vector<const MergeCandidate*>& group) {
+          const MeshPrimitive& groupPrimitive =
+              gltf.meshes[group[0]->meshIndex]
+                  .primitives[group[0]->primitiveIndex];
+          return canMerge(gltf, groupPrimitive, primitive);
+        });
+    if (groupIt == groups.end()) {
+      groups.emplace_back().emplace_back(&candidate);
+    } else {
+      groupIt->emplace_back(&candidate);
+    }
+  }
+
+  std::vector<std::vector<bool>> removedPrimitives(gltf.meshes.size());
+  for (size_t i = 0; i < gltf.meshes.size(); ++i) {
+    removedPrimitives[i].resize(gltf.meshes[i].primitives.size(), false);
+  }
+
+  bool anyMerged = false;
+  for (const std::vector<const MergeCandidate*>& group : groups) {
+    size_t vertexCount = 0;
+    for (const MergeCandidate* pCandidate : group) {
+      vertexCount += pCandidate->vertexCount;
+    }
+
+    if (group.size() < 2 ||
+        vertexCount > size_t(std::numeric_limits<uint32_t>::max())) {
+      continue;
+    }
+
+    MeshPrimitive merged = mergeCandidates(gltf, group);
+    gltf.meshes[group[0]->meshIndex].primitives[group[0]->primitiveIndex] =
+        std::move(merged);
+    for (size_t i = 1; i < group.size(); ++i) {
+      removedPrimitives[group[i]->meshIndex][group[i]->primitiveIndex] = true;
+    }
+    anyMerged = true;
+  }
+
+  if (!anyMerged) {
+    return;
+  }
+
+  // Remove the merged primitives, and the meshes that are left with none.
+  std::vector<int32_t> meshIndexMap(gltf.meshes.size(), -1);
+  std::vector<Mesh> meshes;
+  meshes.reserve(gltf.meshes.size());
+  for (size_t i = 0; i < gltf.meshes.size(); ++i) {
+    Mesh& mesh = gltf.meshes[i];
+    const bool hadPrimitives = !mesh.primitives.empty();
+
+    std::vector<MeshPrimitive> primitives;
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      if (!removedPrimitives[i][j]) {
+        primitives.emplace_back(std::move(mesh.primitives[j]));
+      }
+    }
+    mesh.primitives = std::move(primitives);
+
+    if (hadPrimitives && mesh.primitives.empty()) {
+      continue;
+    }
+
+    meshIndexMap[i] = static_cast<int32_t>(meshes.size());
+    meshes.emplace_back(std::move(mesh));
+  }
+  gltf.meshes = std::move(meshes);
+
+  for (Node& node : gltf.nodes) {
+    if (node.mesh >= 0 && size_t(node.mesh) < meshIndexMap.size()) {
+      node.mesh = meshIndexMap[size_t(node.mesh)];
+    }
+  }
+
+  GltfUtilities::removeUnusedAccessors(gltf);
+  GltfUtilities::removeUnusedBufferViews(gltf);
+  GltfUtilities::compactBuffers(gltf);
+}
+
+/*static*/ uint64_t
+GltfUtilities::computeImageContentHash(const ImageCesium& image) noexcept {
+  uint64_t seed = uint64_t(uint32_t(image.width));
+  seed = CesiumUtility::Hash::combine(seed, uint64_t(uint32_t(image.height)));
+  seed =
+      CesiumUtility::Hash::combine(seed, uint64_t(uint32_t(image.channels)));
+  seed = CesiumUtility::Hash::combine(
+      seed,
+      uint64_t(uint32_t(image.bytesPerChannel)));
+  seed = CesiumUtility::Hash::combine(
+      seed,
+      uint64_t(uint32_t(image.compressedPixelFormat)));
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    seed = CesiumUtility::Hash::combine(seed, uint64_t(mip.byteOffset));
+    seed = CesiumUtility::Hash::combine(seed, uint64_t(mip.byteSize));
+  }
+
+  return CesiumUtility::Hash::xxHash64(image.pixelData, seed);
+}
+
+namespace {
+bool haveSamePixels(const ImageCesium& a, const ImageCesium& b) noexcept {
+  if (a.width != b.width || a.height != b.height ||
+      a.channels != b.channels || a.bytesPerChannel != b.bytesPerChannel ||
+      a.compressedPixelFormat != b.compressedPixelFormat ||
+      a.mipPositions.size() != b.mipPositions.size() ||
+      a.pixelData != b.pixelData) {
+    return false;
+  }
+
+  for (size_t i = 0; i < a.mipPositions.size(); ++i) {
+    if (a.mipPositions[i].byteOffset != b.mipPositions[i].byteOffset ||
+        a.mipPositions[i].byteSize != b.mipPositions[i].byteSize) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Points every reference to a duplicate element at its original, which is
+// given by the map from the old index of each element.
+template <typename TVisitFunction>
+void replaceDuplicates(
+    Model& gltf,
+    const std::vector<int32_t>& originals,
+    TVisitFunction&& visitFunction) {
+  visitFunction(gltf, [&originals](int32_t& elementIndex) {
+    if (elementIndex >= 0 && size_t(elementIndex) < originals.size()) {
+      elementIndex = originals[size_t(elementIndex)];
+    }
+  });
+}
+
+uint64_t hashAccessorBytes(
+    const ConstAccessorBytes& bytes,
+    std::vector<std::byte>& scratch) {
+  const Accessor& accessor = *bytes.pAccessor;
+  uint64_t seed = uint64_t(uint32_t(accessor.componentType));
+  seed = CesiumUtility::Hash::combine(
+      seed,
+      std::hash<std::string>{}(accessor.type));
+  seed = CesiumUtility::Hash::combine(seed, uint64_t(accessor.count));
+  seed = CesiumUtility::Hash::combine(seed, uint64_t(accessor.normalized));
+
+  const size_t count = size_t(accessor.count);
+  if (bytes.stride == bytes.elementSize) {
+    return CesiumUtility::Hash::xxHash64(
+        gsl::span<const std::byte>(bytes.pData, count * bytes.elementSize),
+        seed);
+  }
+
+  // Gather the interleaved elements, so that they're hashed the same as if
+  // they were tightly packed.
+  scratch.resize(count * bytes.elementSize);
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(
+        scratch.data() + i * bytes.elementSize,
+        bytes.pData + i * bytes.stride,
+        bytes.elementSize);
+  }
+  return CesiumUtility::Hash::xxHash64(scratch, seed);
+}
+
+bool haveSameElements(
+    const ConstAccessorBytes& a,
+    const ConstAccessorBytes& b) noexcept {
+  const Accessor& accessorA = *a.pAccessor;
+  const Accessor& accessorB = *b.pAccessor;
+  if (accessorA.componentType != accessorB.componentType ||
+      accessorA.type != accessorB.type || accessorA.count != accessorB.count ||
+      accessorA.normalized != accessorB.normalized ||
+      a.elementSize != b.elementSize) {
+    return false;
+  }
+
+  for (size_t i = 0; i < size_t(accessorA.count); ++i) {
+    if (std::memcmp(
+            a.pData + i * a.stride,
+            b.pData + i * b.stride,
+            a.elementSize) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+/*static*/ void GltfUtilities::mergeDuplicateImages(CesiumGltf::Model& gltf) {
+  std::vector<int32_t> originals(gltf.images.size());
+  std::unordered_map<uint64_t, std::vector<int32_t>> imagesByHash;
+  bool foundDuplicate = false;
+
+  for (size_t i = 0; i < gltf.images.size(); ++i) {
+    originals[i] = int32_t(i);
+
+    const ImageCesium& image = gltf.images[i].cesium;
+    if (image.pixelData.empty()) {
+      continue;
+    }
+
+    std::vector<int32_t>& candidates =
+        imagesByHash[computeImageContentHash(image)];
+    auto it = std::find_if(
+        candidates.begin(),
+        candidates.end(),
+        [&gltf, &image](int32_t candidate) {
+          return haveSamePixels(gltf.images[size_t(candidate)].cesium, image);
+        });
+    if (it != candidates.end()) {
+      originals[i] = *it;
+      foundDuplicate = true;
+    } else {
+      candidates.push_back(int32_t(i));
+    }
+  }
+
+  if (!foundDuplicate) {
+    return;
+  }
+
+  replaceDuplicates(gltf, originals, VisitImageIds());
+  GltfUtilities::removeUnusedImages(gltf);
+  GltfUtilities::removeUnusedBufferViews(gltf);
+  GltfUtilities::compactBuffers(gltf);
+}
+
+/*static*/ void
+GltfUtilities::mergeDuplicateAccessors(CesiumGltf::Model& gltf) {
+  std::vector<int32_t> originals(gltf.accessors.size());
+  std::unordered_map<uint64_t, std::vector<int32_t>> accessorsByHash;
+  std::vector<std::byte> scratch;
+  bool foundDuplicate = false;
+
+  for (size_t i = 0; i < gltf.accessors.size(); ++i) {
+    originals[i] = int32_t(i);
+
+    const std::optional<ConstAccessorBytes> maybeBytes =
+        getAccessorBytes(std::as_const(gltf), int32_t(i));
+    if (!maybeBytes) {
+      continue;
+    }
+
+    std::vector<int32_t>& candidates =
+        accessorsByHash[hashAccessorBytes(*maybeBytes, scratch)];
+    auto it = std::find_if(
+        candidates.begin(),
+        candidates.end(),
+        [&gltf, &maybeBytes](int32_t candidate) {
+          const std::optional<ConstAccessorBytes> candidateBytes =
+              getAccessorBytes(std::as_const(gltf), candidate);
+          return candidateBytes &&
+                 haveSameElements(*candidateBytes, *maybeBytes);
+        });
+    if (it != candidates.end()) {
+      originals[i] = *it;
+      foundDuplicate = true;
+    } else {
+      candidates.push_back(int32_t(i));
+    }
+  }
+
+  if (!foundDuplicate) {
+    return;
+  }
+
+  replaceDuplicates(gltf, originals, VisitAccessorIds());
+  GltfUtilities::removeUnusedAccessors(gltf);
+  GltfUtilities::removeUnusedBufferViews(gltf);
+  GltfUtilities::compactBuffers(gltf);
+}
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) noexcept {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// GPUs read vertex attributes from offsets that are multiples of four bytes.
+constexpr size_t vertexAttributeAlignment = 4;
+
+// Writes the indices of the primitive to newly-allocated memory. Returns false,
+// with no memory allocated, if the indices can't be read or the memory can't
+// be allocated.
+bool writeIndexStream(
+    const Model& gltf,
+    const MeshPrimitive& primitive,
+    IStagingBufferAllocator& allocator,
+    size_t alignment,
+    PrimitiveVertexStreams& streams) {
+  const std::optional<ConstAccessorBytes> maybeIndices =
+      getAccessorBytes(gltf, primitive.indices);
+  if (!maybeIndices ||
+      maybeIndices->pAccessor->type != Accessor::Type::SCALAR) {
+    return false;
+  }
+
+  const ConstAccessorBytes& indices = *maybeIndices;
+  const int32_t componentType = indices.pAccessor->componentType;
+  if (componentType == Accessor::ComponentType::UNSIGNED_BYTE ||
+      componentType == Accessor::ComponentType::UNSIGNED_SHORT) {
+    streams.indexByteSize = sizeof(uint16_t);
+  } else if (componentType == Accessor::ComponentType::UNSIGNED_INT) {
+    streams.indexByteSize = sizeof(uint32_t);
+  } else {
+    return false;
+  }
+
+  streams.indexCount = size_t(indices.pAccessor->count);
+  const size_t byteSize = streams.indexCount * streams.indexByteSize;
+  streams.indices = allocator.allocate(byteSize, alignment);
+  if (streams.indices.data.size() < byteSize) {
+    allocator.free(streams.indices);
+    return false;
+  }
+
+  std::byte* pOutput = streams.indices.data.data();
+  if (indices.elementSize == streams.indexByteSize &&
+      indices.stride == indices.elementSize) {
+    std::memcpy(pOutput, indices.pData, byteSize);
+  } else if (componentType == Accessor::ComponentType::UNSIGNED_BYTE) {
+    for (size_t i = 0; i < streams.indexCount; ++i) {
+      const uint16_t index = uint16_t(indices.pData[i * indices.stride]);
+      std::memcpy(pOutput + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+    }
+  } else {
+    for (size_t i = 0; i < streams.indexCount; ++i) {
+      std::memcpy(
+          pOutput + i * streams.indexByteSize,
+          indices.pData + i * indices.stride,
+          streams.indexByteSize);
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+std::vector<PrimitiveVertexStreams> GltfUtilities::writeVertexStreams(
+    const CesiumGltf::Model& gltf,
+    IStagingBufferAllocator& allocator,
+    size_t alignment) {
+  std::vector<PrimitiveVertexStreams> result;
+  std::vector<ConstAccessorBytes> sources;
+
+  for (size_t i = 0; i < gltf.meshes.size(); ++i) {
+    const Mesh& mesh = gltf.meshes[i];
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      const MeshPrimitive& primitive = mesh.primitives[j];
+
+      auto positionIt = primitive.attributes.find("POSITION");
+      if (positionIt == primitive.attributes.end()) {
+        continue;
+      }
+
+      const std::optional<ConstAccessorBytes> maybePositions =
+          getAccessorBytes(gltf, positionIt->second);
+      if (!maybePositions) {
+        continue;
+      }
+
+      PrimitiveVertexStreams streams;
+      streams.meshIndex = int32_t(i);
+      streams.primitiveIndex = int32_t(j);
+      streams.vertexCount = size_t(maybePositions->pAccessor->count);
+
+      // Lay out the attributes that can be read, one after another.
+      sources.clear();
+      size_t vertexByteSize = 0;
+      size_t attributesByteSize = 0;
+      for (const auto& [name, accessorIndex] : primitive.attributes) {
+        const std::optional<ConstAccessorBytes> maybeBytes =
+            getAccessorBytes(gltf, accessorIndex);
+        if (!maybeBytes ||
+            size_t(maybeBytes->pAccessor->count) != streams.vertexCount) {
+          continue;
+        }
+
+        const size_t byteOffset =
+            alignUp(vertexByteSize, vertexAttributeAlignment);
+        streams.attributes.emplace_back(VertexStreamAttribute{
+            name,
+            accessorIndex,
+            byteOffset,
+            maybeBytes->elementSize});
+        sources.emplace_back(*maybeBytes);
+        vertexByteSize = byteOffset + maybeBytes->elementSize;
+        attributesByteSize += maybeBytes->elementSize;
+      }
+      streams.vertexByteStride =
+          alignUp(vertexByteSize, vertexAttributeAlignment);
+
+      const size_t verticesByteSize =
+          streams.vertexCount * streams.vertexByteStride;
+      streams.vertices = allocator.allocate(verticesByteSize, alignment);
+      if (streams.vertices.data.size() < verticesByteSize) {
+        allocator.free(streams.vertices);
+        continue;
+      }
+
+      // Write each vertex in turn, so the memory is written in order, which is
+      // fastest for write-combined memory. Any padding is zeroed first.
+      std::byte* pVertices = streams.vertices.data.data();
+      if (attributesByteSize != streams.vertexByteStride) {
+        std::memset(pVertices, 0, verticesByteSize);
+      }
+      for (size_t vertex = 0; vertex < streams.vertexCount; ++vertex) {
+        std::byte* pVertex = pVertices + vertex * streams.vertexByteStride;
+        for (size_t k = 0; k < sources.size(); ++k) {
+          std::memcpy(
+              pVertex + streams.attributes[k].byteOffset,
+              sources[k].pData + vertex * sources[k].stride,
+              sources[k].elementSize);
+        }
+      }
+
+      if (primitive.indices >= 0 &&
+          !writeIndexStream(gltf, primitive, allocator, alignment, streams)) {
+        allocator.free(streams.vertices);
+        continue;
+      }
+
+      result.emplace_back(std::move(streams));
+    }
+  }
+
+  return result;
 }
 
 } // namespace CesiumGltfContent
@@ -3,13 +3,100 @@
 
 #include <stb_image_resize.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#define ZLIB_CONST
+#include <zlib.h>
 
 namespace CesiumGltfContent {
 
+namespace {
+// The two source pixels to interpolate between for a target pixel along one
+// axis, and the weight of the second one out of 256.
+struct BilinearTap {
+  size_t first;
+  size_t second;
+  uint32_t weight;
+};
+
+// Computes the taps of the target pixels along one axis, so that the centers
+// of the first and last target pixels map to the centers of the first and last
+// source pixels or beyond them, where they are clamped to the edge.
+void computeBilinearTaps(
+    size_t sourceSize,
+    size_t targetSize,
+    std::vector<BilinearTap>& taps) {
+  taps.resize(targetSize);
+  for (size_t i = 0; i < targetSize; ++i) {
+    // The source position of the center of the target pixel, in 16.16 fixed
+    // point.
+    const int64_t position =
+        int64_t((2 * i + 1) * sourceSize * 65536 / (2 * targetSize)) - 32768;
+    BilinearTap& tap = taps[i];
+    if (position <= 0) {
+      tap = BilinearTap{0, 0, 0};
+    } else if (size_t(position >> 16) >= sourceSize - 1) {
+      tap = BilinearTap{sourceSize - 1, sourceSize - 1, 0};
+    } else {
+      const size_t first = size_t(position >> 16);
+      tap = BilinearTap{first, first + 1, uint32_t(position >> 8) & 0xFF};
+    }
+  }
+}
+
+// Scales up a source image with one byte per channel into a target with
+// bilinear filtering, which is much faster than stbir's general-purpose
+// filters. The inner loop over the channels of a row has no branches or
+// floating point so that the compiler can vectorize it.
+void bilinearBlitImage(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight,
+    size_t channels) {
+  std::vector<BilinearTap> columns;
+  computeBilinearTaps(sourceWidth, targetWidth, columns);
+  std::vector<BilinearTap> rows;
+  computeBilinearTaps(sourceHeight, targetHeight, rows);
+
+  const uint8_t* pSourcePixels = reinterpret_cast<const uint8_t*>(pSource);
+  for (size_t j = 0; j < targetHeight; ++j) {
+    const BilinearTap& row = rows[j];
+    const uint8_t* pTop = pSourcePixels + row.first * sourceRowStride;
+    const uint8_t* pBottom = pSourcePixels + row.second * sourceRowStride;
+    uint8_t* pTargetRow =
+        reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+
+    for (size_t i = 0; i < targetWidth; ++i) {
+      const BilinearTap& column = columns[i];
+      const size_t left = column.first * channels;
+      const size_t right = column.second * channels;
+      for (size_t c = 0; c < channels; ++c) {
+        const uint32_t top = pTop[left + c] * (256 - column.weight) +
+                             pTop[right + c] * column.weight;
+        const uint32_t bottom = pBottom[left + c] * (256 - column.weight) +
+                                pBottom[right + c] * column.weight;
+        pTargetRow[i * channels + c] = uint8_t(
+            (top * (256 - row.weight) + bottom * row.weight + 32768) >> 16);
+      }
+    }
+  }
+}
+} // namespace
+
 void ImageManipulation::unsafeBlitImage(
     std::byte* pTarget,
     size_t targetRowStride,
@@ -99,6 +186,23 @@ bool ImageManipulation::blitImage(
       return false;
     }
 
+    if (targetPixels.width >= sourcePixels.width &&
+        targetPixels.height >= sourcePixels.height) {
+      // Scaling up, such as the part of an ancestor tile's image that covers
+      // a finer target image, only needs to interpolate between pixels.
+      bilinearBlitImage(
+          pTarget,
+          bytesPerTargetRow,
+          size_t(targetPixels.width),
+          size_t(targetPixels.height),
+          pSource,
+          bytesPerSourceRow,
+          size_t(sourcePixels.width),
+          size_t(sourcePixels.height),
+          size_t(target.channels));
+      return true;
+    }
+
     // Use STB to do the copy / scale
     stbir_resize_uint8(
         reinterpret_cast<const unsigned char*>(pSource),
@@ -115,6 +219,239 @@ bool ImageManipulation::blitImage(
   return true;
 }
 
+namespace {
+using PixelBlock = std::array<std::array<uint8_t, 4>, 16>;
+
+// Reads the 4x4 block of RGBA pixels whose top-left pixel is at (x, y),
+// repeating the last column and row of the image where the block extends past
+// its edge.
+void readPixelBlock(
+    const uint8_t* pPixels,
+    size_t width,
+    size_t height,
+    size_t x,
+    size_t y,
+    PixelBlock& block) {
+  for (size_t j = 0; j < 4; ++j) {
+    const size_t row = std::min(y + j, height - 1);
+    for (size_t i = 0; i < 4; ++i) {
+      const size_t column = std::min(x + i, width - 1);
+      std::memcpy(
+          block[j * 4 + i].data(),
+          pPixels + (row * width + column) * 4,
+          4);
+    }
+  }
+}
+
+uint16_t toRgb565(const std::array<uint8_t, 4>& color) {
+  const uint32_t r = (uint32_t(color[0]) * 31 + 127) / 255;
+  const uint32_t g = (uint32_t(color[1]) * 63 + 127) / 255;
+  const uint32_t b = (uint32_t(color[2]) * 31 + 127) / 255;
+  return uint16_t((r << 11) | (g << 5) | b);
+}
+
+std::array<int32_t, 3> fromRgb565(uint16_t color) {
+  const int32_t r = (color >> 11) & 31;
+  const int32_t g = (color >> 5) & 63;
+  const int32_t b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+void writeLittleEndian(std::byte* pOutput, uint64_t value) {
+  for (size_t i = 0; i < 8; ++i) {
+    pOutput[i] = std::byte((value >> (8 * i)) & 0xFF);
+  }
+}
+
+// Encodes the colors of a block as a BC1 block in its four-color mode. The
+// endpoints are the colors of the block that are farthest apart along the
+// principal axis of its colors, which is found with a few steps of power
+// iteration on their covariance.
+void encodeBc1Block(const PixelBlock& block, std::byte* pOutput) {
+  std::array<double, 3> mean{0.0, 0.0, 0.0};
+  for (const std::array<uint8_t, 4>& pixel : block) {
+    for (size_t c = 0; c < 3; ++c) {
+      mean[c] += pixel[c] / 16.0;
+    }
+  }
+
+  std::array<std::array<double, 3>, 3> covariance{};
+  for (const std::array<uint8_t, 4>& pixel : block) {
+    const std::array<double, 3> offset{
+        pixel[0] - mean[0],
+        pixel[1] - mean[1],
+        pixel[2] - mean[2]};
+    for (size_t row = 0; row < 3; ++row) {
+      for (size_t column = 0; column < 3; ++column) {
+        covariance[row][column] += offset[row] * offset[column];
+      }
+    }
+  }
+
+  // Start from the column of the channel that varies the most, which is only
+  // zero when all of the colors are the same.
+  size_t widest = 0;
+  for (size_t c = 1; c < 3; ++c) {
+    if (covariance[c][c] > covariance[widest][widest]) {
+      widest = c;
+    }
+  }
+  std::array<double, 3> axis = covariance[widest];
+  for (int32_t iteration = 0; iteration < 4; ++iteration) {
+    std::array<double, 3> next{0.0, 0.0, 0.0};
+    for (size_t row = 0; row < 3; ++row) {
+      for (size_t column = 0; column < 3; ++column) {
+        next[row] += covariance[row][column] * axis[column];
+      }
+    }
+    const double length = std::max(
+        {std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+    if (length == 0.0) {
+      break;
+    }
+    for (size_t c = 0; c < 3; ++c) {
+      axis[c] = next[c] / length;
+    }
+  }
+
+  size_t minimum = 0;
+  size_t maximum = 0;
+  double minimumProjection = 0.0;
+  double maximumProjection = 0.0;
+  for (size_t p = 0; p < block.size(); ++p) {
+    const double projection = block[p][0] * axis[0] + block[p][1] * axis[1] +
+                              block[p][2] * axis[2];
+    if (p == 0 || projection < minimumProjection) {
+      minimum = p;
+      minimumProjection = projection;
+    }
+    if (p == 0 || projection > maximumProjection) {
+      maximum = p;
+      maximumProjection = projection;
+    }
+  }
+
+  // The first endpoint must be greater than the second for the four-color
+  // mode. When they're equal, every index is zero, which is the first endpoint
+  // in either mode.
+  uint16_t color0 = toRgb565(block[maximum]);
+  uint16_t color1 = toRgb565(block[minimum]);
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  uint32_t indices = 0;
+  if (color0 != color1) {
+    std::array<std::array<int32_t, 3>, 4> palette{};
+    palette[0] = fromRgb565(color0);
+    palette[1] = fromRgb565(color1);
+    for (size_t c = 0; c < 3; ++c) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (size_t p = 0; p < block.size(); ++p) {
+      uint32_t best = 0;
+      int32_t bestDistance = INT32_MAX;
+      for (uint32_t i = 0; i < 4; ++i) {
+        int32_t distance = 0;
+        for (size_t c = 0; c < 3; ++c) {
+          const int32_t difference = int32_t(block[p][c]) - palette[i][c];
+          distance += difference * difference;
+        }
+        if (distance < bestDistance) {
+          best = i;
+          bestDistance = distance;
+        }
+      }
+      indices |= best << (2 * p);
+    }
+  }
+
+  writeLittleEndian(
+      pOutput,
+      uint64_t(color0) | (uint64_t(color1) << 16) | (uint64_t(indices) << 32));
+}
+
+// Encodes the alpha of a block as a BC3 alpha block in its eight-value mode,
+// with the minimum and maximum alpha of the block as its endpoints.
+void encodeBc3AlphaBlock(const PixelBlock& block, std::byte* pOutput) {
+  uint32_t minimum = 255;
+  uint32_t maximum = 0;
+  for (const std::array<uint8_t, 4>& pixel : block) {
+    minimum = std::min(minimum, uint32_t(pixel[3]));
+    maximum = std::max(maximum, uint32_t(pixel[3]));
+  }
+
+  // When the endpoints are equal, every index is zero, which is the first
+  // endpoint.
+  uint64_t bits = uint64_t(maximum) | (uint64_t(minimum) << 8);
+  if (maximum > minimum) {
+    const uint32_t range = maximum - minimum;
+    for (size_t p = 0; p < block.size(); ++p) {
+      // The nearest of the eight values, in steps of 1/7 from the maximum to
+      // the minimum. The endpoints have indices 0 and 1, and the values
+      // between them have the indices 2 to 7.
+      const uint32_t step =
+          ((maximum - uint32_t(block[p][3])) * 7 + range / 2) / range;
+      const uint32_t index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+      bits |= uint64_t(index) << (16 + 3 * p);
+    }
+  }
+
+  writeLittleEndian(pOutput, bits);
+}
+} // namespace
+
+bool ImageManipulation::compressImage(
+    CesiumGltf::ImageCesium& image,
+    CesiumGltf::GpuCompressedPixelFormat format) {
+  if (format != CesiumGltf::GpuCompressedPixelFormat::BC1_RGB &&
+      format != CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA) {
+    return false;
+  }
+
+  if (image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      image.channels != 4 || image.bytesPerChannel != 1 || image.width <= 0 ||
+      image.height <= 0 || !image.mipPositions.empty()) {
+    return false;
+  }
+
+  const size_t width = size_t(image.width);
+  const size_t height = size_t(image.height);
+  if (image.pixelData.size() < width * height * 4) {
+    return false;
+  }
+
+  const bool hasAlpha =
+      format == CesiumGltf::GpuCompressedPixelFormat::BC3_RGBA;
+  const size_t bytesPerBlock = hasAlpha ? 16 : 8;
+  std::vector<std::byte> blocks(
+      ((width + 3) / 4) * ((height + 3) / 4) * bytesPerBlock);
+
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(image.pixelData.data());
+  std::byte* pOutput = blocks.data();
+  PixelBlock block;
+  for (size_t y = 0; y < height; y += 4) {
+    for (size_t x = 0; x < width; x += 4) {
+      readPixelBlock(pPixels, width, height, x, y, block);
+      if (hasAlpha) {
+        encodeBc3AlphaBlock(block, pOutput);
+        pOutput += 8;
+      }
+      encodeBc1Block(block, pOutput);
+      pOutput += 8;
+    }
+  }
+
+  image.pixelData = std::move(blocks);
+  image.compressedPixelFormat = format;
+  return true;
+}
+
 namespace {
 void writePngToVector(void* context, void* data, int size) {
   std::vector<std::byte>* pVector =
@@ -123,11 +460,216 @@ void writePngToVector(void* context, void* data, int size) {
   pVector->resize(previousSize + size_t(size));
   std::memcpy(pVector->data() + previousSize, data, size_t(size));
 }
+
+bool canWriteFastPng(const CesiumGltf::ImageCesium& image) {
+  if (image.bytesPerChannel != 1 || image.channels < 1 || image.channels > 4 ||
+      image.width <= 0 || image.height <= 0) {
+    return false;
+  }
+
+  const size_t pixelCount = size_t(image.width) * size_t(image.height);
+  return image.pixelData.size() >= pixelCount * size_t(image.channels);
+}
+
+void writeUint32BigEndian(std::vector<std::byte>& output, uint32_t value) {
+  output.emplace_back(std::byte(value >> 24));
+  output.emplace_back(std::byte(value >> 16));
+  output.emplace_back(std::byte(value >> 8));
+  output.emplace_back(std::byte(value));
+}
+
+// Writes the length placeholder and type of a chunk, and returns the offset of
+// the type, from which the chunk's CRC is computed.
+size_t beginPngChunk(std::vector<std::byte>& output, const char* type) {
+  writeUint32BigEndian(output, 0);
+  const size_t typeOffset = output.size();
+  for (size_t i = 0; i < 4; ++i) {
+    output.emplace_back(std::byte(type[i]));
+  }
+  return typeOffset;
+}
+
+// Fills in the length of the chunk that begins at typeOffset, now that its data
+// has been written, and appends its CRC.
+void endPngChunk(std::vector<std::byte>& output, size_t typeOffset) {
+  const uint32_t length = uint32_t(output.size() - typeOffset - 4);
+  for (size_t i = 0; i < 4; ++i) {
+    output[typeOffset - 4 + i] = std::byte(length >> (24 - 8 * i));
+  }
+
+  const uLong crc = crc32(
+      crc32(0L, Z_NULL, 0),
+      reinterpret_cast<const Bytef*>(output.data() + typeOffset),
+      uInt(output.size() - typeOffset));
+  writeUint32BigEndian(output, uint32_t(crc));
+}
+
+void writePngHeader(
+    std::vector<std::byte>& output,
+    const CesiumGltf::ImageCesium& image) {
+  constexpr std::array<uint8_t, 8> signature{137, 80, 78, 71, 13, 10, 26, 10};
+  for (uint8_t byte : signature) {
+    output.emplace_back(std::byte(byte));
+  }
+
+  // Grayscale, grayscale and alpha, RGB, and RGBA, by number of channels.
+  constexpr std::array<uint8_t, 4> colorTypes{0, 4, 2, 6};
+
+  const size_t typeOffset = beginPngChunk(output, "IHDR");
+  writeUint32BigEndian(output, uint32_t(image.width));
+  writeUint32BigEndian(output, uint32_t(image.height));
+  output.emplace_back(std::byte(8));
+  output.emplace_back(std::byte(colorTypes[size_t(image.channels - 1)]));
+  // Deflate compression, adaptive filtering, and no interlacing.
+  output.emplace_back(std::byte(0));
+  output.emplace_back(std::byte(0));
+  output.emplace_back(std::byte(0));
+  endPngChunk(output, typeOffset);
+}
+
+void writePngEnd(std::vector<std::byte>& output) {
+  endPngChunk(output, beginPngChunk(output, "IEND"));
+}
+
+// Filters the rows [firstRow, endRow) of an image with the Up filter and
+// compresses them to the end of output. The rows are filtered in batches, so
+// that the filtered rows stay in the cache until they are compressed. The
+// stream is finished with the given flush mode. If pAdler is not nullptr, it
+// is set to the Adler-32 checksum of the filtered rows.
+bool deflatePngRows(
+    z_stream& stream,
+    const CesiumGltf::ImageCesium& image,
+    size_t firstRow,
+    size_t endRow,
+    int flush,
+    std::vector<std::byte>& output,
+    uLong* pAdler = nullptr) {
+  const size_t rowSize = size_t(image.width) * size_t(image.channels);
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(image.pixelData.data());
+
+  const size_t rowsPerBatch = std::max(size_t(1), 65536 / (rowSize + 1));
+  std::vector<uint8_t> filtered(rowsPerBatch * (rowSize + 1));
+
+  uLong adler = adler32(0L, Z_NULL, 0);
+  size_t written = output.size();
+
+  for (size_t batchBegin = firstRow; batchBegin < endRow;
+       batchBegin += rowsPerBatch) {
+    const size_t batchEnd = std::min(endRow, batchBegin + rowsPerBatch);
+
+    uint8_t* pFiltered = filtered.data();
+    for (size_t row = batchBegin; row < batchEnd; ++row) {
+      const uint8_t* pRow = pPixels + row * rowSize;
+
+      // The Up filter, which is the same as no filter for the first row.
+      *pFiltered++ = 2;
+      if (row == 0) {
+        std::memcpy(pFiltered, pRow, rowSize);
+      } else {
+        // A plain loop without dependencies between bytes, which compilers
+        // vectorize.
+        const uint8_t* pAbove = pRow - rowSize;
+        for (size_t i = 0; i < rowSize; ++i) {
+          pFiltered[i] = uint8_t(pRow[i] - pAbove[i]);
+        }
+      }
+      pFiltered += rowSize;
+    }
+
+    const uInt filteredSize = uInt(pFiltered - filtered.data());
+    if (pAdler) {
+      adler = adler32(adler, filtered.data(), filteredSize);
+    }
+
+    stream.next_in = filtered.data();
+    stream.avail_in = filteredSize;
+
+    const int batchFlush = batchEnd == endRow ? flush : Z_NO_FLUSH;
+    for (;;) {
+      if (written == output.size()) {
+        output.resize(
+            output.size() + std::max(size_t(65536), size_t(filteredSize)));
+      }
+
+      stream.next_out = reinterpret_cast<Bytef*>(output.data() + written);
+      stream.avail_out = uInt(output.size() - written);
+      const int result = deflate(&stream, batchFlush);
+      written = output.size() - stream.avail_out;
+
+      if (result == Z_STREAM_ERROR) {
+        return false;
+      }
+
+      // Unless the stream is being finished, a call that leaves room in the
+      // output has consumed all of the input.
+      if (batchFlush == Z_FINISH ? result == Z_STREAM_END
+                                 : stream.avail_out != 0) {
+        break;
+      }
+    }
+  }
+
+  output.resize(written);
+  if (pAdler) {
+    *pAdler = adler;
+  }
+  return true;
+}
+
+void saveFastPng(
+    const CesiumGltf::ImageCesium& image,
+    std::vector<std::byte>& output) {
+  if (!canWriteFastPng(image)) {
+    return;
+  }
+
+  const size_t start = output.size();
+  writePngHeader(output, image);
+
+  const size_t typeOffset = beginPngChunk(output, "IDAT");
+
+  z_stream stream{};
+  if (deflateInit(&stream, Z_BEST_SPEED) != Z_OK) {
+    output.resize(start);
+    return;
+  }
+
+  const bool succeeded = deflatePngRows(
+      stream,
+      image,
+      0,
+      size_t(image.height),
+      Z_FINISH,
+      output);
+  deflateEnd(&stream);
+
+  if (!succeeded) {
+    output.resize(start);
+    return;
+  }
+
+  endPngChunk(output, typeOffset);
+  writePngEnd(output);
+}
+
+struct PngStripe {
+  std::vector<std::byte> data;
+  uLong adler = 1;
+  size_t filteredSize = 0;
+  bool succeeded = false;
+};
 } // namespace
 
 /*static*/ void ImageManipulation::savePng(
     const CesiumGltf::ImageCesium& image,
-    std::vector<std::byte>& output) {
+    std::vector<std::byte>& output,
+    PngEncoding encoding) {
+  if (encoding == PngEncoding::Fast) {
+    saveFastPng(image, output);
+    return;
+  }
+
   if (image.bytesPerChannel != 1) {
     // Only 8-bit images can be written.
     return;
@@ -143,11 +685,115 @@ void writePngToVector(void* context, void* data, int size) {
       0);
 }
 
-/*static*/ std::vector<std::byte>
-ImageManipulation::savePng(const CesiumGltf::ImageCesium& image) {
+/*static*/ std::vector<std::byte> ImageManipulation::savePng(
+    const CesiumGltf::ImageCesium& image,
+    PngEncoding encoding) {
   std::vector<std::byte> result;
-  savePng(image, result);
+  savePng(image, result, encoding);
   return result;
 }
 
+/*static*/ CesiumAsync::Future<std::vector<std::byte>>
+ImageManipulation::savePngInParallel(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    CesiumGltf::ImageCesium image) {
+  if (!canWriteFastPng(image)) {
+    return asyncSystem.createResolvedFuture(std::vector<std::byte>());
+  }
+
+  const size_t height = size_t(image.height);
+  const size_t rowSize = size_t(image.width) * size_t(image.channels);
+
+  // Each stripe starts with an empty compression history, so stripes must be
+  // large for that to cost little.
+  constexpr size_t minimumStripeSize = 256 * 1024;
+  const size_t stripeCount = std::min(
+      {height,
+       std::max(size_t(1), rowSize * height / minimumStripeSize),
+       size_t(std::max(1U, std::thread::hardware_concurrency()))});
+
+  auto pImage =
+      std::make_shared<const CesiumGltf::ImageCesium>(std::move(image));
+
+  if (stripeCount == 1) {
+    return asyncSystem.runInWorkerThread([pImage]() {
+      std::vector<std::byte> result;
+      saveFastPng(*pImage, result);
+      return result;
+    });
+  }
+
+  // Each stripe is a raw deflate stream that ends on a byte boundary without
+  // being finished, except for the last, so that the stripes joined together
+  // are a single deflate stream.
+  std::vector<CesiumAsync::Future<PngStripe>> futures;
+  futures.reserve(stripeCount);
+  for (size_t stripe = 0; stripe < stripeCount; ++stripe) {
+    const size_t firstRow = height * stripe / stripeCount;
+    const size_t endRow = height * (stripe + 1) / stripeCount;
+    const int flush = stripe + 1 == stripeCount ? Z_FINISH : Z_SYNC_FLUSH;
+    futures.emplace_back(asyncSystem.runInWorkerThread(
+        [pImage, rowSize, firstRow, endRow, flush]() {
+          PngStripe result;
+          // Each row is preceded by its filter type.
+          result.filteredSize = (endRow - firstRow) * (rowSize + 1);
+
+          z_stream stream{};
+          if (deflateInit2(
+                  &stream,
+                  Z_BEST_SPEED,
+                  Z_DEFLATED,
+                  -15,
+                  8,
+                  Z_DEFAULT_STRATEGY) != Z_OK) {
+            return result;
+          }
+
+          result.succeeded = deflatePngRows(
+              stream,
+              *pImage,
+              firstRow,
+              endRow,
+              flush,
+              result.data,
+              &result.adler);
+          deflateEnd(&stream);
+          return result;
+        }));
+  }
+
+  return asyncSystem.all(std::move(futures))
+      .thenImmediately([pImage](std::vector<PngStripe>&& stripes) {
+        std::vector<std::byte> output;
+        for (const PngStripe& stripe : stripes) {
+          if (!stripe.succeeded) {
+            return output;
+          }
+        }
+
+        writePngHeader(output, *pImage);
+
+        const size_t typeOffset = beginPngChunk(output, "IDAT");
+
+        // The zlib header for a deflate stream with a 32 KiB window that was
+        // compressed at the fastest level.
+        output.emplace_back(std::byte(0x78));
+        output.emplace_back(std::byte(0x01));
+
+        uLong adler = adler32(0L, Z_NULL, 0);
+        for (const PngStripe& stripe : stripes) {
+          output.insert(output.end(), stripe.data.begin(), stripe.data.end());
+          adler = adler32_combine(
+              adler,
+              stripe.adler,
+              z_off_t(stripe.filteredSize));
+        }
+        writeUint32BigEndian(output, uint32_t(adler));
+
+        endPngChunk(output, typeOffset);
+        writePngEnd(output);
+        return output;
+      });
+}
+
 } // namespace CesiumGltfContent
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <stdexcept>
+#include <utility>
 
 using namespace CesiumUtility;
 
@@ -88,28 +89,74 @@ SkirtMeshMetadata::parseFromGltfExtras(const JsonValue::Object& extras) {
   skirtMeshMetadata.skirtEastHeight = eastHeight;
   skirtMeshMetadata.skirtNorthHeight = northHeight;
 
+  const JsonValue* pEdgeIndices =
+      gltfSkirtMeshMetadata.getValuePtrForKey("skirtEdgeIndices");
+  if (pEdgeIndices) {
+    const auto* pCounts =
+        pEdgeIndices->getValuePtrForKey<JsonValue::Array>("counts");
+    if (!pCounts || pCounts->size() != 4) {
+      return std::nullopt;
+    }
+
+    uint32_t counts[4];
+    for (size_t i = 0; i < 4; ++i) {
+      const double count = (*pCounts)[i].getSafeNumberOrDefault<double>(-1.0);
+      if (count < 0.0) {
+        return std::nullopt;
+      }
+      counts[i] = static_cast<uint32_t>(count);
+    }
+
+    const double accessor =
+        pEdgeIndices->getSafeNumericalValueOrDefaultForKey<double>(
+            "accessor",
+            -1.0);
+    if (accessor < 0.0) {
+      return std::nullopt;
+    }
+
+    skirtMeshMetadata.skirtEdgeIndicesAccessor = static_cast<int32_t>(accessor);
+    skirtMeshMetadata.skirtWestEdgeCount = counts[0];
+    skirtMeshMetadata.skirtSouthEdgeCount = counts[1];
+    skirtMeshMetadata.skirtEastEdgeCount = counts[2];
+    skirtMeshMetadata.skirtNorthEdgeCount = counts[3];
+  }
+
   return skirtMeshMetadata;
 }
 
 JsonValue::Object SkirtMeshMetadata::createGltfExtras(
     const SkirtMeshMetadata& skirtMeshMetadata) {
-  return {
-      {"skirtMeshMetadata",
-       JsonValue::Object{
-           {"noSkirtRange",
-            JsonValue::Array{
-                skirtMeshMetadata.noSkirtIndicesBegin,
-                skirtMeshMetadata.noSkirtIndicesCount,
-                skirtMeshMetadata.noSkirtVerticesBegin,
-                skirtMeshMetadata.noSkirtVerticesCount}},
-           {"meshCenter",
-            JsonValue::Array{
-                skirtMeshMetadata.meshCenter.x,
-                skirtMeshMetadata.meshCenter.y,
-                skirtMeshMetadata.meshCenter.z}},
-           {"skirtWestHeight", skirtMeshMetadata.skirtWestHeight},
-           {"skirtSouthHeight", skirtMeshMetadata.skirtSouthHeight},
-           {"skirtEastHeight", skirtMeshMetadata.skirtEastHeight},
-           {"skirtNorthHeight", skirtMeshMetadata.skirtNorthHeight}}}};
+  JsonValue::Object gltfSkirtMeshMetadata{
+      {"noSkirtRange",
+       JsonValue::Array{
+           skirtMeshMetadata.noSkirtIndicesBegin,
+           skirtMeshMetadata.noSkirtIndicesCount,
+           skirtMeshMetadata.noSkirtVerticesBegin,
+           skirtMeshMetadata.noSkirtVerticesCount}},
+      {"meshCenter",
+       JsonValue::Array{
+           skirtMeshMetadata.meshCenter.x,
+           skirtMeshMetadata.meshCenter.y,
+           skirtMeshMetadata.meshCenter.z}},
+      {"skirtWestHeight", skirtMeshMetadata.skirtWestHeight},
+      {"skirtSouthHeight", skirtMeshMetadata.skirtSouthHeight},
+      {"skirtEastHeight", skirtMeshMetadata.skirtEastHeight},
+      {"skirtNorthHeight", skirtMeshMetadata.skirtNorthHeight}};
+
+  if (skirtMeshMetadata.skirtEdgeIndicesAccessor >= 0) {
+    gltfSkirtMeshMetadata.emplace(
+        "skirtEdgeIndices",
+        JsonValue::Object{
+            {"accessor", skirtMeshMetadata.skirtEdgeIndicesAccessor},
+            {"counts",
+             JsonValue::Array{
+                 skirtMeshMetadata.skirtWestEdgeCount,
+                 skirtMeshMetadata.skirtSouthEdgeCount,
+                 skirtMeshMetadata.skirtEastEdgeCount,
+                 skirtMeshMetadata.skirtNorthEdgeCount}}});
+  }
+
+  return {{"skirtMeshMetadata", std::move(gltfSkirtMeshMetadata)}};
 }
 } // namespace CesiumGltfContent
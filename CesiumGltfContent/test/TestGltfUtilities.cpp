@@ -1,11 +1,27 @@
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/Node.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumUtility/Math.h>
 
 #include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+using namespace CesiumGeospatial;
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
 using namespace CesiumUtility;
@@ -332,6 +348,14 @@ TEST_CASE("GltfUtilities::removeUnusedAccessors") {
     REQUIRE(it != m.meshes[0].primitives[0].attributes.end());
     CHECK(it->second == 0);
   }
+
+  SECTION("does not remove morph target accessors") {
+    m.accessors.emplace_back();
+    m.meshes.emplace_back().primitives.emplace_back().targets.emplace_back(
+        std::unordered_map<std::string, int32_t>{{"POSITION", 0}});
+    GltfUtilities::removeUnusedAccessors(m);
+    CHECK(m.accessors.size() == 1);
+  }
 }
 
 TEST_CASE("GltfUtilities::removeUnusedBufferViews") {
@@ -424,4 +448,599 @@ TEST_CASE("GltfUtilities::compactBuffers") {
       CHECK(buffer.cesium.data[i] == std::byte(i + 10));
     }
   }
+
+  SECTION("keeps the bytes of buffer views that contain others") {
+    for (int64_t offset : {10, 30, 0}) {
+      BufferView& bv = m.bufferViews.emplace_back();
+      bv.buffer = 0;
+      bv.byteOffset = offset;
+      bv.byteLength = offset == 0 ? 100 : 10;
+    }
+
+    GltfUtilities::compactBuffers(m);
+
+    CHECK(buffer.byteLength == 100);
+    CHECK(m.bufferViews[0].byteOffset == 10);
+    CHECK(m.bufferViews[1].byteOffset == 30);
+    CHECK(m.bufferViews[2].byteOffset == 0);
+  }
+
+  SECTION("removes several gaps") {
+    for (int64_t offset : {50, 10}) {
+      BufferView& bv = m.bufferViews.emplace_back();
+      bv.buffer = 0;
+      bv.byteOffset = offset;
+      bv.byteLength = 20;
+    }
+
+    GltfUtilities::compactBuffers(m);
+
+    CHECK(buffer.byteLength == 40);
+    REQUIRE(buffer.cesium.data.size() == 40);
+    CHECK(m.bufferViews[0].byteOffset == 20);
+    CHECK(m.bufferViews[1].byteOffset == 0);
+    CHECK(buffer.cesium.data[0] == std::byte(10));
+    CHECK(buffer.cesium.data[20] == std::byte(50));
+  }
+}
+
+TEST_CASE("GltfUtilities::collapseToSingleBuffer") {
+  Model m;
+  for (size_t i = 0; i < 3; ++i) {
+    Buffer& buffer = m.buffers.emplace_back();
+    buffer.cesium.data.resize(5, std::byte(i));
+    buffer.byteLength = 5;
+
+    BufferView& bv = m.bufferViews.emplace_back();
+    bv.buffer = static_cast<int32_t>(i);
+    bv.byteOffset = 1;
+    bv.byteLength = 4;
+  }
+
+  GltfUtilities::collapseToSingleBuffer(m);
+
+  REQUIRE(m.buffers.size() == 1);
+  CHECK(m.buffers[0].byteLength == 21);
+  REQUIRE(m.buffers[0].cesium.data.size() == 21);
+
+  // Each buffer's content starts at a 4-byte boundary.
+  for (size_t i = 0; i < 3; ++i) {
+    CHECK(m.bufferViews[i].buffer == 0);
+    CHECK(m.bufferViews[i].byteOffset == int64_t(i * 8 + 1));
+    CHECK(m.buffers[0].cesium.data[i * 8 + 1] == std::byte(i));
+  }
+}
+
+TEST_CASE("GltfUtilities::computeApproximateBoundingRegion") {
+  // The corners of a 100m box.
+  std::vector<glm::vec3> positions;
+  for (int i = 0; i < 8; ++i) {
+    positions.emplace_back(
+        (i & 1) ? 50.0f : -50.0f,
+        (i & 2) ? 50.0f : -50.0f,
+        (i & 4) ? 50.0f : -50.0f);
+  }
+
+  Model m;
+  Buffer& buffer = m.buffers.emplace_back();
+  buffer.cesium.data.resize(positions.size() * sizeof(glm::vec3));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      positions.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = m.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = m.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.count = static_cast<int64_t>(positions.size());
+  accessor.type = Accessor::Type::VEC3;
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.min = {-50.0, -50.0, -50.0};
+  accessor.max = {50.0, 50.0, 50.0};
+
+  m.meshes.emplace_back().primitives.emplace_back().attributes["POSITION"] = 0;
+
+  const glm::dvec3 center = Ellipsoid::WGS84.cartographicToCartesian(
+      Cartographic::fromDegrees(10.0, 45.0, 200.0));
+  const glm::dmat4 transform = glm::translate(glm::dmat4(1.0), center);
+
+  const BoundingRegion exact =
+      GltfUtilities::computeBoundingRegion(m, transform);
+  const BoundingRegion approximate =
+      GltfUtilities::computeApproximateBoundingRegion(m, transform);
+
+  SECTION("contains the exact region") {
+    const double epsilon = Math::Epsilon12;
+    CHECK(
+        approximate.getRectangle().getWest() <=
+        exact.getRectangle().getWest() + epsilon);
+    CHECK(
+        approximate.getRectangle().getSouth() <=
+        exact.getRectangle().getSouth() + epsilon);
+    CHECK(
+        approximate.getRectangle().getEast() >=
+        exact.getRectangle().getEast() - epsilon);
+    CHECK(
+        approximate.getRectangle().getNorth() >=
+        exact.getRectangle().getNorth() - epsilon);
+    CHECK(
+        approximate.getMinimumHeight() <=
+        exact.getMinimumHeight() + Math::Epsilon6);
+    CHECK(
+        approximate.getMaximumHeight() >=
+        exact.getMaximumHeight() - Math::Epsilon6);
+  }
+
+  SECTION("is close to the exact region") {
+    CHECK(Math::equalsEpsilon(
+        approximate.getRectangle().getWest(),
+        exact.getRectangle().getWest(),
+        0.0,
+        Math::Epsilon7));
+    CHECK(Math::equalsEpsilon(
+        approximate.getRectangle().getNorth(),
+        exact.getRectangle().getNorth(),
+        0.0,
+        Math::Epsilon7));
+    CHECK(Math::equalsEpsilon(
+        approximate.getMinimumHeight(),
+        exact.getMinimumHeight(),
+        0.0,
+        0.01));
+    CHECK(Math::equalsEpsilon(
+        approximate.getMaximumHeight(),
+        exact.getMaximumHeight(),
+        0.0,
+        0.01));
+  }
+
+  SECTION("skips primitives without positions") {
+    m.meshes[0].primitives[0].attributes.clear();
+    const BoundingRegion empty =
+        GltfUtilities::computeApproximateBoundingRegion(m, transform);
+    CHECK(empty.getMinimumHeight() > empty.getMaximumHeight());
+  }
+}
+
+namespace {
+template <typename T>
+int32_t addAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    const std::string& type,
+    int32_t componentType) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.count = static_cast<int64_t>(values.size());
+  accessor.type = type;
+  accessor.componentType = componentType;
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+// Gets the positions of the corners of each triangle, starting from the
+// smallest one so that triangles can be compared regardless of where their
+// indices start.
+std::vector<std::array<glm::vec3, 3>>
+getTriangles(const Model& model, const MeshPrimitive& primitive) {
+  const AccessorView<glm::vec3> positions(
+      model,
+      primitive.attributes.at("POSITION"));
+  std::vector<int64_t> indices;
+  std::visit(
+      [&indices](const auto& view) {
+        if constexpr (!std::is_same_v<
+                          std::decay_t<decltype(view)>,
+                          std::monostate>) {
+          for (int64_t i = 0; i < view.size(); ++i) {
+            indices.emplace_back(static_cast<int64_t>(view[i]));
+          }
+        }
+      },
+      getIndexAccessorView(model, primitive));
+
+  auto less = [](const glm::vec3& a, const glm::vec3& b) {
+    return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+  };
+
+  std::vector<std::array<glm::vec3, 3>> triangles;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    std::array<glm::vec3, 3> triangle{
+        positions[indices[i]],
+        positions[indices[i + 1]],
+        positions[indices[i + 2]]};
+    std::rotate(
+        triangle.begin(),
+        std::min_element(triangle.begin(), triangle.end(), less),
+        triangle.end());
+    triangles.emplace_back(triangle);
+  }
+
+  std::sort(
+      triangles.begin(),
+      triangles.end(),
+      [&less](const auto& a, const auto& b) {
+        return std::lexicographical_compare(
+            a.begin(),
+            a.end(),
+            b.begin(),
+            b.end(),
+            less);
+      });
+  return triangles;
+}
+} // namespace
+
+TEST_CASE("GltfUtilities::optimizeMeshes") {
+  // A 10x10 grid of vertices, with the triangles between them in a scrambled
+  // order.
+  std::vector<glm::vec3> positions;
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      positions.emplace_back(float(x), float(y), float((x * y) % 3));
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < 81; ++i) {
+    const uint32_t quad = (i * 37) % 81;
+    const uint32_t corner = quad / 9 * 10 + quad % 9;
+    indices.insert(
+        indices.end(),
+        {corner, corner + 1, corner + 11, corner, corner + 11, corner + 10});
+  }
+
+  Model m;
+  MeshPrimitive& primitive =
+      m.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      m,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.indices = addAccessor(
+      m,
+      indices,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_INT);
+
+  const std::vector<std::array<glm::vec3, 3>> expected =
+      getTriangles(m, primitive);
+  REQUIRE(expected.size() == 162);
+
+  SECTION("keeps the same triangles") {
+    GltfUtilities::optimizeMeshes(m);
+
+    CHECK(
+        m.accessors[size_t(primitive.indices)].componentType ==
+        Accessor::ComponentType::UNSIGNED_INT);
+    CHECK(getTriangles(m, primitive) == expected);
+  }
+
+  SECTION("compresses indices") {
+    GltfUtilities::optimizeMeshes(m, true);
+
+    const Accessor& indexAccessor = m.accessors[size_t(primitive.indices)];
+    CHECK(
+        indexAccessor.componentType == Accessor::ComponentType::UNSIGNED_SHORT);
+    CHECK(
+        m.buffers[1].byteLength ==
+        int64_t(indices.size() * sizeof(uint16_t)));
+    CHECK(getTriangles(m, primitive) == expected);
+  }
+
+  SECTION("doesn't change a primitive whose accessors are shared") {
+    MeshPrimitive copy = primitive;
+    m.meshes[0].primitives.emplace_back(std::move(copy));
+    GltfUtilities::optimizeMeshes(m, true);
+
+    CHECK(
+        m.accessors[size_t(m.meshes[0].primitives[1].indices)].componentType ==
+        Accessor::ComponentType::UNSIGNED_INT);
+    CHECK(
+        std::memcmp(
+            m.buffers[1].cesium.data.data(),
+            indices.data(),
+            indices.size() * sizeof(uint32_t)) == 0);
+  }
+}
+
+TEST_CASE("GltfUtilities::mergePrimitives") {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(0.0f, 1.0f, 0.0f)};
+  const std::vector<uint16_t> indices{0, 1, 2};
+
+  // Two nodes, each with a mesh with a single triangle.
+  Model m;
+  m.materials.resize(2);
+  for (size_t i = 0; i < 2; ++i) {
+    MeshPrimitive& primitive =
+        m.meshes.emplace_back().primitives.emplace_back();
+    primitive.material = 0;
+    primitive.attributes["POSITION"] = addAccessor(
+        m,
+        positions,
+        Accessor::Type::VEC3,
+        Accessor::ComponentType::FLOAT);
+    primitive.indices = addAccessor(
+        m,
+        indices,
+        Accessor::Type::SCALAR,
+        Accessor::ComponentType::UNSIGNED_SHORT);
+
+    Node& node = m.nodes.emplace_back();
+    node.mesh = static_cast<int32_t>(i);
+    node.translation = {10.0 * double(i), 0.0, 0.0};
+  }
+  m.scenes.emplace_back().nodes = {0, 1};
+
+  SECTION("merges primitives with the same material and attributes") {
+    GltfUtilities::mergePrimitives(m);
+
+    REQUIRE(m.meshes.size() == 1);
+    REQUIRE(m.meshes[0].primitives.size() == 1);
+    CHECK(m.nodes[0].mesh == 0);
+    CHECK(m.nodes[1].mesh == -1);
+
+    const MeshPrimitive& merged = m.meshes[0].primitives[0];
+    CHECK(merged.material == 0);
+
+    const AccessorView<glm::vec3> mergedPositions(
+        m,
+        merged.attributes.at("POSITION"));
+    REQUIRE(mergedPositions.size() == 6);
+    CHECK(mergedPositions[3] == glm::vec3(10.0f, 0.0f, 0.0f));
+    CHECK(mergedPositions[5] == glm::vec3(10.0f, 1.0f, 0.0f));
+
+    const AccessorView<uint16_t> mergedIndices(m, merged.indices);
+    REQUIRE(mergedIndices.size() == 6);
+    CHECK(mergedIndices[3] == 3);
+    CHECK(mergedIndices[5] == 5);
+
+    // Only the merged accessors remain.
+    CHECK(m.accessors.size() == 2);
+  }
+
+  SECTION("flips the triangles of a mirrored node") {
+    m.nodes[1].scale = {-1.0, 1.0, 1.0};
+    GltfUtilities::mergePrimitives(m);
+
+    REQUIRE(m.meshes.size() == 1);
+    const MeshPrimitive& merged = m.meshes[0].primitives[0];
+    const AccessorView<uint16_t> mergedIndices(m, merged.indices);
+    REQUIRE(mergedIndices.size() == 6);
+    CHECK(mergedIndices[4] == 5);
+    CHECK(mergedIndices[5] == 4);
+  }
+
+  SECTION("doesn't merge primitives with different materials") {
+    m.meshes[1].primitives[0].material = 1;
+    GltfUtilities::mergePrimitives(m);
+
+    CHECK(m.meshes.size() == 2);
+    CHECK(m.accessors.size() == 4);
+  }
+
+  SECTION("doesn't merge the primitives of a mesh used by two nodes") {
+    m.nodes[1].mesh = 0;
+    GltfUtilities::mergePrimitives(m);
+
+    CHECK(m.meshes.size() == 2);
+    CHECK(m.meshes[0].primitives.size() == 1);
+  }
+}
+
+namespace {
+class VectorStagingBufferAllocator : public IStagingBufferAllocator {
+public:
+  StagingAllocation allocate(size_t byteSize, size_t /*alignment*/) override {
+    if (this->fail) {
+      return StagingAllocation{};
+    }
+    std::vector<std::byte>& memory = this->allocations.emplace_back(byteSize);
+    return StagingAllocation{memory, &memory};
+  }
+
+  void free(const StagingAllocation& allocation) noexcept override {
+    if (allocation.pHandle) {
+      ++this->freeCount;
+    }
+  }
+
+  bool fail = false;
+  size_t freeCount = 0;
+  std::deque<std::vector<std::byte>> allocations;
+};
+} // namespace
+
+TEST_CASE("GltfUtilities::writeVertexStreams") {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(0.0f, 1.0f, 0.0f)};
+  const std::vector<uint16_t> ids{7, 8, 9};
+  const std::vector<uint8_t> indices{0, 1, 2};
+
+  Model m;
+  MeshPrimitive& primitive =
+      m.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      m,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.attributes["_ID"] = addAccessor(
+      m,
+      ids,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_SHORT);
+  primitive.indices = addAccessor(
+      m,
+      indices,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_BYTE);
+
+  VectorStagingBufferAllocator allocator;
+
+  SECTION("interleaves the attributes and widens 8-bit indices") {
+    const std::vector<PrimitiveVertexStreams> result =
+        GltfUtilities::writeVertexStreams(m, allocator);
+    REQUIRE(result.size() == 1);
+
+    const PrimitiveVertexStreams& streams = result[0];
+    CHECK(streams.meshIndex == 0);
+    CHECK(streams.primitiveIndex == 0);
+    CHECK(streams.vertexCount == 3);
+    REQUIRE(streams.attributes.size() == 2);
+    CHECK(streams.attributes[0].name == "POSITION");
+    CHECK(streams.attributes[0].byteOffset == 0);
+    CHECK(streams.attributes[0].byteSize == sizeof(glm::vec3));
+    CHECK(streams.attributes[1].name == "_ID");
+    CHECK(streams.attributes[1].byteOffset == sizeof(glm::vec3));
+    CHECK(streams.attributes[1].byteSize == sizeof(uint16_t));
+    CHECK(streams.vertexByteStride == 16);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const std::byte* pVertex =
+          streams.vertices.data.data() + i * streams.vertexByteStride;
+      glm::vec3 position;
+      std::memcpy(&position, pVertex, sizeof(position));
+      CHECK(position == positions[i]);
+
+      uint16_t id;
+      std::memcpy(&id, pVertex + sizeof(glm::vec3), sizeof(id));
+      CHECK(id == ids[i]);
+
+      // The padding is zeroed.
+      CHECK(pVertex[14] == std::byte(0));
+      CHECK(pVertex[15] == std::byte(0));
+    }
+
+    CHECK(streams.indexCount == 3);
+    CHECK(streams.indexByteSize == sizeof(uint16_t));
+    for (size_t i = 0; i < indices.size(); ++i) {
+      uint16_t index;
+      std::memcpy(
+          &index,
+          streams.indices.data.data() + i * sizeof(uint16_t),
+          sizeof(index));
+      CHECK(index == indices[i]);
+    }
+
+    CHECK(allocator.freeCount == 0);
+  }
+
+  SECTION("skips primitives whose memory can't be allocated") {
+    allocator.fail = true;
+    CHECK(GltfUtilities::writeVertexStreams(m, allocator).empty());
+    CHECK(allocator.freeCount == 0);
+  }
+
+  SECTION("frees the vertices if the indices can't be written") {
+    m.accessors[size_t(primitive.indices)].componentType =
+        Accessor::ComponentType::FLOAT;
+    CHECK(GltfUtilities::writeVertexStreams(m, allocator).empty());
+    CHECK(allocator.freeCount == 1);
+  }
+}
+
+TEST_CASE("GltfUtilities::mergeDuplicateImages") {
+  Model m;
+  for (int i = 0; i < 3; ++i) {
+    Image& image = m.images.emplace_back();
+    image.cesium.width = 2;
+    image.cesium.height = 2;
+    image.cesium.pixelData.resize(16, std::byte(i == 2 ? 255 : 128));
+    m.textures.emplace_back().source = i;
+  }
+
+  SECTION("points textures at the first of the identical images") {
+    GltfUtilities::mergeDuplicateImages(m);
+
+    REQUIRE(m.images.size() == 2);
+    CHECK(m.textures[0].source == 0);
+    CHECK(m.textures[1].source == 0);
+    CHECK(m.textures[2].source == 1);
+    CHECK(m.images[1].cesium.pixelData[0] == std::byte(255));
+  }
+
+  SECTION("keeps images of different sizes") {
+    m.images[1].cesium.width = 4;
+    m.images[1].cesium.height = 1;
+    GltfUtilities::mergeDuplicateImages(m);
+    CHECK(m.images.size() == 3);
+  }
+
+  SECTION("hashes the same pixels the same") {
+    CHECK(
+        GltfUtilities::computeImageContentHash(m.images[0].cesium) ==
+        GltfUtilities::computeImageContentHash(m.images[1].cesium));
+    CHECK(
+        GltfUtilities::computeImageContentHash(m.images[0].cesium) !=
+        GltfUtilities::computeImageContentHash(m.images[2].cesium));
+  }
+}
+
+TEST_CASE("GltfUtilities::mergeDuplicateAccessors") {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(0.0f, 1.0f, 0.0f)};
+  const std::vector<uint16_t> indices{0, 1, 2};
+  const std::vector<uint16_t> otherIndices{0, 2, 1};
+
+  // Two meshes with the same positions, one with the same indices too.
+  Model m;
+  for (size_t i = 0; i < 2; ++i) {
+    MeshPrimitive& primitive =
+        m.meshes.emplace_back().primitives.emplace_back();
+    primitive.attributes["POSITION"] = addAccessor(
+        m,
+        positions,
+        Accessor::Type::VEC3,
+        Accessor::ComponentType::FLOAT);
+    primitive.indices = addAccessor(
+        m,
+        i == 0 ? indices : otherIndices,
+        Accessor::Type::SCALAR,
+        Accessor::ComponentType::UNSIGNED_SHORT);
+  }
+
+  SECTION("shares accessors with the same elements") {
+    GltfUtilities::mergeDuplicateAccessors(m);
+
+    REQUIRE(m.accessors.size() == 3);
+    const MeshPrimitive& first = m.meshes[0].primitives[0];
+    const MeshPrimitive& second = m.meshes[1].primitives[0];
+    CHECK(first.attributes.at("POSITION") == second.attributes.at("POSITION"));
+    CHECK(first.indices != second.indices);
+
+    const std::vector<std::array<glm::vec3, 3>> triangles =
+        getTriangles(m, second);
+    REQUIRE(triangles.size() == 1);
+    CHECK(triangles[0][1] == positions[2]);
+  }
+
+  SECTION("keeps accessors of different types") {
+    m.accessors[2].componentType = Accessor::ComponentType::SHORT;
+    GltfUtilities::mergeDuplicateAccessors(m);
+    CHECK(m.accessors.size() == 4);
+  }
 }
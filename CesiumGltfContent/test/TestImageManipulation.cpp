@@ -1,9 +1,14 @@
+#include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGltf/ImageCesium.h>
 #include <CesiumGltfContent/ImageManipulation.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumNativeTests/ThreadTaskProcessor.h>
+#include <CesiumNativeTests/waitForFuture.h>
 
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <memory>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
@@ -237,6 +242,40 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifySuccessfulCopy();
   }
 
+  SECTION("interpolates between source pixels for a scaled-up blit") {
+    ImageCesium gradient;
+    gradient.bytesPerChannel = 1;
+    gradient.channels = 1;
+    gradient.width = 2;
+    gradient.height = 1;
+    gradient.pixelData = {std::byte(0), std::byte(200)};
+
+    ImageCesium scaled;
+    scaled.bytesPerChannel = 1;
+    scaled.channels = 1;
+    scaled.width = 4;
+    scaled.height = 2;
+    scaled.pixelData = std::vector<std::byte>(8, std::byte(1));
+
+    CHECK(
+        ImageManipulation::blitImage(
+            scaled,
+            PixelRectangle{0, 0, 4, 2},
+            gradient,
+            PixelRectangle{0, 0, 2, 1}) == true);
+
+    const std::vector<std::byte> expectedRow{
+        std::byte(0),
+        std::byte(50),
+        std::byte(150),
+        std::byte(200)};
+    for (size_t j = 0; j < 2; ++j) {
+      for (size_t i = 0; i < 4; ++i) {
+        CHECK(scaled.pixelData[j * 4 + i] == expectedRow[i]);
+      }
+    }
+  }
+
   SECTION("returns false for mismatched bytesPerChannel") {
     target.bytesPerChannel = 1;
     CHECK(
@@ -332,3 +371,170 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifyTargetUnchanged();
   }
 }
+
+TEST_CASE("ImageManipulation::compressImage") {
+  // A 6x4 image whose first block is opaque white above transparent black, and
+  // whose second, partial block is opaque red.
+  ImageCesium image;
+  image.width = 6;
+  image.height = 4;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(6 * 4 * 4);
+  for (size_t j = 0; j < 4; ++j) {
+    for (size_t i = 0; i < 6; ++i) {
+      std::byte* pPixel = image.pixelData.data() + (j * 6 + i) * 4;
+      if (i >= 4) {
+        pPixel[0] = std::byte(255);
+        pPixel[3] = std::byte(255);
+      } else if (j < 2) {
+        std::fill(pPixel, pPixel + 4, std::byte(255));
+      }
+    }
+  }
+
+  auto toBytes = [](const std::vector<uint8_t>& values) {
+    std::vector<std::byte> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), [](uint8_t v) {
+      return std::byte(v);
+    });
+    return result;
+  };
+
+  const std::vector<std::byte> expectedColors = toBytes(
+      {0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55,
+       0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00});
+
+  SECTION("compresses to BC1") {
+    CHECK(ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC1_RGB));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC1_RGB);
+    CHECK(image.pixelData == expectedColors);
+  }
+
+  SECTION("compresses to BC3") {
+    CHECK(ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC3_RGBA));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC3_RGBA);
+
+    std::vector<std::byte> expected = toBytes(
+        {0xFF, 0x00, 0x00, 0x00, 0x00, 0x49, 0x92, 0x24});
+    expected.insert(
+        expected.end(),
+        expectedColors.begin(),
+        expectedColors.begin() + 8);
+    const std::vector<std::byte> opaque =
+        toBytes({0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    expected.insert(expected.end(), opaque.begin(), opaque.end());
+    expected.insert(
+        expected.end(),
+        expectedColors.begin() + 8,
+        expectedColors.end());
+    CHECK(image.pixelData == expected);
+  }
+
+  SECTION("returns false for an unsupported format") {
+    const std::vector<std::byte> pixels = image.pixelData;
+    CHECK(!ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::ASTC_4x4_RGBA));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+    CHECK(image.pixelData == pixels);
+  }
+
+  SECTION("returns false for an image without 4 channels") {
+    image.channels = 3;
+    image.pixelData.resize(6 * 4 * 3);
+    CHECK(!ImageManipulation::compressImage(
+        image,
+        GpuCompressedPixelFormat::BC1_RGB));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+  }
+}
+
+TEST_CASE("ImageManipulation::savePng") {
+  // A gradient with some noise, so that it compresses neither perfectly nor
+  // not at all.
+  ImageCesium image;
+  image.width = 300;
+  image.height = 250;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(300 * 250 * 4);
+  for (size_t i = 0; i < image.pixelData.size(); ++i) {
+    image.pixelData[i] = std::byte((i / 4 + (i * 7919) % 13) & 0xFF);
+  }
+
+  auto readPng = [](const std::vector<std::byte>& png) {
+    REQUIRE(!png.empty());
+    CesiumGltfReader::ImageReaderResult result =
+        CesiumGltfReader::GltfReader::readImage(png, Ktx2TranscodeTargets());
+    REQUIRE(result.image);
+    return *result.image;
+  };
+
+  // The reader decodes every PNG to RGBA.
+  auto verifyPng = [&image, &readPng](const std::vector<std::byte>& png) {
+    const ImageCesium decoded = readPng(png);
+    CHECK(decoded.width == image.width);
+    CHECK(decoded.height == image.height);
+    CHECK(decoded.pixelData == image.pixelData);
+  };
+
+  SECTION("writes a PNG with the default encoding") {
+    verifyPng(ImageManipulation::savePng(image));
+  }
+
+  SECTION("writes a PNG with the fast encoding") {
+    verifyPng(ImageManipulation::savePng(image, PngEncoding::Fast));
+  }
+
+  SECTION("writes each number of channels with the fast encoding") {
+    for (int32_t channels = 1; channels <= 3; ++channels) {
+      image.channels = channels;
+      image.pixelData.resize(300 * 250 * size_t(channels));
+      const ImageCesium decoded =
+          readPng(ImageManipulation::savePng(image, PngEncoding::Fast));
+      CHECK(decoded.width == image.width);
+      CHECK(decoded.height == image.height);
+
+      // The first channel is gray or red, which is the first channel of RGBA
+      // either way.
+      for (size_t i = 0; i < 300 * 250; ++i) {
+        REQUIRE(
+            decoded.pixelData[i * 4] == image.pixelData[i * size_t(channels)]);
+      }
+    }
+  }
+
+  SECTION("appends to the end of an existing buffer") {
+    std::vector<std::byte> output(3, std::byte(42));
+    ImageManipulation::savePng(image, output, PngEncoding::Fast);
+    REQUIRE(output.size() > 3);
+    CHECK(output[2] == std::byte(42));
+    verifyPng(std::vector<std::byte>(output.begin() + 3, output.end()));
+  }
+
+  SECTION("writes nothing for an image that is not 8-bit") {
+    image.bytesPerChannel = 2;
+    CHECK(ImageManipulation::savePng(image, PngEncoding::Fast).empty());
+  }
+
+  SECTION("writes a large PNG in parallel") {
+    image.width = 1024;
+    image.height = 1000;
+    image.pixelData.resize(1024 * 1000 * 4);
+    for (size_t i = 0; i < image.pixelData.size(); ++i) {
+      image.pixelData[i] = std::byte((i / 4 + (i * 7919) % 13) & 0xFF);
+    }
+
+    CesiumAsync::AsyncSystem asyncSystem(
+        std::make_shared<CesiumNativeTests::ThreadTaskProcessor>());
+    std::vector<std::byte> png = CesiumNativeTests::waitForFuture(
+        asyncSystem,
+        ImageManipulation::savePngInParallel(asyncSystem, image));
+    verifyPng(png);
+  }
+}
@@ -27,6 +27,9 @@ void ExtensionCesiumRTCJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ExtensionCesiumRTCJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::ExtensionCesiumRTC::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionCesiumRTC(
       CesiumGltf::ExtensionCesiumRTC::TypeName,
       str,
@@ -129,6 +132,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionCesiumTileEdgesJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionCesiumTileEdges::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionCesiumTileEdges(
       CesiumGltf::ExtensionCesiumTileEdges::TypeName,
       str,
@@ -239,6 +247,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionExtInstanceFeaturesJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionExtInstanceFeatures::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionExtInstanceFeatures(
       CesiumGltf::ExtensionExtInstanceFeatures::TypeName,
       str,
@@ -342,6 +355,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionExtMeshFeaturesJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionExtMeshFeatures::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionExtMeshFeatures(
       CesiumGltf::ExtensionExtMeshFeatures::TypeName,
       str,
@@ -445,6 +463,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionExtMeshGpuInstancingJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionExtMeshGpuInstancing::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionExtMeshGpuInstancing(
       CesiumGltf::ExtensionExtMeshGpuInstancing::TypeName,
       str,
@@ -548,6 +571,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionBufferExtMeshoptCompressionJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionBufferExtMeshoptCompression::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionBufferExtMeshoptCompression(
       CesiumGltf::ExtensionBufferExtMeshoptCompression::TypeName,
       str,
@@ -663,6 +691,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionBufferViewExtMeshoptCompressionJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionBufferViewExtMeshoptCompression::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionBufferViewExtMeshoptCompression(
       CesiumGltf::ExtensionBufferViewExtMeshoptCompression::TypeName,
       str,
@@ -790,6 +823,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionModelExtStructuralMetadataJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionModelExtStructuralMetadata::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionModelExtStructuralMetadata(
       CesiumGltf::ExtensionModelExtStructuralMetadata::TypeName,
       str,
@@ -913,6 +951,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionMeshPrimitiveExtStructuralMetadataJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionMeshPrimitiveExtStructuralMetadata::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionMeshPrimitiveExtStructuralMetadata(
       CesiumGltf::ExtensionMeshPrimitiveExtStructuralMetadata::TypeName,
       str,
@@ -1035,6 +1078,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionKhrDracoMeshCompressionJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionKhrDracoMeshCompression::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionKhrDracoMeshCompression(
       CesiumGltf::ExtensionKhrDracoMeshCompression::TypeName,
       str,
@@ -1141,6 +1189,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionKhrMaterialsUnlitJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionKhrMaterialsUnlit::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionKhrMaterialsUnlit(
       CesiumGltf::ExtensionKhrMaterialsUnlit::TypeName,
       str,
@@ -1244,6 +1297,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionModelKhrMaterialsVariantsJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionModelKhrMaterialsVariants::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionModelKhrMaterialsVariants(
       CesiumGltf::ExtensionModelKhrMaterialsVariants::TypeName,
       str,
@@ -1350,6 +1408,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionMeshPrimitiveKhrMaterialsVariantsJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionMeshPrimitiveKhrMaterialsVariants::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionMeshPrimitiveKhrMaterialsVariants(
       CesiumGltf::ExtensionMeshPrimitiveKhrMaterialsVariants::TypeName,
       str,
@@ -1459,6 +1522,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionKhrTextureBasisuJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionKhrTextureBasisu::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionKhrTextureBasisu(
       CesiumGltf::ExtensionKhrTextureBasisu::TypeName,
       str,
@@ -1564,6 +1632,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionModelMaxarMeshVariantsJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionModelMaxarMeshVariants::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionModelMaxarMeshVariants(
       CesiumGltf::ExtensionModelMaxarMeshVariants::TypeName,
       str,
@@ -1670,6 +1743,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionNodeMaxarMeshVariantsJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionNodeMaxarMeshVariants::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionNodeMaxarMeshVariants(
       CesiumGltf::ExtensionNodeMaxarMeshVariants::TypeName,
       str,
@@ -1777,6 +1855,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionKhrTextureTransformJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionKhrTextureTransform::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionKhrTextureTransform(
       CesiumGltf::ExtensionKhrTextureTransform::TypeName,
       str,
@@ -1884,6 +1967,11 @@ void ExtensionTextureWebpJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ExtensionTextureWebpJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionTextureWebp::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionTextureWebp(
       CesiumGltf::ExtensionTextureWebp::TypeName,
       str,
@@ -1983,6 +2071,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionCesiumPrimitiveOutlineJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionCesiumPrimitiveOutline::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionCesiumPrimitiveOutline(
       CesiumGltf::ExtensionCesiumPrimitiveOutline::TypeName,
       str,
@@ -2089,6 +2182,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionNodeMaxarMeshVariantsMappingsValueJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionNodeMaxarMeshVariantsMappingsValue::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionNodeMaxarMeshVariantsMappingsValue(
       CesiumGltf::ExtensionNodeMaxarMeshVariantsMappingsValue::TypeName,
       str,
@@ -2189,6 +2287,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionModelMaxarMeshVariantsValueJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionModelMaxarMeshVariantsValue::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionModelMaxarMeshVariantsValue(
       CesiumGltf::ExtensionModelMaxarMeshVariantsValue::TypeName,
       str,
@@ -2391,6 +2494,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionModelKhrMaterialsVariantsValueJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionModelKhrMaterialsVariantsValue::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionModelKhrMaterialsVariantsValue(
       CesiumGltf::ExtensionModelKhrMaterialsVariantsValue::TypeName,
       str,
@@ -2486,6 +2594,9 @@ void PropertyAttributeJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyAttributeJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::PropertyAttribute::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyAttribute(
       CesiumGltf::PropertyAttribute::TypeName,
       str,
@@ -2581,6 +2692,11 @@ CesiumJsonReader::IJsonHandler*
 PropertyAttributePropertyJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::PropertyAttributeProperty::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyAttributeProperty(
       CesiumGltf::PropertyAttributeProperty::TypeName,
       str,
@@ -2680,6 +2796,9 @@ void PropertyTextureJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTextureJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::PropertyTexture::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTexture(
       CesiumGltf::PropertyTexture::TypeName,
       str,
@@ -2772,6 +2891,11 @@ void PropertyTexturePropertyJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTexturePropertyJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::PropertyTextureProperty::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTextureProperty(
       CesiumGltf::PropertyTextureProperty::TypeName,
       str,
@@ -2870,6 +2994,9 @@ void TextureInfoJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 TextureInfoJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::TextureInfo::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyTextureInfo(
       CesiumGltf::TextureInfo::TypeName,
       str,
@@ -2958,6 +3085,9 @@ void PropertyTableJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTableJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::PropertyTable::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTable(
       CesiumGltf::PropertyTable::TypeName,
       str,
@@ -3056,6 +3186,11 @@ void PropertyTablePropertyJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 PropertyTablePropertyJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::PropertyTableProperty::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyPropertyTableProperty(
       CesiumGltf::PropertyTableProperty::TypeName,
       str,
@@ -3169,6 +3304,9 @@ void SchemaJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SchemaJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Schema::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySchema(
       CesiumGltf::Schema::TypeName,
       str,
@@ -3260,6 +3398,9 @@ void EnumJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 EnumJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Enum::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyEnum(
       CesiumGltf::Enum::TypeName,
       str,
@@ -3346,6 +3487,9 @@ void EnumValueJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 EnumValueJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::EnumValue::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyEnumValue(
       CesiumGltf::EnumValue::TypeName,
       str,
@@ -3431,6 +3575,9 @@ void ClassJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ClassJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Class::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyClass(
       CesiumGltf::Class::TypeName,
       str,
@@ -3528,6 +3675,9 @@ void ClassPropertyJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ClassPropertyJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::ClassProperty::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyClassProperty(
       CesiumGltf::ClassProperty::TypeName,
       str,
@@ -3647,6 +3797,9 @@ void FeatureIdJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 FeatureIdJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::FeatureId::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyFeatureId(
       CesiumGltf::FeatureId::TypeName,
       str,
@@ -3735,6 +3888,9 @@ void FeatureIdTextureJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 FeatureIdTextureJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::FeatureIdTexture::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyFeatureIdTexture(
       CesiumGltf::FeatureIdTexture::TypeName,
       str,
@@ -3826,6 +3982,11 @@ CesiumJsonReader::IJsonHandler*
 ExtensionExtInstanceFeaturesFeatureIdJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::ExtensionExtInstanceFeaturesFeatureId::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyExtensionExtInstanceFeaturesFeatureId(
       CesiumGltf::ExtensionExtInstanceFeaturesFeatureId::TypeName,
       str,
@@ -3943,6 +4104,9 @@ void ModelJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ModelJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Model::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyModel(
       CesiumGltf::Model::TypeName,
       str,
@@ -4057,6 +4221,9 @@ void TextureJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 TextureJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Texture::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyTexture(
       CesiumGltf::Texture::TypeName,
       str,
@@ -4139,6 +4306,9 @@ void SkinJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SkinJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Skin::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySkin(
       CesiumGltf::Skin::TypeName,
       str,
@@ -4223,6 +4393,9 @@ void SceneJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SceneJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Scene::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyScene(
       CesiumGltf::Scene::TypeName,
       str,
@@ -4304,6 +4477,9 @@ void SamplerJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 SamplerJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Sampler::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeySampler(
       CesiumGltf::Sampler::TypeName,
       str,
@@ -4396,6 +4572,9 @@ void NodeJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 NodeJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Node::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyNode(
       CesiumGltf::Node::TypeName,
       str,
@@ -4491,6 +4670,9 @@ void MeshJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 MeshJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Mesh::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMesh(
       CesiumGltf::Mesh::TypeName,
       str,
@@ -4575,6 +4757,9 @@ void MeshPrimitiveJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 MeshPrimitiveJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::MeshPrimitive::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMeshPrimitive(
       CesiumGltf::MeshPrimitive::TypeName,
       str,
@@ -4674,6 +4859,9 @@ void MaterialJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 MaterialJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Material::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMaterial(
       CesiumGltf::Material::TypeName,
       str,
@@ -4776,6 +4964,11 @@ CesiumJsonReader::IJsonHandler*
 MaterialOcclusionTextureInfoJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::MaterialOcclusionTextureInfo::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMaterialOcclusionTextureInfo(
       CesiumGltf::MaterialOcclusionTextureInfo::TypeName,
       str,
@@ -4865,6 +5058,11 @@ CesiumJsonReader::IJsonHandler*
 MaterialNormalTextureInfoJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::MaterialNormalTextureInfo::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMaterialNormalTextureInfo(
       CesiumGltf::MaterialNormalTextureInfo::TypeName,
       str,
@@ -4960,6 +5158,11 @@ CesiumJsonReader::IJsonHandler*
 MaterialPBRMetallicRoughnessJsonHandler::readObjectKey(
     const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::MaterialPBRMetallicRoughness::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyMaterialPBRMetallicRoughness(
       CesiumGltf::MaterialPBRMetallicRoughness::TypeName,
       str,
@@ -5071,6 +5274,9 @@ void ImageJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 ImageJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Image::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyImage(
       CesiumGltf::Image::TypeName,
       str,
@@ -5155,6 +5361,9 @@ void CameraJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 CameraJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Camera::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyCamera(
       CesiumGltf::Camera::TypeName,
       str,
@@ -5240,6 +5449,9 @@ void CameraPerspectiveJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 CameraPerspectiveJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::CameraPerspective::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyCameraPerspective(
       CesiumGltf::CameraPerspective::TypeName,
       str,
@@ -5335,6 +5547,9 @@ void CameraOrthographicJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 CameraOrthographicJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::CameraOrthographic::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyCameraOrthographic(
       CesiumGltf::CameraOrthographic::TypeName,
       str,
@@ -5431,6 +5646,9 @@ void BufferViewJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 BufferViewJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::BufferView::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyBufferView(
       CesiumGltf::BufferView::TypeName,
       str,
@@ -5522,6 +5740,9 @@ void BufferJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 BufferJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Buffer::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyBuffer(
       CesiumGltf::Buffer::TypeName,
       str,
@@ -5605,6 +5826,9 @@ void AssetJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AssetJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Asset::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAsset(
       CesiumGltf::Asset::TypeName,
       str,
@@ -5690,6 +5914,9 @@ void AnimationJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AnimationJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Animation::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAnimation(
       CesiumGltf::Animation::TypeName,
       str,
@@ -5773,6 +6000,9 @@ void AnimationSamplerJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AnimationSamplerJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::AnimationSampler::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAnimationSampler(
       CesiumGltf::AnimationSampler::TypeName,
       str,
@@ -5863,6 +6093,9 @@ void AnimationChannelJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AnimationChannelJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::AnimationChannel::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAnimationChannel(
       CesiumGltf::AnimationChannel::TypeName,
       str,
@@ -5951,6 +6184,11 @@ void AnimationChannelTargetJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AnimationChannelTargetJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::AnimationChannelTarget::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAnimationChannelTarget(
       CesiumGltf::AnimationChannelTarget::TypeName,
       str,
@@ -6050,6 +6288,9 @@ void AccessorJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AccessorJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::Accessor::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAccessor(
       CesiumGltf::Accessor::TypeName,
       str,
@@ -6146,6 +6387,9 @@ void AccessorSparseJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AccessorSparseJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(CesiumGltf::AccessorSparse::TypeName, str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAccessorSparse(
       CesiumGltf::AccessorSparse::TypeName,
       str,
@@ -6235,6 +6479,11 @@ void AccessorSparseValuesJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AccessorSparseValuesJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::AccessorSparseValues::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAccessorSparseValues(
       CesiumGltf::AccessorSparseValues::TypeName,
       str,
@@ -6325,6 +6574,11 @@ void AccessorSparseIndicesJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AccessorSparseIndicesJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumGltf::AccessorSparseIndices::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAccessorSparseIndices(
       CesiumGltf::AccessorSparseIndices::TypeName,
       str,
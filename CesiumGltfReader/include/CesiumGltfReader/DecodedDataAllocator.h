@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CesiumGltfReader/Library.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief A kind of data that {@link GltfReader} decodes, for which a
+ * {@link DecodedDataAllocator} allocates memory.
+ */
+enum class DecodedDataKind : uint8_t {
+  /**
+   * @brief The vertices and indices of primitives decoded from
+   * `KHR_draco_mesh_compression`.
+   */
+  Draco,
+
+  /**
+   * @brief The buffer views decoded from `EXT_meshopt_compression`.
+   */
+  MeshOpt,
+
+  /**
+   * @brief The vertex attributes converted to floating-point values from
+   * `KHR_mesh_quantization`.
+   */
+  DequantizedMeshData,
+
+  /**
+   * @brief The pixels of decoded JPEG, PNG, and WebP images, including images
+   * that were downscaled to a maximum dimension.
+   */
+  Image,
+
+  /**
+   * @brief The pixels of transcoded KTX2 images.
+   */
+  Ktx2
+};
+
+/**
+ * @brief Allocates the memory of the buffers and images that {@link GltfReader}
+ * decodes, and counts the bytes allocated for each {@link DecodedDataKind}.
+ *
+ * When the {@link GltfReaderOptions::pDecodedDataAllocator} is set to an
+ * instance of this class, the Draco and meshopt decoders, the dequantization of
+ * mesh data, and the image decoders get the vectors that they decode into from
+ * {@link allocate}. The counts tell how much memory each of them produces. A
+ * derived class can override {@link allocateBytes} to supply the vectors
+ * itself, such as to reuse the vectors of models that it no longer needs
+ * instead of allocating new ones.
+ *
+ * Models are decoded in worker threads, possibly several at a time, so this
+ * class and the classes derived from it must be thread-safe.
+ */
+class CESIUMGLTFREADER_API DecodedDataAllocator {
+public:
+  virtual ~DecodedDataAllocator() = default;
+
+  /**
+   * @brief Allocates a vector for decoded data and counts its bytes.
+   *
+   * @param kind The kind of data that the vector will hold.
+   * @param byteSize The size of the vector.
+   * @return A vector with exactly `byteSize` bytes. The decoder overwrites all
+   * of them.
+   */
+  std::vector<std::byte> allocate(DecodedDataKind kind, size_t byteSize);
+
+  /**
+   * @brief Gets the number of bytes allocated so far for the given kind of
+   * data.
+   */
+  int64_t getAllocatedBytes(DecodedDataKind kind) const noexcept;
+
+  /**
+   * @brief Gets the number of bytes allocated so far for all kinds of data.
+   */
+  int64_t getTotalAllocatedBytes() const noexcept;
+
+protected:
+  /**
+   * @brief Creates the vector returned by {@link allocate}.
+   *
+   * The default implementation creates a new vector of the given size. An
+   * implementation may return a vector of any size with any contents, such as
+   * one that it reused, because {@link allocate} resizes it and the decoder
+   * overwrites it.
+   *
+   * @param kind The kind of data that the vector will hold.
+   * @param byteSize The size of the vector.
+   * @return The vector.
+   */
+  virtual std::vector<std::byte>
+  allocateBytes(DecodedDataKind kind, size_t byteSize);
+
+private:
+  std::array<std::atomic<int64_t>, size_t(DecodedDataKind::Ktx2) + 1>
+      _allocatedBytes{};
+};
+
+} // namespace CesiumGltfReader
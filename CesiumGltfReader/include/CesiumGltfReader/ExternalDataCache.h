@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CesiumGltfReader/Library.h"
+
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumGltf/ImageCesium.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief An external buffer or image of a glTF, as loaded by
+ * {@link GltfReader::resolveExternalData}.
+ */
+struct CESIUMGLTFREADER_API ExternalData {
+  /**
+   * @brief The bytes of an external buffer. This is empty for an image.
+   */
+  std::vector<std::byte> bufferData;
+
+  /**
+   * @brief The decoded image, or std::nullopt for a buffer.
+   */
+  std::optional<CesiumGltf::ImageCesium> image;
+};
+
+/**
+ * @brief Shares the external buffers and images of glTF models between the
+ * models that refer to the same ones, with one budget of bytes for all of
+ * them.
+ *
+ * The tiles of a tileset often refer to the same external texture atlas or
+ * material image, with a `uri` relative to each tile. When the
+ * {@link GltfReaderOptions::pExternalDataCache} of
+ * {@link GltfReader::resolveExternalData} is set to an instance of this class,
+ * each of them is requested and decoded once, by the first model that needs
+ * it, and the models that need it while it loads or after it's loaded copy the
+ * same result.
+ *
+ * Buffers are identified by their resolved URL, and images by their resolved
+ * URL and the options that affect how they're decoded.
+ *
+ * This class is thread-safe, so that models loading in several worker threads
+ * can share one instance.
+ */
+class CESIUMGLTFREADER_API ExternalDataCache final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumBytes The maximum number of bytes of buffers and images to
+   * keep after they're loaded.
+   */
+  explicit ExternalDataCache(int64_t maximumBytes = 128 * 1024 * 1024) noexcept;
+
+  /**
+   * @brief Gets an external buffer or image, loading it if it's not already
+   * cached or loading.
+   *
+   * A load that resolves to nullptr is not kept, so that the next model that
+   * needs it tries again.
+   *
+   * @param key The key of the buffer or image.
+   * @param load The function to load it if it isn't cached. It is called before
+   * this method returns, if at all, while this cache is locked, so it must only
+   * start the load and not use this cache itself.
+   * @return A future that resolves to the buffer or image, or to nullptr if it
+   * could not be loaded.
+   */
+  CesiumAsync::SharedFuture<std::shared_ptr<const ExternalData>> get(
+      const std::string& key,
+      const std::function<
+          CesiumAsync::Future<std::shared_ptr<const ExternalData>>()>& load);
+
+  /**
+   * @brief Gets the number of bytes of loaded buffers and images in this
+   * cache.
+   */
+  int64_t getCachedBytes() const noexcept { return *this->_pCachedBytes; }
+
+  /**
+   * @brief Gets the maximum number of bytes of loaded buffers and images to
+   * keep.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+private:
+  void unloadCachedData() noexcept;
+
+  struct CacheEntry {
+    std::string key;
+    CesiumAsync::SharedFuture<std::shared_ptr<const ExternalData>> future;
+  };
+
+  // Entries at the beginning of this list are the least recently used
+  // (oldest), while the entries at the end are most recently used (newest).
+  using DataLeastRecentlyUsedList = std::list<CacheEntry>;
+  DataLeastRecentlyUsedList _dataOldToRecent;
+
+  std::unordered_map<std::string, DataLeastRecentlyUsedList::iterator>
+      _dataLookup;
+
+  int64_t _maximumBytes;
+
+  // Shared with the loads in progress, which add the bytes of their result
+  // when they finish, even after this cache is destroyed.
+  std::shared_ptr<std::atomic<int64_t>> _pCachedBytes;
+
+  mutable std::mutex _mutex;
+};
+
+} // namespace CesiumGltfReader
@@ -3,6 +3,7 @@
 #include "CesiumGltfReader/Library.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CancellationToken.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/HttpHeaders.h>
 #include <CesiumAsync/IAssetAccessor.h>
@@ -14,6 +15,7 @@
 
 #include <gsl/span>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -22,6 +24,27 @@
 
 namespace CesiumGltfReader {
 
+class DecodedDataAllocator;
+class ExternalDataCache;
+
+/**
+ * @brief The filter used by {@link GltfReader::generateMipMaps} to compute
+ * each mip level from the one before it.
+ */
+enum class MipMapFilter {
+  /**
+   * @brief A high-quality resampling filter. This is the slowest filter.
+   */
+  HighQuality,
+
+  /**
+   * @brief Each texel is the average of the 2x2 block of texels it covers in
+   * the previous level. This is much faster than {@link HighQuality} and is
+   * usually indistinguishable from it at a distance.
+   */
+  Box
+};
+
 /**
  * @brief The result of reading a glTF model with
  * {@link GltfReader::readGltf}.
@@ -112,20 +135,142 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    * @brief Whether the quantized mesh data are dequantized and converted to
    * floating-point values when loading, according to the KHR_mesh_quantization
    * extension.
+   *
+   * Set this to false to keep the quantized data, which takes a half or a
+   * quarter of the memory, for a renderer that dequantizes vertex attributes
+   * in its shaders. The accessors then keep their integer component types and
+   * their `normalized` flags. PNTS point clouds converted with these options
+   * likewise keep their `POSITION_QUANTIZED` positions, dequantized by the
+   * node's transform.
    */
   bool dequantizeMeshData = true;
 
+  /**
+   * @brief Whether the points of PNTS point clouds are randomly permuted when
+   * they are converted to glTF, so that the first points of each are a uniform
+   * subsample of it.
+   *
+   * A renderer can then draw only a prefix of a point cloud's points, such as
+   * the fraction given by
+   * {@link Cesium3DTilesSelection::TileRenderContent::getPointBudgetFraction},
+   * and still cover the whole tile. The points of a tile with per-point
+   * metadata get explicit feature IDs, so that each still refers to its own
+   * properties.
+   */
+  bool shufflePointClouds = false;
+
+  /**
+   * @brief The names of the batch table properties of B3DM and PNTS content
+   * to convert to `EXT_structural_metadata`, or empty to convert all of them.
+   *
+   * Converting a batch table property with a JSON array of values means
+   * inferring its type from all of the values and then copying them into a
+   * binary buffer, which can take much of the time to load a tile with many
+   * features. The properties that aren't listed are left out of the glTF.
+   */
+  std::vector<std::string> batchTableProperties;
+
   /**
    * @brief  Whether the texture coordinates of a texture are transformed or
    * not, according to the KHR_texture_transform extension
+   *
+   * Transforming them copies every affected texture coordinate accessor. When
+   * this is false, the original texture coordinates and the extensions are
+   * kept, so a renderer can apply the matrix from
+   * {@link CesiumGltf::KhrTextureTransform::toMatrix} in a shader instead. A
+   * consumer that needs the transformed coordinates on the CPU later, such as
+   * for picking, can call {@link GltfReader::applyTextureTransform}.
    */
   bool applyTextureTransform = true;
 
+  /**
+   * @brief The maximum width and height of decoded JPEG, PNG, and WebP images,
+   * or 0 for no limit.
+   *
+   * A larger image is downscaled to fit while preserving its aspect ratio. A
+   * JPEG is scaled by libjpeg-turbo while it is decompressed, by the smallest
+   * of its factors (such as 1/2, 1/4, or 1/8) that makes it fit, which is much
+   * faster than decoding it at full size. Any remaining excess is resized
+   * away afterward. KTX2 images are not affected.
+   */
+  int32_t maximumImageDimension = 0;
+
+  /**
+   * @brief The maximum width and height of the mip levels kept from KTX2
+   * images that have a mip chain, or 0 for no limit.
+   *
+   * The larger mip levels are discarded after the image is transcoded, so the
+   * renderer gets a smaller image that is quicker to upload and takes less
+   * memory, at the cost of sharpness up close. The smallest mip level is
+   * always kept. KTX2 images without a mip chain are not affected.
+   */
+  int32_t maximumKtx2Dimension = 0;
+
+  /**
+   * @brief Whether JPEG, PNG, and WebP images without an alpha channel are
+   * decoded to three channels (RGB) rather than four (RGBA).
+   *
+   * This saves a quarter of the memory of each opaque image, but the renderer
+   * must then handle images with {@link CesiumGltf::ImageCesium::channels}
+   * set to 3.
+   */
+  bool decodeOpaqueImagesToRgb = false;
+
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
+
+  /**
+   * @brief A token that reports when the model is no longer needed.
+   *
+   * It is checked between the expensive steps of the load process, such as
+   * decoding each image and decoding Draco or meshopt compressed geometry.
+   * When it is canceled, the load stops at the next check and the result has
+   * no model.
+   */
+  CesiumAsync::CancellationToken cancellationToken;
+
+  /**
+   * @brief An async system used to spread independent decoding work across
+   * worker threads.
+   *
+   * When set, the embedded images and the Draco-compressed primitives of a
+   * model are decoded in parallel, with the calling thread decoding its share.
+   * When not set, they are decoded one after another in the calling thread.
+   */
+  std::optional<CesiumAsync::AsyncSystem> asyncSystem;
+
+  /**
+   * @brief The maximum number of threads, including the calling thread, that
+   * decode the embedded images of a single model at once.
+   *
+   * This only has an effect when {@link asyncSystem} is set. It keeps a model
+   * with many images from occupying every worker thread while other models
+   * wait to load.
+   */
+  uint32_t maximumSimultaneousImageDecodes = 4;
+
+  /**
+   * @brief A cache of the external buffers and images that
+   * {@link GltfReader::resolveExternalData} loads, shared with the other models
+   * that read with it.
+   *
+   * When set, an external buffer or image that several models refer to, such
+   * as a texture atlas of a tileset, is requested and decoded only once while
+   * it's cached, and each model gets a copy of it. When not set, each model
+   * requests and decodes its own.
+   */
+  std::shared_ptr<ExternalDataCache> pExternalDataCache;
+
+  /**
+   * @brief Allocates the memory of the buffers and images that are decoded
+   * while the glTF is read, and counts its bytes.
+   *
+   * When not set, each decoder creates its own vectors.
+   */
+  std::shared_ptr<DecodedDataAllocator> pDecodedDataAllocator;
 };
 
 /**
@@ -159,6 +304,22 @@ public:
       const gsl::span<const std::byte>& data,
       const GltfReaderOptions& options = GltfReaderOptions()) const;
 
+  /**
+   * @brief Reads a glTF or binary glTF (GLB) from a buffer that the reader
+   * takes ownership of.
+   *
+   * For a GLB, the allocation owned by `data` is reused as the binary buffer
+   * of the resulting model, so the binary chunk is not copied into a second
+   * buffer. Prefer this overload when the caller no longer needs the bytes.
+   *
+   * @param data The buffer from which to read the glTF.
+   * @param options Options for how to read the glTF.
+   * @return The result of reading the glTF.
+   */
+  GltfReaderResult readGltf(
+      std::vector<std::byte>&& data,
+      const GltfReaderOptions& options = GltfReaderOptions()) const;
+
   /**
    * @brief Reads a glTF or binary glTF file from a URL and resolves external
    * buffers and images.
@@ -223,17 +384,66 @@ public:
       const gsl::span<const std::byte>& data,
       const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets);
 
+  /**
+   * @brief Reads an image from a buffer, as controlled by the image-related
+   * properties of the given options.
+   *
+   * Images are transcoded to {@link GltfReaderOptions::ktx2TranscodeTargets},
+   * limited to {@link GltfReaderOptions::maximumImageDimension} and
+   * {@link GltfReaderOptions::maximumKtx2Dimension}, and decoded
+   * according to {@link GltfReaderOptions::decodeOpaqueImagesToRgb}.
+   *
+   * @param data The buffer from which to read the image.
+   * @param options The options for reading the image.
+   * @return The result of reading the image.
+   */
+  static ImageReaderResult readImage(
+      const gsl::span<const std::byte>& data,
+      const GltfReaderOptions& options);
+
+  /**
+   * @brief Decodes the images whose bytes are embedded in the model's
+   * buffers and have not been decoded yet.
+   *
+   * This is the step that {@link GltfReaderOptions::decodeEmbeddedImages}
+   * enables. It can be called later on a model that was read without it.
+   *
+   * @param readGltf The result of reading the glTF. Any errors or warnings
+   * from decoding are added to it.
+   * @param options The options for decoding the images.
+   */
+  static void decodeEmbeddedImages(
+      GltfReaderResult& readGltf,
+      const GltfReaderOptions& options);
+
+  /**
+   * @brief Transforms the texture coordinates of the model according to the
+   * KHR_texture_transform extensions of its textures, and removes the
+   * extensions.
+   *
+   * This is the step that {@link GltfReaderOptions::applyTextureTransform}
+   * enables. It can be called later on a model that was read without it. Each
+   * texture coordinate accessor is copied at most once per distinct
+   * transform, however many primitives and textures share it.
+   *
+   * @param model The model to transform.
+   */
+  static void applyTextureTransform(CesiumGltf::Model& model);
+
   /**
    * @brief Generate mipmaps for this image.
    *
    * Does nothing if mipmaps already exist or the compressedPixelFormat is not
    * GpuCompressedPixelFormat::NONE.
    *
-   * @param image The image to generate mipmaps for.   *
+   * @param image The image to generate mipmaps for.
+   * @param filter The filter used to compute each mip level from the previous
+   * one.
    * @return A string describing the error, if unable to generate mipmaps.
    */
-  static std::optional<std::string>
-  generateMipMaps(CesiumGltf::ImageCesium& image);
+  static std::optional<std::string> generateMipMaps(
+      CesiumGltf::ImageCesium& image,
+      MipMapFilter filter = MipMapFilter::HighQuality);
 
 private:
   CesiumJsonReader::JsonReaderOptions _context;
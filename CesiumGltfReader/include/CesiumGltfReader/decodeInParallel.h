@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CesiumGltfReader/Library.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace CesiumGltfReader {
+/**
+ * @brief Calls `decode` once for each index from 0 to `count - 1`, and returns
+ * when every call has returned.
+ *
+ * The calls are spread across at most `maximumThreads` threads, including the
+ * calling thread, which does its share. The calling thread only ever waits for
+ * calls that are already running, so this may be called from a worker thread,
+ * even from within another `decode`. Without an async system, the calls are
+ * made in order in the calling thread.
+ *
+ * @param count The number of calls.
+ * @param maybeAsyncSystem The async system whose worker threads help.
+ * @param maximumThreads The maximum number of threads to use.
+ * @param decode The function to call, which must not throw.
+ */
+CESIUMGLTFREADER_API void decodeInParallel(
+    size_t count,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    size_t maximumThreads,
+    const std::function<void(size_t)>& decode);
+} // namespace CesiumGltfReader
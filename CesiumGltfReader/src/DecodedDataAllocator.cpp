@@ -0,0 +1,44 @@
+#include "CesiumGltfReader/DecodedDataAllocator.h"
+
+#include "allocateDecodedData.h"
+
+namespace CesiumGltfReader {
+
+std::vector<std::byte>
+DecodedDataAllocator::allocate(DecodedDataKind kind, size_t byteSize) {
+  std::vector<std::byte> result = this->allocateBytes(kind, byteSize);
+  result.resize(byteSize);
+  this->_allocatedBytes[size_t(kind)] += int64_t(byteSize);
+  return result;
+}
+
+int64_t
+DecodedDataAllocator::getAllocatedBytes(DecodedDataKind kind) const noexcept {
+  return this->_allocatedBytes[size_t(kind)];
+}
+
+int64_t DecodedDataAllocator::getTotalAllocatedBytes() const noexcept {
+  int64_t total = 0;
+  for (const std::atomic<int64_t>& bytes : this->_allocatedBytes) {
+    total += bytes;
+  }
+  return total;
+}
+
+std::vector<std::byte> DecodedDataAllocator::allocateBytes(
+    DecodedDataKind /* kind */,
+    size_t byteSize) {
+  return std::vector<std::byte>(byteSize);
+}
+
+std::vector<std::byte> allocateDecodedData(
+    DecodedDataAllocator* pAllocator,
+    DecodedDataKind kind,
+    size_t byteSize) {
+  if (pAllocator) {
+    return pAllocator->allocate(kind, byteSize);
+  }
+  return std::vector<std::byte>(byteSize);
+}
+
+} // namespace CesiumGltfReader
@@ -0,0 +1,101 @@
+#include "CesiumGltfReader/ExternalDataCache.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <cassert>
+
+using namespace CesiumAsync;
+
+namespace CesiumGltfReader {
+
+namespace {
+int64_t computeSizeBytes(const ExternalData& data) noexcept {
+  int64_t bytes = int64_t(data.bufferData.size());
+  if (data.image) {
+    bytes += int64_t(data.image->pixelData.size());
+  }
+  return bytes;
+}
+} // namespace
+
+ExternalDataCache::ExternalDataCache(int64_t maximumBytes) noexcept
+    : _dataOldToRecent(),
+      _dataLookup(),
+      _maximumBytes(maximumBytes),
+      _pCachedBytes(std::make_shared<std::atomic<int64_t>>(0)),
+      _mutex() {}
+
+SharedFuture<std::shared_ptr<const ExternalData>> ExternalDataCache::get(
+    const std::string& key,
+    const std::function<Future<std::shared_ptr<const ExternalData>>()>& load) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto lookupIt = this->_dataLookup.find(key);
+  if (lookupIt != this->_dataLookup.end()) {
+    auto cacheIt = lookupIt->second;
+
+    // Guaranteed not to block because isReady returned true.
+    if (cacheIt->future.isReady() && !cacheIt->future.wait()) {
+      // The previous load failed, so try again.
+      this->_dataLookup.erase(lookupIt);
+      this->_dataOldToRecent.erase(cacheIt);
+    } else {
+      // Move this entry to the end, indicating it's most recently used.
+      this->_dataOldToRecent.splice(
+          this->_dataOldToRecent.end(),
+          this->_dataOldToRecent,
+          cacheIt);
+
+      return cacheIt->future;
+    }
+  }
+
+  Future<std::shared_ptr<const ExternalData>> future = load().thenImmediately(
+      [pCachedBytes = this->_pCachedBytes](
+          std::shared_ptr<const ExternalData>&& pLoaded) {
+        if (pLoaded) {
+          *pCachedBytes += computeSizeBytes(*pLoaded);
+        }
+        return std::move(pLoaded);
+      });
+
+  auto newIt = this->_dataOldToRecent.emplace(
+      this->_dataOldToRecent.end(),
+      CacheEntry{key, std::move(future).share()});
+  this->_dataLookup.emplace(key, newIt);
+
+  SharedFuture<std::shared_ptr<const ExternalData>> result = newIt->future;
+
+  this->unloadCachedData();
+
+  return result;
+}
+
+void ExternalDataCache::unloadCachedData() noexcept {
+  CESIUM_TRACE("ExternalDataCache::unloadCachedData");
+
+  auto it = this->_dataOldToRecent.begin();
+
+  while (it != this->_dataOldToRecent.end() &&
+         *this->_pCachedBytes > this->_maximumBytes) {
+    if (!it->future.isReady()) {
+      // Don't unload data that is still loading.
+      ++it;
+      continue;
+    }
+
+    // Guaranteed not to block because isReady returned true. The data may
+    // still be used by models that are loading, but it's no longer counted
+    // here.
+    const std::shared_ptr<const ExternalData>& pLoaded = it->future.wait();
+    if (pLoaded) {
+      *this->_pCachedBytes -= computeSizeBytes(*pLoaded);
+      assert(*this->_pCachedBytes >= 0);
+    }
+
+    this->_dataLookup.erase(it->key);
+    it = this->_dataOldToRecent.erase(it);
+  }
+}
+
+} // namespace CesiumGltfReader
@@ -1,11 +1,15 @@
 #include "CesiumGltfReader/GltfReader.h"
 
+#include "CesiumGltfReader/ExternalDataCache.h"
+#include "CesiumGltfReader/decodeInParallel.h"
 #include "ModelJsonHandler.h"
+#include "allocateDecodedData.h"
 #include "applyKhrTextureTransform.h"
 #include "decodeDataUrls.h"
 #include "decodeDraco.h"
 #include "decodeMeshOpt.h"
 #include "dequantizeMeshData.h"
+#include "getImageReaderOptions.h"
 #include "registerReaderExtensions.h"
 
 #include <CesiumAsync/IAssetRequest.h>
@@ -23,6 +27,7 @@
 #include <webp/decode.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <iomanip>
 #include <sstream>
@@ -67,7 +72,7 @@ GltfReaderResult readJsonGltf(
     const CesiumJsonReader::JsonReaderOptions& context,
     const gsl::span<const std::byte>& data) {
 
-  CESIUM_TRACE("CesiumGltfReader::GltfReader::readJsonGltf");
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::GltfReader::readJsonGltf");
 
   ModelJsonHandler modelHandler(context);
   CesiumJsonReader::ReadJsonResult<Model> jsonResult =
@@ -99,10 +104,14 @@ std::string toMagicString(uint32_t i) {
   return stream.str();
 }
 
+// Reads a GLB. If pParsedJson is given, it is the result of reading the GLB's
+// JSON chunk, which has already been read while the GLB was streamed.
 GltfReaderResult readBinaryGltf(
     const CesiumJsonReader::JsonReaderOptions& context,
-    const gsl::span<const std::byte>& data) {
-  CESIUM_TRACE("CesiumGltfReader::GltfReader::readBinaryGltf");
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>* pOwnedData = nullptr,
+    GltfReaderResult* pParsedJson = nullptr) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::GltfReader::readBinaryGltf");
 
   if (data.size() < sizeof(GlbHeader) + sizeof(ChunkHeader)) {
     return {std::nullopt, {"Too short to be a valid GLB."}, {}};
@@ -189,7 +198,8 @@ GltfReaderResult readBinaryGltf(
     binaryChunk = glbData.subspan(binaryStart, pBinaryChunkHeader->chunkLength);
   }
 
-  GltfReaderResult result = readJsonGltf(context, jsonChunk);
+  GltfReaderResult result = pParsedJson ? std::move(*pParsedJson)
+                                         : readJsonGltf(context, jsonChunk);
 
   if (result.model && !binaryChunk.empty()) {
     Model& model = result.model.value();
@@ -215,18 +225,284 @@ GltfReaderResult readBinaryGltf(
       return result;
     }
 
-    buffer.cesium.data = std::vector<std::byte>(
-        binaryChunk.begin(),
-        binaryChunk.begin() + buffer.byteLength);
+    if (pOwnedData) {
+      // Reuse the GLB's own allocation for the binary buffer by shifting the
+      // binary chunk to the front, rather than allocating and copying into a
+      // second buffer of nearly the same size.
+      const auto binaryStart = binaryChunk.data() - data.data();
+      std::vector<std::byte> owned = std::move(*pOwnedData);
+      owned.erase(owned.begin(), owned.begin() + binaryStart);
+      owned.resize(static_cast<size_t>(buffer.byteLength));
+      buffer.cesium.data = std::move(owned);
+    } else {
+      buffer.cesium.data = std::vector<std::byte>(
+          binaryChunk.begin(),
+          binaryChunk.begin() + buffer.byteLength);
+    }
   }
 
   return result;
 }
 
+// The state of a GLB that is read while its bytes are still being downloaded.
+// As soon as the JSON chunk has arrived, it is parsed and the model's external
+// buffers and images are requested, and every embedded image is decoded in a
+// worker thread as soon as all of its bytes have arrived.
+struct GlbStream {
+  struct PendingImage {
+    int32_t index;
+    size_t start;
+    size_t end;
+    GltfReaderOptions options;
+  };
+
+  struct DecodedImage {
+    int32_t index;
+    ImageReaderResult result;
+  };
+
+  const GltfReader* pReader;
+  AsyncSystem asyncSystem;
+  std::string uri;
+  std::vector<IAssetAccessor::THeader> headers;
+  std::shared_ptr<IAssetAccessor> pAssetAccessor;
+  GltfReaderOptions options;
+
+  // The bytes received so far, up to the length given in the GLB header.
+  std::vector<std::byte> data{};
+  size_t length = 0;
+
+  // True once the streamed bytes can't be read early, in which case the
+  // complete response is read as usual when the request finishes.
+  bool abandoned = false;
+
+  // Resolves to the model read from the JSON chunk, with its external data,
+  // once the JSON chunk has arrived.
+  std::optional<Future<GltfReaderResult>> maybeModel{};
+
+  std::vector<PendingImage> pendingImages{};
+  std::vector<Future<DecodedImage>> decodedImages{};
+};
+
+void abandonGlbStream(GlbStream& stream) {
+  stream.abandoned = true;
+  stream.data = std::vector<std::byte>();
+  stream.maybeModel.reset();
+  stream.pendingImages.clear();
+  stream.decodedImages.clear();
+}
+
+// Reads the JSON chunk of a streamed GLB, once the JSON chunk has arrived.
+void readGlbStreamJson(GlbStream& stream) {
+  const size_t jsonStart = sizeof(GlbHeader) + sizeof(ChunkHeader);
+  if (stream.data.size() < jsonStart) {
+    return;
+  }
+
+  const ChunkHeader* pJsonChunkHeader = reinterpret_cast<const ChunkHeader*>(
+      stream.data.data() + sizeof(GlbHeader));
+  const size_t jsonEnd = jsonStart + pJsonChunkHeader->chunkLength;
+  if (pJsonChunkHeader->chunkType != 0x4E4F534A || jsonEnd > stream.length) {
+    abandonGlbStream(stream);
+    return;
+  }
+
+  if (stream.data.size() < jsonEnd) {
+    return;
+  }
+
+  GltfReaderResult json = readJsonGltf(
+      stream.pReader->getExtensions(),
+      gsl::span<const std::byte>(stream.data)
+          .subspan(jsonStart, pJsonChunkHeader->chunkLength));
+  if (!json.model) {
+    abandonGlbStream(stream);
+    return;
+  }
+
+  // Images in the binary chunk are decoded early. The chunk's header is only
+  // validated once the whole GLB has arrived, so an image that turns out to
+  // be elsewhere is simply decoded again.
+  const Model& model = *json.model;
+  const size_t binaryStart = jsonEnd + sizeof(ChunkHeader);
+  if (stream.options.decodeEmbeddedImages && !model.buffers.empty() &&
+      !model.buffers[0].uri) {
+    for (size_t i = 0; i < model.images.size(); ++i) {
+      const Image& image = model.images[i];
+      if (image.uri) {
+        continue;
+      }
+
+      const BufferView& bufferView =
+          Model::getSafe(model.bufferViews, image.bufferView);
+      if (bufferView.buffer != 0 || bufferView.byteOffset < 0 ||
+          bufferView.byteLength <= 0) {
+        continue;
+      }
+
+      const size_t start =
+          binaryStart + static_cast<size_t>(bufferView.byteOffset);
+      const size_t end = start + static_cast<size_t>(bufferView.byteLength);
+      if (end <= stream.length) {
+        stream.pendingImages.push_back(
+            GlbStream::PendingImage{
+                static_cast<int32_t>(i),
+                start,
+                end,
+                getImageReaderOptions(model, i, stream.options)});
+      }
+    }
+  }
+
+  stream.maybeModel = GltfReader::resolveExternalData(
+      stream.asyncSystem,
+      stream.uri,
+      HttpHeaders(stream.headers.begin(), stream.headers.end()),
+      stream.pAssetAccessor,
+      stream.options,
+      std::move(json));
+}
+
+// Starts decoding every pending image whose bytes have all arrived.
+void decodeGlbStreamImages(GlbStream& stream) {
+  auto it = std::remove_if(
+      stream.pendingImages.begin(),
+      stream.pendingImages.end(),
+      [&stream](const GlbStream::PendingImage& image) {
+        if (image.end > stream.data.size()) {
+          return false;
+        }
+
+        // The downloaded bytes may still be reallocated as more arrive, so
+        // the decode works on its own copy of the image.
+        std::vector<std::byte> bytes(
+            stream.data.begin() + static_cast<std::ptrdiff_t>(image.start),
+            stream.data.begin() + static_cast<std::ptrdiff_t>(image.end));
+        stream.decodedImages.emplace_back(stream.asyncSystem.runInWorkerThread(
+            [index = image.index,
+             bytes = std::move(bytes),
+             options = image.options]() {
+              if (options.cancellationToken.isCanceled()) {
+                return GlbStream::DecodedImage{index, {}};
+              }
+              return GlbStream::DecodedImage{
+                  index,
+                  GltfReader::readImage(bytes, options)};
+            }));
+        return true;
+      });
+  stream.pendingImages.erase(it, stream.pendingImages.end());
+}
+
+void appendToGlbStream(
+    GlbStream& stream,
+    const gsl::span<const std::byte>& chunk) {
+  if (stream.abandoned) {
+    return;
+  }
+
+  // Bytes past the length in the GLB header are ignored by readBinaryGltf.
+  size_t count = chunk.size();
+  if (stream.length != 0) {
+    count = std::min(count, stream.length - stream.data.size());
+  }
+  stream.data.insert(
+      stream.data.end(),
+      chunk.begin(),
+      chunk.begin() + static_cast<std::ptrdiff_t>(count));
+
+  if (stream.length == 0) {
+    if (stream.data.size() < sizeof(GlbHeader)) {
+      return;
+    }
+
+    const GlbHeader* pHeader =
+        reinterpret_cast<const GlbHeader*>(stream.data.data());
+    if (!isBinaryGltf(stream.data) || pHeader->version != 2) {
+      abandonGlbStream(stream);
+      return;
+    }
+
+    stream.length = pHeader->length;
+    if (stream.data.size() > stream.length) {
+      stream.data.resize(stream.length);
+    }
+  }
+
+  if (!stream.maybeModel) {
+    readGlbStreamJson(stream);
+  }
+
+  if (!stream.abandoned) {
+    decodeGlbStreamImages(stream);
+  }
+}
+
+// Reads a streamed GLB whose JSON chunk has already been read, once all of its
+// bytes have arrived.
+Future<GltfReaderResult>
+finishGlbStream(const std::shared_ptr<GlbStream>& pStream) {
+  Future<GltfReaderResult> model = std::move(*pStream->maybeModel);
+  pStream->maybeModel.reset();
+
+  return pStream->asyncSystem.all(std::move(pStream->decodedImages))
+      .thenInWorkerThread(
+          [pStream, model = std::move(model)](
+              std::vector<GlbStream::DecodedImage>&& decodedImages) mutable {
+            return std::move(model).thenInWorkerThread(
+                [pStream, decodedImages = std::move(decodedImages)](
+                    GltfReaderResult&& json) mutable {
+                  GltfReaderResult result = readBinaryGltf(
+                      pStream->pReader->getExtensions(),
+                      pStream->data,
+                      &pStream->data,
+                      &json);
+                  if (!result.model) {
+                    return result;
+                  }
+
+                  // Images that failed to decode early are decoded again by
+                  // postprocess, which reports why.
+                  std::vector<Image>& images = result.model->images;
+                  for (GlbStream::DecodedImage& decoded : decodedImages) {
+                    if (!decoded.result.image) {
+                      continue;
+                    }
+
+                    images[size_t(decoded.index)].cesium =
+                        std::move(*decoded.result.image);
+                    result.warnings.insert(
+                        result.warnings.end(),
+                        decoded.result.warnings.begin(),
+                        decoded.result.warnings.end());
+                  }
+
+                  return result;
+                });
+          });
+}
+
+// Discards the model if the load has been canceled, returning true if it has.
+bool stopIfCanceled(
+    GltfReaderResult& readGltf,
+    const GltfReaderOptions& options) {
+  if (!options.cancellationToken.isCanceled()) {
+    return false;
+  }
+
+  readGltf.model.reset();
+  readGltf.errors.emplace_back("The glTF load was canceled.");
+  return true;
+}
+
 void postprocess(
     const GltfReader& reader,
     GltfReaderResult& readGltf,
     const GltfReaderOptions& options) {
+  if (stopIfCanceled(readGltf, options)) {
+    return;
+  }
+
   Model& model = readGltf.model.value();
 
   auto extFeatureMetadataIter = std::find(
@@ -246,80 +522,22 @@ void postprocess(
   }
 
   if (options.decodeEmbeddedImages) {
-    CESIUM_TRACE("CesiumGltfReader::decodeEmbeddedImages");
-    for (Image& image : model.images) {
-      // Ignore external images for now.
-      if (image.uri) {
-        continue;
-      }
-
-      // Image has already been decoded
-      if (!image.cesium.pixelData.empty()) {
-        continue;
-      }
-
-      const BufferView& bufferView =
-          Model::getSafe(model.bufferViews, image.bufferView);
-      const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
-
-      if (bufferView.byteOffset + bufferView.byteLength >
-          static_cast<int64_t>(buffer.cesium.data.size())) {
-        readGltf.warnings.emplace_back(
-            "Image bufferView's byte offset is " +
-            std::to_string(bufferView.byteOffset) + " and the byteLength is " +
-            std::to_string(bufferView.byteLength) + ", the result is " +
-            std::to_string(bufferView.byteOffset + bufferView.byteLength) +
-            ", which is more than the available " +
-            std::to_string(buffer.cesium.data.size()) + " bytes.");
-        continue;
-      }
-
-      const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
-      const gsl::span<const std::byte> bufferViewSpan = bufferSpan.subspan(
-          static_cast<size_t>(bufferView.byteOffset),
-          static_cast<size_t>(bufferView.byteLength));
-      ImageReaderResult imageResult =
-          GltfReader::readImage(bufferViewSpan, options.ktx2TranscodeTargets);
-      readGltf.warnings.insert(
-          readGltf.warnings.end(),
-          imageResult.warnings.begin(),
-          imageResult.warnings.end());
-      readGltf.errors.insert(
-          readGltf.errors.end(),
-          imageResult.errors.begin(),
-          imageResult.errors.end());
-      if (imageResult.image) {
-        image.cesium = std::move(imageResult.image.value());
-      } else {
-        if (image.mimeType) {
-          readGltf.errors.emplace_back(
-              "Declared image MIME Type: " + image.mimeType.value());
-        } else {
-          readGltf.errors.emplace_back("Image does not declare a MIME Type");
-        }
-      }
-    }
-
-    // Copy the source property in texture extensions to the main Texture. The
-    // image has already been decoded as necessary, so it's more convenient for
-    // clients to not need to worry about the extension.
-    for (Texture& texture : model.textures) {
-      ExtensionTextureWebp* pWebP =
-          texture.getExtension<ExtensionTextureWebp>();
-      if (pWebP) {
-        texture.source = pWebP->source;
-      }
+    GltfReader::decodeEmbeddedImages(readGltf, options);
+  }
 
-      ExtensionKhrTextureBasisu* pKtx =
-          texture.getExtension<ExtensionKhrTextureBasisu>();
-      if (pKtx) {
-        texture.source = pKtx->source;
-      }
-    }
+  if (stopIfCanceled(readGltf, options)) {
+    return;
   }
 
   if (options.decodeDraco) {
-    decodeDraco(readGltf);
+    decodeDraco(
+        readGltf,
+        options.asyncSystem,
+        options.pDecodedDataAllocator.get());
+  }
+
+  if (stopIfCanceled(readGltf, options)) {
+    return;
   }
 
   if (options.decodeMeshOptData &&
@@ -327,7 +545,11 @@ void postprocess(
           model.extensionsUsed.begin(),
           model.extensionsUsed.end(),
           "EXT_meshopt_compression") != model.extensionsUsed.end()) {
-    decodeMeshOpt(model, readGltf);
+    decodeMeshOpt(
+        model,
+        readGltf,
+        options.asyncSystem,
+        options.pDecodedDataAllocator.get());
   }
 
   if (options.dequantizeMeshData &&
@@ -335,7 +557,7 @@ void postprocess(
           model.extensionsUsed.begin(),
           model.extensionsUsed.end(),
           "KHR_mesh_quantization") != model.extensionsUsed.end()) {
-    dequantizeMeshData(model);
+    dequantizeMeshData(model, options.pDecodedDataAllocator.get());
   }
 
   if (options.applyTextureTransform &&
@@ -343,7 +565,7 @@ void postprocess(
           model.extensionsUsed.begin(),
           model.extensionsUsed.end(),
           "KHR_texture_transform") != model.extensionsUsed.end()) {
-    applyKhrTextureTransform(model);
+    GltfReader::applyTextureTransform(model);
   }
 }
 
@@ -376,15 +598,49 @@ GltfReaderResult GltfReader::readGltf(
   return result;
 }
 
+GltfReaderResult GltfReader::readGltf(
+    std::vector<std::byte>&& data,
+    const GltfReaderOptions& options) const {
+  std::vector<std::byte> owned = std::move(data);
+  const gsl::span<const std::byte> span(owned);
+
+  const CesiumJsonReader::JsonReaderOptions& context = this->getExtensions();
+  GltfReaderResult result = isBinaryGltf(span)
+                                ? readBinaryGltf(context, span, &owned)
+                                : readJsonGltf(context, span);
+
+  if (result.model) {
+    postprocess(*this, result, options);
+  }
+
+  return result;
+}
+
 CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
     const CesiumAsync::AsyncSystem& asyncSystem,
     const std::string& uri,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const GltfReaderOptions& options) const {
-  return pAssetAccessor->get(asyncSystem, uri, headers)
+  auto pStream = std::make_shared<GlbStream>(GlbStream{
+      this,
+      asyncSystem,
+      uri,
+      headers,
+      pAssetAccessor,
+      options});
+
+  return pAssetAccessor
+      ->getStreaming(
+          asyncSystem,
+          uri,
+          headers,
+          options.cancellationToken,
+          [pStream](const gsl::span<const std::byte>& data) {
+            appendToGlbStream(*pStream, data);
+          })
       .thenInWorkerThread(
-          [this, options, asyncSystem, pAssetAccessor, uri](
+          [this, options, asyncSystem, pAssetAccessor, uri, pStream](
               std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
             const CesiumAsync::IAssetResponse* pResponse = pRequest->response();
 
@@ -406,6 +662,10 @@ CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
                   {}});
             }
 
+            if (pStream->maybeModel) {
+              return finishGlbStream(pStream);
+            }
+
             const CesiumJsonReader::JsonReaderOptions& context =
                 this->getExtensions();
             GltfReaderResult result =
@@ -426,7 +686,9 @@ CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
                 std::move(result));
           })
       .thenInWorkerThread([options, this](GltfReaderResult&& result) {
-        postprocess(*this, result, options);
+        if (result.model) {
+          postprocess(*this, result, options);
+        }
         return std::move(result);
       });
 }
@@ -439,6 +701,79 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
   }
 }
 
+namespace {
+struct ExternalBufferLoadResult {
+  bool success = false;
+  std::string bufferUri;
+};
+
+Future<std::shared_ptr<const ExternalData>> requestExternalBuffer(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  return pAssetAccessor->get(asyncSystem, url, headers)
+      .thenInWorkerThread([](std::shared_ptr<IAssetRequest>&& pRequest) {
+        std::shared_ptr<const ExternalData> pResult;
+        const IAssetResponse* pResponse = pRequest->response();
+        if (pResponse) {
+          ExternalData data;
+          data.bufferData = std::vector<std::byte>(
+              pResponse->data().begin(),
+              pResponse->data().end());
+          pResult = std::make_shared<const ExternalData>(std::move(data));
+        }
+        return pResult;
+      });
+}
+
+Future<std::shared_ptr<const ExternalData>> requestExternalImage(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const GltfReaderOptions& imageOptions) {
+  return pAssetAccessor->get(asyncSystem, url, headers)
+      .thenInWorkerThread(
+          [imageOptions](std::shared_ptr<IAssetRequest>&& pRequest) {
+            std::shared_ptr<const ExternalData> pResult;
+            const IAssetResponse* pResponse = pRequest->response();
+            if (pResponse) {
+              ImageReaderResult imageResult =
+                  GltfReader::readImage(pResponse->data(), imageOptions);
+              if (imageResult.image) {
+                ExternalData data;
+                data.image = std::move(imageResult.image);
+                pResult =
+                    std::make_shared<const ExternalData>(std::move(data));
+              }
+            }
+            return pResult;
+          });
+}
+
+// Identifies an external image by its URL and by the options that affect how
+// it is decoded, so that models that read it differently don't share it.
+std::string
+getImageCacheKey(const std::string& url, const GltfReaderOptions& options) {
+  const Ktx2TranscodeTargets& targets = options.ktx2TranscodeTargets;
+  return fmt::format(
+      "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+      url,
+      options.maximumImageDimension,
+      options.maximumKtx2Dimension,
+      options.decodeOpaqueImagesToRgb,
+      int(targets.ETC1S_R),
+      int(targets.ETC1S_RG),
+      int(targets.ETC1S_RGB),
+      int(targets.ETC1S_RGBA),
+      int(targets.UASTC_R),
+      int(targets.UASTC_RG),
+      int(targets.UASTC_RGB),
+      int(targets.UASTC_RGBA));
+}
+} // namespace
+
 /*static*/ Future<GltfReaderResult> GltfReader::resolveExternalData(
     AsyncSystem asyncSystem,
     const std::string& baseUrl,
@@ -475,11 +810,6 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
 
   auto pResult = std::make_unique<GltfReaderResult>(std::move(result));
 
-  struct ExternalBufferLoadResult {
-    bool success = false;
-    std::string bufferUri;
-  };
-
   std::vector<Future<ExternalBufferLoadResult>> resolvedBuffers;
   resolvedBuffers.reserve(uriBuffersCount);
 
@@ -487,11 +817,47 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
   constexpr std::string_view dataPrefix = "data:";
   constexpr size_t dataPrefixLength = dataPrefix.size();
 
+  const std::shared_ptr<ExternalDataCache>& pCache =
+      options.pExternalDataCache;
+
   for (Buffer& buffer : pResult->model->buffers) {
-    if (buffer.uri && buffer.uri->substr(0, dataPrefixLength) != dataPrefix) {
+    if (!buffer.uri || buffer.uri->substr(0, dataPrefixLength) == dataPrefix) {
+      continue;
+    }
+
+    if (pCache) {
+      const std::string url = Uri::resolve(baseUrl, *buffer.uri);
+      resolvedBuffers.push_back(
+          pCache
+              ->get(
+                  url,
+                  [&asyncSystem, &pAssetAccessor, &url, &tHeaders]() {
+                    return requestExternalBuffer(
+                        asyncSystem,
+                        pAssetAccessor,
+                        url,
+                        tHeaders);
+                  })
+              .thenInWorkerThread(
+                  [pBuffer = &buffer](
+                      const std::shared_ptr<const ExternalData>& pData) {
+                    std::string bufferUri = *pBuffer->uri;
+                    if (pData) {
+                      pBuffer->uri = std::nullopt;
+                      pBuffer->cesium.data = pData->bufferData;
+                      return ExternalBufferLoadResult{true, bufferUri};
+                    }
+
+                    return ExternalBufferLoadResult{false, bufferUri};
+                  }));
+    } else {
       resolvedBuffers.push_back(
           pAssetAccessor
-              ->get(asyncSystem, Uri::resolve(baseUrl, *buffer.uri), tHeaders)
+              ->getWithCancellation(
+                  asyncSystem,
+                  Uri::resolve(baseUrl, *buffer.uri),
+                  tHeaders,
+                  options.cancellationToken)
               .thenInWorkerThread(
                   [pBuffer =
                        &buffer](std::shared_ptr<IAssetRequest>&& pRequest) {
@@ -512,24 +878,78 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
     }
   }
 
-  for (Image& image : pResult->model->images) {
-    if (image.uri && image.uri->substr(0, dataPrefixLength) != dataPrefix) {
+  for (size_t i = 0; i < pResult->model->images.size(); ++i) {
+    Image& image = pResult->model->images[i];
+    if (!image.uri || image.uri->substr(0, dataPrefixLength) == dataPrefix) {
+      continue;
+    }
+
+    if (pCache) {
+      const std::string url = Uri::resolve(baseUrl, *image.uri);
+      GltfReaderOptions imageOptions =
+          getImageReaderOptions(*pResult->model, i, options);
+      const std::string key = getImageCacheKey(url, imageOptions);
+
+      // The shared load is not canceled with this model, because other models
+      // may need it too.
+      CancellationToken cancellationToken = imageOptions.cancellationToken;
+      imageOptions.cancellationToken = CancellationToken();
+      imageOptions.pExternalDataCache = nullptr;
+
+      resolvedBuffers.push_back(
+          pCache
+              ->get(
+                  key,
+                  [&asyncSystem,
+                   &pAssetAccessor,
+                   &url,
+                   &tHeaders,
+                   &imageOptions]() {
+                    return requestExternalImage(
+                        asyncSystem,
+                        pAssetAccessor,
+                        url,
+                        tHeaders,
+                        imageOptions);
+                  })
+              .thenInWorkerThread(
+                  [pImage = &image, cancellationToken](
+                      const std::shared_ptr<const ExternalData>& pData) {
+                    std::string imageUri = *pImage->uri;
+                    if (pData && pData->image &&
+                        !cancellationToken.isCanceled()) {
+                      pImage->uri = std::nullopt;
+                      pImage->cesium = *pData->image;
+                      return ExternalBufferLoadResult{true, imageUri};
+                    }
+
+                    return ExternalBufferLoadResult{false, imageUri};
+                  }));
+    } else {
       resolvedBuffers.push_back(
           pAssetAccessor
-              ->get(asyncSystem, Uri::resolve(baseUrl, *image.uri), tHeaders)
+              ->getWithCancellation(
+                  asyncSystem,
+                  Uri::resolve(baseUrl, *image.uri),
+                  tHeaders,
+                  options.cancellationToken)
               .thenInWorkerThread(
                   [pImage = &image,
-                   ktx2TranscodeTargets = options.ktx2TranscodeTargets](
+                   imageOptions =
+                       getImageReaderOptions(*pResult->model, i, options)](
                       std::shared_ptr<IAssetRequest>&& pRequest) {
                     const IAssetResponse* pResponse = pRequest->response();
 
                     std::string imageUri = *pImage->uri;
 
-                    if (pResponse) {
+                    // Don't decode or transcode an image that is no longer
+                    // needed.
+                    if (pResponse &&
+                        !imageOptions.cancellationToken.isCanceled()) {
                       pImage->uri = std::nullopt;
 
                       ImageReaderResult imageResult =
-                          readImage(pResponse->data(), ktx2TranscodeTargets);
+                          readImage(pResponse->data(), imageOptions);
                       if (imageResult.image) {
                         pImage->cesium = std::move(*imageResult.image);
                         return ExternalBufferLoadResult{true, imageUri};
@@ -556,6 +976,117 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
           });
 }
 
+namespace {
+// Reduces the given JPEG dimensions by the mildest of libjpeg-turbo's scaling
+// factors that makes them fit within the maximum, or by its strongest factor if
+// none does. The decompressor scales while it decodes, which is much faster
+// than decoding at full size and resizing afterward.
+void scaleJpegToFit(int& width, int& height, int32_t maximumDimension) {
+  if (maximumDimension <= 0 ||
+      (width <= maximumDimension && height <= maximumDimension)) {
+    return;
+  }
+
+  int numberOfFactors = 0;
+  const tjscalingfactor* pFactors = tjGetScalingFactors(&numberOfFactors);
+  if (!pFactors) {
+    return;
+  }
+
+  int fitWidth = 0;
+  int fitHeight = 0;
+  int smallestWidth = width;
+  int smallestHeight = height;
+  for (int i = 0; i < numberOfFactors; ++i) {
+    const tjscalingfactor factor = pFactors[i];
+    if (factor.num >= factor.denom) {
+      continue;
+    }
+
+    const int scaledWidth = TJSCALED(width, factor);
+    const int scaledHeight = TJSCALED(height, factor);
+    if (scaledWidth <= maximumDimension && scaledHeight <= maximumDimension &&
+        scaledWidth > fitWidth) {
+      fitWidth = scaledWidth;
+      fitHeight = scaledHeight;
+    }
+
+    if (scaledWidth < smallestWidth) {
+      smallestWidth = scaledWidth;
+      smallestHeight = scaledHeight;
+    }
+  }
+
+  width = fitWidth > 0 ? fitWidth : smallestWidth;
+  height = fitWidth > 0 ? fitHeight : smallestHeight;
+}
+
+// Resizes a decoded 8-bit image without mipmaps so that neither its width nor
+// its height exceeds the maximum, preserving its aspect ratio.
+void downscaleToFit(
+    ImageCesium& image,
+    int32_t maximumDimension,
+    DecodedDataAllocator* pAllocator) {
+  if (maximumDimension <= 0 ||
+      (image.width <= maximumDimension && image.height <= maximumDimension) ||
+      image.bytesPerChannel != 1 || !image.mipPositions.empty()) {
+    return;
+  }
+
+  CESIUM_TRACE_CATEGORY(Decode, "Downscale image");
+  const double scale = static_cast<double>(maximumDimension) /
+                       static_cast<double>(std::max(image.width, image.height));
+  const int32_t width = std::clamp(
+      static_cast<int32_t>(std::lround(image.width * scale)),
+      1,
+      maximumDimension);
+  const int32_t height = std::clamp(
+      static_cast<int32_t>(std::lround(image.height * scale)),
+      1,
+      maximumDimension);
+
+  std::vector<std::byte> pixelData = allocateDecodedData(
+      pAllocator,
+      DecodedDataKind::Image,
+      static_cast<size_t>(width * height * image.channels));
+  if (!stbir_resize_uint8(
+          reinterpret_cast<const unsigned char*>(image.pixelData.data()),
+          image.width,
+          image.height,
+          0,
+          reinterpret_cast<unsigned char*>(pixelData.data()),
+          width,
+          height,
+          0,
+          image.channels)) {
+    return;
+  }
+
+  image.width = width;
+  image.height = height;
+  image.pixelData = std::move(pixelData);
+}
+
+// Counts the largest mip levels of a KTX2 image that must be discarded for the
+// rest to fit within the maximum dimension. The smallest level is always kept.
+size_t countKtx2LevelsToSkip(
+    int32_t width,
+    int32_t height,
+    size_t levelCount,
+    int32_t maximumDimension) {
+  if (maximumDimension <= 0) {
+    return 0;
+  }
+
+  size_t skip = 0;
+  while (skip + 1 < levelCount &&
+         std::max(width >> skip, height >> skip) > maximumDimension) {
+    ++skip;
+  }
+  return skip;
+}
+} // namespace
+
 bool isKtx(const gsl::span<const std::byte>& data) {
   const size_t ktxMagicByteLength = 12;
   if (data.size() < ktxMagicByteLength) {
@@ -581,7 +1112,18 @@ bool isWebP(const gsl::span<const std::byte>& data) {
 ImageReaderResult GltfReader::readImage(
     const gsl::span<const std::byte>& data,
     const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
-  CESIUM_TRACE("CesiumGltfReader::readImage");
+  GltfReaderOptions options;
+  options.ktx2TranscodeTargets = ktx2TranscodeTargets;
+  return GltfReader::readImage(data, options);
+}
+
+ImageReaderResult GltfReader::readImage(
+    const gsl::span<const std::byte>& data,
+    const GltfReaderOptions& options) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::readImage");
+
+  const Ktx2TranscodeTargets& ktx2TranscodeTargets =
+      options.ktx2TranscodeTargets;
 
   ImageReaderResult result;
 
@@ -601,7 +1143,7 @@ ImageReaderResult GltfReader::readImage(
     if (errorCode == KTX_SUCCESS) {
       if (ktxTexture2_NeedsTranscoding(pTexture)) {
 
-        CESIUM_TRACE("Transcode KTXv2");
+        CESIUM_TRACE_CATEGORY(Decode, "Transcode KTXv2");
 
         image.channels =
             static_cast<int32_t>(ktxTexture2_GetNumComponents(pTexture));
@@ -756,15 +1298,48 @@ ImageReaderResult GltfReader::readImage(
             assert(pTexture->numLevels == 1);
           }
 
-          // Copy over the entire buffer, including all mips.
+          // Copy over the entire buffer, including all mips, unless the
+          // largest mips are discarded to fit the maximum dimension.
           ktx_uint8_t* pixelData = ktxTexture_GetData(ktxTexture(pTexture));
-          ktx_size_t pixelDataSize =
-              ktxTexture_GetDataSize(ktxTexture(pTexture));
+          size_t pixelDataBegin = 0;
+          size_t pixelDataEnd = ktxTexture_GetDataSize(ktxTexture(pTexture));
+
+          const size_t firstLevel = countKtx2LevelsToSkip(
+              image.width,
+              image.height,
+              image.mipPositions.size(),
+              options.maximumKtx2Dimension);
+          if (firstLevel > 0) {
+            image.mipPositions.erase(
+                image.mipPositions.begin(),
+                image.mipPositions.begin() + std::ptrdiff_t(firstLevel));
+            image.width = std::max(image.width >> firstLevel, 1);
+            image.height = std::max(image.height >> firstLevel, 1);
+
+            // The remaining mips are contiguous, but KTX2 stores the smallest
+            // mip first, so find their range rather than assuming an order.
+            pixelDataBegin = pixelDataEnd;
+            pixelDataEnd = 0;
+            for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+              pixelDataBegin = std::min(pixelDataBegin, mip.byteOffset);
+              pixelDataEnd =
+                  std::max(pixelDataEnd, mip.byteOffset + mip.byteSize);
+            }
+            for (ImageCesiumMipPosition& mip : image.mipPositions) {
+              mip.byteOffset -= pixelDataBegin;
+            }
+          }
 
-          image.pixelData.resize(pixelDataSize);
+          image.pixelData = allocateDecodedData(
+              options.pDecodedDataAllocator.get(),
+              DecodedDataKind::Ktx2,
+              pixelDataEnd - pixelDataBegin);
           std::uint8_t* u8Pointer =
               reinterpret_cast<std::uint8_t*>(image.pixelData.data());
-          std::copy(pixelData, pixelData + pixelDataSize, u8Pointer);
+          std::copy(
+              pixelData + pixelDataBegin,
+              pixelData + pixelDataEnd,
+              u8Pointer);
 
           ktxTexture_Destroy(ktxTexture(pTexture));
 
@@ -780,17 +1355,25 @@ ImageReaderResult GltfReader::readImage(
 
     return result;
   } else if (isWebP(data)) {
-    if (WebPGetInfo(
+    WebPBitstreamFeatures features;
+    if (WebPGetFeatures(
             reinterpret_cast<const uint8_t*>(data.data()),
             data.size(),
-            &image.width,
-            &image.height)) {
-      image.channels = 4;
+            &features) == VP8_STATUS_OK) {
+      image.width = features.width;
+      image.height = features.height;
+      image.channels =
+          options.decodeOpaqueImagesToRgb && !features.has_alpha ? 3 : 4;
       image.bytesPerChannel = 1;
       uint8_t* pImage = NULL;
       const auto bufferSize = image.width * image.height * image.channels;
-      image.pixelData.resize(static_cast<std::size_t>(bufferSize));
-      pImage = WebPDecodeRGBAInto(
+      image.pixelData = allocateDecodedData(
+          options.pDecodedDataAllocator.get(),
+          DecodedDataKind::Image,
+          static_cast<std::size_t>(bufferSize));
+      const auto decodeInto =
+          image.channels == 3 ? WebPDecodeRGBInto : WebPDecodeRGBAInto;
+      pImage = decodeInto(
           reinterpret_cast<const uint8_t*>(data.data()),
           data.size(),
           reinterpret_cast<uint8_t*>(image.pixelData.data()),
@@ -799,6 +1382,11 @@ ImageReaderResult GltfReader::readImage(
       if (!pImage) {
         result.image.reset();
         result.errors.emplace_back("Unable to decode WebP");
+      } else {
+        downscaleToFit(
+            image,
+            options.maximumImageDimension,
+            options.pDecodedDataAllocator.get());
       }
       return result;
     }
@@ -815,12 +1403,17 @@ ImageReaderResult GltfReader::readImage(
             &image.height,
             &inSubsamp,
             &inColorspace)) {
-      CESIUM_TRACE("Decode JPG");
+      CESIUM_TRACE_CATEGORY(Decode, "Decode JPG");
       image.bytesPerChannel = 1;
-      image.channels = 4;
+      // A JPEG never has an alpha channel.
+      image.channels = options.decodeOpaqueImagesToRgb ? 3 : 4;
+      scaleJpegToFit(image.width, image.height, options.maximumImageDimension);
       const auto lastByte =
           image.width * image.height * image.channels * image.bytesPerChannel;
-      image.pixelData.resize(static_cast<std::size_t>(lastByte));
+      image.pixelData = allocateDecodedData(
+          options.pDecodedDataAllocator.get(),
+          DecodedDataKind::Image,
+          static_cast<std::size_t>(lastByte));
       if (tjDecompress2(
               tjInstance,
               reinterpret_cast<const unsigned char*>(data.data()),
@@ -829,17 +1422,33 @@ ImageReaderResult GltfReader::readImage(
               image.width,
               0,
               image.height,
-              TJPF_RGBA,
+              image.channels == 3 ? TJPF_RGB : TJPF_RGBA,
               0)) {
         result.errors.emplace_back("Unable to decode JPEG");
         result.image.reset();
+      } else {
+        downscaleToFit(
+            image,
+            options.maximumImageDimension,
+            options.pDecodedDataAllocator.get());
       }
     } else {
-      CESIUM_TRACE("Decode PNG");
+      CESIUM_TRACE_CATEGORY(Decode, "Decode PNG");
       image.bytesPerChannel = 1;
       image.channels = 4;
 
       int channelsInFile;
+      if (options.decodeOpaqueImagesToRgb &&
+          stbi_info_from_memory(
+              reinterpret_cast<const stbi_uc*>(data.data()),
+              static_cast<int>(data.size()),
+              &image.width,
+              &image.height,
+              &channelsInFile) &&
+          (channelsInFile == 1 || channelsInFile == 3)) {
+        image.channels = 3;
+      }
+
       stbi_uc* pImage = stbi_load_from_memory(
           reinterpret_cast<const stbi_uc*>(data.data()),
           static_cast<int>(data.size()),
@@ -848,7 +1457,8 @@ ImageReaderResult GltfReader::readImage(
           &channelsInFile,
           image.channels);
       if (pImage) {
-        CESIUM_TRACE(
+        CESIUM_TRACE_CATEGORY(
+            Decode,
             "copy image " + std::to_string(image.width) + "x" +
             std::to_string(image.height) + "x" +
             std::to_string(image.channels) + "x" +
@@ -857,11 +1467,18 @@ ImageReaderResult GltfReader::readImage(
         // use reinterpret_cast to (safely) force the conversion.
         const auto lastByte =
             image.width * image.height * image.channels * image.bytesPerChannel;
-        image.pixelData.resize(static_cast<std::size_t>(lastByte));
+        image.pixelData = allocateDecodedData(
+            options.pDecodedDataAllocator.get(),
+            DecodedDataKind::Image,
+            static_cast<std::size_t>(lastByte));
         std::uint8_t* u8Pointer =
             reinterpret_cast<std::uint8_t*>(image.pixelData.data());
         std::copy(pImage, pImage + lastByte, u8Pointer);
         stbi_image_free(pImage);
+        downscaleToFit(
+            image,
+            options.maximumImageDimension,
+            options.pDecodedDataAllocator.get());
       } else {
         result.image.reset();
         result.errors.emplace_back(stbi_failure_reason());
@@ -873,7 +1490,175 @@ ImageReaderResult GltfReader::readImage(
 }
 
 /*static*/
-std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
+void GltfReader::decodeEmbeddedImages(
+    GltfReaderResult& readGltf,
+    const GltfReaderOptions& options) {
+  if (!readGltf.model) {
+    return;
+  }
+
+  Model& model = readGltf.model.value();
+
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::decodeEmbeddedImages");
+
+  // Decoding only reads the model, so images are decoded in parallel and
+  // the results are copied into the model afterward, in order.
+  struct ImageJob {
+    Image* pImage;
+    gsl::span<const std::byte> data;
+    GltfReaderOptions options;
+    ImageReaderResult result;
+  };
+
+  std::vector<ImageJob> jobs;
+  for (size_t i = 0; i < model.images.size(); ++i) {
+    Image& image = model.images[i];
+    // Ignore external images for now.
+    if (image.uri) {
+      continue;
+    }
+
+    // Image has already been decoded
+    if (!image.cesium.pixelData.empty()) {
+      continue;
+    }
+
+    const BufferView& bufferView =
+        Model::getSafe(model.bufferViews, image.bufferView);
+    const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
+
+    if (bufferView.byteOffset + bufferView.byteLength >
+        static_cast<int64_t>(buffer.cesium.data.size())) {
+      readGltf.warnings.emplace_back(
+          "Image bufferView's byte offset is " +
+          std::to_string(bufferView.byteOffset) + " and the byteLength is " +
+          std::to_string(bufferView.byteLength) + ", the result is " +
+          std::to_string(bufferView.byteOffset + bufferView.byteLength) +
+          ", which is more than the available " +
+          std::to_string(buffer.cesium.data.size()) + " bytes.");
+      continue;
+    }
+
+    const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
+    const gsl::span<const std::byte> bufferViewSpan = bufferSpan.subspan(
+        static_cast<size_t>(bufferView.byteOffset),
+        static_cast<size_t>(bufferView.byteLength));
+    jobs.emplace_back(ImageJob{
+        &image,
+        bufferViewSpan,
+        getImageReaderOptions(model, i, options),
+        {}});
+  }
+
+  decodeInParallel(
+      jobs.size(),
+      options.asyncSystem,
+      options.maximumSimultaneousImageDecodes,
+      [&jobs, &options](size_t i) {
+        // Don't decode images that are no longer needed.
+        if (options.cancellationToken.isCanceled()) {
+          return;
+        }
+
+        ImageJob& job = jobs[i];
+        try {
+          job.result = GltfReader::readImage(job.data, job.options);
+        } catch (const std::exception& e) {
+          job.result.errors.emplace_back(
+              std::string("Image decoding failed: ") + e.what());
+        }
+      });
+
+  if (stopIfCanceled(readGltf, options)) {
+    return;
+  }
+
+  for (ImageJob& job : jobs) {
+    ImageReaderResult& imageResult = job.result;
+    readGltf.warnings.insert(
+        readGltf.warnings.end(),
+        imageResult.warnings.begin(),
+        imageResult.warnings.end());
+    readGltf.errors.insert(
+        readGltf.errors.end(),
+        imageResult.errors.begin(),
+        imageResult.errors.end());
+    if (imageResult.image) {
+      job.pImage->cesium = std::move(imageResult.image.value());
+    } else {
+      if (job.pImage->mimeType) {
+        readGltf.errors.emplace_back(
+            "Declared image MIME Type: " + job.pImage->mimeType.value());
+      } else {
+        readGltf.errors.emplace_back("Image does not declare a MIME Type");
+      }
+    }
+  }
+
+  // Copy the source property in texture extensions to the main Texture. The
+  // image has already been decoded as necessary, so it's more convenient for
+  // clients to not need to worry about the extension.
+  for (Texture& texture : model.textures) {
+    ExtensionTextureWebp* pWebP =
+        texture.getExtension<ExtensionTextureWebp>();
+    if (pWebP) {
+      texture.source = pWebP->source;
+    }
+
+    ExtensionKhrTextureBasisu* pKtx =
+        texture.getExtension<ExtensionKhrTextureBasisu>();
+    if (pKtx) {
+      texture.source = pKtx->source;
+    }
+  }
+}
+
+namespace {
+// Computes a mip level from the previous one by averaging each 2x2 block of
+// texels. A dimension of 1 in the source is repeated rather than halved. The
+// inner loop has no branches, so compilers vectorize it.
+void boxFilterMipLevel(
+    const uint8_t* pSource,
+    int32_t sourceWidth,
+    int32_t sourceHeight,
+    uint8_t* pTarget,
+    int32_t targetWidth,
+    int32_t targetHeight,
+    int32_t channels) {
+  const size_t sourceRowSize = size_t(sourceWidth) * size_t(channels);
+  const size_t targetRowSize = size_t(targetWidth) * size_t(channels);
+  const size_t nextColumn = sourceWidth > 1 ? size_t(channels) : 0;
+  const size_t nextRow = sourceHeight > 1 ? sourceRowSize : 0;
+  const size_t columnStep = sourceWidth > 1 ? 2 : 1;
+  const size_t rowStep = sourceHeight > 1 ? 2 : 1;
+  const size_t channelCount = size_t(channels);
+
+  for (size_t y = 0; y < size_t(targetHeight); ++y) {
+    const uint8_t* pRow0 = pSource + y * rowStep * sourceRowSize;
+    const uint8_t* pRow1 = pRow0 + nextRow;
+    uint8_t* pTargetRow = pTarget + y * targetRowSize;
+    for (size_t x = 0; x < size_t(targetWidth); ++x) {
+      const size_t source = x * columnStep * channelCount;
+      for (size_t c = 0; c < channelCount; ++c) {
+        const uint32_t sum =
+            uint32_t(pRow0[source + c]) +
+            uint32_t(pRow0[source + nextColumn + c]) +
+            uint32_t(pRow1[source + c]) +
+            uint32_t(pRow1[source + nextColumn + c]);
+        pTargetRow[x * channelCount + c] = uint8_t((sum + 2) >> 2);
+      }
+    }
+  }
+}
+} // namespace
+
+/*static*/
+void GltfReader::applyTextureTransform(Model& model) {
+  applyKhrTextureTransform(model);
+}
+
+std::optional<std::string>
+GltfReader::generateMipMaps(ImageCesium& image, MipMapFilter filter) {
   if (!image.mipPositions.empty() ||
       image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
     // No error message needed, since this is not technically a failure.
@@ -884,7 +1669,8 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
     return "Unable to generate mipmaps, an empty image was provided.";
   }
 
-  CESIUM_TRACE(
+  CESIUM_TRACE_CATEGORY(
+      Decode,
       "generate mipmaps " + std::to_string(image.width) + "x" +
       std::to_string(image.height) + "x" + std::to_string(image.channels) +
       "x" + std::to_string(image.bytesPerChannel));
@@ -945,17 +1731,27 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
     image.mipPositions[mipIndex].byteOffset = byteOffset;
     image.mipPositions[mipIndex].byteSize = byteSize;
 
-    if (!stbir_resize_uint8(
-            reinterpret_cast<const unsigned char*>(
-                &image.pixelData[lastByteOffset]),
-            lastWidth,
-            lastHeight,
-            0,
-            reinterpret_cast<unsigned char*>(&image.pixelData[byteOffset]),
-            mipWidth,
-            mipHeight,
-            0,
-            image.channels)) {
+    if (filter == MipMapFilter::Box && image.bytesPerChannel == 1) {
+      boxFilterMipLevel(
+          reinterpret_cast<const uint8_t*>(&image.pixelData[lastByteOffset]),
+          lastWidth,
+          lastHeight,
+          reinterpret_cast<uint8_t*>(&image.pixelData[byteOffset]),
+          mipWidth,
+          mipHeight,
+          image.channels);
+    } else if (!stbir_resize_uint8(
+                   reinterpret_cast<const unsigned char*>(
+                       &image.pixelData[lastByteOffset]),
+                   lastWidth,
+                   lastHeight,
+                   0,
+                   reinterpret_cast<unsigned char*>(
+                       &image.pixelData[byteOffset]),
+                   mipWidth,
+                   mipHeight,
+                   0,
+                   image.channels)) {
       // Remove any added mipmaps.
       image.mipPositions.clear();
       image.pixelData.resize(imageByteSize);
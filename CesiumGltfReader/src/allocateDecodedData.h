@@ -0,0 +1,17 @@
+#pragma once
+
+#include <CesiumGltfReader/DecodedDataAllocator.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace CesiumGltfReader {
+/**
+ * Allocates a vector of the given size for decoded data from the allocator, or
+ * creates a new vector if the allocator is nullptr.
+ */
+std::vector<std::byte> allocateDecodedData(
+    DecodedDataAllocator* pAllocator,
+    DecodedDataKind kind,
+    size_t byteSize);
+} // namespace CesiumGltfReader
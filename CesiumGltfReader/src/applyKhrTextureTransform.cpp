@@ -5,19 +5,18 @@
 #include <CesiumGltf/KhrTextureTransform.h>
 #include <CesiumGltfReader/GltfReader.h>
 
+#include <map>
+#include <tuple>
+#include <vector>
+
 using namespace CesiumGltf;
 
 namespace CesiumGltfReader {
 namespace {
-bool transformBufferView(
+void transformBufferView(
     const AccessorView<glm::vec2>& accessorView,
     std::vector<std::byte>& data,
-    const ExtensionKhrTextureTransform& textureTransformExtension) {
-  KhrTextureTransform textureTransform(textureTransformExtension);
-  if (textureTransform.status() != KhrTextureTransformStatus::Valid) {
-    return false;
-  }
-
+    const KhrTextureTransform& textureTransform) {
   glm::vec2* transformedUvs = reinterpret_cast<glm::vec2*>(data.data());
 
   for (int i = 0; i < accessorView.size(); i++) {
@@ -26,16 +25,32 @@ bool transformBufferView(
     *transformedUvs = glm::vec2(transformedUv.x, transformedUv.y);
     transformedUvs++;
   }
+}
 
-  return true;
+// Identifies a texture coordinate accessor transformed by a particular
+// transform, so that primitives and textures sharing both share the result.
+using TransformedAccessorKey =
+    std::tuple<int32_t, double, double, double, double, double>;
+
+TransformedAccessorKey getTransformedAccessorKey(
+    int32_t accessor,
+    const KhrTextureTransform& textureTransform) {
+  return TransformedAccessorKey(
+      accessor,
+      textureTransform.offset().x,
+      textureTransform.offset().y,
+      textureTransform.rotation(),
+      textureTransform.scale().x,
+      textureTransform.scale().y);
 }
-} // namespace
 
 template <typename T>
 void processTextureInfo(
     Model& model,
     MeshPrimitive& primitive,
-    std::optional<T>& maybeTextureInfo) {
+    std::optional<T>& maybeTextureInfo,
+    std::map<TransformedAccessorKey, int32_t>& transformedAccessors,
+    std::vector<TextureInfo*>& appliedTextureInfos) {
   static_assert(std::is_base_of<TextureInfo, T>::value);
   if (!maybeTextureInfo) {
     return;
@@ -54,6 +69,20 @@ void processTextureInfo(
     return;
   }
 
+  KhrTextureTransform textureTransform(*pTextureTransform);
+  if (textureTransform.status() != KhrTextureTransformStatus::Valid) {
+    return;
+  }
+
+  const TransformedAccessorKey key =
+      getTransformedAccessorKey(find->second, textureTransform);
+  auto transformedIt = transformedAccessors.find(key);
+  if (transformedIt != transformedAccessors.end()) {
+    find->second = transformedIt->second;
+    appliedTextureInfos.emplace_back(&*maybeTextureInfo);
+    return;
+  }
+
   const Accessor* pAccessor = Model::getSafe(&model.accessors, find->second);
   if (!pAccessor) {
     return;
@@ -70,11 +99,9 @@ void processTextureInfo(
     return;
   }
 
-  std::vector<std::byte> data(static_cast<size_t>(pBufferView->byteLength));
-  bool success = transformBufferView(accessorView, data, *pTextureTransform);
-  if (!success) {
-    return;
-  }
+  std::vector<std::byte> data(
+      static_cast<size_t>(accessorView.size()) * sizeof(glm::vec2));
+  transformBufferView(accessorView, data, textureTransform);
 
   Buffer& buffer = model.buffers.emplace_back();
   buffer.byteLength = static_cast<int64_t>(data.size());
@@ -84,6 +111,7 @@ void processTextureInfo(
   bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
   bufferView.byteLength = buffer.byteLength;
   bufferView.byteOffset = 0;
+  bufferView.byteStride.reset();
 
   Accessor& accessor = model.accessors.emplace_back(*pAccessor);
   accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
@@ -91,32 +119,65 @@ void processTextureInfo(
   accessor.count = accessorView.size();
   accessor.type = Accessor::Type::VEC2;
   accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.normalized = false;
+  accessor.min.clear();
+  accessor.max.clear();
 
   find->second = static_cast<int32_t>(model.accessors.size() - 1);
-
-  // Erase the extension so it is not re-applied by client implementations.
-  maybeTextureInfo->extensions.erase(
-      ExtensionKhrTextureTransform::ExtensionName);
+  transformedAccessors.emplace(key, find->second);
+  appliedTextureInfos.emplace_back(&*maybeTextureInfo);
 }
+} // namespace
 
 void applyKhrTextureTransform(Model& model) {
+  std::map<TransformedAccessorKey, int32_t> transformedAccessors;
+  std::vector<TextureInfo*> appliedTextureInfos;
+
   for (Mesh& mesh : model.meshes) {
     for (MeshPrimitive& primitive : mesh.primitives) {
       Material* material = Model::getSafe(&model.materials, primitive.material);
       if (material) {
+        if (material->pbrMetallicRoughness) {
+          processTextureInfo(
+              model,
+              primitive,
+              material->pbrMetallicRoughness->baseColorTexture,
+              transformedAccessors,
+              appliedTextureInfos);
+          processTextureInfo(
+              model,
+              primitive,
+              material->pbrMetallicRoughness->metallicRoughnessTexture,
+              transformedAccessors,
+              appliedTextureInfos);
+        }
         processTextureInfo(
             model,
             primitive,
-            material->pbrMetallicRoughness->baseColorTexture);
+            material->normalTexture,
+            transformedAccessors,
+            appliedTextureInfos);
         processTextureInfo(
             model,
             primitive,
-            material->pbrMetallicRoughness->metallicRoughnessTexture);
-        processTextureInfo(model, primitive, material->normalTexture);
-        processTextureInfo(model, primitive, material->occlusionTexture);
-        processTextureInfo(model, primitive, material->emissiveTexture);
+            material->occlusionTexture,
+            transformedAccessors,
+            appliedTextureInfos);
+        processTextureInfo(
+            model,
+            primitive,
+            material->emissiveTexture,
+            transformedAccessors,
+            appliedTextureInfos);
       }
     }
   }
+
+  // Erase the extensions so they are not re-applied by client implementations.
+  // This waits until every primitive is transformed, because primitives share
+  // materials.
+  for (TextureInfo* pTextureInfo : appliedTextureInfos) {
+    pTextureInfo->extensions.erase(ExtensionKhrTextureTransform::ExtensionName);
+  }
 }
 } // namespace CesiumGltfReader
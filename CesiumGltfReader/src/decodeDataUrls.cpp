@@ -1,6 +1,7 @@
 #include "decodeDataUrls.h"
 
 #include "CesiumGltfReader/GltfReader.h"
+#include "getImageReaderOptions.h"
 
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
@@ -14,7 +15,7 @@ namespace CesiumGltfReader {
 namespace {
 
 std::vector<std::byte> decodeBase64(gsl::span<const std::byte> data) {
-  CESIUM_TRACE("CesiumGltfReader::decodeBase64");
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::decodeBase64");
   std::vector<std::byte> result(modp_b64_decode_len(data.size()));
 
   const size_t resultLength = modp_b64_decode(
@@ -90,7 +91,7 @@ void decodeDataUrls(
     const GltfReader& reader,
     GltfReaderResult& readGltf,
     const GltfReaderOptions& options) {
-  CESIUM_TRACE("CesiumGltfReader::decodeDataUrls");
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::decodeDataUrls");
   if (!readGltf.model) {
     return;
   }
@@ -114,7 +115,8 @@ void decodeDataUrls(
     }
   }
 
-  for (CesiumGltf::Image& image : model.images) {
+  for (size_t i = 0; i < model.images.size(); ++i) {
+    CesiumGltf::Image& image = model.images[i];
     if (!image.uri) {
       continue;
     }
@@ -125,7 +127,9 @@ void decodeDataUrls(
     }
 
     ImageReaderResult imageResult =
-        reader.readImage(decoded.value().data, options.ktx2TranscodeTargets);
+        reader.readImage(
+            decoded.value().data,
+            getImageReaderOptions(model, i, options));
 
     if (!imageResult.image) {
       continue;
@@ -1,13 +1,22 @@
 #include "decodeDraco.h"
 
 #include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfReader/decodeInParallel.h"
+#include "allocateDecodedData.h"
 
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -25,36 +34,35 @@ namespace CesiumGltfReader {
 
 namespace {
 std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
-    GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& /* primitive */,
-    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodeBufferViewToDracoMesh");
-  CesiumGltf::Model& model = readGltf.model.value();
-
-  CesiumGltf::BufferView* pBufferView =
+    const CesiumGltf::Model& model,
+    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco,
+    std::vector<std::string>& warnings) {
+  CESIUM_TRACE_CATEGORY(
+      Decode,
+      "CesiumGltfReader::decodeBufferViewToDracoMesh");
+
+  const CesiumGltf::BufferView* pBufferView =
       CesiumGltf::Model::getSafe(&model.bufferViews, draco.bufferView);
   if (!pBufferView) {
-    readGltf.warnings.emplace_back("Draco bufferView index is invalid.");
+    warnings.emplace_back("Draco bufferView index is invalid.");
     return nullptr;
   }
 
   const CesiumGltf::BufferView& bufferView = *pBufferView;
 
-  CesiumGltf::Buffer* pBuffer =
+  const CesiumGltf::Buffer* pBuffer =
       CesiumGltf::Model::getSafe(&model.buffers, bufferView.buffer);
   if (!pBuffer) {
-    readGltf.warnings.emplace_back(
-        "Draco bufferView has an invalid buffer index.");
+    warnings.emplace_back("Draco bufferView has an invalid buffer index.");
     return nullptr;
   }
 
-  CesiumGltf::Buffer& buffer = *pBuffer;
+  const CesiumGltf::Buffer& buffer = *pBuffer;
 
   if (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
       bufferView.byteOffset + bufferView.byteLength >
           static_cast<int64_t>(buffer.cesium.data.size())) {
-    readGltf.warnings.emplace_back(
-        "Draco bufferView extends beyond its buffer.");
+    warnings.emplace_back("Draco bufferView extends beyond its buffer.");
     return nullptr;
   }
 
@@ -70,7 +78,7 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
   draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
       decoder.DecodeMeshFromBuffer(&decodeBuffer);
   if (!result.ok()) {
-    readGltf.warnings.emplace_back(
+    warnings.emplace_back(
         std::string("Draco decoding failed: ") +
         result.status().error_msg_string());
     return nullptr;
@@ -94,11 +102,60 @@ void copyData(const T* pSource, T* pDestination, int64_t length) {
   std::copy(pSource, pSource + length, pDestination);
 }
 
+// Gets the Draco data type of values with the given glTF component type.
+draco::DataType getDracoDataType(int32_t componentType) {
+  switch (componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    return draco::DT_INT8;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    return draco::DT_UINT8;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    return draco::DT_INT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    return draco::DT_UINT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    return draco::DT_UINT32;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    return draco::DT_FLOAT32;
+  default:
+    return draco::DT_INVALID;
+  }
+}
+
+// Copies the values of an attribute that Draco decoded to exactly the layout
+// of the accessor, without converting them one at a time.
+void copyMatchingAttribute(
+    std::byte* pOut,
+    const draco::Mesh* pMesh,
+    const draco::PointAttribute* pAttribute,
+    int64_t stride) {
+  if (pMesh->num_points() == 0) {
+    return;
+  }
+
+  if (pAttribute->is_mapping_identity()) {
+    std::memcpy(
+        pOut,
+        pAttribute->GetAddress(draco::AttributeValueIndex(0)),
+        static_cast<size_t>(stride * pMesh->num_points()));
+    return;
+  }
+
+  for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
+    std::memcpy(
+        pOut,
+        pAttribute->GetAddressOfMappedIndex(i),
+        static_cast<size_t>(stride));
+    pOut += stride;
+  }
+}
+
 void copyDecodedIndices(
     GltfReaderResult& readGltf,
     const CesiumGltf::MeshPrimitive& primitive,
-    draco::Mesh* pMesh) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+    draco::Mesh* pMesh,
+    DecodedDataAllocator* pAllocator) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::copyDecodedIndices");
   CesiumGltf::Model& model = readGltf.model.value();
 
   if (primitive.indices < 0) {
@@ -145,7 +202,10 @@ void copyDecodedIndices(
   int64_t indexBytes = pIndicesAccessor->computeByteSizeOfComponent();
   const int64_t indicesBytes = pIndicesAccessor->count * indexBytes;
 
-  indicesBuffer.cesium.data.resize(static_cast<size_t>(indicesBytes));
+  indicesBuffer.cesium.data = allocateDecodedData(
+      pAllocator,
+      DecodedDataKind::Draco,
+      static_cast<size_t>(indicesBytes));
   indicesBuffer.byteLength = indicesBytes;
   indicesBufferView.byteLength = indicesBytes;
   indicesBufferView.byteOffset = 0;
@@ -204,8 +264,9 @@ void copyDecodedAttribute(
     CesiumGltf::MeshPrimitive& /* primitive */,
     CesiumGltf::Accessor* pAccessor,
     const draco::Mesh* pMesh,
-    const draco::PointAttribute* pAttribute) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+    const draco::PointAttribute* pAttribute,
+    DecodedDataAllocator* pAllocator) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::copyDecodedAttribute");
   CesiumGltf::Model& model = readGltf.model.value();
 
   if (pAccessor->count != pMesh->num_points()) {
@@ -226,7 +287,10 @@ void copyDecodedAttribute(
       numberOfComponents * pAccessor->computeByteSizeOfComponent();
   const int64_t sizeBytes = pAccessor->count * stride;
 
-  buffer.cesium.data.resize(static_cast<size_t>(sizeBytes));
+  buffer.cesium.data = allocateDecodedData(
+      pAllocator,
+      DecodedDataKind::Draco,
+      static_cast<size_t>(sizeBytes));
   buffer.byteLength = sizeBytes;
   bufferView.byteLength = sizeBytes;
   bufferView.byteStride = stride;
@@ -234,6 +298,19 @@ void copyDecodedAttribute(
   bufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
   pAccessor->byteOffset = 0;
 
+  if (pAttribute->data_type() == getDracoDataType(pAccessor->componentType) &&
+      pAttribute->num_components() == numberOfComponents &&
+      pAttribute->byte_stride() == stride &&
+      (!pAttribute->is_mapping_identity() ||
+       pAttribute->size() >= static_cast<size_t>(pMesh->num_points()))) {
+    copyMatchingAttribute(
+        buffer.cesium.data.data(),
+        pMesh,
+        pAttribute,
+        stride);
+    return;
+  }
+
   const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
     for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
       const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
@@ -269,20 +346,16 @@ void copyDecodedAttribute(
   }
 }
 
-void decodePrimitive(
+void copyDecodedPrimitive(
     GltfReaderResult& readGltf,
     CesiumGltf::MeshPrimitive& primitive,
-    CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodePrimitive");
+    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco,
+    const std::unique_ptr<draco::Mesh>& pMesh,
+    DecodedDataAllocator* pAllocator) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::copyDecodedPrimitive");
   CesiumGltf::Model& model = readGltf.model.value();
 
-  std::unique_ptr<draco::Mesh> pMesh =
-      decodeBufferViewToDracoMesh(readGltf, primitive, draco);
-  if (!pMesh) {
-    return;
-  }
-
-  copyDecodedIndices(readGltf, primitive, pMesh.get());
+  copyDecodedIndices(readGltf, primitive, pMesh.get(), pAllocator);
 
   for (const std::pair<const std::string, int32_t>& attribute :
        draco.attributes) {
@@ -320,34 +393,85 @@ void decodePrimitive(
         primitive,
         pAccessor,
         pMesh.get(),
-        pAttribute);
+        pAttribute,
+        pAllocator);
   }
 }
+// A primitive to decode. Decoding only reads the model, so primitives can
+// be decoded in parallel. Copying the results into the model adds buffers,
+// so it happens afterward, one primitive at a time and in order.
+struct DracoJob {
+  CesiumGltf::MeshPrimitive* pPrimitive;
+  CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco;
+  std::unique_ptr<draco::Mesh> pMesh;
+  std::vector<std::string> warnings;
+};
+
+void decodeJobs(
+    std::vector<DracoJob>& jobs,
+    const CesiumGltf::Model& model,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem) {
+  decodeInParallel(
+      jobs.size(),
+      maybeAsyncSystem,
+      std::max(1U, std::thread::hardware_concurrency()),
+      [&jobs, &model](size_t i) {
+        DracoJob& job = jobs[i];
+        try {
+          job.pMesh =
+              decodeBufferViewToDracoMesh(model, *job.pDraco, job.warnings);
+        } catch (const std::exception& e) {
+          job.warnings.emplace_back(
+              std::string("Draco decoding failed: ") + e.what());
+        }
+      });
+}
+
 } // namespace
 
-void decodeDraco(CesiumGltfReader::GltfReaderResult& readGltf) {
-  CESIUM_TRACE("CesiumGltfReader::decodeDraco");
+void decodeDraco(
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    DecodedDataAllocator* pAllocator) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::decodeDraco");
   if (!readGltf.model) {
     return;
   }
 
   CesiumGltf::Model& model = readGltf.model.value();
 
+  std::vector<DracoJob> jobs;
   for (CesiumGltf::Mesh& mesh : model.meshes) {
     for (CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
       CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
           primitive
               .getExtension<CesiumGltf::ExtensionKhrDracoMeshCompression>();
-      if (!pDraco) {
-        continue;
+      if (pDraco) {
+        jobs.emplace_back(DracoJob{&primitive, pDraco, nullptr, {}});
       }
+    }
+  }
 
-      decodePrimitive(readGltf, primitive, *pDraco);
-
-      // Remove the Draco extension as it no longer applies.
-      primitive.extensions.erase(
-          CesiumGltf::ExtensionKhrDracoMeshCompression::ExtensionName);
+  decodeJobs(jobs, model, maybeAsyncSystem);
+
+  for (DracoJob& job : jobs) {
+    readGltf.warnings.insert(
+        readGltf.warnings.end(),
+        std::make_move_iterator(job.warnings.begin()),
+        std::make_move_iterator(job.warnings.end()));
+
+    if (job.pMesh) {
+      copyDecodedPrimitive(
+          readGltf,
+          *job.pPrimitive,
+          *job.pDraco,
+          job.pMesh,
+          pAllocator);
     }
+
+    // Remove the Draco extension as it no longer applies.
+    job.pPrimitive->extensions.erase(
+        CesiumGltf::ExtensionKhrDracoMeshCompression::ExtensionName);
   }
 
   model.extensionsRequired.erase(
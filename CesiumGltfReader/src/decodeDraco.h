@@ -1,7 +1,15 @@
 #pragma once
 
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <optional>
+
 namespace CesiumGltfReader {
 struct GltfReaderResult;
+class DecodedDataAllocator;
 
-void decodeDraco(GltfReaderResult& readGltf);
+void decodeDraco(
+    GltfReaderResult& readGltf,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    DecodedDataAllocator* pAllocator);
 } // namespace CesiumGltfReader
@@ -0,0 +1,69 @@
+#include "CesiumGltfReader/decodeInParallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace CesiumGltfReader {
+
+namespace {
+struct ParallelDecode {
+  std::function<void(size_t)> decode;
+  size_t count = 0;
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable allDone;
+  size_t done = 0;
+
+  // Decodes items until there are none left to start.
+  void work() {
+    for (size_t i = this->next++; i < this->count; i = this->next++) {
+      this->decode(i);
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (++this->done == this->count) {
+        this->allDone.notify_all();
+      }
+    }
+  }
+};
+} // namespace
+
+void decodeInParallel(
+    size_t count,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    size_t maximumThreads,
+    const std::function<void(size_t)>& decode) {
+  const size_t threads = std::min(count, maximumThreads);
+  if (!maybeAsyncSystem || threads < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      decode(i);
+    }
+    return;
+  }
+
+  // Offer the items to other worker threads while this thread works through
+  // them, too. A helper that starts after every item has been claimed does
+  // nothing, so this thread only ever waits for items that are already being
+  // decoded. The shared state outlives this call for the sake of late
+  // helpers.
+  auto pDecode = std::make_shared<ParallelDecode>();
+  pDecode->decode = decode;
+  pDecode->count = count;
+
+  for (size_t i = 1; i < threads; ++i) {
+    maybeAsyncSystem->runInNewWorkerTask([pDecode]() { pDecode->work(); });
+  }
+
+  pDecode->work();
+
+  std::unique_lock<std::mutex> lock(pDecode->mutex);
+  pDecode->allDone.wait(lock, [&pDecode]() {
+    return pDecode->done == pDecode->count;
+  });
+}
+
+} // namespace CesiumGltfReader
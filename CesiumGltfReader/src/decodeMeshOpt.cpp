@@ -1,7 +1,16 @@
 #include "decodeMeshOpt.h"
 
+#include "CesiumGltfReader/decodeInParallel.h"
+#include "allocateDecodedData.h"
+
 #include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
 #include <CesiumGltfReader/GltfReader.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -99,9 +108,33 @@ int decodeBufferView(
     }
   }
 }
+
+// A buffer view to decode. Each job decodes into its own part of a single
+// output buffer, so the jobs can run in parallel, and applies its filter right
+// away, while the decoded data is still in the cache.
+struct MeshOptJob {
+  BufferView* pBufferView;
+  const ExtensionBufferViewExtMeshoptCompression* pMeshOpt;
+  gsl::span<const std::byte> source;
+  size_t outputOffset;
+  size_t outputLength;
+  bool succeeded;
+};
+
+// Keep each decoded buffer view aligned for its largest possible component
+// type, and for the vectorized filters.
+constexpr size_t MESHOPT_OUTPUT_ALIGNMENT = 16;
 } // namespace
 
-void decodeMeshOpt(Model& model, CesiumGltfReader::GltfReaderResult& readGltf) {
+void decodeMeshOpt(
+    Model& model,
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    DecodedDataAllocator* pAllocator) {
+  CESIUM_TRACE_CATEGORY(Decode, "CesiumGltfReader::decodeMeshOpt");
+
+  std::vector<MeshOptJob> jobs;
+  size_t outputSize = 0;
   for (BufferView& bufferView : model.bufferViews) {
     const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
         bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
@@ -129,30 +162,65 @@ void decodeMeshOpt(Model& model, CesiumGltfReader::GltfReaderResult& readGltf) {
         continue;
       }
 
-      std::vector<std::byte> data;
-      data.resize(static_cast<size_t>(byteLength));
-      if (decodeBufferView(
-              data.data(),
-              gsl::span<const std::byte>(
-                  pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
-                  static_cast<size_t>(pMeshOpt->byteLength)),
-              *pMeshOpt) != 0) {
-        readGltf.warnings.emplace_back(
-            "The EXT_meshopt_compression extension has a corrupted or "
-            "incompatible meshopt compression buffer.");
-        continue;
-      }
-      decodeFilter(data.data(), *pMeshOpt);
-      Buffer& buffer = model.buffers.emplace_back();
-      buffer.byteLength = byteLength;
-      buffer.cesium.data = std::move(data);
-
-      bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
-      bufferView.byteOffset = 0;
-      bufferView.byteLength = byteLength;
-      bufferView.extensions.erase(
-          ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+      outputSize = (outputSize + MESHOPT_OUTPUT_ALIGNMENT - 1) /
+                   MESHOPT_OUTPUT_ALIGNMENT * MESHOPT_OUTPUT_ALIGNMENT;
+      jobs.emplace_back(MeshOptJob{
+          &bufferView,
+          pMeshOpt,
+          gsl::span<const std::byte>(
+              pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
+              static_cast<size_t>(pMeshOpt->byteLength)),
+          outputSize,
+          static_cast<size_t>(byteLength),
+          false});
+      outputSize += static_cast<size_t>(byteLength);
     }
   }
+
+  if (jobs.empty()) {
+    return;
+  }
+
+  std::vector<std::byte> output =
+      allocateDecodedData(pAllocator, DecodedDataKind::MeshOpt, outputSize);
+
+  decodeInParallel(
+      jobs.size(),
+      maybeAsyncSystem,
+      std::max(1U, std::thread::hardware_concurrency()),
+      [&jobs, &output](size_t i) {
+        MeshOptJob& job = jobs[i];
+        std::byte* pDestination = output.data() + job.outputOffset;
+        job.succeeded =
+            decodeBufferView(pDestination, job.source, *job.pMeshOpt) == 0;
+        if (job.succeeded) {
+          decodeFilter(pDestination, *job.pMeshOpt);
+        }
+      });
+
+  const int32_t outputBufferIndex = static_cast<int32_t>(model.buffers.size());
+  bool anySucceeded = false;
+  for (MeshOptJob& job : jobs) {
+    if (!job.succeeded) {
+      readGltf.warnings.emplace_back(
+          "The EXT_meshopt_compression extension has a corrupted or "
+          "incompatible meshopt compression buffer.");
+      continue;
+    }
+
+    anySucceeded = true;
+    BufferView& bufferView = *job.pBufferView;
+    bufferView.buffer = outputBufferIndex;
+    bufferView.byteOffset = static_cast<int64_t>(job.outputOffset);
+    bufferView.byteLength = static_cast<int64_t>(job.outputLength);
+    bufferView.extensions.erase(
+        ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+  }
+
+  if (anySucceeded) {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = static_cast<int64_t>(output.size());
+    buffer.cesium.data = std::move(output);
+  }
 }
 } // namespace CesiumGltfReader
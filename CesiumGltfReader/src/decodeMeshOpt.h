@@ -1,11 +1,16 @@
 #pragma once
 
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <optional>
+
 namespace CesiumGltf {
 struct Model;
 }
 
 namespace CesiumGltfReader {
 struct GltfReaderResult;
+class DecodedDataAllocator;
 }
 
 namespace CesiumGltfReader {
@@ -17,8 +22,13 @@ namespace CesiumGltfReader {
  * The decompressed buffer may be in a quantized format as specified by the
  * KHR_mesh_quantization extension, in which case the data will have to be
  * dequantized to get the original values.
+ *
+ * All of the compressed buffer views are decoded into a single new buffer.
+ * With an async system, they are decoded in parallel.
  **/
 void decodeMeshOpt(
     CesiumGltf::Model& model,
-    CesiumGltfReader::GltfReaderResult& readGltf);
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    const std::optional<CesiumAsync::AsyncSystem>& maybeAsyncSystem,
+    CesiumGltfReader::DecodedDataAllocator* pAllocator);
 } // namespace CesiumGltfReader
@@ -1,7 +1,13 @@
 #include "dequantizeMeshData.h"
 
+#include "allocateDecodedData.h"
+
 #include <CesiumGltfReader/GltfReader.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
 using namespace CesiumGltf;
 
 namespace CesiumGltfReader {
@@ -14,25 +20,50 @@ template <> float intToFloat(std::int8_t c) {
   return std::max(c / 127.0f, -1.0f);
 }
 
-template <> float intToFloat(std::uint8_t c) { return c / 127.0f; }
+template <> float intToFloat(std::uint8_t c) { return c / 255.0f; }
 
 template <> float intToFloat(std::int16_t c) {
-  return std::max(c / 65535.0f, -1.0f);
+  return std::max(c / 32767.0f, -1.0f);
 }
 
 template <> float intToFloat(std::uint16_t c) { return c / 65535.0f; }
 
+// Converts the N components of each of `count` elements. Tightly-packed
+// elements are converted as one flat array of scalars, a loop simple enough
+// for the compiler to turn into SIMD instructions.
+template <typename T, size_t N, typename Convert>
+void convertQuantized(
+    float* fPtr,
+    int64_t count,
+    const std::byte* bPtr,
+    int64_t stride,
+    Convert convert) {
+  if (stride == static_cast<int64_t>(sizeof(T) * N)) {
+    const T* pSource = reinterpret_cast<const T*>(bPtr);
+    const int64_t scalars = count * static_cast<int64_t>(N);
+    for (int64_t i = 0; i < scalars; i++) {
+      fPtr[i] = convert(pSource[i]);
+    }
+    return;
+  }
+
+  for (int64_t i = 0; i < count; i++, bPtr += stride) {
+    const T* pSource = reinterpret_cast<const T*>(bPtr);
+    for (size_t j = 0; j < N; j++) {
+      *fPtr++ = convert(pSource[j]);
+    }
+  }
+}
+
 template <typename T, size_t N>
 void normalizeQuantized(
     float* fPtr,
     int64_t count,
     const std::byte* bPtr,
     int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = intToFloat<T>(reinterpret_cast<const T*>(bPtr)[j]);
-    }
-  }
+  convertQuantized<T, N>(fPtr, count, bPtr, stride, [](T t) {
+    return intToFloat<T>(t);
+  });
 }
 
 template <typename T, size_t N>
@@ -41,15 +72,16 @@ void castQuantizedToFloat(
     int64_t count,
     const std::byte* bPtr,
     int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = static_cast<float>(reinterpret_cast<const T*>(bPtr)[j]);
-    }
-  }
+  convertQuantized<T, N>(fPtr, count, bPtr, stride, [](T t) {
+    return static_cast<float>(t);
+  });
 }
 
 template <typename T, size_t N>
-void dequantizeAccessor(Model& model, Accessor& accessor) {
+void dequantizeAccessor(
+    Model& model,
+    Accessor& accessor,
+    DecodedDataAllocator* pAllocator) {
 
   BufferView* pBufferView =
       Model::getSafe(&model.bufferViews, accessor.bufferView);
@@ -82,8 +114,10 @@ void dequantizeAccessor(Model& model, Accessor& accessor) {
     return;
   }
 
-  std::vector<std::byte> data;
-  data.resize(static_cast<size_t>(byteLength));
+  std::vector<std::byte> data = allocateDecodedData(
+      pAllocator,
+      DecodedDataKind::DequantizedMeshData,
+      static_cast<size_t>(byteLength));
 
   const std::byte* bPtr = pBuffer->cesium.data.data() +
                           pBufferView->byteOffset + accessor.byteOffset;
@@ -122,40 +156,47 @@ void dequantizeAccessor(Model& model, Accessor& accessor) {
   buffer.byteLength = byteLength;
 }
 
-template <size_t N> void dequantizeAccessor(Model& model, Accessor& accessor) {
+template <size_t N>
+void dequantizeAccessor(
+    Model& model,
+    Accessor& accessor,
+    DecodedDataAllocator* pAllocator) {
   switch (accessor.componentType) {
   case Accessor::ComponentType::BYTE:
-    dequantizeAccessor<std::int8_t, N>(model, accessor);
+    dequantizeAccessor<std::int8_t, N>(model, accessor, pAllocator);
     break;
   case Accessor::ComponentType::UNSIGNED_BYTE:
-    dequantizeAccessor<std::uint8_t, N>(model, accessor);
+    dequantizeAccessor<std::uint8_t, N>(model, accessor, pAllocator);
     break;
   case Accessor::ComponentType::SHORT:
-    dequantizeAccessor<std::int16_t, N>(model, accessor);
+    dequantizeAccessor<std::int16_t, N>(model, accessor, pAllocator);
     break;
   case Accessor::ComponentType::UNSIGNED_SHORT:
-    dequantizeAccessor<std::uint16_t, N>(model, accessor);
+    dequantizeAccessor<std::uint16_t, N>(model, accessor, pAllocator);
     break;
   }
 }
 
-void dequantizeAccessor(Model& model, Accessor& accessor) {
+void dequantizeAccessor(
+    Model& model,
+    Accessor& accessor,
+    DecodedDataAllocator* pAllocator) {
   int8_t numberOfComponents = accessor.computeNumberOfComponents();
   switch (numberOfComponents) {
   case 2:
-    dequantizeAccessor<2>(model, accessor);
+    dequantizeAccessor<2>(model, accessor, pAllocator);
     break;
   case 3:
-    dequantizeAccessor<3>(model, accessor);
+    dequantizeAccessor<3>(model, accessor, pAllocator);
     break;
   case 4:
-    dequantizeAccessor<4>(model, accessor);
+    dequantizeAccessor<4>(model, accessor, pAllocator);
     break;
   }
 }
 } // namespace
 
-void dequantizeMeshData(Model& model) {
+void dequantizeMeshData(Model& model, DecodedDataAllocator* pAllocator) {
   for (Mesh& mesh : model.meshes) {
     for (MeshPrimitive& primitive : mesh.primitives) {
       for (std::pair<const std::string, int32_t> attribute :
@@ -171,7 +212,7 @@ void dequantizeMeshData(Model& model) {
         const std::string& attributeName = attribute.first;
         if (attributeName == "POSITION" || attributeName == "NORMAL" ||
             attributeName == "TANGENT" || attributeName.find("TEXCOORD") == 0) {
-          dequantizeAccessor(model, *pAccessor);
+          dequantizeAccessor(model, *pAccessor, pAllocator);
         }
       }
     }
@@ -5,11 +5,17 @@ struct Model;
 }
 
 namespace CesiumGltfReader {
+class DecodedDataAllocator;
 
 /**
  * @brief Dequantizes any quantized data in the accessors of the glTF model and
  * converts them to floating-point data as specified in the
  * KHR_quantization extension.
+ *
+ * The floating-point data is written into vectors from the allocator, if it
+ * isn't nullptr.
  */
-void dequantizeMeshData(CesiumGltf::Model& model);
+void dequantizeMeshData(
+    CesiumGltf::Model& model,
+    DecodedDataAllocator* pAllocator);
 } // namespace CesiumGltfReader
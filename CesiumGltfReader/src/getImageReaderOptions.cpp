@@ -0,0 +1,63 @@
+#include "getImageReaderOptions.h"
+
+#include "CesiumGltfReader/GltfReader.h"
+
+#include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+#include <CesiumGltf/Model.h>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+
+namespace {
+bool isNormalMap(const Model& model, size_t imageIndex) {
+  for (const Material& material : model.materials) {
+    if (!material.normalTexture) {
+      continue;
+    }
+
+    const Texture* pTexture =
+        Model::getSafe(&model.textures, material.normalTexture->index);
+    if (!pTexture) {
+      continue;
+    }
+
+    const ExtensionKhrTextureBasisu* pBasisu =
+        pTexture->getExtension<ExtensionKhrTextureBasisu>();
+    const int32_t source = pBasisu ? pBasisu->source : pTexture->source;
+    if (source >= 0 && size_t(source) == imageIndex) {
+      return true;
+    }
+  }
+
+  return false;
+}
+} // namespace
+
+GltfReaderOptions getImageReaderOptions(
+    const Model& model,
+    size_t imageIndex,
+    const GltfReaderOptions& options) {
+  GltfReaderOptions result = options;
+
+  Ktx2TranscodeTargets& targets = result.ktx2TranscodeTargets;
+  if ((targets.ETC1S_NormalMap == GpuCompressedPixelFormat::NONE &&
+       targets.UASTC_NormalMap == GpuCompressedPixelFormat::NONE) ||
+      !isNormalMap(model, imageIndex)) {
+    return result;
+  }
+
+  if (targets.ETC1S_NormalMap != GpuCompressedPixelFormat::NONE) {
+    targets.ETC1S_RGB = targets.ETC1S_NormalMap;
+    targets.ETC1S_RGBA = targets.ETC1S_NormalMap;
+  }
+
+  if (targets.UASTC_NormalMap != GpuCompressedPixelFormat::NONE) {
+    targets.UASTC_RGB = targets.UASTC_NormalMap;
+    targets.UASTC_RGBA = targets.UASTC_NormalMap;
+  }
+
+  return result;
+}
+
+} // namespace CesiumGltfReader
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfReader {
+struct GltfReaderOptions;
+
+/**
+ * Gets the options with which to read the image at the given index of the
+ * model. If the model uses the image as a normal map, the KTX2 transcode
+ * targets are replaced by the normal map targets, if any.
+ */
+GltfReaderOptions getImageReaderOptions(
+    const CesiumGltf::Model& model,
+    size_t imageIndex,
+    const GltfReaderOptions& options);
+} // namespace CesiumGltfReader
@@ -1,22 +1,32 @@
+#include "CesiumGltfReader/DecodedDataAllocator.h"
+#include "CesiumGltfReader/ExternalDataCache.h"
 #include "CesiumGltfReader/GltfReader.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/WorkStealingTaskProcessor.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionKhrTextureTransform.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleTaskProcessor.h>
 #include <CesiumNativeTests/waitForFuture.h>
 #include <CesiumUtility/Math.h>
 
 #include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/span>
 #include <rapidjson/reader.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <map>
 #include <string>
 
 using namespace CesiumAsync;
@@ -224,6 +234,108 @@ TEST_CASE("Can decompress meshes using EXT_meshopt_compression") {
   }
 }
 
+TEST_CASE("Decodes EXT_meshopt_compression buffer views in parallel into a "
+          "single buffer") {
+  auto pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(4);
+  CesiumAsync::AsyncSystem asyncSystem{pTaskProcessor};
+
+  std::vector<std::byte> data = readFile(
+      CesiumGltfReader_TEST_DATA_DIR +
+      std::string("/DucksMeshopt/Duck-vp-12-vt-12-vn-12.glb"));
+
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.dequantizeMeshData = false;
+  GltfReaderResult serial = reader.readGltf(data, options);
+
+  options.asyncSystem = asyncSystem;
+  GltfReaderResult parallel = reader.readGltf(data, options);
+
+  REQUIRE(serial.model);
+  REQUIRE(parallel.model);
+  CHECK(parallel.warnings.empty());
+
+  REQUIRE(parallel.model->buffers.size() == serial.model->buffers.size());
+  for (size_t i = 0; i < serial.model->buffers.size(); ++i) {
+    CHECK(
+        parallel.model->buffers[i].cesium.data ==
+        serial.model->buffers[i].cesium.data);
+  }
+
+  // Every decoded buffer view is in the buffer added last.
+  const int32_t decodedBuffer =
+      static_cast<int32_t>(parallel.model->buffers.size() - 1);
+  size_t decodedBufferViews = 0;
+  for (const BufferView& bufferView : parallel.model->bufferViews) {
+    CHECK(!bufferView.hasExtension<ExtensionBufferViewExtMeshoptCompression>());
+    if (bufferView.buffer == decodedBuffer) {
+      ++decodedBufferViews;
+      CHECK(bufferView.byteOffset % 4 == 0);
+      CHECK(
+          bufferView.byteOffset + bufferView.byteLength <=
+          parallel.model->buffers.back().byteLength);
+    }
+  }
+  CHECK(decodedBufferViews > 1);
+}
+
+TEST_CASE("applyTextureTransform transforms texture coordinates shared by "
+          "primitives once") {
+  Model model;
+
+  const std::vector<glm::vec2> uvs{
+      glm::vec2(0.0f, 0.0f),
+      glm::vec2(1.0f, 1.0f)};
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(uvs.size() * sizeof(glm::vec2));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      uvs.data(),
+      buffer.cesium.data.size());
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.count = static_cast<int64_t>(uvs.size());
+  accessor.type = Accessor::Type::VEC2;
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+
+  Material& material = model.materials.emplace_back();
+  material.pbrMetallicRoughness.emplace().baseColorTexture.emplace();
+  ExtensionKhrTextureTransform& textureTransform =
+      material.pbrMetallicRoughness->baseColorTexture
+          ->addExtension<ExtensionKhrTextureTransform>();
+  textureTransform.offset = {0.5, 0.25};
+  textureTransform.scale = {2.0, 4.0};
+
+  Mesh& mesh = model.meshes.emplace_back();
+  for (int i = 0; i < 2; ++i) {
+    MeshPrimitive& primitive = mesh.primitives.emplace_back();
+    primitive.material = 0;
+    primitive.attributes["TEXCOORD_0"] = 0;
+  }
+
+  GltfReader::applyTextureTransform(model);
+
+  CHECK(!material.pbrMetallicRoughness->baseColorTexture
+             ->hasExtension<ExtensionKhrTextureTransform>());
+  REQUIRE(model.accessors.size() == 2);
+  CHECK(model.buffers.size() == 2);
+  for (const MeshPrimitive& primitive : mesh.primitives) {
+    CHECK(primitive.attributes.at("TEXCOORD_0") == 1);
+  }
+
+  AccessorView<glm::vec2> transformed(model, 1);
+  REQUIRE(transformed.status() == AccessorViewStatus::Valid);
+  REQUIRE(transformed.size() == 2);
+  CHECK(transformed[0] == glm::vec2(0.5f, 0.25f));
+  CHECK(transformed[1] == glm::vec2(2.5f, 4.25f));
+}
+
 TEST_CASE("Read TriangleWithoutIndices") {
   std::filesystem::path gltfFile = CesiumGltfReader_TEST_DATA_DIR;
   gltfFile /=
@@ -287,6 +399,83 @@ TEST_CASE("Nested extras deserializes properly") {
   CHECK(array[4].getSafeNumber<std::int32_t>() == 5);
 }
 
+TEST_CASE("Reads each array of objects independently") {
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0"
+        },
+        "meshes": [
+            {
+                "primitives": [
+                    { "attributes": { "POSITION": 0, "NORMAL": 1 }, "mode": 1 },
+                    { "attributes": { "POSITION": 2 }, "indices": 3 }
+                ]
+            },
+            {
+                "primitives": [
+                    { "attributes": { "TEXCOORD_0": 4 } }
+                ]
+            }
+        ]
+    }
+  )";
+
+  GltfReader reader;
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()));
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+
+  const std::vector<Mesh>& meshes = result.model->meshes;
+  REQUIRE(meshes.size() == 2);
+  REQUIRE(meshes[0].primitives.size() == 2);
+  REQUIRE(meshes[1].primitives.size() == 1);
+
+  CHECK(meshes[0].primitives[0].attributes.size() == 2);
+  CHECK(meshes[0].primitives[0].mode == MeshPrimitive::Mode::LINES);
+  CHECK(meshes[0].primitives[1].attributes.at("POSITION") == 2);
+  CHECK(meshes[0].primitives[1].indices == 3);
+
+  // Nothing from the first mesh's primitives carries over to the second's.
+  const MeshPrimitive& primitive = meshes[1].primitives[0];
+  CHECK(primitive.attributes.size() == 1);
+  CHECK(primitive.attributes.at("TEXCOORD_0") == 4);
+  CHECK(primitive.indices == -1);
+  CHECK(primitive.mode == MeshPrimitive::Mode::TRIANGLES);
+}
+
+TEST_CASE("Reads escaped strings without modifying the input") {
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0",
+            "copyright": "Line\none \"quoted\" é"
+        },
+        "nodes": [
+            { "name": "plain" },
+            { "name": "tab\tseparated" }
+        ]
+    }
+  )";
+  const std::string original = s;
+
+  GltfReader reader;
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.data()), s.size()));
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+  CHECK(s == original);
+
+  const Model& model = result.model.value();
+  CHECK(model.asset.copyright == "Line\none \"quoted\" \xc3\xa9");
+  REQUIRE(model.nodes.size() == 2);
+  CHECK(model.nodes[0].name == "plain");
+  CHECK(model.nodes[1].name == "tab\tseparated");
+}
+
 TEST_CASE("Can deserialize KHR_draco_mesh_compression") {
   const std::string s = R"(
     {
@@ -455,6 +644,119 @@ TEST_CASE("Extensions deserialize to JsonVaue iff "
   REQUIRE(zeroExtensions.empty());
 }
 
+TEST_CASE("Extras and unknown extensions can be skipped") {
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0"
+        },
+        "extras": {
+            "vendor": "data"
+        },
+        "extensions": {
+            "A": {
+              "test": "Hello World"
+            },
+            "CESIUM_RTC": {
+              "center": [1.0, 2.0, 3.0]
+            }
+        },
+        "nodes": [
+            {
+                "extras": {
+                    "id": 5
+                }
+            }
+        ]
+    }
+  )";
+
+  GltfReaderOptions options;
+  GltfReader reader;
+  reader.getOptions().setCaptureExtras(false);
+  reader.getOptions().setCaptureUnknownExtensions(false);
+
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+
+  const Model& model = *result.model;
+  CHECK(model.extras.empty());
+  REQUIRE(model.nodes.size() == 1);
+  CHECK(model.nodes[0].extras.empty());
+
+  CHECK(model.getGenericExtension("A") == nullptr);
+  const ExtensionCesiumRTC* pRtc = model.getExtension<ExtensionCesiumRTC>();
+  REQUIRE(pRtc != nullptr);
+  CHECK(pRtc->center == std::vector<double>{1.0, 2.0, 3.0});
+
+  // An extension that is explicitly JSON-only is still captured.
+  reader.getOptions().setExtensionState(
+      "A",
+      CesiumJsonReader::ExtensionState::JsonOnly);
+
+  GltfReaderResult jsonOnlyResult = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+  REQUIRE(jsonOnlyResult.model.has_value());
+  CHECK(jsonOnlyResult.model->getGenericExtension("A") != nullptr);
+}
+
+TEST_CASE("Properties can be skipped by object type") {
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0"
+        },
+        "animations": [
+            {
+                "channels": [],
+                "samplers": []
+            }
+        ],
+        "cameras": [
+            {
+                "type": "perspective"
+            }
+        ],
+        "nodes": [
+            {
+                "name": "node",
+                "camera": 0,
+                "mesh": 0
+            }
+        ]
+    }
+  )";
+
+  GltfReaderOptions options;
+  GltfReader reader;
+  reader.getOptions().skipProperty("Model", "animations");
+  reader.getOptions().skipProperty("Model", "cameras");
+  reader.getOptions().skipProperty("Node", "camera");
+  CHECK(reader.getOptions().isPropertySkipped("Model", "animations"));
+  CHECK(!reader.getOptions().isPropertySkipped("Node", "animations"));
+
+  GltfReaderResult result = reader.readGltf(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+
+  const Model& model = *result.model;
+  CHECK(model.asset.version == "2.0");
+  CHECK(model.animations.empty());
+  CHECK(model.cameras.empty());
+  REQUIRE(model.nodes.size() == 1);
+  CHECK(model.nodes[0].name == "node");
+  CHECK(model.nodes[0].camera == -1);
+  CHECK(model.nodes[0].mesh == 0);
+}
+
 TEST_CASE("Unknown MIME types are handled") {
   const std::string s = R"(
     {
@@ -532,6 +834,39 @@ TEST_CASE("Test KTX2") {
   REQUIRE(model.meshes.size() == 1);
 }
 
+TEST_CASE("KTX2 normal maps use the normal map transcode targets") {
+  std::filesystem::path gltfFile = CesiumGltfReader_TEST_DATA_DIR;
+  gltfFile /= "CesiumBalloonKTX2.glb";
+  std::vector<std::byte> data = readFile(gltfFile.string());
+
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.decodeEmbeddedImages = false;
+  GltfReaderResult result = reader.readGltf(data, options);
+  REQUIRE(result.model);
+  REQUIRE(result.model->images.size() >= 2);
+
+  // Use the first image as the balloon's normal map, too.
+  Material& material = result.model->materials[0];
+  material.normalTexture.emplace().index =
+      material.pbrMetallicRoughness->baseColorTexture->index;
+
+  options.decodeEmbeddedImages = true;
+  options.ktx2TranscodeTargets.ETC1S_NormalMap =
+      GpuCompressedPixelFormat::BC5_RG;
+  options.ktx2TranscodeTargets.UASTC_NormalMap =
+      GpuCompressedPixelFormat::BC5_RG;
+  reader.postprocessGltf(result, options);
+  CHECK(result.errors.empty());
+
+  CHECK(
+      result.model->images[0].cesium.compressedPixelFormat ==
+      GpuCompressedPixelFormat::BC5_RG);
+  CHECK(
+      result.model->images[1].cesium.compressedPixelFormat ==
+      GpuCompressedPixelFormat::NONE);
+}
+
 TEST_CASE("Can apply RTC CENTER if model uses Cesium RTC extension") {
   const std::string s = R"(
     {
@@ -618,6 +953,76 @@ TEST_CASE("Can correctly interpret mipmaps in KTX2 files") {
   }
 }
 
+TEST_CASE("Discards the KTX2 mip levels larger than the maximum dimension") {
+  std::filesystem::path ktx2File = CesiumGltfReader_TEST_DATA_DIR;
+  ktx2File /= "ktx2/kota-mipmaps.ktx2";
+  std::vector<std::byte> data = readFile(ktx2File.string());
+
+  GltfReaderOptions options;
+  ImageReaderResult fullResult = GltfReader::readImage(data, options);
+  REQUIRE(fullResult.image.has_value());
+  const ImageCesium& full = *fullResult.image;
+  REQUIRE(full.mipPositions.size() == 9);
+
+  options.maximumKtx2Dimension = full.width / 4;
+  ImageReaderResult result = GltfReader::readImage(data, options);
+  REQUIRE(result.image.has_value());
+
+  const ImageCesium& image = *result.image;
+  CHECK(image.width == full.width / 4);
+  CHECK(image.height == full.height / 4);
+  REQUIRE(image.mipPositions.size() == 7);
+
+  // The remaining mips are the same as the smaller mips of the full image.
+  for (size_t i = 0; i < image.mipPositions.size(); ++i) {
+    const ImageCesiumMipPosition& mip = image.mipPositions[i];
+    const ImageCesiumMipPosition& fullMip = full.mipPositions[i + 2];
+    REQUIRE(mip.byteSize == fullMip.byteSize);
+    REQUIRE(mip.byteOffset + mip.byteSize <= image.pixelData.size());
+    CHECK(std::equal(
+        image.pixelData.begin() + std::ptrdiff_t(mip.byteOffset),
+        image.pixelData.begin() + std::ptrdiff_t(mip.byteOffset + mip.byteSize),
+        full.pixelData.begin() + std::ptrdiff_t(fullMip.byteOffset)));
+  }
+  CHECK(image.pixelData.size() < full.pixelData.size());
+
+  // The smallest mip is always kept.
+  options.maximumKtx2Dimension = 1;
+  ImageReaderResult smallestResult = GltfReader::readImage(data, options);
+  REQUIRE(smallestResult.image.has_value());
+  CHECK(smallestResult.image->mipPositions.size() == 1);
+  CHECK(
+      smallestResult.image->pixelData.size() ==
+      full.mipPositions.back().byteSize);
+}
+
+TEST_CASE("Can generate mipmaps with a box filter") {
+  ImageCesium image;
+  image.width = 4;
+  image.height = 2;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  for (int value : {0, 4, 8, 12, 2, 6, 10, 14}) {
+    image.pixelData.push_back(std::byte(value));
+  }
+
+  std::optional<std::string> error =
+      GltfReader::generateMipMaps(image, MipMapFilter::Box);
+  CHECK(!error);
+
+  // 4x2, then 2x1, then 1x1.
+  REQUIRE(image.mipPositions.size() == 3);
+  CHECK(image.mipPositions[1].byteOffset == 8);
+  CHECK(image.mipPositions[1].byteSize == 2);
+  CHECK(image.mipPositions[2].byteOffset == 10);
+  CHECK(image.mipPositions[2].byteSize == 1);
+  REQUIRE(image.pixelData.size() == 11);
+
+  CHECK(image.pixelData[8] == std::byte(3));
+  CHECK(image.pixelData[9] == std::byte(11));
+  CHECK(image.pixelData[10] == std::byte(7));
+}
+
 TEST_CASE("Can read unknown properties from a glTF") {
   const std::string s = R"(
     {
@@ -748,6 +1153,304 @@ TEST_CASE("GltfReader::loadGltf") {
   }
 }
 
+namespace {
+class CountingAssetAccessor : public SimpleAssetAccessor {
+public:
+  using SimpleAssetAccessor::SimpleAssetAccessor;
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->requestCounts[url];
+    return SimpleAssetAccessor::get(asyncSystem, url, headers);
+  }
+
+  std::map<std::string, int> requestCounts;
+};
+} // namespace
+
+TEST_CASE("GltfReader::loadGltf shares external data through a cache") {
+  auto pMockTaskProcessor = std::make_shared<SimpleTaskProcessor>();
+  CesiumAsync::AsyncSystem asyncSystem{pMockTaskProcessor};
+
+  std::filesystem::path dataDir(CesiumGltfReader_TEST_DATA_DIR);
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mapUrlToRequest;
+
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(
+           dataDir / "DracoCompressed")) {
+    if (!entry.is_regular_file())
+      continue;
+    auto pResponse = std::make_unique<SimpleAssetResponse>(
+        uint16_t(200),
+        "application/binary",
+        CesiumAsync::HttpHeaders{},
+        readFile(entry.path()));
+    std::string url = "file:///" + entry.path().generic_u8string();
+    auto pRequest = std::make_unique<SimpleAssetRequest>(
+        "GET",
+        url,
+        CesiumAsync::HttpHeaders{},
+        std::move(pResponse));
+    mapUrlToRequest[url] = std::move(pRequest);
+  }
+
+  auto pMockAssetAccessor =
+      std::make_shared<CountingAssetAccessor>(std::move(mapUrlToRequest));
+
+  const std::string url =
+      "file:///" + std::filesystem::directory_entry(
+                       dataDir / "DracoCompressed" / "CesiumMilkTruck.gltf")
+                       .path()
+                       .generic_u8string();
+
+  GltfReaderOptions options;
+  options.pExternalDataCache = std::make_shared<ExternalDataCache>();
+
+  GltfReader reader{};
+  GltfReaderResult first = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(asyncSystem, url, {}, pMockAssetAccessor, options));
+  GltfReaderResult second = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(asyncSystem, url, {}, pMockAssetAccessor, options));
+  REQUIRE(first.model);
+  REQUIRE(second.model);
+
+  // The glTF itself is requested for each model, but its external buffer and
+  // image only once.
+  CHECK(pMockAssetAccessor->requestCounts[url] == 2);
+  for (const auto& [requestUrl, count] : pMockAssetAccessor->requestCounts) {
+    if (requestUrl != url) {
+      CHECK(count == 1);
+    }
+  }
+
+  REQUIRE(first.model->images.size() == 1);
+  REQUIRE(second.model->images.size() == 1);
+  CHECK(second.model->images[0].cesium.width == 2048);
+  CHECK(
+      first.model->images[0].cesium.pixelData ==
+      second.model->images[0].cesium.pixelData);
+  CHECK(options.pExternalDataCache->getCachedBytes() > 2048 * 2048 * 4);
+}
+
+TEST_CASE("GltfReader decodes Draco primitives in parallel with an async "
+          "system") {
+  auto pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(4);
+  CesiumAsync::AsyncSystem asyncSystem{pTaskProcessor};
+
+  std::filesystem::path dataDir(CesiumGltfReader_TEST_DATA_DIR);
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mapUrlToRequest;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(
+           dataDir / "DracoCompressed")) {
+    if (!entry.is_regular_file())
+      continue;
+    auto pResponse = std::make_unique<SimpleAssetResponse>(
+        uint16_t(200),
+        "application/binary",
+        CesiumAsync::HttpHeaders{},
+        readFile(entry.path()));
+    std::string url = "file:///" + entry.path().generic_u8string();
+    auto pRequest = std::make_unique<SimpleAssetRequest>(
+        "GET",
+        url,
+        CesiumAsync::HttpHeaders{},
+        std::move(pResponse));
+    mapUrlToRequest[url] = std::move(pRequest);
+  }
+
+  auto pMockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mapUrlToRequest));
+  const std::string url =
+      "file:///" + std::filesystem::directory_entry(
+                       dataDir / "DracoCompressed" / "CesiumMilkTruck.gltf")
+                       .path()
+                       .generic_u8string();
+
+  GltfReader reader{};
+  GltfReaderResult serial = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(asyncSystem, url, {}, pMockAssetAccessor));
+
+  GltfReaderOptions options;
+  options.asyncSystem = asyncSystem;
+  GltfReaderResult parallel = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(asyncSystem, url, {}, pMockAssetAccessor, options));
+
+  REQUIRE(serial.model);
+  REQUIRE(parallel.model);
+  CHECK(parallel.errors.empty());
+  CHECK(parallel.warnings == serial.warnings);
+
+  // The decoded buffers are added in the same order either way.
+  REQUIRE(parallel.model->buffers.size() == serial.model->buffers.size());
+  for (size_t i = 0; i < serial.model->buffers.size(); ++i) {
+    CHECK(
+        parallel.model->buffers[i].cesium.data ==
+        serial.model->buffers[i].cesium.data);
+  }
+
+  for (const Mesh& mesh : parallel.model->meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      CHECK(!primitive.hasExtension<ExtensionKhrDracoMeshCompression>());
+
+      // The decoded positions are within the bounds of their accessor.
+      auto positionIt = primitive.attributes.find("POSITION");
+      REQUIRE(positionIt != primitive.attributes.end());
+      const Accessor& accessor =
+          Model::getSafe(parallel.model->accessors, positionIt->second);
+      REQUIRE(accessor.min.size() == 3);
+      REQUIRE(accessor.max.size() == 3);
+      AccessorView<glm::vec3> positions(*parallel.model, accessor);
+      REQUIRE(positions.status() == AccessorViewStatus::Valid);
+      bool inBounds = true;
+      for (int64_t i = 0; i < positions.size(); ++i) {
+        for (glm::length_t j = 0; j < 3; ++j) {
+          inBounds = inBounds &&
+                     positions[i][j] >= accessor.min[size_t(j)] - 1e-4 &&
+                     positions[i][j] <= accessor.max[size_t(j)] + 1e-4;
+        }
+      }
+      CHECK(inBounds);
+    }
+  }
+}
+
+TEST_CASE("GltfReader decodes images in parallel with an async system") {
+  auto pTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(4);
+  CesiumAsync::AsyncSystem asyncSystem{pTaskProcessor};
+
+  const std::filesystem::path path =
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/CesiumBalloon.glb");
+  const std::vector<std::byte> data = readFile(path);
+
+  GltfReader reader;
+  GltfReaderResult serial = reader.readGltf(gsl::span(data));
+
+  GltfReaderOptions options;
+  options.asyncSystem = asyncSystem;
+  SECTION("with the default limit") {}
+  SECTION("limited to one thread") {
+    options.maximumSimultaneousImageDecodes = 1;
+  }
+  GltfReaderResult parallel = reader.readGltf(gsl::span(data), options);
+
+  REQUIRE(serial.model);
+  REQUIRE(parallel.model);
+  CHECK(parallel.errors.empty());
+  CHECK(parallel.warnings == serial.warnings);
+
+  REQUIRE(parallel.model->images.size() == serial.model->images.size());
+  REQUIRE(parallel.model->images.size() > 1);
+  for (size_t i = 0; i < serial.model->images.size(); ++i) {
+    const ImageCesium& image = parallel.model->images[i].cesium;
+    CHECK(image.width == serial.model->images[i].cesium.width);
+    CHECK(image.height == serial.model->images[i].cesium.height);
+    CHECK(image.pixelData == serial.model->images[i].cesium.pixelData);
+  }
+}
+
+TEST_CASE("GltfReader can decode images smaller and without alpha") {
+  const std::filesystem::path path =
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/CesiumBalloon.glb");
+  const std::vector<std::byte> data = readFile(path);
+
+  GltfReader reader;
+  GltfReaderResult full = reader.readGltf(gsl::span(data));
+
+  GltfReaderOptions options;
+  options.maximumImageDimension = 100;
+  options.decodeOpaqueImagesToRgb = true;
+  GltfReaderResult reduced = reader.readGltf(gsl::span(data), options);
+
+  REQUIRE(full.model);
+  REQUIRE(reduced.model);
+  CHECK(reduced.errors.empty());
+
+  REQUIRE(reduced.model->images.size() == full.model->images.size());
+  for (size_t i = 0; i < full.model->images.size(); ++i) {
+    const ImageCesium& fullImage = full.model->images[i].cesium;
+    const ImageCesium& image = reduced.model->images[i].cesium;
+
+    // The balloon's images are all JPEGs, which have no alpha channel.
+    CHECK(image.channels == 3);
+    CHECK(image.bytesPerChannel == 1);
+    CHECK(image.width > 0);
+    CHECK(image.height > 0);
+    CHECK(image.width <= options.maximumImageDimension);
+    CHECK(image.height <= options.maximumImageDimension);
+    CHECK(
+        image.pixelData.size() ==
+        size_t(image.width * image.height * image.channels));
+
+    const double fullAspect = double(fullImage.width) / fullImage.height;
+    const double aspect = double(image.width) / image.height;
+    CHECK(aspect == Approx(fullAspect).epsilon(0.05));
+  }
+}
+
+TEST_CASE("GltfReader decodes into vectors from the decoded data allocator") {
+  class CountingAllocator : public DecodedDataAllocator {
+  public:
+    std::atomic<int32_t> vectors{0};
+
+  protected:
+    std::vector<std::byte>
+    allocateBytes(DecodedDataKind kind, size_t byteSize) override {
+      ++this->vectors;
+      return DecodedDataAllocator::allocateBytes(kind, byteSize);
+    }
+  };
+
+  auto pAllocator = std::make_shared<CountingAllocator>();
+  GltfReaderOptions options;
+  options.pDecodedDataAllocator = pAllocator;
+  GltfReader reader;
+
+  SECTION("meshopt buffers") {
+    GltfReaderResult result = reader.readGltf(
+        readFile(
+            CesiumGltfReader_TEST_DATA_DIR +
+            std::string("/DucksMeshopt/Duck-vp-12-vt-12-vn-12.glb")),
+        options);
+    REQUIRE(result.model);
+
+    CHECK(pAllocator->getAllocatedBytes(DecodedDataKind::MeshOpt) > 0);
+    CHECK(pAllocator->getAllocatedBytes(DecodedDataKind::Draco) == 0);
+    CHECK(pAllocator->getAllocatedBytes(DecodedDataKind::Ktx2) == 0);
+  }
+
+  SECTION("images") {
+    GltfReaderResult result = reader.readGltf(
+        readFile(
+            CesiumGltfReader_TEST_DATA_DIR +
+            std::string("/CesiumBalloon.glb")),
+        options);
+    REQUIRE(result.model);
+
+    int64_t imageBytes = 0;
+    for (const Image& image : result.model->images) {
+      imageBytes += int64_t(image.cesium.pixelData.size());
+    }
+    CHECK(imageBytes > 0);
+    CHECK(pAllocator->getAllocatedBytes(DecodedDataKind::Image) == imageBytes);
+    CHECK(pAllocator->getAllocatedBytes(DecodedDataKind::MeshOpt) == 0);
+  }
+
+  CHECK(pAllocator->vectors > 0);
+  CHECK(
+      pAllocator->getTotalAllocatedBytes() ==
+      pAllocator->getAllocatedBytes(DecodedDataKind::Draco) +
+          pAllocator->getAllocatedBytes(DecodedDataKind::MeshOpt) +
+          pAllocator->getAllocatedBytes(DecodedDataKind::DequantizedMeshData) +
+          pAllocator->getAllocatedBytes(DecodedDataKind::Image) +
+          pAllocator->getAllocatedBytes(DecodedDataKind::Ktx2));
+}
+
 TEST_CASE("GltfReader::postprocessGltf") {
   GltfReaderOptions options;
   GltfReader reader;
@@ -782,3 +1485,131 @@ TEST_CASE("GltfReader::postprocessGltf") {
     CHECK(s == "test");
   }
 }
+
+TEST_CASE("Reading a GLB from an owned buffer produces the same model") {
+  const std::filesystem::path path =
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/CesiumBalloon.glb");
+
+  GltfReader reader;
+  const std::vector<std::byte> data = readFile(path);
+  GltfReaderResult fromSpan = reader.readGltf(gsl::span(data));
+  REQUIRE(fromSpan.model);
+
+  std::vector<std::byte> owned = readFile(path);
+  const std::byte* pOriginalAllocation = owned.data();
+  GltfReaderResult fromOwned = reader.readGltf(std::move(owned));
+  REQUIRE(fromOwned.model);
+  CHECK(fromOwned.errors.empty());
+
+  REQUIRE(!fromOwned.model->buffers.empty());
+  const std::vector<std::byte>& binary =
+      fromOwned.model->buffers[0].cesium.data;
+  CHECK(binary.data() == pOriginalAllocation);
+  CHECK(int64_t(binary.size()) == fromOwned.model->buffers[0].byteLength);
+  CHECK(binary == fromSpan.model->buffers[0].cesium.data);
+  CHECK(fromOwned.model->meshes.size() == fromSpan.model->meshes.size());
+  CHECK(fromOwned.model->images.size() == fromSpan.model->images.size());
+}
+
+TEST_CASE("Reading a glTF stops when its cancellation token is canceled") {
+  const std::filesystem::path path =
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/CesiumBalloon.glb");
+  const std::vector<std::byte> data = readFile(path);
+
+  GltfReader reader;
+  CesiumAsync::CancellationTokenSource cancellation;
+  GltfReaderOptions options;
+  options.cancellationToken = cancellation.getToken();
+
+  GltfReaderResult notCanceled = reader.readGltf(gsl::span(data), options);
+  CHECK(notCanceled.model);
+  CHECK(notCanceled.errors.empty());
+
+  cancellation.cancel();
+  GltfReaderResult canceled = reader.readGltf(gsl::span(data), options);
+  CHECK(!canceled.model);
+  CHECK(!canceled.errors.empty());
+}
+
+namespace {
+// Passes each response body to the data callback in small pieces, as a
+// network accessor would while the body downloads.
+class ChunkedAssetAccessor : public SimpleAssetAccessor {
+public:
+  using SimpleAssetAccessor::SimpleAssetAccessor;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  getStreaming(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const CesiumAsync::CancellationToken&,
+      TDataCallback onData) override {
+    auto mockRequestIt = this->mockCompletedRequests.find(url);
+    REQUIRE(mockRequestIt != this->mockCompletedRequests.end());
+    const gsl::span<const std::byte> data =
+        mockRequestIt->second->response()->data();
+    for (size_t i = 0; i < data.size(); i += this->chunkSize) {
+      onData(data.subspan(i, std::min(this->chunkSize, data.size() - i)));
+      ++this->chunks;
+    }
+    return this->get(asyncSystem, url, headers);
+  }
+
+  size_t chunkSize = 4096;
+  size_t chunks = 0;
+};
+} // namespace
+
+TEST_CASE("GltfReader::loadGltf reads a GLB while it is streamed") {
+  auto pMockTaskProcessor = std::make_shared<SimpleTaskProcessor>();
+  CesiumAsync::AsyncSystem asyncSystem{pMockTaskProcessor};
+
+  const std::filesystem::path path =
+      CesiumGltfReader_TEST_DATA_DIR + std::string("/CesiumBalloon.glb");
+  const std::string url = "file:///" + path.generic_u8string();
+  const std::vector<std::byte> data = readFile(path);
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mapUrlToRequest;
+  mapUrlToRequest[url] = std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      CesiumAsync::HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          uint16_t(200),
+          "application/binary",
+          CesiumAsync::HttpHeaders{},
+          std::vector<std::byte>(data)));
+  auto pAccessor =
+      std::make_shared<ChunkedAssetAccessor>(std::move(mapUrlToRequest));
+
+  GltfReader reader;
+  GltfReaderResult expected = reader.readGltf(gsl::span(data));
+  REQUIRE(expected.model);
+
+  SECTION("in small pieces") { pAccessor->chunkSize = 1000; }
+  SECTION("in a single piece") { pAccessor->chunkSize = data.size(); }
+
+  GltfReaderResult result = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(asyncSystem, url, {}, pAccessor));
+  REQUIRE(result.model);
+  CHECK(result.errors.empty());
+  CHECK(pAccessor->chunks == (data.size() + pAccessor->chunkSize - 1) /
+                                 pAccessor->chunkSize);
+
+  REQUIRE(result.model->buffers.size() == expected.model->buffers.size());
+  CHECK(
+      result.model->buffers[0].cesium.data ==
+      expected.model->buffers[0].cesium.data);
+
+  REQUIRE(result.model->images.size() == expected.model->images.size());
+  for (size_t i = 0; i < result.model->images.size(); ++i) {
+    const CesiumGltf::ImageCesium& image = result.model->images[i].cesium;
+    const CesiumGltf::ImageCesium& expectedImage =
+        expected.model->images[i].cesium;
+    CHECK(image.width == expectedImage.width);
+    CHECK(image.height == expectedImage.height);
+    CHECK(image.pixelData == expectedImage.pixelData);
+  }
+}
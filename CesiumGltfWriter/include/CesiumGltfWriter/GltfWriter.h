@@ -6,6 +6,10 @@
 
 #include <gsl/span>
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 // forward declarations
 namespace CesiumGltf {
 struct Model;
@@ -34,6 +38,57 @@ struct CESIUMGLTFWRITER_API GltfWriterResult {
   std::vector<std::string> warnings;
 };
 
+/**
+ * @brief A glb written by {@link GltfWriter::writeGlbSegments} as segments
+ * that refer to the binary chunk data instead of copying it.
+ *
+ * Writing the segments in order, for example with a single `writev`, produces
+ * the same bytes as {@link GltfWriter::writeGlb}. An instance can be passed to
+ * `writeGlbSegments` again to reuse its memory for the next glb.
+ *
+ * The segments refer to this object's own storage, so it can be moved but not
+ * copied.
+ */
+struct CESIUMGLTFWRITER_API GltfWriterGlbSegments {
+  GltfWriterGlbSegments() = default;
+  GltfWriterGlbSegments(const GltfWriterGlbSegments&) = delete;
+  GltfWriterGlbSegments(GltfWriterGlbSegments&&) noexcept = default;
+  GltfWriterGlbSegments& operator=(const GltfWriterGlbSegments&) = delete;
+  GltfWriterGlbSegments& operator=(GltfWriterGlbSegments&&) noexcept = default;
+
+  /**
+   * @brief The segments of the glb, in order.
+   *
+   * The first holds the glb header, the JSON chunk, and the header of the
+   * binary chunk, if any. The next ones are the binary chunk data and its
+   * padding. They are valid until this object is written to again or
+   * destroyed, and the binary chunk data for as long as the buffer data given
+   * to `writeGlbSegments` is.
+   */
+  std::vector<gsl::span<const std::byte>> segments;
+
+  /**
+   * @brief The storage of the first segment, which keeps its capacity when
+   * this object is reused.
+   */
+  std::vector<std::byte> headerAndJson;
+
+  /**
+   * @brief Errors, if any, that occurred during the write process.
+   */
+  std::vector<std::string> errors;
+
+  /**
+   * @brief Warnings, if any, that occurred during the write process.
+   */
+  std::vector<std::string> warnings;
+
+  /**
+   * @brief Gets the total size of the segments, which is the size of the glb.
+   */
+  size_t getByteLength() const noexcept;
+};
+
 /**
  * @brief Options for how to write a glTF.
  */
@@ -105,6 +160,27 @@ public:
       const gsl::span<const std::byte>& bufferData,
       const GltfWriterOptions& options = GltfWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided model into glb segments, without copying
+   * the buffer data.
+   *
+   * @details This is like {@link writeGlb}, but rather than copying the buffer
+   * data into a single vector with the rest of the glb, the result refers to
+   * it. The result's storage is reused, so writing many glbs with the same
+   * result object allocates less memory.
+   *
+   * @param model The model.
+   * @param bufferData The buffer data to store in the GLB binary chunk. It
+   * must outlive the use of the result's segments.
+   * @param result The result, which is overwritten.
+   * @param options Options for how to write the glb.
+   */
+  void writeGlbSegments(
+      const CesiumGltf::Model& model,
+      const gsl::span<const std::byte>& bufferData,
+      GltfWriterGlbSegments& result,
+      const GltfWriterOptions& options = GltfWriterOptions()) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -7,6 +7,11 @@
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
 namespace CesiumGltfWriter {
 
 namespace {
@@ -19,24 +24,37 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
   return padding;
 }
 
-[[nodiscard]] std::vector<std::byte> writeGlbBuffer(
-    const gsl::span<const std::byte>& jsonData,
-    const gsl::span<const std::byte>& bufferData,
+// The sizes of the parts of a glb.
+struct GlbLayout {
+  size_t jsonChunkDataSize;
+  size_t jsonPaddingSize;
+  size_t binaryChunkDataSize;
+  size_t binaryPaddingSize;
+  size_t glbSize;
+
+  // The size of everything before the binary chunk data.
+  size_t prefixSize;
+};
+
+constexpr size_t headerSize = 12;
+constexpr size_t chunkHeaderSize = 8;
+
+[[nodiscard]] GlbLayout computeGlbLayout(
+    size_t jsonSize,
+    size_t bufferSize,
     size_t binaryChunkByteAlignment) {
   assert(binaryChunkByteAlignment > 0 && binaryChunkByteAlignment % 4 == 0);
 
-  size_t headerSize = 12;
-  size_t chunkHeaderSize = 8;
-
   size_t jsonPaddingSize =
-      getPadding(headerSize + chunkHeaderSize + jsonData.size(), 4);
-  size_t jsonChunkDataSize = jsonData.size() + jsonPaddingSize;
+      getPadding(headerSize + chunkHeaderSize + jsonSize, 4);
+  size_t jsonChunkDataSize = jsonSize + jsonPaddingSize;
   size_t glbSize = headerSize + chunkHeaderSize + jsonChunkDataSize;
 
   size_t binaryPaddingSize = 0;
   size_t binaryChunkDataSize = 0;
+  size_t prefixSize = glbSize;
 
-  if (bufferData.size() > 0) {
+  if (bufferSize > 0) {
     size_t extraJsonPadding =
         getPadding(glbSize + chunkHeaderSize, binaryChunkByteAlignment);
     if (extraJsonPadding > 0) {
@@ -45,29 +63,46 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
       glbSize += extraJsonPadding;
     }
 
-    binaryPaddingSize =
-        getPadding(glbSize + chunkHeaderSize + bufferData.size(), 4);
-    binaryChunkDataSize = bufferData.size() + binaryPaddingSize;
+    binaryPaddingSize = getPadding(glbSize + chunkHeaderSize + bufferSize, 4);
+    binaryChunkDataSize = bufferSize + binaryPaddingSize;
+    prefixSize = glbSize + chunkHeaderSize;
     glbSize += chunkHeaderSize + binaryChunkDataSize;
   }
 
-  std::vector<std::byte> glb(glbSize);
-  uint8_t* glb8 = reinterpret_cast<uint8_t*>(glb.data());
-  uint32_t* glb32 = reinterpret_cast<uint32_t*>(glb.data());
+  return GlbLayout{
+      jsonChunkDataSize,
+      jsonPaddingSize,
+      binaryChunkDataSize,
+      binaryPaddingSize,
+      glbSize,
+      prefixSize};
+}
+
+void writeUint32(uint8_t* pDestination, uint32_t value) noexcept {
+  memcpy(pDestination, &value, sizeof(value));
+}
 
+// Writes the glb header, the JSON chunk, and the binary chunk header, if
+// any, which together are layout.prefixSize bytes.
+void writeGlbPrefix(
+    uint8_t* glb8,
+    const GlbLayout& layout,
+    const std::string_view& jsonData) {
   // GLB header
   size_t byteOffset = 0;
   glb8[byteOffset++] = 'g';
   glb8[byteOffset++] = 'l';
   glb8[byteOffset++] = 'T';
   glb8[byteOffset++] = 'F';
-  glb32[byteOffset / 4] = 2;
+  writeUint32(glb8 + byteOffset, 2);
   byteOffset += 4;
-  glb32[byteOffset / 4] = static_cast<uint32_t>(glbSize);
+  writeUint32(glb8 + byteOffset, static_cast<uint32_t>(layout.glbSize));
   byteOffset += 4;
 
   // JSON chunk header
-  glb32[byteOffset / 4] = static_cast<uint32_t>(jsonChunkDataSize);
+  writeUint32(
+      glb8 + byteOffset,
+      static_cast<uint32_t>(layout.jsonChunkDataSize));
   byteOffset += 4;
   glb8[byteOffset++] = 'J';
   glb8[byteOffset++] = 'S';
@@ -79,28 +114,62 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
   byteOffset += jsonData.size();
 
   // JSON chunk padding
-  memset(glb8 + byteOffset, ' ', jsonPaddingSize);
-  byteOffset += jsonPaddingSize;
+  memset(glb8 + byteOffset, ' ', layout.jsonPaddingSize);
+  byteOffset += layout.jsonPaddingSize;
 
-  if (bufferData.size() > 0) {
+  if (layout.binaryChunkDataSize > 0) {
     // Binary chunk header
-    glb32[byteOffset / 4] = static_cast<uint32_t>(binaryChunkDataSize);
+    writeUint32(
+        glb8 + byteOffset,
+        static_cast<uint32_t>(layout.binaryChunkDataSize));
     byteOffset += 4;
     glb8[byteOffset++] = 'B';
     glb8[byteOffset++] = 'I';
     glb8[byteOffset++] = 'N';
     glb8[byteOffset++] = 0;
+  }
+
+  assert(byteOffset == layout.prefixSize);
+}
+
+[[nodiscard]] std::vector<std::byte> writeGlbBuffer(
+    const std::string_view& jsonData,
+    const gsl::span<const std::byte>& bufferData,
+    size_t binaryChunkByteAlignment) {
+  const GlbLayout layout = computeGlbLayout(
+      jsonData.size(),
+      bufferData.size(),
+      binaryChunkByteAlignment);
+
+  std::vector<std::byte> glb(layout.glbSize);
+  uint8_t* glb8 = reinterpret_cast<uint8_t*>(glb.data());
+  writeGlbPrefix(glb8, layout, jsonData);
+
+  if (bufferData.size() > 0) {
+    size_t byteOffset = layout.prefixSize;
 
     // Binary chunk
     memcpy(glb8 + byteOffset, bufferData.data(), bufferData.size());
     byteOffset += bufferData.size();
 
     // Binary chunk padding
-    memset(glb8 + byteOffset, 0, binaryPaddingSize);
+    memset(glb8 + byteOffset, 0, layout.binaryPaddingSize);
   }
 
   return glb;
 }
+
+// The binary chunk is padded to 4 bytes.
+constexpr std::array<std::byte, 3> binaryPadding{};
+
+std::unique_ptr<CesiumJsonWriter::JsonWriter>
+createJsonWriter(const GltfWriterOptions& options) {
+  if (options.prettyPrint) {
+    return std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+  } else {
+    return std::make_unique<CesiumJsonWriter::JsonWriter>();
+  }
+}
 } // namespace
 
 GltfWriter::GltfWriter() { registerWriterExtensions(this->_context); }
@@ -123,13 +192,8 @@ GltfWriterResult GltfWriter::writeGltf(
       this->getExtensions();
 
   GltfWriterResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
-
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
-  }
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      createJsonWriter(options);
 
   ModelJsonWriter::write(model, *writer, context);
   result.gltfBytes = writer->toBytes();
@@ -148,23 +212,68 @@ GltfWriterResult GltfWriter::writeGlb(
 
   GltfWriterResult result;
 
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
-
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
-  }
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      createJsonWriter(options);
 
   ModelJsonWriter::write(model, *writer, context);
-  std::vector<std::byte> jsonData = writer->toBytes();
 
   result.gltfBytes = writeGlbBuffer(
-      gsl::span(jsonData),
+      writer->toStringView(),
       bufferData,
       options.binaryChunkByteAlignment);
 
   return result;
 }
 
+void GltfWriter::writeGlbSegments(
+    const CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    GltfWriterGlbSegments& result,
+    const GltfWriterOptions& options) const {
+  CESIUM_TRACE("GltfWriter::writeGlbSegments");
+
+  const CesiumJsonWriter::ExtensionWriterContext& context =
+      this->getExtensions();
+
+  result.segments.clear();
+  result.errors.clear();
+  result.warnings.clear();
+
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      createJsonWriter(options);
+
+  ModelJsonWriter::write(model, *writer, context);
+  const std::string_view jsonData = writer->toStringView();
+
+  const GlbLayout layout = computeGlbLayout(
+      jsonData.size(),
+      bufferData.size(),
+      options.binaryChunkByteAlignment);
+
+  // Resizing within the capacity doesn't allocate.
+  result.headerAndJson.resize(layout.prefixSize);
+  writeGlbPrefix(
+      reinterpret_cast<uint8_t*>(result.headerAndJson.data()),
+      layout,
+      jsonData);
+
+  result.segments.emplace_back(result.headerAndJson);
+  if (bufferData.size() > 0) {
+    result.segments.emplace_back(bufferData);
+    if (layout.binaryPaddingSize > 0) {
+      result.segments.emplace_back(
+          binaryPadding.data(),
+          layout.binaryPaddingSize);
+    }
+  }
+}
+
+size_t GltfWriterGlbSegments::getByteLength() const noexcept {
+  size_t byteLength = 0;
+  for (const gsl::span<const std::byte>& segment : this->segments) {
+    byteLength += segment.size();
+  }
+  return byteLength;
+}
+
 } // namespace CesiumGltfWriter
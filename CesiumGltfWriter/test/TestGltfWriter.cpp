@@ -579,3 +579,53 @@ TEST_CASE("Writes glb with binaryChunkByteAlignment of 8") {
 
   REQUIRE(glbBytesExtraPadding.size() == 88);
 }
+
+TEST_CASE("Writes glb segments") {
+  const std::vector<std::byte> bufferData(11, std::byte('!'));
+
+  CesiumGltf::Model model;
+  model.asset.version = "2.0";
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(bufferData.size());
+
+  CesiumGltfWriter::GltfWriter writer;
+  CesiumGltfWriter::GltfWriterOptions options;
+  options.binaryChunkByteAlignment = 8;
+
+  const CesiumGltfWriter::GltfWriterResult expected =
+      writer.writeGlb(model, gsl::span(bufferData), options);
+
+  auto concatenate =
+      [](const CesiumGltfWriter::GltfWriterGlbSegments& segments) {
+        std::vector<std::byte> result;
+        for (const gsl::span<const std::byte>& segment : segments.segments) {
+          result.insert(result.end(), segment.begin(), segment.end());
+        }
+        return result;
+      };
+
+  CesiumGltfWriter::GltfWriterGlbSegments segments;
+  writer.writeGlbSegments(model, gsl::span(bufferData), segments, options);
+
+  REQUIRE(segments.errors.empty());
+  REQUIRE(segments.warnings.empty());
+  REQUIRE(segments.segments.size() == 3);
+  CHECK(segments.segments[1].data() == bufferData.data());
+  CHECK(segments.getByteLength() == expected.gltfBytes.size());
+  CHECK(concatenate(segments) == expected.gltfBytes);
+
+  SECTION("reuses the segments for another glb") {
+    const std::byte* pStorage = segments.headerAndJson.data();
+    writer.writeGlbSegments(model, gsl::span(bufferData), segments, options);
+    CHECK(segments.headerAndJson.data() == pStorage);
+    CHECK(concatenate(segments) == expected.gltfBytes);
+  }
+
+  SECTION("writes only the header and JSON without buffer data") {
+    writer.writeGlbSegments(model, gsl::span<const std::byte>(), segments);
+    REQUIRE(segments.segments.size() == 1);
+    CHECK(
+        concatenate(segments) ==
+        writer.writeGlb(model, gsl::span<const std::byte>()).gltfBytes);
+  }
+}
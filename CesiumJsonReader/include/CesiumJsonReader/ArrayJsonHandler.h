@@ -28,7 +28,13 @@ public:
     JsonHandler::reset(pParent);
     this->_pArray = pArray;
     this->_arrayIsOpen = false;
-    this->_objectHandler.reset(this->_handlerFactory());
+
+    // The element handler is reset for each element, so it is created once
+    // and then reused by every array this handler reads. Creating it on first
+    // use, rather than in the constructor, allows recursive types.
+    if (!this->_objectHandler) {
+      this->_objectHandler.reset(this->_handlerFactory());
+    }
   }
 
   virtual IJsonHandler* readNull() override {
@@ -472,7 +478,10 @@ public:
     JsonHandler::reset(pParent);
     this->_pArray = pArray;
     this->_arrayIsOpen = false;
-    this->_elementHandler.reset(this->_handlerFactory());
+
+    if (!this->_elementHandler) {
+      this->_elementHandler.reset(this->_handlerFactory());
+    }
   }
 
   virtual IJsonHandler* readNull() override {
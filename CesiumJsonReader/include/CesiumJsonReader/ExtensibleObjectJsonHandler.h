@@ -23,6 +23,14 @@ protected:
       const std::string_view& str,
       CesiumUtility::ExtensibleObject& o);
 
+  /**
+   * @brief Determines whether a property of an object of the given type is
+   * skipped by {@link JsonReaderOptions::skipProperty}, so that its value
+   * should be ignored.
+   */
+  bool isSkippedProperty(const char* objectType, const std::string_view& str)
+      const;
+
 private:
   CesiumJsonReader::DictionaryJsonHandler<
       CesiumUtility::JsonValue,
@@ -30,6 +38,8 @@ private:
       _extras;
   ExtensionsJsonHandler _extensions;
   JsonObjectJsonHandler _unknownProperties;
+  const JsonReaderOptions& _context;
   bool _captureUnknownProperties;
+  bool _captureExtras;
 };
 } // namespace CesiumJsonReader
@@ -11,10 +11,6 @@
 #include <string>
 #include <vector>
 
-namespace rapidjson {
-struct MemoryStream;
-}
-
 namespace CesiumJsonReader {
 
 /**
@@ -123,11 +119,11 @@ private:
     virtual void reportWarning(
         const std::string& warning,
         std::vector<std::string>&& context) override;
-    void setInputStream(rapidjson::MemoryStream* pInputStream) noexcept;
+    void setInputStream(rapidjson::InsituStringStream* pInputStream) noexcept;
 
   private:
     std::vector<std::string>& _warnings;
-    rapidjson::MemoryStream* _pInputStream;
+    rapidjson::InsituStringStream* _pInputStream;
   };
 
   static void internalRead(
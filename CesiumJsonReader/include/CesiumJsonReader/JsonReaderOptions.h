@@ -7,7 +7,10 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace CesiumJsonReader {
@@ -67,6 +70,80 @@ public:
     this->_captureUnknownProperties = value;
   }
 
+  /**
+   * @brief Gets a value indicating whether the `extras` of objects are
+   * captured in the {@link ExtensibleObject::extras} field.
+   *
+   * If this is false, `extras` are skipped without building any
+   * {@link CesiumUtility::JsonValue}, which saves time and memory for content
+   * that puts large `extras` on many objects but whose application doesn't
+   * use them.
+   */
+  bool getCaptureExtras() const { return this->_captureExtras; }
+
+  /**
+   * @brief Sets a value indicating whether the `extras` of objects are
+   * captured in the {@link ExtensibleObject::extras} field.
+   *
+   * If this is false, `extras` are skipped without building any
+   * {@link CesiumUtility::JsonValue}, which saves time and memory for content
+   * that puts large `extras` on many objects but whose application doesn't
+   * use them.
+   */
+  void setCaptureExtras(bool value) { this->_captureExtras = value; }
+
+  /**
+   * @brief Gets a value indicating whether extensions that don't have a
+   * registered statically-typed class are captured as a
+   * {@link CesiumUtility::JsonValue}.
+   *
+   * If this is false, they are skipped as if they were disabled, unless their
+   * state is set to `ExtensionState::JsonOnly` with
+   * {@link setExtensionState}.
+   */
+  bool getCaptureUnknownExtensions() const {
+    return this->_captureUnknownExtensions;
+  }
+
+  /**
+   * @brief Sets a value indicating whether extensions that don't have a
+   * registered statically-typed class are captured as a
+   * {@link CesiumUtility::JsonValue}.
+   *
+   * If this is false, they are skipped as if they were disabled, unless their
+   * state is set to `ExtensionState::JsonOnly` with
+   * {@link setExtensionState}.
+   */
+  void setCaptureUnknownExtensions(bool value) {
+    this->_captureUnknownExtensions = value;
+  }
+
+  /**
+   * @brief Skips a property of a type of object while reading, so that its
+   * value is not read into the object at all.
+   *
+   * This saves time and memory for applications that only need some of the
+   * properties, such as the geometry and materials of a model without its
+   * animations, cameras, and skins. To skip an extension, set its state to
+   * `ExtensionState::Disabled` with {@link setExtensionState} instead.
+   *
+   * @param objectType The `TypeName` of the object type, such as `"Model"`.
+   * Properties inherited from a base type are skipped for the derived type
+   * given here.
+   * @param propertyName The name of the property in the JSON, such as
+   * `"animations"`.
+   */
+  void
+  skipProperty(const std::string& objectType, const std::string& propertyName);
+
+  /**
+   * @brief Determines whether a property of a type of object is skipped by
+   * {@link skipProperty}.
+   */
+  bool isPropertySkipped(
+      const std::string_view& objectType,
+      const std::string_view& propertyName) const;
+
   /**
    * @brief Registers an extension for an object.
    *
@@ -134,6 +211,8 @@ public:
       const std::string& extendedObjectType) const;
 
 private:
+  std::unique_ptr<IExtensionJsonHandler> createUnknownExtensionHandler() const;
+
   using ExtensionHandlerFactory =
       std::function<std::unique_ptr<IExtensionJsonHandler>(
           const JsonReaderOptions&)>;
@@ -142,7 +221,11 @@ private:
 
   ExtensionNameMap _extensions;
   std::unordered_map<std::string, ExtensionState> _extensionStates;
+  std::map<std::string, std::set<std::string, std::less<>>, std::less<>>
+      _skippedProperties;
   bool _captureUnknownProperties = true;
+  bool _captureExtras = true;
+  bool _captureUnknownExtensions = true;
 };
 
 } // namespace CesiumJsonReader
@@ -11,7 +11,9 @@ ExtensibleObjectJsonHandler::ExtensibleObjectJsonHandler(
     : ObjectJsonHandler(),
       _extras(),
       _extensions(context),
-      _captureUnknownProperties(context.getCaptureUnknownProperties()) {}
+      _context(context),
+      _captureUnknownProperties(context.getCaptureUnknownProperties()),
+      _captureExtras(context.getCaptureExtras()) {}
 
 void ExtensibleObjectJsonHandler::reset(
     IJsonHandler* pParent,
@@ -25,8 +27,12 @@ IJsonHandler* ExtensibleObjectJsonHandler::readObjectKeyExtensibleObject(
     CesiumUtility::ExtensibleObject& o) {
   using namespace std::string_literals;
 
-  if ("extras"s == str)
+  if ("extras"s == str) {
+    if (!this->_captureExtras) {
+      return this->ignoreAndContinue();
+    }
     return property("extras", this->_extras, o.extras);
+  }
 
   if ("extensions"s == str) {
     this->_extensions.reset(this, &o, objectType);
@@ -46,4 +52,10 @@ IJsonHandler* ExtensibleObjectJsonHandler::readObjectKeyExtensibleObject(
     return this->ignoreAndContinue();
   }
 }
+
+bool ExtensibleObjectJsonHandler::isSkippedProperty(
+    const char* objectType,
+    const std::string_view& str) const {
+  return this->_context.isPropertySkipped(objectType, str);
+}
 } // namespace CesiumJsonReader
@@ -3,6 +3,8 @@
 #include <rapidjson/reader.h>
 
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 namespace CesiumJsonReader {
 namespace {
@@ -116,7 +118,7 @@ void JsonReader::FinalJsonHandler::reportWarning(
 }
 
 void JsonReader::FinalJsonHandler::setInputStream(
-    rapidjson::MemoryStream* pInputStream) noexcept {
+    rapidjson::InsituStringStream* pInputStream) noexcept {
   this->_pInputStream = pInputStream;
 }
 
@@ -127,10 +129,16 @@ void JsonReader::FinalJsonHandler::setInputStream(
     std::vector<std::string>& errors,
     std::vector<std::string>& /* warnings */) {
 
+  // Parse a null-terminated copy of the data in situ. RapidJSON then unescapes
+  // strings in place and hands them to the handlers without first copying
+  // them to its own stack, and it can skip whitespace and scan strings with
+  // SIMD instructions, which it only does for in situ and string streams.
+  std::vector<char> buffer(data.size() + 1);
+  std::memcpy(buffer.data(), data.data(), data.size());
+  buffer.back() = '\0';
+
   rapidjson::Reader reader;
-  rapidjson::MemoryStream inputStream(
-      reinterpret_cast<const char*>(data.data()),
-      data.size());
+  rapidjson::InsituStringStream inputStream(buffer.data());
 
   finalHandler.setInputStream(&inputStream);
 
@@ -141,7 +149,8 @@ void JsonReader::FinalJsonHandler::setInputStream(
   bool success = true;
   while (success && !reader.IterativeParseComplete()) {
     success = reader.IterativeParseNext<
-        rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag>(
+        rapidjson::kParseDefaultFlags | rapidjson::kParseInsituFlag |
+        rapidjson::kParseFullPrecisionFlag>(
         inputStream,
         dispatcher);
   }
@@ -34,6 +34,24 @@ void JsonReaderOptions::setExtensionState(
   this->_extensionStates[extensionName] = newState;
 }
 
+void JsonReaderOptions::skipProperty(
+    const std::string& objectType,
+    const std::string& propertyName) {
+  this->_skippedProperties[objectType].insert(propertyName);
+}
+
+bool JsonReaderOptions::isPropertySkipped(
+    const std::string_view& objectType,
+    const std::string_view& propertyName) const {
+  if (this->_skippedProperties.empty()) {
+    return false;
+  }
+
+  auto it = this->_skippedProperties.find(objectType);
+  return it != this->_skippedProperties.end() &&
+         it->second.find(propertyName) != it->second.end();
+}
+
 std::unique_ptr<IExtensionJsonHandler>
 JsonReaderOptions::createExtensionHandler(
     const std::string_view& extensionName,
@@ -52,14 +70,23 @@ JsonReaderOptions::createExtensionHandler(
 
   auto extensionNameIt = this->_extensions.find(extensionNameString);
   if (extensionNameIt == this->_extensions.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+    return this->createUnknownExtensionHandler();
   }
 
   auto objectTypeIt = extensionNameIt->second.find(extendedObjectType);
   if (objectTypeIt == extensionNameIt->second.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+    return this->createUnknownExtensionHandler();
   }
 
   return objectTypeIt->second(*this);
 }
+
+std::unique_ptr<IExtensionJsonHandler>
+JsonReaderOptions::createUnknownExtensionHandler() const {
+  if (!this->_captureUnknownExtensions) {
+    return nullptr;
+  }
+
+  return std::make_unique<AnyExtensionJsonHandler>();
+}
 } // namespace CesiumJsonReader
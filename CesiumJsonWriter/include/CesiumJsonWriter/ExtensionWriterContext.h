@@ -7,7 +7,7 @@
 #include <functional>
 #include <map>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 namespace CesiumJsonWriter {
 
@@ -110,17 +110,30 @@ public:
   void
   setExtensionState(const std::string& extensionName, ExtensionState newState);
 
+  /**
+   * @brief Gets the handler that writes an extension of an object, or nullptr
+   * if the extension is disabled.
+   *
+   * This doesn't allocate, so it is cheap to call for every extension of
+   * every object written.
+   *
+   * @param extensionName The name of the extension.
+   * @param extendedObjectType The `TypeName` of the extended object.
+   */
   ExtensionHandler<std::any> createExtensionHandler(
       const std::string_view& extensionName,
-      const std::string& extendedObjectType) const;
+      const std::string_view& extendedObjectType) const;
 
 private:
+  // The maps are ordered with a transparent comparator so that they can be
+  // searched with a string_view without constructing a std::string.
   using ObjectTypeToHandler =
-      std::unordered_map<std::string, ExtensionHandler<std::any>>;
-  using ExtensionNameMap = std::map<std::string, ObjectTypeToHandler>;
+      std::map<std::string, ExtensionHandler<std::any>, std::less<>>;
+  using ExtensionNameMap =
+      std::map<std::string, ObjectTypeToHandler, std::less<>>;
 
   ExtensionNameMap _extensions;
-  std::unordered_map<std::string, ExtensionState> _extensionStates;
+  std::map<std::string, ExtensionState, std::less<>> _extensionStates;
 };
 
 } // namespace CesiumJsonWriter
@@ -71,5 +71,12 @@ public:
   virtual std::string toString();
   virtual std::string_view toStringView();
   virtual std::vector<std::byte> toBytes();
+
+  /**
+   * @brief Discards the JSON written so far, so that this writer can write a
+   * new document. The memory of its buffer is kept, so a writer that is
+   * reset and reused for many small documents rarely allocates.
+   */
+  virtual void reset();
 };
 } // namespace CesiumJsonWriter
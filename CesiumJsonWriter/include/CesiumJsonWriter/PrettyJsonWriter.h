@@ -74,5 +74,6 @@ public:
   std::string toString() override;
   std::string_view toStringView() override;
   std::vector<std::byte> toBytes() override;
+  void reset() override;
 };
 } // namespace CesiumJsonWriter
@@ -17,14 +17,17 @@ void objWriter(
 }
 } // namespace
 
+void ExtensionWriterContext::setExtensionState(
+    const std::string& extensionName,
+    ExtensionState newState) {
+  this->_extensionStates[extensionName] = newState;
+}
+
 ExtensionWriterContext::ExtensionHandler<std::any>
 ExtensionWriterContext::createExtensionHandler(
     const std::string_view& extensionName,
-    const std::string& extendedObjectType) const {
-
-  std::string extensionNameString{extensionName};
-
-  auto stateIt = this->_extensionStates.find(extensionNameString);
+    const std::string_view& extendedObjectType) const {
+  auto stateIt = this->_extensionStates.find(extensionName);
   if (stateIt != this->_extensionStates.end()) {
     if (stateIt->second == ExtensionState::Disabled) {
       return nullptr;
@@ -33,7 +36,7 @@ ExtensionWriterContext::createExtensionHandler(
     }
   }
 
-  auto extensionNameIt = this->_extensions.find(extensionNameString);
+  auto extensionNameIt = this->_extensions.find(extensionName);
   if (extensionNameIt == this->_extensions.end()) {
     return objWriter;
   }
@@ -146,4 +146,9 @@ std::vector<std::byte> JsonWriter::toBytes() {
   return result;
 }
 
+void JsonWriter::reset() {
+  _compactBuffer.Clear();
+  compact->Reset(_compactBuffer);
+}
+
 } // namespace CesiumJsonWriter
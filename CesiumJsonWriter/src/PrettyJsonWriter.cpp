@@ -163,4 +163,9 @@ std::vector<std::byte> PrettyJsonWriter::toBytes() {
   std::copy(view.begin(), view.end(), u8Pointer);
   return result;
 }
+
+void PrettyJsonWriter::reset() {
+  _prettyBuffer.Clear();
+  pretty->Reset(_prettyBuffer);
+}
 } // namespace CesiumJsonWriter
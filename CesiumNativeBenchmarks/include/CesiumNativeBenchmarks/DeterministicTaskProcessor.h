@@ -0,0 +1,58 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief A task processor that queues worker thread tasks and runs them in
+ * the order in which they were started, in the thread that calls
+ * {@link runQueuedTasks}.
+ *
+ * Together with an asset accessor whose requests resolve immediately, this
+ * makes the order in which a tileset loads its tiles the same every time it
+ * is replayed.
+ */
+class DeterministicTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_tasks.emplace_back(std::move(f));
+  }
+
+  /**
+   * @brief Runs the queued tasks, and any task that they start, until the
+   * queue is empty.
+   *
+   * @return The number of tasks that were run.
+   */
+  size_t runQueuedTasks() {
+    size_t count = 0;
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        if (this->_tasks.empty()) {
+          return count;
+        }
+        task = std::move(this->_tasks.front());
+        this->_tasks.pop_front();
+      }
+
+      task();
+      ++count;
+    }
+  }
+
+private:
+  std::mutex _mutex;
+  std::deque<std::function<void()>> _tasks;
+};
+
+} // namespace CesiumNativeBenchmarks
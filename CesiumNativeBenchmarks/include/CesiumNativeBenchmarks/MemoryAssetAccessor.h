@@ -0,0 +1,105 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief An asset accessor that serves responses held in memory, so that
+ * benchmarks don't measure the network or the file system.
+ *
+ * Unlike `CesiumNativeTests::SimpleAssetAccessor`, it doesn't depend on
+ * Catch2. A URL without a response gets a 404 response.
+ */
+class MemoryAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @brief Adds a response with status 200 for the given URL.
+   */
+  void add(
+      const std::string& url,
+      const std::string& contentType,
+      std::vector<std::byte>&& data) {
+    this->add(
+        url,
+        200,
+        contentType,
+        CesiumAsync::HttpHeaders{},
+        std::move(data));
+  }
+
+  /**
+   * @brief Adds a response for the given URL, such as one that was recorded
+   * by a `CesiumAsync::RecordingAssetAccessor`.
+   */
+  void add(
+      const std::string& url,
+      uint16_t statusCode,
+      const std::string& contentType,
+      const CesiumAsync::HttpHeaders& headers,
+      std::vector<std::byte>&& data) {
+    this->_requests[url] =
+        createRequest(url, statusCode, contentType, headers, std::move(data));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>&) override {
+    auto it = this->_requests.find(url);
+    if (it != this->_requests.end()) {
+      return asyncSystem.createResolvedFuture(
+          std::shared_ptr<CesiumAsync::IAssetRequest>(it->second));
+    }
+
+    return asyncSystem.createResolvedFuture(
+        std::shared_ptr<CesiumAsync::IAssetRequest>(
+            createRequest(url, 404, "text/plain", {}, {})));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>&) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+private:
+  static std::shared_ptr<CesiumNativeTests::SimpleAssetRequest> createRequest(
+      const std::string& url,
+      uint16_t statusCode,
+      const std::string& contentType,
+      const CesiumAsync::HttpHeaders& headers,
+      std::vector<std::byte>&& data) {
+    return std::make_shared<CesiumNativeTests::SimpleAssetRequest>(
+        "GET",
+        url,
+        CesiumAsync::HttpHeaders{},
+        std::make_unique<CesiumNativeTests::SimpleAssetResponse>(
+            statusCode,
+            contentType,
+            headers,
+            std::move(data)));
+  }
+
+  std::map<std::string, std::shared_ptr<CesiumNativeTests::SimpleAssetRequest>>
+      _requests;
+};
+
+} // namespace CesiumNativeBenchmarks
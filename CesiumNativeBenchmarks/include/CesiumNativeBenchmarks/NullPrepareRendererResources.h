@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Renderer resources that prepare nothing, so that replaying a
+ * tileset measures loading and selecting its tiles without a renderer.
+ */
+class NullPrepareRendererResources
+    : public Cesium3DTilesSelection::IPrepareRendererResources {
+public:
+  virtual CesiumAsync::Future<
+      Cesium3DTilesSelection::TileLoadResultAndRenderResources>
+  prepareInLoadThread(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      Cesium3DTilesSelection::TileLoadResult&& tileLoadResult,
+      const glm::dmat4& /* transform */,
+      const std::any& /* rendererOptions */) override {
+    return asyncSystem.createResolvedFuture(
+        Cesium3DTilesSelection::TileLoadResultAndRenderResources{
+            std::move(tileLoadResult),
+            nullptr});
+  }
+
+  virtual void* prepareInMainThread(
+      Cesium3DTilesSelection::Tile& /* tile */,
+      void* /* pLoadThreadResult */) override {
+    return nullptr;
+  }
+
+  virtual void free(
+      Cesium3DTilesSelection::Tile& /* tile */,
+      void* /* pLoadThreadResult */,
+      void* /* pMainThreadResult */) noexcept override {}
+
+  virtual void* prepareRasterInLoadThread(
+      CesiumGltf::ImageCesium& /* image */,
+      const std::any& /* rendererOptions */) override {
+    return nullptr;
+  }
+
+  virtual void* prepareRasterInMainThread(
+      CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+      void* /* pLoadThreadResult */) override {
+    return nullptr;
+  }
+
+  virtual void freeRaster(
+      const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+      void* /* pLoadThreadResult */,
+      void* /* pMainThreadResult */) noexcept override {}
+
+  virtual void attachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& /* tile */,
+      int32_t /* overlayTextureCoordinateID */,
+      const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+      void* /* pMainThreadRendererResources */,
+      const glm::dvec2& /* translation */,
+      const glm::dvec2& /* scale */) override {}
+
+  virtual void detachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& /* tile */,
+      int32_t /* overlayTextureCoordinateID */,
+      const CesiumRasterOverlays::RasterOverlayTile& /* rasterTile */,
+      void* /* pMainThreadRendererResources */) noexcept override {}
+};
+
+} // namespace CesiumNativeBenchmarks
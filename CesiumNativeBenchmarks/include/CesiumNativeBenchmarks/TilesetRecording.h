@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetRequest.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief The camera of one frame of a {@link TilesetRecording}.
+ */
+struct RecordedView {
+  glm::dvec3 position{0.0};
+  glm::dvec3 direction{0.0, 0.0, -1.0};
+  glm::dvec3 up{0.0, 1.0, 0.0};
+  glm::dvec2 viewportSize{1.0};
+  double horizontalFieldOfView = 0.0;
+  double verticalFieldOfView = 0.0;
+
+  /**
+   * @brief Records the camera of the given view state.
+   */
+  static RecordedView
+  fromViewState(const Cesium3DTilesSelection::ViewState& viewState);
+
+  /**
+   * @brief Creates a view state with this camera, on the WGS84 ellipsoid.
+   */
+  Cesium3DTilesSelection::ViewState toViewState() const;
+};
+
+/**
+ * @brief A response of a {@link TilesetRecording}, served to the tileset
+ * again when the recording is replayed.
+ */
+struct RecordedResponse {
+  std::string url;
+  uint16_t statusCode = 0;
+  std::string contentType;
+  CesiumAsync::HttpHeaders headers;
+  std::vector<std::byte> data;
+};
+
+/**
+ * @brief A camera path through a tileset, and the responses to the requests
+ * that the tileset made while following it.
+ *
+ * A recording is stored in a directory, as a `recording.json` file that holds
+ * the tileset URL, the frames, and the responses without their data, and a
+ * `responses` subdirectory that holds the data of each response in its own
+ * file.
+ */
+struct TilesetRecording {
+  /**
+   * @brief The URL of the tileset, or of the layer.json of terrain.
+   */
+  std::string tilesetUrl;
+
+  /**
+   * @brief The camera of each frame, in order.
+   */
+  std::vector<RecordedView> frames;
+
+  /**
+   * @brief The recorded responses. When a URL was requested more than once,
+   * the last response wins.
+   */
+  std::vector<RecordedResponse> responses;
+
+  /**
+   * @brief Adds the responses of the given completed requests, such as the
+   * ones from `CesiumAsync::RecordingAssetAccessor::getRecordedRequests`.
+   *
+   * Requests without a response are ignored.
+   */
+  void addResponses(
+      const std::vector<std::shared_ptr<CesiumAsync::IAssetRequest>>&
+          requests);
+
+  /**
+   * @brief Writes this recording to the given directory, creating it if it
+   * doesn't exist.
+   *
+   * @throws std::runtime_error if the recording cannot be written.
+   */
+  void save(const std::filesystem::path& directory) const;
+
+  /**
+   * @brief Reads a recording that was written by {@link save}.
+   *
+   * @throws std::runtime_error if the recording cannot be read.
+   */
+  static TilesetRecording load(const std::filesystem::path& directory);
+
+  /**
+   * @brief Reads a camera path, which is a JSON file with the same `frames`
+   * array as a `recording.json` file.
+   *
+   * @throws std::runtime_error if the camera path cannot be read.
+   */
+  static std::vector<RecordedView>
+  loadCameraPath(const std::filesystem::path& fileName);
+};
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Reads a whole file, such as a dataset checked in for the tests.
+ *
+ * @throws std::runtime_error if the file cannot be read.
+ */
+std::vector<std::byte> readFile(const std::filesystem::path& fileName);
+
+} // namespace CesiumNativeBenchmarks
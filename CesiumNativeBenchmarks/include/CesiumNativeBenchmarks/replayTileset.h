@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumNativeBenchmarks/TilesetRecording.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief What happened in one frame of following a camera path.
+ */
+struct ReplayFrame {
+  /**
+   * @brief The time, in milliseconds, spent in `Tileset::updateView` and,
+   * when replaying, in running the worker thread tasks started by the
+   * previous frame.
+   */
+  double frameTime = 0.0;
+
+  /**
+   * @brief The `ViewUpdateResult::traversalTime` of the frame, in
+   * milliseconds.
+   */
+  double traversalTime = 0.0;
+
+  /**
+   * @brief The number of worker thread tasks that were run before the frame.
+   * This is always zero when recording.
+   */
+  size_t tasksRun = 0;
+
+  uint32_t tilesVisited = 0;
+  size_t tilesRendered = 0;
+  int32_t tilesLoaded = 0;
+  int64_t bytesLoaded = 0;
+  int64_t totalDataBytes = 0;
+  int32_t workerThreadTileLoadQueueLength = 0;
+  int32_t mainThreadTileLoadQueueLength = 0;
+  float loadProgress = 0.0f;
+};
+
+/**
+ * @brief The frames of following a camera path, and how long the tileset
+ * took to reach full detail for the last camera.
+ */
+struct ReplayResult {
+  /**
+   * @brief Every frame, including the ones after the camera path during which
+   * the tileset kept loading for the last camera.
+   */
+  std::vector<ReplayFrame> frames;
+
+  /**
+   * @brief The index of the first frame, at or after the end of the camera
+   * path, in which nothing was left to load. `std::nullopt` if the tileset
+   * did not reach full detail within the frame limit.
+   */
+  std::optional<size_t> fullDetailFrame;
+
+  /**
+   * @brief The sum of the frame times up to and including
+   * {@link fullDetailFrame}, in milliseconds.
+   */
+  double timeToFullDetail = 0.0;
+};
+
+/**
+ * @brief Follows a camera path through a tileset whose requests go to the
+ * given asset accessor, such as a `CesiumAsync::RecordingAssetAccessor`.
+ *
+ * The frames are paced at sixty per second, in real time, so that requests
+ * and worker threads have time to make progress, like in an application.
+ * After the last camera, frames continue with it until nothing is left to
+ * load, or until `additionalFrameLimit` more frames have passed.
+ */
+ReplayResult followCameraPath(
+    const std::string& tilesetUrl,
+    const std::vector<RecordedView>& frames,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const Cesium3DTilesSelection::TilesetOptions& options,
+    size_t additionalFrameLimit);
+
+/**
+ * @brief Replays a recording deterministically.
+ *
+ * The recorded responses are served from memory, and the worker thread tasks
+ * run in the order in which they were started, on the calling thread, before
+ * each frame. Frames are not paced, and every frame updates the view with a
+ * time step of a sixtieth of a second. So replaying the same recording with
+ * the same options loads the same tiles in the same frames, and only the
+ * times differ.
+ */
+ReplayResult replayTileset(
+    const TilesetRecording& recording,
+    const Cesium3DTilesSelection::TilesetOptions& options,
+    size_t additionalFrameLimit);
+
+} // namespace CesiumNativeBenchmarks
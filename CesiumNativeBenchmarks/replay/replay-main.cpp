@@ -0,0 +1,172 @@
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/FileAssetAccessor.h>
+#include <CesiumAsync/RecordingAssetAccessor.h>
+#include <CesiumAsync/WorkStealingTaskProcessor.h>
+#include <CesiumNativeBenchmarks/TilesetRecording.h>
+#include <CesiumNativeBenchmarks/replayTileset.h>
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumNativeBenchmarks;
+
+namespace {
+
+// How many frames to keep updating the last camera of the path while the
+// tileset is still loading.
+constexpr size_t additionalFrameLimit = 3600;
+
+void printUsage() {
+  std::cerr
+      << "Usage:\n"
+         "  cesium-native-replay record <tileset-url> <camera-path.json> "
+         "<recording-directory>\n"
+         "  cesium-native-replay replay <recording-directory> "
+         "[<results.json>]\n"
+         "Recording only supports file:// URLs.\n";
+}
+
+void printSummary(const ReplayResult& result) {
+  double totalFrameTime = 0.0;
+  double totalTraversalTime = 0.0;
+  int64_t bytesLoaded = 0;
+  for (const ReplayFrame& frame : result.frames) {
+    totalFrameTime += frame.frameTime;
+    totalTraversalTime += frame.traversalTime;
+    bytesLoaded += frame.bytesLoaded;
+  }
+
+  std::cout << "Frames: " << result.frames.size() << "\n";
+  std::cout << "Total frame time: " << totalFrameTime << " ms\n";
+  std::cout << "Total traversal time: " << totalTraversalTime << " ms\n";
+  std::cout << "Bytes loaded: " << bytesLoaded << "\n";
+  if (!result.frames.empty()) {
+    std::cout << "Tiles loaded: " << result.frames.back().tilesLoaded << "\n";
+  }
+  if (result.fullDetailFrame) {
+    std::cout << "Full detail at frame " << *result.fullDetailFrame
+              << ", after " << result.timeToFullDetail << " ms\n";
+  } else {
+    std::cout << "Full detail was not reached.\n";
+  }
+}
+
+void writeResults(const ReplayResult& result, const std::string& fileName) {
+  std::ofstream file(fileName);
+  rapidjson::OStreamWrapper stream(file);
+  rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer(stream);
+
+  writer.StartObject();
+  writer.Key("fullDetailFrame");
+  if (result.fullDetailFrame) {
+    writer.Uint64(*result.fullDetailFrame);
+  } else {
+    writer.Null();
+  }
+  writer.Key("timeToFullDetail");
+  writer.Double(result.timeToFullDetail);
+
+  writer.Key("frames");
+  writer.StartArray();
+  for (const ReplayFrame& frame : result.frames) {
+    writer.StartObject();
+    writer.Key("frameTime");
+    writer.Double(frame.frameTime);
+    writer.Key("traversalTime");
+    writer.Double(frame.traversalTime);
+    writer.Key("tasksRun");
+    writer.Uint64(frame.tasksRun);
+    writer.Key("tilesVisited");
+    writer.Uint(frame.tilesVisited);
+    writer.Key("tilesRendered");
+    writer.Uint64(frame.tilesRendered);
+    writer.Key("tilesLoaded");
+    writer.Int(frame.tilesLoaded);
+    writer.Key("bytesLoaded");
+    writer.Int64(frame.bytesLoaded);
+    writer.Key("totalDataBytes");
+    writer.Int64(frame.totalDataBytes);
+    writer.Key("workerThreadTileLoadQueueLength");
+    writer.Int(frame.workerThreadTileLoadQueueLength);
+    writer.Key("mainThreadTileLoadQueueLength");
+    writer.Int(frame.mainThreadTileLoadQueueLength);
+    writer.Key("loadProgress");
+    writer.Double(double(frame.loadProgress));
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  if (!file) {
+    throw std::runtime_error("Could not write " + fileName);
+  }
+}
+
+int record(
+    const std::string& tilesetUrl,
+    const std::string& cameraPath,
+    const std::string& directory) {
+  TilesetRecording recording;
+  recording.tilesetUrl = tilesetUrl;
+  recording.frames = TilesetRecording::loadCameraPath(cameraPath);
+
+  auto pAssetAccessor = std::make_shared<RecordingAssetAccessor>(
+      std::make_shared<FileAssetAccessor>());
+  {
+    AsyncSystem asyncSystem(std::make_shared<WorkStealingTaskProcessor>());
+    printSummary(followCameraPath(
+        recording.tilesetUrl,
+        recording.frames,
+        pAssetAccessor,
+        asyncSystem,
+        TilesetOptions(),
+        additionalFrameLimit));
+  }
+
+  recording.addResponses(pAssetAccessor->getRecordedRequests());
+  recording.save(directory);
+  std::cout << "Recorded " << recording.responses.size() << " responses.\n";
+  return EXIT_SUCCESS;
+}
+
+int replay(const std::string& directory, const std::string& resultsFileName) {
+  const TilesetRecording recording = TilesetRecording::load(directory);
+  const ReplayResult result =
+      replayTileset(recording, TilesetOptions(), additionalFrameLimit);
+  printSummary(result);
+  if (!resultsFileName.empty()) {
+    writeResults(result, resultsFileName);
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const std::string command = argc > 1 ? argv[1] : "";
+  try {
+    if (command == "record" && argc == 5) {
+      return record(argv[2], argv[3], argv[4]);
+    }
+    if (command == "replay" && (argc == 3 || argc == 4)) {
+      return replay(argv[2], argc == 4 ? argv[3] : "");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  printUsage();
+  return EXIT_FAILURE;
+}
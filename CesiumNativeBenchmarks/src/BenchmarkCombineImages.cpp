@@ -0,0 +1,153 @@
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeometry/Rectangle.h>
+#include <CesiumGeospatial/WebMercatorProjection.h>
+#include <CesiumNativeBenchmarks/MemoryAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumRasterOverlays/QuadtreeRasterOverlayTileProvider.h>
+#include <CesiumRasterOverlays/RasterOverlay.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeBenchmarks;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+// A provider whose quadtree tiles are solid images, so that loading a raster
+// overlay tile only measures how the quadtree tiles' images are combined.
+class SolidTileProvider : public QuadtreeRasterOverlayTileProvider {
+public:
+  SolidTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor)
+      : QuadtreeRasterOverlayTileProvider(
+            pOwner,
+            asyncSystem,
+            pAssetAccessor,
+            std::nullopt,
+            nullptr,
+            spdlog::default_logger(),
+            WebMercatorProjection(),
+            QuadtreeTilingScheme(
+                WebMercatorProjection::computeMaximumProjectedRectangle(),
+                1,
+                1),
+            WebMercatorProjection::computeMaximumProjectedRectangle(),
+            0,
+            10,
+            256,
+            256) {}
+
+  virtual Future<LoadedRasterOverlayImage>
+  loadQuadtreeTileImage(const QuadtreeTileID& tileID) const override {
+    LoadedRasterOverlayImage result;
+    result.rectangle = this->getTilingScheme().tileToRectangle(tileID);
+    result.image.emplace();
+    result.image->width = int32_t(this->getWidth());
+    result.image->height = int32_t(this->getHeight());
+    result.image->bytesPerChannel = 1;
+    result.image->channels = 4;
+    result.image->pixelData.resize(
+        this->getWidth() * this->getHeight() * 4,
+        std::byte(tileID.level));
+    return this->getAsyncSystem().createResolvedFuture(std::move(result));
+  }
+};
+
+class SolidRasterOverlay : public RasterOverlay {
+public:
+  SolidRasterOverlay() : RasterOverlay("Solid") {}
+
+  virtual Future<CreateTileProviderResult> createTileProvider(
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CreditSystem>& /* pCreditSystem */,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+      /* pPrepareRendererResources */,
+      const std::shared_ptr<spdlog::logger>& /* pLogger */,
+      IntrusivePointer<const RasterOverlay> pOwner) const override {
+    if (!pOwner) {
+      pOwner = this;
+    }
+
+    return asyncSystem.createResolvedFuture<CreateTileProviderResult>(
+        new SolidTileProvider(pOwner, asyncSystem, pAssetAccessor));
+  }
+};
+
+void combineImages(benchmark::State& state) {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  auto pAssetAccessor = std::make_shared<MemoryAssetAccessor>();
+
+  IntrusivePointer<SolidRasterOverlay> pOverlay = new SolidRasterOverlay();
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            if (created) {
+              pProvider = *created;
+            }
+          });
+  asyncSystem.dispatchMainThreadTasks();
+  if (!pProvider) {
+    state.SkipWithError("Could not create the tile provider.");
+    return;
+  }
+
+  // A level 8 quadtree tile grown by half its size on each side, so that the
+  // raster overlay tile is combined from several quadtree tiles.
+  const QuadtreeTilingScheme tilingScheme(
+      WebMercatorProjection::computeMaximumProjectedRectangle(),
+      1,
+      1);
+  const std::optional<QuadtreeTileID> centerTileID =
+      tilingScheme.positionToTile(glm::dvec2(0.1, 0.2), 8);
+  if (!centerTileID) {
+    state.SkipWithError("Could not find the center tile.");
+    return;
+  }
+  const Rectangle centerRectangle =
+      tilingScheme.tileToRectangle(*centerTileID);
+  const Rectangle rectangle(
+      centerRectangle.minimumX - centerRectangle.computeWidth() * 0.5,
+      centerRectangle.minimumY - centerRectangle.computeHeight() * 0.5,
+      centerRectangle.maximumX + centerRectangle.computeWidth() * 0.5,
+      centerRectangle.maximumY + centerRectangle.computeHeight() * 0.5);
+  const glm::dvec2 targetScreenPixels(1024.0, 1024.0);
+
+  // The quadtree tiles are cached by the provider after the first load, so
+  // the iterations measure combining their images.
+  for (auto _ : state) {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        pProvider->getTile(rectangle, targetScreenPixels);
+    pProvider->loadTile(*pTile);
+    while (pTile->getState() != RasterOverlayTile::LoadState::Loaded &&
+           pTile->getState() != RasterOverlayTile::LoadState::Failed) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+    benchmark::DoNotOptimize(pTile->getImage().pixelData.data());
+  }
+}
+
+} // namespace
+
+BENCHMARK(combineImages)->Unit(benchmark::kMicrosecond);
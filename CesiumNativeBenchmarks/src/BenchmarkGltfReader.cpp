@@ -0,0 +1,76 @@
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumNativeBenchmarks/readFile.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfReader;
+using namespace CesiumNativeBenchmarks;
+
+namespace {
+
+std::filesystem::path getDataPath(const std::string& relativePath) {
+  return std::filesystem::path(CesiumGltfReader_TEST_DATA_DIR) / relativePath;
+}
+
+void readGlb(benchmark::State& state, const std::string& relativePath) {
+  const std::vector<std::byte> data = readFile(getDataPath(relativePath));
+  GltfReader reader;
+
+  for (auto _ : state) {
+    GltfReaderResult result = reader.readGltf(data);
+    benchmark::DoNotOptimize(result.model);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+// The Draco-compressed model in the test data is a glTF with an external
+// buffer, which readGltf doesn't load. So the model is read once with its
+// buffer, and each iteration decodes a copy of it.
+void decodeDraco(benchmark::State& state) {
+  const std::vector<std::byte> gltf =
+      readFile(getDataPath("DracoCompressed/CesiumMilkTruck.gltf"));
+  const std::vector<std::byte> buffer =
+      readFile(getDataPath("DracoCompressed/0.bin"));
+
+  GltfReader reader;
+  GltfReaderOptions readOptions;
+  readOptions.decodeDraco = false;
+  readOptions.decodeEmbeddedImages = false;
+  GltfReaderResult read = reader.readGltf(gltf, readOptions);
+  if (!read.model || read.model->buffers.empty()) {
+    state.SkipWithError("Could not read the Draco-compressed model.");
+    return;
+  }
+  read.model->buffers[0].cesium.data = buffer;
+
+  GltfReaderOptions decodeOptions;
+  decodeOptions.decodeEmbeddedImages = false;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    GltfReaderResult result{read.model, {}, {}};
+    state.ResumeTiming();
+
+    reader.postprocessGltf(result, decodeOptions);
+    benchmark::DoNotOptimize(result.model);
+  }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(readGlb, Uncompressed, std::string("CesiumBalloon.glb"))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(
+    readGlb,
+    Meshopt,
+    std::string("DucksMeshopt/Duck-vp-12-vt-12-vn-12.glb"))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(readGlb, Ktx2, std::string("CesiumBalloonKTX2.glb"))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(decodeDraco)->Unit(benchmark::kMicrosecond);
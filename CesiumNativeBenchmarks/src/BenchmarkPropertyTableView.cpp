@@ -0,0 +1,137 @@
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/PropertyTablePropertyView.h>
+#include <CesiumGltf/PropertyTableView.h>
+
+#include <benchmark/benchmark.h>
+#include <glm/vec3.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+
+constexpr int64_t featureCount = 65536;
+
+template <typename T>
+int32_t addBufferViewToModel(Model& model, const std::vector<T>& values) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+// A model with a property table of features that each have a "height" scalar
+// with an offset and scale, and a "position" vector.
+Model createModel() {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+
+  Schema& schema = metadata.schema.emplace();
+  Class& featureClass = schema.classes["Feature"];
+
+  ClassProperty& height = featureClass.properties["height"];
+  height.type = ClassProperty::Type::SCALAR;
+  height.componentType = ClassProperty::ComponentType::FLOAT32;
+  height.offset = JsonValue(1.0);
+  height.scale = JsonValue(2.0);
+
+  ClassProperty& position = featureClass.properties["position"];
+  position.type = ClassProperty::Type::VEC3;
+  position.componentType = ClassProperty::ComponentType::FLOAT32;
+
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "Feature";
+  propertyTable.count = featureCount;
+
+  std::vector<float> heights(size_t(featureCount));
+  std::vector<glm::vec3> positions(size_t(featureCount));
+  for (size_t i = 0; i < heights.size(); ++i) {
+    heights[i] = float(i % 100);
+    positions[i] = glm::vec3(float(i), float(i % 7), float(i % 13));
+  }
+
+  propertyTable.properties["height"].values =
+      addBufferViewToModel(model, heights);
+  propertyTable.properties["position"].values =
+      addBufferViewToModel(model, positions);
+
+  return model;
+}
+
+const PropertyTable& getPropertyTable(const Model& model) {
+  return model.getExtension<ExtensionModelExtStructuralMetadata>()
+      ->propertyTables[0];
+}
+
+void getPropertyView(benchmark::State& state) {
+  const Model model = createModel();
+  const PropertyTableView view(model, getPropertyTable(model));
+
+  for (auto _ : state) {
+    PropertyTablePropertyView<float> property =
+        view.getPropertyView<float>("height");
+    benchmark::DoNotOptimize(property);
+  }
+}
+
+void getTransformedScalars(benchmark::State& state) {
+  const Model model = createModel();
+  const PropertyTableView view(model, getPropertyTable(model));
+  const PropertyTablePropertyView<float> property =
+      view.getPropertyView<float>("height");
+  if (property.status() != PropertyTablePropertyViewStatus::Valid) {
+    state.SkipWithError("The height property is invalid.");
+    return;
+  }
+
+  for (auto _ : state) {
+    float sum = 0.0f;
+    for (int64_t i = 0; i < property.size(); ++i) {
+      sum += property.get(i).value_or(0.0f);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * featureCount);
+}
+
+void getRawVectors(benchmark::State& state) {
+  const Model model = createModel();
+  const PropertyTableView view(model, getPropertyTable(model));
+  const PropertyTablePropertyView<glm::vec3> property =
+      view.getPropertyView<glm::vec3>("position");
+  if (property.status() != PropertyTablePropertyViewStatus::Valid) {
+    state.SkipWithError("The position property is invalid.");
+    return;
+  }
+
+  for (auto _ : state) {
+    glm::vec3 sum(0.0f);
+    for (int64_t i = 0; i < property.size(); ++i) {
+      sum += property.getRaw(i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * featureCount);
+}
+
+} // namespace
+
+BENCHMARK(getPropertyView);
+BENCHMARK(getTransformedScalars)->Unit(benchmark::kMicrosecond);
+BENCHMARK(getRawVectors)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,93 @@
+#include <Cesium3DTilesContent/upsampleGltfForRasterOverlays.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGeospatial/Projection.h>
+#include <CesiumNativeBenchmarks/readFile.h>
+#include <CesiumQuantizedMeshTerrain/QuantizedMeshLoader.h>
+#include <CesiumRasterOverlays/RasterOverlayUtilities.h>
+#include <CesiumUtility/Math.h>
+
+#include <benchmark/benchmark.h>
+#include <glm/mat4x4.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumNativeBenchmarks;
+using namespace CesiumQuantizedMeshTerrain;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+// The western root tile of the geographic tiling scheme that quantized-mesh
+// terrain uses.
+const QuadtreeTileID rootTileID(0, 0, 0);
+const BoundingRegion rootTileRegion(
+    GlobeRectangle(-Math::OnePi, -Math::PiOverTwo, 0.0, Math::PiOverTwo),
+    -1000.0,
+    9000.0);
+
+std::vector<std::byte> readTerrainTile() {
+  return readFile(
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "CesiumTerrainTileJson" / "tile.terrain");
+}
+
+void loadQuantizedMesh(benchmark::State& state) {
+  const std::vector<std::byte> data = readTerrainTile();
+
+  for (auto _ : state) {
+    QuantizedMeshLoadResult result = QuantizedMeshLoader::load(
+        rootTileID,
+        rootTileRegion,
+        "tile.terrain",
+        data,
+        false);
+    benchmark::DoNotOptimize(result.model);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+void upsampleGltf(benchmark::State& state) {
+  QuantizedMeshLoadResult loaded = QuantizedMeshLoader::load(
+      rootTileID,
+      rootTileRegion,
+      "tile.terrain",
+      readTerrainTile(),
+      false);
+  if (!loaded.model) {
+    state.SkipWithError("Could not load the quantized-mesh tile.");
+    return;
+  }
+
+  Model& model = *loaded.model;
+  RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
+      model,
+      glm::dmat4(1.0),
+      rootTileRegion.getRectangle(),
+      {Projection(GeographicProjection())},
+      false,
+      "_CESIUMOVERLAY_",
+      0);
+
+  const UpsampledQuadtreeNode childID{QuadtreeTileID(1, 0, 0)};
+  for (auto _ : state) {
+    std::optional<Model> upsampled =
+        upsampleGltfForRasterOverlays(model, childID);
+    benchmark::DoNotOptimize(upsampled);
+  }
+}
+
+} // namespace
+
+BENCHMARK(loadQuantizedMesh)->Unit(benchmark::kMicrosecond);
+BENCHMARK(upsampleGltf)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,147 @@
+#include <CesiumAsync/ShardedCacheDatabase.h>
+#include <CesiumAsync/SqliteCache.h>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+constexpr uint64_t entryCount = 1024;
+
+const HttpHeaders requestHeaders{{"Accept", "*/*"}};
+const HttpHeaders responseHeaders{
+    {"Content-Type", "application/octet-stream"},
+    {"Cache-Control", "max-age=86400"}};
+
+std::string getKey(uint64_t index) {
+  return "https://example.com/tiles/" + std::to_string(index) + ".glb";
+}
+
+bool storeEntry(
+    ICacheDatabase& cache,
+    uint64_t index,
+    const std::vector<std::byte>& data) {
+  const std::string key = getKey(index);
+  return cache.storeEntry(
+      key,
+      std::time(nullptr) + 86400,
+      key,
+      "GET",
+      requestHeaders,
+      200,
+      responseHeaders,
+      data);
+}
+
+void storeSqliteCacheEntry(benchmark::State& state) {
+  SqliteCache cache(
+      spdlog::default_logger(),
+      "cesium-native-benchmarks.sqlite",
+      entryCount);
+  cache.clearAll();
+
+  const std::vector<std::byte> data(size_t(state.range(0)), std::byte(1));
+  uint64_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(storeEntry(cache, index++ % entryCount, data));
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+void getSqliteCacheEntry(benchmark::State& state) {
+  SqliteCache cache(
+      spdlog::default_logger(),
+      "cesium-native-benchmarks.sqlite",
+      entryCount);
+  cache.clearAll();
+
+  const std::vector<std::byte> data(size_t(state.range(0)), std::byte(1));
+  for (uint64_t i = 0; i < entryCount; ++i) {
+    storeEntry(cache, i, data);
+  }
+
+  uint64_t index = 0;
+  for (auto _ : state) {
+    std::optional<CacheItem> item =
+        cache.getEntry(getKey(index++ % entryCount));
+    benchmark::DoNotOptimize(item);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+// Stores and looks up entries on every benchmark thread at once, in a single
+// database when `state.range(0)` is 1, or else in that many shards.
+void getAndStoreCacheEntryConcurrently(benchmark::State& state) {
+  static std::unique_ptr<ICacheDatabase> pCache;
+  const std::vector<std::byte> data(16 * 1024, std::byte(1));
+
+  if (state.thread_index() == 0) {
+    const uint32_t shardCount = uint32_t(state.range(0));
+    if (shardCount == 1) {
+      pCache = std::make_unique<SqliteCache>(
+          spdlog::default_logger(),
+          "cesium-native-benchmarks.sqlite",
+          entryCount);
+    } else {
+      pCache = std::make_unique<ShardedCacheDatabase>(
+          ShardedCacheDatabase::createSqliteShards(
+              spdlog::default_logger(),
+              "cesium-native-benchmarks.sqlite",
+              shardCount,
+              entryCount));
+    }
+    pCache->clearAll();
+    for (uint64_t i = 0; i < entryCount; ++i) {
+      storeEntry(*pCache, i, data);
+    }
+  }
+
+  // Every eighth operation is a store, as when most tiles are cache hits.
+  uint64_t index = uint64_t(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    if (index % 8 == 0) {
+      benchmark::DoNotOptimize(storeEntry(*pCache, index % entryCount, data));
+    } else {
+      std::optional<CacheItem> item =
+          pCache->getEntry(getKey(index % entryCount));
+      benchmark::DoNotOptimize(item);
+    }
+    ++index;
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()));
+
+  if (state.thread_index() == 0) {
+    pCache.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK(storeSqliteCacheEntry)
+    ->Arg(1024)
+    ->Arg(256 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(getSqliteCacheEntry)
+    ->Arg(1024)
+    ->Arg(256 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(getAndStoreCacheEntryConcurrently)
+    ->Arg(1)
+    ->Arg(8)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
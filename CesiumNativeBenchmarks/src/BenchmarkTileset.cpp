@@ -0,0 +1,182 @@
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumNativeBenchmarks/MemoryAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumUtility/Math.h>
+
+#include <benchmark/benchmark.h>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeBenchmarks;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+
+// The west, south, east, and north of the synthetic tileset, in radians.
+constexpr double tilesetWest = Math::degreesToRadians(118.0);
+constexpr double tilesetSouth = Math::degreesToRadians(32.0);
+constexpr double tilesetEast = Math::degreesToRadians(118.5);
+constexpr double tilesetNorth = Math::degreesToRadians(32.5);
+
+void writeQuadtreeTile(
+    std::ostream& json,
+    double west,
+    double south,
+    double east,
+    double north,
+    double geometricError,
+    int64_t remainingLevels) {
+  json << "{\"boundingVolume\":{\"region\":[" << west << "," << south << ","
+       << east << "," << north << ",0,100]},\"geometricError\":"
+       << (remainingLevels > 0 ? geometricError : 0.0)
+       << ",\"refine\":\"REPLACE\"";
+  if (remainingLevels > 0) {
+    const double centerX = (west + east) * 0.5;
+    const double centerY = (south + north) * 0.5;
+    const double childError = geometricError * 0.5;
+    json << ",\"children\":[";
+    writeQuadtreeTile(
+        json,
+        west,
+        south,
+        centerX,
+        centerY,
+        childError,
+        remainingLevels - 1);
+    json << ",";
+    writeQuadtreeTile(
+        json,
+        centerX,
+        south,
+        east,
+        centerY,
+        childError,
+        remainingLevels - 1);
+    json << ",";
+    writeQuadtreeTile(
+        json,
+        west,
+        centerY,
+        centerX,
+        north,
+        childError,
+        remainingLevels - 1);
+    json << ",";
+    writeQuadtreeTile(
+        json,
+        centerX,
+        centerY,
+        east,
+        north,
+        childError,
+        remainingLevels - 1);
+    json << "]";
+  }
+  json << "}";
+}
+
+// A tileset.json of a complete quadtree of the given depth, whose tiles have
+// no content, so that only the traversal is measured.
+std::vector<std::byte> createQuadtreeTileset(int64_t depth) {
+  std::ostringstream json;
+  json.precision(17);
+  json << "{\"asset\":{\"version\":\"1.0\"},\"geometricError\":20000,"
+          "\"root\":";
+  writeQuadtreeTile(
+      json,
+      tilesetWest,
+      tilesetSouth,
+      tilesetEast,
+      tilesetNorth,
+      10000.0,
+      depth);
+  json << "}";
+
+  const std::string result = json.str();
+  const std::byte* pBegin = reinterpret_cast<const std::byte*>(result.data());
+  return std::vector<std::byte>(pBegin, pBegin + result.size());
+}
+
+ViewState createViewState(double height) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const Cartographic position(
+      (tilesetWest + tilesetEast) * 0.5,
+      (tilesetSouth + tilesetNorth) * 0.5,
+      height);
+  const Cartographic focus(position.longitude, position.latitude + 0.001, 0.0);
+  const glm::dvec3 viewPosition = ellipsoid.cartographicToCartesian(position);
+  const glm::dvec3 viewFocus = ellipsoid.cartographicToCartesian(focus);
+  const glm::dvec2 viewportSize(1920.0, 1080.0);
+  const double horizontalFieldOfView = Math::degreesToRadians(60.0);
+  const double verticalFieldOfView =
+      std::atan(
+          std::tan(horizontalFieldOfView * 0.5) /
+          (viewportSize.x / viewportSize.y)) *
+      2.0;
+  return ViewState::create(
+      viewPosition,
+      glm::normalize(viewFocus - viewPosition),
+      ellipsoid.geodeticSurfaceNormal(viewPosition),
+      viewportSize,
+      horizontalFieldOfView,
+      verticalFieldOfView);
+}
+
+void updateView(benchmark::State& state) {
+  const int64_t depth = state.range(0);
+
+  auto pAssetAccessor = std::make_shared<MemoryAssetAccessor>();
+  pAssetAccessor->add(
+      "tileset.json",
+      "application/json",
+      createQuadtreeTileset(depth));
+
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals externals{pAssetAccessor, nullptr, asyncSystem, nullptr};
+
+  TilesetOptions options;
+  options.enableFrustumCulling = true;
+  Tileset tileset(externals, "tileset.json", options);
+
+  // Load the whole tree before measuring, so that each iteration only
+  // traverses it.
+  const std::vector<ViewState> frustums{createViewState(500.0)};
+  uint32_t tilesVisited = 0;
+  for (int i = 0; i < 100; ++i) {
+    asyncSystem.dispatchMainThreadTasks();
+    const ViewUpdateResult& result = tileset.updateView(frustums);
+    if (tileset.getRootTile() && result.tilesVisited == tilesVisited &&
+        result.workerThreadTileLoadQueueLength == 0 &&
+        result.mainThreadTileLoadQueueLength == 0) {
+      break;
+    }
+    tilesVisited = result.tilesVisited;
+  }
+
+  for (auto _ : state) {
+    const ViewUpdateResult& result = tileset.updateView(frustums);
+    benchmark::DoNotOptimize(result.tilesToRenderThisFrame.data());
+  }
+
+  state.counters["tilesVisited"] = double(tilesVisited);
+}
+
+} // namespace
+
+BENCHMARK(updateView)
+    ->DenseRange(4, 7)
+    ->ArgName("depth")
+    ->Unit(benchmark::kMicrosecond);
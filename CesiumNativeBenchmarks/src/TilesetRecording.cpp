@@ -0,0 +1,297 @@
+#include <CesiumNativeBenchmarks/TilesetRecording.h>
+#include <CesiumNativeBenchmarks/readFile.h>
+
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+
+using JsonWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+template <typename TVector>
+void writeVector(JsonWriter& writer, const char* key, const TVector& vector) {
+  writer.Key(key);
+  writer.StartArray();
+  for (glm::length_t i = 0; i < vector.length(); ++i) {
+    writer.Double(vector[i]);
+  }
+  writer.EndArray();
+}
+
+void writeFrames(JsonWriter& writer, const std::vector<RecordedView>& frames) {
+  writer.Key("frames");
+  writer.StartArray();
+  for (const RecordedView& frame : frames) {
+    writer.StartObject();
+    writeVector(writer, "position", frame.position);
+    writeVector(writer, "direction", frame.direction);
+    writeVector(writer, "up", frame.up);
+    writeVector(writer, "viewportSize", frame.viewportSize);
+    writer.Key("horizontalFieldOfView");
+    writer.Double(frame.horizontalFieldOfView);
+    writer.Key("verticalFieldOfView");
+    writer.Double(frame.verticalFieldOfView);
+    writer.EndObject();
+  }
+  writer.EndArray();
+}
+
+std::string getResponseFileName(size_t index) {
+  return "responses/" + std::to_string(index) + ".bin";
+}
+
+void writeFile(
+    const std::filesystem::path& fileName,
+    const char* pData,
+    size_t size) {
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  file.write(pData, static_cast<std::streamsize>(size));
+  if (!file) {
+    throw std::runtime_error("Could not write " + fileName.string());
+  }
+}
+
+rapidjson::Document parseJson(const std::filesystem::path& fileName) {
+  const std::vector<std::byte> json = readFile(fileName);
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(json.data()), json.size());
+  if (document.HasParseError() || !document.IsObject()) {
+    throw std::runtime_error(fileName.string() + " is not a JSON object.");
+  }
+  return document;
+}
+
+const rapidjson::Value& getMember(
+    const rapidjson::Value& object,
+    const char* key,
+    const std::filesystem::path& fileName) {
+  auto it = object.FindMember(key);
+  if (it == object.MemberEnd()) {
+    throw std::runtime_error(
+        fileName.string() + " is missing the `" + key + "` property.");
+  }
+  return it->value;
+}
+
+template <typename TVector>
+void readVector(
+    const rapidjson::Value& object,
+    const char* key,
+    TVector& vector,
+    const std::filesystem::path& fileName) {
+  const rapidjson::Value& array = getMember(object, key, fileName);
+  if (!array.IsArray() ||
+      array.Size() != static_cast<rapidjson::SizeType>(vector.length())) {
+    throw std::runtime_error(
+        fileName.string() + " has an invalid `" + key + "` property.");
+  }
+  for (glm::length_t i = 0; i < vector.length(); ++i) {
+    const rapidjson::Value& component =
+        array[static_cast<rapidjson::SizeType>(i)];
+    if (!component.IsNumber()) {
+      throw std::runtime_error(
+          fileName.string() + " has an invalid `" + key + "` property.");
+    }
+    vector[i] = component.GetDouble();
+  }
+}
+
+double readDouble(
+    const rapidjson::Value& object,
+    const char* key,
+    const std::filesystem::path& fileName) {
+  const rapidjson::Value& value = getMember(object, key, fileName);
+  if (!value.IsNumber()) {
+    throw std::runtime_error(
+        fileName.string() + " has an invalid `" + key + "` property.");
+  }
+  return value.GetDouble();
+}
+
+std::string readString(
+    const rapidjson::Value& object,
+    const char* key,
+    const std::filesystem::path& fileName) {
+  const rapidjson::Value& value = getMember(object, key, fileName);
+  if (!value.IsString()) {
+    throw std::runtime_error(
+        fileName.string() + " has an invalid `" + key + "` property.");
+  }
+  return std::string(value.GetString(), value.GetStringLength());
+}
+
+std::vector<RecordedView> readFrames(
+    const rapidjson::Value& document,
+    const std::filesystem::path& fileName) {
+  const rapidjson::Value& frames = getMember(document, "frames", fileName);
+  if (!frames.IsArray()) {
+    throw std::runtime_error(
+        fileName.string() + " has an invalid `frames` property.");
+  }
+
+  std::vector<RecordedView> result;
+  result.reserve(frames.Size());
+  for (const rapidjson::Value& frame : frames.GetArray()) {
+    RecordedView& view = result.emplace_back();
+    readVector(frame, "position", view.position, fileName);
+    readVector(frame, "direction", view.direction, fileName);
+    readVector(frame, "up", view.up, fileName);
+    readVector(frame, "viewportSize", view.viewportSize, fileName);
+    view.horizontalFieldOfView =
+        readDouble(frame, "horizontalFieldOfView", fileName);
+    view.verticalFieldOfView =
+        readDouble(frame, "verticalFieldOfView", fileName);
+  }
+  return result;
+}
+
+} // namespace
+
+RecordedView RecordedView::fromViewState(const ViewState& viewState) {
+  RecordedView result;
+  result.position = viewState.getPosition();
+  result.direction = viewState.getDirection();
+  result.up = viewState.getUp();
+  result.viewportSize = viewState.getViewportSize();
+  result.horizontalFieldOfView = viewState.getHorizontalFieldOfView();
+  result.verticalFieldOfView = viewState.getVerticalFieldOfView();
+  return result;
+}
+
+ViewState RecordedView::toViewState() const {
+  return ViewState::create(
+      this->position,
+      this->direction,
+      this->up,
+      this->viewportSize,
+      this->horizontalFieldOfView,
+      this->verticalFieldOfView);
+}
+
+void TilesetRecording::addResponses(
+    const std::vector<std::shared_ptr<IAssetRequest>>& requests) {
+  for (const std::shared_ptr<IAssetRequest>& pRequest : requests) {
+    const IAssetResponse* pResponse = pRequest ? pRequest->response() : nullptr;
+    if (!pResponse) {
+      continue;
+    }
+
+    RecordedResponse& response = this->responses.emplace_back();
+    response.url = pRequest->url();
+    response.statusCode = pResponse->statusCode();
+    response.contentType = pResponse->contentType();
+    response.headers = pResponse->headers();
+    response.data.assign(pResponse->data().begin(), pResponse->data().end());
+  }
+}
+
+void TilesetRecording::save(const std::filesystem::path& directory) const {
+  std::error_code error;
+  std::filesystem::create_directories(directory / "responses", error);
+  if (error) {
+    throw std::runtime_error(
+        "Could not create " + (directory / "responses").string());
+  }
+
+  rapidjson::StringBuffer buffer;
+  JsonWriter writer(buffer);
+  writer.StartObject();
+  writer.Key("tilesetUrl");
+  writer.String(this->tilesetUrl.c_str());
+  writeFrames(writer, this->frames);
+
+  writer.Key("responses");
+  writer.StartArray();
+  for (size_t i = 0; i < this->responses.size(); ++i) {
+    const RecordedResponse& response = this->responses[i];
+    const std::string fileName = getResponseFileName(i);
+    writeFile(
+        directory / fileName,
+        reinterpret_cast<const char*>(response.data.data()),
+        response.data.size());
+
+    writer.StartObject();
+    writer.Key("url");
+    writer.String(response.url.c_str());
+    writer.Key("statusCode");
+    writer.Uint(response.statusCode);
+    writer.Key("contentType");
+    writer.String(response.contentType.c_str());
+    writer.Key("headers");
+    writer.StartObject();
+    for (const auto& [name, value] : response.headers) {
+      writer.Key(name.c_str());
+      writer.String(value.c_str());
+    }
+    writer.EndObject();
+    writer.Key("file");
+    writer.String(fileName.c_str());
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  writeFile(
+      directory / "recording.json",
+      buffer.GetString(),
+      buffer.GetSize());
+}
+
+TilesetRecording
+TilesetRecording::load(const std::filesystem::path& directory) {
+  const std::filesystem::path fileName = directory / "recording.json";
+  const rapidjson::Document document = parseJson(fileName);
+
+  TilesetRecording result;
+  result.tilesetUrl = readString(document, "tilesetUrl", fileName);
+  result.frames = readFrames(document, fileName);
+
+  const rapidjson::Value& responses =
+      getMember(document, "responses", fileName);
+  if (!responses.IsArray()) {
+    throw std::runtime_error(
+        fileName.string() + " has an invalid `responses` property.");
+  }
+
+  result.responses.reserve(responses.Size());
+  for (const rapidjson::Value& value : responses.GetArray()) {
+    RecordedResponse& response = result.responses.emplace_back();
+    response.url = readString(value, "url", fileName);
+    response.statusCode =
+        static_cast<uint16_t>(readDouble(value, "statusCode", fileName));
+    response.contentType = readString(value, "contentType", fileName);
+
+    const rapidjson::Value& headers = getMember(value, "headers", fileName);
+    if (headers.IsObject()) {
+      for (const auto& header : headers.GetObject()) {
+        if (header.value.IsString()) {
+          response.headers.emplace(
+              header.name.GetString(),
+              header.value.GetString());
+        }
+      }
+    }
+
+    response.data = readFile(directory / readString(value, "file", fileName));
+  }
+
+  return result;
+}
+
+std::vector<RecordedView>
+TilesetRecording::loadCameraPath(const std::filesystem::path& fileName) {
+  return readFrames(parseJson(fileName), fileName);
+}
+
+} // namespace CesiumNativeBenchmarks
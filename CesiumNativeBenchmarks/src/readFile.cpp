@@ -0,0 +1,23 @@
+#include <CesiumNativeBenchmarks/readFile.h>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace CesiumNativeBenchmarks {
+
+std::vector<std::byte> readFile(const std::filesystem::path& fileName) {
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("Could not read " + fileName.string());
+  }
+
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> buffer(static_cast<size_t>(size));
+  file.read(reinterpret_cast<char*>(buffer.data()), size);
+
+  return buffer;
+}
+
+} // namespace CesiumNativeBenchmarks
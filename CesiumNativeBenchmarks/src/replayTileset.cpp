@@ -0,0 +1,159 @@
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumNativeBenchmarks/DeterministicTaskProcessor.h>
+#include <CesiumNativeBenchmarks/MemoryAssetAccessor.h>
+#include <CesiumNativeBenchmarks/NullPrepareRendererResources.h>
+#include <CesiumNativeBenchmarks/replayTileset.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+
+constexpr float frameDeltaTime = 1.0f / 60.0f;
+
+bool isFullyLoaded(Tileset& tileset, const ViewUpdateResult& result) {
+  return tileset.getRootTile() != nullptr &&
+         result.workerThreadTileLoadQueueLength == 0 &&
+         result.mainThreadTileLoadQueueLength == 0 &&
+         tileset.computeLoadProgress() >= 100.0f;
+}
+
+// Updates the view of each frame, and then of the last frame until nothing is
+// left to load. `beforeFrame` runs at the start of every frame and returns
+// the number of worker thread tasks that it ran.
+ReplayResult runFrames(
+    const std::string& tilesetUrl,
+    const std::vector<RecordedView>& frames,
+    const TilesetExternals& externals,
+    const TilesetOptions& options,
+    size_t additionalFrameLimit,
+    const std::function<size_t()>& beforeFrame) {
+  ReplayResult replay;
+  if (frames.empty()) {
+    return replay;
+  }
+
+  Tileset tileset(externals, tilesetUrl, options);
+
+  const size_t frameLimit = frames.size() + additionalFrameLimit;
+  for (size_t i = 0; i < frameLimit; ++i) {
+    const std::vector<ViewState> views{
+        frames[std::min(i, frames.size() - 1)].toViewState()};
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t tasksRun = beforeFrame();
+    const ViewUpdateResult& result =
+        tileset.updateView(views, frameDeltaTime);
+    const auto end = std::chrono::steady_clock::now();
+
+    ReplayFrame& frame = replay.frames.emplace_back();
+    frame.frameTime =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    frame.traversalTime = result.traversalTime;
+    frame.tasksRun = tasksRun;
+    frame.tilesVisited = result.tilesVisited;
+    frame.tilesRendered = result.tilesToRenderThisFrame.size();
+    frame.tilesLoaded = tileset.getNumberOfTilesLoaded();
+    frame.bytesLoaded = result.bytesLoaded;
+    frame.totalDataBytes = tileset.getTotalDataBytes();
+    frame.workerThreadTileLoadQueueLength =
+        result.workerThreadTileLoadQueueLength;
+    frame.mainThreadTileLoadQueueLength = result.mainThreadTileLoadQueueLength;
+    frame.loadProgress = tileset.computeLoadProgress();
+
+    replay.timeToFullDetail += frame.frameTime;
+    if (i + 1 >= frames.size() && isFullyLoaded(tileset, result)) {
+      replay.fullDetailFrame = i;
+      break;
+    }
+  }
+
+  if (!replay.fullDetailFrame) {
+    replay.timeToFullDetail = 0.0;
+  }
+
+  // The tileset waits for its loads to finish when it is destroyed, so finish
+  // the ones whose worker thread tasks are still queued.
+  do {
+    externals.asyncSystem.dispatchMainThreadTasks();
+  } while (beforeFrame() > 0);
+
+  return replay;
+}
+
+} // namespace
+
+ReplayResult followCameraPath(
+    const std::string& tilesetUrl,
+    const std::vector<RecordedView>& frames,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const AsyncSystem& asyncSystem,
+    const TilesetOptions& options,
+    size_t additionalFrameLimit) {
+  const TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<NullPrepareRendererResources>(),
+      asyncSystem,
+      nullptr};
+
+  const auto frameInterval =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(frameDeltaTime));
+  auto nextFrame = std::chrono::steady_clock::now();
+  return runFrames(
+      tilesetUrl,
+      frames,
+      externals,
+      options,
+      additionalFrameLimit,
+      [&nextFrame, frameInterval]() -> size_t {
+        std::this_thread::sleep_until(nextFrame);
+        nextFrame = std::chrono::steady_clock::now() + frameInterval;
+        return 0;
+      });
+}
+
+ReplayResult replayTileset(
+    const TilesetRecording& recording,
+    const TilesetOptions& options,
+    size_t additionalFrameLimit) {
+  auto pAssetAccessor = std::make_shared<MemoryAssetAccessor>();
+  for (const RecordedResponse& response : recording.responses) {
+    pAssetAccessor->add(
+        response.url,
+        response.statusCode,
+        response.contentType,
+        response.headers,
+        std::vector<std::byte>(response.data));
+  }
+
+  auto pTaskProcessor = std::make_shared<DeterministicTaskProcessor>();
+  const TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<NullPrepareRendererResources>(),
+      AsyncSystem(pTaskProcessor),
+      nullptr};
+
+  ReplayResult result = runFrames(
+      recording.tilesetUrl,
+      recording.frames,
+      externals,
+      options,
+      additionalFrameLimit,
+      [&pTaskProcessor]() { return pTaskProcessor->runQueuedTasks(); });
+
+  // Freeing the tiles of the destroyed tileset may have started more tasks.
+  pTaskProcessor->runQueuedTasks();
+  return result;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -42,6 +42,11 @@ void LayerJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 LayerJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumQuantizedMeshTerrain::Layer::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyLayer(
       CesiumQuantizedMeshTerrain::Layer::TypeName,
       str,
@@ -158,6 +163,11 @@ void AvailabilityRectangleJsonHandler::reset(
 CesiumJsonReader::IJsonHandler*
 AvailabilityRectangleJsonHandler::readObjectKey(const std::string_view& str) {
   assert(this->_pObject);
+  if (this->isSkippedProperty(
+          CesiumQuantizedMeshTerrain::AvailabilityRectangle::TypeName,
+          str)) {
+    return this->ignoreAndContinue();
+  }
   return this->readObjectKeyAvailabilityRectangle(
       CesiumQuantizedMeshTerrain::AvailabilityRectangle::TypeName,
       str,
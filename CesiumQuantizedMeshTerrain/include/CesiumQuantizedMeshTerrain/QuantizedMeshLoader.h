@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace CesiumAsync {
@@ -67,6 +68,18 @@ struct QuantizedMeshMetadataResult {
  */
 class CESIUMQUANTIZEDMESHTERRAIN_API QuantizedMeshLoader final {
 public:
+  /**
+   * @brief The name of the glTF vertex attribute that holds the oct-encoded
+   * normals of a tile when they are kept encoded.
+   *
+   * Each element of the attribute is a `VEC2` of `UNSIGNED_BYTE`, as in the
+   * quantized-mesh oct-encoded vertex normals extension, and can be decoded
+   * with {@link CesiumUtility::AttributeCompression::octDecode}. The elements
+   * are four bytes apart, because glTF vertex attributes must be aligned to
+   * four bytes.
+   */
+  static const std::string OCT_ENCODED_NORMAL_ATTRIBUTE;
+
   /**
    * @brief Create a {@link QuantizedMeshLoadResult} from the given data.
    *
@@ -74,6 +87,34 @@ public:
    * @param tileBoundingVoume The tile bounding volume.
    * @param url The URL from which the data was loaded.
    * @param data The actual tile data.
+   * @param enableWaterMask Whether to add the water mask of the tile, if it has
+   * one, to the glTF.
+   * @param keepOctEncodedNormals Whether to keep the oct-encoded normals of the
+   * tile, if it has them, in the {@link OCT_ENCODED_NORMAL_ATTRIBUTE}
+   * attribute instead of decoding them to a `NORMAL` attribute.
+   * @param generateMissingNormals Whether to generate smooth normals for a
+   * tile without oct-encoded normals. If this is false, such a tile has no
+   * normals.
+   * @param skirtsAsEdgeIndices Whether to leave the skirts out of the mesh and
+   * add an accessor with the indices of the vertices along its edges instead,
+   * as described by {@link CesiumGltfContent::SkirtMeshMetadata}, for the
+   * renderer to create the skirts from.
+   * @param downsampleWaterMask Whether to store a water mask that is a mix of
+   * land and water at the lowest power-of-two resolution at which each of its
+   * texels covers a block of the 256x256 mask that is all land or all water.
+   * Nothing is lost, because sampling the smaller mask with nearest filtering
+   * gives the same result as sampling the full one. Masks with detail down to
+   * single texels are still stored at 256x256.
+   * @param packWaterMaskBits Whether to store a water mask that is a mix of
+   * land and water with one bit per texel instead of one byte. Each row of
+   * the mask is packed into `(size + 7) / 8` bytes, with the first texel in
+   * the least significant bit, and a set bit means water. The image of such a
+   * mask is that many bytes wide and `size` texels high, and the primitive's
+   * `WaterMaskPackedBits` extra is true. Renderers must unpack it themselves.
+   * @param parseMetadata Whether to parse the metadata extension of the tile.
+   * The extension's JSON is only needed for the tile availability in
+   * {@link QuantizedMeshLoadResult::availableTileRectangles}, so callers that
+   * already know the availability of the tile's subtree can skip it.
    * @return The {@link QuantizedMeshLoadResult}
    */
   static QuantizedMeshLoadResult load(
@@ -81,7 +122,13 @@ public:
       const CesiumGeospatial::BoundingRegion& tileBoundingVolume,
       const std::string& url,
       const gsl::span<const std::byte>& data,
-      bool enableWaterMask);
+      bool enableWaterMask,
+      bool keepOctEncodedNormals = false,
+      bool generateMissingNormals = true,
+      bool skirtsAsEdgeIndices = false,
+      bool downsampleWaterMask = false,
+      bool packWaterMaskBits = false,
+      bool parseMetadata = true);
 
   /**
    * @brief Parses the metadata (tile availability) from the given
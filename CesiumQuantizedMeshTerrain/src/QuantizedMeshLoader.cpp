@@ -7,6 +7,7 @@
 #include <CesiumUtility/AttributeCompression.h>
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Math.h>
+#include <CesiumUtility/ScratchVector.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/Uri.h>
 
@@ -16,7 +17,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -111,10 +115,17 @@ struct QuantizedMeshView {
   gsl::span<const char> metadataJsonBuffer;
 };
 
+const std::string QuantizedMeshLoader::OCT_ENCODED_NORMAL_ATTRIBUTE =
+    "_OCT_ENCODED_NORMAL";
+
 // We can't use sizeof(QuantizedMeshHeader) because it may be padded.
 constexpr size_t headerLength = 92;
 constexpr size_t extensionHeaderLength = 5;
 
+// The oct-encoded normals kept in the glTF have two bytes of padding after
+// each normal, because glTF vertex attributes must be aligned to four bytes.
+constexpr size_t octEncodedNormalStride = 4;
+
 int32_t zigZagDecode(int32_t value) noexcept {
   return (value >> 1) ^ (-(value & 1));
 }
@@ -127,14 +138,79 @@ void decodeIndices(
     throw std::runtime_error("decoded buffer is too small.");
   }
 
+  // Work on the raw pointers so that the loop doesn't check the bounds of
+  // the spans for every index.
+  const E* pEncoded = encoded.data();
+  D* pDecoded = decoded.data();
   E highest = 0;
   for (size_t i = 0; i < encoded.size(); ++i) {
-    E code = encoded[i];
-    E decodedIdx = static_cast<E>(highest - code);
-    decoded[i] = static_cast<D>(decodedIdx);
-    if (code == 0) {
-      ++highest;
-    }
+    const E code = pEncoded[i];
+    pDecoded[i] = static_cast<D>(static_cast<E>(highest - code));
+    highest = static_cast<E>(highest + E(code == 0));
+  }
+}
+
+// Decodes zig-zag encoded deltas into the values they accumulate to. The
+// zig-zag decoding and the sum are done in separate passes, and the first one
+// has no dependency between values, so that it can be vectorized.
+static void decodeZigZagDeltas(
+    const gsl::span<const uint16_t>& encoded,
+    std::vector<int32_t>& decoded) {
+  decoded.resize(encoded.size());
+  std::transform(
+      encoded.data(),
+      encoded.data() + encoded.size(),
+      decoded.begin(),
+      [](uint16_t value) noexcept { return zigZagDecode(int32_t(value)); });
+  std::partial_sum(decoded.begin(), decoded.end(), decoded.begin());
+}
+
+// Converts cartographic positions, given as separate arrays of longitudes,
+// latitudes, and heights, to Cartesian positions relative to the center. The
+// relative positions are written straight to the float output, three floats
+// per position, and the bounds of the relative positions are expanded to
+// include them. This is the same as Ellipsoid::cartographicToCartesian, but
+// with the per-position work kept to plain arithmetic on arrays so that it can
+// be vectorized, and without normalizing the surface normals, which are
+// already unit length.
+static void cartographicToCartesianRelativeToCenter(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& center,
+    const std::vector<double>& longitudes,
+    const std::vector<double>& latitudes,
+    const std::vector<double>& heights,
+    const gsl::span<float>& output,
+    glm::dvec3& minimums,
+    glm::dvec3& maximums) {
+  const glm::dvec3 radiiSquared = ellipsoid.getRadii() * ellipsoid.getRadii();
+  const size_t count = longitudes.size();
+  float* pOutput = output.data();
+
+  for (size_t i = 0; i < count; ++i) {
+    const double cosLatitude = glm::cos(latitudes[i]);
+    const double nx = cosLatitude * glm::cos(longitudes[i]);
+    const double ny = cosLatitude * glm::sin(longitudes[i]);
+    const double nz = glm::sin(latitudes[i]);
+
+    const double kx = radiiSquared.x * nx;
+    const double ky = radiiSquared.y * ny;
+    const double kz = radiiSquared.z * nz;
+    const double oneOverGamma = 1.0 / glm::sqrt(nx * kx + ny * ky + nz * kz);
+
+    const double x = kx * oneOverGamma + nx * heights[i] - center.x;
+    const double y = ky * oneOverGamma + ny * heights[i] - center.y;
+    const double z = kz * oneOverGamma + nz * heights[i] - center.z;
+
+    pOutput[3 * i] = static_cast<float>(x);
+    pOutput[3 * i + 1] = static_cast<float>(y);
+    pOutput[3 * i + 2] = static_cast<float>(z);
+
+    minimums.x = glm::min(minimums.x, x);
+    minimums.y = glm::min(minimums.y, y);
+    minimums.z = glm::min(minimums.z, z);
+    maximums.x = glm::max(maximums.x, x);
+    maximums.y = glm::max(maximums.y, y);
+    maximums.z = glm::max(maximums.z, z);
   }
 }
 
@@ -379,6 +455,7 @@ static void addSkirt(
     const gsl::span<const E>& edgeIndices,
     const gsl::span<float>& positions,
     const gsl::span<float>& normals,
+    const gsl::span<std::byte>& octEncodedNormals,
     const gsl::span<I>& indices,
     glm::dvec3& positionMinimums,
     glm::dvec3& positionMaximums) {
@@ -418,6 +495,13 @@ static void addSkirt(
       normals[positionIdx + 2] = normals[componentIndex + 2];
     }
 
+    if (!octEncodedNormals.empty()) {
+      const size_t sourceIndex = octEncodedNormalStride * size_t(edgeIdx);
+      const size_t targetIndex = octEncodedNormalStride * newEdgeIndex;
+      octEncodedNormals[targetIndex] = octEncodedNormals[sourceIndex];
+      octEncodedNormals[targetIndex + 1] = octEncodedNormals[sourceIndex + 1];
+    }
+
     if (i < edgeIndices.size() - 1) {
       E nextEdgeIdx = edgeIndices[i + 1];
       indices[indexIdx++] = static_cast<I>(edgeIdx);
@@ -453,6 +537,7 @@ static void addSkirts(
     const gsl::span<const std::byte>& northEdgeIndicesBuffer,
     const gsl::span<float>& outputPositions,
     const gsl::span<float>& outputNormals,
+    const gsl::span<std::byte>& outputOctEncodedNormals,
     const gsl::span<I>& outputIndices,
     glm::dvec3& positionMinimums,
     glm::dvec3& positionMaximums) {
@@ -500,6 +585,7 @@ static void addSkirts(
       westEdgeIndices,
       outputPositions,
       outputNormals,
+      outputOctEncodedNormals,
       outputIndices,
       positionMinimums,
       positionMaximums);
@@ -533,6 +619,7 @@ static void addSkirts(
       southEdgeIndices,
       outputPositions,
       outputNormals,
+      outputOctEncodedNormals,
       outputIndices,
       positionMinimums,
       positionMaximums);
@@ -566,6 +653,7 @@ static void addSkirts(
       eastEdgeIndices,
       outputPositions,
       outputNormals,
+      outputOctEncodedNormals,
       outputIndices,
       positionMinimums,
       positionMaximums);
@@ -599,11 +687,74 @@ static void addSkirts(
       northEdgeIndices,
       outputPositions,
       outputNormals,
+      outputOctEncodedNormals,
       outputIndices,
       positionMinimums,
       positionMaximums);
 }
 
+// Appends the indices of the vertices along one edge, sorted by one of their
+// texture coordinates, and returns how many there are.
+template <class E>
+static uint32_t appendSortedEdgeIndices(
+    const std::vector<glm::dvec3>& uvsAndHeights,
+    const gsl::span<const std::byte>& edgeIndicesBuffer,
+    glm::length_t component,
+    bool descending,
+    std::vector<uint32_t>& edgeIndices) {
+  const gsl::span<const E> encoded(
+      reinterpret_cast<const E*>(edgeIndicesBuffer.data()),
+      edgeIndicesBuffer.size() / sizeof(E));
+  const size_t begin = edgeIndices.size();
+  edgeIndices.insert(edgeIndices.end(), encoded.begin(), encoded.end());
+  std::sort(
+      edgeIndices.begin() + int64_t(begin),
+      edgeIndices.end(),
+      [&uvsAndHeights, component, descending](uint32_t lhs, uint32_t rhs) {
+        const double lhsValue = uvsAndHeights[lhs][component];
+        const double rhsValue = uvsAndHeights[rhs][component];
+        return descending ? lhsValue > rhsValue : lhsValue < rhsValue;
+      });
+  return static_cast<uint32_t>(edgeIndices.size() - begin);
+}
+
+// Collects the indices of the vertices along the edges in the same order in
+// which addSkirts adds skirts to them, for the renderer to create the skirts.
+template <class E>
+static void addSkirtEdgeIndices(
+    const std::vector<glm::dvec3>& uvsAndHeights,
+    const gsl::span<const std::byte>& westEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& southEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& eastEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& northEdgeIndicesBuffer,
+    std::vector<uint32_t>& edgeIndices,
+    SkirtMeshMetadata& skirtMeshMetadata) {
+  skirtMeshMetadata.skirtWestEdgeCount = appendSortedEdgeIndices<E>(
+      uvsAndHeights,
+      westEdgeIndicesBuffer,
+      1,
+      false,
+      edgeIndices);
+  skirtMeshMetadata.skirtSouthEdgeCount = appendSortedEdgeIndices<E>(
+      uvsAndHeights,
+      southEdgeIndicesBuffer,
+      0,
+      true,
+      edgeIndices);
+  skirtMeshMetadata.skirtEastEdgeCount = appendSortedEdgeIndices<E>(
+      uvsAndHeights,
+      eastEdgeIndicesBuffer,
+      1,
+      true,
+      edgeIndices);
+  skirtMeshMetadata.skirtNorthEdgeCount = appendSortedEdgeIndices<E>(
+      uvsAndHeights,
+      northEdgeIndicesBuffer,
+      0,
+      false,
+      edgeIndices);
+}
+
 static void decodeNormals(
     const gsl::span<const std::byte>& encoded,
     const gsl::span<float>& decoded) {
@@ -673,14 +824,84 @@ static std::vector<std::byte> generateNormals(
   return normalsBuffer;
 }
 
+// The water mask extension always holds a 256x256 mask.
+static constexpr uint32_t waterMaskSize = 256;
+
+// Finds the lowest power-of-two resolution at which each texel of the water
+// mask covers a block of identical texels, so that the mask can be stored at
+// that resolution without losing anything.
+static uint32_t
+findLosslessWaterMaskResolution(const gsl::span<const std::byte>& waterMask) {
+  for (uint32_t resolution = 1; resolution < waterMaskSize; resolution *= 2) {
+    const uint32_t blockSize = waterMaskSize / resolution;
+    bool isLossless = true;
+    for (uint32_t y = 0; y < waterMaskSize && isLossless; ++y) {
+      const size_t blockRow = size_t(y / blockSize * blockSize) * waterMaskSize;
+      const size_t row = size_t(y) * waterMaskSize;
+      for (uint32_t x = 0; x < waterMaskSize; ++x) {
+        const size_t blockColumn = x / blockSize * blockSize;
+        if (waterMask[row + x] != waterMask[blockRow + blockColumn]) {
+          isLossless = false;
+          break;
+        }
+      }
+    }
+
+    if (isLossless) {
+      return resolution;
+    }
+  }
+
+  return waterMaskSize;
+}
+
+static void createWaterMaskImage(
+    const gsl::span<const std::byte>& waterMask,
+    bool downsample,
+    bool packBits,
+    CesiumGltf::ImageCesium& image) {
+  const uint32_t resolution =
+      downsample ? findLosslessWaterMaskResolution(waterMask) : waterMaskSize;
+  const uint32_t step = waterMaskSize / resolution;
+  const uint32_t rowBytes = packBits ? (resolution + 7) / 8 : resolution;
+
+  image.width = int32_t(rowBytes);
+  image.height = int32_t(resolution);
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  image.pixelData.assign(size_t(rowBytes) * resolution, std::byte(0));
+
+  for (uint32_t y = 0; y < resolution; ++y) {
+    const std::byte* pSource =
+        waterMask.data() + size_t(y * step) * waterMaskSize;
+    std::byte* pTarget = image.pixelData.data() + size_t(y) * rowBytes;
+    for (uint32_t x = 0; x < resolution; ++x) {
+      const std::byte texel = pSource[x * step];
+      if (!packBits) {
+        pTarget[x] = texel;
+      } else if (texel != std::byte(0)) {
+        pTarget[x / 8] |= std::byte(1 << (x % 8));
+      }
+    }
+  }
+}
+
 /*static*/ QuantizedMeshLoadResult QuantizedMeshLoader::load(
     const QuadtreeTileID& tileID,
     const BoundingRegion& tileBoundingVolume,
     const std::string& url,
     const gsl::span<const std::byte>& data,
-    bool enableWaterMask) {
-
-  CESIUM_TRACE("Cesium3DTilesSelection::QuantizedMeshLoader::load");
+    bool enableWaterMask,
+    bool keepOctEncodedNormals,
+    bool generateMissingNormals,
+    bool skirtsAsEdgeIndices,
+    bool downsampleWaterMask,
+    bool packWaterMaskBits,
+    bool parseMetadata) {
+
+  CESIUM_TRACE_CATEGORY(
+      Decode,
+      "Cesium3DTilesSelection::QuantizedMeshLoader::load");
 
   QuantizedMeshLoadResult result;
 
@@ -696,9 +917,13 @@ static std::vector<std::byte> generateNormals(
   const uint32_t vertexCount = pHeader->vertexCount;
   const uint32_t indicesCount = meshView->triangleCount * 3;
   const uint32_t skirtVertexCount =
-      meshView->westEdgeIndicesCount + meshView->southEdgeIndicesCount +
-      meshView->eastEdgeIndicesCount + meshView->northEdgeIndicesCount;
-  const uint32_t skirtIndicesCount = (skirtVertexCount - 4) * 6;
+      skirtsAsEdgeIndices
+          ? 0
+          : meshView->westEdgeIndicesCount + meshView->southEdgeIndicesCount +
+                meshView->eastEdgeIndicesCount +
+                meshView->northEdgeIndicesCount;
+  const uint32_t skirtIndicesCount =
+      skirtsAsEdgeIndices ? 0 : (skirtVertexCount - 4) * 6;
 
   // decode position without skirt, but preallocate position buffer to include
   // skirt as well
@@ -707,7 +932,6 @@ static std::vector<std::byte> generateNormals(
   gsl::span<float> outputPositions(
       reinterpret_cast<float*>(outputPositionsBuffer.data()),
       (vertexCount + skirtVertexCount) * 3);
-  size_t positionOutputIndex = 0;
 
   const glm::dvec3 center(
       pHeader->BoundingSphereCenterX,
@@ -731,42 +955,70 @@ static std::vector<std::byte> generateNormals(
   const double east = rectangle.getEast();
   const double north = rectangle.getNorth();
 
-  int32_t u = 0;
-  int32_t v = 0;
-  int32_t height = 0;
-  std::vector<glm::dvec3> uvsAndHeights;
-  uvsAndHeights.reserve(vertexCount);
+  // The temporary arrays reuse the memory of the last tile decoded in this
+  // thread.
+  ScratchVector<int32_t> usScratch;
+  ScratchVector<int32_t> vsScratch;
+  ScratchVector<int32_t> heightsScratch;
+  std::vector<int32_t>& us = *usScratch;
+  std::vector<int32_t>& vs = *vsScratch;
+  std::vector<int32_t>& heights = *heightsScratch;
+  decodeZigZagDeltas(meshView->uBuffer, us);
+  decodeZigZagDeltas(meshView->vBuffer, vs);
+  decodeZigZagDeltas(meshView->heightBuffer, heights);
+
+  ScratchVector<glm::dvec3> uvsAndHeightsScratch;
+  ScratchVector<double> longitudesScratch;
+  ScratchVector<double> latitudesScratch;
+  ScratchVector<double> heightsMetersScratch;
+  std::vector<glm::dvec3>& uvsAndHeights = *uvsAndHeightsScratch;
+  std::vector<double>& longitudes = *longitudesScratch;
+  std::vector<double>& latitudes = *latitudesScratch;
+  std::vector<double>& heightsMeters = *heightsMetersScratch;
+  uvsAndHeights.resize(vertexCount);
+  longitudes.resize(vertexCount);
+  latitudes.resize(vertexCount);
+  heightsMeters.resize(vertexCount);
   for (size_t i = 0; i < vertexCount; ++i) {
-    u += zigZagDecode(meshView->uBuffer[i]);
-    v += zigZagDecode(meshView->vBuffer[i]);
-    height += zigZagDecode(meshView->heightBuffer[i]);
-
-    double uRatio = static_cast<double>(u) / 32767.0;
-    double vRatio = static_cast<double>(v) / 32767.0;
-    double heightRatio = static_cast<double>(height) / 32767.0;
-
-    const double longitude = Math::lerp(west, east, uRatio);
-    const double latitude = Math::lerp(south, north, vRatio);
-    const double heightMeters =
-        Math::lerp(minimumHeight, maximumHeight, heightRatio);
+    const double uRatio = static_cast<double>(us[i]) / 32767.0;
+    const double vRatio = static_cast<double>(vs[i]) / 32767.0;
+    const double heightRatio = static_cast<double>(heights[i]) / 32767.0;
 
-    glm::dvec3 position = ellipsoid.cartographicToCartesian(
-        Cartographic(longitude, latitude, heightMeters));
-    position -= center;
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.x);
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.y);
-    outputPositions[positionOutputIndex++] = static_cast<float>(position.z);
+    longitudes[i] = Math::lerp(west, east, uRatio);
+    latitudes[i] = Math::lerp(south, north, vRatio);
+    heightsMeters[i] = Math::lerp(minimumHeight, maximumHeight, heightRatio);
 
-    positionMinimums = glm::min(positionMinimums, position);
-    positionMaximums = glm::max(positionMaximums, position);
-
-    uvsAndHeights.emplace_back(uRatio, vRatio, heightRatio);
+    uvsAndHeights[i] = glm::dvec3(uRatio, vRatio, heightRatio);
   }
 
+  cartographicToCartesianRelativeToCenter(
+      ellipsoid,
+      center,
+      longitudes,
+      latitudes,
+      heightsMeters,
+      outputPositions,
+      positionMinimums,
+      positionMaximums);
+
   // decode normal vertices of the tile as well as its metadata without skirt
   std::vector<std::byte> outputNormalsBuffer;
   gsl::span<float> outputNormals;
-  if (!meshView->octEncodedNormalBuffer.empty()) {
+  std::vector<std::byte> outputOctEncodedNormalsBuffer;
+  gsl::span<std::byte> outputOctEncodedNormals;
+  if (!meshView->octEncodedNormalBuffer.empty() && keepOctEncodedNormals) {
+    outputOctEncodedNormalsBuffer.resize(
+        (vertexCount + skirtVertexCount) * octEncodedNormalStride);
+    for (size_t i = 0; i < vertexCount; ++i) {
+      outputOctEncodedNormalsBuffer[i * octEncodedNormalStride] =
+          meshView->octEncodedNormalBuffer[i * 2];
+      outputOctEncodedNormalsBuffer[i * octEncodedNormalStride + 1] =
+          meshView->octEncodedNormalBuffer[i * 2 + 1];
+    }
+    outputOctEncodedNormals = gsl::span<std::byte>(
+        outputOctEncodedNormalsBuffer.data(),
+        outputOctEncodedNormalsBuffer.size());
+  } else if (!meshView->octEncodedNormalBuffer.empty()) {
     const uint32_t totalNormalFloats = (vertexCount + skirtVertexCount) * 3;
     outputNormalsBuffer.resize(totalNormalFloats * sizeof(float));
     outputNormals = gsl::span<float>(
@@ -780,7 +1032,7 @@ static std::vector<std::byte> generateNormals(
   }
 
   // decode metadata
-  if (meshView->metadataJsonLength > 0) {
+  if (parseMetadata && meshView->metadataJsonLength > 0) {
     QuantizedMeshMetadataResult metadata =
         processMetadata(tileID, meshView->metadataJsonBuffer);
     result.availableTileRectangles = std::move(metadata.availability);
@@ -795,6 +1047,8 @@ static std::vector<std::byte> generateNormals(
       meshView->indexType == QuantizedMeshIndexType::UnsignedInt
           ? sizeof(uint32_t)
           : sizeof(uint16_t);
+  const bool shouldGenerateNormals =
+      generateMissingNormals && meshView->octEncodedNormalBuffer.empty();
   const double skirtHeight = calculateSkirtHeight(ellipsoid, rectangle);
   const double longitudeOffset = (east - west) * 0.0001;
   const double latitudeOffset = (north - south) * 0.0001;
@@ -811,7 +1065,7 @@ static std::vector<std::byte> generateNormals(
     decodeIndices(indices, outputIndices);
 
     // generate normals if no provided
-    if (outputNormalsBuffer.empty()) {
+    if (shouldGenerateNormals) {
       outputNormalsBuffer =
           generateNormals(outputPositions, outputIndices, indicesCount);
       outputNormals = gsl::span<float>(
@@ -820,27 +1074,30 @@ static std::vector<std::byte> generateNormals(
     }
 
     // add skirt
-    addSkirts<uint32_t, uint32_t>(
-        ellipsoid,
-        center,
-        rectangle,
-        minimumHeight,
-        maximumHeight,
-        vertexCount,
-        indicesCount,
-        skirtHeight,
-        longitudeOffset,
-        latitudeOffset,
-        uvsAndHeights,
-        meshView->westEdgeIndicesBuffer,
-        meshView->southEdgeIndicesBuffer,
-        meshView->eastEdgeIndicesBuffer,
-        meshView->northEdgeIndicesBuffer,
-        outputPositions,
-        outputNormals,
-        outputIndices,
-        positionMinimums,
-        positionMaximums);
+    if (!skirtsAsEdgeIndices) {
+      addSkirts<uint32_t, uint32_t>(
+          ellipsoid,
+          center,
+          rectangle,
+          minimumHeight,
+          maximumHeight,
+          vertexCount,
+          indicesCount,
+          skirtHeight,
+          longitudeOffset,
+          latitudeOffset,
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          outputPositions,
+          outputNormals,
+          outputOctEncodedNormals,
+          outputIndices,
+          positionMinimums,
+          positionMaximums);
+    }
 
     indexSizeBytes = sizeof(uint32_t);
   } else {
@@ -857,7 +1114,7 @@ static std::vector<std::byte> generateNormals(
       decodeIndices(indices, outputIndices);
 
       // generate normals if no provided
-      if (outputNormalsBuffer.empty()) {
+      if (shouldGenerateNormals) {
         outputNormalsBuffer =
             generateNormals(outputPositions, outputIndices, indicesCount);
         outputNormals = gsl::span<float>(
@@ -865,27 +1122,30 @@ static std::vector<std::byte> generateNormals(
             outputNormalsBuffer.size() / sizeof(float));
       }
 
-      addSkirts<uint16_t, uint16_t>(
-          ellipsoid,
-          center,
-          rectangle,
-          minimumHeight,
-          maximumHeight,
-          vertexCount,
-          indicesCount,
-          skirtHeight,
-          longitudeOffset,
-          latitudeOffset,
-          uvsAndHeights,
-          meshView->westEdgeIndicesBuffer,
-          meshView->southEdgeIndicesBuffer,
-          meshView->eastEdgeIndicesBuffer,
-          meshView->northEdgeIndicesBuffer,
-          outputPositions,
-          outputNormals,
-          outputIndices,
-          positionMinimums,
-          positionMaximums);
+      if (!skirtsAsEdgeIndices) {
+        addSkirts<uint16_t, uint16_t>(
+            ellipsoid,
+            center,
+            rectangle,
+            minimumHeight,
+            maximumHeight,
+            vertexCount,
+            indicesCount,
+            skirtHeight,
+            longitudeOffset,
+            latitudeOffset,
+            uvsAndHeights,
+            meshView->westEdgeIndicesBuffer,
+            meshView->southEdgeIndicesBuffer,
+            meshView->eastEdgeIndicesBuffer,
+            meshView->northEdgeIndicesBuffer,
+            outputPositions,
+            outputNormals,
+            outputOctEncodedNormals,
+            outputIndices,
+            positionMinimums,
+            positionMaximums);
+      }
 
       indexSizeBytes = sizeof(uint16_t);
     } else {
@@ -896,7 +1156,7 @@ static std::vector<std::byte> generateNormals(
       decodeIndices(indices, outputIndices);
 
       // generate normals if no provided
-      if (outputNormalsBuffer.empty()) {
+      if (shouldGenerateNormals) {
         outputNormalsBuffer =
             generateNormals(outputPositions, outputIndices, indicesCount);
         outputNormals = gsl::span<float>(
@@ -904,27 +1164,30 @@ static std::vector<std::byte> generateNormals(
             outputNormalsBuffer.size() / sizeof(float));
       }
 
-      addSkirts<uint16_t, uint32_t>(
-          ellipsoid,
-          center,
-          rectangle,
-          minimumHeight,
-          maximumHeight,
-          vertexCount,
-          indicesCount,
-          skirtHeight,
-          longitudeOffset,
-          latitudeOffset,
-          uvsAndHeights,
-          meshView->westEdgeIndicesBuffer,
-          meshView->southEdgeIndicesBuffer,
-          meshView->eastEdgeIndicesBuffer,
-          meshView->northEdgeIndicesBuffer,
-          outputPositions,
-          outputNormals,
-          outputIndices,
-          positionMinimums,
-          positionMaximums);
+      if (!skirtsAsEdgeIndices) {
+        addSkirts<uint16_t, uint32_t>(
+            ellipsoid,
+            center,
+            rectangle,
+            minimumHeight,
+            maximumHeight,
+            vertexCount,
+            indicesCount,
+            skirtHeight,
+            longitudeOffset,
+            latitudeOffset,
+            uvsAndHeights,
+            meshView->westEdgeIndicesBuffer,
+            meshView->southEdgeIndicesBuffer,
+            meshView->eastEdgeIndicesBuffer,
+            meshView->northEdgeIndicesBuffer,
+            outputPositions,
+            outputNormals,
+            outputOctEncodedNormals,
+            outputIndices,
+            positionMinimums,
+            positionMaximums);
+      }
 
       indexSizeBytes = sizeof(uint32_t);
     }
@@ -1016,6 +1279,41 @@ static std::vector<std::byte> generateNormals(
     primitive.attributes.emplace("NORMAL", static_cast<int>(normalAccessorId));
   }
 
+  // add oct-encoded normal buffer to gltf if the normals are kept encoded
+  if (!outputOctEncodedNormalsBuffer.empty()) {
+    const size_t octNormalBufferId = model.buffers.size();
+    model.buffers.emplace_back();
+    CesiumGltf::Buffer& octNormalBuffer = model.buffers[octNormalBufferId];
+    octNormalBuffer.byteLength = int64_t(outputOctEncodedNormalsBuffer.size());
+    octNormalBuffer.cesium.data = std::move(outputOctEncodedNormalsBuffer);
+
+    const size_t octNormalBufferViewId = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+    CesiumGltf::BufferView& octNormalBufferView =
+        model.bufferViews[octNormalBufferViewId];
+    octNormalBufferView.buffer = int32_t(octNormalBufferId);
+    octNormalBufferView.byteOffset = 0;
+    octNormalBufferView.byteStride = int64_t(octEncodedNormalStride);
+    octNormalBufferView.byteLength =
+        int64_t(octNormalBuffer.cesium.data.size());
+    octNormalBufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
+
+    const size_t octNormalAccessorId = model.accessors.size();
+    model.accessors.emplace_back();
+    CesiumGltf::Accessor& octNormalAccessor =
+        model.accessors[octNormalAccessorId];
+    octNormalAccessor.bufferView = int32_t(octNormalBufferViewId);
+    octNormalAccessor.byteOffset = 0;
+    octNormalAccessor.componentType =
+        CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE;
+    octNormalAccessor.count = vertexCount + skirtVertexCount;
+    octNormalAccessor.type = CesiumGltf::Accessor::Type::VEC2;
+
+    primitive.attributes.emplace(
+        QuantizedMeshLoader::OCT_ENCODED_NORMAL_ATTRIBUTE,
+        int32_t(octNormalAccessorId));
+  }
+
   // add indices buffer to gltf
   const size_t indicesBufferId = model.buffers.size();
   model.buffers.emplace_back();
@@ -1059,6 +1357,66 @@ static std::vector<std::byte> generateNormals(
   skirtMeshMetadata.skirtEastHeight = skirtHeight;
   skirtMeshMetadata.skirtNorthHeight = skirtHeight;
 
+
+  // add the edge vertex indices for the renderer to create skirts from
+  if (skirtsAsEdgeIndices) {
+    std::vector<uint32_t> edgeIndices;
+    edgeIndices.reserve(
+        meshView->westEdgeIndicesCount + meshView->southEdgeIndicesCount +
+        meshView->eastEdgeIndicesCount + meshView->northEdgeIndicesCount);
+    if (meshView->indexType == QuantizedMeshIndexType::UnsignedInt) {
+      addSkirtEdgeIndices<uint32_t>(
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          edgeIndices,
+          skirtMeshMetadata);
+    } else {
+      addSkirtEdgeIndices<uint16_t>(
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          edgeIndices,
+          skirtMeshMetadata);
+    }
+
+    const size_t edgeIndicesBufferId = model.buffers.size();
+    model.buffers.emplace_back();
+    CesiumGltf::Buffer& edgeIndicesBuffer = model.buffers[edgeIndicesBufferId];
+    edgeIndicesBuffer.cesium.data.resize(edgeIndices.size() * sizeof(uint32_t));
+    std::memcpy(
+        edgeIndicesBuffer.cesium.data.data(),
+        edgeIndices.data(),
+        edgeIndicesBuffer.cesium.data.size());
+    edgeIndicesBuffer.byteLength =
+        int64_t(edgeIndicesBuffer.cesium.data.size());
+
+    const size_t edgeIndicesBufferViewId = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+    CesiumGltf::BufferView& edgeIndicesBufferView =
+        model.bufferViews[edgeIndicesBufferViewId];
+    edgeIndicesBufferView.buffer = int32_t(edgeIndicesBufferId);
+    edgeIndicesBufferView.byteOffset = 0;
+    edgeIndicesBufferView.byteLength = edgeIndicesBuffer.byteLength;
+
+    const size_t edgeIndicesAccessorId = model.accessors.size();
+    model.accessors.emplace_back();
+    CesiumGltf::Accessor& edgeIndicesAccessor =
+        model.accessors[edgeIndicesAccessorId];
+    edgeIndicesAccessor.bufferView = int32_t(edgeIndicesBufferViewId);
+    edgeIndicesAccessor.byteOffset = 0;
+    edgeIndicesAccessor.type = CesiumGltf::Accessor::Type::SCALAR;
+    edgeIndicesAccessor.count = int64_t(edgeIndices.size());
+    edgeIndicesAccessor.componentType =
+        CesiumGltf::Accessor::ComponentType::UNSIGNED_INT;
+
+    skirtMeshMetadata.skirtEdgeIndicesAccessor = int32_t(edgeIndicesAccessorId);
+  }
+
   primitive.extras = SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
 
   // add only-water and only-land flags to primitive extras
@@ -1077,23 +1435,27 @@ static std::vector<std::byte> generateNormals(
     const size_t waterMaskImageId = model.images.size();
     model.images.emplace_back();
     CesiumGltf::Image& waterMaskImage = model.images[waterMaskImageId];
-    waterMaskImage.cesium.width = 256;
-    waterMaskImage.cesium.height = 256;
-    waterMaskImage.cesium.channels = 1;
-    waterMaskImage.cesium.bytesPerChannel = 1;
-    waterMaskImage.cesium.pixelData.resize(65536);
-    std::memcpy(
-        waterMaskImage.cesium.pixelData.data(),
-        meshView->waterMaskBuffer.data(),
-        65536);
+    createWaterMaskImage(
+        meshView->waterMaskBuffer,
+        downsampleWaterMask,
+        packWaterMaskBits,
+        waterMaskImage.cesium);
+    primitive.extras.emplace("WaterMaskPackedBits", packWaterMaskBits);
 
     // create sampler parameters
     const size_t waterMaskSamplerId = model.samplers.size();
     model.samplers.emplace_back();
     CesiumGltf::Sampler& waterMaskSampler = model.samplers[waterMaskSamplerId];
-    waterMaskSampler.magFilter = CesiumGltf::Sampler::MagFilter::LINEAR;
-    waterMaskSampler.minFilter =
-        CesiumGltf::Sampler::MinFilter::LINEAR_MIPMAP_NEAREST;
+    if (downsampleWaterMask || packWaterMaskBits) {
+      // Filtering would blur the blocks of a downsampled mask and mix the bits
+      // of a packed one.
+      waterMaskSampler.magFilter = CesiumGltf::Sampler::MagFilter::NEAREST;
+      waterMaskSampler.minFilter = CesiumGltf::Sampler::MinFilter::NEAREST;
+    } else {
+      waterMaskSampler.magFilter = CesiumGltf::Sampler::MagFilter::LINEAR;
+      waterMaskSampler.minFilter =
+          CesiumGltf::Sampler::MinFilter::LINEAR_MIPMAP_NEAREST;
+    }
     waterMaskSampler.wrapS = CesiumGltf::Sampler::WrapS::CLAMP_TO_EDGE;
     waterMaskSampler.wrapT = CesiumGltf::Sampler::WrapT::CLAMP_TO_EDGE;
 
@@ -4,6 +4,7 @@
 #include <CesiumGeospatial/GeographicProjection.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumQuantizedMeshTerrain/QuantizedMeshLoader.h>
 #include <CesiumUtility/Math.h>
 
@@ -16,6 +17,7 @@ using namespace Cesium3DTilesContent;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumGltf;
+using namespace CesiumGltfContent;
 using namespace CesiumQuantizedMeshTerrain;
 using namespace CesiumUtility;
 
@@ -1048,6 +1050,208 @@ TEST_CASE("Test converting quantized mesh to gltf with skirt") {
       REQUIRE(Math::equalsEpsilon(normals[i].z, normal.z, Math::Epsilon2));
     }
   }
+
+  SECTION("Check quantized mesh with skirts as edge indices") {
+    // mock quantized mesh
+    uint32_t verticesWidth = 3;
+    uint32_t verticesHeight = 3;
+    QuadtreeTileID tileID(10, 0, 0);
+    CesiumGeometry::Rectangle tileRectangle =
+        tilingScheme.tileToRectangle(tileID);
+    BoundingRegion boundingVolume = BoundingRegion(
+        GlobeRectangle(
+            tileRectangle.minimumX,
+            tileRectangle.minimumY,
+            tileRectangle.maximumX,
+            tileRectangle.maximumY),
+        0.0,
+        0.0);
+    QuantizedMesh<uint16_t> quantizedMesh = createGridQuantizedMesh<uint16_t>(
+        boundingVolume,
+        verticesWidth,
+        verticesHeight);
+
+    // convert to gltf
+    std::vector<std::byte> quantizedMeshBin =
+        convertQuantizedMeshToBinary(quantizedMesh);
+    gsl::span<const std::byte> data(
+        quantizedMeshBin.data(),
+        quantizedMeshBin.size());
+    auto loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        data,
+        false,
+        false,
+        true,
+        true);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+
+    checkGltfSanity(*loadResult.model);
+
+    const CesiumGltf::Model& model = *loadResult.model;
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+
+    // the mesh has no skirt vertices or triangles
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    CHECK(positions.size() == int64_t(verticesWidth * verticesHeight));
+    AccessorView<uint16_t> indices(model, primitive.indices);
+    CHECK(
+        indices.size() ==
+        int64_t(quantizedMesh.vertexData.indices.size()));
+
+    std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+        SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+    REQUIRE(skirtMeshMetadata);
+    CHECK(skirtMeshMetadata->skirtWestEdgeCount == verticesHeight);
+    CHECK(skirtMeshMetadata->skirtSouthEdgeCount == verticesWidth);
+    CHECK(skirtMeshMetadata->skirtEastEdgeCount == verticesHeight);
+    CHECK(skirtMeshMetadata->skirtNorthEdgeCount == verticesWidth);
+
+    // the west edge goes from south to north
+    AccessorView<uint32_t> edgeIndices(
+        model,
+        skirtMeshMetadata->skirtEdgeIndicesAccessor);
+    REQUIRE(edgeIndices.status() == AccessorViewStatus::Valid);
+    REQUIRE(
+        edgeIndices.size() == int64_t(2 * (verticesWidth + verticesHeight)));
+    for (int64_t i = 1; i < int64_t(verticesHeight); ++i) {
+      CHECK(positions[edgeIndices[i - 1]].z < positions[edgeIndices[i]].z);
+    }
+  }
+
+  SECTION("Check quantized mesh that keeps oct normal encoded") {
+    // mock quantized mesh
+    uint32_t verticesWidth = 3;
+    uint32_t verticesHeight = 3;
+    QuadtreeTileID tileID(10, 0, 0);
+    CesiumGeometry::Rectangle tileRectangle =
+        tilingScheme.tileToRectangle(tileID);
+    BoundingRegion boundingVolume = BoundingRegion(
+        GlobeRectangle(
+            tileRectangle.minimumX,
+            tileRectangle.minimumY,
+            tileRectangle.maximumX,
+            tileRectangle.maximumY),
+        0.0,
+        0.0);
+    QuantizedMesh<uint16_t> quantizedMesh = createGridQuantizedMesh<uint16_t>(
+        boundingVolume,
+        verticesWidth,
+        verticesHeight);
+
+    glm::vec3 normal = glm::normalize(glm::vec3(0.2, 1.4, 0.3));
+    uint8_t x = 0, y = 0;
+    octEncode(normal, x, y);
+    std::vector<std::byte> octNormals(verticesWidth * verticesHeight * 2);
+    for (size_t i = 0; i < octNormals.size(); i += 2) {
+      octNormals[i] = std::byte(x);
+      octNormals[i + 1] = std::byte(y);
+    }
+
+    Extension octNormalExtension;
+    octNormalExtension.extensionID = 1;
+    octNormalExtension.extensionData = std::move(octNormals);
+
+    quantizedMesh.extensions.emplace_back(std::move(octNormalExtension));
+
+    // convert to gltf
+    std::vector<std::byte> quantizedMeshBin =
+        convertQuantizedMeshToBinary(quantizedMesh);
+    gsl::span<const std::byte> data(
+        quantizedMeshBin.data(),
+        quantizedMeshBin.size());
+    auto loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        data,
+        false,
+        true);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+
+    checkGltfSanity(*loadResult.model);
+
+    const CesiumGltf::Model& model = *loadResult.model;
+    const CesiumGltf::Mesh& mesh = model.meshes.front();
+    const CesiumGltf::MeshPrimitive& primitive = mesh.primitives.front();
+    CHECK(primitive.attributes.find("NORMAL") == primitive.attributes.end());
+
+    size_t totalSkirtVerticesCount =
+        quantizedMesh.vertexData.westIndices.size() +
+        quantizedMesh.vertexData.southIndices.size() +
+        quantizedMesh.vertexData.eastIndices.size() +
+        quantizedMesh.vertexData.northIndices.size();
+
+    AccessorView<glm::u8vec2> encodedNormals(
+        model,
+        primitive.attributes.at(
+            QuantizedMeshLoader::OCT_ENCODED_NORMAL_ATTRIBUTE));
+    CHECK(encodedNormals.status() == AccessorViewStatus::Valid);
+
+    REQUIRE(
+        static_cast<size_t>(encodedNormals.size()) ==
+        (verticesWidth * verticesHeight + totalSkirtVerticesCount));
+    for (int64_t i = 0; i < encodedNormals.size(); ++i) {
+      REQUIRE(encodedNormals[i].x == x);
+      REQUIRE(encodedNormals[i].y == y);
+    }
+  }
+
+  SECTION("Check quantized mesh that skips generating missing normals") {
+    // mock quantized mesh
+    uint32_t verticesWidth = 3;
+    uint32_t verticesHeight = 3;
+    QuadtreeTileID tileID(10, 0, 0);
+    CesiumGeometry::Rectangle tileRectangle =
+        tilingScheme.tileToRectangle(tileID);
+    BoundingRegion boundingVolume = BoundingRegion(
+        GlobeRectangle(
+            tileRectangle.minimumX,
+            tileRectangle.minimumY,
+            tileRectangle.maximumX,
+            tileRectangle.maximumY),
+        0.0,
+        0.0);
+    QuantizedMesh<uint16_t> quantizedMesh = createGridQuantizedMesh<uint16_t>(
+        boundingVolume,
+        verticesWidth,
+        verticesHeight);
+
+    // convert to gltf
+    std::vector<std::byte> quantizedMeshBin =
+        convertQuantizedMeshToBinary(quantizedMesh);
+    gsl::span<const std::byte> data(
+        quantizedMeshBin.data(),
+        quantizedMeshBin.size());
+    auto loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        data,
+        false,
+        false,
+        false);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+
+    checkGltfSanity(*loadResult.model);
+
+    const CesiumGltf::Model& model = *loadResult.model;
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+    CHECK(primitive.attributes.find("NORMAL") == primitive.attributes.end());
+    CHECK(
+        primitive.attributes.find(
+            QuantizedMeshLoader::OCT_ENCODED_NORMAL_ATTRIBUTE) ==
+        primitive.attributes.end());
+  }
 }
 
 TEST_CASE("Test converting ill-formed quantized mesh") {
@@ -1622,3 +1826,165 @@ TEST_CASE("Test converting ill-formed quantized mesh") {
     REQUIRE(loadResult.model == std::nullopt);
   }
 }
+
+TEST_CASE("Test converting quantized mesh water mask and metadata") {
+  CesiumGeometry::Rectangle rectangle(
+      glm::dvec2(-Math::OnePi, -Math::PiOverTwo),
+      glm::dvec2(Math::OnePi, Math::PiOverTwo));
+  QuadtreeTilingScheme tilingScheme(rectangle, 2, 1);
+
+  QuadtreeTileID tileID(10, 0, 0);
+  CesiumGeometry::Rectangle tileRectangle =
+      tilingScheme.tileToRectangle(tileID);
+  BoundingRegion boundingVolume = BoundingRegion(
+      GlobeRectangle(
+          tileRectangle.minimumX,
+          tileRectangle.minimumY,
+          tileRectangle.maximumX,
+          tileRectangle.maximumY),
+      0.0,
+      0.0);
+  QuantizedMesh<uint16_t> quantizedMesh =
+      createGridQuantizedMesh<uint16_t>(boundingVolume, 3, 3);
+
+  // A mask with water in the first 64 columns of the top half and nowhere
+  // else, so that it can be stored at 4x2 texels without losing anything.
+  Extension waterMaskExtension;
+  waterMaskExtension.extensionID = 2;
+  waterMaskExtension.extensionData.resize(256 * 256, std::byte(0));
+  for (size_t y = 0; y < 128; ++y) {
+    for (size_t x = 0; x < 64; ++x) {
+      waterMaskExtension.extensionData[y * 256 + x] = std::byte(255);
+    }
+  }
+  quantizedMesh.extensions.emplace_back(std::move(waterMaskExtension));
+
+  const std::string metadataJson =
+      R"({"available":[[{"startX":0,"startY":0,"endX":1,"endY":1}]]})";
+  Extension metadataExtension;
+  metadataExtension.extensionID = 4;
+  const uint32_t metadataJsonLength = uint32_t(metadataJson.size());
+  metadataExtension.extensionData.resize(
+      sizeof(uint32_t) + metadataJson.size());
+  std::memcpy(
+      metadataExtension.extensionData.data(),
+      &metadataJsonLength,
+      sizeof(uint32_t));
+  std::memcpy(
+      metadataExtension.extensionData.data() + sizeof(uint32_t),
+      metadataJson.data(),
+      metadataJson.size());
+  quantizedMesh.extensions.emplace_back(std::move(metadataExtension));
+
+  std::vector<std::byte> quantizedMeshBin =
+      convertQuantizedMeshToBinary(quantizedMesh);
+  gsl::span<const std::byte> data(
+      quantizedMeshBin.data(),
+      quantizedMeshBin.size());
+
+  auto load = [&](bool downsample, bool packBits, bool parseMetadata) {
+    auto loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        data,
+        true,
+        false,
+        true,
+        false,
+        downsample,
+        packBits,
+        parseMetadata);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+    checkGltfSanity(*loadResult.model);
+    return loadResult;
+  };
+
+  auto getWaterMask = [](const Model& model) -> const ImageCesium& {
+    const MeshPrimitive& primitive = model.meshes.front().primitives.front();
+    auto textureIt = primitive.extras.find("WaterMaskTex");
+    REQUIRE(textureIt != primitive.extras.end());
+    const int64_t textureId = textureIt->second.getInt64OrDefault(-1);
+    REQUIRE(textureId >= 0);
+    const Texture& texture = model.textures[size_t(textureId)];
+    return model.images[size_t(texture.source)].cesium;
+  };
+
+  SECTION("Check the full water mask") {
+    auto loadResult = load(false, false, true);
+    const ImageCesium& image = getWaterMask(*loadResult.model);
+    CHECK(image.width == 256);
+    CHECK(image.height == 256);
+    CHECK(image.pixelData.size() == 256 * 256);
+    CHECK(image.pixelData[0] == std::byte(255));
+    CHECK(image.pixelData[64] == std::byte(0));
+    CHECK(image.pixelData[128 * 256] == std::byte(0));
+
+    CHECK(loadResult.availableTileRectangles.size() == 1);
+  }
+
+  SECTION("Check the downsampled water mask") {
+    auto loadResult = load(true, false, true);
+    const ImageCesium& image = getWaterMask(*loadResult.model);
+    CHECK(image.width == 4);
+    CHECK(image.height == 4);
+    CHECK(
+        image.pixelData == std::vector<std::byte>{
+                               std::byte(255),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(255),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0),
+                               std::byte(0)});
+
+    const Sampler& sampler = loadResult.model->samplers.front();
+    CHECK(sampler.magFilter == Sampler::MagFilter::NEAREST);
+    CHECK(sampler.minFilter == Sampler::MinFilter::NEAREST);
+  }
+
+  SECTION("Check the packed water mask") {
+    auto loadResult = load(false, true, true);
+    const ImageCesium& image = getWaterMask(*loadResult.model);
+    CHECK(image.width == 32);
+    CHECK(image.height == 256);
+    CHECK(image.pixelData[0] == std::byte(0xff));
+    CHECK(image.pixelData[7] == std::byte(0xff));
+    CHECK(image.pixelData[8] == std::byte(0));
+    CHECK(image.pixelData[128 * 32] == std::byte(0));
+
+    const MeshPrimitive& primitive =
+        loadResult.model->meshes.front().primitives.front();
+    auto packedIt = primitive.extras.find("WaterMaskPackedBits");
+    REQUIRE(packedIt != primitive.extras.end());
+    CHECK(packedIt->second.getBoolOrDefault(false));
+  }
+
+  SECTION("Check the downsampled and packed water mask") {
+    auto loadResult = load(true, true, true);
+    const ImageCesium& image = getWaterMask(*loadResult.model);
+    CHECK(image.width == 1);
+    CHECK(image.height == 4);
+    CHECK(
+        image.pixelData == std::vector<std::byte>{
+                               std::byte(0x01),
+                               std::byte(0x01),
+                               std::byte(0),
+                               std::byte(0)});
+  }
+
+  SECTION("Check skipping the metadata extension") {
+    auto loadResult = load(false, false, false);
+    CHECK(loadResult.availableTileRectangles.empty());
+  }
+}
@@ -3,6 +3,7 @@
 #include "Library.h"
 
 #include <any>
+#include <cstdint>
 
 namespace CesiumGltf {
 struct ImageCesium;
@@ -51,6 +52,24 @@ public:
       RasterOverlayTile& rasterTile,
       void* pLoadThreadResult) = 0;
 
+  /**
+   * @brief Reports how many bytes of GPU memory the renderer resources for a
+   * raster tile use.
+   *
+   * This is called right after {@link prepareRasterInMainThread}, from the
+   * same thread. The default implementation returns 0, indicating that GPU
+   * memory usage is not reported.
+   *
+   * @param rasterTile The raster tile that was prepared.
+   * @param pMainThreadResult The value returned from
+   * {@link prepareRasterInMainThread}.
+   */
+  virtual int64_t getRasterGpuByteSize(
+      [[maybe_unused]] const RasterOverlayTile& rasterTile,
+      [[maybe_unused]] void* pMainThreadResult) const noexcept {
+    return 0;
+  }
+
   /**
    * @brief Frees previously-prepared renderer resources for a raster tile.
    *
@@ -4,6 +4,7 @@
 #include "RasterOverlay.h"
 
 #include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/SharedFuture.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 
 #include <functional>
@@ -68,6 +69,15 @@ private:
 
   static std::unordered_map<std::string, ExternalAssetEndpoint> endpointCache;
 
+  // The requests for endpoints that are in progress, by URL, so that overlays
+  // of the same asset share a single request.
+  using ExternalAssetEndpointResult =
+      nonstd::expected<ExternalAssetEndpoint, RasterOverlayLoadFailureDetails>;
+  static std::unordered_map<
+      std::string,
+      CesiumAsync::SharedFuture<ExternalAssetEndpointResult>>
+      endpointRequests;
+
   CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
       const ExternalAssetEndpoint& endpoint,
       const CesiumAsync::AsyncSystem& asyncSystem,
@@ -77,6 +87,11 @@ private:
           pPrepareRendererResources,
       const std::shared_ptr<spdlog::logger>& pLogger,
       CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner) const;
+
+  static CesiumAsync::Future<ExternalAssetEndpointResult> requestEndpoint(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::string& ionUrl);
 };
 
 } // namespace CesiumRasterOverlays
@@ -10,9 +10,14 @@
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumUtility/CreditSystem.h>
 
+#include <array>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
@@ -87,6 +92,9 @@ public:
    * @brief Computes the best quadtree level to use for an image intended to
    * cover a given projected rectangle when it is a given size on the screen.
    *
+   * If {@link RasterOverlayOptions::levelHysteresis} is greater than zero,
+   * the level previously computed for the same rectangle is preferred.
+   *
    * @param rectangle The range of projected coordinates to cover.
    * @param screenPixels The number of screen pixels to be covered by the
    * rectangle.
@@ -107,6 +115,33 @@ protected:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadQuadtreeTileImage(const CesiumGeometry::QuadtreeTileID& tileID) const = 0;
 
+  /**
+   * @brief Gets the key that identifies the source of the images loaded by
+   * {@link loadQuadtreeTileImage}, such as its URL template, in the
+   * {@link QuadtreeTileImageCache} given to
+   * {@link RasterOverlayTileProvider::setTileImageCache}.
+   *
+   * Providers with the same key must load the same image for every tile ID,
+   * with the same credits. The default implementation returns an empty
+   * string, which means that the images of this provider are not shared.
+   */
+  virtual std::string getTileImageCacheKey() const;
+
+  /**
+   * @brief Creates a tile for a rectangle.
+   *
+   * If {@link RasterOverlayOptions::shareQuadtreeTiles} is true and the
+   * rectangle maps to exactly one quadtree tile, this returns a tile that
+   * covers that whole quadtree tile and that is shared by every rectangle
+   * that maps to it. Otherwise, it creates a new tile for the rectangle.
+   */
+  virtual CesiumUtility::IntrusivePointer<RasterOverlayTile> createTile(
+      const CesiumGeometry::Rectangle& rectangle,
+      const glm::dvec2& targetScreenPixels) override;
+
+  /** @copydoc RasterOverlayTileProvider::destroyTile */
+  virtual void destroyTile(const RasterOverlayTile& tile) noexcept override;
+
 private:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadTileImage(RasterOverlayTile& overlayTile) override final;
@@ -119,6 +154,18 @@ private:
   CesiumAsync::SharedFuture<LoadedQuadtreeImage>
   getQuadtreeTile(const CesiumGeometry::QuadtreeTileID& tileID);
 
+  /**
+   * @brief Finds the IDs of the quadtree tiles to map to a geometry tile.
+   *
+   * @param geometryRectangle The rectangle for which to find tiles.
+   * @param targetScreenPixels The number of screen pixels controlling which
+   * quadtree level to use to cover the rectangle.
+   * @return The IDs of the tiles that cover the rectangle.
+   */
+  std::vector<CesiumGeometry::QuadtreeTileID> mapRasterTileIDsToGeometryTile(
+      const CesiumGeometry::Rectangle& geometryRectangle,
+      const glm::dvec2 targetScreenPixels);
+
   /**
    * @brief Map raster tiles to geometry tile.
    *
@@ -136,6 +183,15 @@ private:
 
   void unloadCachedTiles();
 
+  /**
+   * @brief Creates a tile whose image is combined from the quadtree tiles
+   * that cover the rectangle, or reuses the one created before for the same
+   * rectangle if {@link RasterOverlayOptions::levelHysteresis} allows it.
+   */
+  CesiumUtility::IntrusivePointer<RasterOverlayTile> createCombinedTile(
+      const CesiumGeometry::Rectangle& rectangle,
+      const glm::dvec2& targetScreenPixels);
+
   struct CombinedImageMeasurements {
     CesiumGeometry::Rectangle rectangle;
     int32_t widthPixels;
@@ -162,6 +218,9 @@ private:
   struct CacheEntry {
     CesiumGeometry::QuadtreeTileID tileID;
     CesiumAsync::SharedFuture<LoadedQuadtreeImage> future;
+
+    // Whether the image came from the QuadtreeTileImageCache.
+    bool sharedImage;
   };
 
   // Tiles at the beginning of this list are the least recently used (oldest),
@@ -176,5 +235,26 @@ private:
       _tileLookup;
 
   std::atomic<int64_t> _cachedBytes;
+
+  // The tiles that cover one whole quadtree tile and are shared by every
+  // rectangle that maps to it, if shareQuadtreeTiles is enabled. They don't
+  // own the tiles, which remove themselves in destroyTile.
+  std::unordered_map<CesiumGeometry::QuadtreeTileID, RasterOverlayTile*>
+      _sharedTiles;
+  std::unordered_map<const RasterOverlayTile*, CesiumGeometry::QuadtreeTileID>
+      _sharedTileIDs;
+
+  // The level last chosen for each rectangle, and the tile last combined for
+  // it, if it's still alive, if levelHysteresis is enabled. The rectangles
+  // are keyed by their coordinates.
+  using RectangleKey = std::array<double, 4>;
+  struct RectangleLevel {
+    uint32_t level;
+    RasterOverlayTile* pCombinedTile;
+    uint32_t combinedLevel;
+  };
+  std::map<RectangleKey, RectangleLevel> _rectangleLevels;
+  std::unordered_map<const RasterOverlayTile*, RectangleKey>
+      _combinedTileRectangles;
 };
 } // namespace CesiumRasterOverlays
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Library.h"
+#include "RasterOverlayTileProvider.h"
+
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief Shares the loaded images of quadtree tiles between raster overlay
+ * tile providers that load them from the same source, with one budget of
+ * bytes for all of them.
+ *
+ * When the same imagery, such as a Bing Maps or TMS layer, is draped over
+ * several tilesets, each tileset has its own tile provider, and each provider
+ * caches its own quadtree tiles. With this cache, the providers of such
+ * overlays load and decode each quadtree tile once, and share one copy of it.
+ *
+ * Images are identified by a key of their source, from
+ * {@link QuadtreeRasterOverlayTileProvider::getTileImageCacheKey}, and by their
+ * tile ID. The credits of an image are shared too, so the providers sharing
+ * this cache must use the same credit system.
+ *
+ * Images are requested in the main thread, so this class is not thread-safe.
+ */
+class CESIUMRASTEROVERLAYS_API QuadtreeTileImageCache final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumBytes The maximum number of bytes of images to keep after
+   * they're loaded, across all the providers that share this cache.
+   */
+  explicit QuadtreeTileImageCache(
+      int64_t maximumBytes = 64 * 1024 * 1024) noexcept;
+
+  /**
+   * @brief Gets the image of a quadtree tile, loading it if it's not already
+   * cached or loading.
+   *
+   * @param sourceKey The key of the source of the image.
+   * @param tileID The ID of the quadtree tile.
+   * @param load The function to load the image if it isn't cached. It is
+   * called before this method returns, if at all.
+   * @return A future that resolves to the image.
+   */
+  CesiumAsync::SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>>
+  getImage(
+      const std::string& sourceKey,
+      const CesiumGeometry::QuadtreeTileID& tileID,
+      const std::function<
+          CesiumAsync::Future<std::shared_ptr<LoadedRasterOverlayImage>>()>&
+          load);
+
+  /**
+   * @brief Gets the number of bytes of loaded images in this cache.
+   */
+  int64_t getCachedBytes() const noexcept { return *this->_pCachedBytes; }
+
+  /**
+   * @brief Gets the maximum number of bytes of loaded images to keep.
+   */
+  int64_t getMaximumBytes() const noexcept { return this->_maximumBytes; }
+
+private:
+  void unloadCachedImages() noexcept;
+
+  struct Key {
+    std::string sourceKey;
+    CesiumGeometry::QuadtreeTileID tileID;
+
+    bool operator==(const Key& other) const noexcept {
+      return this->tileID == other.tileID &&
+             this->sourceKey == other.sourceKey;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept;
+  };
+
+  struct CacheEntry {
+    Key key;
+    CesiumAsync::SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>>
+        future;
+  };
+
+  // Images at the beginning of this list are the least recently used (oldest),
+  // while the images at the end are most recently used (newest).
+  using ImageLeastRecentlyUsedList = std::list<CacheEntry>;
+  ImageLeastRecentlyUsedList _imagesOldToRecent;
+
+  std::unordered_map<Key, ImageLeastRecentlyUsedList::iterator, KeyHash>
+      _imageLookup;
+
+  int64_t _maximumBytes;
+
+  // Shared with the loads in progress, which add the bytes of their image
+  // when they finish, even after this cache is destroyed.
+  std::shared_ptr<std::atomic<int64_t>> _pCachedBytes;
+};
+
+} // namespace CesiumRasterOverlays
@@ -12,6 +12,7 @@
 #include <spdlog/fwd.h>
 
 #include <any>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -22,6 +23,10 @@ struct Credit;
 class CreditSystem;
 } // namespace CesiumUtility
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 class IPrepareRasterOverlayRendererResources;
@@ -73,12 +78,84 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   double maximumScreenSpaceError = 2.0;
 
+  /**
+   * @brief Whether geometry tiles that map to a single tile of a
+   * {@link QuadtreeRasterOverlayTileProvider} share one raster overlay tile
+   * covering that whole quadtree tile.
+   *
+   * By default, every geometry tile gets its own image, combined from the
+   * quadtree tiles that it overlaps. When this is true, a geometry tile that
+   * overlaps only one quadtree tile uses a raster overlay tile with that
+   * quadtree tile's image as-is instead, with its own translation and scale
+   * of the texture coordinates when the image is attached to it. Each such
+   * image is then only prepared for rendering once, no matter how many
+   * geometry tiles it's draped on.
+   */
+  bool shareQuadtreeTiles = false;
+
+  /**
+   * @brief How far past the halfway point between two quadtree levels the
+   * ideal level for a rectangle must move before a
+   * {@link QuadtreeRasterOverlayTileProvider} switches to the other level for
+   * that rectangle.
+   *
+   * By default, the level for a rectangle is always the one nearest to the
+   * ideal level for its screen size, so a rectangle whose size hovers around
+   * the halfway point switches back and forth, and each switch loads and
+   * combines the quadtree tiles again. When this is greater than zero, the
+   * level chosen before for the same rectangle is kept until the ideal level
+   * is more than 0.5 plus this many levels away from it. A raster overlay
+   * tile that was already combined for the same rectangle is also reused
+   * while it's still alive, as long as its level is within one of the level
+   * that would be chosen now.
+   */
+  double levelHysteresis = 0.0;
+
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
 
+  /**
+   * @brief The gpu-compressed pixel format to compress the images of raster
+   * overlay tiles to, or NONE to keep them uncompressed.
+   *
+   * The images are compressed in a worker thread with
+   * {@link CesiumGltfContent::ImageManipulation::compressImage} after they're
+   * loaded and combined, before they're passed to
+   * {@link IPrepareRasterOverlayRendererResources::prepareRasterInLoadThread}.
+   * Only BC1_RGB and BC3_RGBA are supported, so this should only be set to one
+   * of them when the client's GPU supports it. An image that can't be
+   * compressed, such as one that doesn't have 4 channels of 1 byte each, is
+   * left uncompressed, so clients must still check its
+   * `compressedPixelFormat`.
+   */
+  CesiumGltf::GpuCompressedPixelFormat compressedPixelFormat =
+      CesiumGltf::GpuCompressedPixelFormat::NONE;
+
+  /**
+   * @brief A database in which to cache the decoded images of raster overlay
+   * tiles, or nullptr to decode every image that is loaded.
+   *
+   * The images that are loaded by
+   * {@link RasterOverlayTileProvider::loadTileImageFromUrl} are stored after
+   * they're decoded, keyed by their URL and the {@link ktx2TranscodeTargets}.
+   * When an image is found here, it's neither requested nor decoded again.
+   * Because the decoded images are much larger than the encoded ones, this
+   * should be a separate database from the one used by a
+   * {@link CesiumAsync::CachingAssetAccessor}, such as a
+   * {@link CesiumAsync::SqliteCache} with its own file, so that they don't
+   * evict each other.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pDecodedImageCache;
+
+  /**
+   * @brief The number of seconds that an image is kept in the
+   * {@link pDecodedImageCache}.
+   */
+  int64_t decodedImageCacheSeconds = 7 * 24 * 60 * 60;
+
   /**
    * @brief A callback function that is invoked when a raster overlay resource
    * fails to load.
@@ -233,6 +233,16 @@ public:
     this->_pRendererResources = pValue;
   }
 
+  /**
+   * @brief Gets the number of bytes of GPU memory used by this tile's renderer
+   * resources, as reported by
+   * {@link IPrepareRasterOverlayRendererResources::getRasterGpuByteSize}.
+   *
+   * This is zero until {@link loadInMainThread} has prepared the renderer
+   * resources, or if the renderer does not report its GPU memory usage.
+   */
+  int64_t getGpuByteSize() const noexcept { return this->_gpuByteSize; }
+
   /**
    * @brief Determines if more detailed data is available for the spatial area
    * covered by this tile.
@@ -259,5 +269,6 @@ private:
   CesiumGltf::ImageCesium _image;
   void* _pRendererResources;
   MoreDetailAvailable _moreDetailAvailable;
+  int64_t _gpuByteSize;
 };
 } // namespace CesiumRasterOverlays
@@ -3,6 +3,8 @@
 #include "Library.h"
 
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumAsync/TileLoadScheduler.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumUtility/CreditSystem.h>
@@ -14,12 +16,15 @@
 
 #include <cassert>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
 class RasterOverlay;
 class RasterOverlayTile;
 class IPrepareRasterOverlayRendererResources;
+class QuadtreeTileImageCache;
 
 /**
  * @brief Summarizes the result of loading an image of a {@link RasterOverlay}.
@@ -286,6 +291,15 @@ public:
    */
   int64_t getTileDataBytes() const noexcept { return this->_tileDataBytes; }
 
+  /**
+   * @brief Gets the number of bytes of GPU memory used by the renderer
+   * resources of the tiles that are currently loaded, as reported by
+   * {@link IPrepareRasterOverlayRendererResources::getRasterGpuByteSize}.
+   */
+  int64_t getTileGpuDataBytes() const noexcept {
+    return this->_tileGpuDataBytes;
+  }
+
   /**
    * @brief Returns the number of tiles that are currently loading.
    */
@@ -294,6 +308,20 @@ public:
     return this->_totalTilesCurrentlyLoading;
   }
 
+  /**
+   * @brief Gets a number that changes whenever the
+   * {@link RasterOverlayTile::getState} of one of the tiles of this provider
+   * changes.
+   *
+   * A geometry tile waiting for raster tiles of this provider compares this
+   * with the value it saw when it last examined them, so that it examines them
+   * again only after one of them, or one of the ancestors it may fall back to,
+   * has loaded or failed.
+   */
+  uint64_t getTileStateVersion() const noexcept {
+    return this->_tileStateVersion;
+  }
+
   /**
    * @brief Removes a no-longer-referenced tile from this provider's cache and
    * deletes it.
@@ -345,16 +373,96 @@ public:
    *
    * The number of allowable simultaneous tile requests is provided in the
    * {@link RasterOverlayOptions::maximumSimultaneousTileLoads} property of
-   * {@link RasterOverlay::getOptions}.
+   * {@link RasterOverlay::getOptions}. Normal loads leave a quarter of them
+   * free for urgent loads, and preloads leave half of them free, so that the
+   * tiles that are needed most don't wait for the others.
    *
    * @param tile The tile to load.
+   * @param priority The priority of the load, usually that of the geometry
+   * tile that the tile is mapped to.
    * @returns True if the tile load process is started or is already complete,
    * false if the load could not be started because too many loads are already
    * in progress.
    */
-  bool loadTileThrottled(RasterOverlayTile& tile);
+  bool loadTileThrottled(
+      RasterOverlayTile& tile,
+      CesiumAsync::TileLoadScheduler::Priority priority =
+          CesiumAsync::TileLoadScheduler::Priority::Normal);
+
+  /**
+   * @brief Gets the scheduler that shares a budget of simultaneous loads
+   * between this provider and others, or nullptr if there isn't one.
+   */
+  const std::shared_ptr<CesiumAsync::TileLoadScheduler>&
+  getTileLoadScheduler() const noexcept {
+    return this->_pTileLoadScheduler;
+  }
+
+  /**
+   * @brief Sets the scheduler that shares a budget of simultaneous loads
+   * between this provider and others.
+   *
+   * Throttled loads only start when both this provider's
+   * {@link RasterOverlayOptions::maximumSimultaneousTileLoads} and the
+   * scheduler allow it. This must be called before any tile loads start.
+   *
+   * @param pTileLoadScheduler The scheduler, or nullptr to use only this
+   * provider's own limit.
+   */
+  void setTileLoadScheduler(
+      const std::shared_ptr<CesiumAsync::TileLoadScheduler>&
+          pTileLoadScheduler) noexcept;
+
+  /**
+   * @brief Gets the cache that shares the images of quadtree tiles between
+   * this provider and others, or nullptr if there isn't one.
+   */
+  const std::shared_ptr<QuadtreeTileImageCache>&
+  getTileImageCache() const noexcept {
+    return this->_pTileImageCache;
+  }
+
+  /**
+   * @brief Sets the cache that shares the images of quadtree tiles between
+   * this provider and others.
+   *
+   * It is only used by providers, such as
+   * {@link QuadtreeRasterOverlayTileProvider}, that load their images as
+   * quadtree tiles. This must be called before any tile loads start.
+   *
+   * @param pTileImageCache The cache, or nullptr to use only this provider's
+   * own cache.
+   */
+  void setTileImageCache(
+      const std::shared_ptr<QuadtreeTileImageCache>& pTileImageCache) noexcept;
 
 protected:
+  /**
+   * @brief Creates the tile returned by {@link getTile} for a rectangle that
+   * overlaps this provider's coverage rectangle.
+   *
+   * Derived classes may override this to return an existing tile, such as one
+   * that covers a larger rectangle and is shared by several geometry tiles.
+   * The default implementation creates a new tile for the rectangle.
+   *
+   * @param rectangle The rectangle that the tile must cover.
+   * @param targetScreenPixels The maximum number of pixels on the screen that
+   * the tile is meant to cover.
+   * @return The tile.
+   */
+  virtual CesiumUtility::IntrusivePointer<RasterOverlayTile> createTile(
+      const CesiumGeometry::Rectangle& rectangle,
+      const glm::dvec2& targetScreenPixels);
+
+  /**
+   * @brief Notifies this provider that a tile it created is being destroyed.
+   *
+   * The default implementation does nothing.
+   *
+   * @param tile The tile, which must have no outstanding references.
+   */
+  virtual void destroyTile(const RasterOverlayTile& tile) noexcept;
+
   /**
    * @brief Loads the image for a tile.
    *
@@ -379,6 +487,25 @@ protected:
       const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers = {},
       LoadTileImageFromUrlOptions&& options = {}) const;
 
+  /**
+   * @brief Starts collecting the requests of {@link loadTileImageFromUrl}
+   * into a batch, instead of starting each of them right away.
+   *
+   * This must be called from the main thread, and must be followed by
+   * {@link endRequestBatch} before control returns to the main thread's
+   * caller, so that no request is held back. Until then, {@link
+   * loadTileImageFromUrl} must only be called from the main thread.
+   */
+  void beginRequestBatch() noexcept;
+
+  /**
+   * @brief Starts the requests collected since {@link beginRequestBatch}.
+   *
+   * The requests with the same headers are started together with
+   * {@link CesiumAsync::IAssetAccessor::getBatch}.
+   */
+  void endRequestBatch();
+
 private:
   CesiumAsync::Future<TileProviderAndTile>
   doLoad(RasterOverlayTile& tile, bool isThrottledLoad);
@@ -414,12 +541,27 @@ private:
   CesiumGeometry::Rectangle _coverageRectangle;
   CesiumUtility::IntrusivePointer<RasterOverlayTile> _pPlaceholder;
   int64_t _tileDataBytes;
+  int64_t _tileGpuDataBytes;
   int32_t _totalTilesCurrentlyLoading;
   int32_t _throttledTilesCurrentlyLoading;
+  uint64_t _tileStateVersion;
+  std::shared_ptr<CesiumAsync::TileLoadScheduler> _pTileLoadScheduler;
+  std::shared_ptr<QuadtreeTileImageCache> _pTileImageCache;
+
+  // A request held back while a batch is being collected.
+  struct BatchedRequest {
+    std::string url;
+    std::vector<CesiumAsync::IAssetAccessor::THeader> headers;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+  mutable std::optional<std::vector<BatchedRequest>> _requestBatch;
+
   CESIUM_TRACE_DECLARE_TRACK_SET(
       _loadingSlots,
       "Raster Overlay Tile Loading Slot");
 
   static CesiumGltfReader::GltfReader _gltfReader;
+
+  friend class RasterOverlayTile;
 };
 } // namespace CesiumRasterOverlays
@@ -37,10 +37,12 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayUtilities {
    * to the edges, so the coordinate values will never be less then 0.0 or
    * greater than 1.0.
    *
-   * These texture coordinates are stored in the provided glTF, and a new
-   * primitive attribute named `_CESIUMOVERLAY_n` is added to each primitive,
-   * where `n` starts with the `firstTextureCoordinateID` passed to this
-   * function and increases with each projection.
+   * These texture coordinates are stored in the provided glTF, in one new
+   * buffer per primitive for all of the projections, and a new primitive
+   * attribute named `_CESIUMOVERLAY_n` is added to each primitive, where `n`
+   * starts with the `firstTextureCoordinateID` passed to this function and
+   * increases with each projection. Each vertex is converted to cartographic
+   * coordinates only once, however many projections there are.
    *
    * @param gltf The glTF model.
    * @param modelToEcefTransform The transformation of this glTF to ECEF
@@ -60,6 +62,10 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayUtilities {
    * "TEXCOORD_0".
    * @param firstTextureCoordinateID The texture coordinate ID of the first
    * projection.
+   * @param quantizeTextureCoordinates True if the texture coordinates should be
+   * stored as normalized `UNSIGNED_SHORT` components, at half the size of
+   * `FLOAT` components. This is precise to within 1/65535th of the
+   * `rectangle`.
    * @return The details of the generated texture coordinates.
    */
   static std::optional<RasterOverlayDetails>
@@ -70,7 +76,8 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayUtilities {
       std::vector<CesiumGeospatial::Projection>&& projections,
       bool invertVCoordinate = false,
       const std::string& textureCoordinateAttributeBaseName = "TEXCOORD_",
-      int32_t firstTextureCoordinateID = 0);
+      int32_t firstTextureCoordinateID = 0,
+      bool quantizeTextureCoordinates = false);
 
   /**
    * @brief Computes the desired screen pixels for a raster overlay texture.
@@ -12,6 +12,7 @@
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Uri.h>
+#include <CesiumUtility/UriTemplate.h>
 
 #include <rapidjson/document.h>
 #include <rapidjson/pointer.h>
@@ -140,6 +141,8 @@ public:
           // Keep other placeholders
           return "{" + templateKey + "}";
         });
+
+    this->_compiledUrlTemplate = UriTemplate(this->_urlTemplate);
   }
 
   virtual ~BingMapsTileProvider() {}
@@ -147,8 +150,7 @@ public:
 protected:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage> loadQuadtreeTileImage(
       const CesiumGeometry::QuadtreeTileID& tileID) const override {
-    std::string url = CesiumUtility::Uri::substituteTemplateParameters(
-        this->_urlTemplate,
+    std::string url = this->_compiledUrlTemplate.substitute(
         [this, &tileID](const std::string& key) {
           if (key == "quadkey") {
             return BingMapsTileProvider::tileXYToQuadKey(
@@ -196,6 +198,14 @@ protected:
     return this->loadTileImageFromUrl(url, {}, std::move(options));
   }
 
+  virtual std::string getTileImageCacheKey() const override {
+    std::string key = "bing:" + this->_urlTemplate;
+    for (const std::string& subdomain : this->_subdomains) {
+      key += "|" + subdomain;
+    }
+    return key;
+  }
+
 private:
   static std::string tileXYToQuadKey(uint32_t level, uint32_t x, uint32_t y) {
     std::string quadkey;
@@ -219,6 +229,7 @@ private:
 
   std::vector<CreditAndCoverageAreas> _credits;
   std::string _urlTemplate;
+  CesiumUtility::UriTemplate _compiledUrlTemplate;
   std::vector<std::string> _subdomains;
 };
 
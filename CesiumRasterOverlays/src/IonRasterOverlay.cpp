@@ -33,6 +33,11 @@ IonRasterOverlay::~IonRasterOverlay() {}
 std::unordered_map<std::string, IonRasterOverlay::ExternalAssetEndpoint>
     IonRasterOverlay::endpointCache;
 
+std::unordered_map<
+    std::string,
+    SharedFuture<IonRasterOverlay::ExternalAssetEndpointResult>>
+    IonRasterOverlay::endpointRequests;
+
 Future<RasterOverlay::CreateTileProviderResult>
 IonRasterOverlay::createTileProvider(
     const ExternalAssetEndpoint& endpoint,
@@ -107,12 +112,54 @@ IonRasterOverlay::createTileProvider(
         pOwner);
   }
 
+  SharedFuture<ExternalAssetEndpointResult> endpointFuture = [&]() {
+    auto requestIt = IonRasterOverlay::endpointRequests.find(ionUrl);
+    if (requestIt != IonRasterOverlay::endpointRequests.end()) {
+      return requestIt->second;
+    }
+
+    SharedFuture<ExternalAssetEndpointResult> future =
+        requestEndpoint(asyncSystem, pAssetAccessor, ionUrl).share();
+    if (!future.isReady()) {
+      IonRasterOverlay::endpointRequests.emplace(ionUrl, future);
+    }
+    return future;
+  }();
+
+  return endpointFuture.thenInMainThread(
+      [asyncSystem,
+       pOwner,
+       pAssetAccessor,
+       pCreditSystem,
+       pPrepareRendererResources,
+       this,
+       pLogger](const ExternalAssetEndpointResult& result)
+          -> Future<CreateTileProviderResult> {
+        if (result) {
+          return this->createTileProvider(
+              *result,
+              asyncSystem,
+              pAssetAccessor,
+              pCreditSystem,
+              pPrepareRendererResources,
+              pLogger,
+              pOwner);
+        } else {
+          return asyncSystem.createResolvedFuture<CreateTileProviderResult>(
+              nonstd::make_unexpected(result.error()));
+        }
+      });
+}
+
+/*static*/ Future<IonRasterOverlay::ExternalAssetEndpointResult>
+IonRasterOverlay::requestEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& ionUrl) {
   return pAssetAccessor->get(asyncSystem, ionUrl)
       .thenImmediately(
           [](std::shared_ptr<IAssetRequest>&& pRequest)
-              -> nonstd::expected<
-                  ExternalAssetEndpoint,
-                  RasterOverlayLoadFailureDetails> {
+              -> ExternalAssetEndpointResult {
             const IAssetResponse* pResponse = pRequest->response();
 
             rapidjson::Document response;
@@ -202,32 +249,12 @@ IonRasterOverlay::createTileProvider(
 
             return endpoint;
           })
-      .thenInMainThread(
-          [asyncSystem,
-           pOwner,
-           pAssetAccessor,
-           pCreditSystem,
-           pPrepareRendererResources,
-           ionUrl,
-           this,
-           pLogger](nonstd::expected<
-                    ExternalAssetEndpoint,
-                    RasterOverlayLoadFailureDetails>&& result)
-              -> Future<CreateTileProviderResult> {
-            if (result) {
-              IonRasterOverlay::endpointCache[ionUrl] = *result;
-              return this->createTileProvider(
-                  *result,
-                  asyncSystem,
-                  pAssetAccessor,
-                  pCreditSystem,
-                  pPrepareRendererResources,
-                  pLogger,
-                  pOwner);
-            } else {
-              return asyncSystem.createResolvedFuture<CreateTileProviderResult>(
-                  nonstd::make_unexpected(std::move(result).error()));
-            }
-          });
+      .thenInMainThread([ionUrl](ExternalAssetEndpointResult&& result) {
+        IonRasterOverlay::endpointRequests.erase(ionUrl);
+        if (result) {
+          IonRasterOverlay::endpointCache[ionUrl] = *result;
+        }
+        return std::move(result);
+      });
 }
 } // namespace CesiumRasterOverlays
@@ -1,11 +1,15 @@
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumGltfContent/ImageManipulation.h>
 #include <CesiumRasterOverlays/QuadtreeRasterOverlayTileProvider.h>
+#include <CesiumRasterOverlays/QuadtreeTileImageCache.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/SpanHelper.h>
 
+#include <array>
+#include <string>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -20,6 +24,32 @@ namespace {
 // much" into the next pixel, we'll ignore the extra.
 constexpr double pixelTolerance = 0.01;
 
+// The number of rectangles whose levels are remembered when levelHysteresis is
+// enabled, beyond which the ones without a live tile are forgotten.
+constexpr size_t maximumRectangleLevels = 65536;
+
+std::array<double, 4> toRectangleKey(const Rectangle& rectangle) {
+  return {
+      rectangle.minimumX,
+      rectangle.minimumY,
+      rectangle.maximumX,
+      rectangle.maximumY};
+}
+
+std::string describeTiling(
+    const QuadtreeTilingScheme& tilingScheme,
+    uint32_t minimumLevel,
+    uint32_t maximumLevel) {
+  const Rectangle& rectangle = tilingScheme.getRectangle();
+  return "|" + std::to_string(rectangle.minimumX) + "," +
+         std::to_string(rectangle.minimumY) + "," +
+         std::to_string(rectangle.maximumX) + "," +
+         std::to_string(rectangle.maximumY) + "|" +
+         std::to_string(tilingScheme.getRootTilesX()) + "x" +
+         std::to_string(tilingScheme.getRootTilesY()) + "|" +
+         std::to_string(minimumLevel) + "-" + std::to_string(maximumLevel);
+}
+
 } // namespace
 
 namespace CesiumRasterOverlays {
@@ -57,6 +87,10 @@ QuadtreeRasterOverlayTileProvider::QuadtreeRasterOverlayTileProvider(
       _tileLookup(),
       _cachedBytes(0) {}
 
+std::string QuadtreeRasterOverlayTileProvider::getTileImageCacheKey() const {
+  return std::string();
+}
+
 uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
     const CesiumGeometry::Rectangle& rectangle,
     const glm::dvec2& screenPixels) {
@@ -79,9 +113,39 @@ uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
   const glm::dvec2 twoToTheLevelPower =
       totalTileDimensions / targetTileDimensions;
   const glm::dvec2 level = glm::log2(twoToTheLevelPower);
-  const glm::dvec2 rounded = glm::max(glm::round(level), 0.0);
+  const double idealLevel = glm::max(glm::max(level.x, level.y), 0.0);
+
+  uint32_t imageryLevel = uint32_t(glm::round(idealLevel));
+
+  // Keep the level chosen before for the same rectangle, unless the ideal
+  // level has moved far enough from it, so that the rectangle doesn't switch
+  // back and forth between two levels.
+  const double hysteresis = this->getOwner().getOptions().levelHysteresis;
+  if (hysteresis > 0.0) {
+    if (this->_rectangleLevels.size() >= maximumRectangleLevels) {
+      // Forget the levels of the rectangles without a live tile, which are
+      // the least likely to be needed again.
+      for (auto it = this->_rectangleLevels.begin();
+           it != this->_rectangleLevels.end();) {
+        if (it->second.pCombinedTile) {
+          ++it;
+        } else {
+          it = this->_rectangleLevels.erase(it);
+        }
+      }
+    }
 
-  uint32_t imageryLevel = uint32_t(glm::max(rounded.x, rounded.y));
+    auto [it, added] = this->_rectangleLevels.try_emplace(
+        toRectangleKey(rectangle),
+        RectangleLevel{imageryLevel, nullptr, 0});
+    if (!added) {
+      if (glm::abs(idealLevel - double(it->second.level)) <= 0.5 + hysteresis) {
+        imageryLevel = it->second.level;
+      } else {
+        it->second.level = imageryLevel;
+      }
+    }
+  }
 
   const uint32_t maximumLevel = this->getMaximumLevel();
   if (imageryLevel > maximumLevel) {
@@ -96,12 +160,11 @@ uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
   return imageryLevel;
 }
 
-std::vector<CesiumAsync::SharedFuture<
-    QuadtreeRasterOverlayTileProvider::LoadedQuadtreeImage>>
-QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
+std::vector<CesiumGeometry::QuadtreeTileID>
+QuadtreeRasterOverlayTileProvider::mapRasterTileIDsToGeometryTile(
     const CesiumGeometry::Rectangle& geometryRectangle,
     const glm::dvec2 targetScreenPixels) {
-  std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> result;
+  std::vector<QuadtreeTileID> result;
 
   const QuadtreeTilingScheme& imageryTilingScheme = this->getTilingScheme();
 
@@ -271,15 +334,124 @@ QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
         continue;
       }
 
-      CesiumAsync::SharedFuture<LoadedQuadtreeImage> pTile =
-          this->getQuadtreeTile(QuadtreeTileID(level, i, j));
-      result.emplace_back(std::move(pTile));
+      result.emplace_back(level, i, j);
     }
   }
 
   return result;
 }
 
+std::vector<CesiumAsync::SharedFuture<
+    QuadtreeRasterOverlayTileProvider::LoadedQuadtreeImage>>
+QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
+    const CesiumGeometry::Rectangle& geometryRectangle,
+    const glm::dvec2 targetScreenPixels) {
+  const std::vector<QuadtreeTileID> tileIDs =
+      this->mapRasterTileIDsToGeometryTile(
+          geometryRectangle,
+          targetScreenPixels);
+
+  // Request the images that aren't cached yet together, so that the asset
+  // accessor can send them at once.
+  std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> result;
+  result.reserve(tileIDs.size());
+  this->beginRequestBatch();
+  for (const QuadtreeTileID& tileID : tileIDs) {
+    result.emplace_back(this->getQuadtreeTile(tileID));
+  }
+  this->endRequestBatch();
+
+  return result;
+}
+
+IntrusivePointer<RasterOverlayTile>
+QuadtreeRasterOverlayTileProvider::createTile(
+    const CesiumGeometry::Rectangle& rectangle,
+    const glm::dvec2& targetScreenPixels) {
+  if (!this->getOwner().getOptions().shareQuadtreeTiles) {
+    return this->createCombinedTile(rectangle, targetScreenPixels);
+  }
+
+  const std::vector<QuadtreeTileID> tileIDs =
+      this->mapRasterTileIDsToGeometryTile(rectangle, targetScreenPixels);
+  if (tileIDs.size() != 1) {
+    // Several quadtree tiles need to be combined into one image for this
+    // rectangle.
+    return this->createCombinedTile(rectangle, targetScreenPixels);
+  }
+
+  const QuadtreeTileID& tileID = tileIDs.front();
+  auto it = this->_sharedTiles.find(tileID);
+  if (it != this->_sharedTiles.end()) {
+    return it->second;
+  }
+
+  // The tile covers the whole quadtree tile, so that every geometry tile
+  // within it can use the same image, with its own translation and scale.
+  IntrusivePointer<RasterOverlayTile> pTile =
+      RasterOverlayTileProvider::createTile(
+          this->getTilingScheme().tileToRectangle(tileID),
+          targetScreenPixels);
+  this->_sharedTiles.emplace(tileID, pTile.get());
+  this->_sharedTileIDs.emplace(pTile.get(), tileID);
+  return pTile;
+}
+
+IntrusivePointer<RasterOverlayTile>
+QuadtreeRasterOverlayTileProvider::createCombinedTile(
+    const CesiumGeometry::Rectangle& rectangle,
+    const glm::dvec2& targetScreenPixels) {
+  if (this->getOwner().getOptions().levelHysteresis <= 0.0) {
+    return RasterOverlayTileProvider::createTile(rectangle, targetScreenPixels);
+  }
+
+  // This also records the level for the rectangle, if it's not recorded yet.
+  const uint32_t level =
+      this->computeLevelFromTargetScreenPixels(rectangle, targetScreenPixels);
+  RectangleLevel& rectangleLevel =
+      this->_rectangleLevels[toRectangleKey(rectangle)];
+
+  RasterOverlayTile* pExisting = rectangleLevel.pCombinedTile;
+  if (pExisting &&
+      pExisting->getState() != RasterOverlayTile::LoadState::Failed &&
+      glm::max(level, rectangleLevel.combinedLevel) -
+              glm::min(level, rectangleLevel.combinedLevel) <=
+          1U) {
+    return pExisting;
+  }
+
+  IntrusivePointer<RasterOverlayTile> pTile =
+      RasterOverlayTileProvider::createTile(rectangle, targetScreenPixels);
+  if (pExisting) {
+    this->_combinedTileRectangles.erase(pExisting);
+  }
+  rectangleLevel.pCombinedTile = pTile.get();
+  rectangleLevel.combinedLevel = level;
+  this->_combinedTileRectangles.emplace(
+      pTile.get(),
+      toRectangleKey(rectangle));
+  return pTile;
+}
+
+void QuadtreeRasterOverlayTileProvider::destroyTile(
+    const RasterOverlayTile& tile) noexcept {
+  auto it = this->_sharedTileIDs.find(&tile);
+  if (it != this->_sharedTileIDs.end()) {
+    this->_sharedTiles.erase(it->second);
+    this->_sharedTileIDs.erase(it);
+  }
+
+  auto combinedIt = this->_combinedTileRectangles.find(&tile);
+  if (combinedIt != this->_combinedTileRectangles.end()) {
+    auto levelIt = this->_rectangleLevels.find(combinedIt->second);
+    if (levelIt != this->_rectangleLevels.end() &&
+        levelIt->second.pCombinedTile == &tile) {
+      levelIt->second.pCombinedTile = nullptr;
+    }
+    this->_combinedTileRectangles.erase(combinedIt);
+  }
+}
+
 CesiumAsync::SharedFuture<
     QuadtreeRasterOverlayTileProvider::LoadedQuadtreeImage>
 QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
@@ -314,20 +486,53 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
         });
   };
 
+  auto loadImage = [tileID, this]() {
+    return this->loadQuadtreeTileImage(tileID)
+        .catchImmediately([](std::exception&& e) {
+          // Turn an exception into an error.
+          LoadedRasterOverlayImage result;
+          result.errors.emplace_back(e.what());
+          return result;
+        })
+        .thenImmediately([](LoadedRasterOverlayImage&& loaded) {
+          return std::make_shared<LoadedRasterOverlayImage>(std::move(loaded));
+        });
+  };
+
+  // Share the image with other providers that load it from the same source,
+  // if there's a cache for that.
+  const std::shared_ptr<QuadtreeTileImageCache>& pImageCache =
+      this->getTileImageCache();
+  std::string imageCacheKey =
+      pImageCache ? this->getTileImageCacheKey() : std::string();
+  const bool sharedImage = !imageCacheKey.empty();
+  if (sharedImage) {
+    // The rectangle and moreDetailAvailable of the loaded images also depend on
+    // the tiling scheme and levels.
+    imageCacheKey += describeTiling(
+        this->getTilingScheme(),
+        this->getMinimumLevel(),
+        this->getMaximumLevel());
+  }
+
+  Future<std::shared_ptr<LoadedRasterOverlayImage>> imageFuture =
+      sharedImage
+          ? pImageCache->getImage(imageCacheKey, tileID, loadImage)
+                .thenImmediately(
+                    [](const std::shared_ptr<LoadedRasterOverlayImage>&
+                           pLoaded) { return pLoaded; })
+          : loadImage();
+
   Future<LoadedQuadtreeImage> future =
-      this->loadQuadtreeTileImage(tileID)
-          .catchImmediately([](std::exception&& e) {
-            // Turn an exception into an error.
-            LoadedRasterOverlayImage result;
-            result.errors.emplace_back(e.what());
-            return result;
-          })
+      std::move(imageFuture)
           .thenImmediately([&cachedBytes = this->_cachedBytes,
                             currentLevel = tileID.level,
                             minimumLevel = this->getMinimumLevel(),
                             asyncSystem = this->getAsyncSystem(),
                             loadParentTile = std::move(loadParentTile)](
-                               LoadedRasterOverlayImage&& loaded) {
+                               std::shared_ptr<LoadedRasterOverlayImage>&&
+                                   pLoaded) {
+            const LoadedRasterOverlayImage& loaded = *pLoaded;
             if (loaded.image && loaded.errors.empty() &&
                 loaded.image->width > 0 && loaded.image->height > 0) {
               // Successfully loaded, continue.
@@ -337,7 +542,7 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
               // Highlight the edges in red to show tile boundaries.
               gsl::span<uint32_t> pixels =
                   reintepretCastSpan<uint32_t, std::byte>(
-                      loaded.image->pixelData);
+                      pLoaded->image->pixelData);
               for (int32_t j = 0; j < loaded.image->height; ++j) {
                 for (int32_t i = 0; i < loaded.image->width; ++i) {
                   if (i == 0 || j == 0 || i == loaded.image->width - 1 ||
@@ -348,9 +553,8 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
               }
 #endif
 
-              return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
-                  std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+              return asyncSystem.createResolvedFuture(
+                  LoadedQuadtreeImage{std::move(pLoaded), std::nullopt});
             }
 
             // Tile failed to load, try loading the parent tile instead.
@@ -360,15 +564,14 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
               return asyncSystem.runInMainThread(loadParentTile);
             } else {
               // No parent available, so return the original failed result.
-              return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
-                  std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+              return asyncSystem.createResolvedFuture(
+                  LoadedQuadtreeImage{std::move(pLoaded), std::nullopt});
             }
           });
 
   auto newIt = this->_tilesOldToRecent.emplace(
       this->_tilesOldToRecent.end(),
-      CacheEntry{tileID, std::move(future).share()});
+      CacheEntry{tileID, std::move(future).share(), sharedImage});
   this->_tileLookup[tileID] = newIt;
 
   SharedFuture<LoadedQuadtreeImage> result = newIt->future;
@@ -443,6 +646,27 @@ void blitImage(
 CesiumAsync::Future<LoadedRasterOverlayImage>
 QuadtreeRasterOverlayTileProvider::loadTileImage(
     RasterOverlayTile& overlayTile) {
+  auto sharedIt = this->_sharedTileIDs.find(&overlayTile);
+  if (sharedIt != this->_sharedTileIDs.end()) {
+    // A shared tile is exactly one quadtree tile, so its image can be used
+    // as-is unless it's a part of an ancestor's image.
+    return this->getQuadtreeTile(sharedIt->second)
+        .thenImmediately([](const LoadedQuadtreeImage& image) {
+          if (image.subset || !image.pLoaded->image) {
+            // Signal that the parent tile should be used instead.
+            return LoadedRasterOverlayImage{
+                ImageCesium(),
+                Rectangle(),
+                {},
+                {},
+                {},
+                false};
+          }
+
+          return *image.pLoaded;
+        });
+  }
+
   // Figure out which quadtree level we need, and which tiles from that level.
   // Load each needed tile (or pull it from cache).
   std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> tiles =
@@ -488,7 +712,9 @@ QuadtreeRasterOverlayTileProvider::loadTileImage(
 }
 
 void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
-  CESIUM_TRACE("QuadtreeRasterOverlayTileProvider::unloadCachedTiles");
+  CESIUM_TRACE_CATEGORY(
+      Raster,
+      "QuadtreeRasterOverlayTileProvider::unloadCachedTiles");
 
   const int64_t maxCacheBytes = this->getOwner().getOptions().subTileCacheBytes;
   if (this->_cachedBytes <= maxCacheBytes) {
@@ -511,12 +737,18 @@ void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
 
     std::shared_ptr<LoadedRasterOverlayImage> pImage = image.pLoaded;
 
+    const bool isOwnImage = !image.subset;
+    const bool sharedImage = it->sharedImage;
+
     this->_tileLookup.erase(it->tileID);
     it = this->_tilesOldToRecent.erase(it);
 
     // If this is the last use of this data, it will be freed when the shared
-    // pointer goes out of scope, so reduce the cachedBytes accordingly.
-    if (pImage.use_count() == 1) {
+    // pointer goes out of scope, so reduce the cachedBytes accordingly. An
+    // image shared with other providers is also referenced by their cache, so
+    // it stops counting against this provider's cache with the entry of its
+    // own tile, rather than an entry of a descendant that fell back to it.
+    if (sharedImage ? isOwnImage : pImage.use_count() == 1) {
       if (pImage->image) {
         this->_cachedBytes -= int64_t(pImage->image->pixelData.size());
         assert(this->_cachedBytes >= 0);
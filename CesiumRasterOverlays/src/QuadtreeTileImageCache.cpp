@@ -0,0 +1,96 @@
+#include <CesiumRasterOverlays/QuadtreeTileImageCache.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <cassert>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+
+namespace CesiumRasterOverlays {
+
+QuadtreeTileImageCache::QuadtreeTileImageCache(int64_t maximumBytes) noexcept
+    : _imagesOldToRecent(),
+      _imageLookup(),
+      _maximumBytes(maximumBytes),
+      _pCachedBytes(std::make_shared<std::atomic<int64_t>>(0)) {}
+
+SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>>
+QuadtreeTileImageCache::getImage(
+    const std::string& sourceKey,
+    const QuadtreeTileID& tileID,
+    const std::function<Future<std::shared_ptr<LoadedRasterOverlayImage>>()>&
+        load) {
+  Key key{sourceKey, tileID};
+
+  auto lookupIt = this->_imageLookup.find(key);
+  if (lookupIt != this->_imageLookup.end()) {
+    auto& cacheIt = lookupIt->second;
+
+    // Move this entry to the end, indicating it's most recently used.
+    this->_imagesOldToRecent.splice(
+        this->_imagesOldToRecent.end(),
+        this->_imagesOldToRecent,
+        cacheIt);
+
+    return cacheIt->future;
+  }
+
+  Future<std::shared_ptr<LoadedRasterOverlayImage>> future =
+      load().thenImmediately(
+          [pCachedBytes = this->_pCachedBytes](
+              std::shared_ptr<LoadedRasterOverlayImage>&& pLoaded) {
+            if (pLoaded && pLoaded->image) {
+              *pCachedBytes += int64_t(pLoaded->image->pixelData.size());
+            }
+            return std::move(pLoaded);
+          });
+
+  auto newIt = this->_imagesOldToRecent.emplace(
+      this->_imagesOldToRecent.end(),
+      CacheEntry{key, std::move(future).share()});
+  this->_imageLookup.emplace(std::move(key), newIt);
+
+  SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>> result =
+      newIt->future;
+
+  this->unloadCachedImages();
+
+  return result;
+}
+
+void QuadtreeTileImageCache::unloadCachedImages() noexcept {
+  CESIUM_TRACE_CATEGORY(Raster, "QuadtreeTileImageCache::unloadCachedImages");
+
+  auto it = this->_imagesOldToRecent.begin();
+
+  while (it != this->_imagesOldToRecent.end() &&
+         *this->_pCachedBytes > this->_maximumBytes) {
+    if (!it->future.isReady()) {
+      // Don't unload images that are still loading.
+      ++it;
+      continue;
+    }
+
+    // Guaranteed not to block because isReady returned true. The image may
+    // still be used by tile providers, but it's no longer counted here.
+    const std::shared_ptr<LoadedRasterOverlayImage>& pLoaded =
+        it->future.wait();
+    if (pLoaded && pLoaded->image) {
+      *this->_pCachedBytes -= int64_t(pLoaded->image->pixelData.size());
+      assert(*this->_pCachedBytes >= 0);
+    }
+
+    this->_imageLookup.erase(it->key);
+    it = this->_imagesOldToRecent.erase(it);
+  }
+}
+
+size_t QuadtreeTileImageCache::KeyHash::operator()(
+    const Key& key) const noexcept {
+  const size_t sourceHash = std::hash<std::string>{}(key.sourceKey);
+  const size_t tileHash = std::hash<QuadtreeTileID>{}(key.tileID);
+  return sourceHash ^ (tileHash + 0x9e3779b9 + (sourceHash << 6) +
+                       (sourceHash >> 2));
+}
+
+} // namespace CesiumRasterOverlays
@@ -19,7 +19,8 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Placeholder),
       _image(),
       _pRendererResources(nullptr),
-      _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
+      _moreDetailAvailable(MoreDetailAvailable::Unknown),
+      _gpuByteSize(0) {}
 
 RasterOverlayTile::RasterOverlayTile(
     RasterOverlayTileProvider& tileProvider,
@@ -32,7 +33,8 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Unloaded),
       _image(),
       _pRendererResources(nullptr),
-      _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
+      _moreDetailAvailable(MoreDetailAvailable::Unknown),
+      _gpuByteSize(0) {}
 
 RasterOverlayTile::~RasterOverlayTile() {
   RasterOverlayTileProvider& tileProvider = *this->_pTileProvider;
@@ -77,16 +79,26 @@ void RasterOverlayTile::loadInMainThread() {
 
   // Do the final main thread raster loading
   RasterOverlayTileProvider& tileProvider = *this->_pTileProvider;
+  const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+      pPrepareRendererResources = tileProvider.getPrepareRendererResources();
   this->_pRendererResources =
-      tileProvider.getPrepareRendererResources()->prepareRasterInMainThread(
+      pPrepareRendererResources->prepareRasterInMainThread(
           *this,
           this->_pRendererResources);
 
+  this->_gpuByteSize = pPrepareRendererResources->getRasterGpuByteSize(
+      *this,
+      this->_pRendererResources);
+  tileProvider._tileGpuDataBytes += this->_gpuByteSize;
+
   this->setState(LoadState::Done);
 }
 
 void RasterOverlayTile::setState(LoadState newState) noexcept {
-  this->_state = newState;
+  if (this->_state != newState) {
+    this->_state = newState;
+    ++this->_pTileProvider->_tileStateVersion;
+  }
 }
 
 } // namespace CesiumRasterOverlays
@@ -1,4 +1,8 @@
+#include <CesiumAsync/AssetRequestOptions.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumGltfContent/ImageManipulation.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
@@ -9,6 +13,12 @@
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <optional>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -36,8 +46,13 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
                              computeMaximumProjectedRectangle()),
       _pPlaceholder(),
       _tileDataBytes(0),
+      _tileGpuDataBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {
+      _throttledTilesCurrentlyLoading(0),
+      _tileStateVersion(0),
+      _pTileLoadScheduler(nullptr),
+      _pTileImageCache(nullptr),
+      _requestBatch(std::nullopt) {
   this->_pPlaceholder = new RasterOverlayTile(*this);
 }
 
@@ -61,8 +76,13 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
       _coverageRectangle(coverageRectangle),
       _pPlaceholder(nullptr),
       _tileDataBytes(0),
+      _tileGpuDataBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {}
+      _throttledTilesCurrentlyLoading(0),
+      _tileStateVersion(0),
+      _pTileLoadScheduler(nullptr),
+      _pTileImageCache(nullptr),
+      _requestBatch(std::nullopt) {}
 
 RasterOverlayTileProvider::~RasterOverlayTileProvider() noexcept {
   // Explicitly release the placeholder first, because RasterOverlayTiles must
@@ -85,15 +105,28 @@ RasterOverlayTileProvider::getTile(
     return nullptr;
   }
 
-  return new RasterOverlayTile(*this, targetScreenPixels, rectangle);
+  return this->createTile(rectangle, targetScreenPixels);
 }
 
 void RasterOverlayTileProvider::removeTile(RasterOverlayTile* pTile) noexcept {
   assert(pTile->getReferenceCount() == 0);
 
+  this->destroyTile(*pTile);
+
   this->_tileDataBytes -= pTile->getImage().sizeBytes;
+  this->_tileGpuDataBytes -= pTile->getGpuByteSize();
+}
+
+CesiumUtility::IntrusivePointer<RasterOverlayTile>
+RasterOverlayTileProvider::createTile(
+    const CesiumGeometry::Rectangle& rectangle,
+    const glm::dvec2& targetScreenPixels) {
+  return new RasterOverlayTile(*this, targetScreenPixels, rectangle);
 }
 
+void RasterOverlayTileProvider::destroyTile(
+    const RasterOverlayTile& /* tile */) noexcept {}
+
 CesiumAsync::Future<TileProviderAndTile>
 RasterOverlayTileProvider::loadTile(RasterOverlayTile& tile) {
   if (this->_pPlaceholder) {
@@ -105,34 +138,161 @@ RasterOverlayTileProvider::loadTile(RasterOverlayTile& tile) {
   return this->doLoad(tile, false);
 }
 
-bool RasterOverlayTileProvider::loadTileThrottled(RasterOverlayTile& tile) {
+bool RasterOverlayTileProvider::loadTileThrottled(
+    RasterOverlayTile& tile,
+    TileLoadScheduler::Priority priority) {
   if (tile.getState() != RasterOverlayTile::LoadState::Unloaded) {
     return true;
   }
 
+  // Like the TileLoadScheduler, lower priorities leave some of this
+  // provider's load slots free for higher priorities, so that urgent tiles
+  // don't wait for preloads to finish.
+  const int32_t maximumLoads =
+      this->getOwner().getOptions().maximumSimultaneousTileLoads;
+  const int32_t reservedLoads =
+      (maximumLoads / 4) *
+      (int32_t(TileLoadScheduler::Priority::Urgent) - int32_t(priority));
   if (this->_throttledTilesCurrentlyLoading >=
-      this->getOwner().getOptions().maximumSimultaneousTileLoads) {
+      std::max(maximumLoads - reservedLoads, 1)) {
     return false;
   }
 
+  if (this->_pTileLoadScheduler &&
+      !this->_pTileLoadScheduler->canStartLoad(priority)) {
+    return false;
+  }
+
+  // The worker thread work for this load runs ahead of the work for lower
+  // priorities. The priorities have the same values as the task priorities.
+  ScopedTaskPriority priorityScope(static_cast<TaskPriority>(priority));
   this->doLoad(tile, true);
   return true;
 }
 
-CesiumAsync::Future<LoadedRasterOverlayImage>
-RasterOverlayTileProvider::loadTileImageFromUrl(
+namespace {
+// Raster overlay tiles don't have an order within their priority, so their
+// requests only carry the urgency of the task that makes them, which
+// loadTileThrottled sets.
+AssetRequestOptions createRequestOptions() {
+  AssetRequestOptions options;
+  options.pPriority =
+      std::make_shared<AssetRequestPriority>(getCurrentTaskPriority());
+  return options;
+}
+
+// The decoded image cache, and the key and lifetime of an image in it.
+struct DecodedImageCacheEntry {
+  std::shared_ptr<ICacheDatabase> pCache;
+  std::string key;
+  int64_t lifetimeSeconds;
+};
+
+// Identifies the encoding of a cached decoded image, so that images cached
+// with a different layout are never misread.
+constexpr uint32_t decodedImageMagic = 0x31494443; // "CDI1"
+
+std::string getDecodedImageCacheKey(
     const std::string& url,
-    const std::vector<IAssetAccessor::THeader>& headers,
-    LoadTileImageFromUrlOptions&& options) const {
+    const Ktx2TranscodeTargets& targets) {
+  const GpuCompressedPixelFormat formats[] = {
+      targets.ETC1S_R,
+      targets.ETC1S_RG,
+      targets.ETC1S_RGB,
+      targets.ETC1S_RGBA,
+      targets.UASTC_R,
+      targets.UASTC_RG,
+      targets.UASTC_RGB,
+      targets.UASTC_RGBA,
+      targets.ETC1S_NormalMap,
+      targets.UASTC_NormalMap};
+
+  std::string key = "decoded-image:";
+  for (GpuCompressedPixelFormat format : formats) {
+    key += std::to_string(int32_t(format)) + ",";
+  }
+  return key + url;
+}
+
+template <typename T> void appendValue(std::vector<std::byte>& data, T value) {
+  const size_t offset = data.size();
+  data.resize(offset + sizeof(T));
+  std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue(const std::vector<std::byte>& data, size_t& offset, T& value) {
+  if (data.size() < offset + sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+std::vector<std::byte> writeDecodedImage(const ImageCesium& image) {
+  std::vector<std::byte> data;
+  data.reserve(32 + 16 * image.mipPositions.size() + image.pixelData.size());
+  appendValue(data, decodedImageMagic);
+  appendValue(data, image.width);
+  appendValue(data, image.height);
+  appendValue(data, image.channels);
+  appendValue(data, image.bytesPerChannel);
+  appendValue(data, int32_t(image.compressedPixelFormat));
+  appendValue(data, uint64_t(image.mipPositions.size()));
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    appendValue(data, uint64_t(mip.byteOffset));
+    appendValue(data, uint64_t(mip.byteSize));
+  }
+  data.insert(data.end(), image.pixelData.begin(), image.pixelData.end());
+  return data;
+}
+
+std::optional<ImageCesium>
+readDecodedImage(const std::vector<std::byte>& data) {
+  ImageCesium image;
+  size_t offset = 0;
+  uint32_t magic = 0;
+  int32_t compressedPixelFormat = 0;
+  uint64_t mipCount = 0;
+  if (!readValue(data, offset, magic) || magic != decodedImageMagic ||
+      !readValue(data, offset, image.width) ||
+      !readValue(data, offset, image.height) ||
+      !readValue(data, offset, image.channels) ||
+      !readValue(data, offset, image.bytesPerChannel) ||
+      !readValue(data, offset, compressedPixelFormat) ||
+      !readValue(data, offset, mipCount) ||
+      mipCount > (data.size() - offset) / 16) {
+    return std::nullopt;
+  }
+
+  image.compressedPixelFormat = GpuCompressedPixelFormat(compressedPixelFormat);
+  image.mipPositions.resize(size_t(mipCount));
+  for (ImageCesiumMipPosition& mip : image.mipPositions) {
+    uint64_t byteOffset = 0;
+    uint64_t byteSize = 0;
+    readValue(data, offset, byteOffset);
+    readValue(data, offset, byteSize);
+    mip.byteOffset = size_t(byteOffset);
+    mip.byteSize = size_t(byteSize);
+  }
 
-  return this->getAssetAccessor()
-      ->get(this->getAsyncSystem(), url, headers)
+  image.pixelData.assign(data.begin() + std::ptrdiff_t(offset), data.end());
+  return image;
+}
+
+CesiumAsync::Future<LoadedRasterOverlayImage> decodeTileImage(
+    Future<std::shared_ptr<IAssetRequest>>&& request,
+    LoadTileImageFromUrlOptions&& options,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    std::optional<DecodedImageCacheEntry>&& decodedImageCacheEntry) {
+  return std::move(request)
       .thenInWorkerThread(
           [options = std::move(options),
-           Ktx2TranscodeTargets =
-               this->getOwner().getOptions().ktx2TranscodeTargets](
+           ktx2TranscodeTargets,
+           decodedImageCacheEntry = std::move(decodedImageCacheEntry)](
               std::shared_ptr<IAssetRequest>&& pRequest) mutable {
-            CESIUM_TRACE("load image");
+            CESIUM_TRACE_CATEGORY(Raster, "load image");
             const IAssetResponse* pResponse = pRequest->response();
             if (pResponse == nullptr) {
               return LoadedRasterOverlayImage{
@@ -181,9 +341,7 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
             const gsl::span<const std::byte> data = pResponse->data();
 
             CesiumGltfReader::ImageReaderResult loadedImage =
-                RasterOverlayTileProvider::_gltfReader.readImage(
-                    data,
-                    Ktx2TranscodeTargets);
+                GltfReader::readImage(data, ktx2TranscodeTargets);
 
             if (!loadedImage.errors.empty()) {
               loadedImage.errors.push_back("Image url: " + pRequest->url());
@@ -192,6 +350,23 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
               loadedImage.warnings.push_back("Image url: " + pRequest->url());
             }
 
+            if (decodedImageCacheEntry && loadedImage.image &&
+                loadedImage.errors.empty()) {
+              CESIUM_TRACE_CATEGORY(Raster, "store decoded image");
+              const std::vector<std::byte> decoded =
+                  writeDecodedImage(*loadedImage.image);
+              decodedImageCacheEntry->pCache->storeEntry(
+                  decodedImageCacheEntry->key,
+                  std::time(nullptr) +
+                      std::time_t(decodedImageCacheEntry->lifetimeSeconds),
+                  pRequest->url(),
+                  pRequest->method(),
+                  HttpHeaders(),
+                  200,
+                  HttpHeaders(),
+                  decoded);
+            }
+
             return LoadedRasterOverlayImage{
                 loadedImage.image,
                 options.rectangle,
@@ -201,6 +376,128 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
                 options.moreDetailAvailable};
           });
 }
+} // namespace
+
+CesiumAsync::Future<LoadedRasterOverlayImage>
+RasterOverlayTileProvider::loadTileImageFromUrl(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    LoadTileImageFromUrlOptions&& options) const {
+  const RasterOverlayOptions& overlayOptions = this->getOwner().getOptions();
+  if (!overlayOptions.pDecodedImageCache) {
+    Future<std::shared_ptr<IAssetRequest>> request =
+        this->_requestBatch
+            ? this->_requestBatch
+                  ->emplace_back(BatchedRequest{
+                      url,
+                      headers,
+                      this->getAsyncSystem()
+                          .createPromise<std::shared_ptr<IAssetRequest>>()})
+                  .promise.getFuture()
+            : this->getAssetAccessor()->getWithOptions(
+                  this->getAsyncSystem(),
+                  url,
+                  headers,
+                  createRequestOptions());
+    return decodeTileImage(
+        std::move(request),
+        std::move(options),
+        overlayOptions.ktx2TranscodeTargets,
+        std::nullopt);
+  }
+
+  DecodedImageCacheEntry decodedImageCacheEntry{
+      overlayOptions.pDecodedImageCache,
+      getDecodedImageCacheKey(url, overlayOptions.ktx2TranscodeTargets),
+      overlayOptions.decodedImageCacheSeconds};
+
+  // Look up the decoded image first, and only request and decode it if it's
+  // not in the cache.
+  return this->getAsyncSystem().runInWorkerThread(
+      [asyncSystem = this->getAsyncSystem(),
+       pAssetAccessor = this->getAssetAccessor(),
+       url,
+       headers,
+       options = std::move(options),
+       ktx2TranscodeTargets = overlayOptions.ktx2TranscodeTargets,
+       decodedImageCacheEntry = std::move(decodedImageCacheEntry)]() mutable {
+        std::optional<CacheItem> cacheItem =
+            decodedImageCacheEntry.pCache->getEntry(decodedImageCacheEntry.key);
+        if (cacheItem &&
+            std::difftime(cacheItem->expiryTime, std::time(nullptr)) > 0.0) {
+          CESIUM_TRACE_CATEGORY(Raster, "read decoded image");
+          std::optional<ImageCesium> image =
+              readDecodedImage(cacheItem->cacheResponse.data);
+          if (image) {
+            return asyncSystem.createResolvedFuture(LoadedRasterOverlayImage{
+                std::move(image),
+                options.rectangle,
+                std::move(options.credits),
+                {},
+                {},
+                options.moreDetailAvailable});
+          }
+        }
+
+        return decodeTileImage(
+            pAssetAccessor->getWithOptions(
+                asyncSystem,
+                url,
+                headers,
+                createRequestOptions()),
+            std::move(options),
+            ktx2TranscodeTargets,
+            std::move(decodedImageCacheEntry));
+      });
+}
+
+void RasterOverlayTileProvider::beginRequestBatch() noexcept {
+  assert(!this->_requestBatch);
+  this->_requestBatch.emplace();
+}
+
+void RasterOverlayTileProvider::endRequestBatch() {
+  assert(this->_requestBatch);
+  std::vector<BatchedRequest> requests = std::move(*this->_requestBatch);
+  this->_requestBatch.reset();
+
+  std::vector<bool> started(requests.size(), false);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (started[i]) {
+      continue;
+    }
+
+    // Start the requests that have the same headers as this one together.
+    std::vector<size_t> batch;
+    std::vector<std::string> urls;
+    for (size_t j = i; j < requests.size(); ++j) {
+      if (!started[j] && requests[j].headers == requests[i].headers) {
+        started[j] = true;
+        batch.emplace_back(j);
+        urls.emplace_back(requests[j].url);
+      }
+    }
+
+    std::vector<Future<std::shared_ptr<IAssetRequest>>> futures =
+        this->getAssetAccessor()->getBatch(
+            this->getAsyncSystem(),
+            urls,
+            requests[i].headers);
+    assert(futures.size() == batch.size());
+    for (size_t k = 0; k < futures.size(); ++k) {
+      const Promise<std::shared_ptr<IAssetRequest>>& promise =
+          requests[batch[k]].promise;
+      std::move(futures[k])
+          .thenImmediately(
+              [promise](std::shared_ptr<IAssetRequest>&& pRequest) {
+                promise.resolve(std::move(pRequest));
+              })
+          .catchImmediately([promise](std::exception&& e) {
+            promise.reject(std::move(e));
+          });
+    }
+  }
+}
 
 namespace {
 struct LoadResult {
@@ -222,7 +519,8 @@ struct LoadResult {
  * `LoadResult` with the state `RasterOverlayTile::LoadState::Failed` will be
  * returned.
  *
- * Otherwise, the image data will be passed to
+ * Otherwise, the image is compressed to the given `compressedPixelFormat`, if
+ * any, and then passed to
  * `IPrepareRasterOverlayRendererResources::prepareRasterInLoadThread`, and the
  * function will return a `LoadResult` with the image, the prepared renderer
  * resources, and the state `RasterOverlayTile::LoadState::Loaded`.
@@ -232,6 +530,7 @@ struct LoadResult {
  * @param pLogger The logger
  * @param loadedImage The `LoadedRasterOverlayImage`
  * @param rendererOptions Renderer options
+ * @param compressedPixelFormat The format to compress the image to, or NONE
  * @return The `LoadResult`
  */
 static LoadResult createLoadResultFromLoadedImage(
@@ -239,7 +538,8 @@ static LoadResult createLoadResultFromLoadedImage(
         pPrepareRendererResources,
     const std::shared_ptr<spdlog::logger>& pLogger,
     LoadedRasterOverlayImage&& loadedImage,
-    const std::any& rendererOptions) {
+    const std::any& rendererOptions,
+    CesiumGltf::GpuCompressedPixelFormat compressedPixelFormat) {
   if (!loadedImage.image.has_value()) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
@@ -268,7 +568,15 @@ static LoadResult createLoadResultFromLoadedImage(
       static_cast<int64_t>(image.width) * image.height * bytesPerPixel;
   if (image.width > 0 && image.height > 0 &&
       image.pixelData.size() >= static_cast<size_t>(requiredBytes)) {
-    CESIUM_TRACE(
+    if (compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE) {
+      CESIUM_TRACE_CATEGORY(Raster, "Compress Raster");
+      CesiumGltfContent::ImageManipulation::compressImage(
+          image,
+          compressedPixelFormat);
+    }
+
+    CESIUM_TRACE_CATEGORY(
+        Raster,
         "Prepare Raster " + std::to_string(image.width) + "x" +
         std::to_string(image.height) + "x" + std::to_string(image.channels) +
         "x" + std::to_string(image.bytesPerChannel));
@@ -323,13 +631,16 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
       .thenInWorkerThread(
           [pPrepareRendererResources = this->getPrepareRendererResources(),
            pLogger = this->getLogger(),
-           rendererOptions = this->_pOwner->getOptions().rendererOptions](
+           rendererOptions = this->_pOwner->getOptions().rendererOptions,
+           compressedPixelFormat =
+               this->_pOwner->getOptions().compressedPixelFormat](
               LoadedRasterOverlayImage&& loadedImage) {
             return createLoadResultFromLoadedImage(
                 pPrepareRendererResources,
                 pLogger,
                 std::move(loadedImage),
-                rendererOptions);
+                rendererOptions,
+                compressedPixelFormat);
           })
       .thenInMainThread(
           [thiz, pTile, isThrottledLoad](LoadResult&& result) noexcept {
@@ -374,11 +685,29 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
           });
 }
 
+void RasterOverlayTileProvider::setTileLoadScheduler(
+    const std::shared_ptr<TileLoadScheduler>& pTileLoadScheduler) noexcept {
+  // Loads already in progress were never reported to the new scheduler.
+  assert(this->_totalTilesCurrentlyLoading == 0);
+  this->_pTileLoadScheduler = pTileLoadScheduler;
+}
+
+void RasterOverlayTileProvider::setTileImageCache(
+    const std::shared_ptr<QuadtreeTileImageCache>& pTileImageCache) noexcept {
+  // Loads already in progress may have been cached by this provider alone.
+  assert(this->_totalTilesCurrentlyLoading == 0);
+  this->_pTileImageCache = pTileImageCache;
+}
+
 void RasterOverlayTileProvider::beginTileLoad(bool isThrottledLoad) noexcept {
   ++this->_totalTilesCurrentlyLoading;
   if (isThrottledLoad) {
     ++this->_throttledTilesCurrentlyLoading;
   }
+
+  if (this->_pTileLoadScheduler) {
+    this->_pTileLoadScheduler->notifyLoadStarted();
+  }
 }
 
 void RasterOverlayTileProvider::finalizeTileLoad(
@@ -387,6 +716,10 @@ void RasterOverlayTileProvider::finalizeTileLoad(
   if (isThrottledLoad) {
     --this->_throttledTilesCurrentlyLoading;
   }
+
+  if (this->_pTileLoadScheduler) {
+    this->_pTileLoadScheduler->notifyLoadFinished();
+  }
 }
 
 TileProviderAndTile::~TileProviderAndTile() noexcept {
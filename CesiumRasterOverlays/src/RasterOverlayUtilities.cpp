@@ -1,10 +1,15 @@
 #include <CesiumGeospatial/BoundingRegionBuilder.h>
-#include <CesiumGltf/AccessorWriter.h>
+#include <CesiumGltf/AccessorUtility.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 using namespace CesiumGltfContent;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -19,7 +24,8 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
     std::vector<CesiumGeospatial::Projection>&& projections,
     bool invertVCoordinate,
     const std::string& textureCoordinateAttributeBaseName,
-    int32_t firstTextureCoordinateID) {
+    int32_t firstTextureCoordinateID,
+    bool quantizeTextureCoordinates) {
   if (projections.empty()) {
     return std::nullopt;
   }
@@ -91,31 +97,19 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
 
         const glm::dmat4 fullTransform = rootTransform * nodeTransform;
 
-        std::vector<CesiumGltf::Buffer>& buffers = gltf.buffers;
-        std::vector<CesiumGltf::BufferView>& bufferViews = gltf.bufferViews;
-        std::vector<CesiumGltf::Accessor>& accessors = gltf.accessors;
-
-        positionAccessorsToTextureCoordinateAccessor[size_t(
-            positionAccessorIndex)] = int32_t(gltf.accessors.size());
-
-        // Create a buffer, bufferView, accessor, and writer for each set of
-        // coordinates. Reserve space for them to avoid unnecessary
-        // reallocations and to prevent earlier buffers from becoming invalid
-        // after we've created an AccessorWriter for it and then add _another_
-        // buffer.
-        std::vector<CesiumGltf::AccessorWriter<glm::vec2>> uvWriters;
-        uvWriters.reserve(projections.size());
-        buffers.reserve(buffers.size() + projections.size());
-        bufferViews.reserve(bufferViews.size() + projections.size());
-        accessors.reserve(accessors.size() + projections.size());
-
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
-            gltf,
-            positionAccessorIndex);
-        if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+        const CesiumGltf::QuantizedPositionAccessorType positionView =
+            CesiumGltf::getQuantizedPositionAccessorView(gltf, primitive);
+        if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+            CesiumGltf::AccessorViewStatus::Valid) {
           return;
         }
 
+        const int64_t positionCount =
+            std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+        const bool positionsNormalized =
+            gltf.accessors[static_cast<size_t>(positionAccessorIndex)]
+                .normalized;
+
         std::optional<SkirtMeshMetadata> skirtMeshMetadata =
             SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
         int64_t vertexBegin, vertexEnd;
@@ -125,45 +119,57 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
                       skirtMeshMetadata->noSkirtVerticesCount;
         } else {
           vertexBegin = 0;
-          vertexEnd = positionView.size();
+          vertexEnd = positionCount;
         }
 
-        for (size_t i = 0; i < projections.size(); ++i) {
-          const int uvBufferId = static_cast<int>(buffers.size());
-          CesiumGltf::Buffer& uvBuffer = buffers.emplace_back();
-
-          const int uvBufferViewId = static_cast<int>(bufferViews.size());
-          bufferViews.emplace_back();
+        positionAccessorsToTextureCoordinateAccessor[size_t(
+            positionAccessorIndex)] = int32_t(gltf.accessors.size());
 
-          const int uvAccessorId = static_cast<int>(accessors.size());
-          accessors.emplace_back();
+        // The texture coordinates of all projections go in one buffer, with a
+        // bufferView and an accessor for each projection.
+        const size_t uvByteSize = quantizeTextureCoordinates
+                                      ? 2 * sizeof(uint16_t)
+                                      : 2 * sizeof(float);
+        const size_t uvByteLength = size_t(positionCount) * uvByteSize;
 
-          uvBuffer.cesium.data.resize(
-              size_t(positionView.size()) * 2 * sizeof(float));
+        const int32_t uvBufferId = static_cast<int32_t>(gltf.buffers.size());
+        CesiumGltf::Buffer& uvBuffer = gltf.buffers.emplace_back();
+        uvBuffer.cesium.data.resize(uvByteLength * projections.size());
+        uvBuffer.byteLength = int64_t(uvBuffer.cesium.data.size());
 
-          uvBuffer.byteLength = int64_t(uvBuffer.cesium.data.size());
+        gltf.bufferViews.reserve(gltf.bufferViews.size() + projections.size());
+        gltf.accessors.reserve(gltf.accessors.size() + projections.size());
 
+        for (size_t i = 0; i < projections.size(); ++i) {
+          const int32_t uvBufferViewId =
+              static_cast<int32_t>(gltf.bufferViews.size());
           CesiumGltf::BufferView& uvBufferView =
-              gltf.bufferViews[static_cast<size_t>(uvBufferViewId)];
+              gltf.bufferViews.emplace_back();
           uvBufferView.buffer = uvBufferId;
-          uvBufferView.byteOffset = 0;
-          uvBufferView.byteStride = 2 * sizeof(float);
-          uvBufferView.byteLength = int64_t(uvBuffer.cesium.data.size());
+          uvBufferView.byteOffset = int64_t(i * uvByteLength);
+          uvBufferView.byteStride = int64_t(uvByteSize);
+          uvBufferView.byteLength = int64_t(uvByteLength);
           uvBufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
 
-          CesiumGltf::Accessor& uvAccessor =
-              gltf.accessors[static_cast<size_t>(uvAccessorId)];
+          const int32_t uvAccessorId =
+              static_cast<int32_t>(gltf.accessors.size());
+          CesiumGltf::Accessor& uvAccessor = gltf.accessors.emplace_back();
           uvAccessor.bufferView = uvBufferViewId;
           uvAccessor.byteOffset = 0;
-          uvAccessor.componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
-          uvAccessor.count = int64_t(positionView.size());
+          uvAccessor.count = int64_t(positionCount);
           uvAccessor.type = CesiumGltf::Accessor::Type::VEC2;
-          uvAccessor.min = {0.0, 0.0};
-          uvAccessor.max = {1.0, 1.0};
-
-          [[maybe_unused]] CesiumGltf::AccessorWriter<glm::vec2>& uvWriter =
-              uvWriters.emplace_back(gltf, uvAccessorId);
-          assert(uvWriter.status() == CesiumGltf::AccessorViewStatus::Valid);
+          if (quantizeTextureCoordinates) {
+            uvAccessor.componentType =
+                CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT;
+            uvAccessor.normalized = true;
+            uvAccessor.min = {0.0, 0.0};
+            uvAccessor.max = {65535.0, 65535.0};
+          } else {
+            uvAccessor.componentType =
+                CesiumGltf::Accessor::ComponentType::FLOAT;
+            uvAccessor.min = {0.0, 0.0};
+            uvAccessor.max = {1.0, 1.0};
+          }
 
           std::string attributeName =
               textureCoordinateAttributeBaseName +
@@ -171,41 +177,93 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
           primitive.attributes[attributeName] = uvAccessorId;
         }
 
-        // Generate texture coordinates for each position.
-        for (int64_t positionIndex = 0; positionIndex < positionView.size();
+        // Writes the texture coordinates of a vertex for a projection. Newly
+        // resized buffer data is zeroed, so vertices that are never written
+        // get (0.0, 0.0).
+        std::byte* pUvData = uvBuffer.cesium.data.data();
+        auto writeUv = [pUvData, uvByteLength, quantizeTextureCoordinates](
+                           size_t projectionIndex,
+                           int64_t positionIndex,
+                           const glm::vec2& uv) {
+          std::byte* pUv = pUvData + projectionIndex * uvByteLength;
+          if (quantizeTextureCoordinates) {
+            uint16_t* pQuantized =
+                reinterpret_cast<uint16_t*>(pUv) + 2 * positionIndex;
+            pQuantized[0] = static_cast<uint16_t>(std::lround(uv.x * 65535.0));
+            pQuantized[1] = static_cast<uint16_t>(std::lround(uv.y * 65535.0));
+          } else {
+            reinterpret_cast<glm::vec2*>(pUv)[positionIndex] = uv;
+          }
+        };
+
+        // Get the ECEF positions and convert them to cartographic.
+        std::vector<glm::dvec3> positionsEcef(size_t(positionCount));
+        for (int64_t positionIndex = 0; positionIndex < positionCount;
              ++positionIndex) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[positionIndex];
-          const glm::dvec3 positionEcef =
+          const glm::vec3 position =
+              std::visit(
+                  CesiumGltf::PositionFromAccessor{
+                      positionIndex,
+                      positionsNormalized},
+                  positionView)
+                  .value_or(glm::vec3(0.0f));
+          positionsEcef[size_t(positionIndex)] =
               glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
+        }
 
-          // Convert it to cartographic
-          const std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
+        std::vector<std::optional<CesiumGeospatial::Cartographic>>
+            cartographics(positionsEcef.size());
+        CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
+            positionsEcef,
+            cartographics);
+
+        // Positions that couldn't be converted get (0.0, 0.0) texture
+        // coordinates. The others are projected below, so they are replaced
+        // by placeholders that project without problems.
+        std::vector<CesiumGeospatial::Cartographic> cartographicsToProject(
+            cartographics.size(),
+            CesiumGeospatial::Cartographic(0.0, 0.0, 0.0));
+        for (int64_t positionIndex = 0; positionIndex < positionCount;
+             ++positionIndex) {
+          const std::optional<CesiumGeospatial::Cartographic>& cartographic =
+              cartographics[size_t(positionIndex)];
           if (!cartographic) {
-            for (CesiumGltf::AccessorWriter<glm::vec2>& uvWriter : uvWriters) {
-              uvWriter[positionIndex] = glm::dvec2(0.0, 0.0);
-            }
             continue;
           }
 
+          cartographicsToProject[size_t(positionIndex)] = *cartographic;
+
           // exclude skirt vertices from bounds
           if (positionIndex >= vertexBegin && positionIndex < vertexEnd) {
             computedBounds.expandToIncludePosition(*cartographic);
           }
+        }
 
-          // Generate texture coordinates at this position for each projection
-          for (size_t projectionIndex = 0; projectionIndex < projections.size();
-               ++projectionIndex) {
-            const CesiumGeospatial::Projection& projection =
-                projections[projectionIndex];
-            const CesiumGeometry::Rectangle& rectangle =
-                rectangles[projectionIndex];
+        // Generate texture coordinates at each position for each projection
+        std::vector<glm::dvec2> projectedPositions(cartographics.size());
+        for (size_t projectionIndex = 0; projectionIndex < projections.size();
+             ++projectionIndex) {
+          const CesiumGeospatial::Projection& projection =
+              projections[projectionIndex];
+          const CesiumGeometry::Rectangle& rectangle =
+              rectangles[projectionIndex];
+
+          // Project them with the raster overlay's projection
+          projectPositions(
+              projection,
+              cartographicsToProject,
+              projectedPositions);
+
+          for (int64_t positionIndex = 0; positionIndex < positionCount;
+               ++positionIndex) {
+            const std::optional<CesiumGeospatial::Cartographic>& cartographic =
+                cartographics[size_t(positionIndex)];
+            if (!cartographic) {
+              continue;
+            }
 
-            // Project it with the raster overlay's projection
-            glm::dvec3 projectedPosition =
-                projectPosition(projection, cartographic.value());
+            glm::dvec2 projectedPosition =
+                projectedPositions[size_t(positionIndex)];
 
             double longitude = cartographic.value().longitude;
             const double latitude = cartographic.value().latitude;
@@ -226,17 +284,17 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
               const double testLongitude = longitude + longitude < 0.0
                                                ? CesiumUtility::Math::TwoPi
                                                : -CesiumUtility::Math::TwoPi;
-              const glm::dvec3 projectedPosition2 = projectPosition(
+              const glm::dvec2 projectedPosition2(projectPosition(
                   projection,
                   CesiumGeospatial::Cartographic(
                       testLongitude,
                       latitude,
-                      ellipsoidHeight));
+                      ellipsoidHeight)));
 
-              const double distance1 = rectangle.computeSignedDistance(
-                  glm::dvec2(projectedPosition));
-              const double distance2 = rectangle.computeSignedDistance(
-                  glm::dvec2(projectedPosition2));
+              const double distance1 =
+                  rectangle.computeSignedDistance(projectedPosition);
+              const double distance2 =
+                  rectangle.computeSignedDistance(projectedPosition2);
 
               if (distance2 < distance1) {
                 projectedPosition = projectedPosition2;
@@ -264,7 +322,7 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
               uv.y = 1.0f - uv.y;
             }
 
-            uvWriters[projectionIndex][positionIndex] = uv;
+            writeUv(projectionIndex, positionIndex, uv);
           }
         }
       };
@@ -8,8 +8,10 @@
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -17,6 +19,46 @@ using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 namespace {
+// An edge of a polygon that isn't horizontal, from its southern end at
+// (x, minY) to its northern end at maxY, with the change in longitude per
+// change in latitude.
+struct PolygonEdge {
+  double minY;
+  double maxY;
+  double x;
+  double slope;
+};
+
+// Adds the edges of a polygon that span any latitude between south and north.
+void addPolygonEdges(
+    const CartographicPolygon& polygon,
+    double south,
+    double north,
+    std::vector<PolygonEdge>& edges) {
+  edges.clear();
+
+  const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const glm::dvec2& a = vertices[i];
+    const glm::dvec2& b = vertices[(i + 1) % vertices.size()];
+    if (a.y == b.y) {
+      continue;
+    }
+
+    const glm::dvec2& lower = a.y < b.y ? a : b;
+    const glm::dvec2& upper = a.y < b.y ? b : a;
+    if (upper.y < south || lower.y > north) {
+      continue;
+    }
+
+    edges.emplace_back(PolygonEdge{
+        lower.y,
+        upper.y,
+        lower.x,
+        (upper.x - lower.x) / (upper.y - lower.y)});
+  }
+}
+
 void rasterizePolygons(
     LoadedRasterOverlayImage& loaded,
     const CesiumGeospatial::GlobeRectangle& rectangle,
@@ -78,76 +120,67 @@ void rasterizePolygons(
 
   // create source image
   loaded.moreDetailAvailable = true;
-  image.width = int32_t(glm::round(textureSize.x));
-  image.height = int32_t(glm::round(textureSize.y));
+  image.width = glm::max(int32_t(glm::round(textureSize.x)), 1);
+  image.height = glm::max(int32_t(glm::round(textureSize.y)), 1);
   image.channels = 1;
   image.bytesPerChannel = 1;
   image.pixelData.resize(size_t(image.width * image.height), outsideColor);
 
-  // TODO: this is naive approach, use line-triangle
-  // intersections to rasterize one row at a time
-  // NOTE: also completely ignores antimeridian (really these
-  // calculations should be normalized to the first vertex)
+  const size_t width = size_t(image.width);
+  const size_t height = size_t(image.height);
+
+  // Rasterize one row of pixel centers at a time. Each polygon is filled
+  // between pairs of the sorted crossings of its edges with the row, so
+  // only the edges of the polygons that overlap the tile, and only those that
+  // span the tile's latitudes, are ever looked at.
+  // NOTE: this completely ignores the antimeridian (really these calculations
+  // should be normalized to the first vertex)
+  std::vector<PolygonEdge> edges;
+  std::vector<double> crossings;
   for (const CartographicPolygon& polygon : cartographicPolygons) {
-    const std::vector<glm::dvec2>& vertices = polygon.getVertices();
-    const std::vector<uint32_t>& indices = polygon.getIndices();
-    for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
-      const glm::dvec2& a = vertices[indices[3 * triangle]];
-      const glm::dvec2& b = vertices[indices[3 * triangle + 1]];
-      const glm::dvec2& c = vertices[indices[3 * triangle + 2]];
-
-      // TODO: deal with the corner cases here
-      const double minX = glm::min(a.x, glm::min(b.x, c.x));
-      const double minY = glm::min(a.y, glm::min(b.y, c.y));
-      const double maxX = glm::max(a.x, glm::max(b.x, c.x));
-      const double maxY = glm::max(a.y, glm::max(b.y, c.y));
-
-      const CesiumGeospatial::GlobeRectangle triangleBounds(
-          minX,
-          minY,
-          maxX,
-          maxY);
-
-      // skip this triangle if it is entirely outside the tile bounds
-      if (!rectangle.computeIntersection(triangleBounds)) {
-        continue;
-      }
+    const std::optional<CesiumGeospatial::GlobeRectangle>& boundingRectangle =
+        polygon.getBoundingRectangle();
+    if (!boundingRectangle ||
+        !rectangle.computeIntersection(*boundingRectangle)) {
+      continue;
+    }
+
+    addPolygonEdges(polygon, rectangle.getSouth(), rectangle.getNorth(), edges);
+    if (edges.empty()) {
+      continue;
+    }
 
-      const glm::dvec2 ab = b - a;
-      const glm::dvec2 ab_perp(-ab.y, ab.x);
-      const glm::dvec2 bc = c - b;
-      const glm::dvec2 bc_perp(-bc.y, bc.x);
-      const glm::dvec2 ca = a - c;
-      const glm::dvec2 ca_perp(-ca.y, ca.x);
-
-      size_t width = size_t(image.width);
-      size_t height = size_t(image.height);
-
-      for (size_t j = 0; j < height; ++j) {
-        const double pixelY =
-            rectangle.getSouth() +
-            rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
-        for (size_t i = 0; i < width; ++i) {
-          const double pixelX = rectangle.getWest() + rectangleWidth *
-                                                          (double(i) + 0.5) /
-                                                          double(width);
-          const glm::dvec2 v(pixelX, pixelY);
-
-          const glm::dvec2 av = v - a;
-          const glm::dvec2 cv = v - c;
-
-          const double v_proj_ab_perp = glm::dot(av, ab_perp);
-          const double v_proj_bc_perp = glm::dot(cv, bc_perp);
-          const double v_proj_ca_perp = glm::dot(cv, ca_perp);
-
-          // will determine in or out, irrespective of winding
-          if ((v_proj_ab_perp >= 0.0 && v_proj_ca_perp >= 0.0 &&
-               v_proj_bc_perp >= 0.0) ||
-              (v_proj_ab_perp <= 0.0 && v_proj_ca_perp <= 0.0 &&
-               v_proj_bc_perp <= 0.0)) {
-            image.pixelData[width * j + i] = insideColor;
-          }
+    for (size_t j = 0; j < height; ++j) {
+      const double pixelY =
+          rectangle.getSouth() +
+          rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
+
+      crossings.clear();
+      for (const PolygonEdge& edge : edges) {
+        if (pixelY >= edge.minY && pixelY < edge.maxY) {
+          crossings.emplace_back(edge.x + (pixelY - edge.minY) * edge.slope);
+        }
+      }
+      std::sort(crossings.begin(), crossings.end());
+
+      std::byte* pRow = image.pixelData.data() + width * j;
+      for (size_t k = 1; k < crossings.size(); k += 2) {
+        // The pixels whose centers are between the two crossings.
+        const double first = glm::ceil(
+            (crossings[k - 1] - rectangle.getWest()) / rectangleWidth *
+                double(width) -
+            0.5);
+        const double last = glm::floor(
+            (crossings[k] - rectangle.getWest()) / rectangleWidth *
+                double(width) -
+            0.5);
+        if (last < 0.0 || first >= double(width) || first > last) {
+          continue;
         }
+
+        const size_t firstPixel = size_t(glm::max(first, 0.0));
+        const size_t endPixel = size_t(glm::min(last, double(width) - 1.0)) + 1;
+        std::fill(pRow + firstPixel, pRow + endPixel, insideColor);
       }
     }
   }
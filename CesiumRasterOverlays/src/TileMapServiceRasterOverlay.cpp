@@ -8,6 +8,7 @@
 #include <CesiumRasterOverlays/TileMapServiceRasterOverlay.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/Uri.h>
+#include <CesiumUtility/UriResolver.h>
 
 #include <spdlog/fwd.h>
 #include <tinyxml2.h>
@@ -63,6 +64,7 @@ public:
             width,
             height),
         _url(url),
+        _urlResolver(url),
         _headers(headers),
         _fileExtension(fileExtension),
         _tileSets(tileSets) {}
@@ -81,8 +83,7 @@ protected:
 
     if (level < _tileSets.size()) {
       const TileMapServiceTileset& tileset = _tileSets[level];
-      std::string url = CesiumUtility::Uri::resolve(
-          this->_url,
+      std::string url = this->_urlResolver.resolve(
           tileset.url + "/" + std::to_string(tileID.x) + "/" +
               std::to_string(tileID.y) + this->_fileExtension,
           true);
@@ -102,8 +103,17 @@ protected:
     }
   }
 
+  virtual std::string getTileImageCacheKey() const override {
+    std::string key = "tms:" + this->_url + "|" + this->_fileExtension;
+    for (const TileMapServiceTileset& tileset : this->_tileSets) {
+      key += "|" + tileset.url;
+    }
+    return key;
+  }
+
 private:
   std::string _url;
+  CesiumUtility::UriResolver _urlResolver;
   std::vector<IAssetAccessor::THeader> _headers;
   std::string _fileExtension;
   std::vector<TileMapServiceTileset> _tileSets;
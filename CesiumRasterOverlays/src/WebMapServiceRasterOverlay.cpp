@@ -120,6 +120,12 @@ protected:
     return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
   }
 
+  virtual std::string getTileImageCacheKey() const override {
+    return "wms:" + this->_url + "|" + this->_version + "|" + this->_layers +
+           "|" + this->_format + "|" + std::to_string(this->getWidth()) + "x" +
+           std::to_string(this->getHeight());
+  }
+
 private:
   std::string _url;
   std::vector<IAssetAccessor::THeader> _headers;
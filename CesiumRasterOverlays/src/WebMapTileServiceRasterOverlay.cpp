@@ -155,6 +155,26 @@ protected:
     return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
   }
 
+  virtual std::string getTileImageCacheKey() const override {
+    std::string key = "wmts:" + this->_url + "|" + this->_layer + "|" +
+                      this->_style + "|" + this->_tileMatrixSetID + "|" +
+                      this->_format + (this->_useKVP ? "|kvp" : "");
+    if (this->_labels) {
+      for (const std::string& label : *this->_labels) {
+        key += "|" + label;
+      }
+    }
+    if (this->_staticDimensions) {
+      for (const auto& [name, value] : *this->_staticDimensions) {
+        key += "|" + name + "=" + value;
+      }
+    }
+    for (const std::string& subdomain : this->_subdomains) {
+      key += "|" + subdomain;
+    }
+    return key;
+  }
+
 private:
   std::string _url;
   std::vector<IAssetAccessor::THeader> _headers;
@@ -285,3 +285,83 @@ TEST_CASE("Add raster overlay to glTF") {
     CHECK(texCoordView[i].y <= 1.0);
   }
 }
+
+TEST_CASE("Create quantized raster overlay texture coordinates") {
+  std::filesystem::path dataDir(CesiumRasterOverlays_TEST_DATA_DIR);
+  std::vector<std::byte> bytes = readFile(dataDir / "Shadow_Tester.glb");
+  GltfReader reader;
+  GltfReaderResult result = reader.readGltf(bytes);
+  REQUIRE(result.model);
+
+  glm::dmat4 enuToFixed = GlobeTransforms::eastNorthUpToFixedFrame(
+      Ellipsoid::WGS84.cartographicToCartesian(
+          Cartographic::fromDegrees(-75.14777, 39.95021, 200.0)));
+  glm::dmat4 scale =
+      glm::scale(glm::dmat4(1.0), glm::dvec3(100000.0, 100000.0, 100000.0));
+  glm::dmat4 modelToEcef = enuToFixed * scale;
+
+  Model floatModel = *result.model;
+  Model quantizedModel = *result.model;
+
+  std::optional<RasterOverlayDetails> floatDetails =
+      RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
+          floatModel,
+          modelToEcef,
+          std::nullopt,
+          {GeographicProjection(), WebMercatorProjection()},
+          false,
+          "_CESIUMOVERLAY_",
+          0);
+  std::optional<RasterOverlayDetails> quantizedDetails =
+      RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
+          quantizedModel,
+          modelToEcef,
+          std::nullopt,
+          {GeographicProjection(), WebMercatorProjection()},
+          false,
+          "_CESIUMOVERLAY_",
+          0,
+          true);
+  REQUIRE(floatDetails);
+  REQUIRE(quantizedDetails);
+
+  const MeshPrimitive& floatPrimitive = floatModel.meshes[0].primitives[0];
+  const MeshPrimitive& quantizedPrimitive =
+      quantizedModel.meshes[0].primitives[0];
+
+  for (const std::string& name : {"_CESIUMOVERLAY_0", "_CESIUMOVERLAY_1"}) {
+    AccessorView<glm::vec2> floatUvs(
+        floatModel,
+        floatPrimitive.attributes.at(name));
+    AccessorView<glm::u16vec2> quantizedUvs(
+        quantizedModel,
+        quantizedPrimitive.attributes.at(name));
+    REQUIRE(floatUvs.status() == AccessorViewStatus::Valid);
+    REQUIRE(quantizedUvs.status() == AccessorViewStatus::Valid);
+    REQUIRE(floatUvs.size() == quantizedUvs.size());
+
+    const Accessor& accessor = quantizedModel.accessors[static_cast<size_t>(
+        quantizedPrimitive.attributes.at(name))];
+    CHECK(accessor.componentType == Accessor::ComponentType::UNSIGNED_SHORT);
+    CHECK(accessor.normalized);
+
+    for (int64_t i = 0; i < floatUvs.size(); ++i) {
+      const glm::vec2 dequantized = glm::vec2(quantizedUvs[i]) / 65535.0f;
+      CHECK(dequantized.x == Approx(floatUvs[i].x).margin(1.0 / 65535.0));
+      CHECK(dequantized.y == Approx(floatUvs[i].y).margin(1.0 / 65535.0));
+    }
+  }
+
+  // The texture coordinates of both projections are in one buffer.
+  const Accessor& first =
+      quantizedModel.accessors[static_cast<size_t>(
+          quantizedPrimitive.attributes.at("_CESIUMOVERLAY_0"))];
+  const Accessor& second =
+      quantizedModel.accessors[static_cast<size_t>(
+          quantizedPrimitive.attributes.at("_CESIUMOVERLAY_1"))];
+  CHECK(
+      quantizedModel.bufferViews[static_cast<size_t>(first.bufferView)]
+          .buffer ==
+      quantizedModel.bufferViews[static_cast<size_t>(second.bufferView)]
+          .buffer);
+}
@@ -241,3 +241,335 @@ TEST_CASE("QuadtreeRasterOverlayTileProvider getTile") {
         [](std::byte b) { return b == std::byte(8); }));
   }
 }
+
+TEST_CASE("QuadtreeRasterOverlayTileProvider shares quadtree tiles") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  RasterOverlayOptions options;
+  options.shareQuadtreeTiles = true;
+  IntrusivePointer<TestRasterOverlay> pOverlay =
+      new TestRasterOverlay("Test", options);
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  TestTileProvider* pTestProvider =
+      static_cast<TestTileProvider*>(pProvider.get());
+
+  // Select two rectangles within the same tile at tile level 8.
+  const uint32_t expectedLevel = 8;
+  std::optional<QuadtreeTileID> tileID =
+      pTestProvider->getTilingScheme().positionToTile(
+          glm::dvec2(0.1, 0.2),
+          expectedLevel);
+  REQUIRE(tileID);
+
+  const Rectangle tileRectangle =
+      pTestProvider->getTilingScheme().tileToRectangle(*tileID);
+  const glm::dvec2 center = tileRectangle.getCenter();
+  const double inset = tileRectangle.computeWidth() * 0.01;
+  const Rectangle southwest(
+      tileRectangle.minimumX + inset,
+      tileRectangle.minimumY + inset,
+      center.x - inset,
+      center.y - inset);
+  const Rectangle northeast(
+      center.x + inset,
+      center.y + inset,
+      tileRectangle.maximumX - inset,
+      tileRectangle.maximumY - inset);
+
+  // Each rectangle is half the width of the tile, so it needs half as many
+  // pixels on the screen to use the tile's level.
+  const double rasterSSE = 2.0;
+  const glm::dvec2 targetScreenPixels = glm::dvec2(
+      pTestProvider->getWidth() * rasterSSE * 0.5,
+      pTestProvider->getHeight() * rasterSSE * 0.5);
+
+  auto isTileRectangle = [&tileRectangle](const Rectangle& rectangle) {
+    return rectangle.minimumX == tileRectangle.minimumX &&
+           rectangle.minimumY == tileRectangle.minimumY &&
+           rectangle.maximumX == tileRectangle.maximumX &&
+           rectangle.maximumY == tileRectangle.maximumY;
+  };
+
+  SECTION("uses one tile for the whole quadtree tile") {
+    IntrusivePointer<RasterOverlayTile> pSouthwest =
+        pProvider->getTile(southwest, targetScreenPixels);
+    IntrusivePointer<RasterOverlayTile> pNortheast =
+        pProvider->getTile(northeast, targetScreenPixels);
+    REQUIRE(pSouthwest);
+    CHECK(pSouthwest == pNortheast);
+    CHECK(isTileRectangle(pSouthwest->getRectangle()));
+
+    pProvider->loadTile(*pSouthwest);
+
+    while (pSouthwest->getState() != RasterOverlayTile::LoadState::Loaded) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+
+    const ImageCesium& image = pSouthwest->getImage();
+    CHECK(image.width == int32_t(pTestProvider->getWidth()));
+    CHECK(image.height == int32_t(pTestProvider->getHeight()));
+    CHECK(std::all_of(
+        image.pixelData.begin(),
+        image.pixelData.end(),
+        [level = tileID->level](std::byte b) {
+          return b == std::byte(level);
+        }));
+  }
+
+  SECTION("creates a new shared tile after the previous one is released") {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        pProvider->getTile(southwest, targetScreenPixels);
+    REQUIRE(pTile);
+    pTile = nullptr;
+
+    pTile = pProvider->getTile(northeast, targetScreenPixels);
+    REQUIRE(pTile);
+    CHECK(pTile->getState() == RasterOverlayTile::LoadState::Unloaded);
+    CHECK(isTileRectangle(pTile->getRectangle()));
+  }
+
+  SECTION("doesn't share tiles that span several quadtree tiles") {
+    const Rectangle spanning(
+        southwest.minimumX - tileRectangle.computeWidth() * 0.5,
+        southwest.minimumY,
+        southwest.maximumX,
+        southwest.maximumY);
+    IntrusivePointer<RasterOverlayTile> pSpanning =
+        pProvider->getTile(spanning, targetScreenPixels);
+    IntrusivePointer<RasterOverlayTile> pSouthwest =
+        pProvider->getTile(southwest, targetScreenPixels);
+    REQUIRE(pSpanning);
+    CHECK(pSpanning != pSouthwest);
+    CHECK(!isTileRectangle(pSpanning->getRectangle()));
+  }
+}
+
+TEST_CASE("QuadtreeRasterOverlayTileProvider level hysteresis") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  RasterOverlayOptions options;
+  options.levelHysteresis = 0.25;
+  IntrusivePointer<TestRasterOverlay> pOverlay =
+      new TestRasterOverlay("Test", options);
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  TestTileProvider* pTestProvider =
+      static_cast<TestTileProvider*>(pProvider.get());
+
+  std::optional<QuadtreeTileID> tileID =
+      pTestProvider->getTilingScheme().positionToTile(glm::dvec2(0.1, 0.2), 8);
+  REQUIRE(tileID);
+  const Rectangle rectangle =
+      pTestProvider->getTilingScheme().tileToRectangle(*tileID);
+
+  // With 256x256 images and a maximum screen-space error of 2, the ideal
+  // level for the tile's rectangle is 8 at 512 pixels and goes up by one each
+  // time the pixels double.
+  auto pixelsForLevel = [](double level) {
+    const double pixels = 512.0 * glm::pow(2.0, level - 8.0);
+    return glm::dvec2(pixels, pixels);
+  };
+
+  SECTION("keeps the level until the ideal level moves far enough") {
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            rectangle,
+            pixelsForLevel(8.4)) == 8);
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            rectangle,
+            pixelsForLevel(8.7)) == 8);
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            rectangle,
+            pixelsForLevel(9.2)) == 9);
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            rectangle,
+            pixelsForLevel(8.4)) == 9);
+  }
+
+  SECTION("doesn't keep the level of a different rectangle") {
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            rectangle,
+            pixelsForLevel(8.4)) == 8);
+
+    Rectangle other = rectangle;
+    other.maximumX += rectangle.computeWidth() * 0.01;
+    CHECK(
+        pTestProvider->computeLevelFromTargetScreenPixels(
+            other,
+            pixelsForLevel(8.7)) == 9);
+  }
+
+  SECTION("reuses the tile of a rectangle within one level") {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        pProvider->getTile(rectangle, pixelsForLevel(8.0));
+    REQUIRE(pTile);
+    CHECK(pProvider->getTile(rectangle, pixelsForLevel(9.0)) == pTile);
+    CHECK(pProvider->getTile(rectangle, pixelsForLevel(10.0)) != pTile);
+  }
+}
+
+TEST_CASE("QuadtreeRasterOverlayTileProvider loadTileThrottled priorities") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  RasterOverlayOptions options;
+  options.maximumSimultaneousTileLoads = 4;
+  IntrusivePointer<TestRasterOverlay> pOverlay =
+      new TestRasterOverlay("Test", options);
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  const Rectangle rectangle =
+      WebMercatorProjection::computeMaximumProjectedRectangle();
+  std::vector<IntrusivePointer<RasterOverlayTile>> tiles;
+  for (size_t i = 0; i < 5; ++i) {
+    tiles.emplace_back(pProvider->getTile(rectangle, glm::dvec2(256)));
+    REQUIRE(tiles.back());
+  }
+
+  // Throttled loads aren't finished until the main thread tasks are
+  // dispatched, so they keep their load slots.
+  using Priority = TileLoadScheduler::Priority;
+
+  // Preloads leave half of the slots free.
+  CHECK(pProvider->loadTileThrottled(*tiles[0], Priority::Preload));
+  CHECK(pProvider->loadTileThrottled(*tiles[1], Priority::Preload));
+  CHECK(!pProvider->loadTileThrottled(*tiles[2], Priority::Preload));
+
+  // Normal loads leave a quarter of the slots free.
+  CHECK(pProvider->loadTileThrottled(*tiles[2], Priority::Normal));
+  CHECK(!pProvider->loadTileThrottled(*tiles[3], Priority::Normal));
+
+  // Urgent loads can use all of the slots.
+  CHECK(pProvider->loadTileThrottled(*tiles[3], Priority::Urgent));
+  CHECK(!pProvider->loadTileThrottled(*tiles[4], Priority::Urgent));
+
+  while (pProvider->getNumberOfTilesLoading() > 0) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+}
+
+TEST_CASE("RasterOverlayTileProvider reports tile state changes") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+  IntrusivePointer<TestRasterOverlay> pOverlay = new TestRasterOverlay("Test");
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  IntrusivePointer<RasterOverlayTile> pTile = pProvider->getTile(
+      GeographicProjection::computeMaximumProjectedRectangle(),
+      glm::dvec2(256));
+  REQUIRE(pTile);
+
+  const uint64_t unloadedVersion = pProvider->getTileStateVersion();
+
+  // Asking for a tile that is already loading changes nothing.
+  pProvider->loadTile(*pTile);
+  const uint64_t loadingVersion = pProvider->getTileStateVersion();
+  CHECK(loadingVersion != unloadedVersion);
+  pProvider->loadTile(*pTile);
+  CHECK(pProvider->getTileStateVersion() == loadingVersion);
+
+  while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  CHECK(pProvider->getTileStateVersion() != loadingVersion);
+}
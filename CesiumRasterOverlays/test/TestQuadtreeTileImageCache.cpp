@@ -0,0 +1,107 @@
+#include <CesiumNativeTests/ThreadTaskProcessor.h>
+#include <CesiumRasterOverlays/QuadtreeTileImageCache.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumRasterOverlays;
+
+namespace {
+
+std::shared_ptr<LoadedRasterOverlayImage> createImage(size_t bytes) {
+  std::shared_ptr<LoadedRasterOverlayImage> pLoaded =
+      std::make_shared<LoadedRasterOverlayImage>();
+  CesiumGltf::ImageCesium& image = pLoaded->image.emplace();
+  image.width = int32_t(bytes);
+  image.height = 1;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(bytes);
+  return pLoaded;
+}
+
+} // namespace
+
+TEST_CASE("QuadtreeTileImageCache") {
+  AsyncSystem asyncSystem(
+      std::make_shared<CesiumNativeTests::ThreadTaskProcessor>());
+
+  QuadtreeTileImageCache cache(100);
+
+  int32_t loads = 0;
+  auto load = [&asyncSystem, &loads](size_t bytes) {
+    return [&asyncSystem, &loads, bytes]() {
+      ++loads;
+      return asyncSystem.createResolvedFuture(createImage(bytes));
+    };
+  };
+
+  const QuadtreeTileID tileID(3, 1, 2);
+
+  SECTION("loads each image of a source once") {
+    SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>> first =
+        cache.getImage("a", tileID, load(10));
+    SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>> second =
+        cache.getImage("a", tileID, load(10));
+
+    CHECK(loads == 1);
+    REQUIRE(first.isReady());
+    REQUIRE(second.isReady());
+    CHECK(first.wait() == second.wait());
+    CHECK(cache.getCachedBytes() == 10);
+  }
+
+  SECTION("loads the images of different sources and tiles separately") {
+    cache.getImage("a", tileID, load(10));
+    cache.getImage("b", tileID, load(10));
+    cache.getImage("a", QuadtreeTileID(3, 2, 2), load(10));
+
+    CHECK(loads == 3);
+    CHECK(cache.getCachedBytes() == 30);
+  }
+
+  SECTION("unloads the least recently used images over the budget") {
+    cache.getImage("a", QuadtreeTileID(1, 0, 0), load(40));
+    cache.getImage("a", QuadtreeTileID(1, 1, 0), load(40));
+
+    // Use the first image again, so that the second one is the oldest.
+    cache.getImage("a", QuadtreeTileID(1, 0, 0), load(40));
+    CHECK(loads == 2);
+
+    cache.getImage("a", QuadtreeTileID(1, 0, 1), load(40));
+    CHECK(loads == 3);
+    CHECK(cache.getCachedBytes() == 80);
+
+    cache.getImage("a", QuadtreeTileID(1, 0, 0), load(40));
+    CHECK(loads == 3);
+    cache.getImage("a", QuadtreeTileID(1, 1, 0), load(40));
+    CHECK(loads == 4);
+  }
+
+  SECTION("doesn't unload images that are still loading") {
+    Promise<std::shared_ptr<LoadedRasterOverlayImage>> promise =
+        asyncSystem.createPromise<std::shared_ptr<LoadedRasterOverlayImage>>();
+    SharedFuture<std::shared_ptr<LoadedRasterOverlayImage>> pending =
+        cache.getImage("a", QuadtreeTileID(1, 0, 0), [&promise]() {
+          return promise.getFuture();
+        });
+
+    cache.getImage("a", QuadtreeTileID(1, 1, 0), load(60));
+    cache.getImage("a", QuadtreeTileID(1, 0, 1), load(60));
+    CHECK(cache.getCachedBytes() == 60);
+
+    promise.resolve(createImage(10));
+    REQUIRE(pending.isReady());
+    CHECK(cache.getCachedBytes() == 70);
+
+    int32_t pendingLoads = 0;
+    cache.getImage("a", QuadtreeTileID(1, 0, 0), [&]() {
+      ++pendingLoads;
+      return asyncSystem.createResolvedFuture(createImage(10));
+    });
+    CHECK(pendingLoads == 0);
+  }
+}
@@ -0,0 +1,115 @@
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+#include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
+
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+
+TEST_CASE("RasterizedPolygonsOverlay") {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  const GeographicProjection projection;
+  const CartographicPolygon square(std::vector<glm::dvec2>{
+      glm::dvec2(0.0, 0.0),
+      glm::dvec2(0.01, 0.0),
+      glm::dvec2(0.01, 0.01),
+      glm::dvec2(0.0, 0.01)});
+
+  auto loadTile = [&](bool invertSelection,
+                      const GlobeRectangle& rectangle) -> ImageCesium {
+    IntrusivePointer<RasterizedPolygonsOverlay> pOverlay =
+        new RasterizedPolygonsOverlay(
+            "Test",
+            {square},
+            invertSelection,
+            Ellipsoid::WGS84,
+            projection);
+
+    IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+    pOverlay
+        ->createTileProvider(
+            asyncSystem,
+            pAssetAccessor,
+            nullptr,
+            nullptr,
+            spdlog::default_logger(),
+            nullptr)
+        .thenInMainThread(
+            [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+              REQUIRE(created);
+              pProvider = *created;
+            });
+    asyncSystem.dispatchMainThreadTasks();
+    REQUIRE(pProvider);
+
+    // With the default maximum screen-space error of 2, this asks for an 8x4
+    // image.
+    IntrusivePointer<RasterOverlayTile> pTile = pProvider->getTile(
+        projectRectangleSimple(projection, rectangle),
+        glm::dvec2(16.0, 8.0));
+    pProvider->loadTile(*pTile);
+    while (pTile->getState() == RasterOverlayTile::LoadState::Loading) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+    REQUIRE(pTile->getState() == RasterOverlayTile::LoadState::Loaded);
+
+    return pTile->getImage();
+  };
+
+  SECTION("fills the pixels whose centers are inside the polygons") {
+    const ImageCesium image =
+        loadTile(false, GlobeRectangle(-0.01, 0.0, 0.01, 0.01));
+    REQUIRE(image.width == 8);
+    REQUIRE(image.height == 4);
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t i = 0; i < 8; ++i) {
+        CHECK(
+            image.pixelData[j * 8 + i] ==
+            (i < 4 ? std::byte(0) : std::byte(0xff)));
+      }
+    }
+  }
+
+  SECTION("fills the pixels outside the polygons when inverted") {
+    const ImageCesium image =
+        loadTile(true, GlobeRectangle(-0.01, 0.0, 0.01, 0.01));
+    REQUIRE(image.width == 8);
+    REQUIRE(image.height == 4);
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t i = 0; i < 8; ++i) {
+        CHECK(
+            image.pixelData[j * 8 + i] ==
+            (i < 4 ? std::byte(0xff) : std::byte(0)));
+      }
+    }
+  }
+
+  SECTION("uses a single pixel for a tile outside the polygons") {
+    const ImageCesium image =
+        loadTile(false, GlobeRectangle(0.02, 0.0, 0.03, 0.01));
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 1);
+    CHECK(image.pixelData[0] == std::byte(0));
+  }
+
+  SECTION("uses a single pixel for a tile inside the polygons") {
+    const ImageCesium image =
+        loadTile(false, GlobeRectangle(0.002, 0.002, 0.008, 0.008));
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 1);
+    CHECK(image.pixelData[0] == std::byte(0xff));
+  }
+}
@@ -1,3 +1,4 @@
+#include <CesiumAsync/MemoryCacheDatabase.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 #include <CesiumNativeTests/SimpleTaskProcessor.h>
 #include <CesiumNativeTests/readFile.h>
@@ -15,6 +16,25 @@ using namespace CesiumNativeTests;
 using namespace CesiumRasterOverlays;
 using namespace CesiumUtility;
 
+namespace {
+class BatchRecordingAssetAccessor : public SimpleAssetAccessor {
+public:
+  using SimpleAssetAccessor::SimpleAssetAccessor;
+
+  virtual std::vector<
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+  getBatch(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::vector<std::string>& urls,
+      const std::vector<THeader>& headers) override {
+    batches.emplace_back(urls);
+    return SimpleAssetAccessor::getBatch(asyncSystem, urls, headers);
+  }
+
+  std::vector<std::vector<std::string>> batches;
+};
+} // namespace
+
 TEST_CASE("TileMapServiceRasterOverlay") {
   // Set up some mock resources for the raster overlay.
   std::filesystem::path dataDir(CesiumRasterOverlays_TEST_DATA_DIR);
@@ -77,6 +97,82 @@ TEST_CASE("TileMapServiceRasterOverlay") {
     CHECK(image.height > 0);
   }
 
+  SECTION("requests the images of a tile in one batch") {
+    auto pBatchAssetAccessor = std::make_shared<BatchRecordingAssetAccessor>(
+        std::map<std::string, std::shared_ptr<SimpleAssetRequest>>(
+            pMockAssetAccessor->mockCompletedRequests));
+
+    RasterOverlay::CreateTileProviderResult result = waitForFuture(
+        asyncSystem,
+        pRasterOverlay->createTileProvider(
+            asyncSystem,
+            pBatchAssetAccessor,
+            nullptr,
+            nullptr,
+            spdlog::default_logger(),
+            nullptr));
+    REQUIRE(result);
+
+    // At this size, more than one of the overlay's tiles covers the geometry
+    // tile.
+    CesiumUtility::IntrusivePointer<RasterOverlayTileProvider> pTileProvider =
+        *result;
+    IntrusivePointer<RasterOverlayTile> pTile = pTileProvider->getTile(
+        pTileProvider->getCoverageRectangle(),
+        glm::dvec2(1024.0, 1024.0));
+    REQUIRE(pTile);
+    waitForFuture(asyncSystem, pTileProvider->loadTile(*pTile));
+    CHECK(pTile->getState() == RasterOverlayTile::LoadState::Loaded);
+
+    REQUIRE(pBatchAssetAccessor->batches.size() == 1);
+    CHECK(pBatchAssetAccessor->batches[0].size() > 1);
+  }
+
+  SECTION("loads decoded images from the decoded image cache") {
+    RasterOverlayOptions overlayOptions;
+    overlayOptions.pDecodedImageCache =
+        std::make_shared<CesiumAsync::MemoryCacheDatabase>(nullptr);
+
+    auto loadImage = [&]() -> ImageCesium {
+      pRasterOverlay =
+          new TileMapServiceRasterOverlay("test", tmr, {}, {}, overlayOptions);
+      RasterOverlay::CreateTileProviderResult result = waitForFuture(
+          asyncSystem,
+          pRasterOverlay->createTileProvider(
+              asyncSystem,
+              pMockAssetAccessor,
+              nullptr,
+              nullptr,
+              spdlog::default_logger(),
+              nullptr));
+      REQUIRE(result);
+
+      CesiumUtility::IntrusivePointer<RasterOverlayTileProvider>
+          pTileProvider = *result;
+      IntrusivePointer<RasterOverlayTile> pTile = pTileProvider->getTile(
+          pTileProvider->getCoverageRectangle(),
+          glm::dvec2(256.0, 256.0));
+      REQUIRE(pTile);
+      waitForFuture(asyncSystem, pTileProvider->loadTile(*pTile));
+      REQUIRE(pTile->getState() == RasterOverlayTile::LoadState::Loaded);
+      return pTile->getImage();
+    };
+
+    const ImageCesium decoded = loadImage();
+
+    // Without the images, only the decoded image cache can provide them.
+    std::shared_ptr<SimpleAssetRequest> pTilemapResource =
+        pMockAssetAccessor->mockCompletedRequests[tmr];
+    pMockAssetAccessor->mockCompletedRequests.clear();
+    pMockAssetAccessor->mockCompletedRequests[tmr] = pTilemapResource;
+
+    const ImageCesium cached = loadImage();
+    CHECK(cached.width == decoded.width);
+    CHECK(cached.height == decoded.height);
+    CHECK(cached.channels == decoded.channels);
+    CHECK(cached.pixelData == decoded.pixelData);
+  }
+
   SECTION("appends tilemapresource.xml to URL if not already present and "
           "direct request fails") {
     std::string url = "file:///" + std::filesystem::directory_entry(
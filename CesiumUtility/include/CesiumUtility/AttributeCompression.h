@@ -43,6 +43,37 @@ public:
     return glm::normalize(result);
   }
 
+  /**
+   * @brief Encodes a normalized 3-component vector in 'oct' encoding.
+   *
+   * @param vector The unit-length vector to encode.
+   * @param rangeMax The maximum value of the SNORM range. The encoded vector is
+   * stored in log2(rangeMax+1) bits.
+   * @returns The oct-encoded vector.
+   *
+   * @see AttributeCompression::octDecodeInRange
+   */
+  template <
+      typename T,
+      class = typename std::enable_if<std::is_unsigned<T>::value>::type>
+  static glm::vec<2, T> octEncodeInRange(const glm::dvec3& vector, T rangeMax) {
+    const double sum =
+        glm::abs(vector.x) + glm::abs(vector.y) + glm::abs(vector.z);
+    glm::dvec2 result(vector.x / sum, vector.y / sum);
+
+    if (vector.z < 0.0) {
+      const double oldX = result.x;
+      result.x =
+          (1.0 - glm::abs(result.y)) * CesiumUtility::Math::signNotZero(oldX);
+      result.y =
+          (1.0 - glm::abs(oldX)) * CesiumUtility::Math::signNotZero(result.y);
+    }
+
+    return glm::vec<2, T>(
+        static_cast<T>(CesiumUtility::Math::toSNorm(result.x, rangeMax)),
+        static_cast<T>(CesiumUtility::Math::toSNorm(result.y, rangeMax)));
+  }
+
   /**
    * @brief Decodes a unit-length vector in 2 byte 'oct' encoding to a
    * normalized 3-component vector.
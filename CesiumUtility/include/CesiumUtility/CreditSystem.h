@@ -90,9 +90,7 @@ public:
    * shown.
    */
   const std::vector<Credit>&
-  getCreditsToNoLongerShowThisFrame() const noexcept {
-    return _creditsToNoLongerShowThisFrame;
-  }
+  getCreditsToNoLongerShowThisFrame() const noexcept;
 
 private:
   const std::string INVALID_CREDIT_MESSAGE =
@@ -106,9 +104,15 @@ private:
   };
 
   std::vector<HtmlAndLastFrameNumber> _credits;
+  std::unordered_map<std::string, size_t> _creditIndices;
 
   int32_t _currentFrameNumber = 0;
   std::vector<Credit> _creditsToShowThisFrame;
-  std::vector<Credit> _creditsToNoLongerShowThisFrame;
+
+  // The credits shown last frame. Credits that are added to this frame again
+  // are only removed from it when it is requested, so that adding a credit
+  // doesn't need to search it.
+  mutable std::vector<Credit> _creditsToNoLongerShowThisFrame;
+  mutable bool _creditsToNoLongerShowThisFrameIsStale = false;
 };
 } // namespace CesiumUtility
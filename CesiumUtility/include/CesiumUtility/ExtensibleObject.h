@@ -1,9 +1,11 @@
 #pragma once
 
+#include "ExtensionMap.h"
 #include "JsonValue.h"
 #include "Library.h"
 
 #include <any>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -20,8 +22,7 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * @return A boolean indicating whether the extension exists.
    */
   template <typename T> bool hasExtension() const noexcept {
-    auto it = this->extensions.find(T::ExtensionName);
-    return it != this->extensions.end();
+    return this->extensions.find(T::ExtensionName) != this->extensions.end();
   }
 
   /**
@@ -32,12 +33,7 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * attached to this object.
    */
   template <typename T> const T* getExtension() const noexcept {
-    auto it = this->extensions.find(T::ExtensionName);
-    if (it == this->extensions.end()) {
-      return nullptr;
-    }
-
-    return std::any_cast<T>(&it->second);
+    return this->extensions.get<T>();
   }
 
   /** @copydoc ExtensibleObject::getExtension */
@@ -71,9 +67,12 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * @return The added extension.
    */
   template <typename T> T& addExtension() {
+    if (T* pExtension = this->extensions.get<T>()) {
+      return *pExtension;
+    }
+
     std::any& extension =
-        extensions.try_emplace(T::ExtensionName, std::make_any<T>())
-            .first->second;
+        this->extensions.emplace(T::ExtensionName, T()).first->second;
     return std::any_cast<T&>(extension);
   }
 
@@ -83,8 +82,11 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * Use {@link getExtension} to get the extension with a particular static
    * type. Use {@link getGenericExtension} to get unknown extensions as a
    * generic {@link CesiumUtility::JsonValue}.
+   *
+   * Adding or removing an extension invalidates the pointers and references to
+   * the other extensions of this object.
    */
-  std::unordered_map<std::string, std::any> extensions;
+  ExtensionMap extensions;
 
   /**
    * @brief Application-specific data.
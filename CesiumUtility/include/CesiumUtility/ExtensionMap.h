@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Library.h"
+
+#include <any>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+/**
+ * @brief The extensions of an {@link ExtensibleObject}, keyed by their names.
+ *
+ * Objects rarely have more than a few extensions, so they're stored in a
+ * vector in the order in which they were added, rather than in a hash table.
+ * A statically-typed extension is also tagged with an identifier of its type
+ * when it's added, so that {@link get} finds it without comparing its name.
+ * Looking up an extension by its name, such as an unknown extension stored as
+ * a {@link JsonValue}, compares the name with each one.
+ *
+ * The interface mirrors the parts of
+ * `std::unordered_map<std::string, std::any>` that are used for extensions,
+ * and each entry has the same `first` and `second` members as a map entry.
+ * Unlike a map, adding or removing an extension invalidates the pointers and
+ * references to the other extensions of the same object.
+ */
+class CESIUMUTILITY_API ExtensionMap {
+public:
+  /**
+   * @brief An extension.
+   */
+  struct Entry {
+    /**
+     * @brief The name of the extension.
+     */
+    std::string first;
+
+    /**
+     * @brief The extension.
+     */
+    std::any second;
+
+    /**
+     * @brief The identifier of the static type of the extension when it was
+     * added, from {@link getTypeId}, or nullptr if it was added as a
+     * `std::any`.
+     */
+    const void* typeId;
+  };
+
+  /**
+   * @brief An iterator over the extensions.
+   */
+  using iterator = std::vector<Entry>::iterator;
+
+  /**
+   * @brief A const iterator over the extensions.
+   */
+  using const_iterator = std::vector<Entry>::const_iterator;
+
+  /**
+   * @brief Gets an identifier of the given type that is unique among types.
+   */
+  template <typename T> static const void* getTypeId() noexcept {
+    static const char id = 0;
+    return &id;
+  }
+
+  /** @brief Gets an iterator to the first extension. */
+  iterator begin() noexcept { return this->_entries.begin(); }
+
+  /** @copydoc begin */
+  const_iterator begin() const noexcept { return this->_entries.begin(); }
+
+  /** @brief Gets an iterator past the last extension. */
+  iterator end() noexcept { return this->_entries.end(); }
+
+  /** @copydoc end */
+  const_iterator end() const noexcept { return this->_entries.end(); }
+
+  /** @brief Determines whether there are no extensions. */
+  bool empty() const noexcept { return this->_entries.empty(); }
+
+  /** @brief Gets the number of extensions. */
+  size_t size() const noexcept { return this->_entries.size(); }
+
+  /** @brief Removes all extensions. */
+  void clear() noexcept { this->_entries.clear(); }
+
+  /**
+   * @brief Finds the extension with the given name.
+   *
+   * @return An iterator to the extension, or {@link end} if there is none.
+   */
+  iterator find(std::string_view name) noexcept;
+
+  /** @copydoc find */
+  const_iterator find(std::string_view name) const noexcept;
+
+  /**
+   * @brief Gets the extension with the static type `T`, which has a static
+   * `ExtensionName`.
+   *
+   * An extension that was added with this type is found by its identifier,
+   * without comparing its name. Otherwise, the extension named
+   * `T::ExtensionName` is returned if it holds a `T`, which also finds the
+   * extensions added as a `std::any` or in another shared library, where the
+   * identifiers of the types differ.
+   *
+   * @return A pointer to the extension, or nullptr if there is none.
+   */
+  template <typename T> const T* get() const noexcept {
+    const void* typeId = getTypeId<T>();
+    for (const Entry& entry : this->_entries) {
+      if (entry.typeId == typeId || entry.first == T::ExtensionName) {
+        return std::any_cast<T>(&entry.second);
+      }
+    }
+    return nullptr;
+  }
+
+  /** @copydoc get */
+  template <typename T> T* get() noexcept {
+    return const_cast<T*>(std::as_const(*this).get<T>());
+  }
+
+  /**
+   * @brief Adds an extension, unless there already is one with the same name.
+   *
+   * @param name The name of the extension.
+   * @param value The extension, or a `std::any` that holds it.
+   * @return An iterator to the extension with the name, and whether it was
+   * added.
+   */
+  template <typename T>
+  std::pair<iterator, bool> emplace(std::string_view name, T&& value) {
+    iterator it = this->find(name);
+    if (it != this->end()) {
+      return {it, false};
+    }
+
+    using Value = std::decay_t<T>;
+    const void* typeId = nullptr;
+    if constexpr (!std::is_same_v<Value, std::any>) {
+      typeId = getTypeId<Value>();
+    }
+
+    this->_entries.emplace_back(
+        Entry{std::string(name), std::any(std::forward<T>(value)), typeId});
+    return {std::prev(this->_entries.end()), true};
+  }
+
+  /**
+   * @brief Removes the extension with the given name, if there is one.
+   *
+   * @return The number of extensions that were removed.
+   */
+  size_t erase(std::string_view name) noexcept;
+
+  /**
+   * @brief Removes an extension.
+   *
+   * @return An iterator to the extension after the removed one.
+   */
+  iterator erase(const_iterator it) noexcept;
+
+private:
+  std::vector<Entry> _entries;
+};
+} // namespace CesiumUtility
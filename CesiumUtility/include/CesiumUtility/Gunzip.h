@@ -8,7 +8,36 @@ extern bool isGzip(const gsl::span<const std::byte>& data);
 /**
  * Gunzip data. If successful, it will return true and the result will be in the
  * provided vector.
+ *
+ * The output is sized from the gzip trailer up front, so that a single-member
+ * stream is inflated in one step.
  */
 extern bool
 gunzip(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+
+/**
+ * Inflate deflate data with a zlib header, such as the body of a response with
+ * a `Content-Encoding` of `deflate`. If successful, it will return true and
+ * the result will be in the provided vector.
+ */
+extern bool inflateZlib(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out);
+
+/**
+ * Inflate raw deflate data, without a gzip or zlib header, such as the
+ * contents of a deflated zip archive entry. If successful, it will return true
+ * and the result will be in the provided vector.
+ */
+extern bool
+inflateRaw(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+
+/**
+ * Deflate data with a zlib header, favoring speed over size. It can be
+ * inflated again with {@link inflateZlib}. If successful, it will return true
+ * and the result will be in the provided vector.
+ */
+extern bool deflateZlib(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out);
 } // namespace CesiumUtility
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Fast non-cryptographic hashes of binary data.
+ */
+class CESIUMUTILITY_API Hash final {
+public:
+  /**
+   * @brief Computes the 64-bit xxHash (XXH64) of the given bytes.
+   *
+   * Unlike `std::hash`, the result is the same on every platform and in every
+   * run, so it can identify content across loads, such as identical images in
+   * different tiles. It reads about eight bytes at a time, so hashing even a
+   * large buffer is much faster than decoding or uploading it.
+   *
+   * @param data The bytes to hash.
+   * @param seed A value that changes the hash of every input.
+   * @return The hash.
+   */
+  static uint64_t
+  xxHash64(const gsl::span<const std::byte>& data, uint64_t seed = 0) noexcept;
+
+  /**
+   * @brief Combines two hashes into one, in an order-dependent way.
+   */
+  static uint64_t combine(uint64_t first, uint64_t second) noexcept;
+};
+
+} // namespace CesiumUtility
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace CesiumUtility {
+
+/**
+ * @brief An immutable string that is stored once per process, so that copies
+ * of it are a single pointer.
+ *
+ * Interning a string looks it up in a process-wide, thread-safe table, and
+ * adds it if it isn't already there. After that, copying, comparing, and
+ * hashing an `InternedString` never allocates or looks at its characters,
+ * and the class is trivially copyable.
+ *
+ * The interned strings are never removed from the table, so only intern
+ * strings that are likely to be seen again, or that are few, such as the
+ * content URLs of the tiles of a tileset.
+ */
+class CESIUMUTILITY_API InternedString final {
+public:
+  /**
+   * @brief Constructs an empty string.
+   */
+  constexpr InternedString() noexcept = default;
+
+  /**
+   * @brief Interns the given string.
+   */
+  InternedString(const std::string& value);
+
+  /**
+   * @brief Interns the given string.
+   */
+  InternedString(std::string_view value);
+
+  /**
+   * @brief Interns the given null-terminated string.
+   */
+  InternedString(const char* value);
+
+  /**
+   * @brief Gets the interned string.
+   */
+  const std::string& str() const noexcept;
+
+  /**
+   * @brief Gets the interned string.
+   */
+  operator const std::string&() const noexcept { return this->str(); }
+
+  /**
+   * @brief Determines whether the string is empty.
+   */
+  bool empty() const noexcept { return this->_pValue == nullptr; }
+
+  /**
+   * @brief Determines whether two interned strings are equal, by comparing
+   * their addresses.
+   */
+  bool operator==(const InternedString& rhs) const noexcept {
+    return this->_pValue == rhs._pValue;
+  }
+
+  /**
+   * @brief Determines whether two interned strings are not equal.
+   */
+  bool operator!=(const InternedString& rhs) const noexcept {
+    return this->_pValue != rhs._pValue;
+  }
+
+  /**
+   * @brief Determines whether this string is equal to another one, without
+   * interning it.
+   */
+  bool operator==(const std::string& rhs) const noexcept {
+    return this->str() == rhs;
+  }
+
+  /**
+   * @brief Determines whether this string is not equal to another one,
+   * without interning it.
+   */
+  bool operator!=(const std::string& rhs) const noexcept {
+    return this->str() != rhs;
+  }
+
+  /**
+   * @brief Determines whether this string is equal to a null-terminated one,
+   * without interning it.
+   */
+  bool operator==(const char* rhs) const noexcept {
+    return this->str() == rhs;
+  }
+
+  /**
+   * @brief Determines whether this string is not equal to a null-terminated
+   * one, without interning it.
+   */
+  bool operator!=(const char* rhs) const noexcept {
+    return this->str() != rhs;
+  }
+
+  /**
+   * @brief Orders strings by their characters, so that the order is the same
+   * in every run.
+   */
+  bool operator<(const InternedString& rhs) const noexcept {
+    return this->_pValue != rhs._pValue && this->str() < rhs.str();
+  }
+
+  /**
+   * @brief Determines whether a string is equal to an interned one, without
+   * interning it.
+   */
+  friend bool
+  operator==(const std::string& lhs, const InternedString& rhs) noexcept {
+    return rhs == lhs;
+  }
+
+  /**
+   * @brief Determines whether a string is not equal to an interned one,
+   * without interning it.
+   */
+  friend bool
+  operator!=(const std::string& lhs, const InternedString& rhs) noexcept {
+    return rhs != lhs;
+  }
+
+private:
+  // Points into the process-wide table, or is nullptr for the empty string.
+  const std::string* _pValue = nullptr;
+
+  friend struct std::hash<InternedString>;
+};
+
+} // namespace CesiumUtility
+
+namespace std {
+/**
+ * @brief A hash function for {@link CesiumUtility::InternedString} objects,
+ * which hashes their address rather than their characters.
+ */
+template <> struct hash<CesiumUtility::InternedString> {
+  /**
+   * @brief A specialization of the `std::hash` template for
+   * {@link CesiumUtility::InternedString} objects.
+   */
+  size_t operator()(const CesiumUtility::InternedString& key) const noexcept {
+    return std::hash<const std::string*>{}(key._pValue);
+  }
+};
+} // namespace std
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Library.h"
+
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A spdlog sink that passes messages on to other sinks, but drops
+ * messages that repeat too often and later reports how many were dropped.
+ *
+ * When a server starts failing, every tile that is requested from it logs the
+ * same error with a different URL, and writing thousands of such messages per
+ * second can slow down the threads that log them. This sink groups messages by
+ * their level and text with every run of digits treated as the same, so that
+ * the errors for `tiles/3/5/2.b3dm` and `tiles/4/11/6.b3dm` are grouped
+ * together. Only the first `maximumMessagesPerInterval` messages of a group in
+ * each interval are passed on. The number of dropped messages, along with the
+ * last of them, is passed on as a single message when the group's next
+ * message arrives after the interval, or when the sink is flushed.
+ *
+ * Use {@link createLogger} to wrap an existing logger, such as the one in
+ * `TilesetExternals::pLogger`.
+ */
+class CESIUMUTILITY_API RateLimitedLogSink final
+    : public spdlog::sinks::base_sink<std::mutex> {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param sinks The sinks to pass the messages on to.
+   * @param interval The length of the interval in which the messages of a
+   * group are counted.
+   * @param maximumMessagesPerInterval The number of messages of a group that
+   * are passed on in each interval.
+   */
+  RateLimitedLogSink(
+      std::vector<spdlog::sink_ptr> sinks,
+      std::chrono::milliseconds interval = std::chrono::seconds(1),
+      size_t maximumMessagesPerInterval = 1);
+
+  /**
+   * @brief Creates a logger that logs to the sinks of an existing logger
+   * through a {@link RateLimitedLogSink}.
+   *
+   * The new logger has the name, level, and flush level of the existing one.
+   *
+   * @param pLogger The existing logger.
+   * @param interval The length of the interval in which the messages of a
+   * group are counted.
+   * @param maximumMessagesPerInterval The number of messages of a group that
+   * are passed on in each interval.
+   * @param logInBackground Whether to pass the messages to the sinks in a
+   * background thread, so that the threads that log only pay for formatting
+   * the message text. The background thread is shared by all of the loggers
+   * created this way. If it falls behind, the oldest messages waiting for it
+   * are dropped rather than blocking the threads that log.
+   */
+  static std::shared_ptr<spdlog::logger> createLogger(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      std::chrono::milliseconds interval = std::chrono::seconds(1),
+      size_t maximumMessagesPerInterval = 1,
+      bool logInBackground = false);
+
+protected:
+  /** @private */
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+
+  /** @private */
+  void flush_() override;
+
+private:
+  struct Group {
+    spdlog::log_clock::time_point intervalStart;
+    size_t messagesInInterval = 0;
+    size_t droppedMessages = 0;
+    spdlog::level::level_enum lastDroppedLevel = spdlog::level::off;
+    std::string lastDroppedLoggerName;
+    std::string lastDroppedMessage;
+  };
+
+  void forward(const spdlog::details::log_msg& msg);
+  void reportDropped(Group& group);
+  void removeExpiredGroups(spdlog::log_clock::time_point now);
+
+  std::vector<spdlog::sink_ptr> _sinks;
+  std::chrono::milliseconds _interval;
+  size_t _maximumMessagesPerInterval;
+  std::unordered_map<std::string, Group> _groups;
+  std::string _scratchKey;
+};
+
+} // namespace CesiumUtility
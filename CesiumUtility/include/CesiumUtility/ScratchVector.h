@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A vector for temporary data that reuses the memory of the earlier
+ * scratch vectors of the same type in the same thread.
+ *
+ * Decoding a tile needs temporary arrays that are freed when it is done, and
+ * allocating them again for every tile, from many worker threads at once,
+ * costs time in the allocator and touches cold memory. A `ScratchVector`
+ * instead takes a vector from a small pool that belongs to the current thread,
+ * and gives it back, with its capacity, when it is destroyed. So when a worker
+ * thread decodes one tile after another, the temporaries of each tile reuse
+ * the warm memory of the last.
+ *
+ * The vector is empty when the `ScratchVector` is created. Its size is reset
+ * when it is returned to the pool, so it must not be used for anything that
+ * outlives the `ScratchVector`; move the data out or copy it instead. A pool
+ * keeps a few vectors, and a vector with a very large capacity is freed
+ * rather than kept, so that one huge tile doesn't hold on to its memory.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T> class ScratchVector final {
+public:
+  /**
+   * @brief The most vectors of this type that each thread keeps.
+   */
+  static constexpr size_t maximumPooledVectors = 8;
+
+  /**
+   * @brief The capacity in bytes above which a vector is freed instead of
+   * being kept.
+   */
+  static constexpr size_t maximumPooledBytes = size_t(64) * 1024 * 1024;
+
+  /**
+   * @brief Takes an empty vector from the current thread's pool, or creates
+   * one if the pool is empty.
+   */
+  ScratchVector() {
+    std::vector<std::vector<T>>& pool = getPool();
+    if (!pool.empty()) {
+      this->_vector = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+
+  /**
+   * @brief Returns the vector to the current thread's pool.
+   */
+  ~ScratchVector() noexcept {
+    if (this->_vector.capacity() == 0 ||
+        this->_vector.capacity() > maximumPooledBytes / sizeof(T)) {
+      return;
+    }
+
+    // The pool's capacity is reserved up front, so this doesn't allocate.
+    std::vector<std::vector<T>>& pool = getPool();
+    if (pool.size() < maximumPooledVectors) {
+      this->_vector.clear();
+      pool.emplace_back(std::move(this->_vector));
+    }
+  }
+
+  ScratchVector(const ScratchVector&) = delete;
+  ScratchVector& operator=(const ScratchVector&) = delete;
+
+  /**
+   * @brief Gets the vector.
+   */
+  std::vector<T>& operator*() noexcept { return this->_vector; }
+
+  /**
+   * @brief Gets the vector.
+   */
+  std::vector<T>* operator->() noexcept { return &this->_vector; }
+
+private:
+  static std::vector<std::vector<T>>& getPool() {
+    static thread_local std::vector<std::vector<T>> pool = []() {
+      std::vector<std::vector<T>> result;
+      result.reserve(maximumPooledVectors);
+      return result;
+    }();
+    return pool;
+  }
+
+  std::vector<T> _vector;
+};
+
+} // namespace CesiumUtility
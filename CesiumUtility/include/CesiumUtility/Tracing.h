@@ -1,5 +1,11 @@
 #pragma once
 
+// A project that defines CESIUM_OVERRIDE_TRACING provides its own definitions
+// of all the CESIUM_TRACE* macros below, for example by force-including a
+// header that maps them to its engine's profiler. To forward traces to an
+// external profiler while keeping this implementation, install a
+// CesiumUtility::ITracingListener instead.
+
 #ifndef CESIUM_OVERRIDE_TRACING
 
 // If the build system doesn't enable the tracing support
@@ -12,27 +18,49 @@
 
 #define CESIUM_TRACE_INIT(filename)
 #define CESIUM_TRACE_SHUTDOWN()
+#define CESIUM_TRACE_DUMP(filename)
+#define CESIUM_TRACE_SET_CATEGORIES(categories)
+#define CESIUM_TRACE_SET_LISTENER(pListener)
 #define CESIUM_TRACE(name)
+#define CESIUM_TRACE_CATEGORY(category, name)
 #define CESIUM_TRACE_BEGIN(name)
 #define CESIUM_TRACE_END(name)
 #define CESIUM_TRACE_BEGIN_IN_TRACK(name)
 #define CESIUM_TRACE_END_IN_TRACK(name)
+#define CESIUM_TRACE_BEGIN_IN_TRACK_CATEGORY(category, name)
+#define CESIUM_TRACE_END_IN_TRACK_CATEGORY(category, name)
 #define CESIUM_TRACE_DECLARE_TRACK_SET(id, name)
 #define CESIUM_TRACE_USE_TRACK_SET(id)
 #define CESIUM_TRACE_LAMBDA_CAPTURE_TRACK() tracingTrack = false
 #define CESIUM_TRACE_USE_CAPTURED_TRACK()
+#define CESIUM_TRACE_ALLOC(pointer, size, pool)
+#define CESIUM_TRACE_FREE(pointer, pool)
 
 #else
 
+// If the build system doesn't choose the ring buffer backend, traces are
+// written to the file as they happen.
+#ifndef CESIUM_TRACING_RING_BUFFER
+#define CESIUM_TRACING_RING_BUFFER 0
+#endif
+
 #include <atomic>
 #include <cassert>
 #include <chrono>
 #include <fstream>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+#if CESIUM_TRACING_RING_BUFFER
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#endif
+
 // helper macros to avoid shadowing variables
 #define TRACE_NAME_AUX1(A, B) A##B
 #define TRACE_NAME_AUX2(A, B) TRACE_NAME_AUX1(A, B)
@@ -41,6 +69,11 @@
  * @brief Initializes the tracing framework and begins recording to a given JSON
  * filename.
  *
+ * All categories of traces are recorded until
+ * {@link CESIUM_TRACE_SET_CATEGORIES} chooses otherwise. Before tracing is
+ * initialized, and after it is shut down, no traces are recorded and each
+ * `CESIUM_TRACE*` macro costs one relaxed atomic load.
+ *
  * @param filename The path and named of the file in which to record traces.
  */
 #define CESIUM_TRACE_INIT(filename)                                            \
@@ -48,10 +81,60 @@
 
 /**
  * @brief Shuts down tracing and closes the JSON tracing file.
+ *
+ * With the ring buffer backend (`CESIUM_TRACING_RING_BUFFER`), this is when
+ * the recorded traces are written to the file given to
+ * {@link CESIUM_TRACE_INIT}.
  */
 #define CESIUM_TRACE_SHUTDOWN()                                                \
   CesiumUtility::CesiumImpl::Tracer::instance().endTracing()
 
+/**
+ * @brief Chooses which categories of traces are recorded, while tracing is
+ * initialized.
+ *
+ * This can be called at any time, so tracing can be compiled into a release
+ * and only turned on while diagnosing a problem. A measurement that is in
+ * progress when its category is turned off is still ended.
+ *
+ * @param categories The {@link CesiumUtility::TracingCategory} flags to record,
+ * combined with `|`.
+ */
+#define CESIUM_TRACE_SET_CATEGORIES(categories)                                \
+  CesiumUtility::CesiumImpl::Tracer::setEnabledCategories(categories)
+
+/**
+ * @brief Forwards all traces to a listener, in addition to recording them.
+ *
+ * The listener receives traces whose categories are enabled
+ * ({@link CESIUM_TRACE_SET_CATEGORIES}), even if {@link CESIUM_TRACE_INIT}
+ * was never called, so it can be the only place traces go.
+ *
+ * @param pListener The {@link CesiumUtility::ITracingListener}, or nullptr to
+ * stop forwarding traces. It must stay alive until it is replaced.
+ */
+#define CESIUM_TRACE_SET_LISTENER(pListener)                                   \
+  CesiumUtility::CesiumImpl::Tracer::instance().setListener(pListener)
+
+#if CESIUM_TRACING_RING_BUFFER
+/**
+ * @brief Writes the traces recorded so far to a JSON file, without ending
+ * tracing.
+ *
+ * Only the ring buffer backend (`CESIUM_TRACING_RING_BUFFER`) records traces
+ * in memory; otherwise this does nothing. Each thread's buffer holds its most
+ * recent {@link CesiumUtility::CesiumImpl::Tracer::ringBufferCapacity}
+ * events, so older events are lost and the oldest written slices may be
+ * missing their beginning.
+ *
+ * @param filename The path and name of the file in which to write the traces.
+ */
+#define CESIUM_TRACE_DUMP(filename)                                            \
+  CesiumUtility::CesiumImpl::Tracer::instance().dumpTracing(filename)
+#else
+#define CESIUM_TRACE_DUMP(filename)
+#endif
+
 /**
  * @brief Measures and records the time spent in the current scope.
  *
@@ -67,6 +150,23 @@
       cesiumTrace,                                                             \
       __LINE__)(name)
 
+/**
+ * @brief Measures and records the time spent in the current scope, if the
+ * given category is being recorded.
+ *
+ * This macro is identical to {@link CESIUM_TRACE} except that the measurement
+ * belongs to the given category rather than to
+ * {@link CesiumUtility::TracingCategory::General}.
+ *
+ * @param category The name of a {@link CesiumUtility::TracingCategory}, such
+ * as `Decode`.
+ * @param name The name of the measured operation.
+ */
+#define CESIUM_TRACE_CATEGORY(category, name)                                  \
+  CesiumUtility::CesiumImpl::ScopedTrace TRACE_NAME_AUX2(                      \
+      cesiumTrace,                                                             \
+      __LINE__)(name, CesiumUtility::TracingCategory::category)
+
 /**
  * @brief Begins measuring an operation which may span scope but not threads.
  *
@@ -143,6 +243,42 @@
     CESIUM_TRACE_END(name);                                                    \
   }
 
+/**
+ * @brief Begins measuring an operation that may span both scopes and threads,
+ * if the given category is being recorded.
+ *
+ * This macro is identical to {@link CESIUM_TRACE_BEGIN_IN_TRACK} except that
+ * the measurement belongs to the given category. End it with
+ * {@link CESIUM_TRACE_END_IN_TRACK_CATEGORY} and the same category.
+ *
+ * @param category The name of a {@link CesiumUtility::TracingCategory}, such
+ * as `Network`.
+ * @param name The name of the measured operation.
+ */
+#define CESIUM_TRACE_BEGIN_IN_TRACK_CATEGORY(category, name)                   \
+  if (CesiumUtility::CesiumImpl::TrackReference::current() != nullptr) {       \
+    CesiumUtility::CesiumImpl::Tracer::instance().writeAsyncEventBegin(        \
+        name,                                                                  \
+        CesiumUtility::TracingCategory::category);                             \
+  }
+
+/**
+ * @brief Ends measuring an operation that may span both scopes and threads,
+ * if the given category is being recorded.
+ *
+ * See {@link CESIUM_TRACE_BEGIN_IN_TRACK_CATEGORY}.
+ *
+ * @param category The name of a {@link CesiumUtility::TracingCategory}, such
+ * as `Network`.
+ * @param name The name of the measured operation.
+ */
+#define CESIUM_TRACE_END_IN_TRACK_CATEGORY(category, name)                     \
+  if (CesiumUtility::CesiumImpl::TrackReference::current() != nullptr) {       \
+    CesiumUtility::CesiumImpl::Tracer::instance().writeAsyncEventEnd(          \
+        name,                                                                  \
+        CesiumUtility::TracingCategory::category);                             \
+  }
+
 /**
  * @brief Declares a set of tracing tracks as a field inside a class.
  *
@@ -198,7 +334,141 @@
 #define CESIUM_TRACE_USE_CAPTURED_TRACK()                                      \
   CESIUM_TRACE_USE_TRACK_SET(tracingTrack)
 
+/**
+ * @brief Reports an allocation to the tracing listener, if there is one.
+ *
+ * The JSON trace file doesn't record allocations. Each allocation must be
+ * matched by a {@link CESIUM_TRACE_FREE} with the same pointer and pool.
+ *
+ * @param pointer A pointer identifying the allocation.
+ * @param size The size of the allocation in bytes.
+ * @param pool A string literal naming the kind of allocation.
+ */
+#define CESIUM_TRACE_ALLOC(pointer, size, pool)                                \
+  CesiumUtility::CesiumImpl::Tracer::instance().writeAllocation(               \
+      pointer,                                                                 \
+      size,                                                                    \
+      pool)
+
+/**
+ * @brief Reports that an allocation reported with {@link CESIUM_TRACE_ALLOC}
+ * was freed.
+ *
+ * @param pointer The pointer identifying the allocation.
+ * @param pool The pool of the allocation.
+ */
+#define CESIUM_TRACE_FREE(pointer, pool)                                       \
+  CesiumUtility::CesiumImpl::Tracer::instance().writeFree(pointer, pool)
+
 namespace CesiumUtility {
+
+/**
+ * @brief Flags for the categories of traces, which can be turned on and off
+ * at runtime with {@link CESIUM_TRACE_SET_CATEGORIES}.
+ */
+enum class TracingCategory : uint32_t {
+  /** @brief No traces. */
+  None = 0,
+
+  /** @brief Traces that don't name a category. */
+  General = 1U << 0,
+
+  /** @brief Work done in the main thread to update a tileset's view. */
+  MainThread = 1U << 1,
+
+  /** @brief Choosing the tiles to load and render. */
+  Selection = 1U << 2,
+
+  /** @brief Requests for tiles and other assets. */
+  Network = 1U << 3,
+
+  /** @brief Reading and writing the asset cache. */
+  Cache = 1U << 4,
+
+  /** @brief Decoding glTFs, images, and terrain. */
+  Decode = 1U << 5,
+
+  /** @brief Loading and upsampling for raster overlays. */
+  Raster = 1U << 6,
+
+  /** @brief All traces. */
+  All = 0xffffffffU
+};
+
+/**
+ * @brief Combines the flags of two sets of tracing categories.
+ */
+constexpr TracingCategory
+operator|(TracingCategory lhs, TracingCategory rhs) noexcept {
+  return TracingCategory(uint32_t(lhs) | uint32_t(rhs));
+}
+
+/**
+ * @brief Receives traces as they are recorded, so that they can be forwarded
+ * to an external profiler such as Tracy or the Perfetto SDK.
+ *
+ * Slices in a track may begin and end in different threads, and slices of
+ * different tracks may be in progress in the same thread at once, so a
+ * profiler that only has per-thread zones should map each track to a fiber or
+ * an async track of its own. The methods are called from any thread,
+ * concurrently, and must be thread-safe.
+ */
+class ITracingListener {
+public:
+  virtual ~ITracingListener() = default;
+
+  /**
+   * @brief A track was created.
+   *
+   * @param name The name of the track.
+   * @param trackID The ID of the track, which is never reused.
+   */
+  virtual void beginTrack(const char* name, int64_t trackID) = 0;
+
+  /**
+   * @brief A track was destroyed. No more slices will be recorded in it.
+   *
+   * @param trackID The ID of the track.
+   */
+  virtual void endTrack(int64_t trackID) = 0;
+
+  /**
+   * @brief A slice began.
+   *
+   * @param name The name of the slice. It is only valid during the call.
+   * @param trackID The ID of the track of the slice, or -1 if the slice isn't
+   * in a track, in which case it ends in the same thread and is nested in the
+   * slices in progress in that thread.
+   */
+  virtual void beginSlice(const char* name, int64_t trackID) = 0;
+
+  /**
+   * @brief A slice ended.
+   *
+   * @param name The name of the slice. It is only valid during the call.
+   * @param trackID The ID of the track of the slice, or -1.
+   */
+  virtual void endSlice(const char* name, int64_t trackID) = 0;
+
+  /**
+   * @brief Memory was allocated, as reported by {@link CESIUM_TRACE_ALLOC}.
+   *
+   * @param pointer The pointer identifying the allocation.
+   * @param size The size of the allocation in bytes.
+   * @param pool The name of the kind of allocation, a string literal.
+   */
+  virtual void
+  allocate(const void* pointer, int64_t size, const char* pool) = 0;
+
+  /**
+   * @brief Memory was freed, as reported by {@link CESIUM_TRACE_FREE}.
+   *
+   * @param pointer The pointer identifying the allocation.
+   * @param pool The name of the kind of allocation, a string literal.
+   */
+  virtual void free(const void* pointer, const char* pool) = 0;
+};
+
 namespace CesiumImpl {
 
 // The following are internal classes used by the tracing framework, do not use
@@ -215,18 +485,45 @@ class TrackReference;
 
 class Tracer {
 public:
+#if CESIUM_TRACING_RING_BUFFER
+  // The number of most recent events kept for each thread. A power of two.
+  static constexpr uint64_t ringBufferCapacity = uint64_t(1) << 16;
+#endif
+
   static Tracer& instance();
 
   ~Tracer();
 
   void startTracing(const std::string& filePath = "trace.json");
   void endTracing();
+#if CESIUM_TRACING_RING_BUFFER
+  void dumpTracing(const std::string& filePath);
+#endif
+
+  static bool isEnabled(TracingCategory category) noexcept {
+    return (_enabledCategories.load(std::memory_order_relaxed) &
+            uint32_t(category)) != 0;
+  }
+  static void setEnabledCategories(TracingCategory categories) noexcept;
+
+  void setListener(ITracingListener* pListener) noexcept;
+  ITracingListener* getListener() const noexcept {
+    return this->_pListener.load(std::memory_order_acquire);
+  }
 
   void writeCompleteEvent(const Trace& trace);
+  void writeTrackBegin(const char* name, int64_t id);
+  void writeTrackEnd(const char* name, int64_t id);
+  void writeAllocation(const void* pointer, int64_t size, const char* pool);
+  void writeFree(const void* pointer, const char* pool);
   void writeAsyncEventBegin(const char* name, int64_t id);
-  void writeAsyncEventBegin(const char* name);
+  void writeAsyncEventBegin(
+      const char* name,
+      TracingCategory category = TracingCategory::General);
   void writeAsyncEventEnd(const char* name, int64_t id);
-  void writeAsyncEventEnd(const char* name);
+  void writeAsyncEventEnd(
+      const char* name,
+      TracingCategory category = TracingCategory::General);
 
   int64_t allocateTrackID();
 
@@ -240,16 +537,51 @@ private:
       char type,
       int64_t id);
 
+#if CESIUM_TRACING_RING_BUFFER
+  struct ThreadBuffer;
+
+  void recordEvent(
+      const std::string_view& name,
+      char type,
+      int64_t timestamp,
+      int64_t duration,
+      int64_t id);
+  ThreadBuffer& getThreadBuffer();
+  uint32_t getNameID(ThreadBuffer& buffer, const std::string_view& name);
+
+  std::string _filePath;
+  std::atomic<bool> _recording;
+  std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+  std::deque<std::string> _names;
+  std::unordered_map<std::string_view, uint32_t> _nameIDs;
+#else
   std::ofstream _output;
   uint32_t _numTraces;
+#endif
   std::mutex _lock;
   std::atomic<int64_t> _lastAllocatedID;
+  std::atomic<ITracingListener*> _pListener;
+
+  static std::atomic<uint32_t> _enabledCategories;
 };
 
 class ScopedTrace {
 public:
-  explicit ScopedTrace(const std::string& message);
-  ~ScopedTrace();
+  // Inline so that a trace whose category isn't recorded costs only the check.
+  explicit ScopedTrace(
+      const std::string_view& message,
+      TracingCategory category = TracingCategory::General)
+      : _state{} {
+    if (Tracer::isEnabled(category)) {
+      this->begin(message, category);
+    }
+  }
+
+  ~ScopedTrace() {
+    if (this->_state) {
+      this->reset();
+    }
+  }
 
   void reset();
 
@@ -259,10 +591,16 @@ public:
   ScopedTrace& operator=(ScopedTrace&& rhs) = delete;
 
 private:
-  std::string _name;
-  std::chrono::steady_clock::time_point _startTime;
-  std::thread::id _threadId;
-  bool _reset;
+  struct State {
+    std::string name;
+    std::chrono::steady_clock::time_point startTime;
+    std::thread::id threadId;
+  };
+
+  void begin(const std::string_view& message, TracingCategory category);
+
+  // Empty unless the trace is being measured.
+  std::optional<State> _state;
 };
 
 class TrackSet {
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Library.h"
+
+#include <memory>
+#include <string>
+
+namespace CesiumUtility {
+
+/**
+ * @brief Resolves relative URIs against a base URI that is parsed only once.
+ *
+ * {@link Uri::resolve} parses the base URI on every call. Loaders that
+ * resolve the URI of every tile against the same base should keep one of
+ * these instead. The result is the same as {@link Uri::resolve}.
+ *
+ * The const methods may be called from multiple threads at once.
+ */
+class CESIUMUTILITY_API UriResolver final {
+public:
+  /**
+   * @brief Parses the given base URI.
+   *
+   * If it cannot be parsed, {@link resolve} returns the relative URI
+   * unmodified, as {@link Uri::resolve} does.
+   *
+   * @param base The base URI.
+   */
+  explicit UriResolver(const std::string& base);
+
+  /** @brief Parses the base URI of another instance again. */
+  UriResolver(const UriResolver& rhs);
+
+  /** @brief Moves the parsed base URI of another instance. */
+  UriResolver(UriResolver&& rhs) noexcept;
+
+  ~UriResolver() noexcept;
+
+  /** @brief Parses the base URI of another instance again. */
+  UriResolver& operator=(const UriResolver& rhs);
+
+  /** @brief Moves the parsed base URI of another instance. */
+  UriResolver& operator=(UriResolver&& rhs) noexcept;
+
+  /**
+   * @brief Gets the base URI that was passed to the constructor.
+   */
+  const std::string& getBase() const noexcept;
+
+  /**
+   * @brief Resolves a URI relative to the base URI.
+   *
+   * @param relative The relative URI. If it is absolute, it is returned
+   * normalized.
+   * @param useBaseQuery Whether to append the query parameters of the base URI
+   * to the resolved URI.
+   * @return The resolved URI, or `relative` if it cannot be parsed or
+   * resolved.
+   */
+  std::string
+  resolve(const std::string& relative, bool useBaseQuery = false) const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> _pImpl;
+};
+
+} // namespace CesiumUtility
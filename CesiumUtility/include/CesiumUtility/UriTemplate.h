@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Library.h"
+#include "Uri.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A URI template, such as `{z}/{x}/{y}.png`, that is split into its
+ * literal text and its placeholders only once.
+ *
+ * {@link Uri::substituteTemplateParameters} searches the template for
+ * placeholders on every call. Tile providers that substitute the same
+ * template for every tile should keep one of these instead. The result is the
+ * same as {@link Uri::substituteTemplateParameters}.
+ */
+class CESIUMUTILITY_API UriTemplate final {
+public:
+  /**
+   * @brief Creates an empty template, which substitutes to an empty string.
+   */
+  UriTemplate() = default;
+
+  /**
+   * @brief Splits the given template into literal text and placeholders.
+   *
+   * A placeholder is the text between a `{` and the next `}`. A template with
+   * an unclosed placeholder is not rejected here; instead, {@link substitute}
+   * throws, as {@link Uri::substituteTemplateParameters} does.
+   *
+   * @param templateUri The URI template.
+   */
+  explicit UriTemplate(const std::string& templateUri);
+
+  /**
+   * @brief Gets the template that was passed to the constructor.
+   */
+  const std::string& getTemplate() const noexcept { return this->_template; }
+
+  /**
+   * @brief Gets the names of the placeholders, without braces, in the order
+   * in which they appear in the template.
+   */
+  const std::vector<std::string>& getPlaceholders() const noexcept {
+    return this->_placeholders;
+  }
+
+  /**
+   * @brief Replaces each placeholder with the value returned by the callback.
+   *
+   * @param substitutionCallback The function that returns the value for the
+   * name of a placeholder.
+   * @return The URI with all placeholders replaced.
+   * @throws std::runtime_error If the template has an unclosed placeholder.
+   */
+  std::string substitute(
+      const std::function<Uri::SubstitutionCallbackSignature>&
+          substitutionCallback) const;
+
+private:
+  std::string _template;
+
+  // The text before each placeholder, followed by the text after the last.
+  std::vector<std::string> _literals{std::string()};
+  std::vector<std::string> _placeholders;
+  size_t _literalsLength = 0;
+  bool _isUnclosed = false;
+};
+
+} // namespace CesiumUtility
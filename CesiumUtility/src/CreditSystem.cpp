@@ -10,17 +10,16 @@ Credit CreditSystem::createCredit(const std::string& html, bool showOnScreen) {
 
 Credit CreditSystem::createCredit(std::string&& html, bool showOnScreen) {
   // if this credit already exists, return a Credit handle to it
-  for (size_t id = 0; id < _credits.size(); ++id) {
-    if (_credits[id].html == html) {
-      // Override the existing credit's showOnScreen value.
-      _credits[id].showOnScreen = showOnScreen;
-      return Credit(id);
-    }
+  auto [it, inserted] = _creditIndices.emplace(html, _credits.size());
+  if (!inserted) {
+    // Override the existing credit's showOnScreen value.
+    _credits[it->second].showOnScreen = showOnScreen;
+    return Credit(it->second);
   }
 
   _credits.push_back({std::move(html), showOnScreen, -1, 0});
 
-  return Credit(_credits.size() - 1);
+  return Credit(it->second);
 }
 
 bool CreditSystem::shouldBeShownOnScreen(Credit credit) const noexcept {
@@ -54,15 +53,10 @@ void CreditSystem::addCreditToFrame(Credit credit) {
   // add the credit to this frame
   _creditsToShowThisFrame.push_back(credit);
 
-  // if the credit was shown last frame, remove it from
-  // _creditsToNoLongerShowThisFrame since it will still be shown
+  // if the credit was shown last frame, it will still be shown, so it has to
+  // be removed from _creditsToNoLongerShowThisFrame before that is used
   if (_credits[credit.id].lastFrameNumber == _currentFrameNumber - 1) {
-    _creditsToNoLongerShowThisFrame.erase(
-        std::remove(
-            _creditsToNoLongerShowThisFrame.begin(),
-            _creditsToNoLongerShowThisFrame.end(),
-            credit),
-        _creditsToNoLongerShowThisFrame.end());
+    _creditsToNoLongerShowThisFrameIsStale = true;
   }
 
   // update the last frame this credit was shown
@@ -72,6 +66,7 @@ void CreditSystem::addCreditToFrame(Credit credit) {
 void CreditSystem::startNextFrame() noexcept {
   _creditsToNoLongerShowThisFrame.swap(_creditsToShowThisFrame);
   _creditsToShowThisFrame.clear();
+  _creditsToNoLongerShowThisFrameIsStale = false;
   _currentFrameNumber++;
   for (const auto& credit : _creditsToNoLongerShowThisFrame) {
     _credits[credit.id].count = 0;
@@ -96,4 +91,23 @@ const std::vector<Credit>& CreditSystem::getCreditsToShowThisFrame() noexcept {
       });
   return _creditsToShowThisFrame;
 }
+
+const std::vector<Credit>&
+CreditSystem::getCreditsToNoLongerShowThisFrame() const noexcept {
+  // remove the credits that were added to this frame since the last call, all
+  // at once, keeping the order of the others
+  if (_creditsToNoLongerShowThisFrameIsStale) {
+    _creditsToNoLongerShowThisFrame.erase(
+        std::remove_if(
+            _creditsToNoLongerShowThisFrame.begin(),
+            _creditsToNoLongerShowThisFrame.end(),
+            [this](const Credit& credit) {
+              return _credits[credit.id].lastFrameNumber ==
+                     _currentFrameNumber;
+            }),
+        _creditsToNoLongerShowThisFrame.end());
+    _creditsToNoLongerShowThisFrameIsStale = false;
+  }
+  return _creditsToNoLongerShowThisFrame;
+}
 } // namespace CesiumUtility
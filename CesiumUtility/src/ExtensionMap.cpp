@@ -0,0 +1,36 @@
+#include "CesiumUtility/ExtensionMap.h"
+
+#include <algorithm>
+
+namespace CesiumUtility {
+
+ExtensionMap::iterator ExtensionMap::find(std::string_view name) noexcept {
+  return std::find_if(
+      this->_entries.begin(),
+      this->_entries.end(),
+      [name](const Entry& entry) { return entry.first == name; });
+}
+
+ExtensionMap::const_iterator
+ExtensionMap::find(std::string_view name) const noexcept {
+  return std::find_if(
+      this->_entries.begin(),
+      this->_entries.end(),
+      [name](const Entry& entry) { return entry.first == name; });
+}
+
+size_t ExtensionMap::erase(std::string_view name) noexcept {
+  const_iterator it = this->find(name);
+  if (it == this->end()) {
+    return 0;
+  }
+
+  this->_entries.erase(it);
+  return 1;
+}
+
+ExtensionMap::iterator ExtensionMap::erase(const_iterator it) noexcept {
+  return this->_entries.erase(it);
+}
+
+} // namespace CesiumUtility
@@ -2,6 +2,10 @@
 #define ZLIB_CONST
 #include "zlib.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
 #define CHUNK 65536
 
 bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
@@ -11,18 +15,46 @@ bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
   return data[0] == std::byte{31} && data[1] == std::byte{139};
 }
 
-bool CesiumUtility::gunzip(
+namespace {
+// The smallest gzip stream is a 10-byte header and an 8-byte trailer.
+constexpr size_t minimumGzipSize = 18;
+
+// Deflate can't compress by more than about 1032:1, so a larger size in the
+// gzip trailer is corrupt, and must not be used to size the output.
+constexpr size_t maximumDeflateRatio = 1032;
+
+// Reads the ISIZE field of the gzip trailer, which is the size of the
+// uncompressed data modulo 2^32, or returns zero if it isn't plausible.
+size_t getGzipSizeHint(const gsl::span<const std::byte>& data) {
+  if (data.size() < minimumGzipSize) {
+    return 0;
+  }
+
+  const size_t offset = data.size() - 4;
+  const uint32_t isize = uint32_t(data[offset]) |
+                         (uint32_t(data[offset + 1]) << 8) |
+                         (uint32_t(data[offset + 2]) << 16) |
+                         (uint32_t(data[offset + 3]) << 24);
+  if (size_t(isize) > data.size() * maximumDeflateRatio) {
+    return 0;
+  }
+  return size_t(isize);
+}
+
+bool inflateWithWindowBits(
     const gsl::span<const std::byte>& data,
-    std::vector<std::byte>& out) {
+    std::vector<std::byte>& out,
+    int windowBits,
+    size_t sizeHint) {
   int ret;
-  unsigned int index = 0;
+  size_t index = 0;
   z_stream strm;
   strm.zalloc = Z_NULL;
   strm.zfree = Z_NULL;
   strm.opaque = Z_NULL;
   strm.avail_in = 0;
   strm.next_in = Z_NULL;
-  ret = inflateInit2(&strm, 16 + MAX_WBITS);
+  ret = inflateInit2(&strm, windowBits);
   if (ret != Z_OK) {
     return false;
   }
@@ -30,22 +62,83 @@ bool CesiumUtility::gunzip(
   strm.avail_in = static_cast<uInt>(data.size());
   strm.next_in = reinterpret_cast<const Bytef*>(data.data());
 
+  // With the right size, the whole stream inflates in one call. Otherwise,
+  // the output grows geometrically, rather than a chunk at a time.
+  out.resize(sizeHint > 0 ? sizeHint : CHUNK);
   do {
-    out.resize(index + CHUNK);
+    if (index == out.size()) {
+      out.resize(index + std::max(index / 2, size_t(CHUNK)));
+    }
+
+    const size_t available = std::min(
+        out.size() - index,
+        size_t(std::numeric_limits<uInt>::max()));
     strm.next_out = reinterpret_cast<Bytef*>(&out[index]);
-    strm.avail_out = CHUNK;
-    ret = inflate(&strm, Z_NO_FLUSH);
+    strm.avail_out = static_cast<uInt>(available);
+    ret = inflate(&strm, Z_FINISH);
+    index += available - strm.avail_out;
+
     switch (ret) {
     case Z_NEED_DICT:
     case Z_DATA_ERROR:
     case Z_MEM_ERROR:
+    case Z_STREAM_ERROR:
       inflateEnd(&strm);
       return false;
+    case Z_BUF_ERROR:
+      // Out of output space is fine, but out of input means a truncated
+      // stream.
+      if (strm.avail_out != 0) {
+        inflateEnd(&strm);
+        return false;
+      }
+      break;
     }
-    index += CHUNK - strm.avail_out;
   } while (ret != Z_STREAM_END);
 
   inflateEnd(&strm);
   out.resize(index);
   return true;
 }
+} // namespace
+
+bool CesiumUtility::gunzip(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  return inflateWithWindowBits(
+      data,
+      out,
+      16 + MAX_WBITS,
+      getGzipSizeHint(data));
+}
+
+bool CesiumUtility::inflateZlib(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  return inflateWithWindowBits(data, out, MAX_WBITS, 0);
+}
+
+bool CesiumUtility::inflateRaw(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  return inflateWithWindowBits(data, out, -MAX_WBITS, 0);
+}
+
+bool CesiumUtility::deflateZlib(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  uLongf size = compressBound(static_cast<uLong>(data.size()));
+  out.resize(size_t(size));
+  const int ret = compress2(
+      reinterpret_cast<Bytef*>(out.data()),
+      &size,
+      reinterpret_cast<const Bytef*>(data.data()),
+      static_cast<uLong>(data.size()),
+      Z_BEST_SPEED);
+  if (ret != Z_OK) {
+    out.clear();
+    return false;
+  }
+  out.resize(size_t(size));
+  return true;
+}
@@ -0,0 +1,106 @@
+#include "CesiumUtility/Hash.h"
+
+#include <cstring>
+
+namespace CesiumUtility {
+
+namespace {
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t rotateLeft(uint64_t value, int bits) noexcept {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// The input is read as little-endian, like every platform we support.
+uint64_t read64(const std::byte* pData) noexcept {
+  uint64_t value;
+  std::memcpy(&value, pData, sizeof(value));
+  return value;
+}
+
+uint32_t read32(const std::byte* pData) noexcept {
+  uint32_t value;
+  std::memcpy(&value, pData, sizeof(value));
+  return value;
+}
+
+uint64_t round(uint64_t accumulator, uint64_t input) noexcept {
+  accumulator += input * Prime2;
+  accumulator = rotateLeft(accumulator, 31);
+  return accumulator * Prime1;
+}
+
+uint64_t mergeRound(uint64_t accumulator, uint64_t value) noexcept {
+  accumulator ^= round(0, value);
+  return accumulator * Prime1 + Prime4;
+}
+} // namespace
+
+/*static*/ uint64_t
+Hash::xxHash64(const gsl::span<const std::byte>& data, uint64_t seed) noexcept {
+  const std::byte* pCurrent = data.data();
+  const std::byte* const pEnd = pCurrent + data.size();
+
+  uint64_t hash;
+  if (data.size() >= 32) {
+    uint64_t v1 = seed + Prime1 + Prime2;
+    uint64_t v2 = seed + Prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - Prime1;
+
+    const std::byte* const pLastStripe = pEnd - 32;
+    do {
+      v1 = round(v1, read64(pCurrent));
+      v2 = round(v2, read64(pCurrent + 8));
+      v3 = round(v3, read64(pCurrent + 16));
+      v4 = round(v4, read64(pCurrent + 24));
+      pCurrent += 32;
+    } while (pCurrent <= pLastStripe);
+
+    hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) +
+           rotateLeft(v4, 18);
+    hash = mergeRound(hash, v1);
+    hash = mergeRound(hash, v2);
+    hash = mergeRound(hash, v3);
+    hash = mergeRound(hash, v4);
+  } else {
+    hash = seed + Prime5;
+  }
+
+  hash += uint64_t(data.size());
+
+  while (pEnd - pCurrent >= 8) {
+    hash ^= round(0, read64(pCurrent));
+    hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+    pCurrent += 8;
+  }
+
+  if (pEnd - pCurrent >= 4) {
+    hash ^= uint64_t(read32(pCurrent)) * Prime1;
+    hash = rotateLeft(hash, 23) * Prime2 + Prime3;
+    pCurrent += 4;
+  }
+
+  while (pCurrent < pEnd) {
+    hash ^= uint64_t(*pCurrent) * Prime5;
+    hash = rotateLeft(hash, 11) * Prime1;
+    ++pCurrent;
+  }
+
+  hash ^= hash >> 33;
+  hash *= Prime2;
+  hash ^= hash >> 29;
+  hash *= Prime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/*static*/ uint64_t Hash::combine(uint64_t first, uint64_t second) noexcept {
+  return mergeRound(first, second);
+}
+
+} // namespace CesiumUtility
@@ -0,0 +1,67 @@
+#include "CesiumUtility/InternedString.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+namespace CesiumUtility {
+
+namespace {
+// The table is split into shards with their own locks, so that threads that
+// intern different strings at once rarely wait for each other.
+class InternTable {
+public:
+  const std::string* intern(const std::string& value) {
+    const size_t hash = std::hash<std::string>{}(value);
+    Shard& shard = this->_shards[hash % this->_shards.size()];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.strings.find(value);
+    if (it == shard.strings.end()) {
+      it = shard.strings.insert(value).first;
+    }
+
+    // The elements of an unordered_set never move, so their addresses are
+    // stable.
+    return &*it;
+  }
+
+private:
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_set<std::string> strings;
+  };
+
+  std::array<Shard, 16> _shards;
+};
+
+InternTable& getInternTable() {
+  // Never destroyed, so that interned strings stay valid while other static
+  // objects are destroyed.
+  static InternTable* pTable = new InternTable();
+  return *pTable;
+}
+
+const std::string* intern(const std::string& value) {
+  if (value.empty()) {
+    return nullptr;
+  }
+  return getInternTable().intern(value);
+}
+} // namespace
+
+InternedString::InternedString(const std::string& value)
+    : _pValue(intern(value)) {}
+
+InternedString::InternedString(std::string_view value)
+    : _pValue(value.empty() ? nullptr : intern(std::string(value))) {}
+
+InternedString::InternedString(const char* value)
+    : _pValue(value && *value ? intern(std::string(value)) : nullptr) {}
+
+const std::string& InternedString::str() const noexcept {
+  static const std::string empty;
+  return this->_pValue ? *this->_pValue : empty;
+}
+
+} // namespace CesiumUtility
@@ -0,0 +1,161 @@
+#include <CesiumUtility/RateLimitedLogSink.h>
+
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+
+#include <utility>
+
+namespace CesiumUtility {
+
+namespace {
+// Above this many groups, the groups whose interval has ended are removed, so
+// that messages that never repeat don't grow the map forever.
+constexpr size_t maximumGroups = 1024;
+
+// Builds the key of a message's group from its level and its text with every
+// run of digits replaced by a single '#'.
+void makeGroupKey(const spdlog::details::log_msg& msg, std::string& key) {
+  key.clear();
+  key += char('0' + int(msg.level));
+
+  const char* pCurrent = msg.payload.data();
+  const char* pEnd = pCurrent + msg.payload.size();
+  bool inDigits = false;
+  for (; pCurrent != pEnd; ++pCurrent) {
+    const char c = *pCurrent;
+    if (c >= '0' && c <= '9') {
+      if (!inDigits) {
+        key += '#';
+        inDigits = true;
+      }
+    } else {
+      key += c;
+      inDigits = false;
+    }
+  }
+}
+
+std::shared_ptr<spdlog::details::thread_pool> getBackgroundThreadPool() {
+  // One thread for every rate-limited logger, which lives until the program
+  // exits.
+  static const std::shared_ptr<spdlog::details::thread_pool> pThreadPool =
+      std::make_shared<spdlog::details::thread_pool>(8192, 1);
+  return pThreadPool;
+}
+} // namespace
+
+RateLimitedLogSink::RateLimitedLogSink(
+    std::vector<spdlog::sink_ptr> sinks,
+    std::chrono::milliseconds interval,
+    size_t maximumMessagesPerInterval)
+    : _sinks(std::move(sinks)),
+      _interval(interval),
+      _maximumMessagesPerInterval(maximumMessagesPerInterval),
+      _groups(),
+      _scratchKey() {}
+
+/*static*/ std::shared_ptr<spdlog::logger> RateLimitedLogSink::createLogger(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    std::chrono::milliseconds interval,
+    size_t maximumMessagesPerInterval,
+    bool logInBackground) {
+  auto pSink = std::make_shared<RateLimitedLogSink>(
+      pLogger->sinks(),
+      interval,
+      maximumMessagesPerInterval);
+
+  std::shared_ptr<spdlog::logger> pResult;
+  if (logInBackground) {
+    pResult = std::make_shared<spdlog::async_logger>(
+        pLogger->name(),
+        std::move(pSink),
+        getBackgroundThreadPool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+  } else {
+    pResult =
+        std::make_shared<spdlog::logger>(pLogger->name(), std::move(pSink));
+  }
+
+  pResult->set_level(pLogger->level());
+  pResult->flush_on(pLogger->flush_level());
+  return pResult;
+}
+
+void RateLimitedLogSink::sink_it_(const spdlog::details::log_msg& msg) {
+  makeGroupKey(msg, this->_scratchKey);
+
+  auto [it, added] = this->_groups.try_emplace(this->_scratchKey);
+  Group& group = it->second;
+
+  if (added || msg.time - group.intervalStart >= this->_interval) {
+    this->reportDropped(group);
+    group.intervalStart = msg.time;
+    group.messagesInInterval = 0;
+  }
+
+  if (group.messagesInInterval < this->_maximumMessagesPerInterval) {
+    ++group.messagesInInterval;
+    this->forward(msg);
+  } else {
+    ++group.droppedMessages;
+    group.lastDroppedLevel = msg.level;
+    group.lastDroppedLoggerName.assign(
+        msg.logger_name.data(),
+        msg.logger_name.size());
+    group.lastDroppedMessage.assign(msg.payload.data(), msg.payload.size());
+  }
+
+  if (added && this->_groups.size() > maximumGroups) {
+    this->removeExpiredGroups(msg.time);
+  }
+}
+
+void RateLimitedLogSink::flush_() {
+  for (auto& [key, group] : this->_groups) {
+    this->reportDropped(group);
+  }
+
+  for (const spdlog::sink_ptr& pSink : this->_sinks) {
+    pSink->flush();
+  }
+}
+
+void RateLimitedLogSink::forward(const spdlog::details::log_msg& msg) {
+  for (const spdlog::sink_ptr& pSink : this->_sinks) {
+    if (pSink->should_log(msg.level)) {
+      pSink->log(msg);
+    }
+  }
+}
+
+void RateLimitedLogSink::reportDropped(Group& group) {
+  if (group.droppedMessages == 0) {
+    return;
+  }
+
+  const std::string text = fmt::format(
+      "{} similar messages were not logged. The last was: {}",
+      group.droppedMessages,
+      group.lastDroppedMessage);
+  const spdlog::details::log_msg summary(
+      group.lastDroppedLoggerName,
+      group.lastDroppedLevel,
+      text);
+  this->forward(summary);
+
+  group.droppedMessages = 0;
+}
+
+void RateLimitedLogSink::removeExpiredGroups(
+    spdlog::log_clock::time_point now) {
+  for (auto it = this->_groups.begin(); it != this->_groups.end();) {
+    if (now - it->second.intervalStart >= this->_interval) {
+      this->reportDropped(it->second);
+      it = this->_groups.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // namespace CesiumUtility
@@ -18,12 +18,286 @@ Tracer& Tracer::instance() {
 
 Tracer::~Tracer() { endTracing(); }
 
+/*static*/ std::atomic<uint32_t> Tracer::_enabledCategories{0};
+
+/*static*/ void
+Tracer::setEnabledCategories(TracingCategory categories) noexcept {
+  Tracer::_enabledCategories.store(
+      uint32_t(categories),
+      std::memory_order_relaxed);
+}
+
+#if CESIUM_TRACING_RING_BUFFER
+
+namespace {
+int64_t toMicroseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::time_point_cast<std::chrono::microseconds>(time)
+      .time_since_epoch()
+      .count();
+}
+
+// An event as it is copied out of a ring buffer.
+struct RecordedEvent {
+  int64_t timestamp;
+  int64_t duration;
+  int64_t id;
+  uint32_t nameID;
+  char type;
+};
+} // namespace
+
+// The most recent events of one thread. Only that thread writes to it, and
+// any thread may read it while it is being written.
+struct Tracer::ThreadBuffer {
+  // Each field is atomic so that reading an event while it is overwritten is
+  // not a data race. Torn events are detected with `writing` and dropped.
+  struct Event {
+    std::atomic<int64_t> timestamp;
+    std::atomic<int64_t> duration;
+    std::atomic<int64_t> id;
+    std::atomic<uint64_t> nameAndType;
+  };
+
+  explicit ThreadBuffer(uint32_t threadIndex_)
+      : threadIndex(threadIndex_),
+        events(std::make_unique<Event[]>(ringBufferCapacity)) {}
+
+  // The index of this thread in the trace, used as its `tid`.
+  uint32_t threadIndex;
+  std::unique_ptr<Event[]> events;
+
+  // The number of events that were completely written.
+  std::atomic<uint64_t> written{0};
+  // The number of events whose writing has started.
+  std::atomic<uint64_t> writing{0};
+  // The number of events written before tracing was last started.
+  std::atomic<uint64_t> first{0};
+
+  // This thread's cache of the tracer's name IDs, so that a name is only
+  // looked up under the lock the first time the thread uses it. The keys view
+  // the tracer's names.
+  std::unordered_map<std::string_view, uint32_t> nameIDs;
+};
+
+Tracer::Tracer()
+    : _filePath{},
+      _recording{false},
+      _threadBuffers{},
+      _names{},
+      _nameIDs{},
+      _lock{},
+      _lastAllocatedID(0),
+      _pListener(nullptr) {}
+
+void Tracer::startTracing(const std::string& filePath) {
+  std::lock_guard<std::mutex> lock(_lock);
+  this->_filePath = filePath;
+  for (const std::shared_ptr<ThreadBuffer>& pBuffer : this->_threadBuffers) {
+    pBuffer->first.store(
+        pBuffer->written.load(std::memory_order_acquire),
+        std::memory_order_relaxed);
+  }
+  this->_recording.store(true, std::memory_order_release);
+  Tracer::setEnabledCategories(TracingCategory::All);
+}
+
+void Tracer::endTracing() {
+  Tracer::setEnabledCategories(TracingCategory::None);
+  if (!this->_recording.exchange(false)) {
+    return;
+  }
+
+  std::string filePath;
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    filePath = this->_filePath;
+  }
+  this->dumpTracing(filePath);
+}
+
+void Tracer::dumpTracing(const std::string& filePath) {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    buffers = this->_threadBuffers;
+  }
+
+  // Copy the events out of the buffers first, so that the threads writing to
+  // them aren't held up while the file is written.
+  std::vector<std::vector<RecordedEvent>> bufferEvents(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const ThreadBuffer& buffer = *buffers[i];
+    const uint64_t end = buffer.written.load(std::memory_order_acquire);
+    uint64_t begin = buffer.first.load(std::memory_order_relaxed);
+    if (end - begin > ringBufferCapacity) {
+      begin = end - ringBufferCapacity;
+    }
+
+    std::vector<RecordedEvent>& events = bufferEvents[i];
+    events.reserve(size_t(end - begin));
+    for (uint64_t j = begin; j < end; ++j) {
+      const ThreadBuffer::Event& event =
+          buffer.events[size_t(j & (ringBufferCapacity - 1))];
+      const uint64_t nameAndType =
+          event.nameAndType.load(std::memory_order_relaxed);
+      events.push_back(RecordedEvent{
+          event.timestamp.load(std::memory_order_relaxed),
+          event.duration.load(std::memory_order_relaxed),
+          event.id.load(std::memory_order_relaxed),
+          uint32_t(nameAndType >> 8),
+          char(nameAndType & 0xff)});
+    }
+
+    // Drop the events that were overwritten while they were copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t writing = buffer.writing.load(std::memory_order_relaxed);
+    if (writing > begin + ringBufferCapacity) {
+      const uint64_t overwritten =
+          std::min(writing - begin - ringBufferCapacity, end - begin);
+      events.erase(events.begin(), events.begin() + int64_t(overwritten));
+    }
+  }
+
+  std::ofstream output(filePath);
+  output << "{\"otherData\": {},\"traceEvents\":[";
+
+  std::lock_guard<std::mutex> lock(_lock);
+  bool isFirst = true;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    for (const RecordedEvent& event : bufferEvents[i]) {
+      // Chrome tracing wants the text like this
+      if (!isFirst) {
+        output << ",";
+      }
+      isFirst = false;
+
+      output << "{";
+      output << "\"cat\":\"cesium\",";
+      if (event.type == 'X') {
+        output << "\"dur\":" << event.duration << ',';
+      }
+      if (event.id >= 0) {
+        output << "\"id\":" << event.id << ",";
+      } else {
+        output << "\"tid\":" << buffers[i]->threadIndex << ",";
+      }
+      output << "\"name\":\"" << this->_names[event.nameID] << "\",";
+      output << "\"ph\":\"" << event.type << "\",";
+      output << "\"pid\":0,";
+      output << "\"ts\":" << event.timestamp;
+      output << "}";
+    }
+  }
+
+  output << "]}";
+}
+
+void Tracer::writeCompleteEvent(const Trace& trace) {
+  this->recordEvent(trace.name, 'X', trace.start, trace.duration, -1);
+}
+
+void Tracer::writeAsyncEvent(
+    const char* /* category */,
+    const char* name,
+    char type,
+    int64_t id) {
+  if (id < 0) {
+    // Use a standard Duration event for slices without an async ID.
+    if (type == 'b') {
+      type = 'B';
+    } else if (type == 'e') {
+      type = 'E';
+    }
+  }
+
+  this->recordEvent(
+      name,
+      type,
+      toMicroseconds(std::chrono::steady_clock::now()),
+      0,
+      id);
+}
+
+void Tracer::recordEvent(
+    const std::string_view& name,
+    char type,
+    int64_t timestamp,
+    int64_t duration,
+    int64_t id) {
+  if (!this->_recording.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  ThreadBuffer& buffer = this->getThreadBuffer();
+  const uint32_t nameID = this->getNameID(buffer, name);
+
+  // Claim the slot before writing it, so that a concurrent dump that sees
+  // any of the new values also sees that the old event is gone.
+  const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  buffer.writing.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  ThreadBuffer::Event& event =
+      buffer.events[size_t(index & (ringBufferCapacity - 1))];
+  event.timestamp.store(timestamp, std::memory_order_relaxed);
+  event.duration.store(duration, std::memory_order_relaxed);
+  event.id.store(id, std::memory_order_relaxed);
+  event.nameAndType.store(
+      (uint64_t(nameID) << 8) | uint64_t(uint8_t(type)),
+      std::memory_order_relaxed);
+
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+  // The tracer shares ownership so that the events of threads that have
+  // exited are still written.
+  thread_local std::shared_ptr<ThreadBuffer> pBuffer;
+  if (!pBuffer) {
+    std::lock_guard<std::mutex> lock(_lock);
+    pBuffer = std::make_shared<ThreadBuffer>(
+        static_cast<uint32_t>(this->_threadBuffers.size()));
+    this->_threadBuffers.emplace_back(pBuffer);
+  }
+  return *pBuffer;
+}
+
+uint32_t
+Tracer::getNameID(ThreadBuffer& buffer, const std::string_view& name) {
+  auto it = buffer.nameIDs.find(name);
+  if (it != buffer.nameIDs.end()) {
+    return it->second;
+  }
+
+  std::lock_guard<std::mutex> lock(_lock);
+  auto tracerIt = this->_nameIDs.find(name);
+  if (tracerIt == this->_nameIDs.end()) {
+    const uint32_t nameID = static_cast<uint32_t>(this->_names.size());
+    const std::string_view storedName = this->_names.emplace_back(name);
+    tracerIt = this->_nameIDs.emplace(storedName, nameID).first;
+  }
+
+  buffer.nameIDs.emplace(tracerIt->first, tracerIt->second);
+  return tracerIt->second;
+}
+
+#else
+
+Tracer::Tracer()
+    : _output{},
+      _numTraces{0},
+      _lock{},
+      _lastAllocatedID(0),
+      _pListener(nullptr) {}
+
 void Tracer::startTracing(const std::string& filePath) {
   this->_output.open(filePath);
   this->_output << "{\"otherData\": {},\"traceEvents\":[";
+  Tracer::setEnabledCategories(TracingCategory::All);
 }
 
 void Tracer::endTracing() {
+  Tracer::setEnabledCategories(TracingCategory::None);
   this->_output << "]}";
   this->_output.close();
 }
@@ -50,31 +324,6 @@ void Tracer::writeCompleteEvent(const Trace& trace) {
   this->_output << "}";
 }
 
-void Tracer::writeAsyncEventBegin(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'b', id);
-}
-
-void Tracer::writeAsyncEventBegin(const char* name) {
-  this->writeAsyncEventBegin(name, this->getCurrentThreadTrackID());
-}
-
-void Tracer::writeAsyncEventEnd(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'e', id);
-}
-
-void Tracer::writeAsyncEventEnd(const char* name) {
-  this->writeAsyncEventEnd(name, this->getCurrentThreadTrackID());
-}
-
-int64_t Tracer::allocateTrackID() { return ++this->_lastAllocatedID; }
-
-Tracer::Tracer() : _output{}, _numTraces{0}, _lock{}, _lastAllocatedID(0) {}
-
-int64_t Tracer::getCurrentThreadTrackID() const {
-  const TrackReference* pTrack = TrackReference::current();
-  return pTrack->getTracingID();
-}
-
 void Tracer::writeAsyncEvent(
     const char* category,
     const char* name,
@@ -121,29 +370,103 @@ void Tracer::writeAsyncEvent(
   this->_output << "}";
 }
 
-ScopedTrace::ScopedTrace(const std::string& message)
-    : _name{message},
-      _startTime{std::chrono::steady_clock::now()},
-      _threadId{std::this_thread::get_id()},
-      _reset{false} {
-  CESIUM_TRACE_BEGIN_IN_TRACK(_name.c_str());
+#endif // CESIUM_TRACING_RING_BUFFER
+
+void Tracer::setListener(ITracingListener* pListener) noexcept {
+  this->_pListener.store(pListener, std::memory_order_release);
 }
 
-ScopedTrace::~ScopedTrace() {
-  if (!this->_reset) {
-    this->reset();
+void Tracer::writeTrackBegin(const char* name, int64_t id) {
+  this->writeAsyncEvent("cesium", name, 'b', id);
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->beginTrack(name, id);
   }
 }
 
-void ScopedTrace::reset() {
-  this->_reset = true;
+void Tracer::writeTrackEnd(const char* name, int64_t id) {
+  this->writeAsyncEvent("cesium", name, 'e', id);
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->endTrack(id);
+  }
+}
+
+void Tracer::writeAllocation(
+    const void* pointer,
+    int64_t size,
+    const char* pool) {
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->allocate(pointer, size, pool);
+  }
+}
+
+void Tracer::writeFree(const void* pointer, const char* pool) {
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->free(pointer, pool);
+  }
+}
 
+void Tracer::writeAsyncEventBegin(const char* name, int64_t id) {
+  this->writeAsyncEvent("cesium", name, 'b', id);
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->beginSlice(name, id);
+  }
+}
+
+void Tracer::writeAsyncEventBegin(const char* name, TracingCategory category) {
+  if (Tracer::isEnabled(category)) {
+    this->writeAsyncEventBegin(name, this->getCurrentThreadTrackID());
+  }
+}
+
+void Tracer::writeAsyncEventEnd(const char* name, int64_t id) {
+  this->writeAsyncEvent("cesium", name, 'e', id);
+  if (ITracingListener* pListener = this->getListener()) {
+    pListener->endSlice(name, id);
+  }
+}
+
+void Tracer::writeAsyncEventEnd(const char* name, TracingCategory category) {
+  if (Tracer::isEnabled(category)) {
+    this->writeAsyncEventEnd(name, this->getCurrentThreadTrackID());
+  }
+}
+
+int64_t Tracer::allocateTrackID() { return ++this->_lastAllocatedID; }
+
+int64_t Tracer::getCurrentThreadTrackID() const {
+  const TrackReference* pTrack = TrackReference::current();
+  return pTrack->getTracingID();
+}
+
+void ScopedTrace::begin(
+    const std::string_view& message,
+    TracingCategory category) {
+  const State& state = this->_state.emplace(State{
+      std::string(message),
+      std::chrono::steady_clock::now(),
+      std::this_thread::get_id()});
   if (TrackReference::current() != nullptr) {
-    CESIUM_TRACE_END(_name.c_str());
+    Tracer::instance().writeAsyncEventBegin(state.name.c_str(), category);
+  } else if (ITracingListener* pListener = Tracer::instance().getListener()) {
+    pListener->beginSlice(state.name.c_str(), -1);
+  }
+}
+
+void ScopedTrace::reset() {
+  if (!this->_state) {
+    return;
+  }
+
+  const TrackReference* pTrack = TrackReference::current();
+  if (pTrack != nullptr) {
+    // End the measurement even if its category was turned off since it began.
+    Tracer::instance().writeAsyncEventEnd(
+        this->_state->name.c_str(),
+        pTrack->getTracingID());
   } else {
     auto endTimePoint = std::chrono::steady_clock::now();
     int64_t start = std::chrono::time_point_cast<std::chrono::microseconds>(
-                        this->_startTime)
+                        this->_state->startTime)
                         .time_since_epoch()
                         .count();
     int64_t end =
@@ -151,8 +474,13 @@ void ScopedTrace::reset() {
             .time_since_epoch()
             .count();
     Tracer::instance().writeCompleteEvent(
-        {this->_name, start, end - start, this->_threadId});
+        {this->_state->name, start, end - start, this->_state->threadId});
+    if (ITracingListener* pListener = Tracer::instance().getListener()) {
+      pListener->endSlice(this->_state->name.c_str(), -1);
+    }
   }
+
+  this->_state.reset();
 }
 
 TrackSet::TrackSet(const char* name_) : name(name_) {}
@@ -161,7 +489,7 @@ TrackSet::~TrackSet() {
   std::scoped_lock lock(this->mutex);
   for (auto& track : this->tracks) {
     assert(!track.inUse);
-    Tracer::instance().writeAsyncEventEnd(
+    Tracer::instance().writeTrackEnd(
         (this->name + " " + std::to_string(track.id)).c_str(),
         track.id);
   }
@@ -180,7 +508,7 @@ size_t TrackSet::acquireTrack() {
     return size_t(it - this->tracks.begin());
   } else {
     Track track{Tracer::instance().allocateTrackID(), true};
-    Tracer::instance().writeAsyncEventBegin(
+    Tracer::instance().writeTrackBegin(
         (this->name + " " + std::to_string(track.id)).c_str(),
         track.id);
     size_t index = this->tracks.size();
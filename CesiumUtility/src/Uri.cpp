@@ -1,5 +1,6 @@
 #include "CesiumUtility/Uri.h"
 
+#include <CesiumUtility/UriResolver.h>
 #include <CesiumUtility/joinToString.h>
 
 #include <uriparser/Uri.h>
@@ -14,75 +15,7 @@ std::string Uri::resolve(
     const std::string& base,
     const std::string& relative,
     bool useBaseQuery) {
-  UriUriA baseUri;
-
-  if (uriParseSingleUriA(&baseUri, base.c_str(), nullptr) != URI_SUCCESS) {
-    // Could not parse the base, so just use the relative directly and hope for
-    // the best.
-    return relative;
-  }
-
-  UriUriA relativeUri;
-  if (uriParseSingleUriA(&relativeUri, relative.c_str(), nullptr) !=
-      URI_SUCCESS) {
-    // Could not parse one of the URLs, so just use the relative directly and
-    // hope for the best.
-    uriFreeUriMembersA(&baseUri);
-    return relative;
-  }
-
-  UriUriA resolvedUri;
-  if (uriAddBaseUriA(&resolvedUri, &relativeUri, &baseUri) != URI_SUCCESS) {
-    uriFreeUriMembersA(&resolvedUri);
-    uriFreeUriMembersA(&relativeUri);
-    uriFreeUriMembersA(&baseUri);
-    return relative;
-  }
-
-  if (uriNormalizeSyntaxA(&resolvedUri) != URI_SUCCESS) {
-    uriFreeUriMembersA(&resolvedUri);
-    uriFreeUriMembersA(&relativeUri);
-    uriFreeUriMembersA(&baseUri);
-    return relative;
-  }
-
-  int charsRequired;
-  if (uriToStringCharsRequiredA(&resolvedUri, &charsRequired) != URI_SUCCESS) {
-    uriFreeUriMembersA(&resolvedUri);
-    uriFreeUriMembersA(&relativeUri);
-    uriFreeUriMembersA(&baseUri);
-    return relative;
-  }
-
-  std::string result(static_cast<size_t>(charsRequired), ' ');
-
-  if (uriToStringA(
-          const_cast<char*>(result.c_str()),
-          &resolvedUri,
-          charsRequired + 1,
-          nullptr) != URI_SUCCESS) {
-    uriFreeUriMembersA(&resolvedUri);
-    uriFreeUriMembersA(&relativeUri);
-    uriFreeUriMembersA(&baseUri);
-    return relative;
-  }
-
-  if (useBaseQuery) {
-    std::string query(baseUri.query.first, baseUri.query.afterLast);
-    if (query.length() > 0) {
-      if (resolvedUri.query.first) {
-        result += "&" + query;
-      } else {
-        result += "?" + query;
-      }
-    }
-  }
-
-  uriFreeUriMembersA(&resolvedUri);
-  uriFreeUriMembersA(&relativeUri);
-  uriFreeUriMembersA(&baseUri);
-
-  return result;
+  return UriResolver(base).resolve(relative, useBaseQuery);
 }
 
 std::string Uri::addQuery(
@@ -90,10 +23,14 @@ std::string Uri::addQuery(
     const std::string& key,
     const std::string& value) {
   // TODO
-  if (uri.find('?') != std::string::npos) {
-    return uri + "&" + key + "=" + value;
-  }
-  return uri + "?" + key + "=" + value;
+  std::string result;
+  result.reserve(uri.size() + key.size() + value.size() + 2);
+  result += uri;
+  result += uri.find('?') != std::string::npos ? '&' : '?';
+  result += key;
+  result += '=';
+  result += value;
+  return result;
   // UriUriA baseUri;
 
   // if (uriParseSingleUriA(&baseUri, uri.c_str(), nullptr) != URI_SUCCESS)
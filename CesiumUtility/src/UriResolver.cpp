@@ -0,0 +1,124 @@
+#include "CesiumUtility/UriResolver.h"
+
+#include <uriparser/Uri.h>
+
+namespace CesiumUtility {
+
+struct UriResolver::Impl {
+  explicit Impl(const std::string& base_) : base(base_) {
+    // The parsed URI points into `base`, which never moves, because the
+    // Impl is only ever owned through a pointer.
+    this->isParsed =
+        uriParseSingleUriA(&this->uri, this->base.c_str(), nullptr) ==
+        URI_SUCCESS;
+    if (this->isParsed && this->uri.query.first) {
+      this->query.assign(this->uri.query.first, this->uri.query.afterLast);
+    }
+  }
+
+  ~Impl() noexcept {
+    if (this->isParsed) {
+      uriFreeUriMembersA(&this->uri);
+    }
+  }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+
+  std::string base;
+  UriUriA uri;
+  bool isParsed;
+  std::string query;
+};
+
+UriResolver::UriResolver(const std::string& base)
+    : _pImpl(std::make_unique<Impl>(base)) {}
+
+UriResolver::UriResolver(const UriResolver& rhs)
+    : _pImpl(std::make_unique<Impl>(rhs.getBase())) {}
+
+UriResolver::UriResolver(UriResolver&& rhs) noexcept = default;
+
+UriResolver::~UriResolver() noexcept = default;
+
+UriResolver& UriResolver::operator=(const UriResolver& rhs) {
+  if (this != &rhs) {
+    this->_pImpl = std::make_unique<Impl>(rhs.getBase());
+  }
+  return *this;
+}
+
+UriResolver& UriResolver::operator=(UriResolver&& rhs) noexcept = default;
+
+const std::string& UriResolver::getBase() const noexcept {
+  static const std::string empty;
+  return this->_pImpl ? this->_pImpl->base : empty;
+}
+
+std::string
+UriResolver::resolve(const std::string& relative, bool useBaseQuery) const {
+  if (!this->_pImpl || !this->_pImpl->isParsed) {
+    // Could not parse the base, so just use the relative directly and hope for
+    // the best.
+    return relative;
+  }
+
+  UriUriA relativeUri;
+  if (uriParseSingleUriA(&relativeUri, relative.c_str(), nullptr) !=
+      URI_SUCCESS) {
+    // Could not parse one of the URLs, so just use the relative directly and
+    // hope for the best.
+    return relative;
+  }
+
+  UriUriA resolvedUri;
+  if (uriAddBaseUriA(&resolvedUri, &relativeUri, &this->_pImpl->uri) !=
+      URI_SUCCESS) {
+    uriFreeUriMembersA(&resolvedUri);
+    uriFreeUriMembersA(&relativeUri);
+    return relative;
+  }
+
+  if (uriNormalizeSyntaxA(&resolvedUri) != URI_SUCCESS) {
+    uriFreeUriMembersA(&resolvedUri);
+    uriFreeUriMembersA(&relativeUri);
+    return relative;
+  }
+
+  int charsRequired;
+  if (uriToStringCharsRequiredA(&resolvedUri, &charsRequired) != URI_SUCCESS) {
+    uriFreeUriMembersA(&resolvedUri);
+    uriFreeUriMembersA(&relativeUri);
+    return relative;
+  }
+
+  const std::string& query = this->_pImpl->query;
+  const bool appendQuery = useBaseQuery && !query.empty();
+
+  // Make room for the base query up front, so that appending it doesn't
+  // reallocate.
+  std::string result;
+  result.reserve(
+      static_cast<size_t>(charsRequired) +
+      (appendQuery ? query.size() + 1 : 0));
+  result.resize(static_cast<size_t>(charsRequired));
+
+  if (uriToStringA(result.data(), &resolvedUri, charsRequired + 1, nullptr) !=
+      URI_SUCCESS) {
+    uriFreeUriMembersA(&resolvedUri);
+    uriFreeUriMembersA(&relativeUri);
+    return relative;
+  }
+
+  if (appendQuery) {
+    result += resolvedUri.query.first ? '&' : '?';
+    result += query;
+  }
+
+  uriFreeUriMembersA(&resolvedUri);
+  uriFreeUriMembersA(&relativeUri);
+
+  return result;
+}
+
+} // namespace CesiumUtility
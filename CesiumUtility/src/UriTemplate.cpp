@@ -0,0 +1,58 @@
+#include "CesiumUtility/UriTemplate.h"
+
+#include <stdexcept>
+
+namespace CesiumUtility {
+
+UriTemplate::UriTemplate(const std::string& templateUri)
+    : _template(templateUri) {
+  size_t startPos = 0;
+  size_t nextPos;
+
+  // Find the start of a parameter
+  while ((nextPos = templateUri.find('{', startPos)) != std::string::npos) {
+    this->_literals.back().assign(templateUri, startPos, nextPos - startPos);
+
+    // Find the end of this parameter
+    ++nextPos;
+    const size_t endPos = templateUri.find('}', nextPos);
+    if (endPos == std::string::npos) {
+      this->_isUnclosed = true;
+      return;
+    }
+
+    this->_placeholders.emplace_back(
+        templateUri.substr(nextPos, endPos - nextPos));
+    this->_literalsLength += this->_literals.back().size();
+    this->_literals.emplace_back();
+
+    startPos = endPos + 1;
+  }
+
+  this->_literals.back().assign(
+      templateUri,
+      startPos,
+      templateUri.length() - startPos);
+  this->_literalsLength += this->_literals.back().size();
+}
+
+std::string UriTemplate::substitute(
+    const std::function<Uri::SubstitutionCallbackSignature>&
+        substitutionCallback) const {
+  if (this->_isUnclosed) {
+    throw std::runtime_error("Unclosed template parameter");
+  }
+
+  std::string result;
+  result.reserve(this->_literalsLength + 8 * this->_placeholders.size());
+
+  result.append(this->_literals[0]);
+  for (size_t i = 0; i < this->_placeholders.size(); ++i) {
+    result.append(substitutionCallback(this->_placeholders[i]));
+    result.append(this->_literals[i + 1]);
+  }
+
+  return result;
+}
+
+} // namespace CesiumUtility
@@ -46,6 +46,42 @@ TEST_CASE("AttributeCompression::octDecode") {
   }
 }
 
+TEST_CASE("AttributeCompression::octEncodeInRange") {
+  const std::vector<glm::dvec3> input{
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec3(0.0, 0.0, -1.0),
+      glm::dvec3(0.0, 1.0, 0.0),
+      glm::dvec3(-1.0, 0.0, 0.0),
+      glm::normalize(glm::dvec3(1.0, -1.0, 1.0)),
+      glm::normalize(glm::dvec3(-1.0, 2.0, -3.0)),
+  };
+
+  SECTION("matches the 2 byte encoding decoded by octDecode") {
+    CHECK(
+        AttributeCompression::octEncodeInRange(input[0], uint8_t(255)) ==
+        glm::u8vec2(128, 128));
+    CHECK(
+        AttributeCompression::octEncodeInRange(input[1], uint8_t(255)) ==
+        glm::u8vec2(255, 255));
+    CHECK(
+        AttributeCompression::octEncodeInRange(input[2], uint8_t(255)) ==
+        glm::u8vec2(128, 255));
+  }
+
+  SECTION("round-trips through octDecodeInRange") {
+    constexpr uint16_t rangeMax = 65535;
+    for (const glm::dvec3& vector : input) {
+      const glm::u16vec2 encoded =
+          AttributeCompression::octEncodeInRange(vector, rangeMax);
+      const glm::dvec3 decoded = AttributeCompression::octDecodeInRange(
+          encoded.x,
+          encoded.y,
+          rangeMax);
+      CHECK(Math::equalsEpsilon(decoded, vector, Math::Epsilon3));
+    }
+  }
+}
+
 TEST_CASE("AttributeCompression::decodeRGB565") {
   const std::vector<uint16_t> input{
       0,
@@ -0,0 +1,117 @@
+#include <CesiumUtility/ExtensibleObject.h>
+#include <CesiumUtility/ExtensionMap.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <any>
+#include <string>
+
+using namespace CesiumUtility;
+
+namespace {
+struct ExtensionA {
+  static inline constexpr const char* ExtensionName = "EXT_a";
+  int value = 1;
+};
+
+struct ExtensionB {
+  static inline constexpr const char* ExtensionName = "EXT_b";
+  std::string value = "b";
+};
+} // namespace
+
+TEST_CASE("ExtensionMap") {
+  ExtensionMap extensions;
+
+  SECTION("is empty at first") {
+    CHECK(extensions.empty());
+    CHECK(extensions.size() == 0);
+    CHECK(extensions.begin() == extensions.end());
+    CHECK(extensions.find("EXT_a") == extensions.end());
+    CHECK(extensions.get<ExtensionA>() == nullptr);
+  }
+
+  SECTION("keeps extensions in the order they were added") {
+    extensions.emplace("EXT_b", ExtensionB());
+    extensions.emplace("EXT_a", ExtensionA());
+    extensions.emplace("EXT_unknown", JsonValue(JsonValue::Object()));
+
+    REQUIRE(extensions.size() == 3);
+    auto it = extensions.begin();
+    CHECK(it->first == "EXT_b");
+    CHECK((++it)->first == "EXT_a");
+    CHECK((++it)->first == "EXT_unknown");
+  }
+
+  SECTION("finds extensions by type and by name") {
+    extensions.emplace("EXT_unknown", JsonValue(JsonValue::Object()));
+    extensions.emplace("EXT_a", ExtensionA{5});
+
+    const ExtensionA* pA = extensions.get<ExtensionA>();
+    REQUIRE(pA != nullptr);
+    CHECK(pA->value == 5);
+    CHECK(extensions.get<ExtensionB>() == nullptr);
+
+    auto it = extensions.find("EXT_unknown");
+    REQUIRE(it != extensions.end());
+    CHECK(std::any_cast<JsonValue>(&it->second) != nullptr);
+  }
+
+  SECTION("finds an extension added as std::any by its name") {
+    extensions.emplace("EXT_b", std::any(ExtensionB{"any"}));
+    REQUIRE(extensions.begin()->typeId == nullptr);
+
+    const ExtensionB* pB = extensions.get<ExtensionB>();
+    REQUIRE(pB != nullptr);
+    CHECK(pB->value == "any");
+  }
+
+  SECTION("does not replace an extension with the same name") {
+    auto first = extensions.emplace("EXT_a", ExtensionA{1});
+    CHECK(first.second);
+    auto second = extensions.emplace("EXT_a", ExtensionA{2});
+    CHECK(!second.second);
+    CHECK(second.first == first.first);
+    CHECK(extensions.size() == 1);
+    CHECK(extensions.get<ExtensionA>()->value == 1);
+  }
+
+  SECTION("does not return an extension of another type with the name") {
+    extensions.emplace("EXT_a", JsonValue(JsonValue::Object()));
+    CHECK(extensions.get<ExtensionA>() == nullptr);
+  }
+
+  SECTION("erases extensions") {
+    extensions.emplace("EXT_a", ExtensionA());
+    extensions.emplace("EXT_b", ExtensionB());
+
+    CHECK(extensions.erase("EXT_c") == 0);
+    CHECK(extensions.erase("EXT_a") == 1);
+    REQUIRE(extensions.size() == 1);
+    CHECK(extensions.get<ExtensionA>() == nullptr);
+    CHECK(extensions.get<ExtensionB>() != nullptr);
+
+    auto next = extensions.erase(extensions.begin());
+    CHECK(next == extensions.end());
+    CHECK(extensions.empty());
+  }
+}
+
+TEST_CASE("ExtensibleObject extensions") {
+  ExtensibleObject object;
+
+  ExtensionA& a = object.addExtension<ExtensionA>();
+  a.value = 10;
+  CHECK(
+      &object.addExtension<ExtensionA>() ==
+      object.getExtension<ExtensionA>());
+  CHECK(object.hasExtension<ExtensionA>());
+  CHECK(!object.hasExtension<ExtensionB>());
+  CHECK(object.getExtension<ExtensionA>()->value == 10);
+
+  object.extensions.emplace("EXT_generic", JsonValue(JsonValue::Object()));
+  CHECK(object.getGenericExtension("EXT_generic") != nullptr);
+  CHECK(object.getGenericExtension("EXT_a") == nullptr);
+  CHECK(object.extensions.size() == 2);
+}
@@ -0,0 +1,45 @@
+#include "CesiumUtility/Hash.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+gsl::span<const std::byte> asBytes(const std::string& s) {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(s.data()),
+      s.size());
+}
+} // namespace
+
+TEST_CASE("Hash::xxHash64") {
+  SECTION("matches the reference implementation") {
+    CHECK(Hash::xxHash64(asBytes("")) == 0xEF46DB3751D8E999ULL);
+    CHECK(Hash::xxHash64(asBytes("abc")) == 0x44BC2CF5AD770999ULL);
+  }
+
+  SECTION("depends on every byte of long inputs") {
+    std::vector<std::byte> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = std::byte(i * 7);
+    }
+
+    const uint64_t original = Hash::xxHash64(data);
+    for (size_t i : {size_t(0), size_t(31), size_t(500), size_t(999)}) {
+      std::vector<std::byte> changed = data;
+      changed[i] ^= std::byte(1);
+      CHECK(Hash::xxHash64(changed) != original);
+    }
+
+    CHECK(Hash::xxHash64(data, 1) != original);
+  }
+
+  SECTION("combines hashes in order") {
+    const uint64_t a = Hash::xxHash64(asBytes("a"));
+    const uint64_t b = Hash::xxHash64(asBytes("b"));
+    CHECK(Hash::combine(a, b) != Hash::combine(b, a));
+  }
+}
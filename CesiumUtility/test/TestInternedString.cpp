@@ -0,0 +1,68 @@
+#include "CesiumUtility/InternedString.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("InternedString") {
+  SECTION("is trivially copyable") {
+    CHECK(std::is_trivially_copyable_v<InternedString>);
+    CHECK(sizeof(InternedString) == sizeof(void*));
+  }
+
+  SECTION("shares one copy of equal strings") {
+    const std::string value = "tiles/0/0/0.b3dm";
+    const InternedString a(value);
+    const InternedString b("tiles/0/0/0.b3dm");
+    CHECK(a == b);
+    CHECK(&a.str() == &b.str());
+    CHECK(a.str() == value);
+    CHECK(a == value);
+    CHECK(value == a);
+    CHECK(a != InternedString("tiles/0/0/1.b3dm"));
+  }
+
+  SECTION("represents the empty string without interning it") {
+    CHECK(InternedString().empty());
+    CHECK(InternedString("").empty());
+    CHECK(InternedString(std::string()) == InternedString());
+    CHECK(InternedString().str().empty());
+  }
+
+  SECTION("interns the same string from several threads") {
+    std::vector<InternedString> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+      threads.emplace_back([&results, i]() {
+        for (int j = 0; j < 1000; ++j) {
+          const InternedString other(std::to_string(j));
+          CHECK(other.str() == std::to_string(j));
+        }
+        results[i] = InternedString("shared");
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    for (const InternedString& result : results) {
+      CHECK(result == results[0]);
+    }
+  }
+
+  SECTION("can be used as a key") {
+    std::unordered_set<InternedString> set;
+    set.insert(InternedString("a"));
+    set.insert(InternedString(std::string("a")));
+    set.insert(InternedString("b"));
+    CHECK(set.size() == 2);
+    CHECK(InternedString("a") < InternedString("b"));
+    CHECK(!(InternedString("a") < InternedString("a")));
+  }
+}
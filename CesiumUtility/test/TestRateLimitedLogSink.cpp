@@ -0,0 +1,83 @@
+#include <CesiumUtility/RateLimitedLogSink.h>
+
+#include <catch2/catch.hpp>
+#include <spdlog/sinks/ringbuffer_sink.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("RateLimitedLogSink") {
+  auto pRingBuffer = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(10);
+  pRingBuffer->set_pattern("%l %v");
+
+  // An interval long enough that it never ends during the test.
+  auto pSink = std::make_shared<RateLimitedLogSink>(
+      std::vector<spdlog::sink_ptr>{pRingBuffer},
+      std::chrono::hours(1),
+      2);
+  spdlog::logger logger("test", pSink);
+
+  auto getMessages = [&pRingBuffer]() {
+    std::vector<std::string> messages = pRingBuffer->last_formatted();
+    for (std::string& message : messages) {
+      while (!message.empty() &&
+             (message.back() == '\n' || message.back() == '\r')) {
+        message.pop_back();
+      }
+    }
+    return messages;
+  };
+
+  SECTION("passes on the first messages of each group") {
+    logger.error("Failed to load tiles/3/5/2.b3dm");
+    logger.error("Failed to load tiles/4/11/6.b3dm");
+    logger.error("Failed to load tiles/5/22/13.b3dm");
+    logger.error("Failed to load layer.json");
+    logger.warn("Failed to load tiles/3/5/2.b3dm");
+
+    CHECK(
+        getMessages() == std::vector<std::string>{
+                             "error Failed to load tiles/3/5/2.b3dm",
+                             "error Failed to load tiles/4/11/6.b3dm",
+                             "error Failed to load layer.json",
+                             "warning Failed to load tiles/3/5/2.b3dm"});
+  }
+
+  SECTION("reports the dropped messages when flushed") {
+    for (int i = 0; i < 5; ++i) {
+      logger.error("Failed to load tiles/{}.b3dm", i);
+    }
+    logger.flush();
+
+    CHECK(
+        getMessages() ==
+        std::vector<std::string>{
+            "error Failed to load tiles/0.b3dm",
+            "error Failed to load tiles/1.b3dm",
+            "error 3 similar messages were not logged. The last was: Failed "
+            "to load tiles/4.b3dm"});
+
+    // Nothing more is reported until more messages are dropped.
+    logger.flush();
+    CHECK(getMessages().size() == 3);
+  }
+
+  SECTION("creates a logger from an existing logger") {
+    auto pExisting = std::make_shared<spdlog::logger>("existing", pRingBuffer);
+    pExisting->set_level(spdlog::level::warn);
+
+    std::shared_ptr<spdlog::logger> pLogger =
+        RateLimitedLogSink::createLogger(pExisting);
+    CHECK(pLogger->name() == "existing");
+    CHECK(pLogger->level() == spdlog::level::warn);
+
+    pLogger->info("Not logged");
+    pLogger->warn("Warning 1");
+    pLogger->warn("Warning 2");
+    CHECK(getMessages() == std::vector<std::string>{"warning Warning 1"});
+  }
+}
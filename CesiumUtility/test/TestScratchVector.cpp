@@ -0,0 +1,59 @@
+#include <CesiumUtility/ScratchVector.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("ScratchVector") {
+  SECTION("starts empty and reuses the memory of an earlier vector") {
+    const int32_t* pData = nullptr;
+    {
+      ScratchVector<int32_t> first;
+      CHECK(first->empty());
+      first->resize(1000, 42);
+      pData = first->data();
+    }
+
+    ScratchVector<int32_t> second;
+    CHECK(second->empty());
+    CHECK(second->capacity() >= 1000);
+    CHECK(second->data() == pData);
+  }
+
+  SECTION("gives each live vector its own memory") {
+    ScratchVector<int64_t> first;
+    first->resize(10);
+    ScratchVector<int64_t> second;
+    second->resize(10);
+    CHECK(first->data() != second->data());
+  }
+
+  SECTION("doesn't keep very large vectors") {
+    {
+      ScratchVector<uint8_t> huge;
+      huge->resize(ScratchVector<uint8_t>::maximumPooledBytes + 1);
+    }
+
+    ScratchVector<uint8_t> next;
+    CHECK(next->capacity() == 0);
+  }
+
+  SECTION("keeps a separate pool for each thread") {
+    {
+      ScratchVector<double> vector;
+      vector->resize(100);
+    }
+
+    size_t capacityInOtherThread = 1;
+    std::thread thread([&capacityInOtherThread]() {
+      ScratchVector<double> vector;
+      capacityInOtherThread = vector->capacity();
+    });
+    thread.join();
+    CHECK(capacityInOtherThread == 0);
+  }
+}
@@ -0,0 +1,60 @@
+#include <CesiumUtility/Uri.h>
+#include <CesiumUtility/UriResolver.h>
+
+#include <catch2/catch.hpp>
+
+#include <utility>
+
+using namespace CesiumUtility;
+
+TEST_CASE("UriResolver") {
+  SECTION("gives the same result as Uri::resolve") {
+    const std::string bases[] = {
+        "https://example.com/tileset/tileset.json",
+        "https://example.com/tileset/tileset.json?key=abc",
+        "https://example.com/a/b/",
+        "not a valid uri"};
+    const std::string relatives[] = {
+        "0/0/0.b3dm",
+        "../other/tile.glb",
+        "/root.json",
+        "tile.b3dm?v=1",
+        "https://other.com/tile.b3dm",
+        ""};
+
+    for (const std::string& base : bases) {
+      UriResolver resolver(base);
+      CHECK(resolver.getBase() == base);
+      for (const std::string& relative : relatives) {
+        CHECK(resolver.resolve(relative) == Uri::resolve(base, relative));
+        CHECK(
+            resolver.resolve(relative, true) ==
+            Uri::resolve(base, relative, true));
+      }
+    }
+  }
+
+  SECTION("appends the base query") {
+    UriResolver resolver("https://example.com/tileset.json?key=abc");
+    CHECK(
+        resolver.resolve("tile.b3dm", true) ==
+        "https://example.com/tile.b3dm?key=abc");
+    CHECK(
+        resolver.resolve("tile.b3dm?v=1", true) ==
+        "https://example.com/tile.b3dm?v=1&key=abc");
+    CHECK(
+        resolver.resolve("tile.b3dm", false) ==
+        "https://example.com/tile.b3dm");
+  }
+
+  SECTION("copies and moves") {
+    UriResolver resolver("https://example.com/a/");
+    UriResolver copy(resolver);
+    UriResolver moved(std::move(resolver));
+    CHECK(copy.resolve("b") == "https://example.com/a/b");
+    CHECK(moved.resolve("b") == "https://example.com/a/b");
+
+    copy = UriResolver("https://other.com/");
+    CHECK(copy.resolve("b") == "https://other.com/b");
+  }
+}
@@ -0,0 +1,70 @@
+#include <CesiumUtility/Uri.h>
+#include <CesiumUtility/UriTemplate.h>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+using namespace CesiumUtility;
+
+namespace {
+std::string substituteXYZ(const std::string& placeholder) {
+  if (placeholder == "x") {
+    return "1";
+  }
+  if (placeholder == "y") {
+    return "2";
+  }
+  if (placeholder == "z") {
+    return "3";
+  }
+  return "{" + placeholder + "}";
+}
+} // namespace
+
+TEST_CASE("UriTemplate") {
+  SECTION("substitutes placeholders") {
+    UriTemplate uriTemplate("https://example.com/{z}/{x}/{y}.png?key=abc");
+    CHECK(
+        uriTemplate.getPlaceholders() ==
+        std::vector<std::string>{"z", "x", "y"});
+    CHECK(
+        uriTemplate.substitute(substituteXYZ) ==
+        "https://example.com/3/1/2.png?key=abc");
+  }
+
+  SECTION("gives the same result as substituteTemplateParameters") {
+    for (const char* templateUri :
+         {"",
+          "no placeholders",
+          "{x}",
+          "{x}{y}",
+          "{}/{unknown}/",
+          "a{x}b{y}c{z}d",
+          "nested {a{x}} braces"}) {
+      CHECK(
+          UriTemplate(templateUri).substitute(substituteXYZ) ==
+          Uri::substituteTemplateParameters(templateUri, substituteXYZ));
+    }
+  }
+
+  SECTION("can be substituted many times") {
+    UriTemplate uriTemplate("{x}/{y}");
+    for (int i = 0; i < 3; ++i) {
+      CHECK(
+          uriTemplate.substitute([i](const std::string& placeholder) {
+            return placeholder + std::to_string(i);
+          }) == "x" + std::to_string(i) + "/y" + std::to_string(i));
+    }
+  }
+
+  SECTION("throws on substituting an unclosed placeholder") {
+    UriTemplate uriTemplate("https://example.com/{x}/{y");
+    CHECK(uriTemplate.getTemplate() == "https://example.com/{x}/{y");
+    CHECK_THROWS_AS(uriTemplate.substitute(substituteXYZ), std::runtime_error);
+  }
+
+  SECTION("is empty by default") {
+    CHECK(UriTemplate().substitute(substituteXYZ) == "");
+  }
+}
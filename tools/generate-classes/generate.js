@@ -337,6 +337,9 @@ function generate(options, schema, writers) {
 
         CesiumJsonReader::IJsonHandler* ${name}JsonHandler::readObjectKey(const std::string_view& str) {
           assert(this->_pObject);
+          if (this->isSkippedProperty(${namespace}::${name}::TypeName, str)) {
+            return this->ignoreAndContinue();
+          }
           return this->readObjectKey${name}(${namespace}::${name}::TypeName, str, *this->_pObject);
         }
 